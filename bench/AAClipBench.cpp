@@ -9,6 +9,7 @@
 #include "SkAAClip.h"
 #include "SkCanvas.h"
 #include "SkPath.h"
+#include "SkRRect.h"
 #include "SkRandom.h"
 #include "SkRegion.h"
 #include "SkString.h"
@@ -170,6 +171,64 @@ private:
     typedef Benchmark INHERITED;
 };
 
+////////////////////////////////////////////////////////////////////////////////
+// This bench repeats the same nested clips every loop, the way a UI redraws the same views every
+// frame, so the clip paths keep their generation IDs from one loop to the next.
+class RepeatedAAClipBench : public Benchmark {
+    static const int kNestingDepth = 3;
+    SkPath fPaths[kNestingDepth];
+
+public:
+    RepeatedAAClipBench() {
+        for (int i = 0; i < kNestingDepth; ++i) {
+            SkRect r = SkRect::MakeXYWH(10.5f * i, 10.5f * i, 400 - 21.0f * i, 400 - 21.0f * i);
+            fPaths[i].addRoundRect(r, 20, 20);
+        }
+    }
+
+protected:
+    const char* onGetName() override { return "repeated_aaclip"; }
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+        for (int i = 0; i < loops; ++i) {
+            canvas->save();
+            for (const SkPath& path : fPaths) {
+                canvas->clipPath(path, true);
+            }
+            canvas->drawRect(SkRect::MakeWH(400, 400), paint);
+            canvas->restore();
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+};
+
+// Draws the rects of a card's contents, most of them clear of its rounded corners, through a
+// round rect clip.
+class RRectClipRectsBench : public Benchmark {
+protected:
+    const char* onGetName() override { return "aaclip_rrect_rects"; }
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+        const SkRRect card = SkRRect::MakeRectXY(SkRect::MakeLTRB(10.5f, 10.5f, 390.5f, 390.5f),
+                                                 16, 16);
+        for (int i = 0; i < loops; ++i) {
+            canvas->save();
+            canvas->clipRRect(card, true);
+            canvas->drawRect(SkRect::MakeWH(400, 400), paint);
+            for (int y = 0; y < 400; y += 40) {
+                canvas->drawRect(SkRect::MakeXYWH(0, SkIntToScalar(y), 400, 30), paint);
+                canvas->drawRect(SkRect::MakeXYWH(40, SkIntToScalar(y), 320, 30), paint);
+            }
+            canvas->restore();
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 class AAClipBuilderBench : public Benchmark {
     SkString fName;
@@ -242,6 +301,33 @@ private:
     typedef Benchmark INHERITED;
 };
 
+////////////////////////////////////////////////////////////////////////////////
+// This bench intersects an antialiased ring with integral rects, as happens when a clip stack
+// mixes a rounded clip with the layout rects of nested views.
+class AAClipIntersectRectBench : public Benchmark {
+public:
+    AAClipIntersectRectBench()  {
+        SkPath path;
+        path.addCircle(200, 200, SkIntToScalar(200));
+        path.addCircle(200, 200, SkIntToScalar(180));
+        path.setFillType(SkPath::kEvenOdd_FillType);
+        fClip.setPath(path);
+    }
+
+protected:
+    const char* onGetName() override { return "aaclip_intersect_rect"; }
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            SkAAClip clip(fClip);
+            clip.op(SkRect::MakeLTRB(10, 20, 300, 380), SkRegion::kIntersect_Op, true);
+        }
+    }
+
+private:
+    SkAAClip fClip;
+    typedef Benchmark INHERITED;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH(return new AAClipBuilderBench(false, false);)
@@ -249,9 +335,12 @@ DEF_BENCH(return new AAClipBuilderBench(false, true);)
 DEF_BENCH(return new AAClipBuilderBench(true, false);)
 DEF_BENCH(return new AAClipBuilderBench(true, true);)
 DEF_BENCH(return new AAClipRegionBench();)
+DEF_BENCH(return new AAClipIntersectRectBench();)
 DEF_BENCH(return new AAClipBench(false, false);)
 DEF_BENCH(return new AAClipBench(false, true);)
 DEF_BENCH(return new AAClipBench(true, false);)
 DEF_BENCH(return new AAClipBench(true, true);)
 DEF_BENCH(return new NestedAAClipBench(false);)
 DEF_BENCH(return new NestedAAClipBench(true);)
+DEF_BENCH(return new RepeatedAAClipBench();)
+DEF_BENCH(return new RRectClipRectsBench();)
@@ -131,6 +131,7 @@ enum Flags {
     kRotate_Flag            = 1 << 1,
     kBilerp_Flag            = 1 << 2,
     kBicubic_Flag           = 1 << 3,
+    kPerspective_Flag       = 1 << 4,
 };
 
 static bool isBilerp(uint32_t flags) {
@@ -160,6 +161,9 @@ protected:
         if (fFlags & kRotate_Flag) {
             fFullName.append("_rotate");
         }
+        if (fFlags & kPerspective_Flag) {
+            fFullName.append("_persp");
+        }
         if (isBilerp(fFlags)) {
             fFullName.append("_bilerp");
         } else if (isBicubic(fFlags)) {
@@ -185,6 +189,14 @@ protected:
             const SkScalar y = SkIntToScalar(dim.fHeight) / 2;
             canvas->rotate(SkIntToScalar(35), x, y);
         }
+        if (fFlags & kPerspective_Flag) {
+            // A gentle tilt, like a card turning in 3D.
+            SkMatrix persp;
+            persp.setAll(1, 0, 0,
+                         0, 1, 0,
+                         SK_Scalar1 / 2000, SK_Scalar1 / 4000, 1);
+            canvas->concat(persp);
+        }
         INHERITED::onDraw(loops, canvas);
     }
 
@@ -323,6 +335,10 @@ DEF_BENCH( return new FilterBitmapBench(kN32_SkColorType, kOpaque_SkAlphaType, f
 DEF_BENCH( return new FilterBitmapBench(kN32_SkColorType, kOpaque_SkAlphaType, true, true, kScale_Flag | kRotate_Flag | kBilerp_Flag); )
 DEF_BENCH( return new FilterBitmapBench(kN32_SkColorType, kOpaque_SkAlphaType, true, false, kScale_Flag | kRotate_Flag | kBilerp_Flag); )
 
+// perspective -> SkRasterPipeline's matrix_perspective and gather stages
+DEF_BENCH( return new FilterBitmapBench(kN32_SkColorType, kPremul_SkAlphaType, false, false, kPerspective_Flag); )
+DEF_BENCH( return new FilterBitmapBench(kN32_SkColorType, kPremul_SkAlphaType, false, false, kPerspective_Flag | kBilerp_Flag); )
+
 DEF_BENCH( return new FilterBitmapBench(kN32_SkColorType, kPremul_SkAlphaType, false, false, kScale_Flag | kBilerp_Flag | kBicubic_Flag); )
 DEF_BENCH( return new FilterBitmapBench(kN32_SkColorType, kPremul_SkAlphaType, false, false, kScale_Flag | kRotate_Flag | kBilerp_Flag | kBicubic_Flag); )
 
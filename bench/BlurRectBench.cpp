@@ -19,6 +19,7 @@ static const SkScalar kMedium = SkIntToScalar(5);
 #define BIG     SkIntToScalar(10)
 static const SkScalar kMedBig = SkIntToScalar(20);
 #define REALBIG 30.5f
+static const SkScalar kHuge = SkIntToScalar(100);
 
 class BlurRectBench: public Benchmark {
     int         fLoopCount;
@@ -200,6 +201,7 @@ DEF_BENCH(return new BlurRectDirectBench(kMedBig);)
 
 DEF_BENCH(return new BlurRectBoxFilterBench(kMedium);)
 DEF_BENCH(return new BlurRectBoxFilterBench(kMedBig);)
+DEF_BENCH(return new BlurRectBoxFilterBench(kHuge);)
 
 #if 0
 // disable Gaussian benchmarks; the algorithm works well enough
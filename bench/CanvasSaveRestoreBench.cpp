@@ -0,0 +1,65 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Benchmark.h"
+#include "SkCanvas.h"
+#include "SkPaint.h"
+#include "SkString.h"
+
+// The save/translate/draw/restore pattern UI toolkits emit for every child view. The clipping
+// variant also clips each child, so its saves can't skip the devices' clip stacks.
+class CanvasSaveRestoreBench : public Benchmark {
+public:
+    CanvasSaveRestoreBench(int depth, bool clip) : fDepth(depth), fClip(clip) {
+        fName.printf("canvas_save_restore_depth%d%s", depth, clip ? "_clip" : "");
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+        paint.setColor(0xFF336699);
+        const SkRect rect = SkRect::MakeWH(4, 4);
+        for (int i = 0; i < loops; ++i) {
+            for (int child = 0; child < kChildren; ++child) {
+                this->drawChild(canvas, paint, rect, child, fDepth);
+            }
+        }
+    }
+
+private:
+    static constexpr int kChildren = 100;
+
+    void drawChild(SkCanvas* canvas, const SkPaint& paint, const SkRect& rect, int child,
+                   int depth) {
+        canvas->save();
+        canvas->translate(SkIntToScalar(child % 10 * 4), SkIntToScalar(child / 10 * 4));
+        if (fClip) {
+            canvas->clipRect(SkRect::MakeWH(32, 32));
+        }
+        if (depth > 1) {
+            this->drawChild(canvas, paint, rect, child, depth - 1);
+        } else {
+            canvas->drawRect(rect, paint);
+        }
+        canvas->restore();
+    }
+
+    SkString fName;
+    int      fDepth;
+    bool     fClip;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new CanvasSaveRestoreBench(1, false); )
+DEF_BENCH( return new CanvasSaveRestoreBench(4, false); )
+DEF_BENCH( return new CanvasSaveRestoreBench(1, true); )
+DEF_BENCH( return new CanvasSaveRestoreBench(4, true); )
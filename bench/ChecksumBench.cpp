@@ -10,11 +10,13 @@
 #include "SkOpts.h"
 #include "SkMD5.h"
 #include "SkRandom.h"
+#include "SkString.h"
 #include "SkTemplates.h"
 
 enum ChecksumType {
     kMD5_ChecksumType,
     kHash_ChecksumType,
+    kHasher_ChecksumType,  // SkHasher, written 16 bytes at a time.
 };
 
 class ComputeChecksumBench : public Benchmark {
@@ -22,13 +24,16 @@ class ComputeChecksumBench : public Benchmark {
         U32COUNT  = 256,
         SIZE      = U32COUNT * 4,
     };
-    uint32_t    fData[U32COUNT];
+    SkAutoTMalloc<uint32_t> fData;
+    size_t       fBytes;
     ChecksumType fType;
+    SkString     fName;
 
 public:
-    ComputeChecksumBench(ChecksumType type) : fType(type) {
+    ComputeChecksumBench(ChecksumType type, size_t bytes = SIZE)
+        : fData(SkAlign4(bytes) / 4), fBytes(bytes), fType(type) {
         SkRandom rand;
-        for (int i = 0; i < U32COUNT; ++i) {
+        for (size_t i = 0; i < SkAlign4(bytes) / 4; ++i) {
             fData[i] = rand.nextU();
         }
     }
@@ -40,11 +45,16 @@ public:
 protected:
     const char* onGetName() override {
         switch (fType) {
-            case kMD5_ChecksumType: return "compute_md5";
-            case kHash_ChecksumType: return "compute_hash";
+            case kMD5_ChecksumType:    fName = "compute_md5";    break;
+            case kHash_ChecksumType:   fName = "compute_hash";   break;
+            case kHasher_ChecksumType: fName = "compute_hasher"; break;
 
             default: SK_ABORT("Invalid Type"); return "";
         }
+        if (fBytes != SIZE) {
+            fName.appendf("_%zu", fBytes);
+        }
+        return fName.c_str();
     }
 
     void onDraw(int loops, SkCanvas*) override {
@@ -52,14 +62,25 @@ protected:
             case kMD5_ChecksumType: {
                 for (int i = 0; i < loops; i++) {
                     SkMD5 md5;
-                    md5.write(fData, sizeof(fData));
+                    md5.write(fData.get(), fBytes);
                     SkMD5::Digest digest;
                     md5.finish(digest);
                 }
             } break;
             case kHash_ChecksumType: {
                 for (int i = 0; i < loops; i++) {
-                    volatile uint32_t result = SkOpts::hash(fData, sizeof(fData));
+                    volatile uint32_t result = SkOpts::hash(fData.get(), fBytes);
+                    sk_ignore_unused_variable(result);
+                }
+            }break;
+            case kHasher_ChecksumType: {
+                auto data = (const uint8_t*)fData.get();
+                for (int i = 0; i < loops; i++) {
+                    SkHasher hasher;
+                    for (size_t j = 0; j < fBytes; j += 16) {
+                        hasher.write(data + j, SkTMin(fBytes - j, (size_t)16));
+                    }
+                    volatile uint32_t result = hasher.finish();
                     sk_ignore_unused_variable(result);
                 }
             }break;
@@ -75,3 +96,13 @@ private:
 
 DEF_BENCH( return new ComputeChecksumBench(kMD5_ChecksumType); )
 DEF_BENCH( return new ComputeChecksumBench(kHash_ChecksumType); )
+
+// Short keys always take the 4 or 8 byte at a time paths, while keys of 256 bytes and up take the
+// wide SIMD paths where a CPU has them.
+DEF_BENCH( return new ComputeChecksumBench(kHash_ChecksumType,   16); )
+DEF_BENCH( return new ComputeChecksumBench(kHash_ChecksumType,   64); )
+DEF_BENCH( return new ComputeChecksumBench(kHash_ChecksumType,  255); )
+DEF_BENCH( return new ComputeChecksumBench(kHash_ChecksumType,  256); )
+DEF_BENCH( return new ComputeChecksumBench(kHash_ChecksumType, 4096); )
+DEF_BENCH( return new ComputeChecksumBench(kHasher_ChecksumType,  256); )
+DEF_BENCH( return new ComputeChecksumBench(kHasher_ChecksumType, 4096); )
@@ -9,12 +9,14 @@
 #include "SkCanvas.h"
 #include "SkPath.h"
 #include "SkPathOps.h"
+#include "SkRRect.h"
 
 class ClipStrategyBench : public Benchmark {
 public:
     enum class Mode {
         kClipPath,
         kMask,
+        kDifferenceRRects,
     };
 
     ClipStrategyBench(Mode mode, size_t count)
@@ -27,8 +29,10 @@ public:
             this->forEachClipCircle([&](float x, float y, float r) {
                 fClipPath.addCircle(x, y, r);
             });
-        } else {
+        } else if (fMode == Mode::kMask) {
             fName.append("mask_");
+        } else {
+            fName.append("diff_rrects_");
         }
         fName.appendf("%zu", count);
     }
@@ -51,6 +55,14 @@ protected:
             if (fMode == Mode::kClipPath) {
                 canvas->save();
                 canvas->clipPath(fClipPath, true);
+            } else if (fMode == Mode::kDifferenceRRects) {
+                // Cut out rounded holes, as card or window UIs do.
+                canvas->save();
+                this->forEachClipCircle([&](float x, float y, float r) {
+                    SkRect bounds = SkRect::MakeLTRB(x - r, y - r, x + r, y + r);
+                    canvas->clipRRect(SkRRect::MakeRectXY(bounds, r / 4, r / 4),
+                                      SkClipOp::kDifference, true);
+                });
             } else {
                 canvas->saveLayer(nullptr, nullptr);
                 this->forEachClipCircle([&](float x, float y, float r) {
@@ -89,3 +101,8 @@ DEF_BENCH( return new ClipStrategyBench(ClipStrategyBench::Mode::kMask, 1  );)
 DEF_BENCH( return new ClipStrategyBench(ClipStrategyBench::Mode::kMask, 5  );)
 DEF_BENCH( return new ClipStrategyBench(ClipStrategyBench::Mode::kMask, 10 );)
 DEF_BENCH( return new ClipStrategyBench(ClipStrategyBench::Mode::kMask, 100);)
+
+DEF_BENCH( return new ClipStrategyBench(ClipStrategyBench::Mode::kDifferenceRRects, 1  );)
+DEF_BENCH( return new ClipStrategyBench(ClipStrategyBench::Mode::kDifferenceRRects, 5  );)
+DEF_BENCH( return new ClipStrategyBench(ClipStrategyBench::Mode::kDifferenceRRects, 10 );)
+DEF_BENCH( return new ClipStrategyBench(ClipStrategyBench::Mode::kDifferenceRRects, 100);)
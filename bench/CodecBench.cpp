@@ -9,8 +9,12 @@
 #include "CodecBenchPriv.h"
 #include "SkBitmap.h"
 #include "SkCodec.h"
+#include "SkColorPriv.h"
 #include "SkCommandLineFlags.h"
+#include "SkImageEncoder.h"
 #include "SkOSFile.h"
+#include "SkRandom.h"
+#include "SkStream.h"
 
 // Actually zeroing the memory would throw off timing, so we just lie.
 DEFINE_bool(zero_init, false, "Pretend our destination is zero-intialized, simulating Android?");
@@ -63,3 +67,68 @@ void CodecBench::onDraw(int n, SkCanvas* canvas) {
                  || result == SkCodec::kIncompleteInput);
     }
 }
+
+// Decodes a tall PNG as a series of full-width strips, top to bottom, like a tile server
+// cutting up a large map. Each strip is its own incremental decode of a subset, so this
+// measures how much of the image is inflated again for each strip.
+class PngStripBench : public Benchmark {
+public:
+    explicit PngStripBench(int stripHeight) : fStripHeight(stripHeight) {
+        fName.printf("Codec_png_strips_%d", stripHeight);
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override {
+        return kNonRendering_Backend == backend;
+    }
+
+    void onDelayedSetup() override {
+        // Smooth enough to compress like a real map, with some noise so it isn't trivial.
+        SkBitmap src;
+        src.allocN32Pixels(1024, 4096);
+        SkRandom random;
+        for (int y = 0; y < src.height(); y++) {
+            for (int x = 0; x < src.width(); x++) {
+                *src.getAddr32(x, y) = SkPackARGB32(0xFF, x & 0xFF, y & 0xFF,
+                                                    random.nextU() & 0x0F);
+            }
+        }
+        SkDynamicMemoryWStream stream;
+        SkAssertResult(SkEncodeImage(&stream, src, SkEncodedImageFormat::kPNG, 100));
+        fData = stream.detachAsData();
+
+        fInfo = SkImageInfo::MakeN32Premul(src.width(), src.height());
+        fPixelStorage.reset(fInfo.minRowBytes() * fStripHeight);
+    }
+
+    void onDraw(int n, SkCanvas*) override {
+        for (int i = 0; i < n; i++) {
+            std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(fData);
+            for (int top = 0; top < fInfo.height(); top += fStripHeight) {
+                const SkIRect subset = SkIRect::MakeLTRB(0, top, fInfo.width(),
+                        SkTMin(top + fStripHeight, fInfo.height()));
+                SkCodec::Options options;
+                options.fSubset = &subset;
+                if (SkCodec::kSuccess != codec->startIncrementalDecode(fInfo,
+                        fPixelStorage.get(), fInfo.minRowBytes(), &options)) {
+                    return;
+                }
+                codec->incrementalDecode();
+            }
+        }
+    }
+
+private:
+    const int     fStripHeight;
+    SkString      fName;
+    sk_sp<SkData> fData;
+    SkImageInfo   fInfo;
+    SkAutoMalloc  fPixelStorage;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH(return new PngStripBench(16);)
+DEF_BENCH(return new PngStripBench(256);)
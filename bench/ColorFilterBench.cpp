@@ -6,9 +6,12 @@
  */
 
 #include "Benchmark.h"
+#include "SkBitmap.h"
 #include "SkCanvas.h"
 #include "SkColorFilterImageFilter.h"
 #include "SkColorMatrixFilter.h"
+#include "SkTableColorFilter.h"
+#include "ThreadedBench.h"
 
 #define FILTER_WIDTH_SMALL  SkIntToScalar(32)
 #define FILTER_HEIGHT_SMALL SkIntToScalar(32)
@@ -279,3 +282,56 @@ DEF_BENCH( return new ColorFilterBrightBlueBench(false); )
 DEF_BENCH( return new ColorFilterBrightBench(false); )
 DEF_BENCH( return new ColorFilterBlueBench(false); )
 DEF_BENCH( return new ColorFilterGrayBench(false); )
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Filters a pixel buffer in place with SkColorFilter::filterPixmap(), without any drawing.
+class ColorFilterPixmapBench : public Benchmark {
+public:
+    explicit ColorFilterPixmapBench(bool table) : fTable(table) {}
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+protected:
+    const char* onGetName() override {
+        return fTable ? "colorfilter_pixmap_table" : "colorfilter_pixmap_matrix";
+    }
+
+    void onDelayedSetup() override {
+        if (fTable) {
+            uint8_t table[256];
+            for (int i = 0; i < 256; ++i) {
+                table[i] = (uint8_t)(255 - i);
+            }
+            fFilter = SkTableColorFilter::MakeARGB(nullptr, table, table, table);
+        } else {
+            SkScalar matrix[20];
+            memset(matrix, 0, 20 * sizeof(SkScalar));
+            matrix[0] = matrix[5] = matrix[10] = 0.2126f;
+            matrix[1] = matrix[6] = matrix[11] = 0.7152f;
+            matrix[2] = matrix[7] = matrix[12] = 0.0722f;
+            matrix[18] = 1.0f;
+            fFilter = SkColorFilter::MakeMatrixFilterRowMajor255(matrix);
+        }
+        fBitmap.allocN32Pixels(1024, 1024);
+        fBitmap.eraseColor(0xFF336699);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; i++) {
+            fFilter->filterPixmap(fBitmap.pixmap());
+        }
+    }
+
+private:
+    bool                 fTable;
+    sk_sp<SkColorFilter> fFilter;
+    SkBitmap             fBitmap;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new ColorFilterPixmapBench(false); )
+DEF_BENCH( return new ColorFilterPixmapBench(true); )
+DEF_BENCH( return new ThreadedBench(new ColorFilterPixmapBench(false)); )
+DEF_BENCH( return new ThreadedBench(new ColorFilterPixmapBench(true)); )
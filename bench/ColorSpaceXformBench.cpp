@@ -7,12 +7,15 @@
 
 #include "Benchmark.h"
 #include "SkColor.h"
+#include "SkColorFilter.h"
 #include "SkColorSpaceXformer.h"
 #include "SkColorSpaceXformSteps.h"
+#include "SkGradientShader.h"
 #include "SkMakeUnique.h"
 #include "SkRandom.h"
+#include "SkRasterPipeline.h"
 
-enum class Mode { steps, xformer };
+enum class Mode { steps, xformer, paint };
 
 struct ColorSpaceXformBench : public Benchmark {
     ColorSpaceXformBench(Mode mode) : fMode(mode) {}
@@ -21,11 +24,13 @@ struct ColorSpaceXformBench : public Benchmark {
 
     std::unique_ptr<SkColorSpaceXformSteps>  fSteps;
     std::unique_ptr<SkColorSpaceXformer>     fXformer;
+    SkPaint                                  fPaint;
 
     const char* onGetName() override {
         switch (fMode) {
             case Mode::steps  : return "ColorSpaceXformBench_steps";
             case Mode::xformer: return "ColorSpaceXformBench_xformer";
+            case Mode::paint  : return "ColorSpaceXformBench_paint";
         }
         return "";
     }
@@ -40,6 +45,14 @@ struct ColorSpaceXformBench : public Benchmark {
         fSteps = skstd::make_unique<SkColorSpaceXformSteps>(src.get(), kOpaque_SkAlphaType,
                                                             dst.get(), kPremul_SkAlphaType);
         fXformer = SkColorSpaceXformer::Make(dst);  // src is implicitly sRGB, what we want anyway
+
+        // A paint drawn over and over, as through a SkColorSpaceXformCanvas.
+        const SkPoint pts[] = {{0, 0}, {100, 100}};
+        const SkColor colors[] = {SK_ColorRED, SK_ColorBLUE};
+        fPaint.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, 2,
+                                                      SkShader::kClamp_TileMode));
+        fPaint.setColorFilter(SkColorFilter::MakeModeFilter(SK_ColorGREEN,
+                                                            SkBlendMode::kModulate));
     }
 
     void onDraw(int n, SkCanvas* canvas) override {
@@ -59,6 +72,10 @@ struct ColorSpaceXformBench : public Benchmark {
                 case Mode::xformer: {
                     dst = fXformer->apply(src);
                 } break;
+
+                case Mode::paint: {
+                    dst = fXformer->apply(fPaint).getColor();
+                } break;
             }
 
             if (false && i == 0) {
@@ -72,3 +89,60 @@ struct ColorSpaceXformBench : public Benchmark {
 
 DEF_BENCH(return new ColorSpaceXformBench{Mode::steps  };)
 DEF_BENCH(return new ColorSpaceXformBench{Mode::xformer};)
+DEF_BENCH(return new ColorSpaceXformBench{Mode::paint  };)
+
+// Converts rows of 8888 pixels between two color spaces with non-sRGB transfer functions,
+// either evaluating those transfer functions directly or with useTables().
+struct ColorSpaceXformPipelineBench : public Benchmark {
+    ColorSpaceXformPipelineBench(bool tables) : fTables(tables) {}
+
+    const bool fTables;
+
+    static constexpr int kPixels = 1024;
+    uint32_t                                fSrc[kPixels],
+                                            fDst[kPixels];
+    std::unique_ptr<SkColorSpaceXformSteps> fSteps;
+
+    const char* onGetName() override {
+        return fTables ? "ColorSpaceXformBench_pipeline_tables"
+                       : "ColorSpaceXformBench_pipeline_math";
+    }
+
+    bool isSuitableFor(Backend backend) override { return kNonRendering_Backend == backend; }
+
+    void onDelayedSetup() override {
+        sk_sp<SkColorSpace> src = SkColorSpace::MakeRGB(SkNamedTransferFn::k2Dot2,
+                                                        SkNamedGamut::kSRGB),
+                            dst = SkColorSpace::MakeRGB(SkNamedTransferFn::k2Dot2,
+                                                        SkNamedGamut::kDCIP3);
+
+        fSteps = skstd::make_unique<SkColorSpaceXformSteps>(src.get(), kOpaque_SkAlphaType,
+                                                            dst.get(), kOpaque_SkAlphaType);
+        if (fTables) {
+            fSteps->useTables();
+        }
+
+        SkRandom rand;
+        for (int i = 0; i < kPixels; i++) {
+            fSrc[i] = rand.nextU() | 0xff000000;
+        }
+    }
+
+    void onDraw(int n, SkCanvas* canvas) override {
+        SkRasterPipeline_MemoryCtx src = { fSrc, 0 },
+                                   dst = { fDst, 0 };
+
+        SkRasterPipeline_<256> p;
+        p.append(SkRasterPipeline::load_8888, &src);
+        fSteps->apply(&p, kRGBA_8888_SkColorType);
+        p.append(SkRasterPipeline::store_8888, &dst);
+        auto run = p.compile();
+
+        for (int i = 0; i < n; i++) {
+            run(0,0,kPixels,1);
+        }
+    }
+};
+
+DEF_BENCH(return new ColorSpaceXformPipelineBench{false};)
+DEF_BENCH(return new ColorSpaceXformPipelineBench{true };)
@@ -14,6 +14,7 @@
 #include "SkMatrix.h"
 #include "SkPath.h"
 #include "SkRasterClip.h"
+#include "SkScan.h"
 
 class DrawPathBench : public Benchmark {
     SkPaint     fPaint;
@@ -73,3 +74,81 @@ private:
 
 DEF_BENCH( return new DrawPathBench(false) )
 DEF_BENCH( return new DrawPathBench(true) )
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Fills the same many-pointed star with each of the antialiasing scan converters. The small star
+// fits in a single SkCoverageDeltaMask with DAA, and the large one uses an SkCoverageDeltaList.
+class ScanConverterBench : public Benchmark {
+public:
+    enum class Type { kSupersampled, kAnalytic, kDelta };
+
+    ScanConverterBench(Type type, int size) : fType(type) {
+        static const char* kNames[] = { "supersampled", "analytic", "delta" };
+        fName.printf("scan_converter_%s_%d", kNames[(int)type], size);
+
+        fPaint.setAntiAlias(true);
+
+        const int kPoints = 53;
+        SkScalar r = size * 0.5f;
+        fPath.moveTo(r, 0);
+        for (int i = 1; i < kPoints; ++i) {
+            // Every 19th point around the circle gives a star that crosses itself a lot.
+            SkScalar angle = 2 * SK_ScalarPI * (i * 19 % kPoints) / kPoints - SK_ScalarPI / 2;
+            fPath.lineTo(r + r * SkScalarCos(angle), r + r * SkScalarSin(angle));
+        }
+        fPath.close();
+
+        fPixmap.alloc(SkImageInfo::MakeA8(size, size));
+        fPixmap.erase(0);
+
+        fIdentity.setIdentity();
+        fRC.setRect(SkIRect::MakeWH(size, size));
+
+        fDraw.fDst      = fPixmap;
+        fDraw.fMatrix   = &fIdentity;
+        fDraw.fRC       = &fRC;
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    void onDraw(int loops, SkCanvas*) override {
+        bool useDelta      = gSkUseDeltaAA,
+             forceDelta    = gSkForceDeltaAA,
+             useAnalytic   = gSkUseAnalyticAA,
+             forceAnalytic = gSkForceAnalyticAA;
+
+        gSkUseDeltaAA      = gSkForceDeltaAA    = Type::kDelta    == fType;
+        gSkUseAnalyticAA   = gSkForceAnalyticAA = Type::kAnalytic == fType;
+        for (int i = 0; i < loops; ++i) {
+            fDraw.drawPath(fPath, fPaint);
+        }
+
+        gSkUseDeltaAA      = useDelta;
+        gSkForceDeltaAA    = forceDelta;
+        gSkUseAnalyticAA   = useAnalytic;
+        gSkForceAnalyticAA = forceAnalytic;
+    }
+
+private:
+    Type                fType;
+    SkString            fName;
+    SkPaint             fPaint;
+    SkPath              fPath;
+    SkRasterClip        fRC;
+    SkAutoPixmapStorage fPixmap;
+    SkMatrix            fIdentity;
+    SkDraw              fDraw;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new ScanConverterBench(ScanConverterBench::Type::kSupersampled,  30) )
+DEF_BENCH( return new ScanConverterBench(ScanConverterBench::Type::kAnalytic,      30) )
+DEF_BENCH( return new ScanConverterBench(ScanConverterBench::Type::kDelta,         30) )
+DEF_BENCH( return new ScanConverterBench(ScanConverterBench::Type::kSupersampled, 500) )
+DEF_BENCH( return new ScanConverterBench(ScanConverterBench::Type::kAnalytic,     500) )
+DEF_BENCH( return new ScanConverterBench(ScanConverterBench::Type::kDelta,        500) )
@@ -437,6 +437,73 @@ private:
     typedef Benchmark INHERITED;
 };
 
+// Dashed polylines, rects and ovals with thin antialiased strokes, which the raster backend
+// dashes as it draws. Shorter intervals mean more dashes for the same shape.
+class DashShapeBench : public Benchmark {
+    SkString            fName;
+    SkPath              fPath;
+    sk_sp<SkPathEffect> fPathEffect;
+
+public:
+    enum Shape {
+        kPolyline_Shape,
+        kRect_Shape,
+        kOval_Shape,
+    };
+
+    DashShapeBench(Shape shape, int interval, bool round) {
+        static const char* kNames[] = { "polyline", "rect", "oval" };
+        fName.printf("dashshape_%s_%d%s", kNames[shape], interval, round ? "_dots" : "");
+
+        switch (shape) {
+            case kPolyline_Shape: {
+                SkRandom rand;
+                fPath.moveTo(0, 300);
+                for (int x = 10; x <= 640; x += 10) {
+                    fPath.lineTo(SkIntToScalar(x), 300 + rand.nextSScalar1() * 20);
+                }
+                break;
+            }
+            case kRect_Shape:
+                fPath.addRect(SkRect::MakeLTRB(10.5f, 10.5f, 630.5f, 470.5f));
+                break;
+            case kOval_Shape:
+                fPath.addOval(SkRect::MakeLTRB(10, 10, 630, 470));
+                break;
+        }
+
+        // Round dots are zero length dashes with round caps.
+        SkScalar vals[] = { round ? 0 : SkIntToScalar(interval), SkIntToScalar(interval) };
+        fPathEffect = SkDashPathEffect::Make(vals, 2, 0);
+        fRound = round;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint p;
+        this->setupPaint(&p);
+        p.setColor(SK_ColorBLACK);
+        p.setStyle(SkPaint::kStroke_Style);
+        p.setStrokeWidth(1.5f);
+        p.setStrokeCap(fRound ? SkPaint::kRound_Cap : SkPaint::kButt_Cap);
+        p.setPathEffect(fPathEffect);
+        p.setAntiAlias(true);
+
+        for (int i = 0; i < loops; ++i) {
+            canvas->drawPath(fPath, p);
+        }
+    }
+
+private:
+    bool fRound;
+
+    typedef Benchmark INHERITED;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 static const SkScalar gDots[] = { SK_Scalar1, SK_Scalar1 };
@@ -464,6 +531,14 @@ DEF_BENCH( return new DrawPointsDashingBench(3, 1, true); )
 DEF_BENCH( return new DrawPointsDashingBench(5, 5, false); )
 DEF_BENCH( return new DrawPointsDashingBench(5, 5, true); )
 
+DEF_BENCH( return new DashShapeBench(DashShapeBench::kPolyline_Shape, 2, false); )
+DEF_BENCH( return new DashShapeBench(DashShapeBench::kPolyline_Shape, 8, false); )
+DEF_BENCH( return new DashShapeBench(DashShapeBench::kRect_Shape, 2, false); )
+DEF_BENCH( return new DashShapeBench(DashShapeBench::kRect_Shape, 8, false); )
+DEF_BENCH( return new DashShapeBench(DashShapeBench::kRect_Shape, 4, true); )
+DEF_BENCH( return new DashShapeBench(DashShapeBench::kOval_Shape, 2, false); )
+DEF_BENCH( return new DashShapeBench(DashShapeBench::kOval_Shape, 8, false); )
+
 /* Disable the GiantDashBench for Android devices until we can better control
  * the memory usage. (https://code.google.com/p/skia/issues/detail?id=1430)
  */
@@ -13,10 +13,12 @@
 
 class DrawLatticeBench : public Benchmark {
 public:
+    // Each loop draws patchCount copies of the lattice, at a variety of sizes up to dst's.
     DrawLatticeBench(int* xDivs, int xCount, int* yDivs, int yCount, const SkISize& srcSize,
-                     const SkRect& dst, const char* desc)
+                     const SkRect& dst, const char* desc, int patchCount = 1)
         : fSrcSize(srcSize)
         , fDst(dst)
+        , fPatchCount(patchCount)
     {
         fLattice.fXDivs = xDivs;
         fLattice.fXCount = xCount;
@@ -48,7 +50,16 @@ public:
 
     void onDraw(int loops, SkCanvas* canvas) override {
         for (int i = 0; i < loops; i++) {
-            canvas->drawBitmapLattice(fBitmap, fLattice, fDst);
+            if (1 == fPatchCount) {
+                canvas->drawBitmapLattice(fBitmap, fLattice, fDst);
+                continue;
+            }
+            for (int j = 0; j < fPatchCount; j++) {
+                SkRect dst = SkRect::MakeWH(fDst.width() * (j % 4 + 1) / 4,
+                                            fDst.height() * (j % 3 + 1) / 3);
+                dst.offset(j % 10 * 100.0f, j / 10 % 10 * 100.0f);
+                canvas->drawBitmapLattice(fBitmap, fLattice, dst);
+            }
         }
     }
 
@@ -56,6 +67,7 @@ private:
     SkISize           fSrcSize;
     SkCanvas::Lattice fLattice;
     SkRect            fDst;
+    int               fPatchCount;
     SkString          fName;
     SkBitmap          fBitmap;
 
@@ -69,6 +81,11 @@ DEF_BENCH(return new DrawLatticeBench(gDivs9, 2, gDivs9, 2, SkISize::Make(100, 1
                                       SkRect::MakeWH(500.0f, 500.0f), "Src100_Dst500_Rects9");)
 DEF_BENCH(return new DrawLatticeBench(gDivs9, 2, gDivs9, 2, SkISize::Make(100, 100),
                                       SkRect::MakeWH(1000.0f, 1000.0f), "Src100_Dst1000_Rects9");)
+// Many small nine-patches of different sizes, like the buttons and cards of a UI.
+static int gDivs9Small[2] = { 8, 24, };
+DEF_BENCH(return new DrawLatticeBench(gDivs9Small, 2, gDivs9Small, 2, SkISize::Make(32, 32),
+                                      SkRect::MakeWH(96.0f, 96.0f), "Src32_Dst96_Rects9_x100",
+                                      100);)
 static int gDivs15[4] = { 15, 45, 55, 85, };
 DEF_BENCH(return new DrawLatticeBench(gDivs15, 4, gDivs15, 4, SkISize::Make(100, 100),
                                       SkRect::MakeWH(250.0f, 250.0f), "Src100_Dst250_Rects15");)
@@ -8,6 +8,7 @@
 #include "Benchmark.h"
 #include "Resources.h"
 #include "SkBitmap.h"
+#include "SkExecutor.h"
 #include "SkJpegEncoder.h"
 #include "SkPngEncoder.h"
 #include "SkWebpEncoder.h"
@@ -72,19 +73,32 @@ static bool encode_webp_lossless(SkWStream* dst, const SkPixmap& src) {
     return SkWebpEncoder::Encode(dst, src, opts);
 }
 
+static SkExecutor* png_executor() {
+    static SkExecutor* executor = SkExecutor::MakeFIFOThreadPool().release();
+    return executor;
+}
+
 static bool encode_png(SkWStream* dst,
                        const SkPixmap& src,
                        SkPngEncoder::FilterFlag filters,
-                       int zlibLevel) {
+                       int zlibLevel,
+                       SkPngEncoder::ZLibStrategy strategy = SkPngEncoder::ZLibStrategy::kDefault,
+                       bool threaded = false) {
     SkPngEncoder::Options opts;
     opts.fFilterFlags = filters;
     opts.fZLibLevel = zlibLevel;
+    opts.fZLibStrategy = strategy;
+    opts.fExecutor = threaded ? png_executor() : nullptr;
     return SkPngEncoder::Encode(dst, src, opts);
 }
 
 #define PNG(FLAG, ZLIBLEVEL) [](SkWStream* d, const SkPixmap& s) { \
            return encode_png(d, s, SkPngEncoder::FilterFlag::FLAG, ZLIBLEVEL); }
 
+#define PNG_STRATEGY(FLAG, ZLIBLEVEL, STRATEGY, THREADED) [](SkWStream* d, const SkPixmap& s) { \
+           return encode_png(d, s, SkPngEncoder::FilterFlag::FLAG, ZLIBLEVEL,                 \
+                             SkPngEncoder::ZLibStrategy::STRATEGY, THREADED); }
+
 static const char* srcs[2] = {"images/mandrill_512.png", "images/color_wheel.jpg"};
 
 // The Android Photos app uses a quality of 90 on JPEG encodes
@@ -122,4 +136,18 @@ DEF_BENCH(return new EncodeBench(srcs[1], PNG(kNone, 6), "PNG_6n"));
 DEF_BENCH(return new EncodeBench(srcs[1], PNG(kNone, 3), "PNG_3n"));
 DEF_BENCH(return new EncodeBench(srcs[1], PNG(kNone, 1), "PNG_1n"));
 
+DEF_BENCH(return new EncodeBench(srcs[0], PNG_STRATEGY(kAll, 6, kHuffmanOnly, false),
+                                 "PNG_huffman"));
+DEF_BENCH(return new EncodeBench(srcs[0], PNG_STRATEGY(kAll, 6, kRLE, false), "PNG_rle"));
+DEF_BENCH(return new EncodeBench(srcs[0], PNG_STRATEGY(kSub, 1, kRLE, false), "PNG_1s_rle"));
+
+// mandrill_512 is large enough to be split into bands; color_wheel is encoded serially anyway.
+DEF_BENCH(return new EncodeBench(srcs[0], PNG_STRATEGY(kAll, 6, kDefault, true),
+                                 "PNG_threaded"));
+DEF_BENCH(return new EncodeBench(srcs[0], PNG_STRATEGY(kAll, 9, kDefault, true),
+                                 "PNG_9_threaded"));
+DEF_BENCH(return new EncodeBench(srcs[0], PNG_STRATEGY(kSub, 1, kRLE, true),
+                                 "PNG_1s_rle_threaded"));
+
+#undef PNG_STRATEGY
 #undef PNG
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Benchmark.h"
+#include "SkExecutor.h"
+#include "SkString.h"
+#include "SkTaskGroup.h"
+
+#include <atomic>
+
+enum class PoolType { kFIFO, kLIFO, kWorkStealing };
+
+enum class Work { kFlat, kNested, kParallelFor };
+
+// Measures how quickly a thread pool runs many tiny tasks: added from this thread one by one,
+// fanned out as a tree of tasks that each add their own children, or chunked by parallelFor().
+class ExecutorBench : public Benchmark {
+public:
+    ExecutorBench(PoolType type, Work work) : fType(type), fWork(work) {
+        static const char* kPoolNames[] = { "fifo", "lifo", "workstealing" };
+        static const char* kWorkNames[] = { "flat", "nested", "parallelfor" };
+        fName.printf("executor_%s_%s", kPoolNames[(int)type], kWorkNames[(int)work]);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        switch (fType) {
+            case PoolType::kFIFO:         fPool = SkExecutor::MakeFIFOThreadPool();         break;
+            case PoolType::kLIFO:         fPool = SkExecutor::MakeLIFOThreadPool();         break;
+            case PoolType::kWorkStealing: fPool = SkExecutor::MakeWorkStealingThreadPool(); break;
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        std::atomic<int> count(0);
+        for (int i = 0; i < loops; i++) {
+            switch (fWork) {
+                case Work::kFlat:
+                    SkTaskGroup(*fPool).batch(4096, [&](int) {
+                        count.fetch_add(1, std::memory_order_relaxed);
+                    });
+                    break;
+                case Work::kNested:
+                    // 4^0 + 4^1 + ... + 4^6 = 5461 tasks.
+                    this->fanOut(6, &count);
+                    break;
+                case Work::kParallelFor:
+                    SkTaskGroup(*fPool).parallelFor(4096, 1, [&](int start, int end) {
+                        count.fetch_add(end - start, std::memory_order_relaxed);
+                    });
+                    break;
+            }
+        }
+    }
+
+private:
+    void fanOut(int depth, std::atomic<int>* count) {
+        count->fetch_add(1, std::memory_order_relaxed);
+        if (depth > 0) {
+            SkTaskGroup group(*fPool);
+            for (int i = 0; i < 4; i++) {
+                group.add([=] { this->fanOut(depth - 1, count); });
+            }
+            group.wait();
+        }
+    }
+
+    PoolType                    fType;
+    Work                        fWork;
+    std::unique_ptr<SkExecutor> fPool;
+    SkString                    fName;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH(return new ExecutorBench(PoolType::kFIFO, Work::kFlat);)
+DEF_BENCH(return new ExecutorBench(PoolType::kLIFO, Work::kFlat);)
+DEF_BENCH(return new ExecutorBench(PoolType::kWorkStealing, Work::kFlat);)
+DEF_BENCH(return new ExecutorBench(PoolType::kFIFO, Work::kNested);)
+DEF_BENCH(return new ExecutorBench(PoolType::kLIFO, Work::kNested);)
+DEF_BENCH(return new ExecutorBench(PoolType::kWorkStealing, Work::kNested);)
+DEF_BENCH(return new ExecutorBench(PoolType::kFIFO, Work::kParallelFor);)
+DEF_BENCH(return new ExecutorBench(PoolType::kLIFO, Work::kParallelFor);)
+DEF_BENCH(return new ExecutorBench(PoolType::kWorkStealing, Work::kParallelFor);)
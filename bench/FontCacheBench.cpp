@@ -12,6 +12,7 @@
 #include "SkPaint.h"
 #include "SkPath.h"
 #include "SkString.h"
+#include "SkTaskGroup.h"
 #include "SkTemplates.h"
 
 #include "gUniqueGlyphIDs.h"
@@ -53,6 +54,42 @@ private:
     typedef Benchmark INHERITED;
 };
 
+// The same work as FontCacheBench, measured from several threads at once.
+class FontCacheThreadsBench : public Benchmark {
+public:
+    explicit FontCacheThreadsBench(int threads) : fThreads(threads) {
+        fName.printf("fontcache_threads_%d", fThreads);
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkTaskGroup().batch(fThreads, [&](int) {
+            SkFont font;
+            font.setEdging(SkFont::Edging::kAntiAlias);
+
+            const uint16_t* array = gUniqueGlyphIDs;
+            while (*array != gUniqueGlyphIDs_Sentinel) {
+                int count = count_glyphs(array);
+                for (int i = 0; i < loops; ++i) {
+                    (void)font.measureText(array, count * sizeof(uint16_t),
+                                           kGlyphID_SkTextEncoding);
+                }
+                array += count + 1;    // skip the sentinel
+            }
+        });
+    }
+
+private:
+    const int fThreads;
+    SkString fName;
+
+    typedef Benchmark INHERITED;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 static uint32_t rotr(uint32_t value, unsigned bits) {
@@ -141,6 +178,9 @@ private:
     typedef Benchmark INHERITED;
 };
 DEF_BENCH( return new FontCacheBench(); )
+DEF_BENCH( return new FontCacheThreadsBench(1); )
+DEF_BENCH( return new FontCacheThreadsBench(4); )
+DEF_BENCH( return new FontCacheThreadsBench(8); )
 
 // undefine this to run the efficiency test
 //DEF_BENCH( return new FontCacheEfficiency(); )
@@ -244,6 +244,44 @@ protected:
 };
 DEF_BENCH( return new ChopCubicAt; )
 
+#include "GrPathUtils.h"
+
+// Flattening the way the GPU path renderers and tessellators do, to a half-pixel tolerance.
+class FlattenCurve : public GeometryBench {
+public:
+    FlattenCurve(bool cubic) : GeometryBench(cubic ? "flattencubic" : "flattenquad")
+                             , fCubic(cubic) {
+        SkRandom rand;
+        for (int i = 0; i < 4; ++i) {
+            fPts[i].set(rand.nextRangeF(0, 500), rand.nextRangeF(0, 500));
+        }
+    }
+
+protected:
+    void onDraw(int loops, SkCanvas* canvas) override {
+        const SkScalar tol = 0.5f;
+        const int maxPts = fCubic ? GrPathUtils::cubicPointCount(fPts, tol)
+                                  : GrPathUtils::quadraticPointCount(fPts, tol);
+        int total = 0;
+        for (int outer = 0; outer < loops; ++outer) {
+            SkPoint* pts = fStorage;
+            total += fCubic
+                ? GrPathUtils::generateCubicPoints(fPts[0], fPts[1], fPts[2], fPts[3], tol * tol,
+                                                   &pts, maxPts)
+                : GrPathUtils::generateQuadraticPoints(fPts[0], fPts[1], fPts[2], tol * tol,
+                                                       &pts, maxPts);
+        }
+        this->virtualCallToFoilOptimizers(total);
+    }
+
+private:
+    SkPoint fPts[4];
+    SkPoint fStorage[GrPathUtils::kMaxPointsPerCurve];
+    bool    fCubic;
+};
+DEF_BENCH( return new FlattenCurve(false); )
+DEF_BENCH( return new FlattenCurve(true); )
+
 #include "SkPath.h"
 
 class ConvexityBench : public Benchmark {
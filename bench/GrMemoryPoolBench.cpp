@@ -9,8 +9,12 @@
 
 #include "Benchmark.h"
 #include "GrMemoryPool.h"
+#include "SkExecutor.h"
 #include "SkRandom.h"
+#include "SkString.h"
+#include "SkTArray.h"
 #include "SkTDArray.h"
+#include "SkTaskGroup.h"
 #include "SkTemplates.h"
 
 #include <new>
@@ -170,8 +174,69 @@ private:
     typedef Benchmark INHERITED;
 };
 
+/**
+ * This benchmark allocates from a GrOpMemoryPool per recording thread, then releases everything
+ * on this thread, the way ops recorded into DDLs on several threads are destroyed after replay.
+ */
+class GrOpMemoryPoolBenchThreaded : public Benchmark {
+    enum {
+        M = 4 * (1 << 10),
+    };
+public:
+    explicit GrOpMemoryPoolBenchThreaded(int recorders) : fRecorders(recorders) {
+        fName.printf("groppool_threaded_%d", recorders);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        fExecutor = SkExecutor::MakeFIFOThreadPool(fRecorders);
+        for (int i = 0; i < fRecorders; i++) {
+            fPools.push_back(sk_make_sp<GrOpMemoryPool>(1 << 14, 1 << 14));
+        }
+        fAllocations.reset(fRecorders * M);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; i++) {
+            SkTaskGroup recording(*fExecutor);
+            recording.batch(fRecorders, [&](int recorder) {
+                void** allocations = &fAllocations[recorder * M];
+                for (int j = 0; j < M; j++) {
+                    allocations[j] = fPools[recorder]->allocate(16 + 8 * (j & 15));
+                }
+            });
+            recording.wait();
+
+            for (int recorder = 0; recorder < fRecorders; recorder++) {
+                for (int j = 0; j < M; j++) {
+                    fPools[recorder]->release(fAllocations[recorder * M + j]);
+                }
+            }
+        }
+    }
+
+private:
+    int                               fRecorders;
+    SkString                          fName;
+    std::unique_ptr<SkExecutor>       fExecutor;
+    SkTArray<sk_sp<GrOpMemoryPool>>   fPools;
+    SkAutoTMalloc<void*>              fAllocations;
+
+    typedef Benchmark INHERITED;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH( return new GrMemoryPoolBenchStack(); )
 DEF_BENCH( return new GrMemoryPoolBenchRandom(); )
 DEF_BENCH( return new GrMemoryPoolBenchQueue(); )
+DEF_BENCH( return new GrOpMemoryPoolBenchThreaded(1); )
+DEF_BENCH( return new GrOpMemoryPoolBenchThreaded(4); )
@@ -156,6 +156,71 @@ private:
     typedef Benchmark INHERITED;
 };
 
+// Cycles through one more keyed resource than the cache's count budget. With LRU purging every
+// lookup misses, so each iteration recreates a resource and purges another.
+class GrResourceCacheBenchThrash : public Benchmark {
+public:
+    GrResourceCacheBenchThrash(int keyData32Count)
+        : fFullName("grresourcecache_thrash")
+        , fKeyData32Count(keyData32Count) {
+        if (keyData32Count > 1) {
+            fFullName.appendf("_%d", fKeyData32Count);
+        }
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+protected:
+    const char* onGetName() override {
+        return fFullName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        fContext = GrContext::MakeMock(nullptr);
+        if (!fContext) {
+            return;
+        }
+        fContext->setResourceCacheLimits(CACHE_SIZE_COUNT, 1 << 30);
+
+        GrResourceCache* cache = fContext->priv().getResourceCache();
+
+        // Make sure the cache is empty.
+        cache->purgeAllUnlocked();
+        SkASSERT(0 == cache->getResourceCount() && 0 == cache->getResourceBytes());
+
+        GrGpu* gpu = fContext->priv().getGpu();
+
+        populate_cache(gpu, CACHE_SIZE_COUNT, fKeyData32Count);
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        if (!fContext) {
+            return;
+        }
+        GrResourceCache* cache = fContext->priv().getResourceCache();
+        GrGpu* gpu = fContext->priv().getGpu();
+        for (int i = 0; i < loops; ++i) {
+            for (int k = 0; k <= CACHE_SIZE_COUNT; ++k) {
+                GrUniqueKey key;
+                BenchResource::ComputeKey(k, fKeyData32Count, &key);
+                sk_sp<GrGpuResource> resource(cache->findAndRefUniqueResource(key));
+                if (!resource) {
+                    resource.reset(new BenchResource(gpu));
+                    resource->resourcePriv().setUniqueKey(key);
+                }
+            }
+        }
+        SkASSERT(CACHE_SIZE_COUNT == cache->getResourceCount());
+    }
+
+private:
+    sk_sp<GrContext> fContext;
+    SkString fFullName;
+    int fKeyData32Count;
+    typedef Benchmark INHERITED;
+};
+
 DEF_BENCH( return new GrResourceCacheBenchAdd(1); )
 #ifdef SK_RELEASE
 // Only on release because on debug the SkTDynamicHash validation is too slow.
@@ -182,3 +247,8 @@ DEF_BENCH( return new GrResourceCacheBenchFind(54); )
 DEF_BENCH( return new GrResourceCacheBenchFind(55); )
 DEF_BENCH( return new GrResourceCacheBenchFind(56); )
 #endif
+
+DEF_BENCH( return new GrResourceCacheBenchThrash(1); )
+#ifdef SK_RELEASE
+DEF_BENCH( return new GrResourceCacheBenchThrash(10); )
+#endif
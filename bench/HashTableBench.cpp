@@ -0,0 +1,81 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Benchmark.h"
+#include "SkChecksum.h"
+#include "SkString.h"
+#include "SkTHash.h"
+#include "SkTSwissTable.h"
+#include "SkTemplates.h"
+
+// Looks up keys in a table of pointers, the way a strike looks up glyphs, either all hits or
+// all misses.
+template <typename Table>
+class HashTableFindBench : public Benchmark {
+public:
+    HashTableFindBench(const char* tableName, bool hits) : fHits(hits) {
+        fName.printf("hashtable_find_%s_%s", tableName, hits ? "hits" : "misses");
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        fEntries.reset(kCount);
+        for (int i = 0; i < kCount; i++) {
+            // Spread the keys like packed glyph IDs with subpixel positions.
+            fEntries[i].fKey = (i >> 2) << 4 | (i & 3);
+            fTable.set(&fEntries[i]);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        const uint32_t offset = fHits ? 0 : 8;
+        int found = 0;
+        for (int i = 0; i < loops; i++) {
+            for (int j = 0; j < kCount; j++) {
+                found += SkToBool(fTable.findOrNull(fEntries[j].fKey + offset));
+            }
+        }
+        SkASSERT(found == (fHits ? loops * kCount : 0));
+    }
+
+private:
+    static constexpr int kCount = 2048;
+
+    struct Entry {
+        uint32_t fKey;
+    };
+
+    struct Traits {
+        static uint32_t GetKey(const Entry* entry) { return entry->fKey; }
+        static uint32_t Hash(uint32_t key) { return SkChecksum::CheapMix(key); }
+    };
+
+    bool                   fHits;
+    SkString               fName;
+    SkAutoTMalloc<Entry>   fEntries;
+    typename Table::template Type<Entry*, uint32_t, Traits> fTable;
+
+    typedef Benchmark INHERITED;
+};
+
+struct UseTHashTable {
+    template <typename T, typename K, typename Traits> using Type = SkTHashTable<T, K, Traits>;
+};
+struct UseSwissTable {
+    template <typename T, typename K, typename Traits> using Type = SkTSwissTable<T, K, Traits>;
+};
+
+DEF_BENCH(return new HashTableFindBench<UseTHashTable>("thash", true);)
+DEF_BENCH(return new HashTableFindBench<UseTHashTable>("thash", false);)
+DEF_BENCH(return new HashTableFindBench<UseSwissTable>("swiss", true);)
+DEF_BENCH(return new HashTableFindBench<UseSwissTable>("swiss", false);)
@@ -10,9 +10,11 @@
 #include "SkBlurImageFilter.h"
 #include "SkCanvas.h"
 #include "SkDisplacementMapEffect.h"
+#include "SkDropShadowImageFilter.h"
 #include "SkImage.h"
 #include "SkMergeImageFilter.h"
 #include "SkOffsetImageFilter.h"
+#include "SkPaintImageFilter.h"
 #include "SkXfermodeImageFilter.h"
 
 // Exercise a blur filter connected to 5 inputs of the same merge filter.
@@ -144,7 +146,45 @@ private:
     typedef Benchmark INHERITED;
 };
 
+// Exercise the same drop-shadowed card drawn at a new whole-pixel scroll position every frame,
+// the way an animated UI would.  Nothing in the DAG reads the source, so once the first frame
+// is cached the rest should come straight out of the image filter cache.
+class ImageFilterScrolledShadowBench : public Benchmark {
+public:
+    ImageFilterScrolledShadowBench() {}
+
+protected:
+    const char* onGetName() override { return "image_filter_scrolled_shadow"; }
+
+    void onDelayedSetup() override {
+        SkPaint cardPaint;
+        cardPaint.setColor(SK_ColorWHITE);
+        SkImageFilter::CropRect cardRect(SkRect::MakeWH(200, 200));
+        fFilter = SkDropShadowImageFilter::Make(
+                4.0f, 4.0f, 10.0f, 10.0f, 0x80000000,
+                SkDropShadowImageFilter::kDrawShadowAndForeground_ShadowMode,
+                SkPaintImageFilter::Make(cardPaint, &cardRect));
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+        paint.setImageFilter(fFilter);
+        for (int j = 0; j < loops; j++) {
+            canvas->save();
+            canvas->translate(SkIntToScalar(j % 64), SkIntToScalar(j % 64));
+            canvas->drawRect(SkRect::MakeWH(200, 200), paint);
+            canvas->restore();
+        }
+    }
+
+private:
+    sk_sp<SkImageFilter> fFilter;
+
+    typedef Benchmark INHERITED;
+};
+
 DEF_BENCH(return new ImageFilterDAGBench;)
 DEF_BENCH(return new ImageMakeWithFilterDAGBench;)
 DEF_BENCH(return new ImageFilterDisplacedBlur;)
 DEF_BENCH(return new ImageFilterXfermodeIn;)
+DEF_BENCH(return new ImageFilterScrolledShadowBench;)
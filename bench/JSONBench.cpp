@@ -6,9 +6,11 @@
  */
 
 #include "Benchmark.h"
+#include "Resources.h"
 #include "SkData.h"
 #include "SkJSON.h"
 #include "SkStream.h"
+#include "Skottie.h"
 
 #if defined(SK_BUILD_FOR_ANDROID)
 static constexpr const char* kBenchFile = "/data/local/tmp/bench.json";
@@ -55,6 +57,69 @@ private:
 
 DEF_BENCH( return new JsonBench; )
 
+// Time to first frame for a Lottie animation: JSON parsing, scene graph and animator
+// construction, and the initial seek. The binary variants load a precompiled skjson image
+// (see skjson::DOM::writeBinary()) instead of the JSON text.
+class SkottieLoadBench : public Benchmark {
+public:
+    // Loads kBenchFile when |resource| is null.
+    explicit SkottieLoadBench(const char* resource, bool binary = false)
+        : fResource(resource)
+        , fBinary(binary)
+        , fName(SkStringPrintf("json_skottie_%s%s", binary ? "binary_" : "",
+                               resource ? resource : "file")) {}
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    void onPerCanvasPreDraw(SkCanvas*) override {
+        fData = fResource ? GetResourceAsData(SkStringPrintf("skottie/%s.json", fResource).c_str())
+                          : SkData::MakeFromFileName(kBenchFile);
+        if (!fData) {
+            SkDebugf("!! Could not open bench file: %s\n", fResource ? fResource : kBenchFile);
+        }
+        if (fData && fBinary) {
+            skjson::DOM dom(static_cast<const char*>(fData->data()), fData->size());
+            SkDynamicMemoryWStream stream;
+            fData = dom.writeBinary(&stream) ? stream.detachAsData() : nullptr;
+        }
+    }
+
+    void onPerCanvasPostDraw(SkCanvas*) override {
+        fData = nullptr;
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        if (!fData) return;
+
+        for (int i = 0; i < loops; i++) {
+            auto animation = skottie::Animation::Make(static_cast<const char*>(fData->data()),
+                                                      fData->size());
+            if (!animation) {
+                SkDebugf("!! Parsing failed.\n");
+                return;
+            }
+        }
+    }
+
+private:
+    const char*    fResource;
+    const bool     fBinary;
+    const SkString fName;
+    sk_sp<SkData>  fData;
+
+    using INHERITED = Benchmark;
+};
+
+DEF_BENCH( return new SkottieLoadBench(nullptr); )
+DEF_BENCH( return new SkottieLoadBench("skottie_sample_search"); )
+DEF_BENCH( return new SkottieLoadBench("skottie_sample_webfont"); )
+DEF_BENCH( return new SkottieLoadBench(nullptr, true); )
+DEF_BENCH( return new SkottieLoadBench("skottie_sample_search", true); )
+DEF_BENCH( return new SkottieLoadBench("skottie_sample_webfont", true); )
+
 #if (0)
 
 #include "rapidjson/document.h"
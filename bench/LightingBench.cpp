@@ -8,6 +8,7 @@
 #include "SkCanvas.h"
 #include "SkLightingImageFilter.h"
 #include "SkPoint3.h"
+#include "ThreadedBench.h"
 
 #define FILTER_WIDTH_SMALL  SkIntToScalar(32)
 #define FILTER_HEIGHT_SMALL SkIntToScalar(32)
@@ -244,3 +245,10 @@ DEF_BENCH( return new LightingDistantLitSpecularBench(true); )
 DEF_BENCH( return new LightingDistantLitSpecularBench(false); )
 DEF_BENCH( return new LightingSpotLitSpecularBench(true); )
 DEF_BENCH( return new LightingSpotLitSpecularBench(false); )
+
+DEF_BENCH( return new ThreadedBench(new LightingPointLitDiffuseBench(false)); )
+DEF_BENCH( return new ThreadedBench(new LightingDistantLitDiffuseBench(false)); )
+DEF_BENCH( return new ThreadedBench(new LightingSpotLitDiffuseBench(false)); )
+DEF_BENCH( return new ThreadedBench(new LightingPointLitSpecularBench(false)); )
+DEF_BENCH( return new ThreadedBench(new LightingDistantLitSpecularBench(false)); )
+DEF_BENCH( return new ThreadedBench(new LightingSpotLitSpecularBench(false)); )
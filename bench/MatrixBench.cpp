@@ -9,6 +9,9 @@
 #include "SkMatrixUtils.h"
 #include "SkRandom.h"
 #include "SkString.h"
+#include "SkTo.h"
+
+#include <vector>
 
 class MatrixBench : public Benchmark {
     SkString    fName;
@@ -269,27 +272,27 @@ DEF_BENCH( return new InvertMapRectMatrixBench(
 static SkMatrix make_trans() { return SkMatrix::MakeTrans(2, 3); }
 static SkMatrix make_scale() { SkMatrix m(make_trans()); m.postScale(1.5f, 0.5f); return m; }
 static SkMatrix make_afine() { SkMatrix m(make_trans()); m.postRotate(15); return m; }
+static SkMatrix make_persp() { SkMatrix m(make_afine()); m.setPerspX(0.001f); return m; }
 
 class MapPointsMatrixBench : public MatrixBench {
 protected:
     SkMatrix fM;
-    enum {
-        N = 32
-    };
-    SkPoint fSrc[N], fDst[N];
+    std::vector<SkPoint> fSrc, fDst;
 public:
-    MapPointsMatrixBench(const char name[], const SkMatrix& m)
-        : MatrixBench(name), fM(m)
+    // Maps the same total number of points whatever the batch size.
+    MapPointsMatrixBench(const char name[], const SkMatrix& m, int n = 32)
+        : MatrixBench(name), fM(m), fSrc(n), fDst(n)
     {
         SkRandom rand;
-        for (int i = 0; i < N; ++i) {
-            fSrc[i].set(rand.nextSScalar1(), rand.nextSScalar1());
+        for (SkPoint& pt : fSrc) {
+            pt.set(rand.nextSScalar1(), rand.nextSScalar1());
         }
     }
 
     void performTest() override {
-        for (int i = 0; i < 1000000; ++i) {
-            fM.mapPoints(fDst, fSrc, N);
+        const int n = SkToInt(fSrc.size());
+        for (int i = 0; i < 32000000 / n; ++i) {
+            fM.mapPoints(fDst.data(), fSrc.data(), n);
         }
     }
 };
@@ -297,6 +300,9 @@ DEF_BENCH( return new MapPointsMatrixBench("mappoints_identity", SkMatrix::I());
 DEF_BENCH( return new MapPointsMatrixBench("mappoints_trans", make_trans()); )
 DEF_BENCH( return new MapPointsMatrixBench("mappoints_scale", make_scale()); )
 DEF_BENCH( return new MapPointsMatrixBench("mappoints_affine", make_afine()); )
+DEF_BENCH( return new MapPointsMatrixBench("mappoints_persp", make_persp()); )
+DEF_BENCH( return new MapPointsMatrixBench("mappoints_affine_4096", make_afine(), 4096); )
+DEF_BENCH( return new MapPointsMatrixBench("mappoints_persp_4096", make_persp(), 4096); )
 
 ///////////////////////////////////////////////////////////////////////////////
 
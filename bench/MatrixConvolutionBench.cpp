@@ -10,6 +10,7 @@
 #include "SkPaint.h"
 #include "SkRandom.h"
 #include "SkString.h"
+#include "ThreadedBench.h"
 
 static const char* name(SkMatrixConvolutionImageFilter::TileMode mode) {
     switch (mode) {
@@ -68,3 +69,8 @@ DEF_BENCH( return new MatrixConvolutionBench(SkMatrixConvolutionImageFilter::kCl
 DEF_BENCH( return new MatrixConvolutionBench(SkMatrixConvolutionImageFilter::kRepeat_TileMode, true); )
 DEF_BENCH( return new MatrixConvolutionBench(SkMatrixConvolutionImageFilter::kClampToBlack_TileMode, true); )
 DEF_BENCH( return new MatrixConvolutionBench(SkMatrixConvolutionImageFilter::kClampToBlack_TileMode, false); )
+
+DEF_BENCH( return new ThreadedBench(
+        new MatrixConvolutionBench(SkMatrixConvolutionImageFilter::kClamp_TileMode, true)); )
+DEF_BENCH( return new ThreadedBench(
+        new MatrixConvolutionBench(SkMatrixConvolutionImageFilter::kRepeat_TileMode, true)); )
@@ -7,6 +7,7 @@
 
 #include "Benchmark.h"
 #include "SkBitmap.h"
+#include "SkExecutor.h"
 #include "SkMipMap.h"
 
 class MipMapBench: public Benchmark {
@@ -14,15 +15,20 @@ class MipMapBench: public Benchmark {
     SkString fName;
     const int fW, fH;
     bool fHalfFoat;
+    bool fThreaded;
+    std::unique_ptr<SkExecutor> fExecutor;
 
 public:
-    MipMapBench(int w, int h, bool halfFloat = false)
-        : fW(w), fH(h), fHalfFoat(halfFloat)
+    MipMapBench(int w, int h, bool halfFloat = false, bool threaded = false)
+        : fW(w), fH(h), fHalfFoat(halfFloat), fThreaded(threaded)
     {
         fName.printf("mipmap_build_%dx%d", w, h);
         if (halfFloat) {
             fName.append("_f16");
         }
+        if (threaded) {
+            fName.append("_threaded");
+        }
     }
 
 protected:
@@ -38,11 +44,14 @@ protected:
                                              SkColorSpace::MakeSRGB());
         fBitmap.allocPixels(info);
         fBitmap.eraseColor(SK_ColorWHITE);  // so we don't read uninitialized memory
+        if (fThreaded) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool();
+        }
     }
 
     void onDraw(int loops, SkCanvas*) override {
         for (int i = 0; i < loops * 4; i++) {
-            SkMipMap::Build(fBitmap, nullptr)->unref();
+            SkMipMap::Build(fBitmap, nullptr, fExecutor.get())->unref();
         }
     }
 
@@ -65,3 +74,7 @@ DEF_BENCH( return new MipMapBench(2048, 2048); )
 DEF_BENCH( return new MipMapBench(2047, 2047); )
 DEF_BENCH( return new MipMapBench(2048, 2047); )
 DEF_BENCH( return new MipMapBench(2047, 2048); )
+
+DEF_BENCH( return new MipMapBench(2048, 2048, false, true); )
+DEF_BENCH( return new MipMapBench(2047, 2047, false, true); )
+DEF_BENCH( return new MipMapBench(2048, 2048, true, true); )
@@ -12,6 +12,7 @@
 #include "SkRandom.h"
 #include "SkShader.h"
 #include "SkString.h"
+#include "ThreadedBench.h"
 
 #define SMALL   SkIntToScalar(2)
 #define REAL    1.5f
@@ -96,3 +97,6 @@ DEF_BENCH( return new MorphologyBench(REAL, kErode_MT); )
 DEF_BENCH( return new MorphologyBench(REAL, kDilate_MT); )
 
 DEF_BENCH( return new MorphologyBench(0, kErode_MT); )
+
+DEF_BENCH( return new ThreadedBench(new MorphologyBench(BIG, kErode_MT)); )
+DEF_BENCH( return new ThreadedBench(new MorphologyBench(BIG, kDilate_MT)); )
@@ -75,6 +75,7 @@ DEF_BENCH(return new PDFScalarBench("PDFScalar_random", next_any);)
 
 #ifdef SK_SUPPORT_PDF
 
+#include "SkDeflate.h"
 #include "SkPDFBitmap.h"
 #include "SkPDFDocumentPriv.h"
 #include "SkPDFShader.h"
@@ -183,6 +184,52 @@ private:
     std::unique_ptr<SkStreamAsset> fAsset;
 };
 
+/** Test DEFLATE on a few megabytes of PDF command stream, at a given compression level, and
+    optionally split into chunks compressed in parallel. */
+class PDFLargeCompressionBench : public Benchmark {
+public:
+    PDFLargeCompressionBench(SkPDF::Metadata::CompressionLevel level, bool parallel)
+        : fLevel(level), fParallel(parallel) {
+        fName.printf("PDFLargeCompression_%s%s",
+                     level == SkPDF::Metadata::CompressionLevel::Default ? "default" : "fast",
+                     parallel ? "_parallel" : "");
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+    void onDelayedSetup() override {
+        sk_sp<SkData> commands = GetResourceAsData("pdf_command_stream.txt");
+        if (!commands) { return; }
+        SkDynamicMemoryWStream buffer;
+        while (buffer.bytesWritten() < 4 * 1024 * 1024) {
+            buffer.write(commands->data(), commands->size());
+        }
+        fInput = buffer.detachAsData();
+        if (fParallel) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool();
+        }
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        SkASSERT(fInput);
+        if (!fInput) { return; }
+        while (loops-- > 0) {
+            SkNullWStream wStream;
+            SkDeflateWStream deflate(&wStream, (int)fLevel, false, fExecutor.get());
+            deflate.write(fInput->data(), fInput->size());
+        }
+    }
+
+private:
+    SkPDF::Metadata::CompressionLevel fLevel;
+    bool fParallel;
+    SkString fName;
+    sk_sp<SkData> fInput;
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+
 struct PDFColorComponentBench : public Benchmark {
     bool isSuitableFor(Backend b) override {
         return b == kNonRendering_Backend;
@@ -247,6 +294,10 @@ struct WritePDFTextBenchmark : public Benchmark {
 DEF_BENCH(return new PDFImageBench;)
 DEF_BENCH(return new PDFJpegImageBench;)
 DEF_BENCH(return new PDFCompressionBench;)
+DEF_BENCH(return new PDFLargeCompressionBench(SkPDF::Metadata::CompressionLevel::Default, false);)
+DEF_BENCH(return new PDFLargeCompressionBench(SkPDF::Metadata::CompressionLevel::Default, true);)
+DEF_BENCH(return new PDFLargeCompressionBench(SkPDF::Metadata::CompressionLevel::LowButFast, false);)
+DEF_BENCH(return new PDFLargeCompressionBench(SkPDF::Metadata::CompressionLevel::LowButFast, true);)
 DEF_BENCH(return new PDFColorComponentBench;)
 DEF_BENCH(return new PDFShaderBench;)
 DEF_BENCH(return new WritePDFTextBenchmark;)
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Benchmark.h"
+#include "SkParse.h"
+#include "SkParsePath.h"
+#include "SkPath.h"
+#include "SkRandom.h"
+#include "SkString.h"
+#include "random_parse_path.h"
+
+// Parses a large SVG path string, like those in SVGs exported from drawing tools.
+class ParsePathBench : public Benchmark {
+public:
+    ParsePathBench(int pieces) {
+        fName.printf("parsepath_%d", pieces);
+        SkRandom rand;
+        for (int i = 0; i < pieces; ++i) {
+            fSpec.append(MakeRandomParsePathPiece(&rand));
+        }
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            SkPath path;
+            SkParsePath::FromSVGString(fSpec.c_str(), &path);
+        }
+    }
+
+private:
+    SkString fName;
+    SkString fSpec;
+
+    typedef Benchmark INHERITED;
+};
+
+// Just the number scanning, e.g. as in an SVG polyline's points.
+class ParseScalarsBench : public Benchmark {
+public:
+    ParseScalarsBench() {
+        SkRandom rand;
+        for (int i = 0; i < kCount; ++i) {
+            fSpec.appendScalar(rand.nextRangeF(-1000, 1000));
+            fSpec.append(i & 1 ? " " : ",");
+        }
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return "parsescalars";
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            SkParse::FindScalars(fSpec.c_str(), fScalars, kCount);
+        }
+    }
+
+private:
+    static constexpr int kCount = 1000;
+
+    SkString fSpec;
+    SkScalar fScalars[kCount];
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new ParsePathBench(100); )
+DEF_BENCH( return new ParsePathBench(10000); )
+DEF_BENCH( return new ParseScalarsBench(); )
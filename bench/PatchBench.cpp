@@ -323,6 +323,89 @@ DEF_BENCH( return new LoopPatchBench(SkVector::Make(3.0f, 3.0f),
 DEF_BENCH( return new LoopPatchBench(SkVector::Make(3.0f, 3.0f),
                                         PatchBench::kBoth_VertexMode); )
 
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Draws a grid of patches like a mesh warp does, either the same grid every time (which the
+ * tessellation cache helps) or with its control points moving every time (which it can't).
+ */
+class PatchGridBench : public Benchmark {
+public:
+    PatchGridBench(int gridSize, bool animate, PatchBench::VertexMode vertexMode)
+    : fGridSize(gridSize)
+    , fAnimate(animate)
+    , fVertexMode(vertexMode) {
+        fName.printf("patch_grid_%d_%s%s", gridSize, animate ? "animated" : "static",
+                     vertexMode == PatchBench::kColors_VertexMode ? "_colors" : "_texs");
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    SkIPoint onGetSize() override { return SkIPoint::Make(512, 512); }
+
+    void onDelayedSetup() override {
+        if (fVertexMode == PatchBench::kTexCoords_VertexMode) {
+            const SkColor colors[] = { SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE };
+            const SkPoint pts[] = { { 0, 0 }, { 512, 512 } };
+            fPaint.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr,
+                                                          SK_ARRAY_COUNT(colors),
+                                                          SkShader::kMirror_TileMode));
+        }
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        const SkScalar cell = 512.f / fGridSize;
+        for (int i = 0; i < loops; i++) {
+            // Bow every cell's edges by an amount that changes each time when animating.
+            SkScalar bow = fAnimate ? cell * 0.25f * SkScalarSin(i * 0.1f) : cell * 0.25f;
+            for (int y = 0; y < fGridSize; ++y) {
+                for (int x = 0; x < fGridSize; ++x) {
+                    SkScalar l = x * cell, t = y * cell, r = l + cell, b = t + cell;
+                    SkScalar third = cell / 3;
+                    const SkPoint cubics[SkPatchUtils::kNumCtrlPts] = {
+                        // top
+                        {l, t}, {l + third, t + bow}, {r - third, t - bow}, {r, t},
+                        // right
+                        {r + bow, t + third}, {r - bow, b - third},
+                        // bottom
+                        {r, b}, {r - third, b - bow}, {l + third, b + bow}, {l, b},
+                        // left
+                        {l - bow, b - third}, {l + bow, t + third},
+                    };
+                    const SkColor colors[SkPatchUtils::kNumCorners] = {
+                        SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE, SK_ColorCYAN
+                    };
+                    const SkPoint texCoords[SkPatchUtils::kNumCorners] = {
+                        {l, t}, {r, t}, {r, b}, {l, b}
+                    };
+                    if (fVertexMode == PatchBench::kColors_VertexMode) {
+                        canvas->drawPatch(cubics, colors, nullptr, fPaint);
+                    } else {
+                        canvas->drawPatch(cubics, nullptr, texCoords, fPaint);
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    SkString               fName;
+    SkPaint                fPaint;
+    int                    fGridSize;
+    bool                   fAnimate;
+    PatchBench::VertexMode fVertexMode;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new PatchGridBench(8, false, PatchBench::kColors_VertexMode); )
+DEF_BENCH( return new PatchGridBench(8, true, PatchBench::kColors_VertexMode); )
+DEF_BENCH( return new PatchGridBench(32, false, PatchBench::kColors_VertexMode); )
+DEF_BENCH( return new PatchGridBench(32, true, PatchBench::kColors_VertexMode); )
+DEF_BENCH( return new PatchGridBench(32, false, PatchBench::kTexCoords_VertexMode); )
+DEF_BENCH( return new PatchGridBench(32, true, PatchBench::kTexCoords_VertexMode); )
+
 //////////////////////////////////////////////
 #include "SkPatchUtils.h"
 
@@ -6,6 +6,7 @@
  */
 
 #include "Benchmark.h"
+#include "SkExecutor.h"
 #include "SkPath.h"
 #include "SkPathOps.h"
 #include "SkRandom.h"
@@ -96,3 +97,69 @@ static SkPath makerects() {
 }
 
 DEF_BENCH( return new PathOpsSimplifyBench("rects", makerects()); )
+
+// A single contour with many segments, few of whose bounds overlap.
+static SkPath makezigzag() {
+    SkPath path;
+    path.moveTo(0, 0);
+    for (int i = 1; i < 500; ++i) {
+        path.lineTo(i, (i & 1) ? 10 : 0);
+    }
+    path.lineTo(500, 20);
+    path.lineTo(0, 20);
+    path.close();
+    return path;
+}
+
+DEF_BENCH( return new PathOpsSimplifyBench("zigzag", makezigzag()); )
+
+// Unions many small, mostly separate shapes, like a map's parcels, with an SkOpBuilder.
+class PathOpsBuilderIslandsBench : public Benchmark {
+    SkString                    fName;
+    SkTArray<SkPath>            fPaths;
+    std::unique_ptr<SkExecutor> fExecutor;
+
+public:
+    PathOpsBuilderIslandsBench(int islands, bool threaded) {
+        fName.printf("pathops_builder_islands_%d%s", islands, threaded ? "_threaded" : "");
+
+        SkRandom rand;
+        SkScalar extent = 20 * SkScalarSqrt(islands);
+        for (int i = 0; i < islands; ++i) {
+            SkScalar x = rand.nextUScalar1() * extent;
+            SkScalar y = rand.nextUScalar1() * extent;
+            fPaths.push_back().addCircle(x, y, 3 + rand.nextUScalar1() * 4);
+            fPaths.push_back().addRect({x, y, x + 8, y + 3});
+        }
+        if (threaded) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool();
+        }
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int i = 0; i < loops; i++) {
+            SkOpBuilder builder;
+            for (const SkPath& path : fPaths) {
+                builder.add(path, kUnion_SkPathOp);
+            }
+            SkPath result;
+            builder.resolve(&result, fExecutor.get());
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new PathOpsBuilderIslandsBench(100, false); )
+DEF_BENCH( return new PathOpsBuilderIslandsBench(1000, false); )
+DEF_BENCH( return new PathOpsBuilderIslandsBench(1000, true); )
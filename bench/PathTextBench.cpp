@@ -7,6 +7,7 @@
 
 #include "Benchmark.h"
 #include "SkCanvas.h"
+#include "SkFont.h"
 #include "SkPaint.h"
 #include "SkPath.h"
 #include "SkRandom.h"
@@ -107,3 +108,35 @@ private:
 DEF_BENCH(return new PathTextBench(false, false);)
 DEF_BENCH(return new PathTextBench(false, true);)
 DEF_BENCH(return new PathTextBench(true, true);)
+
+/*
+ * This class benchmarks drawing headline text too big for glyph masks, with the strike cache
+ * purged before every frame so each frame's paths have to be regenerated. Each line is drawn
+ * with a different width and slant, so each has a path strike of its own.
+ */
+class PathTextHeadlineBench : public Benchmark {
+private:
+    const char* onGetName() override { return "path_text_headline"; }
+    SkIPoint onGetSize() override { return SkIPoint::Make(kScreenWidth, kScreenHeight); }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        for (int loop = 0; loop < loops; ++loop) {
+            SkStrikeCache::PurgeAll();
+            for (int line = 0; line < kNumLines; ++line) {
+                SkFont font(nullptr, 300);
+                font.setScaleX(1 - line / (4.0f * kNumLines));
+                font.setSkewX(-line / (2.0f * kNumLines));
+                canvas->drawSimpleText(kGlyphs, kNumGlyphs, kUTF8_SkTextEncoding,
+                                       10, (line + 1) * 150.0f, font, paint);
+            }
+        }
+    }
+
+    static constexpr int kNumLines = 8;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH(return new PathTextHeadlineBench;)
@@ -7,6 +7,7 @@
 #include "Benchmark.h"
 #include "SkCanvas.h"
 #include "SkColor.h"
+#include "SkExecutor.h"
 #include "SkPaint.h"
 #include "SkPicture.h"
 #include "SkPictureRecorder.h"
@@ -14,6 +15,7 @@
 #include "SkRandom.h"
 #include "SkRect.h"
 #include "SkString.h"
+#include "SkThreadedPicturePlayback.h"
 
 // This is designed to emulate about 4 screens of textual content
 
@@ -95,3 +97,59 @@ DEF_BENCH( return new TiledPlaybackBench(kNone,     kRandom); )
 DEF_BENCH( return new TiledPlaybackBench(kNone,     kTiled ); )
 DEF_BENCH( return new TiledPlaybackBench(kRTree,    kRandom); )
 DEF_BENCH( return new TiledPlaybackBench(kRTree,    kTiled ); )
+
+// Plays back the whole picture at once with SkThreadedPicturePlayback,
+// to track how playback scales with the number of threads.
+class ThreadedPlaybackBench : public Benchmark {
+public:
+    ThreadedPlaybackBench(BBH bbh, int threads) : fBBH(bbh), fThreads(threads) {
+        fName.printf("threaded_playback_%s_%d", fBBH == kRTree ? "rtree" : "none", fThreads);
+    }
+
+    const char* onGetName() override { return fName.c_str(); }
+    SkIPoint onGetSize() override { return SkIPoint::Make(1024,1024); }
+    bool isSuitableFor(Backend backend) override { return backend == kRaster_Backend; }
+
+    void onDelayedSetup() override {
+        fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+
+        std::unique_ptr<SkBBHFactory> factory;
+        if (fBBH == kRTree) {
+            factory.reset(new SkRTreeFactory);
+        }
+
+        SkPictureRecorder recorder;
+        SkCanvas* canvas = recorder.beginRecording(1024, 1024, factory.get());
+            SkRandom rand;
+            for (int i = 0; i < 10000; i++) {
+                SkScalar x = rand.nextRangeScalar(0, 1024),
+                         y = rand.nextRangeScalar(0, 1024),
+                         w = rand.nextRangeScalar(0, 128),
+                         h = rand.nextRangeScalar(0, 128);
+                SkPaint paint;
+                paint.setColor(rand.nextU());
+                paint.setAntiAlias(true);
+                canvas->drawOval(SkRect::MakeXYWH(x,y,w,h), paint);
+            }
+        fPic = recorder.finishRecordingAsPicture();
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int i = 0; i < loops; i++) {
+            SkThreadedPicturePlayback(fPic.get(), canvas, fExecutor.get());
+        }
+    }
+
+private:
+    BBH                         fBBH;
+    int                         fThreads;
+    SkString                    fName;
+    sk_sp<SkPicture>            fPic;
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+
+DEF_BENCH( return new ThreadedPlaybackBench(kNone,  1); )
+DEF_BENCH( return new ThreadedPlaybackBench(kRTree, 1); )
+DEF_BENCH( return new ThreadedPlaybackBench(kRTree, 2); )
+DEF_BENCH( return new ThreadedPlaybackBench(kRTree, 4); )
+DEF_BENCH( return new ThreadedPlaybackBench(kRTree, 8); )
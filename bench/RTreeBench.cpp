@@ -53,6 +53,45 @@ private:
     typedef Benchmark INHERITED;
 };
 
+// Time how long it takes to build an R-Tree by inserting into it in batches.
+class RTreeIncrementalBuildBench : public Benchmark {
+public:
+    RTreeIncrementalBuildBench(const char* name, MakeRectProc proc) : fProc(proc) {
+        fName.printf("rtree_%s_incremental_build", name);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+    void onDraw(int loops, SkCanvas* canvas) override {
+        static const int kBatches = 10;
+        static_assert(NUM_BUILD_RECTS % kBatches == 0, "");
+
+        SkRandom rand;
+        SkAutoTMalloc<SkRect> rects(NUM_BUILD_RECTS);
+        for (int i = 0; i < NUM_BUILD_RECTS; ++i) {
+            rects[i] = fProc(rand, i, NUM_BUILD_RECTS);
+        }
+
+        for (int i = 0; i < loops; ++i) {
+            SkRTree tree;
+            for (int j = 0; j < kBatches; ++j) {
+                const int batch = NUM_BUILD_RECTS / kBatches;
+                tree.insert(rects.get() + j * batch, batch);
+            }
+        }
+    }
+private:
+    MakeRectProc fProc;
+    SkString fName;
+    typedef Benchmark INHERITED;
+};
+
 // Time how long it takes to perform queries on an R-Tree.
 class RTreeQueryBench : public Benchmark {
 public:
@@ -132,6 +171,9 @@ DEF_BENCH(return new RTreeBuildBench("YX", &make_YXordered_rects));
 DEF_BENCH(return new RTreeBuildBench("random", &make_random_rects));
 DEF_BENCH(return new RTreeBuildBench("concentric", &make_concentric_rects));
 
+DEF_BENCH(return new RTreeIncrementalBuildBench("XY", &make_XYordered_rects));
+DEF_BENCH(return new RTreeIncrementalBuildBench("random", &make_random_rects));
+
 DEF_BENCH(return new RTreeQueryBench("XY", &make_XYordered_rects));
 DEF_BENCH(return new RTreeQueryBench("YX", &make_YXordered_rects));
 DEF_BENCH(return new RTreeQueryBench("random", &make_random_rects));
@@ -10,6 +10,9 @@
 #include "SkLiteDL.h"
 #include "SkLiteRecorder.h"
 #include "SkPictureRecorder.h"
+#include "SkRecord.h"
+#include "SkRecordOpts.h"
+#include "SkRecorder.h"
 
 PictureCentricBench::PictureCentricBench(const char* name, const SkPicture* pic) : fName(name) {
     // Flatten the source picture in case it's trivially nested (useless for timing).
@@ -66,12 +69,43 @@ void RecordingBench::onDraw(int loops, SkCanvas*) {
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+RecordOptimizeBench::RecordOptimizeBench(const char* name, const SkPicture* pic,
+                                         bool experimental)
+    : INHERITED(name, pic)
+    , fExperimental(experimental)
+{
+    fName.append(experimental ? "_optimize2" : "_optimize");
+
+    SkRecord record;
+    this->record(&record);
+    fOpsBefore = record.count();
+    fExperimental ? SkRecordOptimize2(&record) : SkRecordOptimize(&record);
+    fOpsAfter = record.count();
+}
+
+void RecordOptimizeBench::record(SkRecord* record) const {
+    SkRecorder recorder(record, fSrc->cullRect());
+    fSrc->playback(&recorder);
+}
+
+void RecordOptimizeBench::onDraw(int loops, SkCanvas*) {
+    while (loops --> 0) {
+        SkRecord record;
+        this->record(&record);
+        fExperimental ? SkRecordOptimize2(&record) : SkRecordOptimize(&record);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 #include "SkSerialProcs.h"
 
-DeserializePictureBench::DeserializePictureBench(const char* name, sk_sp<SkData> data)
+DeserializePictureBench::DeserializePictureBench(const char* name, sk_sp<SkData> data,
+                                                 bool shared)
     : fName(name)
     , fEncodedPicture(std::move(data))
+    , fShared(shared)
 {}
 
 const char* DeserializePictureBench::onGetName() {
@@ -88,6 +122,10 @@ SkIPoint DeserializePictureBench::onGetSize() {
 
 void DeserializePictureBench::onDraw(int loops, SkCanvas*) {
     for (int i = 0; i < loops; ++i) {
-        SkPicture::MakeFromData(fEncodedPicture.get());
+        if (fShared) {
+            SkPicture::MakeFromSharedData(fEncodedPicture);
+        } else {
+            SkPicture::MakeFromData(fEncodedPicture.get());
+        }
     }
 }
@@ -12,6 +12,8 @@
 #include "SkPicture.h"
 #include "SkLiteDL.h"
 
+class SkRecord;
+
 class PictureCentricBench : public Benchmark {
 public:
     PictureCentricBench(const char* name, const SkPicture*);
@@ -42,9 +44,32 @@ private:
     typedef PictureCentricBench INHERITED;
 };
 
+// Records the picture into an SkRecord and runs SkRecordOptimize (or SkRecordOptimize2 when
+// experimental) over it.  The time includes recording, so compare the two optimizers' benches.
+class RecordOptimizeBench : public PictureCentricBench {
+public:
+    RecordOptimizeBench(const char* name, const SkPicture*, bool experimental);
+
+    // Op counts of the recorded picture before and after optimizing it.
+    int opsBefore() const { return fOpsBefore; }
+    int opsAfter()  const { return fOpsAfter;  }
+
+protected:
+    void onDraw(int loops, SkCanvas*) override;
+
+private:
+    void record(SkRecord*) const;
+
+    bool fExperimental;
+    int  fOpsBefore;
+    int  fOpsAfter;
+
+    typedef PictureCentricBench INHERITED;
+};
+
 class DeserializePictureBench : public Benchmark {
 public:
-    DeserializePictureBench(const char* name, sk_sp<SkData> encodedPicture);
+    DeserializePictureBench(const char* name, sk_sp<SkData> encodedPicture, bool shared);
 
 protected:
     const char* onGetName() override;
@@ -55,6 +80,7 @@ protected:
 private:
     SkString      fName;
     sk_sp<SkData> fEncodedPicture;
+    bool          fShared;
 
     typedef Benchmark INHERITED;
 };
@@ -34,6 +34,13 @@ static bool diffrectbig_proc(SkRegion& a, SkRegion& b) {
     return result.op(a, a.getBounds(), SkRegion::kDifference_Op);
 }
 
+static bool sectrect_proc(SkRegion& a, SkRegion& b) {
+    SkIRect r = a.getBounds();
+    r.inset(r.width()/4, r.height()/4);
+    SkRegion result;
+    return result.op(a, r, SkRegion::kIntersect_Op);
+}
+
 static bool containsrect_proc(SkRegion& a, SkRegion& b) {
     SkIRect r = a.getBounds();
     r.inset(r.width()/4, r.height()/4);
@@ -125,6 +132,7 @@ DEF_BENCH(return new RegionBench(SMALL, sect_proc, "intersect");)
 DEF_BENCH(return new RegionBench(SMALL, diff_proc, "difference");)
 DEF_BENCH(return new RegionBench(SMALL, diffrect_proc, "differencerect");)
 DEF_BENCH(return new RegionBench(SMALL, diffrectbig_proc, "differencerectbig");)
+DEF_BENCH(return new RegionBench(SMALL, sectrect_proc, "intersectrect");)
 DEF_BENCH(return new RegionBench(SMALL, containsrect_proc, "containsrect");)
 DEF_BENCH(return new RegionBench(SMALL, sectsrgn_proc, "intersectsrgn");)
 DEF_BENCH(return new RegionBench(SMALL, sectsrect_proc, "intersectsrect");)
@@ -33,18 +33,42 @@ static void draw_into_bitmap(const SkBitmap& bm) {
 }
 
 class RepeatTileBench : public Benchmark {
-    const SkAlphaType   fAlphaType;
-    SkPaint             fPaint;
-    SkString            fName;
-    SkBitmap            fBitmap;
 public:
-    RepeatTileBench(SkColorType ct, SkAlphaType at = kPremul_SkAlphaType) : fAlphaType(at) {
+    enum class Transform {
+        kNone,
+        kRotate,
+        kPerspective,
+    };
+
+private:
+    const SkAlphaType        fAlphaType;
+    const SkShader::TileMode fTileMode;
+    const Transform          fTransform;
+    SkPaint                  fPaint;
+    SkString                 fName;
+    SkBitmap                 fBitmap;
+public:
+    RepeatTileBench(SkColorType ct, SkAlphaType at = kPremul_SkAlphaType,
+                    SkShader::TileMode tileMode = SkShader::kRepeat_TileMode,
+                    Transform transform = Transform::kNone)
+        : fAlphaType(at)
+        , fTileMode(tileMode)
+        , fTransform(transform) {
+        // 50 isn't a power of two, so none of this can be done with masks.
         const int w = 50;
         const int h = 50;
 
         fBitmap.setInfo(SkImageInfo::Make(w, h, ct, at));
         fName.printf("repeatTile_%s_%c",
                      sk_tool_utils::colortype_name(ct), kOpaque_SkAlphaType == at ? 'X' : 'A');
+        if (SkShader::kMirror_TileMode == tileMode) {
+            fName.append("_mirror");
+        }
+        switch (transform) {
+            case Transform::kNone:                                break;
+            case Transform::kRotate:      fName.append("_rotate"); break;
+            case Transform::kPerspective: fName.append("_persp");  break;
+        }
     }
 
 protected:
@@ -58,9 +82,7 @@ protected:
 
         draw_into_bitmap(fBitmap);
 
-        fPaint.setShader(SkShader::MakeBitmapShader(fBitmap,
-                                                    SkShader::kRepeat_TileMode,
-                                                    SkShader::kRepeat_TileMode));
+        fPaint.setShader(SkShader::MakeBitmapShader(fBitmap, fTileMode, fTileMode));
     }
 
 
@@ -68,6 +90,22 @@ protected:
         SkPaint paint(fPaint);
         this->setupPaint(&paint);
 
+        switch (fTransform) {
+            case Transform::kNone:
+                break;
+            case Transform::kRotate:
+                canvas->rotate(15);
+                break;
+            case Transform::kPerspective: {
+                SkMatrix persp;
+                persp.setAll(1, 0, 0,
+                             0, 1, 0,
+                             SK_Scalar1 / 2000, SK_Scalar1 / 4000, 1);
+                canvas->concat(persp);
+                break;
+            }
+        }
+
         for (int i = 0; i < loops; i++) {
             canvas->drawPaint(paint);
         }
@@ -80,3 +118,15 @@ private:
 DEF_BENCH(return new RepeatTileBench(kN32_SkColorType, kOpaque_SkAlphaType))
 DEF_BENCH(return new RepeatTileBench(kN32_SkColorType, kPremul_SkAlphaType))
 DEF_BENCH(return new RepeatTileBench(kRGB_565_SkColorType, kOpaque_SkAlphaType))
+
+DEF_BENCH(return new RepeatTileBench(kN32_SkColorType, kPremul_SkAlphaType,
+                                     SkShader::kMirror_TileMode))
+DEF_BENCH(return new RepeatTileBench(kN32_SkColorType, kPremul_SkAlphaType,
+                                     SkShader::kRepeat_TileMode,
+                                     RepeatTileBench::Transform::kRotate))
+DEF_BENCH(return new RepeatTileBench(kN32_SkColorType, kPremul_SkAlphaType,
+                                     SkShader::kRepeat_TileMode,
+                                     RepeatTileBench::Transform::kPerspective))
+DEF_BENCH(return new RepeatTileBench(kN32_SkColorType, kPremul_SkAlphaType,
+                                     SkShader::kMirror_TileMode,
+                                     RepeatTileBench::Transform::kPerspective))
@@ -9,6 +9,7 @@
 #include "SkCommandLineFlags.h"
 #include "SkMultiPictureDraw.h"
 #include "SkSurface.h"
+#include "SkThreadedPicturePlayback.h"
 
 #include "GrContext.h"
 #include "GrContextPriv.h"
@@ -21,17 +22,22 @@ DEFINE_int32(GPUbenchTileW, 1600, "Tile width  used for GPU SKP playback.");
 DEFINE_int32(GPUbenchTileH, 512, "Tile height used for GPU SKP playback.");
 
 SKPBench::SKPBench(const char* name, const SkPicture* pic, const SkIRect& clip, SkScalar scale,
-                   bool useMultiPictureDraw, bool doLooping)
+                   bool useMultiPictureDraw, bool doLooping, int threads)
     : fPic(SkRef(pic))
     , fClip(clip)
     , fScale(scale)
     , fName(name)
     , fUseMultiPictureDraw(useMultiPictureDraw)
-    , fDoLooping(doLooping) {
+    , fDoLooping(doLooping)
+    , fThreads(threads) {
     fUniqueName.printf("%s_%.2g", name, scale);  // Scale makes this unqiue for perf.skia.org traces.
     if (useMultiPictureDraw) {
         fUniqueName.append("_mpd");
     }
+    if (fThreads > 0) {
+        fUniqueName.appendf("_threads%d", fThreads);
+        fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+    }
 }
 
 SKPBench::~SKPBench() {
@@ -49,6 +55,11 @@ const char* SKPBench::onGetUniqueName() {
 }
 
 void SKPBench::onPerCanvasPreDraw(SkCanvas* canvas) {
+    if (fExecutor) {
+        // Threaded playback tiles and draws straight into the bench canvas.
+        return;
+    }
+
     SkIRect bounds = canvas->getDeviceClipBounds();
     SkAssertResult(!bounds.isEmpty());
 
@@ -99,6 +110,9 @@ void SKPBench::onPerCanvasPostDraw(SkCanvas* canvas) {
 }
 
 bool SKPBench::isSuitableFor(Backend backend) {
+    if (fExecutor) {
+        return backend == kRaster_Backend;
+    }
     return backend != kNonRendering_Backend;
 }
 
@@ -109,7 +123,12 @@ SkIPoint SKPBench::onGetSize() {
 void SKPBench::onDraw(int loops, SkCanvas* canvas) {
     SkASSERT(fDoLooping || 1 == loops);
     while (1) {
-        if (fUseMultiPictureDraw) {
+        if (fExecutor) {
+            SkAutoCanvasRestore acr(canvas, true);
+            canvas->scale(fScale, fScale);
+            SkThreadedPicturePlayback(fPic.get(), canvas, fExecutor.get(),
+                                      FLAGS_CPUbenchTileW, FLAGS_CPUbenchTileH);
+        } else if (fUseMultiPictureDraw) {
             this->drawMPDPicture();
         } else {
             this->drawPicture();
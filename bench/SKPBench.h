@@ -10,6 +10,7 @@
 
 #include "Benchmark.h"
 #include "SkCanvas.h"
+#include "SkExecutor.h"
 #include "SkPicture.h"
 #include "SkTDArray.h"
 
@@ -17,11 +18,13 @@ class SkSurface;
 
 /**
  * Runs an SkPicture as a benchmark by repeatedly drawing it scaled inside a device clip.
+ * If threads > 0, the picture is instead played back on the CPU with SkThreadedPicturePlayback
+ * using that many threads.
  */
 class SKPBench : public Benchmark {
 public:
     SKPBench(const char* name, const SkPicture*, const SkIRect& devClip, SkScalar scale,
-             bool useMultiPictureDraw, bool doLooping);
+             bool useMultiPictureDraw, bool doLooping, int threads = 0);
     ~SKPBench() override;
 
     int calculateLoops(int defaultLoops) const override {
@@ -59,6 +62,9 @@ private:
 
     const bool fDoLooping;
 
+    const int fThreads;
+    std::unique_ptr<SkExecutor> fExecutor;  // for threaded playback
+
     typedef Benchmark INHERITED;
 };
 
@@ -9,6 +9,7 @@
 #include "SkDrawShadowInfo.h"
 #include "SkPaint.h"
 #include "SkPath.h"
+#include "SkRRect.h"
 #include "SkShadowUtils.h"
 
 class ShadowBench : public Benchmark {
@@ -103,3 +104,100 @@ DEF_BENCH(return new ShadowBench(false, true);)
 DEF_BENCH(return new ShadowBench(true, false);)
 DEF_BENCH(return new ShadowBench(true, true);)
 
+
+// Draws one path's shadow at a handful of elevations while it scrolls, the way a list of
+// cards would, forcing tessellation so that we measure how well the cache reuses it.
+class ShadowCacheBench : public Benchmark {
+public:
+    ShadowCacheBench() {}
+
+protected:
+    enum {
+        kNumElevations = 4,
+    };
+
+    const char* onGetName() override { return "shadows_cache_scroll"; }
+
+    void onDelayedSetup() override {
+        fPath.addRRect(SkRRect::MakeRectXY(SkRect::MakeWH(300, 80), 8, 8));
+        fRec.fLightPos = SkPoint3::Make(270, 0, 600);
+        fRec.fLightRadius = 800;
+        fRec.fAmbientColor = 0x19000000;
+        fRec.fSpotColor = 0x40000000;
+        fRec.fFlags = SkShadowFlags::kTransparentOccluder_ShadowFlag |
+                      SkShadowFlags::kGeometricOnly_ShadowFlag;
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int i = 0; i < loops; ++i) {
+            fRec.fZPlaneParams = SkPoint3::Make(0, 0, 2.0f + 4.0f * (i % kNumElevations));
+            canvas->save();
+            canvas->translate(20, (i * 7) % 400);
+            canvas->private_draw_shadow_rec(fPath, fRec);
+            canvas->restore();
+        }
+    }
+
+private:
+    SkPath          fPath;
+    SkDrawShadowRec fRec;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH(return new ShadowCacheBench;)
+
+// Draws the analytic shadows of a screenful of small cards every frame, the way a list or grid of
+// material cards would, so that the cost per shadow dominates.
+class ShadowManyCardsBench : public Benchmark {
+public:
+    ShadowManyCardsBench() {}
+
+protected:
+    enum {
+        kCardWidth = 24,
+        kCardHeight = 16,
+        kCardRadius = 3,
+        kCardSpace = 6,
+        kCardsX = 20,
+        kCardsY = 16,
+        kNumCards = kCardsX * kCardsY,
+        kNumElevations = 3,
+    };
+
+    const char* onGetName() override { return "shadows_many_cards"; }
+
+    void onDelayedSetup() override {
+        for (int y = 0; y < kCardsY; ++y) {
+            for (int x = 0; x < kCardsX; ++x) {
+                SkRect rect = SkRect::MakeXYWH(kCardSpace + x * (kCardWidth + kCardSpace),
+                                               kCardSpace + y * (kCardHeight + kCardSpace),
+                                               kCardWidth, kCardHeight);
+                fCards[y * kCardsX + x].addRRect(SkRRect::MakeRectXY(rect, kCardRadius,
+                                                                     kCardRadius));
+            }
+        }
+        fRec.fLightPos = SkPoint3::Make(320, 0, 600);
+        fRec.fLightRadius = 800;
+        fRec.fAmbientColor = 0x19000000;
+        fRec.fSpotColor = 0x40000000;
+        fRec.fFlags = 0;
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int i = 0; i < loops; ++i) {
+            for (int j = 0; j < kNumCards; ++j) {
+                fRec.fZPlaneParams = SkPoint3::Make(0, 0, 2.0f + 4.0f * (j % kNumElevations));
+                canvas->private_draw_shadow_rec(fCards[j], fRec);
+            }
+        }
+    }
+
+private:
+    SkPath          fCards[kNumCards];
+    SkDrawShadowRec fRec;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH(return new ShadowManyCardsBench;)
@@ -10,6 +10,7 @@
 
 #include "Benchmark.h"
 #include "SkCanvas.h"
+#include "SkExecutor.h"
 #include "SkStrikeCache.h"
 #include "SkGraphics.h"
 #include "SkTaskGroup.h"
@@ -38,6 +39,27 @@ static void do_font_stuff(SkFont* font) {
     }
 }
 
+static void do_shared_font_stuff(SkFont* font) {
+    SkPaint defaultPaint;
+    for (SkScalar i = 8; i < 64; i++) {
+        font->setSize(i);
+        auto strike = SkStrikeCache::FindOrCreateSharedStrike(
+                *font,  defaultPaint, SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+                SkScalerContextFlags::kNone, SkMatrix::I());
+        uint16_t glyphs['z'];
+        for (int c = ' '; c < 'z'; c++) {
+            glyphs[c] = font->unicharToGlyph(c);
+        }
+        for (int lookups = 0; lookups < 10; lookups++) {
+            for (int c = ' '; c < 'z'; c++) {
+                const SkGlyph& g = strike.getGlyphMetrics(glyphs[c], {0, 0});
+                strike.findImage(g);
+            }
+        }
+
+    }
+}
+
 class SkGlyphCacheBasic : public Benchmark {
 public:
     explicit SkGlyphCacheBasic(size_t cacheSize) : fCacheSize(cacheSize) { }
@@ -111,7 +133,132 @@ private:
     SkString fName;
 };
 
+// Every thread draws the same font, which is where exclusive strikes hurt the most: each thread
+// either waits for or duplicates the others' strikes. Compare exclusive and shared strikes.
+class SkGlyphCacheSameFontThreads : public Benchmark {
+public:
+    SkGlyphCacheSameFontThreads(int threads, bool shared) : fThreads(threads), fShared(shared) {
+        fName.printf("SkGlyphCacheSameFont_%s_%d", fShared ? "shared" : "exclusive", fThreads);
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        fTypeface = sk_tool_utils::create_portable_typeface("serif", SkFontStyle::Italic());
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int work = 0; work < loops; work++) {
+            SkTaskGroup(*fExecutor).batch(fThreads, [&](int) {
+                SkFont font;
+                font.setEdging(SkFont::Edging::kAntiAlias);
+                font.setSubpixel(true);
+                font.setTypeface(fTypeface);
+                if (fShared) {
+                    do_shared_font_stuff(&font);
+                } else {
+                    do_font_stuff(&font);
+                }
+            });
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+    const int fThreads;
+    const bool fShared;
+    SkString fName;
+    std::unique_ptr<SkExecutor> fExecutor;
+    sk_sp<SkTypeface> fTypeface;
+};
+
+// Fills freshly purged strikes, as the first paint of a page does, rasterizing each strike's
+// glyphs one at a time or as a batch. Framed glyphs are scan converted from their paths, which
+// a batch spreads across a thread pool.
+class SkGlyphCacheColdImages : public Benchmark {
+public:
+    SkGlyphCacheColdImages(bool batched, bool framed) : fBatched(batched), fFramed(framed) {
+        fName.printf("SkGlyphCacheColdImages_%s%s",
+                     fBatched ? "batched" : "single", fFramed ? "_framed" : "");
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        fExecutor = SkExecutor::MakeFIFOThreadPool();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkFont font;
+        font.setEdging(SkFont::Edging::kAntiAlias);
+        SkPaint paint;
+        if (fFramed) {
+            paint.setStyle(SkPaint::kStroke_Style);
+            paint.setStrokeWidth(1);
+        }
+        SkGlyphID glyphIDs['z' - ' '];
+        for (int c = ' '; c < 'z'; c++) {
+            glyphIDs[c - ' '] = font.unicharToGlyph(c);
+        }
+
+        for (int loop = 0; loop < loops; loop++) {
+            SkStrikeCache::PurgeAll();
+            for (SkScalar size = 8; size < 64; size++) {
+                font.setSize(size);
+                auto strike = SkStrikeCache::FindOrCreateSharedStrike(
+                        font, paint, SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+                        SkScalerContextFlags::kNone, SkMatrix::I());
+                const SkGlyph* glyphs[SK_ARRAY_COUNT(glyphIDs)];
+                for (size_t i = 0; i < SK_ARRAY_COUNT(glyphIDs); i++) {
+                    glyphs[i] = &strike.getGlyphMetrics(glyphIDs[i], {0, 0});
+                }
+                if (fBatched) {
+                    strike.prepareImages(glyphs, fExecutor.get());
+                } else {
+                    for (const SkGlyph* glyph : glyphs) {
+                        strike.findImage(*glyph);
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+    const bool fBatched;
+    const bool fFramed;
+    SkString fName;
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+
 DEF_BENCH( return new SkGlyphCacheBasic(256 * 1024); )
 DEF_BENCH( return new SkGlyphCacheBasic(32 * 1024 * 1024); )
 DEF_BENCH( return new SkGlyphCacheStressTest(256 * 1024); )
 DEF_BENCH( return new SkGlyphCacheStressTest(32 * 1024 * 1024); )
+
+DEF_BENCH( return new SkGlyphCacheSameFontThreads(1, false); )
+DEF_BENCH( return new SkGlyphCacheSameFontThreads(1, true ); )
+DEF_BENCH( return new SkGlyphCacheSameFontThreads(4, false); )
+DEF_BENCH( return new SkGlyphCacheSameFontThreads(4, true ); )
+DEF_BENCH( return new SkGlyphCacheSameFontThreads(8, false); )
+DEF_BENCH( return new SkGlyphCacheSameFontThreads(8, true ); )
+
+DEF_BENCH( return new SkGlyphCacheColdImages(false, false); )
+DEF_BENCH( return new SkGlyphCacheColdImages(true,  false); )
+DEF_BENCH( return new SkGlyphCacheColdImages(false, true ); )
+DEF_BENCH( return new SkGlyphCacheColdImages(true,  true ); )
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Benchmark.h"
+#include "SkRasterPipeline.h"
+
+// Compares the fused linear_2_stop_gradient stage to the stages it replaces.
+class SkRasterPipelineLinearGradientBench : public Benchmark {
+public:
+    SkRasterPipelineLinearGradientBench(bool fused) : fFused(fused) {}
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    const char* onGetName() override {
+        return fFused ? "SkRasterPipeline_linear_2_stop_gradient_fused"
+                      : "SkRasterPipeline_linear_2_stop_gradient_unfused";
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        static const float m[6] = { 1.0f/N, 0, 0, 1, 0, 0 };
+
+        SkRasterPipeline_Linear2StopGradientCtx ctx;
+        ctx.tx = m[0];
+        ctx.ty = m[2];
+        ctx.t0 = m[4];
+        for (int i = 0; i < 4; i++) {
+            ctx.stops.f[i] = 1.0f;
+            ctx.stops.b[i] = 0.0f;
+        }
+        ctx.stops.interpolatedInPremul = true;
+
+        SkRasterPipeline_MemoryCtx dst = { fDst, 0 };
+
+        SkRasterPipeline_<256> p;
+        if (fFused) {
+            p.append(SkRasterPipeline::linear_2_stop_gradient, &ctx);
+        } else {
+            p.append(SkRasterPipeline::seed_shader);
+            p.append(SkRasterPipeline::matrix_2x3, m);
+            p.append(SkRasterPipeline::clamp_x_1);
+            p.append(SkRasterPipeline::evenly_spaced_2_stop_gradient, &ctx.stops);
+        }
+        p.append(SkRasterPipeline::store_8888, &dst);
+
+        auto fn = p.compile();
+        while (loops --> 0) {
+            fn(0,0,N,1);
+        }
+    }
+
+private:
+    static const int N = 1023;
+
+    bool     fFused;
+    uint32_t fDst[N];
+};
+DEF_BENCH( return new SkRasterPipelineLinearGradientBench(true); )
+DEF_BENCH( return new SkRasterPipelineLinearGradientBench(false); )
@@ -6,6 +6,7 @@
  */
 
 #include "Benchmark.h"
+#include "SkCanvas.h"
 #include "SkPaint.h"
 #include "SkPath.h"
 #include "SkRandom.h"
@@ -117,3 +118,49 @@ DEF_BENCH(return new StrokeBench(line_path_maker(), paint_maker(), "line_.25", .
 DEF_BENCH(return new StrokeBench(quad_path_maker(), paint_maker(), "quad_.25", .25f);)
 DEF_BENCH(return new StrokeBench(conic_path_maker(), paint_maker(), "conic_.25", .25f);)
 DEF_BENCH(return new StrokeBench(cubic_path_maker(), paint_maker(), "cubic_.25", .25f);)
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Redraws the same stroked polyline, like a chart that's redrawn every frame.
+class DrawStrokeBench : public Benchmark {
+public:
+    DrawStrokeBench(SkScalar width, bool isVolatile) : fVolatile(isVolatile) {
+        fName.printf("draw_stroke_polyline_%g%s", width, isVolatile ? "_volatile" : "");
+        fPaint.setAntiAlias(true);
+        fPaint.setStyle(SkPaint::kStroke_Style);
+        fPaint.setStrokeWidth(width);
+    }
+
+protected:
+    bool isSuitableFor(Backend backend) override {
+        return backend == kRaster_Backend;
+    }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        SkRandom rand;
+        fPath.moveTo(0, 320);
+        for (int x = 1; x <= 640; x += 2) {
+            fPath.lineTo(x, 320 + rand.nextSScalar1() * 40);
+        }
+        fPath.setIsVolatile(fVolatile);
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int i = 0; i < loops; ++i) {
+            canvas->drawPath(fPath, fPaint);
+        }
+    }
+
+private:
+    SkPath      fPath;
+    SkPaint     fPaint;
+    SkString    fName;
+    bool        fVolatile;
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH(return new DrawStrokeBench(1.5f, false);)
+DEF_BENCH(return new DrawStrokeBench(10, false);)
+DEF_BENCH(return new DrawStrokeBench(10, true);)
@@ -6,7 +6,11 @@
  */
 
 #include "Benchmark.h"
+#include "SkBitmap.h"
+#include "SkConvertPixels.h"
+#include "SkExecutor.h"
 #include "SkOpts.h"
+#include "SkString.h"
 
 class SwizzleBench : public Benchmark {
 public:
@@ -41,3 +45,63 @@ DEF_BENCH(return new SwizzleBench("SkOpts::grayA_to_RGBA", SkOpts::grayA_to_RGBA
 DEF_BENCH(return new SwizzleBench("SkOpts::grayA_to_rgbA", SkOpts::grayA_to_rgbA));
 DEF_BENCH(return new SwizzleBench("SkOpts::inverted_CMYK_to_RGB1", SkOpts::inverted_CMYK_to_RGB1));
 DEF_BENCH(return new SwizzleBench("SkOpts::inverted_CMYK_to_BGR1", SkOpts::inverted_CMYK_to_BGR1));
+
+// Converts a whole large buffer with SkConvertPixels(), optionally split across a thread pool.
+class ConvertPixelsBench : public Benchmark {
+public:
+    ConvertPixelsBench(SkColorType src, SkColorType dst, bool threaded)
+        : fSrcCT(src), fDstCT(dst), fThreaded(threaded) {
+        fName.printf("SkConvertPixels_%s_to_%s%s", name(src), name(dst),
+                     threaded ? "_threaded" : "");
+    }
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        static const int W = 4096, H = 4096;
+        fSrc.allocPixels(SkImageInfo::Make(W, H, fSrcCT, kPremul_SkAlphaType));
+        fSrc.eraseColor(0xFF336699);
+        fDst.allocPixels(SkImageInfo::Make(W, H, fDstCT, kPremul_SkAlphaType));
+        if (fThreaded) {
+            fThreadPool = SkExecutor::MakeFIFOThreadPool();
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        while (loops --> 0) {
+            SkConvertPixels(fDst.info(), fDst.getPixels(), fDst.rowBytes(),
+                            fSrc.info(), fSrc.getPixels(), fSrc.rowBytes(), fThreadPool.get());
+        }
+    }
+
+private:
+    static const char* name(SkColorType ct) {
+        switch (ct) {
+            case kRGBA_8888_SkColorType:    return "8888";
+            case kBGRA_8888_SkColorType:    return "BGRA";
+            case kRGBA_1010102_SkColorType: return "1010102";
+            case kGray_8_SkColorType:       return "gray";
+            case kRGBA_F16_SkColorType:     return "F16";
+            default:                        return "other";
+        }
+    }
+
+    SkColorType                 fSrcCT, fDstCT;
+    bool                        fThreaded;
+    SkString                    fName;
+    SkBitmap                    fSrc, fDst;
+    std::unique_ptr<SkExecutor> fThreadPool;
+};
+
+#define DEF_CONVERT_BENCH(src, dst)                                                            \
+    DEF_BENCH(return new ConvertPixelsBench(src##_SkColorType, dst##_SkColorType, false));     \
+    DEF_BENCH(return new ConvertPixelsBench(src##_SkColorType, dst##_SkColorType, true))
+
+DEF_CONVERT_BENCH(kRGBA_8888,    kRGBA_8888);
+DEF_CONVERT_BENCH(kRGBA_8888,    kBGRA_8888);
+DEF_CONVERT_BENCH(kRGBA_8888,    kRGBA_F16);
+DEF_CONVERT_BENCH(kRGBA_F16,     kRGBA_8888);
+DEF_CONVERT_BENCH(kRGBA_8888,    kRGBA_1010102);
+DEF_CONVERT_BENCH(kRGBA_1010102, kRGBA_F16);
+DEF_CONVERT_BENCH(kRGBA_8888,    kGray_8);
@@ -75,6 +75,31 @@ class TextBlobCachedBench : public SkTextBlobBench {
 };
 DEF_BENCH( return new TextBlobCachedBench(); )
 
+class TextBlobScrollBench : public SkTextBlobBench {
+    const char* onGetName() override {
+        return "TextBlobScrollBench";
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+
+        // Like a scrolling list: the same blobs are redrawn every frame, moved by whole pixels.
+        static const int kLineCount = 20;
+        sk_sp<SkTextBlob> blobs[kLineCount];
+        for (auto& blob : blobs) {
+            blob = this->makeBlob();
+        }
+        auto bigLoops = loops * 5;
+        for (int i = 0; i < bigLoops; i++) {
+            SkScalar scroll = SkIntToScalar(i % 100);
+            for (int line = 0; line < kLineCount; ++line) {
+                canvas->drawTextBlob(blobs[line], 0, 100 + 20 * line - scroll, paint);
+            }
+        }
+    }
+};
+DEF_BENCH( return new TextBlobScrollBench(); )
+
 class TextBlobFirstTimeBench : public SkTextBlobBench {
     const char* onGetName() override {
         return "TextBlobFirstTimeBench";
@@ -109,3 +134,66 @@ class TextBlobMakeBench : public SkTextBlobBench {
     }
 };
 DEF_BENCH( return new TextBlobMakeBench(); )
+
+// Builds lots of small multi-run blobs, like a text layout that makes one blob per word or span,
+// optionally reserving each blob's storage up front.
+class TextBlobMakeSmallBench : public Benchmark {
+public:
+    explicit TextBlobMakeSmallBench(bool reserve) : fReserve(reserve) {}
+
+private:
+    static constexpr int kRunCount = 8;
+    static constexpr int kGlyphsPerRun = 5;
+
+    const char* onGetName() override {
+        return fReserve ? "TextBlobMakeSmallBench_reserve" : "TextBlobMakeSmallBench";
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        fFont.setTypeface(sk_tool_utils::create_portable_typeface("serif", SkFontStyle()));
+        for (int i = 0; i < kRunCount * kGlyphsPerRun; ++i) {
+            fGlyphs[i] = SkToU16(i + 36);
+            fPos[i] = SkPoint::Make(SkIntToScalar(10 * i), SkIntToScalar(i % 7));
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkTextBlobBuilder builder;
+        for (int i = 0; i < loops; i++) {
+            for (int inner = 0; inner < 1000; ++inner) {
+                if (fReserve) {
+                    builder.reserveRuns(kRunCount, kRunCount * kGlyphsPerRun);
+                }
+                for (int r = 0; r < kRunCount; ++r) {
+                    // Alternate positioning so the runs don't merge.
+                    int offset = r * kGlyphsPerRun;
+                    if (r & 1) {
+                        const auto& run = builder.allocRunPosH(fFont, kGlyphsPerRun, 0);
+                        memcpy(run.glyphs, fGlyphs + offset, kGlyphsPerRun * sizeof(uint16_t));
+                        for (int g = 0; g < kGlyphsPerRun; ++g) {
+                            run.pos[g] = fPos[offset + g].fX;
+                        }
+                    } else {
+                        const auto& run = builder.allocRunPos(fFont, kGlyphsPerRun);
+                        memcpy(run.glyphs, fGlyphs + offset, kGlyphsPerRun * sizeof(uint16_t));
+                        memcpy(run.pos, fPos + offset, kGlyphsPerRun * sizeof(SkPoint));
+                    }
+                }
+                builder.make();
+            }
+        }
+    }
+
+    bool     fReserve;
+    SkFont   fFont;
+    uint16_t fGlyphs[kRunCount * kGlyphsPerRun];
+    SkPoint  fPos[kRunCount * kGlyphsPerRun];
+
+    typedef Benchmark INHERITED;
+};
+DEF_BENCH( return new TextBlobMakeSmallBench(false); )
+DEF_BENCH( return new TextBlobMakeSmallBench(true); )
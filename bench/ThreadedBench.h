@@ -0,0 +1,57 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+#ifndef ThreadedBench_DEFINED
+#define ThreadedBench_DEFINED
+
+#include "Benchmark.h"
+#include "SkExecutor.h"
+#include "SkString.h"
+
+/**
+ * Runs another benchmark with a thread pool installed as SkExecutor::GetDefault(), so work that
+ * Skia spreads across the default executor (e.g. raster image filters) runs on every core.
+ * The pool is only installed while the wrapped benchmark draws.
+ */
+class ThreadedBench : public Benchmark {
+public:
+    // Takes ownership of bench.
+    explicit ThreadedBench(Benchmark* bench) : fBench(bench) {
+        fName.printf("%s_threaded", fBench->getName());
+    }
+
+    bool isSuitableFor(Backend backend) override { return fBench->isSuitableFor(backend); }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        if (!fThreadPool) {
+            fThreadPool = SkExecutor::MakeFIFOThreadPool();
+        }
+        fBench->delayedSetup();
+    }
+
+    void onPerCanvasPreDraw(SkCanvas* canvas) override { fBench->perCanvasPreDraw(canvas); }
+    void onPerCanvasPostDraw(SkCanvas* canvas) override { fBench->perCanvasPostDraw(canvas); }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkExecutor::SetDefault(fThreadPool.get());
+        fBench->draw(loops, canvas);
+        SkExecutor::SetDefault(nullptr);
+    }
+
+    SkIPoint onGetSize() override { return fBench->getSize(); }
+
+private:
+    sk_sp<Benchmark>            fBench;
+    std::unique_ptr<SkExecutor> fThreadPool;
+    SkString                    fName;
+
+    typedef Benchmark INHERITED;
+};
+
+#endif
@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "Benchmark.h"
+#include "SkFontMgr.h"
 #include "SkFontTypes.h"
 #include "SkMakeUnique.h"
 #include "SkTypeface.h"
@@ -316,3 +317,54 @@ DEF_BENCH(return new UtfToGlyph(SkTextEncoding::kUTF8, atext, SK_ARRAY_COUNT(ate
 
 
 
+
+// Looks up a fallback typeface for every character of a mix of scripts, as text shaping does for
+// each character the requested typeface lacks.
+class FallbackBench : public Benchmark {
+public:
+    FallbackBench(const char* familyName, const char* name)
+        : fFamilyName{familyName}
+        , fName{name} { }
+
+protected:
+    const char* onGetName() override {
+        return fName;
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        fFontMgr = SkFontMgr::RefDefault();
+        for (const char* line : ctext) {
+            const char* end = line + strlen(line);
+            while (line < end) {
+                fCharacters.push_back(SkUTF::NextUTF8(&line, end));
+            }
+        }
+        // Devanagari, Arabic, Thai, Hangul, Hebrew, Ethiopic and emoji.
+        for (SkUnichar c : {0x0915, 0x0628, 0x0E01, 0xAC00, 0x05D0, 0x1200, 0x1F600, 0x1F44D}) {
+            fCharacters.push_back(c);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        static const char* kLanguages[] = { "en-US", "zh-Hant" };
+        for (int i = 0; i < loops; ++i) {
+            for (SkUnichar c : fCharacters) {
+                sk_sp<SkTypeface> face(fFontMgr->matchFamilyStyleCharacter(
+                        fFamilyName, SkFontStyle(), kLanguages, SK_ARRAY_COUNT(kLanguages), c));
+            }
+        }
+    }
+
+private:
+    const char* fFamilyName;
+    const char* fName;
+    sk_sp<SkFontMgr> fFontMgr;
+    std::vector<SkUnichar> fCharacters;
+};
+
+DEF_BENCH(return new FallbackBench(nullptr, "SkFontMgrFallbackDefault");)
+DEF_BENCH(return new FallbackBench("serif", "SkFontMgrFallbackSerif");)
@@ -9,6 +9,7 @@
 #include "SkBitmap.h"
 #include "SkCanvas.h"
 #include "SkString.h"
+#include "ThreadedBench.h"
 
 class WritePixelsBench : public Benchmark {
 public:
@@ -74,3 +75,7 @@ private:
 
 DEF_BENCH(return new WritePixelsBench(kRGBA_8888_SkColorType, kPremul_SkAlphaType);)
 DEF_BENCH(return new WritePixelsBench(kRGBA_8888_SkColorType, kUnpremul_SkAlphaType);)
+DEF_BENCH(return new ThreadedBench(
+        new WritePixelsBench(kRGBA_8888_SkColorType, kPremul_SkAlphaType));)
+DEF_BENCH(return new ThreadedBench(
+        new WritePixelsBench(kRGBA_8888_SkColorType, kUnpremul_SkAlphaType));)
@@ -3,7 +3,6 @@ Created on May 16, 2011
 
 @author: bungeman
 '''
-import bench_util
 import getopt
 import httplib
 import itertools
@@ -24,9 +23,16 @@ EXPECTED_IDX = -3
 LB_IDX = -2
 UB_IDX = -1
 
-# Indices of the tuple of dictionaries containing slower and faster alerts.
+# Indices of the tuple of dictionaries containing slower and faster alerts, and
+# alerts for benches that allocate more or less.
 SLOWER = 0
 FASTER = 1
+MORE_ALLOCS = 2
+FEWER_ALLOCS = 3
+
+# Metrics nanobench --mem writes per bench and config. Unlike times, these are
+# deterministic for a given build, so their expectations can have tight ranges.
+ALLOC_METRICS = ['allocs', 'alloc_bytes', 'peak_live_bytes']
 
 # URL prefix for the bench dashboard page. Showing recent 15 days of data.
 DASHBOARD_URL_PREFIX = 'http://go/skpdash/#15'
@@ -41,6 +47,10 @@ def usage():
     print '-e <file> file containing expected bench builder values/ranges.'
     print '   Will raise exception if actual bench values are out of range.'
     print '   See bench_expectations_<builder>.txt for data format / examples.'
+    print '-j <file> a nanobench --outResultsFile JSON file to check instead of'
+    print '   -d and -r. Its min_ms and, if nanobench ran with --mem, its'
+    print '   allocation metrics (%s) are checked as' % ', '.join(ALLOC_METRICS)
+    print '   <bench>_<config>_<metric>,<builder>-<alg> expectations.'
     print '-r <revision> the git commit hash or svn revision for checking '
     print '   bench values.'
 
@@ -105,6 +115,25 @@ def create_bench_dict(revision_data_points):
 
     return bench_dict
 
+def read_nanobench_json(filename):
+    """Reads a nanobench JSON results file into a dictionary of line data.
+
+    Returns:
+      a dictionary mapping Label(bench, config, metric, {}) objects to the
+      values of min_ms and of any ALLOC_METRICS.
+    """
+    bench_dict = {}
+    results = json.load(open(filename)).get('results', {})
+    for bench, configs in results.iteritems():
+        for config, values in configs.iteritems():
+            if not isinstance(values, dict):
+                continue
+            for metric in ['min_ms'] + ALLOC_METRICS:
+                if metric in values:
+                    bench_dict[Label(bench, config, metric, {})] = \
+                        float(values[metric])
+    return bench_dict
+
 def read_expectations(expectations, filename):
     """Reads expectations data from file and put in expectations dict."""
     for expectation in open(filename).readlines():
@@ -143,16 +172,19 @@ def check_expectations(lines, expectations, key_suffix):
     """
     # The platform for this bot, to pass to the dashboard plot.
     platform = key_suffix[ : key_suffix.rfind('-')]
-    # Tuple of dictionaries recording exceptions that are slower and faster,
-    # respectively. Each dictionary maps off_ratio (ratio of actual to expected)
-    # to a list of corresponding exception messages.
-    exceptions = ({}, {})
+    # Tuple of dictionaries recording exceptions that are slower, faster, and
+    # allocate more or less, respectively. Each dictionary maps off_ratio (ratio
+    # of actual to expected) to a list of corresponding exception messages.
+    exceptions = ({}, {}, {}, {})
     for line in lines:
         line_str = str(line)
         line_str = line_str[ : line_str.find('_{')]
-        # Extracts bench and config from line_str, which is in the format
-        # <bench-picture-name>.skp_<config>_
-        bench, config = line_str.strip('_').split('.skp_')
+        if '.skp_' in line_str:
+            # Extracts bench and config from line_str, which is in the format
+            # <bench-picture-name>.skp_<config>_
+            bench, config = line_str.strip('_').split('.skp_')
+        else:
+            bench, config = line.bench, line.config
         bench_platform_key = line_str + ',' + key_suffix
         if bench_platform_key not in expectations:
             continue
@@ -165,12 +197,13 @@ def check_expectations(lines, expectations, key_suffix):
                 this_expected, (off_ratio - 1) * 100)
             exception += '\n' + '~'.join([
                 DASHBOARD_URL_PREFIX, bench, platform, config])
-            if off_ratio > 1:  # Bench is slower.
-                exceptions[SLOWER].setdefault(off_ratio, []).append(exception)
+            if line.time_type in ALLOC_METRICS:
+                kind = MORE_ALLOCS if off_ratio > 1 else FEWER_ALLOCS
             else:
-                exceptions[FASTER].setdefault(off_ratio, []).append(exception)
+                kind = SLOWER if off_ratio > 1 else FASTER
+            exceptions[kind].setdefault(off_ratio, []).append(exception)
     outputs = []
-    for i in [SLOWER, FASTER]:
+    for i in [MORE_ALLOCS, SLOWER, FASTER, FEWER_ALLOCS]:
       if exceptions[i]:
           ratios = exceptions[i].keys()
           ratios.sort(reverse=True)
@@ -179,7 +212,11 @@ def check_expectations(lines, expectations, key_suffix):
               li.extend(exceptions[i][ratio])
           header = '%s benches got slower (sorted by %% difference):' % len(li)
           if i == FASTER:
-              header = header.replace('slower', 'faster')
+              header = header.replace('got slower', 'got faster')
+          elif i == MORE_ALLOCS:
+              header = header.replace('got slower', 'allocate more')
+          elif i == FEWER_ALLOCS:
+              header = header.replace('got slower', 'allocate less')
           outputs.extend(['', header] + li)
 
     if outputs:
@@ -194,7 +231,7 @@ def main():
     """Parses command line and checks bench expectations."""
     try:
         opts, _ = getopt.getopt(sys.argv[1:],
-                                "a:b:d:e:r:",
+                                "a:b:d:e:j:r:",
                                 "default-setting=")
     except getopt.GetoptError, err:
         print str(err)
@@ -206,6 +243,7 @@ def main():
     rep = '25th'  # bench representation algorithm, default to 25th
     rev = None  # git commit hash or svn revision number
     bot = None
+    json_file = None  # nanobench results to check instead of -d and -r
 
     try:
         for option, value in opts:
@@ -217,6 +255,8 @@ def main():
                 directory = value
             elif option == "-e":
                 read_expectations(bench_expectations, value)
+            elif option == "-j":
+                json_file = value
             elif option == "-r":
                 rev = value
             else:
@@ -226,15 +266,20 @@ def main():
         usage()
         sys.exit(2)
 
-    if directory is None or bot is None or rev is None:
+    if bot is None or (json_file is None and
+                       (directory is None or rev is None)):
         usage()
         sys.exit(2)
 
     platform_and_alg = bot + '-' + rep
 
-    data_points = bench_util.parse_skp_bench_data(directory, rev, rep)
-
-    bench_dict = create_bench_dict(data_points)
+    if json_file is not None:
+        bench_dict = read_nanobench_json(json_file)
+    else:
+        # Only needed for the -d data.
+        import bench_util
+        data_points = bench_util.parse_skp_bench_data(directory, rev, rep)
+        bench_dict = create_bench_dict(data_points)
 
     if bench_expectations:
         check_expectations(bench_dict, bench_expectations, platform_and_alg)
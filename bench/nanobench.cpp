@@ -37,6 +37,7 @@
 #include "SkGraphics.h"
 #include "SkJSONWriter.h"
 #include "SkLeanWindows.h"
+#include "SkMallocStats.h"
 #include "SkOSFile.h"
 #include "SkOSPath.h"
 #include "SkPictureRecorder.h"
@@ -53,10 +54,31 @@
 #endif  // SK_XML
 
 #include <stdlib.h>
+#include <atomic>
+#include <functional>
+#include <new>
 #include <thread>
+#include <vector>
 
 extern bool gSkForceRasterPipelineBlitter;
 
+#if SK_METRICS_ENABLED
+// Route new and delete through sk_malloc and sk_free, so that --mem counts the allocations of
+// every object too, not just Skia's buffers.
+void* operator new(size_t size) { return sk_malloc_throw(size ? size : 1); }
+void* operator new[](size_t size) { return sk_malloc_throw(size ? size : 1); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return sk_malloc_canfail(size ? size : 1);
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return sk_malloc_canfail(size ? size : 1);
+}
+void operator delete(void* p) noexcept { sk_free(p); }
+void operator delete[](void* p) noexcept { sk_free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { sk_free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { sk_free(p); }
+#endif
+
 #ifndef SK_BUILD_FOR_WIN
     #include <unistd.h>
 
@@ -123,11 +145,25 @@ DEFINE_string(zoom, "1.0,0", "Comma-separated zoomMax,zoomPeriodMs factors for a
                              "function that ping-pongs between 1.0 and zoomMax.");
 DEFINE_bool(bbh, true, "Build a BBH for SKPs?");
 DEFINE_bool(lite, false, "Use SkLiteRecorder in recording benchmarks?");
+DEFINE_bool(sharedSKP, false, "Deserialize SKPs in place with SkPicture::MakeFromSharedData?");
+DEFINE_bool(optimizeSKP, false, "Also bench SkRecordOptimize and SkRecordOptimize2 on SKPs?");
 DEFINE_bool(mpd, true, "Use MultiPictureDraw for the SKPs?");
+DEFINE_string(skpThreads, "", "Space-separated thread counts to also bench threaded CPU SKP "
+                              "playback with, e.g. '1 2 4 8'.");
+DEFINE_string(scalingThreads, "", "Space-separated thread counts, e.g. '2 4 8', to also run CPU "
+                                  "micro benches and GMs on that many threads at once, each "
+                                  "with its own copy of the bench and surface, and report "
+                                  "aggregate time per loop and scaling efficiency.");
 DEFINE_bool(loopSKP, true, "Loop SKPs like we do for micro benches?");
 DEFINE_int32(flushEvery, 10, "Flush --outResultsFile every Nth run.");
 DEFINE_bool(gpuStats, false, "Print GPU stats after each gpu benchmark?");
 DEFINE_bool(gpuStatsDump, false, "Dump GPU states after each benchmark to json");
+DEFINE_bool(flushPhases, false, "For GPU configs, also report how the measured CPU time splits "
+                                "into recording and the phases of flushing. Use --config mock to "
+                                "leave out the driver and the GPU.");
+DEFINE_bool(mem, false, "Also report heap allocations and bytes allocated per loop, how far the "
+                        "live heap grew while timing, and for GPU configs the resource cache's "
+                        "usage. Heap stats need a build with skia_enable_metrics=true.");
 DEFINE_bool(keepAlive, false, "Print a message every so often so that we don't time out");
 DEFINE_bool(csv, false, "Print status in CSV format");
 DEFINE_string(sourceType, "",
@@ -236,6 +272,33 @@ struct GPUTarget : public Target {
         this->contextInfo.grContext()->priv().printCacheStats();
         this->contextInfo.grContext()->priv().printGpuStats();
     }
+
+    void beginFlushPhases() override {
+        this->flushPhaseTotals = {};
+        this->contextInfo.grContext()->setFlushStatsProc(
+                [](GrFlushStatsContext context, const GrFlushStats& stats) {
+                    GrFlushStats* totals = static_cast<GrFlushStats*>(context);
+                    totals->fAllocateNanos += stats.fAllocateNanos;
+                    totals->fPrepareNanos += stats.fPrepareNanos;
+                    totals->fUploadNanos += stats.fUploadNanos;
+                    totals->fExecuteNanos += stats.fExecuteNanos;
+                    totals->fSubmitNanos += stats.fSubmitNanos;
+                    totals->fTotalNanos += stats.fTotalNanos;
+                },
+                &this->flushPhaseTotals);
+    }
+    bool endFlushPhases(GrFlushStats* totals) override {
+        this->contextInfo.grContext()->setFlushStatsProc(nullptr, nullptr);
+        *totals = this->flushPhaseTotals;
+        return true;
+    }
+
+    bool getGpuCacheUsage(int* resources, size_t* bytes) override {
+        this->contextInfo.grContext()->getResourceCacheUsage(resources, bytes);
+        return true;
+    }
+
+    GrFlushStats flushPhaseTotals = {};
 };
 
 static double time(int loops, Benchmark* bench, Target* target) {
@@ -256,6 +319,77 @@ static double time(int loops, Benchmark* bench, Target* target) {
     return elapsed;
 }
 
+/**
+ *  Sets up a fresh copy of the bench for each of 'threads' threads, each with its own surface like
+ *  'info' (or no surface, if info is empty). Then every thread at once draws 'samples' runs of
+ *  'loops' loops with its copy. Returns the wall time of all that per loop, or a negative value if
+ *  a surface can't be made.
+ */
+static double time_concurrently(const std::function<Benchmark*()>& factory,
+                                const SkImageInfo& info, int threads, int loops, int samples) {
+    struct Copy {
+        std::unique_ptr<Benchmark> fBench;
+        sk_sp<SkSurface>           fSurface;
+
+        SkCanvas* canvas() const { return fSurface ? fSurface->getCanvas() : nullptr; }
+
+        void draw(int loops) const {
+            SkCanvas* canvas = this->canvas();
+            if (canvas) {
+                canvas->clear(SK_ColorWHITE);
+            }
+            fBench->preDraw(canvas);
+            fBench->draw(loops, canvas);
+            if (canvas) {
+                canvas->flush();
+            }
+            fBench->postDraw(canvas);
+        }
+    };
+
+    std::vector<Copy> copies(threads);
+    for (Copy& copy : copies) {
+        copy.fBench.reset(factory());
+        copy.fBench->delayedSetup();
+        if (!info.isEmpty()) {
+            copy.fSurface = SkSurface::MakeRaster(info);
+            if (!copy.fSurface) {
+                return -1;
+            }
+        }
+        copy.fBench->perCanvasPreDraw(copy.canvas());
+        copy.draw(loops);  // Warm up.
+    }
+
+    // Start the clock once every thread has started.
+    std::atomic<int> starting{threads};
+    std::vector<std::thread> workers;
+    for (const Copy& copy : copies) {
+        workers.emplace_back([&starting, &copy, loops, samples] {
+            starting.fetch_sub(1);
+            while (starting.load() > 0) {
+                std::this_thread::yield();
+            }
+            for (int s = 0; s < samples; ++s) {
+                copy.draw(loops);
+            }
+        });
+    }
+    while (starting.load() > 0) {
+        std::this_thread::yield();
+    }
+    double start = now_ms();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    double elapsed = now_ms() - start;
+
+    for (const Copy& copy : copies) {
+        copy.fBench->perCanvasPostDraw(copy.canvas());
+    }
+    return elapsed / ((double)threads * samples * loops);
+}
+
 static double estimate_timer_overhead() {
     double overhead = 0;
     for (int i = 0; i < FLAGS_overheadLoops; i++) {
@@ -593,10 +727,12 @@ public:
                       , fGMs(skiagm::GMRegistry::Head())
                       , fCurrentRecording(0)
                       , fCurrentDeserialPicture(0)
+                      , fCurrentOptimize(0)
                       , fCurrentScale(0)
                       , fCurrentSKP(0)
                       , fCurrentSVG(0)
                       , fCurrentUseMPD(0)
+                      , fCurrentSKPThreads(0)
                       , fCurrentCodec(0)
                       , fCurrentAndroidCodec(0)
                       , fCurrentBRDImage(0)
@@ -631,6 +767,15 @@ public:
         }
         fUseMPDs.push_back() = false;
 
+        for (int i = 0; i < FLAGS_skpThreads.count(); i++) {
+            if (1 != sscanf(FLAGS_skpThreads[i], "%d", &fSKPThreads.push_back()) ||
+                fSKPThreads.back() < 1) {
+                SkDebugf("Can't parse %s from --skpThreads as a thread count.\n",
+                         FLAGS_skpThreads[i]);
+                exit(1);
+            }
+        }
+
         // Prepare the images for decoding
         if (!CollectImages(FLAGS_images, &fImages)) {
             exit(1);
@@ -703,9 +848,15 @@ public:
         return bench.release();
     }
 
+    // Makes another copy of the bench last returned by next(), or is empty if it can't.
+    const std::function<Benchmark*()>& currentFactory() const { return fFactory; }
+
     Benchmark* rawNext() {
+        fFactory = nullptr;
         if (fBenches) {
-            Benchmark* bench = fBenches->get()(nullptr);
+            auto factory = fBenches->get();
+            Benchmark* bench = factory(nullptr);
+            fFactory = [factory] { return factory(nullptr); };
             fBenches = fBenches->next();
             fSourceType = "bench";
             fBenchType  = "micro";
@@ -713,9 +864,11 @@ public:
         }
 
         while (fGMs) {
-            std::unique_ptr<skiagm::GM> gm(fGMs->get()(nullptr));
+            auto factory = fGMs->get();
+            std::unique_ptr<skiagm::GM> gm(factory(nullptr));
             fGMs = fGMs->next();
             if (gm->runAsBench()) {
+                fFactory = [factory] { return new GMBench(factory(nullptr)); };
                 fSourceType = "gm";
                 fBenchType  = "micro";
                 return new GMBench(gm.release());
@@ -749,7 +902,25 @@ public:
             fBenchType  = "deserial";
             fSKPBytes = static_cast<double>(data->size());
             fSKPOps   = 0;
-            return new DeserializePictureBench(name.c_str(), std::move(data));
+            return new DeserializePictureBench(name.c_str(), std::move(data), FLAGS_sharedSKP);
+        }
+
+        // Add all .skps as RecordOptimizeBenches, once with each optimizer.
+        while (FLAGS_optimizeSKP && fCurrentOptimize < 2 * fSKPs.count()) {
+            const int index = fCurrentOptimize++;
+            const SkString& path = fSKPs[index / 2];
+            sk_sp<SkPicture> pic = ReadPicture(path.c_str());
+            if (!pic) {
+                continue;
+            }
+            SkString name = SkOSPath::Basename(path.c_str());
+            auto bench = new RecordOptimizeBench(name.c_str(), pic.get(), index % 2 == 1);
+            fSourceType = "skp";
+            fBenchType  = "optimize";
+            fSKPBytes = static_cast<double>(pic->approximateBytesUsed());
+            fSKPOps   = bench->opsBefore();
+            fSKPOptimizedOps = bench->opsAfter();
+            return bench;
         }
 
         // Then once each for each scale as SKPBenches (playback).
@@ -779,7 +950,15 @@ public:
                     return new SKPBench(name.c_str(), pic.get(), fClip, fScales[fCurrentScale],
                                         fUseMPDs[fCurrentUseMPD++], FLAGS_loopSKP);
                 }
+                while (fCurrentSKPThreads < fSKPThreads.count()) {
+                    SkString name = SkOSPath::Basename(path.c_str());
+                    fSourceType = "skp";
+                    fBenchType = "playback_threaded";
+                    return new SKPBench(name.c_str(), pic.get(), fClip, fScales[fCurrentScale],
+                                        false, FLAGS_loopSKP, fSKPThreads[fCurrentSKPThreads++]);
+                }
                 fCurrentUseMPD = 0;
+                fCurrentSKPThreads = 0;
                 fCurrentSKP++;
             }
 
@@ -1021,7 +1200,10 @@ public:
                                                   fClip.fRight, fClip.fBottom).c_str());
             SkASSERT_RELEASE(fCurrentScale < fScales.count());  // debugging paranoia
             log.appendString("scale", SkStringPrintf("%.2g", fScales[fCurrentScale]).c_str());
-            if (fCurrentUseMPD > 0) {
+            if (fCurrentSKPThreads > 0) {
+                log.appendString("threads",
+                        SkStringPrintf("%d", fSKPThreads[fCurrentSKPThreads-1]).c_str());
+            } else if (fCurrentUseMPD > 0) {
                 SkASSERT(1 == fCurrentUseMPD || 2 == fCurrentUseMPD);
                 log.appendString("multi_picture_draw",
                                  fUseMPDs[fCurrentUseMPD-1] ? "true" : "false");
@@ -1034,6 +1216,10 @@ public:
             log.appendMetric("bytes", fSKPBytes);
             log.appendMetric("ops", fSKPOps);
         }
+        if (0 == strcmp(fBenchType, "optimize")) {
+            log.appendMetric("ops", fSKPOps);
+            log.appendMetric("optimized_ops", fSKPOptimizedOps);
+        }
     }
 
 private:
@@ -1056,21 +1242,25 @@ private:
     SkTArray<SkString> fSKPs;
     SkTArray<SkString> fSVGs;
     SkTArray<bool>     fUseMPDs;
+    SkTArray<int>      fSKPThreads;
     SkTArray<SkString> fImages;
     SkTArray<SkColorType, true> fColorTypes;
     SkScalar           fZoomMax;
     double             fZoomPeriodMs;
 
-    double fSKPBytes, fSKPOps;
+    double fSKPBytes, fSKPOps, fSKPOptimizedOps;
 
     const char* fSourceType;  // What we're benching: bench, GM, SKP, ...
     const char* fBenchType;   // How we bench it: micro, recording, playback, ...
+    std::function<Benchmark*()> fFactory;
     int fCurrentRecording;
     int fCurrentDeserialPicture;
+    int fCurrentOptimize;
     int fCurrentScale;
     int fCurrentSKP;
     int fCurrentSVG;
     int fCurrentUseMPD;
+    int fCurrentSKPThreads;
     int fCurrentCodec;
     int fCurrentAndroidCodec;
     int fCurrentBRDImage;
@@ -1185,6 +1375,11 @@ int main(int argc, char** argv) {
         start_keepalive();
     }
 
+    if (FLAGS_mem && !SkMallocStats::Enabled()) {
+        SkDebugf("WARNING: this build doesn't count heap allocations; --mem will only report GPU "
+                 "resource cache usage. Build with skia_enable_metrics=true for the rest.\n");
+    }
+
     gSkUseAnalyticAA = FLAGS_analyticAA;
     gSkUseDeltaAA = FLAGS_deltaAA;
 
@@ -1198,6 +1393,16 @@ int main(int argc, char** argv) {
         gSkForceRasterPipelineBlitter = true;
     }
 
+    SkTArray<int> scalingThreads;
+    for (int i = 0; i < FLAGS_scalingThreads.count(); i++) {
+        if (1 != sscanf(FLAGS_scalingThreads[i], "%d", &scalingThreads.push_back()) ||
+            scalingThreads.back() < 1) {
+            SkDebugf("Can't parse %s from --scalingThreads as a thread count.\n",
+                     FLAGS_scalingThreads[i]);
+            return 1;
+        }
+    }
+
     int runs = 0;
     BenchmarkStream benchStream;
     log.beginObject("results");
@@ -1256,6 +1461,15 @@ int main(int argc, char** argv) {
                 } while (now_ms() < stop);
             }
 
+            bool flushPhases = FLAGS_flushPhases && Benchmark::kGPU_Backend == configs[i].backend;
+            if (flushPhases) {
+                target->beginFlushPhases();
+            }
+            SkMallocStats::Totals memStart = {};
+            if (FLAGS_mem) {
+                SkMallocStats::ResetPeak();
+                memStart = SkMallocStats::Get();
+            }
             if (FLAGS_ms) {
                 samples.reset();
                 auto stop = now_ms() + FLAGS_ms;
@@ -1268,6 +1482,84 @@ int main(int argc, char** argv) {
                     samples[s] = time(loops, bench.get(), target) / loops;
                 }
             }
+            const SkMallocStats::Totals memEnd = SkMallocStats::Get();
+
+            // The heap use of the measured runs, per loop (including each sample's clear and
+            // flush), and what the GPU resource cache holds afterwards.
+            struct MemoryMetric {
+                const char* fName;
+                double      fValue;
+            };
+            SkSTArray<5, MemoryMetric> memMetrics;
+            if (FLAGS_mem && !samples.empty()) {
+                if (SkMallocStats::Enabled()) {
+                    double timedLoops = (double)loops * samples.count();
+                    memMetrics.push_back({"allocs", (memEnd.fAllocs - memStart.fAllocs) /
+                                                    timedLoops});
+                    memMetrics.push_back({"alloc_bytes",
+                                          (memEnd.fAllocBytes - memStart.fAllocBytes) /
+                                          timedLoops});
+                    memMetrics.push_back({"peak_live_bytes",
+                                          (double)(memEnd.fPeakLiveBytes - memStart.fLiveBytes)});
+                }
+                int gpuResources;
+                size_t gpuBytes;
+                if (target->getGpuCacheUsage(&gpuResources, &gpuBytes)) {
+                    memMetrics.push_back({"gpu_cache_resources", (double)gpuResources});
+                    memMetrics.push_back({"gpu_cache_bytes", (double)gpuBytes});
+                }
+            }
+
+            // The aggregate time per loop of copies of the bench drawing on 1 and on each of the
+            // --scalingThreads counts of threads at once, and how close each count comes to
+            // dividing the 1-thread time by the number of threads.
+            struct ScalingRun {
+                int    fThreads;
+                double fMs;
+                double fEfficiency;
+            };
+            SkSTArray<8, ScalingRun> scalingRuns;
+            const std::function<Benchmark*()>& factory = benchStream.currentFactory();
+            if (!scalingThreads.empty() && factory && !samples.empty() &&
+                (Benchmark::kRaster_Backend == configs[i].backend ||
+                 Benchmark::kNonRendering_Backend == configs[i].backend)) {
+                SkImageInfo info = canvas ? canvas->imageInfo() : SkImageInfo::MakeUnknown();
+                double oneThreadMs = time_concurrently(factory, info, 1, loops, samples.count());
+                if (oneThreadMs > 0) {
+                    scalingRuns.push_back({1, oneThreadMs, 1});
+                    for (int threads : scalingThreads) {
+                        double ms = time_concurrently(factory, info, threads, loops,
+                                                      samples.count());
+                        scalingRuns.push_back({threads, ms, oneThreadMs / ms / threads});
+                    }
+                }
+            }
+
+            // The CPU time of the measured runs, per loop, split into what flushes spent in each
+            // phase and everything else (mostly recording).
+            struct FlushPhase {
+                const char* fName;
+                double      fMs;
+            };
+            SkSTArray<7, FlushPhase> phases;
+            GrFlushStats phaseTotals;
+            if (flushPhases && target->endFlushPhases(&phaseTotals) && !samples.empty()) {
+                double timedLoops = (double)loops * samples.count();
+                double sampledMs = 0;
+                for (double sample : samples) {
+                    sampledMs += sample * loops;
+                }
+                auto perLoop = [timedLoops](uint64_t nanos) { return nanos * 1e-6 / timedLoops; };
+                phases.push_back({"record_ms",
+                                  SkTMax(0.0, sampledMs / timedLoops -
+                                              perLoop(phaseTotals.fTotalNanos))});
+                phases.push_back({"flush_ms", perLoop(phaseTotals.fTotalNanos)});
+                phases.push_back({"allocate_ms", perLoop(phaseTotals.fAllocateNanos)});
+                phases.push_back({"prepare_ms", perLoop(phaseTotals.fPrepareNanos)});
+                phases.push_back({"upload_ms", perLoop(phaseTotals.fUploadNanos)});
+                phases.push_back({"execute_ms", perLoop(phaseTotals.fExecuteNanos)});
+                phases.push_back({"submit_ms", perLoop(phaseTotals.fSubmitNanos)});
+            }
 
             SkTArray<SkString> keys;
             SkTArray<double> values;
@@ -1308,6 +1600,17 @@ int main(int argc, char** argv) {
             }
             log.endArray(); // samples
             benchStream.fillCurrentMetrics(log);
+            for (const FlushPhase& phase : phases) {
+                log.appendMetric(phase.fName, phase.fMs);
+            }
+            for (const MemoryMetric& metric : memMetrics) {
+                log.appendMetric(metric.fName, metric.fValue);
+            }
+            for (const ScalingRun& run : scalingRuns) {
+                log.appendMetric(SkStringPrintf("threads%d_ms", run.fThreads).c_str(), run.fMs);
+                log.appendMetric(SkStringPrintf("threads%d_efficiency", run.fThreads).c_str(),
+                                 run.fEfficiency);
+            }
             if (gpuStatsDump) {
                 // dump to json, only SKPBench currently returns valid keys / values
                 SkASSERT(keys.count() == values.count());
@@ -1371,6 +1674,36 @@ int main(int argc, char** argv) {
                         );
             }
 
+            if (!phases.empty() && !FLAGS_quiet && !FLAGS_csv) {
+                SkString line;
+                for (const FlushPhase& phase : phases) {
+                    line.appendf("%s%s %s", line.isEmpty() ? "" : ", ", phase.fName,
+                                 HUMANIZE(phase.fMs));
+                }
+                SkDebugf("\t%s\n", line.c_str());
+            }
+
+            if (!scalingRuns.empty() && !FLAGS_quiet && !FLAGS_csv) {
+                SkString line;
+                for (const ScalingRun& run : scalingRuns) {
+                    line.appendf("%s%d threads %s/loop", line.isEmpty() ? "" : ", ",
+                                 run.fThreads, HUMANIZE(run.fMs));
+                    if (run.fThreads > 1) {
+                        line.appendf(" (%.0f%%)", 100 * run.fEfficiency);
+                    }
+                }
+                SkDebugf("\t%s\n", line.c_str());
+            }
+
+            if (!memMetrics.empty() && !FLAGS_quiet && !FLAGS_csv) {
+                SkString line;
+                for (const MemoryMetric& metric : memMetrics) {
+                    line.appendf("%s%s %.4g", line.isEmpty() ? "" : ", ", metric.fName,
+                                 metric.fValue);
+                }
+                SkDebugf("\t%s\n", line.c_str());
+            }
+
             if (FLAGS_gpuStats && Benchmark::kGPU_Backend == configs[i].backend) {
                 target->dumpStats();
             }
@@ -73,6 +73,15 @@ struct Target {
     /** Writes gathered stats using SkDebugf. */
     virtual void dumpStats() {}
 
+    /** Starts summing the GrFlushStats of every flush, for GPU targets. */
+    virtual void beginFlushPhases() {}
+
+    /** Stops summing, and returns the sums in 'totals'. Returns false if nothing was summed. */
+    virtual bool endFlushPhases(GrFlushStats* totals) { return false; }
+
+    /** Returns the GPU resource cache's usage, for GPU targets. Returns false for others. */
+    virtual bool getGpuCacheUsage(int* resources, size_t* bytes) { return false; }
+
     SkCanvas* getCanvas() const {
         if (!surface.get()) {
             return nullptr;
@@ -43,6 +43,8 @@
 #include "ios_utils.h"
 #include "sk_tool_utils.h"
 
+#include <atomic>
+#include <thread>
 #include <vector>
 
 #include "png.h"
@@ -68,6 +70,9 @@ DEFINE_string(matrix, "1 0 0 1",
               "2x2 scale+skew matrix to apply or upright when using "
               "'matrix' or 'upright' in config.");
 DEFINE_bool(gpu_threading, false, "Allow GPU work to run on multiple threads?");
+DEFINE_int32(gpuWorkers, 0, "If > 0, run GPU sink tasks on this many threads alongside the main "
+                            "thread, each with GL or Vulkan contexts of its own that it keeps "
+                            "from task to task.");
 
 DEFINE_string(blacklist, "",
         "Space-separated config/src/srcOptions/name quadruples to blacklist. "
@@ -900,6 +905,7 @@ static Sink* create_sink(const GrContextOptions& grCtxOptions, const SkCommandLi
         SINK("565",     RasterSink, kRGB_565_SkColorType);
         SINK("4444",    RasterSink, kARGB_4444_SkColorType);
         SINK("8888",    RasterSink, kN32_SkColorType);
+        SINK("t8888",   ThreadedSink, kN32_SkColorType);
         SINK("rgba",    RasterSink, kRGBA_8888_SkColorType);
         SINK("bgra",    RasterSink, kBGRA_8888_SkColorType);
         SINK("rgbx",    RasterSink, kRGB_888x_SkColorType);
@@ -1481,7 +1487,7 @@ int main(int argc, char** argv) {
 
     // Kick off as much parallel work as we can, making note of any serial work we'll need to do.
     SkTaskGroup parallel;
-    SkTArray<Task> serial;
+    SkTArray<Task> serial, gpu;
 
     for (auto& sink : gSinks)
     for (auto&  src : gSrcs) {
@@ -1494,7 +1500,11 @@ int main(int argc, char** argv) {
         }
 
         Task task(src, sink);
-        if (src->serial() || sink->serial()) {
+        if (FLAGS_gpuWorkers > 0 && !src->serial() && sink->serial() &&
+            SinkFlags::kGPU == sink->flags().type) {
+            // GPU sinks are only serial to keep them on one thread's contexts.
+            gpu.push_back(task);
+        } else if (src->serial() || sink->serial()) {
             serial.push_back(task);
         } else {
             parallel.add([task] { Task::Run(task); });
@@ -1504,9 +1514,25 @@ int main(int argc, char** argv) {
         parallel.add([test, grCtxOptions] { run_test(test, grCtxOptions); });
     }
 
+    // Each GPU worker takes the next GPU task until there are none left.
+    std::atomic<int> nextGPUTask{0};
+    std::vector<std::thread> gpuWorkers;
+    for (int i = 0; i < SkTMin(FLAGS_gpuWorkers, gpu.count()); i++) {
+        gpuWorkers.emplace_back([&gpu, &nextGPUTask] {
+            BeginGPUWorker();
+            for (int t = nextGPUTask++; t < gpu.count(); t = nextGPUTask++) {
+                Task::Run(gpu[t]);
+            }
+            EndGPUWorker();
+        });
+    }
+
     // With the parallel work running, run serial tasks and tests here on main thread.
     for (auto task : serial) { Task::Run(task); }
     for (auto test : gSerialTests) { run_test(test, grCtxOptions); }
+    for (std::thread& worker : gpuWorkers) {
+        worker.join();
+    }
 
     // Wait for any remaining parallel work to complete (including any spun off of serial tasks).
     parallel.wait();
@@ -52,8 +52,10 @@
 #include "SkSurface.h"
 #include "SkSurfaceCharacterization.h"
 #include "SkSwizzler.h"
+#include "SkTLS.h"
 #include "SkTLogic.h"
 #include "SkTaskGroup.h"
+#include "SkThreadedBMPDevice.h"
 #if defined(SK_BUILD_FOR_WIN)
     #include "SkAutoCoInitialize.h"
     #include "SkHRESULT.h"
@@ -1348,6 +1350,54 @@ GPUSink::GPUSink(GrContextFactory::ContextType ct,
 
 DEFINE_bool(drawOpClip, false, "Clip each GrDrawOp to its device bounds for testing.");
 
+namespace {
+
+// The GrContextFactories of one GPU worker thread, one for each set of options it has drawn with.
+class GPUWorkerFactories {
+public:
+    static void* Create() { return new GPUWorkerFactories; }
+    static void Delete(void* ptr) { delete static_cast<GPUWorkerFactories*>(ptr); }
+
+    GrContextFactory* find(const GrContextOptions& options) {
+        // GrContextOptions has no operator==. Options made by modifying copies of the same base
+        // have the same bytes, so comparing bytes can only take equal options for different
+        // ones, which just costs a new factory.
+        for (int i = 0; i < fFactories.count(); ++i) {
+            if (0 == memcmp(&fFactories[i].fOptions, &options, sizeof(GrContextOptions))) {
+                return fFactories[i].fFactory.get();
+            }
+        }
+        if (fFactories.count() == kMaxFactories) {
+            fFactories.removeShuffle(0);
+        }
+        Entry& entry = fFactories.push_back();
+        entry.fOptions = options;
+        entry.fFactory.reset(new GrContextFactory(options));
+        return entry.fFactory.get();
+    }
+
+private:
+    // Each factory holds on to its contexts, so don't let sources with unusual options pile up.
+    static constexpr int kMaxFactories = 4;
+
+    struct Entry {
+        GrContextOptions                  fOptions;
+        std::unique_ptr<GrContextFactory> fFactory;
+    };
+    SkTArray<Entry> fFactories;
+};
+
+}  // namespace
+
+void BeginGPUWorker() {
+    SkTLS::Get(GPUWorkerFactories::Create, GPUWorkerFactories::Delete);
+}
+
+void EndGPUWorker() {
+    // Destroy the contexts on the thread that made them.
+    SkTLS::Delete(GPUWorkerFactories::Create);
+}
+
 Error GPUSink::draw(const Src& src, SkBitmap* dst, SkWStream* dstStream, SkString* log) const {
     return this->onDraw(src, dst, dstStream, log, fBaseContextOptions);
 }
@@ -1363,12 +1413,22 @@ Error GPUSink::onDraw(const Src& src, SkBitmap* dst, SkWStream*, SkString* log,
     SkASSERT(cache == grOptions.fPersistentCache);
     SkASSERT(exec == grOptions.fExecutor);
 
-    GrContextFactory factory(grOptions);
+    // A GPU worker's factory is kept for its next draws, unless this draw will abandon it.
+    GrContextFactory* factory = nullptr;
+    std::unique_ptr<GrContextFactory> ownFactory;
+    auto worker = static_cast<GPUWorkerFactories*>(SkTLS::Find(GPUWorkerFactories::Create));
+    if (worker && !FLAGS_preAbandonGpuContext && !FLAGS_abandonGpuContext &&
+        !FLAGS_releaseAndAbandonGpuContext) {
+        factory = worker->find(grOptions);
+    } else {
+        ownFactory.reset(new GrContextFactory(grOptions));
+        factory = ownFactory.get();
+    }
     const SkISize size = src.size();
     SkImageInfo info =
             SkImageInfo::Make(size.width(), size.height(), fColorType, fAlphaType, fColorSpace);
     sk_sp<SkSurface> surface;
-    GrContext* context = factory.getContextInfo(fContextType, fContextOverrides).grContext();
+    GrContext* context = factory->getContextInfo(fContextType, fContextOverrides).grContext();
     const int maxDimension = context->priv().caps()->maxTextureSize();
     if (maxDimension < SkTMax(size.width(), size.height())) {
         return Error::Nonfatal("Src too large to create a texture.\n");
@@ -1405,7 +1465,7 @@ Error GPUSink::onDraw(const Src& src, SkBitmap* dst, SkWStream*, SkString* log,
         return "Could not create a surface.";
     }
     if (FLAGS_preAbandonGpuContext) {
-        factory.abandonContexts();
+        factory->abandonContexts();
     }
     SkCanvas* canvas = surface->getCanvas();
     Error err = src.draw(canvas);
@@ -1427,9 +1487,9 @@ Error GPUSink::onDraw(const Src& src, SkBitmap* dst, SkWStream*, SkString* log,
     dst->allocPixels(info);
     canvas->readPixels(*dst, 0, 0);
     if (FLAGS_abandonGpuContext) {
-        factory.abandonContexts();
+        factory->abandonContexts();
     } else if (FLAGS_releaseAndAbandonGpuContext) {
-        factory.releaseResourcesAndAbandonContexts();
+        factory->releaseResourcesAndAbandonContexts();
     }
     if (!context->abandoned()) {
         surface.reset();
@@ -1443,6 +1503,10 @@ Error GPUSink::onDraw(const Src& src, SkBitmap* dst, SkWStream*, SkString* log,
     if (grOptions.fPersistentCache) {
         context->storeVkPipelineCacheData();
     }
+    if (!ownFactory && !context->abandoned()) {
+        // Don't let this draw's cached resources change how the next one draws.
+        context->freeGpuResources();
+    }
     return "";
 }
 
@@ -1674,7 +1738,7 @@ RasterSink::RasterSink(SkColorType colorType, sk_sp<SkColorSpace> colorSpace)
     : fColorType(colorType)
     , fColorSpace(std::move(colorSpace)) {}
 
-Error RasterSink::draw(const Src& src, SkBitmap* dst, SkWStream*, SkString*) const {
+void RasterSink::allocPixels(const Src& src, SkBitmap* dst) const {
     const SkISize size = src.size();
     // If there's an appropriate alpha type for this color type, use it, otherwise use premul.
     SkAlphaType alphaType = kPremul_SkAlphaType;
@@ -1683,11 +1747,28 @@ Error RasterSink::draw(const Src& src, SkBitmap* dst, SkWStream*, SkString*) con
     dst->allocPixelsFlags(SkImageInfo::Make(size.width(), size.height(),
                                             fColorType, alphaType, fColorSpace),
                           SkBitmap::kZeroPixels_AllocFlag);
+}
+
+Error RasterSink::draw(const Src& src, SkBitmap* dst, SkWStream*, SkString*) const {
+    this->allocPixels(src, dst);
 
     SkCanvas canvas(*dst);
     return src.draw(&canvas);
 }
 
+ThreadedSink::ThreadedSink(SkColorType colorType, sk_sp<SkColorSpace> colorSpace)
+        : RasterSink(colorType, std::move(colorSpace)) {}
+
+Error ThreadedSink::draw(const Src& src, SkBitmap* dst, SkWStream*, SkString*) const {
+    this->allocPixels(src, dst);
+
+    SkCanvas canvas(sk_make_sp<SkThreadedBMPDevice>(*dst, FLAGS_backendTiles,
+                                                    FLAGS_backendThreads));
+    Error err = src.draw(&canvas);
+    canvas.flush();
+    return err;
+}
+
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
 // Handy for front-patching a Src.  Do whatever up-front work you need, then call draw_to_canvas(),
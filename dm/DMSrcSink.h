@@ -365,6 +365,15 @@ private:
     GrContextOptions                                  fBaseContextOptions;
 };
 
+/**
+ *  With --gpuWorkers, DM runs GPU tasks on worker threads, which call BeginGPUWorker() before
+ *  their first task and EndGPUWorker() after their last. In between, GPUSinks drawing on such a
+ *  thread reuse its GrContextFactory, and so its contexts and compiled programs, from task to task
+ *  instead of making new ones for every draw.
+ */
+void BeginGPUWorker();
+void EndGPUWorker();
+
 class GPUThreadTestingSink : public GPUSink {
 public:
     GPUThreadTestingSink(sk_gpu_test::GrContextFactory::ContextType,
@@ -434,6 +443,9 @@ public:
     const char* fileExtension() const override { return "png"; }
     SinkFlags flags() const override { return SinkFlags{ SinkFlags::kRaster, SinkFlags::kDirect }; }
 
+protected:
+    void allocPixels(const Src& src, SkBitmap*) const;
+
 private:
     SkColorType         fColorType;
     sk_sp<SkColorSpace> fColorSpace;
@@ -7,14 +7,27 @@
 
 #include "SkSVGContainer.h"
 
+#include "SkCanvas.h"
 #include "SkPath.h"
 #include "SkPathOps.h"
+#include "SkPictureRecorder.h"
+#include "SkRectPriv.h"
+#include "SkSVGRenderContext.h"
 
 SkSVGContainer::SkSVGContainer(SkSVGTag t) : INHERITED(t) { }
 
 void SkSVGContainer::appendChild(sk_sp<SkSVGNode> node) {
     SkASSERT(node);
     fChildren.push_back(std::move(node));
+    this->invalidate();
+}
+
+uint32_t SkSVGContainer::subtreeGenerationID() const {
+    uint32_t id = this->generationID();
+    for (int i = 0; i < fChildren.count(); ++i) {
+        id = SkTMax(id, fChildren[i]->subtreeGenerationID());
+    }
+    return id;
 }
 
 bool SkSVGContainer::hasChildren() const {
@@ -22,9 +35,34 @@ bool SkSVGContainer::hasChildren() const {
 }
 
 void SkSVGContainer::onRender(const SkSVGRenderContext& ctx) const {
-    for (int i = 0; i < fChildren.count(); ++i) {
-        fChildren[i]->render(ctx);
+    auto renderChildren = [this](const SkSVGRenderContext& ctx) {
+        for (int i = 0; i < fChildren.count(); ++i) {
+            fChildren[i]->render(ctx);
+        }
+    };
+
+    uint32_t key = ctx.cacheKey();
+    if (key) {
+        SkSVGRenderContext localContext(ctx);
+        localContext.mixCacheKey(this->subtreeGenerationID());
+        key = localContext.cacheKey();
+    }
+    if (!key || key != fRenderCacheKey) {
+        // Don't bother recording subtrees that are only rendered once, or change every time.
+        fRenderCacheKey = key;
+        fRenderCache.reset();
+        renderChildren(ctx);
+        return;
+    }
+
+    if (!fRenderCache) {
+        SkPictureRecorder recorder;
+        // Our children draw in our local space, and can extend anywhere in it.
+        SkCanvas* recordingCanvas = recorder.beginRecording(SkRectPriv::MakeLargeS32());
+        renderChildren(SkSVGRenderContext(ctx, recordingCanvas));
+        fRenderCache = recorder.finishRecordingAsPicture();
     }
+    ctx.canvas()->drawPicture(fRenderCache);
 }
 
 SkPath SkSVGContainer::onAsPath(const SkSVGRenderContext& ctx) const {
@@ -8,6 +8,7 @@
 #ifndef SkSVGContainer_DEFINED
 #define SkSVGContainer_DEFINED
 
+#include "SkPicture.h"
 #include "SkSVGTransformableNode.h"
 #include "SkTArray.h"
 
@@ -17,6 +18,8 @@ public:
 
     void appendChild(sk_sp<SkSVGNode>) override;
 
+    uint32_t subtreeGenerationID() const override;
+
 protected:
     explicit SkSVGContainer(SkSVGTag);
 
@@ -30,6 +33,11 @@ protected:
     SkSTArray<1, sk_sp<SkSVGNode>, true> fChildren;
 
 private:
+    // Children rendered twice in a row with the same cache key are recorded, and replayed from
+    // then on until the key changes: when anything in the subtree or inherited by it changes.
+    mutable uint32_t         fRenderCacheKey = 0;
+    mutable sk_sp<SkPicture> fRenderCache;
+
     typedef SkSVGTransformableNode INHERITED;
 };
 
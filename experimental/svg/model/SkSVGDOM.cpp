@@ -7,6 +7,7 @@
 
 #include "SkCanvas.h"
 #include "SkDOM.h"
+#include "SkFloatBits.h"
 #include "SkParsePath.h"
 #include "SkSVGAttributeParser.h"
 #include "SkSVGCircle.h"
@@ -483,10 +484,28 @@ void SkSVGDOM::render(SkCanvas* canvas) const {
     if (fRoot) {
         SkSVGLengthContext       lctx(fContainerSize);
         SkSVGPresentationContext pctx;
-        fRoot->render(SkSVGRenderContext(canvas, fIDMapper, lctx, pctx));
+        SkSVGRenderContext       ctx(canvas, fIDMapper, lctx, pctx);
+
+        // Any node can be referenced (gradients, clip paths, <use>) from anywhere else, so
+        // changing one that has an id conservatively invalidates every cached subtree.
+        uint32_t referencedID = 0;
+        fIDMapper.foreach([&referencedID](const SkString&, const sk_sp<SkSVGNode>& node) {
+            referencedID = SkTMax(referencedID, node->subtreeGenerationID());
+        });
+        ctx.setCacheKey(1);
+        ctx.mixCacheKey(referencedID);
+        ctx.mixCacheKey(SkFloat2Bits(fContainerSize.width()));
+        ctx.mixCacheKey(SkFloat2Bits(fContainerSize.height()));
+
+        fRoot->render(ctx);
     }
 }
 
+SkSVGNode* SkSVGDOM::findNodeById(const char* id) const {
+    const auto* node = fIDMapper.find(SkString(id));
+    return node ? node->get() : nullptr;
+}
+
 SkSize SkSVGDOM::intrinsicSize() const {
     if (!fRoot || fRoot->tag() != SkSVGTag::kSvg) {
         return SkSize::Make(0, 0);
@@ -502,7 +521,6 @@ const SkSize& SkSVGDOM::containerSize() const {
 }
 
 void SkSVGDOM::setContainerSize(const SkSize& containerSize) {
-    // TODO: inval
     fContainerSize = containerSize;
 }
 
@@ -31,6 +31,12 @@ public:
 
     void setRoot(sk_sp<SkSVGNode>);
 
+    // Returns the node with the given id attribute, e.g. to update it with setAttribute() between
+    // renders, or null.
+    SkSVGNode* findNodeById(const char* id) const;
+
+    // Subtrees rendered repeatedly without changes are recorded into pictures and replayed, so
+    // re-rendering after a small update only re-traverses the nodes whose renderings it affects.
     void render(SkCanvas*) const;
 
 private:
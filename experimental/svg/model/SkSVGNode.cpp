@@ -13,12 +13,21 @@
 #include "SkSVGValue.h"
 #include "SkTLazy.h"
 
-SkSVGNode::SkSVGNode(SkSVGTag t) : fTag(t) { }
+#include <atomic>
+
+static uint32_t next_generation_id() {
+    static std::atomic<uint32_t> nextID{1};
+    return nextID++;
+}
+
+SkSVGNode::SkSVGNode(SkSVGTag t) : fTag(t), fGenerationID(next_generation_id()) { }
 
 SkSVGNode::~SkSVGNode() { }
 
 void SkSVGNode::render(const SkSVGRenderContext& ctx) const {
     SkSVGRenderContext localContext(ctx);
+    // Our attributes feed what our descendants inherit.
+    localContext.mixCacheKey(fGenerationID);
 
     if (this->onPrepareToRender(&localContext)) {
         this->onRender(localContext);
@@ -58,6 +67,11 @@ bool SkSVGNode::onPrepareToRender(SkSVGRenderContext* ctx) const {
 
 void SkSVGNode::setAttribute(SkSVGAttribute attr, const SkSVGValue& v) {
     this->onSetAttribute(attr, v);
+    this->invalidate();
+}
+
+void SkSVGNode::invalidate() {
+    fGenerationID = next_generation_id();
 }
 
 void SkSVGNode::setClipPath(const SkSVGClip& clip) {
@@ -49,8 +49,15 @@ public:
     bool asPaint(const SkSVGRenderContext&, SkPaint*) const;
     SkPath asPath(const SkSVGRenderContext&) const;
 
+    // Also invalidates cached renderings of this node (see SkSVGContainer). The typed setters
+    // below don't, so use setAttribute() to update a tree that has already been rendered.
     void setAttribute(SkSVGAttribute, const SkSVGValue&);
 
+    // Changes whenever this node's attributes (or children) do. IDs come from a global counter,
+    // so a subtree's largest ID changes whenever anything in it changes.
+    uint32_t generationID() const { return fGenerationID; }
+    virtual uint32_t subtreeGenerationID() const { return fGenerationID; }
+
     void setClipPath(const SkSVGClip&);
     void setClipRule(const SkSVGFillRule&);
     void setFill(const SkSVGPaint&);
@@ -85,8 +92,12 @@ protected:
 
     virtual bool hasChildren() const { return false; }
 
+    // Assigns a new generationID().
+    void invalidate();
+
 private:
     SkSVGTag                    fTag;
+    uint32_t                    fGenerationID;
 
     // FIXME: this should be sparse
     SkSVGPresentationAttributes fPresentationAttributes;
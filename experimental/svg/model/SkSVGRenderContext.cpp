@@ -8,6 +8,7 @@
 #include "SkSVGRenderContext.h"
 
 #include "SkCanvas.h"
+#include "SkChecksum.h"
 #include "SkDashPathEffect.h"
 #include "SkPath.h"
 #include "SkSVGAttribute.h"
@@ -300,18 +301,29 @@ SkSVGRenderContext::SkSVGRenderContext(const SkSVGRenderContext& other)
     : SkSVGRenderContext(other.fCanvas,
                          other.fIDMapper,
                          *other.fLengthContext,
-                         *other.fPresentationContext) {}
+                         *other.fPresentationContext) {
+    fCacheKey = other.fCacheKey;
+}
 
 SkSVGRenderContext::SkSVGRenderContext(const SkSVGRenderContext& other, SkCanvas* canvas)
     : SkSVGRenderContext(canvas,
                          other.fIDMapper,
                          *other.fLengthContext,
-                         *other.fPresentationContext) {}
+                         *other.fPresentationContext) {
+    fCacheKey = other.fCacheKey;
+}
 
 SkSVGRenderContext::~SkSVGRenderContext() {
     fCanvas->restoreToCount(fCanvasSaveCount);
 }
 
+void SkSVGRenderContext::mixCacheKey(uint32_t id) {
+    if (fCacheKey) {
+        // Keep zero for "disabled".
+        fCacheKey = SkTMax(SkChecksum::Mix(fCacheKey ^ SkChecksum::Mix(id)), 1u);
+    }
+}
+
 const SkSVGNode* SkSVGRenderContext::findNodeById(const SkString& id) const {
     const auto* v = fIDMapper.find(id);
     return v ? v->get() : nullptr;
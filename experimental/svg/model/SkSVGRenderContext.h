@@ -85,6 +85,13 @@ public:
     // The local computed clip path (not inherited).
     const SkPath* clipPath() const { return fClipPath.getMaybeNull(); }
 
+    // Identifies everything a subtree rendered in this context inherits from outside itself:
+    // SkSVGDOM seeds it, and each node mixes in its generationID() on the way down. Zero (the
+    // default) disables caching subtree renderings.
+    uint32_t cacheKey() const { return fCacheKey; }
+    void setCacheKey(uint32_t key) { fCacheKey = key; }
+    void mixCacheKey(uint32_t);
+
 private:
     // Stack-only
     void* operator new(size_t)                               = delete;
@@ -104,6 +111,8 @@ private:
 
     // clipPath, if present for the current context (not inherited).
     SkTLazy<SkPath>                               fClipPath;
+
+    uint32_t                                      fCacheKey = 0;
 };
 
 #endif // SkSVGRenderContext_DEFINED
@@ -6,7 +6,9 @@
  */
 
 #include "SkDebugCanvas.h"
+#include "SkJSONWriter.h"
 #include "SkPicture.h"
+#include "SkStream.h"
 #include "SkSurface.h"
 #include <emscripten.h>
 #include <emscripten/bind.h>
@@ -64,6 +66,20 @@ class SkpDebugPlayer {
       surface->getCanvas()->flush();
     }
 
+    /* profile draws every command to the surface, one at a time, and returns JSON with each
+     * command's cost, for showing the commands as a heat map.
+     */
+    std::string profile(SkSurface* surface) {
+      SkDynamicMemoryWStream stream;
+      SkJSONWriter writer(&stream, SkJSONWriter::Mode::kFast);
+      writer.beginObject(); // root
+      fDebugCanvas->toJSONProfile(writer, surface->getCanvas());
+      writer.endObject(); // root
+      writer.flush();
+      sk_sp<SkData> data = stream.detachAsData();
+      return std::string(static_cast<const char*>(data->data()), data->size());
+    }
+
   private:
     // admission of ignorance - don't know when to use unique pointer or sk_sp
     std::unique_ptr<SkDebugCanvas> fDebugCanvas;
@@ -77,7 +93,8 @@ EMSCRIPTEN_BINDINGS(my_module) {
   class_<SkpDebugPlayer>("SkpDebugPlayer")
     .constructor<>()
     .function("loadSkp", &SkpDebugPlayer::loadSkp, allow_raw_pointers())
-    .function("drawTo", &SkpDebugPlayer::drawTo, allow_raw_pointers());
+    .function("drawTo", &SkpDebugPlayer::drawTo, allow_raw_pointers())
+    .function("profile", &SkpDebugPlayer::profile, allow_raw_pointers());
 
   // Symbols needed by cpu.js to perform surface creation and flushing.
   enum_<SkColorType>("ColorType")
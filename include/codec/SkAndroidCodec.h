@@ -13,6 +13,10 @@
 #include "SkStream.h"
 #include "SkTypes.h"
 
+#if defined(SK_BUILD_FOR_ANDROID) && __ANDROID_API__ >= 26
+#include <android/hardware_buffer.h>
+#endif
+
 /**
  *  Abstract interface defining image codec functionality that is necessary for
  *  Android.
@@ -188,11 +192,22 @@ public:
     //        called SkAndroidCodec.  On the other hand, it's may be a bit confusing to call
     //        these Options when SkCodec has a slightly different set of Options.  Maybe these
     //        should be DecodeOptions or SamplingOptions?
+    /**
+     *  Filters that getAndroidPixels() can resample with, while decoding, to sizes that
+     *  sampling can't reach.
+     */
+    enum class ResizeFilter {
+        kNone,      // Only the sizes returned by getSampledDimensions() are supported.
+        kBox,       // Each output pixel is the average of the pixels it covers.
+        kLanczos3,  // Sharper than kBox, at roughly three times the cost per source pixel.
+    };
+
     struct AndroidOptions {
         AndroidOptions()
             : fZeroInitialized(SkCodec::kNo_ZeroInitialized)
             , fSubset(nullptr)
             , fSampleSize(1)
+            , fResizeFilter(ResizeFilter::kNone)
         {}
 
         /**
@@ -222,6 +237,17 @@ public:
          *  The default is 1, representing no downscaling.
          */
         int fSampleSize;
+
+        /**
+         *  If not kNone, the requested info may have any dimensions no larger than the
+         *  image (or fSubset), and fSampleSize is ignored.  Decoded rows are resampled
+         *  with this filter as they arrive, so the image is never held at full size.
+         *  The codec still does as much of the downscale natively as it can without
+         *  going below the requested size.
+         *
+         *  The default is kNone.
+         */
+        ResizeFilter fResizeFilter;
     };
 
     /**
@@ -263,6 +289,21 @@ public:
      */
     SkCodec::Result getAndroidPixels(const SkImageInfo& info, void* pixels, size_t rowBytes);
 
+#if defined(SK_BUILD_FOR_ANDROID) && __ANDROID_API__ >= 26
+    /**
+     *  Decode directly into hardwareBuffer, locking it for the duration of the decode.
+     *
+     *  The buffer must have a single layer, be CPU-writable, match info's dimensions, and have
+     *  a format that stores info's color type. Pass it to SkImage::MakeFromAHardwareBuffer()
+     *  (which requires AHARDWAREBUFFER_USAGE_GPU_SAMPLED_IMAGE) to draw the decoded image
+     *  without uploading it.
+     *
+     *  Only available on Android, when __ANDROID_API__ is defined to be 26 or greater.
+     */
+    SkCodec::Result getAndroidPixels(const SkImageInfo& info, AHardwareBuffer* hardwareBuffer,
+                                     const AndroidOptions* options);
+#endif
+
     SkCodec::Result getPixels(const SkImageInfo& info, void* pixels, size_t rowBytes) {
         return this->getAndroidPixels(info, pixels, rowBytes);
     }
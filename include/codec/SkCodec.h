@@ -26,6 +26,7 @@
 
 class SkColorSpace;
 class SkData;
+class SkExecutor;
 class SkFrameHolder;
 class SkPngChunkReader;
 class SkSampler;
@@ -257,6 +258,7 @@ public:
             , fSubset(nullptr)
             , fFrameIndex(0)
             , fPriorFrame(kNoFrame)
+            , fExecutor(nullptr)
         {}
 
         ZeroInitialized            fZeroInitialized;
@@ -300,6 +302,17 @@ public:
          *  If set to kNoFrame, the codec will decode any necessary required frame(s) first.
          */
         int                        fPriorFrame;
+
+        /**
+         *  If not NULL, getPixels() may split the decode into bands and decode
+         *  them concurrently on this executor.  The output is identical either
+         *  way.  Currently used for baseline JPEGs with restart markers, and by
+         *  WebP, which turns on libwebp's threading and decodes the next frame of
+         *  an animation ahead of time.
+         *
+         *  Ignored by scanline and incremental decodes.
+         */
+        SkExecutor*                fExecutor;
     };
 
     /**
@@ -384,8 +397,12 @@ public:
      *                    query, except the WidthBytes may be larger than the
      *                    recommendation (but not smaller).
      *  @param planes     Memory for each of the Y, U, and V planes.
+     *  @param executor   If not null, the decode may be split into bands that are
+     *                    decoded concurrently on this executor, as with
+     *                    Options::fExecutor.
      */
-    Result getYUV8Planes(const SkYUVASizeInfo& sizeInfo, void* planes[SkYUVASizeInfo::kMaxCount]) {
+    Result getYUV8Planes(const SkYUVASizeInfo& sizeInfo, void* planes[SkYUVASizeInfo::kMaxCount],
+                         SkExecutor* executor = nullptr) {
         if (!planes || !planes[0] || !planes[1] || !planes[2]) {
             return kInvalidInput;
         }
@@ -395,13 +412,17 @@ public:
             return kCouldNotRewind;
         }
 
-        return this->onGetYUV8Planes(sizeInfo, planes);
+        return this->onGetYUV8Planes(sizeInfo, planes, executor);
     }
 
     /**
      *  Prepare for an incremental decode with the specified options.
      *
-     *  This may require a rewind.
+     *  This may require a rewind.  If the previous call was also an incremental
+     *  decode that finished its rows, some codecs (non-interlaced PNG) can skip
+     *  the rewind and carry on from where they stopped, as long as fSubset starts
+     *  at or below the rows already decoded.  Decoding a tall image in strips from
+     *  top to bottom then only inflates each row once.
      *
      *  If kIncompleteInput is returned, may be called again after more data has
      *  been provided to the source SkStream.
@@ -729,7 +750,8 @@ protected:
     }
 
     virtual Result onGetYUV8Planes(const SkYUVASizeInfo&,
-                                   void*[SkYUVASizeInfo::kMaxCount] /*planes*/) {
+                                   void*[SkYUVASizeInfo::kMaxCount] /*planes*/,
+                                   SkExecutor*) {
         return kUnimplemented;
     }
 
@@ -759,6 +781,16 @@ protected:
         return true;
     }
 
+    /**
+     *  Called by startIncrementalDecode() after a previous incremental decode.
+     *
+     *  Return true if the codec can start the new decode from its current position
+     *  in the stream, without rewinding.
+     */
+    virtual bool onCanResumeIncrementalDecode(const SkImageInfo&, const Options&) {
+        return false;
+    }
+
     /**
      * Get method for the input stream
      */
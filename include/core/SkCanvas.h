@@ -2553,6 +2553,7 @@ private:
 
     void doSave();
     void checkForDeferredSave();
+    void checkForDeferredDeviceSave();
     void internalSetMatrix(const SkMatrix&);
 
     friend class SkAndroidFrameworkUtils;
@@ -20,6 +20,7 @@ class SkArenaAlloc;
 class SkBitmap;
 class SkColorSpace;
 class SkColorSpaceXformer;
+class SkPixmap;
 class SkRasterPipeline;
 class SkString;
 
@@ -80,6 +81,16 @@ public:
     SkColor filterColor(SkColor) const;
     SkColor4f filterColor4f(const SkColor4f&, SkColorSpace*) const;
 
+    /**
+     *  Applies this filter to every pixel of pixmap, in place, as drawing the pixmap through a
+     *  paint with this filter (and kSrc blending) would. Large pixmaps are split into bands of
+     *  rows that run on SkExecutor::GetDefault().
+     *
+     *  Returns false, leaving the pixels untouched, if pixmap's pixels are missing or its color
+     *  type isn't supported.
+     */
+    bool filterPixmap(const SkPixmap& pixmap) const;
+
     /** Create a colorfilter that uses the specified color and mode.
         If the Mode is DST, this function will return NULL (since that
         mode will have no effect on the result).
@@ -9,6 +9,7 @@
 #define SkContourMeasure_DEFINED
 
 #include "../private/SkNoncopyable.h"
+#include "../private/SkTArray.h"
 #include "../private/SkTDArray.h"
 #include "SkPath.h"
 #include "SkRefCnt.h"
@@ -86,6 +87,7 @@ private:
 
     const Segment* distanceToSegment(SkScalar distance, SkScalar* t) const;
 
+    friend class SkContourMeasureCache;
     friend class SkContourMeasureIter;
 };
 
@@ -124,8 +126,18 @@ private:
     SkPath::RawIter fIter;
     SkPath          fPath;
     SkScalar        fTolerance;
+    SkScalar        fResScale;
     bool            fForceClosed;
 
+    // Non-volatile paths' measures are shared through SkContourMeasureCache: either replayed
+    // from it (fFromCache), or collected here as they're built and added once next() is done.
+    SkTArray<sk_sp<SkContourMeasure>> fMeasures;
+    int                               fNextMeasure;
+    bool                              fFromCache;
+    bool                              fCacheable;
+
+    void findInCache();
+
     // temporary
     SkTDArray<SkContourMeasure::Segment>  fSegments;
     SkTDArray<SkPoint>  fPts; // Points used to define the segments
@@ -85,6 +85,13 @@ public:
         return this->onSnapGpuDrawHandler(backendApi, matrix, clipBounds, bufferInfo);
     }
 
+    /**
+     *  Returns a picture that draws what draw() would draw in the drawable's current state. The
+     *  caller owns a ref on the returned picture.
+     *
+     *  Drawables that cache their snapshots (see setCachesSnapshots()) return the same picture
+     *  until their generation ID changes.
+     */
     SkPicture* newPictureSnapshot();
 
     /**
@@ -130,6 +137,15 @@ public:
 
 protected:
     SkDrawable();
+    ~SkDrawable() override;
+
+    /**
+     *  Opts in to keeping the last picture snapshot until notifyDrawingChanged() is called. While
+     *  it's kept, newPictureSnapshot() returns it and draw() plays it back, rather than calling
+     *  onNewPictureSnapshot() or onDraw() again. This suits drawables that are expensive to draw
+     *  and rarely change, and that always call notifyDrawingChanged() when they do.
+     */
+    void setCachesSnapshots(bool cachesSnapshots);
 
     virtual SkRect onGetBounds() = 0;
     virtual void onDraw(SkCanvas*) = 0;
@@ -154,7 +170,10 @@ protected:
     virtual SkPicture* onNewPictureSnapshot();
 
 private:
-    int32_t fGenerationID;
+    int32_t          fGenerationID;
+    uint32_t         fSnapshotGenerationID;
+    sk_sp<SkPicture> fSnapshot;
+    bool             fCachesSnapshots;
 };
 
 #endif
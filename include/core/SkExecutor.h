@@ -20,6 +20,11 @@ public:
     static std::unique_ptr<SkExecutor> MakeFIFOThreadPool(int threads = 0);
     static std::unique_ptr<SkExecutor> MakeLIFOThreadPool(int threads = 0);
 
+    // Create a thread pool SkExecutor where each thread has its own queue of work, and idle threads
+    // steal from the others. Work added by a pool thread goes on that thread's queue and runs
+    // newest first there; work added from outside the pool is spread across the threads.
+    static std::unique_ptr<SkExecutor> MakeWorkStealingThreadPool(int threads = 0);
+
     // There is always a default SkExecutor available by calling SkExecutor::GetDefault().
     static SkExecutor& GetDefault();
     static void SetDefault(SkExecutor*);  // Does not take ownership.  Not thread safe.
@@ -27,6 +32,10 @@ public:
     // Add work to execute.
     virtual void add(std::function<void(void)>) = 0;
 
+    // Add work that should only run when there is no other work waiting, e.g. decoding ahead.
+    // By default this is the same as add().
+    virtual void addBackground(std::function<void(void)> work) { this->add(std::move(work)); }
+
     // If it makes sense for this executor, use this thread to execute work for a little while.
     virtual void borrow() {}
 };
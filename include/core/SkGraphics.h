@@ -103,6 +103,19 @@ public:
      */
     static void PurgeFontCache();
 
+    /**
+     *  Save the glyphs currently in the font cache to a file, which a later process can pass to
+     *  LoadFontCache() to skip rasterizing those glyphs again. Returns false on failure.
+     */
+    static bool SaveFontCache(const char path[]);
+
+    /**
+     *  Use a file written by SaveFontCache() to fill in font cache entries as they are created.
+     *  The file is memory-mapped until the next PurgeFontCache(). Returns false if the file
+     *  could not be read.
+     */
+    static bool LoadFontCache(const char path[]);
+
     /**
      *  Scaling bitmaps with the kHigh_SkFilterQuality setting is
      *  expensive, so the result is saved in the global Scaled Image
@@ -32,6 +32,7 @@
 
 class SkData;
 class SkCanvas;
+class SkExecutor;
 class SkImageFilter;
 class SkImageGenerator;
 class SkPaint;
@@ -1045,6 +1046,24 @@ public:
     */
     bool isLazyGenerated() const;
 
+    /** Starts decoding a lazy-generated SkImage into the raster cache on executor, so that a
+        later draw or readPixels() finds its pixels there instead of decoding on the calling
+        thread. Does nothing if SkImage is not lazy-generated, or its pixels are already cached.
+
+        Requests from all callers share one queue, and are decoded highest priority first.
+        Prefetching an image that is already queued only raises its priority. The queue holds
+        a reference to SkImage until its decode runs or cancelPrefetchDecode() is called.
+
+        @param executor  runs the decode
+        @param priority  requests with larger values are decoded first
+    */
+    void prefetchDecode(SkExecutor& executor, int priority = 0) const;
+
+    /** Removes SkImage from the prefetchDecode() queue, if its decode has not started yet.
+        A decode already in progress runs to completion.
+    */
+    void cancelPrefetchDecode() const;
+
     /** Creates SkImage in target SkColorSpace.
         Returns nullptr if SkImage could not be created.
 
@@ -11,6 +11,9 @@
 #include "../private/SkTDArray.h"
 #include "SkMatrix.h"
 
+#include <memory>
+
+class GrLayerHoister;
 class SkCanvas;
 class SkPaint;
 class SkPicture;
@@ -28,7 +31,7 @@ public:
      *  @param reserve Hint for the number of add calls expected to be issued
      */
     SkMultiPictureDraw(int reserve = 0);
-    ~SkMultiPictureDraw() { this->reset(); }
+    ~SkMultiPictureDraw();
 
     /**
      *  Add a canvas/picture pair for later rendering.
@@ -55,6 +58,14 @@ public:
      */
     void reset();
 
+    /**
+     *  Let draws into GPU canvases keep up to bytes of their pictures' saveLayers as images,
+     *  and composite those on later draws of the same pictures instead of drawing the layers
+     *  again. The images persist across draw() and reset() until they're purged. 0, the
+     *  default, disables this and frees any images kept so far.
+     */
+    void setLayerCacheLimit(size_t bytes);
+
 private:
     struct DrawData {
         SkCanvas*        fCanvas;
@@ -70,6 +81,8 @@ private:
 
     SkTDArray<DrawData> fThreadSafeDrawData;
     SkTDArray<DrawData> fGPUDrawData;
+
+    std::unique_ptr<GrLayerHoister> fLayerHoister;
 };
 
 #endif
@@ -61,9 +61,10 @@ private:
     void drawPosTextCommon(const SkGlyphID[], int, const SkScalar[], int, const SkPoint&,
                            const SkFont&, const SkPaint&);
 
-    inline SkPaint overdrawPaint(const SkPaint& paint);
+    inline const SkPaint& overdrawPaint(const SkPaint& paint);
 
     SkPaint   fPaint;
+    SkPaint   fStrokePaint;  // fPaint with the style and stroke of the last stroked draw
 
     typedef SkCanvasVirtualEnforcer<SkNWayCanvas> INHERITED;
 };
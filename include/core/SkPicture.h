@@ -87,6 +87,23 @@ public:
     static sk_sp<SkPicture> MakeFromData(const void* data, size_t size,
                                          const SkDeserialProcs* procs = nullptr);
 
+    /** Recreates SkPicture that was serialized into data, reading it in place. Returns
+        constructed SkPicture if successful; otherwise, returns nullptr.
+
+        Unlike MakeFromData(), the returned SkPicture keeps data, e.g. a file mapped with
+        SkData::MakeFromFileName, and plays its drawing commands back from it directly rather
+        than recording them again. Drawing part of the picture only reads the commands that
+        draw into that part. Encoded images share data's bytes and are decoded when first
+        drawn. Pictures serialized before this format was padded for in-place reading
+        are still supported, but are copied.
+
+        @param data   container for serial data
+        @param procs  custom serial data decoders; may be nullptr
+        @return       SkPicture backed by data
+    */
+    static sk_sp<SkPicture> MakeFromSharedData(sk_sp<SkData> data,
+                                               const SkDeserialProcs* procs = nullptr);
+
     /** \class SkPicture::AbortCallback
         AbortCallback is an abstract class. An implementation of AbortCallback may
         passed as a parameter to SkPicture::playback, to stop it before all drawing
@@ -209,11 +226,15 @@ private:
     friend class SkBigPicture;
     friend class SkEmptyPicture;
     friend class SkPicturePriv;
+    friend class SkPlaybackPicture;
     template <typename> friend class SkMiniPicture;
 
     void serialize(SkWStream*, const SkSerialProcs*, class SkRefCntSet* typefaces) const;
+    // If inPlace is not null, the stream reads from its memory, and the picture plays back
+    // straight from it rather than being recorded again.
     static sk_sp<SkPicture> MakeFromStream(SkStream*, const SkDeserialProcs*,
-                                           class SkTypefacePlayback*);
+                                           class SkTypefacePlayback*,
+                                           const SkData* inPlace = nullptr);
     friend class SkPictureData;
 
     /** Return true if the SkStream/Buffer represents a serialized picture, and
@@ -267,10 +288,12 @@ private:
     // V66: Add saveBehind
     // V67: Blobs serialize fonts instead of paints
     // V68: Paint doesn't serialize font-related stuff
+    // V69: Pad picture data in streams to 4 bytes so it can be read in place
+    // V70: Serialize the bounds of groups of ops
 
     // Only SKPs within the min/current picture version range (inclusive) can be read.
     static const uint32_t     MIN_PICTURE_VERSION = 56;     // august 2017
-    static const uint32_t CURRENT_PICTURE_VERSION = 68;
+    static const uint32_t CURRENT_PICTURE_VERSION = 70;
 
     static_assert(MIN_PICTURE_VERSION <= 62, "Remove kFontAxes_bad from SkFontDescriptor.cpp");
 
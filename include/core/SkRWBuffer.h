@@ -12,6 +12,7 @@
 
 struct SkBufferBlock;
 struct SkBufferHead;
+class SkData;
 class SkRWBuffer;
 class SkStreamAsset;
 
@@ -27,6 +28,15 @@ public:
      */
     size_t size() const { return fAvailable; }
 
+    /**
+     *  Return the contents as one contiguous SkData. If they lie in a single block, the SkData
+     *  shares that block; otherwise the blocks are copied into memory that's shared with every
+     *  snapshot of the same SkRWBuffer, so that as it grows, each new snapshot only copies the
+     *  bytes appended since the last one asked. Decoding a progressively loaded image from a
+     *  series of snapshots then doesn't recopy the data that had already arrived.
+     */
+    sk_sp<SkData> asData() const;
+
     class SK_API Iter {
     public:
         Iter(const SkROBuffer*);
@@ -94,6 +104,9 @@ public:
         return sk_sp<SkROBuffer>(new SkROBuffer(fHead, fTotalUsed, fTail));
     }
 
+    /**
+     *  The stream's getMemoryBase() is the snapshot's SkROBuffer::asData().
+     */
     std::unique_ptr<SkStreamAsset> makeStreamSnapshot() const;
 
 #ifdef SK_DEBUG
@@ -8,6 +8,7 @@
 #ifndef SkStream_DEFINED
 #define SkStream_DEFINED
 
+#include "../private/SkTArray.h"
 #include "../private/SkTo.h"
 #include "SkData.h"
 #include "SkRefCnt.h"
@@ -85,6 +86,13 @@ public:
      */
     virtual bool isAtEnd() const = 0;
 
+    /** Streams whose bytes arrive over time, like SkReadAheadStream, wait for them in read() and
+     *  peek() unless told not to, in which case they return 0 until there is enough to read.
+     *  SkCodec stops waiting during incremental decodes, so that a decode that catches up with
+     *  the data returns kIncompleteInput instead of blocking.  Other streams ignore this.
+     */
+    virtual void setWaitForData(bool) {}
+
     bool SK_WARN_UNUSED_RESULT readS8(int8_t*);
     bool SK_WARN_UNUSED_RESULT readS16(int16_t*);
     bool SK_WARN_UNUSED_RESULT readS32(int32_t*);
@@ -271,6 +279,11 @@ public:
 
     bool writeStream(SkStream* input, size_t length);
 
+    /** Writes the contents of data.  Streams that can keep data by reference instead of copying
+        it override this; the data must not change after it's written.
+    */
+    virtual bool writeData(sk_sp<SkData> data);
+
     /**
      * This returns the number of bytes in the stream required to store
      * 'value'.
@@ -512,4 +525,64 @@ private:
     typedef SkWStream INHERITED;
 };
 
+/** A SkWStream that holds what's written as a list of segments, so that large SkData, e.g. encoded
+    images, can be written by reference rather than copied.  Smaller writes are gathered into
+    blocks of the stream's own.  The segments can be handed to writev() or sendmsg() as they are,
+    without first being copied into one buffer.
+*/
+class SK_API SkDataListWStream : public SkWStream {
+public:
+    SkDataListWStream();
+    SkDataListWStream(SkDataListWStream&&);
+    SkDataListWStream& operator=(SkDataListWStream&&);
+    ~SkDataListWStream() override;
+
+    /** SkData at least this big is kept by reference by writeData(); smaller SkData is copied. */
+    static constexpr size_t kMinAdoptBytes = 1024;
+
+    bool write(const void* buffer, size_t size) override;
+    bool writeData(sk_sp<SkData> data) override;
+    size_t bytesWritten() const override { return fBytesWritten; }
+
+    /** A piece of the stream's contents, laid out to be copied straight into a struct iovec. */
+    struct Segment {
+        const void* fData;
+        size_t      fSize;
+    };
+
+    /** The number of segments holding the contents. */
+    int segmentCount() const;
+
+    /** Fills out segmentCount() segments, in order.  They stay valid until the stream is next
+        written to, moved, or reset.
+    */
+    void getSegments(Segment segments[]) const;
+
+    /** Copies the contents, bytesWritten() bytes, to dst. */
+    void copyTo(void* dst) const;
+    bool writeToStream(SkWStream* dst) const;
+
+    /** Return the contents as SkData, and then reset the stream.  Contents held in one segment
+        are returned without a copy.
+    */
+    sk_sp<SkData> detachAsData();
+
+    /** Reset the stream to its original, empty, state. */
+    void reset();
+
+private:
+    struct Block;
+
+    // Moves what's been written to fBlock since the last segment was cut from it into a segment.
+    void cutBlockSegment();
+
+    SkTArray<sk_sp<SkData>> fSegments;
+    Block*                  fBlock        = nullptr;  // Small writes are copied here.
+    size_t                  fBlockStart   = 0;        // Where fBlock's uncut bytes start.
+    size_t                  fBlockUsed    = 0;
+    size_t                  fBytesWritten = 0;
+
+    typedef SkWStream INHERITED;
+};
+
 #endif
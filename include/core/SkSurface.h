@@ -467,6 +467,22 @@ public:
     */
     void notifyContentWillChange(ContentChangeMode mode);
 
+    /** Returns bounds of the pixels that may have changed since SkSurface was created, or since
+        resetDamage() was last called. Drawing, writePixels() and notifyContentWillChange() all
+        add to the damage. Draws add their clip bounds, narrowed to the bounds of rect, image and
+        bitmap draws; the result is conservative but never too small.
+
+        Embedders that repaint small areas can use it to limit what they copy or present, e.g. by
+        passing it to a swap-with-damage extension.
+
+        @return  damaged bounds, empty if nothing has changed
+    */
+    SkIRect damage() const;
+
+    /** Empties the bounds returned by damage(), typically after presenting SkSurface.
+    */
+    void resetDamage();
+
     enum BackendHandleAccess {
         kFlushRead_BackendHandleAccess,    //!< back-end object is readable
         kFlushWrite_BackendHandleAccess,   //!< back-end object is writable
@@ -670,6 +686,93 @@ public:
     */
     bool readPixels(const SkBitmap& dst, int srcX, int srcY);
 
+    /** Client-provided context that is passed to the client-provided read pixels callbacks. */
+    typedef void* ReadPixelsContext;
+
+    /** Client-provided callback to asyncReadPixels() that is called once, when the read result
+        is ready or the read has failed. On failure data is nullptr. Otherwise data holds the
+        pixels, rowBytes apart, and is only valid for the duration of the call.
+    */
+    typedef void (*ReadPixelsCallback)(ReadPixelsContext context, const void* data,
+                                       size_t rowBytes);
+
+    /** Client-provided callback to asyncReadPixelsYUV420() that is called once, when the read
+        result is ready or the read has failed. On failure data is nullptr. Otherwise data holds
+        the Y, U and V planes, each rowBytes[i] apart, only valid for the duration of the call.
+    */
+    typedef void (*ReadPixelsYUV420Callback)(ReadPixelsContext context, const void* data[3],
+                                             const size_t rowBytes[3]);
+
+    /** Like readPixels(), but returns without waiting for the pixels. The callback is called
+        with them once they are ready.
+
+        On GPU surfaces the pending draws are flushed and the copy into a transfer buffer is
+        issued right away. The callback is called from a later flush or
+        GrContext::checkAsyncWorkCompletion() once the GPU has finished the copy, so reads can
+        be pipelined with rendering the following frames. When the backend can't read
+        asynchronously, or dstInfo differs from the surface's SkColorType, SkAlphaType or
+        SkColorSpace, the pixels are read and the callback is called before this returns.
+
+        The rectangle of pixels corners are (srcX, srcY) and
+        (srcX + dstInfo.width(), srcY + dstInfo.height()) and must be contained by the surface,
+        otherwise the callback is called with nullptr.
+
+        @param dstInfo   width, height, SkColorType, SkAlphaType and SkColorSpace of the result
+        @param srcX      offset into readable pixels on x-axis
+        @param srcY      offset into readable pixels on y-axis
+        @param callback  function called with the pixels
+        @param context   passed to callback
+    */
+    void asyncReadPixels(const SkImageInfo& dstInfo, int srcX, int srcY,
+                         ReadPixelsCallback callback, ReadPixelsContext context);
+
+    /** Controls the color space asyncRescaleAndReadPixels() filters in. */
+    enum RescaleGamma : bool {
+        kSrc,    //!< filters in the destination's color space, as drawing would
+        kLinear, //!< filters in a linear version of the destination's color space
+    };
+
+    /** Like asyncReadPixels(), but rescales srcRect to dstInfo's width and height, and converts
+        it to dstInfo's SkColorType and SkColorSpace, first. On GPU surfaces the rescale and
+        conversion are drawn on the GPU, so only the result is transferred.
+
+        With kNone_SkFilterQuality the pixels are sampled once. Otherwise downscales by more than
+        half are done in steps of at most half with bilinear filtering, so every source pixel
+        contributes, and a kHigh_SkFilterQuality rescale does its last step with bicubic
+        filtering. With kLinear the steps are kept in a linear, half float color space, which
+        avoids darkening high contrast detail as it's filtered.
+
+        Render targets can't hold unpremultiplied pixels, so when dstInfo is kUnpremul_SkAlphaType
+        the last step is read back synchronously to unpremultiply it.
+
+        srcRect must be contained by the surface, otherwise the callback is called with nullptr.
+
+        @param dstInfo         width, height, SkColorType, SkAlphaType and SkColorSpace of result
+        @param srcRect         rectangle of pixels to rescale
+        @param rescaleGamma    color space the rescale filters in
+        @param rescaleQuality  filtering of the rescale
+        @param callback        function called with the pixels
+        @param context         passed to callback
+    */
+    void asyncRescaleAndReadPixels(const SkImageInfo& dstInfo, const SkIRect& srcRect,
+                                   RescaleGamma rescaleGamma, SkFilterQuality rescaleQuality,
+                                   ReadPixelsCallback callback, ReadPixelsContext context);
+
+    /** Like asyncReadPixels(), but converts srcRect to YUV 4:2:0 planes with yuvColorSpace
+        first. On GPU surfaces the conversion is drawn on the GPU, so only the planes are
+        transferred. The Y plane is srcRect's size and the U and V planes are half of it, rounded
+        up, and are filtered from the source. Only opaque content is supported.
+
+        srcRect must be contained by the surface, otherwise the callback is called with nullptr.
+
+        @param yuvColorSpace  coefficients and range of the conversion
+        @param srcRect        rectangle of pixels to convert
+        @param callback       function called with the planes
+        @param context        passed to callback
+    */
+    void asyncReadPixelsYUV420(SkYUVColorSpace yuvColorSpace, const SkIRect& srcRect,
+                               ReadPixelsYUV420Callback callback, ReadPixelsContext context);
+
     /** Copies SkRect of pixels from the src SkPixmap to the SkSurface.
 
         Source SkRect corners are (0, 0) and (src.width(), src.height()).
@@ -364,6 +364,17 @@ public:
     // Experimental, RunBuffer.pos points to SkRSXform array
     const RunBuffer& allocRunRSXform(const SkFont& font, int count);
 
+    /** Experimental.
+        Reserves storage for runCount more runs totalling glyphCount glyphs, allocated with
+        allocRun(), allocRunPosH() or allocRunPos(). Callers that know the size of their blobs
+        up front build each one with a single allocation this way. make() releases whatever
+        storage goes unused.
+
+        @param runCount    number of runs to reserve storage for
+        @param glyphCount  total number of glyphs in those runs
+    */
+    void reserveRuns(int runCount, int glyphCount);
+
 private:
     const RunBuffer& allocRunText(const SkFont& font,
                                   int count,
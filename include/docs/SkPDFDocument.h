@@ -151,7 +151,9 @@ struct Metadata {
     /** Executor to handle threaded work within PDF Backend. If this is nullptr,
         then all work will be done serially on the main thread. To have worker
         threads assist with various tasks, set this to a valid SkExecutor
-        instance. Currently used for executing Deflate algorithm in parallel.
+        instance. Currently used for executing Deflate algorithm in parallel,
+        including compressing large streams in chunks, and for subsetting
+        fonts.
 
         If set, the PDF output will be non-reproducible in the order and
         internal numbering of objects, but should render the same.
@@ -159,6 +161,27 @@ struct Metadata {
         Experimental.
     */
     SkExecutor* fExecutor = nullptr;
+
+    /** Preferred level of compression for the Deflate algorithm, which is
+        used for content streams, fonts and lossless images.  Lower levels
+        are faster but make larger documents.
+    */
+    enum class CompressionLevel : int {
+        Default = -1,
+        None = 0,
+        LowButFast = 1,
+        Average = 6,
+        HighButSlow = 9,
+    };
+    CompressionLevel fCompressionLevel = CompressionLevel::Default;
+
+    /** If greater than zero, the fonts used by each run of this many pages
+        are written when the run ends, rather than all at once when the
+        document is closed.  Later pages that use the same typefaces get
+        their own subsets, so the document is larger, but memory used for
+        fonts no longer grows with the page count.
+    */
+    int fFontPageRunLength = 0;
 };
 
 /** Associate a node ID with subsequent drawing commands in an
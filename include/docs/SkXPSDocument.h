@@ -14,13 +14,20 @@
 
 #include "SkDocument.h"
 
+class SkExecutor;
 struct IXpsOMObjectFactory;
 
 namespace SkXPS {
 
+/**
+ *  If executor is not null, images are PNG encoded on its threads while the document is drawn,
+ *  rather than inline in each draw. As with SkPDF::Metadata::fExecutor, all drawing still happens
+ *  on the calling thread.
+ */
 SK_API sk_sp<SkDocument> MakeDocument(SkWStream* stream,
                                       IXpsOMObjectFactory* xpsFactory,
-                                      SkScalar dpi = SK_ScalarDefaultRasterDPI);
+                                      SkScalar dpi = SK_ScalarDefaultRasterDPI,
+                                      SkExecutor* executor = nullptr);
 
 }  // namespace SkXPS
 #endif  // SK_BUILD_FOR_WIN
@@ -9,7 +9,9 @@
 #define SkJpegEncoder_DEFINED
 
 #include "SkEncoder.h"
+#include "SkImageInfo.h"
 
+class SkExecutor;
 class SkJpegEncoderMgr;
 class SkWStream;
 
@@ -61,6 +63,15 @@ public:
          *  In the second case, the encoder supports linear or legacy blending.
          */
         AlphaOption fAlphaOption = AlphaOption::kIgnore;
+
+        /**
+         *  Executor to handle threaded work.
+         *
+         *  Sources that libjpeg can't read directly (anything but unblended 8888 and gray) are
+         *  converted to 8888 rows for it a batch at a time.  If this is not nullptr, each batch
+         *  is split across this executor.  Compression itself is always serial.
+         */
+        SkExecutor* fExecutor = nullptr;
     };
 
     /**
@@ -71,6 +82,21 @@ public:
      */
     static bool Encode(SkWStream* dst, const SkPixmap& src, const Options& options);
 
+    /**
+     *  Encode the Y, U and V |planes| to the |dst| stream, as they are.  This skips the
+     *  conversion from RGB (and the downsampling) that Encode() would do.
+     *
+     *  Each plane must be kGray_8 or kAlpha_8.  The size of Y is the size of the image, and U
+     *  and V must be that size reduced by the |options| downsampling factor, rounding up.
+     *  |yuvColorSpace| must be kJPEG_SkYUVColorSpace, since that is what jpegs hold.  The ICC
+     *  profile, if any, comes from the color space of the Y plane.  |options|' fAlphaOption and
+     *  fExecutor have no effect.
+     *
+     *  Returns true on success.  Returns false on invalid or unsupported |planes|.
+     */
+    static bool EncodeYUV(SkWStream* dst, const SkPixmap planes[3], SkYUVColorSpace yuvColorSpace,
+                          const Options& options);
+
     /**
      *  Create a jpeg encoder that will encode the |src| pixels to the |dst| stream.
      *  |options| may be used to control the encoding behavior.
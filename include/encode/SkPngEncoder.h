@@ -11,6 +11,7 @@
 #include "SkEncoder.h"
 #include "SkDataTable.h"
 
+class SkExecutor;
 class SkPngEncoderMgr;
 class SkWStream;
 
@@ -27,6 +28,13 @@ public:
         kAll   = kNone | kSub | kUp | kAvg | kPaeth,
     };
 
+    enum class ZLibStrategy : int {
+        kDefault,
+        kFiltered,
+        kHuffmanOnly,
+        kRLE,
+    };
+
     struct Options {
         /**
          *  Selects which filtering strategies to use.
@@ -53,6 +61,26 @@ public:
          */
         int fZLibLevel = 6;
 
+        /**
+         *  Selects the zlib compression strategy.
+         *
+         *  kDefault matches libpng: kFiltered if rows are filtered, otherwise zlib's default.
+         *  kHuffmanOnly and kRLE skip most or all of zlib's string matching, so they are much
+         *  faster, and on filtered photographic images they often cost little in file size.
+         */
+        ZLibStrategy fZLibStrategy = ZLibStrategy::kDefault;
+
+        /**
+         *  Executor to handle threaded work within Encode().
+         *
+         *  If this is not nullptr, large images are split into bands of rows that are filtered
+         *  and compressed in parallel, each band continuing one zlib stream in its own IDAT
+         *  chunk.  This produces slightly larger files.  If this is nullptr, or the image is too
+         *  small to be worth splitting, all work is done serially.  Encoders returned by Make()
+         *  always encode serially.
+         */
+        SkExecutor* fExecutor = nullptr;
+
         /**
          *  Represents comments in the tEXt ancillary chunk of the png.
          *  The 2i-th entry is the keyword for the i-th comment,
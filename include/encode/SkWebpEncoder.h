@@ -43,6 +43,30 @@ namespace SkWebpEncoder {
      *  Returns true on success.  Returns false on an invalid or unsupported |src|.
      */
     SK_API bool Encode(SkWStream* dst, const SkPixmap& src, const Options& options);
+
+    struct SK_API Frame {
+        /**
+         *  The pixels of the frame.  Every frame must have the same size and color type.
+         */
+        SkPixmap fPixmap;
+
+        /**
+         *  How long to show the frame for, in milliseconds.
+         */
+        int fDuration = 0;
+    };
+
+    /**
+     *  Encode the |frames| to the |dst| stream as an animation that loops forever.
+     *  |options| may be used to control the encoding behavior of each frame.
+     *
+     *  Only the rectangle of each frame that differs from the frame before it is encoded.  A
+     *  frame that doesn't differ at all extends the duration of the one before it instead.
+     *
+     *  Returns true on success.  Returns false on invalid or unsupported |frames|.
+     */
+    SK_API bool EncodeAnimated(SkWStream* dst, const Frame frames[], int frameCount,
+                               const Options& options);
 }
 
 #endif
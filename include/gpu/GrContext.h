@@ -17,6 +17,7 @@
 // We shouldn't need this but currently Android is relying on this being include transitively.
 #include "SkUnPreMultiply.h"
 
+class GrAsyncReadbackQueue;
 class GrAtlasManager;
 class GrBackendFormat;
 class GrBackendSemaphore;
@@ -288,6 +289,22 @@ public:
                                 GrGpuFinishedProc finishedProc = nullptr,
                                 GrGpuFinishedContext finishedContext = nullptr);
 
+    /**
+     * Calls the callbacks of asynchronous work, like SkSurface::asyncReadPixels(), whose GPU side
+     * has finished. This never blocks. Flushing also checks, so this only needs to be called by
+     * clients that wait for results without flushing.
+     */
+    void checkAsyncWorkCompletion();
+
+    /**
+     * Calls proc, at the end of each flush, with a breakdown of where that flush spent its time
+     * and how much work it did. If timeGpu is true and the backend supports it (only GL with timer
+     * queries for now), the GPU's time for earlier flushes is reported as it becomes available.
+     * Pass a null proc to stop. Collecting the stats costs a few clock reads per op list.
+     */
+    void setFlushStatsProc(GrFlushStatsProc proc, GrFlushStatsContext context,
+                           bool timeGpu = false);
+
     /**
      * Deprecated.
      */
@@ -300,14 +317,32 @@ public:
     GrContextPriv priv();
     const GrContextPriv priv() const;
 
-    /** Enumerates all cached GPU resources and dumps their memory to traceMemoryDump. */
+    /**
+     * Enumerates all cached GPU resources and dumps their memory to traceMemoryDump. Also dumps,
+     * per resource type, how many resources were purged to stay within budget and how many of
+     * those had to be recreated afterwards, under "skia/gpu_resource_cache/<type>".
+     */
     // Chrome is using this!
     void dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) const;
 
     bool supportsDistanceFieldText() const;
 
+    /**
+     * On Vulkan, writes the driver's pipeline cache to the PersistentCache if pipelines have been
+     * created since it was last written. This is also done when the context is destroyed, so
+     * calling this is only needed to save the work sooner (e.g. before the app is backgrounded).
+     */
     void storeVkPipelineCacheData();
 
+    /**
+     * Compiles and links the program for a key and data that this context's PersistentCache was
+     * earlier asked to store, e.g. in a previous run, so that the first draw needing it does not.
+     * The result is only checked when the program is first used, so drivers that compile on
+     * their own threads can overlap a batch of these with other work. Returns false if the
+     * backend or the data does not support this. Currently only GL does.
+     */
+    bool precompileShader(const SkData& key, const SkData& data);
+
 protected:
     GrContext(GrBackendApi, const GrContextOptions&, int32_t contextID = SK_InvalidGenID);
 
@@ -328,6 +363,7 @@ private:
     sk_sp<GrGpu>                            fGpu;
     GrResourceCache*                        fResourceCache;
     GrResourceProvider*                     fResourceProvider;
+    std::unique_ptr<GrAsyncReadbackQueue>   fAsyncReadbacks;
 
     bool                                    fDidTestPMConversions;
     // true if the PM/UPM conversion succeeded; false otherwise
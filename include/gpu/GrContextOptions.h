@@ -72,6 +72,14 @@ struct SK_API GrContextOptions {
      */
     SkExecutor* fExecutor = nullptr;
 
+    /**
+     * If true, and there is an fExecutor, ops that can generate their vertex data without touching
+     * any GPU resources (e.g. convex and tessellated paths) do so on the executor's threads while
+     * a flush is preparing. Their data is copied into the flush's vertex and index buffers, and
+     * their draws recorded, in the usual order afterwards.
+     */
+    bool fPrepareOpsConcurrently = false;
+
     /** Construct mipmaps manually, via repeated downsampling draw-calls. This is used when
         the driver's implementation (glGenerateMipmap) contains bugs. This requires mipmap
         level and LOD control (ie desktop or ES3). */
@@ -102,11 +110,36 @@ struct SK_API GrContextOptions {
      */
     bool fDisableGpuYUVConversion = false;
 
+    /**
+     * Gaussian blurs whose sigma is too large to convolve directly are computed on a downsampled
+     * copy of their source. If true, large blurs are downsampled further and convolved with
+     * shorter kernels. This costs roughly half as much, and the results are slightly softer and
+     * blockier near hard edges.
+     */
+    bool fReducedQualityBlurs = false;
+
+    /**
+     * If true, promise images made with the same fulfill and release procs, texture context and
+     * pixel config share a single call to the fulfill proc for as long as any of them is alive
+     * (e.g., when each DDL of a frame makes its own promise images for the same client textures).
+     * Only set this if the fulfill proc always returns the same texture for a texture context.
+     */
+    bool fSharePromiseImageTextures = false;
+
     /**
      * The maximum size of cache textures used for Skia's Glyph cache.
      */
     size_t fGlyphCacheTextureMaximumBytes = 2048 * 1024 * 4;
 
+    /**
+     * If greater than zero, raster images no larger than this in either dimension (at most 256)
+     * that are drawn more than once are copied into shared atlas textures, rather than each getting
+     * a texture of its own. Draws of different such images (icons, avatars) can then be batched.
+     * Only drawImage/drawImageRect calls whose paints have no shader, filters or mipmapping use
+     * the atlas.
+     */
+    int fImageAtlasMaxImageSize = 0;
+
     /**
      * Below this threshold size in device space distance field fonts won't be used. Distance field
      * fonts don't support hinting which is more important at smaller sizes. A negative value means
@@ -164,6 +197,14 @@ struct SK_API GrContextOptions {
      */
     Enable fReduceOpListSplitting = Enable::kDefault;
 
+    /**
+     * If true, each GrRenderTargetOpList reorders its ops, without changing the result, so that
+     * ops of the same kind reading the same textures draw consecutively. An op is never moved past
+     * another whose bounds it overlaps. This reduces program and texture binds (see
+     * GrFlushStats::fProgramBinds) when different kinds of draws interleave without overlapping.
+     */
+    bool fSortOpsByState = false;
+
     /**
      * Some ES3 contexts report the ES2 external image extension, but not the ES3 version.
      * If support for external images is critical, enabling this option will cause Ganesh to limit
@@ -191,6 +232,13 @@ struct SK_API GrContextOptions {
      */
      bool fDisallowGLSLBinaryCaching = false;
 
+    /**
+     * If true, the signed distance fields generated for small paths are also stored in the
+     * PersistentCache, and looked up there before being generated again. They are always shared
+     * between the GrContexts in a process.
+     */
+    bool fPersistDistanceFieldPaths = false;
+
 #if GR_TEST_UTILS
     /**
      * Private options that are only meant for testing within Skia's tools.
@@ -217,6 +265,11 @@ struct SK_API GrContextOptions {
      */
     bool fSuppressGeometryShaders = false;
 
+    /**
+     * If true, GrFillRectOp always tessellates its quads rather than drawing them as instances.
+     */
+    bool fSuppressInstancedRects = false;
+
     /**
      * Render everything in wireframe
      */
@@ -268,6 +268,39 @@ enum GrFlushFlags {
 typedef void* GrGpuFinishedContext;
 typedef void (*GrGpuFinishedProc)(GrGpuFinishedContext finishedContext);
 
+/**
+ * Statistics for one flush of a GrContext, passed to the GrFlushStatsProc set with
+ * GrContext::setFlushStatsProc(). Times are CPU wall clock nanoseconds spent on the flushing
+ * thread, except for fGpuNanos.
+ */
+struct GrFlushStats {
+    // Counts up from 1 with each flush of the context, whether or not its stats were reported.
+    uint64_t fFlushID;
+
+    uint64_t fAllocateNanos; // Assigning GPU resources to the op lists' proxies.
+    uint64_t fPrepareNanos;  // Ops preparing their draws: vertex data, atlases, etc.
+    uint64_t fUploadNanos;   // Texture data uploaded before the ops executed.
+    uint64_t fExecuteNanos;  // Ops issuing their draws to the backend API.
+    uint64_t fSubmitNanos;   // Handing the recorded work to the GPU.
+    uint64_t fTotalNanos;    // The whole flush, including resource allocation and cleanup.
+
+    int      fOpLists;       // Op lists executed.
+    int      fOpChains;      // Chains of combined ops executed, at most one per op recorded.
+    int      fDraws;         // Draws issued to the backend, each with its own pipeline.
+    int      fMeshes;        // Meshes drawn by those draws.
+    int      fProgramBinds;  // Times the backend switched to a different program or pipeline.
+    uint64_t fBytesUploaded; // Texture data written from the CPU since the previous flush.
+
+    // When GPU timing was asked for and the backend supports it, the GPU time of an earlier flush
+    // whose work has since finished, usually a few flushes ago. fGpuTimedFlushID is that flush's
+    // fFlushID, or 0 if no result was ready.
+    uint64_t fGpuTimedFlushID;
+    uint64_t fGpuNanos;
+};
+
+typedef void* GrFlushStatsContext;
+typedef void (*GrFlushStatsProc)(GrFlushStatsContext context, const GrFlushStats& stats);
+
 /**
  * Enum used as return value when flush with semaphores so the client knows whether the semaphores
  * were submitted to GPU or not.
@@ -97,6 +97,7 @@ public:
         GrGLFunction<GrGLBlendFuncFn> fBlendFunc;
         GrGLFunction<GrGLBlitFramebufferFn> fBlitFramebuffer;
         GrGLFunction<GrGLBufferDataFn> fBufferData;
+        GrGLFunction<GrGLBufferStorageFn> fBufferStorage;
         GrGLFunction<GrGLBufferSubDataFn> fBufferSubData;
         GrGLFunction<GrGLCheckFramebufferStatusFn> fCheckFramebufferStatus;
         GrGLFunction<GrGLClearFn> fClear;
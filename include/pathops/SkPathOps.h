@@ -11,6 +11,7 @@
 #include "../private/SkTDArray.h"
 #include "SkPreConfig.h"
 
+class SkExecutor;
 class SkPath;
 struct SkRect;
 
@@ -96,15 +97,21 @@ public:
     /** Computes the sum of all paths and operands, and resets the builder to its
         initial state.
 
+        When every operand is a union, paths whose bounds don't overlap, directly or through
+        other paths, are combined independently, and in parallel if an executor is given.
+
         @param result The product of the operands.
+        @param executor If not null, runs independent unions concurrently. Must outlive the call.
         @return True if the operation succeeded.
       */
-    bool resolve(SkPath* result);
+    bool resolve(SkPath* result, SkExecutor* executor = nullptr);
 
 private:
     SkTArray<SkPath> fPathRefs;
     SkTDArray<SkPathOp> fOps;
 
+    bool unionGroups(SkPath* result, SkExecutor* executor);
+
     static bool FixWinding(SkPath* path);
     static void ReversePath(SkPath* path);
     void reset();
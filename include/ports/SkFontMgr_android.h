@@ -37,6 +37,13 @@ struct SkFontMgr_Android_CustomFonts {
      *  system IO resources on initialization.
      */
     bool fIsolated;
+
+    /** Optional path of a file in which to cache what is learned from the font files (names,
+     *  styles, axes and character coverage), so that later font managers need not open them.
+     *  An entry is used only while its font file's size and modification time are unchanged;
+     *  the file is rewritten when any entry had to be rebuilt.
+     */
+    const char* fFontIndex = nullptr;
 };
 
 /** Create a font manager for Android. If 'custom' is NULL, use only system fonts. */
@@ -15,6 +15,7 @@
 class GrDrawingManager;
 class GrOnFlushCallbackObject;
 class GrOpMemoryPool;
+class GrPaintConversionCache;
 class GrRecordingContextPriv;
 class GrStrikeCache;
 class GrTextBlobCache;
@@ -45,6 +46,8 @@ protected:
     GrTextBlobCache* getTextBlobCache();
     const GrTextBlobCache* getTextBlobCache() const;
 
+    GrPaintConversionCache* getPaintConversionCache() { return fPaintConversionCache.get(); }
+
     /**
      * Registers an object for flush-related callbacks. (See GrOnFlushCallbackObject.)
      *
@@ -112,6 +115,7 @@ private:
 
     std::unique_ptr<GrStrikeCache>    fStrikeCache;
     std::unique_ptr<GrTextBlobCache>  fTextBlobCache;
+    std::unique_ptr<GrPaintConversionCache> fPaintConversionCache;
 
     GrAuditTrail                      fAuditTrail;
 
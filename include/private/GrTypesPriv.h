@@ -827,6 +827,11 @@ T* const* unique_ptr_address_as_pointer_address(std::unique_ptr<T> const* up) {
  */
 typedef uint64_t GrFence;
 
+/*
+ * Object for measuring how long the GPU takes to do a span of work
+ */
+typedef uint64_t GrTimerQuery;
+
 /**
  * Used to include or exclude specific GPU path renderers for testing purposes.
  */
@@ -840,6 +845,7 @@ enum class GpuPathRenderers {
     kAALinearizing     = 1 << 5,
     kSmall             = 1 << 6,
     kTessellating      = 1 << 7,
+    kSkc               = 1 << 8, // Experimental, requires SK_ENABLE_SKC. Not part of kAll.
 
     kAll               = (kTessellating | (kTessellating - 1))
 };
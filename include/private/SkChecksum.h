@@ -13,6 +13,8 @@
 #include "SkTLogic.h"
 #include "SkTypes.h"
 
+#include <string.h>
+
 // #include "SkOpts.h"
 // It's sort of pesky to be able to include SkOpts.h here, so we'll just re-declare what we need.
 namespace SkOpts {
@@ -50,6 +52,48 @@ public:
     }
 };
 
+/**
+ *  Hashes a key handed over in pieces, e.g. as it's built, without first copying it all into one
+ *  buffer.  The hash depends only on the seed and the bytes written, not on how they were split
+ *  into calls to write().  Keys up to kBlockBytes long hash just as SkOpts::hash_fn() would hash
+ *  them in one piece; longer keys are hashed a block at a time, each seeded with the hash so far.
+ */
+class SkHasher {
+public:
+    static constexpr size_t kBlockBytes = 512;
+
+    explicit SkHasher(uint32_t seed = 0) : fHash(seed), fCount(0) {}
+
+    void write(const void* data, size_t bytes) {
+        auto src = (const uint8_t*)data;
+        while (bytes > 0) {
+            // A full block is only hashed once we know it isn't the last.
+            if (fCount == kBlockBytes) {
+                fHash  = SkOpts::hash_fn(fBuffer, kBlockBytes, fHash);
+                fCount = 0;
+            }
+            if (fCount == 0 && bytes > kBlockBytes) {
+                fHash  = SkOpts::hash_fn(src, kBlockBytes, fHash);
+                src   += kBlockBytes;
+                bytes -= kBlockBytes;
+                continue;
+            }
+            size_t n = SkTMin(bytes, kBlockBytes - fCount);
+            memcpy(fBuffer + fCount, src, n);
+            fCount += n;
+            src    += n;
+            bytes  -= n;
+        }
+    }
+
+    uint32_t finish() const { return SkOpts::hash_fn(fBuffer, fCount, fHash); }
+
+private:
+    uint32_t fHash;
+    size_t   fCount;
+    uint8_t  fBuffer[kBlockBytes];
+};
+
 // SkGoodHash should usually be your first choice in hashing data.
 // It should be both reasonably fast and high quality.
 struct SkGoodHash {
@@ -413,6 +413,8 @@ typedef SkNx<4, uint32_t> Sk4u;
     #include "SkNx_sse.h"
 #elif !defined(SKNX_NO_SIMD) && defined(SK_ARM_HAS_NEON)
     #include "SkNx_neon.h"
+#elif !defined(SKNX_NO_SIMD) && defined(__wasm_simd128__)
+    #include "SkNx_wasm.h"
 #else
 
 AI static Sk4i Sk4f_round(const Sk4f& x) {
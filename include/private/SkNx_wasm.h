@@ -0,0 +1,220 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkNx_wasm_DEFINED
+#define SkNx_wasm_DEFINED
+
+#include <math.h>
+#include <string.h>
+
+// WebAssembly SIMD (-msimd128). Only Sk4f is specialized here, the type our geometry code (paths,
+// pathops, stroking) leans on. It's written with the compiler's generic vector extensions, which
+// the wasm backend lowers to the 128-bit SIMD instructions; everything else stays portable.
+
+namespace {  // NOLINT(google-build-namespaces)
+
+typedef float    SkWasmF4 __attribute__((vector_size(16)));
+typedef int32_t  SkWasmI4 __attribute__((vector_size(16)));
+typedef uint32_t SkWasmU4 __attribute__((vector_size(16)));
+typedef uint16_t SkWasmH4 __attribute__((vector_size(8)));
+typedef uint8_t  SkWasmB4 __attribute__((vector_size(4)));
+
+// Transposes four rows of four floats, e.g. four RGBA pixels to four channels (or back).
+AI static void sk_wasm_transpose(SkWasmF4* a, SkWasmF4* b, SkWasmF4* c, SkWasmF4* d) {
+    SkWasmF4 ab_lo = __builtin_shufflevector(*a, *b, 0,4,1,5),
+             cd_lo = __builtin_shufflevector(*c, *d, 0,4,1,5),
+             ab_hi = __builtin_shufflevector(*a, *b, 2,6,3,7),
+             cd_hi = __builtin_shufflevector(*c, *d, 2,6,3,7);
+    *a = __builtin_shufflevector(ab_lo, cd_lo, 0,1,4,5);
+    *b = __builtin_shufflevector(ab_lo, cd_lo, 2,3,6,7);
+    *c = __builtin_shufflevector(ab_hi, cd_hi, 0,1,4,5);
+    *d = __builtin_shufflevector(ab_hi, cd_hi, 2,3,6,7);
+}
+
+template <>
+class SkNx<4, float> {
+public:
+    AI SkNx(const SkWasmF4& vec) : fVec(vec) {}
+
+    AI SkNx() {}
+    AI SkNx(float val) : fVec(SkWasmF4{val, val, val, val}) {}
+    AI SkNx(float a, float b, float c, float d) : fVec(SkWasmF4{a, b, c, d}) {}
+
+    AI static SkNx Load(const void* ptr) {
+        SkWasmF4 vec;
+        memcpy(&vec, ptr, sizeof(vec));
+        return vec;
+    }
+    AI void store(void* ptr) const { memcpy(ptr, &fVec, sizeof(fVec)); }
+
+    AI static void Load2(const void* ptr, SkNx* x, SkNx* y) {
+        SkWasmF4 lo = Load(ptr).fVec,
+                 hi = Load((const float*)ptr + 4).fVec;
+        *x = __builtin_shufflevector(lo, hi, 0,2,4,6);
+        *y = __builtin_shufflevector(lo, hi, 1,3,5,7);
+    }
+    AI static void Store2(void* dst, const SkNx& a, const SkNx& b) {
+        SkNx(__builtin_shufflevector(a.fVec, b.fVec, 0,4,1,5)).store((float*)dst + 0);
+        SkNx(__builtin_shufflevector(a.fVec, b.fVec, 2,6,3,7)).store((float*)dst + 4);
+    }
+
+    AI static void Load4(const void* ptr, SkNx* r, SkNx* g, SkNx* b, SkNx* a) {
+        const float* fs = (const float*)ptr;
+        SkWasmF4 v0 = Load(fs +  0).fVec,
+                 v1 = Load(fs +  4).fVec,
+                 v2 = Load(fs +  8).fVec,
+                 v3 = Load(fs + 12).fVec;
+        sk_wasm_transpose(&v0, &v1, &v2, &v3);
+        *r = v0;
+        *g = v1;
+        *b = v2;
+        *a = v3;
+    }
+    AI static void Store4(void* dst, const SkNx& r, const SkNx& g, const SkNx& b, const SkNx& a) {
+        SkWasmF4 v0 = r.fVec,
+                 v1 = g.fVec,
+                 v2 = b.fVec,
+                 v3 = a.fVec;
+        sk_wasm_transpose(&v0, &v1, &v2, &v3);
+        float* fs = (float*)dst;
+        SkNx(v0).store(fs +  0);
+        SkNx(v1).store(fs +  4);
+        SkNx(v2).store(fs +  8);
+        SkNx(v3).store(fs + 12);
+    }
+
+    AI SkNx operator - () const { return -fVec; }
+
+    AI SkNx operator + (const SkNx& o) const { return fVec + o.fVec; }
+    AI SkNx operator - (const SkNx& o) const { return fVec - o.fVec; }
+    AI SkNx operator * (const SkNx& o) const { return fVec * o.fVec; }
+    AI SkNx operator / (const SkNx& o) const { return fVec / o.fVec; }
+
+    // Comparisons produce lanes of all 1 or all 0 bits, like the other backends.
+    AI SkNx operator == (const SkNx& o) const { return (SkWasmF4)(fVec == o.fVec); }
+    AI SkNx operator != (const SkNx& o) const { return (SkWasmF4)(fVec != o.fVec); }
+    AI SkNx operator  < (const SkNx& o) const { return (SkWasmF4)(fVec  < o.fVec); }
+    AI SkNx operator  > (const SkNx& o) const { return (SkWasmF4)(fVec  > o.fVec); }
+    AI SkNx operator <= (const SkNx& o) const { return (SkWasmF4)(fVec <= o.fVec); }
+    AI SkNx operator >= (const SkNx& o) const { return (SkWasmF4)(fVec >= o.fVec); }
+
+    // Like _mm_min_ps and _mm_max_ps, these return r if either is NaN.
+    AI static SkNx Min(const SkNx& l, const SkNx& r) { return (l < r).thenElse(l, r); }
+    AI static SkNx Max(const SkNx& l, const SkNx& r) { return (l > r).thenElse(l, r); }
+
+    AI SkNx abs() const {
+        return (SkWasmF4)((SkWasmI4)fVec & SkWasmI4{0x7fffffff, 0x7fffffff,
+                                                    0x7fffffff, 0x7fffffff});
+    }
+    AI SkNx floor() const {
+        // Roundtrip through integers via truncation, then subtract 1 if that's too big (possible
+        // for negative values). As with NEON, this limits the domain to around 2^31.
+        SkWasmF4 roundtrip = __builtin_convertvector(__builtin_convertvector(fVec, SkWasmI4),
+                                                     SkWasmF4);
+        SkWasmI4 too_big = roundtrip > fVec;
+        return roundtrip - (SkWasmF4)(too_big & (SkWasmI4)SkWasmF4{1, 1, 1, 1});
+    }
+
+    AI SkNx sqrt() const {
+    #if defined(__has_builtin) && __has_builtin(__builtin_wasm_sqrt_f32x4)
+        return __builtin_wasm_sqrt_f32x4(fVec);
+    #else
+        return SkWasmF4{sqrtf(fVec[0]), sqrtf(fVec[1]), sqrtf(fVec[2]), sqrtf(fVec[3])};
+    #endif
+    }
+    AI SkNx  rsqrt() const { return SkNx(1) / this->sqrt(); }
+    AI SkNx invert() const { return SkNx(1) / *this; }
+
+    AI float operator[](int k) const {
+        SkASSERT(0 <= k && k < 4);
+        return fVec[k&3];
+    }
+
+    AI float min() const {
+        SkNx min = Min(*this, __builtin_shufflevector(fVec, fVec, 1,0,3,2));
+        min = Min(min, __builtin_shufflevector(min.fVec, min.fVec, 3,2,1,0));
+        return min[0];
+    }
+
+    AI float max() const {
+        SkNx max = Max(*this, __builtin_shufflevector(fVec, fVec, 1,0,3,2));
+        max = Max(max, __builtin_shufflevector(max.fVec, max.fVec, 3,2,1,0));
+        return max[0];
+    }
+
+    AI bool allTrue() const {
+        SkWasmI4 m = (SkWasmI4)fVec;
+        return 0 != (m[0] & m[1] & m[2] & m[3]);
+    }
+    AI bool anyTrue() const {
+        SkWasmI4 m = (SkWasmI4)fVec;
+        return 0 != (m[0] | m[1] | m[2] | m[3]);
+    }
+
+    AI SkNx thenElse(const SkNx& t, const SkNx& e) const {
+        SkWasmI4 m = (SkWasmI4)fVec;
+        return (SkWasmF4)((m & (SkWasmI4)t.fVec) | (~m & (SkWasmI4)e.fVec));
+    }
+
+    SkWasmF4 fVec;
+};
+
+// The other 4-wide types are portable, so these go through memory to reach a vector register.
+template<> AI /*static*/ Sk4f SkNx_cast<float, int32_t>(const Sk4i& src) {
+    SkWasmI4 vec;
+    src.store(&vec);
+    return __builtin_convertvector(vec, SkWasmF4);
+}
+
+template<> AI /*static*/ Sk4f SkNx_cast<float, uint32_t>(const Sk4u& src) {
+    SkWasmU4 vec;
+    src.store(&vec);
+    return __builtin_convertvector(vec, SkWasmF4);
+}
+
+template<> AI /*static*/ Sk4f SkNx_cast<float, uint16_t>(const Sk4h& src) {
+    SkWasmH4 vec;
+    src.store(&vec);
+    return __builtin_convertvector(vec, SkWasmF4);
+}
+
+template<> AI /*static*/ Sk4f SkNx_cast<float, uint8_t>(const Sk4b& src) {
+    SkWasmB4 vec;
+    src.store(&vec);
+    return __builtin_convertvector(vec, SkWasmF4);
+}
+
+template<> AI /*static*/ Sk4i SkNx_cast<int32_t, float>(const Sk4f& src) {
+    SkWasmI4 vec = __builtin_convertvector(src.fVec, SkWasmI4);
+    return Sk4i::Load(&vec);
+}
+
+template<> AI /*static*/ Sk4u SkNx_cast<uint32_t, float>(const Sk4f& src) {
+    SkWasmU4 vec = __builtin_convertvector(src.fVec, SkWasmU4);
+    return Sk4u::Load(&vec);
+}
+
+template<> AI /*static*/ Sk4h SkNx_cast<uint16_t, float>(const Sk4f& src) {
+    SkWasmH4 vec = __builtin_convertvector(__builtin_convertvector(src.fVec, SkWasmI4), SkWasmH4);
+    return Sk4h::Load(&vec);
+}
+
+template<> AI /*static*/ Sk4b SkNx_cast<uint8_t, float>(const Sk4f& src) {
+    SkWasmB4 vec = __builtin_convertvector(__builtin_convertvector(src.fVec, SkWasmI4), SkWasmB4);
+    return Sk4b::Load(&vec);
+}
+
+AI static Sk4i Sk4f_round(const Sk4f& x) {
+    return { (int) lrintf (x[0]),
+             (int) lrintf (x[1]),
+             (int) lrintf (x[2]),
+             (int) lrintf (x[3]), };
+}
+
+}  // namespace
+
+#endif//SkNx_wasm_DEFINED
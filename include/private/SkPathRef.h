@@ -539,6 +539,8 @@ private:
         return fPoints;
     }
 
+    struct GenIDChangeListeners;
+
     void callGenIDChangeListeners();
 
     enum {
@@ -560,8 +562,8 @@ private:
     mutable uint32_t    fGenerationID;
     SkDEBUGCODE(std::atomic<int> fEditorsAttached;) // assert only one editor in use at any time.
 
-    SkMutex                         fGenIDChangeListenersMutex;
-    SkTDArray<GenIDChangeListener*> fGenIDChangeListeners;  // pointers are reffed
+    // Allocated by the first addGenIDChangeListener(), since most paths never have listeners.
+    std::atomic<GenIDChangeListeners*> fGenIDChangeListeners{nullptr};
 
     mutable uint8_t  fBoundsIsDirty;
     mutable bool     fIsFinite;    // only meaningful if bounds are valid
@@ -9,12 +9,37 @@
 #define SkAnimCodecPlayer_DEFINED
 
 #include "SkCodec.h"
+#include "../private/SkMutex.h"
 
+class SkExecutor;
 class SkImage;
+class SkTaskGroup;
 
 class SkAnimCodecPlayer {
 public:
+    struct Options {
+        /**
+         *  Decoded frames are kept for as long as they fit in this many bytes, dropping the least
+         *  recently used first.  The current frame is always kept.  By default every frame is
+         *  kept once decoded.
+         */
+        size_t fCacheBudget = SIZE_MAX;
+
+        /**
+         *  If this is not nullptr, the current frame and the ones after it are decoded ahead of
+         *  time on this executor, so that playing and seeking wait on decoding less often.
+         */
+        SkExecutor* fExecutor = nullptr;
+
+        /**
+         *  How many frames after the current one to decode ahead of time, if there is an
+         *  executor.  Never more than fit in the cache alongside the current frame.
+         */
+        int fPrefetchCount = 4;
+    };
+
     SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec);
+    SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec, const Options& options);
     ~SkAnimCodecPlayer();
 
     /**
@@ -37,7 +62,8 @@ public:
 
     /**
      *  Finds the closest frame associated with the time code (in milliseconds) and sets that
-     *  to be the current frame (call getFrame() to retrieve that image).
+     *  to be the current frame (call getFrame() to retrieve that image).  Decoding it starts
+     *  from the closest cached frame it depends on, rather than from the first frame.
      *  Returns true iff this call to seek() changed the "current frame" for the animation.
      *  Thus if seek() returns false, then getFrame() will return the same image as it did
      *  before this call to seek().
@@ -52,8 +78,24 @@ private:
     std::vector<sk_sp<SkImage> >    fImages;
     int                             fCurrIndex = 0;
     uint32_t                        fTotalDuration;
+    const Options                   fOptions;
+
+    // For animations, fMutex guards fCodec, the cache and fCurrIndex, which prefetching shares.
+    SkMutex                         fMutex;
+    std::vector<uint64_t>           fLastUsed;   // When each cached frame was last used.
+    uint64_t                        fUseCount = 0;
+    int                             fCachedCount = 0;
+    int                             fMaxCachedCount;
+    bool                            fPrefetching = false;
+    bool                            fShuttingDown = false;
+    std::unique_ptr<SkTaskGroup>    fTaskGroup;
 
+    // These are all called with fMutex held.
     sk_sp<SkImage> getFrameAt(int index);
+    bool decodeFrame(int index);
+    int findCachedPriorFrame(int index) const;
+    void cacheFrame(int index, sk_sp<SkImage> image);
+    void prefetch();
 };
 
 #endif
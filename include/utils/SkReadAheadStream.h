@@ -0,0 +1,57 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkReadAheadStream_DEFINED
+#define SkReadAheadStream_DEFINED
+
+#include "SkStream.h"
+
+#include <functional>
+
+class SkExecutor;
+
+/**
+ *  A stream that reads ahead of its reader, for sources like the network or a slow disk.
+ *
+ *  Up to windowBytes of the source are read ahead on an SkExecutor, so the reader is only held
+ *  up when it catches up with the source.  By default read() and peek() then wait, like any
+ *  other stream.  After setWaitForData(false), as SkCodec::startIncrementalDecode() does, they
+ *  return 0 without consuming anything until min(size, windowBytes) bytes have arrived (or the
+ *  rest of the source, if it has ended), so an incremental decode returns kIncompleteInput and
+ *  can be retried from onData instead of blocking the decoding thread.
+ *
+ *  rewind() restarts from the beginning of the source, and works if the source can rewind.
+ *  Like other streams, this is to be used by one thread at a time; only the read ahead happens
+ *  on the executor.
+ */
+class SK_API SkReadAheadStream : public SkStream {
+public:
+    static constexpr size_t kDefaultWindowBytes = 256 * 1024;
+
+    /**
+     *  @param source    The stream to read ahead.  It's read on the executor's threads.
+     *  @param executor  Where to read ahead.  If null, SkExecutor::GetDefault().
+     *  @param onData    If set, called on the executor's threads after each piece of the source
+     *                   arrives and once the source has ended, e.g. to retry a decode.
+     *  @return null if source is null.
+     */
+    static std::unique_ptr<SkReadAheadStream> Make(std::unique_ptr<SkStream> source,
+                                                   SkExecutor* executor,
+                                                   size_t windowBytes = kDefaultWindowBytes,
+                                                   std::function<void()> onData = nullptr);
+
+    /** Waits for a read of the source in progress to finish. */
+    ~SkReadAheadStream() override {}
+
+    /** The number of bytes that can be read now without waiting. */
+    virtual size_t bytesAvailable() const = 0;
+
+    /** True once everything left of the source has arrived. */
+    virtual bool hasAllData() const = 0;
+};
+
+#endif
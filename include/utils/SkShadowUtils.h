@@ -51,6 +51,18 @@ public:
      */
     static void ComputeTonalColors(SkColor inAmbientColor, SkColor inSpotColor,
                                    SkColor* outAmbientColor, SkColor* outSpotColor);
+
+    struct CacheStats {
+        int fHits;
+        int fMisses;
+    };
+
+    /**
+     * How often tessellated shadows have been found in the cache, rather than tessellated,
+     * since the last ResetCacheStats(). Shadows drawn analytically don't count.
+     */
+    static CacheStats GetCacheStats();
+    static void ResetCacheStats();
 };
 
 #endif
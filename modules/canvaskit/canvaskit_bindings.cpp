@@ -30,6 +30,8 @@
 #include "SkPath.h"
 #include "SkPathEffect.h"
 #include "SkPathOps.h"
+#include "SkRRect.h"
+#include "SkRSXform.h"
 #include "SkScalar.h"
 #include "SkShader.h"
 #include "SkShadowUtils.h"
@@ -39,6 +41,7 @@
 #include "SkSurface.h"
 #include "SkSurfaceProps.h"
 #include "SkTextBlob.h"
+#include "SkTo.h"
 #include "SkTrimPathEffect.h"
 #include "SkTypeface.h"
 #include "SkTypes.h"
@@ -46,6 +49,7 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include "WasmAliases.h"
 #include <emscripten.h>
@@ -156,6 +160,28 @@ sk_sp<SkSurface> MakeRenderTarget(sk_sp<GrContext> grContext, SimpleImageInfo si
                              nullptr, true));
     return surface;
 }
+
+// Wraps a texture that JS filled itself (e.g. with texImage2D from a video element) as an SkImage,
+// so the pixels never leave the GPU. The image adopts the texture and deletes it when it's done.
+sk_sp<SkImage> MakeImageFromGLTexture(SkSurface& surface, uint32_t texID, int width, int height,
+                                      SkAlphaType alphaType) {
+    GrContext* grContext = surface.getCanvas()->getGrContext();
+    if (!grContext) {
+        SkDebugf("Can only make images from textures on a GPU surface\n");
+        return nullptr;
+    }
+    // Uploading the texture changed GL state behind Skia's back.
+    grContext->resetContext(kTextureBinding_GrGLBackendState | kPixelStore_GrGLBackendState);
+
+    GrGLTextureInfo info;
+    info.fTarget = GL_TEXTURE_2D;
+    info.fID = texID;
+    info.fFormat = GL_RGBA8;
+    GrBackendTexture backendTexture(width, height, GrMipMapped::kNo, info);
+    // texImage2D puts the first row of the source at the start of the texture.
+    return SkImage::MakeFromAdoptedTexture(grContext, backendTexture, kTopLeft_GrSurfaceOrigin,
+                                           kRGBA_8888_SkColorType, alphaType);
+}
 #endif
 
 
@@ -534,6 +560,203 @@ void drawShapedText(SkCanvas& canvas, ShapedText st, SkScalar x,
     canvas.drawTextBlob(st.blob(), x, y, paint);
 }
 
+// =================================================================================
+// Batched draw commands
+// =================================================================================
+
+// Draw commands are written by interface.js into a buffer of 32 bit words in the WASM heap and
+// replayed with a single call, rather than paying the embind overhead for every draw. Each
+// command is an opcode followed by its arguments. Coordinates are floats; opcodes, colors and
+// paint/font handles are uint32s. Text is UTF-8 in a second, byte sized buffer, referenced by
+// offset and length. These opcodes must match CanvasKit.SkDrawCommandBuffer in interface.js.
+static const int DRAW_CMD_CLEAR        = 0;  // color
+static const int DRAW_CMD_SAVE         = 1;
+static const int DRAW_CMD_RESTORE      = 2;
+static const int DRAW_CMD_TRANSLATE    = 3;  // dx, dy
+static const int DRAW_CMD_SCALE        = 4;  // sx, sy
+static const int DRAW_CMD_ROTATE       = 5;  // degrees
+static const int DRAW_CMD_CLIP_RECT    = 6;  // l, t, r, b, SkClipOp, doAntiAlias
+static const int DRAW_CMD_RECT         = 7;  // l, t, r, b, paint
+static const int DRAW_CMD_OVAL         = 8;  // l, t, r, b, paint
+static const int DRAW_CMD_ROUND_RECT   = 9;  // l, t, r, b, rx, ry, paint
+static const int DRAW_CMD_CIRCLE       = 10; // cx, cy, radius, paint
+static const int DRAW_CMD_LINE         = 11; // x0, y0, x1, y1, paint
+static const int DRAW_CMD_TEXT         = 12; // byte offset, byte length, x, y, font, paint
+static const int DRAW_CMD_PAINT_COLOR  = 13; // paint, color
+
+// The paints and fonts draw commands refer to by handle, i.e. by their index here. They are
+// copied in once, so replaying commands doesn't marshal a paint per draw.
+class DrawCommandResources {
+public:
+    int addPaint(const SkPaint& paint) {
+        fPaints.push_back(paint);
+        return SkToInt(fPaints.size()) - 1;
+    }
+
+    bool setPaint(int handle, const SkPaint& paint) {
+        if (handle < 0 || handle >= SkToInt(fPaints.size())) {
+            return false;
+        }
+        fPaints[handle] = paint;
+        return true;
+    }
+
+    int addFont(const SkFont& font) {
+        fFonts.push_back(font);
+        return SkToInt(fFonts.size()) - 1;
+    }
+
+    void reset() {
+        fPaints.clear();
+        fFonts.clear();
+    }
+
+    SkPaint* paint(uint32_t handle) {
+        return handle < fPaints.size() ? &fPaints[handle] : nullptr;
+    }
+
+    const SkFont* font(uint32_t handle) const {
+        return handle < fFonts.size() ? &fFonts[handle] : nullptr;
+    }
+
+private:
+    std::vector<SkPaint> fPaints;
+    std::vector<SkFont>  fFonts;
+};
+
+// Returns false, having drawn the commands before it, if a command is malformed.
+bool DrawCommands(SkCanvas& canvas, DrawCommandResources& res,
+                  uintptr_t /* uint32_t* */ wptr, int numWords,
+                  uintptr_t /* char* */ bptr, int numBytes) {
+    const auto* words = reinterpret_cast<const uint32_t*>(wptr);
+    const auto* floats = reinterpret_cast<const float*>(wptr);
+    const char* bytes = reinterpret_cast<const char*>(bptr);
+    auto f = [floats](int i) { return floats[i]; };
+
+    #define CHECK_NUM_ARGS(n) \
+        if ((i + n) > numWords) { \
+            SkDebugf("Not enough args for draw command %u at word %d\n", op, i - 1); \
+            return false; \
+        }
+    #define GET_PAINT(p, i) \
+        SkPaint* p = res.paint(words[i]); \
+        if (!p) { \
+            SkDebugf("Unknown paint handle %u at word %d\n", words[i], i); \
+            return false; \
+        }
+
+    for (int i = 0; i < numWords;) {
+        uint32_t op = words[i++];
+        switch (op) {
+            case DRAW_CMD_CLEAR:
+                CHECK_NUM_ARGS(1);
+                canvas.clear(SkColor(words[i]));
+                i += 1;
+                break;
+            case DRAW_CMD_SAVE:
+                canvas.save();
+                break;
+            case DRAW_CMD_RESTORE:
+                canvas.restore();
+                break;
+            case DRAW_CMD_TRANSLATE:
+                CHECK_NUM_ARGS(2);
+                canvas.translate(f(i), f(i + 1));
+                i += 2;
+                break;
+            case DRAW_CMD_SCALE:
+                CHECK_NUM_ARGS(2);
+                canvas.scale(f(i), f(i + 1));
+                i += 2;
+                break;
+            case DRAW_CMD_ROTATE:
+                CHECK_NUM_ARGS(1);
+                canvas.rotate(f(i));
+                i += 1;
+                break;
+            case DRAW_CMD_CLIP_RECT:
+                CHECK_NUM_ARGS(6);
+                if (words[i + 4] > (uint32_t)SkClipOp::kIntersect) {
+                    SkDebugf("Unknown clip op %u at word %d\n", words[i + 4], i + 4);
+                    return false;
+                }
+                canvas.clipRect(SkRect::MakeLTRB(f(i), f(i + 1), f(i + 2), f(i + 3)),
+                                (SkClipOp)words[i + 4], words[i + 5] != 0);
+                i += 6;
+                break;
+            case DRAW_CMD_RECT: {
+                CHECK_NUM_ARGS(5);
+                GET_PAINT(paint, i + 4);
+                canvas.drawRect(SkRect::MakeLTRB(f(i), f(i + 1), f(i + 2), f(i + 3)), *paint);
+                i += 5;
+                break;
+            }
+            case DRAW_CMD_OVAL: {
+                CHECK_NUM_ARGS(5);
+                GET_PAINT(paint, i + 4);
+                canvas.drawOval(SkRect::MakeLTRB(f(i), f(i + 1), f(i + 2), f(i + 3)), *paint);
+                i += 5;
+                break;
+            }
+            case DRAW_CMD_ROUND_RECT: {
+                CHECK_NUM_ARGS(7);
+                GET_PAINT(paint, i + 6);
+                canvas.drawRoundRect(SkRect::MakeLTRB(f(i), f(i + 1), f(i + 2), f(i + 3)),
+                                     f(i + 4), f(i + 5), *paint);
+                i += 7;
+                break;
+            }
+            case DRAW_CMD_CIRCLE: {
+                CHECK_NUM_ARGS(4);
+                GET_PAINT(paint, i + 3);
+                canvas.drawCircle(f(i), f(i + 1), f(i + 2), *paint);
+                i += 4;
+                break;
+            }
+            case DRAW_CMD_LINE: {
+                CHECK_NUM_ARGS(5);
+                GET_PAINT(paint, i + 4);
+                canvas.drawLine(f(i), f(i + 1), f(i + 2), f(i + 3), *paint);
+                i += 5;
+                break;
+            }
+            case DRAW_CMD_TEXT: {
+                CHECK_NUM_ARGS(6);
+                uint32_t offset = words[i], len = words[i + 1];
+                if (offset > (uint32_t)numBytes || len > (uint32_t)numBytes - offset) {
+                    SkDebugf("Text bytes [%u, %u) out of range at word %d\n",
+                             offset, offset + len, i);
+                    return false;
+                }
+                const SkFont* font = res.font(words[i + 4]);
+                if (!font) {
+                    SkDebugf("Unknown font handle %u at word %d\n", words[i + 4], i + 4);
+                    return false;
+                }
+                GET_PAINT(paint, i + 5);
+                canvas.drawSimpleText(bytes + offset, len, SkTextEncoding::kUTF8,
+                                      f(i + 2), f(i + 3), *font, *paint);
+                i += 6;
+                break;
+            }
+            case DRAW_CMD_PAINT_COLOR: {
+                CHECK_NUM_ARGS(2);
+                GET_PAINT(paint, i);
+                paint->setColor(SkColor(words[i + 1]));
+                i += 2;
+                break;
+            }
+            default:
+                SkDebugf("Unknown draw command %u at word %d\n", op, i - 1);
+                return false;
+        }
+    }
+
+    #undef CHECK_NUM_ARGS
+    #undef GET_PAINT
+    return true;
+}
+
 // These objects have private destructors / delete mthods - I don't think
 // we need to do anything other than tell emscripten to do nothing.
 namespace emscripten {
@@ -625,6 +848,17 @@ EMSCRIPTEN_BINDINGS(Skia) {
 
         return SkImage::MakeRasterData(info, pixelData, rowBytes);
     }), allow_raw_pointers());
+    function("_MakeImageWithoutCopy", optional_override([](SimpleImageInfo ii,
+                                                           uintptr_t /* uint8_t*  */ pPtr, int plen,
+                                                           size_t rowBytes)->sk_sp<SkImage> {
+        // See comment above for uintptr_t explanation
+        // The pixels belong to JS (see CanvasKit.Malloc), and must outlive the image.
+        const uint8_t* pixels = reinterpret_cast<const uint8_t*>(pPtr);
+        SkImageInfo info = toSkImageInfo(ii);
+        sk_sp<SkData> pixelData = SkData::MakeWithoutCopy(pixels, plen);
+
+        return SkImage::MakeRasterData(info, pixelData, rowBytes);
+    }), allow_raw_pointers());
     // Allow localMatrix to be optional, so we have 2 declarations of these shaders
     function("_MakeImageShader", optional_override([](sk_sp<SkImage> img,
                                 SkShader::TileMode tx, SkShader::TileMode ty,
@@ -750,6 +984,17 @@ EMSCRIPTEN_BINDINGS(Skia) {
             self.concat(toSkMatrix(m));
         }))
         .function("drawArc", &SkCanvas::drawArc)
+        .function("_drawAtlas", optional_override([](SkCanvas& self,
+                const sk_sp<SkImage>& atlas, uintptr_t /* SkRSXform* */ xptr,
+                uintptr_t /* SkRect* */ rptr, uintptr_t /* SkColor* */ cptr, int count,
+                SkBlendMode mode, const SkPaint* paint)->void {
+            // See comment above for uintptr_t explanation
+            const SkRSXform* dstXforms = reinterpret_cast<const SkRSXform*>(xptr);
+            const SkRect* srcRects = reinterpret_cast<const SkRect*>(rptr);
+            const SkColor* colors = reinterpret_cast<const SkColor*>(cptr);
+
+            self.drawAtlas(atlas, dstXforms, srcRects, colors, count, mode, nullptr, paint);
+        }), allow_raw_pointers())
         .function("drawImage", select_overload<void (const sk_sp<SkImage>&, SkScalar, SkScalar, const SkPaint*)>(&SkCanvas::drawImage), allow_raw_pointers())
         .function("drawImageRect", optional_override([](SkCanvas& self, const sk_sp<SkImage>& image,
                                                         SkRect src, SkRect dst,
@@ -781,6 +1026,7 @@ EMSCRIPTEN_BINDINGS(Skia) {
 
             self.drawSimpleText(str, len, SkTextEncoding::kUTF8, x, y, font, paint);
         }))
+        .function("_drawCommands", &DrawCommands)
         .function("drawTextBlob", select_overload<void (const sk_sp<SkTextBlob>&, SkScalar, SkScalar, const SkPaint&)>(&SkCanvas::drawTextBlob))
         .function("drawVertices", select_overload<void (const sk_sp<SkVertices>&, SkBlendMode, const SkPaint&)>(&SkCanvas::drawVertices))
         .function("flush", &SkCanvas::flush)
@@ -822,6 +1068,13 @@ EMSCRIPTEN_BINDINGS(Skia) {
         .smart_ptr<sk_sp<SkData>>("sk_sp<SkData>>")
         .function("size", &SkData::size);
 
+    class_<DrawCommandResources>("_DrawCommandResources")
+        .constructor<>()
+        .function("addFont", &DrawCommandResources::addFont)
+        .function("addPaint", &DrawCommandResources::addPaint)
+        .function("reset", &DrawCommandResources::reset)
+        .function("setPaint", &DrawCommandResources::setPaint);
+
     class_<SkFont>("SkFont")
         .constructor<>()
         .constructor<sk_sp<SkTypeface>>()
@@ -979,6 +1232,9 @@ EMSCRIPTEN_BINDINGS(Skia) {
         .function("_flush", select_overload<void()>(&SkSurface::flush))
         .function("getCanvas", &SkSurface::getCanvas, allow_raw_pointers())
         .function("height", &SkSurface::height)
+#if SK_SUPPORT_GPU
+        .function("_makeImageFromGLTexture", &MakeImageFromGLTexture)
+#endif
         .function("makeImageSnapshot", select_overload<sk_sp<SkImage>()>(&SkSurface::makeImageSnapshot))
         .function("makeImageSnapshot", select_overload<sk_sp<SkImage>(const SkIRect& bounds)>(&SkSurface::makeImageSnapshot))
         .function("makeSurface", optional_override([](SkSurface& self, SimpleImageInfo sii)->sk_sp<SkSurface> {
@@ -1000,6 +1256,27 @@ EMSCRIPTEN_BINDINGS(Skia) {
     class_<SkTypeface>("SkTypeface")
         .smart_ptr<sk_sp<SkTypeface>>("sk_sp<SkTypeface>");
 
+    // The pointers into the builder's storage are handed back to interface.js as numbers,
+    // which wraps them in TypedArrays to fill in (see comment above for uintptr_t explanation).
+    class_<SkVertices::Builder>("SkVerticesBuilder")
+        .constructor<SkVertices::VertexMode, int, int, uint32_t>()
+        .function("_colors", optional_override([](SkVertices::Builder& self)->uintptr_t {
+            return reinterpret_cast<uintptr_t>(self.colors());
+        }))
+        .function("detach", &SkVertices::Builder::detach)
+        .function("indexCount", &SkVertices::Builder::indexCount)
+        .function("_indices", optional_override([](SkVertices::Builder& self)->uintptr_t {
+            return reinterpret_cast<uintptr_t>(self.indices());
+        }))
+        .function("isValid", &SkVertices::Builder::isValid)
+        .function("_positions", optional_override([](SkVertices::Builder& self)->uintptr_t {
+            return reinterpret_cast<uintptr_t>(self.positions());
+        }))
+        .function("_texCoords", optional_override([](SkVertices::Builder& self)->uintptr_t {
+            return reinterpret_cast<uintptr_t>(self.texCoords());
+        }))
+        .function("vertexCount", &SkVertices::Builder::vertexCount);
+
     class_<SkVertices>("SkVertices")
         .smart_ptr<sk_sp<SkVertices>>("sk_sp<SkVertices>")
         .function("_applyBones", optional_override([](SkVertices& self, uintptr_t /* Bone* */ bptr, int boneCount)->sk_sp<SkVertices> {
@@ -1223,4 +1500,25 @@ EMSCRIPTEN_BINDINGS(Skia) {
     constant("CONIC_VERB", CONIC);
     constant("CUBIC_VERB", CUBIC);
     constant("CLOSE_VERB", CLOSE);
+
+    // Flags for SkVerticesBuilder
+    constant("HAS_TEXCOORDS_VERTICES_FLAG",   (uint32_t) SkVertices::kHasTexCoords_BuilderFlag);
+    constant("HAS_COLORS_VERTICES_FLAG",      (uint32_t) SkVertices::kHasColors_BuilderFlag);
+    constant("IS_NON_VOLATILE_VERTICES_FLAG", (uint32_t) SkVertices::kIsNonVolatile_BuilderFlag);
+
+    // Opcodes for SkDrawCommandBuffer
+    constant("_DRAW_CMD_CLEAR",       DRAW_CMD_CLEAR);
+    constant("_DRAW_CMD_SAVE",        DRAW_CMD_SAVE);
+    constant("_DRAW_CMD_RESTORE",     DRAW_CMD_RESTORE);
+    constant("_DRAW_CMD_TRANSLATE",   DRAW_CMD_TRANSLATE);
+    constant("_DRAW_CMD_SCALE",       DRAW_CMD_SCALE);
+    constant("_DRAW_CMD_ROTATE",      DRAW_CMD_ROTATE);
+    constant("_DRAW_CMD_CLIP_RECT",   DRAW_CMD_CLIP_RECT);
+    constant("_DRAW_CMD_RECT",        DRAW_CMD_RECT);
+    constant("_DRAW_CMD_OVAL",        DRAW_CMD_OVAL);
+    constant("_DRAW_CMD_ROUND_RECT",  DRAW_CMD_ROUND_RECT);
+    constant("_DRAW_CMD_CIRCLE",      DRAW_CMD_CIRCLE);
+    constant("_DRAW_CMD_LINE",        DRAW_CMD_LINE);
+    constant("_DRAW_CMD_TEXT",        DRAW_CMD_TEXT);
+    constant("_DRAW_CMD_PAINT_COLOR", DRAW_CMD_PAINT_COLOR);
 }
@@ -33,6 +33,8 @@ var CanvasKit = {
 	ImageData: function() {},
 
 	GetWebGLContext: function() {},
+	Free: function() {},
+	Malloc: function() {},
 	MakeBlurMaskFilter: function() {},
 	MakeCanvas: function() {},
 	MakeCanvasSurface: function() {},
@@ -56,6 +58,7 @@ var CanvasKit = {
 	/** @return {RadialCanvasGradient} */
 	MakeTwoPointConicalGradientShader: function() {},
 	MakeWebGLCanvasSurface: function() {},
+	SkDrawCommandBuffer: function() {},
 	currentContext: function() {},
 	getColorComponents: function() {},
 	getSkDataBytes: function() {},
@@ -65,6 +68,7 @@ var CanvasKit = {
 	// private API (i.e. things declared in the bindings that we use
 	// in the pre-js file)
 	_MakeImage: function() {},
+	_MakeImageWithoutCopy: function() {},
 	_MakeImageShader: function() {},
 	_MakeLinearGradientShader: function() {},
 	_MakePathFromCmds: function() {},
@@ -84,6 +88,14 @@ var CanvasKit = {
 
 	// Objects and properties on CanvasKit
 
+	_DrawCommandResources: {
+		addFont: function() {},
+		addPaint: function() {},
+		reset: function() {},
+		setPaint: function() {},
+		delete: function() {},
+	},
+
 	ShapedText: {
 		// public API (from C++ bindings)
 		getBounds: function() {},
@@ -121,6 +133,8 @@ var CanvasKit = {
 		translate: function() {},
 
 		// private API
+		_drawAtlas: function() {},
+		_drawCommands: function() {},
 		_drawSimpleText: function() {},
 		_readPixels: function() {},
 		_writePixels: function() {},
@@ -258,6 +272,7 @@ var CanvasKit = {
 		// private API
 		_flush: function() {},
 		_getRasterN32PremulSurface: function() {},
+		_makeImageFromGLTexture: function() {},
 		delete: function() {},
 	},
 
@@ -278,6 +293,22 @@ var CanvasKit = {
 		_applyBones: function() {},
 	},
 
+	SkVerticesBuilder: {
+		// public API (from C++ bindings)
+		/** @return {CanvasKit.SkVertices} */
+		detach: function() {},
+		indexCount: function() {},
+		isValid: function() {},
+		vertexCount: function() {},
+
+		// private API
+		_colors: function() {},
+		_indices: function() {},
+		_positions: function() {},
+		_texCoords: function() {},
+		delete: function() {},
+	},
+
 	// Constants and Enums
 	gpu: {},
 	skottie: {},
@@ -297,6 +328,25 @@ var CanvasKit = {
 	CUBIC_VERB: {},
 	CLOSE_VERB: {},
 
+	HAS_TEXCOORDS_VERTICES_FLAG: {},
+	HAS_COLORS_VERTICES_FLAG: {},
+	IS_NON_VOLATILE_VERTICES_FLAG: {},
+
+	_DRAW_CMD_CLEAR: {},
+	_DRAW_CMD_SAVE: {},
+	_DRAW_CMD_RESTORE: {},
+	_DRAW_CMD_TRANSLATE: {},
+	_DRAW_CMD_SCALE: {},
+	_DRAW_CMD_ROTATE: {},
+	_DRAW_CMD_CLIP_RECT: {},
+	_DRAW_CMD_RECT: {},
+	_DRAW_CMD_OVAL: {},
+	_DRAW_CMD_ROUND_RECT: {},
+	_DRAW_CMD_CIRCLE: {},
+	_DRAW_CMD_LINE: {},
+	_DRAW_CMD_TEXT: {},
+	_DRAW_CMD_PAINT_COLOR: {},
+
 	AlphaType: {
 		Opaque: {},
 		Premul: {},
@@ -482,12 +532,20 @@ CanvasKit.SkPath.prototype.trim = function() {};
 
 CanvasKit.SkSurface.prototype.flush = function() {};
 CanvasKit.SkSurface.prototype.dispose = function() {};
+CanvasKit.SkSurface.prototype.makeImageFromTextureSource = function() {};
+
+CanvasKit.SkVerticesBuilder.prototype.colors = function() {};
+CanvasKit.SkVerticesBuilder.prototype.indices = function() {};
+CanvasKit.SkVerticesBuilder.prototype.positions = function() {};
+CanvasKit.SkVerticesBuilder.prototype.texCoords = function() {};
 
 /** @return {CanvasKit.SkVertices} */
 CanvasKit.SkVertices.prototype.applyBones = function() {};
 
 CanvasKit.SkImage.prototype.encodeToData = function() {};
 
+CanvasKit.SkCanvas.prototype.drawAtlas = function() {};
+CanvasKit.SkCanvas.prototype.drawCommands = function() {};
 CanvasKit.SkCanvas.prototype.drawText = function() {};
 /** @return {Uint8Array} */
 CanvasKit.SkCanvas.prototype.readPixels = function() {};
@@ -495,6 +553,26 @@ CanvasKit.SkCanvas.prototype.writePixels = function() {};
 
 CanvasKit.SkFontMgr.prototype.MakeTypefaceFromData = function() {};
 
+CanvasKit.SkDrawCommandBuffer.prototype.addFont = function() {};
+CanvasKit.SkDrawCommandBuffer.prototype.addPaint = function() {};
+CanvasKit.SkDrawCommandBuffer.prototype.clear = function() {};
+CanvasKit.SkDrawCommandBuffer.prototype.clipRect = function() {};
+CanvasKit.SkDrawCommandBuffer.prototype.delete = function() {};
+CanvasKit.SkDrawCommandBuffer.prototype.drawCircle = function() {};
+CanvasKit.SkDrawCommandBuffer.prototype.drawLine = function() {};
+CanvasKit.SkDrawCommandBuffer.prototype.drawOval = function() {};
+CanvasKit.SkDrawCommandBuffer.prototype.drawRect = function() {};
+CanvasKit.SkDrawCommandBuffer.prototype.drawRoundRect = function() {};
+CanvasKit.SkDrawCommandBuffer.prototype.drawText = function() {};
+CanvasKit.SkDrawCommandBuffer.prototype.reset = function() {};
+CanvasKit.SkDrawCommandBuffer.prototype.restore = function() {};
+CanvasKit.SkDrawCommandBuffer.prototype.rotate = function() {};
+CanvasKit.SkDrawCommandBuffer.prototype.save = function() {};
+CanvasKit.SkDrawCommandBuffer.prototype.scale = function() {};
+CanvasKit.SkDrawCommandBuffer.prototype.setPaint = function() {};
+CanvasKit.SkDrawCommandBuffer.prototype.setPaintColor = function() {};
+CanvasKit.SkDrawCommandBuffer.prototype.translate = function() {};
+
 // Define StrokeOpts object
 var StrokeOpts = {};
 StrokeOpts.prototype.width;
@@ -85,5 +85,39 @@
       };
       // Default to trying WebGL first.
       CanvasKit.MakeCanvasSurface = CanvasKit.MakeWebGLCanvasSurface;
+
+      // Makes an SkImage of source, which can be anything WebGL's texImage2D takes (e.g. an
+      // HTMLVideoElement, ImageBitmap or HTMLCanvasElement), by uploading it to a texture in
+      // this surface's WebGL context. The pixels go straight to the GPU rather than being read
+      // back into the WASM heap, so this is cheap enough to do for every frame of a video.
+      // The image owns the texture; delete the image when it has been drawn.
+      CanvasKit.SkSurface.prototype.makeImageFromTextureSource = function(source, width, height) {
+        width = width || source.videoWidth || source.width;
+        height = height || source.videoHeight || source.height;
+        var gl = GL.currentContext && GL.currentContext.GLctx;
+        if (!gl || !width || !height) {
+          SkDebug('makeImageFromTextureSource needs a current WebGL context and a size');
+          return null;
+        }
+        var tex = gl.createTexture();
+        gl.bindTexture(gl.TEXTURE_2D, tex);
+        // Skia draws premultiplied images, but leave the setting as it was for Skia's own uploads.
+        gl.pixelStorei(gl.UNPACK_PREMULTIPLY_ALPHA_WEBGL, true);
+        gl.texImage2D(gl.TEXTURE_2D, 0, gl.RGBA, gl.RGBA, gl.UNSIGNED_BYTE, source);
+        gl.pixelStorei(gl.UNPACK_PREMULTIPLY_ALPHA_WEBGL, false);
+
+        // GL is an emscripten provided helper. Registering the texture in its table gives it the
+        // id that the C++ code (and glDeleteTextures, when the image is done with it) refers to.
+        var id = GL.getNewId(GL.textures);
+        GL.textures[id] = tex;
+        var img = this._makeImageFromGLTexture(id, width, height, CanvasKit.AlphaType.Premul);
+        if (!img) {
+          SkDebug('Could not make an image from the texture');
+          GL.textures[id] = null;
+          gl.deleteTexture(tex);
+          return null;
+        }
+        return img;
+      };
     });
 }(Module)); // When this file is loaded in, the high level object is "Module";
@@ -59,12 +59,56 @@ function almostEqual(floata, floatb) {
 
 var nullptr = 0; // emscripten doesn't like to take null as uintptr_t
 
-// arr can be a normal JS array or a TypedArray
+// Allocates memory for length elements of typedArray (e.g. Float32Array) in the WASM
+// heap. JS can fill it in and hand it to the APIs that take arrays (MakeImage,
+// MakeSkVertices, drawAtlas, ...) without it being copied again on the way in.
+// Growing the heap detaches any views of it, so rather than keeping the result of
+// toTypedArray() around, call it again each time the memory is to be written.
+// The memory must be released with CanvasKit.Free.
+CanvasKit.Malloc = function(typedArray, length) {
+  var byteLength = length * typedArray.BYTES_PER_ELEMENT;
+  var ptr = CanvasKit._malloc(byteLength);
+  var ta = null;
+  return {
+    '_ck': true,
+    'length': length,
+    'byteLength': byteLength,
+    'byteOffset': ptr,
+    'toTypedArray': function() {
+      if (!ta || ta.buffer !== CanvasKit.HEAPU8.buffer) {
+        ta = new typedArray(CanvasKit.HEAPU8.buffer, ptr, length);
+      }
+      return ta;
+    },
+  };
+}
+
+// Frees memory from CanvasKit.Malloc. Anything made from it in place (e.g. an
+// image from MakeImage) must be deleted first.
+CanvasKit.Free = function(mObj) {
+  CanvasKit._free(mObj.byteOffset);
+  mObj.byteOffset = nullptr;
+  mObj.toTypedArray = null;
+}
+
+// Use this to free the pointers from copy1dArray or copy2dArray, which may have
+// been made by the user with CanvasKit.Malloc rather than copied.
+function freeArraysThatAreNotMallocedByUsers(ptr, arr) {
+  if (ptr && !(arr && arr['_ck'])) {
+    CanvasKit._free(ptr);
+  }
+}
+
+// arr can be a normal JS array, a TypedArray, or memory from CanvasKit.Malloc
+// (which is used where it is rather than copied).
 // dest is something like CanvasKit.HEAPF32
 function copy1dArray(arr, dest) {
   if (!arr || !arr.length) {
     return nullptr;
   }
+  if (arr['_ck']) {
+    return arr.byteOffset;
+  }
   var ptr = CanvasKit._malloc(arr.length * dest.BYTES_PER_ELEMENT);
   // In c++ terms, the WASM heap is a uint8_t*, a long buffer/array of single
   // byte elements. When we run _malloc, we always get an offset/pointer into
@@ -80,12 +124,15 @@ function copy1dArray(arr, dest) {
 }
 
 // arr should be a non-jagged 2d JS array (TypedArrays can't be nested
-//     inside themselves.)
+//     inside themselves), or flattened memory from CanvasKit.Malloc.
 // dest is something like CanvasKit.HEAPF32
 function copy2dArray(arr, dest) {
   if (!arr || !arr.length) {
     return nullptr;
   }
+  if (arr['_ck']) {
+    return arr.byteOffset;
+  }
   var ptr = CanvasKit._malloc(arr.length * arr[0].length * dest.BYTES_PER_ELEMENT);
   var idx = 0;
   var adjustedPtr = ptr / dest.BYTES_PER_ELEMENT;
@@ -223,7 +223,7 @@ CanvasKit.onRuntimeInitialized = function() {
       var a = args;
       this._addRoundRect(a[0], a[1], a[2], a[3], rptr, ccw);
     }
-    CanvasKit._free(rptr);
+    freeArraysThatAreNotMallocedByUsers(rptr, radii);
     return this;
   };
 
@@ -368,6 +368,30 @@ CanvasKit.onRuntimeInitialized = function() {
     return vert;
   }
 
+  // These return views of the builder's own storage in the WASM heap, so filling them
+  // in builds the SkVertices in place. As with CanvasKit.Malloc, growing the heap
+  // detaches them, so get them again rather than keeping them across other calls.
+  // texCoords, colors and indices return null if the builder wasn't made with them.
+  CanvasKit.SkVerticesBuilder.prototype.positions = function() {
+    return new Float32Array(CanvasKit.HEAPU8.buffer, this._positions(), this.vertexCount() * 2);
+  }
+
+  CanvasKit.SkVerticesBuilder.prototype.texCoords = function() {
+    var ptr = this._texCoords();
+    return ptr ? new Float32Array(CanvasKit.HEAPU8.buffer, ptr, this.vertexCount() * 2) : null;
+  }
+
+  // Colors are SkColors, e.g. from CanvasKit.Color.
+  CanvasKit.SkVerticesBuilder.prototype.colors = function() {
+    var ptr = this._colors();
+    return ptr ? new Uint32Array(CanvasKit.HEAPU8.buffer, ptr, this.vertexCount()) : null;
+  }
+
+  CanvasKit.SkVerticesBuilder.prototype.indices = function() {
+    var ptr = this._indices();
+    return ptr ? new Uint16Array(CanvasKit.HEAPU8.buffer, ptr, this.indexCount()) : null;
+  }
+
   CanvasKit.SkImage.prototype.encodeToData = function() {
     if (!arguments.length) {
       return this._encodeToData();
@@ -397,6 +421,45 @@ CanvasKit.onRuntimeInitialized = function() {
     }
   }
 
+  // atlas is an SkImage. srcRects and dstXforms have 4 floats per sprite: the
+  // [left, top, right, bottom] of the part of atlas to draw, and the
+  // [scos, ssin, tx, ty] of the SkRSXform to draw it with. colors is optional,
+  // one per sprite, blended with it using blendMode. Memory from CanvasKit.Malloc
+  // can be used for any of them to skip copying them into the WASM heap.
+  CanvasKit.SkCanvas.prototype.drawAtlas = function(atlas, srcRects, dstXforms, paint,
+                                                    blendMode, colors) {
+    if (!atlas || !srcRects || !dstXforms) {
+      SkDebug('Doing nothing since missing a required input');
+      return;
+    }
+    if (srcRects.length !== dstXforms.length ||
+        (colors && colors.length * 4 !== srcRects.length)) {
+      SkDebug('Doing nothing since input arrays length mismatches');
+      return;
+    }
+    blendMode = blendMode || CanvasKit.BlendMode.Modulate;
+
+    var srcRectPtr = copy1dArray(srcRects, CanvasKit.HEAPF32);
+    var xformPtr =   copy1dArray(dstXforms, CanvasKit.HEAPF32);
+    // See MakeSkVertices for why colors go in as signed ints.
+    var colorPtr =   copy1dArray(colors, CanvasKit.HEAP32);
+
+    this._drawAtlas(atlas, xformPtr, srcRectPtr, colorPtr, srcRects.length / 4, blendMode,
+                    paint || null);
+
+    freeArraysThatAreNotMallocedByUsers(srcRectPtr, srcRects);
+    freeArraysThatAreNotMallocedByUsers(xformPtr, dstXforms);
+    freeArraysThatAreNotMallocedByUsers(colorPtr, colors);
+  }
+
+  // Replays the commands in cmds, a CanvasKit.SkDrawCommandBuffer, with one call
+  // into the WASM code. Returns false if a command was malformed; the commands before
+  // it will have been drawn.
+  CanvasKit.SkCanvas.prototype.drawCommands = function(cmds) {
+    return this._drawCommands(cmds._resources, cmds._wordPtr, cmds._numWords,
+                              cmds._bytePtr, cmds._numBytes);
+  }
+
   // returns Uint8Array
   CanvasKit.SkCanvas.prototype.readPixels = function(x, y, w, h, alphaType,
                                                      colorType, dstRowBytes) {
@@ -425,8 +488,8 @@ CanvasKit.onRuntimeInitialized = function() {
     return pixels;
   }
 
-  // pixels is a TypedArray. No matter the input size, it will be treated as
-  // a Uint8Array (essentially, a byte array).
+  // pixels is a TypedArray or memory from CanvasKit.Malloc. No matter the input
+  // size, it will be treated as a Uint8Array (essentially, a byte array).
   CanvasKit.SkCanvas.prototype.writePixels = function(pixels, srcWidth, srcHeight,
                                                       destX, destY, alphaType, colorType) {
     if (pixels.byteLength % (srcWidth * srcHeight)) {
@@ -438,8 +501,10 @@ CanvasKit.onRuntimeInitialized = function() {
     colorType = colorType || CanvasKit.ColorType.RGBA_8888;
     var srcRowBytes = bytesPerPixel * srcWidth;
 
-    var pptr = CanvasKit._malloc(pixels.byteLength);
-    CanvasKit.HEAPU8.set(pixels, pptr);
+    var pptr = pixels['_ck'] ? pixels.byteOffset : CanvasKit._malloc(pixels.byteLength);
+    if (!pixels['_ck']) {
+      CanvasKit.HEAPU8.set(pixels, pptr);
+    }
 
     var ok = this._writePixels({
       'width': srcWidth,
@@ -448,7 +513,7 @@ CanvasKit.onRuntimeInitialized = function() {
       'alphaType': alphaType,
     }, pptr, srcRowBytes, destX, destY);
 
-    CanvasKit._free(pptr);
+    freeArraysThatAreNotMallocedByUsers(pptr, pixels);
     return ok;
   }
 
@@ -517,13 +582,208 @@ CanvasKit.XYWHRect = function(x, y, w, h) {
   };
 }
 
+// cmds is a 2d array of commands, or the commands already flattened into memory
+// from CanvasKit.Malloc(Float32Array, ...), which is read where it is.
 CanvasKit.MakePathFromCmds = function(cmds) {
+  if (cmds['_ck']) {
+    return CanvasKit._MakePathFromCmds(cmds.byteOffset, cmds.length);
+  }
   var ptrLen = loadCmdsTypedArray(cmds);
   var path = CanvasKit._MakePathFromCmds(ptrLen[0], ptrLen[1]);
   CanvasKit._free(ptrLen[0]);
   return path;
 }
 
+// SkDrawCommandBuffer records draws into memory in the WASM heap, so that a frame of
+// many small draws can be replayed onto an SkCanvas with a single call to
+// SkCanvas.drawCommands, rather than paying the cost of crossing into WASM for every one.
+// Paints and fonts are copied in once with addPaint/addFont and referred to by the
+// handles those return. After drawing, reset() empties the buffer for the next frame
+// (the paints and fonts stay). Call delete() when done with it.
+//
+// Each command is an opcode followed by its arguments, written as 32 bit words
+// (see DrawCommands in canvaskit_bindings.cpp). Text goes into a separate byte buffer.
+CanvasKit.SkDrawCommandBuffer = function(initialWords, initialBytes) {
+  this._resources = new CanvasKit._DrawCommandResources();
+  this._wordCapacity = initialWords || 4096;
+  this._byteCapacity = initialBytes || 1024;
+  this._wordPtr = CanvasKit._malloc(this._wordCapacity * 4);
+  this._bytePtr = CanvasKit._malloc(this._byteCapacity);
+  this._numWords = 0;
+  this._numBytes = 0;
+}
+
+// Makes room for n more words and returns the index of the first one in HEAPU32/HEAPF32.
+// This may grow the heap, so callers must look up CanvasKit.HEAPU32 and HEAPF32 after.
+CanvasKit.SkDrawCommandBuffer.prototype._reserve = function(n) {
+  if (this._numWords + n > this._wordCapacity) {
+    this._wordCapacity = Math.max(2 * this._wordCapacity, this._numWords + n);
+    var ptr = CanvasKit._malloc(this._wordCapacity * 4);
+    CanvasKit.HEAPU8.copyWithin(ptr, this._wordPtr, this._wordPtr + this._numWords * 4);
+    CanvasKit._free(this._wordPtr);
+    this._wordPtr = ptr;
+  }
+  var idx = this._wordPtr / 4 + this._numWords;
+  this._numWords += n;
+  return idx;
+}
+
+// Records op and the edges of a rect, reserving extra more words for the caller to
+// fill in starting at the returned index.
+CanvasKit.SkDrawCommandBuffer.prototype._rectOp = function(op, l, t, r, b, extra) {
+  var i = this._reserve(5 + extra);
+  CanvasKit.HEAPU32[i] = op;
+  var f = CanvasKit.HEAPF32;
+  f[i+1] = l;
+  f[i+2] = t;
+  f[i+3] = r;
+  f[i+4] = b;
+  return i + 5;
+}
+
+// Returns a handle to a copy of paint, for use with the draw methods.
+CanvasKit.SkDrawCommandBuffer.prototype.addPaint = function(paint) {
+  return this._resources.addPaint(paint);
+}
+
+// Returns a handle to a copy of font, for use with drawText.
+CanvasKit.SkDrawCommandBuffer.prototype.addFont = function(font) {
+  return this._resources.addFont(font);
+}
+
+// Replaces the paint that handle refers to, for commands replayed after this.
+CanvasKit.SkDrawCommandBuffer.prototype.setPaint = function(handle, paint) {
+  return this._resources.setPaint(handle, paint);
+}
+
+// Records changing a paint's color, for the commands after this one. This is cheaper
+// than keeping a paint per color.
+CanvasKit.SkDrawCommandBuffer.prototype.setPaintColor = function(handle, color) {
+  var i = this._reserve(3);
+  var u = CanvasKit.HEAPU32;
+  u[i]   = CanvasKit._DRAW_CMD_PAINT_COLOR;
+  u[i+1] = handle;
+  u[i+2] = color;
+}
+
+CanvasKit.SkDrawCommandBuffer.prototype.clear = function(color) {
+  var i = this._reserve(2);
+  var u = CanvasKit.HEAPU32;
+  u[i]   = CanvasKit._DRAW_CMD_CLEAR;
+  u[i+1] = color;
+}
+
+CanvasKit.SkDrawCommandBuffer.prototype.save = function() {
+  CanvasKit.HEAPU32[this._reserve(1)] = CanvasKit._DRAW_CMD_SAVE;
+}
+
+CanvasKit.SkDrawCommandBuffer.prototype.restore = function() {
+  CanvasKit.HEAPU32[this._reserve(1)] = CanvasKit._DRAW_CMD_RESTORE;
+}
+
+CanvasKit.SkDrawCommandBuffer.prototype.translate = function(dx, dy) {
+  var i = this._reserve(3);
+  CanvasKit.HEAPU32[i] = CanvasKit._DRAW_CMD_TRANSLATE;
+  CanvasKit.HEAPF32[i+1] = dx;
+  CanvasKit.HEAPF32[i+2] = dy;
+}
+
+CanvasKit.SkDrawCommandBuffer.prototype.scale = function(sx, sy) {
+  var i = this._reserve(3);
+  CanvasKit.HEAPU32[i] = CanvasKit._DRAW_CMD_SCALE;
+  CanvasKit.HEAPF32[i+1] = sx;
+  CanvasKit.HEAPF32[i+2] = sy;
+}
+
+// degrees, like SkCanvas.rotate
+CanvasKit.SkDrawCommandBuffer.prototype.rotate = function(degrees) {
+  var i = this._reserve(2);
+  CanvasKit.HEAPU32[i] = CanvasKit._DRAW_CMD_ROTATE;
+  CanvasKit.HEAPF32[i+1] = degrees;
+}
+
+// op is a CanvasKit.ClipOp
+CanvasKit.SkDrawCommandBuffer.prototype.clipRect = function(l, t, r, b, op, doAntiAlias) {
+  var i = this._rectOp(CanvasKit._DRAW_CMD_CLIP_RECT, l, t, r, b, 2);
+  CanvasKit.HEAPU32[i]   = op.value;
+  CanvasKit.HEAPU32[i+1] = doAntiAlias ? 1 : 0;
+}
+
+// The draw methods take the edges of rects as numbers, rather than SkRect objects,
+// so that recording a command doesn't allocate.
+CanvasKit.SkDrawCommandBuffer.prototype.drawRect = function(l, t, r, b, paint) {
+  var i = this._rectOp(CanvasKit._DRAW_CMD_RECT, l, t, r, b, 1);
+  CanvasKit.HEAPU32[i] = paint;
+}
+
+CanvasKit.SkDrawCommandBuffer.prototype.drawOval = function(l, t, r, b, paint) {
+  var i = this._rectOp(CanvasKit._DRAW_CMD_OVAL, l, t, r, b, 1);
+  CanvasKit.HEAPU32[i] = paint;
+}
+
+CanvasKit.SkDrawCommandBuffer.prototype.drawRoundRect = function(l, t, r, b, rx, ry, paint) {
+  var i = this._rectOp(CanvasKit._DRAW_CMD_ROUND_RECT, l, t, r, b, 3);
+  CanvasKit.HEAPF32[i]   = rx;
+  CanvasKit.HEAPF32[i+1] = ry;
+  CanvasKit.HEAPU32[i+2] = paint;
+}
+
+CanvasKit.SkDrawCommandBuffer.prototype.drawCircle = function(cx, cy, radius, paint) {
+  var i = this._reserve(5);
+  var f = CanvasKit.HEAPF32;
+  CanvasKit.HEAPU32[i] = CanvasKit._DRAW_CMD_CIRCLE;
+  f[i+1] = cx;
+  f[i+2] = cy;
+  f[i+3] = radius;
+  CanvasKit.HEAPU32[i+4] = paint;
+}
+
+CanvasKit.SkDrawCommandBuffer.prototype.drawLine = function(x0, y0, x1, y1, paint) {
+  var i = this._rectOp(CanvasKit._DRAW_CMD_LINE, x0, y0, x1, y1, 1);
+  CanvasKit.HEAPU32[i] = paint;
+}
+
+// str is a text string, drawn like SkCanvas.drawText(str, x, y, paint, font).
+CanvasKit.SkDrawCommandBuffer.prototype.drawText = function(str, x, y, paint, font) {
+  // lengthBytesUTF8 and stringToUTF8 are defined in the emscripten JS.
+  // stringToUTF8 also writes a null terminator, which the command leaves out.
+  var len = lengthBytesUTF8(str);
+  if (this._numBytes + len + 1 > this._byteCapacity) {
+    this._byteCapacity = Math.max(2 * this._byteCapacity, this._numBytes + len + 1);
+    var ptr = CanvasKit._malloc(this._byteCapacity);
+    CanvasKit.HEAPU8.copyWithin(ptr, this._bytePtr, this._bytePtr + this._numBytes);
+    CanvasKit._free(this._bytePtr);
+    this._bytePtr = ptr;
+  }
+  var offset = this._numBytes;
+  stringToUTF8(str, this._bytePtr + offset, len + 1);
+  this._numBytes += len;
+
+  var i = this._reserve(7);
+  var u = CanvasKit.HEAPU32, f = CanvasKit.HEAPF32;
+  u[i]   = CanvasKit._DRAW_CMD_TEXT;
+  u[i+1] = offset;
+  u[i+2] = len;
+  f[i+3] = x;
+  f[i+4] = y;
+  u[i+5] = font;
+  u[i+6] = paint;
+}
+
+// Forgets the recorded commands, keeping the paints and fonts and the memory.
+CanvasKit.SkDrawCommandBuffer.prototype.reset = function() {
+  this._numWords = 0;
+  this._numBytes = 0;
+}
+
+CanvasKit.SkDrawCommandBuffer.prototype.delete = function() {
+  this._resources.delete();
+  CanvasKit._free(this._wordPtr);
+  CanvasKit._free(this._bytePtr);
+  this._wordPtr = nullptr;
+  this._bytePtr = nullptr;
+}
+
 CanvasKit.MakeSkDashPathEffect = function(intervals, phase) {
   if (!phase) {
     phase = 0;
@@ -533,7 +793,7 @@ CanvasKit.MakeSkDashPathEffect = function(intervals, phase) {
   }
   var ptr = copy1dArray(intervals, CanvasKit.HEAPF32);
   var dpe = CanvasKit._MakeSkDashPathEffect(ptr, intervals.length, phase);
-  CanvasKit._free(ptr);
+  freeArraysThatAreNotMallocedByUsers(ptr, intervals);
   return dpe;
 }
 
@@ -568,15 +828,20 @@ CanvasKit.MakeImageShader = function(img, xTileMode, yTileMode, clampUnpremul, l
   }
 }
 
-// pixels is a Uint8Array
+// pixels is a Uint8Array, or memory from CanvasKit.Malloc. The image reads the latter
+// where it is, so it must not be changed or freed until the image is deleted.
 CanvasKit.MakeImage = function(pixels, width, height, alphaType, colorType) {
-  var bytesPerPixel = pixels.byteLength / (width * height);
   var info = {
     'width': width,
     'height': height,
     'alphaType': alphaType,
     'colorType': colorType,
   };
+  if (pixels['_ck']) {
+    return CanvasKit._MakeImageWithoutCopy(info, pixels.byteOffset, pixels.byteLength,
+                                           pixels.byteLength / height);
+  }
+  var bytesPerPixel = pixels.byteLength / (width * height);
   var pptr = CanvasKit._malloc(pixels.byteLength);
   CanvasKit.HEAPU8.set(pixels, pptr);
   // No need to _free iptr, Image takes it with SkData::MakeFromMalloc
@@ -601,8 +866,8 @@ CanvasKit.MakeLinearGradientShader = function(start, end, colors, pos, mode, loc
                                                   colors.length, mode, flags);
   }
 
-  CanvasKit._free(colorPtr);
-  CanvasKit._free(posPtr);
+  freeArraysThatAreNotMallocedByUsers(colorPtr, colors);
+  freeArraysThatAreNotMallocedByUsers(posPtr, pos);
   return lgs;
 }
 
@@ -623,8 +888,8 @@ CanvasKit.MakeRadialGradientShader = function(center, radius, colors, pos, mode,
                                                   colors.length, mode, flags);
   }
 
-  CanvasKit._free(colorPtr);
-  CanvasKit._free(posPtr);
+  freeArraysThatAreNotMallocedByUsers(colorPtr, colors);
+  freeArraysThatAreNotMallocedByUsers(posPtr, pos);
   return rgs;
 }
 
@@ -648,8 +913,8 @@ CanvasKit.MakeTwoPointConicalGradientShader = function(start, startRadius, end,
                         colorPtr, posPtr, colors.length, mode, flags);
   }
 
-  CanvasKit._free(colorPtr);
-  CanvasKit._free(posPtr);
+  freeArraysThatAreNotMallocedByUsers(colorPtr, colors);
+  freeArraysThatAreNotMallocedByUsers(posPtr, pos);
   return rgs;
 }
 
@@ -670,16 +935,18 @@ CanvasKit.MakeSkVertices = function(mode, positions, textureCoordinates, colors,
   isVolatile = isVolatile === undefined ? true : isVolatile;
 
   var idxCount = (indices && indices.length) || 0;
+  // Memory from CanvasKit.Malloc is flat, with 2 floats per position.
+  var vertexCount = positions['_ck'] ? positions.length / 2 : positions.length;
   // _MakeVertices will copy all the values in, so we are free to release
   // the memory after.
-  var vertices = CanvasKit._MakeSkVertices(mode, positions.length, positionPtr,
+  var vertices = CanvasKit._MakeSkVertices(mode, vertexCount, positionPtr,
                                            texPtr, colorPtr, boneIdxPtr, boneWtPtr,
                                            idxCount, idxPtr, isVolatile);
-  positionPtr && CanvasKit._free(positionPtr);
-  texPtr && CanvasKit._free(texPtr);
-  colorPtr && CanvasKit._free(colorPtr);
-  idxPtr && CanvasKit._free(idxPtr);
-  boneIdxPtr && CanvasKit._free(boneIdxPtr);
-  boneWtPtr && CanvasKit._free(boneWtPtr);
+  freeArraysThatAreNotMallocedByUsers(positionPtr, positions);
+  freeArraysThatAreNotMallocedByUsers(texPtr, textureCoordinates);
+  freeArraysThatAreNotMallocedByUsers(colorPtr, colors);
+  freeArraysThatAreNotMallocedByUsers(idxPtr, indices);
+  freeArraysThatAreNotMallocedByUsers(boneIdxPtr, boneIndices);
+  freeArraysThatAreNotMallocedByUsers(boneWtPtr, boneWeights);
   return vertices;
 };
\ No newline at end of file
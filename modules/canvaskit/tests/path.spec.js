@@ -114,6 +114,119 @@ describe('CanvasKit\'s Path Behavior', function() {
         // See canvas2d for more API tests
     });
 
+    it('can replay a buffer of draw commands', function(done) {
+        LoadCanvasKit.then(catchException(done, () => {
+            const surface = CanvasKit.MakeCanvasSurface('test');
+            expect(surface).toBeTruthy('Could not make surface')
+            if (!surface) {
+                done();
+                return;
+            }
+            const canvas = surface.getCanvas();
+            const stroke = new CanvasKit.SkPaint();
+            stroke.setStrokeWidth(2.0);
+            stroke.setAntiAlias(true);
+            stroke.setColor(CanvasKit.Color(0, 0, 0, 1.0));
+            stroke.setStyle(CanvasKit.PaintStyle.Stroke);
+            const fill = new CanvasKit.SkPaint();
+            fill.setAntiAlias(true);
+            const font = new CanvasKit.SkFont(null, 20);
+
+            // Start small, so that recording has to grow the buffers.
+            const cmds = new CanvasKit.SkDrawCommandBuffer(8, 4);
+            const strokeHandle = cmds.addPaint(stroke);
+            const fillHandle = cmds.addPaint(fill);
+            const fontHandle = cmds.addFont(font);
+
+            cmds.clear(CanvasKit.WHITE);
+            cmds.drawLine(3, 10, 30, 15, strokeHandle);
+            cmds.drawRoundRect(5, 35, 45, 80, 15, 10, strokeHandle);
+            cmds.drawOval(55, 35, 95, 80, strokeHandle);
+            cmds.save();
+            cmds.translate(120, 40);
+            cmds.rotate(30);
+            cmds.clipRect(0, 0, 60, 60, CanvasKit.ClipOp.Intersect, true);
+            for (let i = 0; i < 100; i++) {
+                cmds.setPaintColor(fillHandle, CanvasKit.Color(i * 2, 0, 255 - i * 2, 1.0));
+                cmds.drawRect(i % 10 * 6, Math.floor(i / 10) * 6,
+                              i % 10 * 6 + 5, Math.floor(i / 10) * 6 + 5, fillHandle);
+            }
+            cmds.restore();
+            cmds.drawCircle(220, 60, 20, strokeHandle);
+            cmds.drawText('this is ascii text', 5, 100, strokeHandle, fontHandle);
+            cmds.drawText('Unicode chars 💩 é É ص', 5, 130, strokeHandle, fontHandle);
+
+            expect(canvas.drawCommands(cmds)).toBeTruthy();
+
+            // Replaying after a reset draws nothing more.
+            cmds.reset();
+            expect(canvas.drawCommands(cmds)).toBeTruthy();
+
+            surface.flush();
+            cmds.delete();
+            font.delete();
+            fill.delete();
+            stroke.delete();
+
+            reportSurface(surface, 'draw_commands', done);
+        }));
+    });
+
+    it('can draw from memory made with Malloc without copying it', function(done) {
+        LoadCanvasKit.then(catchException(done, () => {
+            const surface = CanvasKit.MakeCanvasSurface('test');
+            expect(surface).toBeTruthy('Could not make surface')
+            if (!surface) {
+                done();
+                return;
+            }
+            const canvas = surface.getCanvas();
+            canvas.clear(CanvasKit.WHITE);
+            const paint = new CanvasKit.SkPaint();
+
+            // A 16x16 checkerboard, written straight into the WASM heap.
+            const pixels = CanvasKit.Malloc(Uint8Array, 16 * 16 * 4);
+            const bytes = pixels.toTypedArray();
+            for (let i = 0; i < 16 * 16; i++) {
+                const on = ((i % 16 >> 2) + (i >> 6)) % 2;
+                bytes.set(on ? [255, 0, 0, 255] : [0, 0, 255, 255], i * 4);
+            }
+            const img = CanvasKit.MakeImage(pixels, 16, 16, CanvasKit.AlphaType.Unpremul,
+                                            CanvasKit.ColorType.RGBA_8888);
+            expect(img).toBeTruthy('Could not make image');
+            canvas.drawImage(img, 10, 10, paint);
+
+            const srcRects = CanvasKit.Malloc(Float32Array, 3 * 4);
+            const dstXforms = CanvasKit.Malloc(Float32Array, 3 * 4);
+            for (let i = 0; i < 3; i++) {
+                srcRects.toTypedArray().set([0, 0, 8 + 4 * i, 8 + 4 * i], i * 4);
+                const a = i * Math.PI / 8;
+                dstXforms.toTypedArray().set([2 * Math.cos(a), 2 * Math.sin(a),
+                                              60 + 60 * i, 10], i * 4);
+            }
+            canvas.drawAtlas(img, srcRects, dstXforms, paint);
+
+            const builder = new CanvasKit.SkVerticesBuilder(
+                    CanvasKit.VertexMode.Triangles, 3, 0, CanvasKit.HAS_COLORS_VERTICES_FLAG);
+            expect(builder.isValid()).toBeTruthy();
+            builder.positions().set([10, 100, 110, 100, 60, 180]);
+            builder.colors().set([CanvasKit.RED, CanvasKit.BLUE, CanvasKit.YELLOW]);
+            const vertices = builder.detach();
+            canvas.drawVertices(vertices, CanvasKit.BlendMode.Src, paint);
+
+            surface.flush();
+            vertices.delete();
+            builder.delete();
+            img.delete();
+            CanvasKit.Free(pixels);
+            CanvasKit.Free(srcRects);
+            CanvasKit.Free(dstXforms);
+            paint.delete();
+
+            reportSurface(surface, 'malloc_inputs', done);
+        }));
+    });
+
     function starPath(CanvasKit, X=128, Y=128, R=116) {
         let p = new CanvasKit.SkPath();
         p.moveTo(X + R, Y);
@@ -15,10 +15,12 @@
 #include "SkTArray.h"
 
 class SkCanvas;
+class SkExecutor;
 class SkFieldVisitor;
 class SkParticleAffector;
 class SkParticleDrawable;
 struct SkParticleState;
+struct SkParticleUpdateParams;
 
 class SkParticleEffectParams : public SkRefCnt {
 public:
@@ -41,7 +43,9 @@ public:
 
 class SkParticleEffect : public SkRefCnt {
 public:
-    SkParticleEffect(sk_sp<SkParticleEffectParams> params, const SkRandom& random);
+    // If an executor is provided, large effects run their update affectors in parallel batches.
+    SkParticleEffect(sk_sp<SkParticleEffectParams> params, const SkRandom& random,
+                     SkExecutor* executor = nullptr);
 
     void start(double now, bool looping = false);
     void update(double now);
@@ -52,10 +56,12 @@ public:
 
 private:
     void setCapacity(int capacity);
+    void updateParticles(const SkParticleUpdateParams& params, int start, int count);
 
     sk_sp<SkParticleEffectParams> fParams;
 
-    SkRandom fRandom;
+    SkRandom    fRandom;
+    SkExecutor* fExecutor;
 
     bool   fLooping;
     double fSpawnTime;
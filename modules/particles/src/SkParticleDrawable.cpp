@@ -27,11 +27,16 @@ static sk_sp<SkImage> make_circle_image(int radius) {
     return surface->makeImageSnapshot();
 }
 
+// Kept by each drawable, so large effects don't reallocate the arrays on every frame.
 struct DrawAtlasArrays {
-    DrawAtlasArrays(const SkParticleState particles[], int count, SkPoint center)
-            : fXforms(count)
-            , fRects(count)
-            , fColors(count) {
+    void update(const SkParticleState particles[], int count, SkPoint center) {
+        if (count > fCapacity) {
+            fXforms.reset(count);
+            fRects.reset(count);
+            fColors.reset(count);
+            fCapacity = count;
+        }
+
         for (int i = 0; i < count; ++i) {
             fXforms[i] = particles[i].fPose.asRSXform(center);
             fColors[i] = particles[i].fColor.toSkColor();
@@ -41,6 +46,7 @@ struct DrawAtlasArrays {
     SkAutoTMalloc<SkRSXform> fXforms;
     SkAutoTMalloc<SkRect>    fRects;
     SkAutoTMalloc<SkColor>   fColors;
+    int                      fCapacity = 0;
 };
 
 class SkCircleDrawable : public SkParticleDrawable {
@@ -55,12 +61,12 @@ public:
     void draw(SkCanvas* canvas, const SkParticleState particles[], int count,
               const SkPaint* paint) override {
         SkPoint center = { SkIntToScalar(fRadius), SkIntToScalar(fRadius) };
-        DrawAtlasArrays arrays(particles, count, center);
+        fArrays.update(particles, count, center);
         for (int i = 0; i < count; ++i) {
-            arrays.fRects[i].set(0.0f, 0.0f, fImage->width(), fImage->height());
+            fArrays.fRects[i].set(0.0f, 0.0f, fImage->width(), fImage->height());
         }
-        canvas->drawAtlas(fImage, arrays.fXforms.get(), arrays.fRects.get(), arrays.fColors.get(),
-                          count, SkBlendMode::kModulate, nullptr, paint);
+        canvas->drawAtlas(fImage, fArrays.fXforms.get(), fArrays.fRects.get(),
+                          fArrays.fColors.get(), count, SkBlendMode::kModulate, nullptr, paint);
     }
 
     void visitFields(SkFieldVisitor* v) override {
@@ -79,7 +85,8 @@ private:
     }
 
     // Cached
-    sk_sp<SkImage> fImage;
+    sk_sp<SkImage>  fImage;
+    DrawAtlasArrays fArrays;
 };
 
 class SkImageDrawable : public SkParticleDrawable {
@@ -97,7 +104,7 @@ public:
               const SkPaint* paint) override {
         SkRect baseRect = getBaseRect();
         SkPoint center = { baseRect.width() * 0.5f, baseRect.height() * 0.5f };
-        DrawAtlasArrays arrays(particles, count, center);
+        fArrays.update(particles, count, center);
 
         int frameCount = fCols * fRows;
         for (int i = 0; i < count; ++i) {
@@ -105,10 +112,11 @@ public:
             frame = SkTPin(frame, 0, frameCount - 1);
             int row = frame / fCols;
             int col = frame % fCols;
-            arrays.fRects[i] = baseRect.makeOffset(col * baseRect.width(), row * baseRect.height());
+            fArrays.fRects[i] = baseRect.makeOffset(col * baseRect.width(),
+                                                    row * baseRect.height());
         }
-        canvas->drawAtlas(fImage, arrays.fXforms.get(), arrays.fRects.get(), arrays.fColors.get(),
-                          count, SkBlendMode::kModulate, nullptr, paint);
+        canvas->drawAtlas(fImage, fArrays.fXforms.get(), fArrays.fRects.get(),
+                          fArrays.fColors.get(), count, SkBlendMode::kModulate, nullptr, paint);
     }
 
     void visitFields(SkFieldVisitor* v) override {
@@ -146,7 +154,8 @@ private:
     }
 
     // Cached
-    sk_sp<SkImage> fImage;
+    sk_sp<SkImage>  fImage;
+    DrawAtlasArrays fArrays;
 };
 
 void SkParticleDrawable::RegisterDrawableTypes() {
@@ -14,6 +14,10 @@
 #include "SkParticleDrawable.h"
 #include "SkReflected.h"
 #include "SkRSXform.h"
+#include "SkTaskGroup.h"
+
+// Minimum number of particles updated by each task, when updating in parallel.
+static constexpr int kParallelBatchSize = 4096;
 
 void SkParticleEffectParams::visitFields(SkFieldVisitor* v) {
     v->visit("MaxCount", fMaxCount);
@@ -27,9 +31,11 @@ void SkParticleEffectParams::visitFields(SkFieldVisitor* v) {
     v->visit("Update", fUpdateAffectors);
 }
 
-SkParticleEffect::SkParticleEffect(sk_sp<SkParticleEffectParams> params, const SkRandom& random)
+SkParticleEffect::SkParticleEffect(sk_sp<SkParticleEffectParams> params, const SkRandom& random,
+                                   SkExecutor* executor)
         : fParams(std::move(params))
         , fRandom(random)
+        , fExecutor(executor)
         , fLooping(false)
         , fSpawnTime(-1.0)
         , fCount(0)
@@ -122,34 +128,54 @@ void SkParticleEffect::update(double now) {
         }
     }
 
-    // Restore all stable random generators so update affectors get consistent behavior each frame
-    for (int i = 0; i < fCount; ++i) {
-        fParticles[i].fRandom = fStableRandoms[i];
-    }
-
     // During update, values that refer to kAge_Source get the *particle* age
     updateParams.fAgeSource = SkParticleValue::kParticleAge_Source;
 
+    // Each particle is updated independently of the others, so batches can run in parallel.
+    const int batchCount = fExecutor ? fCount / kParallelBatchSize : 0;
+    if (batchCount > 1) {
+        const int batchSize = (fCount + batchCount - 1) / batchCount;
+        SkTaskGroup(*fExecutor).batch(batchCount, [&](int batch) {
+            const int start = batch * batchSize;
+            this->updateParticles(updateParams, start, SkTMin(batchSize, fCount - start));
+        });
+    } else {
+        this->updateParticles(updateParams, 0, fCount);
+    }
+
+    // Mark effect as dead if we've reached the end (and are not looping)
+    if (!fLooping && (now - fSpawnTime) > fParams->fEffectDuration) {
+        fSpawnTime = -1.0;
+    }
+}
+
+void SkParticleEffect::updateParticles(const SkParticleUpdateParams& params, int start,
+                                       int count) {
+    SkParticleState* particles = fParticles + start;
+
+    // Restore the stable random generators so update affectors get consistent behavior each frame
+    for (int i = 0; i < count; ++i) {
+        particles[i].fRandom = fStableRandoms[start + i];
+    }
+
     // Apply update rules
     for (auto affector : fParams->fUpdateAffectors) {
         if (affector) {
-            affector->apply(updateParams, fParticles, fCount);
+            affector->apply(params, particles, count);
         }
     }
 
     // Do fixed-function update work (integration of position and orientation)
-    for (int i = 0; i < fCount; ++i) {
-        fParticles[i].fPose.fPosition += fParticles[i].fVelocity.fLinear * deltaTime;
-
-        SkScalar c, s = SkScalarSinCos(fParticles[i].fVelocity.fAngular * deltaTime, &c);
-        SkVector oldHeading = fParticles[i].fPose.fHeading;
-        fParticles[i].fPose.fHeading = { oldHeading.fX * c - oldHeading.fY * s,
-                                         oldHeading.fX * s + oldHeading.fY * c };
-    }
-
-    // Mark effect as dead if we've reached the end (and are not looping)
-    if (!fLooping && (now - fSpawnTime) > fParams->fEffectDuration) {
-        fSpawnTime = -1.0;
+    for (int i = 0; i < count; ++i) {
+        particles[i].fPose.fPosition += particles[i].fVelocity.fLinear * params.fDeltaTime;
+
+        if (particles[i].fVelocity.fAngular != 0) {
+            SkScalar c, s = SkScalarSinCos(particles[i].fVelocity.fAngular * params.fDeltaTime,
+                                           &c);
+            SkVector oldHeading = particles[i].fPose.fHeading;
+            particles[i].fPose.fHeading = { oldHeading.fX * c - oldHeading.fY * s,
+                                            oldHeading.fX * s + oldHeading.fY * c };
+        }
     }
 }
 
@@ -37,6 +37,8 @@ if [[ $@ == *help* ]]; then
   echo "  test = Make a build suitable for running tests or profiling"
   echo "  debug = Make a build suitable for debugging (defines SK_DEBUG)"
   echo "  asm.js = Build for asm.js instead of WASM (very experimental)"
+  echo "  simd = Build with WebAssembly SIMD (-msimd128), which lets SkNx"
+  echo "         use 128-bit vectors. Needs a browser with WASM SIMD enabled."
   echo "  serve = starts a webserver allowing a user to navigate to"
   echo "          localhost:8000/pathkit.html to view the demo page."
   exit 0
@@ -66,6 +68,12 @@ WASM_CONF="-s WASM=1"
 if [[ $@ == *asm.js* ]]; then
   echo "Building with asm.js instead of WASM"
   WASM_CONF="-s WASM=0 -s ALLOW_MEMORY_GROWTH=1"
+elif [[ $@ == *simd* ]]; then
+  echo "Building with WASM SIMD"
+  # Both libpathkit.a and the bindings need the flag, so SkNx picks the same
+  # (vectorized) Sk4f everywhere.
+  EXTRA_CFLAGS="${EXTRA_CFLAGS}, \"-msimd128\""
+  WASM_CONF="-s WASM=1 -msimd128"
 fi
 
 OUTPUT="-o $BUILD_DIR/pathkit.js"
@@ -28,6 +28,12 @@ var PathKit = {
 	_FromCmds: function(ptr, size) {},
 	loadCmdsTypedArray: function(arr) {},
 	FromCmds: function(arr) {},
+	_CmdsToSVGStrings: function(cmdsPtr, lengthsPtr, numPaths) {},
+	_StrokeCmds: function(cmdsPtr, lengthsPtr, numPaths, opts) {},
+	_UnionCmds: function(cmdsPtr, lengthsPtr, numPaths) {},
+	CmdsToSVGStrings: function(cmds, lengths) {},
+	StrokeCmds: function(cmds, lengths, opts) {},
+	UnionCmds: function(cmds, lengths) {},
 	_SkCubicMap: function(cp1, cp2) {},
 	cubicYFromX: function(cpx1, cpy1, cpx2, cpy2, X) {},
 	cubicPtFromT: function(cpx1, cpy1, cpx2, cpy2, T) {},
@@ -37,6 +43,11 @@ var PathKit = {
 	 */
 	HEAPF32: {},
 
+	/**
+	 * @type {Int32Array}
+	 */
+	HEAP32: {},
+
 	SkPath: {
 		_addPath: function(path, scaleX, skewX, transX, skewY, scaleY, transY, pers0, pers1, pers2) {},
 		_arc: function(x, y, radius, startAngle, endAngle, ccw) {},
@@ -69,6 +69,54 @@
     return path;
   }
 
+  // The bulk functions below take many paths at once: cmds is one flat array (or Float32Array)
+  // of all their commands in the encoding FromCmds uses, and lengths holds how many of those
+  // floats belong to each path. Batching like this crosses into WASM (and copies) once for the
+  // whole lot, rather than once per path per call.
+  //
+  // Example usage:
+  // let cmds = new Float32Array([PathKit.MOVE_VERB, 0, 0, PathKit.LINE_VERB, 10, 10,
+  //                              PathKit.MOVE_VERB, 5, 0, PathKit.LINE_VERB, 5, 10]);
+  // let svgs = PathKit.CmdsToSVGStrings(cmds, [6, 6]);
+  function callWithBulkCmds(cmds, lengths, fn) {
+    var cmdsPtr = PathKit._malloc(cmds.length * 4);
+    var lengthsPtr = PathKit._malloc(lengths.length * 4);
+    // Both the mallocs can grow memory, so only look up the heap views after them.
+    PathKit.HEAPF32.set(cmds, cmdsPtr / 4);
+    PathKit.HEAP32.set(lengths, lengthsPtr / 4);
+    var result = fn(cmdsPtr, lengthsPtr, lengths.length);
+    PathKit._free(cmdsPtr);
+    PathKit._free(lengthsPtr);
+    return result;
+  }
+
+  // Returns the union of all the paths as an SkPath, or null if that fails.
+  PathKit.UnionCmds = function(cmds, lengths) {
+    return callWithBulkCmds(cmds, lengths, PathKit._UnionCmds);
+  }
+
+  // Strokes every path with the same opts (see SkPath.stroke), returning
+  // {cmds: Float32Array, lengths: Int32Array} in the same form as the input, or null.
+  PathKit.StrokeCmds = function(cmds, lengths, opts) {
+    /**
+     * See externs.js for this definition
+     * @type {StrokeOpts}
+     */
+    opts = opts || {};
+    opts.width = opts.width || 1;
+    opts.miter_limit = opts.miter_limit || 4;
+    opts.cap = opts.cap || PathKit.StrokeCap.BUTT;
+    opts.join = opts.join || PathKit.StrokeJoin.MITER;
+    return callWithBulkCmds(cmds, lengths, function(cmdsPtr, lengthsPtr, numPaths) {
+      return PathKit._StrokeCmds(cmdsPtr, lengthsPtr, numPaths, opts);
+    });
+  }
+
+  // Returns an array with the SVG string (see SkPath.toSVGString) of each path, or null.
+  PathKit.CmdsToSVGStrings = function(cmds, lengths) {
+    return callWithBulkCmds(cmds, lengths, PathKit._CmdsToSVGStrings);
+  }
+
   /**
    * A common pattern is to call this function in sequence with the same
    * params. We can just remember the last one to speed things up.
@@ -18,11 +18,14 @@
 #include "SkRect.h"
 #include "SkString.h"
 #include "SkStrokeRec.h"
+#include "SkTo.h"
 #include "SkTrimPathEffect.h"
 
 #include <emscripten/emscripten.h>
 #include <emscripten/bind.h>
 
+#include <vector>
+
 using namespace emscripten;
 
 static const int MOVE = 0;
@@ -92,26 +95,15 @@ JSArray EMSCRIPTEN_KEEPALIVE ToCmds(const SkPath& path) {
     return cmds;
 }
 
-// This type signature is a mess, but it's necessary. See, we can't use "bind" (EMSCRIPTEN_BINDINGS)
-// and pointers to primitive types (Only bound types like SkPoint). We could if we used
-// cwrap (see https://becominghuman.ai/passing-and-returning-webassembly-array-parameters-a0f572c65d97)
-// but that requires us to stick to C code and, AFAIK, doesn't allow us to return nice things like
-// SkPath or SkOpBuilder.
-//
-// So, basically, if we are using C++ and EMSCRIPTEN_BINDINGS, we can't have primative pointers
-// in our function type signatures. (this gives an error message like "Cannot call foo due to unbound
-// types Pi, Pf").  But, we can just pretend they are numbers and cast them to be pointers and
-// the compiler is happy.
-SkPathOrNull EMSCRIPTEN_KEEPALIVE FromCmds(uintptr_t /* float* */ cptr, int numCmds) {
-    const auto* cmds = reinterpret_cast<const float*>(cptr);
-    SkPath path;
+// Appends the commands in cmds to path, returning false if they are malformed.
+static bool AppendCmds(const float* cmds, int numCmds, SkPath* path) {
     float x1, y1, x2, y2, x3, y3;
 
     // if there are not enough arguments, bail with the path we've constructed so far.
     #define CHECK_NUM_ARGS(n) \
         if ((i + n) > numCmds) { \
             SkDebugf("Not enough args to match the verbs. Saw %d commands\n", numCmds); \
-            return emscripten::val::null(); \
+            return false; \
         }
 
     for(int i = 0; i < numCmds;){
@@ -119,47 +111,98 @@ SkPathOrNull EMSCRIPTEN_KEEPALIVE FromCmds(uintptr_t /* float* */ cptr, int numC
             case MOVE:
                 CHECK_NUM_ARGS(2);
                 x1 = cmds[i++], y1 = cmds[i++];
-                path.moveTo(x1, y1);
+                path->moveTo(x1, y1);
                 break;
             case LINE:
                 CHECK_NUM_ARGS(2);
                 x1 = cmds[i++], y1 = cmds[i++];
-                path.lineTo(x1, y1);
+                path->lineTo(x1, y1);
                 break;
             case QUAD:
                 CHECK_NUM_ARGS(4);
                 x1 = cmds[i++], y1 = cmds[i++];
                 x2 = cmds[i++], y2 = cmds[i++];
-                path.quadTo(x1, y1, x2, y2);
+                path->quadTo(x1, y1, x2, y2);
                 break;
             case CONIC:
                 CHECK_NUM_ARGS(5);
                 x1 = cmds[i++], y1 = cmds[i++];
                 x2 = cmds[i++], y2 = cmds[i++];
                 x3 = cmds[i++]; // weight
-                path.conicTo(x1, y1, x2, y2, x3);
+                path->conicTo(x1, y1, x2, y2, x3);
                 break;
             case CUBIC:
                 CHECK_NUM_ARGS(6);
                 x1 = cmds[i++], y1 = cmds[i++];
                 x2 = cmds[i++], y2 = cmds[i++];
                 x3 = cmds[i++], y3 = cmds[i++];
-                path.cubicTo(x1, y1, x2, y2, x3, y3);
+                path->cubicTo(x1, y1, x2, y2, x3, y3);
                 break;
             case CLOSE:
-                path.close();
+                path->close();
                 break;
             default:
                 SkDebugf("  path: UNKNOWN command %f, aborting dump...\n", cmds[i-1]);
-                return emscripten::val::null();
+                return false;
         }
     }
 
     #undef CHECK_NUM_ARGS
 
+    return true;
+}
+
+// This type signature is a mess, but it's necessary. See, we can't use "bind" (EMSCRIPTEN_BINDINGS)
+// and pointers to primitive types (Only bound types like SkPoint). We could if we used
+// cwrap (see https://becominghuman.ai/passing-and-returning-webassembly-array-parameters-a0f572c65d97)
+// but that requires us to stick to C code and, AFAIK, doesn't allow us to return nice things like
+// SkPath or SkOpBuilder.
+//
+// So, basically, if we are using C++ and EMSCRIPTEN_BINDINGS, we can't have primative pointers
+// in our function type signatures. (this gives an error message like "Cannot call foo due to unbound
+// types Pi, Pf").  But, we can just pretend they are numbers and cast them to be pointers and
+// the compiler is happy.
+SkPathOrNull EMSCRIPTEN_KEEPALIVE FromCmds(uintptr_t /* float* */ cptr, int numCmds) {
+    const auto* cmds = reinterpret_cast<const float*>(cptr);
+    SkPath path;
+    if (!AppendCmds(cmds, numCmds, &path)) {
+        return emscripten::val::null();
+    }
     return emscripten::val(path);
 }
 
+// The flat, typed array form of ToCmds: appends path's commands to cmds.
+static void AppendToCmds(const SkPath& path, std::vector<float>* cmds) {
+    VisitPath(path, [cmds](SkPath::Verb verb, const SkPoint pts[4], SkPath::RawIter iter) {
+        switch (verb) {
+        case SkPath::kMove_Verb:
+            cmds->insert(cmds->end(), { MOVE, pts[0].x(), pts[0].y() });
+            break;
+        case SkPath::kLine_Verb:
+            cmds->insert(cmds->end(), { LINE, pts[1].x(), pts[1].y() });
+            break;
+        case SkPath::kQuad_Verb:
+            cmds->insert(cmds->end(), { QUAD, pts[1].x(), pts[1].y(), pts[2].x(), pts[2].y() });
+            break;
+        case SkPath::kConic_Verb:
+            cmds->insert(cmds->end(), { CONIC, pts[1].x(), pts[1].y(),
+                                               pts[2].x(), pts[2].y(), iter.conicWeight() });
+            break;
+        case SkPath::kCubic_Verb:
+            cmds->insert(cmds->end(), { CUBIC, pts[1].x(), pts[1].y(),
+                                               pts[2].x(), pts[2].y(),
+                                               pts[3].x(), pts[3].y() });
+            break;
+        case SkPath::kClose_Verb:
+            cmds->push_back(CLOSE);
+            break;
+        case SkPath::kDone_Verb:
+            SkASSERT(false);
+            break;
+        }
+    });
+}
+
 SkPath EMSCRIPTEN_KEEPALIVE NewPath() {
     return SkPath();
 }
@@ -267,6 +310,55 @@ SkPathOrNull EMSCRIPTEN_KEEPALIVE ResolveBuilder(SkOpBuilder& builder) {
     return emscripten::val::null();
 }
 
+//========================================================================================
+// Bulk things
+//========================================================================================
+
+// These take many paths at once as one flat array of commands (the same encoding FromCmds
+// reads), plus the number of floats each path uses, so that a batch costs one crossing into
+// WASM rather than one per path per call. Results that are paths come back the same way.
+
+// Calls f(path) with each of the paths in cmds, stopping early (and returning false) on the
+// first one that is malformed.
+template <typename PathFunc>
+static bool VisitCmds(const float* cmds, const int32_t* lengths, int numPaths, PathFunc&& f) {
+    for (int i = 0; i < numPaths; ++i) {
+        SkPath path;
+        if (lengths[i] < 0 || !AppendCmds(cmds, lengths[i], &path)) {
+            return false;
+        }
+        f(path);
+        cmds += lengths[i];
+    }
+    return true;
+}
+
+SkPathOrNull EMSCRIPTEN_KEEPALIVE UnionCmds(uintptr_t /* float* */ cptr,
+                                            uintptr_t /* int32_t* */ lptr, int numPaths) {
+    SkOpBuilder builder;
+    // See comment above for uintptr_t explanation
+    if (!VisitCmds(reinterpret_cast<const float*>(cptr), reinterpret_cast<const int32_t*>(lptr),
+                   numPaths, [&builder](const SkPath& path) {
+        builder.add(path, kUnion_SkPathOp);
+    })) {
+        return emscripten::val::null();
+    }
+    return ResolveBuilder(builder);
+}
+
+JSArray EMSCRIPTEN_KEEPALIVE CmdsToSVGStrings(uintptr_t /* float* */ cptr,
+                                              uintptr_t /* int32_t* */ lptr, int numPaths) {
+    JSArray strings = emscripten::val::array();
+    // See comment above for uintptr_t explanation
+    if (!VisitCmds(reinterpret_cast<const float*>(cptr), reinterpret_cast<const int32_t*>(lptr),
+                   numPaths, [&strings](const SkPath& path) {
+        strings.call<void>("push", ToSVGString(path));
+    })) {
+        return emscripten::val::null();
+    }
+    return strings;
+}
+
 //========================================================================================
 // Canvas things
 //========================================================================================
@@ -421,6 +513,34 @@ bool ApplyStroke(SkPath& path, StrokeOpts opts) {
     return p.getFillPath(path, &path);
 }
 
+// Strokes each path with the same opts. Returns {cmds: Float32Array, lengths: Int32Array} or
+// null if the input is malformed or a path can't be stroked.
+emscripten::val EMSCRIPTEN_KEEPALIVE StrokeCmds(uintptr_t /* float* */ cptr,
+                                                uintptr_t /* int32_t* */ lptr, int numPaths,
+                                                StrokeOpts opts) {
+    std::vector<float> outCmds;
+    std::vector<int32_t> outLengths;
+    outLengths.reserve(numPaths);
+    bool stroked = true;
+    // See comment above for uintptr_t explanation
+    if (!VisitCmds(reinterpret_cast<const float*>(cptr), reinterpret_cast<const int32_t*>(lptr),
+                   numPaths, [&](SkPath& path) {
+        stroked &= ApplyStroke(path, opts);
+        size_t before = outCmds.size();
+        AppendToCmds(path, &outCmds);
+        outLengths.push_back(SkToS32(outCmds.size() - before));
+    }) || !stroked) {
+        return emscripten::val::null();
+    }
+    // The memory views alias our vectors, so slice() copies them out before they go away.
+    emscripten::val result = emscripten::val::object();
+    result.set("cmds", emscripten::val(typed_memory_view(outCmds.size(), outCmds.data()))
+                               .call<emscripten::val>("slice"));
+    result.set("lengths", emscripten::val(typed_memory_view(outLengths.size(), outLengths.data()))
+                                  .call<emscripten::val>("slice"));
+    return result;
+}
+
 //========================================================================================
 // Matrix things
 //========================================================================================
@@ -557,6 +677,11 @@ EMSCRIPTEN_BINDINGS(skia) {
     // PathOps
     function("MakeFromOp", &MakeFromOp);
 
+    // Bulk; see helper.js for the client-facing implementations.
+    function("_CmdsToSVGStrings", &CmdsToSVGStrings);
+    function("_StrokeCmds", &StrokeCmds);
+    function("_UnionCmds", &UnionCmds);
+
     enum_<SkPathOp>("PathOp")
         .value("DIFFERENCE",         SkPathOp::kDifference_SkPathOp)
         .value("INTERSECT",          SkPathOp::kIntersect_SkPathOp)
@@ -28,6 +28,20 @@ describe('PathKit\'s Effects', function() {
         return p;
     }
 
+    // Flattens count paths into the form the bulk functions take.
+    function bulkCmds(count) {
+        let cmds = [];
+        let lengths = [];
+        for (let i = 0; i < count; i++) {
+            let path = drawStar(X=100 + 4*i, Y=100 + 3*i);
+            let flat = [].concat(...path.toCmds());
+            path.delete();
+            cmds.push(...flat);
+            lengths.push(flat.length);
+        }
+        return {cmds: new Float32Array(cmds), lengths: new Int32Array(lengths)};
+    }
+
     it('effects_dash', function(done) {
         function setup(ctx) {
             ctx.path = drawStar();
@@ -140,4 +154,60 @@ describe('PathKit\'s Effects', function() {
         });
     });
 
-});
\ No newline at end of file
+    it('effects_stroke_16_paths', function(done) {
+        function setup(ctx) {
+            ctx.paths = [];
+            for (let i = 0; i < 16; i++) {
+                ctx.paths.push(drawStar(X=100 + 4*i, Y=100 + 3*i));
+            }
+        }
+
+        function test(ctx) {
+            for (let p of ctx.paths) {
+                let path = p.copy().stroke({
+                        width: 15,
+                        join: PathKit.StrokeJoin.BEVEL,
+                        cap: PathKit.StrokeCap.BUTT,
+                        miter_limit: 2,
+                    });
+                path.delete();
+            }
+        }
+
+        function teardown(ctx) {
+            ctx.paths.forEach((p) => p.delete());
+        }
+
+        LoadPathKit.then(() => {
+            benchmarkAndReport('effects_stroke_16_paths', setup, test, teardown).then(() => {
+                done();
+            }).catch(reportError(done));
+        });
+    });
+
+    it('effects_stroke_16_paths_bulk', function(done) {
+        function setup(ctx) {
+            ctx.bulk = bulkCmds(16);
+        }
+
+        function test(ctx) {
+            PathKit.StrokeCmds(ctx.bulk.cmds, ctx.bulk.lengths, {
+                width: 15,
+                join: PathKit.StrokeJoin.BEVEL,
+                cap: PathKit.StrokeCap.BUTT,
+                miter_limit: 2,
+            });
+        }
+
+        function teardown(ctx) {
+            ctx.bulk = null;
+        }
+
+        LoadPathKit.then(() => {
+            benchmarkAndReport('effects_stroke_16_paths_bulk', setup, test, teardown).then(() => {
+                done();
+            }).catch(reportError(done));
+        });
+    });
+
+});
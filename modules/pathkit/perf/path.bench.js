@@ -221,6 +221,33 @@ describe('PathKit\'s Path Behavior', function() {
                 }).catch(reportError(done));
             });
         });
+
+        it('path_toSVGString_16_paths_bulk', function(done) {
+            function setup(ctx) {
+                let path = drawPath();
+                let flat = [].concat(...path.toCmds());
+                path.delete();
+                let cmds = [];
+                ctx.lengths = new Int32Array(16);
+                for (let i = 0; i < 16; i++) {
+                    cmds.push(...flat);
+                    ctx.lengths[i] = flat.length;
+                }
+                ctx.cmds = new Float32Array(cmds);
+            }
+
+            function test(ctx) {
+                PathKit.CmdsToSVGStrings(ctx.cmds, ctx.lengths);
+            }
+
+            function teardown(ctx) {}
+
+            LoadPathKit.then(() => {
+                benchmarkAndReport('path_toSVGString_16_paths_bulk', setup, test, teardown).then(() => {
+                    done();
+                }).catch(reportError(done));
+            });
+        });
     });
 
     describe('matrix options', function() {
@@ -28,6 +28,20 @@ describe('PathKit\'s Pathops', function() {
         return p;
     }
 
+    // Flattens count paths into the form the bulk functions take.
+    function bulkCmds(count) {
+        let cmds = [];
+        let lengths = [];
+        for (let i = 0; i < count; i++) {
+            let path = drawStar(X=100 + 4*i, Y=100 + 3*i);
+            let flat = [].concat(...path.toCmds());
+            path.delete();
+            cmds.push(...flat);
+            lengths.push(flat.length);
+        }
+        return {cmds: new Float32Array(cmds), lengths: new Int32Array(lengths)};
+    }
+
     it('pathops_simplify', function(done) {
         function setup(ctx) {
             ctx.path = drawStar();
@@ -169,4 +183,54 @@ describe('PathKit\'s Pathops', function() {
         });
     });
 
-});
\ No newline at end of file
+    it('pathops_union_16_paths', function(done) {
+        function setup(ctx) {
+            ctx.paths = [];
+            for (let i = 0; i < 16; i++) {
+                ctx.paths.push(drawStar(X=100 + 4*i, Y=100 + 3*i));
+            }
+        }
+
+        function test(ctx) {
+            let builder = new PathKit.SkOpBuilder();
+            for (let path of ctx.paths) {
+                builder.add(path, PathKit.PathOp.UNION);
+            }
+            let path = builder.resolve();
+            path.delete();
+            builder.delete();
+        }
+
+        function teardown(ctx) {
+            ctx.paths.forEach((p) => p.delete());
+        }
+
+        LoadPathKit.then(() => {
+            benchmarkAndReport('pathops_union_16_paths', setup, test, teardown).then(() => {
+                done();
+            }).catch(reportError(done));
+        });
+    });
+
+    it('pathops_union_16_paths_bulk', function(done) {
+        function setup(ctx) {
+            ctx.bulk = bulkCmds(16);
+        }
+
+        function test(ctx) {
+            let path = PathKit.UnionCmds(ctx.bulk.cmds, ctx.bulk.lengths);
+            path.delete();
+        }
+
+        function teardown(ctx) {
+            ctx.bulk = null;
+        }
+
+        LoadPathKit.then(() => {
+            benchmarkAndReport('pathops_union_16_paths_bulk', setup, test, teardown).then(() => {
+                done();
+            }).catch(reportError(done));
+        });
+    });
+
+});
@@ -181,6 +181,57 @@ describe('PathKit\'s Path Behavior', function() {
                 done();
             }));
         });
+
+        it('operates on many paths at once with the bulk functions', function(done) {
+            LoadPathKit.then(catchException(done, () => {
+                let cmds = new Float32Array([
+                    PathKit.MOVE_VERB, 0, 0, PathKit.LINE_VERB, 10, 0,
+                    PathKit.LINE_VERB, 10, 10, PathKit.CLOSE_VERB,
+                    PathKit.MOVE_VERB, 5, 0, PathKit.LINE_VERB, 20, 0,
+                    PathKit.LINE_VERB, 20, 10, PathKit.CLOSE_VERB,
+                ]);
+                let lengths = [10, 10];
+                function makePath(i) {
+                    let x = i ? 5 : 0, w = i ? 15 : 10;
+                    return PathKit.NewPath().moveTo(x, 0).lineTo(x + w, 0).lineTo(x + w, 10)
+                                            .closePath();
+                }
+
+                let svgs = PathKit.CmdsToSVGStrings(cmds, lengths);
+                expect(svgs).toEqual(['M0 0L10 0L10 10Z', 'M5 0L20 0L20 10Z']);
+
+                let expected = makePath(0);
+                let other = makePath(1);
+                expected.op(other, PathKit.PathOp.UNION);
+                let union = PathKit.UnionCmds(cmds, lengths);
+                expect(union.equals(expected)).toBe(true);
+                expected.delete();
+                other.delete();
+                union.delete();
+
+                // Each stroked path matches stroking it on its own.
+                let stroked = PathKit.StrokeCmds(cmds, lengths, {width: 2});
+                expect(stroked.lengths.length).toEqual(2);
+                let offset = 0;
+                for (let i = 0; i < 2; i++) {
+                    let path = makePath(i).stroke({width: 2});
+                    let len = stroked.lengths[i];
+                    let [ptr] = PathKit.loadCmdsTypedArray(
+                            [Array.from(stroked.cmds.subarray(offset, offset + len))]);
+                    let fromBulk = PathKit._FromCmds(ptr, len);
+                    PathKit._free(ptr);
+                    expect(fromBulk.equals(path)).toBe(true);
+                    offset += len;
+                    fromBulk.delete();
+                    path.delete();
+                }
+                expect(offset).toEqual(stroked.cmds.length);
+
+                // Malformed input is rejected rather than partially processed.
+                expect(PathKit.UnionCmds(cmds, [10, 11])).toBeNull();
+                done();
+            }));
+        });
     });
 
 });
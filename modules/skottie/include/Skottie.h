@@ -24,7 +24,7 @@ class SkStream;
 
 namespace skjson { class ObjectValue; }
 
-namespace sksg { class Scene;  }
+namespace sksg { class InvalidationController; class Scene; }
 
 namespace skottie {
 
@@ -163,6 +163,16 @@ public:
          */
         Builder& setMarkerObserver(sk_sp<MarkerObserver>);
 
+        /**
+         * Cache the content of static (non-animated) layers as raster images, using up to
+         * |bytes| of memory across all cached layers.  Images are allocated by the destination
+         * canvas (i.e. they are GPU-backed when rendering to a GPU surface), and are only used
+         * while the layer's transform and render state stay the same.
+         *
+         * Defaults to 0 (no caching).
+         */
+        Builder& setLayerCacheBudget(size_t bytes);
+
         /**
          * Animation factories.
          */
@@ -176,6 +186,7 @@ public:
         sk_sp<PropertyObserver> fPropertyObserver;
         sk_sp<Logger>           fLogger;
         sk_sp<MarkerObserver>   fMarkerObserver;
+        size_t                  fLayerCacheBudget = 0;
         Stats                   fStats;
     };
 
@@ -212,9 +223,12 @@ public:
      * Updates the animation state for |t|.
      *
      * @param t   normalized [0..1] frame selector (0 -> first frame, 1 -> final frame)
+     * @param ic  optional invalidation controller: when present, the scene is also revalidated
+     *            and the frame's damage is reported to |ic| (an empty ic->bounds() means the
+     *            frame is unchanged and doesn't need to be redrawn)
      *
      */
-    void seek(SkScalar t);
+    void seek(SkScalar t, sksg::InvalidationController* ic = nullptr);
 
     /**
      * Returns the animation duration in seconds.
@@ -264,7 +264,7 @@ sk_sp<sksg::Color> AnimationBuilder::attachColor(const skjson::ObjectValue& jcol
 
 AnimationBuilder::AnimationBuilder(sk_sp<ResourceProvider> rp, sk_sp<SkFontMgr> fontmgr,
                                    sk_sp<PropertyObserver> pobserver, sk_sp<Logger> logger,
-                                   sk_sp<MarkerObserver> mobserver,
+                                   sk_sp<MarkerObserver> mobserver, size_t layerCacheBudget,
                                    Animation::Builder::Stats* stats,
                                    float duration, float framerate)
     : fResourceProvider(std::move(rp))
@@ -272,6 +272,8 @@ AnimationBuilder::AnimationBuilder(sk_sp<ResourceProvider> rp, sk_sp<SkFontMgr>
     , fPropertyObserver(std::move(pobserver))
     , fLogger(std::move(logger))
     , fMarkerObserver(std::move(mobserver))
+    , fLayerCacheBudget(layerCacheBudget ? sk_make_sp<LayerCacheBudget>(layerCacheBudget)
+                                         : nullptr)
     , fStats(stats)
     , fDuration(duration)
     , fFrameRate(framerate)
@@ -426,6 +428,11 @@ Animation::Builder& Animation::Builder::setMarkerObserver(sk_sp<MarkerObserver>
     return *this;
 }
 
+Animation::Builder& Animation::Builder::setLayerCacheBudget(size_t bytes) {
+    fLayerCacheBudget = bytes;
+    return *this;
+}
+
 sk_sp<Animation> Animation::Builder::make(SkStream* stream) {
     if (!stream->hasLength()) {
         // TODO: handle explicit buffering?
@@ -435,6 +442,13 @@ sk_sp<Animation> Animation::Builder::make(SkStream* stream) {
         return nullptr;
     }
 
+    // Memory-backed streams (including mmap'd SkStream::MakeFromFile() streams) are parsed in
+    // place, without copying a potentially large document.
+    if (const auto* base = static_cast<const char*>(stream->getMemoryBase())) {
+        const auto position = stream->getPosition();
+        return this->make(base + position, stream->getLength() - position);
+    }
+
     auto data = SkData::MakeFromStream(stream, stream->getLength());
     if (!data) {
         if (fLogger) {
@@ -499,6 +513,7 @@ sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
                                        std::move(fPropertyObserver),
                                        std::move(fLogger),
                                        std::move(fMarkerObserver),
+                                       fLayerCacheBudget,
                                        &fStats, duration, fps);
     auto scene = builder.parse(json);
 
@@ -582,13 +597,17 @@ void Animation::render(SkCanvas* canvas, const SkRect* dstR, RenderFlags renderF
     fScene->render(canvas);
 }
 
-void Animation::seek(SkScalar t) {
+void Animation::seek(SkScalar t, sksg::InvalidationController* ic) {
     TRACE_EVENT0("skottie", TRACE_FUNC);
 
     if (!fScene)
         return;
 
     fScene->animate(fInPoint + SkTPin(t, 0.0f, 1.0f) * (fOutPoint - fInPoint));
+
+    if (ic) {
+        fScene->revalidate(ic);
+    }
 }
 
 sk_sp<Animation> Animation::Make(const char* data, size_t length) {
@@ -0,0 +1,56 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkCommandLineFlags.h"
+#include "SkData.h"
+#include "SkGraphics.h"
+#include "SkJSON.h"
+#include "Skottie.h"
+#include "SkStream.h"
+
+// Compiles a Lottie .json animation into the binary skjson image Skottie loads without parsing.
+// The output is a drop-in replacement for the input: any Skottie entry point accepts either.
+
+DEFINE_string2(input , i, nullptr, "Input .json file.");
+DEFINE_string2(output, o, nullptr, "Output binary animation file.");
+
+int main(int argc, char** argv) {
+    SkCommandLineFlags::Parse(argc, argv);
+    SkAutoGraphics ag;
+
+    if (FLAGS_input.isEmpty() || FLAGS_output.isEmpty()) {
+        SkDebugf("Missing required 'input' and 'output' args.\n");
+        return 1;
+    }
+
+    auto data = SkData::MakeFromFileName(FLAGS_input[0]);
+    if (!data) {
+        SkDebugf("Could not read '%s'.\n", FLAGS_input[0]);
+        return 1;
+    }
+
+    const auto* json = static_cast<const char*>(data->data());
+    if (!skottie::Animation::Make(json, data->size())) {
+        SkDebugf("Could not load animation: '%s'.\n", FLAGS_input[0]);
+        return 1;
+    }
+
+    const skjson::DOM dom(json, data->size());
+    SkFILEWStream stream(FLAGS_output[0]);
+    if (!stream.isValid()) {
+        SkDebugf("Could not open '%s' for writing.\n", FLAGS_output[0]);
+        return 1;
+    }
+    if (!dom.writeBinary(&stream)) {
+        SkDebugf("Could not write '%s'.\n", FLAGS_output[0]);
+        return 1;
+    }
+
+    SkDebugf("Wrote %lu bytes (from %lu bytes of JSON).\n",
+             stream.bytesWritten(), data->size());
+    return 0;
+}
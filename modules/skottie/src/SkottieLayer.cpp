@@ -7,6 +7,7 @@
 
 #include "SkottiePriv.h"
 
+#include "SkCanvas.h"
 #include "SkData.h"
 #include "SkFontMgr.h"
 #include "SkImage.h"
@@ -18,6 +19,7 @@
 #include "SkSGClipEffect.h"
 #include "SkSGColor.h"
 #include "SkSGDraw.h"
+#include "SkSGEffectNode.h"
 #include "SkSGGroup.h"
 #include "SkSGImage.h"
 #include "SkSGMaskEffect.h"
@@ -26,6 +28,7 @@
 #include "SkSGPath.h"
 #include "SkSGRect.h"
 #include "SkSGTransform.h"
+#include "SkSurface.h"
 
 #include <algorithm>
 #include <vector>
@@ -171,6 +174,112 @@ sk_sp<sksg::RenderNode> AttachMask(const skjson::ArrayValue* jmask,
     return sksg::MaskEffect::Make(std::move(childNode), std::move(maskNode));
 }
 
+// Draws static layer content from a raster snapshot, rendered at the device resolution.
+//
+// The snapshot is only valid for the transform and render context it was rendered with, so it
+// is taken once these have been stable for two consecutive frames (to avoid re-rendering layers
+// with animated transforms on every frame).
+class LayerCache final : public sksg::EffectNode {
+public:
+    LayerCache(sk_sp<sksg::RenderNode> child, sk_sp<LayerCacheBudget> budget)
+        : INHERITED(std::move(child))
+        , fBudget(std::move(budget)) {}
+
+    ~LayerCache() override { this->purge(); }
+
+protected:
+    void onRender(SkCanvas* canvas, const RenderContext* ctx) const override {
+        const RenderContext default_ctx;
+        if (!ctx) {
+            ctx = &default_ctx;
+        }
+
+        // Compositing a snapshot is only equivalent to direct rendering for src-over.
+        if (ctx->fBlendMode != SkBlendMode::kSrcOver) {
+            this->INHERITED::onRender(canvas, ctx);
+            return;
+        }
+
+        const auto& ctm = canvas->getTotalMatrix();
+        const auto stable = fRendered &&
+                            ctm == fMatrix &&
+                            ctx->fColorFilter == fContext.fColorFilter &&
+                            ctx->fOpacity     == fContext.fOpacity;
+        if (!stable) {
+            this->purge();
+            fMatrix  = ctm;
+            fContext = *ctx;
+        }
+        fRendered = true;
+
+        if (!fImage && !(stable && this->snapshot(canvas, ctx))) {
+            this->INHERITED::onRender(canvas, ctx);
+            return;
+        }
+
+        SkAutoCanvasRestore acr(canvas, true);
+        canvas->resetMatrix();
+        canvas->drawImage(fImage, fOrigin.x(), fOrigin.y());
+    }
+
+    SkRect onRevalidate(sksg::InvalidationController* ic, const SkMatrix& ctm) override {
+        // The content was mutated externally (e.g. via a property handle).
+        this->purge();
+
+        return this->INHERITED::onRevalidate(ic, ctm);
+    }
+
+private:
+    bool snapshot(SkCanvas* canvas, const RenderContext* ctx) const {
+        const auto dev_bounds = fMatrix.mapRect(this->bounds()).roundOut();
+        if (dev_bounds.isEmpty()) {
+            return false;
+        }
+
+        const auto info  = canvas->imageInfo().makeWH(dev_bounds.width(), dev_bounds.height());
+        const auto bytes = info.computeMinByteSize();
+        if (SkImageInfo::ByteSizeOverflowed(bytes) || !fBudget->acquire(bytes)) {
+            return false;
+        }
+
+        auto surface = canvas->makeSurface(info);
+        if (!surface) {
+            fBudget->release(bytes);
+            return false;
+        }
+
+        auto* surface_canvas = surface->getCanvas();
+        surface_canvas->clear(SK_ColorTRANSPARENT);
+        surface_canvas->translate(-dev_bounds.x(), -dev_bounds.y());
+        surface_canvas->concat(fMatrix);
+        this->INHERITED::onRender(surface_canvas, ctx);
+
+        fImage  = surface->makeImageSnapshot();
+        fOrigin = dev_bounds.topLeft();
+        fBytes  = bytes;
+
+        return true;
+    }
+
+    void purge() const {
+        if (fImage) {
+            fBudget->release(fBytes);
+            fImage = nullptr;
+        }
+    }
+
+    const sk_sp<LayerCacheBudget> fBudget;
+
+    mutable sk_sp<SkImage> fImage;
+    mutable SkIPoint       fOrigin = { 0, 0 };
+    mutable size_t         fBytes  = 0;
+    mutable SkMatrix       fMatrix = SkMatrix::I();
+    mutable RenderContext  fContext;
+    mutable bool           fRendered = false;
+
+    using INHERITED = sksg::EffectNode;
+};
+
 } // namespace
 
 sk_sp<sksg::RenderNode> AnimationBuilder::attachNestedAnimation(const char* name,
@@ -510,6 +619,11 @@ sk_sp<sksg::RenderNode> AnimationBuilder::attachLayer(const skjson::ObjectValue*
     // Optional layer mask.
     layer = AttachMask((*jlayer)["masksProperties"], this, &layer_animators, std::move(layer));
 
+    // Static layer content (transforms and opacity are applied outside the cache).
+    if (layer && fLayerCacheBudget && layer_animators.empty()) {
+        layer = sk_make_sp<LayerCache>(std::move(layer), fLayerCacheBudget);
+    }
+
     // Optional layer transform.
     if (auto layer_transform = layerCtx->attachLayerTransform(*jlayer, this)) {
         layer = sksg::TransformEffect::Make(std::move(layer), std::move(layer_transform));
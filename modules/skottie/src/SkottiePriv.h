@@ -41,10 +41,29 @@ namespace internal {
 
 using AnimatorScope = sksg::AnimatorList;
 
+// Memory shared by the raster caches of an animation's static layers.
+class LayerCacheBudget final : public SkRefCnt {
+public:
+    explicit LayerCacheBudget(size_t bytes) : fAvailable(bytes) {}
+
+    bool acquire(size_t bytes) {
+        if (bytes > fAvailable) {
+            return false;
+        }
+        fAvailable -= bytes;
+        return true;
+    }
+
+    void release(size_t bytes) { fAvailable += bytes; }
+
+private:
+    size_t fAvailable;
+};
+
 class AnimationBuilder final : public SkNoncopyable {
 public:
     AnimationBuilder(sk_sp<ResourceProvider>, sk_sp<SkFontMgr>, sk_sp<PropertyObserver>,
-                     sk_sp<Logger>, sk_sp<MarkerObserver>,
+                     sk_sp<Logger>, sk_sp<MarkerObserver>, size_t layerCacheBudget,
                      Animation::Builder::Stats*, float duration, float framerate);
 
     std::unique_ptr<sksg::Scene> parse(const skjson::ObjectValue&);
@@ -173,6 +192,7 @@ private:
     sk_sp<PropertyObserver>    fPropertyObserver;
     sk_sp<Logger>              fLogger;
     sk_sp<MarkerObserver>      fMarkerObserver;
+    sk_sp<LayerCacheBudget>    fLayerCacheBudget;
     Animation::Builder::Stats* fStats;
     const float                fDuration,
                                fFrameRate;
@@ -5,10 +5,14 @@
  * found in the LICENSE file.
  */
 
+#include "SkBitmap.h"
+#include "SkCanvas.h"
 #include "SkMatrix.h"
+#include "SkSGInvalidationController.h"
 #include "Skottie.h"
 #include "SkottieProperty.h"
 #include "SkStream.h"
+#include "SkSurface.h"
 
 #include "Test.h"
 
@@ -217,3 +221,114 @@ DEF_TEST(Skottie_Annotations, reporter) {
     REPORTER_ASSERT(reporter, std::get<1>(observer->fMarkers[1]) == 0.75f);
     REPORTER_ASSERT(reporter, std::get<2>(observer->fMarkers[1]) == 0.75f);
 }
+
+DEF_TEST(Skottie_Damage, reporter) {
+    static constexpr char json[] = R"({
+                                     "v": "5.2.1",
+                                     "w": 100,
+                                     "h": 100,
+                                     "fr": 1,
+                                     "ip": 0,
+                                     "op": 10,
+                                     "layers": [
+                                       {
+                                         "ty": 4,
+                                         "ind": 0,
+                                         "ip": 0,
+                                         "op": 10,
+                                         "shapes": [
+                                           {
+                                             "ty": "rc",
+                                             "p": { "a": 0, "k": [ 50, 50 ] },
+                                             "s": { "a": 0, "k": [ 20, 20 ] }
+                                           },
+                                           {
+                                             "ty": "fl",
+                                             "c": { "a": 1, "k": [
+                                               { "t": 0, "s": [ 1, 0, 0 ], "e": [ 0, 0, 1 ] },
+                                               { "t": 10 }
+                                             ]}
+                                           }
+                                         ]
+                                       }
+                                     ]
+                                   })";
+
+    SkMemoryStream stream(json, strlen(json));
+    auto animation = Animation::Make(&stream);
+    REPORTER_ASSERT(reporter, animation);
+
+    {
+        sksg::InvalidationController ic;
+        animation->seek(0, &ic);
+        REPORTER_ASSERT(reporter, !ic.bounds().isEmpty());
+    }
+
+    {
+        // Nothing changes when seeking to the same frame.
+        sksg::InvalidationController ic;
+        animation->seek(0, &ic);
+        REPORTER_ASSERT(reporter, ic.bounds().isEmpty());
+    }
+
+    {
+        // Only the animated fill's geometry is damaged.
+        sksg::InvalidationController ic;
+        animation->seek(0.5f, &ic);
+        REPORTER_ASSERT(reporter, ic.bounds() == SkRect::MakeLTRB(40, 40, 60, 60));
+    }
+}
+
+DEF_TEST(Skottie_LayerCache, reporter) {
+    static constexpr char json[] = R"({
+                                     "v": "5.2.1",
+                                     "w": 100,
+                                     "h": 100,
+                                     "fr": 1,
+                                     "ip": 0,
+                                     "op": 10,
+                                     "layers": [
+                                       {
+                                         "ty": 4,
+                                         "ind": 0,
+                                         "ip": 0,
+                                         "op": 10,
+                                         "shapes": [
+                                           {
+                                             "ty": "el",
+                                             "p": { "a": 0, "k": [ 50, 50 ] },
+                                             "s": { "a": 0, "k": [ 60, 40 ] }
+                                           },
+                                           {
+                                             "ty": "fl",
+                                             "c": { "a": 0, "k": [ 1, 0, 0 ] }
+                                           }
+                                         ]
+                                       }
+                                     ]
+                                   })";
+
+    const auto render = [](Animation* animation, SkSurface* surface) {
+        surface->getCanvas()->clear(SK_ColorTRANSPARENT);
+        animation->render(surface->getCanvas());
+
+        SkBitmap bm;
+        bm.allocPixels(surface->getCanvas()->imageInfo());
+        surface->readPixels(bm.pixmap(), 0, 0);
+        return bm;
+    };
+
+    auto reference = Animation::Make(json, strlen(json));
+    auto cached    = Animation::Builder().setLayerCacheBudget(1 << 20).make(json, strlen(json));
+    REPORTER_ASSERT(reporter, reference && cached);
+
+    auto surface = SkSurface::MakeRasterN32Premul(100, 100);
+    const auto expected = render(reference.get(), surface.get());
+
+    // The first frames render directly and take the snapshot, the last one draws from it.
+    for (int i = 0; i < 3; ++i) {
+        const auto actual = render(cached.get(), surface.get());
+        REPORTER_ASSERT(reporter, !memcmp(expected.getPixels(), actual.getPixels(),
+                                          expected.computeByteSize()));
+    }
+}
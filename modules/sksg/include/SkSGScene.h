@@ -19,6 +19,7 @@ struct SkPoint;
 
 namespace sksg {
 
+class InvalidationController;
 class RenderNode;
 
 /**
@@ -68,6 +69,7 @@ public:
 
     void render(SkCanvas*) const;
     void animate(float t);
+    void revalidate(InvalidationController*);
     const RenderNode* nodeAt(const SkPoint&) const;
 
     void setShowInval(bool show) { fShowInval = show; }
@@ -10,8 +10,10 @@
 #include "SkFontArguments.h"
 #include "SkFontMetrics.h"
 #include "SkFontMgr.h"
+#include "SkLRUCache.h"
 #include "SkMakeUnique.h"
 #include "SkMalloc.h"
+#include "SkMutex.h"
 #include "SkPoint.h"
 #include "SkRefCnt.h"
 #include "SkScalar.h"
@@ -268,7 +270,7 @@ hb_blob_t* skhb_get_table(hb_face_t* face, hb_tag_t tag, void* user_data) {
                           HB_MEMORY_MODE_WRITABLE, buffer, sk_free);
 }
 
-HBFont create_hb_font(const SkFont& font) {
+HBFace create_hb_face(const SkFont& font) {
     int index;
     std::unique_ptr<SkStreamAsset> typefaceAsset = font.getTypeface()->openStream(&index);
     HBFace face;
@@ -287,6 +289,40 @@ HBFont create_hb_font(const SkFont& font) {
     }
     hb_face_set_index(face.get(), (unsigned)index);
     hb_face_set_upem(face.get(), font.getTypeface()->getUnitsPerEm());
+    hb_face_make_immutable(face.get());
+
+    return face;
+}
+
+// Creating a face means opening (and possibly copying) the font data, and HarfBuzz caches table
+// data and shaping plans per face. Immutable faces are safe to share between threads, so they
+// are cached across shape calls, keyed by typeface. Typeface IDs are never reused, so a changed
+// typeface always gets a new face.
+HBFace ref_hb_face(const SkFont& font) {
+    static constexpr int kMaxCachedFaces = 32;
+    SK_DECLARE_STATIC_MUTEX(gFaceCacheMutex);
+    static auto* gFaceCache = new SkLRUCache<SkFontID, HBFace>(kMaxCachedFaces);
+
+    const SkFontID typefaceID = font.getTypeface()->uniqueID();
+
+    SkAutoMutexAcquire lock(gFaceCacheMutex);
+    HBFace* face = gFaceCache->find(typefaceID);
+    if (!face) {
+        HBFace newFace = create_hb_face(font);
+        if (!newFace) {
+            return nullptr;
+        }
+        face = gFaceCache->insert(typefaceID, std::move(newFace));
+    }
+
+    return HBFace(hb_face_reference(face->get()));
+}
+
+HBFont create_hb_font(const SkFont& font) {
+    HBFace face = ref_hb_face(font);
+    if (!face) {
+        return nullptr;
+    }
 
     HBFont otFont(hb_font_create(face.get()));
     SkASSERT(otFont);
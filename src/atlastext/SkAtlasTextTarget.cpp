@@ -245,8 +245,12 @@ void GrAtlasTextOp::executeForTextTarget(SkAtlasTextTarget* target) {
             }
             done = result.fFinished;
 
-            context.recordDraw(result.fFirstVertex, result.fGlyphsRegenerated,
-                               fGeoData[i].fViewMatrix, target->handle());
+            // The glyphs are transformed when the draw is recorded, so any translation the
+            // regenerator left for us goes into that matrix.
+            SkMatrix glyphMatrix = fGeoData[i].fViewMatrix;
+            glyphMatrix.preTranslate(result.fTranslate.fX, result.fTranslate.fY);
+            context.recordDraw(result.fFirstVertex, result.fGlyphsRegenerated, glyphMatrix,
+                               target->handle());
             if (!result.fFinished) {
                 // Make space in the atlas so we can continue generating vertices.
                 context.flush();
@@ -410,3 +410,49 @@ SkCodec::Result SkAndroidCodec::getAndroidPixels(const SkImageInfo& info, void*
         size_t rowBytes) {
     return this->getAndroidPixels(info, pixels, rowBytes, nullptr);
 }
+
+#if defined(SK_BUILD_FOR_ANDROID) && __ANDROID_API__ >= 26
+static bool buffer_format_stores(uint32_t bufferFormat, const SkImageInfo& info) {
+    switch (bufferFormat) {
+        case AHARDWAREBUFFER_FORMAT_R8G8B8A8_UNORM:
+            return kRGBA_8888_SkColorType == info.colorType();
+        case AHARDWAREBUFFER_FORMAT_R8G8B8X8_UNORM:
+            // The X channel is undefined when sampled, so only opaque decodes can go there.
+            return kRGBA_8888_SkColorType == info.colorType() && info.isOpaque();
+        case AHARDWAREBUFFER_FORMAT_R16G16B16A16_FLOAT:
+            return kRGBA_F16_SkColorType == info.colorType();
+        case AHARDWAREBUFFER_FORMAT_R5G6B5_UNORM:
+            return kRGB_565_SkColorType == info.colorType();
+        default:
+            return false;
+    }
+}
+
+SkCodec::Result SkAndroidCodec::getAndroidPixels(const SkImageInfo& info,
+        AHardwareBuffer* hardwareBuffer, const AndroidOptions* options) {
+    if (!hardwareBuffer) {
+        return SkCodec::kInvalidParameters;
+    }
+
+    AHardwareBuffer_Desc bufferDesc;
+    AHardwareBuffer_describe(hardwareBuffer, &bufferDesc);
+    const uint64_t cpuWriteUsage = bufferDesc.usage & AHARDWAREBUFFER_USAGE_CPU_WRITE_MASK;
+    if (!cpuWriteUsage || bufferDesc.layers != 1 ||
+        SkToInt(bufferDesc.width) != info.width() || SkToInt(bufferDesc.height) != info.height()) {
+        return SkCodec::kInvalidParameters;
+    }
+    if (!buffer_format_stores(bufferDesc.format, info)) {
+        return SkCodec::kInvalidConversion;
+    }
+
+    void* pixels;
+    if (AHardwareBuffer_lock(hardwareBuffer, cpuWriteUsage, -1, nullptr, &pixels)) {
+        return SkCodec::kInternalError;
+    }
+    // The buffer's stride is in pixels, not bytes.
+    size_t rowBytes = bufferDesc.stride * info.bytesPerPixel();
+    SkCodec::Result result = this->getAndroidPixels(info, pixels, rowBytes, options);
+    AHardwareBuffer_unlock(hardwareBuffer, nullptr);
+    return result;
+}
+#endif
@@ -322,6 +322,10 @@ SkCodec::Result SkCodec::getPixels(const SkImageInfo& dstInfo, void* pixels, siz
         return kInvalidParameters;
     }
 
+    // Decoding all at once, we have nothing better to do than wait for the data.
+    if (fStream) {
+        fStream->setWaitForData(true);
+    }
     if (!this->rewindIfNeeded()) {
         return kCouldNotRewind;
     }
@@ -382,6 +386,7 @@ SkCodec::Result SkCodec::getPixels(const SkImageInfo& dstInfo, void* pixels, siz
 
 SkCodec::Result SkCodec::startIncrementalDecode(const SkImageInfo& dstInfo, void* pixels,
         size_t rowBytes, const SkCodec::Options* options) {
+    const bool hadIncrementalDecode = fStartedIncrementalDecode;
     fStartedIncrementalDecode = false;
 
     SkImageInfo info = dstInfo;
@@ -395,15 +400,6 @@ SkCodec::Result SkCodec::startIncrementalDecode(const SkImageInfo& dstInfo, void
         return kInvalidParameters;
     }
 
-    // FIXME: If the rows come after the rows of a previous incremental decode,
-    // we might be able to skip the rewind, but only the implementation knows
-    // that. (e.g. PNG will always need to rewind, since we called longjmp, but
-    // a bottom-up BMP could skip rewinding if the new rows are above the old
-    // rows.)
-    if (!this->rewindIfNeeded()) {
-        return kCouldNotRewind;
-    }
-
     // Set options.
     Options optsStorage;
     if (nullptr == options) {
@@ -423,6 +419,14 @@ SkCodec::Result SkCodec::startIncrementalDecode(const SkImageInfo& dstInfo, void
         }
     }
 
+    // If the rows come after the rows of the previous incremental decode, the codec may
+    // be able to skip the rewind, but only the implementation knows that.
+    const bool resume = hadIncrementalDecode
+                        && this->onCanResumeIncrementalDecode(info, *options);
+    if (!resume && !this->rewindIfNeeded()) {
+        return kCouldNotRewind;
+    }
+
     const Result frameIndexResult = this->handleFrameIndex(info, pixels, rowBytes,
                                                            *options);
     if (frameIndexResult != kSuccess) {
@@ -436,6 +440,11 @@ SkCodec::Result SkCodec::startIncrementalDecode(const SkImageInfo& dstInfo, void
     fDstInfo = info;
     fOptions = *options;
 
+    // An incremental decode that runs out of data returns kIncompleteInput, to be called again
+    // once more has arrived, so it shouldn't wait for it.
+    if (fStream) {
+        fStream->setWaitForData(false);
+    }
     const Result result = this->onStartIncrementalDecode(info, pixels, rowBytes, fOptions);
     if (kSuccess == result) {
         fStartedIncrementalDecode = true;
@@ -463,6 +472,10 @@ SkCodec::Result SkCodec::startScanlineDecode(const SkImageInfo& dstInfo,
         info = info.makeColorSpace(SkColorSpace::MakeSRGB());
     }
 
+    // Scanline decoders have no way to report running out of data part way.
+    if (fStream) {
+        fStream->setWaitForData(true);
+    }
     if (!this->rewindIfNeeded()) {
         return kCouldNotRewind;
     }
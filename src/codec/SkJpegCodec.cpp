@@ -13,10 +13,14 @@
 #include "SkJpegDecoderMgr.h"
 #include "SkJpegInfo.h"
 #include "SkStream.h"
+#include "SkTaskGroup.h"
 #include "SkTemplates.h"
 #include "SkTo.h"
 #include "SkTypes.h"
 
+#include <atomic>
+#include <vector>
+
 // stdio is needed for libjpeg-turbo
 #include <stdio.h>
 #include "SkJpegUtility.h"
@@ -36,14 +40,6 @@ bool SkJpegCodec::IsJpeg(const void* buffer, size_t bytesRead) {
     return bytesRead >= 3 && !memcmp(buffer, jpegSig, sizeof(jpegSig));
 }
 
-static uint32_t get_endian_int(const uint8_t* data, bool littleEndian) {
-    if (littleEndian) {
-        return (data[3] << 24) | (data[2] << 16) | (data[1] << 8) | (data[0]);
-    }
-
-    return (data[0] << 24) | (data[1] << 16) | (data[2] << 8) | (data[3]);
-}
-
 const uint32_t kExifHeaderSize = 14;
 const uint32_t kExifMarker = JPEG_APP0 + 1;
 
@@ -569,6 +565,297 @@ static inline bool needs_swizzler_to_convert_from_cmyk(J_COLOR_SPACE jpegColorTy
     return !hasCMYKColorSpace || !hasColorSpaceXform;
 }
 
+/*
+ * Every restart marker resets the entropy decoder, so the coded data between two markers that
+ * fall on MCU row boundaries can be placed behind a copy of the headers (with the image height
+ * patched) and decoded on its own, as a band of the image.
+ *
+ * Upsampling chroma looks at the neighboring rows, so when needsContext is set, each band also
+ * decodes the MCU rows from the previous and up to the next row boundary that starts an interval.  The caller throws the extra rows away, and
+ * the rows it keeps match a decode of the whole image exactly.
+ */
+namespace {
+struct JpegBand {
+    sk_sp<SkData> fData;
+    int           fFirstMCURow;  // first MCU row this band outputs
+    int           fMCURowCount;  // MCU rows this band outputs
+    int           fSkipMCURows;  // MCU rows decoded ahead of fFirstMCURow, only for context
+};
+}  // namespace
+
+static constexpr int kMaxJpegBands = 16;
+
+static uint16_t read_be16(const uint8_t* data) {
+    return (data[0] << 8) | data[1];
+}
+
+static bool slice_at_restarts(const uint8_t* data, size_t length, bool needsContext,
+                              std::vector<JpegBand>* bands, int* mcuHeightOut) {
+    if (length < 4 || data[0] != 0xFF || data[1] != 0xD8) {
+        return false;
+    }
+
+    // Copy the headers we need to decode a band, and find the frame's geometry.
+    std::vector<uint8_t> header(data, data + 2);
+    size_t heightOffset = 0;  // where the frame height lives in header, or 0 before the SOF
+    int width = 0, height = 0, numComponents = 0, maxH = 1, maxV = 1;
+    bool unitSampling = true;
+    int restartInterval = 0;
+    size_t pos = 2;
+    for (;;) {
+        // Markers may be preceded by any number of fill bytes.
+        if (pos >= length || data[pos] != 0xFF) {
+            return false;
+        }
+        while (pos < length && data[pos] == 0xFF) {
+            pos++;
+        }
+        if (pos + 3 > length) {
+            return false;
+        }
+        const uint8_t marker = data[pos];
+        if (marker == 0xD9 || (marker >= 0xD0 && marker <= 0xD7) || marker == 0x01) {
+            return false;
+        }
+        const size_t segmentLength = read_be16(data + pos + 1);
+        const size_t segmentEnd = pos + 1 + segmentLength;
+        if (segmentLength < 2 || segmentEnd > length) {
+            return false;
+        }
+        const uint8_t* payload = data + pos + 3;
+        const size_t payloadLength = segmentLength - 2;
+
+        bool copySegment = true;
+        if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 &&
+                marker != 0xCC) {
+            // Only sequential Huffman frames, with a single scan, can be split.
+            if ((marker != 0xC0 && marker != 0xC1) || heightOffset || payloadLength < 6) {
+                return false;
+            }
+            height = read_be16(payload + 1);
+            width = read_be16(payload + 3);
+            numComponents = payload[5];
+            if (payload[0] != 8 || 0 == height || 0 == width || numComponents < 1 ||
+                    numComponents > 4 || payloadLength < 6 + 3 * (size_t) numComponents) {
+                return false;
+            }
+            for (int i = 0; i < numComponents; i++) {
+                const int h = payload[7 + 3 * i] >> 4,
+                          v = payload[7 + 3 * i] & 0xF;
+                if (h < 1 || h > 4 || v < 1 || v > 4) {
+                    return false;
+                }
+                maxH = SkTMax(maxH, h);
+                maxV = SkTMax(maxV, v);
+                unitSampling &= (1 == h && 1 == v);
+            }
+            heightOffset = header.size() + 5;  // 0xFF, marker, length, precision
+        } else if (0xDD == marker) {
+            if (payloadLength < 2) {
+                return false;
+            }
+            restartInterval = read_be16(payload);
+        } else if (0xE1 == marker || 0xE2 == marker || 0xFE == marker) {
+            // EXIF, ICC and comments were already read from the original.
+            copySegment = false;
+        }
+
+        if (copySegment) {
+            header.push_back(0xFF);
+            header.insert(header.end(), data + pos, data + segmentEnd);
+        }
+        pos = segmentEnd;
+
+        if (0xDA == marker) {
+            if (!heightOffset || payloadLength < 1 || payload[0] != numComponents) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    // A non-interleaved scan has one block per MCU; only handle the common case for it.
+    if (0 == restartInterval || (1 == numComponents && !unitSampling)) {
+        return false;
+    }
+    const int mcuWidth  = 1 == numComponents ? DCTSIZE : DCTSIZE * maxH,
+              mcuHeight = 1 == numComponents ? DCTSIZE : DCTSIZE * maxV;
+    const int mcusPerRow = (width + mcuWidth - 1) / mcuWidth,
+              mcuRows = (height + mcuHeight - 1) / mcuHeight;
+    const size_t intervals = ((size_t) mcusPerRow * mcuRows + restartInterval - 1) /
+                             restartInterval;
+
+    // Restart intervals start on an MCU row boundary every stride rows.
+    int a = restartInterval, b = mcusPerRow;
+    while (b) {
+        int t = a % b;
+        a = b;
+        b = t;
+    }
+    const int stride = restartInterval / a;
+    if (2 * stride > mcuRows) {
+        return false;
+    }
+
+    // Find the restart markers, skipping stuffed zeros and fill bytes.
+    const size_t entropyStart = pos;
+    size_t entropyEnd = 0;
+    std::vector<size_t> restarts;
+    for (size_t i = entropyStart; i + 1 < length;) {
+        if (data[i] != 0xFF) {
+            i++;
+            continue;
+        }
+        size_t j = i + 1;
+        while (j < length && data[j] == 0xFF) {
+            j++;
+        }
+        if (j >= length) {
+            break;
+        }
+        if (0x00 == data[j]) {
+            i = j + 1;
+        } else if (data[j] >= 0xD0 && data[j] <= 0xD7) {
+            restarts.push_back(j - 1);
+            i = j + 1;
+        } else {
+            if (0xD9 == data[j]) {
+                entropyEnd = i;
+            }
+            break;
+        }
+    }
+    if (!entropyEnd || restarts.size() + 1 != intervals) {
+        return false;
+    }
+
+    int rowsPerBand = (mcuRows + kMaxJpegBands - 1) / kMaxJpegBands;
+    rowsPerBand = (rowsPerBand + stride - 1) / stride * stride;
+    for (int top = 0; top < mcuRows; top += rowsPerBand) {
+        const int bottom = SkTMin(top + rowsPerBand, mcuRows);
+        const int decodeTop = (needsContext && top > 0) ? top - stride : top;
+        const int decodeBottom = (needsContext && bottom < mcuRows)
+                ? SkTMin((bottom + stride) / stride * stride, mcuRows)
+                : bottom;
+
+        const size_t firstInterval = (size_t) decodeTop * mcusPerRow / restartInterval;
+        const size_t lastInterval = decodeBottom == mcuRows
+                ? intervals
+                : (size_t) decodeBottom * mcusPerRow / restartInterval;
+        const size_t begin = firstInterval ? restarts[firstInterval - 1] + 2 : entropyStart;
+        const size_t end = lastInterval < intervals ? restarts[lastInterval - 1] : entropyEnd;
+        const int bandHeight = decodeBottom == mcuRows ? height - decodeTop * mcuHeight
+                                                       : (decodeBottom - decodeTop) * mcuHeight;
+
+        sk_sp<SkData> band = SkData::MakeUninitialized(header.size() + (end - begin) + 2);
+        uint8_t* dst = (uint8_t*) band->writable_data();
+        memcpy(dst, header.data(), header.size());
+        dst[heightOffset + 0] = bandHeight >> 8;
+        dst[heightOffset + 1] = bandHeight & 0xFF;
+        memcpy(dst + header.size(), data + begin, end - begin);
+
+        // The decoder expects the band's restart markers to count up from RST0.
+        for (size_t i = firstInterval; i + 1 < lastInterval; i++) {
+            dst[header.size() + restarts[i] - begin + 1] = 0xD0 + ((i - firstInterval) & 7);
+        }
+        dst[band->size() - 2] = 0xFF;
+        dst[band->size() - 1] = 0xD9;
+
+        bands->push_back({std::move(band), top, bottom - top, top - decodeTop});
+    }
+
+    *mcuHeightOut = mcuHeight;
+    return bands->size() > 1;
+}
+
+bool SkJpegCodec::decodeBand(const sk_sp<SkData>& band, int skipRows, int rows,
+                             const SkImageInfo& dstInfo, void* dst, size_t rowBytes) const {
+    jpeg_decompress_struct* srcInfo = fDecoderMgr->dinfo();
+    SkMemoryStream stream(band);
+    JpegDecoderMgr decoderMgr(&stream);
+    SkAutoTMalloc<uint8_t> storage;
+
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(decoderMgr.errorMgr());
+    if (setjmp(jmp)) {
+        return false;
+    }
+
+    decoderMgr.init();
+    jpeg_decompress_struct* dinfo = decoderMgr.dinfo();
+    if (JPEG_HEADER_OK != jpeg_read_header(dinfo, true)) {
+        return false;
+    }
+    dinfo->out_color_space = srcInfo->out_color_space;
+    dinfo->dither_mode = srcInfo->dither_mode;
+    dinfo->scale_num = srcInfo->scale_num;
+    dinfo->scale_denom = srcInfo->scale_denom;
+    if (!jpeg_start_decompress(dinfo)) {
+        return false;
+    }
+    if (dinfo->output_width != (JDIMENSION) dstInfo.width() ||
+            dinfo->output_height < (JDIMENSION) (skipRows + rows)) {
+        return false;
+    }
+
+    // Context rows, and rows on their way through a color xform, are decoded into storage.
+    const bool xformInPlace = sizeof(uint32_t) == dstInfo.bytesPerPixel();
+    storage.reset(get_row_bytes(dinfo));
+    JSAMPLE* scratch = storage.get();
+    for (int y = 0; y < skipRows; y++) {
+        if (1 != jpeg_read_scanlines(dinfo, &scratch, 1)) {
+            return false;
+        }
+    }
+    for (int y = 0; y < rows; y++) {
+        JSAMPLE* row = (this->colorXform() && !xformInPlace) ? scratch : (JSAMPLE*) dst;
+        if (1 != jpeg_read_scanlines(dinfo, &row, 1)) {
+            return false;
+        }
+        if (this->colorXform()) {
+            this->applyColorXform(dst, row, dstInfo.width());
+        }
+        dst = SkTAddOffset<void>(dst, rowBytes);
+    }
+    return true;
+}
+
+bool SkJpegCodec::decodeInBands(const SkImageInfo& dstInfo, void* dst, size_t rowBytes,
+                                SkExecutor* executor) {
+    const jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+    const void* data = this->stream()->getMemoryBase();
+    if (!data || !this->stream()->hasLength()) {
+        return false;
+    }
+
+    std::vector<JpegBand> bands;
+    int mcuHeight;
+    if (!slice_at_restarts((const uint8_t*) data, this->stream()->getLength(), true, &bands,
+                           &mcuHeight)) {
+        return false;
+    }
+
+    // Output rows per MCU row, after libjpeg-turbo's scaling.
+    if (0 != (mcuHeight * dinfo->scale_num) % dinfo->scale_denom) {
+        return false;
+    }
+    const int scaledMCUHeight = mcuHeight * dinfo->scale_num / dinfo->scale_denom;
+
+    std::atomic<bool> success{true};
+    SkTaskGroup taskGroup(*executor);
+    taskGroup.batch(SkToInt(bands.size()), [&](int i) {
+        const JpegBand& band = bands[i];
+        const int top = band.fFirstMCURow * scaledMCUHeight;
+        const int rows = (size_t) i + 1 == bands.size() ? dstInfo.height() - top
+                                                        : band.fMCURowCount * scaledMCUHeight;
+        if (!this->decodeBand(band.fData, band.fSkipMCURows * scaledMCUHeight, rows, dstInfo,
+                              SkTAddOffset<void>(dst, top * rowBytes), rowBytes)) {
+            success = false;
+        }
+    });
+    taskGroup.wait();
+    return success;
+}
+
 /*
  * Performs the jpeg decode
  */
@@ -590,6 +877,14 @@ SkCodec::Result SkJpegCodec::onGetPixels(const SkImageInfo& dstInfo,
         return fDecoderMgr->returnFailure("setjmp", kInvalidInput);
     }
 
+    if (options.fExecutor &&
+            !needs_swizzler_to_convert_from_cmyk(dinfo->out_color_space,
+                                                 this->getEncodedInfo().profile(),
+                                                 this->colorXform()) &&
+            this->decodeInBands(dstInfo, dst, dstRowBytes, options.fExecutor)) {
+        return kSuccess;
+    }
+
     if (!jpeg_start_decompress(dinfo)) {
         return fDecoderMgr->returnFailure("startDecompress", kInvalidInput);
     }
@@ -863,47 +1158,12 @@ bool SkJpegCodec::onQueryYUV8(SkYUVASizeInfo* sizeInfo, SkYUVColorSpace* colorSp
     return true;
 }
 
-SkCodec::Result SkJpegCodec::onGetYUV8Planes(const SkYUVASizeInfo& sizeInfo,
-                                             void* planes[SkYUVASizeInfo::kMaxCount]) {
-    SkYUVASizeInfo defaultInfo;
-
-    // This will check is_yuv_supported(), so we don't need to here.
-    bool supportsYUV = this->onQueryYUV8(&defaultInfo, nullptr);
-    if (!supportsYUV ||
-            sizeInfo.fSizes[0] != defaultInfo.fSizes[0] ||
-            sizeInfo.fSizes[1] != defaultInfo.fSizes[1] ||
-            sizeInfo.fSizes[2] != defaultInfo.fSizes[2] ||
-            sizeInfo.fWidthBytes[0] < defaultInfo.fWidthBytes[0] ||
-            sizeInfo.fWidthBytes[1] < defaultInfo.fWidthBytes[1] ||
-            sizeInfo.fWidthBytes[2] < defaultInfo.fWidthBytes[2]) {
-        return fDecoderMgr->returnFailure("onGetYUV8Planes", kInvalidInput);
-    }
-
-    // Set the jump location for libjpeg errors
-    skjpeg_error_mgr::AutoPushJmpBuf jmp(fDecoderMgr->errorMgr());
-    if (setjmp(jmp)) {
-        return fDecoderMgr->returnFailure("setjmp", kInvalidInput);
-    }
-
-    // Get a pointer to the decompress info since we will use it quite frequently
-    jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
-
-    dinfo->raw_data_out = TRUE;
-    if (!jpeg_start_decompress(dinfo)) {
-        return fDecoderMgr->returnFailure("startDecompress", kInvalidInput);
-    }
-
-    // A previous implementation claims that the return value of is_yuv_supported()
-    // may change after calling jpeg_start_decompress().  It looks to me like this
-    // was caused by a bug in the old code, but we'll be safe and check here.
-    SkASSERT(is_yuv_supported(dinfo));
-
-    // Currently, we require that the Y plane dimensions match the image dimensions
-    // and that the U and V planes are the same dimensions.
-    SkASSERT(sizeInfo.fSizes[1] == sizeInfo.fSizes[2]);
-    SkASSERT((uint32_t) sizeInfo.fSizes[0].width() == dinfo->output_width &&
-             (uint32_t) sizeInfo.fSizes[0].height() == dinfo->output_height);
-
+/*
+ * Reads all of dinfo's output, which must be in raw data mode, into the Y, U, and V planes.
+ */
+static SkCodec::Result read_yuv8_planes(jpeg_decompress_struct* dinfo,
+                                        const SkYUVASizeInfo& sizeInfo,
+                                        void* planes[SkYUVASizeInfo::kMaxCount]) {
     // Build a JSAMPIMAGE to handle output from libjpeg-turbo.  A JSAMPIMAGE has
     // a 2-D array of pixels for each of the components (Y, U, V) in the image.
     // Cheat Sheet:
@@ -943,7 +1203,7 @@ SkCodec::Result SkJpegCodec::onGetYUV8Planes(const SkYUVASizeInfo& sizeInfo,
         JDIMENSION linesRead = jpeg_read_raw_data(dinfo, yuv, numRowsPerBlock);
         if (linesRead < numRowsPerBlock) {
             // FIXME: Handle incomplete YUV decodes without signalling an error.
-            return kInvalidInput;
+            return SkCodec::kInvalidInput;
         }
 
         // Update rowptrs.
@@ -977,11 +1237,123 @@ SkCodec::Result SkJpegCodec::onGetYUV8Planes(const SkYUVASizeInfo& sizeInfo,
         JDIMENSION linesRead = jpeg_read_raw_data(dinfo, yuv, numRowsPerBlock);
         if (linesRead < remainingRows) {
             // FIXME: Handle incomplete YUV decodes without signalling an error.
-            return kInvalidInput;
+            return SkCodec::kInvalidInput;
         }
     }
 
-    return kSuccess;
+    return SkCodec::kSuccess;
+}
+
+static bool decode_yuv_band(const sk_sp<SkData>& band, const SkYUVASizeInfo& sizeInfo,
+                            void* planes[SkYUVASizeInfo::kMaxCount]) {
+    SkMemoryStream stream(band);
+    JpegDecoderMgr decoderMgr(&stream);
+
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(decoderMgr.errorMgr());
+    if (setjmp(jmp)) {
+        return false;
+    }
+
+    decoderMgr.init();
+    jpeg_decompress_struct* dinfo = decoderMgr.dinfo();
+    if (JPEG_HEADER_OK != jpeg_read_header(dinfo, true) || !is_yuv_supported(dinfo)) {
+        return false;
+    }
+    dinfo->raw_data_out = TRUE;
+    if (!jpeg_start_decompress(dinfo) ||
+            dinfo->comp_info[0].width_in_blocks * DCTSIZE > sizeInfo.fWidthBytes[0] ||
+            dinfo->comp_info[1].width_in_blocks * DCTSIZE > sizeInfo.fWidthBytes[1] ||
+            dinfo->comp_info[2].width_in_blocks * DCTSIZE > sizeInfo.fWidthBytes[2]) {
+        return false;
+    }
+    return SkCodec::kSuccess == read_yuv8_planes(dinfo, sizeInfo, planes);
+}
+
+bool SkJpegCodec::decodeYUVInBands(const SkYUVASizeInfo& sizeInfo,
+                                   void* planes[SkYUVASizeInfo::kMaxCount],
+                                   SkExecutor* executor) {
+    const void* data = this->stream()->getMemoryBase();
+    if (!data || !this->stream()->hasLength()) {
+        return false;
+    }
+
+    // Raw data isn't upsampled, so bands don't need any context rows.
+    std::vector<JpegBand> bands;
+    int mcuHeight;
+    if (!slice_at_restarts((const uint8_t*) data, this->stream()->getLength(), false, &bands,
+                           &mcuHeight)) {
+        return false;
+    }
+
+    // In every case is_yuv_supported() allows, an MCU row holds mcuHeight rows of Y and
+    // DCTSIZE rows of U and V.
+    std::atomic<bool> success{true};
+    SkTaskGroup taskGroup(*executor);
+    taskGroup.batch(SkToInt(bands.size()), [&](int i) {
+        const JpegBand& band = bands[i];
+        const size_t yTop  = band.fFirstMCURow * mcuHeight,
+                     uvTop = band.fFirstMCURow * DCTSIZE;
+        void* bandPlanes[SkYUVASizeInfo::kMaxCount] = {
+            SkTAddOffset<void>(planes[0], yTop  * sizeInfo.fWidthBytes[0]),
+            SkTAddOffset<void>(planes[1], uvTop * sizeInfo.fWidthBytes[1]),
+            SkTAddOffset<void>(planes[2], uvTop * sizeInfo.fWidthBytes[2]),
+            nullptr,
+        };
+        if (!decode_yuv_band(band.fData, sizeInfo, bandPlanes)) {
+            success = false;
+        }
+    });
+    taskGroup.wait();
+    return success;
+}
+
+SkCodec::Result SkJpegCodec::onGetYUV8Planes(const SkYUVASizeInfo& sizeInfo,
+                                             void* planes[SkYUVASizeInfo::kMaxCount],
+                                             SkExecutor* executor) {
+    SkYUVASizeInfo defaultInfo;
+
+    // This will check is_yuv_supported(), so we don't need to here.
+    bool supportsYUV = this->onQueryYUV8(&defaultInfo, nullptr);
+    if (!supportsYUV ||
+            sizeInfo.fSizes[0] != defaultInfo.fSizes[0] ||
+            sizeInfo.fSizes[1] != defaultInfo.fSizes[1] ||
+            sizeInfo.fSizes[2] != defaultInfo.fSizes[2] ||
+            sizeInfo.fWidthBytes[0] < defaultInfo.fWidthBytes[0] ||
+            sizeInfo.fWidthBytes[1] < defaultInfo.fWidthBytes[1] ||
+            sizeInfo.fWidthBytes[2] < defaultInfo.fWidthBytes[2]) {
+        return fDecoderMgr->returnFailure("onGetYUV8Planes", kInvalidInput);
+    }
+
+    if (executor && this->decodeYUVInBands(sizeInfo, planes, executor)) {
+        return kSuccess;
+    }
+
+    // Set the jump location for libjpeg errors
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(fDecoderMgr->errorMgr());
+    if (setjmp(jmp)) {
+        return fDecoderMgr->returnFailure("setjmp", kInvalidInput);
+    }
+
+    // Get a pointer to the decompress info since we will use it quite frequently
+    jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+
+    dinfo->raw_data_out = TRUE;
+    if (!jpeg_start_decompress(dinfo)) {
+        return fDecoderMgr->returnFailure("startDecompress", kInvalidInput);
+    }
+
+    // A previous implementation claims that the return value of is_yuv_supported()
+    // may change after calling jpeg_start_decompress().  It looks to me like this
+    // was caused by a bug in the old code, but we'll be safe and check here.
+    SkASSERT(is_yuv_supported(dinfo));
+
+    // Currently, we require that the Y plane dimensions match the image dimensions
+    // and that the U and V planes are the same dimensions.
+    SkASSERT(sizeInfo.fSizes[1] == sizeInfo.fSizes[2]);
+    SkASSERT((uint32_t) sizeInfo.fSizes[0].width() == dinfo->output_width &&
+             (uint32_t) sizeInfo.fSizes[0].height() == dinfo->output_height);
+
+    return read_yuv8_planes(dinfo, sizeInfo, planes);
 }
 
 // This function is declared in SkJpegInfo.h, used by SkPDF.
@@ -47,7 +47,7 @@ protected:
     bool onQueryYUV8(SkYUVASizeInfo* sizeInfo, SkYUVColorSpace* colorSpace) const override;
 
     Result onGetYUV8Planes(const SkYUVASizeInfo& sizeInfo,
-                           void* planes[SkYUVASizeInfo::kMaxCount]) override;
+                           void* planes[SkYUVASizeInfo::kMaxCount], SkExecutor*) override;
 
     SkEncodedImageFormat onGetEncodedFormat() const override {
         return SkEncodedImageFormat::kJPEG;
@@ -109,6 +109,17 @@ private:
     void allocateStorage(const SkImageInfo& dstInfo);
     int readRows(const SkImageInfo& dstInfo, void* dst, size_t rowBytes, int count, const Options&);
 
+    /*
+     * If the image has restart markers on MCU row boundaries, splits it into bands and
+     * decodes them concurrently on executor.  Returns false, having possibly written part
+     * of the output, if the image can't be split or a band fails to decode.
+     */
+    bool decodeInBands(const SkImageInfo& dstInfo, void* dst, size_t rowBytes, SkExecutor*);
+    bool decodeBand(const sk_sp<SkData>& band, int skipRows, int rows,
+                    const SkImageInfo& dstInfo, void* dst, size_t rowBytes) const;
+    bool decodeYUVInBands(const SkYUVASizeInfo&, void* planes[SkYUVASizeInfo::kMaxCount],
+                          SkExecutor*);
+
     /*
      * Scanline decoding.
      */
@@ -24,6 +24,7 @@
 
 #include "png.h"
 #include <algorithm>
+#include <vector>
 
 #ifdef SK_BUILD_FOR_ANDROID_FRAMEWORK
     #include "SkAndroidFrameworkUtils.h"
@@ -215,33 +216,46 @@ bool SkPngCodec::processData() {
     constexpr size_t kBufferSize = 4096;
     char buffer[kBufferSize];
 
+    fPaused = false;
     bool iend = false;
     while (true) {
-        size_t length;
-        if (fDecodedIdat) {
-            // Parse chunk length and type.
-            if (this->stream()->read(buffer, 8) < 8) {
-                break;
-            }
+        if (0 == fChunkBytesLeft) {
+            size_t length;
+            if (fDecodedIdat) {
+                // Parse chunk length and type.
+                if (this->stream()->read(buffer, 8) < 8) {
+                    break;
+                }
 
-            png_byte* chunk = reinterpret_cast<png_byte*>(buffer);
-            png_process_data(fPng_ptr, fInfo_ptr, chunk, 8);
-            if (is_chunk(chunk, "IEND")) {
-                iend = true;
-            }
+                png_byte* chunk = reinterpret_cast<png_byte*>(buffer);
+                png_process_data(fPng_ptr, fInfo_ptr, chunk, 8);
+                if (is_chunk(chunk, "IEND")) {
+                    iend = true;
+                }
 
-            length = png_get_uint_32(chunk);
-        } else {
-            length = fIdatLength;
-            png_byte idat[] = {0, 0, 0, 0, 'I', 'D', 'A', 'T'};
-            png_save_uint_32(idat, length);
-            png_process_data(fPng_ptr, fInfo_ptr, idat, 8);
-            fDecodedIdat = true;
+                length = png_get_uint_32(chunk);
+            } else {
+                length = fIdatLength;
+                png_byte idat[] = {0, 0, 0, 0, 'I', 'D', 'A', 'T'};
+                png_save_uint_32(idat, length);
+                png_process_data(fPng_ptr, fInfo_ptr, idat, 8);
+                fDecodedIdat = true;
+            }
+            fChunkBytesLeft = length + 4;
         }
 
-        // Process the full chunk + CRC.
-        if (!process_data(fPng_ptr, fInfo_ptr, this->stream(), buffer, kBufferSize, length + 4)
-                || iend) {
+        // Process the rest of the chunk + CRC, a buffer at a time, so that a callback can
+        // pause us without losing our place.
+        while (fChunkBytesLeft > 0 && !fPaused) {
+            const size_t bytesToProcess = std::min(kBufferSize, fChunkBytesLeft);
+            const size_t bytesRead = this->stream()->read(buffer, bytesToProcess);
+            png_process_data(fPng_ptr, fInfo_ptr, (png_bytep) buffer, bytesRead);
+            fChunkBytesLeft -= bytesRead;
+            if (bytesRead < bytesToProcess) {
+                return true;
+            }
+        }
+        if (fPaused || iend) {
             break;
         }
     }
@@ -500,6 +514,12 @@ public:
         , fRowBytes(0)
         , fFirstRow(0)
         , fLastRow(0)
+        , fRowsNeeded(0)
+        , fNextRow(0)
+        , fPendingFirstRow(0)
+        , fPendingRowCount(0)
+        , fPendingOverflowed(false)
+        , fResumable(false)
     {}
 
     static void AllRowsCallback(png_structp png_ptr, png_bytep row, png_uint_32 rowNum, int /*pass*/) {
@@ -520,6 +540,19 @@ private:
     int                         fLastRow;
     int                         fRowsNeeded;
 
+    // Variables for resuming a partial decode. Once we have all the rows we need, libpng
+    // still hands us the rest of the rows in the buffer it was given; we keep those so the
+    // next incremental decode can start with them instead of rewinding.
+    int                         fNextRow;   // first row we have not looked at
+    std::vector<png_byte>       fPendingRows;
+    int                         fPendingFirstRow;
+    int                         fPendingRowCount;
+    bool                        fPendingOverflowed;
+    bool                        fResumable;
+
+    // A bound on fPendingRows, for images that compress extremely well.
+    static constexpr size_t kMaxPendingBytes = 1 << 20;
+
     typedef SkPngCodec INHERITED;
 
     static SkPngNormalDecoder* GetDecoder(png_structp png_ptr) {
@@ -563,6 +596,19 @@ private:
         fRowBytes = rowBytes;
         fRowsWrittenToOutput = 0;
         fRowsNeeded = fLastRow - fFirstRow + 1;
+        fPaused = false;
+        fResumable = false;
+        if (!this->resumingDecode()) {
+            fNextRow = 0;
+            fPendingRows.clear();
+            fPendingRowCount = 0;
+            fPendingOverflowed = false;
+        }
+        SkASSERT(fFirstRow >= fNextRow);
+    }
+
+    bool canResumeAt(int firstRow) const override {
+        return fResumable && firstRow >= fNextRow;
     }
 
     Result decode(int* rowsDecoded) override {
@@ -571,7 +617,25 @@ private:
             fRowsNeeded = get_scaled_dimension(fLastRow - fFirstRow + 1, sampleY);
         }
 
-        const bool success = this->processData();
+        // Rows left over from the decode we are resuming come before anything libpng has
+        // left to give us.
+        if (fPendingRowCount > 0) {
+            const size_t pngRowBytes = png_get_rowbytes(this->png_ptr(), this->info_ptr());
+            png_bytep row = fPendingRows.data() + pngRowBytes * (fNextRow - fPendingFirstRow);
+            while (fPendingRowCount > 0 && !fPaused) {
+                this->useRow(row, fNextRow);
+                row += pngRowBytes;
+                fPendingRowCount--;
+            }
+            if (0 == fPendingRowCount) {
+                fPendingRows.clear();
+            }
+        }
+
+        const bool success = fPaused || this->processData();
+        // If we stopped at a row boundary with nothing dropped, the next decode can pick
+        // up from here.
+        fResumable = success && fPaused && !fPendingOverflowed;
         if (success && fRowsWrittenToOutput == fRowsNeeded) {
             return kSuccess;
         }
@@ -584,6 +648,16 @@ private:
     }
 
     void rowCallback(png_bytep row, int rowNum) {
+        if (fPaused) {
+            this->holdRow(row, rowNum);
+            return;
+        }
+        SkASSERT(rowNum == fNextRow);
+        this->useRow(row, rowNum);
+    }
+
+    void useRow(png_bytep row, int rowNum) {
+        fNextRow = rowNum + 1;
         if (rowNum < fFirstRow) {
             // Ignore this row.
             return;
@@ -600,10 +674,25 @@ private:
         }
 
         if (fRowsWrittenToOutput == fRowsNeeded) {
-            // Fake error to stop decoding scanlines.
-            longjmp(PNG_JMPBUF(this->png_ptr()), kStopDecoding);
+            // Stop feeding libpng. Unlike longjmp'ing out of here, this leaves it in a
+            // state we can resume from.
+            fPaused = true;
         }
     }
+
+    void holdRow(png_bytep row, int rowNum) {
+        const size_t pngRowBytes = png_get_rowbytes(this->png_ptr(), this->info_ptr());
+        if (fPendingOverflowed || fPendingRows.size() + pngRowBytes > kMaxPendingBytes) {
+            fPendingOverflowed = true;
+            return;
+        }
+        if (0 == fPendingRowCount) {
+            fPendingFirstRow = rowNum;
+        }
+        SkASSERT(rowNum == fPendingFirstRow + fPendingRowCount);
+        fPendingRows.insert(fPendingRows.end(), row, row + pngRowBytes);
+        fPendingRowCount++;
+    }
 };
 
 class SkPngInterlacedDecoder : public SkPngCodec {
@@ -618,6 +707,8 @@ public:
         , fLinesDecoded(0)
         , fInterlacedComplete(false)
         , fPng_rowbytes(0)
+        , fSampleY(0)
+        , fBufferedRows(0)
     {}
 
     static void InterlacedRowCallback(png_structp png_ptr, png_bytep row, png_uint_32 rowNum, int pass) {
@@ -635,6 +726,10 @@ private:
     bool                    fInterlacedComplete;
     size_t                  fPng_rowbytes;
     SkAutoTMalloc<png_byte> fInterlaceBuffer;
+    // fInterlaceBuffer only holds the rows that survive sampling: every fSampleY'th row
+    // of the range, fBufferedRows in all. 0 until decode() knows the sampler's settings.
+    int                     fSampleY;
+    int                     fBufferedRows;
 
     typedef SkPngCodec INHERITED;
 
@@ -647,8 +742,13 @@ private:
             return;
         }
 
-        png_bytep oldRow = fInterlaceBuffer.get() + (rowNum - fFirstRow) * fPng_rowbytes;
-        png_progressive_combine_row(this->png_ptr(), oldRow, row);
+        // Every pass has to be inflated, but rows the sampler drops need not be combined.
+        const int rowInRange = rowNum - fFirstRow;
+        if (rowInRange % fSampleY == get_start_coord(fSampleY) &&
+                rowInRange / fSampleY < fBufferedRows) {
+            png_bytep oldRow = fInterlaceBuffer.get() + (rowInRange / fSampleY) * fPng_rowbytes;
+            png_progressive_combine_row(this->png_ptr(), oldRow, row);
+        }
 
         if (0 == pass) {
             // The first pass initializes all rows.
@@ -660,8 +760,7 @@ private:
             if (fNumberPasses - 1 == pass && rowNum == fLastRow) {
                 // Last pass, and we have read all of the rows we care about.
                 fInterlacedComplete = true;
-                if (fLastRow != this->dimensions().height() - 1 ||
-                        (this->swizzler() && this->swizzler()->sampleY() != 1)) {
+                if (fLastRow != this->dimensions().height() - 1 || fSampleY != 1) {
                     // Fake error to stop decoding scanlines. Only stop if we're not decoding the
                     // whole image, in which case processing the rest of the image might be
                     // expensive. When decoding the whole image, read through the IEND chunk to
@@ -674,6 +773,7 @@ private:
 
     Result decodeAllRows(void* dst, size_t rowBytes, int* rowsDecoded) override {
         const int height = this->dimensions().height();
+        fSampleY = 1;
         this->setUpInterlaceBuffer(height);
         png_set_progressive_read_fn(this->png_ptr(), this, nullptr, InterlacedRowCallback,
                                     nullptr);
@@ -702,17 +802,24 @@ private:
     }
 
     void setRange(int firstRow, int lastRow, void* dst, size_t rowBytes) override {
-        // FIXME: We could skip rows in the interlace buffer that we won't put in the output.
-        this->setUpInterlaceBuffer(lastRow - firstRow + 1);
         png_set_progressive_read_fn(this->png_ptr(), this, nullptr, InterlacedRowCallback, nullptr);
         fFirstRow = firstRow;
         fLastRow = lastRow;
         fDst = dst;
         fRowBytes = rowBytes;
         fLinesDecoded = 0;
+        // The sampler may not be set up until after this, so the interlace buffer is
+        // allocated on the first call to decode().
+        fSampleY = 0;
+        fInterlacedComplete = false;
     }
 
     Result decode(int* rowsDecoded) override {
+        if (0 == fSampleY) {
+            fSampleY = this->swizzler() ? this->swizzler()->sampleY() : 1;
+            this->setUpInterlaceBuffer(get_scaled_dimension(fLastRow - fFirstRow + 1, fSampleY));
+        }
+
         const bool success = this->processData();
 
         // Now apply Xforms on all the rows that were decoded.
@@ -723,24 +830,22 @@ private:
             return log_and_return_error(success);
         }
 
-        const int sampleY = this->swizzler() ? this->swizzler()->sampleY() : 1;
-        const int rowsNeeded = get_scaled_dimension(fLastRow - fFirstRow + 1, sampleY);
-
         // FIXME: For resuming interlace, we may swizzle a row that hasn't changed. But it
         // may be too tricky/expensive to handle that correctly.
 
-        // Offset srcRow by get_start_coord rows. We do not need to account for fFirstRow,
-        // since the first row in fInterlaceBuffer corresponds to fFirstRow.
-        int srcRow = get_start_coord(sampleY);
+        // srcRow is the row of the range that buffered row rowsWrittenToOutput came from.
+        // fLinesDecoded counts rows of the range that the first pass has reached.
+        int srcRow = get_start_coord(fSampleY);
         void* dst = fDst;
         int rowsWrittenToOutput = 0;
-        while (rowsWrittenToOutput < rowsNeeded && srcRow < fLinesDecoded) {
-            png_bytep src = SkTAddOffset<png_byte>(fInterlaceBuffer.get(), fPng_rowbytes * srcRow);
+        while (rowsWrittenToOutput < fBufferedRows && srcRow < fLinesDecoded) {
+            png_bytep src = SkTAddOffset<png_byte>(fInterlaceBuffer.get(),
+                                                   fPng_rowbytes * rowsWrittenToOutput);
             this->applyXformRow(dst, src);
             dst = SkTAddOffset<void>(dst, fRowBytes);
 
             rowsWrittenToOutput++;
-            srcRow += sampleY;
+            srcRow += fSampleY;
         }
 
         if (success && fInterlacedComplete) {
@@ -756,6 +861,7 @@ private:
     void setUpInterlaceBuffer(int height) {
         fPng_rowbytes = png_get_rowbytes(this->png_ptr(), this->info_ptr());
         fInterlaceBuffer.reset(fPng_rowbytes * height);
+        fBufferedRows = height;
         fInterlacedComplete = false;
     }
 };
@@ -977,8 +1083,12 @@ SkPngCodec::SkPngCodec(SkEncodedInfo&& encodedInfo, std::unique_ptr<SkStream> st
     , fInfo_ptr(info_ptr)
     , fColorXformSrcRow(nullptr)
     , fBitDepth(bitDepth)
+    , fPaused(false)
     , fIdatLength(0)
     , fDecodedIdat(false)
+    , fChunkBytesLeft(0)
+    , fUpdatedInfo(false)
+    , fResumeDecode(false)
 {}
 
 SkPngCodec::~SkPngCodec() {
@@ -1004,7 +1114,12 @@ SkCodec::Result SkPngCodec::initializeXforms(const SkImageInfo& dstInfo, const O
         SkCodecPrintf("Failed on png_read_update_info.\n");
         return kInvalidInput;
     }
-    png_read_update_info(fPng_ptr, fInfo_ptr);
+    // libpng only allows this once per png_ptr, and a resumed decode is still using the
+    // png_ptr it was called on.
+    if (!fUpdatedInfo) {
+        png_read_update_info(fPng_ptr, fInfo_ptr);
+        fUpdatedInfo = true;
+    }
 
     // Reset fSwizzler and this->colorXform().  We can't do this in onRewind() because the
     // interlaced scanline decoder may need to rewind.
@@ -1133,6 +1248,9 @@ bool SkPngCodec::onRewind() {
     fPng_ptr = png_ptr;
     fInfo_ptr = info_ptr;
     fDecodedIdat = false;
+    fChunkBytesLeft = 0;
+    fUpdatedInfo = false;
+    fResumeDecode = false;
     return true;
 }
 
@@ -1171,9 +1289,15 @@ SkCodec::Result SkPngCodec::onStartIncrementalDecode(const SkImageInfo& dstInfo,
         lastRow = dstInfo.height() - 1;
     }
     this->setRange(firstRow, lastRow, dst, rowBytes);
+    fResumeDecode = false;
     return kSuccess;
 }
 
+bool SkPngCodec::onCanResumeIncrementalDecode(const SkImageInfo&, const Options& options) {
+    fResumeDecode = this->canResumeAt(options.fSubset ? options.fSubset->top() : 0);
+    return fResumeDecode;
+}
+
 SkCodec::Result SkPngCodec::onIncrementalDecode(int* rowsDecoded) {
     // FIXME: Only necessary on the first call.
     this->initializeXformParams();
@@ -67,13 +67,20 @@ protected:
      *  Pass available input to libpng to process it.
      *
      *  libpng will call any relevant callbacks installed. This will continue decoding
-     *  until it reaches the end of the file, or until a callback tells libpng to stop.
+     *  until it reaches the end of the file, or until a callback tells libpng to stop,
+     *  either by longjmp'ing with kStopDecoding or by setting fPaused.  Only the latter
+     *  can be picked up again by a later call.
      */
     bool processData();
 
     Result onStartIncrementalDecode(const SkImageInfo& dstInfo, void* pixels, size_t rowBytes,
             const SkCodec::Options&) override;
     Result onIncrementalDecode(int*) override;
+    bool onCanResumeIncrementalDecode(const SkImageInfo&, const Options&) override;
+
+    // True while onStartIncrementalDecode() is continuing the previous incremental decode,
+    // rather than starting from a freshly rewound png_ptr.
+    bool resumingDecode() const { return fResumeDecode; }
 
     sk_sp<SkPngChunkReader>     fPngChunkReader;
     voidp                       fPng_ptr;
@@ -86,6 +93,10 @@ protected:
     void*                       fColorXformSrcRow;
     const int                   fBitDepth;
 
+    // Set by a row callback to make processData() stop once libpng returns, leaving the
+    // stream at a chunk position it can carry on from.
+    bool                        fPaused;
+
 private:
 
     enum XformMode {
@@ -109,12 +120,19 @@ private:
     virtual Result decodeAllRows(void* dst, size_t rowBytes, int* rowsDecoded) = 0;
     virtual void setRange(int firstRow, int lastRow, void* dst, size_t rowBytes) = 0;
     virtual Result decode(int* rowsDecoded) = 0;
+    // Whether an incremental decode starting at firstRow can continue from where the
+    // last one stopped.
+    virtual bool canResumeAt(int /* firstRow */) const { return false; }
 
     XformMode                      fXformMode;
     int                            fXformWidth;
 
     size_t                         fIdatLength;
     bool                           fDecodedIdat;
+    // Bytes of the current chunk, including its CRC, not yet passed to libpng.
+    size_t                         fChunkBytesLeft;
+    bool                           fUpdatedInfo;
+    bool                           fResumeDecode;
 
     typedef SkCodec INHERITED;
 };
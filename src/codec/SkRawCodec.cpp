@@ -537,6 +537,41 @@ public:
         return 0x2A == get_endian_short(header + 2, littleEndian);
     }
 
+    // Quick check if the first IFD has the DNGVersion tag that every DNG must have. Other RAW
+    // formats are TIFF based too, so a valid TIFF header does not mean the DNG SDK can read it.
+    // Does not affect ownership of stream.
+    static bool HasDngVersionTag(SkRawStream* stream) {
+        const size_t kHeaderSize = 8;
+        unsigned char header[kHeaderSize];
+        bool littleEndian;
+        if (!stream->read(header, 0 /* offset */, kHeaderSize) ||
+            !is_valid_endian_marker(header, &littleEndian) ||
+            0x2A != get_endian_short(header + 2, littleEndian)) {
+            return false;
+        }
+
+        const size_t ifdOffset = get_endian_int(header + 4, littleEndian);
+        unsigned char countData[2];
+        if (!stream->read(countData, ifdOffset, sizeof(countData))) {
+            return false;
+        }
+
+        const int numEntries = get_endian_short(countData, littleEndian);
+        const size_t kEntrySize = 12;
+        SkAutoTMalloc<unsigned char> entries(numEntries * kEntrySize);
+        if (!stream->read(entries.get(), ifdOffset + sizeof(countData), numEntries * kEntrySize)) {
+            return false;
+        }
+
+        const uint16_t kDngVersionTag = 50706;
+        for (int i = 0; i < numEntries; ++i) {
+            if (kDngVersionTag == get_endian_short(&entries[i * kEntrySize], littleEndian)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
 private:
     bool init(int width, int height, const dng_point& cfaPatternSize) {
         fWidth = width;
@@ -612,10 +647,58 @@ private:
     bool fIsXtransImage;
 };
 
+static std::unique_ptr<SkEncodedInfo::ICCProfile> make_preview_profile(
+        const ::piex::PreviewImageData& imageData) {
+    if (imageData.color_space == ::piex::PreviewImageData::kAdobeRgb) {
+        skcms_ICCProfile skcmsProfile;
+        skcms_Init(&skcmsProfile);
+        skcms_SetTransferFunction(&skcmsProfile, &SkNamedTransferFn::k2Dot2);
+        skcms_SetXYZD50(&skcmsProfile, &SkNamedGamut::kAdobeRGB);
+        return SkEncodedInfo::ICCProfile::Make(skcmsProfile);
+    }
+    return nullptr;
+}
+
+/*
+ * Makes a codec for the JPEG preview embedded in a DNG, to decode small sizes from instead of
+ * rendering the raw image. Returns nullptr if the preview can not stand in for a downscaled raw
+ * image, e.g. it is rotated or cropped. Does not affect ownership of rawStream, and leaves it
+ * usable.
+ */
+static std::unique_ptr<SkCodec> make_preview_codec(SkRawStream* rawStream,
+                                                   const ::piex::PreviewImageData& imageData) {
+    const ::piex::Image& preview = imageData.preview;
+    if (preview.width == 0 || preview.height == 0) {
+        return nullptr;
+    }
+
+    // Allow the preview's aspect ratio to be off by rounding to whole pixels.
+    const float expectedHeight = static_cast<float>(preview.width) * imageData.full_height /
+                                 imageData.full_width;
+    if (std::abs(expectedHeight - preview.height) > 1.f) {
+        return nullptr;
+    }
+
+    sk_sp<SkData> data(SkData::MakeUninitialized(preview.length));
+    if (!rawStream->read(data->writable_data(), preview.offset, preview.length)) {
+        return nullptr;
+    }
+
+    SkCodec::Result result;
+    std::unique_ptr<SkCodec> codec = SkJpegCodec::MakeFromStream(
+            SkMemoryStream::Make(std::move(data)), &result, make_preview_profile(imageData));
+    if (!codec || codec->dimensions() != SkISize::Make(preview.width, preview.height)) {
+        return nullptr;
+    }
+    return codec;
+}
+
 /*
  * Tries to handle the image with PIEX. If PIEX returns kOk and finds the preview image, create a
  * SkJpegCodec. If PIEX returns kFail, then the file is invalid, return nullptr. In other cases,
  * fallback to create SkRawCodec for DNG images.
+ * A DNG whose preview is smaller than the raw image gets a SkRawCodec that decodes small sizes
+ * from the preview.
  */
 std::unique_ptr<SkCodec> SkRawCodec::MakeFromStream(std::unique_ptr<SkStream> stream,
                                                     Result* result) {
@@ -629,6 +712,7 @@ std::unique_ptr<SkCodec> SkRawCodec::MakeFromStream(std::unique_ptr<SkStream> st
     // Does not take the ownership of rawStream.
     SkPiexStream piexStream(rawStream.get());
     ::piex::PreviewImageData imageData;
+    std::unique_ptr<SkCodec> previewCodec;
     if (::piex::IsRaw(&piexStream)) {
         ::piex::Error error = ::piex::GetPreviewImageData(&piexStream, &imageData);
         if (error == ::piex::Error::kFail) {
@@ -636,31 +720,31 @@ std::unique_ptr<SkCodec> SkRawCodec::MakeFromStream(std::unique_ptr<SkStream> st
             return nullptr;
         }
 
-        std::unique_ptr<SkEncodedInfo::ICCProfile> profile;
-        if (imageData.color_space == ::piex::PreviewImageData::kAdobeRgb) {
-            skcms_ICCProfile skcmsProfile;
-            skcms_Init(&skcmsProfile);
-            skcms_SetTransferFunction(&skcmsProfile, &SkNamedTransferFn::k2Dot2);
-            skcms_SetXYZD50(&skcmsProfile, &SkNamedGamut::kAdobeRGB);
-            profile = SkEncodedInfo::ICCProfile::Make(skcmsProfile);
-        }
-
         //  Theoretically PIEX can return JPEG compressed image or uncompressed RGB image. We only
         //  handle the JPEG compressed preview image here.
         if (error == ::piex::Error::kOk && imageData.preview.length > 0 &&
             imageData.preview.format == ::piex::Image::kJpegCompressed)
         {
-            // transferBuffer() is destructive to the rawStream. Abandon the rawStream after this
-            // function call.
-            // FIXME: one may avoid the copy of memoryStream and use the buffered rawStream.
-            auto memoryStream = rawStream->transferBuffer(imageData.preview.offset,
-                                                          imageData.preview.length);
-            if (!memoryStream) {
-                *result = kInvalidInput;
-                return nullptr;
+            if (imageData.preview.width < imageData.full_width &&
+                imageData.preview.height < imageData.full_height &&
+                SkDngImage::HasDngVersionTag(rawStream.get()))
+            {
+                previewCodec = make_preview_codec(rawStream.get(), imageData);
+            }
+
+            if (!previewCodec) {
+                // transferBuffer() is destructive to the rawStream. Abandon the rawStream after
+                // this function call.
+                // FIXME: one may avoid the copy of memoryStream and use the buffered rawStream.
+                auto memoryStream = rawStream->transferBuffer(imageData.preview.offset,
+                                                              imageData.preview.length);
+                if (!memoryStream) {
+                    *result = kInvalidInput;
+                    return nullptr;
+                }
+                return SkJpegCodec::MakeFromStream(std::move(memoryStream), result,
+                                                   make_preview_profile(imageData));
             }
-            return SkJpegCodec::MakeFromStream(std::move(memoryStream), result,
-                                               std::move(profile));
         }
     }
 
@@ -672,17 +756,29 @@ std::unique_ptr<SkCodec> SkRawCodec::MakeFromStream(std::unique_ptr<SkStream> st
     // Takes the ownership of the rawStream.
     std::unique_ptr<SkDngImage> dngImage(SkDngImage::NewFromStream(rawStream.release()));
     if (!dngImage) {
+        if (previewCodec) {
+            // Fall back to decoding just the preview, as for other RAW formats.
+            *result = kSuccess;
+            return previewCodec;
+        }
         *result = kInvalidInput;
         return nullptr;
     }
 
     *result = kSuccess;
-    return std::unique_ptr<SkCodec>(new SkRawCodec(dngImage.release()));
+    return std::unique_ptr<SkCodec>(new SkRawCodec(dngImage.release(), std::move(previewCodec)));
 }
 
 SkCodec::Result SkRawCodec::onGetPixels(const SkImageInfo& dstInfo, void* dst,
                                         size_t dstRowBytes, const Options& options,
                                         int* rowsDecoded) {
+    if (this->isPreviewDimensions(dstInfo.dimensions())) {
+        const Result result = fPreviewCodec->getPixels(dstInfo, dst, dstRowBytes, &options);
+        // The preview codec fills in any rows it could not decode itself.
+        *rowsDecoded = dstInfo.height();
+        return result;
+    }
+
     const int width = dstInfo.width();
     const int height = dstInfo.height();
     std::unique_ptr<dng_image> image(fDngImage->render(width, height));
@@ -752,6 +848,18 @@ SkCodec::Result SkRawCodec::onGetPixels(const SkImageInfo& dstInfo, void* dst,
 SkISize SkRawCodec::onGetScaledDimensions(float desiredScale) const {
     SkASSERT(desiredScale <= 1.f);
 
+    if (fPreviewCodec) {
+        // Sizes the preview covers are decoded from it, which is much faster than rendering.
+        const float previewScale = desiredScale * this->dimensions().fWidth /
+                                   fPreviewCodec->dimensions().fWidth;
+        if (previewScale <= 1.f) {
+            return fPreviewCodec->getScaledDimensions(previewScale);
+        }
+    }
+    return this->getRenderedDimensions(desiredScale);
+}
+
+SkISize SkRawCodec::getRenderedDimensions(float desiredScale) const {
     const SkISize dim = this->dimensions();
     SkASSERT(dim.fWidth != 0 && dim.fHeight != 0);
 
@@ -777,21 +885,40 @@ SkISize SkRawCodec::onGetScaledDimensions(float desiredScale) const {
                          static_cast<int32_t>(std::floor(dim.fHeight / finalScale)));
 }
 
+bool SkRawCodec::isPreviewDimensions(const SkISize& dim) const {
+    if (!fPreviewCodec) {
+        return false;
+    }
+
+    // SkJpegCodec scales by eighths.
+    for (int numerator = 1; numerator <= 8; ++numerator) {
+        if (fPreviewCodec->getScaledDimensions(numerator / 8.f) == dim) {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool SkRawCodec::onDimensionsSupported(const SkISize& dim) {
+    if (this->isPreviewDimensions(dim)) {
+        return true;
+    }
+
     const SkISize fullDim = this->dimensions();
     const float fullShortEdge = static_cast<float>(SkTMin(fullDim.fWidth, fullDim.fHeight));
     const float shortEdge = static_cast<float>(SkTMin(dim.fWidth, dim.fHeight));
 
-    SkISize sizeFloor = this->onGetScaledDimensions(1.f / std::floor(fullShortEdge / shortEdge));
-    SkISize sizeCeil = this->onGetScaledDimensions(1.f / std::ceil(fullShortEdge / shortEdge));
+    SkISize sizeFloor = this->getRenderedDimensions(1.f / std::floor(fullShortEdge / shortEdge));
+    SkISize sizeCeil = this->getRenderedDimensions(1.f / std::ceil(fullShortEdge / shortEdge));
     return sizeFloor == dim || sizeCeil == dim;
 }
 
 SkRawCodec::~SkRawCodec() {}
 
-SkRawCodec::SkRawCodec(SkDngImage* dngImage)
+SkRawCodec::SkRawCodec(SkDngImage* dngImage, std::unique_ptr<SkCodec> previewCodec)
     : INHERITED(SkEncodedInfo::Make(dngImage->width(), dngImage->height(),
                                     SkEncodedInfo::kRGB_Color,
                                     SkEncodedInfo::kOpaque_Alpha, 8),
                 skcms_PixelFormat_RGBA_8888, nullptr)
-    , fDngImage(dngImage) {}
+    , fDngImage(dngImage)
+    , fPreviewCodec(std::move(previewCodec)) {}
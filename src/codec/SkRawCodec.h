@@ -54,10 +54,19 @@ private:
     /*
      * Creates an instance of the decoder
      * Called only by NewFromStream, takes ownership of dngImage.
+     * previewCodec, if not null, decodes the DNG's embedded preview, which is smaller than the
+     * raw image.
      */
-    SkRawCodec(SkDngImage* dngImage);
+    SkRawCodec(SkDngImage* dngImage, std::unique_ptr<SkCodec> previewCodec);
+
+    // The size the DNG SDK renders the raw image to for desiredScale.
+    SkISize getRenderedDimensions(float desiredScale) const;
+
+    // Whether dim is decoded from the embedded preview rather than rendered.
+    bool isPreviewDimensions(const SkISize& dim) const;
 
     std::unique_ptr<SkDngImage> fDngImage;
+    std::unique_ptr<SkCodec>    fPreviewCodec;
 
     typedef SkCodec INHERITED;
 };
@@ -7,10 +7,12 @@
 
 #include "SkCodec.h"
 #include "SkCodecPriv.h"
+#include "SkConvertPixels.h"
 #include "SkMath.h"
 #include "SkMathPriv.h"
 #include "SkSampledCodec.h"
 #include "SkSampler.h"
+#include "SkStreamingResizer.h"
 #include "SkTemplates.h"
 
 SkSampledCodec::SkSampledCodec(SkCodec* codec, ExifOrientationBehavior behavior)
@@ -73,6 +75,10 @@ SkISize SkSampledCodec::onGetSampledDimensions(int sampleSize) const {
 
 SkCodec::Result SkSampledCodec::onGetAndroidPixels(const SkImageInfo& info, void* pixels,
         size_t rowBytes, const AndroidOptions& options) {
+    if (ResizeFilter::kNone != options.fResizeFilter) {
+        return this->resizedDecode(info, pixels, rowBytes, options);
+    }
+
     // Create an Options struct for the codec.
     SkCodec::Options codecOptions;
     codecOptions.fZeroInitialized = options.fZeroInitialized;
@@ -350,3 +356,103 @@ SkCodec::Result SkSampledCodec::sampledDecode(const SkImageInfo& info, void* pix
             return SkCodec::kUnimplemented;
     }
 }
+
+SkCodec::Result SkSampledCodec::resizedDecode(const SkImageInfo& info, void* pixels,
+        size_t rowBytes, const AndroidOptions& options) {
+    SkASSERT(ResizeFilter::kNone != options.fResizeFilter);
+
+    const SkIRect srcRect = options.fSubset ? *options.fSubset
+                                            : SkIRect::MakeSize(this->codec()->dimensions());
+    if (info.isEmpty() || info.width() > srcRect.width() || info.height() > srcRect.height()) {
+        return SkCodec::kInvalidScale;
+    }
+
+    // Let libjpeg do as much of the downscale as it can without going below the requested
+    // size.  Its DCT scaling is as good as any filter we could run afterwards.
+    int nativeSampleSize = 1;
+    if (this->codec()->getEncodedFormat() == SkEncodedImageFormat::kJPEG) {
+        for (int sampleSize : { 8, 4, 2 }) {
+            if (get_scaled_dimension(srcRect.width(),  sampleSize) >= info.width() &&
+                get_scaled_dimension(srcRect.height(), sampleSize) >= info.height()) {
+                nativeSampleSize = sampleSize;
+                break;
+            }
+        }
+    }
+    const SkISize nativeSize = nativeSampleSize > 1
+            ? this->codec()->getScaledDimensions(get_scale_from_sample_size(nativeSampleSize))
+            : this->codec()->dimensions();
+
+    // The source rect, in the natively scaled image.
+    const int srcX = srcRect.x() / nativeSampleSize,
+              srcY = srcRect.y() / nativeSampleSize;
+    const int srcWidth  = SkTMin(get_scaled_dimension(srcRect.width(),  nativeSampleSize),
+                                 nativeSize.width()  - srcX),
+              srcHeight = SkTMin(get_scaled_dimension(srcRect.height(), nativeSampleSize),
+                                 nativeSize.height() - srcY);
+
+    if (srcWidth == info.width() && srcHeight == info.height()) {
+        // No resampling needed after all.
+        AndroidOptions exactOptions = options;
+        exactOptions.fResizeFilter = ResizeFilter::kNone;
+        exactOptions.fSampleSize = nativeSampleSize;
+        return this->onGetAndroidPixels(info, pixels, rowBytes, exactOptions);
+    }
+
+    // Filter in 8888.  Anything else is converted from a buffer of the (small) output.
+    const bool resizeInPlace = kRGBA_8888_SkColorType == info.colorType() ||
+                               kBGRA_8888_SkColorType == info.colorType();
+    const SkImageInfo resizedInfo = resizeInPlace ? info : info.makeColorType(kN32_SkColorType);
+    SkAutoTMalloc<uint32_t> resizedStorage;
+    SkPixmap resized(resizedInfo, pixels, rowBytes);
+    if (!resizeInPlace) {
+        resizedStorage.reset(resizedInfo.width() * resizedInfo.height());
+        resized.reset(resizedInfo, resizedStorage.get(), resizedInfo.minRowBytes());
+    }
+
+    SkCodec::Options codecOptions;
+    SkIRect scanlineSubset = SkIRect::MakeXYWH(srcX, 0, srcWidth, nativeSize.height());
+    if (srcWidth != nativeSize.width()) {
+        codecOptions.fSubset = &scanlineSubset;
+    }
+    const SkImageInfo nativeInfo = resizedInfo.makeWH(nativeSize.width(), nativeSize.height());
+    SkCodec::Result result = this->codec()->startScanlineDecode(nativeInfo, &codecOptions);
+    if (SkCodec::kIncompleteInput == result || SkCodec::kErrorInInput == result) {
+        return SkCodec::kInvalidInput;
+    } else if (SkCodec::kSuccess != result) {
+        return result;
+    }
+
+    const bool bottomUp = SkCodec::kBottomUp_SkScanlineOrder == this->codec()->getScanlineOrder();
+    if (bottomUp && (srcY != 0 || srcHeight != nativeSize.height())) {
+        // Bottom-up codecs don't support subsetting in y.
+        return SkCodec::kUnimplemented;
+    }
+    SkASSERT(bottomUp ||
+             SkCodec::kTopDown_SkScanlineOrder == this->codec()->getScanlineOrder());
+
+    SkStreamingResizer resizer(options.fResizeFilter, srcWidth, srcHeight, resized, bottomUp);
+    SkAutoTMalloc<uint32_t> row(srcWidth);
+    bool complete = bottomUp || this->codec()->skipScanlines(srcY);
+    for (int y = 0; complete && y < srcHeight; y++) {
+        complete = 1 == this->codec()->getScanlines(row.get(), 1, 0);
+        if (complete) {
+            resizer.addRow(row.get());
+        }
+    }
+
+    if (!complete) {
+        // Fill whatever the resizer didn't get to write.
+        const int remaining = info.height() - resizer.rowsWritten();
+        void* firstUnwritten = bottomUp ? resized.writable_addr()
+                                        : resized.writable_addr(0, resizer.rowsWritten());
+        SkSampler::Fill(resizedInfo.makeWH(info.width(), remaining), firstUnwritten,
+                        resized.rowBytes(), options.fZeroInitialized);
+    }
+    SkASSERT(!complete || resizer.rowsWritten() == info.height());
+
+    if (!resizeInPlace) {
+        SkConvertPixels(info, pixels, rowBytes, resized.info(), resized.addr(), resized.rowBytes());
+    }
+    return complete ? SkCodec::kSuccess : SkCodec::kIncompleteInput;
+}
@@ -54,6 +54,16 @@ private:
     SkCodec::Result sampledDecode(const SkImageInfo& info, void* pixels, size_t rowBytes,
             const AndroidOptions& options);
 
+    /**
+     *  This fulfills the same contract as onGetAndroidPixels().
+     *
+     *  We call this function from onGetAndroidPixels() if the client asked for a
+     *  ResizeFilter and a size that neither fCodec nor sampling can provide.  Rows are
+     *  decoded from fCodec's scanline decoder straight into an SkStreamingResizer.
+     */
+    SkCodec::Result resizedDecode(const SkImageInfo& info, void* pixels, size_t rowBytes,
+            const AndroidOptions& options);
+
     typedef SkAndroidCodec INHERITED;
 };
 #endif // SkSampledCodec_DEFINED
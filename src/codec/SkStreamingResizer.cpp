@@ -0,0 +1,170 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkStreamingResizer.h"
+
+#include "SkFloatingPoint.h"
+#include "SkScalar.h"
+#include "SkTo.h"
+
+#include <cmath>
+
+static float sinc(float x) {
+    if (x == 0.0f) {
+        return 1.0f;
+    }
+    x *= SK_ScalarPI;
+    return sk_float_sin(x) / x;
+}
+
+void SkStreamingResizer::ComputeContributions(Filter filter, int srcSize, int dstSize,
+                                              std::vector<Contribution>* contributions,
+                                              std::vector<float>* weights) {
+    // When downscaling, the filter is stretched to cover the source pixels under each
+    // destination pixel.  When upscaling, it stays at its natural size.
+    const float scale = (float) dstSize / srcSize;
+    const float filterScale = SkTMin(scale, 1.0f);
+    const float radius = Filter::kLanczos3 == filter ? 3.0f : 0.5f;
+    const float support = radius / filterScale;
+
+    contributions->resize(dstSize);
+    for (int i = 0; i < dstSize; i++) {
+        const float center = (i + 0.5f) / scale;
+        const int lo = SkTMax(0, (int) sk_float_floor(center - support));
+        const int hi = SkTMin(srcSize, (int) sk_float_ceil(center + support));
+
+        const size_t first = weights->size();
+        float sum = 0.0f;
+        for (int j = lo; j < hi; j++) {
+            float w;
+            if (Filter::kLanczos3 == filter) {
+                const float x = (j + 0.5f - center) * filterScale;
+                w = (x > -3.0f && x < 3.0f) ? sinc(x) * sinc(x / 3.0f) : 0.0f;
+            } else {
+                // The box is exact: each source pixel counts by how much of it is covered.
+                w = SkTMax(0.0f, SkTMin(j + 1.0f, center + support) -
+                                 SkTMax((float) j, center - support));
+            }
+            weights->push_back(w);
+            sum += w;
+        }
+
+        Contribution& c = (*contributions)[i];
+        c.fFirst = lo;
+        c.fCount = hi - lo;
+        c.fWeights = SkToInt(first);
+        if (sum == 0.0f || c.fCount == 0) {
+            // Can't happen for sane sizes, but don't divide by zero: take the nearest pixel.
+            weights->resize(first);
+            weights->push_back(1.0f);
+            c.fFirst = SkTPin((int) center, 0, srcSize - 1);
+            c.fCount = 1;
+            continue;
+        }
+
+        // Normalize, and trim taps that don't contribute.
+        float* w = weights->data() + first;
+        for (int j = 0; j < c.fCount; j++) {
+            w[j] /= sum;
+        }
+        while (c.fCount > 1 && w[0] == 0.0f) {
+            c.fFirst++;
+            c.fWeights++;
+            c.fCount--;
+            w++;
+        }
+        while (c.fCount > 1 && w[c.fCount - 1] == 0.0f) {
+            c.fCount--;
+        }
+    }
+}
+
+SkStreamingResizer::SkStreamingResizer(Filter filter, int srcWidth, int srcHeight,
+                                       const SkPixmap& dst, bool bottomUp)
+    : fDst(dst)
+    , fPremul(kPremul_SkAlphaType == dst.alphaType())
+    , fBottomUp(bottomUp)
+    , fRingHeight(1)
+    , fRowsAdded(0)
+    , fNextOutput(0)
+{
+    SkASSERT(kRGBA_8888_SkColorType == dst.colorType() ||
+             kBGRA_8888_SkColorType == dst.colorType());
+    SkASSERT(Filter::kNone != filter);
+
+    ComputeContributions(filter, srcWidth, dst.width(), &fColumns, &fColumnWeights);
+    ComputeContributions(filter, srcHeight, dst.height(), &fRows, &fRowWeights);
+
+    for (const Contribution& c : fRows) {
+        fRingHeight = SkTMax(fRingHeight, c.fCount);
+    }
+    fRing.reset(4 * dst.width() * fRingHeight);
+}
+
+void SkStreamingResizer::addRow(const uint32_t* src) {
+    SkASSERT(fRowsAdded < (int) fRows.size() || fNextOutput == fDst.height());
+
+    float* dst = fRing.get() + 4 * fDst.width() * (fRowsAdded % fRingHeight);
+    for (const Contribution& c : fColumns) {
+        const float* w = fColumnWeights.data() + c.fWeights;
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(src + c.fFirst);
+        float channels[4] = { 0, 0, 0, 0 };
+        for (int i = 0; i < c.fCount; i++, p += 4) {
+            for (int k = 0; k < 4; k++) {
+                channels[k] += w[i] * p[k];
+            }
+        }
+        memcpy(dst, channels, sizeof(channels));
+        dst += 4;
+    }
+    fRowsAdded++;
+
+    // Write every output row whose last source row just arrived.
+    while (fNextOutput < fDst.height()) {
+        const Contribution& c = fRows[fNextOutput];
+        if (c.fFirst + c.fCount > fRowsAdded) {
+            break;
+        }
+        this->writeOutputRow(fNextOutput++);
+    }
+}
+
+void SkStreamingResizer::writeOutputRow(int y) {
+    const Contribution& c = fRows[y];
+    const float* w = fRowWeights.data() + c.fWeights;
+    const int dstY = fBottomUp ? fDst.height() - 1 - y : y;
+    uint8_t* dst = static_cast<uint8_t*>(fDst.writable_addr(0, dstY));
+
+    // Alpha is the last byte of both RGBA and BGRA.
+    const int alphaIndex = 3;
+
+    const int width = fDst.width();
+    for (int x = 0; x < width; x++) {
+        float channels[4] = { 0, 0, 0, 0 };
+        for (int i = 0; i < c.fCount; i++) {
+            const float* row = fRing.get() + 4 * width * ((c.fFirst + i) % fRingHeight);
+            for (int k = 0; k < 4; k++) {
+                channels[k] += w[i] * row[4 * x + k];
+            }
+        }
+
+        // Lanczos rings, so channels can over- and undershoot; clamp them, and keep
+        // premultiplied colors no brighter than their alpha.
+        uint8_t out[4];
+        for (int k = 0; k < 4; k++) {
+            out[k] = (uint8_t) SkTPin(sk_float_round2int(channels[k]), 0, 255);
+        }
+        if (fPremul) {
+            for (int k = 0; k < 4; k++) {
+                if (k != alphaIndex) {
+                    out[k] = SkTMin(out[k], out[alphaIndex]);
+                }
+            }
+        }
+        memcpy(dst + 4 * x, out, 4);
+    }
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+#ifndef SkStreamingResizer_DEFINED
+#define SkStreamingResizer_DEFINED
+
+#include "SkAndroidCodec.h"
+#include "SkPixmap.h"
+#include "SkTemplates.h"
+
+#include <vector>
+
+/**
+ *  Resamples a stream of decoded rows to a new size with a separable filter.
+ *
+ *  Each source row is filtered horizontally as it arrives, into a ring just tall enough for
+ *  the vertical filter, and each output row is written as soon as the last source row it
+ *  needs has been added.  Memory use depends on the output width and the filter's footprint
+ *  in the source, never on the source height.
+ */
+class SkStreamingResizer : SkNoncopyable {
+public:
+    using Filter = SkAndroidCodec::ResizeFilter;
+
+    /**
+     *  @param dst       Where output rows are written.  Must be kRGBA_8888 or kBGRA_8888,
+     *                   matching the source rows' layout and alpha type.
+     *  @param bottomUp  If true, source rows are added from the bottom of the image up.
+     */
+    SkStreamingResizer(Filter, int srcWidth, int srcHeight, const SkPixmap& dst, bool bottomUp);
+
+    /**
+     *  Adds the next source row, srcWidth pixels in dst's format.
+     */
+    void addRow(const uint32_t* row);
+
+    /**
+     *  The number of output rows written so far, counted in the order source rows are added.
+     */
+    int rowsWritten() const { return fNextOutput; }
+
+private:
+    struct Contribution {
+        int fFirst;   // first source pixel or row
+        int fCount;
+        int fWeights; // index of the first weight in fWeights
+    };
+
+    static void ComputeContributions(Filter, int srcSize, int dstSize,
+                                     std::vector<Contribution>*, std::vector<float>*);
+
+    void writeOutputRow(int y);
+
+    const SkPixmap            fDst;
+    const bool                fPremul;
+    const bool                fBottomUp;
+
+    std::vector<Contribution> fColumns;
+    std::vector<float>        fColumnWeights;
+    std::vector<Contribution> fRows;
+    std::vector<float>        fRowWeights;
+
+    // Horizontally filtered source rows, 4 floats per output pixel, fRingHeight rows.
+    SkAutoTMalloc<float>      fRing;
+    int                       fRingHeight;
+    int                       fRowsAdded;
+    int                       fNextOutput;
+};
+
+#endif // SkStreamingResizer_DEFINED
@@ -12,10 +12,12 @@
 #include "SkCodecAnimation.h"
 #include "SkCodecAnimationPriv.h"
 #include "SkCodecPriv.h"
+#include "SkConvertPixels.h"
 #include "SkMakeUnique.h"
 #include "SkRasterPipeline.h"
 #include "SkSampler.h"
 #include "SkStreamPriv.h"
+#include "SkTaskGroup.h"
 #include "SkTemplates.h"
 #include "SkTo.h"
 
@@ -375,6 +377,8 @@ SkCodec::Result SkWebpCodec::onGetPixels(const SkImageInfo& dstInfo, void* dst,
         // FIXME: New enum for this?
         return kInvalidInput;
     }
+    // Only lossy frames have work libwebp can spread across threads (the in-loop filter).
+    config.options.use_threads = options.fExecutor ? 1 : 0;
 
     // Free any memory associated with the buffer. Must be called last, so we declare it first.
     SkAutoTCallVProc<WebPDecBuffer, WebPFreeDecBuffer> autoFree(&(config.output));
@@ -483,55 +487,84 @@ SkCodec::Result SkWebpCodec::onGetPixels(const SkImageInfo& dstInfo, void* dst,
         }
     }
 
-    if ((this->colorXform() && !is_8888(dstInfo.colorType())) || blendWithPrevFrame) {
+    const bool premultiply = dstInfo.alphaType() == kPremul_SkAlphaType && !this->colorXform();
+    const WEBP_CSP_MODE mode = webp_decode_mode(webpInfo.colorType(),
+                                                frame.has_alpha && premultiply);
+
+    // A frame decoded ahead of time is only good for a full size decode.
+    const bool fullFrame = !config.options.use_cropping && !config.options.use_scaling;
+    const bool usePrefetched = fullFrame && this->takePrefetchedFrame(index, mode);
+
+    const bool decodeInPlace = !(this->colorXform() && !is_8888(dstInfo.colorType()))
+                               && !blendWithPrevFrame;
+    if (decodeInPlace) {
+        // libwebp can decode directly into the output memory.
+        webpDst.installPixels(webpInfo, dst, rowBytes);
+    } else if (!usePrefetched) {
         // We will decode the entire image and then perform the color transform.  libwebp
         // does not provide a row-by-row API.  This is a shame particularly when we do not want
         // 8888, since we will need to create another image sized buffer.
         webpDst.allocPixels(webpInfo);
-    } else {
-        // libwebp can decode directly into the output memory.
-        webpDst.installPixels(webpInfo, dst, rowBytes);
     }
 
-    config.output.colorspace = webp_decode_mode(webpInfo.colorType(),
-            frame.has_alpha && dstInfo.alphaType() == kPremul_SkAlphaType && !this->colorXform());
-    config.output.is_external_memory = 1;
+    int rowsDecoded = 0;
+    SkCodec::Result result;
+    const uint8_t* decoded;
+    size_t srcRowBytes;
+    if (usePrefetched) {
+        const SkBitmap& src = fPrefetched.fPixels;
+        SkASSERT(src.width() == scaledWidth && src.height() == scaledHeight);
+        if (decodeInPlace) {
+            void* pixels = webpDst.getAddr(dstX, dstY);
+            SkRectMemcpy(pixels, webpDst.rowBytes(), src.getPixels(), src.rowBytes(),
+                         src.info().minRowBytes(), src.height());
+            decoded = static_cast<const uint8_t*>(pixels);
+            srcRowBytes = webpDst.rowBytes();
+        } else {
+            decoded = static_cast<const uint8_t*>(src.getPixels());
+            srcRowBytes = src.rowBytes();
+        }
+        rowsDecoded = scaledHeight;
+        result = kSuccess;
+    } else {
+        config.output.colorspace = mode;
+        config.output.is_external_memory = 1;
 
-    config.output.u.RGBA.rgba = reinterpret_cast<uint8_t*>(webpDst.getAddr(dstX, dstY));
-    config.output.u.RGBA.stride = static_cast<int>(webpDst.rowBytes());
-    config.output.u.RGBA.size = webpDst.computeByteSize();
+        config.output.u.RGBA.rgba = reinterpret_cast<uint8_t*>(webpDst.getAddr(dstX, dstY));
+        config.output.u.RGBA.stride = static_cast<int>(webpDst.rowBytes());
+        config.output.u.RGBA.size = webpDst.computeByteSize();
 
-    SkAutoTCallVProc<WebPIDecoder, WebPIDelete> idec(WebPIDecode(nullptr, 0, &config));
-    if (!idec) {
-        return kInvalidInput;
-    }
+        SkAutoTCallVProc<WebPIDecoder, WebPIDelete> idec(WebPIDecode(nullptr, 0, &config));
+        if (!idec) {
+            return kInvalidInput;
+        }
 
-    int rowsDecoded = 0;
-    SkCodec::Result result;
-    switch (WebPIUpdate(idec, frame.fragment.bytes, frame.fragment.size)) {
-        case VP8_STATUS_OK:
-            rowsDecoded = scaledHeight;
-            result = kSuccess;
-            break;
-        case VP8_STATUS_SUSPENDED:
-            if (!WebPIDecGetRGB(idec, &rowsDecoded, nullptr, nullptr, nullptr)
-                    || rowsDecoded <= 0) {
+        switch (WebPIUpdate(idec, frame.fragment.bytes, frame.fragment.size)) {
+            case VP8_STATUS_OK:
+                rowsDecoded = scaledHeight;
+                result = kSuccess;
+                break;
+            case VP8_STATUS_SUSPENDED:
+                if (!WebPIDecGetRGB(idec, &rowsDecoded, nullptr, nullptr, nullptr)
+                        || rowsDecoded <= 0) {
+                    return kInvalidInput;
+                }
+                *rowsDecodedPtr = rowsDecoded + dstY;
+                result = kIncompleteInput;
+                break;
+            default:
                 return kInvalidInput;
-            }
-            *rowsDecodedPtr = rowsDecoded + dstY;
-            result = kIncompleteInput;
-            break;
-        default:
-            return kInvalidInput;
+        }
+        decoded = config.output.u.RGBA.rgba;
+        srcRowBytes = config.output.u.RGBA.stride;
     }
 
     const size_t dstBpp = dstInfo.bytesPerPixel();
     dst = SkTAddOffset<void>(dst, dstBpp * dstX + rowBytes * dstY);
-    const size_t srcRowBytes = config.output.u.RGBA.stride;
 
     const auto dstCT = dstInfo.colorType();
     if (this->colorXform()) {
-        uint32_t* xformSrc = (uint32_t*) config.output.u.RGBA.rgba;
+        const uint32_t* xformSrc = reinterpret_cast<const uint32_t*>(decoded);
         SkBitmap tmp;
         void* xformDst;
 
@@ -552,22 +585,80 @@ SkCodec::Result SkWebpCodec::onGetPixels(const SkImageInfo& dstInfo, void* dst,
             } else {
                 xformDst = SkTAddOffset<void>(xformDst, rowBytes);
             }
-            xformSrc = SkTAddOffset<uint32_t>(xformSrc, srcRowBytes);
+            xformSrc = SkTAddOffset<const uint32_t>(xformSrc, srcRowBytes);
         }
     } else if (blendWithPrevFrame) {
-        const uint8_t* src = config.output.u.RGBA.rgba;
+        const uint8_t* src = decoded;
 
         for (int y = 0; y < rowsDecoded; y++) {
-            blend_line(dstCT, dst, webpDst.colorType(), src,
+            blend_line(dstCT, dst, webpInfo.colorType(), src,
                     dstInfo.alphaType(), frame.has_alpha, scaledWidth);
             src = SkTAddOffset<const uint8_t>(src, srcRowBytes);
             dst = SkTAddOffset<void>(dst, rowBytes);
         }
     }
 
+    // Players ask for the frames in order, so start on the next one while the caller is
+    // busy with this one.
+    if (options.fExecutor && fullFrame && kSuccess == result && index + 1 < fFrameHolder.size()) {
+        this->prefetchFrame(index + 1, webpInfo.colorType(), premultiply, options.fExecutor);
+    }
+
     return result;
 }
 
+bool SkWebpCodec::takePrefetchedFrame(int index, int mode) {
+    if (!fPrefetchTasks) {
+        return false;
+    }
+    fPrefetchTasks->wait();
+    return fPrefetched.fSuccess && fPrefetched.fIndex == index && fPrefetched.fMode == mode;
+}
+
+void SkWebpCodec::prefetchFrame(int index, SkColorType colorType, bool premultiply,
+                                SkExecutor* executor) {
+    WebPIterator frame;
+    SkAutoTCallVProc<WebPIterator, WebPDemuxReleaseIterator> autoFrame(&frame);
+    if (!WebPDemuxGetFrame(fDemux, index + 1, &frame)) {
+        return;
+    }
+
+    if (fPrefetchExecutor != executor) {
+        fPrefetchTasks = skstd::make_unique<SkTaskGroup>(*executor);
+        fPrefetchExecutor = executor;
+    }
+    fPrefetchTasks->wait();
+
+    // Only the compositing depends on earlier frames, so any frame's own pixels can be
+    // decoded without them.
+    fPrefetched.fIndex = index;
+    fPrefetched.fMode = webp_decode_mode(colorType, frame.has_alpha && premultiply);
+    fPrefetched.fSuccess = false;
+    if (!fPrefetched.fPixels.tryAllocPixels(SkImageInfo::Make(frame.width, frame.height,
+                                                              colorType, kPremul_SkAlphaType))) {
+        return;
+    }
+
+    // The fragment points into fData, which outlives the task.
+    const uint8_t* bytes = frame.fragment.bytes;
+    const size_t size = frame.fragment.size;
+    PrefetchedFrame* prefetched = &fPrefetched;
+    fPrefetchTasks->add([prefetched, bytes, size] {
+        WebPDecoderConfig config;
+        if (0 == WebPInitDecoderConfig(&config)) {
+            return;
+        }
+        SkAutoTCallVProc<WebPDecBuffer, WebPFreeDecBuffer> autoFree(&(config.output));
+        config.options.use_threads = 1;
+        config.output.colorspace = static_cast<WEBP_CSP_MODE>(prefetched->fMode);
+        config.output.is_external_memory = 1;
+        config.output.u.RGBA.rgba = static_cast<uint8_t*>(prefetched->fPixels.getPixels());
+        config.output.u.RGBA.stride = static_cast<int>(prefetched->fPixels.rowBytes());
+        config.output.u.RGBA.size = prefetched->fPixels.computeByteSize();
+        prefetched->fSuccess = VP8_STATUS_OK == WebPDecode(bytes, size, &config);
+    });
+}
+
 SkWebpCodec::SkWebpCodec(SkEncodedInfo&& info, std::unique_ptr<SkStream> stream,
                          WebPDemuxer* demux, sk_sp<SkData> data, SkEncodedOrigin origin)
     : INHERITED(std::move(info), skcms_PixelFormat_BGRA_8888, std::move(stream),
@@ -575,7 +666,13 @@ SkWebpCodec::SkWebpCodec(SkEncodedInfo&& info, std::unique_ptr<SkStream> stream,
     , fDemux(demux)
     , fData(std::move(data))
     , fFailed(false)
+    , fPrefetchExecutor(nullptr)
 {
     const auto& eInfo = this->getEncodedInfo();
     fFrameHolder.setScreenSize(eInfo.width(), eInfo.height());
 }
+
+SkWebpCodec::~SkWebpCodec() {
+    // A frame may still be decoding into fPrefetched.
+    fPrefetchTasks.reset();
+}
@@ -8,6 +8,7 @@
 #ifndef SkWebpCodec_DEFINED
 #define SkWebpCodec_DEFINED
 
+#include "SkBitmap.h"
 #include "SkCodec.h"
 #include "SkEncodedImageFormat.h"
 #include "SkFrameHolder.h"
@@ -16,7 +17,9 @@
 
 #include <vector>
 
+class SkExecutor;
 class SkStream;
+class SkTaskGroup;
 extern "C" {
     struct WebPDemuxer;
     void WebPDemuxDelete(WebPDemuxer* dmux);
@@ -27,6 +30,8 @@ public:
     // Assumes IsWebp was called and returned true.
     static std::unique_ptr<SkCodec> MakeFromStream(std::unique_ptr<SkStream>, Result*);
     static bool IsWebp(const void*, size_t);
+
+    ~SkWebpCodec() override;
 protected:
     Result onGetPixels(const SkImageInfo&, void*, size_t, const Options&, int*) override;
     SkEncodedImageFormat onGetEncodedFormat() const override { return SkEncodedImageFormat::kWEBP; }
@@ -49,6 +54,12 @@ private:
     SkWebpCodec(SkEncodedInfo&&, std::unique_ptr<SkStream>, WebPDemuxer*, sk_sp<SkData>,
                 SkEncodedOrigin);
 
+    // Waits for any frame being decoded ahead, and returns true if it is frame index,
+    // decoded with mode, and ready in fPrefetched.
+    bool takePrefetchedFrame(int index, int mode);
+    // Starts decoding frame index, unscaled and unblended, into fPrefetched on executor.
+    void prefetchFrame(int index, SkColorType, bool premultiply, SkExecutor*);
+
     SkAutoTCallVProc<WebPDemuxer, WebPDemuxDelete> fDemux;
 
     // fDemux has a pointer into this data.
@@ -102,6 +113,16 @@ private:
     // succeed.
     bool        fFailed;
 
+    struct PrefetchedFrame {
+        int      fIndex   = -1;
+        int      fMode    = 0;      // WEBP_CSP_MODE
+        SkBitmap fPixels;
+        bool     fSuccess = false;
+    };
+    PrefetchedFrame              fPrefetched;
+    SkExecutor*                  fPrefetchExecutor;
+    std::unique_ptr<SkTaskGroup> fPrefetchTasks;
+
     typedef SkCodec INHERITED;
 };
 #endif // SkWebpCodec_DEFINED
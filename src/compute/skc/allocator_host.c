@@ -16,8 +16,13 @@
 //
 //
 
+#if defined(SKC_PLATFORM_VK)
+#include "runtime_vk.h"
+#include "config_vk.h"
+#else
 #include "runtime_cl_12.h"
 #include "config_cl.h"
+#endif
 
 //
 //
@@ -21,12 +21,43 @@
 //
 
 // temporarily
+#if defined(SKC_PLATFORM_VK)
+#include "runtime_vk.h"
+#include "skc_vk.h"
+#else
 #include "runtime_cl_12.h"
+#endif
 
 //
 // CONTEXT
 //
 
+#if defined(SKC_PLATFORM_VK)
+
+skc_err
+skc_context_create_vk(skc_context_t                     * context,
+                      struct skc_vk_target  const * const target,
+                      VkPhysicalDevice                    phys_device,
+                      VkDevice                            device,
+                      VkAllocationCallbacks const *       allocator,
+                      VkPipelineCache                     pipeline_cache,
+                      VkQueue                             queue,
+                      uint32_t                            queue_family_index)
+{
+  (*context) = malloc(sizeof(**context));
+
+  return skc_runtime_vk_create(*context,
+                               target,
+                               phys_device,
+                               device,
+                               allocator,
+                               pipeline_cache,
+                               queue,
+                               queue_family_index);
+}
+
+#else
+
 skc_err
 skc_context_create_cl(skc_context_t * context,
                       cl_context      context_cl,
@@ -45,6 +76,8 @@ skc_context_create_cl(skc_context_t * context,
   return err;
 }
 
+#endif
+
 skc_err
 skc_context_retain(skc_context_t context)
 {
@@ -55,7 +88,11 @@ skc_context_retain(skc_context_t context)
 skc_err
 skc_context_release(skc_context_t context)
 {
+#if defined(SKC_PLATFORM_VK)
+  skc_err err = skc_runtime_vk_dispose(context);
+#else
   skc_err err = skc_runtime_cl_12_dispose(context);
+#endif
 
   free(context);
 
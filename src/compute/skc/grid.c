@@ -18,7 +18,11 @@
 
 #include "grid.h"
 #include "macros.h"
+#if defined(SKC_PLATFORM_VK)
+#include "runtime_vk.h"
+#else
 #include "runtime_cl_12.h"
+#endif
 
 //
 // SKC grid dependencies can be represented with a DAG.
@@ -0,0 +1,178 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can
+ * be found in the LICENSE file.
+ *
+ */
+
+//
+//
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+
+//
+//
+//
+
+#include "runtime_vk.h"
+#include "config_vk.h"
+#include "common/vk/assert_vk.h"
+
+//
+// All SKC buffers are storage buffers that may also be the source or
+// destination of a copy
+//
+
+#define SKC_VK_BUFFER_USAGE  (VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |    \
+                              VK_BUFFER_USAGE_TRANSFER_SRC_BIT   |    \
+                              VK_BUFFER_USAGE_TRANSFER_DST_BIT)
+
+//
+//
+//
+
+static
+uint32_t
+skc_runtime_vk_memory_type_index(struct skc_runtime  * const runtime,
+                                 uint32_t              const type_bits,
+                                 VkMemoryPropertyFlags const props)
+{
+  VkPhysicalDeviceMemoryProperties const * const pdmp = &runtime->vk.pdmp;
+
+  for (uint32_t ii=0; ii<pdmp->memoryTypeCount; ii++)
+    {
+      if ((type_bits & (1u << ii)) == 0)
+        continue;
+
+      if ((pdmp->memoryTypes[ii].propertyFlags & props) == props)
+        return ii;
+    }
+
+  fprintf(stderr,"%s: no memory type with properties 0x%X\n",__func__,props);
+  abort();
+}
+
+//
+// PERM
+//
+
+void
+skc_runtime_device_perm_alloc(struct skc_runtime   * const runtime,
+                              VkMemoryPropertyFlags  const props,
+                              size_t                 const size,
+                              struct skc_buffer_vk * const buffer)
+{
+  VkBufferCreateInfo const bci = {
+    .sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+    .pNext                 = NULL,
+    .flags                 = 0,
+    .size                  = size,
+    .usage                 = SKC_VK_BUFFER_USAGE,
+    .sharingMode           = VK_SHARING_MODE_EXCLUSIVE,
+    .queueFamilyIndexCount = 0,
+    .pQueueFamilyIndices   = NULL
+  };
+
+  vk(CreateBuffer(runtime->vk.device,&bci,runtime->vk.allocator,&buffer->buffer));
+
+  VkMemoryRequirements mr;
+
+  vkGetBufferMemoryRequirements(runtime->vk.device,buffer->buffer,&mr);
+
+  VkMemoryAllocateInfo const mai = {
+    .sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+    .pNext           = NULL,
+    .allocationSize  = mr.size,
+    .memoryTypeIndex = skc_runtime_vk_memory_type_index(runtime,mr.memoryTypeBits,props)
+  };
+
+  vk(AllocateMemory(runtime->vk.device,&mai,runtime->vk.allocator,&buffer->mem));
+
+  vk(BindBufferMemory(runtime->vk.device,buffer->buffer,buffer->mem,0));
+
+  buffer->size = size;
+}
+
+void
+skc_runtime_device_perm_free(struct skc_runtime   * const runtime,
+                             struct skc_buffer_vk * const buffer)
+{
+  vkDestroyBuffer(runtime->vk.device,buffer->buffer,runtime->vk.allocator);
+  vkFreeMemory   (runtime->vk.device,buffer->mem,   runtime->vk.allocator);
+}
+
+//
+// TEMP
+//
+
+void
+skc_runtime_device_temp_alloc(struct skc_runtime     * const runtime,
+                              size_t                   const size,
+                              skc_subbuf_id_t        * const subbuf_id,
+                              VkDescriptorBufferInfo * const dbi)
+{
+  dbi->buffer = runtime->allocator.device.temp.extent.buffer;
+
+  if (size == 0)
+    {
+      *subbuf_id = (skc_subbuf_id_t)-1;
+
+      dbi->offset = 0;
+      dbi->range  = 0;
+
+      return;
+    }
+
+  size_t subbuf_size;
+
+  dbi->offset = skc_suballocator_subbuf_alloc(&runtime->allocator.device.temp.suballocator,
+                                              runtime->scheduler,
+                                              size,subbuf_id,&subbuf_size);
+  dbi->range  = subbuf_size;
+}
+
+void
+skc_runtime_device_temp_free(struct skc_runtime           * const runtime,
+                             VkDescriptorBufferInfo const * const dbi,
+                             skc_subbuf_id_t                const subbuf_id)
+{
+  if (dbi->range == 0)
+    return;
+
+  skc_suballocator_subbuf_free(&runtime->allocator.device.temp.suballocator,subbuf_id);
+}
+
+//
+//
+//
+
+void
+skc_allocator_device_create(struct skc_runtime * const runtime)
+{
+  skc_suballocator_create(runtime,
+                          &runtime->allocator.device.temp.suballocator,
+                          "DEVICE",
+                          runtime->config->suballocator.device.subbufs,
+                          runtime->vk.align_bytes,
+                          runtime->config->suballocator.device.size);
+
+  skc_runtime_device_perm_alloc(runtime,
+                                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                runtime->config->suballocator.device.size,
+                                &runtime->allocator.device.temp.extent);
+}
+
+void
+skc_allocator_device_dispose(struct skc_runtime * const runtime)
+{
+  skc_suballocator_dispose(runtime,&runtime->allocator.device.temp.suballocator);
+
+  skc_runtime_device_perm_free(runtime,&runtime->allocator.device.temp.extent);
+}
+
+//
+//
+//
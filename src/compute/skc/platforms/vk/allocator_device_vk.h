@@ -0,0 +1,71 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can
+ * be found in the LICENSE file.
+ *
+ */
+
+#pragma once
+
+//
+//
+//
+
+#include <vulkan/vulkan.h>
+
+//
+//
+//
+
+#include "suballocator.h"
+
+//
+//
+//
+
+struct skc_runtime;
+
+//
+// A buffer bound to its own dedicated allocation
+//
+
+struct skc_buffer_vk
+{
+  VkBuffer       buffer;
+  VkDeviceMemory mem;
+  VkDeviceSize   size;
+};
+
+//
+// Temporary device allocations are ranges of one large buffer so
+// they're described by a VkDescriptorBufferInfo instead of a
+// CL-style sub-buffer object
+//
+
+struct skc_allocator_device
+{
+#if 0
+  struct {
+  } perm;
+#endif
+
+  struct {
+    struct skc_suballocator suballocator;
+    struct skc_buffer_vk    extent;
+  } temp;
+};
+
+//
+//
+//
+
+void
+skc_allocator_device_create(struct skc_runtime * const runtime);
+
+void
+skc_allocator_device_dispose(struct skc_runtime * const runtime);
+
+//
+//
+//
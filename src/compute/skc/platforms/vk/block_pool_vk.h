@@ -0,0 +1,32 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can
+ * be found in the LICENSE file.
+ *
+ */
+
+#pragma once
+
+//
+//
+//
+
+#include "../cl_12/block_pool_cl.h" // platform-neutral block pool types
+#include "allocator_device_vk.h"
+
+//
+// device side block pool
+//
+
+struct skc_block_pool
+{
+  union  skc_block_pool_size const * size;
+  struct skc_buffer_vk               blocks;
+  struct skc_buffer_vk               ids;
+  struct skc_buffer_vk               atomics;
+};
+
+//
+//
+//
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can
+ * be found in the LICENSE file.
+ *
+ */
+
+#pragma once
+
+//
+//
+//
+
+#include "../cl_12/block_pool_cl.h" // platform-neutral block pool types
+
+//
+// A subset of the CL 1.2 configuration -- the remaining knobs will
+// return with the pipeline stages that use them
+//
+
+struct skc_config
+{
+  struct {
+    struct {
+      skc_uint               size;
+      skc_uint               subbufs;
+    } host;   // alignment determined by compiler
+    struct {
+      skc_uint               size;
+      skc_uint               subbufs;
+    } device; // alignment determined by device
+  } suballocator;
+
+  struct {
+    skc_uint                 size;
+  } scheduler;
+
+  struct {
+    skc_uint                 bytes;    // bytes per subblock -- pow2
+    skc_uint                 words;    // words per subblock -- pow2
+  } subblock;
+
+  struct {
+    skc_uint                 bytes;     // bytes per block     -- pow2
+    skc_uint                 words;     // words per block     -- pow2
+    skc_uint                 subblocks; // subblocks per block -- block.bytes >= subblock.bytes
+  } block;
+
+  union skc_block_pool_size  block_pool;
+
+  struct {
+    skc_uint                 size;      // max in-flight queue submissions
+  } fence_pool;
+
+  struct {
+    skc_uint                 width;     // tile width  in pixels
+    skc_uint                 height;    // tile height in pixels
+    skc_uint                 ratio;     // subblocks per TTPB
+  } tile;
+
+  struct {
+    struct {
+      skc_uint               workgroup_size; // must match the kernel's local_size_x
+    } block_pool_init_ids;
+  } kernels;
+};
+
+//
+//
+//
@@ -0,0 +1,227 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can
+ * be found in the LICENSE file.
+ *
+ */
+
+//
+// Like the scheduler, this is C++11 for its threads and condvars
+//
+
+extern "C" {
+
+#include "fence_pool_vk.h"
+#include "runtime_vk.h"
+#include "common/vk/assert_vk.h"
+
+}
+
+//
+//
+//
+
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+//
+//
+//
+
+struct skc_fence_pool_submission
+{
+  VkFence                     fence;
+  skc_scheduler_command_pfn   pfn;
+  void                      * data;
+  char const                * name;
+};
+
+//
+// Submissions are completed in order so a ring of in-flight fences
+// is all we need.  Signaled fences are reset by the waiter and go
+// back to the end of the ring.
+//
+
+struct skc_fence_pool
+{
+  struct skc_runtime               * runtime;
+
+  struct skc_fence_pool_submission * ring;
+  skc_uint                           size;
+  skc_uint                           head;  // oldest in-flight submission
+  skc_uint                           count; // in-flight submissions
+
+  std::mutex                         mutex;
+  std::condition_variable            submitted;
+  std::condition_variable            completed;
+
+  bool                               disposing;
+
+  std::thread                        waiter;
+};
+
+//
+//
+//
+
+static
+void
+skc_fence_pool_noop(void * data)
+{
+  ;
+}
+
+//
+//
+//
+
+static
+void
+skc_fence_pool_wait_loop(struct skc_fence_pool * const fence_pool)
+{
+  struct skc_runtime * const runtime = fence_pool->runtime;
+
+  while (true)
+    {
+      struct skc_fence_pool_submission submission;
+
+      {
+        std::unique_lock<std::mutex> lock(fence_pool->mutex);
+
+        fence_pool->submitted.wait(lock,[fence_pool] {
+            return fence_pool->count > 0 || fence_pool->disposing;
+          });
+
+        if (fence_pool->count == 0)
+          return;
+
+        submission = fence_pool->ring[fence_pool->head];
+      }
+
+      vk(WaitForFences(runtime->vk.device,1,&submission.fence,VK_TRUE,UINT64_MAX));
+      vk(ResetFences(runtime->vk.device,1,&submission.fence));
+
+      {
+        std::lock_guard<std::mutex> lock(fence_pool->mutex);
+
+        fence_pool->head   = (fence_pool->head + 1) % fence_pool->size;
+        fence_pool->count -= 1;
+      }
+
+      fence_pool->completed.notify_one();
+
+      //
+      // every submission schedules something so that a thread
+      // blocked in skc_scheduler_wait() wakes up and rechecks its
+      // predicate
+      //
+      if (submission.pfn != NULL)
+        skc_scheduler_schedule(runtime->scheduler,submission.pfn,submission.data,submission.name);
+      else
+        SKC_SCHEDULER_SCHEDULE(runtime->scheduler,skc_fence_pool_noop,NULL);
+    }
+}
+
+
+//
+//
+//
+
+struct skc_fence_pool *
+skc_fence_pool_create(struct skc_runtime * const runtime, skc_uint const size)
+{
+  struct skc_fence_pool * const fence_pool = new skc_fence_pool;
+
+  fence_pool->runtime   = runtime;
+  fence_pool->ring      = new skc_fence_pool_submission[size];
+  fence_pool->size      = size;
+  fence_pool->head      = 0;
+  fence_pool->count     = 0;
+  fence_pool->disposing = false;
+
+  // no designated initializers in C++11
+  VkFenceCreateInfo fci = {};
+
+  fci.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+  for (skc_uint ii=0; ii<size; ii++)
+    vk(CreateFence(runtime->vk.device,&fci,runtime->vk.allocator,&fence_pool->ring[ii].fence));
+
+  fence_pool->waiter = std::thread(skc_fence_pool_wait_loop,fence_pool);
+
+  return fence_pool;
+}
+
+void
+skc_fence_pool_dispose(struct skc_runtime    * const runtime,
+                       struct skc_fence_pool * const fence_pool)
+{
+  {
+    std::lock_guard<std::mutex> lock(fence_pool->mutex);
+
+    fence_pool->disposing = true;
+  }
+
+  // the waiter drains the in-flight submissions before exiting
+  fence_pool->submitted.notify_one();
+  fence_pool->waiter.join();
+
+  for (skc_uint ii=0; ii<fence_pool->size; ii++)
+    vkDestroyFence(runtime->vk.device,fence_pool->ring[ii].fence,runtime->vk.allocator);
+
+  delete[] fence_pool->ring;
+  delete   fence_pool;
+}
+
+//
+// There is only one submitting thread so the tail slot can be filled
+// outside of the lock
+//
+
+void
+skc_fence_pool_submit(struct skc_runtime        * const runtime,
+                      VkCommandBuffer                   cb,
+                      skc_scheduler_command_pfn const pfn,
+                      void                      *       data,
+                      char                const * const name)
+{
+  struct skc_fence_pool * const fence_pool = runtime->fence_pool;
+
+  struct skc_fence_pool_submission * submission;
+
+  {
+    std::unique_lock<std::mutex> lock(fence_pool->mutex);
+
+    fence_pool->completed.wait(lock,[fence_pool] {
+        return fence_pool->count < fence_pool->size;
+      });
+
+    submission = fence_pool->ring + (fence_pool->head + fence_pool->count) % fence_pool->size;
+  }
+
+  submission->pfn  = pfn;
+  submission->data = data;
+  submission->name = name;
+
+  VkSubmitInfo si = {};
+
+  si.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+  si.commandBufferCount = 1;
+  si.pCommandBuffers    = &cb;
+
+  vk(QueueSubmit(runtime->vk.queue,1,&si,submission->fence));
+
+  {
+    std::lock_guard<std::mutex> lock(fence_pool->mutex);
+
+    fence_pool->count += 1;
+  }
+
+  fence_pool->submitted.notify_one();
+}
+
+//
+//
+//
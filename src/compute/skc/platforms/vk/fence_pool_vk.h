@@ -0,0 +1,69 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can
+ * be found in the LICENSE file.
+ *
+ */
+
+#pragma once
+
+//
+//
+//
+
+#include <vulkan/vulkan.h>
+
+//
+//
+//
+
+#include "scheduler.h"
+
+//
+//
+//
+
+struct skc_runtime;
+
+//
+// The CL platform learns of completed work through event callbacks
+// that the driver invokes on its own thread and which schedule the
+// pipeline's next stage.  Vulkan has no callbacks so the fence pool
+// waits on in-flight submissions from a thread of its own and
+// schedules each submission's completion command in the order it was
+// submitted.  This keeps skc_scheduler_wait() from sleeping forever.
+//
+
+struct skc_fence_pool;
+
+//
+//
+//
+
+struct skc_fence_pool *
+skc_fence_pool_create(struct skc_runtime * const runtime, skc_uint const size);
+
+void
+skc_fence_pool_dispose(struct skc_runtime    * const runtime,
+                       struct skc_fence_pool * const fence_pool);
+
+//
+// Submits the command buffer to the runtime's queue and schedules
+// 'pfn(data)' once it completes.  Blocks if all fences are in flight.
+//
+// The 'pfn' may be NULL.
+//
+
+#define SKC_FENCE_POOL_SUBMIT(r,cb,c,d) skc_fence_pool_submit(r,cb,c,d,#c)
+
+void
+skc_fence_pool_submit(struct skc_runtime        * const runtime,
+                      VkCommandBuffer                   cb,
+                      skc_scheduler_command_pfn const pfn,
+                      void                      *       data,
+                      char                const * const name);
+
+//
+//
+//
@@ -0,0 +1,36 @@
+//
+// Copyright 2019 Google Inc.
+//
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file.
+//
+
+#ifndef SKC_ONCE_BLOCK_POOL_INIT
+#define SKC_ONCE_BLOCK_POOL_INIT
+
+//
+// Must match skc_block_pool_init_push and the "block_pool" layout in
+// runtime_vk.c
+//
+
+layout(set = 0, binding = 0) writeonly buffer block_pool_ids
+{
+  uint ids[];
+};
+
+layout(set = 0, binding = 1) writeonly buffer block_pool_atomics
+{
+  uint atomics[];
+};
+
+layout(push_constant) uniform block_pool_init_push
+{
+  uint bp_size;
+  uint subblocks_per_block;
+};
+
+#endif
+
+//
+//
+//
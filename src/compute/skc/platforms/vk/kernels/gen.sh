@@ -0,0 +1,67 @@
+#!/bin/bash
+
+##
+## Copyright 2019 Google Inc.
+##
+## Use of this source code is governed by a BSD-style license that can
+## be found in the LICENSE file.
+##
+
+##
+## exit on error
+##
+
+set -e
+
+##
+## Compiles the kernels in skc_vk_kernel_id order and packs them like
+## HotSort's Vulkan targets: each SPIR-V binary is preceded by its
+## big-endian length.
+##
+## The packed modules are written to "skc_vk_modules.xxd" and can be
+## included by a target definition:
+##
+##   struct skc_vk_target const target = {
+##     .config  = { ... },
+##     .modules = {
+##   #include "skc_vk_modules.xxd"
+##     }
+##   };
+##
+## Pass extra defines for the target device on the command line, e.g.
+##
+##   ./gen.sh -DSKC_BP_INIT_IDS_WORKGROUP_SIZE=256
+##
+
+KERNELS="block_pool_init_ids block_pool_init_atomics"
+
+whereis glslangValidator
+
+rm -f skc_vk_modules.bin
+
+for k in $KERNELS
+do
+    glslangValidator --target-env vulkan1.1 "$@" -o $k.spv $k.comp
+    spirv-opt -O $k.spv -o $k.spv
+    len=$(wc -c < $k.spv)
+    echo $k.spv $len
+    printf "%.8x" $len | xxd -r -p >> skc_vk_modules.bin
+    cat $k.spv >> skc_vk_modules.bin
+done
+
+##
+## the modules are an array of uint32_t -- convert from bytes to
+## little-endian words so the big-endian lengths survive
+##
+
+xxd -i < skc_vk_modules.bin | sed 's/, */,/g' | tr -d '\n ' | tr ',' '\n' | \
+    paste -d ' ' - - - - | \
+    awk '{ printf "  0x%s%s%s%s,\n", substr($4,3), substr($3,3), substr($2,3), substr($1,3) }' \
+    > skc_vk_modules.xxd
+
+##
+## delete temporary files
+##
+
+rm *.spv
+rm skc_vk_modules.bin
@@ -0,0 +1,598 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can
+ * be found in the LICENSE file.
+ *
+ */
+
+//
+//
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//
+//
+//
+
+#include "context.h"
+#include "grid.h"
+#include "scheduler.h"
+#include "common/macros.h"
+#include "common/vk/assert_vk.h"
+#include "config_vk.h"
+#include "runtime_vk.h"
+#include "skc_vk.h"
+#include "skc_vk_target.h"
+
+//
+// The block pool initialization kernels share a layout:
+//
+//   binding 0 : ids[]
+//   binding 1 : atomics[]
+//
+// and both take the same push constants
+//
+
+struct skc_block_pool_init_push
+{
+  skc_uint bp_size;
+  skc_uint subblocks_per_block;
+};
+
+//
+//
+//
+
+static
+void
+skc_pipelines_create(struct skc_runtime * const runtime)
+{
+  VkDevice                      const device    = runtime->vk.device;
+  VkAllocationCallbacks const * const allocator = runtime->vk.allocator;
+
+  //
+  // descriptor set and pipeline layouts
+  //
+  static VkDescriptorSetLayoutBinding const dslb_block_pool[] = {
+    {
+      .binding            = 0, // ids
+      .descriptorType     = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+      .descriptorCount    = 1,
+      .stageFlags         = VK_SHADER_STAGE_COMPUTE_BIT,
+      .pImmutableSamplers = NULL
+    },
+    {
+      .binding            = 1, // atomics
+      .descriptorType     = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+      .descriptorCount    = 1,
+      .stageFlags         = VK_SHADER_STAGE_COMPUTE_BIT,
+      .pImmutableSamplers = NULL
+    }
+  };
+
+  static VkDescriptorSetLayoutCreateInfo const dscli = {
+    .sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+    .pNext        = NULL,
+    .flags        = 0,
+    .bindingCount = ARRAY_LENGTH_MACRO(dslb_block_pool),
+    .pBindings    = dslb_block_pool
+  };
+
+  vk(CreateDescriptorSetLayout(device,
+                               &dscli,
+                               allocator,
+                               &runtime->pipelines.ds_layout.block_pool));
+
+  static VkPushConstantRange const pcr_block_pool = {
+    .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+    .offset     = 0,
+    .size       = sizeof(struct skc_block_pool_init_push)
+  };
+
+  VkPipelineLayoutCreateInfo const plci = {
+    .sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+    .pNext                  = NULL,
+    .flags                  = 0,
+    .setLayoutCount         = 1,
+    .pSetLayouts            = &runtime->pipelines.ds_layout.block_pool,
+    .pushConstantRangeCount = 1,
+    .pPushConstantRanges    = &pcr_block_pool
+  };
+
+  vk(CreatePipelineLayout(device,
+                          &plci,
+                          allocator,
+                          &runtime->pipelines.layout.block_pool));
+
+  //
+  // create a shader module, use it to create a pipeline... and
+  // dispose of the shader module
+  //
+  runtime->pipelines.all = malloc(sizeof(*runtime->pipelines.all) * SKC_VK_KERNEL_ID_COUNT);
+
+  VkComputePipelineCreateInfo cpci = {
+    .sType                 = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+    .pNext                 = NULL,
+    .flags                 = 0,
+    .stage = {
+      .sType               = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+      .pNext               = NULL,
+      .flags               = 0,
+      .stage               = VK_SHADER_STAGE_COMPUTE_BIT,
+      .module              = VK_NULL_HANDLE,
+      .pName               = "main",
+      .pSpecializationInfo = NULL
+    },
+    .layout                = runtime->pipelines.layout.block_pool,
+    .basePipelineHandle    = VK_NULL_HANDLE,
+    .basePipelineIndex     = 0
+  };
+
+  VkShaderModuleCreateInfo smci = {
+    .sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+    .pNext    = NULL,
+    .flags    = 0,
+    .codeSize = 0,
+    .pCode    = runtime->target->modules
+  };
+
+  for (uint32_t ii=0; ii<SKC_VK_KERNEL_ID_COUNT; ii++)
+    {
+      // convert bytes to words
+      uint32_t const * const module = smci.pCode + smci.codeSize / sizeof(*module);
+
+      smci.codeSize = NTOHL_MACRO(module[0]);
+      smci.pCode    = module + 1;
+
+      vk(CreateShaderModule(device,
+                            &smci,
+                            allocator,
+                            &cpci.stage.module));
+
+      vk(CreateComputePipelines(device,
+                                runtime->vk.pipeline_cache,
+                                1,
+                                &cpci,
+                                allocator,
+                                runtime->pipelines.all+ii));
+
+      vkDestroyShaderModule(device,
+                            cpci.stage.module,
+                            allocator);
+    }
+}
+
+static
+void
+skc_pipelines_dispose(struct skc_runtime * const runtime)
+{
+  VkDevice                      const device    = runtime->vk.device;
+  VkAllocationCallbacks const * const allocator = runtime->vk.allocator;
+
+  for (uint32_t ii=0; ii<SKC_VK_KERNEL_ID_COUNT; ii++)
+    vkDestroyPipeline(device,runtime->pipelines.all[ii],allocator);
+
+  free(runtime->pipelines.all);
+
+  vkDestroyPipelineLayout     (device,runtime->pipelines.layout.block_pool,   allocator);
+  vkDestroyDescriptorSetLayout(device,runtime->pipelines.ds_layout.block_pool,allocator);
+}
+
+//
+//
+//
+
+static
+void
+skc_pools_create(struct skc_runtime * const runtime)
+{
+  VkCommandPoolCreateInfo const cpci = {
+    .sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+    .pNext            = NULL,
+    .flags            = (VK_COMMAND_POOL_CREATE_TRANSIENT_BIT |
+                         VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT),
+    .queueFamilyIndex = runtime->vk.queue_family_index
+  };
+
+  vk(CreateCommandPool(runtime->vk.device,
+                       &cpci,
+                       runtime->vk.allocator,
+                       &runtime->vk.command_pool));
+
+  //
+  // FIXME -- size this for the raster and composition stages once
+  // they're ported
+  //
+  static VkDescriptorPoolSize const dps[] = {
+    {
+      .type            = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+      .descriptorCount = 2
+    }
+  };
+
+  static VkDescriptorPoolCreateInfo const dpci = {
+    .sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+    .pNext         = NULL,
+    .flags         = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT,
+    .maxSets       = 1,
+    .poolSizeCount = ARRAY_LENGTH_MACRO(dps),
+    .pPoolSizes    = dps
+  };
+
+  vk(CreateDescriptorPool(runtime->vk.device,
+                          &dpci,
+                          runtime->vk.allocator,
+                          &runtime->vk.descriptor_pool));
+}
+
+static
+void
+skc_pools_dispose(struct skc_runtime * const runtime)
+{
+  vkDestroyDescriptorPool(runtime->vk.device,runtime->vk.descriptor_pool,runtime->vk.allocator);
+  vkDestroyCommandPool   (runtime->vk.device,runtime->vk.command_pool,   runtime->vk.allocator);
+}
+
+//
+//
+//
+
+static
+void
+skc_block_pool_init_complete(void * data)
+{
+  *(bool *)data = true;
+}
+
+static
+void
+skc_block_pool_create(struct skc_runtime * const runtime)
+{
+  // save size
+  runtime->block_pool.size = &runtime->config->block_pool;
+
+  // create block extent
+  skc_runtime_device_perm_alloc(runtime,
+                                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                runtime->block_pool.size->pool_size *
+                                runtime->config->block.bytes,
+                                &runtime->block_pool.blocks);
+
+  // allocate block pool ids
+  skc_runtime_device_perm_alloc(runtime,
+                                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                runtime->block_pool.size->ring_pow2 * sizeof(skc_uint),
+                                &runtime->block_pool.ids);
+
+  // allocate block pool atomics
+  skc_runtime_device_perm_alloc(runtime,
+                                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                sizeof(union skc_block_pool_atomic),
+                                &runtime->block_pool.atomics);
+
+  //
+  // describe the ids and atomics
+  //
+  VkDescriptorSetAllocateInfo const dsai = {
+    .sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+    .pNext              = NULL,
+    .descriptorPool     = runtime->vk.descriptor_pool,
+    .descriptorSetCount = 1,
+    .pSetLayouts        = &runtime->pipelines.ds_layout.block_pool
+  };
+
+  VkDescriptorSet ds;
+
+  vk(AllocateDescriptorSets(runtime->vk.device,&dsai,&ds));
+
+  VkDescriptorBufferInfo const dbi[] = {
+    { .buffer = runtime->block_pool.ids.buffer,     .offset = 0, .range = VK_WHOLE_SIZE },
+    { .buffer = runtime->block_pool.atomics.buffer, .offset = 0, .range = VK_WHOLE_SIZE }
+  };
+
+  VkWriteDescriptorSet const wds = {
+    .sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+    .pNext            = NULL,
+    .dstSet           = ds,
+    .dstBinding       = 0,
+    .dstArrayElement  = 0,
+    .descriptorCount  = ARRAY_LENGTH_MACRO(dbi),
+    .descriptorType   = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+    .pImageInfo       = NULL,
+    .pBufferInfo      = dbi,
+    .pTexelBufferView = NULL
+  };
+
+  vkUpdateDescriptorSets(runtime->vk.device,1,&wds,0,NULL);
+
+  //
+  // record both kernels
+  //
+  VkCommandBufferAllocateInfo const cbai = {
+    .sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+    .pNext              = NULL,
+    .commandPool        = runtime->vk.command_pool,
+    .level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+    .commandBufferCount = 1
+  };
+
+  VkCommandBuffer cb;
+
+  vk(AllocateCommandBuffers(runtime->vk.device,&cbai,&cb));
+
+  VkCommandBufferBeginInfo const cbbi = {
+    .sType            = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+    .pNext            = NULL,
+    .flags            = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+    .pInheritanceInfo = NULL
+  };
+
+  vk(BeginCommandBuffer(cb,&cbbi));
+
+  struct skc_block_pool_init_push const push = {
+    .bp_size             = runtime->block_pool.size->pool_size,
+    .subblocks_per_block = runtime->config->block.subblocks
+  };
+
+  vkCmdBindDescriptorSets(cb,
+                          VK_PIPELINE_BIND_POINT_COMPUTE,
+                          runtime->pipelines.layout.block_pool,
+                          0,1,&ds,
+                          0,NULL);
+
+  vkCmdPushConstants(cb,
+                     runtime->pipelines.layout.block_pool,
+                     VK_SHADER_STAGE_COMPUTE_BIT,
+                     0,sizeof(push),&push);
+
+  // init ids
+  skc_uint const wg_size = runtime->config->kernels.block_pool_init_ids.workgroup_size;
+
+  vkCmdBindPipeline(cb,
+                    VK_PIPELINE_BIND_POINT_COMPUTE,
+                    runtime->pipelines.all[SKC_VK_KERNEL_ID_BLOCK_POOL_INIT_IDS]);
+
+  vkCmdDispatch(cb,(push.bp_size + wg_size - 1) / wg_size,1,1);
+
+  // init atomics -- the kernel is always a single workgroup of 2
+  vkCmdBindPipeline(cb,
+                    VK_PIPELINE_BIND_POINT_COMPUTE,
+                    runtime->pipelines.all[SKC_VK_KERNEL_ID_BLOCK_POOL_INIT_ATOMICS]);
+
+  vkCmdDispatch(cb,1,1,1);
+
+  vk(EndCommandBuffer(cb));
+
+  //
+  // block on pool creation
+  //
+  bool complete = false;
+
+  SKC_FENCE_POOL_SUBMIT(runtime,cb,skc_block_pool_init_complete,&complete);
+
+  SKC_SCHEDULER_WAIT_WHILE(runtime->scheduler,!complete);
+
+  vkFreeCommandBuffers(runtime->vk.device,runtime->vk.command_pool,1,&cb);
+
+  vk(FreeDescriptorSets(runtime->vk.device,runtime->vk.descriptor_pool,1,&ds));
+}
+
+static
+void
+skc_block_pool_dispose(struct skc_runtime * const runtime)
+{
+  skc_runtime_device_perm_free(runtime,&runtime->block_pool.atomics);
+  skc_runtime_device_perm_free(runtime,&runtime->block_pool.ids);
+  skc_runtime_device_perm_free(runtime,&runtime->block_pool.blocks);
+}
+
+//
+//
+//
+
+static
+bool
+skc_runtime_yield(struct skc_runtime * const runtime)
+{
+  return skc_scheduler_yield(runtime->scheduler);
+}
+
+static
+void
+skc_runtime_wait(struct skc_runtime * const runtime)
+{
+  skc_scheduler_wait(runtime->scheduler);
+}
+
+//
+// FIXME -- the path, raster, composition, styling and surface stages
+// and the handle pool they depend on haven't been ported from the CL
+// 1.2 platform yet
+//
+
+static
+skc_err
+skc_path_builder_vk_create(struct skc_context * const context,
+                           skc_path_builder_t * const path_builder)
+{
+  return SKC_ERR_NOT_IMPLEMENTED;
+}
+
+static
+skc_err
+skc_raster_builder_vk_create(struct skc_context   * const context,
+                             skc_raster_builder_t * const raster_builder)
+{
+  return SKC_ERR_NOT_IMPLEMENTED;
+}
+
+static
+skc_err
+skc_runtime_path_host_vk(struct skc_runtime * const runtime,
+                         skc_path_t   const *       paths,
+                         uint32_t                   count)
+{
+  return SKC_ERR_NOT_IMPLEMENTED;
+}
+
+static
+skc_err
+skc_runtime_raster_host_vk(struct skc_runtime * const runtime,
+                           skc_raster_t const *       rasters,
+                           uint32_t                   count)
+{
+  return SKC_ERR_NOT_IMPLEMENTED;
+}
+
+static
+skc_err
+skc_composition_vk_create(struct skc_context * const context,
+                          skc_composition_t  * const composition)
+{
+  return SKC_ERR_NOT_IMPLEMENTED;
+}
+
+static
+skc_err
+skc_styling_vk_create(struct skc_context * const context,
+                      skc_styling_t      * const styling,
+                      uint32_t             const layers_count,
+                      uint32_t             const groups_count,
+                      uint32_t             const extras_count)
+{
+  return SKC_ERR_NOT_IMPLEMENTED;
+}
+
+static
+skc_err
+skc_surface_vk_create(struct skc_context * const context,
+                      skc_surface_t      * const surface)
+{
+  return SKC_ERR_NOT_IMPLEMENTED;
+}
+
+//
+//
+//
+
+skc_err
+skc_runtime_vk_create(struct skc_context         * const context,
+                      struct skc_vk_target const * const target,
+                      VkPhysicalDevice                   phys_device,
+                      VkDevice                           device,
+                      VkAllocationCallbacks const *      allocator,
+                      VkPipelineCache                    pipeline_cache,
+                      VkQueue                            queue,
+                      uint32_t                           queue_family_index)
+{
+  // allocate the runtime
+  struct skc_runtime * const runtime = malloc(sizeof(*runtime));
+
+  // save off VK objects
+  runtime->vk.phys_device        = phys_device;
+  runtime->vk.device             = device;
+  runtime->vk.allocator          = allocator;
+  runtime->vk.pipeline_cache     = pipeline_cache;
+  runtime->vk.queue              = queue;
+  runtime->vk.queue_family_index = queue_family_index;
+
+  vkGetPhysicalDeviceMemoryProperties(phys_device,&runtime->vk.pdmp);
+
+  // query device alignment of storage buffer ranges -- always pow2
+  VkPhysicalDeviceProperties pdp;
+
+  vkGetPhysicalDeviceProperties(phys_device,&pdp);
+
+  runtime->vk.align_bytes = (skc_uint)pdp.limits.minStorageBufferOffsetAlignment;
+
+  // the target supplies the kernels and the config
+  runtime->target = target;
+  runtime->config = &target->config;
+
+  // create the host and device allocators
+  skc_allocator_host_create(runtime);
+  skc_allocator_device_create(runtime);
+
+  // how many slots in the scheduler?
+  runtime->scheduler  = skc_scheduler_create(runtime,runtime->config->scheduler.size);
+
+  // allocate deps structure
+  runtime->deps       = skc_grid_deps_create(runtime,
+                                             runtime->scheduler,
+                                             runtime->config->block_pool.pool_size);
+
+  // start waiting on submissions
+  runtime->fence_pool = skc_fence_pool_create(runtime,runtime->config->fence_pool.size);
+
+  // create command and descriptor pools
+  skc_pools_create(runtime);
+
+  // create pipelines
+  skc_pipelines_create(runtime);
+
+  // initialize block pool
+  skc_block_pool_create(runtime);
+
+  //
+  // initialize pfns
+  //
+  context->runtime        = runtime;
+
+  context->yield          = skc_runtime_yield;
+  context->wait           = skc_runtime_wait;
+
+  context->path_builder   = skc_path_builder_vk_create;
+  context->path_retain    = skc_runtime_path_host_vk;
+  context->path_release   = skc_runtime_path_host_vk;
+  context->path_flush     = skc_runtime_path_host_vk;
+
+  context->raster_builder = skc_raster_builder_vk_create;
+  context->raster_retain  = skc_runtime_raster_host_vk;
+  context->raster_release = skc_runtime_raster_host_vk;
+  context->raster_flush   = skc_runtime_raster_host_vk;
+
+  context->composition    = skc_composition_vk_create;
+  context->styling        = skc_styling_vk_create;
+
+  context->surface        = skc_surface_vk_create;
+
+  return SKC_ERR_SUCCESS;
+}
+
+//
+//
+//
+
+skc_err
+skc_runtime_vk_dispose(struct skc_context * const context)
+{
+  struct skc_runtime * const runtime = context->runtime;
+
+  // drains in-flight submissions
+  skc_fence_pool_dispose(runtime,runtime->fence_pool);
+
+  skc_block_pool_dispose(runtime);
+
+  skc_pipelines_dispose(runtime);
+
+  skc_pools_dispose(runtime);
+
+  skc_grid_deps_dispose(runtime->deps);
+
+  skc_scheduler_dispose(runtime,runtime->scheduler);
+
+  skc_allocator_device_dispose(runtime);
+  skc_allocator_host_dispose(runtime);
+
+  free(runtime);
+
+  return SKC_ERR_SUCCESS;
+}
+
+//
+//
+//
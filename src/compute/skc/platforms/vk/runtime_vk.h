@@ -0,0 +1,133 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can
+ * be found in the LICENSE file.
+ *
+ */
+
+#pragma once
+
+//
+//
+//
+
+#include <vulkan/vulkan.h>
+
+//
+//
+//
+
+#include "skc.h"
+#include "runtime.h"
+#include "fence_pool_vk.h"
+#include "block_pool_vk.h"
+#include "allocator_device_vk.h"
+
+//
+// The generic parts of the pipeline (scheduler, grid, suballocators)
+// only touch the allocator, scheduler, deps and config members so
+// they're named as in the CL 1.2 runtime
+//
+
+struct skc_vk_target;
+
+struct skc_runtime
+{
+  //
+  // Vulkan objects -- only the pool, layouts and pipelines are owned
+  //
+  struct {
+    VkPhysicalDevice                 phys_device;
+    VkDevice                         device;
+    VkAllocationCallbacks    const * allocator;
+    VkPipelineCache                  pipeline_cache;
+    VkQueue                          queue;
+    uint32_t                         queue_family_index;
+
+    VkPhysicalDeviceMemoryProperties pdmp;
+    skc_uint                         align_bytes;
+
+    VkCommandPool                    command_pool;
+    VkDescriptorPool                 descriptor_pool;
+  } vk;
+
+  struct {
+    struct {
+      VkDescriptorSetLayout          block_pool;
+    } ds_layout;
+
+    struct {
+      VkPipelineLayout               block_pool;
+    } layout;
+
+    VkPipeline                     * all; // indexed by skc_vk_kernel_id
+  } pipelines;
+
+  struct {
+    struct skc_allocator_host        host;
+    struct skc_allocator_device      device;
+  } allocator;
+
+  struct skc_fence_pool            * fence_pool;
+
+  struct skc_block_pool              block_pool;
+
+  //
+  // state that is slightly opaque (for now)
+  //
+  struct skc_scheduler             * scheduler;
+
+  struct skc_grid_deps             * deps;
+
+  struct skc_config          const * config;
+
+  struct skc_vk_target       const * target;
+};
+
+//
+// Creation and disposal intitializes context and may rely on other
+// context resources like the scheduler
+//
+
+skc_err
+skc_runtime_vk_create(struct skc_context         * const context,
+                      struct skc_vk_target const * const target,
+                      VkPhysicalDevice                   phys_device,
+                      VkDevice                           device,
+                      VkAllocationCallbacks const *      allocator,
+                      VkPipelineCache                    pipeline_cache,
+                      VkQueue                            queue,
+                      uint32_t                           queue_family_index);
+
+skc_err
+skc_runtime_vk_dispose(struct skc_context * const context);
+
+//
+// DEVICE MEMORY ALLOCATION
+//
+
+void
+skc_runtime_device_perm_alloc(struct skc_runtime   * const runtime,
+                              VkMemoryPropertyFlags  const props,
+                              size_t                 const size,
+                              struct skc_buffer_vk * const buffer);
+
+void
+skc_runtime_device_perm_free(struct skc_runtime   * const runtime,
+                             struct skc_buffer_vk * const buffer);
+
+void
+skc_runtime_device_temp_alloc(struct skc_runtime     * const runtime,
+                              size_t                   const size,
+                              skc_subbuf_id_t        * const subbuf_id,
+                              VkDescriptorBufferInfo * const dbi);
+
+void
+skc_runtime_device_temp_free(struct skc_runtime           * const runtime,
+                             VkDescriptorBufferInfo const * const dbi,
+                             skc_subbuf_id_t                const subbuf_id);
+
+//
+//
+//
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can
+ * be found in the LICENSE file.
+ *
+ */
+
+#ifndef SKC_ONCE_SKC_CREATE_VK
+#define SKC_ONCE_SKC_CREATE_VK
+
+//
+//
+//
+
+#include <vulkan/vulkan.h>
+
+//
+//
+//
+
+#include "skc.h"
+
+//
+//
+//
+
+struct skc_vk_target;
+
+//
+// CONTEXT CREATION
+//
+// The context doesn't own any of the Vulkan objects it's handed so
+// they can be shared with another Vulkan client -- e.g. the
+// fPhysicalDevice, fDevice, fQueue and fGraphicsQueueIndex of a
+// GrVkBackendContext.
+//
+// The queue is externally synchronized: SKC submits to it from the
+// thread calling the SKC API so the caller must not submit to the
+// same queue concurrently.
+//
+// The target describes the device's kernels and configuration and is
+// generated per device family by "kernels/gen.sh".
+//
+
+skc_err
+skc_context_create_vk(skc_context_t                     * context,
+                      struct skc_vk_target  const * const target,
+                      VkPhysicalDevice                    phys_device,
+                      VkDevice                            device,
+                      VkAllocationCallbacks const *       allocator,
+                      VkPipelineCache                     pipeline_cache,
+                      VkQueue                             queue,
+                      uint32_t                            queue_family_index);
+
+//
+//
+//
+
+#endif
+
+//
+//
+//
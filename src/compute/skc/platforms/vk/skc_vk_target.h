@@ -0,0 +1,52 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can
+ * be found in the LICENSE file.
+ *
+ */
+
+#pragma once
+
+//
+//
+//
+
+#include <stdint.h>
+
+//
+//
+//
+
+#include "config_vk.h"
+
+//
+// The kernels are packed into the target in this order
+//
+
+typedef enum skc_vk_kernel_id {
+
+  SKC_VK_KERNEL_ID_BLOCK_POOL_INIT_IDS,
+  SKC_VK_KERNEL_ID_BLOCK_POOL_INIT_ATOMICS,
+
+  SKC_VK_KERNEL_ID_COUNT
+
+} skc_vk_kernel_id;
+
+//
+// Same encoding as HotSort's Vulkan targets: kernels are appended
+// end-to-end with a leading big-endian length followed by a SPIR-V
+// binary.
+//
+// The entry point for each kernel is "main".
+//
+
+struct skc_vk_target
+{
+  struct skc_config config;
+  uint32_t          modules[];
+};
+
+//
+//
+//
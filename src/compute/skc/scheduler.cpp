@@ -19,7 +19,11 @@
 extern "C" {
 
 #include "scheduler.h"
+#if defined(SKC_PLATFORM_VK)
+#include "runtime_vk.h"
+#else
 #include "runtime_cl_12.h" // FIXME -- all allocations are extent structures
+#endif
 
 }
 
@@ -13,7 +13,11 @@
 #include <assert.h>
 #include <memory.h>
 
+#if defined(SKC_PLATFORM_VK)
+#include "runtime_vk.h"
+#else
 #include "runtime_cl_12.h"
+#endif
 #include "scheduler.h"
 
 //
@@ -862,14 +862,20 @@ bool SkAAClip::quickContains(int left, int top, int right, int bottom) const {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+/*
+ *  Rows are only ever appended, and only the last one is still growing, so every row's runs live
+ *  back to back in fData: row i spans [fRows[i].fStart, fRows[i + 1].fStart). This saves an
+ *  allocation per row, and finish() copies all of them out at once.
+ */
 class SkAAClip::Builder {
     SkIRect fBounds;
     struct Row {
         int fY;
         int fWidth;
-        SkTDArray<uint8_t>* fData;
+        int fStart;
     };
     SkTDArray<Row>  fRows;
+    SkTDArray<uint8_t> fData;
     Row* fCurrRow;
     int fPrevY;
     int fWidth;
@@ -883,15 +889,6 @@ public:
         fMinY = bounds.fTop;
     }
 
-    ~Builder() {
-        Row* row = fRows.begin();
-        Row* stop = fRows.end();
-        while (row < stop) {
-            delete row->fData;
-            row += 1;
-        }
-    }
-
     const SkIRect& getBounds() const { return fBounds; }
 
     void addRun(int x, int y, U8CPU alpha, int count) {
@@ -909,24 +906,22 @@ public:
             row = this->flushRow(true);
             row->fY = y;
             row->fWidth = 0;
-            SkASSERT(row->fData);
-            SkASSERT(0 == row->fData->count());
+            SkASSERT(row->fStart == fData.count());
             fCurrRow = row;
         }
 
+        SkASSERT(row == fRows.end() - 1);
         SkASSERT(row->fWidth <= x);
         SkASSERT(row->fWidth < fBounds.width());
 
-        SkTDArray<uint8_t>& data = *row->fData;
-
         int gap = x - row->fWidth;
         if (gap) {
-            AppendRun(data, 0, gap);
+            AppendRun(fData, 0, gap);
             row->fWidth += gap;
             SkASSERT(row->fWidth < fBounds.width());
         }
 
-        AppendRun(data, alpha, count);
+        AppendRun(fData, alpha, count);
         row->fWidth += count;
         SkASSERT(row->fWidth <= fBounds.width());
     }
@@ -998,15 +993,7 @@ public:
     bool finish(SkAAClip* target) {
         this->flushRow(false);
 
-        const Row* row = fRows.begin();
-        const Row* stop = fRows.end();
-
-        size_t dataSize = 0;
-        while (row < stop) {
-            dataSize += row->fData->count();
-            row += 1;
-        }
-
+        size_t dataSize = fData.count();
         if (0 == dataSize) {
             return target->setEmpty();
         }
@@ -1019,27 +1006,21 @@ public:
         RunHead* head = RunHead::Alloc(fRows.count(), dataSize);
         YOffset* yoffset = head->yoffsets();
         uint8_t* data = head->data();
-        uint8_t* baseData = data;
+        memcpy(data, fData.begin(), dataSize);
 
-        row = fRows.begin();
-        SkDEBUGCODE(int prevY = row->fY - 1;)
-        while (row < stop) {
-            SkASSERT(prevY < row->fY);  // must be monotonic
-            SkDEBUGCODE(prevY = row->fY);
+        SkDEBUGCODE(int prevY = fRows[0].fY - 1;)
+        for (int i = 0; i < fRows.count(); ++i) {
+            const Row& row = fRows[i];
+            SkASSERT(prevY < row.fY);  // must be monotonic
+            SkDEBUGCODE(prevY = row.fY);
 
-            yoffset->fY = row->fY - adjustY;
-            yoffset->fOffset = SkToU32(data - baseData);
+            yoffset->fY = row.fY - adjustY;
+            yoffset->fOffset = SkToU32(row.fStart);
             yoffset += 1;
-
-            size_t n = row->fData->count();
-            memcpy(data, row->fData->begin(), n);
 #ifdef SK_DEBUG
-            size_t bytesNeeded = compute_row_length(data, fBounds.width());
-            SkASSERT(bytesNeeded == n);
+            size_t bytesNeeded = compute_row_length(data + row.fStart, fBounds.width());
+            SkASSERT(bytesNeeded == SkToSizeT(this->rowSize(i)));
 #endif
-            data += n;
-
-            row += 1;
         }
 
         target->freeRuns();
@@ -1054,10 +1035,9 @@ public:
         for (y = 0; y < fRows.count(); ++y) {
             const Row& row = fRows[y];
             SkDebugf("Y:%3d W:%3d", row.fY, row.fWidth);
-            const SkTDArray<uint8_t>& data = *row.fData;
-            int count = data.count();
+            int count = this->rowSize(y);
             SkASSERT(!(count & 1));
-            const uint8_t* ptr = data.begin();
+            const uint8_t* ptr = fData.begin() + row.fStart;
             for (int x = 0; x < count; x += 2) {
                 SkDebugf(" [%3d:%02X]", ptr[0], ptr[1]);
                 ptr += 2;
@@ -1073,8 +1053,8 @@ public:
             const Row& row = fRows[i];
             SkASSERT(prevY < row.fY);
             SkASSERT(fWidth == row.fWidth);
-            int count = row.fData->count();
-            const uint8_t* ptr = row.fData->begin();
+            int count = this->rowSize(i);
+            const uint8_t* ptr = fData.begin() + row.fStart;
             SkASSERT(!(count & 1));
             int w = 0;
             for (int x = 0; x < count; x += 2) {
@@ -1096,10 +1076,16 @@ public:
     }
 
 private:
+    int rowSize(int index) const {
+        int end = index + 1 < fRows.count() ? fRows[index + 1].fStart : fData.count();
+        return end - fRows[index].fStart;
+    }
+
     void flushRowH(Row* row) {
+        SkASSERT(row == fRows.end() - 1);
         // flush current row if needed
         if (row->fWidth < fWidth) {
-            AppendRun(*row->fData, 0, fWidth - row->fWidth);
+            AppendRun(fData, 0, fWidth - row->fWidth);
             row->fWidth = fWidth;
         }
     }
@@ -1116,27 +1102,23 @@ private:
             Row* curr = &fRows[count - 1];
             SkASSERT(prev->fWidth == fWidth);
             SkASSERT(curr->fWidth == fWidth);
-            if (*prev->fData == *curr->fData) {
+            int prevSize = curr->fStart - prev->fStart;
+            if (prevSize == this->rowSize(count - 1) &&
+                !memcmp(fData.begin() + prev->fStart, fData.begin() + curr->fStart, prevSize)) {
                 prev->fY = curr->fY;
+                fData.setCount(curr->fStart);
                 if (readyForAnother) {
-                    curr->fData->rewind();
                     next = curr;
                 } else {
-                    delete curr->fData;
                     fRows.removeShuffle(count - 1);
                 }
-            } else {
-                if (readyForAnother) {
-                    next = fRows.append();
-                    next->fData = new SkTDArray<uint8_t>;
-                }
-            }
-        } else {
-            if (readyForAnother) {
-                next = fRows.append();
-                next->fData = new SkTDArray<uint8_t>;
+                return next;
             }
         }
+        if (readyForAnother) {
+            next = fRows.append();
+            next->fStart = fData.count();
+        }
         return next;
     }
 
@@ -1600,6 +1582,33 @@ static void operateY(SkAAClip::Builder& builder, const SkAAClip& A,
     } while (!iterA.done() || !iterB.done());
 }
 
+// Intersecting with a rect inside the clip's bounds only crops its rows, so copy the runs that
+// fall inside the builder's bounds instead of merging them against a rect clip.
+static void crop_rows(SkAAClip::Builder& builder, const SkAAClip& clip) {
+    const SkIRect& bounds = builder.getBounds();
+    SkASSERT(clip.getBounds().contains(bounds));
+
+    for (SkAAClip::Iter iter(clip); !iter.done() && iter.top() < bounds.fBottom; iter.next()) {
+        if (iter.bottom() <= bounds.fTop) {
+            continue;
+        }
+        int lastY = SkMin32(iter.bottom(), bounds.fBottom) - 1;
+        int count;
+        const uint8_t* row = clip.findX(iter.data(), bounds.fLeft, &count);
+        int x = bounds.fLeft;
+        for (;;) {
+            int n = SkMin32(count, bounds.fRight - x);
+            builder.addRun(x, lastY, row[1], n);
+            x += n;
+            if (x == bounds.fRight) {
+                break;
+            }
+            row += 2;
+            count = row[0];
+        }
+    }
+}
+
 bool SkAAClip::op(const SkAAClip& clipAOrig, const SkAAClip& clipBOrig,
                   SkRegion::Op op) {
     AUTO_AACLIP_VALIDATE(*this);
@@ -1689,8 +1698,12 @@ bool SkAAClip::op(const SkIRect& rOrig, SkRegion::Op op) {
                 // the intersection is wholly inside us, we're a rect
                 return this->setRect(rStorage);
             }
-            r = &rStorage;   // use the intersected bounds
-            break;
+            {
+                AUTO_AACLIP_VALIDATE(*this);
+                Builder builder(rStorage);
+                crop_rows(builder, *this);
+                return builder.finish(this);
+            }
         case SkRegion::kDifference_Op:
             break;
         case SkRegion::kUnion_Op:
@@ -1708,6 +1721,14 @@ bool SkAAClip::op(const SkIRect& rOrig, SkRegion::Op op) {
 }
 
 bool SkAAClip::op(const SkRect& rOrig, SkRegion::Op op, bool doAA) {
+    if (SkRegion::kIntersect_Op == op &&
+            SkScalarIsInt(rOrig.fLeft) && SkScalarIsInt(rOrig.fTop) &&
+            SkScalarIsInt(rOrig.fRight) && SkScalarIsInt(rOrig.fBottom)) {
+        // An integral rect has no partial coverage, so we can skip scan converting it and crop
+        // our rows directly.
+        return this->op(rOrig.roundOut(), op);
+    }
+
     SkRect        rStorage, boundsStorage;
     const SkRect* r = &rOrig;
 
@@ -1742,6 +1763,13 @@ bool SkAAClip::op(const SkAAClip& clip, SkRegion::Op op) {
     return this->op(*this, clip, op);
 }
 
+size_t SkAAClip::bytesUsed() const {
+    if (this->isEmpty()) {
+        return 0;
+    }
+    return sizeof(RunHead) + fRunHead->fRowCount * sizeof(YOffset) + fRunHead->fDataSize;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 bool SkAAClip::translate(int dx, int dy, SkAAClip* dst) const {
@@ -1968,9 +1996,51 @@ void SkAAClipBlitter::blitRect(int x, int y, int width, int height) {
         return;
     }
 
-    while (--height >= 0) {
-        this->blitH(x, y, width);
-        y += 1;
+    // Rows that share their runs (e.g. the straight sides of a round rect) are blitted together,
+    // each run as a rect, columns or spans of its alpha, instead of one row at a time.
+    for (;;) {
+        int lastY SK_INIT_TO_AVOID_WARNING;
+        const uint8_t* row = fAAClip->findRow(y, &lastY);
+        int dy = SkMin32(lastY - y + 1, height);
+        if (1 == dy) {
+            this->blitH(x, y, width);
+        } else {
+            int n;
+            row = fAAClip->findX(row, x, &n);
+            int left = x;
+            int remaining = width;
+            for (;;) {
+                n = SkMin32(n, remaining);
+                SkAlpha alpha = row[1];
+                if (0xFF == alpha) {
+                    fBlitter->blitRect(left, y, n, dy);
+                } else if (alpha && n <= dy) {
+                    for (int i = 0; i < n; ++i) {
+                        fBlitter->blitV(left + i, y, dy, alpha);
+                    }
+                } else if (alpha) {
+                    this->ensureRunsAndAA();
+                    fRuns[0] = n;
+                    fRuns[n] = 0;
+                    fAA[0] = alpha;
+                    for (int i = 0; i < dy; ++i) {
+                        fBlitter->blitAntiH(left, y + i, fAA, fRuns);
+                    }
+                }
+                left += n;
+                remaining -= n;
+                if (0 == remaining) {
+                    break;
+                }
+                row += 2;
+                n = row[0];
+            }
+        }
+        height -= dy;
+        if (height <= 0) {
+            break;
+        }
+        y += dy;
     }
 }
 
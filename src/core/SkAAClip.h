@@ -58,6 +58,9 @@ public:
      */
     void copyToMask(SkMask*) const;
 
+    // Returns the size of the clip's row data, for memory accounting.
+    size_t bytesUsed() const;
+
     // called internally
 
     bool quickContains(int left, int top, int right, int bottom) const;
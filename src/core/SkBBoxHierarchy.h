@@ -22,7 +22,8 @@ public:
     virtual ~SkBBoxHierarchy() {}
 
     /**
-     * Insert N bounding boxes into the hierarchy.
+     * Insert N bounding boxes into the hierarchy.  Boxes from later calls are indexed after those
+     * already inserted, if the hierarchy supports being extended.
      */
     virtual void insert(const SkRect[], int N) = 0;
 
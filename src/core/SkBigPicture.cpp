@@ -8,6 +8,7 @@
 #include "SkBBoxHierarchy.h"
 #include "SkBigPicture.h"
 #include "SkPictureCommon.h"
+#include "SkPictureRecord.h"
 #include "SkRecord.h"
 #include "SkRecordDraw.h"
 #include "SkTraceEvent.h"
@@ -53,6 +54,28 @@ void SkBigPicture::partialPlayback(SkCanvas* canvas,
                         initialCTM);
 }
 
+const SkLayerInfo* SkBigPicture::layerInfo() const {
+    fLayerInfoOnce([this] {
+        SkAutoTMalloc<SkRect> bounds(fRecord->count());
+        SkLayerInfo* info = new SkLayerInfo;
+        SkRecordComputeLayers(fCullRect, *fRecord, bounds.get(), fDrawablePicts.get(), info);
+        fLayerInfo.reset(info);
+    });
+    return fLayerInfo.get();
+}
+
+void SkBigPicture::playbackWithBounds(SkPictureRecord* record) const {
+    SkAutoTMalloc<SkRect> bounds(fRecord->count());
+    SkRecordFillBounds(fCullRect, *fRecord, bounds.get());
+
+    SkRecords::Draw draw(record, this->drawablePicts(), nullptr, this->drawableCount());
+    for (int i = 0; i < fRecord->count(); i++) {
+        record->beginOpGroup(bounds[i]);
+        fRecord->visit(i, draw);
+    }
+    record->endOpGroups();
+}
+
 SkRect SkBigPicture::cullRect()            const { return fCullRect; }
 int    SkBigPicture::approximateOpCount()   const { return fRecord->count(); }
 size_t SkBigPicture::approximateBytesUsed() const {
@@ -8,6 +8,7 @@
 #ifndef SkBigPicture_DEFINED
 #define SkBigPicture_DEFINED
 
+#include "SkLayerInfo.h"
 #include "SkNoncopyable.h"
 #include "SkOnce.h"
 #include "SkPicture.h"
@@ -16,6 +17,7 @@
 
 class SkBBoxHierarchy;
 class SkMatrix;
+class SkPictureRecord;
 class SkRecord;
 
 // An implementation of SkPicture supporting an arbitrary number of drawing commands.
@@ -53,19 +55,27 @@ public:
                          int start,
                          int stop,
                          const SkMatrix& initialCTM) const;
+    // The hoistable saveLayer blocks in this picture, computed on first use.
+    const SkLayerInfo* layerInfo() const;
+// Used by SkPicture::backport(): plays back into record, grouping its ops by their bounds.
+    void playbackWithBounds(SkPictureRecord* record) const;
 // Used by GrRecordReplaceDraw
     const SkBBoxHierarchy* bbh() const { return fBBH.get(); }
     const SkRecord*     record() const { return fRecord.get(); }
-
-private:
+// Used by GrLayerHoister
     int drawableCount() const;
     SkPicture const* const* drawablePicts() const;
 
+private:
+
     const SkRect                         fCullRect;
     const size_t                         fApproxBytesUsedBySubPictures;
     sk_sp<const SkRecord>                fRecord;
     std::unique_ptr<const SnapshotArray> fDrawablePicts;
     sk_sp<const SkBBoxHierarchy>         fBBH;
+
+    mutable SkOnce                               fLayerInfoOnce;
+    mutable std::unique_ptr<const SkLayerInfo>   fLayerInfo;
 };
 
 #endif//SkBigPicture_DEFINED
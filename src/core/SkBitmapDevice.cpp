@@ -601,6 +601,12 @@ private:
 
 }  // anonymous ns
 
+// Image filters over larger areas than this are evaluated a tile at a time, so that each node of
+// the filter DAG only needs an intermediate image as big as a tile plus what the nodes downstream
+// of it need around that tile (e.g. a blur's radius).
+static constexpr int kMaxUntiledImageFilterPixels = 2048 * 2048;
+static constexpr int kImageFilterTileSize         = 1024;
+
 void SkBitmapDevice::drawSpecial(SkSpecialImage* src, int x, int y, const SkPaint& origPaint,
                                  SkImage* clipImage, const SkMatrix& clipMatrix) {
     SkASSERT(!src->isTextureBacked());
@@ -608,6 +614,30 @@ void SkBitmapDevice::drawSpecial(SkSpecialImage* src, int x, int y, const SkPain
     sk_sp<SkSpecialImage> filteredImage;
     SkTCopyOnFirstWrite<SkPaint> paint(origPaint);
 
+    const SkIRect devClipBounds = fRCStack.rc().getBounds();
+    if (paint->getImageFilter() && !clipImage &&
+        (int64_t)devClipBounds.width() * devClipBounds.height() > kMaxUntiledImageFilterPixels) {
+        for (int top = devClipBounds.fTop; top < devClipBounds.fBottom;
+             top += kImageFilterTileSize) {
+            for (int left = devClipBounds.fLeft; left < devClipBounds.fRight;
+                 left += kImageFilterTileSize) {
+                SkIRect tile = SkIRect::MakeXYWH(left, top,
+                                                 kImageFilterTileSize, kImageFilterTileSize);
+                if (!tile.intersect(devClipBounds)) {
+                    continue;
+                }
+                // Each tile's filterImage() only produces what's inside the tile's clip.
+                fRCStack.save();
+                fRCStack.clipRect(SkMatrix::I(), SkRect::Make(tile), SkClipOp::kIntersect, false);
+                if (!fRCStack.rc().isEmpty()) {
+                    this->drawSpecial(src, x, y, origPaint, nullptr, clipMatrix);
+                }
+                fRCStack.restore();
+            }
+        }
+        return;
+    }
+
     if (SkImageFilter* filter = paint->getImageFilter()) {
         SkIPoint offset = SkIPoint::Make(0, 0);
         const SkMatrix matrix = SkMatrix::Concat(
@@ -145,11 +145,32 @@ bool SkCanvas::wouldOverwriteEntireSurface(const SkRect* rect, const SkPaint* pa
 
 typedef SkTLazy<SkPaint> SkLazyPaint;
 
+// Returns the device bounds a draw may touch, for the surface's damage. This is the clip, narrowed
+// to the (paint adjusted) bounds of the draw when they're known.
+static SkIRect draw_damage(const SkRect& deviceClipBounds, const SkMatrix& ctm,
+                           const SkRect* rect, const SkPaint* paint) {
+    SkRect damage = deviceClipBounds;
+    if (rect && paint && paint->canComputeFastBounds()) {
+        SkRect storage;
+        SkRect devRect = ctm.mapRect(paint->computeFastBounds(*rect, &storage));
+        // Antialiasing and hairlines can touch the pixels just outside the geometry.
+        devRect.outset(1, 1);
+        if (!devRect.isFinite()) {
+            return damage.roundOut();
+        }
+        if (!damage.intersect(devRect)) {
+            return SkIRect::MakeEmpty();
+        }
+    }
+    return damage.roundOut();
+}
+
 void SkCanvas::predrawNotify(bool willOverwritesEntireSurface) {
     if (fSurfaceBase) {
+        SkIRect damage = draw_damage(fDeviceClipBounds, this->getTotalMatrix(), nullptr, nullptr);
         fSurfaceBase->aboutToDraw(willOverwritesEntireSurface
                                   ? SkSurface::kDiscard_ContentChangeMode
-                                  : SkSurface::kRetain_ContentChangeMode);
+                                  : SkSurface::kRetain_ContentChangeMode, &damage);
     }
 }
 
@@ -166,7 +187,8 @@ void SkCanvas::predrawNotify(const SkRect* rect, const SkPaint* paint,
                 mode = SkSurface::kDiscard_ContentChangeMode;
             }
         }
-        fSurfaceBase->aboutToDraw(mode);
+        SkIRect damage = draw_damage(fDeviceClipBounds, this->getTotalMatrix(), rect, paint);
+        fSurfaceBase->aboutToDraw(mode, &damage);
     }
 }
 
@@ -235,12 +257,17 @@ public:
     SkConservativeClip fRasterClip;
     SkMatrix fMatrix;
     int fDeferredSaveCount;
+    // True until the top devices have saved their clip for this level. internalSave() leaves
+    // that to the first clip change, so save/translate/draw/restore never touches the devices'
+    // clip stacks.
+    bool fDeferredDeviceSave;
 
     MCRec() {
         fLayer      = nullptr;
         fTopLayer   = nullptr;
         fMatrix.reset();
         fDeferredSaveCount = 0;
+        fDeferredDeviceSave = false;
 
         // don't bother initializing fNext
         inc_rec();
@@ -249,6 +276,7 @@ public:
         fLayer = nullptr;
         fTopLayer = prev.fTopLayer;
         fDeferredSaveCount = 0;
+        fDeferredDeviceSave = true;
 
         // don't bother initializing fNext
         inc_rec();
@@ -754,6 +782,13 @@ void SkCanvas::checkForDeferredSave() {
     }
 }
 
+void SkCanvas::checkForDeferredDeviceSave() {
+    if (fMCRec->fDeferredDeviceSave) {
+        fMCRec->fDeferredDeviceSave = false;
+        FOR_EACH_TOP_DEVICE(device->save());
+    }
+}
+
 int SkCanvas::getSaveCount() const {
 #ifdef SK_DEBUG
     int count = 0;
@@ -817,8 +852,6 @@ void SkCanvas::internalSave() {
     MCRec* newTop = (MCRec*)fMCStack.push_back();
     new (newTop) MCRec(*fMCRec);    // balanced in restore()
     fMCRec = newTop;
-
-    FOR_EACH_TOP_DEVICE(device->save());
 }
 
 bool SkCanvas::BoundsAffectsClip(SaveLayerFlags saveLayerFlags) {
@@ -945,9 +978,24 @@ void SkCanvas::DrawDeviceWithFilter(SkBaseDevice* src, const SkImageFilter* filt
 
     int x = src->getOrigin().x() - dstOrigin.x();
     int y = src->getOrigin().y() - dstOrigin.y();
-    auto special = src->snapSpecial();
+
+    // Only snap the part of src that can reach dst: dst's bounds (in src's device space), grown
+    // by however far the filter reads beyond its output.
+    SkIRect needed = SkIRect::MakeXYWH(-x, -y, dst->width(), dst->height());
+    if (p.getImageFilter()) {
+        needed = p.getImageFilter()->filterBounds(needed, SkMatrix::I(),
+                                                  SkImageFilter::kReverse_MapDirection);
+    }
+    const SkIRect srcBounds = SkIRect::MakeWH(src->width(), src->height());
+    if (!needed.intersect(srcBounds)) {
+        // None of src reaches dst, but the filter may still draw something from transparent black.
+        needed = srcBounds;
+    }
+
+    auto special = src->snapSpecialSubset(needed);
     if (special) {
-        dst->drawSpecial(special.get(), x, y, p, nullptr, SkMatrix::I());
+        dst->drawSpecial(special.get(), x + needed.fLeft, y + needed.fTop, p, nullptr,
+                         SkMatrix::I());
     }
 }
 
@@ -1026,6 +1074,8 @@ void SkCanvas::internalSaveLayer(const SaveLayerRec& rec, SaveLayerStrategy stra
     // do this before we create the layer. We don't call the public save() since
     // that would invoke a possibly overridden virtual
     this->internalSave();
+    // the layer changes which devices are on top, so the current ones must save now
+    this->checkForDeferredDeviceSave();
 
     SkIRect ir;
     if (!this->clipRectBounds(bounds, saveLayerFlags, &ir, imageFilter)) {
@@ -1159,13 +1209,20 @@ void SkCanvas::internalRestore() {
     // move this out before we do the actual restore
     auto backImage = std::move(fMCRec->fBackImage);
 
+    // the devices only have a save to restore if this level changed their clip
+    const bool devicesSaved = !fMCRec->fDeferredDeviceSave;
+
     // now do the normal restore()
     fMCRec->~MCRec();       // balanced in save()
     fMCStack.pop_back();
     fMCRec = (MCRec*)fMCStack.back();
 
     if (fMCRec) {
-        FOR_EACH_TOP_DEVICE(device->restore(fMCRec->fMatrix));
+        if (devicesSaved) {
+            FOR_EACH_TOP_DEVICE(device->restore(fMCRec->fMatrix));
+        } else {
+            FOR_EACH_TOP_DEVICE(device->setGlobalCTM(fMCRec->fMatrix));
+        }
     }
 
     if (backImage) {
@@ -1393,6 +1450,7 @@ void SkCanvas::clipRect(const SkRect& rect, SkClipOp op, bool doAA) {
 void SkCanvas::onClipRect(const SkRect& rect, SkClipOp op, ClipEdgeStyle edgeStyle) {
     const bool isAA = kSoft_ClipEdgeStyle == edgeStyle;
 
+    this->checkForDeferredDeviceSave();
     FOR_EACH_TOP_DEVICE(device->clipRect(rect, op, isAA));
 
     AutoValidateClip avc(this);
@@ -1409,6 +1467,7 @@ void SkCanvas::androidFramework_setDeviceClipRestriction(const SkIRect& rect) {
         FOR_EACH_TOP_DEVICE(device->androidFramework_setDeviceClipRestriction(&fClipRestrictionRect));
     } else {
         this->checkForDeferredSave();
+        this->checkForDeferredDeviceSave();
         FOR_EACH_TOP_DEVICE(device->androidFramework_setDeviceClipRestriction(&fClipRestrictionRect));
         AutoValidateClip avc(this);
         fMCRec->fRasterClip.opIRect(fClipRestrictionRect, SkRegion::kIntersect_Op);
@@ -1431,6 +1490,7 @@ void SkCanvas::onClipRRect(const SkRRect& rrect, SkClipOp op, ClipEdgeStyle edge
 
     bool isAA = kSoft_ClipEdgeStyle == edgeStyle;
 
+    this->checkForDeferredDeviceSave();
     FOR_EACH_TOP_DEVICE(device->clipRRect(rrect, op, isAA));
 
     fMCRec->fRasterClip.opRRect(rrect, fMCRec->fMatrix, this->getTopLayerBounds(), (SkRegion::Op)op,
@@ -1468,6 +1528,7 @@ void SkCanvas::onClipPath(const SkPath& path, SkClipOp op, ClipEdgeStyle edgeSty
 
     bool isAA = kSoft_ClipEdgeStyle == edgeStyle;
 
+    this->checkForDeferredDeviceSave();
     FOR_EACH_TOP_DEVICE(device->clipPath(path, op, isAA));
 
     const SkPath* rasterClipPath = &path;
@@ -1483,6 +1544,7 @@ void SkCanvas::clipRegion(const SkRegion& rgn, SkClipOp op) {
 }
 
 void SkCanvas::onClipRegion(const SkRegion& rgn, SkClipOp op) {
+    this->checkForDeferredDeviceSave();
     FOR_EACH_TOP_DEVICE(device->clipRegion(rgn, op));
 
     AutoValidateClip avc(this);
@@ -12,10 +12,12 @@
 #include "SkColorSpaceXformSteps.h"
 #include "SkColorSpaceXformer.h"
 #include "SkNx.h"
+#include "SkPixmap.h"
 #include "SkRasterPipeline.h"
 #include "SkReadBuffer.h"
 #include "SkRefCnt.h"
 #include "SkString.h"
+#include "SkTaskGroup.h"
 #include "SkTDArray.h"
 #include "SkUnPreMultiply.h"
 #include "SkWriteBuffer.h"
@@ -81,6 +83,52 @@ SkColor4f SkColorFilter::filterColor4f(const SkColor4f& c, SkColorSpace* colorSp
     return dst.unpremul();
 }
 
+bool SkColorFilter::filterPixmap(const SkPixmap& pixmap) const {
+    if (!pixmap.addr() || kUnknown_SkColorType == pixmap.colorType() ||
+        kUnknown_SkAlphaType == pixmap.alphaType()) {
+        return false;
+    }
+
+    // Rows are independent, so large pixmaps are filtered in bands. Each band builds its own
+    // pipeline, as some filters' stages (e.g. callbacks) keep scratch space in their contexts.
+    static constexpr int kMinPixelsPerBand = 64 * 1024;
+    static constexpr int kMaxBands         = 32;
+
+    const int width  = pixmap.width(),
+              height = pixmap.height();
+    const bool isOpaque = pixmap.isOpaque();
+    auto filter_rows = [&](int top, int bottom) {
+        SkSTArenaAlloc<512> alloc;
+        SkRasterPipeline p(&alloc);
+        SkRasterPipeline_MemoryCtx ctx = { pixmap.writable_addr(), pixmap.rowBytesAsPixels() };
+        p.append_load(pixmap.colorType(), &ctx);
+        if (kUnpremul_SkAlphaType == pixmap.alphaType()) {
+            p.append(SkRasterPipeline::premul);
+        }
+        this->onAppendStages(&p, pixmap.colorSpace(), &alloc, isOpaque);
+        if (kUnpremul_SkAlphaType == pixmap.alphaType()) {
+            p.append(SkRasterPipeline::unpremul);
+        }
+        p.append_gamut_clamp_if_normalized(pixmap.info());
+        p.append_store(pixmap.colorType(), &ctx);
+        p.run(0, top, width, bottom - top);
+    };
+
+    int bands = (int)SkTMin<int64_t>(SkTMin(height, kMaxBands),
+                                     (int64_t)width * height / kMinPixelsPerBand);
+    if (bands <= 1) {
+        filter_rows(0, height);
+    } else {
+        SkTaskGroup tg;
+        tg.batch(bands, [&](int band) {
+            filter_rows((int)((int64_t)height *  band      / bands),
+                        (int)((int64_t)height * (band + 1) / bands));
+        });
+        tg.wait();
+    }
+    return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 /*
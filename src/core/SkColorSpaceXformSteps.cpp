@@ -8,6 +8,7 @@
 #include "SkColorSpaceXformSteps.h"
 #include "SkColorSpacePriv.h"
 #include "SkRasterPipeline.h"
+#include "SkResourceCache.h"
 #include "../../third_party/skcms/skcms.h"
 
 // TODO: explain
@@ -95,6 +96,77 @@ SkColorSpaceXformSteps::SkColorSpaceXformSteps(SkColorSpace* src, SkAlphaType sr
     }
 }
 
+namespace {
+
+// 256 entries keep every transfer function we've tried to within 0.05/255 of the real thing.
+static constexpr int kTFTableSize = 256;
+
+static unsigned gTFTableKeyNamespaceLabel;
+
+struct TFTableKey : public SkResourceCache::Key {
+public:
+    TFTableKey(const skcms_TransferFunction& tf) {
+        memcpy(fTF, &tf, sizeof(fTF));
+        this->init(&gTFTableKeyNamespaceLabel, 0, sizeof(fTF));
+    }
+
+    float fTF[7];
+};
+
+struct TFTableRec : public SkResourceCache::Rec {
+    TFTableRec(const TFTableKey& key, sk_sp<SkData> table)
+        : fKey(key), fTable(std::move(table)) {}
+
+    TFTableKey    fKey;
+    sk_sp<SkData> fTable;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(*this) + fTable->size(); }
+    const char* getCategory() const override { return "tf-table"; }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextTable) {
+        const TFTableRec& rec = static_cast<const TFTableRec&>(baseRec);
+        *static_cast<sk_sp<SkData>*>(contextTable) = rec.fTable;
+        return true;
+    }
+};
+
+}  // namespace
+
+// Returns an SkRasterPipeline_TFTableCtx followed by the table it points to.
+static sk_sp<SkData> find_or_make_tf_table(const skcms_TransferFunction& tf) {
+    TFTableKey key(tf);
+    sk_sp<SkData> data;
+    if (SkResourceCache::Find(key, TFTableRec::Visitor, &data)) {
+        return data;
+    }
+
+    data = SkData::MakeUninitialized(sizeof(SkRasterPipeline_TFTableCtx) +
+                                     (kTFTableSize + 1) * sizeof(float));
+    auto ctx   = static_cast<SkRasterPipeline_TFTableCtx*>(data->writable_data());
+    auto table = reinterpret_cast<float*>(ctx + 1);
+    for (int i = 0; i < kTFTableSize; i++) {
+        float u = i * (1.0f / (kTFTableSize - 1));
+        table[i] = skcms_TransferFunction_eval(&tf, u*u);
+    }
+    table[kTFTableSize] = table[kTFTableSize - 1];
+    ctx->table = table;
+    ctx->size  = kTFTableSize;
+
+    SkResourceCache::Add(new TFTableRec(key, data));
+    return data;
+}
+
+void SkColorSpaceXformSteps::useTables() {
+    // from_srgb and to_srgb are already cheap approximations, so we leave them alone.
+    if (flags.linearize && !srcTF_is_sRGB && !srcTFTable) {
+        srcTFTable = find_or_make_tf_table(srcTF);
+    }
+    if (flags.encode && !dstTF_is_sRGB && !dstTFInvTable) {
+        dstTFInvTable = find_or_make_tf_table(dstTFInv);
+    }
+}
+
 void SkColorSpaceXformSteps::apply(float* rgba) const {
     if (flags.unpremul) {
         // I don't know why isfinite(x) stopped working on the Chromecast bots...
@@ -144,6 +216,8 @@ void SkColorSpaceXformSteps::apply(SkRasterPipeline* p, bool src_is_normalized)
     if (flags.linearize) {
         if (src_is_normalized && srcTF_is_sRGB) {
             p->append(SkRasterPipeline::from_srgb);
+        } else if (srcTFTable) {
+            p->append(SkRasterPipeline::tf_table, srcTFTable->data());
         } else if (srcTF.a == 1 &&
                    srcTF.b == 0 &&
                    srcTF.c == 0 &&
@@ -161,6 +235,8 @@ void SkColorSpaceXformSteps::apply(SkRasterPipeline* p, bool src_is_normalized)
     if (flags.encode) {
         if (src_is_normalized && dstTF_is_sRGB) {
             p->append(SkRasterPipeline::to_srgb);
+        } else if (dstTFInvTable) {
+            p->append(SkRasterPipeline::tf_table, dstTFInvTable->data());
         } else if (dstTFInv.a == 1 &&
                    dstTFInv.b == 0 &&
                    dstTFInv.c == 0 &&
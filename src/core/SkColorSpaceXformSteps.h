@@ -9,6 +9,7 @@
 #define SkColorSpaceXformSteps_DEFINED
 
 #include "SkColorSpace.h"
+#include "SkData.h"
 #include "SkImageInfo.h"
 
 class SkRasterPipeline;
@@ -33,6 +34,11 @@ struct SkColorSpaceXformSteps {
     SkColorSpaceXformSteps(SkColorSpace* src, SkAlphaType srcAT,
                            SkColorSpace* dst, SkAlphaType dstAT);
 
+    // Replaces the linearize and encode transfer functions, if they'd need per-pixel pow() calls,
+    // with cached tables of their values.  Those tables clamp to [0,1], so this should only be
+    // used when converting from one normalized color type to another.
+    void useTables();
+
     void apply(float rgba[4]) const;
     void apply(SkRasterPipeline*, bool src_is_normalized) const;
 
@@ -53,6 +59,10 @@ struct SkColorSpaceXformSteps {
     skcms_TransferFunction srcTF,     // Apply for linearize.
                            dstTFInv;  // Apply for encode.
     float src_to_dst_matrix[9];       // Apply this 3x3 column-major matrix for gamut_transform.
+
+    // If set by useTables(), an SkRasterPipeline_TFTableCtx for srcTF or dstTFInv.
+    sk_sp<SkData> srcTFTable,
+                  dstTFInvTable;
 };
 
 #endif//SkColorSpaceXformSteps_DEFINED
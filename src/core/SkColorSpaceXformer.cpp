@@ -16,11 +16,19 @@
 #include "SkImagePriv.h"
 #include "SkShaderBase.h"
 
+// Transformed images may be copies of the pixels, so keep fewer of them around.
+static constexpr int kMaxPersistentImages  = 8;
+static constexpr int kMaxPersistentObjects = 32;
+
 SkColorSpaceXformer::SkColorSpaceXformer(sk_sp<SkColorSpace> dst)
     : fDst(std::move(dst))
     , fFromSRGBSteps(sk_srgb_singleton(), kUnpremul_SkAlphaType,
                      fDst.get()         , kUnpremul_SkAlphaType)
-    , fReentryCount(0) {
+    , fReentryCount(0)
+    , fPersistentImageCache(kMaxPersistentImages)
+    , fPersistentColorFilterCache(kMaxPersistentObjects)
+    , fPersistentImageFilterCache(kMaxPersistentObjects)
+    , fPersistentShaderCache(kMaxPersistentObjects) {
 
     SkRasterPipeline p(&fAlloc);
     p.append(SkRasterPipeline::load_8888, &fFromSRGBSrc);
@@ -54,6 +62,10 @@ std::unique_ptr<SkColorSpaceXformer> SkColorSpaceXformer::Make(sk_sp<SkColorSpac
 // clients may choose to not discard xformers immediately - in which case, caching indefinitely
 // is problematic.  The solution is to limit the cache scope to the top level apply() call
 // (i.e. we only keep cached objects alive while transforming).
+//
+// Xformers that live as long as a canvas do see the same objects draw after draw, though, so a
+// few of the most recently transformed objects of each kind are also kept in small LRU caches
+// that survive across top level calls.  Those bound what's kept alive by count.
 
 class SkColorSpaceXformer::AutoCachePurge {
 public:
@@ -75,6 +87,7 @@ private:
 
 template <typename T>
 sk_sp<T> SkColorSpaceXformer::cachedApply(const T* src, Cache<T>* cache,
+                                          PersistentCache<T>* persistentCache,
                                           sk_sp<T> (*applyFunc)(const T*, SkColorSpaceXformer*)) {
     if (!src) {
         return nullptr;
@@ -85,7 +98,13 @@ sk_sp<T> SkColorSpaceXformer::cachedApply(const T* src, Cache<T>* cache,
         return sk_ref_sp(xformed->get());
     }
 
-    auto xformed = applyFunc(src, this);
+    sk_sp<T> xformed;
+    if (auto* entry = persistentCache->find(src)) {
+        xformed = entry->fXformed;
+    } else {
+        xformed = applyFunc(src, this);
+        persistentCache->insert(src, {key, xformed});
+    }
     cache->set(std::move(key), xformed);
 
     return xformed;
@@ -95,11 +114,12 @@ void SkColorSpaceXformer::purgeCaches() {
     fImageCache.reset();
     fColorFilterCache.reset();
     fImageFilterCache.reset();
+    fShaderCache.reset();
 }
 
 sk_sp<SkImage> SkColorSpaceXformer::apply(const SkImage* src) {
     const AutoCachePurge autoPurge(this);
-    return this->cachedApply<SkImage>(src, &fImageCache,
+    return this->cachedApply<SkImage>(src, &fImageCache, &fPersistentImageCache,
         [](const SkImage* img, SkColorSpaceXformer* xformer) {
             return img->makeColorSpace(xformer->fDst);
         });
@@ -121,6 +141,7 @@ sk_sp<SkImage> SkColorSpaceXformer::apply(const SkBitmap& src) {
 sk_sp<SkColorFilter> SkColorSpaceXformer::apply(const SkColorFilter* colorFilter) {
     const AutoCachePurge autoPurge(this);
     return this->cachedApply<SkColorFilter>(colorFilter, &fColorFilterCache,
+                                              &fPersistentColorFilterCache,
         [](const SkColorFilter* f, SkColorSpaceXformer* xformer) {
             return f->makeColorSpace(xformer);
         });
@@ -129,6 +150,7 @@ sk_sp<SkColorFilter> SkColorSpaceXformer::apply(const SkColorFilter* colorFilter
 sk_sp<SkImageFilter> SkColorSpaceXformer::apply(const SkImageFilter* imageFilter) {
     const AutoCachePurge autoPurge(this);
     return this->cachedApply<SkImageFilter>(imageFilter, &fImageFilterCache,
+                                              &fPersistentImageFilterCache,
         [](const SkImageFilter* f, SkColorSpaceXformer* xformer) {
             return f->makeColorSpace(xformer);
         });
@@ -136,7 +158,10 @@ sk_sp<SkImageFilter> SkColorSpaceXformer::apply(const SkImageFilter* imageFilter
 
 sk_sp<SkShader> SkColorSpaceXformer::apply(const SkShader* shader) {
     const AutoCachePurge autoPurge(this);
-    return as_SB(shader)->makeColorSpace(this);
+    return this->cachedApply<SkShader>(shader, &fShaderCache, &fPersistentShaderCache,
+        [](const SkShader* s, SkColorSpaceXformer* xformer) {
+            return as_SB(s)->makeColorSpace(xformer);
+        });
 }
 
 void SkColorSpaceXformer::apply(SkColor* xformed, const SkColor* srgb, int n) {
@@ -152,6 +177,11 @@ SkColor SkColorSpaceXformer::apply(SkColor srgb) {
 }
 
 SkPaint SkColorSpaceXformer::apply(const SkPaint& src) {
+    // Effects are compared by identity, so this is cheap, and catches runs of draws with one paint.
+    if (fHasLastPaint && src == fLastSrcPaint) {
+        return fLastXformedPaint;
+    }
+
     const AutoCachePurge autoPurge(this);
 
     SkPaint dst = src;
@@ -177,6 +207,9 @@ SkPaint SkColorSpaceXformer::apply(const SkPaint& src) {
         dst.setImageFilter(this->apply(imageFilter));
     }
 
+    fHasLastPaint = true;
+    fLastSrcPaint = src;
+    fLastXformedPaint = dst;
     return dst;
 }
 
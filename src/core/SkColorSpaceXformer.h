@@ -11,6 +11,8 @@
 #include "SkCanvas.h"
 #include "SkColor.h"
 #include "SkColorSpaceXformSteps.h"
+#include "SkLRUCache.h"
+#include "SkPaint.h"
 #include "SkRasterPipeline.h"
 #include "SkRefCnt.h"
 #include "SkTHash.h"
@@ -20,7 +22,6 @@ class SkColorFilter;
 class SkColorSpace;
 class SkImage;
 class SkImageFilter;
-class SkPaint;
 class SkShader;
 
 class SkColorSpaceXformer : public SkNoncopyable {
@@ -48,8 +49,21 @@ private:
     template <typename T>
     using Cache = SkTHashMap<sk_sp<T>, sk_sp<T>>;
 
+    // Outlives the top level apply() call, so objects drawn again and again (e.g. by a
+    // SkColorSpaceXformCanvas) are only transformed once. The source is held to keep its address
+    // from being reused.
     template <typename T>
-    sk_sp<T> cachedApply(const T*, Cache<T>*, sk_sp<T> (*)(const T*, SkColorSpaceXformer*));
+    struct Xformed {
+        sk_sp<T> fSrc;
+        sk_sp<T> fXformed;
+    };
+
+    template <typename T>
+    using PersistentCache = SkLRUCache<const T*, Xformed<T>>;
+
+    template <typename T>
+    sk_sp<T> cachedApply(const T*, Cache<T>*, PersistentCache<T>*,
+                         sk_sp<T> (*)(const T*, SkColorSpaceXformer*));
 
     void purgeCaches();
 
@@ -67,6 +81,17 @@ private:
     Cache<SkImage      > fImageCache;
     Cache<SkColorFilter> fColorFilterCache;
     Cache<SkImageFilter> fImageFilterCache;
+    Cache<SkShader     > fShaderCache;
+
+    PersistentCache<SkImage      > fPersistentImageCache;
+    PersistentCache<SkColorFilter> fPersistentColorFilterCache;
+    PersistentCache<SkImageFilter> fPersistentImageFilterCache;
+    PersistentCache<SkShader     > fPersistentShaderCache;
+
+    // The last paint transformed, and what it became.
+    bool    fHasLastPaint = false;
+    SkPaint fLastSrcPaint;
+    SkPaint fLastXformedPaint;
 };
 
 #endif
@@ -6,10 +6,11 @@
  */
 
 #include "SkContourMeasure.h"
+#include "SkContourMeasureCache.h"
 #include "SkPathMeasurePriv.h"
 #include "SkGeometry.h"
 #include "SkPath.h"
-#include "SkTSearch.h"
+#include "SkTo.h"
 
 #define kMaxTValue  0x3FFFFFFF
 
@@ -439,16 +440,22 @@ static void compute_pos_tan(const SkPoint pts[], unsigned segType,
 
 SkContourMeasureIter::SkContourMeasureIter() {
     fTolerance = CHEAP_DIST_LIMIT;
+    fResScale = 1;
     fForceClosed = false;
+    fNextMeasure = 0;
+    fFromCache = false;
+    fCacheable = false;
 }
 
 SkContourMeasureIter::SkContourMeasureIter(const SkPath& path, bool forceClosed,
                                            SkScalar resScale) {
     fPath = path.isFinite() ? path : SkPath();
     fTolerance = CHEAP_DIST_LIMIT * SkScalarInvert(resScale);
+    fResScale = resScale;
     fForceClosed = forceClosed;
 
     fIter.setPath(fPath);
+    this->findInCache();
 }
 
 SkContourMeasureIter::~SkContourMeasureIter() {}
@@ -461,20 +468,43 @@ void SkContourMeasureIter::reset(const SkPath& path, bool forceClosed, SkScalar
     } else {
         fPath.reset();
     }
+    fTolerance = CHEAP_DIST_LIMIT * SkScalarInvert(resScale);
+    fResScale = resScale;
     fForceClosed = forceClosed;
 
     fIter.setPath(fPath);
     fSegments.reset();
     fPts.reset();
+    this->findInCache();
+}
+
+void SkContourMeasureIter::findInCache() {
+    fMeasures.reset();
+    fNextMeasure = 0;
+    fCacheable = !fPath.isVolatile() && !fPath.isEmpty();
+    fFromCache = fCacheable &&
+                 SkContourMeasureCache::Find(fPath, fForceClosed, fResScale, &fMeasures);
 }
 
 sk_sp<SkContourMeasure> SkContourMeasureIter::next() {
+    if (fFromCache) {
+        return fNextMeasure < fMeasures.count() ? fMeasures[fNextMeasure++] : nullptr;
+    }
     while (fIter.peek() != SkPath::kDone_Verb) {
         auto cm = this->buildSegments();
         if (cm) {
-            return sk_sp<SkContourMeasure>(cm);
+            sk_sp<SkContourMeasure> measure(cm);
+            if (fCacheable) {
+                fMeasures.push_back(measure);
+            }
+            return measure;
         }
     }
+    if (fCacheable) {
+        SkContourMeasureCache::Add(fPath, fForceClosed, fResScale, fMeasures);
+        fMeasures.reset();
+        fCacheable = false;
+    }
     return nullptr;
 }
 
@@ -487,48 +517,23 @@ SkContourMeasure::SkContourMeasure(SkTDArray<Segment>&& segs, SkTDArray<SkPoint>
     , fIsClosed(isClosed)
     {}
 
-template <typename T, typename K>
-int SkTKSearch(const T base[], int count, const K& key) {
-    SkASSERT(count >= 0);
-    if (count <= 0) {
-        return ~0;
-    }
-
-    SkASSERT(base != nullptr); // base may be nullptr if count is zero
-
-    unsigned lo = 0;
-    unsigned hi = count - 1;
-
-    while (lo < hi) {
-        unsigned mid = (hi + lo) >> 1;
-        if (base[mid].fDistance < key) {
-            lo = mid + 1;
-        } else {
-            hi = mid;
-        }
-    }
-
-    if (base[hi].fDistance < key) {
-        hi += 1;
-        hi = ~hi;
-    } else if (key < base[hi].fDistance) {
-        hi = ~hi;
-    }
-    return hi;
-}
-
 const SkContourMeasure::Segment* SkContourMeasure::distanceToSegment( SkScalar distance,
                                                                      SkScalar* t) const {
     SkDEBUGCODE(SkScalar length = ) this->length();
     SkASSERT(distance >= 0 && distance <= length);
 
+    // Find the first segment ending at or past distance. This lower bound search selects rather
+    // than branches, so the unpredictable comparisons don't stall getPosTan() on long contours.
     const Segment*  seg = fSegments.begin();
     int             count = fSegments.count();
-
-    int index = SkTKSearch<Segment, SkScalar>(seg, count, distance);
-    // don't care if we hit an exact match or not, so we xor index if it is negative
-    index ^= (index >> 31);
-    seg = &seg[index];
+    SkASSERT(count > 0);
+    while (count > 1) {
+        int half = count >> 1;
+        seg = seg[half].fDistance < distance ? seg + half : seg;
+        count -= half;
+    }
+    seg += seg->fDistance < distance;
+    int index = SkToInt(seg - fSegments.begin());
 
     // now interpolate t-values with the prev segment (if possible)
     SkScalar    startT = 0, startD = 0;
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkContourMeasureCache.h"
+
+#include "SkPathPriv.h"
+
+#define CHECK_LOCAL(localCache, localName, globalName, ...) \
+    ((localCache) ? localCache->localName(__VA_ARGS__) : SkResourceCache::globalName(__VA_ARGS__))
+
+namespace {
+static unsigned gContourMeasureKeyNamespaceLabel;
+
+static uint64_t make_shared_id(uint32_t pathGenID) {
+    uint64_t sharedID = SkSetFourByteTag('c', 'm', 'e', 's');
+    return (sharedID << 32) | pathGenID;
+}
+
+struct ContourMeasureKey : public SkResourceCache::Key {
+public:
+    ContourMeasureKey(const SkPath& path, bool forceClosed, SkScalar resScale)
+        : fResScale(resScale)
+        , fForceClosed(forceClosed)
+    {
+        this->init(&gContourMeasureKeyNamespaceLabel, make_shared_id(path.getGenerationID()),
+                   sizeof(fResScale) + sizeof(fForceClosed));
+    }
+
+    SkScalar fResScale;
+    int32_t  fForceClosed;
+};
+
+// Purges the source path's entries once it changes.
+class PathListener : public SkPathRef::GenIDChangeListener {
+public:
+    explicit PathListener(uint32_t genID) : fGenID(genID) {}
+
+    void onChange() override {
+        SkResourceCache::PostPurgeSharedID(make_shared_id(fGenID));
+    }
+
+private:
+    const uint32_t fGenID;
+};
+
+struct ContourMeasureRec : public SkResourceCache::Rec {
+    ContourMeasureRec(const ContourMeasureKey& key,
+                      const SkContourMeasureCache::Measures& measures, size_t measureBytes,
+                      sk_sp<PathListener> listener)
+        : fKey(key)
+        , fMeasures(measures)
+        , fMeasureBytes(measureBytes)
+        , fListener(std::move(listener)) {}
+
+    ~ContourMeasureRec() override {
+        fListener->markShouldUnregisterFromPath();
+    }
+
+    ContourMeasureKey                fKey;
+    SkContourMeasureCache::Measures  fMeasures;
+    size_t                           fMeasureBytes;
+    sk_sp<PathListener>              fListener;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(*this) + fMeasureBytes; }
+    const char* getCategory() const override { return "contour-measure"; }
+    SkDiscardableMemory* diagnostic_only_getDiscardable() const override { return nullptr; }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const ContourMeasureRec& rec = static_cast<const ContourMeasureRec&>(baseRec);
+        *static_cast<SkContourMeasureCache::Measures*>(contextData) = rec.fMeasures;
+        return true;
+    }
+};
+} // namespace
+
+bool SkContourMeasureCache::Find(const SkPath& path, bool forceClosed, SkScalar resScale,
+                                 Measures* measures, SkResourceCache* localCache) {
+    SkASSERT(!path.isVolatile());
+    ContourMeasureKey key(path, forceClosed, resScale);
+    return CHECK_LOCAL(localCache, find, Find, key, ContourMeasureRec::Visitor, measures);
+}
+
+void SkContourMeasureCache::Add(const SkPath& path, bool forceClosed, SkScalar resScale,
+                                const Measures& measures, SkResourceCache* localCache) {
+    SkASSERT(!path.isVolatile());
+    ContourMeasureKey key(path, forceClosed, resScale);
+    size_t measureBytes = 0;
+    for (const auto& measure : measures) {
+        measureBytes += sizeof(SkContourMeasure) +
+                        measure->fSegments.count() * sizeof(SkContourMeasure::Segment) +
+                        measure->fPts.count() * sizeof(SkPoint);
+    }
+    auto listener = sk_make_sp<PathListener>(path.getGenerationID());
+    SkPathPriv::AddGenIDChangeListener(path, listener);
+    return CHECK_LOCAL(localCache, add, Add,
+                       new ContourMeasureRec(key, measures, measureBytes, std::move(listener)));
+}
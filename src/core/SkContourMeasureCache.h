@@ -0,0 +1,38 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkContourMeasureCache_DEFINED
+#define SkContourMeasureCache_DEFINED
+
+#include "SkContourMeasure.h"
+#include "SkResourceCache.h"
+#include "SkTArray.h"
+
+/**
+ * Caches the contour measures SkContourMeasureIter builds for non-volatile paths, keyed by the
+ * path's generation ID, forceClosed and resScale, so animations that trim or walk the same
+ * paths every frame don't re-measure them. Entries are purged when the source path is modified
+ * or deleted.
+ */
+class SkContourMeasureCache {
+public:
+    using Measures = SkTArray<sk_sp<SkContourMeasure>>;
+
+    /**
+     * On success, sets measures to all of path's (non-empty) contour measures and returns true.
+     */
+    static bool Find(const SkPath& path, bool forceClosed, SkScalar resScale,
+                     Measures* measures, SkResourceCache* localCache = nullptr);
+
+    /**
+     * Records all of path's contour measures. path must not be volatile.
+     */
+    static void Add(const SkPath& path, bool forceClosed, SkScalar resScale,
+                    const Measures& measures, SkResourceCache* localCache = nullptr);
+};
+
+#endif
@@ -13,10 +13,60 @@
 #include "SkImageInfoPriv.h"
 #include "SkOpts.h"
 #include "SkRasterPipeline.h"
+#include "SkTaskGroup.h"
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+    #include <emmintrin.h>
+#endif
+
+// Conversions writing at least this many bytes copy with non-temporal stores, as the destination
+// won't fit in cache anyway and reading it in first only wastes memory bandwidth.
+static constexpr size_t kStreamingBytes = 8 * 1024 * 1024;
+
+// When given an executor, conversions are split into bands of at least this many pixels.
+static constexpr int64_t kMinPixelsPerBand = 256 * 1024;
+static constexpr int     kMaxBands         = 32;
+
+// Like memcpy(), but writes dst without reading it into the cache.  The caller must issue a
+// store fence (see stream_fence()) before the copied pixels are read by another thread.
+static void stream_memcpy(void* dst, const void* src, size_t bytes) {
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+    auto d = (char*)dst;
+    auto s = (const char*)src;
+
+    // Non-temporal stores need a 16-byte aligned destination.
+    size_t head = SkTMin(bytes, (16 - ((uintptr_t)d & 15)) & 15);
+    memcpy(d, s, head);
+    d += head; s += head; bytes -= head;
+
+    for (; bytes >= 64; d += 64, s += 64, bytes -= 64) {
+        __m128i a = _mm_loadu_si128((const __m128i*)s + 0),
+                b = _mm_loadu_si128((const __m128i*)s + 1),
+                c = _mm_loadu_si128((const __m128i*)s + 2),
+                e = _mm_loadu_si128((const __m128i*)s + 3);
+        _mm_stream_si128((__m128i*)d + 0, a);
+        _mm_stream_si128((__m128i*)d + 1, b);
+        _mm_stream_si128((__m128i*)d + 2, c);
+        _mm_stream_si128((__m128i*)d + 3, e);
+    }
+    for (; bytes >= 16; d += 16, s += 16, bytes -= 16) {
+        _mm_stream_si128((__m128i*)d, _mm_loadu_si128((const __m128i*)s));
+    }
+    memcpy(d, s, bytes);
+#else
+    memcpy(dst, src, bytes);
+#endif
+}
+
+static void stream_fence() {
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+    _mm_sfence();
+#endif
+}
 
 static bool rect_memcpy(const SkImageInfo& dstInfo,       void* dstPixels, size_t dstRB,
                         const SkImageInfo& srcInfo, const void* srcPixels, size_t srcRB,
-                        const SkColorSpaceXformSteps& steps) {
+                        const SkColorSpaceXformSteps& steps, bool stream) {
     // We can copy the pixels when no color type, alpha type, or color space changes.
     if (dstInfo.colorType() != srcInfo.colorType()) {
         return false;
@@ -26,8 +76,17 @@ static bool rect_memcpy(const SkImageInfo& dstInfo,       void* dstPixels, size_
         return false;
     }
 
-    SkRectMemcpy(dstPixels, dstRB,
-                 srcPixels, srcRB, dstInfo.minRowBytes(), dstInfo.height());
+    if (!stream) {
+        SkRectMemcpy(dstPixels, dstRB,
+                     srcPixels, srcRB, dstInfo.minRowBytes(), dstInfo.height());
+        return true;
+    }
+    for (int y = 0; y < dstInfo.height(); y++) {
+        stream_memcpy(dstPixels, srcPixels, dstInfo.minRowBytes());
+        dstPixels = SkTAddOffset<void>(dstPixels, dstRB);
+        srcPixels = SkTAddOffset<const void>(srcPixels, srcRB);
+    }
+    stream_fence();
     return true;
 }
 
@@ -178,18 +237,63 @@ static void convert_with_pipeline(const SkImageInfo& dstInfo, void* dstRow, size
     pipeline.run(0,0, srcInfo.width(), srcInfo.height());
 }
 
+static void convert_rows(const SkImageInfo& dstInfo,       void* dstPixels, size_t dstRB,
+                         const SkImageInfo& srcInfo, const void* srcPixels, size_t srcRB,
+                         const SkColorSpaceXformSteps& steps, bool stream) {
+    if (rect_memcpy(dstInfo, dstPixels, dstRB, srcInfo, srcPixels, srcRB, steps, stream)) {
+        return;
+    }
+    for (auto fn : {swizzle_or_premul, convert_to_alpha8}) {
+        if (fn(dstInfo, dstPixels, dstRB, srcInfo, srcPixels, srcRB, steps)) {
+            return;
+        }
+    }
+    convert_with_pipeline(dstInfo, dstPixels, dstRB, srcInfo, srcPixels, srcRB, steps);
+}
+
 void SkConvertPixels(const SkImageInfo& dstInfo,       void* dstPixels, size_t dstRB,
-                     const SkImageInfo& srcInfo, const void* srcPixels, size_t srcRB) {
+                     const SkImageInfo& srcInfo, const void* srcPixels, size_t srcRB,
+                     SkExecutor* executor) {
     SkASSERT(dstInfo.dimensions() == srcInfo.dimensions());
     SkASSERT(SkImageInfoValidConversion(dstInfo, srcInfo));
 
     SkColorSpaceXformSteps steps{srcInfo.colorSpace(), srcInfo.alphaType(),
                                  dstInfo.colorSpace(), dstInfo.alphaType()};
 
-    for (auto fn : {rect_memcpy, swizzle_or_premul, convert_to_alpha8}) {
-        if (fn(dstInfo, dstPixels, dstRB, srcInfo, srcPixels, srcRB, steps)) {
-            return;
-        }
+    // Between normalized color types, table lookups are close enough to exact transfer functions.
+    // (Conversions to alpha never touch color, so they don't need the tables.)
+    auto is_normalized = [](SkColorType ct) {
+        return ct != kRGBA_F16_SkColorType && ct != kRGBA_F32_SkColorType;
+    };
+    if (is_normalized(srcInfo.colorType()) && is_normalized(dstInfo.colorType()) &&
+        dstInfo.colorType() != kAlpha_8_SkColorType) {
+        steps.useTables();
     }
-    convert_with_pipeline(dstInfo, dstPixels, dstRB, srcInfo, srcPixels, srcRB, steps);
+
+    const int width  = dstInfo.width(),
+              height = dstInfo.height();
+    const bool stream = dstInfo.minRowBytes64() * height >= kStreamingBytes;
+
+    int bands = 1;
+    if (executor) {
+        bands = (int)SkTMin<int64_t>(SkTMin(height, kMaxBands),
+                                     (int64_t)width * height / kMinPixelsPerBand);
+    }
+    if (bands <= 1) {
+        convert_rows(dstInfo, dstPixels, dstRB, srcInfo, srcPixels, srcRB, steps, stream);
+        return;
+    }
+
+    // Rows convert independently, so each band just converts its own slice of them.
+    SkTaskGroup tg(*executor);
+    tg.batch(bands, [&](int band) {
+        const int top    = (int)((int64_t)height *  band      / bands),
+                  bottom = (int)((int64_t)height * (band + 1) / bands);
+        convert_rows(dstInfo.makeWH(width, bottom - top),
+                     SkTAddOffset<void>(dstPixels, top * dstRB), dstRB,
+                     srcInfo.makeWH(width, bottom - top),
+                     SkTAddOffset<const void>(srcPixels, top * srcRB), srcRB,
+                     steps, stream);
+    });
+    tg.wait();
 }
@@ -12,9 +12,13 @@
 #include "SkTemplates.h"
 
 class SkColorTable;
+class SkExecutor;
 
+// Converts srcPixels to dstInfo's color type, alpha type and color space.  If executor isn't null,
+// large conversions are split into bands of rows that run on it.
 void SkConvertPixels(const SkImageInfo& dstInfo, void* dstPixels, size_t dstRowBytes,
-                     const SkImageInfo& srcInfo, const void* srcPixels, size_t srcRowBytes);
+                     const SkImageInfo& srcInfo, const void* srcPixels, size_t srcRowBytes,
+                     SkExecutor* executor = nullptr);
 
 static inline void SkRectMemcpy(void* dst, size_t dstRB, const void* src, size_t srcRB,
                                 size_t trimRowBytes, int rowCount) {
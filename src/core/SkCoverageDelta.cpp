@@ -7,6 +7,8 @@
 
 #include "SkCoverageDelta.h"
 
+#include "SkOpts.h"
+
 SkCoverageDeltaList::SkCoverageDeltaList(SkArenaAlloc* alloc, const SkIRect& bounds, bool forceRLE) {
     fAlloc              = alloc;
     fBounds             = bounds;
@@ -80,9 +82,6 @@ SkCoverageDeltaMask::SkCoverageDeltaMask(SkArenaAlloc* alloc, const SkIRect& bou
     fDeltas             = fDeltaStorage + PADDING - this->index(fBounds.fLeft, fBounds.fTop);
 }
 
-// TODO As this function is so performance-critical (and we're thinking so much about SIMD), use
-// SkOpts framework to compile multiple versions of this function so we can choose the best one
-// available at runtime.
 void SkCoverageDeltaMask::convertCoverageToAlpha(bool isEvenOdd, bool isInverse, bool isConvex) {
     SkFixed* deltaRow = &this->delta(fBounds.fLeft, fBounds.fTop);
     SkAlpha* maskRow = fMask;
@@ -111,23 +110,8 @@ void SkCoverageDeltaMask::convertCoverageToAlpha(bool isEvenOdd, bool isInverse,
         }
 
         // Otherwise, cumulate deltas into coverages, and convert them into alphas
-        SkFixed c[SIMD_WIDTH] = {0}; // prepare SIMD_WIDTH coverages at a time
-        for(int ix = 0; ix < fExpandedWidth; ix += SIMD_WIDTH) {
-            // Future todo: is it faster to process SIMD_WIDTH rows at a time so we can use SIMD
-            // for coverage accumulation?
-
-            // Cumulate deltas to get SIMD_WIDTH new coverages
-            c[0] = c[SIMD_WIDTH - 1] + deltaRow[ix];
-            for(int j = 1; j < SIMD_WIDTH; ++j) {
-                c[j] = c[j - 1] + deltaRow[ix + j];
-            }
-
-            using SkNi = SkNx<SIMD_WIDTH, int>;
-            SkNi cn = SkNi::Load(c);
-            SkNi an = isConvex ? ConvexCoverageToAlpha(cn, isInverse)
-                               : CoverageToAlpha(cn, isEvenOdd, isInverse);
-            SkNx_cast<SkAlpha>(an).store(maskRow + ix);
-        }
+        SkOpts::accumulate_coverage_deltas(deltaRow, maskRow, fExpandedWidth,
+                                           isEvenOdd, isInverse, isConvex);
 
         // Finally, advance to the next row
         deltaRow    += fExpandedWidth;
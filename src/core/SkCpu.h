@@ -88,6 +88,10 @@ inline bool SkCpu::Supports(uint32_t mask) {
     // It's available on Haswell+ just like AVX2, but it's technically a different bit.
     // TODO: circle back on this if we find ourselves limited by lack of compile-time FMA
 
+    #if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SKX
+    features |= AVX512F | AVX512DQ | AVX512CD | AVX512BW | AVX512VL;
+    #endif
+
     #if defined(SK_CPU_LIMIT_SSE41)
     features &= (SkCpu::SSE1 | SkCpu::SSE2 | SkCpu::SSE3 | SkCpu::SSSE3 | SkCpu::SSE41);
     #elif defined(SK_CPU_LIMIT_SSE2)
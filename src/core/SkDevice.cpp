@@ -140,9 +140,8 @@ void SkBaseDevice::drawEdgeAARect(const SkRect& r, SkCanvas::QuadAAFlags aa, SkC
 
 void SkBaseDevice::drawPatch(const SkPoint cubics[12], const SkColor colors[4],
                              const SkPoint texCoords[4], SkBlendMode bmode, const SkPaint& paint) {
-    SkISize lod = SkPatchUtils::GetLevelOfDetail(cubics, &this->ctm());
-    auto vertices = SkPatchUtils::MakeVertices(cubics, colors, texCoords, lod.width(), lod.height(),
-                                               this->imageInfo().colorSpace());
+    auto vertices = SkPatchUtils::MakeCachedVertices(cubics, colors, texCoords, this->ctm(),
+                                                     this->imageInfo().colorSpace());
     if (vertices) {
         this->drawVertices(vertices.get(), nullptr, 0, bmode, paint);
     }
@@ -289,6 +288,11 @@ sk_sp<SkSpecialImage> SkBaseDevice::makeSpecial(const SkBitmap&) { return nullpt
 sk_sp<SkSpecialImage> SkBaseDevice::makeSpecial(const SkImage*) { return nullptr; }
 sk_sp<SkSpecialImage> SkBaseDevice::snapSpecial() { return nullptr; }
 
+sk_sp<SkSpecialImage> SkBaseDevice::snapSpecialSubset(const SkIRect& subset) {
+    sk_sp<SkSpecialImage> special = this->snapSpecial();
+    return special ? special->makeSubset(subset) : nullptr;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 bool SkBaseDevice::readPixels(const SkPixmap& pm, int x, int y) {
@@ -245,6 +245,10 @@ protected:
     virtual sk_sp<SkSpecialImage> makeSpecial(const SkBitmap&);
     virtual sk_sp<SkSpecialImage> makeSpecial(const SkImage*);
     virtual sk_sp<SkSpecialImage> snapSpecial();
+    // Like snapSpecial(), but the result only needs the device's pixels inside 'subset' (in device
+    // space), and its subset is offset to match. Devices that can sample their pixels in place
+    // share them; others only copy 'subset'.
+    virtual sk_sp<SkSpecialImage> snapSpecialSubset(const SkIRect& subset);
     virtual void setImmutable() {}
 
     bool readPixels(const SkPixmap&, int x, int y);
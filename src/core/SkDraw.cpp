@@ -29,6 +29,7 @@
 #include "SkShader.h"
 #include "SkString.h"
 #include "SkStroke.h"
+#include "SkStrokeCache.h"
 #include "SkStrokeRec.h"
 #include "SkTLazy.h"
 #include "SkTemplates.h"
@@ -880,6 +881,78 @@ void SkDraw::drawDevPath(const SkPath& devPath, const SkPaint& paint, bool drawC
     proc(devPath, *fRC, blitter);
 }
 
+bool SkDraw::drawThinStroke(const SkPath& path, const SkPaint& paint, const SkMatrix& matrix,
+                            bool drawCoverage, SkBlitter* customBlitter) const {
+    if (!paint.isAntiAlias() || paint.getStyle() != SkPaint::kStroke_Style ||
+        paint.getMaskFilter() || !matrix.isSimilarity()) {
+        return false;
+    }
+    SkScalar scale = matrix.getMaxScale();
+
+    // Dashes are stepped along the device space path, so their intervals scale with it.
+    SkScan::ThinDash dash;
+    SkAutoSTMalloc<8, SkScalar> intervals;
+    SkPathEffect* pathEffect = paint.getPathEffect();
+    if (pathEffect) {
+        SkPathEffect::DashInfo info;
+        if (SkPathEffect::kDash_DashType != pathEffect->asADash(&info)) {
+            return false;
+        }
+        info.fIntervals = intervals.reset(info.fCount);
+        pathEffect->asADash(&info);
+        dash = { info.fIntervals, info.fCount, info.fPhase, scale };
+    }
+
+    // Undashed hairlines have their own scan converters, dashed ones are drawn a pixel wide.
+    SkScalar devWidth = paint.getStrokeWidth() * scale;
+    if (0 == paint.getStrokeWidth() && pathEffect) {
+        devWidth = 1;
+    }
+    if (!(devWidth > 0 && devWidth <= SkScan::kMaxThinStrokeWidth)) {
+        return false;
+    }
+
+    SkPath devPath;
+    path.transform(matrix, &devPath);
+    if (!devPath.isFinite() || SkPathPriv::TooBigForMath(devPath)) {
+        return false;
+    }
+    SkAutoBlitterChoose blitterStorage;
+    SkBlitter* blitter = customBlitter;
+    if (nullptr == blitter) {
+        blitter = blitterStorage.choose(*this, nullptr, paint, drawCoverage);
+    }
+    return SkScan::AntiStrokeThinPath(devPath, devWidth, paint, *fRC, blitter,
+                                      pathEffect ? &dash : nullptr);
+}
+
+// Like SkPaint::getFillPath(), but reuses earlier strokes of the same non-volatile path.
+static bool get_fill_path(const SkPaint& paint, const SkPath& src, SkPath* dst,
+                          const SkRect* cullRect, SkScalar resScale) {
+    if (paint.getPathEffect() || src.isVolatile() || !src.isFinite()) {
+        return paint.getFillPath(src, dst, cullRect, resScale);
+    }
+    resScale = SkStrokeCache::BucketResScale(resScale);
+    SkStrokeRec rec(paint, resScale);
+    if (!rec.needToApply()) {
+        return paint.getFillPath(src, dst, cullRect, resScale);
+    }
+
+    // dst's flags describe how it's drawn, not its contents, so keep them.
+    bool isVolatile = dst->isVolatile(),
+         isBadForDAA = SkPathPriv::IsBadForDAA(*dst);
+    bool found = SkStrokeCache::Find(src, rec, dst);
+    if (!found && !paint.getFillPath(src, dst, cullRect, resScale)) {
+        return false;
+    }
+    if (!found) {
+        SkStrokeCache::Add(src, rec, *dst);
+    }
+    dst->setIsVolatile(isVolatile);
+    SkPathPriv::SetIsBadForDAA(*dst, isBadForDAA);
+    return true;
+}
+
 void SkDraw::drawPath(const SkPath& origSrcPath, const SkPaint& origPaint,
                       const SkMatrix* prePathMatrix, bool pathIsMutable,
                       bool drawCoverage, SkBlitter* customBlitter) const {
@@ -943,14 +1016,18 @@ void SkDraw::drawPath(const SkPath& origSrcPath, const SkPaint& origPaint,
         }
     }
 
+    if (this->drawThinStroke(*pathPtr, *paint, *matrix, drawCoverage, customBlitter)) {
+        return;
+    }
+
     if (paint->getPathEffect() || paint->getStyle() != SkPaint::kFill_Style) {
         SkRect cullRect;
         const SkRect* cullRectPtr = nullptr;
         if (this->computeConservativeLocalClipBounds(&cullRect)) {
             cullRectPtr = &cullRect;
         }
-        doFill = paint->getFillPath(*pathPtr, tmpPath, cullRectPtr,
-                                    ComputeResScaleForStroking(*fMatrix));
+        doFill = get_fill_path(*paint, *pathPtr, tmpPath, cullRectPtr,
+                               ComputeResScaleForStroking(*fMatrix));
         pathPtr = tmpPath;
     }
 
@@ -138,6 +138,14 @@ private:
 
     void drawLine(const SkPoint[2], const SkPaint&) const;
 
+    // Draws thin antialiased strokes, optionally dashed, without stroking them into a path first.
+    // Returns false if the path or paint aren't suitable.
+    bool drawThinStroke(const SkPath& path,
+                        const SkPaint& paint,
+                        const SkMatrix& matrix,
+                        bool drawCoverage,
+                        SkBlitter* customBlitter) const;
+
     void drawDevPath(const SkPath& devPath,
                      const SkPaint& paint,
                      bool drawCoverage,
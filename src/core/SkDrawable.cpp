@@ -7,6 +7,7 @@
 
 #include "SkCanvas.h"
 #include "SkDrawable.h"
+#include "SkPicture.h"
 #include <atomic>
 
 static int32_t next_generation_id() {
@@ -19,7 +20,12 @@ static int32_t next_generation_id() {
     return id;
 }
 
-SkDrawable::SkDrawable() : fGenerationID(0) {}
+SkDrawable::SkDrawable()
+    : fGenerationID(0)
+    , fSnapshotGenerationID(0)
+    , fCachesSnapshots(false) {}
+
+SkDrawable::~SkDrawable() {}
 
 static void draw_bbox(SkCanvas* canvas, const SkRect& r) {
     SkPaint paint;
@@ -35,7 +41,12 @@ void SkDrawable::draw(SkCanvas* canvas, const SkMatrix* matrix) {
     if (matrix) {
         canvas->concat(*matrix);
     }
-    this->onDraw(canvas);
+    if (fCachesSnapshots) {
+        sk_sp<SkPicture> snapshot(this->newPictureSnapshot());
+        canvas->drawPicture(snapshot);
+    } else {
+        this->onDraw(canvas);
+    }
 
     if (false) {
         draw_bbox(canvas, this->getBounds());
@@ -48,7 +59,15 @@ void SkDrawable::draw(SkCanvas* canvas, SkScalar x, SkScalar y) {
 }
 
 SkPicture* SkDrawable::newPictureSnapshot() {
-    return this->onNewPictureSnapshot();
+    if (!fCachesSnapshots) {
+        return this->onNewPictureSnapshot();
+    }
+    const uint32_t genID = this->getGenerationID();
+    if (!fSnapshot || fSnapshotGenerationID != genID) {
+        fSnapshot.reset(this->onNewPictureSnapshot());
+        fSnapshotGenerationID = genID;
+    }
+    return SkSafeRef(fSnapshot.get());
 }
 
 uint32_t SkDrawable::getGenerationID() {
@@ -64,6 +83,14 @@ SkRect SkDrawable::getBounds() {
 
 void SkDrawable::notifyDrawingChanged() {
     fGenerationID = 0;
+    fSnapshot.reset();
+}
+
+void SkDrawable::setCachesSnapshots(bool cachesSnapshots) {
+    fCachesSnapshots = cachesSnapshots;
+    if (!fCachesSnapshots) {
+        fSnapshot.reset();
+    }
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -75,7 +102,8 @@ SkPicture* SkDrawable::onNewPictureSnapshot() {
 
     const SkRect bounds = this->getBounds();
     SkCanvas* canvas = recorder.beginRecording(bounds, nullptr, 0);
-    this->draw(canvas);
+    // Not draw(), which may be playing back this very snapshot.
+    this->onDraw(canvas);
     if (false) {
         draw_bbox(canvas, bounds);
     }
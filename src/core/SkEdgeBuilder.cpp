@@ -344,6 +344,11 @@ int SkEdgeBuilder::build(const SkPath& path, const SkIRect* iclip, bool canCullT
 
     bool is_finite = true;
 
+    // Unclipped lines, quads and cubics each make at most one edge per point once they're chopped
+    // at their y extrema, so this usually spares paths with thousands of edges from regrowing
+    // fList over and over. Conics and clipping may still need more.
+    fList.setReserve(path.countPoints());
+
     if (iclip) {
         SkRect clip = this->recoverClip(*iclip);
         SkEdgeClipper clipper(canCullToTheRight);
@@ -11,6 +11,7 @@
 #include "SkSemaphore.h"
 #include "SkSpinlock.h"
 #include "SkTArray.h"
+#include <atomic>
 #include <deque>
 #include <thread>
 
@@ -131,6 +132,140 @@ private:
     SkSemaphore           fWorkAvailable;
 };
 
+// An SkWorkStealingThreadPool gives each of its threads a lock and queue of its own, so threads
+// only contend when one runs out of work and steals from another. A thread runs the newest work
+// on its own queue first, while it is likely still in cache, and steals the oldest work from
+// others. Background work waits for all the other work in the pool.
+class SkWorkStealingThreadPool final : public SkExecutor {
+public:
+    explicit SkWorkStealingThreadPool(int threads)
+        : fWorkers(new Worker[threads])
+        , fWorkerCount(threads)
+        , fNextWorker(0) {
+        for (int i = 0; i < threads; i++) {
+            fThreads.emplace_back(&Loop, this, i);
+        }
+        // Work can only be added from a pool thread once we return, so it's safe to fill this in
+        // after the threads have started.
+        for (int i = 0; i < threads; i++) {
+            fThreadIDs.push_back(fThreads[i].get_id());
+        }
+    }
+
+    ~SkWorkStealingThreadPool() override {
+        // Signal each thread that it's time to shut down, after all other work.
+        for (int i = 0; i < fThreads.count(); i++) {
+            this->push(i, kBackground, nullptr);
+        }
+        for (int i = 0; i < fThreads.count(); i++) {
+            fThreads[i].join();
+        }
+    }
+
+    void add(std::function<void(void)> work) override {
+        this->push(this->pickWorker(), kNormal, std::move(work));
+    }
+
+    void addBackground(std::function<void(void)> work) override {
+        this->push(this->pickWorker(), kBackground, std::move(work));
+    }
+
+    void borrow() override {
+        if (fWorkAvailable.try_wait()) {
+            SkAssertResult(this->do_work(this->currentWorker()));
+        }
+    }
+
+private:
+    enum Priority { kNormal, kBackground, kPriorityCount };
+
+    struct Worker {
+        SkSpinlock                            fLock;
+        std::deque<std::function<void(void)>> fWork[kPriorityCount];
+    };
+
+    // Returns the index of the pool thread calling this, or -1 if it is not one of ours.
+    int currentWorker() const {
+        const std::thread::id id = std::this_thread::get_id();
+        for (int i = 0; i < fThreadIDs.count(); i++) {
+            if (fThreadIDs[i] == id) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    int pickWorker() {
+        int worker = this->currentWorker();
+        if (worker < 0) {
+            worker = fNextWorker.fetch_add(1, std::memory_order_relaxed) % fWorkerCount;
+        }
+        return worker;
+    }
+
+    void push(int worker, Priority priority, std::function<void(void)> work) {
+        {
+            SkAutoExclusive lock(fWorkers[worker].fLock);
+            fWorkers[worker].fWork[priority].emplace_back(std::move(work));
+        }
+        fWorkAvailable.signal(1);
+    }
+
+    // Pops the highest priority work, preferring self's own newest work and then the oldest work
+    // of the other threads. Background work, including the shutdown signals, always runs oldest
+    // first so that shutting down waits for it.
+    bool try_pop(int self, std::function<void(void)>* work) {
+        for (int priority = 0; priority < kPriorityCount; priority++) {
+            for (int i = 0; i < fWorkerCount; i++) {
+                const int victim = self >= 0 ? (self + i) % fWorkerCount : i;
+                Worker& worker = fWorkers[victim];
+                SkAutoExclusive lock(worker.fLock);
+                auto& list = worker.fWork[priority];
+                if (list.empty()) {
+                    continue;
+                }
+                if (victim == self && priority == kNormal) {
+                    *work = std::move(list.back());
+                    list.pop_back();
+                } else {
+                    *work = std::move(list.front());
+                    list.pop_front();
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // This method should be called only when fWorkAvailable indicates there's work to do.
+    bool do_work(int self) {
+        std::function<void(void)> work;
+        // Each successful wait on fWorkAvailable has work waiting for it somewhere, but another
+        // thread may take it from a queue we've already looked at, leaving us another to find.
+        while (!this->try_pop(self, &work)) {}
+
+        if (!work) {
+            return false;  // This is Loop()'s signal to shut down.
+        }
+
+        work();
+        return true;
+    }
+
+    static void Loop(SkWorkStealingThreadPool* pool, int self) {
+        do {
+            pool->fWorkAvailable.wait();
+        } while (pool->do_work(self));
+    }
+
+    std::unique_ptr<Worker[]> fWorkers;
+    const int                 fWorkerCount;
+    SkTArray<std::thread>     fThreads;
+    SkTArray<std::thread::id> fThreadIDs;
+    std::atomic<unsigned>     fNextWorker;
+    SkSemaphore               fWorkAvailable;
+};
+
 std::unique_ptr<SkExecutor> SkExecutor::MakeFIFOThreadPool(int threads) {
     using WorkList = std::deque<std::function<void(void)>>;
     return skstd::make_unique<SkThreadPool<WorkList>>(threads > 0 ? threads : num_cores());
@@ -139,3 +274,6 @@ std::unique_ptr<SkExecutor> SkExecutor::MakeLIFOThreadPool(int threads) {
     using WorkList = SkTArray<std::function<void(void)>>;
     return skstd::make_unique<SkThreadPool<WorkList>>(threads > 0 ? threads : num_cores());
 }
+std::unique_ptr<SkExecutor> SkExecutor::MakeWorkStealingThreadPool(int threads) {
+    return skstd::make_unique<SkWorkStealingThreadPool>(threads > 0 ? threads : num_cores());
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkGlyphOutlineCache.h"
+
+#include "SkDescriptor.h"
+
+// Each maker holds an open scaler context, so only keep them for typefaces in active use.
+static constexpr int kMaxMakers = 16;
+
+SkGlyphOutlineCache* SkGlyphOutlineCache::Global() {
+    static auto* cache = new SkGlyphOutlineCache;
+    return cache;
+}
+
+SkGlyphOutlineCache::SkGlyphOutlineCache(int countLimit)
+    : fOutlines(countLimit)
+    , fMakers(kMaxMakers) {}
+
+SkGlyphOutlineCache::~SkGlyphOutlineCache() = default;
+
+SkGlyphOutlineCache::Maker::Maker(const SkTypeface& typeface)
+    : fUnitsPerEm(typeface.getUnitsPerEm()) {
+    if (fUnitsPerEm > 0) {
+        SkAutoDescriptor ad;
+        SkScalerContext::MakeDescriptorForPaths(typeface.uniqueID(), &ad, fUnitsPerEm);
+        fContext = typeface.createScalerContext(SkScalerContextEffects(), ad.getDesc(), true);
+    }
+}
+
+bool SkGlyphOutlineCache::findOutline(const SkTypeface& typeface, SkGlyphID glyphID,
+                                      Outline* outline) {
+    const SkFontID fontID = typeface.uniqueID();
+    const uint64_t key = Key(fontID, glyphID);
+    sk_sp<Maker> maker;
+    {
+        SkAutoMutexAcquire lock(fMutex);
+        if (Outline* found = fOutlines.find(key)) {
+            *outline = *found;
+            return true;
+        }
+        if (sk_sp<Maker>* found = fMakers.find(fontID)) {
+            maker = *found;
+        }
+    }
+
+    if (!maker) {
+        // Opening the typeface can be slow, so don't hold up other typefaces while it happens.
+        maker = sk_make_sp<Maker>(typeface);
+        SkAutoMutexAcquire lock(fMutex);
+        if (sk_sp<Maker>* found = fMakers.find(fontID)) {
+            maker = *found;
+        } else {
+            fMakers.insert(fontID, maker);
+        }
+    }
+    if (!maker->fContext) {
+        return false;
+    }
+
+    outline->fUnitsPerEm = SkIntToScalar(maker->fUnitsPerEm);
+    {
+        SkAutoMutexAcquire lock(maker->fMutex);
+        outline->fHasPath = maker->fContext->generatePath(glyphID, &outline->fPath);
+    }
+    if (!outline->fHasPath) {
+        outline->fPath.reset();
+    }
+
+    SkAutoMutexAcquire lock(fMutex);
+    if (!fOutlines.find(key)) {
+        fOutlines.insert(key, *outline);
+    }
+    return true;
+}
+
+void SkGlyphOutlineCache::purgeAll() {
+    SkAutoMutexAcquire lock(fMutex);
+    fOutlines.reset();
+    fMakers.reset();
+}
+
+int SkGlyphOutlineCache::getCountUsed() {
+    SkAutoMutexAcquire lock(fMutex);
+    return fOutlines.count();
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkGlyphOutlineCache_DEFINED
+#define SkGlyphOutlineCache_DEFINED
+
+#include "SkLRUCache.h"
+#include "SkMutex.h"
+#include "SkPath.h"
+#include "SkRefCnt.h"
+#include "SkScalerContext.h"
+#include "SkTypeface.h"
+
+#ifndef SK_DEFAULT_GLYPH_OUTLINE_CACHE_COUNT_LIMIT
+    #define SK_DEFAULT_GLYPH_OUTLINE_CACHE_COUNT_LIMIT  4096
+#endif
+
+/**
+ * Holds glyph outlines independent of size and matrix: each outline is the unhinted glyph at a
+ * text size of its typeface's units per em, so every strike of a typeface can make its paths by
+ * transforming the one outline rather than each decomposing the glyph again. Outlines for the
+ * least recently used glyphs are dropped once the cache holds more than its count limit.
+ *
+ * Thread safe. Outlines for different typefaces are generated concurrently.
+ */
+class SkGlyphOutlineCache : SkNoncopyable {
+public:
+    static SkGlyphOutlineCache* Global();
+
+    explicit SkGlyphOutlineCache(int countLimit = SK_DEFAULT_GLYPH_OUTLINE_CACHE_COUNT_LIMIT);
+    ~SkGlyphOutlineCache();
+
+    struct Outline {
+        SkPath   fPath;        // In font units, y down, with the origin at the glyph's origin.
+        SkScalar fUnitsPerEm;
+        bool     fHasPath;     // False if the glyph has no outline, e.g. a bitmap glyph.
+    };
+
+    /** Finds the outline of glyphID in typeface, generating it if it isn't cached.
+     *  Returns false if the typeface's outlines can't be cached (it has no units per em).
+     */
+    bool findOutline(const SkTypeface& typeface, SkGlyphID glyphID, Outline* outline);
+
+    void purgeAll();
+    int getCountUsed();
+
+private:
+    // Generates outlines for one typeface with a scaler context at its units per em.
+    struct Maker : public SkNVRefCnt<Maker> {
+        explicit Maker(const SkTypeface& typeface);
+
+        const int                        fUnitsPerEm;
+        SkMutex                          fMutex;  // Scaler contexts are used by one thread.
+        std::unique_ptr<SkScalerContext> fContext;
+    };
+
+    static uint64_t Key(SkFontID fontID, SkGlyphID glyphID) {
+        return (uint64_t)fontID << 16 | glyphID;
+    }
+
+    SkMutex                            fMutex;  // Guards fOutlines and fMakers.
+    SkLRUCache<uint64_t, Outline>      fOutlines;
+    SkLRUCache<SkFontID, sk_sp<Maker>> fMakers;
+};
+
+#endif
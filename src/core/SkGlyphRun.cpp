@@ -173,6 +173,14 @@ void SkGlyphRunBuilder::drawTextUTF8(const SkPaint& paint, const SkFont& font, c
 
 void SkGlyphRunBuilder::drawTextBlob(const SkPaint& paint, const SkTextBlob& blob, SkPoint origin,
                                      SkBaseDevice* device) {
+    // A blob's glyph runs don't depend on the origin, paint, device or matrix, so the blob drawn
+    // last (e.g. redrawn every frame, or once per layer) reuses the runs already built for it.
+    if (blob.uniqueID() == fGlyphRunListBlobID) {
+        this->makeGlyphRunList(paint, &blob, origin);
+        device->drawGlyphRunList(this->useGlyphRunList());
+        return;
+    }
+
     // Figure out all the storage needed to pre-size everything below.
     size_t totalGlyphs = 0;
     for (SkTextBlobRunIterator it(&blob); !it.done(); it.next()) {
@@ -183,6 +191,7 @@ void SkGlyphRunBuilder::drawTextBlob(const SkPaint& paint, const SkTextBlob& blo
     this->initialize(totalGlyphs);
 
     SkPoint* positions = fPositions;
+    bool hasRSXformRuns = false;
 
     for (SkTextBlobRunIterator it(&blob); !it.done(); it.next()) {
         // applyFontToPaint() always overwrites the exact same attributes,
@@ -221,6 +230,7 @@ void SkGlyphRunBuilder::drawTextBlob(const SkPaint& paint, const SkTextBlob& blo
 
                 // re-init in case we keep looping and need the builder again
                 this->initialize(totalGlyphs);
+                hasRSXformRuns = true;
             } break;
         }
 
@@ -230,6 +240,12 @@ void SkGlyphRunBuilder::drawTextBlob(const SkPaint& paint, const SkTextBlob& blo
     if (!this->empty()) {
         this->makeGlyphRunList(paint, &blob, origin);
         device->drawGlyphRunList(this->useGlyphRunList());
+
+        // RSXform runs are drawn separately, so only a blob without them has all of its runs in
+        // the list.
+        if (!hasRSXformRuns) {
+            fGlyphRunListBlobID = blob.uniqueID();
+        }
     }
 }
 
@@ -254,6 +270,7 @@ void SkGlyphRunBuilder::initialize(size_t totalRunSize) {
     }
 
     fGlyphRunListStorage.clear();
+    fGlyphRunListBlobID = SK_InvalidUniqueID;
 }
 
 SkSpan<const SkGlyphID> SkGlyphRunBuilder::textToGlyphIDs(
@@ -163,6 +163,10 @@ private:
     std::vector<SkGlyphRun> fGlyphRunListStorage;
     SkGlyphRunList fGlyphRunList;
 
+    // The unique ID of the blob whose runs are all in fGlyphRunListStorage, if any. The runs
+    // point into the blob, so they're only reused when drawing that blob again.
+    uint32_t fGlyphRunListBlobID{SK_InvalidUniqueID};
+
     // Used as a temporary for preparing using utfN text. This implies that only one run of
     // glyph ids will ever be needed because blobs are already glyph based.
     std::vector<SkGlyphID> fScratchGlyphIDs;
@@ -23,6 +23,7 @@
 #include "SkDevice.h"
 #include "SkDistanceFieldGen.h"
 #include "SkDraw.h"
+#include "SkExecutor.h"
 #include "SkFontPriv.h"
 #include "SkMaskFilter.h"
 #include "SkPaintPriv.h"
@@ -188,7 +189,8 @@ void SkGlyphRunListPainter::drawForBitmapDevice(
             SkFont  pathFont{runFont};
             SkScalar textScale = pathFont.setupForAsPaths(&pathPaint);
 
-            auto pathCache = SkStrikeCache::FindOrCreateStrikeExclusive(
+            // Shared strikes let other threads drawing this font find its glyphs concurrently.
+            auto pathCache = SkStrikeCache::FindOrCreateSharedStrike(
                                 pathFont, pathPaint, props,
                                 fScalerContextFlags, SkMatrix::I());
 
@@ -198,9 +200,9 @@ void SkGlyphRunListPainter::drawForBitmapDevice(
             for (auto glyphID : glyphRun.glyphsIDs()) {
                 SkPoint position = *positionCursor++;
                 if (check_glyph_position(position)) {
-                    const SkGlyph& glyph = pathCache->getGlyphMetrics(glyphID, {0, 0});
+                    const SkGlyph& glyph = pathCache.getGlyphMetrics(glyphID, {0, 0});
                     if (!glyph.isEmpty()) {
-                        const SkPath* path = pathCache->findPath(glyph);
+                        const SkPath* path = pathCache.findPath(glyph);
                         if (path != nullptr) {
                             pathsAndPositions.push_back(SkPathPos{path, position});
                         }
@@ -217,30 +219,44 @@ void SkGlyphRunListPainter::drawForBitmapDevice(
                     SkSpan<const SkPathPos>{pathsAndPositions.begin(), pathsAndPositions.size()},
                     textScale, pathPaint);
         } else {
-            auto cache = SkStrikeCache::FindOrCreateStrikeExclusive(
+            auto cache = SkStrikeCache::FindOrCreateSharedStrike(
                                         runFont, runPaint, props,
                                         fScalerContextFlags, deviceMatrix);
 
             // Add rounding and origin.
             SkMatrix matrix = deviceMatrix;
             matrix.preTranslate(origin.x(), origin.y());
-            SkPoint rounding = cache->rounding();
+            SkPoint rounding = cache.rounding();
             matrix.postTranslate(rounding.x(), rounding.y());
             matrix.mapPoints(fPositions, glyphRun.positions().data(), runSize);
 
-            SkTDArray<SkMask> masks;
-            masks.setReserve(runSize);
+            SkTDArray<const SkGlyph*> glyphs;
+            SkTDArray<SkPoint> glyphPositions;
+            glyphs.setReserve(runSize);
+            glyphPositions.setReserve(runSize);
             const SkPoint* positionCursor = fPositions;
             for (auto glyphID : glyphRun.glyphsIDs()) {
                 auto position = *positionCursor++;
                 if (check_glyph_position(position)) {
-                    const SkGlyph& glyph = cache->getGlyphMetrics(glyphID, position);
-                    const void* image;
-                    if (!glyph.isEmpty() && (image = cache->findImage(glyph))) {
-                        masks.push_back(create_mask(glyph, position, image));
+                    const SkGlyph& glyph = cache.getGlyphMetrics(glyphID, position);
+                    if (!glyph.isEmpty()) {
+                        glyphs.push_back(&glyph);
+                        glyphPositions.push_back(position);
                     }
                 }
             }
+
+            // Rasterize all of the run's missing glyphs in one go.
+            cache.prepareImages(SkSpan<const SkGlyph* const>{glyphs.begin(), glyphs.size()},
+                                &SkExecutor::GetDefault());
+
+            SkTDArray<SkMask> masks;
+            masks.setReserve(glyphs.count());
+            for (int i = 0; i < glyphs.count(); ++i) {
+                if (const void* image = cache.findImage(*glyphs[i])) {
+                    masks.push_back(create_mask(*glyphs[i], glyphPositions[i], image));
+                }
+            }
             bitmapDevice->paintMasks(SkSpan<const SkMask>{masks.begin(), masks.size()}, runPaint);
         }
     }
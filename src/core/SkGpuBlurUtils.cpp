@@ -22,6 +22,10 @@
 #include "SkGr.h"
 
 #define MAX_BLUR_SIGMA 4.0f
+// The largest sigma convolved directly when GrContextOptions::fReducedQualityBlurs is set.
+#define MAX_REDUCED_QUALITY_BLUR_SIGMA 2.0f
+// The most that decimate() shrinks each axis by in one pass.
+#define MAX_DECIMATION_PER_PASS 4
 
 using Direction = GrGaussianConvolutionFragmentProcessor::Direction;
 
@@ -39,31 +43,24 @@ static void scale_irect(SkIRect* rect, int xScale, int yScale) {
     rect->fBottom *= yScale;
 }
 
-#ifdef SK_DEBUG
-static inline int is_even(int x) { return !(x & 1); }
-#endif
-
-static void shrink_irect_by_2(SkIRect* rect, bool xAxis, bool yAxis) {
-    if (xAxis) {
-        SkASSERT(is_even(rect->fLeft) && is_even(rect->fRight));
-        rect->fLeft /= 2;
-        rect->fRight /= 2;
-    }
-    if (yAxis) {
-        SkASSERT(is_even(rect->fTop) && is_even(rect->fBottom));
-        rect->fTop /= 2;
-        rect->fBottom /= 2;
-    }
+static void shrink_irect(SkIRect* rect, int xScale, int yScale) {
+    SkASSERT(rect->fLeft % xScale == 0 && rect->fRight  % xScale == 0);
+    SkASSERT(rect->fTop  % yScale == 0 && rect->fBottom % yScale == 0);
+    rect->fLeft   /= xScale;
+    rect->fTop    /= yScale;
+    rect->fRight  /= xScale;
+    rect->fBottom /= yScale;
 }
 
-static float adjust_sigma(float sigma, int maxTextureSize, int *scaleFactor, int *radius) {
+static float adjust_sigma(float sigma, float maxSigma, int maxTextureSize, int *scaleFactor,
+                          int *radius) {
     *scaleFactor = 1;
-    while (sigma > MAX_BLUR_SIGMA) {
+    while (sigma > maxSigma) {
         *scaleFactor *= 2;
         sigma *= 0.5f;
         if (*scaleFactor > maxTextureSize) {
             *scaleFactor = maxTextureSize;
-            sigma = MAX_BLUR_SIGMA;
+            sigma = maxSigma;
         }
     }
     *radius = static_cast<int>(ceilf(sigma * 3.0f));
@@ -295,8 +292,14 @@ static sk_sp<GrTextureProxy> decimate(GrRecordingContext* context,
         return nullptr;
     }
 
-    for (int i = 1; i < scaleFactorX || i < scaleFactorY; i *= 2) {
-        shrink_irect_by_2(&dstRect, i < scaleFactorX, i < scaleFactorY);
+    // Each pass shrinks by up to MAX_DECIMATION_PER_PASS in each axis. A 2x pass is one bilinear
+    // sample at the corner of each 2x2 block; larger passes average their whole block with a box
+    // kernel, which matches a chain of 2x passes without drawing the intermediate levels.
+    for (int doneX = 1, doneY = 1; doneX < scaleFactorX || doneY < scaleFactorY;) {
+        const int stepX = SkTMin(scaleFactorX / doneX, MAX_DECIMATION_PER_PASS),
+                  stepY = SkTMin(scaleFactorY / doneY, MAX_DECIMATION_PER_PASS);
+        const bool firstPass = 1 == doneX && 1 == doneY;
+        shrink_irect(&dstRect, stepX, stepY);
 
         // We know this will not be the final draw so we are free to make it an approx match.
         dstRenderTargetContext = context->priv().makeDeferredRenderTargetContext(
@@ -312,15 +315,36 @@ static sk_sp<GrTextureProxy> decimate(GrRecordingContext* context,
         }
 
         GrPaint paint;
-        if (GrTextureDomain::kIgnore_Mode != mode && i == 1) {
+        SkRect sampleRect;
+        if (stepX > 2 || stepY > 2) {
+            float kernel[MAX_DECIMATION_PER_PASS * MAX_DECIMATION_PER_PASS];
+            for (int i = 0; i < stepX * stepY; ++i) {
+                kernel[i] = 1.0f / (stepX * stepY);
+            }
+            SkIRect domain = srcRect;
+            GrTextureDomain::Mode boxMode = GrTextureDomain::kIgnore_Mode;
+            if (GrTextureDomain::kIgnore_Mode != mode && firstPass) {
+                domain = *contentRect;
+                boxMode = mode;
+                srcRect.offset(-(*srcOffset));
+                srcOffset->set(0, 0);
+            }
+            paint.addColorFragmentProcessor(GrMatrixConvolutionEffect::Make(
+                    std::move(src), domain, SkISize::Make(stepX, stepY), kernel, 1.0f, 0.0f,
+                    SkIPoint::Make(stepX / 2, stepY / 2), boxMode, true));
+            // The box's taps are nearest samples, so move them from the blocks' centers (on texel
+            // edges) to texel centers.
+            sampleRect = SkRect::Make(srcRect).makeOffset(stepX > 1 ? SK_ScalarHalf : 0.0f,
+                                                          stepY > 1 ? SK_ScalarHalf : 0.0f);
+        } else if (GrTextureDomain::kIgnore_Mode != mode && firstPass) {
             // GrTextureDomainEffect does not support kRepeat_Mode with GrSamplerState::Filter.
             GrTextureDomain::Mode modeForScaling = GrTextureDomain::kRepeat_Mode == mode
                                                                 ? GrTextureDomain::kDecal_Mode
                                                                 : mode;
 
             SkRect domain = SkRect::Make(*contentRect);
-            domain.inset((i < scaleFactorX) ? SK_ScalarHalf : 0.0f,
-                         (i < scaleFactorY) ? SK_ScalarHalf : 0.0f);
+            domain.inset((stepX > 1) ? SK_ScalarHalf : 0.0f,
+                         (stepY > 1) ? SK_ScalarHalf : 0.0f);
             auto fp = GrTextureDomainEffect::Make(std::move(src),
                                                   SkMatrix::I(),
                                                   domain,
@@ -331,22 +355,25 @@ static sk_sp<GrTextureProxy> decimate(GrRecordingContext* context,
             // TODO: consume the srcOffset in both first draws and always set it to zero
             // back in GaussianBlur
             srcOffset->set(0, 0);
+            sampleRect = SkRect::Make(srcRect);
         } else {
             paint.addColorTextureProcessor(std::move(src), SkMatrix::I(),
                                            GrSamplerState::ClampBilerp());
+            sampleRect = SkRect::Make(srcRect);
         }
         paint.setPorterDuffXPFactory(SkBlendMode::kSrc);
 
         GrFixedClip clip(dstRect);
         dstRenderTargetContext->fillRectToRect(clip, std::move(paint), GrAA::kNo,
-                                               SkMatrix::I(), SkRect::Make(dstRect),
-                                               SkRect::Make(srcRect));
+                                               SkMatrix::I(), SkRect::Make(dstRect), sampleRect);
 
         src = dstRenderTargetContext->asTextureProxyRef();
         if (!src) {
             return nullptr;
         }
         srcRect = dstRect;
+        doneX *= stepX;
+        doneY *= stepY;
     }
 
     *contentRect = dstRect;
@@ -475,8 +502,10 @@ sk_sp<GrRenderTargetContext> GaussianBlur(GrRecordingContext* context,
     int scaleFactorX, radiusX;
     int scaleFactorY, radiusY;
     int maxTextureSize = context->priv().caps()->maxTextureSize();
-    sigmaX = adjust_sigma(sigmaX, maxTextureSize, &scaleFactorX, &radiusX);
-    sigmaY = adjust_sigma(sigmaY, maxTextureSize, &scaleFactorY, &radiusY);
+    float maxSigma = context->priv().options().fReducedQualityBlurs
+                   ? MAX_REDUCED_QUALITY_BLUR_SIGMA : MAX_BLUR_SIGMA;
+    sigmaX = adjust_sigma(sigmaX, maxSigma, maxTextureSize, &scaleFactorX, &radiusX);
+    sigmaY = adjust_sigma(sigmaY, maxSigma, maxTextureSize, &scaleFactorY, &radiusY);
     SkASSERT(sigmaX || sigmaY);
 
     SkIPoint srcOffset = SkIPoint::Make(-dstBounds.x(), -dstBounds.y());
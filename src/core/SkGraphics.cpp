@@ -11,7 +11,9 @@
 #include "SkCanvas.h"
 #include "SkCpu.h"
 #include "SkGeometry.h"
+#include "SkGlyphOutlineCache.h"
 #include "SkImageFilter.h"
+#include "SkImageFilterCache.h"
 #include "SkMath.h"
 #include "SkMatrix.h"
 #include "SkOpts.h"
@@ -53,6 +55,7 @@ void SkGraphics::Init() {
 void SkGraphics::DumpMemoryStatistics(SkTraceMemoryDump* dump) {
   SkResourceCache::DumpMemoryStatistics(dump);
   SkStrikeCache::DumpMemoryStatistics(dump);
+  SkImageFilterCache::Get()->dumpMemoryStatistics(dump);
 }
 
 void SkGraphics::PurgeAllCaches() {
@@ -143,5 +146,14 @@ int SkGraphics::SetFontCachePointSizeLimit(int limit) {
 
 void SkGraphics::PurgeFontCache() {
     SkStrikeCache::GlobalStrikeCache()->purgeAll();
+    SkGlyphOutlineCache::Global()->purgeAll();
     SkTypefaceCache::PurgeAll();
 }
+
+bool SkGraphics::SaveFontCache(const char path[]) {
+    return SkStrikeCache::SavePersistentStrikes(path);
+}
+
+bool SkGraphics::LoadFontCache(const char path[]) {
+    return SkStrikeCache::LoadPersistentStrikes(path);
+}
@@ -10,6 +10,7 @@
 #include "SkCanvas.h"
 #include "SkFuzzLogging.h"
 #include "SkImageFilterCache.h"
+#include "SkImageFilterPriv.h"
 #include "SkLocalMatrixImageFilter.h"
 #include "SkMatrixImageFilter.h"
 #include "SkReadBuffer.h"
@@ -17,6 +18,7 @@
 #include "SkSafe32.h"
 #include "SkSpecialImage.h"
 #include "SkSpecialSurface.h"
+#include "SkTaskGroup.h"
 #include "SkValidationUtils.h"
 #include "SkWriteBuffer.h"
 #if SK_SUPPORT_GPU
@@ -170,10 +172,29 @@ sk_sp<SkSpecialImage> SkImageFilter::filterImage(SkSpecialImage* src, const Cont
 
     uint32_t srcGenID = fUsesSrcInput ? src->uniqueID() : 0;
     const SkIRect srcSubset = fUsesSrcInput ? src->subset() : SkIRect::MakeWH(0, 0);
-    SkImageFilterCacheKey key(fUniqueID, context.ctm(), context.clipBounds(), srcGenID, srcSubset);
+
+    // Without the source, moving the CTM by whole pixels just moves the result by the same
+    // amount, so we key on the CTM and clip with their integer translation taken out and put it
+    // back into the offset.  That lets a DAG drawn at a new scroll position hit last frame's
+    // results.  (With the source, every frame's layer has a new ID anyway.)
+    SkMatrix keyMatrix = context.ctm();
+    SkIRect keyClip = context.clipBounds();
+    SkIVector keyShift = SkIVector::Make(0, 0);
+    if (!fUsesSrcInput && !keyMatrix.hasPerspective()) {
+        const SkScalar kMaxShift = SkIntToScalar(1 << 24);  // plenty, and clipBounds can't overflow
+        SkScalar tx = keyMatrix.getTranslateX(),
+                 ty = keyMatrix.getTranslateY();
+        if (SkScalarAbs(tx) < kMaxShift && SkScalarAbs(ty) < kMaxShift) {
+            keyShift = SkIVector::Make(SkScalarFloorToInt(tx), SkScalarFloorToInt(ty));
+            keyMatrix.postTranslate(-SkIntToScalar(keyShift.fX), -SkIntToScalar(keyShift.fY));
+            keyClip.offset(-keyShift.fX, -keyShift.fY);
+        }
+    }
+    SkImageFilterCacheKey key(fUniqueID, keyMatrix, keyClip, srcGenID, srcSubset);
     if (context.cache()) {
         sk_sp<SkSpecialImage> result = context.cache()->get(key, offset);
         if (result) {
+            *offset += keyShift;
             return result;
         }
     }
@@ -190,7 +211,7 @@ sk_sp<SkSpecialImage> SkImageFilter::filterImage(SkSpecialImage* src, const Cont
 #endif
 
     if (result && context.cache()) {
-        context.cache()->set(key, result.get(), *offset, this);
+        context.cache()->set(key, result.get(), *offset - keyShift, this);
     }
 
     return result;
@@ -492,3 +513,29 @@ SkIRect SkImageFilter::DetermineRepeatedSrcBound(const SkIRect& srcBounds,
 
     return tmp;
 }
+
+void SkImageFilterForEachBand(int lineCount, int pixelsPerLine,
+                              const std::function<void(int start, int end)>& fn) {
+    // Bands smaller than this cost more to schedule than they save, and more bands than this
+    // doesn't help balance the load on any machine we care about.
+    static constexpr int64_t kMinPixelsPerBand = 16 * 1024;
+    static constexpr int     kMaxBands         = 32;
+
+    if (lineCount <= 0) {
+        return;
+    }
+    int64_t pixels = (int64_t)lineCount * SkTMax(pixelsPerLine, 1);
+    int bands = (int)SkTMin<int64_t>(SkTMin(lineCount, kMaxBands), pixels / kMinPixelsPerBand);
+    if (bands <= 1) {
+        fn(0, lineCount);
+        return;
+    }
+
+    SkTaskGroup tg;
+    tg.batch(bands, [&](int band) {
+        int start = (int)((int64_t)lineCount *  band      / bands),
+            end   = (int)((int64_t)lineCount * (band + 1) / bands);
+        fn(start, end);
+    });
+    tg.wait();
+}
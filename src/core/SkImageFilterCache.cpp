@@ -15,9 +15,11 @@
 #include "SkOpts.h"
 #include "SkRefCnt.h"
 #include "SkSpecialImage.h"
+#include "SkString.h"
 #include "SkTDynamicHash.h"
 #include "SkTHash.h"
 #include "SkTInternalLList.h"
+#include "SkTraceMemoryDump.h"
 
 #ifdef SK_BUILD_FOR_IOS
   enum { kDefaultCacheSize = 2 * 1024 * 1024 };
@@ -42,12 +44,15 @@ public:
     }
     struct Value {
         Value(const Key& key, SkSpecialImage* image, const SkIPoint& offset, const SkImageFilter* filter)
-            : fKey(key), fImage(SkRef(image)), fOffset(offset), fFilter(filter) {}
+            : fKey(key), fImage(SkRef(image)), fOffset(offset), fFilter(filter)
+            , fSize(image->getSize()) {}
 
         Key fKey;
         sk_sp<SkSpecialImage> fImage;
         SkIPoint fOffset;
         const SkImageFilter* fFilter;
+        // What we charged for this entry; the image's own size could change under us.
+        size_t fSize;
         static const Key& GetKey(const Value& v) {
             return v.fKey;
         }
@@ -78,30 +83,23 @@ public:
         Value* v = new Value(key, image, offset, filter);
         fLookup.add(v);
         fLRU.addToHead(v);
-        fCurrentBytes += image->getSize();
+        fCurrentBytes += v->fSize;
         if (auto* values = fImageFilterValues.find(filter)) {
             values->push_back(v);
         } else {
             fImageFilterValues.set(filter, {v});
         }
 
-        while (fCurrentBytes > fMaxBytes) {
-            Value* tail = fLRU.tail();
-            SkASSERT(tail);
-            if (tail == v) {
-                break;
-            }
-            this->removeInternal(tail);
-        }
+        this->purgeToLimit(v);
     }
 
     void purge() override {
         SkAutoMutexAcquire mutex(fMutex);
-        while (fCurrentBytes > 0) {
-            Value* tail = fLRU.tail();
-            SkASSERT(tail);
+        // Loop on the list rather than the byte count, so empty images go too.
+        while (Value* tail = fLRU.tail()) {
             this->removeInternal(tail);
         }
+        SkASSERT(0 == fCurrentBytes);
     }
 
     void purgeByImageFilter(const SkImageFilter* filter) override {
@@ -119,8 +117,61 @@ public:
         fImageFilterValues.remove(filter);
     }
 
+    size_t getTotalBytesUsed() const override {
+        SkAutoMutexAcquire mutex(fMutex);
+        return fCurrentBytes;
+    }
+
+    size_t getByteLimit() const override {
+        SkAutoMutexAcquire mutex(fMutex);
+        return fMaxBytes;
+    }
+
+    void setByteLimit(size_t maxBytes) override {
+        SkAutoMutexAcquire mutex(fMutex);
+        fMaxBytes = maxBytes;
+        this->purgeToLimit(nullptr);
+    }
+
+    void dumpMemoryStatistics(SkTraceMemoryDump* dump) const override {
+        static const char kDumpName[] = "skia/sk_image_filter_cache";
+
+        SkAutoMutexAcquire mutex(fMutex);
+        dump->dumpNumericValue(kDumpName, "size", "bytes", fCurrentBytes);
+        dump->dumpNumericValue(kDumpName, "budget_size", "bytes", fMaxBytes);
+        dump->dumpNumericValue(kDumpName, "entry_count", "objects", fLookup.count());
+
+        if (dump->getRequestedDetails() != SkTraceMemoryDump::kObjectsBreakdowns_LevelOfDetail) {
+            return;
+        }
+        fImageFilterValues.foreach([dump](const SkImageFilter*,
+                                          const std::vector<Value*>& values) {
+            size_t bytes = 0;
+            for (const Value* v : values) {
+                bytes += v->fSize;
+            }
+            // Every key for a filter carries that filter's unique ID.
+            SkString dumpName = SkStringPrintf("%s/filter_%u", kDumpName,
+                                               values.front()->fKey.fUniqueID);
+            dump->dumpNumericValue(dumpName.c_str(), "size", "bytes", bytes);
+            dump->dumpNumericValue(dumpName.c_str(), "entry_count", "objects", values.size());
+        });
+    }
+
     SkDEBUGCODE(int count() const override { return fLookup.count(); })
 private:
+    // Evicts from the LRU end until we're under budget, but never evicts keep.
+    void purgeToLimit(const Value* keep) {
+        while (fCurrentBytes > fMaxBytes) {
+            Value* tail = fLRU.tail();
+            SkASSERT(tail);
+            if (tail == keep) {
+                break;
+            }
+            this->removeInternal(tail);
+        }
+    }
+
     void removeInternal(Value* v) {
         SkASSERT(v->fImage);
         if (v->fFilter) {
@@ -137,7 +188,8 @@ private:
                 }
             }
         }
-        fCurrentBytes -= v->fImage->getSize();
+        SkASSERT(fCurrentBytes >= v->fSize);
+        fCurrentBytes -= v->fSize;
         fLRU.remove(v);
         fLookup.remove(v->fKey);
         delete v;
@@ -14,6 +14,7 @@
 struct SkIPoint;
 class SkImageFilter;
 class SkSpecialImage;
+class SkTraceMemoryDump;
 
 struct SkImageFilterCacheKey {
     SkImageFilterCacheKey(const uint32_t uniqueID, const SkMatrix& matrix,
@@ -47,7 +48,9 @@ struct SkImageFilterCacheKey {
 };
 
 // This cache maps from (filter's unique ID + CTM + clipBounds + src bitmap generation ID) to
-// (result, offset).
+// (result, offset).  Entries are evicted least recently used first once the cache holds more than
+// its byte limit.  Each entry is charged the size its image had when it was added, so the total
+// stays exact even if an image's reported size changes later (e.g. a deferred texture).
 class SkImageFilterCache : public SkRefCnt {
 public:
     enum { kDefaultTransientSize = 32 * 1024 * 1024 };
@@ -60,6 +63,15 @@ public:
                      const SkIPoint& offset, const SkImageFilter* filter) = 0;
     virtual void purge() = 0;
     virtual void purgeByImageFilter(const SkImageFilter*) = 0;
+
+    virtual size_t getTotalBytesUsed() const = 0;
+    virtual size_t getByteLimit() const = 0;
+    // Shrinking the limit purges immediately.
+    virtual void setByteLimit(size_t) = 0;
+
+    // Reports the cache's total and budget and, when asked for a breakdown, how many bytes and
+    // entries each filter is holding on to.
+    virtual void dumpMemoryStatistics(SkTraceMemoryDump*) const = 0;
     SkDEBUGCODE(virtual int count() const = 0;)
 };
 
@@ -10,6 +10,8 @@
 
 #include "SkImageFilter.h"
 
+#include <functional>
+
 /**
  *  Helper to unflatten the common data, and return nullptr if we fail.
  */
@@ -21,4 +23,14 @@
         }                                                           \
     } while (0)
 
+/**
+ *  Splits lines [0, lineCount) into contiguous bands and calls fn(start, end) once per band,
+ *  running the bands on SkExecutor::GetDefault().  Filters whose output lines depend only on
+ *  their inputs (not on other output lines) use this to spread large images across threads.
+ *  Small images run as a single band; nothing runs concurrently unless the client has installed
+ *  a thread pool with SkExecutor::SetDefault().  Returns after every band has finished.
+ */
+void SkImageFilterForEachBand(int lineCount, int pixelsPerLine,
+                              const std::function<void(int start, int end)>& fn);
+
 #endif
@@ -286,6 +286,25 @@ bool SkLatticeIter::next(SkIRect* src, SkRect* dst, bool* isFixedColor, SkColor*
     return true;
 }
 
+bool SkLatticeIter::getNinePatchGrid(int srcX[4], int srcY[4],
+                                     SkScalar dstX[4], SkScalar dstY[4]) const {
+    if (4 != fSrcX.count() || 4 != fSrcY.count()) {
+        return false;
+    }
+    for (SkCanvas::Lattice::RectType type : fRectTypes) {
+        if (SkCanvas::Lattice::kDefault != type) {
+            return false;
+        }
+    }
+    for (int i = 0; i < 4; i++) {
+        srcX[i] = fSrcX[i];
+        srcY[i] = fSrcY[i];
+        dstX[i] = fDstX[i];
+        dstY[i] = fDstY[i];
+    }
+    return true;
+}
+
 void SkLatticeIter::mapDstScaleTranslate(const SkMatrix& matrix) {
     SkASSERT(matrix.isScaleTranslate());
     SkScalar tx = matrix.getTranslateX();
@@ -53,6 +53,12 @@ public:
      */
     void mapDstScaleTranslate(const SkMatrix& matrix);
 
+    /**
+     *  If the lattice is a 3x3 grid whose rects are all drawn from the image, returns true and
+     *  the x and y coordinates of its grid lines in src and dst space. Otherwise returns false.
+     */
+    bool getNinePatchGrid(int srcX[4], int srcY[4], SkScalar dstX[4], SkScalar dstY[4]) const;
+
     /**
      *  Returns the number of rects that will actually be drawn.
      */
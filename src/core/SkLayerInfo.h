@@ -0,0 +1,63 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkLayerInfo_DEFINED
+#define SkLayerInfo_DEFINED
+
+#include "SkMatrix.h"
+#include "SkNoncopyable.h"
+#include "SkRect.h"
+#include "SkTArray.h"
+#include "SkTSort.h"
+
+class SkPaint;
+
+/**
+ * Describes the saveLayer blocks in a picture that can be hoisted: drawn once into an image of
+ * their own and then composited from that image.  A hoistable block's contents depend only on the
+ * ops inside it, not on the pixels already in the destination, and its paint only composites the
+ * layer (no image filter, no effects that reach outside the layer's contents).
+ *
+ * SkRecordComputeLayers() gathers these, in order of their SaveLayers.
+ */
+class SkLayerInfo : SkNoncopyable {
+public:
+    struct BlockInfo {
+        // The SaveLayer and its matching Restore.
+        int            fSaveLayerOpID;
+        int            fRestoreOpID;
+        // The bounds of everything drawn in the block, in picture space.
+        SkRect         fBounds;
+        // The CTM at the SaveLayer, relative to the start of the picture.
+        SkMatrix       fLocalMat;
+        // The SaveLayer's bounds hint, which its contents are clipped to, and paint.  Both are
+        // owned by the picture's SkRecord, and may be null.
+        const SkRect*  fHint;
+        const SkPaint* fPaint;
+    };
+
+    BlockInfo& addBlock() { return fBlocks.push_back(); }
+
+    int numBlocks() const { return fBlocks.count(); }
+    const BlockInfo& block(int index) const { return fBlocks[index]; }
+
+    // Sorts the blocks by their SaveLayers.  They're found by their Restores, so nested blocks
+    // come first.
+    void sort() {
+        if (!fBlocks.empty()) {
+            SkTQSort(fBlocks.begin(), fBlocks.end() - 1,
+                     [](const BlockInfo& a, const BlockInfo& b) {
+                         return a.fSaveLayerOpID < b.fSaveLayerOpID;
+                     });
+        }
+    }
+
+private:
+    SkTArray<BlockInfo, true> fBlocks;
+};
+
+#endif
@@ -473,8 +473,10 @@ void* SkLiteDL::push(size_t pod, Args&&... args) {
     SkASSERT(skip < (1<<24));
     if (fUsed + skip > fReserved) {
         static_assert(SkIsPow2(SKLITEDL_PAGE), "This math needs updating for non-pow2.");
+        // Grow by at least half again, so big lists don't realloc (and copy) once per page.
+        size_t needed = std::max(fUsed + skip, fReserved + fReserved/2);
         // Next greater multiple of SKLITEDL_PAGE.
-        fReserved = (fUsed + skip + SKLITEDL_PAGE) & ~(SKLITEDL_PAGE-1);
+        fReserved = (needed + SKLITEDL_PAGE) & ~(SKLITEDL_PAGE-1);
         fBytes.realloc(fReserved);
     }
     SkASSERT(fUsed + skip <= fReserved);
@@ -678,3 +680,9 @@ void SkLiteDL::reset() {
     // Leave fBytes and fReserved alone.
     fUsed   = 0;
 }
+
+void SkLiteDL::compact() {
+    // Ops are relocatable, just like when push() grows fBytes.
+    fBytes.realloc(fUsed);
+    fReserved = fUsed;
+}
@@ -22,9 +22,14 @@ public:
 
     void draw(SkCanvas* canvas) const;
 
+    // Destroys all ops, but keeps their storage to record the next frame into.
     void reset();
     bool empty() const { return fUsed == 0; }
 
+    // Releases storage beyond what the recorded ops use.
+    void compact();
+    size_t bytesReserved() const { return fReserved; }
+
     void flush();
 
     void save();
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkMallocStats.h"
+
+#include <atomic>
+
+#if defined(SK_BUILD_FOR_MAC) || defined(SK_BUILD_FOR_IOS)
+    #include <malloc/malloc.h>
+#elif defined(SK_BUILD_FOR_WIN) || defined(SK_BUILD_FOR_ANDROID) || defined(__GLIBC__)
+    #include <malloc.h>
+#endif
+
+// These are constant-initialized, so they're safe to use from allocations made by static
+// constructors.
+static std::atomic<int64_t> gAllocs{0};
+static std::atomic<int64_t> gFrees{0};
+static std::atomic<int64_t> gAllocBytes{0};
+static std::atomic<int64_t> gLiveBytes{0};
+static std::atomic<int64_t> gPeakLiveBytes{0};
+
+static int64_t usable_size(void* p) {
+#if defined(SK_BUILD_FOR_MAC) || defined(SK_BUILD_FOR_IOS)
+    return malloc_size(p);
+#elif defined(SK_BUILD_FOR_WIN)
+    return _msize(p);
+#elif defined(SK_BUILD_FOR_ANDROID) || defined(__GLIBC__)
+    return malloc_usable_size(p);
+#else
+    return 0;
+#endif
+}
+
+void SkMallocStats::RecordAlloc(void* p) {
+    if (!p) {
+        return;
+    }
+    int64_t size = usable_size(p);
+    gAllocs.fetch_add(1, std::memory_order_relaxed);
+    gAllocBytes.fetch_add(size, std::memory_order_relaxed);
+    int64_t live = gLiveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+    int64_t peak = gPeakLiveBytes.load(std::memory_order_relaxed);
+    while (live > peak &&
+           !gPeakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+}
+
+void SkMallocStats::RecordFree(void* p) {
+    if (!p) {
+        return;
+    }
+    gFrees.fetch_add(1, std::memory_order_relaxed);
+    gLiveBytes.fetch_sub(usable_size(p), std::memory_order_relaxed);
+}
+
+SkMallocStats::Totals SkMallocStats::Get() {
+    Totals totals;
+    totals.fAllocs        = gAllocs.load(std::memory_order_relaxed);
+    totals.fFrees         = gFrees.load(std::memory_order_relaxed);
+    totals.fAllocBytes    = gAllocBytes.load(std::memory_order_relaxed);
+    totals.fLiveBytes     = gLiveBytes.load(std::memory_order_relaxed);
+    totals.fPeakLiveBytes = gPeakLiveBytes.load(std::memory_order_relaxed);
+    return totals;
+}
+
+void SkMallocStats::ResetPeak() {
+    gPeakLiveBytes.store(gLiveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkMallocStats_DEFINED
+#define SkMallocStats_DEFINED
+
+#include "SkTypes.h"
+
+// Build with skia_enable_metrics=true for sk_malloc and friends to record themselves here.
+#ifndef SK_METRICS_ENABLED
+    #define SK_METRICS_ENABLED 0
+#endif
+
+/**
+ *  Process-wide heap accounting for benchmarking tools, e.g. to catch a change that makes a draw
+ *  allocate more often.  When SK_METRICS_ENABLED, sk_malloc_flags, sk_realloc_throw and sk_free
+ *  record every allocation they make or free; a tool can also route its own allocations (say,
+ *  from a replacement operator new) through sk_malloc to have them counted.
+ *
+ *  Byte counts use the allocator's usable size of each block, and are zero on platforms where
+ *  that can't be queried.  Recording is a few relaxed atomic adds, plus a compare-exchange when
+ *  the live bytes reach a new peak.
+ */
+class SkMallocStats {
+public:
+    struct Totals {
+        int64_t fAllocs;          // Allocations made, including reallocs.
+        int64_t fFrees;           // Allocations freed, including the old block of reallocs.
+        int64_t fAllocBytes;      // Bytes allocated.
+        int64_t fLiveBytes;       // Bytes allocated and not yet freed.
+        int64_t fPeakLiveBytes;   // The most fLiveBytes has been since the last ResetPeak().
+    };
+
+    static constexpr bool Enabled() { return SK_METRICS_ENABLED; }
+
+    /** Records that p was just allocated.  p may be null. */
+    static void RecordAlloc(void* p);
+
+    /** Records that p is about to be freed.  p may be null. */
+    static void RecordFree(void* p);
+
+    static Totals Get();
+
+    /** Lowers the peak to the current live bytes, to find the peak of what follows. */
+    static void ResetPeak();
+};
+
+#endif
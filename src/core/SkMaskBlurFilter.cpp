@@ -12,6 +12,7 @@
 #include "SkGaussFilter.h"
 #include "SkMalloc.h"
 #include "SkNx.h"
+#include "SkOpts.h"
 #include "SkTemplates.h"
 #include "SkTo.h"
 
@@ -89,6 +90,23 @@ public:
 
     int    border()     const { return fBorder; }
 
+    // SkOpts::box_blur_a8_x4 scales in 32-bit lanes, so it needs the weight to fit in 32 bits,
+    // which is every window but 1.
+    bool canBlurFourRows() const {
+        return fWeight <= 0xFFFFFFFF && fPass0Size > 0 && fPass1Size > 0 && fPass2Size > 0;
+    }
+
+    // Blurs four A8 rows, srcRB apart, like makeBlurScan(width, ...).blur() would blur each of
+    // them, with row i going to dst + i.  The buffer needs 4 * bufferSize() entries.
+    void blurFourRows(const uint8_t* src, size_t srcRB, int width,
+                      uint8_t* dst, size_t dstStride, int dstWidth, uint32_t* buffer) const {
+        SkASSERT(this->canBlurFourRows());
+        const int passSizes[3] = {fPass0Size, fPass1Size, fPass2Size};
+        int noChangeCount = fSlidingWindow > width ? fSlidingWindow - width : 0;
+        SkOpts::box_blur_a8_x4(src, srcRB, width, dst, dstStride, dstWidth,
+                               noChangeCount, passSizes, SkTo<uint32_t>(fWeight), buffer);
+    }
+
 public:
     class Scan {
     public:
@@ -982,8 +1000,9 @@ SkIPoint SkMaskBlurFilter::blur(const SkMask& src, SkMask* dst) const {
         dstH = dst->fBounds.height();
     SkASSERT(srcW >= 0 && srcH >= 0 && dstW >= 0 && dstH >= 0);
 
+    // Big enough for four rows at a time; the scalar scans just use the front of it.
     auto bufferSize = std::max(planW.bufferSize(), planH.bufferSize());
-    auto buffer = alloc.makeArrayDefault<uint32_t>(bufferSize);
+    auto buffer = alloc.makeArrayDefault<uint32_t>(4 * bufferSize);
 
     // Blur both directions.
     int tmpW = srcH,
@@ -1004,10 +1023,17 @@ SkIPoint SkMaskBlurFilter::blur(const SkMask& src, SkMask* dst) const {
             }
         } break;
         case SkMask::kA8_Format: {
-            const uint8_t* a8Start = src.fImage;
+            int y = 0;
+            if (planW.canBlurFourRows()) {
+                for (; y + 4 <= srcH; y += 4) {
+                    planW.blurFourRows(src.fImage + y * src.fRowBytes, src.fRowBytes, srcW,
+                                       &tmp[y], tmpW, tmpH, buffer);
+                }
+            }
+            const uint8_t* a8Start = src.fImage + y * src.fRowBytes;
             auto start = SkMask::AlphaIter<SkMask::kA8_Format>(a8Start);
             auto end = SkMask::AlphaIter<SkMask::kA8_Format>(a8Start + srcW);
-            for (int y = 0; y < srcH; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
+            for (; y < srcH; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
                 auto tmpStart = &tmp[y];
                 scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
             }
@@ -1037,7 +1063,14 @@ SkIPoint SkMaskBlurFilter::blur(const SkMask& src, SkMask* dst) const {
     // Blur vertically (scan in memory order because of the transposition),
     // and transpose back to the original orientation.
     const PlanGauss::Scan& scanH = planH.makeBlurScan(tmpW, buffer);
-    for (int y = 0; y < tmpH; y++) {
+    int y = 0;
+    if (planH.canBlurFourRows()) {
+        for (; y + 4 <= tmpH; y += 4) {
+            planH.blurFourRows(&tmp[y * tmpW], tmpW, tmpW,
+                               &dst->fImage[y], dst->fRowBytes, dstH, buffer);
+        }
+    }
+    for (; y < tmpH; y++) {
         auto tmpStart = &tmp[y * tmpW];
         auto dstStart = &dst->fImage[y];
 
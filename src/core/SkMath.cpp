@@ -41,6 +41,10 @@ int SkCLZ_portable(uint32_t x) {
     return zeros;
 }
 
+int SkCTZ_portable(uint32_t x) {
+    return 32 - SkCLZ_portable(~x & (x - 1));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 /* www.worldserver.com/turk/computergraphics/FixedSqrt.pdf
@@ -164,6 +164,35 @@ int SkCLZ_portable(uint32_t);
     #endif
 #endif
 
+//! Returns the number of trailing zero bits (0...32)
+int SkCTZ_portable(uint32_t);
+
+#ifndef SkCTZ
+    #if defined(SK_BUILD_FOR_WIN)
+        #include <intrin.h>
+
+        static inline int SkCTZ(uint32_t mask) {
+            if (mask) {
+                unsigned long index;
+                _BitScanForward(&index, mask);
+                // Suppress this bogus /analyze warning. The check for non-zero
+                // guarantees that _BitScanForward will succeed.
+#pragma warning(suppress : 6102) // Using 'index' from failed function call
+                return index;
+            } else {
+                return 32;
+            }
+        }
+    #elif defined(SK_CPU_ARM32) || defined(__GNUC__) || defined(__clang__)
+        static inline int SkCTZ(uint32_t mask) {
+            // __builtin_ctz(0) is undefined, so we have to detect that case.
+            return mask ? __builtin_ctz(mask) : 32;
+        }
+    #else
+        #define SkCTZ(x)    SkCTZ_portable(x)
+    #endif
+#endif
+
 /**
  *  Returns the smallest power-of-2 that is >= the specified value. If value
  *  is already a power of 2, then it is returned unchanged. It is undefined
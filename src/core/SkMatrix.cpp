@@ -11,6 +11,7 @@
 #include "SkMathPriv.h"
 #include "SkMatrixPriv.h"
 #include "SkNx.h"
+#include "SkOpts.h"
 #include "SkPaint.h"
 #include "SkPoint3.h"
 #include "SkRSXform.h"
@@ -984,6 +985,7 @@ void SkMatrix::Persp_pts(const SkMatrix& m, SkPoint dst[],
                          const SkPoint src[], int count) {
     SkASSERT(m.hasPerspective());
 
+#ifdef SK_LEGACY_MATRIX_MATH_ORDER
     if (count > 0) {
         do {
             SkScalar sy = src->fY;
@@ -992,11 +994,7 @@ void SkMatrix::Persp_pts(const SkMatrix& m, SkPoint dst[],
 
             SkScalar x = sdot(sx, m.fMat[kMScaleX], sy, m.fMat[kMSkewX])  + m.fMat[kMTransX];
             SkScalar y = sdot(sx, m.fMat[kMSkewY],  sy, m.fMat[kMScaleY]) + m.fMat[kMTransY];
-#ifdef SK_LEGACY_MATRIX_MATH_ORDER
             SkScalar z = sx * m.fMat[kMPersp0] + (sy * m.fMat[kMPersp1] + m.fMat[kMPersp2]);
-#else
-            SkScalar z = sdot(sx, m.fMat[kMPersp0], sy, m.fMat[kMPersp1]) + m.fMat[kMPersp2];
-#endif
             if (z) {
                 z = 1 / z;
             }
@@ -1006,35 +1004,14 @@ void SkMatrix::Persp_pts(const SkMatrix& m, SkPoint dst[],
             dst += 1;
         } while (--count);
     }
+#else
+    SkOpts::matrix_persp_pts(m, dst, src, count);
+#endif
 }
 
 void SkMatrix::Affine_vpts(const SkMatrix& m, SkPoint dst[], const SkPoint src[], int count) {
     SkASSERT(m.getType() != SkMatrix::kPerspective_Mask);
-    if (count > 0) {
-        SkScalar tx = m.getTranslateX();
-        SkScalar ty = m.getTranslateY();
-        SkScalar sx = m.getScaleX();
-        SkScalar sy = m.getScaleY();
-        SkScalar kx = m.getSkewX();
-        SkScalar ky = m.getSkewY();
-        if (count & 1) {
-            dst->set(src->fX * sx + src->fY * kx + tx,
-                     src->fX * ky + src->fY * sy + ty);
-            src += 1;
-            dst += 1;
-        }
-        Sk4s trans4(tx, ty, tx, ty);
-        Sk4s scale4(sx, sy, sx, sy);
-        Sk4s  skew4(kx, ky, kx, ky);    // applied to swizzle of src4
-        count >>= 1;
-        for (int i = 0; i < count; ++i) {
-            Sk4s src4 = Sk4s::Load(src);
-            Sk4s swz4 = SkNx_shuffle<1,0,3,2>(src4);  // y0 x0, y1 x1
-            (src4 * scale4 + swz4 * skew4 + trans4).store(dst);
-            src += 2;
-            dst += 2;
-        }
-    }
+    SkOpts::matrix_affine_pts(m, dst, src, count);
 }
 
 const SkMatrix::MapPtsProc SkMatrix::gMapPtsProcs[] = {
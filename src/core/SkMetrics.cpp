@@ -0,0 +1,109 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkMetrics.h"
+
+#include "SkString.h"
+#include "SkTraceMemoryDump.h"
+
+constexpr int SkMetrics::kShards;
+constexpr int SkMetrics::kBuckets;
+
+// Counters and histograms push themselves onto these lists as they are constructed, and are
+// never removed, so readers can walk them without a lock.
+static std::atomic<SkMetrics::Counter*>   gCounters{nullptr};
+static std::atomic<SkMetrics::Histogram*> gHistograms{nullptr};
+
+template <typename T>
+static void push(std::atomic<T*>* list, T* node, T** next) {
+    *next = list->load(std::memory_order_relaxed);
+    while (!list->compare_exchange_weak(*next, node,
+                                        std::memory_order_release, std::memory_order_relaxed)) {}
+}
+
+SkMetrics::Counter::Counter(const char* name) : fName(name) {
+    push(&gCounters, this, &fNext);
+}
+
+int64_t SkMetrics::Counter::value() const {
+    int64_t sum = 0;
+    for (const ShardValue& shard : fShards) {
+        sum += shard.fValue.load(std::memory_order_relaxed);
+    }
+    return sum;
+}
+
+SkMetrics::Histogram::Histogram(const char* name) : fName(name) {
+    for (ShardValues& shard : fShards) {
+        for (auto& bucket : shard.fBuckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        shard.fSum.store(0, std::memory_order_relaxed);
+    }
+    push(&gHistograms, this, &fNext);
+}
+
+SkMetrics::Histogram::Totals SkMetrics::Histogram::totals() const {
+    Totals totals = {};
+    for (const ShardValues& shard : fShards) {
+        for (int i = 0; i < kBuckets; i++) {
+            uint64_t count = shard.fBuckets[i].load(std::memory_order_relaxed);
+            totals.fBuckets[i] += count;
+            totals.fCount      += count;
+        }
+        totals.fSum += shard.fSum.load(std::memory_order_relaxed);
+    }
+    return totals;
+}
+
+void SkMetrics::ForEachCounter(const std::function<void(const Counter&)>& fn) {
+    for (Counter* c = gCounters.load(std::memory_order_acquire); c; c = c->fNext) {
+        fn(*c);
+    }
+}
+
+void SkMetrics::ForEachHistogram(const std::function<void(const Histogram&)>& fn) {
+    for (Histogram* h = gHistograms.load(std::memory_order_acquire); h; h = h->fNext) {
+        fn(*h);
+    }
+}
+
+void SkMetrics::DumpMemoryStatistics(SkTraceMemoryDump* dump) {
+    ForEachCounter([dump](const Counter& counter) {
+        SkString dumpName = SkStringPrintf("skia/metrics/%s", counter.name());
+        dump->dumpNumericValue(dumpName.c_str(), "count", "objects", counter.value());
+    });
+    ForEachHistogram([dump](const Histogram& histogram) {
+        SkString dumpName = SkStringPrintf("skia/metrics/%s", histogram.name());
+        Histogram::Totals totals = histogram.totals();
+        dump->dumpNumericValue(dumpName.c_str(), "count", "objects", totals.fCount);
+        dump->dumpNumericValue(dumpName.c_str(), "sum", "objects", totals.fSum);
+        for (int i = 0; i < kBuckets; i++) {
+            if (totals.fBuckets[i]) {
+                SkString valueName = SkStringPrintf("bucket_%d", i);
+                dump->dumpNumericValue(dumpName.c_str(), valueName.c_str(), "objects",
+                                       totals.fBuckets[i]);
+            }
+        }
+    });
+}
+
+void SkMetrics::ResetAll() {
+    for (Counter* c = gCounters.load(std::memory_order_acquire); c; c = c->fNext) {
+        for (Counter::ShardValue& shard : c->fShards) {
+            shard.fValue.store(0, std::memory_order_relaxed);
+        }
+    }
+    for (Histogram* h = gHistograms.load(std::memory_order_acquire); h; h = h->fNext) {
+        for (Histogram::ShardValues& shard : h->fShards) {
+            for (auto& bucket : shard.fBuckets) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+            shard.fSum.store(0, std::memory_order_relaxed);
+        }
+    }
+}
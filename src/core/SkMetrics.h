@@ -0,0 +1,141 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkMetrics_DEFINED
+#define SkMetrics_DEFINED
+
+#include "SkChecksum.h"
+#include "SkMathPriv.h"
+#include "SkThreadID.h"
+#include "SkTypes.h"
+
+#include <atomic>
+#include <functional>
+
+class SkTraceMemoryDump;
+
+// Build with skia_enable_metrics=true to turn on the SK_METRIC_* instrumentation.
+#ifndef SK_METRICS_ENABLED
+    #define SK_METRICS_ENABLED 0
+#endif
+
+/**
+ *  A registry of counters and histograms for hot paths: cache hit rates, bytes uploaded, op
+ *  merges and the like.  Unless SK_METRICS_ENABLED, the SK_METRIC_* macros compile to nothing
+ *  and don't evaluate their arguments, and the registry is always empty.
+ *
+ *  Counters and histograms are sharded by thread, so recording one is a relaxed atomic add on a
+ *  cache line that other threads rarely touch.  They are meant to be function statics, as the
+ *  macros make them, and are never unregistered.
+ */
+class SkMetrics {
+public:
+    static constexpr int kShards = 16;
+
+    class Counter {
+    public:
+        explicit Counter(const char* name);
+
+        void add(int64_t n) {
+            fShards[Shard()].fValue.fetch_add(n, std::memory_order_relaxed);
+        }
+
+        const char* name() const { return fName; }
+        int64_t value() const;
+
+    private:
+        friend class SkMetrics;
+
+        struct alignas(64) ShardValue {
+            std::atomic<int64_t> fValue{0};
+        };
+
+        ShardValue  fShards[kShards];
+        const char* fName;
+        Counter*    fNext;
+    };
+
+    // Bucket 0 counts zeros, and bucket i > 0 counts values in [2^(i-1), 2^i).
+    static constexpr int kBuckets = 65;
+
+    class Histogram {
+    public:
+        explicit Histogram(const char* name);
+
+        void record(uint64_t value) {
+            ShardValues& shard = fShards[Shard()];
+            shard.fBuckets[Bucket(value)].fetch_add(1, std::memory_order_relaxed);
+            shard.fSum.fetch_add(value, std::memory_order_relaxed);
+        }
+
+        struct Totals {
+            uint64_t fCount;
+            uint64_t fSum;
+            uint64_t fBuckets[kBuckets];
+        };
+
+        const char* name() const { return fName; }
+        Totals totals() const;
+
+    private:
+        friend class SkMetrics;
+
+        static int Bucket(uint64_t value) {
+            uint32_t hi = (uint32_t)(value >> 32);
+            return hi ? 64 - SkCLZ(hi) : 32 - SkCLZ((uint32_t)value);
+        }
+
+        struct alignas(64) ShardValues {
+            std::atomic<uint64_t> fBuckets[kBuckets];
+            std::atomic<uint64_t> fSum;
+        };
+
+        ShardValues fShards[kShards];
+        const char* fName;
+        Histogram*  fNext;
+    };
+
+    /** Calls fn with every registered counter, in no particular order. */
+    static void ForEachCounter(const std::function<void(const Counter&)>& fn);
+
+    /** Calls fn with every registered histogram, in no particular order. */
+    static void ForEachHistogram(const std::function<void(const Histogram&)>& fn);
+
+    /**
+     *  Dumps each counter as "skia/metrics/<name>" with a "count", and each histogram with its
+     *  "count", "sum", and the count in each non-empty bucket as "bucket_<i>".
+     */
+    static void DumpMemoryStatistics(SkTraceMemoryDump* dump);
+
+    /** Zeros every counter and histogram, e.g. between tests or frames. */
+    static void ResetAll();
+
+private:
+    // Threads are spread over the shards by ID, so there's no thread-local state to set up.
+    static int Shard() {
+        uint64_t id = (uint64_t)SkGetThreadID();
+        return SkChecksum::Mix((uint32_t)(id ^ (id >> 32))) & (kShards - 1);
+    }
+};
+
+#if SK_METRICS_ENABLED
+    #define SK_METRIC_COUNT(name, n)                           \
+        do {                                                   \
+            static SkMetrics::Counter sk_metric_counter(name); \
+            sk_metric_counter.add(n);                          \
+        } while (false)
+    #define SK_METRIC_HISTOGRAM(name, value)                       \
+        do {                                                       \
+            static SkMetrics::Histogram sk_metric_histogram(name); \
+            sk_metric_histogram.record(value);                     \
+        } while (false)
+#else
+    #define SK_METRIC_COUNT(name, n)         do {} while (false)
+    #define SK_METRIC_HISTOGRAM(name, value) do {} while (false)
+#endif
+
+#endif
@@ -6,6 +6,7 @@
  */
 
 #include "SkCanvas.h"
+#include "SkImage.h"
 #include "SkTLazy.h"
 #include "SkMiniRecorder.h"
 #include "SkOnce.h"
@@ -33,6 +34,13 @@ static SkRect adjust_for_paint(SkRect bounds, const SkPaint& paint) {
     return paint.canComputeFastBounds() ? paint.computeFastBounds(bounds, &bounds)
                                         : SkRectPriv::MakeLargest();
 }
+static SkRect bounds(const DrawImage& op) {
+    // We only record DrawImages without a paint.
+    return SkRect::MakeXYWH(op.left, op.top, op.image->width(), op.image->height());
+}
+static SkRect bounds(const DrawOval& op) {
+    return adjust_for_paint(op.oval, op.paint);
+}
 static SkRect bounds(const DrawRect& op) {
     return adjust_for_paint(op.rect, op.paint);
 }
@@ -40,6 +48,9 @@ static SkRect bounds(const DrawPath& op) {
     return op.path.isInverseFillType() ? SkRectPriv::MakeLargest()
                                        : adjust_for_paint(op.path.getBounds(), op.paint);
 }
+static SkRect bounds(const DrawRRect& op) {
+    return adjust_for_paint(op.rrect.rect(), op.paint);
+}
 static SkRect bounds(const DrawTextBlob& op) {
     return adjust_for_paint(op.blob->bounds().makeOffset(op.x, op.y), op.paint);
 }
@@ -81,6 +92,17 @@ SkMiniRecorder::~SkMiniRecorder() {
     new (fBuffer.get()) Type{__VA_ARGS__};         \
     return true
 
+bool SkMiniRecorder::drawImage(const SkImage* image, SkScalar x, SkScalar y,
+                               const SkPaint* paint) {
+    // A paint would need storage of its own, like SkRecorder::copy() gives it.
+    if (paint) { return false; }
+    TRY_TO_STORE(DrawImage, nullptr, sk_ref_sp(image), x, y);
+}
+
+bool SkMiniRecorder::drawOval(const SkRect& oval, const SkPaint& paint) {
+    TRY_TO_STORE(DrawOval, paint, oval);
+}
+
 bool SkMiniRecorder::drawRect(const SkRect& rect, const SkPaint& paint) {
     TRY_TO_STORE(DrawRect, paint, rect);
 }
@@ -89,6 +111,10 @@ bool SkMiniRecorder::drawPath(const SkPath& path, const SkPaint& paint) {
     TRY_TO_STORE(DrawPath, paint, path);
 }
 
+bool SkMiniRecorder::drawRRect(const SkRRect& rrect, const SkPaint& paint) {
+    TRY_TO_STORE(DrawRRect, paint, rrect);
+}
+
 bool SkMiniRecorder::drawTextBlob(const SkTextBlob* b, SkScalar x, SkScalar y, const SkPaint& p) {
     TRY_TO_STORE(DrawTextBlob, p, sk_ref_sp(b), x, y);
 }
@@ -108,8 +134,11 @@ sk_sp<SkPicture> SkMiniRecorder::detachAsPicture(const SkRect* cull) {
         case State::kEmpty:
             once([]{ empty = new SkEmptyPicture; });
             return sk_ref_sp(empty);
+        CASE(DrawImage);
+        CASE(DrawOval);
         CASE(DrawPath);
         CASE(DrawRect);
+        CASE(DrawRRect);
         CASE(DrawTextBlob);
     }
     SkASSERT(false);
@@ -128,8 +157,11 @@ void SkMiniRecorder::flushAndReset(SkCanvas* canvas) {
 
     switch (fState) {
         case State::kEmpty: return;
+        CASE(DrawImage);
+        CASE(DrawOval);
         CASE(DrawPath);
         CASE(DrawRect);
+        CASE(DrawRRect);
         CASE(DrawTextBlob);
     }
     SkASSERT(false);
@@ -20,8 +20,11 @@ public:
     ~SkMiniRecorder();
 
     // Try to record an op.  Returns false on failure.
+    bool drawImage(const SkImage*, SkScalar x, SkScalar y, const SkPaint*);
+    bool drawOval(const SkRect&, const SkPaint&);
     bool drawPath(const SkPath&, const SkPaint&);
     bool drawRect(const SkRect&, const SkPaint&);
+    bool drawRRect(const SkRRect&, const SkPaint&);
     bool drawTextBlob(const SkTextBlob*, SkScalar x, SkScalar y, const SkPaint&);
 
     // Detach anything we've recorded as a picture, resetting this SkMiniRecorder.
@@ -37,8 +40,11 @@ public:
 private:
     enum class State {
         kEmpty,
+        kDrawImage,
+        kDrawOval,
         kDrawPath,
         kDrawRect,
+        kDrawRRect,
         kDrawTextBlob,
     };
 
@@ -48,9 +54,12 @@ private:
     struct Max { static const size_t val = A > B ? A : B; };
 
     static const size_t kInlineStorage =
+        Max<sizeof(SkRecords::DrawImage),
+        Max<sizeof(SkRecords::DrawOval),
         Max<sizeof(SkRecords::DrawPath),
         Max<sizeof(SkRecords::DrawRect),
-            sizeof(SkRecords::DrawTextBlob)>::val>::val;
+        Max<sizeof(SkRecords::DrawRRect),
+            sizeof(SkRecords::DrawTextBlob)>::val>::val>::val>::val>::val;
     SkAlignedSStorage<kInlineStorage> fBuffer;
 };
 
@@ -13,6 +13,7 @@
 #include "SkImageInfoPriv.h"
 #include "SkMathPriv.h"
 #include "SkNx.h"
+#include "SkTaskGroup.h"
 #include "SkTo.h"
 #include "SkTypes.h"
 #include <new>
@@ -311,9 +312,63 @@ size_t SkMipMap::AllocLevelsSize(int levelCount, size_t pixelSize) {
     return SkTo<int32_t>(size);
 }
 
-SkMipMap* SkMipMap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact) {
-    typedef void FilterProc(void*, const void* srcPtr, size_t srcRB, int count);
+typedef void FilterProc(void*, const void* srcPtr, size_t srcRB, int count);
 
+// The last row of the parent that row y of its child reads from.
+static int last_parent_row(int y, int parentHeight) {
+    if (1 == parentHeight) {
+        return 0;
+    }
+    return 2 * y + ((parentHeight & 1) ? 2 : 1);
+}
+
+static void downsample_rows(FilterProc* proc, const SkPixmap& parent, const SkPixmap& dst,
+                            int top, int bottom) {
+    const size_t srcRB = parent.rowBytes();
+    const char* srcPtr = (const char*)parent.addr() + 2 * top * srcRB;
+    for (int y = top; y < bottom; y++) {
+        proc(dst.writable_addr(0, y), srcPtr, srcRB, dst.width());
+        srcPtr += 2 * srcRB;  // jump two rows
+    }
+}
+
+// Fills levels [first, count), whose parent at first is base, a strip of rows at a time.  Each
+// level catches up as far as its parent allows right after the parent's rows are written, so
+// they're usually still in cache, rather than every level re-reading its parent from memory.
+static void cascade_levels(const SkPixmap& base, const SkMipMap::Level* levels,
+                           FilterProc* const procs[], int first, int count) {
+    constexpr int kStripRows = 8;
+
+    SkAutoSTMalloc<32, int> done(count);
+    for (int i = first; i < count; i++) {
+        done[i] = 0;
+    }
+
+    const SkPixmap& top = levels[first].fPixmap;
+    while (done[first] < top.height()) {
+        const int bottom = SkTMin(done[first] + kStripRows, top.height());
+        downsample_rows(procs[first], base, top, done[first], bottom);
+        done[first] = bottom;
+
+        for (int i = first + 1; i < count; i++) {
+            const SkPixmap& parent = levels[i - 1].fPixmap;
+            const SkPixmap& dst = levels[i].fPixmap;
+
+            int end = done[i];
+            while (end < dst.height() && last_parent_row(end, parent.height()) < done[i - 1]) {
+                end++;
+            }
+            if (end == done[i]) {
+                break;  // If this level can't move, nothing below it can either.
+            }
+            downsample_rows(procs[i], parent, dst, done[i], end);
+            done[i] = end;
+        }
+    }
+}
+
+SkMipMap* SkMipMap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
+                          SkExecutor* executor) {
     FilterProc* proc_1_2 = nullptr;
     FilterProc* proc_1_3 = nullptr;
     FilterProc* proc_2_1 = nullptr;
@@ -423,12 +478,14 @@ SkMipMap* SkMipMap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact) {
     int         width = src.width();
     int         height = src.height();
     uint32_t    rowBytes;
-    SkPixmap    srcPM(src);
 
     // Depending on architecture and other factors, the pixel data alignment may need to be as
     // large as 8 (for F16 pixels). See the comment on SkMipMap::Level.
     SkASSERT(SkIsAlign8((uintptr_t)addr));
 
+    // Lay out every level and pick its filter first, so that we can then fill them in whatever
+    // order is kindest to the cache.
+    SkAutoSTMalloc<32, FilterProc*> procs(countLevels);
     for (int i = 0; i < countLevels; ++i) {
         FilterProc* proc;
         if (height & 1) {
@@ -470,22 +527,36 @@ SkMipMap* SkMipMap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact) {
         new (&levels[i].fPixmap) SkPixmap(SkImageInfo::Make(width, height, ct, at), addr, rowBytes);
         levels[i].fScale  = SkSize::Make(SkIntToScalar(width)  / src.width(),
                                          SkIntToScalar(height) / src.height());
-
-        const SkPixmap& dstPM = levels[i].fPixmap;
-        const void* srcBasePtr = srcPM.addr();
-        void* dstBasePtr = dstPM.writable_addr();
-
-        const size_t srcRB = srcPM.rowBytes();
-        for (int y = 0; y < height; y++) {
-            proc(dstBasePtr, srcBasePtr, srcRB, width);
-            srcBasePtr = (char*)srcBasePtr + srcRB * 2; // jump two rows
-            dstBasePtr = (char*)dstBasePtr + dstPM.rowBytes();
-        }
-        srcPM = dstPM;
+        procs[i] = proc;
         addr += height * rowBytes;
     }
     SkASSERT(addr == baseAddr + size);
 
+    int first = 0;
+    if (executor) {
+        // Big levels are split into bands of rows, one level at a time.  Once a level is small
+        // enough, the rest aren't worth the synchronization, and cascade on this thread.
+        constexpr int kMinParallelPixels = 256 * 256;
+        constexpr int kBandRows = 32;
+        SkTaskGroup taskGroup(*executor);
+        for (; first < countLevels; first++) {
+            const SkPixmap& parent = first ? levels[first - 1].fPixmap : src;
+            const SkPixmap& dst = levels[first].fPixmap;
+            if ((int64_t)dst.width() * dst.height() < kMinParallelPixels) {
+                break;
+            }
+            taskGroup.batch((dst.height() + kBandRows - 1) / kBandRows, [&](int band) {
+                downsample_rows(procs[first], parent, dst, band * kBandRows,
+                                SkTMin((band + 1) * kBandRows, dst.height()));
+            });
+            taskGroup.wait();
+        }
+    }
+    if (first < countLevels) {
+        cascade_levels(first ? levels[first - 1].fPixmap : src, levels, procs.get(), first,
+                       countLevels);
+    }
+
     SkASSERT(mipmap->fLevels);
     return mipmap;
 }
@@ -595,12 +666,13 @@ bool SkMipMap::extractLevel(const SkSize& scaleSize, Level* levelPtr) const {
 
 // Helper which extracts a pixmap from the src bitmap
 //
-SkMipMap* SkMipMap::Build(const SkBitmap& src, SkDiscardableFactoryProc fact) {
+SkMipMap* SkMipMap::Build(const SkBitmap& src, SkDiscardableFactoryProc fact,
+                          SkExecutor* executor) {
     SkPixmap srcPixmap;
     if (!src.peekPixels(&srcPixmap)) {
         return nullptr;
     }
-    return Build(srcPixmap, fact);
+    return Build(srcPixmap, fact, executor);
 }
 
 int SkMipMap::countLevels() const {
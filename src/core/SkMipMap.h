@@ -17,6 +17,7 @@
 
 class SkBitmap;
 class SkDiscardableMemory;
+class SkExecutor;
 
 typedef SkDiscardableMemory* (*SkDiscardableFactoryProc)(size_t bytes);
 
@@ -29,8 +30,11 @@ typedef SkDiscardableMemory* (*SkDiscardableFactoryProc)(size_t bytes);
  */
 class SkMipMap : public SkCachedData {
 public:
-    static SkMipMap* Build(const SkPixmap& src, SkDiscardableFactoryProc);
-    static SkMipMap* Build(const SkBitmap& src, SkDiscardableFactoryProc);
+    // If executor is not null, the larger levels are built across several threads on it.
+    static SkMipMap* Build(const SkPixmap& src, SkDiscardableFactoryProc,
+                           SkExecutor* executor = nullptr);
+    static SkMipMap* Build(const SkBitmap& src, SkDiscardableFactoryProc,
+                           SkExecutor* executor = nullptr);
 
     // Determines how many levels a SkMipMap will have without creating that mipmap.
     // This does not include the base mipmap level that the user provided when
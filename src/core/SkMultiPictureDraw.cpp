@@ -5,11 +5,14 @@
  * found in the LICENSE file.
  */
 
+#include "SkBigPicture.h"
 #include "SkCanvas.h"
 #include "SkCanvasPriv.h"
 #include "SkMultiPictureDraw.h"
 #include "SkPicture.h"
+#include "SkPicturePriv.h"
 #include "SkTaskGroup.h"
+#include "../gpu/GrLayerHoister.h"  // Used only when SK_SUPPORT_GPU, but always owned.
 
 void SkMultiPictureDraw::DrawData::draw() {
     fCanvas->drawPicture(fPicture, &fMatrix, fPaint);
@@ -48,6 +51,14 @@ SkMultiPictureDraw::SkMultiPictureDraw(int reserve) {
     }
 }
 
+SkMultiPictureDraw::~SkMultiPictureDraw() {
+    this->reset();
+}
+
+void SkMultiPictureDraw::setLayerCacheLimit(size_t bytes) {
+    fLayerHoister.reset(bytes ? new GrLayerHoister(bytes) : nullptr);
+}
+
 void SkMultiPictureDraw::reset() {
     DrawData::Reset(fGPUDrawData);
     DrawData::Reset(fThreadSafeDrawData);
@@ -101,7 +112,17 @@ void SkMultiPictureDraw::draw(bool flush) {
         SkCanvas* canvas = data.fCanvas;
         const SkPicture* picture = data.fPicture;
 
-        canvas->drawPicture(picture, &data.fMatrix, data.fPaint);
+#if SK_SUPPORT_GPU
+        const SkBigPicture* big = fLayerHoister ? SkPicturePriv::AsSkBigPicture(sk_ref_sp(picture))
+                                                : nullptr;
+        if (big) {
+            SkAutoCanvasMatrixPaint acmp(canvas, &data.fMatrix, data.fPaint, big->cullRect());
+            fLayerHoister->drawPicture(canvas, big);
+        } else
+#endif
+        {
+            canvas->drawPicture(picture, &data.fMatrix, data.fPaint);
+        }
         if (flush) {
             canvas->flush();
         }
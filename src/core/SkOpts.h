@@ -12,7 +12,9 @@
 #include "SkTypes.h"
 #include "SkXfermodePriv.h"
 
+class SkMatrix;
 struct SkBitmapProcState;
+struct SkPoint;
 
 namespace SkOpts {
     // Call to replace pointers to portable functions with pointers to CPU-specific functions.
@@ -47,6 +49,20 @@ namespace SkOpts {
     extern void SK_API (*memset32)(uint32_t[], uint32_t, int);
     extern void (*memset64)(uint64_t[], uint64_t, int);
 
+    // SkMaskBlurFilter's box passes over four A8 rows at once, transposing as they go.
+    extern void (*box_blur_a8_x4)(const uint8_t* src, size_t srcRB, int srcW,
+                                  uint8_t* dst, size_t dstStride, int dstW,
+                                  int noChangeCount, const int passSizes[3],
+                                  uint32_t weight, uint32_t* buffer);
+
+    // Running sums a row of SkCoverageDeltaMask's SkFixed deltas into alphas.
+    extern void (*accumulate_coverage_deltas)(const int32_t* deltas, SkAlpha* alphas, int width,
+                                              bool isEvenOdd, bool isInverse, bool isConvex);
+
+    // SkMatrix's MapPtsProcs for affine and perspective matrices, N points at a time.
+    extern void (*matrix_affine_pts)(const SkMatrix&, SkPoint dst[], const SkPoint src[], int);
+    extern void (*matrix_persp_pts )(const SkMatrix&, SkPoint dst[], const SkPoint src[], int);
+
     // The fastest high quality 32-bit hash we can provide on this platform.
     extern uint32_t (*hash_fn)(const void*, size_t, uint32_t seed);
     static inline uint32_t hash(const void* data, size_t bytes, uint32_t seed=0) {
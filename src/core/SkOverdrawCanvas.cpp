@@ -34,11 +34,12 @@ public:
         int top = SkScalarFloorToInt(position.fY) + glyph.fTop;
         int right = left + glyph.fWidth;
         int bottom = top + glyph.fHeight;
-        fCanvas->onDrawRect(SkRect::MakeLTRB(left, top, right, bottom), SkPaint());
+        fCanvas->onDrawRect(SkRect::MakeLTRB(left, top, right, bottom), fPaint);
     }
 
 private:
     SkOverdrawCanvas* fCanvas;
+    SkPaint           fPaint;
 };
 };
 
@@ -59,6 +60,7 @@ SkOverdrawCanvas::SkOverdrawCanvas(SkCanvas* canvas)
     fPaint.setAntiAlias(false);
     fPaint.setBlendMode(SkBlendMode::kPlus);
     fPaint.setColorFilter(SkColorFilter::MakeMatrixFilterRowMajor255(kIncrementAlpha));
+    fStrokePaint = fPaint;
 }
 
 void SkOverdrawCanvas::drawPosTextCommon(const SkGlyphID glyphs[], int count, const SkScalar pos[],
@@ -166,14 +168,8 @@ void SkOverdrawCanvas::onDrawVerticesObject(const SkVertices* vertices,
 void SkOverdrawCanvas::onDrawAtlas(const SkImage* image, const SkRSXform xform[],
                                    const SkRect texs[], const SkColor colors[], int count,
                                    SkBlendMode mode, const SkRect* cull, const SkPaint* paint) {
-    SkPaint* paintPtr = &fPaint;
-    SkPaint storage;
-    if (paint) {
-        storage = this->overdrawPaint(*paint);
-        paintPtr = &storage;
-    }
-
-    fList[0]->onDrawAtlas(image, xform, texs, colors, count, mode, cull, paintPtr);
+    const SkPaint& overdrawPaint = paint ? this->overdrawPaint(*paint) : fPaint;
+    fList[0]->onDrawAtlas(image, xform, texs, colors, count, mode, cull, &overdrawPaint);
 }
 
 void SkOverdrawCanvas::onDrawPath(const SkPath& path, const SkPaint& paint) {
@@ -260,9 +256,14 @@ void SkOverdrawCanvas::onDrawShadowRec(const SkPath& path, const SkDrawShadowRec
     fList[0]->onDrawRect(bounds, fPaint);
 }
 
-inline SkPaint SkOverdrawCanvas::overdrawPaint(const SkPaint& paint) {
-    SkPaint newPaint = fPaint;
-    newPaint.setStyle(paint.getStyle());
-    newPaint.setStrokeWidth(paint.getStrokeWidth());
-    return newPaint;
+// Only the geometry of a draw matters, so every draw shares fPaint, or fStrokePaint when stroked.
+// The returned paint is only good until the next call.
+inline const SkPaint& SkOverdrawCanvas::overdrawPaint(const SkPaint& paint) {
+    if (paint.getStyle() == fPaint.getStyle() &&
+        paint.getStrokeWidth() == fPaint.getStrokeWidth()) {
+        return fPaint;
+    }
+    fStrokePaint.setStyle(paint.getStyle());
+    fStrokePaint.setStrokeWidth(paint.getStrokeWidth());
+    return fStrokePaint;
 }
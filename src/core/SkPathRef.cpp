@@ -89,11 +89,19 @@ void SkPath::shrinkToFit() {
 
 //////////////////////////////////////////////////////////////////////////////
 
+struct SkPathRef::GenIDChangeListeners {
+    SkMutex                         fMutex;
+    SkTDArray<GenIDChangeListener*> fListeners;  // pointers are reffed
+};
+
 SkPathRef::~SkPathRef() {
     // Deliberately don't validate() this path ref, otherwise there's no way
     // to read one that's not valid and then free its memory without asserting.
     this->callGenIDChangeListeners();
-    SkASSERT(fGenIDChangeListeners.empty());  // These are raw ptrs.
+    if (GenIDChangeListeners* listeners = fGenIDChangeListeners.load(std::memory_order_relaxed)) {
+        SkASSERT(listeners->fListeners.empty());  // These are raw ptrs.
+        delete listeners;
+    }
     sk_free(fPoints);
 
     SkDEBUGCODE(fPoints = nullptr;)
@@ -713,24 +721,41 @@ void SkPathRef::addGenIDChangeListener(sk_sp<GenIDChangeListener> listener) {
         return;
     }
 
-    SkAutoMutexAcquire lock(fGenIDChangeListenersMutex);
+    GenIDChangeListeners* listeners = fGenIDChangeListeners.load(std::memory_order_acquire);
+    if (!listeners) {
+        // Another thread may be racing us to add the first listener.
+        auto* newListeners = new GenIDChangeListeners;
+        if (fGenIDChangeListeners.compare_exchange_strong(listeners, newListeners,
+                                                          std::memory_order_acq_rel)) {
+            listeners = newListeners;
+        } else {
+            delete newListeners;
+        }
+    }
+
+    SkAutoMutexAcquire lock(listeners->fMutex);
 
     // Clean out any stale listeners before we append the new one.
-    for (int i = 0; i < fGenIDChangeListeners.count(); ++i) {
-        if (fGenIDChangeListeners[i]->shouldUnregisterFromPath()) {
-            fGenIDChangeListeners[i]->unref();
-            fGenIDChangeListeners.removeShuffle(i--);  // No need to preserve the order after i.
+    for (int i = 0; i < listeners->fListeners.count(); ++i) {
+        if (listeners->fListeners[i]->shouldUnregisterFromPath()) {
+            listeners->fListeners[i]->unref();
+            listeners->fListeners.removeShuffle(i--);  // No need to preserve the order after i.
         }
     }
 
     SkASSERT(!listener->shouldUnregisterFromPath());
-    *fGenIDChangeListeners.append() = listener.release();
+    *listeners->fListeners.append() = listener.release();
 }
 
 // we need to be called *before* the genID gets changed or zerod
 void SkPathRef::callGenIDChangeListeners() {
-    SkAutoMutexAcquire lock(fGenIDChangeListenersMutex);
-    for (GenIDChangeListener* listener : fGenIDChangeListeners) {
+    GenIDChangeListeners* listeners = fGenIDChangeListeners.load(std::memory_order_acquire);
+    if (!listeners) {
+        return;
+    }
+
+    SkAutoMutexAcquire lock(listeners->fMutex);
+    for (GenIDChangeListener* listener : listeners->fListeners) {
         if (!listener->shouldUnregisterFromPath()) {
             listener->onChange();
         }
@@ -738,7 +763,7 @@ void SkPathRef::callGenIDChangeListeners() {
         listener->unref();
     }
 
-    fGenIDChangeListeners.reset();
+    listeners->fListeners.reset();
 }
 
 SkRRect SkPathRef::getRRect() const {
@@ -0,0 +1,284 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkPersistentStrikeStore.h"
+
+#include "SkOpts.h"
+#include "SkScalerContext.h"
+#include "SkStream.h"
+#include "SkStrikeSerialization.h"
+#include "SkString.h"
+#include "SkTemplates.h"
+#include "SkTypeface.h"
+
+#include <cstdio>
+
+// File layout, all in native byte order:
+//   uint32_t magic, uint32_t version, uint64_t strikeCount
+//   per strike: uint32_t descChecksum, uint32_t fontHash, uint64_t size, then size bytes of
+//               descriptor, SkFontMetrics, uint64_t glyphCount and per glyph
+//               (glyph, uint64_t imageSize, image, uint64_t pathSize, path).
+static const uint32_t kMagic   = SkSetFourByteTag('S', 'K', 'G', 'S');
+static const uint32_t kVersion = 1;
+static const size_t   kStrikeAlignment = 8;
+
+// The font ID is only meaningful within one process, so we leave it out of the key and rely
+// on the font hash to tell typefaces apart instead.
+static const SkDescriptor* normalized_descriptor(const SkDescriptor& source,
+                                                 SkAutoDescriptor* ad) {
+    uint32_t size;
+    auto ptr = source.findEntry(kRec_SkDescriptorTag, &size);
+    if (!ptr || size != sizeof(SkScalerContextRec)) {
+        return nullptr;
+    }
+
+    ad->reset(source.getLength());
+    auto* desc = ad->getDesc();
+    desc->init();
+
+    SkScalerContextRec rec;
+    std::memcpy(&rec, ptr, size);
+    rec.fFontID = 0;
+    desc->addEntry(kRec_SkDescriptorTag, sizeof(rec), &rec);
+
+    if (auto effects = source.findEntry(kEffects_SkDescriptorTag, &size)) {
+        desc->addEntry(kEffects_SkDescriptorTag, size, effects);
+    }
+
+    desc->computeChecksum();
+    return desc;
+}
+
+sk_sp<SkPersistentStrikeStore> SkPersistentStrikeStore::Make(const char path[]) {
+    sk_sp<SkData> data = SkData::MakeFromFileName(path);
+    if (!data) {
+        return nullptr;
+    }
+    sk_sp<SkPersistentStrikeStore> store(new SkPersistentStrikeStore(std::move(data)));
+    return store->index() ? store : nullptr;
+}
+
+SkPersistentStrikeStore::SkPersistentStrikeStore(sk_sp<SkData> data) : fData(std::move(data)) {}
+
+bool SkPersistentStrikeStore::index() {
+    Deserializer deserializer(static_cast<const volatile char*>(fData->data()), fData->size());
+
+    uint32_t magic, version;
+    uint64_t strikeCount;
+    if (!deserializer.read<uint32_t>(&magic) || magic != kMagic) return false;
+    if (!deserializer.read<uint32_t>(&version) || version != kVersion) return false;
+    if (!deserializer.read<uint64_t>(&strikeCount)) return false;
+
+    for (uint64_t i = 0; i < strikeCount; i++) {
+        Key key;
+        uint64_t size;
+        if (!deserializer.read<uint32_t>(&key.fDescChecksum)) return false;
+        if (!deserializer.read<uint32_t>(&key.fFontHash)) return false;
+        if (!deserializer.read<uint64_t>(&size)) return false;
+
+        auto* memory = deserializer.read(size, kStrikeAlignment);
+        if (!memory) return false;
+        fStrikes.set(key, Entry{memory, size});
+    }
+    return true;
+}
+
+uint32_t SkPersistentStrikeStore::FontHash(const SkTypeface& typeface) {
+    int ttcIndex = 0;
+    std::unique_ptr<SkStreamAsset> stream = typeface.openStream(&ttcIndex);
+    if (!stream || stream->getLength() == 0) {
+        return 0;
+    }
+
+    uint32_t hash;
+    if (const void* base = stream->getMemoryBase()) {
+        hash = SkOpts::hash(base, stream->getLength(), ttcIndex);
+    } else {
+        sk_sp<SkData> data = SkData::MakeFromStream(stream.get(), stream->getLength());
+        if (!data) {
+            return 0;
+        }
+        hash = SkOpts::hash(data->data(), data->size(), ttcIndex);
+    }
+
+    using Coordinate = SkFontArguments::VariationPosition::Coordinate;
+    int axisCount = typeface.getVariationDesignPosition(nullptr, 0);
+    if (axisCount > 0) {
+        SkAutoSTMalloc<4, Coordinate> coordinates(axisCount);
+        if (typeface.getVariationDesignPosition(coordinates.get(), axisCount) == axisCount) {
+            hash = SkOpts::hash(coordinates.get(), axisCount * sizeof(Coordinate), hash);
+        }
+    }
+
+    // 0 means "can't be persisted".
+    return hash ? hash : 1;
+}
+
+uint32_t SkPersistentStrikeStore::cachedFontHash(const SkTypeface& typeface) const {
+    SkAutoMutexAcquire lock(fFontHashMutex);
+    if (uint32_t* hash = fFontHashes.find(typeface.uniqueID())) {
+        return *hash;
+    }
+    return *fFontHashes.set(typeface.uniqueID(), FontHash(typeface));
+}
+
+bool SkPersistentStrikeStore::populate(const SkDescriptor& desc, const SkTypeface& typeface,
+                                       SkStrike* strike) const {
+    uint32_t fontHash = this->cachedFontHash(typeface);
+    if (fontHash == 0) {
+        return false;
+    }
+
+    SkAutoDescriptor ad;
+    const SkDescriptor* key = normalized_descriptor(desc, &ad);
+    if (!key) {
+        return false;
+    }
+
+    const Entry* entry = fStrikes.find(Key{key->getChecksum(), fontHash});
+    if (!entry) {
+        return false;
+    }
+
+    Deserializer deserializer(static_cast<const volatile char*>(entry->fMemory), entry->fSize);
+
+    // The checksum only picked the entry; make sure it really is this strike.
+    SkAutoDescriptor stored;
+    if (!deserializer.readDescriptor(&stored)) return false;
+    if (stored.getDesc()->getLength() != key->getLength() || *stored.getDesc() != *key) {
+        return false;
+    }
+
+    SkFontMetrics fontMetrics;
+    if (!deserializer.read<SkFontMetrics>(&fontMetrics)) return false;
+
+    uint64_t glyphCount = 0u;
+    if (!deserializer.read<uint64_t>(&glyphCount)) return false;
+
+    for (uint64_t i = 0; i < glyphCount; i++) {
+        SkTLazy<SkGlyph> glyph;
+        if (!readGlyph(glyph, &deserializer)) return false;
+
+        // Read everything for this glyph before touching the strike, so a truncated file
+        // can't leave a glyph behind without its metrics.
+        uint64_t imageSize = 0u;
+        if (!deserializer.read<uint64_t>(&imageSize)) return false;
+        if (imageSize != 0u && imageSize != glyph->computeImageSize()) return false;
+        auto* image = imageSize ? deserializer.read(imageSize, glyph->formatAlignment())
+                                : nullptr;
+        if (imageSize && !image) return false;
+
+        uint64_t pathSize = 0u;
+        if (!deserializer.read<uint64_t>(&pathSize)) return false;
+        auto* path = pathSize ? deserializer.read(pathSize, kPathAlignment) : nullptr;
+        if (pathSize && !path) return false;
+
+        SkGlyph* allocatedGlyph = strike->getRawGlyphByID(glyph->getPackedID());
+        if (allocatedGlyph->fMaskFormat != MASK_FORMAT_UNKNOWN) {
+            continue;
+        }
+        *allocatedGlyph = *glyph;
+
+        if (image) {
+            strike->initializeImage(image, imageSize, allocatedGlyph);
+        }
+        if (path) {
+            // A bad path only costs us that path; the scaler will be asked for it again.
+            strike->initializePath(allocatedGlyph, path, pathSize);
+        }
+    }
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+SkPersistentStrikeStore::Writer::Writer() {
+    Serializer serializer(&fBuffer);
+    serializer.write<uint32_t>(kMagic);
+    serializer.write<uint32_t>(kVersion);
+    serializer.write<uint64_t>(0u);  // strike count, patched in finish()
+}
+
+void SkPersistentStrikeStore::Writer::appendStrike(const SkStrike& strike) {
+    const SkTypeface* typeface = strike.getScalerContext()->getTypeface();
+    if (!typeface) {
+        return;
+    }
+
+    uint32_t fontHash;
+    if (uint32_t* hash = fFontHashes.find(typeface->uniqueID())) {
+        fontHash = *hash;
+    } else {
+        fontHash = *fFontHashes.set(typeface->uniqueID(), FontHash(*typeface));
+    }
+    if (fontHash == 0) {
+        return;
+    }
+
+    SkAutoDescriptor ad;
+    const SkDescriptor* key = normalized_descriptor(strike.getDescriptor(), &ad);
+    if (!key) {
+        return;
+    }
+
+    uint64_t glyphCount = 0u;
+    strike.forEachCachedGlyph([&glyphCount](const SkGlyph& glyph) {
+        if (glyph.isFullMetrics() && glyph.fMaskFormat != MASK_FORMAT_UNKNOWN) {
+            glyphCount++;
+        }
+    });
+
+    std::vector<uint8_t> body;
+    Serializer serializer(&body);
+    serializer.writeDescriptor(*key);
+    serializer.write<SkFontMetrics>(strike.getFontMetrics());
+    serializer.write<uint64_t>(glyphCount);
+
+    strike.forEachCachedGlyph([&serializer](const SkGlyph& glyph) {
+        if (!glyph.isFullMetrics() || glyph.fMaskFormat == MASK_FORMAT_UNKNOWN) {
+            return;
+        }
+        SkGlyph copy = glyph;
+        writeGlyph(&copy, &serializer);
+
+        uint64_t imageSize = glyph.fImage ? glyph.computeImageSize() : 0u;
+        serializer.write<uint64_t>(imageSize);
+        if (imageSize) {
+            memcpy(serializer.allocate(imageSize, glyph.formatAlignment()), glyph.fImage,
+                   imageSize);
+        }
+
+        const SkPath* path = glyph.path();
+        uint64_t pathSize = path ? path->writeToMemory(nullptr) : 0u;
+        serializer.write<uint64_t>(pathSize);
+        if (pathSize) {
+            path->writeToMemory(serializer.allocate(pathSize, kPathAlignment));
+        }
+    });
+
+    Serializer out(&fBuffer);
+    out.write<uint32_t>(key->getChecksum());
+    out.write<uint32_t>(fontHash);
+    out.write<uint64_t>(body.size());
+    memcpy(out.allocate(body.size(), kStrikeAlignment), body.data(), body.size());
+    fStrikeCount++;
+}
+
+bool SkPersistentStrikeStore::Writer::finish(const char path[]) {
+    memcpy(fBuffer.data() + 2 * sizeof(uint32_t), &fStrikeCount, sizeof(fStrikeCount));
+
+    // Write to the side and rename, so that other processes mapping path never see a
+    // partly written store.
+    SkString tmpPath = SkStringPrintf("%s.tmp", path);
+    {
+        SkFILEWStream stream(tmpPath.c_str());
+        if (!stream.isValid() || !stream.write(fBuffer.data(), fBuffer.size())) {
+            return false;
+        }
+    }
+    return std::rename(tmpPath.c_str(), path) == 0;
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkPersistentStrikeStore_DEFINED
+#define SkPersistentStrikeStore_DEFINED
+
+#include "SkData.h"
+#include "SkMutex.h"
+#include "SkRefCnt.h"
+#include "SkTHash.h"
+#include "SkTypes.h"
+
+#include <vector>
+
+class SkDescriptor;
+class SkStrike;
+class SkTypeface;
+
+/**
+ *  Glyphs (metrics, masks and paths) saved by an earlier process, so that short-lived processes
+ *  don't have to rasterize every glyph again from the font.
+ *
+ *  Strikes are keyed by the checksum of their SkDescriptor, with the process-specific font ID
+ *  taken out, plus a hash of the typeface's font data and variation position. The file is
+ *  memory-mapped and indexed when opened; new strikes then copy their glyphs out of it as they
+ *  are created. The glyphs use the same wire format as SkRemoteGlyphCache.
+ */
+class SkPersistentStrikeStore : public SkRefCnt {
+public:
+    // Returns nullptr if path can't be read or isn't a store written by a Writer.
+    static sk_sp<SkPersistentStrikeStore> Make(const char path[]);
+
+    // Copy whatever glyphs we have for this strike into it. Returns true if we found the strike.
+    bool populate(const SkDescriptor&, const SkTypeface&, SkStrike*) const;
+
+    size_t mappedBytes() const { return fData->size(); }
+    int strikeCount() const { return fStrikes.count(); }
+
+    /**
+     *  Writing a store: call appendStrike() for each strike to save, then finish() to write
+     *  everything to path. Typefaces without font data we can hash (e.g. remote typefaces) are
+     *  skipped.
+     */
+    class Writer {
+    public:
+        Writer();
+        void appendStrike(const SkStrike&);
+        bool finish(const char path[]);
+
+    private:
+        std::vector<uint8_t> fBuffer;
+        uint64_t             fStrikeCount{0};
+        SkTHashMap<uint32_t, uint32_t> fFontHashes;  // typeface uniqueID -> font hash
+    };
+
+private:
+    struct Key {
+        uint32_t fDescChecksum;
+        uint32_t fFontHash;
+
+        bool operator==(const Key& that) const {
+            return fDescChecksum == that.fDescChecksum && fFontHash == that.fFontHash;
+        }
+    };
+
+    struct Entry {
+        const volatile void* fMemory;
+        size_t               fSize;
+    };
+
+    explicit SkPersistentStrikeStore(sk_sp<SkData>);
+    bool index();
+
+    static uint32_t FontHash(const SkTypeface&);
+    uint32_t cachedFontHash(const SkTypeface&) const;
+
+    sk_sp<SkData>           fData;
+    SkTHashMap<Key, Entry>  fStrikes;
+
+    mutable SkMutex                        fFontHashMutex;
+    mutable SkTHashMap<uint32_t, uint32_t> fFontHashes;  // typeface uniqueID -> font hash
+};
+
+#endif  // SkPersistentStrikeStore_DEFINED
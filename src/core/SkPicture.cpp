@@ -7,6 +7,7 @@
 
 #include "SkPicture.h"
 
+#include "SkBigPicture.h"
 #include "SkImageGenerator.h"
 #include "SkMathPriv.h"
 #include "SkPictureCommon.h"
@@ -15,6 +16,7 @@
 #include "SkPicturePriv.h"
 #include "SkPictureRecord.h"
 #include "SkPictureRecorder.h"
+#include "SkPlaybackPicture.h"
 #include "SkSerialProcs.h"
 #include "SkTo.h"
 #include <atomic>
@@ -152,8 +154,18 @@ sk_sp<SkPicture> SkPicture::MakeFromData(const SkData* data, const SkDeserialPro
     return MakeFromStream(&stream, procs, nullptr);
 }
 
+sk_sp<SkPicture> SkPicture::MakeFromSharedData(sk_sp<SkData> data,
+                                               const SkDeserialProcs* procs) {
+    if (!data) {
+        return nullptr;
+    }
+    SkMemoryStream stream(data);
+    return MakeFromStream(&stream, procs, nullptr, data.get());
+}
+
 sk_sp<SkPicture> SkPicture::MakeFromStream(SkStream* stream, const SkDeserialProcs* procsPtr,
-                                           SkTypefacePlayback* typefaces) {
+                                           SkTypefacePlayback* typefaces,
+                                           const SkData* inPlace) {
     SkPictInfo info;
     if (!StreamIsSKP(stream, &info)) {
         return nullptr;
@@ -168,8 +180,17 @@ sk_sp<SkPicture> SkPicture::MakeFromStream(SkStream* stream, const SkDeserialPro
     if (!stream->readU8(&trailingStreamByteAfterPictInfo)) { return nullptr; }
     switch (trailingStreamByteAfterPictInfo) {
         case kPictureData_TrailingStreamByteAfterPictInfo: {
+            if (info.getVersion() >= SkReadBuffer::kAlignedPictureData_Version) {
+                uint8_t padding[3];
+                if (stream->read(padding, sizeof(padding)) != sizeof(padding)) {
+                    return nullptr;
+                }
+            }
             std::unique_ptr<SkPictureData> data(
-                    SkPictureData::CreateFromStream(stream, info, procs, typefaces));
+                    SkPictureData::CreateFromStream(stream, info, procs, typefaces, inPlace));
+            if (inPlace) {
+                return SkPlaybackPicture::Make(info.fCullRect, std::move(data));
+            }
             return Forwardport(info, data.get(), nullptr);
         }
         case kCustom_TrailingStreamByteAfterPictInfo: {
@@ -217,7 +238,11 @@ SkPictureData* SkPicture::backport() const {
     SkPictInfo info = this->createHeader();
     SkPictureRecord rec(SkISize::Make(info.fCullRect.width(), info.fCullRect.height()), 0/*flags*/);
     rec.beginRecording();
-        this->playback(&rec);
+        if (const SkBigPicture* big = this->asSkBigPicture()) {
+            big->playbackWithBounds(&rec);
+        } else {
+            this->playback(&rec);
+        }
     rec.endRecording();
     return new SkPictureData(rec, info);
 }
@@ -227,7 +252,7 @@ void SkPicture::serialize(SkWStream* stream, const SkSerialProcs* procs) const {
 }
 
 sk_sp<SkData> SkPicture::serialize(const SkSerialProcs* procs) const {
-    SkDynamicMemoryWStream stream;
+    SkDataListWStream stream;
     this->serialize(&stream, procs, nullptr);
     return stream.detachAsData();
 }
@@ -282,6 +307,9 @@ void SkPicture::serialize(SkWStream* stream, const SkSerialProcs* procsPtr,
     std::unique_ptr<SkPictureData> data(this->backport());
     if (data) {
         stream->write8(kPictureData_TrailingStreamByteAfterPictInfo);
+        // Pad to keep the picture data aligned for MakeFromSharedData().
+        stream->write8(0);
+        stream->write16(0);
         data->serialize(stream, procs, typefaceSet);
     } else {
         stream->write8(kFailure_TrailingStreamByteAfterPictInfo);
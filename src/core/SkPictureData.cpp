@@ -7,12 +7,12 @@
 
 #include "SkPictureData.h"
 
-#include "SkAutoMalloc.h"
 #include "SkImageGenerator.h"
 #include "SkMakeUnique.h"
 #include "SkPictureRecord.h"
 #include "SkPicturePriv.h"
 #include "SkReadBuffer.h"
+#include "SkSafeMath.h"
 #include "SkTextBlobPriv.h"
 #include "SkTypeface.h"
 #include "SkWriteBuffer.h"
@@ -49,6 +49,17 @@ SkPictureData::SkPictureData(const SkPictureRecord& record,
 
     fOpData = record.opData();
 
+    if (record.fOpGroupsEnd) {
+        const int count = record.fOpGroupOffsets.count();
+        fOpGroups = SkData::MakeUninitialized((count + 1) * sizeof(uint32_t) +
+                                              count * sizeof(SkRect));
+        uint32_t* offsets = static_cast<uint32_t*>(fOpGroups->writable_data());
+        memcpy(offsets, record.fOpGroupOffsets.begin(), count * sizeof(uint32_t));
+        offsets[count] = record.fOpGroupsEnd;
+        memcpy(offsets + count + 1, record.fOpGroupBounds.begin(), count * sizeof(SkRect));
+        fOpGroupCount = count;
+    }
+
     fPaints  = record.fPaints;
 
     fPaths.reset(record.fPaths.count());
@@ -93,6 +104,11 @@ static void write_tag_size(SkWStream* stream, uint32_t tag, size_t size) {
     stream->write32(SkToU32(size));
 }
 
+static void write_pad32(SkWStream* stream, size_t size) {
+    uint32_t zero = 0;
+    stream->write(&zero, SkAlign4(size) - size);
+}
+
 void SkPictureData::WriteFactories(SkWStream* stream, const SkFactorySet& rec) {
     int count = rec.count();
 
@@ -103,7 +119,8 @@ void SkPictureData::WriteFactories(SkWStream* stream, const SkFactorySet& rec) {
     size_t size = compute_chunk_size(array, count);
 
     // TODO: write_tag_size should really take a size_t
-    write_tag_size(stream, SK_PICT_FACTORY_TAG, (uint32_t) size);
+    // The chunk is padded so that what follows it stays aligned.
+    write_tag_size(stream, SK_PICT_FACTORY_TAG, (uint32_t) SkAlign4(size));
     SkDEBUGCODE(size_t start = stream->bytesWritten());
     stream->write32(count);
 
@@ -119,29 +136,37 @@ void SkPictureData::WriteFactories(SkWStream* stream, const SkFactorySet& rec) {
     }
 
     SkASSERT(size == (stream->bytesWritten() - start));
+    write_pad32(stream, size);
 }
 
 void SkPictureData::WriteTypefaces(SkWStream* stream, const SkRefCntSet& rec,
                                    const SkSerialProcs& procs) {
     int count = rec.count();
 
-    write_tag_size(stream, SK_PICT_TYPEFACE_TAG, count);
-
     SkAutoSTMalloc<16, SkTypeface*> storage(count);
     SkTypeface** array = (SkTypeface**)storage.get();
     rec.copyToArray((SkRefCnt**)array);
 
+    // Typefaces don't know their serialized sizes up front, so they're gathered first, and
+    // written after their (padded) size.
+    SkDynamicMemoryWStream typefaces;
     for (int i = 0; i < count; i++) {
         SkTypeface* tf = array[i];
         if (procs.fTypefaceProc) {
             auto data = procs.fTypefaceProc(tf, procs.fTypefaceCtx);
             if (data) {
-                stream->write(data->data(), data->size());
+                typefaces.write(data->data(), data->size());
                 continue;
             }
         }
-        array[i]->serialize(stream);
+        array[i]->serialize(&typefaces);
     }
+
+    size_t size = typefaces.bytesWritten();
+    write_tag_size(stream, SK_PICT_TYPEFACE_TAG, count);
+    stream->write32(SkToU32(SkAlign4(size)));
+    typefaces.writeToAndReset(stream);
+    write_pad32(stream, size);
 }
 
 void SkPictureData::flattenToBuffer(SkWriteBuffer& buffer) const {
@@ -200,7 +225,12 @@ void SkPictureData::serialize(SkWStream* stream, const SkSerialProcs& procs,
                               SkRefCntSet* topLevelTypeFaceSet) const {
     // This can happen at pretty much any time, so might as well do it first.
     write_tag_size(stream, SK_PICT_READER_TAG, fOpData->size());
-    stream->write(fOpData->bytes(), fOpData->size());
+    stream->writeData(fOpData);
+
+    if (fOpGroupCount > 0) {
+        write_tag_size(stream, SK_PICT_OP_GROUPS_TAG, fOpGroupCount);
+        stream->write(fOpGroups->data(), fOpGroups->size());
+    }
 
     // We serialize all typefaces into the typeface section of the top-level picture.
     SkRefCntSet localTypefaceSet;
@@ -277,21 +307,52 @@ void SkPictureData::flatten(SkWriteBuffer& buffer) const {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// Reads the next size bytes of stream. If they're aligned within inPlace, the memory the stream
+// reads from, they're shared rather than copied.
+static sk_sp<SkData> read_data(SkStream* stream, size_t size, const SkData* inPlace) {
+    if (inPlace && stream->getMemoryBase() == inPlace->data() && stream->hasPosition()) {
+        size_t offset = stream->getPosition();
+        if (SkIsAlign4((uintptr_t)inPlace->bytes() + offset) && size <= inPlace->size() - offset) {
+            if (stream->skip(size) != size) {
+                return nullptr;
+            }
+            return SkData::MakeSubset(inPlace, offset, size);
+        }
+    }
+    return SkData::MakeFromStream(stream, size);
+}
+
 bool SkPictureData::parseStreamTag(SkStream* stream,
                                    uint32_t tag,
                                    uint32_t size,
                                    const SkDeserialProcs& procs,
-                                   SkTypefacePlayback* topLevelTFPlayback) {
+                                   SkTypefacePlayback* topLevelTFPlayback,
+                                   const SkData* inPlace) {
     switch (tag) {
         case SK_PICT_READER_TAG:
             SkASSERT(nullptr == fOpData);
-            fOpData = SkData::MakeFromStream(stream, size);
+            fOpData = read_data(stream, size, inPlace);
             if (!fOpData) {
                 return false;
             }
             break;
+        case SK_PICT_OP_GROUPS_TAG: {
+            SkSafeMath safe;
+            size_t bytes = safe.add(safe.mul(size + (size_t)1, sizeof(uint32_t)),
+                                    safe.mul(size, sizeof(SkRect)));
+            if (!safe || !SkTFitsIn<int>(size) || fOpGroups) {
+                return false;
+            }
+            fOpGroups = read_data(stream, bytes, inPlace);
+            if (!fOpGroups) {
+                return false;
+            }
+            fOpGroupCount = SkToInt(size);
+        } break;
         case SK_PICT_FACTORY_TAG: {
+            const size_t chunkSize = size;
             if (!stream->readU32(&size)) { return false; }
+            size_t bytesRead = 4;
             fFactoryPlayback = skstd::make_unique<SkFactoryPlayback>(size);
             for (size_t i = 0; i < size; i++) {
                 SkString str;
@@ -301,13 +362,31 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
                 if (stream->read(str.writable_str(), len) != len) {
                     return false;
                 }
+                bytesRead += SkWStream::SizeOfPackedUInt(len) + len;
                 fFactoryPlayback->base()[i] = SkFlattenable::NameToFactory(str.c_str());
             }
+            // Skip any padding (chunks before V69 weren't padded).
+            const size_t padding = chunkSize > bytesRead ? chunkSize - bytesRead : 0;
+            if (stream->skip(padding) != padding) {
+                return false;
+            }
         } break;
         case SK_PICT_TYPEFACE_TAG: {
+            std::unique_ptr<SkStream> typefaceStream;
+            SkStream* typefaces = stream;
+            if (fInfo.getVersion() >= SkReadBuffer::kAlignedPictureData_Version) {
+                uint32_t byteLength;
+                if (!stream->readU32(&byteLength)) { return false; }
+                sk_sp<SkData> data = read_data(stream, byteLength, inPlace);
+                if (!data) {
+                    return false;
+                }
+                typefaceStream = skstd::make_unique<SkMemoryStream>(std::move(data));
+                typefaces = typefaceStream.get();
+            }
             fTFPlayback.setCount(size);
             for (uint32_t i = 0; i < size; ++i) {
-                sk_sp<SkTypeface> tf(SkTypeface::MakeDeserialize(stream));
+                sk_sp<SkTypeface> tf(SkTypeface::MakeDeserialize(typefaces));
                 if (!tf.get()) {    // failed to deserialize
                     // fTFPlayback asserts it never has a null, so we plop in
                     // the default here.
@@ -321,7 +400,7 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
             fPictures.reserve(SkToInt(size));
 
             for (uint32_t i = 0; i < size; i++) {
-                auto pic = SkPicture::MakeFromStream(stream, &procs, topLevelTFPlayback);
+                auto pic = SkPicture::MakeFromStream(stream, &procs, topLevelTFPlayback, inPlace);
                 if (!pic) {
                     return false;
                 }
@@ -329,13 +408,17 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
             }
         } break;
         case SK_PICT_BUFFER_SIZE_TAG: {
-            SkAutoMalloc storage(size);
-            if (stream->read(storage.get(), size) != size) {
+            sk_sp<SkData> storage = read_data(stream, size, inPlace);
+            if (!storage) {
                 return false;
             }
 
-            SkReadBuffer buffer(storage.get(), size);
+            SkReadBuffer buffer(storage->data(), size);
             buffer.setVersion(fInfo.getVersion());
+            if (inPlace && storage->bytes() >= inPlace->bytes() &&
+                    storage->bytes() < inPlace->bytes() + inPlace->size()) {
+                buffer.setBackingData(inPlace);
+            }
 
             if (!fFactoryPlayback) {
                 return false;
@@ -467,15 +550,20 @@ void SkPictureData::parseBufferTag(SkReadBuffer& buffer, uint32_t tag, uint32_t
 SkPictureData* SkPictureData::CreateFromStream(SkStream* stream,
                                                const SkPictInfo& info,
                                                const SkDeserialProcs& procs,
-                                               SkTypefacePlayback* topLevelTFPlayback) {
+                                               SkTypefacePlayback* topLevelTFPlayback,
+                                               const SkData* inPlace) {
     std::unique_ptr<SkPictureData> data(new SkPictureData(info));
     if (!topLevelTFPlayback) {
         topLevelTFPlayback = &data->fTFPlayback;
     }
 
-    if (!data->parseStream(stream, procs, topLevelTFPlayback)) {
+    if (!data->parseStream(stream, procs, topLevelTFPlayback, inPlace)) {
         return nullptr;
     }
+    if (inPlace) {
+        // This data is played back directly (perhaps on several threads), not recorded again.
+        data->initForPlayback();
+    }
     return data.release();
 }
 
@@ -492,7 +580,8 @@ SkPictureData* SkPictureData::CreateFromBuffer(SkReadBuffer& buffer,
 
 bool SkPictureData::parseStream(SkStream* stream,
                                 const SkDeserialProcs& procs,
-                                SkTypefacePlayback* topLevelTFPlayback) {
+                                SkTypefacePlayback* topLevelTFPlayback,
+                                const SkData* inPlace) {
     for (;;) {
         uint32_t tag;
         if (!stream->readU32(&tag)) { return false; }
@@ -502,10 +591,26 @@ bool SkPictureData::parseStream(SkStream* stream,
 
         uint32_t size;
         if (!stream->readU32(&size)) { return false; }
-        if (!this->parseStreamTag(stream, tag, size, procs, topLevelTFPlayback)) {
+        if (!this->parseStreamTag(stream, tag, size, procs, topLevelTFPlayback, inPlace)) {
             return false; // we're invalid
         }
     }
+
+    // Op groups must split the ops in order.
+    if (fOpGroups) {
+        if (!fOpData) {
+            return false;
+        }
+        const uint32_t* offsets = this->opGroupOffsets();
+        for (int i = 0; i <= fOpGroupCount; ++i) {
+            if (!SkIsAlign4(offsets[i]) || (i > 0 && offsets[i] < offsets[i - 1])) {
+                return false;
+            }
+        }
+        if (offsets[fOpGroupCount] > fOpData->size()) {
+            return false;
+        }
+    }
     return true;
 }
 
@@ -55,6 +55,7 @@ public:
 #define SK_PICT_TYPEFACE_TAG   SkSetFourByteTag('t', 'p', 'f', 'c')
 #define SK_PICT_PICTURE_TAG    SkSetFourByteTag('p', 'c', 't', 'r')
 #define SK_PICT_DRAWABLE_TAG   SkSetFourByteTag('d', 'r', 'a', 'w')
+#define SK_PICT_OP_GROUPS_TAG  SkSetFourByteTag('o', 'p', 'g', 'r')
 
 // This tag specifies the size of the ReadBuffer, needed for the following tags
 #define SK_PICT_BUFFER_SIZE_TAG     SkSetFourByteTag('a', 'r', 'a', 'y')
@@ -77,11 +78,13 @@ T* read_index_base_1_or_null(SkReadBuffer* reader, const SkTArray<sk_sp<T>>& arr
 class SkPictureData {
 public:
     SkPictureData(const SkPictureRecord& record, const SkPictInfo&);
-    // Does not affect ownership of SkStream.
+    // Does not affect ownership of SkStream. If inPlace is not null, it holds the stream's
+    // memory, and aligned chunks (e.g. the ops and encoded images) share it instead of copying.
     static SkPictureData* CreateFromStream(SkStream*,
                                            const SkPictInfo&,
                                            const SkDeserialProcs&,
-                                           SkTypefacePlayback*);
+                                           SkTypefacePlayback*,
+                                           const SkData* inPlace = nullptr);
     static SkPictureData* CreateFromBuffer(SkReadBuffer&, const SkPictInfo&);
 
     void serialize(SkWStream*, const SkSerialProcs&, SkRefCntSet*) const;
@@ -89,11 +92,24 @@ public:
 
     const sk_sp<SkData>& opData() const { return fOpData; }
 
+    // The ops may be split into groups that each draw within known bounds (see
+    // SkPictureRecord::beginOpGroup()). Group i holds the ops from opGroupOffsets()[i] up to
+    // opGroupOffsets()[i + 1], so there are opGroupCount() + 1 offsets.
+    int opGroupCount() const { return fOpGroupCount; }
+    const uint32_t* opGroupOffsets() const {
+        return reinterpret_cast<const uint32_t*>(fOpGroups->bytes());
+    }
+    const SkRect* opGroupBounds() const {
+        return reinterpret_cast<const SkRect*>(fOpGroups->bytes() +
+                                               (fOpGroupCount + 1) * sizeof(uint32_t));
+    }
+
 protected:
     explicit SkPictureData(const SkPictInfo& info);
 
     // Does not affect ownership of SkStream.
-    bool parseStream(SkStream*, const SkDeserialProcs&, SkTypefacePlayback*);
+    bool parseStream(SkStream*, const SkDeserialProcs&, SkTypefacePlayback*,
+                     const SkData* inPlace);
     bool parseBuffer(SkReadBuffer& buffer);
 
 public:
@@ -138,7 +154,7 @@ private:
     // these help us with reading/writing
     // Does not affect ownership of SkStream.
     bool parseStreamTag(SkStream*, uint32_t tag, uint32_t size,
-                        const SkDeserialProcs&, SkTypefacePlayback*);
+                        const SkDeserialProcs&, SkTypefacePlayback*, const SkData* inPlace);
     void parseBufferTag(SkReadBuffer&, uint32_t tag, uint32_t size);
     void flattenToBuffer(SkWriteBuffer&) const;
 
@@ -146,6 +162,8 @@ private:
     SkTArray<SkPath>   fPaths;
 
     sk_sp<SkData>   fOpData;    // opcodes and parameters
+    sk_sp<SkData>   fOpGroups;  // op group offsets, then their bounds
+    int             fOpGroupCount = 0;
 
     const SkPath    fEmptyPath;
     const SkBitmap  fEmptyBitmap;
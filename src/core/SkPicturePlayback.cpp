@@ -82,25 +82,74 @@ void SkPicturePlayback::draw(SkCanvas* canvas,
 
     SkAutoCanvasRestore acr(canvas, false);
 
-    while (!reader.eof()) {
-        if (callback && callback->abort()) {
-            return;
+    if (!this->drawOps(&reader, reader.size(), canvas, callback, initialMatrix)) {
+        return;
+    }
+
+    // need to propagate invalid state to the parent reader
+    if (buffer) {
+        buffer->validate(reader.isValid());
+    }
+}
+
+void SkPicturePlayback::drawGroups(SkCanvas* canvas,
+                                   SkPicture::AbortCallback* callback,
+                                   const SkTDArray<int>& groups) {
+    AutoResetOpID aroi(this);
+    SkASSERT(0 == fCurOffset);
+    SkASSERT(fPictureData->opGroupCount() > 0);
+
+    SkReadBuffer reader(fPictureData->opData()->bytes(),
+                        fPictureData->opData()->size());
+
+    SkMatrix initialMatrix = canvas->getTotalMatrix();
+
+    SkAutoCanvasRestore acr(canvas, false);
+
+    // Skips to offset, unless an op already skipped past it (e.g. a clip that emptied the clip
+    // skips to its restore).
+    auto skipTo = [&reader](size_t offset) {
+        if (reader.offset() < offset) {
+            reader.skip(offset - reader.offset());
         }
+    };
 
-        fCurOffset = reader.offset();
-        uint32_t size;
-        DrawType op = ReadOpAndSize(&reader, &size);
-        if (!reader.validate(op > UNUSED && op <= LAST_DRAWTYPE_ENUM)) {
+    const uint32_t* offsets = fPictureData->opGroupOffsets();
+    const int count = fPictureData->opGroupCount();
+    if (!this->drawOps(&reader, offsets[0], canvas, callback, initialMatrix)) {
+        return;
+    }
+    for (int group : groups) {
+        SkASSERT(group >= 0 && group < count);
+        skipTo(offsets[group]);
+        if (!this->drawOps(&reader, offsets[group + 1], canvas, callback, initialMatrix)) {
             return;
         }
-
-        this->handleOp(&reader, op, size, canvas, initialMatrix);
     }
+    skipTo(offsets[count]);
+    this->drawOps(&reader, reader.size(), canvas, callback, initialMatrix);
+}
 
-    // need to propagate invalid state to the parent reader
-    if (buffer) {
-        buffer->validate(reader.isValid());
+bool SkPicturePlayback::drawOps(SkReadBuffer* reader,
+                                size_t stop,
+                                SkCanvas* canvas,
+                                SkPicture::AbortCallback* callback,
+                                const SkMatrix& initialMatrix) {
+    while (reader->offset() < stop) {
+        if (callback && callback->abort()) {
+            return false;
+        }
+
+        fCurOffset = reader->offset();
+        uint32_t size;
+        DrawType op = ReadOpAndSize(reader, &size);
+        if (!reader->validate(op > UNUSED && op <= LAST_DRAWTYPE_ENUM)) {
+            return false;
+        }
+
+        this->handleOp(reader, op, size, canvas, initialMatrix);
     }
+    return true;
 }
 
 static void validate_offsetToRestore(SkReadBuffer* reader, size_t offsetToRestore) {
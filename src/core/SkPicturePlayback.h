@@ -25,26 +25,37 @@ public:
 
     void draw(SkCanvas* canvas, SkPicture::AbortCallback*, SkReadBuffer* buffer);
 
+    // Draws just the given op groups (in increasing order), and the ops outside any group.
+    void drawGroups(SkCanvas* canvas, SkPicture::AbortCallback*, const SkTDArray<int>& groups);
+
     // TODO: remove the curOp calls after cleaning up GrGatherDevice
     // Return the ID of the operation currently being executed when playing
     // back. 0 indicates no call is active.
     size_t curOpID() const { return fCurOffset; }
     void resetOpID() { fCurOffset = 0; }
 
+    // Reads the next op's header. size includes the header, or is 0 for ops in old SKPs.
+    static DrawType ReadOpAndSize(SkReadBuffer* reader, uint32_t* size);
+
 protected:
     const SkPictureData* fPictureData;
 
     // The offset of the current operation when within the draw method
     size_t fCurOffset;
 
+    // Draws ops until the reader reaches stop. Returns false if playback should stop.
+    bool drawOps(SkReadBuffer* reader,
+                 size_t stop,
+                 SkCanvas* canvas,
+                 SkPicture::AbortCallback*,
+                 const SkMatrix& initialMatrix);
+
     void handleOp(SkReadBuffer* reader,
                   DrawType op,
                   uint32_t size,
                   SkCanvas* canvas,
                   const SkMatrix& initialMatrix);
 
-    static DrawType ReadOpAndSize(SkReadBuffer* reader, uint32_t* size);
-
     class AutoResetOpID {
     public:
         AutoResetOpID(SkPicturePlayback* playback) : fPlayback(playback) { }
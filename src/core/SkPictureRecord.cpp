@@ -31,6 +31,7 @@ static int const kUInt32Size = 4;
 
 SkPictureRecord::SkPictureRecord(const SkISize& dimensions, uint32_t flags)
     : INHERITED(dimensions.width(), dimensions.height())
+    , fOpGroupsEnd(0)
     , fRecordFlags(flags)
     , fInitialSaveCount(kNoInitialSave) {
 }
@@ -297,6 +298,29 @@ void SkPictureRecord::endRecording() {
     this->restoreToCount(fInitialSaveCount);
 }
 
+void SkPictureRecord::beginOpGroup(const SkRect& bounds) {
+    SkASSERT(0 == fOpGroupsEnd);
+    const uint32_t offset = SkToU32(fWriter.bytesWritten());
+    if (!fOpGroupOffsets.isEmpty()) {
+        if (fOpGroupOffsets.top() == offset) {
+            // The last group recorded no ops, so replace it.
+            fOpGroupBounds.top() = bounds;
+            return;
+        }
+        if (fOpGroupBounds.top() == bounds) {
+            return;     // Just extend the last group.
+        }
+    }
+    fOpGroupOffsets.push_back(offset);
+    fOpGroupBounds.push_back(bounds);
+}
+
+void SkPictureRecord::endOpGroups() {
+    if (!fOpGroupOffsets.isEmpty()) {
+        fOpGroupsEnd = SkToU32(fWriter.bytesWritten());
+    }
+}
+
 size_t SkPictureRecord::recordRestoreOffsetPlaceholder(SkClipOp op) {
     if (fRestoreOffsetStack.isEmpty()) {
         return -1;
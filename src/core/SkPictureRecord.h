@@ -73,6 +73,12 @@ public:
     void beginRecording();
     void endRecording();
 
+    // Marks the ops recorded from now until the next call as drawing only within bounds, so that
+    // playback can skip them. Ops recorded before the first call, or after endOpGroups(), always
+    // play back.
+    void beginOpGroup(const SkRect& bounds);
+    void endOpGroups();
+
 protected:
     void addNoOp();
 
@@ -255,6 +261,10 @@ private:
     SkTArray<sk_sp<const SkTextBlob>> fTextBlobs;
     SkTArray<sk_sp<const SkVertices>> fVertices;
 
+    SkTDArray<uint32_t> fOpGroupOffsets;
+    SkTDArray<SkRect>   fOpGroupBounds;
+    uint32_t            fOpGroupsEnd;
+
     uint32_t fRecordFlags;
     int      fInitialSaveCount;
 
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkPlaybackPicture.h"
+
+#include "SkBBHFactory.h"
+#include "SkBBoxHierarchy.h"
+#include "SkCanvas.h"
+#include "SkPictureData.h"
+#include "SkPicturePlayback.h"
+#include "SkReadBuffer.h"
+#include "SkTextBlob.h"
+
+// Walks the op headers, without reading their arguments.
+static int count_ops(const SkData& opData) {
+    SkReadBuffer reader(opData.data(), opData.size());
+    int count = 0;
+    while (!reader.eof() && reader.isValid()) {
+        size_t offset = reader.offset();
+        uint32_t size;
+        SkPicturePlayback::ReadOpAndSize(&reader, &size);
+        count++;
+        if (0 == size || !reader.validate(offset + size >= reader.offset())) {
+            break;  // Old SKPs don't record op sizes, so this is as far as we can count.
+        }
+        reader.skip(offset + size - reader.offset());
+    }
+    return count;
+}
+
+sk_sp<SkPicture> SkPlaybackPicture::Make(const SkRect& cull,
+                                         std::unique_ptr<SkPictureData> data) {
+    if (!data || !data->opData()) {
+        return nullptr;
+    }
+    int opCount = count_ops(*data->opData());
+
+    sk_sp<SkBBoxHierarchy> bbh;
+    if (data->opGroupCount() > 0) {
+        bbh.reset(SkRTreeFactory()(cull));
+        bbh->insert(data->opGroupBounds(), data->opGroupCount());
+    }
+    return sk_sp<SkPicture>(new SkPlaybackPicture(cull, std::move(data), opCount,
+                                                  std::move(bbh)));
+}
+
+SkPlaybackPicture::SkPlaybackPicture(const SkRect& cull, std::unique_ptr<SkPictureData> data,
+                                     int opCount, sk_sp<SkBBoxHierarchy> bbh)
+    : fCullRect(cull)
+    , fData(std::move(data))
+    , fOpCount(opCount)
+    , fBBH(std::move(bbh)) {}
+
+SkPlaybackPicture::~SkPlaybackPicture() {}
+
+void SkPlaybackPicture::playback(SkCanvas* canvas, AbortCallback* callback) const {
+    SkASSERT(canvas);
+    SkPicturePlayback playback(fData.get());
+
+    // If the query contains the whole picture, don't bother with the BBH.
+    const SkRect query = canvas->getLocalClipBounds();
+    if (fBBH && !query.contains(fCullRect)) {
+        if (!SkRect::Intersects(query, fCullRect)) {
+            return;     // Just like the BBH, we assume nothing draws outside the cull.
+        }
+        SkTDArray<int> groups;
+        fBBH->search(query, &groups);
+        playback.drawGroups(canvas, callback, groups);
+        return;
+    }
+    playback.draw(canvas, callback, nullptr);
+}
+
+size_t SkPlaybackPicture::approximateBytesUsed() const {
+    size_t bytes = sizeof(*this) + fData->opData()->size();
+    if (fBBH) { bytes += fBBH->bytesUsed(); }
+    return bytes;
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkPlaybackPicture_DEFINED
+#define SkPlaybackPicture_DEFINED
+
+#include "SkPicture.h"
+#include "SkRect.h"
+
+#include <memory>
+
+class SkBBoxHierarchy;
+class SkPictureData;
+
+// An implementation of SkPicture that plays back the SkPictureData it was deserialized into,
+// rather than recording it into an SkRecord first. See SkPicture::MakeFromSharedData().
+//
+// If the data has op groups, they're indexed by an R-tree, and playing back part of the picture
+// only reads the ops that draw into it.
+class SkPlaybackPicture final : public SkPicture {
+public:
+    // Returns nullptr if data is null or has no ops.
+    static sk_sp<SkPicture> Make(const SkRect& cull, std::unique_ptr<SkPictureData> data);
+
+    ~SkPlaybackPicture() override;
+
+// SkPicture overrides
+    void playback(SkCanvas*, AbortCallback*) const override;
+    SkRect cullRect() const override { return fCullRect; }
+    int approximateOpCount() const override { return fOpCount; }
+    size_t approximateBytesUsed() const override;
+
+private:
+    SkPlaybackPicture(const SkRect& cull, std::unique_ptr<SkPictureData>, int opCount,
+                      sk_sp<SkBBoxHierarchy>);
+
+    const SkRect                         fCullRect;
+    std::unique_ptr<const SkPictureData> fData;
+    const int                            fOpCount;
+    sk_sp<const SkBBoxHierarchy>         fBBH;
+};
+
+#endif//SkPlaybackPicture_DEFINED
@@ -6,9 +6,12 @@
  */
 
 #include "SkRTree.h"
+#include "SkNx.h"
+
+#include <algorithm>
 
 SkRTree::SkRTree(SkScalar aspectRatio)
-    : fCount(0), fAspectRatio(isfinite(aspectRatio) ? aspectRatio : 1) {}
+    : fCount(0), fNextOpIndex(0), fAspectRatio(isfinite(aspectRatio) ? aspectRatio : 1) {}
 
 SkRect SkRTree::getRootBound() const {
     if (fCount) {
@@ -19,10 +22,20 @@ SkRect SkRTree::getRootBound() const {
 }
 
 void SkRTree::insert(const SkRect boundsArray[], int N) {
-    SkASSERT(0 == fCount);
-
     SkTDArray<Branch> branches;
-    branches.setReserve(N);
+    branches.setReserve(fCount + N);
+
+    // Level 0 nodes hold every rect inserted so far, still in insertion order.  We gather them up
+    // and bulk-load them again with the new ones, which keeps search() results in index order.
+    for (const Node& node : fNodes) {
+        if (0 == node.fLevel) {
+            for (int i = 0; i < node.fNumChildren; i++) {
+                branches.push_back(node.child(i));
+            }
+        }
+    }
+    SkASSERT(branches.count() == fCount);
+    fNodes.rewind();
 
     for (int i = 0; i < N; i++) {
         const SkRect& bounds = boundsArray[i];
@@ -32,16 +45,16 @@ void SkRTree::insert(const SkRect boundsArray[], int N) {
 
         Branch* b = branches.push();
         b->fBounds = bounds;
-        b->fOpIndex = i;
+        b->fOpIndex = fNextOpIndex + i;
     }
+    fNextOpIndex += N;
 
     fCount = branches.count();
     if (fCount) {
         if (1 == fCount) {
             fNodes.setReserve(1);
             Node* n = this->allocateNodeAtLevel(0);
-            n->fNumChildren = 1;
-            n->fChildren[0] = branches[0];
+            n->append(branches[0]);
             fRoot.fSubtree = n;
             fRoot.fBounds  = branches[0].fBounds;
         } else {
@@ -57,9 +70,39 @@ SkRTree::Node* SkRTree::allocateNodeAtLevel(uint16_t level) {
     SkASSERT(fNodes.begin() == p);  // If this fails, we didn't setReserve() enough.
     out->fNumChildren = 0;
     out->fLevel = level;
+    for (int i = 0; i < kPaddedChildren; i++) {
+        out->fLefts[i]   = out->fTops[i]    =  SK_ScalarInfinity;
+        out->fRights[i]  = out->fBottoms[i] = -SK_ScalarInfinity;
+    }
     return out;
 }
 
+void SkRTree::Node::append(const Branch& branch) {
+    SkASSERT(fNumChildren < kMaxChildren);
+    int i = fNumChildren++;
+    fLefts  [i] = branch.fBounds.fLeft;
+    fTops   [i] = branch.fBounds.fTop;
+    fRights [i] = branch.fBounds.fRight;
+    fBottoms[i] = branch.fBounds.fBottom;
+    if (0 == fLevel) {
+        fChildren[i].fOpIndex = branch.fOpIndex;
+    } else {
+        fChildren[i].fSubtree = branch.fSubtree;
+    }
+}
+
+SkRTree::Branch SkRTree::Node::child(int i) const {
+    SkASSERT(i < fNumChildren);
+    Branch branch;
+    if (0 == fLevel) {
+        branch.fOpIndex = fChildren[i].fOpIndex;
+    } else {
+        branch.fSubtree = fChildren[i].fSubtree;
+    }
+    branch.fBounds = { fLefts[i], fTops[i], fRights[i], fBottoms[i] };
+    return branch;
+}
+
 // This function parallels bulkLoad, but just counts how many nodes bulkLoad would allocate.
 int SkRTree::CountNodes(int branches, SkScalar aspectRatio) {
     if (branches == 1) {
@@ -142,16 +185,14 @@ SkRTree::Branch SkRTree::bulkLoad(SkTDArray<Branch>* branches, int level) {
                 }
             }
             Node* n = allocateNodeAtLevel(level);
-            n->fNumChildren = 1;
-            n->fChildren[0] = (*branches)[currentBranch];
+            n->append((*branches)[currentBranch]);
             Branch b;
             b.fBounds = (*branches)[currentBranch].fBounds;
             b.fSubtree = n;
             ++currentBranch;
             for (int k = 1; k < incrementBy && currentBranch < branches->count(); ++k) {
                 b.fBounds.join((*branches)[currentBranch].fBounds);
-                n->fChildren[k] = (*branches)[currentBranch];
-                ++n->fNumChildren;
+                n->append((*branches)[currentBranch]);
                 ++currentBranch;
             }
             (*branches)[newBranches] = b;
@@ -169,12 +210,32 @@ void SkRTree::search(const SkRect& query, SkTDArray<int>* results) const {
 }
 
 void SkRTree::search(Node* node, const SkRect& query, SkTDArray<int>* results) const {
-    for (int i = 0; i < node->fNumChildren; ++i) {
-        if (SkRect::Intersects(node->fChildren[i].fBounds, query)) {
+    const Sk4f queryL(query.fLeft),
+               queryT(query.fTop),
+               queryR(query.fRight),
+               queryB(query.fBottom);
+
+    for (int i = 0; i < node->fNumChildren; i += 4) {
+        // The same test as SkRect::Intersects(), for four children at once.
+        Sk4f hitX = Sk4f::Max(Sk4f::Load(node->fLefts + i), queryL) <
+                    Sk4f::Min(Sk4f::Load(node->fRights + i), queryR),
+             hitY = Sk4f::Max(Sk4f::Load(node->fTops + i), queryT) <
+                    Sk4f::Min(Sk4f::Load(node->fBottoms + i), queryB);
+        Sk4f hit = hitX.thenElse(hitY, hitX);
+        if (!hit.anyTrue()) {
+            continue;
+        }
+
+        const Sk4f ones = hit.thenElse(1.0f, 0.0f);
+        const int end = std::min(i + 4, (int)node->fNumChildren);
+        for (int j = i; j < end; ++j) {
+            if (ones[j - i] == 0) {
+                continue;
+            }
             if (0 == node->fLevel) {
-                results->push_back(node->fChildren[i].fOpIndex);
+                results->push_back(node->fChildren[j].fOpIndex);
             } else {
-                this->search(node->fChildren[i].fSubtree, query, results);
+                this->search(node->fChildren[j].fSubtree, query, results);
             }
         }
     }
@@ -16,8 +16,9 @@
  * An R-Tree implementation. In short, it is a balanced n-ary tree containing a hierarchy of
  * bounding rectangles.
  *
- * It only supports bulk-loading, i.e. creation from a batch of bounding rectangles.
+ * It is built by bulk-loading, i.e. creation from a batch of bounding rectangles.
  * This performs a bottom-up bulk load using the STR (sort-tile-recursive) algorithm.
+ * Inserting more rectangles later bulk-loads them again along with everything already inserted.
  *
  * TODO: Experiment with other bulk-load algorithms (in particular the Hilbert pack variant,
  * which groups rects by position on the Hilbert curve, is probably worth a look). There also
@@ -59,6 +60,9 @@ public:
                      kMaxChildren = 11;
 
 private:
+    // search() tests children four at a time, so each node's bounds are padded to a multiple of 4.
+    static const int kPaddedChildren = (kMaxChildren + 3) & ~3;
+
     struct Node;
 
     struct Branch {
@@ -72,7 +76,19 @@ private:
     struct Node {
         uint16_t fNumChildren;
         uint16_t fLevel;
-        Branch fChildren[kMaxChildren];
+        // The children's bounds, stored edge by edge.  Unused slots hold empty bounds, which
+        // never intersect a query.
+        SkScalar fLefts  [kPaddedChildren],
+                 fTops   [kPaddedChildren],
+                 fRights [kPaddedChildren],
+                 fBottoms[kPaddedChildren];
+        union {
+            Node* fSubtree;
+            int fOpIndex;
+        } fChildren[kMaxChildren];
+
+        void append(const Branch&);
+        Branch child(int i) const;
     };
 
     void search(Node* root, const SkRect& query, SkTDArray<int>* results) const;
@@ -87,6 +103,8 @@ private:
 
     // This is the count of data elements (rather than total nodes in the tree)
     int fCount;
+    // The op index the next insert() numbers its first rect with.
+    int fNextOpIndex;
     SkScalar fAspectRatio;
     Branch fRoot;
     SkTDArray<Node> fNodes;
@@ -8,7 +8,9 @@
 #include "SkRWBuffer.h"
 
 #include "SkMakeUnique.h"
+#include "SkData.h"
 #include "SkMalloc.h"
+#include "SkMutex.h"
 #include "SkStream.h"
 #include "SkTo.h"
 
@@ -66,7 +68,15 @@ private:
 
 struct SkBufferHead {
     mutable std::atomic<int32_t> fRefCnt;
-    SkBufferBlock   fBlock;
+
+    // The blocks' bytes, copied into contiguous memory on demand by SkROBuffer::asData().
+    // Snapshots only ever grow, so the bytes copied for one are reused by every later one.
+    mutable SkMutex         fFlatMutex;
+    mutable sk_sp<SkData>   fFlat;          // Shared with the SkData returned by asData().
+    mutable char*           fFlatBase = nullptr;
+    mutable size_t          fFlatUsed = 0;
+
+    SkBufferBlock   fBlock;                 // Must be last, as its data follows it.
 
     SkBufferHead(size_t capacity) : fRefCnt(1), fBlock(capacity) {}
 
@@ -93,6 +103,7 @@ struct SkBufferHead {
         if (1 == oldRefCnt) {
             // Like unique(), the acquire is only needed on success.
             SkBufferBlock* block = fBlock.fNext;
+            this->~SkBufferHead();
             sk_free((void*)this);
             while (block) {
                 SkBufferBlock* next = block->fNext;
@@ -102,6 +113,44 @@ struct SkBufferHead {
         }
     }
 
+    // Returns the first size bytes, which a snapshot has made safe to read, as one SkData.
+    sk_sp<SkData> coalesce(size_t size) const {
+        SkAutoMutexAcquire lock(fFlatMutex);
+        if (!fFlat || fFlat->size() < size) {
+            // Grow geometrically, so each byte is copied a constant number of times however many
+            // successively larger snapshots are coalesced.
+            sk_sp<SkData> flat =
+                    SkData::MakeUninitialized(SkTMax(size, fFlat ? 2 * fFlat->size() : 0));
+            char* base = static_cast<char*>(flat->writable_data());
+            if (fFlatUsed) {
+                memcpy(base, fFlatBase, fFlatUsed);
+            }
+            fFlat = std::move(flat);
+            fFlatBase = base;
+        }
+
+        // Copy what the flat copy is missing from the blocks.  Bytes before fFlatUsed may
+        // already be shared with other readers, but we only write after them.
+        // Like SkROBuffer::Iter, never look at fNext of the snapshot's last block, which the
+        // writer may be setting.
+        const SkBufferBlock* block = &fBlock;
+        size_t blockStart = 0;
+        while (fFlatUsed < size) {
+            const size_t blockEnd = blockStart + block->fCapacity;
+            if (fFlatUsed < blockEnd) {
+                const size_t n = SkTMin(size, blockEnd) - fFlatUsed;
+                memcpy(fFlatBase + fFlatUsed,
+                       (const char*)block->startData() + (fFlatUsed - blockStart), n);
+                fFlatUsed += n;
+            }
+            if (fFlatUsed < size) {
+                block = block->fNext;
+                blockStart = blockEnd;
+            }
+        }
+        return SkData::MakeSubset(fFlat.get(), 0, size);
+    }
+
     void validate(size_t minUsed, const SkBufferBlock* tail = nullptr) const {
 #ifdef SK_DEBUG
         SkASSERT(fRefCnt.load(std::memory_order_relaxed) > 0);
@@ -145,6 +194,23 @@ SkROBuffer::~SkROBuffer() {
     }
 }
 
+sk_sp<SkData> SkROBuffer::asData() const {
+    if (!fHead) {
+        return SkData::MakeEmpty();
+    }
+    const SkBufferBlock* first = &fHead->fBlock;
+    if (fAvailable <= first->fCapacity) {
+        // Share the first block, which holds everything.
+        fHead->ref();
+        return SkData::MakeWithProc(first->startData(), fAvailable,
+                                    [](const void*, void* head) {
+                                        static_cast<const SkBufferHead*>(head)->unref();
+                                    },
+                                    const_cast<SkBufferHead*>(fHead));
+    }
+    return fHead->coalesce(fAvailable);
+}
+
 SkROBuffer::Iter::Iter(const SkROBuffer* buffer) {
     this->reset(buffer);
 }
@@ -322,6 +388,13 @@ public:
         return fGlobalOffset;
     }
 
+    const void* getMemoryBase() override {
+        if (!fData) {
+            fData = fBuffer->asData();
+        }
+        return fData->data();
+    }
+
     bool seek(size_t position) override {
         AUTO_VALIDATE
         if (position < fGlobalOffset) {
@@ -354,6 +427,7 @@ private:
     }
 
     sk_sp<SkROBuffer> fBuffer;
+    sk_sp<SkData>     fData;        // From getMemoryBase(), if it has been called.
     SkROBuffer::Iter  fIter;
     size_t            fLocalOffset;
     size_t            fGlobalOffset;
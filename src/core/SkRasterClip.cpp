@@ -188,6 +188,22 @@ const SkIRect& SkRasterClip::getBounds() const {
     return fIsBW ? fBW.getBounds() : fAA.getBounds();
 }
 
+bool SkRasterClip::setClip(const SkRasterClip& src) {
+    AUTO_RASTERCLIP_VALIDATE(*this);
+
+    fIsBW = src.fIsBW;
+    if (fIsBW) {
+        fBW = src.fBW;
+        fAA.setEmpty();
+    } else {
+        fAA = src.fAA;
+        fBW.setEmpty();
+    }
+    fIsEmpty = src.isEmpty();
+    fIsRect = src.isRect();
+    return !fIsEmpty;
+}
+
 bool SkRasterClip::setEmpty() {
     AUTO_RASTERCLIP_VALIDATE(*this);
 
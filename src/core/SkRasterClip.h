@@ -91,6 +91,8 @@ public:
 
     bool setEmpty();
     bool setRect(const SkIRect&);
+    // Copies src's clip, but keeps our own device clip restriction.
+    bool setClip(const SkRasterClip& src);
 
     bool op(const SkIRect&, SkRegion::Op);
     bool op(const SkRegion&, SkRegion::Op);
@@ -0,0 +1,181 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkRasterClipCache.h"
+
+#include "SkMatrix.h"
+#include "SkPath.h"
+#include "SkPathPriv.h"
+#include "SkRRect.h"
+
+#include <atomic>
+#include <string.h>
+
+#define CHECK_LOCAL(localCache, localName, globalName, ...) \
+    ((localCache) ? localCache->localName(__VA_ARGS__) : SkResourceCache::globalName(__VA_ARGS__))
+
+SkRasterClipCache::Desc::Desc(const SkRasterClip& parent, uint32_t parentID,
+                              const SkMatrix& matrix, const SkIRect& devBounds, SkClipOp op,
+                              bool doAA)
+        : fPath(nullptr) {
+    memset(&fData, 0, sizeof(fData));
+    // Expanding ops also depend on the device's clip restriction, so they aren't cached.
+    fValid = (SkClipOp::kIntersect == op || SkClipOp::kDifference == op) &&
+             !parent.isEmpty() && (parentID || parent.isRect());
+
+    const SkIRect& parentBounds = parent.getBounds();
+    fData.fParentID = parentID;
+    fData.fParentBounds[0] = parentBounds.fLeft;
+    fData.fParentBounds[1] = parentBounds.fTop;
+    fData.fParentBounds[2] = parentBounds.fRight;
+    fData.fParentBounds[3] = parentBounds.fBottom;
+    fData.fDevBounds[0] = devBounds.fLeft;
+    fData.fDevBounds[1] = devBounds.fTop;
+    fData.fDevBounds[2] = devBounds.fRight;
+    fData.fDevBounds[3] = devBounds.fBottom;
+    fData.fFlags = ((uint32_t)op << 8) | ((uint32_t)doAA << 16);
+    matrix.get9(fData.fMatrix);
+}
+
+void SkRasterClipCache::Desc::setType(Type type, uint32_t extraFlags) {
+    SkASSERT(0 == (fData.fFlags & 0xFF));
+    fData.fFlags |= type | (extraFlags << 24);
+}
+
+void SkRasterClipCache::Desc::setRect(const SkRect& rect) {
+    this->setType(kRect_Type);
+    memcpy(fData.fGeometry, &rect, sizeof(SkRect));
+}
+
+void SkRasterClipCache::Desc::setRRect(const SkRRect& rrect) {
+    this->setType(kRRect_Type);
+    memcpy(fData.fGeometry, &rrect.rect(), sizeof(SkRect));
+    for (int i = 0; i < 4; ++i) {
+        SkVector radii = rrect.radii((SkRRect::Corner)i);
+        fData.fGeometry[4 + 2 * i] = radii.fX;
+        fData.fGeometry[5 + 2 * i] = radii.fY;
+    }
+}
+
+void SkRasterClipCache::Desc::setPath(const SkPath& path) {
+    this->setType(kPath_Type, path.getFillType());
+    fData.fPathGenID = path.getGenerationID();
+    fPath = &path;
+    if (path.isVolatile()) {
+        fValid = false;
+    }
+}
+
+namespace {
+static unsigned gRasterClipKeyNamespaceLabel;
+
+static uint64_t make_shared_id(uint32_t pathGenID) {
+    uint64_t sharedID = SkSetFourByteTag('r', 'c', 'l', 'p');
+    return (sharedID << 32) | pathGenID;
+}
+
+// IDs identify cached results as the parents of later ops, so they must never repeat (or be 0).
+static uint32_t next_result_id() {
+    static std::atomic<uint32_t> gNextID{1};
+    uint32_t id;
+    do {
+        id = gNextID.fetch_add(1, std::memory_order_relaxed);
+    } while (0 == id);
+    return id;
+}
+
+struct RasterClipKey : public SkResourceCache::Key {
+public:
+    RasterClipKey(const void* data, size_t size, uint32_t pathGenID) {
+        SkASSERT(size <= sizeof(fData));
+        memcpy(fData, data, size);
+        this->init(&gRasterClipKeyNamespaceLabel, pathGenID ? make_shared_id(pathGenID) : 0,
+                   size);
+    }
+
+    uint32_t fData[32];
+};
+
+// Purges the source path's entries once it changes.
+class PathListener : public SkPathRef::GenIDChangeListener {
+public:
+    explicit PathListener(uint32_t genID) : fGenID(genID) {}
+
+    void onChange() override {
+        SkResourceCache::PostPurgeSharedID(make_shared_id(fGenID));
+    }
+
+private:
+    const uint32_t fGenID;
+};
+
+struct RasterClipRec : public SkResourceCache::Rec {
+    RasterClipRec(const RasterClipKey& key, const SkRasterClip& clip, uint32_t id,
+                  sk_sp<PathListener> listener)
+        : fKey(key)
+        , fClip(clip)
+        , fID(id)
+        , fListener(std::move(listener)) {
+        // The restriction points into the device that made this clip, which may go away.
+        fClip.setDeviceClipRestriction(nullptr);
+    }
+
+    ~RasterClipRec() override {
+        if (fListener) {
+            fListener->markShouldUnregisterFromPath();
+        }
+    }
+
+    RasterClipKey       fKey;
+    SkRasterClip        fClip;
+    uint32_t            fID;
+    sk_sp<PathListener> fListener;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override {
+        return sizeof(*this) + (fClip.isBW() ? fClip.bwRgn().writeToMemory(nullptr)
+                                             : fClip.aaRgn().bytesUsed());
+    }
+    const char* getCategory() const override { return "raster-clip"; }
+    SkDiscardableMemory* diagnostic_only_getDiscardable() const override { return nullptr; }
+
+    struct Result {
+        SkRasterClip* fClip;
+        uint32_t*     fID;
+    };
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const RasterClipRec& rec = static_cast<const RasterClipRec&>(baseRec);
+        Result* result = static_cast<Result*>(contextData);
+        result->fClip->setClip(rec.fClip);
+        *result->fID = rec.fID;
+        return true;
+    }
+};
+} // namespace
+
+bool SkRasterClipCache::Find(const Desc& desc, SkRasterClip* dst, uint32_t* id,
+                             SkResourceCache* localCache) {
+    SkASSERT(desc.isValid());
+    RasterClipKey key(&desc.fData, sizeof(desc.fData), desc.fData.fPathGenID);
+    RasterClipRec::Result result = { dst, id };
+    return CHECK_LOCAL(localCache, find, Find, key, RasterClipRec::Visitor, &result);
+}
+
+uint32_t SkRasterClipCache::Add(const Desc& desc, const SkRasterClip& result,
+                                SkResourceCache* localCache) {
+    SkASSERT(desc.isValid());
+    RasterClipKey key(&desc.fData, sizeof(desc.fData), desc.fData.fPathGenID);
+    uint32_t id = next_result_id();
+    sk_sp<PathListener> listener;
+    if (desc.fData.fPathGenID) {
+        listener = sk_make_sp<PathListener>(desc.fData.fPathGenID);
+        SkPathPriv::AddGenIDChangeListener(*desc.fPath, listener);
+    }
+    CHECK_LOCAL(localCache, add, Add, new RasterClipRec(key, result, id, std::move(listener)));
+    return id;
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkRasterClipCache_DEFINED
+#define SkRasterClipCache_DEFINED
+
+#include "SkClipOp.h"
+#include "SkRasterClip.h"
+#include "SkResourceCache.h"
+
+class SkMatrix;
+class SkPath;
+class SkRRect;
+
+/**
+ * Caches the complex clips SkRasterClipStack computes, so repeating a sequence of clips (e.g. on
+ * every frame) looks up each result instead of rasterizing it again.
+ *
+ * A result is keyed by the clip element (a path's generation ID, or the rect or rrect itself), the
+ * matrix, the op, the device bounds and the clip state it was applied to. A state is identified by
+ * its bounds when it's a rect, and otherwise by the ID Add() assigned it when it was cached.
+ */
+class SkRasterClipCache {
+public:
+    /**
+     * Describes clipping parent, whose ID is parentID (or 0), by an element. isValid() is false
+     * for ops that can't be keyed: unidentified parents, volatile paths and expanding ops.
+     */
+    class Desc {
+    public:
+        Desc(const SkRasterClip& parent, uint32_t parentID, const SkMatrix&,
+             const SkIRect& devBounds, SkClipOp, bool doAA);
+
+        void setRect(const SkRect&);
+        void setRRect(const SkRRect&);
+        void setPath(const SkPath&);
+
+        bool isValid() const { return fValid; }
+
+    private:
+        enum Type : uint32_t {
+            kRect_Type,
+            kRRect_Type,
+            kPath_Type,
+        };
+
+        // Flattened into the cache key, so unused fields stay zero.
+        struct Data {
+            uint32_t fParentID;
+            int32_t  fParentBounds[4];
+            int32_t  fDevBounds[4];
+            uint32_t fPathGenID;
+            uint32_t fFlags;            // Type, op, AA and path fill type
+            SkScalar fGeometry[12];     // rect, or rrect rect and radii
+            SkScalar fMatrix[9];
+        };
+        static_assert(sizeof(Data) == 128, "packed so the key has no padding");
+
+        void setType(Type, uint32_t extraFlags = 0);
+
+        Data          fData;
+        const SkPath* fPath;
+        bool          fValid;
+
+        friend class SkRasterClipCache;
+    };
+
+    /**
+     * On success, sets dst's clip to the cached result of desc, id to its ID, and returns true.
+     */
+    static bool Find(const Desc& desc, SkRasterClip* dst, uint32_t* id,
+                     SkResourceCache* localCache = nullptr);
+
+    /**
+     * Records that result is the clip desc produces, and returns the ID that identifies result as
+     * a parent in later descriptions.
+     */
+    static uint32_t Add(const Desc& desc, const SkRasterClip& result,
+                        SkResourceCache* localCache = nullptr);
+};
+
+#endif
@@ -11,6 +11,7 @@
 #include "SkClipOp.h"
 #include "SkDeque.h"
 #include "SkRasterClip.h"
+#include "SkRasterClipCache.h"
 #include <new>
 
 template <typename T> class SkTStack {
@@ -70,6 +71,7 @@ public:
         Rec& rec = fStack.push();
         rec.fRC.setRect(fRootBounds);
         rec.fDeferredCount = 0;
+        rec.fCacheID = 0;
         SkASSERT(fStack.count() == 1);
     }
 
@@ -80,6 +82,7 @@ public:
         Rec& rec = fStack.top();
         SkASSERT(rec.fDeferredCount == 0);
         rec.fRC.setRect(fRootBounds);
+        rec.fCacheID = 0;
     }
 
     const SkRasterClip& rc() const { return fStack.top().fRC; }
@@ -100,25 +103,50 @@ public:
     }
 
     void clipRect(const SkMatrix& ctm, const SkRect& rect, SkClipOp op, bool aa) {
-        this->writable_rc().op(rect, ctm, fRootBounds, (SkRegion::Op)op, aa);
+        SkRasterClip& rc = this->writable_rc();
+        if (rc.isRect() && ctm.rectStaysRect() && (!aa || is_integral(ctm.mapRect(rect)))) {
+            // Clipping a rect to a hard-edged rect is cheaper than looking the result up.
+            rc.op(rect, ctm, fRootBounds, (SkRegion::Op)op, aa);
+            fStack.top().fCacheID = 0;
+        } else {
+            SkRasterClipCache::Desc desc(rc, fStack.top().fCacheID, ctm, fRootBounds, op, aa);
+            desc.setRect(rect);
+            if (!this->findCachedClip(desc)) {
+                rc.op(rect, ctm, fRootBounds, (SkRegion::Op)op, aa);
+                this->addCachedClip(desc);
+            }
+        }
         this->trimIfExpanding(op);
         this->validate();
     }
 
     void clipRRect(const SkMatrix& ctm, const SkRRect& rrect, SkClipOp op, bool aa) {
-        this->writable_rc().op(rrect, ctm, fRootBounds, (SkRegion::Op)op, aa);
+        SkRasterClip& rc = this->writable_rc();
+        SkRasterClipCache::Desc desc(rc, fStack.top().fCacheID, ctm, fRootBounds, op, aa);
+        desc.setRRect(rrect);
+        if (!this->findCachedClip(desc)) {
+            rc.op(rrect, ctm, fRootBounds, (SkRegion::Op)op, aa);
+            this->addCachedClip(desc);
+        }
         this->trimIfExpanding(op);
         this->validate();
     }
 
     void clipPath(const SkMatrix& ctm, const SkPath& path, SkClipOp op, bool aa) {
-        this->writable_rc().op(path, ctm, fRootBounds, (SkRegion::Op)op, aa);
+        SkRasterClip& rc = this->writable_rc();
+        SkRasterClipCache::Desc desc(rc, fStack.top().fCacheID, ctm, fRootBounds, op, aa);
+        desc.setPath(path);
+        if (!this->findCachedClip(desc)) {
+            rc.op(path, ctm, fRootBounds, (SkRegion::Op)op, aa);
+            this->addCachedClip(desc);
+        }
         this->trimIfExpanding(op);
         this->validate();
     }
 
     void clipRegion(const SkRegion& rgn, SkClipOp op) {
         this->writable_rc().op(rgn, (SkRegion::Op)op);
+        fStack.top().fCacheID = 0;
         this->trimIfExpanding(op);
         this->validate();
     }
@@ -142,6 +170,7 @@ private:
     struct Rec {
         SkRasterClip    fRC;
         int             fDeferredCount; // 0 for a "normal" entry
+        uint32_t        fCacheID;       // identifies a complex fRC to SkRasterClipCache, or 0
     };
 
     enum {
@@ -162,6 +191,24 @@ private:
         return fStack.top().fRC;
     }
 
+    static bool is_integral(const SkRect& r) {
+        return SkRect::Make(r.round()) == r;
+    }
+
+    bool findCachedClip(const SkRasterClipCache::Desc& desc) {
+        Rec& rec = fStack.top();
+        return desc.isValid() && SkRasterClipCache::Find(desc, &rec.fRC, &rec.fCacheID);
+    }
+
+    // Caches the complex clips that desc produced. Rects are identified by their bounds instead.
+    void addCachedClip(const SkRasterClipCache::Desc& desc) {
+        Rec& rec = fStack.top();
+        rec.fCacheID = 0;
+        if (desc.isValid() && !rec.fRC.isEmpty() && !rec.fRC.isRect()) {
+            rec.fCacheID = SkRasterClipCache::Add(desc, rec.fRC);
+        }
+    }
+
     void trimIfExpanding(SkClipOp op) {
         if ((int)op > (int)SkClipOp::kIntersect) {
             Rec& rec = fStack.top();
@@ -6,8 +6,13 @@
  */
 
 #include "SkRasterPipeline.h"
+#include "SkMetrics.h"
 #include "SkOpts.h"
+#include "SkTraceEvent.h"
 #include <algorithm>
+#include <atomic>
+#include <new>
+#include <type_traits>
 
 SkRasterPipeline::SkRasterPipeline(SkArenaAlloc* alloc) : fAlloc(alloc) {
     this->reset();
@@ -259,7 +264,43 @@ void SkRasterPipeline::append_gamut_clamp_if_normalized(const SkImageInfo& dstIn
     }
 }
 
+static const char* const kHighpFallbackNames[] = {
+#define M(st) "SkRasterPipeline highp fallback: " #st,
+    SK_RASTER_PIPELINE_STAGES(M)
+#undef M
+};
+
+static std::atomic<int> gHighpFallbacks[SK_ARRAY_COUNT(kHighpFallbackNames)];
+
+int SkRasterPipeline::HighpFallbackCount(StockStage stage) {
+    return gHighpFallbacks[stage].load(std::memory_order_relaxed);
+}
+
 SkRasterPipeline::StartPipelineFn SkRasterPipeline::build_pipeline(void** ip) const {
+#if SK_METRICS_ENABLED
+    // The stage mix: how often each stock stage is built into a pipeline.
+    static SkMetrics::Counter* stageCounts = [] {
+        static const char* const kNames[] = {
+        #define M(st) "raster_pipeline.stage." #st,
+            SK_RASTER_PIPELINE_STAGES(M)
+        #undef M
+        };
+        using Storage = std::aligned_storage<sizeof(SkMetrics::Counter),
+                                             alignof(SkMetrics::Counter)>::type;
+        static Storage storage[SK_ARRAY_COUNT(kNames)];
+        auto counts = reinterpret_cast<SkMetrics::Counter*>(storage);
+        for (size_t i = 0; i < SK_ARRAY_COUNT(kNames); i++) {
+            new (&counts[i]) SkMetrics::Counter(kNames[i]);
+        }
+        return counts;
+    }();
+    for (const StageList* st = fStages; st; st = st->prev) {
+        if (!st->rawFunction) {
+            stageCounts[st->stage].add(1);
+        }
+    }
+#endif
+
     // We'll try to build a lowp pipeline, but if that fails fallback to a highp float pipeline.
     void** reset_point = ip;
 
@@ -277,9 +318,20 @@ SkRasterPipeline::StartPipelineFn SkRasterPipeline::build_pipeline(void** ip) co
             break;
         }
     }
+    SK_METRIC_HISTOGRAM("raster_pipeline.stages", fNumStages);
     if (ip != reset_point) {
+        SK_METRIC_COUNT("raster_pipeline.lowp", 1);
         return SkOpts::start_pipeline_lowp;
     }
+    SK_METRIC_COUNT("raster_pipeline.highp", 1);
+
+    // Count the stages without lowp implementations that kept us from running in lowp.
+    for (const StageList* st = fStages; st; st = st->prev) {
+        if (!st->rawFunction && !SkOpts::stages_lowp[st->stage]) {
+            int count = gHighpFallbacks[st->stage].fetch_add(1, std::memory_order_relaxed) + 1;
+            TRACE_COUNTER1("skia", kHighpFallbackNames[st->stage], count);
+        }
+    }
 
     *--ip = (void*)SkOpts::just_return_highp;
     for (const StageList* st = fStages; st; st = st->prev) {
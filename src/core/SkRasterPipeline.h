@@ -65,7 +65,7 @@
     M(matrix_translate) M(matrix_scale_translate)                  \
     M(matrix_2x3) M(matrix_3x3) M(matrix_3x4) M(matrix_4x5) M(matrix_4x3) \
     M(matrix_perspective)                                          \
-    M(parametric) M(gamma)                                         \
+    M(parametric) M(gamma) M(tf_table)                             \
     M(mirror_x)   M(repeat_x)                                      \
     M(mirror_y)   M(repeat_y)                                      \
     M(decal_x)    M(decal_y)   M(decal_x_and_y)                    \
@@ -78,7 +78,9 @@
     M(clamp_x_1) M(mirror_x_1) M(repeat_x_1)                       \
     M(evenly_spaced_gradient)                                      \
     M(gradient)                                                    \
+    M(gradient_lut)                                                \
     M(evenly_spaced_2_stop_gradient)                               \
+    M(linear_2_stop_gradient)                                      \
     M(xy_to_unit_angle)                                            \
     M(xy_to_radius)                                                \
     M(xy_to_2pt_conical_strip)                                     \
@@ -150,12 +152,27 @@ struct SkRasterPipeline_GradientCtx {
     bool interpolatedInPremul;
 };
 
+// A gradient's colors sampled at size evenly spaced t in [0,1], as size+1 RGBA quads; the last
+// quad repeats the one before it so lerping never reads past the end.
+struct SkRasterPipeline_GradientLUTCtx {
+    const float* rgba;
+    int          size;
+    bool         interpolatedInPremul;
+};
+
 struct SkRasterPipeline_EvenlySpaced2StopGradientCtx {
     float f[4];
     float b[4];
     bool interpolatedInPremul;
 };
 
+// seed_shader, an affine matrix, clamp_x_1 and evenly_spaced_2_stop_gradient in one stage.
+struct SkRasterPipeline_Linear2StopGradientCtx {
+    // t = x*tx + y*ty + t0, i.e. the first row of the matrix.
+    float tx, ty, t0;
+    SkRasterPipeline_EvenlySpaced2StopGradientCtx stops;
+};
+
 struct SkRasterPipeline_2PtConicalCtx {
     uint32_t fMask[SkRasterPipeline_kMaxStride];
     float    fP0,
@@ -172,6 +189,13 @@ struct SkRasterPipeline_EmbossCtx {
                                add;
 };
 
+// A transfer function sampled at (i/(size-1))^2, i.e. evenly in sqrt(x), for x in [0,1].
+// table holds size+1 entries; the last repeats table[size-1] so lerping never reads past the end.
+struct SkRasterPipeline_TFTableCtx {
+    const float* table;
+    int          size;
+};
+
 
 
 class SkRasterPipeline {
@@ -208,6 +232,10 @@ public:
 
     void dump() const;
 
+    // How many times a pipeline had to run in highp because stage has no lowp implementation.
+    // These counts are also traced as "SkRasterPipeline highp fallback: <stage>" counters.
+    static int HighpFallbackCount(StockStage stage);
+
     // Appends a stage for the specified matrix.
     // Tries to optimize the stage by analyzing the type of matrix.
     void append_matrix(SkArenaAlloc*, const SkMatrix&);
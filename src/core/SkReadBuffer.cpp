@@ -319,10 +319,20 @@ sk_sp<SkImage> SkReadBuffer::readImage() {
         return nullptr;
     }
 
-    sk_sp<SkData> data = SkData::MakeUninitialized(size);
-    if (!this->readPad32(data->writable_data(), size)) {
-        this->validate(false);
-        return nullptr;
+    sk_sp<SkData> data;
+    if (fBackingData) {
+        // Share the encoded bytes rather than copying them; they're only decoded on demand.
+        const uint8_t* bytes = static_cast<const uint8_t*>(this->skip(size));
+        if (!bytes) {
+            return nullptr;
+        }
+        data = SkData::MakeSubset(fBackingData, bytes - fBackingData->bytes(), size);
+    } else {
+        data = SkData::MakeUninitialized(size);
+        if (!this->readPad32(data->writable_data(), size)) {
+            this->validate(false);
+            return nullptr;
+        }
     }
     if (this->isVersionLT(kDontNegateImageSize_Version)) {
         (void)this->read32();   // originX
@@ -47,6 +47,7 @@ public:
         kSaveBehind_Version                = 66,
         kSerializeFonts_Version            = 67,
         kPaintDoesntSerializeFonts_Version = 68,
+        kAlignedPictureData_Version        = 69,
     };
 
     /**
@@ -168,6 +169,12 @@ public:
     void setDeserialProcs(const SkDeserialProcs& procs);
     const SkDeserialProcs& getDeserialProcs() const { return fProcs; }
 
+    /**
+     *  Call this when the buffer's memory lies within data, which outlives the buffer, so that
+     *  encoded images can share those bytes instead of copying them.
+     */
+    void setBackingData(const SkData* data) { fBackingData = data; }
+
     /**
      *  If isValid is false, sets the buffer to be "invalid". Returns true if the buffer
      *  is still valid.
@@ -227,6 +234,8 @@ private:
 
     SkDeserialProcs fProcs;
 
+    const SkData* fBackingData = nullptr;
+
     static bool IsPtrAlign4(const void* ptr) {
         return SkIsAlign4((uintptr_t)ptr);
     }
@@ -255,6 +264,7 @@ public:
         kSaveBehind_Version                = 66,
         kSerializeFonts_Version            = 67,
         kPaintDoesntSerializeFonts_Version = 68,
+        kAlignedPictureData_Version        = 69,
     };
 
     bool isVersionLT(Version) const { return false; }
@@ -339,6 +349,7 @@ public:
     void setTypefaceArray(sk_sp<SkTypeface>[], int)        {}
     void setFactoryPlayback(SkFlattenable::Factory[], int) {}
     void setDeserialProcs(const SkDeserialProcs&)          {}
+    void setBackingData(const SkData*)                     {}
 
     const SkDeserialProcs& getDeserialProcs() const {
         static const SkDeserialProcs procs;
@@ -186,8 +186,9 @@ private:
     SkAutoTMalloc<Record> fRecords;
 
     // fAlloc needs to be a data structure which can append variable length data in contiguous
-    // chunks, returning a stable handle to that data for later retrieval.
-    SkArenaAlloc fAlloc{256};
+    // chunks, returning a stable handle to that data for later retrieval.  Its first block lives
+    // inline, so small pictures need no allocation beyond the SkRecord and fRecords.
+    SkSTArenaAlloc<256> fAlloc;
     size_t       fApproxBytesAllocated{0};
 };
 
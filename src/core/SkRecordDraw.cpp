@@ -8,6 +8,7 @@
 #include "SkRecordDraw.h"
 #include "SkCanvasPriv.h"
 #include "SkImage.h"
+#include "SkLayerInfo.h"
 #include "SkPatchUtils.h"
 
 void SkRecordDraw(const SkRecord& record,
@@ -504,6 +505,102 @@ private:
     SkTDArray<int>   fControlIndices;
 };
 
+// SkRecord visitor to gather the hoistable saveLayers (see SkLayerInfo) as FillBounds finds their
+// bounds.  A block is hoistable if its SaveLayer reads nothing from the destination, its paint
+// just composites the layer back over it, and nothing inside it draws outside of it.
+class CollectLayers : SkNoncopyable {
+public:
+    CollectLayers(const SkRect& cullRect, const SkRecord& record, SkRect bounds[],
+                  SkLayerInfo* accelData)
+        : fAccelData(accelData)
+        , fFillBounds(cullRect, record, bounds) {}
+
+    void cleanUp() {
+        // Layers still open at the end were never restored, so they aren't hoistable.
+        fFillBounds.cleanUp();
+        fAccelData->sort();
+    }
+
+    template <typename T> void operator()(const T& op) {
+        // FillBounds goes first, so a Restore's bounds are ready for trackSaveLayers().
+        fFillBounds(op);
+        this->trackSaveLayers(op);
+    }
+
+    void setCurrentOp(int currentOp) { fFillBounds.setCurrentOp(currentOp); }
+
+private:
+    struct SaveLayerInfo {
+        int            fStartIndex;    // -1 for Saves and SaveBehinds, which aren't layers.
+        bool           fHoistable;
+        SkMatrix       fLocalMat;
+        const SkRect*  fHint;
+        const SkPaint* fPaint;
+    };
+
+    template <typename T> void trackSaveLayers(const T&) {}
+
+    void trackSaveLayers(const Save&) { this->pushNonLayer(); }
+
+    void trackSaveLayers(const SaveLayer& op) {
+        const SkCanvas::SaveLayerFlags rejected = SkCanvas::kInitWithPrevious_SaveLayerFlag |
+                                                  SkCanvasPriv::kDontClipToLayer_SaveLayerFlag;
+        bool hoistable = !op.backdrop && !op.clipMask && !(op.saveLayerFlags & rejected) &&
+                         CompositesOnly(op.paint);
+        fSaveLayerStack.push_back({ fFillBounds.currentOp(), hoistable, fFillBounds.ctm(),
+                                    op.bounds, op.paint });
+    }
+
+    void trackSaveLayers(const SaveBehind&) {
+        this->pushNonLayer();
+        this->poisonOpenLayers();
+    }
+
+    // These draw outside of (or beneath) the layers they're in.
+    void trackSaveLayers(const DrawBehind&) { this->poisonOpenLayers(); }
+    // Regions clip in device space, which a hoisted layer doesn't share with the canvas.
+    void trackSaveLayers(const ClipRegion&) { this->poisonOpenLayers(); }
+
+    void trackSaveLayers(const Restore&) {
+        if (fSaveLayerStack.isEmpty()) {
+            return;
+        }
+        SaveLayerInfo sli;
+        fSaveLayerStack.pop(&sli);
+        if (sli.fStartIndex < 0 || !sli.fHoistable) {
+            return;
+        }
+
+        SkLayerInfo::BlockInfo& block = fAccelData->addBlock();
+        block.fSaveLayerOpID = sli.fStartIndex;
+        block.fRestoreOpID = fFillBounds.currentOp();
+        block.fBounds = fFillBounds.getBounds(fFillBounds.currentOp());
+        block.fLocalMat = sli.fLocalMat;
+        block.fHint = sli.fHint;
+        block.fPaint = sli.fPaint;
+    }
+
+    void pushNonLayer() {
+        fSaveLayerStack.push_back({ -1, false, SkMatrix::I(), nullptr, nullptr });
+    }
+
+    void poisonOpenLayers() {
+        for (int i = 0; i < fSaveLayerStack.count(); ++i) {
+            fSaveLayerStack[i].fHoistable = false;
+        }
+    }
+
+    static bool CompositesOnly(const SkPaint* paint) {
+        return !paint || (paint->isSrcOver() && !paint->getImageFilter() &&
+                          !paint->getColorFilter() && !paint->getMaskFilter() &&
+                          !paint->getShader() && !paint->getLooper());
+    }
+
+    SkLayerInfo*             fAccelData;
+    FillBounds               fFillBounds;
+    SkTDArray<SaveLayerInfo> fSaveLayerStack;
+};
+
 }  // namespace SkRecords
 
 void SkRecordFillBounds(const SkRect& cullRect, const SkRecord& record, SkRect bounds[]) {
@@ -515,3 +612,13 @@ void SkRecordFillBounds(const SkRect& cullRect, const SkRecord& record, SkRect b
     visitor.cleanUp();
 }
 
+void SkRecordComputeLayers(const SkRect& cullRect, const SkRecord& record, SkRect bounds[],
+                           const SkBigPicture::SnapshotArray* pictList, SkLayerInfo* data) {
+    // Drawable pictures are drawn like any other op, so pictList doesn't change what we collect.
+    SkRecords::CollectLayers visitor(cullRect, record, bounds, data);
+    for (int curOp = 0; curOp < record.count(); curOp++) {
+        visitor.setCurrentOp(curOp);
+        record.visit(curOp, visitor);
+    }
+    visitor.cleanUp();
+}
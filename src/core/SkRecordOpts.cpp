@@ -8,6 +8,7 @@
 #include "SkRecordOpts.h"
 
 #include "SkCanvasPriv.h"
+#include "SkPaintPriv.h"
 #include "SkRecordPattern.h"
 #include "SkRecords.h"
 #include "SkTDArray.h"
@@ -51,6 +52,125 @@ static void multiple_set_matrices(SkRecord* record) {
     while (apply(&pass, record));
 }
 
+// Turns matrix changes that nothing draws with before the following Restore into NoOps.
+struct DeadMatrixBeforeRestoreNooper {
+    typedef Pattern<Or<Is<SetMatrix>, Or<Is<Concat>, Is<Translate>>>,
+                    Greedy<Is<NoOp>>,
+                    Is<Restore>>
+        Match;
+
+    bool onMatch(SkRecord* record, Match*, int begin, int end) {
+        record->replace<NoOp>(begin);  // SetMatrix, Concat or Translate
+        return true;
+    }
+};
+void SkRecordNoopDeadMatrices(SkRecord* record) {
+    DeadMatrixBeforeRestoreNooper pass;
+    // Removing one matrix op can leave the one before it dead too.
+    while (apply(&pass, record));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// Sorts commands by how they affect which earlier draws a later opaque DrawPaint hides.
+enum class Coverage {
+    kNone,      // Doesn't touch pixels or the clip, e.g. matrix changes.
+    kDraw,      // A draw that can be hidden.
+    kKeep,      // A draw that must stay even when hidden, e.g. pictures may hold annotations.
+    kCovers,    // DrawPaint that overwrites every pixel inside the clip.
+    kSave,
+    kRestore,
+    kClip,      // Narrows the clip.
+    kBarrier,   // Anything we can't reason about.
+};
+
+struct CoverageClassifier {
+    template <typename T>
+    Coverage operator()(const T&) {
+        return (T::kTags & kDraw_Tag) ? Coverage::kDraw : Coverage::kNone;
+    }
+
+    Coverage operator()(const DrawPaint& op) {
+        const SkPaint& paint = op.paint;
+        return SkPaintPriv::Overwrites(&paint, SkPaintPriv::kNone_ShaderOverrideOpacity) &&
+               !paint.getImageFilter() && !paint.getMaskFilter() && !paint.getLooper()
+                ? Coverage::kCovers : Coverage::kDraw;
+    }
+
+    Coverage operator()(const DrawPicture&)  { return Coverage::kKeep; }
+    Coverage operator()(const DrawDrawable&) { return Coverage::kKeep; }
+
+    Coverage operator()(const Save&)      { return Coverage::kSave; }
+    Coverage operator()(const SaveLayer&) { return Coverage::kSave; }
+    Coverage operator()(const Restore&)   { return Coverage::kRestore; }
+
+    // Drawing behind existing content depends on everything drawn so far.
+    Coverage operator()(const SaveBehind&) { return Coverage::kBarrier; }
+    Coverage operator()(const DrawBehind&) { return Coverage::kBarrier; }
+
+    Coverage operator()(const ClipPath& op)   { return Clip(op.opAA.op()); }
+    Coverage operator()(const ClipRRect& op)  { return Clip(op.opAA.op()); }
+    Coverage operator()(const ClipRect& op)   { return Clip(op.opAA.op()); }
+    Coverage operator()(const ClipRegion& op) { return Clip(op.op); }
+
+    // Expanding clip ops could uncover pixels a later DrawPaint wouldn't reach.
+    static Coverage Clip(SkClipOp op) {
+        return SkClipOp::kIntersect == op || SkClipOp::kDifference == op ? Coverage::kClip
+                                                                         : Coverage::kBarrier;
+    }
+};
+
+}  // namespace
+
+void SkRecordNoopOverdrawnDraws(SkRecord* record) {
+    CoverageClassifier classify;
+
+    // For each open Save or SaveLayer, the first command since the clip last changed at that
+    // level.  Everything drawn from there on, including into nested blocks (which can only clip
+    // further), lands inside the clip a DrawPaint at that level fills.
+    SkTDArray<int> firstHideable;
+    firstHideable.push_back(0);
+
+    for (int i = 0; i < record->count(); i++) {
+        switch (record->visit(i, classify)) {
+            case Coverage::kNone:
+            case Coverage::kDraw:
+            case Coverage::kKeep:
+                break;
+            case Coverage::kCovers:
+                for (int j = firstHideable.top(); j < i; j++) {
+                    Coverage coverage = record->visit(j, classify);
+                    if (Coverage::kDraw == coverage || Coverage::kCovers == coverage) {
+                        record->replace<NoOp>(j);
+                    }
+                }
+                firstHideable.top() = i;
+                break;
+            case Coverage::kSave:
+                firstHideable.push_back(i + 1);
+                break;
+            case Coverage::kRestore:
+                if (firstHideable.count() > 1) {
+                    firstHideable.pop();
+                    break;
+                }
+                // An unbalanced Restore; treat it like a barrier.
+                firstHideable.top() = i + 1;
+                break;
+            case Coverage::kClip:
+                firstHideable.top() = i + 1;
+                break;
+            case Coverage::kBarrier:
+                for (int& first : firstHideable) {
+                    first = i + 1;
+                }
+                break;
+        }
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 #if 0   // experimental, but needs knowledge of previous matrix to operate correctly
@@ -289,6 +409,34 @@ void SkRecordMergeSvgOpacityAndFilterLayers(SkRecord* record) {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Runs the SaveLayer passes above in a single walk over the record.  Both patterns start with a
+// SaveLayer and can't match at the same index, so this makes the same changes as applying them
+// one after the other.
+static void noop_layers(SkRecord* record) {
+    // See why we turn this off for the Android framework in SkRecordOptimize below.
+#ifndef SK_BUILD_FOR_ANDROID_FRAMEWORK
+    SaveLayerDrawRestoreNooper drawPass;
+    SaveLayerDrawRestoreNooper::Match drawMatch;
+#endif
+    SvgOpacityAndFilterLayerMergePass svgPass;
+    SvgOpacityAndFilterLayerMergePass::Match svgMatch;
+
+    for (int i = 0; i < record->count(); i++) {
+        int end;
+#ifndef SK_BUILD_FOR_ANDROID_FRAMEWORK
+        if ((end = drawMatch.match(record, i)) != 0) {
+            drawPass.onMatch(record, &drawMatch, i, end);
+            i = end - 1;
+            continue;
+        }
+#endif
+        if ((end = svgMatch.match(record, i)) != 0) {
+            svgPass.onMatch(record, &svgMatch, i, end);
+            i = end - 1;
+        }
+    }
+}
+
 void SkRecordOptimize(SkRecord* record) {
     // This might be useful  as a first pass in the future if we want to weed
     // out junk for other optimization passes.  Right now, nothing needs it,
@@ -299,25 +447,20 @@ void SkRecordOptimize(SkRecord* record) {
     //     https://bugs.chromium.org/p/skia/issues/detail?id=5548
 //    SkRecordNoopSaveRestores(record);
 
-    // Turn off this optimization completely for Android framework
+    // noop_layers() turns off the SaveLayer-Draw-Restore merge completely for Android framework
     // because it makes the following Android CTS test fail:
     // android.uirendering.cts.testclasses.LayerTests#testSaveLayerClippedWithAlpha
-#ifndef SK_BUILD_FOR_ANDROID_FRAMEWORK
-    SkRecordNoopSaveLayerDrawRestores(record);
-#endif
-    SkRecordMergeSvgOpacityAndFilterLayers(record);
+    noop_layers(record);
 
     record->defrag();
 }
 
 void SkRecordOptimize2(SkRecord* record) {
     multiple_set_matrices(record);
+    SkRecordNoopDeadMatrices(record);
+    SkRecordNoopOverdrawnDraws(record);
     SkRecordNoopSaveRestores(record);
-    // See why we turn this off in SkRecordOptimize above.
-#ifndef SK_BUILD_FOR_ANDROID_FRAMEWORK
-    SkRecordNoopSaveLayerDrawRestores(record);
-#endif
-    SkRecordMergeSvgOpacityAndFilterLayers(record);
+    noop_layers(record);
 
     record->defrag();
 }
@@ -26,6 +26,12 @@ void SkRecordNoopSaveLayerDrawRestores(SkRecord*);
 // the alpha of the first SaveLayer to the second SaveLayer.
 void SkRecordMergeSvgOpacityAndFilterLayers(SkRecord*);
 
+// Turns SetMatrix, Concat and Translate commands followed directly by a Restore into no-ops.
+void SkRecordNoopDeadMatrices(SkRecord*);
+
+// Turns draws that a later opaque DrawPaint completely covers into no-ops.
+void SkRecordNoopOverdrawnDraws(SkRecord*);
+
 // Experimental optimizers
 void SkRecordOptimize2(SkRecord*);
 
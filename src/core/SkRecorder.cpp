@@ -165,6 +165,7 @@ void SkRecorder::onDrawRegion(const SkRegion& region, const SkPaint& paint) {
 }
 
 void SkRecorder::onDrawOval(const SkRect& oval, const SkPaint& paint) {
+    TRY_MINIRECORDER(drawOval, oval, paint);
     this->append<SkRecords::DrawOval>(paint, oval);
 }
 
@@ -174,6 +175,7 @@ void SkRecorder::onDrawArc(const SkRect& oval, SkScalar startAngle, SkScalar swe
 }
 
 void SkRecorder::onDrawRRect(const SkRRect& rrect, const SkPaint& paint) {
+    TRY_MINIRECORDER(drawRRect, rrect, paint);
     this->append<SkRecords::DrawRRect>(paint, rrect);
 }
 
@@ -238,6 +240,7 @@ void SkRecorder::onDrawBitmapLattice(const SkBitmap& bitmap, const Lattice& latt
 
 void SkRecorder::onDrawImage(const SkImage* image, SkScalar left, SkScalar top,
                              const SkPaint* paint) {
+    TRY_MINIRECORDER(drawImage, image, left, top, paint);
     this->append<SkRecords::DrawImage>(this->copy(paint), sk_ref_sp(image), left, top);
 }
 
@@ -772,6 +772,23 @@ static int distance_to_sentinel(const SkRegionPriv::RunType* runs) {
     return ptr - runs;
 }
 
+// Appends the interval [left, rite) followed by the remaining intervals in runs, which are
+// already sorted and disjoint, so all but the first can be memcpy'd rather than merged.
+static SkRegionPriv::RunType* copy_intervals(SkRegionPriv::RunType* dst, bool firstInterval,
+                                             int left, int rite,
+                                             const SkRegionPriv::RunType* runs) {
+    SkASSERT(left < rite);
+    if (firstInterval || *(dst - 1) < left) {
+        *dst++ = (SkRegionPriv::RunType)(left);
+        *dst++ = (SkRegionPriv::RunType)(rite);
+    } else {
+        *(dst - 1) = (SkRegionPriv::RunType)(rite);
+    }
+    int count = distance_to_sentinel(runs);
+    memcpy(dst, runs, count * sizeof(SkRegionPriv::RunType));
+    return dst + count;
+}
+
 static int operate_on_span(const SkRegionPriv::RunType a_runs[],
                            const SkRegionPriv::RunType b_runs[],
                            RunArray* array, int dstOffset,
@@ -787,6 +804,20 @@ static int operate_on_span(const SkRegionPriv::RunType a_runs[],
     rec.init(a_runs, b_runs);
 
     while (!rec.done()) {
+        // Once either side runs out, the rest of the other side is either entirely in the result
+        // (inside == 1 for A alone, 2 for B alone) or entirely out of it.
+        if (rec.fA_left == SkRegion_kRunTypeSentinel ||
+                rec.fB_left == SkRegion_kRunTypeSentinel) {
+            bool aRemains = rec.fB_left == SkRegion_kRunTypeSentinel;
+            int inside = aRemains ? 1 : 2;
+            if ((unsigned)(inside - min) <= (unsigned)(max - min)) {
+                dst = aRemains
+                    ? copy_intervals(dst, firstInterval, rec.fA_left, rec.fA_rite, rec.fA_runs)
+                    : copy_intervals(dst, firstInterval, rec.fB_left, rec.fB_rite, rec.fB_runs);
+            }
+            break;
+        }
+
         rec.next();
 
         int left = rec.fLeft;
@@ -8,6 +8,7 @@
 #include "SkRemoteGlyphCache.h"
 
 #include <iterator>
+#include <map>
 #include <memory>
 #include <new>
 #include <string>
@@ -19,6 +20,7 @@
 #include "SkRemoteGlyphCacheImpl.h"
 #include "SkStrike.h"
 #include "SkStrikeCache.h"
+#include "SkStrikeSerialization.h"
 #include "SkTLazy.h"
 #include "SkTraceEvent.h"
 #include "SkTypeface_remote.h"
@@ -65,113 +67,6 @@ static const SkDescriptor* create_descriptor(
     return SkScalerContext::AutoDescriptorGivenRecAndEffects(rec, *effects, ad);
 }
 
-// -- Serializer ----------------------------------------------------------------------------------
-
-size_t pad(size_t size, size_t alignment) { return (size + (alignment - 1)) & ~(alignment - 1); }
-
-class Serializer {
-public:
-    Serializer(std::vector<uint8_t>* buffer) : fBuffer{buffer} { }
-
-    template <typename T, typename... Args>
-    T* emplace(Args&&... args) {
-        auto result = allocate(sizeof(T), alignof(T));
-        return new (result) T{std::forward<Args>(args)...};
-    }
-
-    template <typename T>
-    void write(const T& data) {
-        T* result = (T*)allocate(sizeof(T), alignof(T));
-        memcpy(result, &data, sizeof(T));
-    }
-
-    template <typename T>
-    T* allocate() {
-        T* result = (T*)allocate(sizeof(T), alignof(T));
-        return result;
-    }
-
-    void writeDescriptor(const SkDescriptor& desc) {
-        write(desc.getLength());
-        auto result = allocate(desc.getLength(), alignof(SkDescriptor));
-        memcpy(result, &desc, desc.getLength());
-    }
-
-    void* allocate(size_t size, size_t alignment) {
-        size_t aligned = pad(fBuffer->size(), alignment);
-        fBuffer->resize(aligned + size);
-        return &(*fBuffer)[aligned];
-    }
-
-private:
-    std::vector<uint8_t>* fBuffer;
-};
-
-// -- Deserializer -------------------------------------------------------------------------------
-// Note that the Deserializer is reading untrusted data, we need to guard against invalid data.
-class Deserializer {
-public:
-    Deserializer(const volatile char* memory, size_t memorySize)
-            : fMemory(memory), fMemorySize(memorySize) {}
-
-    template <typename T>
-    bool read(T* val) {
-        auto* result = this->ensureAtLeast(sizeof(T), alignof(T));
-        if (!result) return false;
-
-        memcpy(val, const_cast<const char*>(result), sizeof(T));
-        return true;
-    }
-
-    bool readDescriptor(SkAutoDescriptor* ad) {
-        uint32_t desc_length = 0u;
-        if (!read<uint32_t>(&desc_length)) return false;
-
-        auto* result = this->ensureAtLeast(desc_length, alignof(SkDescriptor));
-        if (!result) return false;
-
-        ad->reset(desc_length);
-        memcpy(ad->getDesc(), const_cast<const char*>(result), desc_length);
-        return true;
-    }
-
-    const volatile void* read(size_t size, size_t alignment) {
-      return this->ensureAtLeast(size, alignment);
-    }
-
-private:
-    const volatile char* ensureAtLeast(size_t size, size_t alignment) {
-        size_t padded = pad(fBytesRead, alignment);
-
-        // Not enough data
-        if (padded + size > fMemorySize) return nullptr;
-
-        auto* result = fMemory + padded;
-        fBytesRead = padded + size;
-        return result;
-    }
-
-    // Note that we read each piece of memory only once to guard against TOCTOU violations.
-    const volatile char* fMemory;
-    size_t fMemorySize;
-    size_t fBytesRead = 0u;
-};
-
-// Paths use a SkWriter32 which requires 4 byte alignment.
-static const size_t kPathAlignment  = 4u;
-
-bool read_path(Deserializer* deserializer, SkGlyph* glyph, SkStrike* cache) {
-    uint64_t pathSize = 0u;
-    if (!deserializer->read<uint64_t>(&pathSize)) return false;
-
-    if (pathSize == 0u) return true;
-
-    auto* path = deserializer->read(pathSize, kPathAlignment);
-    if (!path) return false;
-
-    return cache->initializePath(glyph, path, pathSize);
-}
-
 size_t SkDescriptorMapOperators::operator()(const SkDescriptor* key) const {
     return key->getChecksum();
 }
@@ -190,6 +85,9 @@ struct StrikeSpec {
     /* n X (glyphs ids) */
 };
 
+// Written in place of an image's shared memory offset when it didn't fit and follows inline.
+static constexpr uint64_t kImageNotShared = ~0ull;
+
 // -- TrackLayerDevice -----------------------------------------------------------------------------
 SkTextBlobCacheDiffCanvas::TrackLayerDevice::TrackLayerDevice(
         const SkIRect& bounds, const SkSurfaceProps& props, SkStrikeServer* server,
@@ -274,6 +172,66 @@ struct WireTypeface {
 
 // SkStrikeServer -----------------------------------------
 
+// A first-fit allocator over the memory shared with the clients. We only track offsets here;
+// nothing in the block itself is used for bookkeeping, since the clients can see all of it.
+class SkStrikeServer::SharedGlyphArena {
+public:
+    SharedGlyphArena(void* memory, size_t size) : fMemory{static_cast<char*>(memory)} {
+        if (size > 0) {
+            fFreeRanges[0] = size;
+        }
+    }
+
+    // Returns kImageNotShared if there's no room.
+    uint64_t allocate(size_t size, size_t alignment) {
+        for (auto it = fFreeRanges.begin(); it != fFreeRanges.end(); ++it) {
+            size_t start = it->first,
+                   end   = it->first + it->second,
+                   offset = pad(start, alignment);
+            if (offset >= end || end - offset < size) {
+                continue;
+            }
+            fFreeRanges.erase(it);
+            if (offset > start) {
+                fFreeRanges[start] = offset - start;
+            }
+            if (offset + size < end) {
+                fFreeRanges[offset + size] = end - (offset + size);
+            }
+            fBytesUsed += size;
+            return offset;
+        }
+        return kImageNotShared;
+    }
+
+    void release(size_t offset, size_t size) {
+        SkASSERT(fBytesUsed >= size);
+        fBytesUsed -= size;
+
+        auto next = fFreeRanges.lower_bound(offset);
+        if (next != fFreeRanges.end() && offset + size == next->first) {
+            size += next->second;
+            next = fFreeRanges.erase(next);
+        }
+        if (next != fFreeRanges.begin()) {
+            auto prev = std::prev(next);
+            if (prev->first + prev->second == offset) {
+                prev->second += size;
+                return;
+            }
+        }
+        fFreeRanges[offset] = size;
+    }
+
+    void* at(size_t offset) const { return fMemory + offset; }
+    size_t bytesUsed() const { return fBytesUsed; }
+
+private:
+    char* const fMemory;
+    std::map<size_t, size_t> fFreeRanges;  // offset -> size
+    size_t fBytesUsed{0};
+};
+
 SkStrikeServer::SkStrikeServer(DiscardableHandleManager* discardableHandleManager)
         : fDiscardableHandleManager(discardableHandleManager) {
     SkASSERT(fDiscardableHandleManager);
@@ -281,6 +239,15 @@ SkStrikeServer::SkStrikeServer(DiscardableHandleManager* discardableHandleManage
 
 SkStrikeServer::~SkStrikeServer() = default;
 
+void SkStrikeServer::setSharedGlyphMemory(void* memory, size_t size) {
+    SkASSERT(fRemoteGlyphStateMap.empty());
+    fSharedGlyphArena = skstd::make_unique<SharedGlyphArena>(memory, size);
+}
+
+size_t SkStrikeServer::sharedGlyphMemoryUsedForTesting() const {
+    return fSharedGlyphArena ? fSharedGlyphArena->bytesUsed() : 0u;
+}
+
 sk_sp<SkData> SkStrikeServer::serializeTypeface(SkTypeface* tf) {
     auto* data = fSerializedTypefaces.find(SkTypeface::UniqueID(tf));
     if (data) {
@@ -398,7 +365,8 @@ SkStrikeServer::SkGlyphCacheState* SkStrikeServer::getOrCreateCache(
 
     // Create a new cache state and insert it into the map.
     auto newHandle = fDiscardableHandleManager->createHandle();
-    auto cacheState = skstd::make_unique<SkGlyphCacheState>(desc, std::move(context), newHandle);
+    auto cacheState = skstd::make_unique<SkGlyphCacheState>(desc, std::move(context), newHandle,
+                                                            fSharedGlyphArena.get());
 
     auto* cacheStatePtr = cacheState.get();
 
@@ -415,9 +383,11 @@ SkStrikeServer::SkGlyphCacheState* SkStrikeServer::getOrCreateCache(
 SkStrikeServer::SkGlyphCacheState::SkGlyphCacheState(
         const SkDescriptor& descriptor,
         std::unique_ptr<SkScalerContext> context,
-        uint32_t discardableHandleId)
+        uint32_t discardableHandleId,
+        SharedGlyphArena* sharedArena)
         : fDescriptor{descriptor}
         , fDiscardableHandleId(discardableHandleId)
+        , fSharedArena{sharedArena}
         , fIsSubpixel{context->isSubpixel()}
         , fAxisAlignmentForHText{context->computeAxisAlignmentForHText()}
         // N.B. context must come last because it is used above.
@@ -426,7 +396,12 @@ SkStrikeServer::SkGlyphCacheState::SkGlyphCacheState(
     SkASSERT(fContext != nullptr);
 }
 
-SkStrikeServer::SkGlyphCacheState::~SkGlyphCacheState() = default;
+SkStrikeServer::SkGlyphCacheState::~SkGlyphCacheState() {
+    // We're only deleted once the client has deleted its strike, so nobody is using these.
+    for (const auto& image : fSharedImages) {
+        fSharedArena->release(image.first, image.second);
+    }
+}
 
 void SkStrikeServer::SkGlyphCacheState::addGlyph(SkPackedGlyphID glyph, bool asPath) {
     auto* cache = asPath ? &fCachedGlyphPaths : &fCachedGlyphImages;
@@ -446,18 +421,6 @@ void SkStrikeServer::SkGlyphCacheState::addGlyph(SkPackedGlyphID glyph, bool asP
     pending->push_back(glyph);
 }
 
-static void writeGlyph(SkGlyph* glyph, Serializer* serializer) {
-    serializer->write<SkPackedGlyphID>(glyph->getPackedID());
-    serializer->write<float>(glyph->fAdvanceX);
-    serializer->write<float>(glyph->fAdvanceY);
-    serializer->write<uint16_t>(glyph->fWidth);
-    serializer->write<uint16_t>(glyph->fHeight);
-    serializer->write<int16_t>(glyph->fTop);
-    serializer->write<int16_t>(glyph->fLeft);
-    serializer->write<int8_t>(glyph->fForceBW);
-    serializer->write<uint8_t>(glyph->fMaskFormat);
-}
-
 void SkStrikeServer::SkGlyphCacheState::writePendingGlyphs(Serializer* serializer) {
     // TODO(khushalsagar): Write a strike only if it has any pending glyphs.
     serializer->emplace<bool>(this->hasPendingGlyphs());
@@ -478,6 +441,7 @@ void SkStrikeServer::SkGlyphCacheState::writePendingGlyphs(Serializer* serialize
 
     // Write glyphs images.
     serializer->emplace<uint64_t>(fPendingGlyphImages.size());
+    serializer->emplace<bool>(fSharedArena != nullptr);
     for (const auto& glyphID : fPendingGlyphImages) {
         SkGlyph glyph{glyphID};
         fContext->getMetrics(&glyph);
@@ -486,6 +450,17 @@ void SkStrikeServer::SkGlyphCacheState::writePendingGlyphs(Serializer* serialize
         auto imageSize = glyph.computeImageSize();
         if (imageSize == 0u) continue;
 
+        if (fSharedArena) {
+            uint64_t offset = fSharedArena->allocate(imageSize, glyph.formatAlignment());
+            serializer->write<uint64_t>(offset);
+            if (offset != kImageNotShared) {
+                fSharedImages.emplace_back(offset, imageSize);
+                glyph.fImage = fSharedArena->at(offset);
+                fContext->getImage(glyph);
+                continue;
+            }
+        }
+
         glyph.fImage = serializer->allocate(imageSize, glyph.formatAlignment());
         fContext->getImage(glyph);
         // TODO: Generating the image can change the mask format, do we need to update it in the
@@ -663,21 +638,6 @@ SkStrikeClient::~SkStrikeClient() = default;
         return false;                     \
     }
 
-static bool readGlyph(SkTLazy<SkGlyph>& glyph, Deserializer* deserializer) {
-    SkPackedGlyphID glyphID;
-    if (!deserializer->read<SkPackedGlyphID>(&glyphID)) return false;
-    glyph.init(glyphID);
-    if (!deserializer->read<float>(&glyph->fAdvanceX)) return false;
-    if (!deserializer->read<float>(&glyph->fAdvanceY)) return false;
-    if (!deserializer->read<uint16_t>(&glyph->fWidth)) return false;
-    if (!deserializer->read<uint16_t>(&glyph->fHeight)) return false;
-    if (!deserializer->read<int16_t>(&glyph->fTop)) return false;
-    if (!deserializer->read<int16_t>(&glyph->fLeft)) return false;
-    if (!deserializer->read<int8_t>(&glyph->fForceBW)) return false;
-    if (!deserializer->read<uint8_t>(&glyph->fMaskFormat)) return false;
-    return true;
-}
-
 bool SkStrikeClient::readStrikeData(const volatile void* memory, size_t memorySize) {
     SkASSERT(memorySize != 0u);
     Deserializer deserializer(static_cast<const volatile char*>(memory), memorySize);
@@ -741,6 +701,9 @@ bool SkStrikeClient::readStrikeData(const volatile void* memory, size_t memorySi
 
         uint64_t glyphImagesCount = 0u;
         if (!deserializer.read<uint64_t>(&glyphImagesCount)) READ_FAILURE
+        bool sharedImages = false;
+        if (!deserializer.read<bool>(&sharedImages)) READ_FAILURE
+        if (sharedImages && fSharedGlyphMemory == nullptr) READ_FAILURE
         for (size_t j = 0; j < glyphImagesCount; j++) {
             SkTLazy<SkGlyph> glyph;
             if (!readGlyph(glyph, &deserializer)) READ_FAILURE
@@ -758,6 +721,19 @@ bool SkStrikeClient::readStrikeData(const volatile void* memory, size_t memorySi
             auto imageSize = glyph->computeImageSize();
             if (imageSize == 0u) continue;
 
+            if (sharedImages) {
+                uint64_t offset = 0u;
+                if (!deserializer.read<uint64_t>(&offset)) READ_FAILURE
+                if (offset != kImageNotShared) {
+                    if (offset > fSharedGlyphMemorySize ||
+                        imageSize > fSharedGlyphMemorySize - offset ||
+                        offset % glyph->formatAlignment() != 0) READ_FAILURE
+                    strike->initializeSharedImage(fSharedGlyphMemory + offset, imageSize,
+                                                  allocatedGlyph);
+                    continue;
+                }
+            }
+
             auto* image = deserializer.read(imageSize, allocatedGlyph->formatAlignment());
             if (!image) READ_FAILURE
             strike->initializeImage(image, imageSize, allocatedGlyph);
@@ -786,6 +762,11 @@ bool SkStrikeClient::readStrikeData(const volatile void* memory, size_t memorySi
     return true;
 }
 
+void SkStrikeClient::setSharedGlyphMemory(const volatile void* memory, size_t size) {
+    fSharedGlyphMemory = static_cast<const volatile char*>(memory);
+    fSharedGlyphMemorySize = size;
+}
+
 sk_sp<SkTypeface> SkStrikeClient::deserializeTypeface(const void* buf, size_t len) {
     WireTypeface wire;
     if (len != sizeof(wire)) return nullptr;
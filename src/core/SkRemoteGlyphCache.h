@@ -124,6 +124,15 @@ public:
     // unlocked after this call.
     void writeStrikeData(std::vector<uint8_t>* memory);
 
+    // Use a block of memory that the embedder has also mapped into the client process(es) to
+    // hold glyph images. Images put there are used in place by the SkStrikeClient instead of
+    // being copied through the strike data, so pass the same block to
+    // SkStrikeClient::setSharedGlyphMemory(). A strike's images are reclaimed once its handle
+    // is deleted, so with several clients sharing the block, the DiscardableHandleManager should
+    // only report a handle deleted once every client has deleted it. Images that don't fit are
+    // sent in the strike data as usual. Must be called before any strikes are created.
+    void setSharedGlyphMemory(void* memory, size_t size);
+
     // Methods used internally in skia ------------------------------------------
     class SkGlyphCacheState;
 
@@ -142,16 +151,21 @@ public:
         fMaxEntriesInDescriptorMap = count;
     }
     size_t remoteGlyphStateMapSizeForTesting() const { return fRemoteGlyphStateMap.size(); }
+    size_t sharedGlyphMemoryUsedForTesting() const;
 
 private:
     static constexpr size_t kMaxEntriesInDescriptorMap = 2000u;
 
+    class SharedGlyphArena;
+
     void checkForDeletedEntries();
 
     SkGlyphCacheState* getOrCreateCache(const SkDescriptor& desc,
                                         const SkTypeface& typeface,
                                         SkScalerContextEffects effects);
 
+    // Declared before fRemoteGlyphStateMap, since the cache states release into it.
+    std::unique_ptr<SharedGlyphArena> fSharedGlyphArena;
     SkDescriptorMap<std::unique_ptr<SkGlyphCacheState>> fRemoteGlyphStateMap;
     DiscardableHandleManager* const fDiscardableHandleManager;
     SkTHashSet<SkFontID> fCachedTypefaces;
@@ -210,6 +224,11 @@ public:
     // Returns false if the data is invalid.
     bool readStrikeData(const volatile void* memory, size_t memorySize);
 
+    // The client side of SkStrikeServer::setSharedGlyphMemory(). Strikes read from this client
+    // point into memory, so it must stay mapped until they have all been deleted from the
+    // strike cache.
+    void setSharedGlyphMemory(const volatile void* memory, size_t size);
+
 private:
     class DiscardableStrikePinner;
 
@@ -219,6 +238,8 @@ private:
     sk_sp<DiscardableHandleManager> fDiscardableHandleManager;
     SkStrikeCache* const fStrikeCache;
     const bool fIsLogging;
+    const volatile char* fSharedGlyphMemory{nullptr};
+    size_t fSharedGlyphMemorySize{0};
 };
 
 #endif  // SkRemoteGlyphCache_DEFINED
@@ -13,13 +13,15 @@
 #include "SkGlyphRun.h"
 #include "SkGlyphRunPainter.h"
 #include "SkRemoteGlyphCache.h"
+#include "SkTSwissTable.h"
 
 class SkStrikeServer::SkGlyphCacheState : public SkStrikeInterface {
 public:
     // N.B. SkGlyphCacheState is not valid until ensureScalerContext is called.
     SkGlyphCacheState(const SkDescriptor& descriptor,
                       std::unique_ptr<SkScalerContext> context,
-                      SkDiscardableHandleId discardableHandleId);
+                      SkDiscardableHandleId discardableHandleId,
+                      SharedGlyphArena* sharedArena = nullptr);
     ~SkGlyphCacheState() override;
 
     void addGlyph(SkPackedGlyphID, bool pathOnly);
@@ -71,6 +73,11 @@ private:
 
     const SkDiscardableHandleId fDiscardableHandleId;
 
+    // Where we put glyph images for the client to use in place, and the (offset, size) of each
+    // image we've put there, to give back when we're deleted.
+    SharedGlyphArena* const fSharedArena;
+    std::vector<std::pair<size_t, size_t>> fSharedImages;
+
     // Values saved from the initial context.
     const bool fIsSubpixel;
     const SkAxisAlignment fAxisAlignmentForHText;
@@ -95,7 +102,7 @@ private:
 
     // FallbackTextHelper cases require glyph metrics when analyzing a glyph run, in which case
     // we cache them here.
-    SkTHashTable<SkGlyph*, SkPackedGlyphID, GlyphMapHashTraits> fGlyphMap;
+    SkTSwissTable<SkGlyph*, SkPackedGlyphID, GlyphMapHashTraits> fGlyphMap;
 
     SkArenaAlloc fAlloc{256};
 };
@@ -9,12 +9,15 @@
 
 #include "SkDiscardableMemory.h"
 #include "SkMessageBus.h"
+#include "SkMetrics.h"
 #include "SkMipMap.h"
 #include "SkMutex.h"
+#include "SkOnce.h"
 #include "SkOpts.h"
 #include "SkTo.h"
 #include "SkTraceMemoryDump.h"
 
+#include <atomic>
 #include <stddef.h>
 #include <stdlib.h>
 
@@ -118,13 +121,16 @@ bool SkResourceCache::find(const Key& key, FindVisitor visitor, void* context) {
     if (auto found = fHash->find(key)) {
         Rec* rec = *found;
         if (visitor(*rec, context)) {
+            SK_METRIC_COUNT("resource_cache.hits", 1);
             this->moveToHead(rec);  // for our LRU
             return true;
         } else {
+            SK_METRIC_COUNT("resource_cache.stale", 1);
             this->remove(rec);  // stale
             return false;
         }
     }
+    SK_METRIC_COUNT("resource_cache.misses", 1);
     return false;
 }
 
@@ -199,25 +205,26 @@ void SkResourceCache::remove(Rec* rec) {
 }
 
 void SkResourceCache::purgeAsNeeded(bool forcePurge) {
-    size_t byteLimit;
-    int    countLimit;
-
-    if (fDiscardableFactory) {
-        countLimit = SK_DISCARDABLEMEMORY_SCALEDIMAGECACHE_COUNT_LIMIT;
-        byteLimit = UINT32_MAX;  // no limit based on bytes
+    if (forcePurge) {
+        this->purgeUntilUnder(0, 0);
+    } else if (fDiscardableFactory) {
+        this->purgeUntilUnder(UINT32_MAX,  // no limit based on bytes
+                              SK_DISCARDABLEMEMORY_SCALEDIMAGECACHE_COUNT_LIMIT);
     } else {
-        countLimit = SK_MaxS32; // no limit based on count
-        byteLimit = fTotalByteLimit;
+        this->purgeUntilUnder(fTotalByteLimit, SK_MaxS32);  // no limit based on count
     }
+}
 
+void SkResourceCache::purgeUntilUnder(size_t byteLimit, int countLimit) {
     Rec* rec = fTail;
     while (rec) {
-        if (!forcePurge && fTotalBytesUsed < byteLimit && fCount < countLimit) {
+        if (fTotalBytesUsed < byteLimit && fCount < countLimit) {
             break;
         }
 
         Rec* prev = rec->fPrev;
         if (rec->canBePurged()) {
+            SK_METRIC_COUNT("resource_cache.evictions", 1);
             this->remove(rec);
         }
         rec = prev;
@@ -449,86 +456,192 @@ void SkResourceCache::checkMessages() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-SK_DECLARE_STATIC_MUTEX(gMutex);
-static SkResourceCache* gResourceCache = nullptr;
+// Each shard is an ordinary SkResourceCache with a practically unlimited budget of its own.
+// The global budget is tracked here with atomics and enforced by purge_as_needed().
+static constexpr int kShardCount = 16;
+
+namespace {
+    struct Shard {
+        SkBaseMutex      fMutex;
+        SkResourceCache* fCache = nullptr;  // so gShards is constant initialized
+    };
+}
+
+static Shard gShards[kShardCount];
+
+static SkResourceCache::DiscardableFactory gDiscardableFactory = nullptr;
+static std::atomic<size_t> gTotalByteLimit{0};
+static std::atomic<size_t> gSingleAllocationByteLimit{0};
 
-/** Must hold gMutex when calling. */
-static SkResourceCache* get_cache() {
-    // gMutex is always held when this is called, so we don't need to be fancy in here.
-    gMutex.assertHeld();
-    if (nullptr == gResourceCache) {
+// The sums of every shard's getTotalBytesUsed() and getCount().
+static std::atomic<size_t> gTotalBytesUsed{0};
+static std::atomic<int>    gCount{0};
+
+// Which shard purge_as_needed() should start purging from next.
+static std::atomic<int>    gPurgeCursor{0};
+
+static void init_shards() {
+    static SkOnce once;
+    once([] {
 #ifdef SK_USE_DISCARDABLE_SCALEDIMAGECACHE
-        gResourceCache = new SkResourceCache(SkDiscardableMemory::Create);
+        gDiscardableFactory = SkDiscardableMemory::Create;
 #else
-        gResourceCache = new SkResourceCache(SK_DEFAULT_IMAGE_CACHE_LIMIT);
+        gTotalByteLimit = SK_DEFAULT_IMAGE_CACHE_LIMIT;
 #endif
+        for (Shard& shard : gShards) {
+            shard.fCache = gDiscardableFactory ? new SkResourceCache(gDiscardableFactory)
+                                               : new SkResourceCache(SIZE_MAX);
+        }
+    });
+}
+
+static Shard& shard_for(const SkResourceCache::Key& key) {
+    // SkTHashTable indexes with the low bits of the hash, so pick shards with the high bits.
+    return gShards[key.hash() >> 28];
+}
+static_assert(kShardCount == 16, "shard_for() assumes 16 shards");
+
+// Runs fn on a shard's cache under its lock, keeping the global totals in sync.
+template <typename Fn>
+static auto with_shard(Shard& shard, Fn&& fn) -> decltype(fn(shard.fCache)) {
+    SkAutoMutexAcquire am(shard.fMutex);
+
+    struct SyncTotals {
+        ~SyncTotals() {
+            // size_t addition wraps, so this handles shrinking too.
+            gTotalBytesUsed += cache->getTotalBytesUsed() - bytes;
+            gCount          += cache->getCount()          - count;
+        }
+        SkResourceCache* cache;
+        size_t           bytes;
+        int              count;
+    } sync = { shard.fCache, shard.fCache->getTotalBytesUsed(), shard.fCache->getCount() };
+
+    return fn(shard.fCache);
+}
+
+static bool over_budget() {
+    if (gDiscardableFactory) {
+        return gCount >= SK_DISCARDABLEMEMORY_SCALEDIMAGECACHE_COUNT_LIMIT;
+    }
+    return gTotalBytesUsed >= gTotalByteLimit;
+}
+
+// Purge round-robin across the shards until we're back under the global budget.
+// This only approximates a global LRU, but never needs to hold more than one shard's lock.
+static void purge_as_needed() {
+    int start = gPurgeCursor.fetch_add(1, std::memory_order_relaxed);
+    for (int i = 0; i < kShardCount && over_budget(); i++) {
+        with_shard(gShards[(start + i) % kShardCount], [](SkResourceCache* cache) {
+            size_t byteExcess = 0;
+            int    countExcess = 0;
+            if (gDiscardableFactory) {
+                countExcess = SkTMax(0, gCount - SK_DISCARDABLEMEMORY_SCALEDIMAGECACHE_COUNT_LIMIT);
+            } else {
+                size_t used = gTotalBytesUsed, limit = gTotalByteLimit;
+                byteExcess = used > limit ? used - limit : 0;
+            }
+
+            size_t bytes = cache->getTotalBytesUsed();
+            int    count = cache->getCount();
+            cache->purgeUntilUnder(gDiscardableFactory ? SIZE_MAX
+                                                       : bytes - SkTMin(byteExcess, bytes),
+                                   gDiscardableFactory ? count - SkTMin(countExcess, count)
+                                                       : SK_MaxS32);
+        });
     }
-    return gResourceCache;
 }
 
 size_t SkResourceCache::GetTotalBytesUsed() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->getTotalBytesUsed();
+    init_shards();
+    return gTotalBytesUsed;
 }
 
 size_t SkResourceCache::GetTotalByteLimit() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->getTotalByteLimit();
+    init_shards();
+    return gTotalByteLimit;
 }
 
 size_t SkResourceCache::SetTotalByteLimit(size_t newLimit) {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->setTotalByteLimit(newLimit);
+    init_shards();
+    size_t prevLimit = gTotalByteLimit.exchange(newLimit);
+    if (newLimit < prevLimit) {
+        purge_as_needed();
+    }
+    return prevLimit;
 }
 
 SkResourceCache::DiscardableFactory SkResourceCache::GetDiscardableFactory() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->discardableFactory();
+    init_shards();
+    return gDiscardableFactory;
 }
 
 SkCachedData* SkResourceCache::NewCachedData(size_t bytes) {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->newCachedData(bytes);
+    init_shards();
+    if (gDiscardableFactory) {
+        SkDiscardableMemory* dm = gDiscardableFactory(bytes);
+        return dm ? new SkCachedData(bytes, dm) : nullptr;
+    } else {
+        return new SkCachedData(sk_malloc_throw(bytes), bytes);
+    }
 }
 
 void SkResourceCache::Dump() {
-    SkAutoMutexAcquire am(gMutex);
-    get_cache()->dump();
+    init_shards();
+    for (Shard& shard : gShards) {
+        SkAutoMutexAcquire am(shard.fMutex);
+        shard.fCache->dump();
+    }
 }
 
 size_t SkResourceCache::SetSingleAllocationByteLimit(size_t size) {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->setSingleAllocationByteLimit(size);
+    init_shards();
+    return gSingleAllocationByteLimit.exchange(size);
 }
 
 size_t SkResourceCache::GetSingleAllocationByteLimit() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->getSingleAllocationByteLimit();
+    init_shards();
+    return gSingleAllocationByteLimit;
 }
 
 size_t SkResourceCache::GetEffectiveSingleAllocationByteLimit() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->getEffectiveSingleAllocationByteLimit();
+    init_shards();
+    // Same policy as getEffectiveSingleAllocationByteLimit(), against the global budget.
+    size_t limit = gSingleAllocationByteLimit;
+    if (nullptr == gDiscardableFactory) {
+        limit = 0 == limit ? gTotalByteLimit.load() : SkTMin(limit, gTotalByteLimit.load());
+    }
+    return limit;
 }
 
 void SkResourceCache::PurgeAll() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->purgeAll();
+    init_shards();
+    for (Shard& shard : gShards) {
+        with_shard(shard, [](SkResourceCache* cache) { cache->purgeAll(); });
+    }
 }
 
 bool SkResourceCache::Find(const Key& key, FindVisitor visitor, void* context) {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->find(key, visitor, context);
+    init_shards();
+    return with_shard(shard_for(key), [&](SkResourceCache* cache) {
+        return cache->find(key, visitor, context);
+    });
 }
 
 void SkResourceCache::Add(Rec* rec, void* payload) {
-    SkAutoMutexAcquire am(gMutex);
-    get_cache()->add(rec, payload);
+    init_shards();
+    with_shard(shard_for(rec->getKey()), [&](SkResourceCache* cache) {
+        cache->add(rec, payload);
+    });
+    purge_as_needed();
 }
 
 void SkResourceCache::VisitAll(Visitor visitor, void* context) {
-    SkAutoMutexAcquire am(gMutex);
-    get_cache()->visitAll(visitor, context);
+    init_shards();
+    for (Shard& shard : gShards) {
+        SkAutoMutexAcquire am(shard.fMutex);
+        shard.fCache->visitAll(visitor, context);
+    }
 }
 
 void SkResourceCache::PostPurgeSharedID(uint64_t sharedID) {
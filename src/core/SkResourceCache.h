@@ -25,6 +25,10 @@ class SkTraceMemoryDump;
  *
  *  As a convenience, a global instance is also defined, which can be safely
  *  access across threads via the static methods (e.g. FindAndLock, etc.).
+ *  To keep threads from contending on one lock, the global instance is really
+ *  several caches ("shards"), each with its own mutex and LRU, picked by key
+ *  hash. They share one total byte budget (or count limit, when backed by
+ *  discardable memory), enforced by purging across all the shards.
  */
 class SkResourceCache {
 public:
@@ -222,6 +226,7 @@ public:
 
     size_t getTotalBytesUsed() const { return fTotalBytesUsed; }
     size_t getTotalByteLimit() const { return fTotalByteLimit; }
+    int getCount() const { return fCount; }
 
     /**
      *  This is respected by SkBitmapProcState::possiblyScaleImage.
@@ -247,6 +252,12 @@ public:
         this->purgeAsNeeded(true);
     }
 
+    /**
+     *  Purge least recently used Recs until this cache holds fewer than byteLimit bytes and
+     *  fewer than countLimit Recs, or until nothing left can be purged.
+     */
+    void purgeUntilUnder(size_t byteLimit, int countLimit);
+
     DiscardableFactory discardableFactory() const { return fDiscardableFactory; }
 
     SkCachedData* newCachedData(size_t bytes);
@@ -16,6 +16,7 @@
 #include "SkFontMetrics.h"
 #include "SkFontPriv.h"
 #include "SkGlyph.h"
+#include "SkGlyphOutlineCache.h"
 #include "SkMakeUnique.h"
 #include "SkMaskFilter.h"
 #include "SkMaskGamma.h"
@@ -30,6 +31,8 @@
 #include "SkStrokeRec.h"
 #include "SkSurfacePriv.h"
 #include "SkTextFormatParams.h"
+#include "SkTDArray.h"
+#include "SkTaskGroup.h"
 #include "SkTo.h"
 #include "SkWriteBuffer.h"
 #include <new>
@@ -573,6 +576,62 @@ void SkScalerContext::getImage(const SkGlyph& origGlyph) {
     }
 }
 
+void SkScalerContext::getImages(SkSpan<const SkGlyph* const> glyphs, SkExecutor* executor) {
+    if (fMaskFilter) {
+        for (const SkGlyph* glyph : glyphs) {
+            this->getImage(*glyph);
+        }
+        return;
+    }
+    if (!fGenerateImageFromPath) {
+        this->generateImages(glyphs);
+        return;
+    }
+
+    // Only this thread may use the context to make paths, but any thread can scan convert them.
+    const int count = SkToInt(glyphs.size());
+    SkAutoTArray<SkPath> paths(count);
+    SkTDArray<int> fromPath;
+    fromPath.setReserve(count);
+    for (int i = 0; i < count; ++i) {
+        if (this->internalGetPath(glyphs[i]->getPackedID(), &paths[i])) {
+            // DAA would have over coverage issues with small stroke_and_fill (crbug.com/821353)
+            SkPathPriv::SetIsBadForDAA(paths[i], fRec.fFrameWidth > 0 && fRec.fFrameWidth <= 2);
+            fromPath.push_back(i);
+        } else {
+            this->generateImage(*glyphs[i]);
+        }
+    }
+
+    constexpr int kMaxBands = 32;
+    const int bands = SkTMin(fromPath.count(), kMaxBands);
+    auto draw_band = [&](int band) {
+        for (int j = fromPath.count() * band / bands; j < fromPath.count() * (band + 1) / bands;
+             ++j) {
+            const SkGlyph& glyph = *glyphs[fromPath[j]];
+            SkASSERT(SkMask::kARGB32_Format != glyph.fMaskFormat);
+            SkMask mask;
+            glyph.toMask(&mask);
+            generateMask(mask, paths[fromPath[j]], fPreBlend);
+        }
+    };
+    if (executor && bands > 1) {
+        SkTaskGroup tg(*executor);
+        tg.batch(bands, draw_band);
+        tg.wait();
+    } else {
+        for (int band = 0; band < bands; ++band) {
+            draw_band(band);
+        }
+    }
+}
+
+void SkScalerContext::generateImages(SkSpan<const SkGlyph* const> glyphs) {
+    for (const SkGlyph* glyph : glyphs) {
+        this->generateImage(*glyph);
+    }
+}
+
 bool SkScalerContext::getPath(SkPackedGlyphID glyphID, SkPath* path) {
     return this->internalGetPath(glyphID, path);
 }
@@ -584,9 +643,33 @@ void SkScalerContext::getFontMetrics(SkFontMetrics* fm) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+bool SkScalerContext::generateSharedPath(SkGlyphID glyphID, SkPath* path) {
+    if (this->outlinesScaleLinearly() && fRec.getHinting() == kNo_SkFontHinting &&
+        !(fRec.fFlags & kEmbolden_Flag))
+    {
+        SkGlyphOutlineCache::Outline outline;
+        if (SkGlyphOutlineCache::Global()->findOutline(*fTypeface, glyphID, &outline)) {
+            if (!outline.fHasPath) {
+                path->reset();
+                return false;
+            }
+            SkMatrix matrix;
+            fRec.getSingleMatrix(&matrix);
+            matrix.preScale(SK_Scalar1 / outline.fUnitsPerEm, SK_Scalar1 / outline.fUnitsPerEm);
+            if (matrix.isIdentity()) {
+                *path = outline.fPath;
+            } else {
+                outline.fPath.transform(matrix, path);
+            }
+            return true;
+        }
+    }
+    return this->generatePath(glyphID, path);
+}
+
 bool SkScalerContext::internalGetPath(SkPackedGlyphID glyphID, SkPath* devPath) {
     SkPath  path;
-    if (!generatePath(glyphID.code(), &path)) {
+    if (!this->generateSharedPath(glyphID.code(), &path)) {
         return false;
     }
 
@@ -1072,11 +1155,12 @@ void SkScalerContext::MakeRecAndEffects(const SkFont& font, const SkPaint& paint
 }
 
 SkDescriptor* SkScalerContext::MakeDescriptorForPaths(SkFontID typefaceID,
-                                                      SkAutoDescriptor* ad) {
+                                                      SkAutoDescriptor* ad,
+                                                      SkScalar textSize) {
     SkScalerContextRec rec;
     memset(&rec, 0, sizeof(rec));
     rec.fFontID = typefaceID;
-    rec.fTextSize = SkFontPriv::kCanonicalTextSizeForPaths;
+    rec.fTextSize = textSize;
     rec.fPreScaleX = rec.fPost2x2[0][0] = rec.fPost2x2[1][1] = SK_Scalar1;
     return AutoDescriptorGivenRecAndEffects(rec, SkScalerContextEffects(), ad);
 }
@@ -11,6 +11,7 @@
 #include <memory>
 
 #include "SkFont.h"
+#include "SkFontPriv.h"
 #include "SkFontTypes.h"
 #include "SkGlyph.h"
 #include "SkMacros.h"
@@ -19,6 +20,7 @@
 #include "SkMaskGamma.h"
 #include "SkMatrix.h"
 #include "SkPaint.h"
+#include "SkSpan.h"
 #include "SkStrikeInterface.h"
 #include "SkSurfacePriv.h"
 #include "SkTypeface.h"
@@ -26,6 +28,7 @@
 
 class SkAutoDescriptor;
 class SkDescriptor;
+class SkExecutor;
 class SkMaskFilter;
 class SkPathEffect;
 class SkScalerContext;
@@ -279,6 +282,11 @@ public:
     void        getAdvance(SkGlyph*);
     void        getMetrics(SkGlyph*);
     void        getImage(const SkGlyph&);
+    /** Generates the images of glyphs, as getImage would one at a time. Each glyph's fImage
+     *  must already be allocated. Glyphs drawn from their paths are scan converted across
+     *  executor, if there is one.
+     */
+    void        getImages(SkSpan<const SkGlyph* const> glyphs, SkExecutor* executor = nullptr);
     bool SK_WARN_UNUSED_RESULT getPath(SkPackedGlyphID, SkPath*);
     void        getFontMetrics(SkFontMetrics*);
 
@@ -313,7 +321,9 @@ public:
     }
 
     static SkDescriptor*  MakeDescriptorForPaths(SkFontID fontID,
-                                                 SkAutoDescriptor* ad);
+                                                 SkAutoDescriptor* ad,
+                                                 SkScalar textSize =
+                                                        SkFontPriv::kCanonicalTextSizeForPaths);
 
     static SkDescriptor* AutoDescriptorGivenRecAndEffects(
         const SkScalerContextRec& rec,
@@ -375,6 +385,11 @@ protected:
      */
     virtual void generateImage(const SkGlyph& glyph) = 0;
 
+    /** Generates the contents of each glyph's fImage, as generateImage does for one glyph.
+     *  Override to share setup across the glyphs.
+     */
+    virtual void generateImages(SkSpan<const SkGlyph* const> glyphs);
+
     /** Sets the passed path to the glyph outline.
      *  If this cannot be done the path is set to empty;
      *  @return false if this glyph does not have any path.
@@ -392,10 +407,17 @@ protected:
      */
     virtual uint16_t generateCharToGlyph(SkUnichar unichar) = 0;
 
+    /** Returns true if, when unhinted and not emboldened, generatePath() is the typeface's
+     *  outline at its units per em mapped by the rec's matrix, so its paths can be made from the
+     *  outlines in SkGlyphOutlineCache instead.
+     */
+    virtual bool outlinesScaleLinearly() const { return false; }
+
     void forceGenerateImageFromPath() { fGenerateImageFromPath = true; }
     void forceOffGenerateImageFromPath() { fGenerateImageFromPath = false; }
 
 private:
+    friend class SkGlyphOutlineCache;   // To generate outlines.
     friend class SkRandomScalerContext; // For debug purposes
 
     static SkScalerContextRec PreprocessRec(const SkTypeface& typeface,
@@ -416,6 +438,9 @@ private:
     /** Returns false if the glyph has no path at all. */
     bool internalGetPath(SkPackedGlyphID id, SkPath* devPath);
 
+    /** Same as generatePath, but from SkGlyphOutlineCache when outlinesScaleLinearly(). */
+    bool generateSharedPath(SkGlyphID glyphID, SkPath* path);
+
     // SkMaskGamma::PreBlend converts linear masks to gamma correcting masks.
 protected:
     // Visible to subclasses so that generateImage can apply the pre-blend directly.
@@ -79,6 +79,12 @@ void SkScan::FillIRect(const SkIRect& r, const SkRasterClip& clip,
         return;
     }
 
+    // Rects inside an antialiased clip's opaque interior don't need its coverage.
+    if (clip.quickContains(r)) {
+        FillIRect(r, nullptr, blitter);
+        return;
+    }
+
     SkAAClipBlitterWrapper wrapper(clip, blitter);
     FillIRect(r, &wrapper.getRgn(), wrapper.getBlitter());
 }
@@ -94,8 +100,9 @@ void SkScan::FillXRect(const SkXRect& xr, const SkRasterClip& clip,
         return;
     }
 
-    SkAAClipBlitterWrapper wrapper(clip, blitter);
-    FillXRect(xr, &wrapper.getRgn(), wrapper.getBlitter());
+    SkIRect r;
+    XRect_round(xr, &r);
+    FillIRect(r, clip, blitter);
 }
 
 void SkScan::FillRect(const SkRect& r, const SkRasterClip& clip,
@@ -109,6 +116,7 @@ void SkScan::FillRect(const SkRect& r, const SkRasterClip& clip,
         return;
     }
 
-    SkAAClipBlitterWrapper wrapper(clip, blitter);
-    FillRect(r, &wrapper.getRgn(), wrapper.getBlitter());
+    SkIRect ir;
+    r.round(&ir);
+    FillIRect(ir, clip, blitter);
 }
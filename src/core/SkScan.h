@@ -14,6 +14,7 @@
 #include "SkRect.h"
 #include <atomic>
 
+class SkPaint;
 class SkRasterClip;
 class SkRegion;
 class SkBlitter;
@@ -70,6 +71,24 @@ public:
     static void HairRoundPath(const SkPath&, const SkRasterClip&, SkBlitter*);
     static void AntiHairRoundPath(const SkPath&, const SkRasterClip&, SkBlitter*);
 
+    // Strokes no wider than this, in device space, may be drawn by AntiStrokeThinPath().
+    static constexpr SkScalar kMaxThinStrokeWidth = 2;
+
+    // A dash pattern for AntiStrokeThinPath(), like SkPathEffect::DashInfo.
+    struct ThinDash {
+        const SkScalar* fIntervals;
+        int             fCount;
+        SkScalar        fPhase;
+        SkScalar        fScale;     // Device space length of one unit of the intervals.
+    };
+
+    // Draws devPath stroked with paint's cap and join, devWidth wide and optionally dashed,
+    // without building the stroke's outline. Returns false, drawing nothing, if devPath's joins
+    // aren't close enough to round.
+    static bool AntiStrokeThinPath(const SkPath& devPath, SkScalar devWidth, const SkPaint&,
+                                   const SkRasterClip&, SkBlitter*,
+                                   const ThinDash* dash = nullptr);
+
     // Needed by do_fill_path in SkScanPriv.h
     static void FillPath(const SkPath&, const SkRegion& clip, SkBlitter*);
 
@@ -77,6 +96,12 @@ public:
     static void AntiFillPath(const SkPath& path, const SkRasterClip& rc, SkBlitter* blitter) {
         AntiFillPath(path, rc, blitter, nullptr);
     }
+
+    // Returns true if AntiFillPath() would scan convert this (non-inverse) device space path
+    // with DAA when clipped to clipBounds. Its SkDAARecord can then be computed ahead of time,
+    // by calling AntiFillPath() with a null blitter, and blitted in pieces later.
+    static bool ShouldUseDAA(const SkPath& devPath, const SkIRect& clipBounds);
+
 private:
     friend class SkAAClip;
     friend class SkRegion;
@@ -758,6 +758,20 @@ static int rect_overflows_short_shift(SkIRect rect, int shift) {
            overflows_short_shift(rect.fBottom, shift);
 }
 
+bool SkScan::ShouldUseDAA(const SkPath& path, const SkIRect& clipBounds) {
+    // Mirrors the choices AntiFillPath() makes before it picks a scan converter.
+    SkIRect clippedIR;
+    if (path.isInverseFillType() ||
+        !clippedIR.intersect(safeRoundOut(path.getBounds()), clipBounds) ||
+        rect_overflows_short_shift(clippedIR, SHIFT)) {
+        return false;
+    }
+
+    SkScalar avgLength, complexity;
+    compute_complexity(path, avgLength, complexity);
+    return ::ShouldUseDAA(path, avgLength, complexity);
+}
+
 void SkScan::AntiFillPath(const SkPath& path, const SkRegion& origClip,
                           SkBlitter* blitter, bool forceRLE, SkDAARecord* daaRecord) {
     if (origClip.isEmpty()) {
@@ -836,7 +850,7 @@ void SkScan::AntiFillPath(const SkPath& path, const SkRegion& origClip,
     SkScalar avgLength, complexity;
     compute_complexity(path, avgLength, complexity);
 
-    if (daaRecord || ShouldUseDAA(path, avgLength, complexity)) {
+    if (daaRecord || ::ShouldUseDAA(path, avgLength, complexity)) {
         SkScan::DAAFillPath(path, blitter, ir, clipRgn->getBounds(), forceRLE, daaRecord);
     } else if (ShouldUseAAA(path, avgLength, complexity)) {
         // Do not use AAA if path is too complicated:
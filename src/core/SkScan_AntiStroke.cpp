@@ -0,0 +1,502 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkScan.h"
+#include "SkBlitter.h"
+#include "SkDashPathPriv.h"
+#include "SkGeometry.h"
+#include "SkMask.h"
+#include "SkPaint.h"
+#include "SkPath.h"
+#include "SkRasterClip.h"
+#include "SkScanPriv.h"
+#include "SkTDArray.h"
+#include "SkTSort.h"
+#include "SkTemplates.h"
+
+/*  Thin strokes are drawn straight from the device space path, without building an outline for
+    SkScan::AntiFillPath(). Curves are flattened into polylines, and dashes are stepped along
+    those, so dashing doesn't build an intermediate path either. Every pixel takes the largest coverage any segment gives it. A
+    segment's coverage is the 1D box filtered coverage across its width, times the coverage along
+    its length at butt ends. Past a segment's other ends it's the coverage at the distance to the
+    end point, which makes round joins and caps.
+
+    Other joins are only drawn this way while they're within kJoinTolerance of a round join.
+*/
+
+static constexpr SkScalar kJoinTolerance = 0.5f;
+
+// Curves are flattened into chords no further than this from them.
+static constexpr SkScalar kFlattenTolerance = 0.1f;
+static constexpr int kMaxFlattenCount = 1 << 10;
+
+namespace {
+
+struct ThinSegment {
+    SkPoint  fP0, fP1;
+    SkVector fDir;      // unit length, from fP0 to fP1
+    SkScalar fLength;
+    SkScalar fTop, fBottom;  // y extent of the pixel centers it may cover
+    bool     fButtStart, fButtEnd;
+
+    bool operator<(const ThinSegment& that) const { return fTop < that.fTop; }
+};
+
+}  // namespace
+
+// Coverage of a pixel whose center is d from the middle of a span of half width r.
+static inline float span_coverage(float d, float r) {
+    return SkTPin(SkTMin(d + 0.5f, r) - SkTMax(d - 0.5f, -r), 0.0f, 1.0f);
+}
+
+static float segment_coverage(const ThinSegment& seg, SkPoint center, SkScalar radius) {
+    SkVector v = center - seg.fP0;
+    SkScalar t = v.dot(seg.fDir);
+    if (t < 0 && !seg.fButtStart) {
+        return span_coverage(v.length(), radius);
+    }
+    if (t > seg.fLength && !seg.fButtEnd) {
+        return span_coverage(SkPoint::Distance(center, seg.fP1), radius);
+    }
+    float coverage = span_coverage(v.cross(seg.fDir), radius);
+    if (seg.fButtStart) {
+        coverage *= SkTPin(t + 0.5f, 0.0f, 1.0f);
+    }
+    if (seg.fButtEnd) {
+        coverage *= SkTPin(seg.fLength - t + 0.5f, 0.0f, 1.0f);
+    }
+    return coverage;
+}
+
+// Can the join turning from u to v be drawn as a round join?
+static bool join_is_nearly_round(const SkVector& u, const SkVector& v, SkScalar radius,
+                                 const SkPaint& paint) {
+    if (paint.getStrokeJoin() == SkPaint::kRound_Join) {
+        return true;
+    }
+    // The cosine of half the angle turned.
+    SkScalar halfCos = SkScalarSqrt(SkTMax(0.0f, (1 + u.dot(v)) * 0.5f));
+    SkScalar bevelGap = radius * (1 - halfCos);
+    if (paint.getStrokeJoin() == SkPaint::kMiter_Join && halfCos * paint.getStrokeMiter() >= 1) {
+        // The miter's tip sticks out radius / halfCos - radius past the round join.
+        return bevelGap <= kJoinTolerance * halfCos;
+    }
+    return bevelGap <= kJoinTolerance;
+}
+
+static void flatten_quad(const SkPoint pts[3], SkTDArray<SkPoint>* dst) {
+    // Chords of 1/n of the quad stray up to |p0 - 2p1 + p2| / (4n^2) from it.
+    SkScalar dd = (pts[0] - pts[1] - pts[1] + pts[2]).length();
+    int n = SkTPin(SkScalarCeilToInt(SkScalarSqrt(dd / (4 * kFlattenTolerance))),
+                   1, kMaxFlattenCount);
+    for (int i = 1; i < n; ++i) {
+        *dst->append() = SkEvalQuadAt(pts, (SkScalar)i / n);
+    }
+    *dst->append() = pts[2];
+}
+
+static void flatten_conic(const SkPoint pts[3], SkScalar weight, SkTDArray<SkPoint>* dst) {
+    SkAutoConicToQuads quadder;
+    const SkPoint* quads = quadder.computeQuads(pts, weight, kFlattenTolerance);
+    for (int i = 0; i < quadder.countQuads(); ++i) {
+        flatten_quad(quads + 2 * i, dst);
+    }
+}
+
+static void flatten_cubic(const SkPoint pts[4], SkTDArray<SkPoint>* dst) {
+    // Chords of 1/n of the cubic stray up to 3/4 its largest second difference / n^2 from it.
+    SkScalar dd = SkTMax((pts[0] - pts[1] - pts[1] + pts[2]).length(),
+                         (pts[1] - pts[2] - pts[2] + pts[3]).length());
+    int n = SkTPin(SkScalarCeilToInt(SkScalarSqrt(3 * dd / (4 * kFlattenTolerance))),
+                   1, kMaxFlattenCount);
+    for (int i = 1; i < n; ++i) {
+        SkEvalCubicAt(pts, (SkScalar)i / n, dst->append(), nullptr, nullptr);
+    }
+    *dst->append() = pts[3];
+}
+
+static void remove_repeated_points(SkTDArray<SkPoint>* pts) {
+    int kept = SkTMin(pts->count(), 1);
+    for (int i = 1; i < pts->count(); ++i) {
+        if ((*pts)[i] != (*pts)[kept - 1]) {
+            (*pts)[kept++] = (*pts)[i];
+        }
+    }
+    pts->setCount(kept);
+}
+
+namespace {
+
+// Flattens and dashes a device space path into the ThinSegments that draw its stroke.
+class ThinStrokeBuilder {
+public:
+    ThinStrokeBuilder(SkScalar radius, const SkPaint& paint, const SkRect& cull)
+        : fRadius(radius)
+        , fPaint(paint)
+        , fCull(cull) {}
+
+    // Returns false if path can't be drawn as a thin stroke.
+    bool addPath(const SkPath& path, const SkScan::ThinDash* dash);
+
+    SkTDArray<ThinSegment>* segments() { return &fSegments; }
+
+private:
+    bool addContour(SkTDArray<SkPoint>* pts, bool closed, bool sawLine);
+
+    // Follows SkDashPath::InternalFilter().
+    bool addDashes(const SkTDArray<SkPoint>& pts, bool closed);
+
+    // Appends the segments of the polyline through pts, with caps unless it's closed. A single
+    // point is a zero length dash along tangent.
+    bool addPolyline(const SkPoint pts[], int count, bool closed, const SkVector& tangent);
+
+    const SkScalar              fRadius;
+    const SkPaint&              fPaint;
+    const SkRect                fCull;
+    SkTDArray<ThinSegment>      fSegments;
+
+    // The dash pattern, scaled to device space, if any.
+    SkTDArray<SkScalar>         fIntervals;
+    SkScalar                    fInitialDashLength = 0;
+    int32_t                     fInitialDashIndex = 0;
+    SkScalar                    fIntervalLength = 0;
+    double                      fDashCount = 0;
+};
+
+}  // namespace
+
+bool ThinStrokeBuilder::addPath(const SkPath& path, const SkScan::ThinDash* dash) {
+    if (dash) {
+        if (!SkDashPath::ValidDashPath(dash->fPhase, dash->fIntervals, dash->fCount)) {
+            return false;
+        }
+        SkScalar phase = dash->fPhase;
+        SkDashPath::CalcDashParameters(phase, dash->fIntervals, dash->fCount,
+                                       &fInitialDashLength, &fInitialDashIndex,
+                                       &fIntervalLength, &phase);
+        fIntervals.setCount(dash->fCount);
+        for (int i = 0; i < dash->fCount; ++i) {
+            fIntervals[i] = dash->fIntervals[i] * dash->fScale;
+        }
+        fInitialDashLength *= dash->fScale;
+        fIntervalLength *= dash->fScale;
+    }
+
+    SkPath::Iter iter(path, false);
+    SkTDArray<SkPoint> pts;
+    bool closed = false;
+    bool sawLine = false;
+    SkPoint p[4];
+    for (;;) {
+        SkPath::Verb verb = iter.next(p, false);
+        switch (verb) {
+            case SkPath::kMove_Verb:
+            case SkPath::kDone_Verb:
+                if (!pts.isEmpty() && !this->addContour(&pts, closed, sawLine)) {
+                    return false;
+                }
+                if (SkPath::kDone_Verb == verb) {
+                    return true;
+                }
+                pts.rewind();
+                *pts.append() = p[0];
+                closed = sawLine = false;
+                break;
+            case SkPath::kLine_Verb:
+                *pts.append() = p[1];
+                sawLine = true;
+                break;
+            case SkPath::kQuad_Verb:
+                flatten_quad(p, &pts);
+                sawLine = true;
+                break;
+            case SkPath::kConic_Verb:
+                flatten_conic(p, iter.conicWeight(), &pts);
+                sawLine = true;
+                break;
+            case SkPath::kCubic_Verb:
+                flatten_cubic(p, &pts);
+                sawLine = true;
+                break;
+            case SkPath::kClose_Verb:
+                closed = true;
+                break;
+        }
+    }
+}
+
+bool ThinStrokeBuilder::addContour(SkTDArray<SkPoint>* pts, bool closed, bool sawLine) {
+    remove_repeated_points(pts);
+    if (closed && pts->count() > 1 && pts->top() == (*pts)[0]) {
+        pts->pop();
+    }
+    if (!fIntervals.isEmpty()) {
+        return this->addDashes(*pts, closed);
+    }
+    if (pts->count() < 2) {
+        // Empty contours draw nothing, but zero length lines may draw caps.
+        return !sawLine;
+    }
+    return this->addPolyline(pts->begin(), pts->count(), closed, {0, 0});
+}
+
+bool ThinStrokeBuilder::addDashes(const SkTDArray<SkPoint>& pts, bool closed) {
+    SkTDArray<SkPoint> verts(pts);
+    if (closed) {
+        *verts.append() = pts[0];
+    }
+    if (verts.count() < 2) {
+        return true;  // Zero length contours have no dashes.
+    }
+    int last = verts.count() - 1;
+    SkTDArray<double> distances;
+    distances.setCount(verts.count());
+    distances[0] = 0;
+    for (int i = 0; i < last; ++i) {
+        distances[i + 1] = distances[i] + SkPoint::Distance(verts[i], verts[i + 1]);
+    }
+    double length = distances[last];
+
+    fDashCount += length * (fIntervals.count() >> 1) / fIntervalLength;
+    if (fDashCount > SkDashPath::kMaxDashCount) {
+        return false;
+    }
+
+    // Appends the points between start and stop to piece, returning the tangent at start.
+    SkTDArray<SkPoint> piece;
+    int cursor = 0;
+    auto appendPiece = [&](double start, double stop) {
+        auto pointAt = [&](double d, int i) {
+            double segmentLength = distances[i + 1] - distances[i];
+            SkScalar t = segmentLength > 0
+                       ? SkDoubleToScalar(SkTPin((d - distances[i]) / segmentLength, 0.0, 1.0))
+                       : 0;
+            return verts[i] + (verts[i + 1] - verts[i]) * t;
+        };
+        while (cursor < last - 1 && distances[cursor + 1] < start) {
+            ++cursor;
+        }
+        *piece.append() = pointAt(start, cursor);
+        SkVector tangent = verts[cursor + 1] - verts[cursor];
+        int i = cursor;
+        for (; i < last - 1 && distances[i + 1] < stop; ++i) {
+            *piece.append() = verts[i + 1];
+        }
+        *piece.append() = pointAt(stop, i);
+        return tangent;
+    };
+    SkVector tangent;
+    auto addPiece = [&]() {
+        remove_repeated_points(&piece);
+        SkRect bounds;
+        bounds.setBounds(piece.begin(), piece.count());
+        bounds.outset(fRadius + 1, fRadius + 1);
+        return !bounds.intersects(fCull) ||
+               this->addPolyline(piece.begin(), piece.count(), false, tangent);
+    };
+
+    // A closed contour's first dash is drawn last, joined to the last dash if that reaches the
+    // end of the contour.
+    bool joinFirstDash = closed && SkIsAlign2(fInitialDashIndex) && fInitialDashLength >= 0;
+    bool skipFirstDash = closed;
+    bool addedDash = false;
+    int index = fInitialDashIndex;
+    double distance = 0,
+           dashLength = fInitialDashLength;
+    while (distance < length) {
+        addedDash = false;
+        if (SkIsAlign2(index) && !skipFirstDash) {
+            addedDash = true;
+            piece.rewind();
+            tangent = appendPiece(distance, SkTMin(distance + dashLength, length));
+            if (!(joinFirstDash && distance + dashLength >= length) && !addPiece()) {
+                return false;
+            }
+        }
+        distance += dashLength;
+        skipFirstDash = false;
+        index = (index + 1) % fIntervals.count();
+        dashLength = fIntervals[index];
+    }
+    if (joinFirstDash) {
+        if (addedDash) {
+            piece.pop();  // The first dash starts exactly where this one ends.
+        } else {
+            piece.rewind();
+        }
+        cursor = 0;
+        SkVector firstTangent = appendPiece(0, SkTMin<double>(fInitialDashLength, length));
+        if (!addedDash) {
+            tangent = firstTangent;
+        }
+        return addPiece();
+    }
+    return true;
+}
+
+bool ThinStrokeBuilder::addPolyline(const SkPoint pts[], int count, bool closed,
+                                    const SkVector& tangent) {
+    SkASSERT(count > 0);
+    int first = fSegments.count();
+    if (1 == count) {
+        if (SkPaint::kButt_Cap == fPaint.getStrokeCap()) {
+            return true;  // Zero length dashes only draw caps.
+        }
+        ThinSegment* seg = fSegments.append();
+        seg->fP0 = seg->fP1 = pts[0];
+        seg->fDir = tangent;
+        seg->fLength = 0;
+        seg->fButtStart = seg->fButtEnd = false;
+        if (!seg->fDir.normalize()) {
+            return false;
+        }
+    } else {
+        int segmentCount = closed ? count : count - 1;
+        for (int i = 0; i < segmentCount; ++i) {
+            ThinSegment* seg = fSegments.append();
+            seg->fP0 = pts[i];
+            seg->fP1 = pts[(i + 1) % count];
+            seg->fDir = seg->fP1 - seg->fP0;
+            seg->fLength = seg->fDir.length();
+            seg->fButtStart = seg->fButtEnd = false;
+            if (!seg->fDir.normalize()) {
+                return false;
+            }
+            if (i > 0 && !join_is_nearly_round(seg[-1].fDir, seg->fDir, fRadius, fPaint)) {
+                return false;
+            }
+        }
+    }
+    ThinSegment& head = fSegments[first];
+    ThinSegment& tail = fSegments.top();
+    if (closed) {
+        return join_is_nearly_round(tail.fDir, head.fDir, fRadius, fPaint);
+    }
+    switch (fPaint.getStrokeCap()) {
+        case SkPaint::kSquare_Cap:
+            head.fP0 -= head.fDir * fRadius;
+            tail.fP1 += tail.fDir * fRadius;
+            // Both ends move out when head and tail are the same segment.
+            head.fLength = SkPoint::Distance(head.fP0, head.fP1);
+            tail.fLength = SkPoint::Distance(tail.fP0, tail.fP1);
+            // fall through
+        case SkPaint::kButt_Cap:
+            head.fButtStart = true;
+            tail.fButtEnd = true;
+            break;
+        default:
+            break;
+    }
+    return true;
+}
+
+bool SkScan::AntiStrokeThinPath(const SkPath& devPath, SkScalar devWidth, const SkPaint& paint,
+                                const SkRasterClip& clip, SkBlitter* blitter,
+                                const ThinDash* dash) {
+    if (!(devWidth > 0 && devWidth <= kMaxThinStrokeWidth) || devPath.isInverseFillType()) {
+        return false;
+    }
+    SkScalar radius = SkScalarHalf(devWidth);
+    ThinStrokeBuilder builder(radius, paint, SkRect::Make(clip.getBounds()));
+    if (!builder.addPath(devPath, dash)) {
+        return false;
+    }
+    SkTDArray<ThinSegment>& segments = *builder.segments();
+    if (segments.isEmpty()) {
+        return true;
+    }
+
+    // Pixels whose centers are further than this from a segment get no coverage from it.
+    const SkScalar reach = radius + 0.5f;
+    SkRect bounds = SkRect::MakeEmpty();
+    for (ThinSegment& seg : segments) {
+        seg.fTop = SkTMin(seg.fP0.fY, seg.fP1.fY) - reach;
+        seg.fBottom = SkTMax(seg.fP0.fY, seg.fP1.fY) + reach;
+        bounds.join({SkTMin(seg.fP0.fX, seg.fP1.fX) - reach, seg.fTop,
+                     SkTMax(seg.fP0.fX, seg.fP1.fX) + reach, seg.fBottom});
+    }
+    SkIRect ir = bounds.roundOut();
+    if (!ir.intersect(clip.getBounds())) {
+        return true;
+    }
+
+    SkAAClipBlitterWrapper wrapper;
+    const SkRegion* clipRgn;
+    if (clip.isBW()) {
+        clipRgn = &clip.bwRgn();
+    } else {
+        wrapper.init(clip, blitter);
+        clipRgn = &wrapper.getRgn();
+        blitter = wrapper.getBlitter();
+    }
+    SkScanClipper clipper(blitter, clipRgn, ir);
+    blitter = clipper.getBlitter();
+    if (!blitter) {
+        return true;
+    }
+
+    SkTQSort(segments.begin(), segments.end() - 1);
+    SkTDArray<const ThinSegment*> active;
+    int nextSegment = 0;
+
+    SkAutoTMalloc<SkAlpha> row(ir.width());
+    sk_bzero(row.get(), ir.width());
+    for (int y = ir.fTop; y < ir.fBottom; ++y) {
+        SkScalar cy = y + 0.5f;
+        while (nextSegment < segments.count() && segments[nextSegment].fTop <= cy) {
+            *active.append() = &segments[nextSegment++];
+        }
+
+        int left = ir.fRight,
+            right = ir.fLeft - 1;
+        int kept = 0;
+        for (const ThinSegment* seg : active) {
+            if (seg->fBottom < cy) {
+                continue;
+            }
+            active[kept++] = seg;
+
+            // The segment's x extent between cy - reach and cy + reach, outset by reach.
+            SkScalar x0 = seg->fP0.fX,
+                     x1 = seg->fP1.fX;
+            if (seg->fDir.fY != 0) {
+                SkScalar dxdy = seg->fDir.fX / seg->fDir.fY;
+                SkScalar y0 = SkTPin(cy - reach, SkTMin(seg->fP0.fY, seg->fP1.fY),
+                                                 SkTMax(seg->fP0.fY, seg->fP1.fY)),
+                         y1 = SkTPin(cy + reach, SkTMin(seg->fP0.fY, seg->fP1.fY),
+                                                 SkTMax(seg->fP0.fY, seg->fP1.fY));
+                x0 = seg->fP0.fX + (y0 - seg->fP0.fY) * dxdy;
+                x1 = seg->fP0.fX + (y1 - seg->fP0.fY) * dxdy;
+            }
+            int l = SkTMax(ir.fLeft, SkScalarFloorToInt(SkTMin(x0, x1) - reach)),
+                r = SkTMin(ir.fRight - 1, SkScalarFloorToInt(SkTMax(x0, x1) + reach));
+            if (l > r) {
+                continue;
+            }
+            for (int x = l; x <= r; ++x) {
+                float coverage = segment_coverage(*seg, {x + 0.5f, cy}, radius);
+                SkAlpha alpha = SkToU8(SkScalarRoundToInt(coverage * 255));
+                SkAlpha& dst = row[x - ir.fLeft];
+                dst = SkTMax(dst, alpha);
+            }
+            left = SkTMin(left, l);
+            right = SkTMax(right, r);
+        }
+        active.setCount(kept);
+
+        if (left <= right) {
+            SkMask mask;
+            mask.fImage = &row[left - ir.fLeft];
+            mask.fBounds.set(left, y, right + 1, y + 1);
+            mask.fRowBytes = SkToU32(ir.width());
+            mask.fFormat = SkMask::kA8_Format;
+            blitter->blitMask(mask, mask.fBounds);
+            sk_bzero(mask.fImage, right + 1 - left);
+        }
+    }
+    return true;
+}
@@ -808,6 +808,8 @@ void SkScan::AntiFillRect(const SkRect& r, const SkRasterClip& clip,
                           SkBlitter* blitter) {
     if (clip.isBW()) {
         AntiFillRect(r, &clip.bwRgn(), blitter);
+    } else if (clip.quickContains(r.roundOut())) {
+        AntiFillRect(r, nullptr, blitter);
     } else {
         SkAAClipBlitterWrapper wrap(clip, blitter);
         AntiFillRect(r, &wrap.getRgn(), wrap.getBlitter());
@@ -150,6 +150,10 @@ bool SkWStream::writeStream(SkStream* stream, size_t length) {
     return true;
 }
 
+bool SkWStream::writeData(sk_sp<SkData> data) {
+    return !data || this->write(data->data(), data->size());
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 SkFILEStream::SkFILEStream(std::shared_ptr<FILE> file, size_t size,
@@ -879,6 +883,145 @@ std::unique_ptr<SkStreamAsset> SkDynamicMemoryWStream::detachAsStream() {
     return stream;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define SkDataListWStream_MinBlockSize   4096
+
+// Segments cut from a block share it, each holding a ref until its SkData is released.
+struct SkDataListWStream::Block : public SkNVRefCnt<Block> {
+    explicit Block(size_t size) : fStorage(size), fSize(size) {}
+
+    SkAutoTMalloc<char> fStorage;
+    const size_t        fSize;
+};
+
+constexpr size_t SkDataListWStream::kMinAdoptBytes;
+
+SkDataListWStream::SkDataListWStream() {}
+
+SkDataListWStream::SkDataListWStream(SkDataListWStream&& other)
+    : fSegments(std::move(other.fSegments))
+    , fBlock(other.fBlock)
+    , fBlockStart(other.fBlockStart)
+    , fBlockUsed(other.fBlockUsed)
+    , fBytesWritten(other.fBytesWritten)
+{
+    other.fBlock = nullptr;
+    other.fBlockStart = other.fBlockUsed = other.fBytesWritten = 0;
+}
+
+SkDataListWStream& SkDataListWStream::operator=(SkDataListWStream&& other) {
+    if (this != &other) {
+        this->~SkDataListWStream();
+        new (this) SkDataListWStream(std::move(other));
+    }
+    return *this;
+}
+
+SkDataListWStream::~SkDataListWStream() {
+    this->reset();
+}
+
+void SkDataListWStream::reset() {
+    fSegments.reset();
+    SkSafeUnref(fBlock);
+    fBlock = nullptr;
+    fBlockStart = fBlockUsed = fBytesWritten = 0;
+}
+
+void SkDataListWStream::cutBlockSegment() {
+    if (fBlockUsed > fBlockStart) {
+        fSegments.push_back(SkData::MakeWithProc(fBlock->fStorage.get() + fBlockStart,
+                                                 fBlockUsed - fBlockStart,
+                                                 [](const void*, void* ctx) {
+                                                     static_cast<Block*>(ctx)->unref();
+                                                 },
+                                                 SkRef(fBlock)));
+        fBlockStart = fBlockUsed;
+    }
+}
+
+bool SkDataListWStream::write(const void* buffer, size_t size) {
+    auto src = static_cast<const char*>(buffer);
+    fBytesWritten += size;
+    while (size > 0) {
+        if (!fBlock || fBlockUsed == fBlock->fSize) {
+            this->cutBlockSegment();
+            SkSafeUnref(fBlock);
+            fBlock = new Block(SkTMax<size_t>(size, SkDataListWStream_MinBlockSize));
+            fBlockStart = fBlockUsed = 0;
+        }
+        size_t n = SkTMin(size, fBlock->fSize - fBlockUsed);
+        memcpy(fBlock->fStorage.get() + fBlockUsed, src, n);
+        fBlockUsed += n;
+        src  += n;
+        size -= n;
+    }
+    return true;
+}
+
+bool SkDataListWStream::writeData(sk_sp<SkData> data) {
+    if (!data || data->size() < kMinAdoptBytes) {
+        return this->INHERITED::writeData(std::move(data));
+    }
+    // Later small writes carry on filling the rest of fBlock.
+    this->cutBlockSegment();
+    fBytesWritten += data->size();
+    fSegments.push_back(std::move(data));
+    return true;
+}
+
+int SkDataListWStream::segmentCount() const {
+    return fSegments.count() + (fBlockUsed > fBlockStart ? 1 : 0);
+}
+
+void SkDataListWStream::getSegments(Segment segments[]) const {
+    for (const sk_sp<SkData>& data : fSegments) {
+        *segments++ = { data->data(), data->size() };
+    }
+    if (fBlockUsed > fBlockStart) {
+        *segments = { fBlock->fStorage.get() + fBlockStart, fBlockUsed - fBlockStart };
+    }
+}
+
+void SkDataListWStream::copyTo(void* dst) const {
+    SkASSERT(dst || 0 == fBytesWritten);
+    auto out = static_cast<char*>(dst);
+    for (const sk_sp<SkData>& data : fSegments) {
+        memcpy(out, data->data(), data->size());
+        out += data->size();
+    }
+    if (fBlockUsed > fBlockStart) {
+        memcpy(out, fBlock->fStorage.get() + fBlockStart, fBlockUsed - fBlockStart);
+    }
+}
+
+bool SkDataListWStream::writeToStream(SkWStream* dst) const {
+    SkASSERT(dst);
+    for (const sk_sp<SkData>& data : fSegments) {
+        if (!dst->writeData(data)) {
+            return false;
+        }
+    }
+    return fBlockUsed == fBlockStart ||
+           dst->write(fBlock->fStorage.get() + fBlockStart, fBlockUsed - fBlockStart);
+}
+
+sk_sp<SkData> SkDataListWStream::detachAsData() {
+    this->cutBlockSegment();
+    sk_sp<SkData> data;
+    if (fSegments.count() == 1) {
+        data = std::move(fSegments[0]);
+    } else if (fBytesWritten == 0) {
+        data = SkData::MakeEmpty();
+    } else {
+        data = SkData::MakeUninitialized(fBytesWritten);
+        this->copyTo(data->writable_data());
+    }
+    this->reset();
+    return data;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
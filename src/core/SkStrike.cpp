@@ -9,9 +9,11 @@
 
 #include "SkGraphics.h"
 #include "SkMakeUnique.h"
+#include "SkMetrics.h"
 #include "SkMutex.h"
 #include "SkOnce.h"
 #include "SkPath.h"
+#include "SkTArray.h"
 #include "SkTemplates.h"
 #include "SkTypeface.h"
 #include <cctype>
@@ -89,10 +91,12 @@ void SkStrike::getAdvances(SkSpan<const SkGlyphID> glyphIDs, SkPoint advances[])
 }
 
 SkGlyph* SkStrike::lookupByPackedGlyphID(SkPackedGlyphID packedGlyphID, MetricsType type) {
+    SK_METRIC_COUNT("strike.glyph_lookups", 1);
     SkGlyph* glyphPtr = fGlyphMap.findOrNull(packedGlyphID);
 
     if (glyphPtr == nullptr) {
         // Glyph is not present in the stirke. Make a new glyph and fill it in.
+        SK_METRIC_COUNT("strike.glyph_misses", 1);
 
         fMemoryUsed += sizeof(SkGlyph);
         glyphPtr = fAlloc.make<SkGlyph>(packedGlyphID);
@@ -141,6 +145,25 @@ const void* SkStrike::findImage(const SkGlyph& glyph) {
     return glyph.fImage;
 }
 
+void SkStrike::prepareImages(SkSpan<const SkGlyph* const> glyphs, SkExecutor* executor) {
+    SkSTArray<64, const SkGlyph*> missing;
+    for (const SkGlyph* glyph : glyphs) {
+        if (glyph->fWidth > 0 && glyph->fWidth < kMaxGlyphWidth && nullptr == glyph->fImage) {
+            size_t size = const_cast<SkGlyph*>(glyph)->allocImage(&fAlloc);
+            // check that alloc() actually succeeded
+            if (glyph->fImage) {
+                missing.push_back(glyph);
+                fMemoryUsed += size;
+            }
+        }
+    }
+    if (!missing.empty()) {
+        fScalerContext->getImages(SkSpan<const SkGlyph* const>{missing.begin(),
+                                                               SkTo<size_t>(missing.count())},
+                                  executor);
+    }
+}
+
 void SkStrike::initializeImage(const volatile void* data, size_t size, SkGlyph* glyph) {
     // Don't overwrite the image if we already have one. We could have used a fallback if the
     // glyph was missing earlier.
@@ -179,6 +202,18 @@ const SkPath* SkStrike::findPath(const SkGlyph& glyph) {
     return nullptr;
 }
 
+void SkStrike::initializeSharedImage(const volatile void* data, size_t size, SkGlyph* glyph) {
+    if (glyph->fImage) return;
+
+    if (glyph->fWidth > 0 && glyph->fWidth < kMaxGlyphWidth) {
+        SkASSERT(size == glyph->computeImageSize());
+        // Nothing here writes to glyph images, so dropping const and volatile is safe. Someone
+        // else scribbling on the memory can only garble pixels; sizes all come from the glyph.
+        glyph->fImage = const_cast<void*>(data);
+        fSharedImageBytes += size;
+    }
+}
+
 bool SkStrike::initializePath(SkGlyph* glyph, const volatile void* data, size_t size) {
     // Don't overwrite the path if we already have one. We could have used a fallback if the
     // glyph was missing earlier.
@@ -235,6 +270,17 @@ const SkGlyph& SkStrike::getGlyphMetrics(SkGlyphID glyphID, SkPoint position) {
     }
 }
 
+const SkGlyph* SkStrike::findCachedGlyphMetrics(SkGlyphID glyphID, SkPoint position) const {
+    SkPackedGlyphID packedGlyphID{glyphID};
+    if (fIsSubpixel) {
+        SkIPoint lookupPosition = SkStrikeCommon::SubpixelLookup(fAxisAlignment, position);
+        packedGlyphID = SkPackedGlyphID{glyphID, lookupPosition.x(), lookupPosition.y()};
+    }
+
+    SkGlyph* glyphPtr = fGlyphMap.findOrNull(packedGlyphID);
+    return glyphPtr != nullptr && !glyphPtr->isJustAdvance() ? glyphPtr : nullptr;
+}
+
 // N.B. This glyphMetrics call culls all the glyphs which will not display based on a non-finite
 // position or that there are no mask pixels.
 int SkStrike::glyphMetrics(const SkGlyphID glyphIDs[],
@@ -459,7 +505,7 @@ void SkStrike::forceValidate() const {
             memoryUsed += compute_path_size(glyphPtr->fPathData->fPath);
         }
     });
-    SkASSERT(fMemoryUsed == memoryUsed);
+    SkASSERT(fMemoryUsed + fSharedImageBytes == memoryUsed);
 }
 
 void SkStrike::validate() const {
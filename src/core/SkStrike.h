@@ -14,9 +14,9 @@
 #include "SkGlyph.h"
 #include "SkGlyphRunPainter.h"
 #include "SkPaint.h"
-#include "SkTHash.h"
 #include "SkScalerContext.h"
 #include "SkStrikeInterface.h"
+#include "SkTSwissTable.h"
 #include "SkTemplates.h"
 #include <memory>
 
@@ -73,15 +73,31 @@ public:
     /** Return the number of glyphs currently cached. */
     int countCachedGlyphs() const;
 
+    /** Call fn(const SkGlyph&) on every glyph currently cached. */
+    template <typename Fn>
+    void forEachCachedGlyph(Fn&& fn) const {
+        fGlyphMap.foreach([&fn](const SkGlyph* glyph) { fn(*glyph); });
+    }
+
     /** Return the image associated with the glyph. If it has not been generated this will
         trigger that.
     */
     const void* findImage(const SkGlyph&);
 
+    /** Generates the images of all of glyphs that don't have one yet, together, as findImage
+        would one at a time. Some of the work may be spread across executor, if there is one.
+    */
+    void prepareImages(SkSpan<const SkGlyph* const> glyphs, SkExecutor* executor = nullptr);
+
     /** Initializes the image associated with the glyph with |data|.
      */
     void initializeImage(const volatile void* data, size_t size, SkGlyph*);
 
+    /** Like initializeImage(), but points the glyph at |data| instead of copying it. The strike
+        doesn't own |data|, which must outlive it, and doesn't count it in getMemoryUsed().
+     */
+    void initializeSharedImage(const volatile void* data, size_t size, SkGlyph*);
+
     /** If the advance axis intersects the glyph's path, append the positions scaled and offset
         to the array (if non-null), and set the count to the updated array length.
     */
@@ -126,6 +142,12 @@ public:
 
     const SkGlyph& getGlyphMetrics(SkGlyphID glyphID, SkPoint position) override;
 
+    /** Like getGlyphMetrics(), but only finds glyphs already cached with full metrics, returning
+        nullptr otherwise. This never modifies the strike, so it may run concurrently with other
+        const calls.
+    */
+    const SkGlyph* findCachedGlyphMetrics(SkGlyphID glyphID, SkPoint position) const;
+
     bool decideCouldDrawFromPath(const SkGlyph& glyph) override;
 
     const SkDescriptor& getDescriptor() const override;
@@ -222,7 +244,7 @@ private:
     // Map from a combined GlyphID and sub-pixel position to a SkGlyph*.
     // The actual glyph is stored in the fAlloc. This structure provides an
     // unchanging pointer as long as the cache is alive.
-    SkTHashTable<SkGlyph*, SkPackedGlyphID, GlyphMapHashTraits> fGlyphMap;
+    SkTSwissTable<SkGlyph*, SkPackedGlyphID, GlyphMapHashTraits> fGlyphMap;
 
     // so we don't grow our arrays a lot
     static constexpr size_t kMinGlyphCount = 8;
@@ -233,6 +255,8 @@ private:
 
     // used to track (approx) how much ram is tied-up in this cache
     size_t                  fMemoryUsed;
+    // images we point at but don't own; see initializeSharedImage()
+    size_t                  fSharedImageBytes{0};
 
     const bool              fIsSubpixel;
     const SkAxisAlignment   fAxisAlignment;
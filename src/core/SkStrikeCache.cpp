@@ -11,7 +11,9 @@
 
 #include "SkGlyphRunPainter.h"
 #include "SkGraphics.h"
+#include "SkMetrics.h"
 #include "SkMutex.h"
+#include "SkSharedMutex.h"
 #include "SkStrike.h"
 #include "SkTemplates.h"
 #include "SkTraceMemoryDump.h"
@@ -63,6 +65,16 @@ public:
     Node*                           fPrev{nullptr};
     SkStrike                        fStrike;
     std::unique_ptr<SkStrikePinner> fPinner;
+
+    // What fStrikeCache->fTotalMemoryUsed counts for this node. Shared strikes grow while they
+    // are attached, so this is only brought up to date when nobody is using them.
+    size_t                          fMemoryAccounted{0};
+
+    // Shared strikes stay attached while in use. fSharedRefs counts their SharedStrikePtrs, and
+    // like the list links is only touched under fStrikeCache->fLock. fGlyphLock guards fStrike.
+    bool                            fIsShared{false};
+    int                             fSharedRefs{0};
+    mutable SkSharedMutex           fGlyphLock;
 };
 
 SkStrikeCache* SkStrikeCache::GlobalStrikeCache() {
@@ -126,6 +138,96 @@ bool operator == (decltype(nullptr), const SkStrikeCache::ExclusiveStrikePtr& rh
     return nullptr == rhs.fNode;
 }
 
+SkStrikeCache::SharedStrikePtr::SharedStrikePtr(SkStrikeCache::Node* node)
+    : fNode{node} {}
+
+SkStrikeCache::SharedStrikePtr::SharedStrikePtr()
+    : fNode{nullptr} {}
+
+SkStrikeCache::SharedStrikePtr::SharedStrikePtr(SharedStrikePtr&& o)
+    : fNode{o.fNode} {
+    o.fNode = nullptr;
+}
+
+SkStrikeCache::SharedStrikePtr&
+SkStrikeCache::SharedStrikePtr::operator = (SharedStrikePtr&& o) {
+    if (fNode != nullptr) {
+        fNode->fStrikeCache->unrefSharedNode(fNode);
+    }
+    fNode = o.fNode;
+    o.fNode = nullptr;
+    return *this;
+}
+
+SkStrikeCache::SharedStrikePtr::~SharedStrikePtr() {
+    if (fNode != nullptr) {
+        fNode->fStrikeCache->unrefSharedNode(fNode);
+    }
+}
+
+SkVector SkStrikeCache::SharedStrikePtr::rounding() const {
+    // Immutable after construction.
+    return fNode->fStrike.rounding();
+}
+
+const SkGlyph& SkStrikeCache::SharedStrikePtr::getGlyphMetrics(SkGlyphID glyphID,
+                                                               SkPoint position) const {
+    {
+        SkAutoSharedMutexShared shared(fNode->fGlyphLock);
+        if (const SkGlyph* glyph = fNode->fStrike.findCachedGlyphMetrics(glyphID, position)) {
+            return *glyph;
+        }
+    }
+    SkAutoExclusive exclusive(fNode->fGlyphLock);
+    return fNode->fStrike.getGlyphMetrics(glyphID, position);
+}
+
+const void* SkStrikeCache::SharedStrikePtr::findImage(const SkGlyph& glyph) const {
+    {
+        // A glyph's metrics never change once it is published, and fImage is only ever set
+        // under the exclusive lock, so if we see it (or see it can't have one) we're done.
+        SkAutoSharedMutexShared shared(fNode->fGlyphLock);
+        if (glyph.fImage != nullptr || glyph.fWidth == 0 || glyph.fWidth >= kMaxGlyphWidth) {
+            return glyph.fImage;
+        }
+    }
+    SkAutoExclusive exclusive(fNode->fGlyphLock);
+    return fNode->fStrike.findImage(glyph);
+}
+
+void SkStrikeCache::SharedStrikePtr::prepareImages(SkSpan<const SkGlyph* const> glyphs,
+                                                   SkExecutor* executor) const {
+    {
+        SkAutoSharedMutexShared shared(fNode->fGlyphLock);
+        bool allPrepared = true;
+        for (const SkGlyph* glyph : glyphs) {
+            if (glyph->fImage == nullptr && glyph->fWidth > 0 && glyph->fWidth < kMaxGlyphWidth) {
+                allPrepared = false;
+                break;
+            }
+        }
+        if (allPrepared) {
+            return;
+        }
+    }
+    SkAutoExclusive exclusive(fNode->fGlyphLock);
+    fNode->fStrike.prepareImages(glyphs, executor);
+}
+
+const SkPath* SkStrikeCache::SharedStrikePtr::findPath(const SkGlyph& glyph) const {
+    {
+        SkAutoSharedMutexShared shared(fNode->fGlyphLock);
+        if (glyph.isEmpty()) {
+            return nullptr;
+        }
+        if (glyph.fPathData != nullptr) {
+            return glyph.path();
+        }
+    }
+    SkAutoExclusive exclusive(fNode->fGlyphLock);
+    return fNode->fStrike.findPath(glyph);
+}
+
 SkStrikeCache::~SkStrikeCache() {
     Node* node = fHead;
     while (node) {
@@ -173,8 +275,20 @@ auto SkStrikeCache::findOrCreateStrike(const SkDescriptor& desc,
                                        const SkTypeface& typeface) -> Node* {
     Node* node = this->findAndDetachStrike(desc);
     if (node == nullptr) {
-        auto scaler = CreateScalerContext(desc, effects, typeface);
-        node = this->createStrike(desc, std::move(scaler));
+        node = this->createStrikeForTypeface(desc, effects, typeface);
+    }
+    return node;
+}
+
+auto SkStrikeCache::createStrikeForTypeface(const SkDescriptor& desc,
+                                            const SkScalerContextEffects& effects,
+                                            const SkTypeface& typeface) -> Node* {
+    auto scaler = CreateScalerContext(desc, effects, typeface);
+    Node* node = this->createStrike(desc, std::move(scaler));
+
+    // Nobody else can see the new strike yet, so we can fill it without holding any locks.
+    if (sk_sp<SkPersistentStrikeStore> store = this->persistentStore()) {
+        store->populate(desc, typeface, &node->fStrike);
     }
     return node;
 }
@@ -184,8 +298,7 @@ SkScopedStrike SkStrikeCache::findOrCreateScopedStrike(const SkDescriptor& desc,
                                                        const SkTypeface& typeface) {
     Node* node = this->findAndDetachStrike(desc);
     if (node == nullptr) {
-        auto scaler = CreateScalerContext(desc, effects, typeface);
-        node = this->createStrike(desc, std::move(scaler));
+        node = this->createStrikeForTypeface(desc, effects, typeface);
     }
     return SkScopedStrike{node};
 }
@@ -220,6 +333,71 @@ auto SkStrikeCache::findOrCreateStrike(
     return this->findOrCreateStrike(*desc, effects, *tf);
 }
 
+SkStrikeCache::SharedStrikePtr SkStrikeCache::FindOrCreateSharedStrike(
+        const SkFont& font,
+        const SkPaint& paint,
+        const SkSurfaceProps& surfaceProps,
+        SkScalerContextFlags scalerContextFlags,
+        const SkMatrix& deviceMatrix)
+{
+    SkAutoDescriptor ad;
+    SkScalerContextEffects effects;
+
+    auto desc = SkScalerContext::CreateDescriptorAndEffectsUsingPaint(
+            font, paint, surfaceProps, scalerContextFlags, deviceMatrix, &ad, &effects);
+
+    auto tf = font.getTypefaceOrDefault();
+
+    return GlobalStrikeCache()->findOrCreateSharedStrike(*desc, effects, *tf);
+}
+
+auto SkStrikeCache::findOrCreateSharedStrike(const SkDescriptor& desc,
+                                             const SkScalerContextEffects& effects,
+                                             const SkTypeface& typeface) -> SharedStrikePtr {
+    {
+        SkAutoExclusive ac(fLock);
+        if (Node* node = this->internalFindAndRefSharedStrike(desc)) {
+            return SharedStrikePtr(node);
+        }
+    }
+
+    Node* node = this->createStrikeForTypeface(desc, effects, typeface);
+    node->fIsShared = true;
+
+    SkAutoExclusive ac(fLock);
+    // Another thread may have created the same strike while we weren't holding the lock.
+    if (Node* existing = this->internalFindAndRefSharedStrike(desc)) {
+        delete node;
+        return SharedStrikePtr(existing);
+    }
+    node->fSharedRefs = 1;
+    this->internalAttachToHead(node);
+    this->internalPurge();
+    return SharedStrikePtr(node);
+}
+
+auto SkStrikeCache::internalFindAndRefSharedStrike(const SkDescriptor& desc) -> Node* {
+    for (Node* node = internalGetHead(); node != nullptr; node = node->fNext) {
+        if (node->fIsShared && node->fStrike.getDescriptor() == desc) {
+            node->fSharedRefs += 1;
+            this->internalMoveToHead(node);
+            return node;
+        }
+    }
+    return nullptr;
+}
+
+void SkStrikeCache::unrefSharedNode(Node* node) {
+    SkAutoExclusive ac(fLock);
+    SkASSERT(node->fIsShared && node->fSharedRefs > 0);
+    if (--node->fSharedRefs == 0) {
+        // Nobody else can be growing the strike now, so catch up on its memory use.
+        this->internalDetachCache(node);
+        this->internalAttachToHead(node);
+        this->internalPurge();
+    }
+}
+
 SkExclusiveStrikePtr SkStrikeCache::FindOrCreateStrikeWithNoDeviceExclusive(const SkFont& font) {
     return FindOrCreateStrikeWithNoDeviceExclusive(font, SkPaint());
 }
@@ -239,6 +417,33 @@ void SkStrikeCache::PurgeAll() {
     GlobalStrikeCache()->purgeAll();
 }
 
+bool SkStrikeCache::LoadPersistentStrikes(const char path[]) {
+    sk_sp<SkPersistentStrikeStore> store = SkPersistentStrikeStore::Make(path);
+    bool loaded = store != nullptr;
+    GlobalStrikeCache()->setPersistentStore(std::move(store));
+    return loaded;
+}
+
+bool SkStrikeCache::SavePersistentStrikes(const char path[]) {
+    return GlobalStrikeCache()->savePersistentStore(path);
+}
+
+sk_sp<SkPersistentStrikeStore> SkStrikeCache::persistentStore() const {
+    SkAutoExclusive ac(fLock);
+    return fPersistentStore;
+}
+
+void SkStrikeCache::setPersistentStore(sk_sp<SkPersistentStrikeStore> store) {
+    SkAutoExclusive ac(fLock);
+    fPersistentStore = std::move(store);
+}
+
+bool SkStrikeCache::savePersistentStore(const char path[]) const {
+    SkPersistentStrikeStore::Writer writer;
+    this->forEachStrike([&writer](const SkStrike& strike) { writer.appendStrike(strike); });
+    return writer.finish(path);
+}
+
 void SkStrikeCache::Dump() {
     SkDebugf("GlyphCache [     used    budget ]\n");
     SkDebugf("    bytes  [ %8zu  %8zu ]\n",
@@ -272,6 +477,13 @@ void SkStrikeCache::DumpMemoryStatistics(SkTraceMemoryDump* dump) {
     dump->dumpNumericValue(gGlyphCacheDumpName, "budget_glyph_count", "objects",
                            SkGraphics::GetFontCacheCountLimit());
 
+    if (sk_sp<SkPersistentStrikeStore> store = GlobalStrikeCache()->persistentStore()) {
+        SkString storeName = SkStringPrintf("%s/persistent_store", gGlyphCacheDumpName);
+        dump->dumpNumericValue(storeName.c_str(), "size", "bytes", store->mappedBytes());
+        dump->dumpNumericValue(storeName.c_str(), "strike_count", "objects",
+                               store->strikeCount());
+    }
+
     if (dump->getRequestedDetails() == SkTraceMemoryDump::kLight_LevelOfDetail) {
         dump->setMemoryBacking(gGlyphCacheDumpName, "malloc", nullptr);
         return;
@@ -325,12 +537,14 @@ auto SkStrikeCache::findAndDetachStrike(const SkDescriptor& desc) -> Node* {
     SkAutoExclusive ac(fLock);
 
     for (Node* node = internalGetHead(); node != nullptr; node = node->fNext) {
-        if (node->fStrike.getDescriptor() == desc) {
+        if (!node->fIsShared && node->fStrike.getDescriptor() == desc) {
             this->internalDetachCache(node);
+            SK_METRIC_COUNT("strike_cache.strike_hits", 1);
             return node;
         }
     }
 
+    SK_METRIC_COUNT("strike_cache.strike_misses", 1);
     return nullptr;
 }
 
@@ -370,7 +584,8 @@ bool SkStrikeCache::desperationSearchForImage(const SkDescriptor& desc, SkGlyph*
             targetSubY = glyph->getSubYFixed();
 
     for (Node* node = internalGetHead(); node != nullptr; node = node->fNext) {
-        if (loose_compare(node->fStrike.getDescriptor(), desc)) {
+        // Shared strikes that are in use may be changing under us.
+        if (node->fSharedRefs == 0 && loose_compare(node->fStrike.getDescriptor(), desc)) {
             auto targetGlyphID = SkPackedGlyphID(glyphID, targetSubX, targetSubY);
             if (node->fStrike.isGlyphCached(glyphID, targetSubX, targetSubY)) {
                 SkGlyph* fallback = node->fStrike.getRawGlyphByID(targetGlyphID);
@@ -403,7 +618,8 @@ bool SkStrikeCache::desperationSearchForPath(
     // This will have to search the sub-pixel positions too.
     // There is also a problem with accounting for cache size with shared path data.
     for (Node* node = internalGetHead(); node != nullptr; node = node->fNext) {
-        if (loose_compare(node->fStrike.getDescriptor(), desc)) {
+        // Shared strikes that are in use may be changing under us.
+        if (node->fSharedRefs == 0 && loose_compare(node->fStrike.getDescriptor(), desc)) {
             if (node->fStrike.isGlyphCached(glyphID, 0, 0)) {
                 SkGlyph* from = node->fStrike.getRawGlyphByID(SkPackedGlyphID(glyphID));
                 if (from->fPathData != nullptr) {
@@ -454,8 +670,11 @@ auto SkStrikeCache::createStrike(
 }
 
 void SkStrikeCache::purgeAll() {
+    sk_sp<SkPersistentStrikeStore> store;
     SkAutoExclusive ac(fLock);
     this->internalPurge(fTotalMemoryUsed);
+    // Unmap the store once we've let go of fLock.
+    store = std::move(fPersistentStore);
 }
 
 size_t SkStrikeCache::getTotalMemoryUsed() const {
@@ -528,7 +747,11 @@ void SkStrikeCache::forEachStrike(std::function<void(const SkStrike&)> visitor)
     this->validate();
 
     for (Node* node = this->internalGetHead(); node != nullptr; node = node->fNext) {
-        visitor(node->fStrike);
+        // Shared strikes in use may be changing under us. We're holding fLock, and growing a
+        // strike may need fLock too (e.g. desperation searches), so don't wait on fGlyphLock.
+        if (node->fSharedRefs == 0) {
+            visitor(node->fStrike);
+        }
     }
 }
 
@@ -566,9 +789,10 @@ size_t SkStrikeCache::internalPurge(size_t minBytesNeeded) {
     while (node != nullptr && (bytesFreed < bytesNeeded || countFreed < countNeeded)) {
         Node* prev = node->fPrev;
 
-        // Only delete if the strike is not pinned.
-        if (node->fPinner == nullptr || node->fPinner->canDelete()) {
-            bytesFreed += node->fStrike.getMemoryUsed();
+        // Only delete if the strike is not pinned, or in use as a shared strike.
+        if (node->fSharedRefs == 0 &&
+            (node->fPinner == nullptr || node->fPinner->canDelete())) {
+            bytesFreed += node->fMemoryAccounted;
             countFreed += 1;
             this->internalDetachCache(node);
             delete node;
@@ -577,6 +801,8 @@ size_t SkStrikeCache::internalPurge(size_t minBytesNeeded) {
     }
 
     this->validate();
+    SK_METRIC_COUNT("strike_cache.purged_strikes", countFreed);
+    SK_METRIC_COUNT("strike_cache.purged_bytes", bytesFreed);
 
 #ifdef SPEW_PURGE_STATUS
     if (countFreed) {
@@ -601,13 +827,31 @@ void SkStrikeCache::internalAttachToHead(Node* node) {
     }
 
     fCacheCount += 1;
-    fTotalMemoryUsed += node->fStrike.getMemoryUsed();
+    node->fMemoryAccounted = node->fStrike.getMemoryUsed();
+    fTotalMemoryUsed += node->fMemoryAccounted;
+}
+
+void SkStrikeCache::internalMoveToHead(Node* node) {
+    // Unlike detaching and reattaching, this leaves the memory accounting alone.
+    if (fHead == node) {
+        return;
+    }
+    node->fPrev->fNext = node->fNext;
+    if (node->fNext) {
+        node->fNext->fPrev = node->fPrev;
+    } else {
+        fTail = node->fPrev;
+    }
+    node->fPrev = nullptr;
+    node->fNext = fHead;
+    fHead->fPrev = node;
+    fHead = node;
 }
 
 void SkStrikeCache::internalDetachCache(Node* node) {
     SkASSERT(fCacheCount > 0);
     fCacheCount -= 1;
-    fTotalMemoryUsed -= node->fStrike.getMemoryUsed();
+    fTotalMemoryUsed -= node->fMemoryAccounted;
 
     if (node->fPrev) {
         node->fPrev->fNext = node->fNext;
@@ -643,7 +887,7 @@ void SkStrikeCache::validate() const {
 
     const Node* node = fHead;
     while (node != nullptr) {
-        computedBytes += node->fStrike.getMemoryUsed();
+        computedBytes += node->fMemoryAccounted;
         computedCount += 1;
         node = node->fNext;
     }
@@ -12,6 +12,7 @@
 #include <unordered_set>
 
 #include "SkDescriptor.h"
+#include "SkPersistentStrikeStore.h"
 #include "SkStrike.h"
 #include "SkSpinlock.h"
 #include "SkTemplates.h"
@@ -68,6 +69,32 @@ public:
         Node* fNode;
     };
 
+    // A strike that many threads can use at once. Glyphs that are already cached (metrics, image
+    // and path) are found under a shared per-strike lock, so readers never wait on each other;
+    // only cache misses that need the SkScalerContext take that lock exclusively. Shared strikes
+    // are kept separately from the strikes handed out by the *Exclusive() calls.
+    class SharedStrikePtr {
+    public:
+        explicit SharedStrikePtr(Node*);
+        SharedStrikePtr();
+        SharedStrikePtr(const SharedStrikePtr&) = delete;
+        SharedStrikePtr& operator = (const SharedStrikePtr&) = delete;
+        SharedStrikePtr(SharedStrikePtr&&);
+        SharedStrikePtr& operator = (SharedStrikePtr&&);
+        ~SharedStrikePtr();
+
+        SkVector rounding() const;
+        const SkGlyph& getGlyphMetrics(SkGlyphID, SkPoint position) const;
+        const void* findImage(const SkGlyph&) const;
+        void prepareImages(SkSpan<const SkGlyph* const>, SkExecutor* = nullptr) const;
+        const SkPath* findPath(const SkGlyph&) const;
+
+        explicit operator bool () const { return fNode != nullptr; }
+
+    private:
+        Node* fNode;
+    };
+
     static SkStrikeCache* GlobalStrikeCache();
 
     static ExclusiveStrikePtr FindStrikeExclusive(const SkDescriptor&);
@@ -132,6 +159,18 @@ public:
             SkScalerContextFlags scalerContextFlags,
             const SkMatrix& deviceMatrix);
 
+    static SharedStrikePtr FindOrCreateSharedStrike(
+            const SkFont& font,
+            const SkPaint& paint,
+            const SkSurfaceProps& surfaceProps,
+            SkScalerContextFlags scalerContextFlags,
+            const SkMatrix& deviceMatrix);
+
+    SharedStrikePtr findOrCreateSharedStrike(
+            const SkDescriptor& desc,
+            const SkScalerContextEffects& effects,
+            const SkTypeface& typeface);
+
     // cons up a default paint, which is only needed for patheffects/maskfilter
     static ExclusiveStrikePtr FindOrCreateStrikeWithNoDeviceExclusive(const SkFont&);
 
@@ -143,6 +182,13 @@ public:
 
     static void PurgeAll();
     static void ValidateGlyphCacheDataSize();
+
+    // Map a store written by SavePersistentStrikes(). Strikes created from then on start out
+    // with whatever glyphs the store has for them. Returns false, leaving the cache without a
+    // store, if path isn't a valid store.
+    static bool LoadPersistentStrikes(const char path[]);
+    // Write every strike not in use by another thread to path.
+    static bool SavePersistentStrikes(const char path[]);
     static void Dump();
 
     // Dump memory usage statistics of all the attaches caches in the process using the
@@ -152,7 +198,14 @@ public:
     // call when a glyphcache is available for caching (i.e. not in use)
     void attachNode(Node* node);
 
-    void purgeAll(); // does not change budget
+    // call when a SharedStrikePtr lets go of its strike
+    void unrefSharedNode(Node* node);
+
+    void purgeAll(); // does not change budget; also drops the persistent store
+
+    sk_sp<SkPersistentStrikeStore> persistentStore() const;
+    void setPersistentStore(sk_sp<SkPersistentStrikeStore>);
+    bool savePersistentStore(const char path[]) const;
 
     int getCacheCountLimit() const;
     int setCacheCountLimit(int limit);
@@ -182,6 +235,12 @@ private:
     Node* internalGetTail() const { return fTail; }
     void internalDetachCache(Node*);
     void internalAttachToHead(Node*);
+    void internalMoveToHead(Node*);
+    Node* internalFindAndRefSharedStrike(const SkDescriptor&);
+
+    // Create a strike for a cache miss, filled from the persistent store if we have one.
+    Node* createStrikeForTypeface(const SkDescriptor&, const SkScalerContextEffects&,
+                                  const SkTypeface&);
 
     // Checkout budgets, modulated by the specified min-bytes-needed-to-purge,
     // and attempt to purge caches to match.
@@ -198,6 +257,7 @@ private:
     int32_t            fCacheCountLimit{SK_DEFAULT_FONT_CACHE_COUNT_LIMIT};
     int32_t            fCacheCount{0};
     int32_t            fPointSizeLimit{SK_DEFAULT_FONT_CACHE_POINT_SIZE_LIMIT};
+    sk_sp<SkPersistentStrikeStore> fPersistentStore;
 };
 
 using SkExclusiveStrikePtr = SkStrikeCache::ExclusiveStrikePtr;
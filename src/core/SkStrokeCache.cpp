@@ -0,0 +1,113 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkStrokeCache.h"
+
+#include "SkPathPriv.h"
+
+#include <cmath>
+
+#define CHECK_LOCAL(localCache, localName, globalName, ...) \
+    ((localCache) ? localCache->localName(__VA_ARGS__) : SkResourceCache::globalName(__VA_ARGS__))
+
+namespace {
+static unsigned gStrokeKeyNamespaceLabel;
+
+static uint64_t make_shared_id(uint32_t pathGenID) {
+    uint64_t sharedID = SkSetFourByteTag('s', 't', 'r', 'k');
+    return (sharedID << 32) | pathGenID;
+}
+
+struct StrokeKey : public SkResourceCache::Key {
+public:
+    StrokeKey(const SkPath& src, const SkStrokeRec& rec)
+        : fWidth(rec.getWidth())
+        , fMiter(rec.getMiter())
+        , fResScale(rec.getResScale())
+        , fStyle(rec.getStyle())
+        , fCap(rec.getCap())
+        , fJoin(rec.getJoin())
+        , fFillType(src.getFillType())
+    {
+        this->init(&gStrokeKeyNamespaceLabel, make_shared_id(src.getGenerationID()),
+                   sizeof(fWidth) + sizeof(fMiter) + sizeof(fResScale) + sizeof(fStyle) +
+                   sizeof(fCap) + sizeof(fJoin) + sizeof(fFillType));
+    }
+
+    SkScalar fWidth;
+    SkScalar fMiter;
+    SkScalar fResScale;
+    int32_t  fStyle;
+    int32_t  fCap;
+    int32_t  fJoin;
+    int32_t  fFillType;
+};
+
+// Purges the source path's entries once it changes.
+class PathListener : public SkPathRef::GenIDChangeListener {
+public:
+    explicit PathListener(uint32_t genID) : fGenID(genID) {}
+
+    void onChange() override {
+        SkResourceCache::PostPurgeSharedID(make_shared_id(fGenID));
+    }
+
+private:
+    const uint32_t fGenID;
+};
+
+struct StrokeRec : public SkResourceCache::Rec {
+    StrokeRec(const StrokeKey& key, const SkPath& path, sk_sp<PathListener> listener)
+        : fKey(key)
+        , fPath(path)
+        , fListener(std::move(listener)) {}
+
+    ~StrokeRec() override {
+        fListener->markShouldUnregisterFromPath();
+    }
+
+    StrokeKey           fKey;
+    SkPath              fPath;
+    sk_sp<PathListener> fListener;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override {
+        return sizeof(*this) + fPath.countPoints() * sizeof(SkPoint) + fPath.countVerbs();
+    }
+    const char* getCategory() const override { return "stroke"; }
+    SkDiscardableMemory* diagnostic_only_getDiscardable() const override { return nullptr; }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const StrokeRec& rec = static_cast<const StrokeRec&>(baseRec);
+        *static_cast<SkPath*>(contextData) = rec.fPath;
+        return true;
+    }
+};
+} // namespace
+
+SkScalar SkStrokeCache::BucketResScale(SkScalar resScale) {
+    SkASSERT(resScale > 0 && SkScalarIsFinite(resScale));
+    int exp;
+    float mantissa = std::frexp(resScale, &exp);  // resScale = mantissa * 2^exp, 0.5 <= mantissa
+    return std::ldexp(1.0f, mantissa == 0.5f ? exp - 1 : exp);
+}
+
+bool SkStrokeCache::Find(const SkPath& src, const SkStrokeRec& rec, SkPath* dst,
+                         SkResourceCache* localCache) {
+    SkASSERT(!src.isVolatile());
+    StrokeKey key(src, rec);
+    return CHECK_LOCAL(localCache, find, Find, key, StrokeRec::Visitor, dst);
+}
+
+void SkStrokeCache::Add(const SkPath& src, const SkStrokeRec& rec, const SkPath& dst,
+                        SkResourceCache* localCache) {
+    SkASSERT(!src.isVolatile());
+    StrokeKey key(src, rec);
+    auto listener = sk_make_sp<PathListener>(src.getGenerationID());
+    SkPathPriv::AddGenIDChangeListener(src, listener);
+    return CHECK_LOCAL(localCache, add, Add, new StrokeRec(key, dst, std::move(listener)));
+}
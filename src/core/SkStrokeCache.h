@@ -0,0 +1,41 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkStrokeCache_DEFINED
+#define SkStrokeCache_DEFINED
+
+#include "SkPath.h"
+#include "SkResourceCache.h"
+#include "SkStrokeRec.h"
+
+/**
+ * Caches the outlines SkStrokeRec::applyToPath() produces for non-volatile paths, keyed by the
+ * path's generation ID, so paths redrawn with the same stroke aren't restroked every time.
+ * Entries are purged when the source path is modified or deleted.
+ */
+class SkStrokeCache {
+public:
+    /**
+     * Rounds resScale up to a power of two. Stroking with the bucketed scale lets draws at
+     * slightly different scales share entries, at the cost of a little extra precision.
+     */
+    static SkScalar BucketResScale(SkScalar resScale);
+
+    /**
+     * On success, sets dst to src stroked with rec and returns true.
+     */
+    static bool Find(const SkPath& src, const SkStrokeRec& rec, SkPath* dst,
+                     SkResourceCache* localCache = nullptr);
+
+    /**
+     * Records that stroking src with rec produces dst. src must not be volatile.
+     */
+    static void Add(const SkPath& src, const SkStrokeRec& rec, const SkPath& dst,
+                    SkResourceCache* localCache = nullptr);
+};
+
+#endif
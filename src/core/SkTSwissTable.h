@@ -0,0 +1,283 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkTSwissTable_DEFINED
+#define SkTSwissTable_DEFINED
+
+#include "SkChecksum.h"
+#include "SkMathPriv.h"
+#include "SkTypes.h"
+
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+    #include <emmintrin.h>
+#elif defined(SK_ARM_HAS_NEON)
+    #include <arm_neon.h>
+#endif
+
+// A drop-in replacement for SkTHashTable, with the same Traits, for tables on hot lookup paths.
+//
+// Next to every slot is a control byte: empty, deleted, or, for a full slot, 7 bits of its entry's
+// hash. Slots come in groups of 16, and a lookup compares the wanted hash bits against a whole
+// group of control bytes at once with SSE2 or NEON, then only compares keys for the matches. A
+// lookup stops at the first group with an empty slot, so misses rarely compare keys at all.
+//
+// Unlike SkTHashTable, T need not be default constructible, and remove() does not move other
+// entries. Traits::Hash() is mixed before use, so weak hashes like the identity are fine.
+template <typename T, typename K, typename Traits = T>
+class SkTSwissTable {
+public:
+    SkTSwissTable() : fCount(0), fDeleted(0), fCapacity(0) {}
+    SkTSwissTable(SkTSwissTable&& other)
+        : fCount(other.fCount)
+        , fDeleted(other.fDeleted)
+        , fCapacity(other.fCapacity)
+        , fCtrl(std::move(other.fCtrl))
+        , fSlots(std::move(other.fSlots)) { other.fCount = other.fDeleted = other.fCapacity = 0; }
+
+    SkTSwissTable& operator=(SkTSwissTable&& other) {
+        if (this != &other) {
+            this->~SkTSwissTable();
+            new (this) SkTSwissTable(std::move(other));
+        }
+        return *this;
+    }
+
+    ~SkTSwissTable() {
+        this->foreach([](T* val) { val->~T(); });
+    }
+
+    // Clear the table.
+    void reset() { *this = SkTSwissTable(); }
+
+    // How many entries are in the table?
+    int count() const { return fCount; }
+
+    // Approximately how many bytes of memory do we use beyond sizeof(*this)?
+    size_t approxBytesUsed() const { return fCapacity * (sizeof(Slot) + sizeof(int8_t)); }
+
+    // The pointers returned by set() and find() are valid only until the next call to set().
+    // The pointers you receive in foreach() are only valid for its duration.
+    // As with SkTHashTable, never change an entry so that it no longer has the same key.
+
+    // Copy val into the hash table, returning a pointer to the copy now in the table.
+    // If there already is an entry in the table with the same key, we overwrite it.
+    T* set(T val) {
+        const uint32_t hash = Hash(Traits::GetKey(val));
+        if (T* found = this->find(Traits::GetKey(val), hash)) {
+            *found = std::move(val);
+            return found;
+        }
+
+        if (8 * (fCount + fDeleted + 1) > 7 * fCapacity) {
+            // Grow, unless most of what fills the table is deleted entries we can drop in place.
+            this->resize(16 * fCount >= 7 * fCapacity ? SkTMax(2 * fCapacity, (int)kGroupWidth)
+                                                      : fCapacity);
+        }
+        return this->uncheckedSet(std::move(val), hash);
+    }
+
+    // If there is an entry in the table with this key, return a pointer to it.  If not, null.
+    T* find(const K& key) const {
+        return fCapacity > 0 ? this->find(key, Hash(key)) : nullptr;
+    }
+
+    // If there is an entry in the table with this key, return it.  If not, null.
+    // This only works for pointer type T, and cannot be used to find an nullptr entry.
+    T findOrNull(const K& key) const {
+        if (T* p = this->find(key)) {
+            return *p;
+        }
+        return nullptr;
+    }
+
+    // Remove the value with this key from the hash table.
+    void remove(const K& key) {
+        T* val = this->find(key);
+        SkASSERT(val);
+        const int index = SkToInt(reinterpret_cast<Slot*>(val) - fSlots.get());
+        val->~T();
+        fCount--;
+
+        // No lookup ever went past a group that still has an empty slot, so a slot in such a group
+        // can be made empty again. Otherwise lookups must keep probing past it.
+        const int8_t* group = &fCtrl[index & ~(kGroupWidth - 1)];
+        if (MatchEmpty(group)) {
+            fCtrl[index] = kEmpty;
+        } else {
+            fCtrl[index] = kDeleted;
+            fDeleted++;
+        }
+    }
+
+    // Call fn on every entry in the table.  You may mutate the entries, but be very careful.
+    template <typename Fn>  // f(T*)
+    void foreach(Fn&& fn) {
+        for (int i = 0; i < fCapacity; i++) {
+            if (IsFull(fCtrl[i])) {
+                fn(this->slot(i));
+            }
+        }
+    }
+
+    // Call fn on every entry in the table.  You may not mutate anything.
+    template <typename Fn>  // f(T) or f(const T&)
+    void foreach(Fn&& fn) const {
+        for (int i = 0; i < fCapacity; i++) {
+            if (IsFull(fCtrl[i])) {
+                fn(*this->slot(i));
+            }
+        }
+    }
+
+private:
+    using Slot = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+    static constexpr int    kGroupWidth = 16;
+    static constexpr int8_t kEmpty      = -128;  // 0x80
+    static constexpr int8_t kDeleted    = -2;    // 0xFE
+    // Full slots hold the low 7 bits of their entry's hash, so they are never negative.
+
+    static bool IsFull(int8_t ctrl) { return ctrl >= 0; }
+
+    static uint32_t Hash(const K& key) { return SkChecksum::Mix(Traits::Hash(key)); }
+
+    // Sets bit i of the result if group[i] == ctrl.
+    static uint32_t Match(const int8_t* group, int8_t ctrl) {
+    #if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+        __m128i bytes = _mm_loadu_si128((const __m128i*)group);
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(ctrl)));
+    #elif defined(SK_ARM_HAS_NEON)
+        return MoveMask(vceqq_s8(vld1q_s8(group), vdupq_n_s8(ctrl)));
+    #else
+        uint32_t mask = 0;
+        for (int i = 0; i < kGroupWidth; i++) {
+            mask |= (uint32_t)(group[i] == ctrl) << i;
+        }
+        return mask;
+    #endif
+    }
+
+    static uint32_t MatchEmpty(const int8_t* group) { return Match(group, kEmpty); }
+
+    // Sets bit i of the result if group[i] is empty or deleted.
+    static uint32_t MatchEmptyOrDeleted(const int8_t* group) {
+    #if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+        return _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)group));
+    #elif defined(SK_ARM_HAS_NEON)
+        return MoveMask(vcltq_s8(vld1q_s8(group), vdupq_n_s8(0)));
+    #else
+        uint32_t mask = 0;
+        for (int i = 0; i < kGroupWidth; i++) {
+            mask |= (uint32_t)!IsFull(group[i]) << i;
+        }
+        return mask;
+    #endif
+    }
+
+#if SK_CPU_SSE_LEVEL < SK_CPU_SSE_LEVEL_SSE2 && defined(SK_ARM_HAS_NEON)
+    // Packs the lanes of a comparison result (each 0x00 or 0xFF) into the bits of a mask.
+    static uint32_t MoveMask(uint8x16_t lanes) {
+        static const uint8_t kBits[16] = { 1, 2, 4, 8, 16, 32, 64, 128,
+                                           1, 2, 4, 8, 16, 32, 64, 128 };
+        uint8x16_t bits = vandq_u8(lanes, vld1q_u8(kBits));
+        uint8x8_t sums = vpadd_u8(vget_low_u8(bits), vget_high_u8(bits));
+        sums = vpadd_u8(sums, sums);
+        sums = vpadd_u8(sums, sums);
+        return vget_lane_u8(sums, 0) | (vget_lane_u8(sums, 1) << 8);
+    }
+#endif
+
+    T* slot(int index) const { return reinterpret_cast<T*>(&fSlots[index]); }
+
+    // Groups are probed in a triangular sequence, which visits every group once when the number
+    // of groups is a power of two. There is always an empty slot, so every probe ends.
+    template <typename Fn>  // bool f(int groupStart), returning true to stop probing.
+    void probe(uint32_t hash, Fn&& fn) const {
+        const int groupMask = fCapacity / kGroupWidth - 1;
+        int group = (hash >> 7) & groupMask;
+        for (int step = 1; !fn(group * kGroupWidth); step++) {
+            SkASSERT(step <= groupMask + 1);
+            group = (group + step) & groupMask;
+        }
+    }
+
+    T* find(const K& key, uint32_t hash) const {
+        if (fCapacity == 0) {
+            return nullptr;
+        }
+        T* found = nullptr;
+        this->probe(hash, [&](int groupStart) {
+            const int8_t* group = &fCtrl[groupStart];
+            for (uint32_t matches = Match(group, hash & 0x7F); matches; matches &= matches - 1) {
+                T* val = this->slot(groupStart + SkCTZ(matches));
+                if (key == Traits::GetKey(*val)) {
+                    found = val;
+                    return true;
+                }
+            }
+            return MatchEmpty(group) != 0;
+        });
+        return found;
+    }
+
+    // Adds val, which must not already be in the table, to a slot that is empty or deleted.
+    T* uncheckedSet(T&& val, uint32_t hash) {
+        int index = -1;
+        this->probe(hash, [&](int groupStart) {
+            if (uint32_t free = MatchEmptyOrDeleted(&fCtrl[groupStart])) {
+                index = groupStart + SkCTZ(free);
+                return true;
+            }
+            return false;
+        });
+        SkASSERT(index >= 0);
+
+        if (fCtrl[index] == kDeleted) {
+            fDeleted--;
+        }
+        fCtrl[index] = hash & 0x7F;
+        fCount++;
+        return new (&fSlots[index]) T(std::move(val));
+    }
+
+    void resize(int capacity) {
+        SkASSERT(capacity >= kGroupWidth && SkIsPow2(capacity));
+        const int oldCapacity = fCapacity;
+        SkDEBUGCODE(int oldCount = fCount);
+        std::unique_ptr<int8_t[]> oldCtrl = std::move(fCtrl);
+        std::unique_ptr<Slot[]> oldSlots = std::move(fSlots);
+
+        fCount = fDeleted = 0;
+        fCapacity = capacity;
+        fCtrl.reset(new int8_t[capacity]);
+        memset(fCtrl.get(), kEmpty, capacity);
+        fSlots.reset(new Slot[capacity]);
+
+        for (int i = 0; i < oldCapacity; i++) {
+            if (IsFull(oldCtrl[i])) {
+                T* val = reinterpret_cast<T*>(&oldSlots[i]);
+                this->uncheckedSet(std::move(*val), Hash(Traits::GetKey(*val)));
+                val->~T();
+            }
+        }
+        SkASSERT(fCount == oldCount);
+    }
+
+    int fCount, fDeleted, fCapacity;
+    std::unique_ptr<int8_t[]> fCtrl;
+    std::unique_ptr<Slot[]>   fSlots;
+
+    SkTSwissTable(const SkTSwissTable&) = delete;
+    SkTSwissTable& operator=(const SkTSwissTable&) = delete;
+};
+
+#endif//SkTSwissTable_DEFINED
@@ -29,6 +29,39 @@ void SkTaskGroup::batch(int N, std::function<void(int)> fn) {
     }
 }
 
+// With no grain given, aim for enough chunks to balance uneven work across threads.
+static constexpr int kDefaultChunks = 64;
+// Each helper task claims chunks until there are none left, so a few are enough to keep every
+// thread busy without paying to queue a task per chunk.
+static constexpr int kMaxHelpers = 64;
+
+int SkTaskGroup::GrainSize(int N, int grain) {
+    return grain > 0 ? grain : SkTMax(1, N / kDefaultChunks);
+}
+
+void SkTaskGroup::parallelFor(int N, int grain, std::function<void(int, int)> fn) {
+    if (N <= 0) {
+        return;
+    }
+    grain = GrainSize(N, grain);
+
+    std::atomic<int> next(0);
+    auto work = [&] {
+        for (int start; (start = next.fetch_add(grain, std::memory_order_relaxed)) < N;) {
+            fn(start, start + SkTMin(grain, N - start));
+        }
+    };
+
+    // Helpers run on their own SkTaskGroup so we wait for them, not for this group's work.
+    SkTaskGroup helpers(fExecutor);
+    const int chunks = (N - 1) / grain + 1;
+    for (int i = 1; i < SkTMin(chunks, kMaxHelpers); i++) {
+        helpers.add(work);
+    }
+    work();
+    helpers.wait();
+}
+
 bool SkTaskGroup::done() const {
     return fPending.load(std::memory_order_acquire) == 0;
 }
@@ -10,6 +10,7 @@
 
 #include "SkExecutor.h"
 #include "SkNoncopyable.h"
+#include "SkTArray.h"
 #include "SkTypes.h"
 #include <atomic>
 #include <functional>
@@ -26,6 +27,32 @@ public:
     // Add a batch of N tasks, all calling fn with different arguments.
     void batch(int N, std::function<void(int)> fn);
 
+    // Call fn(start, end) on chunks of [0, N) of about grain indices, concurrently on this
+    // SkTaskGroup's executor and this thread, returning when they're all done. If grain is 0, the
+    // chunk size is picked from N. Unlike batch(), this queues at most a few helper tasks that each
+    // claim chunks until none are left, so even very fine grains don't pay to queue each chunk.
+    // This only waits for its own chunks, not for other work added to this SkTaskGroup, and fn
+    // may itself use SkTaskGroups on the same executor.
+    void parallelFor(int N, int grain, std::function<void(int start, int end)> fn);
+
+    // Returns reduce(...reduce(reduce(identity, map(0, end0)), map(end0, end1))..., map(endK, N))
+    // for the chunks of [0, N) parallelFor() would use. The chunks are mapped concurrently, then
+    // reduced in order on this thread, so the result doesn't depend on how the work was spread.
+    template <typename T, typename MapFn, typename ReduceFn>
+    T parallelReduce(int N, int grain, T identity, MapFn&& map, ReduceFn&& reduce) {
+        grain = GrainSize(N, grain);
+        SkTArray<T> partials;
+        partials.push_back_n(N > 0 ? (N + grain - 1) / grain : 0, identity);
+        this->parallelFor(N, grain, [&](int start, int end) {
+            partials[start / grain] = map(start, end);
+        });
+        T result = std::move(identity);
+        for (T& partial : partials) {
+            result = reduce(std::move(result), std::move(partial));
+        }
+        return result;
+    }
+
     // Returns true if all Tasks previously add()ed to this SkTaskGroup have run.
     // It is safe to reuse this SkTaskGroup once done().
     bool done() const;
@@ -41,6 +68,8 @@ public:
     };
 
 private:
+    static int GrainSize(int N, int grain);
+
     std::atomic<int32_t> fPending;
     SkExecutor&          fExecutor;
 };
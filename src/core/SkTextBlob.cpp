@@ -379,28 +379,47 @@ void SkTextBlobBuilder::updateDeferredBounds() {
 void SkTextBlobBuilder::reserve(size_t size) {
     SkSafeMath safe;
 
-    // We don't currently pre-allocate, but maybe someday...
     if (safe.add(fStorageUsed, size) <= fStorageSize && safe) {
         return;
     }
 
-    if (0 == fRunCount) {
+    if (0 == fStorageUsed) {
         SkASSERT(nullptr == fStorage.get());
         SkASSERT(0 == fStorageSize);
-        SkASSERT(0 == fStorageUsed);
+        SkASSERT(0 == fRunCount);
 
         // the first allocation also includes blob storage
         // aligned up to a pointer alignment so SkTextBlob::RunRecords after it stay aligned.
         fStorageUsed = SkAlignPtr(sizeof(SkTextBlob));
     }
 
-    fStorageSize = safe.add(fStorageUsed, size);
+    // Grow by at least half, so blobs with many runs don't realloc for every one of them. The
+    // first allocation is exact, and make() trims any excess.
+    fStorageSize = SkTMax(safe.add(fStorageUsed, size), fStorageSize + fStorageSize / 2);
 
     // FYI: This relies on everything we store being relocatable, particularly SkPaint.
     //      Also, this is counting on the underlying realloc to throw when passed max().
     fStorage.realloc(safe ? fStorageSize : std::numeric_limits<size_t>::max());
 }
 
+void SkTextBlobBuilder::reserveRuns(int runCount, int glyphCount) {
+    if (runCount <= 0 || glyphCount <= 0) {
+        return;
+    }
+
+    // Each run's storage is at most its RunRecord, its glyphs and positions, and the padding that
+    // aligns them (see RunRecord::StorageSize()).
+    SkSafeMath safe;
+    size_t runSize = sizeof(SkTextBlob::RunRecord) + 4 + sizeof(void*);
+    size_t glyphSize = sizeof(uint16_t) +
+                       SkTextBlob::ScalarsPerGlyph(SkTextBlob::kFull_Positioning) *
+                       sizeof(SkScalar);
+    size_t size = safe.add(safe.mul(runCount, runSize), safe.mul(glyphCount, glyphSize));
+    if (safe) {
+        this->reserve(size);
+    }
+}
+
 bool SkTextBlobBuilder::mergeRun(const SkFont& font, SkTextBlob::GlyphPositioning positioning,
                                  uint32_t count, SkPoint offset) {
     if (0 == fLastRun) {
@@ -576,17 +595,23 @@ const SkTextBlobBuilder::RunBuffer& SkTextBlobBuilder::allocRunRSXform(const SkF
 
 sk_sp<SkTextBlob> SkTextBlobBuilder::make() {
     if (!fRunCount) {
-        // We don't instantiate empty blobs.
-        SkASSERT(!fStorage.get());
-        SkASSERT(fStorageUsed == 0);
-        SkASSERT(fStorageSize == 0);
+        // We don't instantiate empty blobs, but there may be storage reserved for one.
         SkASSERT(fLastRun == 0);
         SkASSERT(fBounds.isEmpty());
+        fStorage.reset();
+        fStorageUsed = 0;
+        fStorageSize = 0;
         return nullptr;
     }
 
     this->updateDeferredBounds();
 
+    // Hand the blob only the storage it uses.
+    if (fStorageUsed < fStorageSize) {
+        fStorage.realloc(fStorageUsed);
+        fStorageSize = fStorageUsed;
+    }
+
     // Tag the last run as such.
     auto* lastRun = reinterpret_cast<SkTextBlob::RunRecord*>(fStorage.get() + fLastRun);
     lastRun->fFlags |= SkTextBlob::RunRecord::kLast_Flag;
@@ -0,0 +1,465 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkThreadedBMPDevice.h"
+
+#include "SkArenaAlloc.h"
+#include "SkAutoBlitterChoose.h"
+#include "SkBlitter.h"
+#include "SkOnce.h"
+#include "SkPath.h"
+#include "SkPathPriv.h"
+#include "SkScan.h"
+#include "SkSpecialImage.h"
+#include "SkTaskGroup.h"
+#include "SkVertices.h"
+
+namespace {
+
+// Keeps copies of the A8 masks a mask filter blits, clipped the way they were blitted.
+// Anything else, like a filter that gave up and let the path be scanned, isn't captured.
+class MaskCaptureBlitter final : public SkBlitter {
+public:
+    ~MaskCaptureBlitter() override {
+        for (const SkMask& piece : fPieces) {
+            SkMask::FreeImage(piece.fImage);
+        }
+    }
+
+    void blitH(int, int, int) override { fCaptured = false; }
+    void blitAntiH(int, int, const SkAlpha[], const int16_t[]) override { fCaptured = false; }
+
+    void blitMask(const SkMask& mask, const SkIRect& clip) override {
+        if (SkMask::kA8_Format != mask.fFormat) {
+            fCaptured = false;
+            return;
+        }
+        SkIRect r = clip;
+        if (!r.intersect(mask.fBounds)) {
+            return;
+        }
+        SkMask& piece = fPieces.push_back();
+        piece.fBounds   = r;
+        piece.fFormat   = SkMask::kA8_Format;
+        piece.fRowBytes = SkToU32(r.width());
+        piece.fImage    = SkMask::AllocImage(piece.computeImageSize());
+        for (int y = r.fTop; y < r.fBottom; ++y) {
+            memcpy(piece.getAddr8(r.fLeft, y), mask.getAddr8(r.fLeft, y), r.width());
+        }
+    }
+
+    bool captured() const { return fCaptured; }
+    const SkTArray<SkMask>& pieces() const { return fPieces; }
+
+private:
+    SkTArray<SkMask> fPieces;
+    bool             fCaptured = true;
+};
+
+}  // namespace
+
+// A queued draw's filtered mask.  The executor renders it once, against the draw's whole clip,
+// and tiles blit the part of it they cover.  A tile that needs it first waits for it, or, if the
+// executor hasn't gotten to it yet, renders it itself.  Blur masks of rects and rrects also land
+// in SkMaskCache as they're rendered, like they do on any other raster device.
+class SkThreadedBMPDevice::PrefetchedMask {
+public:
+    PrefetchedMask(const SkPixmap& dst, const DrawElement& element, const SkPaint& paint,
+                   MaskFn maskFn)
+        : fDst(dst)
+        , fMatrix(element.fMatrix)
+        , fClip(element.fClip)
+        , fPaint(paint)
+        , fMaskFn(std::move(maskFn)) {}
+
+    void render() {
+        fOnce([this] {
+            SkDraw draw;
+            draw.fDst    = fDst;
+            draw.fMatrix = &fMatrix;
+            draw.fRC     = fClip.get();
+            fMaskFn(draw, &fCapture);
+        });
+    }
+
+    // Returns false if the tile has to draw the original way.
+    bool blit(const SkDraw& tile) {
+        this->render();
+        if (!fCapture.captured()) {
+            return false;
+        }
+        // Every piece is already inside the clip, so all that's left is the tile's bounds.
+        SkAutoBlitterChoose blitter(tile, nullptr, fPaint);
+        const SkIRect& tileBounds = tile.fRC->getBounds();
+        for (const SkMask& piece : fCapture.pieces()) {
+            SkIRect r = piece.fBounds;
+            if (r.intersect(tileBounds)) {
+                blitter->blitMask(piece, r);
+            }
+        }
+        return true;
+    }
+
+private:
+    const SkPixmap                      fDst;
+    const SkMatrix                      fMatrix;
+    std::shared_ptr<const SkRasterClip> fClip;
+    const SkPaint                       fPaint;
+    const MaskFn                        fMaskFn;
+
+    SkOnce                              fOnce;
+    MaskCaptureBlitter                  fCapture;
+};
+
+// A queued path's coverage deltas (see SkDAARecord).  Just like a PrefetchedMask, the executor
+// scan converts the path once, against the draw's whole clip, and tiles only blit the rows they
+// cover, so edges are built and sorted once per path instead of once per tile.
+class SkThreadedBMPDevice::PrefetchedDeltas {
+public:
+    PrefetchedDeltas(SkPath devPath, std::shared_ptr<const SkRasterClip> clip,
+                     const SkPaint& paint)
+        : fDevPath(std::move(devPath))
+        , fClip(std::move(clip))
+        , fPaint(paint) {}
+
+    void render() {
+        fOnce([this] {
+            SkNullBlitter nullBlitter;
+            SkScan::AntiFillPath(fDevPath, *fClip, &nullBlitter, &fRecord);
+        });
+    }
+
+    // Returns false if the tile has to draw the original way.
+    bool blit(const SkDraw& tile) {
+        this->render();
+        // The scan converter doesn't record anything when it returns early, e.g. for a rect.
+        if (SkDAARecord::Type::kMask != fRecord.fType &&
+            SkDAARecord::Type::kList != fRecord.fType) {
+            return false;
+        }
+        SkAutoBlitterChoose blitter(tile, nullptr, fPaint);
+        SkScan::AntiFillPath(fDevPath, *tile.fRC, blitter.get(), &fRecord);
+        return true;
+    }
+
+private:
+    const SkPath                        fDevPath;
+    std::shared_ptr<const SkRasterClip> fClip;
+    const SkPaint                       fPaint;
+
+    SkOnce                              fOnce;
+    SkArenaAlloc                        fAlloc{4096};
+    SkDAARecord                         fRecord{&fAlloc};
+};
+
+SkThreadedBMPDevice::SkThreadedBMPDevice(const SkBitmap& bitmap, int tiles, int threads,
+                                         SkExecutor* executor)
+        : INHERITED(bitmap)
+        , fExecutor(executor) {
+    if (!fExecutor) {
+        fInternalExecutor = SkExecutor::MakeFIFOThreadPool(threads);
+        fExecutor = fInternalExecutor.get();
+    }
+
+    // Horizontal strips keep each tile's scanlines contiguous for the scan converters.
+    tiles = SkTMax(1, SkTMin(tiles, bitmap.height()));
+    for (int i = 0; i < tiles; ++i) {
+        int top    = bitmap.height() *  i      / tiles,
+            bottom = bitmap.height() * (i + 1) / tiles;
+        fTileBounds.push_back(SkIRect::MakeLTRB(0, top, bitmap.width(), bottom));
+    }
+}
+
+SkThreadedBMPDevice::DrawElement* SkThreadedBMPDevice::recordDraw(const SkRect* localBounds,
+                                                                  DrawFn fn) {
+    SkIRect devBounds = fRCStack.rc().getBounds();
+    if (localBounds) {
+        // Like SkDrawTiler, round out first and only then intersect with the clip.
+        if (!devBounds.intersect(this->ctm().mapRect(*localBounds).roundOut())) {
+            return nullptr;
+        }
+    }
+    return this->recordDrawInDeviceSpace(devBounds, std::move(fn));
+}
+
+SkThreadedBMPDevice::DrawElement* SkThreadedBMPDevice::recordDrawInDeviceSpace(
+        const SkIRect& devBounds, DrawFn fn) {
+    const SkRasterClip& rc = fRCStack.rc();
+    if (rc.isEmpty() || !SkIRect::Intersects(devBounds, rc.getBounds())) {
+        return nullptr;
+    }
+    if (!fClip) {
+        fClip = std::make_shared<const SkRasterClip>(rc);
+    }
+
+    SkMatrix matrix = this->ctm();
+    (void)matrix.getType();  // SkMatrix::getType() isn't thread safe unless we precache it.
+    return &fQueue.push_back(DrawElement{devBounds, matrix, fClip, std::move(fn),
+                                         nullptr, nullptr});
+}
+
+void SkThreadedBMPDevice::prefetchMask(DrawElement* element, const SkPaint& paint,
+                                       MaskFn maskFn) {
+    SkPixmap dst;
+    if (!INHERITED::onAccessPixels(&dst)) {
+        return;
+    }
+    auto mask = std::make_shared<PrefetchedMask>(dst, *element, paint, std::move(maskFn));
+    element->fMask = mask;
+    fExecutor->add([mask] { mask->render(); });
+}
+
+void SkThreadedBMPDevice::prefetchDeltas(DrawElement* element, const SkPath& path,
+                                         const SkPaint& paint) {
+    // This is the device space path SkDraw::drawPath() would scan convert for a plain fill.
+    SkPath devPath;
+    path.transform(element->fMatrix, &devPath);
+    SkPathPriv::SetIsBadForDAA(devPath, SkPathPriv::IsBadForDAA(path));
+    devPath.updateBoundsCache();
+    if (SkPathPriv::TooBigForMath(devPath) ||
+        !SkScan::ShouldUseDAA(devPath, element->fClip->getBounds())) {
+        return;
+    }
+    auto deltas = std::make_shared<PrefetchedDeltas>(std::move(devPath), element->fClip, paint);
+    element->fDeltas = deltas;
+    fExecutor->add([deltas] { deltas->render(); });
+}
+
+void SkThreadedBMPDevice::flush() {
+    if (fQueue.empty()) {
+        return;
+    }
+
+    SkPixmap dst;
+    if (!INHERITED::onAccessPixels(&dst)) {
+        fQueue.reset();
+        return;
+    }
+
+    SkTaskGroup tg(*fExecutor);
+    tg.batch(fTileBounds.count(), [this, &dst](int i) {
+        const SkIRect& tile = fTileBounds[i];
+        for (const DrawElement& element : fQueue) {
+            if (!SkIRect::Intersects(element.fDrawBounds, tile)) {
+                continue;
+            }
+            SkRasterClip tileRC(*element.fClip);
+            if (!tileRC.op(tile, SkRegion::kIntersect_Op)) {
+                continue;
+            }
+            SkDraw draw;
+            draw.fDst    = dst;
+            draw.fMatrix = &element.fMatrix;
+            draw.fRC     = &tileRC;
+            if (element.fMask && element.fMask->blit(draw)) {
+                continue;
+            }
+            if (element.fDeltas && element.fDeltas->blit(draw)) {
+                continue;
+            }
+            element.fDrawFn(draw);
+        }
+    });
+    tg.wait();
+
+    fQueue.reset();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static const SkRect* fast_bounds(const SkRect& r, const SkPaint& paint, SkRect* storage) {
+    if (!paint.canComputeFastBounds()) {
+        return nullptr;
+    }
+    *storage = paint.computeFastBounds(r, storage);
+    return storage;
+}
+
+void SkThreadedBMPDevice::drawPaint(const SkPaint& paint) {
+    this->recordDraw(nullptr, [paint](const SkDraw& draw) {
+        draw.drawPaint(paint);
+    });
+}
+
+void SkThreadedBMPDevice::drawPoints(SkCanvas::PointMode mode, size_t count,
+                                     const SkPoint pts[], const SkPaint& paint) {
+    std::vector<SkPoint> points(pts, pts + count);
+    this->recordDraw(nullptr, [mode, points, paint](const SkDraw& draw) {
+        draw.drawPoints(mode, points.size(), points.data(), paint, nullptr);
+    });
+}
+
+void SkThreadedBMPDevice::drawRect(const SkRect& r, const SkPaint& paint) {
+    SkRect storage;
+    this->recordDraw(fast_bounds(r, paint, &storage), [r, paint](const SkDraw& draw) {
+        draw.drawRect(r, paint);
+    });
+}
+
+void SkThreadedBMPDevice::drawRRect(const SkRRect& rrect, const SkPaint& paint) {
+    SkRect storage;
+    this->recordDraw(fast_bounds(rrect.getBounds(), paint, &storage),
+                     [rrect, paint](const SkDraw& draw) {
+        draw.drawRRect(rrect, paint);
+    });
+}
+
+void SkThreadedBMPDevice::drawPath(const SkPath& path, const SkPaint& paint, bool) {
+    // Every tile draws from the same copy, so we can't let any of them mutate it,
+    // and SkPath::getBounds() isn't thread safe unless we precache the bounds here.
+    SkPath copy(path);
+    copy.updateBoundsCache();
+    (void)copy.getGenerationID();
+
+    SkRect storage;
+    const SkRect* bounds = copy.isInverseFillType() ? nullptr
+                                                    : fast_bounds(copy.getBounds(), paint, &storage);
+    DrawElement* element = this->recordDraw(bounds, [copy, paint](const SkDraw& draw) {
+        draw.drawPath(copy, paint, nullptr, false);
+    });
+
+    // Pieces of a mask can only be re-clipped to a tile by rectangles, so the clip must be BW.
+    // Strokes may be drawn as hairlines with a modulated alpha, which the mask wouldn't know.
+    if (element && paint.getMaskFilter() && !copy.isInverseFillType() &&
+        SkPaint::kFill_Style == paint.getStyle() && !paint.getPathEffect() &&
+        element->fClip->isBW()) {
+        this->prefetchMask(element, paint, [copy, paint](const SkDraw& draw, SkBlitter* blitter) {
+            draw.drawPathCoverage(copy, paint, blitter);
+        });
+    } else if (element && paint.isAntiAlias() && !paint.getMaskFilter() &&
+               SkPaint::kFill_Style == paint.getStyle() && !paint.getPathEffect()) {
+        this->prefetchDeltas(element, copy, paint);
+    }
+}
+
+void SkThreadedBMPDevice::drawSprite(const SkBitmap& bitmap, int x, int y, const SkPaint& paint) {
+    // Sprites are positioned in device space, ignoring the CTM.
+    SkRect storage;
+    const SkRect* bounds = fast_bounds(SkRect::MakeXYWH(x, y, bitmap.width(), bitmap.height()),
+                                       paint, &storage);
+    SkIRect devBounds = bounds ? bounds->roundOut() : fRCStack.rc().getBounds();
+    this->recordDrawInDeviceSpace(devBounds, [bitmap, x, y, paint](const SkDraw& draw) {
+        draw.drawSprite(bitmap, x, y, paint);
+    });
+}
+
+void SkThreadedBMPDevice::drawBitmap(const SkBitmap& bitmap, const SkMatrix& matrix,
+                                     const SkRect* dstOrNull, const SkPaint& paint) {
+    SkRect dst = dstOrNull ? *dstOrNull
+                           : matrix.mapRect(SkRect::MakeIWH(bitmap.width(), bitmap.height()));
+    bool hasDst = dstOrNull != nullptr;
+
+    SkMatrix typedMatrix = matrix;
+    (void)typedMatrix.getType();
+
+    SkRect storage;
+    this->recordDraw(fast_bounds(dst, paint, &storage),
+                     [bitmap, typedMatrix, hasDst, dst, paint](const SkDraw& draw) {
+        draw.drawBitmap(bitmap, typedMatrix, hasDst ? &dst : nullptr, paint);
+    });
+}
+
+void SkThreadedBMPDevice::drawVertices(const SkVertices* vertices, const SkVertices::Bone bones[],
+                                       int boneCount, SkBlendMode bmode, const SkPaint& paint) {
+    sk_sp<const SkVertices> verts = sk_ref_sp(vertices);
+    std::vector<SkVertices::Bone> boneCopy(bones, bones + boneCount);
+    this->recordDraw(&vertices->bounds(), [verts, boneCopy, bmode, paint](const SkDraw& draw) {
+        draw.drawVertices(verts->mode(), verts->vertexCount(), verts->positions(),
+                          verts->texCoords(), verts->colors(), verts->boneIndices(),
+                          verts->boneWeights(), bmode, verts->indices(), verts->indexCount(),
+                          paint, boneCopy.data(), boneCopy.size());
+    });
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Everything below either reads back our pixels or draws through paths we don't defer,
+// so we flush and let SkBitmapDevice handle it on this thread.
+
+void SkThreadedBMPDevice::drawGlyphRunList(const SkGlyphRunList& glyphRunList) {
+    this->flush();
+    INHERITED::drawGlyphRunList(glyphRunList);
+}
+
+void SkThreadedBMPDevice::drawDevice(SkBaseDevice* device, int x, int y, const SkPaint& paint) {
+    this->flush();
+    INHERITED::drawDevice(device, x, y, paint);
+}
+
+void SkThreadedBMPDevice::drawSpecial(SkSpecialImage* src, int x, int y, const SkPaint& paint,
+                                      SkImage* clipImage, const SkMatrix& clipMatrix) {
+    this->flush();
+    INHERITED::drawSpecial(src, x, y, paint, clipImage, clipMatrix);
+}
+
+sk_sp<SkSpecialImage> SkThreadedBMPDevice::snapSpecial() {
+    this->flush();
+    return INHERITED::snapSpecial();
+}
+
+sk_sp<SkSpecialImage> SkThreadedBMPDevice::snapSpecialSubset(const SkIRect& subset) {
+    this->flush();
+    return INHERITED::snapSpecialSubset(subset);
+}
+
+sk_sp<SkSpecialImage> SkThreadedBMPDevice::snapBackImage(const SkIRect& bounds) {
+    this->flush();
+    return INHERITED::snapBackImage(bounds);
+}
+
+bool SkThreadedBMPDevice::onReadPixels(const SkPixmap& pm, int x, int y) {
+    this->flush();
+    return INHERITED::onReadPixels(pm, x, y);
+}
+
+bool SkThreadedBMPDevice::onWritePixels(const SkPixmap& pm, int x, int y) {
+    this->flush();
+    return INHERITED::onWritePixels(pm, x, y);
+}
+
+bool SkThreadedBMPDevice::onPeekPixels(SkPixmap* pmap) {
+    this->flush();
+    return INHERITED::onPeekPixels(pmap);
+}
+
+bool SkThreadedBMPDevice::onAccessPixels(SkPixmap* pmap) {
+    this->flush();
+    return INHERITED::onAccessPixels(pmap);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Queued draws hold on to the clip they were recorded with, so any change to the clip
+// just means the next draw needs a fresh snapshot.
+
+void SkThreadedBMPDevice::onRestore() {
+    INHERITED::onRestore();
+    fClip.reset();
+}
+
+void SkThreadedBMPDevice::onClipRect(const SkRect& rect, SkClipOp op, bool aa) {
+    INHERITED::onClipRect(rect, op, aa);
+    fClip.reset();
+}
+
+void SkThreadedBMPDevice::onClipRRect(const SkRRect& rrect, SkClipOp op, bool aa) {
+    INHERITED::onClipRRect(rrect, op, aa);
+    fClip.reset();
+}
+
+void SkThreadedBMPDevice::onClipPath(const SkPath& path, SkClipOp op, bool aa) {
+    INHERITED::onClipPath(path, op, aa);
+    fClip.reset();
+}
+
+void SkThreadedBMPDevice::onClipRegion(const SkRegion& deviceRgn, SkClipOp op) {
+    INHERITED::onClipRegion(deviceRgn, op);
+    fClip.reset();
+}
+
+void SkThreadedBMPDevice::onSetDeviceClipRestriction(SkIRect* mutableClipRestriction) {
+    INHERITED::onSetDeviceClipRestriction(mutableClipRestriction);
+    fClip.reset();
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkThreadedBMPDevice_DEFINED
+#define SkThreadedBMPDevice_DEFINED
+
+#include "SkBitmapDevice.h"
+#include "SkDraw.h"
+#include "SkExecutor.h"
+#include "SkTArray.h"
+
+#include <functional>
+#include <memory>
+
+// An SkBitmapDevice that defers its draws and rasterizes them in parallel.
+//
+// The device is split into horizontal tiles.  Each draw is recorded along with its matrix, clip
+// and device-space bounds, and on flush() every tile replays, in order, the draws that touch it,
+// clipped to the tile.  Tiles never share pixels, so they can all be rasterized at once.
+//
+// Paths with a mask filter start rendering their filtered mask on the executor as soon as they're
+// recorded, against the whole clip, and each tile just blits its part of it at flush time.
+// Antialiased fills that the scan converter would render with DAA (see gSkUseDeltaAA) do the
+// same with their coverage deltas.
+//
+// Draws that read back from the device (text, layers, image filters, pixel access, ...) first
+// flush and then fall back to the single-threaded SkBitmapDevice implementation.
+class SkThreadedBMPDevice : public SkBitmapDevice {
+public:
+    // When executor is null, we create and own a thread pool with the given number of threads
+    // (0 means one per core).  Otherwise the executor must outlive this device.
+    SkThreadedBMPDevice(const SkBitmap& bitmap, int tiles, int threads = 0,
+                        SkExecutor* executor = nullptr);
+    ~SkThreadedBMPDevice() override { this->flush(); }
+
+    void flush() override;
+
+protected:
+    void drawPaint(const SkPaint& paint) override;
+    void drawPoints(SkCanvas::PointMode mode, size_t count,
+                    const SkPoint[], const SkPaint& paint) override;
+    void drawRect(const SkRect& r, const SkPaint& paint) override;
+    void drawRRect(const SkRRect& rr, const SkPaint& paint) override;
+    void drawPath(const SkPath&, const SkPaint&, bool pathIsMutable) override;
+    void drawSprite(const SkBitmap&, int x, int y, const SkPaint&) override;
+    void drawBitmap(const SkBitmap&, const SkMatrix&, const SkRect* dstOrNull,
+                    const SkPaint&) override;
+    void drawVertices(const SkVertices*, const SkVertices::Bone bones[], int boneCount, SkBlendMode,
+                      const SkPaint& paint) override;
+
+    void drawGlyphRunList(const SkGlyphRunList& glyphRunList) override;
+    void drawDevice(SkBaseDevice*, int x, int y, const SkPaint&) override;
+    void drawSpecial(SkSpecialImage*, int x, int y, const SkPaint&,
+                     SkImage*, const SkMatrix&) override;
+
+    sk_sp<SkSpecialImage> snapSpecial() override;
+    sk_sp<SkSpecialImage> snapSpecialSubset(const SkIRect&) override;
+    sk_sp<SkSpecialImage> snapBackImage(const SkIRect&) override;
+
+    bool onReadPixels(const SkPixmap&, int x, int y) override;
+    bool onWritePixels(const SkPixmap&, int, int) override;
+    bool onPeekPixels(SkPixmap*) override;
+    bool onAccessPixels(SkPixmap*) override;
+
+    void onRestore() override;
+    void onClipRect(const SkRect& rect, SkClipOp, bool aa) override;
+    void onClipRRect(const SkRRect& rrect, SkClipOp, bool aa) override;
+    void onClipPath(const SkPath& path, SkClipOp, bool aa) override;
+    void onClipRegion(const SkRegion& deviceRgn, SkClipOp) override;
+    void onSetDeviceClipRestriction(SkIRect* mutableClipRestriction) override;
+
+private:
+    using DrawFn = std::function<void(const SkDraw&)>;
+    using MaskFn = std::function<void(const SkDraw&, SkBlitter*)>;
+
+    class PrefetchedDeltas;
+    class PrefetchedMask;
+
+    struct DrawElement {
+        SkIRect                             fDrawBounds;  // in device space, already clipped
+        SkMatrix                            fMatrix;
+        std::shared_ptr<const SkRasterClip> fClip;
+        DrawFn                              fDrawFn;
+        std::shared_ptr<PrefetchedMask>     fMask;        // if not null, blitted instead
+        std::shared_ptr<PrefetchedDeltas>   fDeltas;      // ditto
+    };
+
+    // localBounds is in local coordinates; null means the draw may touch the whole clip.
+    // Both return the queued draw, or null if it was clipped out.
+    DrawElement* recordDraw(const SkRect* localBounds, DrawFn);
+    DrawElement* recordDrawInDeviceSpace(const SkIRect& devBounds, DrawFn);
+
+    // Starts rendering the element's mask on the executor.  maskFn must send the draw's
+    // coverage, with its mask filter applied, to the blitter it's given.
+    void prefetchMask(DrawElement*, const SkPaint&, MaskFn maskFn);
+
+    // Starts computing the coverage deltas of the element's antialiased fill on the executor,
+    // if the scan converter would draw it with DAA.
+    void prefetchDeltas(DrawElement*, const SkPath&, const SkPaint&);
+
+    std::unique_ptr<SkExecutor>         fInternalExecutor;
+    SkExecutor*                         fExecutor;
+    SkTArray<SkIRect>                   fTileBounds;
+    SkTArray<DrawElement>               fQueue;
+
+    // The clip is snapshotted lazily, and shared by every queued draw until it changes again.
+    std::shared_ptr<const SkRasterClip> fClip;
+
+    typedef SkBitmapDevice INHERITED;
+};
+
+#endif // SkThreadedBMPDevice_DEFINED
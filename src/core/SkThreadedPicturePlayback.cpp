@@ -0,0 +1,86 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkThreadedPicturePlayback.h"
+
+#include "SkBBoxHierarchy.h"
+#include "SkBigPicture.h"
+#include "SkBitmap.h"
+#include "SkCanvas.h"
+#include "SkPicturePriv.h"
+#include "SkPixmap.h"
+#include "SkTaskGroup.h"
+
+// The BBH was built in picture space, so this is the same query SkRecordDraw will make
+// when playing back into a canvas clipped to tile.
+static bool tile_has_ops(const SkBBoxHierarchy* bbh, const SkMatrix& inverse,
+                         const SkIRect& tile) {
+    if (!bbh) {
+        return true;
+    }
+    SkTDArray<int> ops;
+    bbh->search(inverse.mapRect(SkRect::Make(tile)), &ops);
+    return !ops.isEmpty();
+}
+
+void SkThreadedPicturePlayback(const SkPicture* picture, SkCanvas* canvas, SkExecutor* executor,
+                               int tileW, int tileH) {
+    SkASSERT(picture && canvas && executor);
+    SkASSERT(tileW > 0 && tileH > 0);
+
+    // We can only draw from other threads directly into the base layer's pixels.
+    SkPixmap base;
+    SkImageInfo topInfo;
+    size_t topRowBytes;
+    if (!canvas->peekPixels(&base) ||
+        canvas->accessTopLayerPixels(&topInfo, &topRowBytes) != base.addr() ||
+        !canvas->isClipRect()) {
+        picture->playback(canvas);
+        return;
+    }
+
+    const SkMatrix ctm = canvas->getTotalMatrix();
+    SkMatrix inverse;
+    SkIRect bounds = canvas->getDeviceClipBounds();
+    if (!ctm.invert(&inverse) ||
+        !bounds.intersect(ctm.mapRect(picture->cullRect()).roundOut()) ||
+        !bounds.intersect(base.bounds())) {
+        return;
+    }
+
+    const SkBigPicture* big = SkPicturePriv::AsSkBigPicture(sk_ref_sp(picture));
+    const SkBBoxHierarchy* bbh = big ? big->bbh() : nullptr;
+
+    SkTArray<SkIRect> tiles;
+    for (int y = bounds.fTop; y < bounds.fBottom; y += tileH) {
+        for (int x = bounds.fLeft; x < bounds.fRight; x += tileW) {
+            SkIRect tile = SkIRect::MakeXYWH(x, y, tileW, tileH);
+            SkAssertResult(tile.intersect(bounds));
+            if (tile_has_ops(bbh, inverse, tile)) {
+                tiles.push_back(tile);
+            }
+        }
+    }
+
+    SkTaskGroup tg(*executor);
+    tg.batch(tiles.count(), [&](int i) {
+        const SkIRect& tile = tiles[i];
+
+        SkPixmap pixels;
+        SkAssertResult(base.extractSubset(&pixels, tile));
+        SkBitmap bitmap;
+        if (!bitmap.installPixels(pixels)) {
+            return;
+        }
+
+        SkCanvas tileCanvas(bitmap);
+        tileCanvas.translate(-SkIntToScalar(tile.fLeft), -SkIntToScalar(tile.fTop));
+        tileCanvas.concat(ctm);
+        picture->playback(&tileCanvas);
+    });
+    tg.wait();
+}
@@ -0,0 +1,30 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkThreadedPicturePlayback_DEFINED
+#define SkThreadedPicturePlayback_DEFINED
+
+#include "SkTypes.h"
+
+class SkCanvas;
+class SkExecutor;
+class SkPicture;
+
+// Play back an SkPicture into a raster canvas using the executor's threads.
+//
+// The canvas' device clip is split into tileW x tileH tiles.  Each tile gets its own canvas
+// over the shared pixels, clipped to the tile, and they are played back concurrently.  When the
+// picture has an SkBBoxHierarchy, tiles that no op touches are skipped entirely, and each tile's
+// playback only visits the ops that intersect it.  Tiles never share pixels, so the result is
+// the same as picture->playback(canvas).
+//
+// Falls back to serial playback when the canvas isn't a raster canvas we can tile safely: no
+// directly accessible pixels, an active layer, or a clip that isn't a rectangle.
+void SkThreadedPicturePlayback(const SkPicture*, SkCanvas*, SkExecutor*,
+                               int tileW = 256, int tileH = 256);
+
+#endif//SkThreadedPicturePlayback_DEFINED
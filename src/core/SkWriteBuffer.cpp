@@ -18,21 +18,36 @@
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Data at least this big is kept by reference instead of being copied into fWriter.
+static constexpr size_t kMinSpliceBytes = 1024;
+
 SkBinaryWriteBuffer::SkBinaryWriteBuffer()
     : fFactorySet(nullptr)
-    , fTFSet(nullptr) {
+    , fTFSet(nullptr)
+    , fCanSplice(true) {
 }
 
 SkBinaryWriteBuffer::SkBinaryWriteBuffer(void* storage, size_t storageSize)
     : fFactorySet(nullptr)
     , fTFSet(nullptr)
     , fWriter(storage, storageSize)
+    , fCanSplice(!storage)
 {}
 
 SkBinaryWriteBuffer::~SkBinaryWriteBuffer() {}
 
 bool SkBinaryWriteBuffer::usingInitialStorage() const {
-    return fWriter.usingInitialStorage();
+    return fWriter.usingInitialStorage() && fSplices.empty();
+}
+
+void SkBinaryWriteBuffer::writeDataPad32(sk_sp<SkData> data) {
+    const size_t size = data->size();
+    if (!fCanSplice || size < kMinSpliceBytes) {
+        this->writePad32(data->data(), size);
+        return;
+    }
+    fSplices.push_back({fWriter.bytesWritten(), std::move(data)});
+    fSplicedBytes += SkAlign4(size);
 }
 
 void SkBinaryWriteBuffer::writeByteArray(const void* data, size_t size) {
@@ -132,7 +147,35 @@ size_t SkBinaryWriteBuffer::writeStream(SkStream* stream, size_t length) {
 }
 
 bool SkBinaryWriteBuffer::writeToStream(SkWStream* stream) const {
-    return fWriter.writeToStream(stream);
+    const char* written = static_cast<const char*>(fWriter.data());
+    size_t offset = 0;
+    for (const Splice& splice : fSplices) {
+        const uint32_t zero = 0;
+        const size_t size = splice.fData->size();
+        if (!stream->write(written + offset, splice.fOffset - offset) ||
+            !stream->writeData(splice.fData) ||
+            !stream->write(&zero, SkAlign4(size) - size)) {
+            return false;
+        }
+        offset = splice.fOffset;
+    }
+    return stream->write(written + offset, fWriter.bytesWritten() - offset);
+}
+
+void SkBinaryWriteBuffer::writeToMemory(void* dst) const {
+    const char* written = static_cast<const char*>(fWriter.data());
+    char* out = static_cast<char*>(dst);
+    size_t offset = 0;
+    for (const Splice& splice : fSplices) {
+        const size_t size = splice.fData->size();
+        memcpy(out, written + offset, splice.fOffset - offset);
+        out += splice.fOffset - offset;
+        memcpy(out, splice.fData->data(), size);
+        memset(out + size, 0, SkAlign4(size) - size);
+        out += SkAlign4(size);
+        offset = splice.fOffset;
+    }
+    memcpy(out, written + offset, fWriter.bytesWritten() - offset);
 }
 
 /*  Format:
@@ -158,7 +201,7 @@ void SkBinaryWriteBuffer::writeImage(const SkImage* image) {
     }
     this->write32(SkToS32(size));   // writing 0 signals failure
     if (size) {
-        this->writePad32(data->data(), size);
+        this->writeDataPad32(std::move(data));
     }
 }
 
@@ -180,7 +223,7 @@ void SkBinaryWriteBuffer::writeTypeface(SkTypeface* obj) {
             int32_t ssize = SkToS32(size);
             fWriter.write32(-ssize);    // negative to signal custom
             if (size) {
-                this->writePad32(data->data(), size);
+                this->writeDataPad32(std::move(data));
             }
             return;
         }
@@ -251,10 +294,11 @@ void SkBinaryWriteBuffer::writeFlattenable(const SkFlattenable* flattenable) {
     // make room for the size of the flattened object
     (void)fWriter.reserve(sizeof(uint32_t));
     // record the current size, so we can subtract after the object writes.
-    size_t offset = fWriter.bytesWritten();
+    size_t offset = fWriter.bytesWritten(),
+           spliced = fSplicedBytes;
     // now flatten the object
     flattenable->flatten(*this);
-    size_t objSize = fWriter.bytesWritten() - offset;
+    size_t objSize = fWriter.bytesWritten() - offset + (fSplicedBytes - spliced);
     // record the obj's size
     fWriter.overwriteTAt(offset - sizeof(uint32_t), SkToU32(objSize));
 }
@@ -12,6 +12,7 @@
 #include "SkFlattenable.h"
 #include "SkSerialProcs.h"
 #include "SkWriter32.h"
+#include "../private/SkTArray.h"
 #include "../private/SkTHash.h"
 
 class SkFactorySet;
@@ -85,9 +86,12 @@ public:
 
     void reset(void* storage = nullptr, size_t storageSize = 0) {
         fWriter.reset(storage, storageSize);
+        fSplices.reset();
+        fSplicedBytes = 0;
+        fCanSplice = !storage;
     }
 
-    size_t bytesWritten() const { return fWriter.bytesWritten(); }
+    size_t bytesWritten() const { return fWriter.bytesWritten() + fSplicedBytes; }
 
     // Returns true iff all of the bytes written so far are stored in the initial storage
     // buffer provided in the constructor or the most recent call to reset.
@@ -120,18 +124,33 @@ public:
     void writeTypeface(SkTypeface* typeface) override;
     void writePaint(const SkPaint& paint) override;
 
+    /** Large SkData, like encoded images, is passed on to the stream with SkWStream::writeData(),
+        so streams that keep data by reference never copy it. */
     bool writeToStream(SkWStream*) const;
-    void writeToMemory(void* dst) const { fWriter.flatten(dst); }
+    void writeToMemory(void* dst) const;
 
     void setFactoryRecorder(sk_sp<SkFactorySet>);
     void setTypefaceRecorder(sk_sp<SkRefCntSet>);
 
 private:
+    // Writes data padded to 4 bytes.  Unless we were given storage to write into, large data is
+    // kept by reference and only copied out by writeToMemory() or writeToStream().
+    void writeDataPad32(sk_sp<SkData> data);
+
     sk_sp<SkFactorySet> fFactorySet;
     sk_sp<SkRefCntSet> fTFSet;
 
     SkWriter32 fWriter;
 
+    // Data that belongs at fOffset in fWriter's bytes, followed by zeros to pad it to 4 bytes.
+    struct Splice {
+        size_t        fOffset;
+        sk_sp<SkData> fData;
+    };
+    SkTArray<Splice> fSplices;
+    size_t           fSplicedBytes = 0;  // Including padding.
+    bool             fCanSplice;
+
     // Only used if we do not have an fFactorySet
     SkTHashMap<SkFlattenable::Factory, uint32_t> fFlattenableDict;
 };
@@ -237,6 +237,9 @@ public:
         return stream->write(fData, fUsed);
     }
 
+    // The bytes written so far, valid until the next write or reset.
+    const void* data() const { return fData; }
+
     // read from the stream, and write up to length bytes. Return the actual
     // number of bytes written.
     size_t readFromStream(SkStream* stream, size_t length) {
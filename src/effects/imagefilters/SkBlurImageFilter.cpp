@@ -493,13 +493,21 @@ static sk_sp<SkSpecialImage> cpu_blur(
         return nullptr;
     }
 
-    auto bufferSizeW = calculate_buffer(windowW),
-         bufferSizeH = calculate_buffer(windowH);
-
-    // The amount 1024 is enough for buffers up to 10 sigma. The tmp bitmap will be
-    // allocated on the heap.
-    SkSTArenaAlloc<1024> alloc;
-    Sk4u* buffer = alloc.makeArrayDefault<Sk4u>(std::max(bufferSizeW, bufferSizeH));
+    // Each line of a pass is blurred independently of the others, so a pass can be split into
+    // bands of lines, each with its own buffer. The amount 1024 is enough for buffers up to
+    // 10 sigma. Larger buffers will be allocated on the heap.
+    auto blur_bands = [](int window, int srcLeft, int srcRight, int dstRight,
+                         const uint32_t* src, int srcXStride, int srcYStride, int srcH,
+                               uint32_t* dst, int dstXStride, int dstYStride) {
+        SkImageFilterForEachBand(srcH, dstRight, [&](int start, int end) {
+            SkSTArenaAlloc<1024> alloc;
+            Sk4u* buffer = alloc.makeArrayDefault<Sk4u>(calculate_buffer(window));
+            blur_one_direction(buffer, window, srcLeft, srcRight, dstRight,
+                               src + (int64_t)start * srcYStride, srcXStride, srcYStride,
+                               end - start,
+                               dst + (int64_t)start * dstYStride, dstXStride, dstYStride);
+        });
+    };
 
     // Basic Plan: The three cases to handle
     // * Horizontal and Vertical - blur horizontally while copying values from the source to
@@ -541,16 +549,16 @@ static sk_sp<SkSpecialImage> cpu_blur(
         intermediateWidth = dstW;
         intermediateDst = static_cast<uint32_t *>(dst.getPixels());
 
-        blur_one_direction(
-                buffer, windowW,
+        blur_bands(
+                windowW,
                 srcBounds.left(), srcBounds.right(), dstBounds.right(),
                 static_cast<uint32_t *>(src.getPixels()), 1, src.rowBytesAsPixels(), srcH,
                 intermediateSrc, 1, intermediateRowBytesAsPixels);
     }
 
     if (windowH > 1) {
-        blur_one_direction(
-                buffer, windowH,
+        blur_bands(
+                windowH,
                 srcBounds.top(), srcBounds.bottom(), dstBounds.bottom(),
                 intermediateSrc, intermediateRowBytesAsPixels, 1, intermediateWidth,
                 intermediateDst, dst.rowBytesAsPixels(), 1);
@@ -289,12 +289,11 @@ static void lightBitmap(const BaseLightingType& lightingType,
                  const SkIRect& bounds) {
     SkASSERT(dst->width() == bounds.width() && dst->height() == bounds.height());
     int left = bounds.left(), right = bounds.right();
-    int bottom = bounds.bottom();
-    int y = bounds.top();
+    int top = bounds.top(), bottom = bounds.bottom();
     SkIRect srcBounds = src.bounds();
-    SkPMColor* dptr = dst->getAddr32(0, 0);
     {
-        int x = left;
+        int x = left, y = top;
+        SkPMColor* dptr = dst->getAddr32(0, 0);
         int m[9];
         m[4] = PixelFetcher::Fetch(src, x,     y,     srcBounds);
         m[5] = PixelFetcher::Fetch(src, x + 1, y,     srcBounds);
@@ -318,35 +317,41 @@ static void lightBitmap(const BaseLightingType& lightingType,
                                      l->lightColor(surfaceToLight));
     }
 
-    for (++y; y < bottom - 1; ++y) {
-        int x = left;
-        int m[9];
-        m[1] = PixelFetcher::Fetch(src, x,     y - 1, srcBounds);
-        m[2] = PixelFetcher::Fetch(src, x + 1, y - 1, srcBounds);
-        m[4] = PixelFetcher::Fetch(src, x,     y,     srcBounds);
-        m[5] = PixelFetcher::Fetch(src, x + 1, y,     srcBounds);
-        m[7] = PixelFetcher::Fetch(src, x,     y + 1, srcBounds);
-        m[8] = PixelFetcher::Fetch(src, x + 1, y + 1, srcBounds);
-        SkPoint3 surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
-        *dptr++ = lightingType.light(leftNormal(m, surfaceScale), surfaceToLight,
-                                     l->lightColor(surfaceToLight));
-        for (++x; x < right - 1; ++x) {
-            shiftMatrixLeft(m);
+    // The rows between the first and last each read only the source, so they can be lit in
+    // parallel bands.
+    SkImageFilterForEachBand(bottom - top - 2, right - left, [&](int start, int end) {
+        for (int y = top + 1 + start; y < top + 1 + end; ++y) {
+            SkPMColor* dptr = dst->getAddr32(0, y - top);
+            int x = left;
+            int m[9];
+            m[1] = PixelFetcher::Fetch(src, x,     y - 1, srcBounds);
             m[2] = PixelFetcher::Fetch(src, x + 1, y - 1, srcBounds);
+            m[4] = PixelFetcher::Fetch(src, x,     y,     srcBounds);
             m[5] = PixelFetcher::Fetch(src, x + 1, y,     srcBounds);
+            m[7] = PixelFetcher::Fetch(src, x,     y + 1, srcBounds);
             m[8] = PixelFetcher::Fetch(src, x + 1, y + 1, srcBounds);
+            SkPoint3 surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
+            *dptr++ = lightingType.light(leftNormal(m, surfaceScale), surfaceToLight,
+                                         l->lightColor(surfaceToLight));
+            for (++x; x < right - 1; ++x) {
+                shiftMatrixLeft(m);
+                m[2] = PixelFetcher::Fetch(src, x + 1, y - 1, srcBounds);
+                m[5] = PixelFetcher::Fetch(src, x + 1, y,     srcBounds);
+                m[8] = PixelFetcher::Fetch(src, x + 1, y + 1, srcBounds);
+                surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
+                *dptr++ = lightingType.light(interiorNormal(m, surfaceScale), surfaceToLight,
+                                             l->lightColor(surfaceToLight));
+            }
+            shiftMatrixLeft(m);
             surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
-            *dptr++ = lightingType.light(interiorNormal(m, surfaceScale), surfaceToLight,
+            *dptr++ = lightingType.light(rightNormal(m, surfaceScale), surfaceToLight,
                                          l->lightColor(surfaceToLight));
         }
-        shiftMatrixLeft(m);
-        surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
-        *dptr++ = lightingType.light(rightNormal(m, surfaceScale), surfaceToLight,
-                                     l->lightColor(surfaceToLight));
-    }
+    });
 
     {
-        int x = left;
+        int x = left, y = bottom - 1;
+        SkPMColor* dptr = dst->getAddr32(0, y - top);
         int m[9];
         m[1] = PixelFetcher::Fetch(src, x,     bottom - 2, srcBounds);
         m[2] = PixelFetcher::Fetch(src, x + 1, bottom - 2, srcBounds);
@@ -182,39 +182,45 @@ void SkMatrixConvolutionImageFilter::filterPixels(const SkBitmap& src,
     if (!rect.intersect(bounds)) {
         return;
     }
-    for (int y = rect.fTop; y < rect.fBottom; ++y) {
-        SkPMColor* dptr = result->getAddr32(rect.fLeft - offset.fX, y - offset.fY);
-        for (int x = rect.fLeft; x < rect.fRight; ++x) {
-            SkScalar sumA = 0, sumR = 0, sumG = 0, sumB = 0;
-            for (int cy = 0; cy < fKernelSize.fHeight; cy++) {
-                for (int cx = 0; cx < fKernelSize.fWidth; cx++) {
-                    SkPMColor s = PixelFetcher::fetch(src,
-                                                      x + cx - fKernelOffset.fX,
-                                                      y + cy - fKernelOffset.fY,
-                                                      bounds);
-                    SkScalar k = fKernel[cy * fKernelSize.fWidth + cx];
-                    if (convolveAlpha) {
-                        sumA += SkGetPackedA32(s) * k;
+    // Every output row reads only the source, so the rows can be filtered in parallel bands.
+    // Weight the rows by the kernel taps they read.
+    const int work = (int)SkTMin<int64_t>((int64_t)rect.width() * fKernelSize.fWidth *
+                                          fKernelSize.fHeight, SK_MaxS32);
+    SkImageFilterForEachBand(rect.height(), work, [&](int start, int end) {
+        for (int y = rect.fTop + start; y < rect.fTop + end; ++y) {
+            SkPMColor* dptr = result->getAddr32(rect.fLeft - offset.fX, y - offset.fY);
+            for (int x = rect.fLeft; x < rect.fRight; ++x) {
+                SkScalar sumA = 0, sumR = 0, sumG = 0, sumB = 0;
+                for (int cy = 0; cy < fKernelSize.fHeight; cy++) {
+                    for (int cx = 0; cx < fKernelSize.fWidth; cx++) {
+                        SkPMColor s = PixelFetcher::fetch(src,
+                                                          x + cx - fKernelOffset.fX,
+                                                          y + cy - fKernelOffset.fY,
+                                                          bounds);
+                        SkScalar k = fKernel[cy * fKernelSize.fWidth + cx];
+                        if (convolveAlpha) {
+                            sumA += SkGetPackedA32(s) * k;
+                        }
+                        sumR += SkGetPackedR32(s) * k;
+                        sumG += SkGetPackedG32(s) * k;
+                        sumB += SkGetPackedB32(s) * k;
                     }
-                    sumR += SkGetPackedR32(s) * k;
-                    sumG += SkGetPackedG32(s) * k;
-                    sumB += SkGetPackedB32(s) * k;
                 }
-            }
-            int a = convolveAlpha
-                  ? SkClampMax(SkScalarFloorToInt(sumA * fGain + fBias), 255)
-                  : 255;
-            int r = SkClampMax(SkScalarFloorToInt(sumR * fGain + fBias), a);
-            int g = SkClampMax(SkScalarFloorToInt(sumG * fGain + fBias), a);
-            int b = SkClampMax(SkScalarFloorToInt(sumB * fGain + fBias), a);
-            if (!convolveAlpha) {
-                a = SkGetPackedA32(PixelFetcher::fetch(src, x, y, bounds));
-                *dptr++ = SkPreMultiplyARGB(a, r, g, b);
-            } else {
-                *dptr++ = SkPackARGB32(a, r, g, b);
+                int a = convolveAlpha
+                      ? SkClampMax(SkScalarFloorToInt(sumA * fGain + fBias), 255)
+                      : 255;
+                int r = SkClampMax(SkScalarFloorToInt(sumR * fGain + fBias), a);
+                int g = SkClampMax(SkScalarFloorToInt(sumG * fGain + fBias), a);
+                int b = SkClampMax(SkScalarFloorToInt(sumB * fGain + fBias), a);
+                if (!convolveAlpha) {
+                    a = SkGetPackedA32(PixelFetcher::fetch(src, x, y, bounds));
+                    *dptr++ = SkPreMultiplyARGB(a, r, g, b);
+                } else {
+                    *dptr++ = SkPackARGB32(a, r, g, b);
+                }
             }
         }
-    }
+    });
 }
 
 template<class PixelFetcher>
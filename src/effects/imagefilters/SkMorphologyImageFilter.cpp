@@ -70,20 +70,30 @@ void SkMorphologyImageFilter::flatten(SkWriteBuffer& buffer) const {
     buffer.writeInt(fRadius.fHeight);
 }
 
+// Each of the procs' output lines only reads the matching source line, so the lines can be
+// split into bands. X passes band rows; Y passes band columns.
 static void call_proc_X(SkMorphologyImageFilter::Proc procX,
                         const SkBitmap& src, SkBitmap* dst,
                         int radiusX, const SkIRect& bounds) {
-    procX(src.getAddr32(bounds.left(), bounds.top()), dst->getAddr32(0, 0),
-          radiusX, bounds.width(), bounds.height(),
-          src.rowBytesAsPixels(), dst->rowBytesAsPixels());
+    const SkPMColor* srcAddr = src.getAddr32(bounds.left(), bounds.top());
+    SkPMColor* dstAddr = dst->getAddr32(0, 0);
+    const int srcStride = src.rowBytesAsPixels(),
+              dstStride = dst->rowBytesAsPixels();
+    SkImageFilterForEachBand(bounds.height(), bounds.width(), [&](int start, int end) {
+        procX(srcAddr + (size_t)start * srcStride, dstAddr + (size_t)start * dstStride,
+              radiusX, bounds.width(), end - start, srcStride, dstStride);
+    });
 }
 
 static void call_proc_Y(SkMorphologyImageFilter::Proc procY,
                         const SkPMColor* src, int srcRowBytesAsPixels, SkBitmap* dst,
                         int radiusY, const SkIRect& bounds) {
-    procY(src, dst->getAddr32(0, 0),
-          radiusY, bounds.height(), bounds.width(),
-          srcRowBytesAsPixels, dst->rowBytesAsPixels());
+    SkPMColor* dstAddr = dst->getAddr32(0, 0);
+    const int dstStride = dst->rowBytesAsPixels();
+    SkImageFilterForEachBand(bounds.width(), bounds.height(), [&](int start, int end) {
+        procY(src + start, dstAddr + start,
+              radiusY, bounds.height(), end - start, srcRowBytesAsPixels, dstStride);
+    });
 }
 
 SkRect SkMorphologyImageFilter::computeFastBounds(const SkRect& src) const {
@@ -0,0 +1,56 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrAsyncReadbackQueue.h"
+
+#include "GrGpu.h"
+
+void GrAsyncReadbackQueue::add(GrFence fence, sk_sp<GrGpuBuffer> buffer, size_t rowBytes,
+                               SkSurface::ReadPixelsCallback callback,
+                               SkSurface::ReadPixelsContext context) {
+    SkASSERT(buffer);
+    SkASSERT(callback);
+    fReadbacks.push_back({fence, std::move(buffer), rowBytes, callback, context});
+}
+
+void GrAsyncReadbackQueue::process(GrGpu* gpu) {
+    SkASSERT(gpu);
+    int numDone = 0;
+    while (numDone < fReadbacks.count() && gpu->waitFence(fReadbacks[numDone].fFence, 0)) {
+        ++numDone;
+    }
+    if (!numDone) {
+        return;
+    }
+    // Take the completed readbacks out first since a callback may start new readbacks.
+    SkTArray<Readback> done(numDone);
+    SkTArray<Readback> pending(fReadbacks.count() - numDone);
+    for (int i = 0; i < fReadbacks.count(); ++i) {
+        (i < numDone ? done : pending).push_back(std::move(fReadbacks[i]));
+    }
+    fReadbacks = std::move(pending);
+
+    for (Readback& readback : done) {
+        gpu->deleteFence(readback.fFence);
+        const void* data = readback.fBuffer->map();
+        readback.fCallback(readback.fContext, data, data ? readback.fRowBytes : 0);
+        if (data) {
+            readback.fBuffer->unmap();
+        }
+    }
+}
+
+void GrAsyncReadbackQueue::failAll(GrGpu* gpu) {
+    SkTArray<Readback> readbacks = std::move(fReadbacks);
+    fReadbacks.reset();
+    for (Readback& readback : readbacks) {
+        if (gpu) {
+            gpu->deleteFence(readback.fFence);
+        }
+        readback.fCallback(readback.fContext, nullptr, 0);
+    }
+}
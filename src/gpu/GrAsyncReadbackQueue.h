@@ -0,0 +1,57 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrAsyncReadbackQueue_DEFINED
+#define GrAsyncReadbackQueue_DEFINED
+
+#include "GrGpuBuffer.h"
+#include "GrTypesPriv.h"
+#include "SkSurface.h"
+#include "SkTArray.h"
+
+class GrGpu;
+
+/**
+ * Tracks the readbacks that have been copied into transfer buffers but whose callbacks haven't
+ * been called yet. Each readback has a fence inserted after its copy. The GPU finishes work in
+ * submission order, so readbacks complete in the order they were added and polling stops at the
+ * first fence that hasn't signaled. The transfer buffers are scratch buffers; once a callback
+ * returns its buffer goes back to the resource cache and is reused by later readbacks of the same
+ * size, so several frames of readbacks can be in flight without reallocating buffers.
+ */
+class GrAsyncReadbackQueue {
+public:
+    GrAsyncReadbackQueue() = default;
+    ~GrAsyncReadbackQueue() { SkASSERT(fReadbacks.empty()); }
+
+    bool empty() const { return fReadbacks.empty(); }
+
+    // The buffer holds height rows of rowBytes each, starting at offset zero.
+    void add(GrFence, sk_sp<GrGpuBuffer>, size_t rowBytes, SkSurface::ReadPixelsCallback,
+             SkSurface::ReadPixelsContext);
+
+    // Maps the buffers of the readbacks whose fences have signaled and calls their callbacks. A
+    // buffer that fails to map calls back with nullptr.
+    void process(GrGpu*);
+
+    // Calls back all the remaining readbacks with nullptr. When the context is being abandoned
+    // the gpu is null and the fences are not deleted.
+    void failAll(GrGpu*);
+
+private:
+    struct Readback {
+        GrFence                       fFence;
+        sk_sp<GrGpuBuffer>            fBuffer;
+        size_t                        fRowBytes;
+        SkSurface::ReadPixelsCallback fCallback;
+        SkSurface::ReadPixelsContext  fContext;
+    };
+
+    SkTArray<Readback> fReadbacks;
+};
+
+#endif
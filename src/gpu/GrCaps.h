@@ -58,6 +58,8 @@ public:
     bool sampleLocationsSupport() const { return fSampleLocationsSupport; }
     bool multisampleDisableSupport() const { return fMultisampleDisableSupport; }
     bool instanceAttribSupport() const { return fInstanceAttribSupport; }
+    // Can GrFillRectOp draw its quads as instances of a unit square, rather than tessellating them?
+    bool instancedRectSupport() const { return fInstancedRectSupport; }
     bool usesMixedSamples() const { return fUsesMixedSamples; }
     bool halfFloatVertexAttributeSupport() const { return fHalfFloatVertexAttributeSupport; }
 
@@ -338,6 +340,7 @@ protected:
     bool fSampleLocationsSupport                     : 1;
     bool fMultisampleDisableSupport                  : 1;
     bool fInstanceAttribSupport                      : 1;
+    bool fInstancedRectSupport                       : 1;
     bool fUsesMixedSamples                           : 1;
     bool fUsePrimitiveRestart                        : 1;
     bool fPreferClientSideDynamicBuffers             : 1;
@@ -6,10 +6,12 @@
  */
 
 #include "GrContext.h"
+#include "GrAsyncReadbackQueue.h"
 #include "GrBackendSemaphore.h"
 #include "GrDrawingManager.h"
 #include "GrGpu.h"
 #include "GrMemoryPool.h"
+#include "GrPaintConversionCache.h"
 #include "GrPathRendererChain.h"
 #include "GrProxyProvider.h"
 #include "GrRenderTargetProxy.h"
@@ -54,6 +56,9 @@ GrContext::GrContext(GrBackendApi backend, const GrContextOptions& options, int3
 GrContext::~GrContext() {
     ASSERT_SINGLE_OWNER
 
+    if (fAsyncReadbacks) {
+        fAsyncReadbacks->failAll(this->abandoned() ? nullptr : fGpu.get());
+    }
     if (this->drawingManager()) {
         this->drawingManager()->cleanup();
     }
@@ -78,6 +83,7 @@ bool GrContext::init(sk_sp<const GrCaps> caps, sk_sp<GrSkSLFPFactoryCache> FPFac
         fResourceCache = new GrResourceCache(this->caps(), this->singleOwner(), this->contextID());
         fResourceProvider = new GrResourceProvider(fGpu.get(), fResourceCache, this->singleOwner(),
                                                    this->explicitlyAllocateGPUResources());
+        fAsyncReadbacks.reset(new GrAsyncReadbackQueue);
     }
 
     if (fResourceCache) {
@@ -110,6 +116,10 @@ void GrContext::abandonContext() {
 
     INHERITED::abandonContext();
 
+    if (fAsyncReadbacks) {
+        fAsyncReadbacks->failAll(nullptr);
+    }
+
     fResourceProvider->abandon();
 
     // Need to cleanup the drawing manager first so all the render targets
@@ -130,6 +140,10 @@ void GrContext::releaseResourcesAndAbandonContext() {
 
     INHERITED::abandonContext();
 
+    if (fAsyncReadbacks) {
+        fAsyncReadbacks->failAll(fGpu.get());
+    }
+
     fResourceProvider->abandon();
 
     // Need to cleanup the drawing manager first so all the render targets
@@ -161,6 +175,9 @@ void GrContext::freeGpuResources() {
     // Some slack in the GrTextBlob's implementation requires it though. That could be fixed.
     this->getGrStrikeCache()->freeAll();
 
+    // Cached paint conversions hold the textures their fragment processors sample.
+    this->getPaintConversionCache()->reset();
+
     this->drawingManager()->freeGpuResources();
 
     fResourceCache->purgeAllUnlocked();
@@ -270,6 +287,23 @@ GrSemaphoresSubmitted GrContext::flush(GrFlushFlags flags, int numSemaphores,
                                          finishedContext);
 }
 
+void GrContext::checkAsyncWorkCompletion() {
+    ASSERT_SINGLE_OWNER
+    if (this->abandoned() || !fAsyncReadbacks) {
+        return;
+    }
+    fAsyncReadbacks->process(fGpu.get());
+}
+
+void GrContext::setFlushStatsProc(GrFlushStatsProc proc, GrFlushStatsContext context,
+                                  bool timeGpu) {
+    ASSERT_SINGLE_OWNER
+    if (this->abandoned()) {
+        return;
+    }
+    this->drawingManager()->setFlushStatsProc(proc, context, timeGpu);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 void GrContext::storeVkPipelineCacheData() {
@@ -278,6 +312,14 @@ void GrContext::storeVkPipelineCacheData() {
     }
 }
 
+bool GrContext::precompileShader(const SkData& key, const SkData& data) {
+    ASSERT_SINGLE_OWNER
+    if (this->abandoned() || !fGpu) {
+        return false;
+    }
+    return fGpu->precompileShader(key, data);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 std::unique_ptr<GrFragmentProcessor> GrContext::createPMToUPMEffect(
@@ -263,6 +263,8 @@ public:
 
     GrResourceCache* getResourceCache() { return fContext->fResourceCache; }
 
+    GrAsyncReadbackQueue* asyncReadbackQueue() { return fContext->fAsyncReadbacks.get(); }
+
     GrGpu* getGpu() { return fContext->fGpu.get(); }
     const GrGpu* getGpu() const { return fContext->fGpu.get(); }
 
@@ -9,6 +9,7 @@
 
 #include "GrCaps.h"
 #include "SkRefCnt.h"
+#include "SkVertices.h"
 #include "glsl/GrGLSLColorSpaceXformHelper.h"
 #include "glsl/GrGLSLFragmentShaderBuilder.h"
 #include "glsl/GrGLSLGeometryProcessor.h"
@@ -30,6 +31,7 @@ enum GPFlag {
     kLocalCoordAttribute_GPFlag     = 0x8,
     kCoverageAttribute_GPFlag       = 0x10,
     kCoverageAttributeTweak_GPFlag  = 0x20,
+    kBoneAttribute_GPFlag           = 0x40,
 };
 
 class DefaultGeoProc : public GrGeometryProcessor {
@@ -41,10 +43,12 @@ public:
                                            const SkMatrix& viewMatrix,
                                            const SkMatrix& localMatrix,
                                            bool localCoordsWillBeRead,
-                                           uint8_t coverage) {
+                                           uint8_t coverage,
+                                           const SkVertices::Bone bones[] = nullptr,
+                                           int boneCount = 0) {
         return sk_sp<GrGeometryProcessor>(new DefaultGeoProc(
                 shaderCaps, gpTypeFlags, color, std::move(colorSpaceXform), viewMatrix, localMatrix,
-                coverage, localCoordsWillBeRead));
+                coverage, localCoordsWillBeRead, bones, boneCount));
     }
 
     const char* name() const override { return "DefaultGeometryProcessor"; }
@@ -56,6 +60,10 @@ public:
     bool localCoordsWillBeRead() const { return fLocalCoordsWillBeRead; }
     uint8_t coverage() const { return fCoverage; }
     bool hasVertexCoverage() const { return fInCoverage.isInitialized(); }
+    bool hasBones() const { return SkToBool(fFlags & kBoneAttribute_GPFlag); }
+    // Each bone is packed as two float4s: (scaleX, skewY, skewX, scaleY), (transX, transY, 0, 0).
+    const float* boneData() const { return fBoneData.begin(); }
+    int boneDataCount() const { return fBoneData.count(); }
 
     class GLSLProcessor : public GrGLSLGeometryProcessor {
     public:
@@ -122,11 +130,40 @@ public:
                                         &fColorUniform);
             }
 
-            // Setup position
+            // Setup position, deforming it by the bones if there are any. Bone 0 of each instance
+            // is its world transform; the vertex is then the weighted sum of its (up to four) bones'
+            // transforms of the world position. Weights of unused slots were zeroed on upload.
+            GrShaderVar position = gp.fInPosition.asShaderVar();
+            if (gp.hasBones()) {
+                const char* bones;
+                fBonesUniform = uniformHandler->addUniformArray(kVertex_GrShaderFlag,
+                                                                kFloat4_GrSLType,
+                                                                "Bones",
+                                                                2 * GrDefaultGeoProcFactory::kMaxBones,
+                                                                &bones);
+                vertBuilder->codeAppendf("int firstBone = 2 * int(%s);", gp.fInFirstBone.name());
+                vertBuilder->codeAppendf("float2 worldPosition = %s[firstBone].xy * %s.x + "
+                                                                "%s[firstBone].zw * %s.y + "
+                                                                "%s[firstBone + 1].xy;",
+                                         bones, gp.fInPosition.name(), bones,
+                                         gp.fInPosition.name(), bones);
+                vertBuilder->codeAppend("float2 skinnedPosition = float2(0);");
+                vertBuilder->codeAppend("int bone;");
+                for (char c : {'x', 'y', 'z', 'w'}) {
+                    vertBuilder->codeAppendf("bone = firstBone + 2 * int(%s.%c * 255.0 + 0.5);",
+                                             gp.fInBoneIndices.name(), c);
+                    vertBuilder->codeAppendf("skinnedPosition += %s.%c * "
+                                                    "(%s[bone].xy * worldPosition.x + "
+                                                     "%s[bone].zw * worldPosition.y + "
+                                                     "%s[bone + 1].xy);",
+                                             gp.fInBoneWeights.name(), c, bones, bones, bones);
+                }
+                position = GrShaderVar("skinnedPosition", kFloat2_GrSLType);
+            }
             this->writeOutputPosition(vertBuilder,
                                       uniformHandler,
                                       gpArgs,
-                                      gp.fInPosition.name(),
+                                      position.c_str(),
                                       gp.viewMatrix(),
                                       &fViewMatrixUniform);
 
@@ -143,7 +180,7 @@ public:
                 this->emitTransforms(vertBuilder,
                                      varyingHandler,
                                      uniformHandler,
-                                     gp.fInPosition.asShaderVar(),
+                                     position,
                                      gp.localMatrix(),
                                      args.fFPCoordTransformHandler);
             }
@@ -198,6 +235,16 @@ public:
                 pdman.set1f(fCoverageUniform, GrNormalizeByteToFloat(dgp.coverage()));
                 fCoverage = dgp.coverage();
             }
+            if (dgp.hasBones()) {
+                size_t boneDataSize = dgp.boneDataCount() * sizeof(float);
+                if (fBoneData.count() != dgp.boneDataCount() ||
+                    0 != memcmp(fBoneData.begin(), dgp.boneData(), boneDataSize)) {
+                    pdman.set4fv(fBonesUniform, dgp.boneDataCount() / 4, dgp.boneData());
+                    fBoneData.reset(dgp.boneDataCount());
+                    memcpy(fBoneData.begin(), dgp.boneData(), boneDataSize);
+                }
+            }
+
             this->setTransformDataHelper(dgp.fLocalMatrix, pdman, &transformIter);
 
             fColorSpaceHelper.setData(pdman, dgp.fColorSpaceXform.get());
@@ -210,6 +257,8 @@ public:
         UniformHandle fViewMatrixUniform;
         UniformHandle fColorUniform;
         UniformHandle fCoverageUniform;
+        UniformHandle fBonesUniform;
+        SkTArray<float, true> fBoneData;
         GrGLSLColorSpaceXformHelper fColorSpaceHelper;
 
         typedef GrGLSLGeometryProcessor INHERITED;
@@ -231,7 +280,9 @@ private:
                    const SkMatrix& viewMatrix,
                    const SkMatrix& localMatrix,
                    uint8_t coverage,
-                   bool localCoordsWillBeRead)
+                   bool localCoordsWillBeRead,
+                   const SkVertices::Bone bones[],
+                   int boneCount)
             : INHERITED(kDefaultGeoProc_ClassID)
             , fColor(color)
             , fViewMatrix(viewMatrix)
@@ -252,13 +303,30 @@ private:
         if (fFlags & kCoverageAttribute_GPFlag) {
             fInCoverage = {"inCoverage", kFloat_GrVertexAttribType, kHalf_GrSLType};
         }
-        this->setVertexAttributes(&fInPosition, 4);
+        if (fFlags & kBoneAttribute_GPFlag) {
+            SkASSERT(bones && boneCount > 0 && boneCount <= GrDefaultGeoProcFactory::kMaxBones);
+            fInBoneIndices = {"inBoneIndices", kUByte4_norm_GrVertexAttribType, kFloat4_GrSLType};
+            fInBoneWeights = {"inBoneWeights", kFloat4_GrVertexAttribType, kFloat4_GrSLType};
+            fInFirstBone = {"inFirstBone", kFloat_GrVertexAttribType, kFloat_GrSLType};
+            this->setInstanceAttributes(&fInFirstBone, 1);
+            fBoneData.reset(8 * boneCount);
+            float* data = fBoneData.begin();
+            for (int i = 0; i < boneCount; ++i, data += 8) {
+                memcpy(data, bones[i].values, 6 * sizeof(float));
+                data[6] = data[7] = 0;
+            }
+        }
+        this->setVertexAttributes(&fInPosition, 6);
     }
 
     Attribute fInPosition;
     Attribute fInColor;
     Attribute fInLocalCoords;
     Attribute fInCoverage;
+    Attribute fInBoneIndices;
+    Attribute fInBoneWeights;
+    Attribute fInFirstBone;
+    SkTArray<float, true> fBoneData;
     SkPMColor4f fColor;
     SkMatrix fViewMatrix;
     SkMatrix fLocalMatrix;
@@ -295,6 +363,17 @@ sk_sp<GrGeometryProcessor> DefaultGeoProc::TestCreate(GrProcessorTestData* d) {
     if (d->fRandom->nextBool()) {
         flags |= kLocalCoordAttribute_GPFlag;
     }
+    SkVertices::Bone bones[GrDefaultGeoProcFactory::kMaxBones];
+    int boneCount = 0;
+    if (d->caps()->instanceAttribSupport() && d->fRandom->nextBool()) {
+        flags |= kBoneAttribute_GPFlag;
+        boneCount = d->fRandom->nextRangeU(1, GrDefaultGeoProcFactory::kMaxBones);
+        for (int i = 0; i < boneCount; ++i) {
+            for (int j = 0; j < 6; ++j) {
+                bones[i][j] = d->fRandom->nextRangeScalar(-2.f, 2.f);
+            }
+        }
+    }
 
     return DefaultGeoProc::Make(d->caps()->shaderCaps(),
                                 flags,
@@ -303,15 +382,16 @@ sk_sp<GrGeometryProcessor> DefaultGeoProc::TestCreate(GrProcessorTestData* d) {
                                 GrTest::TestMatrix(d->fRandom),
                                 GrTest::TestMatrix(d->fRandom),
                                 d->fRandom->nextBool(),
-                                GrRandomCoverage(d->fRandom));
+                                GrRandomCoverage(d->fRandom),
+                                bones,
+                                boneCount);
 }
 #endif
 
-sk_sp<GrGeometryProcessor> GrDefaultGeoProcFactory::Make(const GrShaderCaps* shaderCaps,
-                                                         const Color& color,
-                                                         const Coverage& coverage,
-                                                         const LocalCoords& localCoords,
-                                                         const SkMatrix& viewMatrix) {
+static uint32_t gp_flags(const GrDefaultGeoProcFactory::Color& color,
+                         const GrDefaultGeoProcFactory::Coverage& coverage,
+                         const GrDefaultGeoProcFactory::LocalCoords& localCoords) {
+    using namespace GrDefaultGeoProcFactory;
     uint32_t flags = 0;
     if (Color::kPremulGrColorAttribute_Type == color.fType) {
         flags |= kColorAttribute_GPFlag;
@@ -326,6 +406,15 @@ sk_sp<GrGeometryProcessor> GrDefaultGeoProcFactory::Make(const GrShaderCaps* sha
         flags |= kCoverageAttribute_GPFlag | kCoverageAttributeTweak_GPFlag;
     }
     flags |= localCoords.fType == LocalCoords::kHasExplicit_Type ? kLocalCoordAttribute_GPFlag : 0;
+    return flags;
+}
+
+sk_sp<GrGeometryProcessor> GrDefaultGeoProcFactory::Make(const GrShaderCaps* shaderCaps,
+                                                         const Color& color,
+                                                         const Coverage& coverage,
+                                                         const LocalCoords& localCoords,
+                                                         const SkMatrix& viewMatrix) {
+    uint32_t flags = gp_flags(color, coverage, localCoords);
 
     uint8_t inCoverage = coverage.fCoverage;
     bool localCoordsWillBeRead = localCoords.fType != LocalCoords::kUnused_Type;
@@ -340,6 +429,29 @@ sk_sp<GrGeometryProcessor> GrDefaultGeoProcFactory::Make(const GrShaderCaps* sha
                                 inCoverage);
 }
 
+sk_sp<GrGeometryProcessor> GrDefaultGeoProcFactory::MakeWithBones(const GrShaderCaps* shaderCaps,
+                                                                  const Color& color,
+                                                                  const Coverage& coverage,
+                                                                  const LocalCoords& localCoords,
+                                                                  const Bones& bones,
+                                                                  const SkMatrix& viewMatrix) {
+    uint32_t flags = gp_flags(color, coverage, localCoords) | kBoneAttribute_GPFlag;
+
+    uint8_t inCoverage = coverage.fCoverage;
+    bool localCoordsWillBeRead = localCoords.fType != LocalCoords::kUnused_Type;
+
+    return DefaultGeoProc::Make(shaderCaps,
+                                flags,
+                                color.fColor,
+                                color.fColorSpaceXform,
+                                viewMatrix,
+                                localCoords.fMatrix ? *localCoords.fMatrix : SkMatrix::I(),
+                                localCoordsWillBeRead,
+                                inCoverage,
+                                bones.fBones,
+                                bones.fBoneCount);
+}
+
 sk_sp<GrGeometryProcessor> GrDefaultGeoProcFactory::MakeForDeviceSpace(
                                                                      const GrShaderCaps* shaderCaps,
                                                                      const Color& color,
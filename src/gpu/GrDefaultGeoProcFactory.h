@@ -11,6 +11,7 @@
 #include "GrColorSpaceXform.h"
 #include "GrGeometryProcessor.h"
 #include "GrShaderCaps.h"
+#include "SkVertices.h"
 
 /*
  * A factory for creating default Geometry Processors which simply multiply position by the uniform
@@ -76,12 +77,41 @@ namespace GrDefaultGeoProcFactory {
         const SkMatrix* fMatrix;
     };
 
+    /*
+     * The most bones a skinned GP can hold, counting every instance's bones. Each takes two float4
+     * vertex uniforms, which keeps the array within the 128 vectors GLES2 guarantees.
+     */
+    static constexpr int kMaxBones = 48;
+
+    struct Bones {
+        Bones(const SkVertices::Bone bones[], int boneCount)
+                : fBones(bones)
+                , fBoneCount(boneCount) {}
+
+        const SkVertices::Bone* fBones;
+        int fBoneCount;
+    };
+
     sk_sp<GrGeometryProcessor> Make(const GrShaderCaps*,
                                     const Color&,
                                     const Coverage&,
                                     const LocalCoords&,
                                     const SkMatrix& viewMatrix);
 
+    /*
+     * Use this factory to create a GrGeometryProcessor that deforms positions by bones on the GPU,
+     * as SkVertices::applyBones() would on the CPU. After the position attribute (and the color and
+     * local coord attributes, if any) each vertex has a kUByte4_norm of bone indices and a kFloat4
+     * of bone weights, and each instance has a kFloat index of its first bone in 'bones', which is
+     * its world transform. Requires instance attribute support.
+     */
+    sk_sp<GrGeometryProcessor> MakeWithBones(const GrShaderCaps*,
+                                             const Color&,
+                                             const Coverage&,
+                                             const LocalCoords&,
+                                             const Bones&,
+                                             const SkMatrix& viewMatrix);
+
     /*
      * Use this factory to create a GrGeometryProcessor that expects a device space vertex position
      * attribute. The view matrix must still be provided to compute correctly transformed
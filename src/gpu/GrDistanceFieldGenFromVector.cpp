@@ -16,6 +16,8 @@
 #include "SkPathOps.h"
 #include "SkPointPriv.h"
 #include "SkRectPriv.h"
+#include "SkTArray.h"
+#include "SkTemplates.h"
 
 /**
  * If a scanline (a row of texel) cross from the kRight_SegSide
@@ -737,11 +739,9 @@ static unsigned char pack_distance_field_val(float dist) {
     return (unsigned char)SkScalarRoundToInt(dist / (2 * distanceMagnitude) * 256.0f);
 }
 
-bool GrGenerateDistanceFieldFromPath(unsigned char* distanceField,
-                                     const SkPath& path, const SkMatrix& drawMatrix,
-                                     int width, int height, size_t rowBytes) {
-    SkASSERT(distanceField);
-
+// Simplifies the path and maps it into the distance field's texel space, leaving room for the pad.
+static bool make_working_path(const SkPath& path, const SkMatrix& drawMatrix,
+                              int width, int height, SkPath* workingPath) {
 #ifdef SK_DEBUG
     SkPath xformPath;
     path.transform(drawMatrix, &xformPath);
@@ -756,20 +756,19 @@ bool GrGenerateDistanceFieldFromPath(unsigned char* distanceField,
              expectPathBounds.contains(pathBounds));
 
     SkPath simplifiedPath;
-    SkPath workingPath;
     if (Simplify(path, &simplifiedPath)) {
-        workingPath = simplifiedPath;
+        *workingPath = simplifiedPath;
     } else {
-        workingPath = path;
+        *workingPath = path;
     }
 
-    if (!IsDistanceFieldSupportedFillType(workingPath.getFillType())) {
+    if (!IsDistanceFieldSupportedFillType(workingPath->getFillType())) {
         return false;
     }
 
-    workingPath.transform(drawMatrix);
+    workingPath->transform(drawMatrix);
 
-    SkDEBUGCODE(pathBounds = workingPath.getBounds().roundOut());
+    SkDEBUGCODE(pathBounds = workingPath->getBounds().roundOut());
     SkASSERT(expectPathBounds.isEmpty() ||
              expectPathBounds.contains(pathBounds.x(), pathBounds.y()));
     SkASSERT(expectPathBounds.isEmpty() || pathBounds.isEmpty() ||
@@ -778,7 +777,19 @@ bool GrGenerateDistanceFieldFromPath(unsigned char* distanceField,
     // translate path to offset (SK_DistanceFieldPad, SK_DistanceFieldPad)
     SkMatrix dfMatrix;
     dfMatrix.setTranslate(SK_DistanceFieldPad, SK_DistanceFieldPad);
-    workingPath.transform(dfMatrix);
+    workingPath->transform(dfMatrix);
+    return true;
+}
+
+bool GrGenerateDistanceFieldFromPath(unsigned char* distanceField,
+                                     const SkPath& path, const SkMatrix& drawMatrix,
+                                     int width, int height, size_t rowBytes) {
+    SkASSERT(distanceField);
+
+    SkPath workingPath;
+    if (!make_working_path(path, drawMatrix, width, height, &workingPath)) {
+        return false;
+    }
 
     // create temp data
     size_t dataSize = width * height * sizeof(DFData);
@@ -877,3 +888,328 @@ bool GrGenerateDistanceFieldFromPath(unsigned char* distanceField,
     }
     return true;
 }
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Multi-channel distance fields (see Chlumsky, "Shape Decomposition for Multi-channel Distance
+ * Fields"). The path's contours are flattened to lines and each line is given a subset of the
+ * red, green and blue channels. Each channel stores the signed distance to the nearest line that
+ * has it, and the lines meeting at a corner never have both of the channels the corner needs.
+ * The median of the three channels then reconstructs the corner sharply at any scale, where a
+ * single channel field rounds it off.
+ */
+
+enum EdgeColor {
+    kRed_EdgeColor     = 0x1,
+    kGreen_EdgeColor   = 0x2,
+    kBlue_EdgeColor    = 0x4,
+    kYellow_EdgeColor  = kRed_EdgeColor | kGreen_EdgeColor,
+    kMagenta_EdgeColor = kRed_EdgeColor | kBlue_EdgeColor,
+    kCyan_EdgeColor    = kGreen_EdgeColor | kBlue_EdgeColor,
+    kWhite_EdgeColor   = kRed_EdgeColor | kGreen_EdgeColor | kBlue_EdgeColor,
+};
+
+// Curves are flattened with this tolerance in texels. Joints inside a curve are never corners.
+static const SkScalar kMultiChannelFlattenTolerance = 0.125f;
+// Joints between verbs whose directions differ by more than about 8 degrees are corners.
+static const double kCornerCrossThreshold = 0.141;
+// Neighboring texels whose channels change by more than this would interpolate to artifacts.
+static const float kClashThreshold = 1.001f;
+
+struct ColoredEdge {
+    DPoint fP0;
+    DPoint fDir;          // unit direction from fP0 to the end point
+    double fLength;
+    int    fColor;
+    bool   fStartsVerb;   // false for lines in the middle of a flattened curve
+};
+
+typedef SkSTArray<32, ColoredEdge, true> ColoredEdgeArray;
+
+static void add_colored_edge(const SkPoint& p0, const SkPoint& p1, bool startsVerb,
+                             ColoredEdgeArray* edges) {
+    double dx = (double)p1.fX - p0.fX;
+    double dy = (double)p1.fY - p0.fY;
+    double length = DPoint::Length(dx, dy);
+    if (nearly_zero(length)) {
+        return;
+    }
+    ColoredEdge& edge = edges->push_back();
+    edge.fP0 = DPoint::Make(p0.fX, p0.fY);
+    edge.fDir = DPoint::Make(dx / length, dy / length);
+    edge.fLength = length;
+    edge.fColor = kWhite_EdgeColor;
+    edge.fStartsVerb = startsVerb;
+}
+
+template <typename EvalFn>
+static void add_flattened_curve(const SkPoint& start, const SkPoint& end, uint32_t segmentCount,
+                                EvalFn eval, ColoredEdgeArray* edges) {
+    SkPoint prev = start;
+    for (uint32_t i = 1; i <= segmentCount; ++i) {
+        SkPoint next = (i == segmentCount) ? end : eval((SkScalar)i / segmentCount);
+        add_colored_edge(prev, next, 1 == i, edges);
+        prev = next;
+    }
+}
+
+static void add_flattened_quad(const SkPoint pts[3], ColoredEdgeArray* edges) {
+    uint32_t count = GrPathUtils::quadraticPointCount(pts, kMultiChannelFlattenTolerance);
+    add_flattened_curve(pts[0], pts[2], count,
+                        [pts](SkScalar t) { return SkEvalQuadAt(pts, t); }, edges);
+}
+
+static void add_flattened_cubic(const SkPoint pts[4], ColoredEdgeArray* edges) {
+    uint32_t count = GrPathUtils::cubicPointCount(pts, kMultiChannelFlattenTolerance);
+    add_flattened_curve(pts[0], pts[3], count,
+                        [pts](SkScalar t) {
+                            SkPoint pt;
+                            SkEvalCubicAt(pts, t, &pt, nullptr, nullptr);
+                            return pt;
+                        }, edges);
+}
+
+static int next_edge_color(int color) {
+    switch (color) {
+        case kCyan_EdgeColor:    return kMagenta_EdgeColor;
+        case kMagenta_EdgeColor: return kYellow_EdgeColor;
+        default:                 return kCyan_EdgeColor;
+    }
+}
+
+// Colors the edges of one closed contour so the two edges at each corner differ in two channels.
+static void color_contour(ColoredEdge* edges, int count) {
+    SkSTArray<16, int, true> corners;
+    for (int i = 0; i < count; ++i) {
+        if (!edges[i].fStartsVerb) {
+            continue;
+        }
+        const DPoint& a = edges[(i + count - 1) % count].fDir;
+        const DPoint& b = edges[i].fDir;
+        double dot = a.fX * b.fX + a.fY * b.fY;
+        double cross = a.fX * b.fY - a.fY * b.fX;
+        if (dot <= 0 || fabs(cross) > kCornerCrossThreshold) {
+            corners.push_back(i);
+        }
+    }
+
+    if (corners.empty()) {
+        // Smooth contours don't need more than one channel.
+        for (int i = 0; i < count; ++i) {
+            edges[i].fColor = kWhite_EdgeColor;
+        }
+    } else if (1 == corners.count()) {
+        // A single corner ("teardrop") needs the contour split in three.
+        static const int kColors[] = { kCyan_EdgeColor, kWhite_EdgeColor, kMagenta_EdgeColor };
+        for (int j = 0; j < count; ++j) {
+            edges[(corners[0] + j) % count].fColor = kColors[SkTMin(2, 3 * j / count)];
+        }
+    } else {
+        // Switch colors at each corner, making sure the last spline doesn't match the first.
+        int color = kCyan_EdgeColor;
+        int spline = 0;
+        for (int j = 0; j < count; ++j) {
+            int i = (corners[0] + j) % count;
+            if (j > 0 && spline + 1 < corners.count() && i == corners[spline + 1]) {
+                ++spline;
+                color = next_edge_color(color);
+                if (spline == corners.count() - 1 && color == kCyan_EdgeColor) {
+                    color = next_edge_color(color);
+                }
+            }
+            edges[i].fColor = color;
+        }
+    }
+}
+
+struct EdgeDistance {
+    double fDistance = SK_ScalarMax;        // unsigned distance to the nearest point of the edge
+    double fOrthogonality = SK_ScalarMax;   // breaks ties at shared end points, lower is better
+    double fPseudoDistance = SK_ScalarMax;  // signed distance to the edge's line
+
+    bool operator<(const EdgeDistance& that) const {
+        if (nearly_equal(fDistance, that.fDistance, kNearlyZero)) {
+            return fOrthogonality < that.fOrthogonality;
+        }
+        return fDistance < that.fDistance;
+    }
+};
+
+static EdgeDistance distance_to_edge(const DPoint& point, const ColoredEdge& edge) {
+    EdgeDistance result;
+    double vx = point.fX - edge.fP0.fX;
+    double vy = point.fY - edge.fP0.fY;
+    double t = vx * edge.fDir.fX + vy * edge.fDir.fY;
+    // Positive on the left of the edge.
+    result.fPseudoDistance = edge.fDir.fX * vy - edge.fDir.fY * vx;
+    if (t >= 0 && t <= edge.fLength) {
+        result.fDistance = fabs(result.fPseudoDistance);
+        result.fOrthogonality = 0;
+    } else {
+        if (t > edge.fLength) {
+            vx -= edge.fDir.fX * edge.fLength;
+            vy -= edge.fDir.fY * edge.fLength;
+        }
+        result.fDistance = DPoint::Length(vx, vy);
+        result.fOrthogonality = nearly_zero(result.fDistance)
+                ? 0 : fabs(vx * edge.fDir.fX + vy * edge.fDir.fY) / result.fDistance;
+    }
+    return result;
+}
+
+static inline float median(float a, float b, float c) {
+    return SkTMax(SkTMin(a, b), SkTMin(SkTMax(a, b), c));
+}
+
+struct MultiChannelTexel {
+    float fChannels[3];
+    float fTrueDistance;
+};
+
+static bool channels_clash(const MultiChannelTexel& a, const MultiChannelTexel& b) {
+    int clashes = 0;
+    for (int c = 0; c < 3; ++c) {
+        if (fabs(a.fChannels[c] - b.fChannels[c]) > kClashThreshold) {
+            ++clashes;
+        }
+    }
+    return clashes >= 2;
+}
+
+bool GrGenerateMultiChannelDistanceFieldFromPath(unsigned char* distanceField,
+                                                 const SkPath& path, const SkMatrix& drawMatrix,
+                                                 int width, int height, size_t rowBytes) {
+    SkASSERT(distanceField);
+    SkASSERT(rowBytes >= 4 * (size_t)width);
+
+    SkPath workingPath;
+    if (!make_working_path(path, drawMatrix, width, height, &workingPath)) {
+        return false;
+    }
+
+    // Flatten the contours and color their edges.
+    ColoredEdgeArray edges;
+    SkPath::Iter iter(workingPath, true);
+    int contourStart = 0;
+    for (;;) {
+        SkPoint pts[4];
+        SkPath::Verb verb = iter.next(pts);
+        switch (verb) {
+            case SkPath::kMove_Verb:
+            case SkPath::kClose_Verb:
+            case SkPath::kDone_Verb:
+                if (edges.count() > contourStart) {
+                    color_contour(&edges[contourStart], edges.count() - contourStart);
+                }
+                contourStart = edges.count();
+                break;
+            case SkPath::kLine_Verb:
+                add_colored_edge(pts[0], pts[1], true, &edges);
+                break;
+            case SkPath::kQuad_Verb:
+                add_flattened_quad(pts, &edges);
+                break;
+            case SkPath::kConic_Verb: {
+                SkScalar weight = iter.conicWeight();
+                SkAutoConicToQuads converter;
+                const SkPoint* quadPts = converter.computeQuads(pts, weight, kConicTolerance);
+                for (int i = 0; i < converter.countQuads(); ++i) {
+                    int firstEdge = edges.count();
+                    add_flattened_quad(quadPts + 2*i, &edges);
+                    if (i > 0 && edges.count() > firstEdge) {
+                        edges[firstEdge].fStartsVerb = false;
+                    }
+                }
+                break;
+            }
+            case SkPath::kCubic_Verb:
+                add_flattened_cubic(pts, &edges);
+                break;
+        }
+        if (verb == SkPath::kDone_Verb) {
+            break;
+        }
+    }
+
+    // create temp data
+    size_t dataSize = width * height * sizeof(MultiChannelTexel);
+    SkAutoSMalloc<1024> dfStorage(dataSize);
+    MultiChannelTexel* texels = (MultiChannelTexel*) dfStorage.get();
+
+    for (int row = 0; row < height; ++row) {
+        for (int col = 0; col < width; ++col) {
+            MultiChannelTexel& texel = texels[row * width + col];
+            const DPoint point = DPoint::Make(col + 0.5, row + 0.5);
+            const bool inside = workingPath.contains(col + 0.5f, row + 0.5f);
+
+            EdgeDistance nearest;
+            EdgeDistance nearestPerChannel[3];
+            for (const ColoredEdge& edge : edges) {
+                EdgeDistance distance = distance_to_edge(point, edge);
+                if (distance < nearest) {
+                    nearest = distance;
+                }
+                for (int c = 0; c < 3; ++c) {
+                    if ((edge.fColor & (1 << c)) && distance < nearestPerChannel[c]) {
+                        nearestPerChannel[c] = distance;
+                    }
+                }
+            }
+
+            // Like the single channel field, distances are negative inside. Contours may be
+            // wound either way, so orient the edges by the nearest one.
+            float trueDistance = (float)(inside ? -nearest.fDistance : nearest.fDistance);
+            bool negate = (nearest.fPseudoDistance < 0) != inside;
+            for (int c = 0; c < 3; ++c) {
+                double pseudo = nearestPerChannel[c].fPseudoDistance;
+                if (SK_ScalarMax == nearestPerChannel[c].fDistance) {
+                    texel.fChannels[c] = trueDistance;
+                } else {
+                    texel.fChannels[c] = (float)(negate ? -pseudo : pseudo);
+                }
+            }
+            texel.fTrueDistance = trueDistance;
+
+            // Fall back to a single channel where the median disagrees with the real inside.
+            float m = median(texel.fChannels[0], texel.fChannels[1], texel.fChannels[2]);
+            if ((m < 0) != inside) {
+                for (int c = 0; c < 3; ++c) {
+                    texel.fChannels[c] = trueDistance;
+                }
+            }
+        }
+    }
+
+    // Texels whose channels jump in different directions relative to a neighbor interpolate to
+    // spurious edges between them. Collapse both to their medians.
+    SkAutoTMalloc<bool> clashes(width * height);
+    memset(clashes.get(), 0, width * height * sizeof(bool));
+    for (int row = 0; row < height; ++row) {
+        for (int col = 0; col < width; ++col) {
+            int idx = row * width + col;
+            if (col + 1 < width && channels_clash(texels[idx], texels[idx + 1])) {
+                clashes[idx] = clashes[idx + 1] = true;
+            }
+            if (row + 1 < height && channels_clash(texels[idx], texels[idx + width])) {
+                clashes[idx] = clashes[idx + width] = true;
+            }
+        }
+    }
+
+    for (int row = 0; row < height; ++row) {
+        unsigned char* dst = distanceField + row * rowBytes;
+        for (int col = 0; col < width; ++col) {
+            int idx = row * width + col;
+            const MultiChannelTexel& texel = texels[idx];
+            float m = median(texel.fChannels[0], texel.fChannels[1], texel.fChannels[2]);
+            for (int c = 0; c < 3; ++c) {
+                float dist = clashes[idx] ? m : texel.fChannels[c];
+                dst[4 * col + c] = pack_distance_field_val<SK_DistanceFieldMagnitude>(dist);
+            }
+            dst[4 * col + 3] =
+                    pack_distance_field_val<SK_DistanceFieldMagnitude>(texel.fTrueDistance);
+        }
+    }
+    return true;
+}
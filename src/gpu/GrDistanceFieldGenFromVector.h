@@ -30,6 +30,23 @@ bool GrGenerateDistanceFieldFromPath(unsigned char* distanceField,
                                      const SkPath& path, const SkMatrix& viewMatrix,
                                      int width, int height, size_t rowBytes);
 
+/** Given a vector path, generate the associated multi-channel distance field. Each texel has four
+ *  bytes: red, green and blue hold distances to differently colored edges of the path, whose
+ *  median reconstructs sharp corners at any scale, and alpha holds the ordinary distance field.
+ *  Distances are packed the same way as for GrGenerateDistanceFieldFromPath.
+
+ *  @param distanceField     The distance field to be generated. Should already be allocated
+ *                           by the client with the padding defined in "SkDistanceFieldGen.h".
+ *  @param path              The path we're using to generate the distance field.
+ *  @param matrix            Transformation matrix for path.
+ *  @param width             Width of the distance field.
+ *  @param height            Height of the distance field.
+ *  @param rowBytes          Size of each row in the distance field, in bytes. At least 4 * width.
+ */
+bool GrGenerateMultiChannelDistanceFieldFromPath(unsigned char* distanceField,
+                                                 const SkPath& path, const SkMatrix& viewMatrix,
+                                                 int width, int height, size_t rowBytes);
+
 inline bool IsDistanceFieldSupportedFillType(SkPath::FillType fFillType)
 {
     return (SkPath::kEvenOdd_FillType == fFillType ||
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrDistanceFieldPathCache.h"
+
+#include "SkFloatBits.h"
+#include "SkOpts.h"
+#include "SkPath.h"
+#include "SkResourceCache.h"
+
+namespace {
+static unsigned gDistanceFieldPathKeyNamespaceLabel;
+
+// Bump this whenever the distance fields GrSmallPathRenderer generates change, so persisted
+// fields from older builds aren't used.
+#ifdef SK_USE_LEGACY_DISTANCE_FIELDS
+static const uint32_t kFieldVersion = 0x10001;
+#else
+static const uint32_t kFieldVersion = 1;
+#endif
+
+static const int kKeyHeader32 = 3;
+
+// The SkResourceCache key is a hash of the full key, which each rec keeps to check for
+// collisions.
+struct DistanceFieldPathKey : public SkResourceCache::Key {
+public:
+    explicit DistanceFieldPathKey(const SkData& key)
+        : fHash(SkOpts::hash(key.data(), key.size()))
+        , fSize(SkToU32(key.size())) {
+        this->init(&gDistanceFieldPathKeyNamespaceLabel, 0, sizeof(fHash) + sizeof(fSize));
+    }
+
+    uint32_t fHash;
+    uint32_t fSize;
+};
+
+struct DistanceFieldPathRec : public SkResourceCache::Rec {
+    DistanceFieldPathRec(sk_sp<SkData> key, sk_sp<SkData> field)
+        : fKey(*key)
+        , fFullKey(std::move(key))
+        , fField(std::move(field)) {}
+
+    DistanceFieldPathKey fKey;
+    sk_sp<SkData>        fFullKey;
+    sk_sp<SkData>        fField;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override {
+        return sizeof(*this) + fFullKey->size() + fField->size();
+    }
+    const char* getCategory() const override { return "distance-field-path"; }
+    SkDiscardableMemory* diagnostic_only_getDiscardable() const override { return nullptr; }
+
+    struct Context {
+        const SkData*  fFullKey;
+        sk_sp<SkData>* fField;
+    };
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const DistanceFieldPathRec& rec = static_cast<const DistanceFieldPathRec&>(baseRec);
+        Context* context = static_cast<Context*>(contextData);
+        if (!rec.fFullKey->equals(context->fFullKey)) {
+            return false;  // A hash collision; make room for the path being looked up.
+        }
+        *context->fField = rec.fField;
+        return true;
+    }
+};
+} // namespace
+
+sk_sp<SkData> GrDistanceFieldPathCache::MakeKey(const SkPath& path, SkScalar scale) {
+    size_t pathSize = path.writeToMemory(nullptr);
+    size_t keySize = kKeyHeader32 * sizeof(uint32_t) + SkAlign4(pathSize);
+    sk_sp<SkData> key = SkData::MakeUninitialized(keySize);
+    uint32_t* key32 = static_cast<uint32_t*>(key->writable_data());
+    key32[keySize / sizeof(uint32_t) - 1] = 0;  // Zero the padding after the path.
+    key32[0] = SkSetFourByteTag('s', 'd', 'f', 'p');
+    key32[1] = kFieldVersion;
+    key32[2] = SkFloat2Bits(scale);
+    SkAssertResult(path.writeToMemory(key32 + kKeyHeader32) == pathSize);
+    return key;
+}
+
+sk_sp<SkData> GrDistanceFieldPathCache::Find(const SkData& key, size_t fieldSize,
+                                             GrContextOptions::PersistentCache* persistentCache) {
+    sk_sp<SkData> field;
+    DistanceFieldPathRec::Context context = { &key, &field };
+    if (SkResourceCache::Find(DistanceFieldPathKey(key), DistanceFieldPathRec::Visitor,
+                              &context) && field->size() == fieldSize) {
+        return field;
+    }
+    if (persistentCache) {
+        field = persistentCache->load(key);
+        if (field && field->size() == fieldSize) {
+            SkResourceCache::Add(new DistanceFieldPathRec(SkData::MakeWithCopy(key.data(),
+                                                                               key.size()),
+                                                          field));
+            return field;
+        }
+    }
+    return nullptr;
+}
+
+void GrDistanceFieldPathCache::Add(sk_sp<SkData> key, sk_sp<SkData> field,
+                                   GrContextOptions::PersistentCache* persistentCache) {
+    if (persistentCache) {
+        persistentCache->store(*key, *field);
+    }
+    SkResourceCache::Add(new DistanceFieldPathRec(std::move(key), std::move(field)));
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrDistanceFieldPathCache_DEFINED
+#define GrDistanceFieldPathCache_DEFINED
+
+#include "GrContextOptions.h"
+#include "SkData.h"
+
+class SkPath;
+
+/**
+ * A process-wide, CPU-side cache of the signed distance fields GrSmallPathRenderer generates for
+ * paths, so every GrContext in the process (and, through a PersistentCache, later runs) can reuse
+ * them instead of regenerating them when an atlas is first filled. Entries are keyed by the
+ * path's contents and the scale it's rendered at, not by generation ID, so they stay valid
+ * across path copies and runs. The in-process entries live in the SkResourceCache budget.
+ */
+class GrDistanceFieldPathCache {
+public:
+    /**
+     * Returns the key for path's distance field at the given scale.
+     */
+    static sk_sp<SkData> MakeKey(const SkPath& path, SkScalar scale);
+
+    /**
+     * Returns the fieldSize bytes of distance field for key, looking in persistentCache (if any)
+     * when this process hasn't cached it. Returns null if neither has it.
+     */
+    static sk_sp<SkData> Find(const SkData& key, size_t fieldSize,
+                              GrContextOptions::PersistentCache* persistentCache);
+
+    /**
+     * Records the distance field for key here, and in persistentCache if it's not null.
+     */
+    static void Add(sk_sp<SkData> key, sk_sp<SkData> field,
+                    GrContextOptions::PersistentCache* persistentCache);
+};
+
+#endif
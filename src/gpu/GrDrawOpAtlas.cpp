@@ -17,6 +17,7 @@
 #include "GrSurfaceProxyPriv.h"
 #include "GrTexture.h"
 #include "GrTracing.h"
+#include "SkMetrics.h"
 
 // When proxy allocation is deferred until flush time the proxies acting as atlases require
 // special handling. This is because the usage that can be determined from the ops themselves
@@ -152,6 +153,9 @@ void GrDrawOpAtlas::Plot::uploadToTexture(GrDeferredTextureUploadWritePixelsFn&
     dataPtr += fBytesPerPixel * fDirtyRect.fLeft;
     // TODO: Make GrDrawOpAtlas store a GrColorType rather than GrPixelConfig.
     auto colorType = GrPixelConfigToColorType(fConfig);
+    SK_METRIC_COUNT("atlas.uploads", 1);
+    SK_METRIC_COUNT("atlas.uploaded_bytes",
+                    fDirtyRect.height() * fDirtyRect.width() * fBytesPerPixel);
     writePixels(proxy, fOffset.fX + fDirtyRect.fLeft, fOffset.fY + fDirtyRect.fTop,
                 fDirtyRect.width(), fDirtyRect.height(), colorType, dataPtr, rowBytes);
     fDirtyRect.setEmpty();
@@ -204,6 +208,7 @@ GrDrawOpAtlas::GrDrawOpAtlas(GrProxyProvider* proxyProvider, const GrBackendForm
 }
 
 inline void GrDrawOpAtlas::processEviction(AtlasID id) {
+    SK_METRIC_COUNT("atlas.plot_evictions", 1);
     for (int i = 0; i < fEvictionCallbacks.count(); i++) {
         (*fEvictionCallbacks[i].fFunc)(id, fEvictionCallbacks[i].fData);
     }
@@ -606,7 +611,8 @@ GrDrawOpAtlasConfig::GrDrawOpAtlasConfig(int maxTextureSize, size_t maxBytes) {
         {512, 512},   // 2^20 <= maxBytes < 2^21
         {1024, 512},  // 2^21 <= maxBytes < 2^22
         {1024, 1024}, // 2^22 <= maxBytes < 2^23
-        {2048, 1024}, // 2^23 <= maxBytes
+        {2048, 1024}, // 2^23 <= maxBytes < 2^24
+        {2048, 2048}, // 2^24 <= maxBytes
     };
 
     // Index 0 corresponds to maxBytes of 2^18, so start by dividing it by that
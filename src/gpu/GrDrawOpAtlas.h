@@ -56,7 +56,7 @@ public:
     /** Is the atlas allowed to use more than one texture? */
     enum class AllowMultitexturing : bool { kNo, kYes };
 
-    static constexpr int kMaxPlots = 32; // restricted by the fPlotAlreadyUpdated bitfield
+    static constexpr int kMaxPlots = 64; // restricted by the fPlotAlreadyUpdated bitfield
                                          // in BulkUseTokenUpdater
 
     /**
@@ -162,8 +162,8 @@ public:
 
     /**
      * A class which can be handed back to GrDrawOpAtlas for updating last use tokens in bulk.  The
-     * current max number of plots per page the GrDrawOpAtlas can handle is 32. If in the future
-     * this is insufficient then we can move to a 64 bit int.
+     * current max number of plots per page the GrDrawOpAtlas can handle is 64, one bit each of a
+     * uint64_t per page.
      */
     class BulkUseTokenUpdater {
     public:
@@ -204,14 +204,13 @@ public:
 
         void set(int pageIdx, int index) {
             SkASSERT(!this->find(pageIdx, index));
-            fPlotAlreadyUpdated[pageIdx] |= (1 << index);
+            fPlotAlreadyUpdated[pageIdx] |= ((uint64_t)1 << index);
             fPlotsToUpdate.push_back(PlotData(pageIdx, index));
         }
 
         static constexpr int kMinItems = 4;
         SkSTArray<kMinItems, PlotData, true> fPlotsToUpdate;
-        uint32_t fPlotAlreadyUpdated[kMaxMultitexturePages]; // TODO: increase this to uint64_t
-                                                             //       to allow more plots per page
+        uint64_t fPlotAlreadyUpdated[kMaxMultitexturePages];
 
         friend class GrDrawOpAtlas;
     };
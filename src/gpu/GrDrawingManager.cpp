@@ -10,6 +10,7 @@
 #include "GrBackendSemaphore.h"
 #include "GrContextPriv.h"
 #include "GrGpu.h"
+#include "GrImageAtlasManager.h"
 #include "GrMemoryPool.h"
 #include "GrOnFlushResourceProvider.h"
 #include "GrOpList.h"
@@ -31,9 +32,30 @@
 #include "SkDeferredDisplayList.h"
 #include "SkSurface_Gpu.h"
 #include "SkTTopoSort.h"
+#include "SkTime.h"
 #include "ccpr/GrCoverageCountingPathRenderer.h"
 #include "text/GrTextContext.h"
 
+namespace {
+
+// Adds the wall time from its construction to its destruction to *nanos, unless nanos is null.
+class AutoFlushTimer {
+public:
+    explicit AutoFlushTimer(uint64_t* nanos)
+            : fNanos(nanos), fStart(nanos ? SkTime::GetNSecs() : 0) {}
+    ~AutoFlushTimer() {
+        if (fNanos) {
+            *fNanos += (uint64_t)(SkTime::GetNSecs() - fStart);
+        }
+    }
+
+private:
+    uint64_t* fNanos;
+    double    fStart;
+};
+
+}  // namespace
+
 GrDrawingManager::OpListDAG::OpListDAG(bool explicitlyAllocating, bool sortOpLists)
         : fSortOpLists(sortOpLists) {
     SkASSERT(!sortOpLists || explicitlyAllocating);
@@ -167,7 +189,9 @@ GrDrawingManager::GrDrawingManager(GrRecordingContext* context,
 
 void GrDrawingManager::cleanup() {
     fDAG.cleanup(fContext->priv().caps());
+    this->deleteTimerQueries();
 
+    fImageAtlasManager = nullptr;
     fPathRendererChain = nullptr;
     fSoftwarePathRenderer = nullptr;
 
@@ -192,6 +216,7 @@ void GrDrawingManager::freeGpuResources() {
 
     // a path renderer may be holding onto resources
     fPathRendererChain = nullptr;
+    fImageAtlasManager = nullptr;
     fSoftwarePathRenderer = nullptr;
 }
 
@@ -231,6 +256,19 @@ GrSemaphoresSubmitted GrDrawingManager::flush(GrSurfaceProxy* proxy,
 
     fFlushing = true;
 
+    // Nothing is timed unless someone wants the stats.
+    GrFlushStats stats = {};
+    stats.fFlushID = ++fFlushCount;
+    fFlushStats = fFlushStatsProc ? &stats : nullptr;
+    const double flushStart = fFlushStats ? SkTime::GetNSecs() : 0;
+    const uint64_t drawsAtStart = gpu->counters().fDraws;
+    const uint64_t meshesAtStart = gpu->counters().fMeshes;
+    const uint64_t programBindsAtStart = gpu->counters().fProgramBinds;
+    GrTimerQuery timerQuery = 0;
+    if (fFlushStats && fTimeFlushesOnGpu) {
+        timerQuery = gpu->startTimerQuery();
+    }
+
     auto resourceProvider = direct->priv().resourceProvider();
     auto resourceCache = direct->priv().getResourceCache();
 
@@ -250,7 +288,14 @@ GrSemaphoresSubmitted GrDrawingManager::flush(GrSurfaceProxy* proxy,
         fCpuBufferCache = GrBufferAllocPool::CpuBufferCache::Make(maxCachedBuffers);
     }
 
-    GrOpFlushState flushState(gpu, resourceProvider, &fTokenTracker, fCpuBufferCache);
+    const GrContextOptions& options = direct->priv().options();
+    SkExecutor* prepareExecutor = options.fPrepareOpsConcurrently ? options.fExecutor : nullptr;
+    GrOpFlushState flushState(gpu, resourceProvider, &fTokenTracker, fCpuBufferCache,
+                              prepareExecutor);
+
+    if (fImageAtlasManager) {
+        fImageAtlasManager->preFlush(&flushState);
+    }
 
     GrOnFlushResourceProvider onFlushProvider(this);
     // TODO: AFAICT the only reason fFlushState is on GrDrawingManager rather than on the
@@ -258,6 +303,7 @@ GrSemaphoresSubmitted GrDrawingManager::flush(GrSurfaceProxy* proxy,
 
     // Prepare any onFlush op lists (e.g. atlases).
     if (!fOnFlushCBObjects.empty()) {
+        AutoFlushTimer prepareTimer(fFlushStats ? &fFlushStats->fPrepareNanos : nullptr);
         fDAG.gatherIDs(&fFlushingOpListIDs);
 
         SkSTArray<4, sk_sp<GrRenderTargetContext>> renderTargetContexts;
@@ -297,17 +343,25 @@ GrSemaphoresSubmitted GrDrawingManager::flush(GrSurfaceProxy* proxy,
     bool flushed = false;
 
     {
+        uint64_t* allocateNanos = fFlushStats ? &fFlushStats->fAllocateNanos : nullptr;
         GrResourceAllocator alloc(resourceProvider, flushState.deinstantiateProxyTracker());
-        for (int i = 0; i < fDAG.numOpLists(); ++i) {
-            if (fDAG.opList(i)) {
-                fDAG.opList(i)->gatherProxyIntervals(&alloc);
+        {
+            AutoFlushTimer allocateTimer(allocateNanos);
+            for (int i = 0; i < fDAG.numOpLists(); ++i) {
+                if (fDAG.opList(i)) {
+                    fDAG.opList(i)->gatherProxyIntervals(&alloc);
+                }
+                alloc.markEndOfOpList(i);
             }
-            alloc.markEndOfOpList(i);
         }
 
         GrResourceAllocator::AssignError error = GrResourceAllocator::AssignError::kNoError;
         int numOpListsExecuted = 0;
-        while (alloc.assign(&startIndex, &stopIndex, &error)) {
+        auto assign = [&] {
+            AutoFlushTimer allocateTimer(allocateNanos);
+            return alloc.assign(&startIndex, &stopIndex, &error);
+        };
+        while (assign()) {
             if (GrResourceAllocator::AssignError::kFailedProxyInstantiation == error) {
                 for (int i = startIndex; i < stopIndex; ++i) {
                     if (fDAG.opList(i) && !fDAG.opList(i)->isFullyInstantiated()) {
@@ -345,9 +399,18 @@ GrSemaphoresSubmitted GrDrawingManager::flush(GrSurfaceProxy* proxy,
     opMemoryPool->isEmpty();
 #endif
 
-    GrSemaphoresSubmitted result = gpu->finishFlush(proxy, access, flags, numSemaphores,
-                                                    backendSemaphores, finishedProc,
-                                                    finishedContext);
+    if (timerQuery) {
+        // Ended before the work is submitted, so that the end is too.
+        gpu->endTimerQuery(timerQuery);
+        fPendingTimerQueries.push_back({stats.fFlushID, timerQuery});
+    }
+
+    GrSemaphoresSubmitted result;
+    {
+        AutoFlushTimer submitTimer(fFlushStats ? &fFlushStats->fSubmitNanos : nullptr);
+        result = gpu->finishFlush(proxy, access, flags, numSemaphores, backendSemaphores,
+                                  finishedProc, finishedContext);
+    }
 
     flushState.deinstantiateProxyTracker()->deinstantiateAllProxies();
 
@@ -361,12 +424,23 @@ GrSemaphoresSubmitted GrDrawingManager::flush(GrSurfaceProxy* proxy,
                                    fFlushingOpListIDs.count());
         flushed = true;
     }
+    if (fImageAtlasManager) {
+        fImageAtlasManager->postFlush(fTokenTracker.nextTokenToFlush());
+    }
     if (flushed) {
         resourceCache->purgeAsNeeded();
     }
     fFlushingOpListIDs.reset();
     fFlushing = false;
 
+    // Readbacks started by earlier flushes may have landed by now.
+    direct->checkAsyncWorkCompletion();
+
+    if (fFlushStats) {
+        stats.fTotalNanos = (uint64_t)(SkTime::GetNSecs() - flushStart);
+        this->reportFlushStats(gpu, flushState, drawsAtStart, meshesAtStart,
+                               programBindsAtStart);
+    }
     return result;
 }
 
@@ -415,11 +489,15 @@ bool GrDrawingManager::executeOpLists(int startIndex, int stopIndex, GrOpFlushSt
         // TODO: handle this instantiation via lazy surface proxies?
         // Instantiate all deferred proxies (being built on worker threads) so we can upload them
         opList->instantiateDeferredProxies(resourceProvider);
+        AutoFlushTimer prepareTimer(fFlushStats ? &fFlushStats->fPrepareNanos : nullptr);
         opList->prepare(flushState);
     }
 
     // Upload all data to the GPU
-    flushState->preExecuteDraws();
+    {
+        AutoFlushTimer uploadTimer(fFlushStats ? &fFlushStats->fUploadNanos : nullptr);
+        flushState->preExecuteDraws();
+    }
 
     // For Vulkan, if we have too many oplists to be flushed we end up allocating a lot of resources
     // for each command buffer associated with the oplists. If this gets too large we can cause the
@@ -430,8 +508,14 @@ bool GrDrawingManager::executeOpLists(int startIndex, int stopIndex, GrOpFlushSt
 
     // Execute the onFlush op lists first, if any.
     for (sk_sp<GrOpList>& onFlushOpList : fOnFlushCBOpLists) {
-        if (!onFlushOpList->execute(flushState)) {
-            SkDebugf("WARNING: onFlushOpList failed to execute.\n");
+        {
+            AutoFlushTimer executeTimer(fFlushStats ? &fFlushStats->fExecuteNanos : nullptr);
+            if (!onFlushOpList->execute(flushState)) {
+                SkDebugf("WARNING: onFlushOpList failed to execute.\n");
+            }
+        }
+        if (fFlushStats) {
+            fFlushStats->fOpLists++;
         }
         SkASSERT(onFlushOpList->unique());
         onFlushOpList = nullptr;
@@ -450,8 +534,14 @@ bool GrDrawingManager::executeOpLists(int startIndex, int stopIndex, GrOpFlushSt
             continue;
         }
 
-        if (fDAG.opList(i)->execute(flushState)) {
-            anyOpListsExecuted = true;
+        {
+            AutoFlushTimer executeTimer(fFlushStats ? &fFlushStats->fExecuteNanos : nullptr);
+            if (fDAG.opList(i)->execute(flushState)) {
+                anyOpListsExecuted = true;
+            }
+        }
+        if (fFlushStats) {
+            fFlushStats->fOpLists++;
         }
         (*numOpListsExecuted)++;
         if (*numOpListsExecuted >= kMaxOpListsBeforeFlush) {
@@ -474,6 +564,70 @@ bool GrDrawingManager::executeOpLists(int startIndex, int stopIndex, GrOpFlushSt
     return anyOpListsExecuted;
 }
 
+void GrDrawingManager::reportFlushStats(GrGpu* gpu, const GrOpFlushState& flushState,
+                                        uint64_t drawsAtStart, uint64_t meshesAtStart,
+                                        uint64_t programBindsAtStart) {
+    // Cleared first, in case the proc flushes again.
+    GrFlushStats* stats = fFlushStats;
+    fFlushStats = nullptr;
+
+    const GrGpu::Counters& counters = gpu->counters();
+    stats->fOpChains = flushState.numOpChainsExecuted();
+    stats->fDraws = SkToInt(counters.fDraws - drawsAtStart);
+    stats->fMeshes = SkToInt(counters.fMeshes - meshesAtStart);
+    stats->fProgramBinds = SkToInt(counters.fProgramBinds - programBindsAtStart);
+    stats->fBytesUploaded = counters.fBytesUploaded - fBytesUploadedAtLastFlush;
+    fBytesUploadedAtLastFlush = counters.fBytesUploaded;
+
+    // Report the newest earlier flush whose GPU work has finished. If the GPU falls too far
+    // behind, give up on the oldest queries rather than let them pile up.
+    static constexpr size_t kMaxPendingTimerQueries = 8;
+    while (!fPendingTimerQueries.empty() &&
+           fPendingTimerQueries.front().fFlushID < stats->fFlushID) {
+        const PendingTimerQuery& oldest = fPendingTimerQueries.front();
+        uint64_t nanos;
+        if (gpu->checkTimerQuery(oldest.fQuery, &nanos)) {
+            stats->fGpuTimedFlushID = oldest.fFlushID;
+            stats->fGpuNanos = nanos;
+        } else if (fPendingTimerQueries.size() <= kMaxPendingTimerQueries) {
+            break;
+        }
+        gpu->deleteTimerQuery(oldest.fQuery);
+        fPendingTimerQueries.pop_front();
+    }
+
+    fFlushStatsProc(fFlushStatsContext, *stats);
+}
+
+void GrDrawingManager::setFlushStatsProc(GrFlushStatsProc proc, GrFlushStatsContext context,
+                                         bool timeGpu) {
+    SkASSERT(!fFlushing);
+    fFlushStatsProc = proc;
+    fFlushStatsContext = context;
+    fTimeFlushesOnGpu = proc && timeGpu;
+    if (!fTimeFlushesOnGpu) {
+        this->deleteTimerQueries();
+    }
+    if (auto direct = fContext->priv().asDirectContext()) {
+        // Uploads before the stats were turned on aren't counted in the first flush's stats.
+        if (GrGpu* gpu = direct->priv().getGpu()) {
+            fBytesUploadedAtLastFlush = gpu->counters().fBytesUploaded;
+        }
+    }
+}
+
+void GrDrawingManager::deleteTimerQueries() {
+    auto direct = fContext->priv().asDirectContext();
+    GrGpu* gpu = direct ? direct->priv().getGpu() : nullptr;
+    // An abandoned context's queries died with its backend context.
+    if (gpu && !this->wasAbandoned()) {
+        for (const PendingTimerQuery& pending : fPendingTimerQueries) {
+            gpu->deleteTimerQuery(pending.fQuery);
+        }
+    }
+    fPendingTimerQueries.clear();
+}
+
 GrSemaphoresSubmitted GrDrawingManager::prepareSurfaceForExternalIO(
         GrSurfaceProxy* proxy, SkSurface::BackendSurfaceAccess access, GrFlushFlags flags,
         int numSemaphores, GrBackendSemaphore backendSemaphores[],
@@ -637,11 +791,13 @@ sk_sp<GrRenderTargetOpList> GrDrawingManager::newRTOpList(GrRenderTargetProxy* r
         resourceProvider = fContext->priv().asDirectContext()->priv().resourceProvider();
     }
 
+    bool sortOpsByState = fContext->priv().options().fSortOpsByState;
     sk_sp<GrRenderTargetOpList> opList(new GrRenderTargetOpList(
                                                         resourceProvider,
                                                         fContext->priv().refOpMemoryPool(),
                                                         rtp,
-                                                        fContext->priv().auditTrail()));
+                                                        fContext->priv().auditTrail(),
+                                                        sortOpsByState));
     SkASSERT(rtp->getLastOpList() == opList.get());
 
     if (managedOpList) {
@@ -752,6 +908,20 @@ GrCoverageCountingPathRenderer* GrDrawingManager::getCoverageCountingPathRendere
     return fPathRendererChain->getCoverageCountingPathRenderer();
 }
 
+GrImageAtlasManager* GrDrawingManager::getImageAtlasManager() {
+    if (!fImageAtlasManager) {
+        auto direct = fContext->priv().asDirectContext();
+        int maxImageSize = fContext->priv().options().fImageAtlasMaxImageSize;
+        if (!direct || maxImageSize <= 0 || this->wasAbandoned()) {
+            return nullptr;
+        }
+        fImageAtlasManager.reset(new GrImageAtlasManager(direct->priv().proxyProvider(),
+                                                         direct->priv().resourceProvider(),
+                                                         &fTokenTracker, maxImageSize));
+    }
+    return fImageAtlasManager.get();
+}
+
 void GrDrawingManager::flushIfNecessary() {
     auto direct = fContext->priv().asDirectContext();
     if (!direct) {
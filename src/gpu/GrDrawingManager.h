@@ -17,7 +17,11 @@
 #include "SkTArray.h"
 #include "text/GrTextContext.h"
 
+#include <deque>
+
 class GrCoverageCountingPathRenderer;
+class GrGpu;
+class GrImageAtlasManager;
 class GrOnFlushCallbackObject;
 class GrOpFlushState;
 class GrRecordingContext;
@@ -68,6 +72,10 @@ public:
     // supported and turned on.
     GrCoverageCountingPathRenderer* getCoverageCountingPathRenderer();
 
+    // Returns the atlas for small, repeatedly drawn images, or null if this isn't a direct context
+    // or GrContextOptions::fImageAtlasMaxImageSize doesn't turn it on.
+    GrImageAtlasManager* getImageAtlasManager();
+
     void flushIfNecessary();
 
     static bool ProgramUnitTest(GrContext* context, int maxStages, int maxLevels);
@@ -148,6 +156,14 @@ private:
 
     void cleanup();
 
+    void setFlushStatsProc(GrFlushStatsProc, GrFlushStatsContext, bool timeGpu);
+
+    // Fills in the GPU timing and the counts of fFlushStats, and reports it.
+    void reportFlushStats(GrGpu*, const GrOpFlushState&, uint64_t drawsAtStart,
+                          uint64_t meshesAtStart, uint64_t programBindsAtStart);
+
+    void deleteTimerQueries();
+
     // return true if any opLists were actually executed; false otherwise
     bool executeOpLists(int startIndex, int stopIndex, GrOpFlushState*, int* numOpListsExecuted);
 
@@ -190,10 +206,26 @@ private:
     sk_sp<GrSoftwarePathRenderer>     fSoftwarePathRenderer;
 
     GrTokenTracker                    fTokenTracker;
+    std::unique_ptr<GrImageAtlasManager> fImageAtlasManager;
     bool                              fFlushing;
     bool                              fReduceOpListSplitting;
 
     SkTArray<GrOnFlushCallbackObject*> fOnFlushCBObjects;
+
+    GrFlushStatsProc                  fFlushStatsProc = nullptr;
+    GrFlushStatsContext               fFlushStatsContext = nullptr;
+    bool                              fTimeFlushesOnGpu = false;
+    uint64_t                          fFlushCount = 0;
+    uint64_t                          fBytesUploadedAtLastFlush = 0;
+    // Points at the stats being collected, if any, while flushing.
+    GrFlushStats*                     fFlushStats = nullptr;
+
+    // Timer queries of earlier flushes, oldest first, whose GPU work may not have finished yet.
+    struct PendingTimerQuery {
+        uint64_t     fFlushID;
+        GrTimerQuery fQuery;
+    };
+    std::deque<PendingTimerQuery>     fPendingTimerQueries;
 };
 
 #endif
@@ -296,6 +296,10 @@ bool GrGpu::writePixels(GrSurface* surface, int left, int top, int width, int he
         SkIRect rect = SkIRect::MakeXYWH(left, top, width, height);
         this->didWriteToSurface(surface, kTopLeft_GrSurfaceOrigin, &rect, mipLevelCount);
         fStats.incTextureUploads();
+        size_t bpp = GrColorTypeBytesPerPixel(srcColorType);
+        for (int i = 0; i < mipLevelCount; i++) {
+            fCounters.fBytesUploaded += bpp * SkTMax(width >> i, 1) * SkTMax(height >> i, 1);
+        }
         return true;
     }
     return false;
@@ -324,12 +328,33 @@ bool GrGpu::transferPixels(GrTexture* texture, int left, int top, int width, int
         SkIRect rect = SkIRect::MakeXYWH(left, top, width, height);
         this->didWriteToSurface(texture, kTopLeft_GrSurfaceOrigin, &rect);
         fStats.incTransfersToTexture();
+        fCounters.fBytesUploaded += GrColorTypeBytesPerPixel(bufferColorType) * width * height;
 
         return true;
     }
     return false;
 }
 
+bool GrGpu::transferPixelsFrom(GrSurface* surface, int left, int top, int width, int height,
+                               GrColorType bufferColorType, GrGpuBuffer* transferBuffer,
+                               size_t offset) {
+    SkASSERT(surface);
+    SkASSERT(transferBuffer);
+
+    // We require that the read region is contained in the surface and fits in the buffer
+    SkIRect subRect = SkIRect::MakeXYWH(left, top, width, height);
+    SkIRect bounds = SkIRect::MakeWH(surface->width(), surface->height());
+    if (!bounds.contains(subRect) ||
+        offset + GrColorTypeBytesPerPixel(bufferColorType) * width * height >
+                transferBuffer->size()) {
+        return false;
+    }
+
+    this->handleDirtyContext();
+    return this->onTransferPixelsFrom(surface, left, top, width, height, bufferColorType,
+                                      transferBuffer, offset);
+}
+
 bool GrGpu::regenerateMipMapLevels(GrTexture* texture) {
     SkASSERT(texture);
     SkASSERT(this->caps()->mipMapSupport());
@@ -227,6 +227,26 @@ public:
                         GrColorType bufferColorType, GrGpuBuffer* transferBuffer, size_t offset,
                         size_t rowBytes);
 
+    /**
+     * Records a copy of a rectangle of a surface into a transfer buffer. Unlike readPixels() this
+     * does not wait for the GPU: the buffer may only be mapped once a fence inserted after the
+     * copy has signaled. The rows are tightly packed and the surface must have top left origin.
+     * Returns false if the backend can't do the copy, in which case the caller should fall back
+     * to readPixels().
+     *
+     * @param surface          The surface to read from.
+     * @param left             left edge of the rectangle to read (inclusive)
+     * @param top              top edge of the rectangle to read (inclusive)
+     * @param width            width of rectangle to read in pixels.
+     * @param height           height of rectangle to read in pixels.
+     * @param bufferColorType  the color type the pixels are written to the buffer in
+     * @param transferBuffer   GrBuffer to write pixels to (type must be "kXferGpuToCpu")
+     * @param offset           offset from the start of the buffer
+     */
+    bool transferPixelsFrom(GrSurface* surface, int left, int top, int width, int height,
+                            GrColorType bufferColorType, GrGpuBuffer* transferBuffer,
+                            size_t offset);
+
     // After the client interacts directly with the 3D context state the GrGpu
     // must resync its internal state and assumptions about 3D context state.
     // Each time this occurs the GrGpu bumps a timestamp.
@@ -296,6 +316,14 @@ public:
     virtual bool waitFence(GrFence, uint64_t timeout = 1000) = 0;
     virtual void deleteFence(GrFence) const = 0;
 
+    // Times the GPU work of flushes for GrContext::setFlushStatsProc(). startTimerQuery() returns 0
+    // if the backend can't. Only one query may be started at a time, and a query's result is
+    // ready once checkTimerQuery() returns true.
+    virtual GrTimerQuery startTimerQuery() { return 0; }
+    virtual void endTimerQuery(GrTimerQuery) {}
+    virtual bool checkTimerQuery(GrTimerQuery, uint64_t* nanos) { return false; }
+    virtual void deleteTimerQuery(GrTimerQuery) {}
+
     virtual sk_sp<GrSemaphore> SK_WARN_UNUSED_RESULT makeSemaphore(bool isOwned = true) = 0;
     virtual sk_sp<GrSemaphore> wrapBackendSemaphore(const GrBackendSemaphore& semaphore,
                                                     GrResourceProvider::SemaphoreWrapType wrapType,
@@ -380,6 +408,23 @@ public:
     };
 
     Stats* stats() { return &fStats; }
+
+    // Running totals behind GrFlushStats, which reports how much each flush adds to them. Unlike
+    // Stats, these are kept in all builds.
+    struct Counters {
+        uint64_t fDraws = 0;
+        uint64_t fMeshes = 0;
+        uint64_t fProgramBinds = 0;
+        uint64_t fBytesUploaded = 0;
+    };
+
+    const Counters& counters() const { return fCounters; }
+    void countDraw(int meshCount) {
+        fCounters.fDraws++;
+        fCounters.fMeshes += meshCount;
+    }
+    void countProgramBind() { fCounters.fProgramBinds++; }
+
     void dumpJSON(SkJSONWriter*) const;
 
 #if GR_TEST_UTILS
@@ -463,12 +508,16 @@ public:
 
     virtual void storeVkPipelineCacheData() {}
 
+    // See GrContext::precompileShader().
+    virtual bool precompileShader(const SkData& key, const SkData& data) { return false; }
+
 protected:
     // Handles cases where a surface will be updated without a call to flushRenderTarget.
     void didWriteToSurface(GrSurface* surface, GrSurfaceOrigin origin, const SkIRect* bounds,
                            uint32_t mipLevels = 1) const;
 
     Stats                            fStats;
+    Counters                         fCounters;
     std::unique_ptr<GrPathRendering> fPathRendering;
     // Subclass must initialize this in its constructor.
     sk_sp<const GrCaps>              fCaps;
@@ -521,6 +570,13 @@ private:
                                   GrColorType colorType, GrGpuBuffer* transferBuffer, size_t offset,
                                   size_t rowBytes) = 0;
 
+    // overridden by backend-specific derived class to perform the transfer out of a surface. The
+    // default reports that the backend has no asynchronous readback.
+    virtual bool onTransferPixelsFrom(GrSurface*, int left, int top, int width, int height,
+                                      GrColorType, GrGpuBuffer* transferBuffer, size_t offset) {
+        return false;
+    }
+
     // overridden by backend-specific derived class to perform the resolve
     virtual void onResolveRenderTarget(GrRenderTarget* target) = 0;
 
@@ -0,0 +1,137 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrImageAtlasManager.h"
+
+#include "GrCaps.h"
+#include "GrProxyProvider.h"
+#include "SkAutoMalloc.h"
+#include "SkBitmap.h"
+#include "SkMetrics.h"
+
+// Each page is split into 4x4 plots of kMaxImageSize.
+static constexpr int kPageSize = 4 * GrImageAtlasManager::kMaxImageSize;
+
+// Images drawn only once aren't worth the copy into the atlas.
+static constexpr int kMinDrawCount = 2;
+
+// How many images' draw counts and locations are remembered.
+static constexpr int kMaxEntries = 1024;
+
+GrImageAtlasManager::GrImageAtlasManager(GrProxyProvider* proxyProvider,
+                                         GrResourceProvider* resourceProvider,
+                                         const GrTokenTracker* tokenTracker, int maxImageSize)
+        : fProxyProvider(proxyProvider)
+        , fResourceProvider(resourceProvider)
+        , fTokenTracker(tokenTracker)
+        , fMaxImageSize(SkTMin(maxImageSize, kMaxImageSize))
+        , fPendingUploads(tokenTracker)
+        , fEntries(kMaxEntries) {}
+
+bool GrImageAtlasManager::initAtlas() {
+    if (!fAtlas && !fAtlasFailed) {
+        const GrCaps* caps = fProxyProvider->caps();
+        const GrBackendFormat format = caps->getBackendFormatFromColorType(kRGBA_8888_SkColorType);
+        if (format.isValid() && caps->isConfigTexturable(kRGBA_8888_GrPixelConfig) &&
+            caps->maxTextureSize() >= kPageSize) {
+            fAtlas = GrDrawOpAtlas::Make(fProxyProvider, format, kRGBA_8888_GrPixelConfig,
+                                         kPageSize, kPageSize, kMaxImageSize, kMaxImageSize,
+                                         GrDrawOpAtlas::AllowMultitexturing::kYes,
+                                         &GrImageAtlasManager::HandleEviction, this);
+        }
+        fAtlasFailed = !fAtlas;
+    }
+    return SkToBool(fAtlas);
+}
+
+void GrImageAtlasManager::HandleEviction(GrDrawOpAtlas::AtlasID id, void* ptr) {
+    auto* manager = static_cast<GrImageAtlasManager*>(ptr);
+    if (SkTArray<uint32_t>* images = manager->fPlotImages.find(id)) {
+        for (uint32_t uniqueID : *images) {
+            Entry* entry = manager->fEntries.find(uniqueID);
+            if (entry && entry->fID == id) {
+                entry->fID = GrDrawOpAtlas::kInvalidAtlasID;
+            }
+        }
+        manager->fPlotImages.remove(id);
+    }
+}
+
+sk_sp<GrTextureProxy> GrImageAtlasManager::findOrAddImage(uint32_t uniqueID,
+                                                          const SkBitmap& bitmap,
+                                                          SkIRect* subset) {
+    int width = bitmap.width();
+    int height = bitmap.height();
+    if (width <= 0 || height <= 0 || width > fMaxImageSize || height > fMaxImageSize ||
+        bitmap.colorType() != kN32_SkColorType || bitmap.alphaType() == kUnpremul_SkAlphaType ||
+        !bitmap.getPixels()) {
+        return nullptr;
+    }
+
+    Entry* entry = fEntries.find(uniqueID);
+    if (!entry) {
+        entry = fEntries.insert(uniqueID, Entry());
+    }
+    entry->fDrawCount++;
+
+    if (entry->fID == GrDrawOpAtlas::kInvalidAtlasID) {
+        if (entry->fDrawCount < kMinDrawCount || !this->initAtlas()) {
+            return nullptr;
+        }
+
+        // The atlas wants tightly packed rows.
+        SkAutoMalloc storage;
+        const void* pixels = bitmap.getPixels();
+        if (bitmap.rowBytes() != bitmap.info().minRowBytes()) {
+            storage.reset(bitmap.computeByteSize());
+            if (!bitmap.readPixels(bitmap.info(), storage.get(), bitmap.info().minRowBytes(),
+                                   0, 0)) {
+                return nullptr;
+            }
+            pixels = storage.get();
+        }
+
+        GrDrawOpAtlas::AtlasID id;
+        SkIPoint16 location;
+        if (GrDrawOpAtlas::ErrorCode::kSucceeded !=
+                fAtlas->addToAtlas(fResourceProvider, &id, &fPendingUploads, width, height, pixels,
+                                   &location)) {
+            // Every plot is read by a draw in the coming flush, or the atlas can't grow.
+            SK_METRIC_COUNT("gpu.image_atlas.full", 1);
+            return nullptr;
+        }
+        SK_METRIC_COUNT("gpu.image_atlas.adds", 1);
+        entry->fID = id;
+        entry->fLocation = location;
+        if (SkTArray<uint32_t>* images = fPlotImages.find(id)) {
+            images->push_back(uniqueID);
+        } else {
+            fPlotImages.set(id, SkTArray<uint32_t>())->push_back(uniqueID);
+        }
+    }
+
+    uint32_t pageIndex = GrDrawOpAtlas::GetPageIndexFromID(entry->fID);
+    SkASSERT(pageIndex < fAtlas->numActivePages() && fAtlas->hasID(entry->fID));
+    // Nothing is drawn between flushes, so nextDrawToken() is the token of the coming flush's first
+    // draw. A plot last used at that token can't be evicted or uploaded to inline until then.
+    fAtlas->setLastUseToken(entry->fID, fTokenTracker->nextDrawToken());
+    *subset = SkIRect::MakeXYWH(entry->fLocation.fX, entry->fLocation.fY, width, height);
+    return fAtlas->getProxies()[pageIndex];
+}
+
+void GrImageAtlasManager::preFlush(GrDeferredUploadTarget* target) {
+    for (GrDeferredTextureUploadFn& upload : fPendingUploads.fUploads) {
+        target->addASAPUpload(std::move(upload));
+    }
+    fPendingUploads.fUploads.reset();
+}
+
+void GrImageAtlasManager::postFlush(GrDeferredUploadToken startTokenForNextFlush) {
+    if (fAtlas) {
+        fAtlas->compact(startTokenForNextFlush);
+    }
+}
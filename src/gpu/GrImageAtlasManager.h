@@ -0,0 +1,103 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrImageAtlasManager_DEFINED
+#define GrImageAtlasManager_DEFINED
+
+#include "GrDeferredUpload.h"
+#include "GrDrawOpAtlas.h"
+#include "SkLRUCache.h"
+#include "SkTArray.h"
+#include "SkTHash.h"
+
+class GrProxyProvider;
+class GrResourceProvider;
+class SkBitmap;
+
+/**
+ * Places small raster images that are drawn repeatedly into shared GrDrawOpAtlas pages, so that
+ * draws of different images (icons, avatars, ...) can sample the same textures and be batched
+ * together. Owned by the GrDrawingManager of a direct context that sets
+ * GrContextOptions::fImageAtlasMaxImageSize.
+ *
+ * Unlike the glyph atlases, images are added while recording rather than while an op prepares its
+ * draws. Their uploads are held until the next flush starts, and then all happen before any of its
+ * draws. An image that would overwrite a plot read by a draw already recorded for that flush is
+ * simply not atlased.
+ */
+class GrImageAtlasManager {
+public:
+    // Largest image, in either dimension, that fits in a plot.
+    static constexpr int kMaxImageSize = 256;
+
+    GrImageAtlasManager(GrProxyProvider*, GrResourceProvider*, const GrTokenTracker*,
+                        int maxImageSize);
+
+    /**
+     * If the image with this unique ID has been drawn before and its pixels are small enough,
+     * returns the atlas page that holds its pixels, and the area of that page they're in. Every
+     * draw of the image should call this, since it both counts the draws and keeps the pixels from
+     * being evicted before the draw executes. Returns null if the image should be drawn as usual.
+     */
+    sk_sp<GrTextureProxy> findOrAddImage(uint32_t uniqueID, const SkBitmap&, SkIRect* subset);
+
+    /** Called as a flush starts, to schedule the uploads of the images added since the last. */
+    void preFlush(GrDeferredUploadTarget*);
+
+    /** Called after a flush, to let the atlas drop pages that are no longer used. */
+    void postFlush(GrDeferredUploadToken startTokenForNextFlush);
+
+private:
+    // Collects the atlas's uploads until the next flush can take them.
+    class PendingUploads : public GrDeferredUploadTarget {
+    public:
+        explicit PendingUploads(const GrTokenTracker* tokenTracker)
+                : fTokenTracker(tokenTracker) {}
+
+        const GrTokenTracker* tokenTracker() override { return fTokenTracker; }
+
+        // GrDrawOpAtlas only asks for an inline upload to a plot none of the recorded draws read,
+        // since they all set their plots' last use to nextDrawToken(). So it can happen first.
+        GrDeferredUploadToken addInlineUpload(GrDeferredTextureUploadFn&& upload) override {
+            return this->addASAPUpload(std::move(upload));
+        }
+
+        GrDeferredUploadToken addASAPUpload(GrDeferredTextureUploadFn&& upload) override {
+            fUploads.push_back(std::move(upload));
+            return fTokenTracker->nextTokenToFlush();
+        }
+
+        SkTArray<GrDeferredTextureUploadFn> fUploads;
+
+    private:
+        const GrTokenTracker* fTokenTracker;
+    };
+
+    struct Entry {
+        int                    fDrawCount = 0;
+        GrDrawOpAtlas::AtlasID fID = GrDrawOpAtlas::kInvalidAtlasID;
+        SkIPoint16             fLocation = {0, 0};
+    };
+
+    bool initAtlas();
+
+    // Forgets the location of every image in the evicted plot.
+    static void HandleEviction(GrDrawOpAtlas::AtlasID, void*);
+
+    GrProxyProvider*               fProxyProvider;
+    GrResourceProvider*            fResourceProvider;
+    const GrTokenTracker*          fTokenTracker;
+    const int                      fMaxImageSize;
+    std::unique_ptr<GrDrawOpAtlas> fAtlas;
+    bool                           fAtlasFailed = false;
+    PendingUploads                 fPendingUploads;
+    SkLRUCache<uint32_t, Entry>    fEntries;
+    // The unique IDs of the images added to each plot, by the plot's ID when they were added.
+    SkTHashMap<GrDrawOpAtlas::AtlasID, SkTArray<uint32_t>> fPlotImages;
+};
+
+#endif
@@ -91,12 +91,13 @@ std::unique_ptr<GrFragmentProcessor> GrYUVAImageTextureMaker::createFragmentProc
     bool coordsLimitedToConstraintRect,
     const GrSamplerState::Filter* filterOrNullForBicubic) {
 
-    // Check simple cases to see if we need to fall back to flattening the image
+    // Check simple cases to see if we need to fall back to flattening the image. Scaled and
+    // translated draws (e.g. a video frame fit to its view) sample the planes directly.
     // TODO: See if we can relax this -- for example, if filterConstraint
     //       is kYes_FilterConstraint we still may not need a TextureDomain
     //       in some cases. Or allow YUVtoRGBEffect to take a wrap mode to
     //       handle ClampToBorder when a decal is needed.
-    if (!textureMatrix.isIdentity() || kNo_FilterConstraint != filterConstraint ||
+    if (kNo_FilterConstraint != filterConstraint ||
         !coordsLimitedToConstraintRect || !filterOrNullForBicubic ||
         this->domainNeedsDecal()) {
         return this->INHERITED::createFragmentProcessor(textureMatrix, constraintRect,
@@ -114,7 +115,7 @@ std::unique_ptr<GrFragmentProcessor> GrYUVAImageTextureMaker::createFragmentProc
     }
 
     auto fp = GrYUVtoRGBEffect::Make(fImage->fProxies, fImage->fYUVAIndices,
-                                     fImage->fYUVColorSpace, filter);
+                                     fImage->fYUVColorSpace, filter, textureMatrix);
     if (fImage->fTargetColorSpace) {
         fp = GrColorSpaceXformEffect::Make(std::move(fp), fImage->fColorSpace.get(),
                                            fImage->alphaType(), fImage->fTargetColorSpace.get());
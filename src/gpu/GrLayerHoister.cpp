@@ -0,0 +1,166 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrLayerHoister.h"
+
+#include "GrContext.h"
+#include "GrContextPriv.h"
+#include "SkBigPicture.h"
+#include "SkCanvas.h"
+#include "SkColorSpace.h"
+#include "SkImage.h"
+#include "SkLayerInfo.h"
+#include "SkRecord.h"
+#include "SkRecordDraw.h"
+#include "SkSurface.h"
+
+namespace {
+
+// Larger layers are drawn normally; caching them would cost more memory than it's likely to save.
+static constexpr int64_t kMaxLayerPixels = 2048 * 2048;
+
+static unsigned gLayerKeyNamespaceLabel;
+
+struct LayerKey : public SkResourceCache::Key {
+public:
+    LayerKey(uint32_t contextID, uint32_t pictureID, int saveLayerOpID, const SkMatrix& matrix,
+             const SkImageInfo& info)
+        : fContextID(contextID)
+        , fPictureID(pictureID)
+        , fSaveLayerOpID(saveLayerOpID)
+        , fColorType(info.colorType())
+        , fColorSpaceHash(info.colorSpace() ? info.colorSpace()->hash() : 0) {
+        fMatrix[0] = matrix.getScaleX();
+        fMatrix[1] = matrix.getSkewX();
+        fMatrix[2] = matrix.getTranslateX();
+        fMatrix[3] = matrix.getSkewY();
+        fMatrix[4] = matrix.getScaleY();
+        fMatrix[5] = matrix.getTranslateY();
+        this->init(&gLayerKeyNamespaceLabel, pictureID,
+                   sizeof(fContextID) + sizeof(fPictureID) + sizeof(fSaveLayerOpID) +
+                   sizeof(fColorType) + sizeof(fColorSpaceHash) + sizeof(fMatrix));
+    }
+
+    uint32_t fContextID;
+    uint32_t fPictureID;
+    int32_t  fSaveLayerOpID;
+    int32_t  fColorType;
+    uint32_t fColorSpaceHash;
+    SkScalar fMatrix[6];
+};
+
+struct LayerRec : public SkResourceCache::Rec {
+    LayerRec(const LayerKey& key, sk_sp<SkImage> image) : fKey(key), fImage(std::move(image)) {}
+
+    LayerKey       fKey;
+    sk_sp<SkImage> fImage;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override {
+        return sizeof(*this) + fImage->width() * fImage->height() *
+                               SkColorTypeBytesPerPixel(fImage->colorType());
+    }
+    const char* getCategory() const override { return "layer"; }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextImage) {
+        const LayerRec& rec = static_cast<const LayerRec&>(baseRec);
+        *static_cast<sk_sp<SkImage>*>(contextImage) = rec.fImage;
+        return true;
+    }
+};
+
+}  // namespace
+
+void GrLayerHoister::drawPicture(SkCanvas* canvas, const SkBigPicture* picture) {
+    const SkLayerInfo* info = picture->layerInfo();
+    const SkMatrix initialCTM = canvas->getTotalMatrix();
+    GrContext* context = canvas->getGrContext();
+    if (!context || !info->numBlocks() || initialCTM.hasPerspective()) {
+        picture->playback(canvas, nullptr);
+        return;
+    }
+
+    // Split the CTM into a layer matrix and an integer translation, so layers can be reused as
+    // their picture moves around by whole pixels.
+    const SkScalar dx = SkScalarFloorToScalar(initialCTM.getTranslateX()),
+                   dy = SkScalarFloorToScalar(initialCTM.getTranslateY());
+    const SkMatrix layerCTM = SkMatrix::Concat(SkMatrix::MakeTrans(-dx, -dy), initialCTM);
+    const SkRecord& record = *picture->record();
+
+    SkAutoCanvasRestore acr(canvas, true);
+    SkRecords::Draw draw(canvas, picture->drawablePicts(), nullptr, picture->drawableCount());
+    int nextBlock = 0;
+    for (int i = 0; i < record.count(); ++i) {
+        if (nextBlock >= info->numBlocks() || info->block(nextBlock).fSaveLayerOpID != i) {
+            record.visit(i, draw);
+            continue;
+        }
+        const SkLayerInfo::BlockInfo& block = info->block(nextBlock++);
+
+        // The layer holds everything drawn in the block, clipped to its hint.
+        SkRect layerRect = layerCTM.mapRect(block.fBounds);
+        if (block.fHint) {
+            const SkMatrix ctm = SkMatrix::Concat(layerCTM, block.fLocalMat);
+            if (!layerRect.intersect(ctm.mapRect(*block.fHint))) {
+                layerRect.setEmpty();
+            }
+        }
+        const SkIRect layerBounds = layerRect.roundOut();
+        SkIRect devBounds = layerBounds;
+        devBounds.offset(SkScalarTruncToInt(dx), SkScalarTruncToInt(dy));
+        if (layerBounds.isEmpty() || (int64_t)layerBounds.width() * layerBounds.height() >
+                                     kMaxLayerPixels) {
+            // Too big to be worth keeping (or empty), so draw the block normally.
+            record.visit(i, draw);
+            continue;
+        }
+
+        if (SkIRect::Intersects(devBounds, canvas->getDeviceClipBounds())) {
+            const SkImageInfo layerInfo = canvas->imageInfo().makeWH(layerBounds.width(),
+                                                                     layerBounds.height());
+            LayerKey key(context->priv().contextID(), picture->uniqueID(), i, layerCTM, layerInfo);
+            sk_sp<SkImage> image;
+            if (!fCache.find(key, LayerRec::Visitor, &image)) {
+                sk_sp<SkSurface> surface = canvas->makeSurface(layerInfo);
+                if (!surface) {
+                    record.visit(i, draw);
+                    continue;
+                }
+
+                // Replay the block's contents as if the layer's origin were the device's.
+                SkCanvas* layerCanvas = surface->getCanvas();
+                layerCanvas->clear(SK_ColorTRANSPARENT);
+                SkMatrix layerInitial = layerCTM;
+                layerInitial.postTranslate(-SkIntToScalar(layerBounds.fLeft),
+                                           -SkIntToScalar(layerBounds.fTop));
+                layerCanvas->setMatrix(SkMatrix::Concat(layerInitial, block.fLocalMat));
+                if (block.fHint) {
+                    layerCanvas->clipRect(*block.fHint);
+                }
+                SkRecordPartialDraw(record, layerCanvas, picture->drawablePicts(),
+                                    picture->drawableCount(), block.fSaveLayerOpID + 1,
+                                    block.fRestoreOpID, layerInitial);
+
+                image = surface->makeImageSnapshot();
+                fCache.add(new LayerRec(key, image));
+            }
+
+            canvas->save();
+            canvas->resetMatrix();
+            canvas->drawImage(image, SkIntToScalar(devBounds.fLeft),
+                              SkIntToScalar(devBounds.fTop), block.fPaint);
+            canvas->restore();
+        }
+
+        // Skip the rest of the block, including any blocks nested inside it.
+        i = block.fRestoreOpID;
+        while (nextBlock < info->numBlocks() &&
+               info->block(nextBlock).fSaveLayerOpID < block.fRestoreOpID) {
+            nextBlock++;
+        }
+    }
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrLayerHoister_DEFINED
+#define GrLayerHoister_DEFINED
+
+#include "SkNoncopyable.h"
+#include "SkResourceCache.h"
+
+class SkBigPicture;
+class SkCanvas;
+
+/**
+ * Draws pictures into GPU canvases, rendering each of their hoistable saveLayer blocks (see
+ * SkLayerInfo) into an image of its own the first time it's drawn and compositing that image on
+ * later draws.  Images are keyed by the picture, the block, the context and the CTM (up to an
+ * integer translation, so scrolling content still hits), and are purged least recently used first
+ * once they exceed the byte limit.
+ *
+ * Not thread safe; it's meant to be owned by one SkMultiPictureDraw.
+ */
+class GrLayerHoister : SkNoncopyable {
+public:
+    explicit GrLayerHoister(size_t byteLimit) : fCache(byteLimit) {}
+
+    // Draws picture into canvas, as canvas->drawPicture(picture) would.
+    void drawPicture(SkCanvas* canvas, const SkBigPicture* picture);
+
+    size_t bytesUsed() const { return fCache.getTotalBytesUsed(); }
+    int layerCount() const { return fCache.getCount(); }
+
+private:
+    SkResourceCache fCache;
+};
+
+#endif
@@ -18,11 +18,48 @@
     #define VALIDATE
 #endif
 
+GrOpMemoryPool::~GrOpMemoryPool() {
+    this->releaseRemoteFrees();
+}
+
+void* GrOpMemoryPool::allocate(size_t size) {
+    fOwner.store(SkGetThreadID(), std::memory_order_relaxed);
+    if (fRemoteFrees.load(std::memory_order_relaxed)) {
+        this->releaseRemoteFrees();
+    }
+    // Leave room to link the memory into fRemoteFrees.
+    return fMemoryPool.allocate(SkTMax(size, sizeof(RemoteFree)));
+}
+
 void GrOpMemoryPool::release(std::unique_ptr<GrOp> op) {
     GrOp* tmp = op.release();
     SkASSERT(tmp);
     tmp->~GrOp();
-    fMemoryPool.release(tmp);
+    this->release(static_cast<void*>(tmp));
+}
+
+void GrOpMemoryPool::release(void* mem) {
+    SkASSERT(mem);
+    if (SkGetThreadID() == fOwner.load(std::memory_order_relaxed)) {
+        fMemoryPool.release(mem);
+        return;
+    }
+
+    // The list lives in the released memory. The owner takes the whole list at once, so pushing
+    // can't suffer from ABA.
+    RemoteFree* node = static_cast<RemoteFree*>(mem);
+    node->fNext = fRemoteFrees.load(std::memory_order_relaxed);
+    while (!fRemoteFrees.compare_exchange_weak(node->fNext, node, std::memory_order_release,
+                                               std::memory_order_relaxed)) {}
+}
+
+void GrOpMemoryPool::releaseRemoteFrees() {
+    RemoteFree* node = fRemoteFrees.exchange(nullptr, std::memory_order_acquire);
+    while (node) {
+        RemoteFree* next = node->fNext;
+        fMemoryPool.release(node);
+        node = next;
+    }
 }
 
 constexpr size_t GrMemoryPool::kSmallestMinAllocSize;
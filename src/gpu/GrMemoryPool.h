@@ -11,6 +11,9 @@
 #include "GrTypes.h"
 
 #include "SkRefCnt.h"
+#include "SkThreadID.h"
+
+#include <atomic>
 
 #ifdef SK_DEBUG
 #include "SkTHash.h"
@@ -128,28 +131,56 @@ class GrOp;
 
 // DDL TODO: for the DLL use case this could probably be the non-intrinsic-based style of
 // ref counting
+/**
+ * A GrMemoryPool for ops. Allocation happens on one thread at a time (the pool's current owner),
+ * and may only move to another thread while the pool is otherwise unused. Release, though, may
+ * happen on any thread, e.g. when a DDL recorded on one thread is replayed and destroyed on
+ * another. Memory released on a thread other than the owner is pushed onto a lock-free list and
+ * handed back to the pool the next time the owner allocates.
+ */
 class GrOpMemoryPool : public SkRefCnt {
 public:
     GrOpMemoryPool(size_t preallocSize, size_t minAllocSize)
-            : fMemoryPool(preallocSize, minAllocSize) {
+            : fMemoryPool(preallocSize, minAllocSize)
+            , fOwner(SkGetThreadID())
+            , fRemoteFrees(nullptr) {
     }
 
+    ~GrOpMemoryPool() override;
+
     template <typename Op, typename... OpArgs>
     std::unique_ptr<Op> allocate(OpArgs&&... opArgs) {
-        char* mem = (char*) fMemoryPool.allocate(sizeof(Op));
+        char* mem = (char*) this->allocate(sizeof(Op));
         return std::unique_ptr<Op>(new (mem) Op(std::forward<OpArgs>(opArgs)...));
     }
 
-    void* allocate(size_t size) {
-        return fMemoryPool.allocate(size);
-    }
+    void* allocate(size_t size);
 
     void release(std::unique_ptr<GrOp> op);
 
-    bool isEmpty() const { return fMemoryPool.isEmpty(); }
+    /**
+     * mem must have been returned by allocate(size_t).
+     */
+    void release(void* mem);
+
+    /**
+     * Memory released on other threads counts as allocated until the owner takes it back.
+     */
+    bool isEmpty() const {
+        return fMemoryPool.isEmpty() && !fRemoteFrees.load(std::memory_order_acquire);
+    }
 
 private:
-    GrMemoryPool fMemoryPool;
+    // Overlays memory released by a thread other than the owner.
+    struct RemoteFree {
+        RemoteFree* fNext;
+    };
+
+    void releaseRemoteFrees();
+
+    GrMemoryPool              fMemoryPool;
+    std::atomic<SkThreadID>   fOwner;
+    std::atomic<RemoteFree*>  fRemoteFrees;
 };
 
 #endif
@@ -53,6 +53,20 @@ public:
 
     void setVertexData(sk_sp<const GrBuffer> vertexBuffer, int baseVertex = 0);
 
+    const GrBuffer* vertexBuffer() const { return fVertexBuffer.get(); }
+    const GrBuffer* instanceBuffer() const { return fInstanceBuffer.get(); }
+    const GrBuffer* indexBuffer() const { return fIndexBuffer.get(); }
+
+    /**
+     * Points the mesh at data that has been copied to another buffer, 'offset' vertices, instances
+     * or indices further in than it was. Used when draws are prepared against staging buffers.
+     * Only non-patterned, non-instanced index data has a base index to move; moveIndexData()
+     * returns false for any other.
+     */
+    void moveVertexData(sk_sp<const GrBuffer>, int offset);
+    void moveInstanceData(sk_sp<const GrBuffer>, int offset);
+    bool moveIndexData(sk_sp<const GrBuffer>, int offset);
+
     class SendToGpuImpl {
     public:
         virtual void sendMeshToGpu(GrPrimitiveType, const GrBuffer* vertexBuffer, int vertexCount,
@@ -218,6 +232,33 @@ inline void GrMesh::setVertexData(sk_sp<const GrBuffer> vertexBuffer, int baseVe
     fBaseVertex = baseVertex;
 }
 
+inline void GrMesh::moveVertexData(sk_sp<const GrBuffer> vertexBuffer, int offset) {
+    SkASSERT(fBaseVertex + offset >= 0);
+    fVertexBuffer = std::move(vertexBuffer);
+    fBaseVertex += offset;
+}
+
+inline void GrMesh::moveInstanceData(sk_sp<const GrBuffer> instanceBuffer, int offset) {
+    SkASSERT(this->isInstanced());
+    SkASSERT(fInstanceData.fBaseInstance + offset >= 0);
+    fInstanceBuffer = std::move(instanceBuffer);
+    fInstanceData.fBaseInstance += offset;
+}
+
+inline bool GrMesh::moveIndexData(sk_sp<const GrBuffer> indexBuffer, int offset) {
+    SkASSERT(this->isIndexed());
+    if (this->isInstanced() || 0 != fIndexData.fPatternRepeatCount) {
+        if (offset) {
+            return false;
+        }
+    } else {
+        SkASSERT(fNonPatternIndexData.fBaseIndex + offset >= 0);
+        fNonPatternIndexData.fBaseIndex += offset;
+    }
+    fIndexBuffer = std::move(indexBuffer);
+    return true;
+}
+
 inline void GrMesh::sendToGpu(SendToGpuImpl* impl) const {
     if (this->isInstanced()) {
         if (!this->isIndexed()) {
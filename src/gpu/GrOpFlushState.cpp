@@ -8,21 +8,25 @@
 #include "GrOpFlushState.h"
 
 #include "GrContextPriv.h"
+#include "GrCpuBuffer.h"
 #include "GrDrawOpAtlas.h"
 #include "GrGpu.h"
 #include "GrResourceProvider.h"
 #include "GrTexture.h"
+#include "SkTHash.h"
 
 //////////////////////////////////////////////////////////////////////////////
 
 GrOpFlushState::GrOpFlushState(GrGpu* gpu, GrResourceProvider* resourceProvider,
                                GrTokenTracker* tokenTracker,
-                               sk_sp<GrBufferAllocPool::CpuBufferCache> cpuBufferCache)
+                               sk_sp<GrBufferAllocPool::CpuBufferCache> cpuBufferCache,
+                               SkExecutor* prepareExecutor)
         : fVertexPool(gpu, cpuBufferCache)
         , fIndexPool(gpu, std::move(cpuBufferCache))
         , fGpu(gpu)
         , fResourceProvider(resourceProvider)
-        , fTokenTracker(tokenTracker) {}
+        , fTokenTracker(tokenTracker)
+        , fPrepareExecutor(prepareExecutor) {}
 
 const GrCaps& GrOpFlushState::caps() const {
     return *fGpu->caps();
@@ -185,6 +189,168 @@ GrAtlasManager* GrOpFlushState::atlasManager() const {
     return fGpu->getContext()->priv().getAtlasManager();
 }
 
+GrOpFlushState::StagedPrepare* GrOpFlushState::makeStagedPrepare(const OpArgs& opArgs) {
+    SkASSERT(opArgs.fOp->canPrepareConcurrently());
+    return fArena.make<StagedPrepare>(this, opArgs);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void GrOpFlushState::StagedPrepare::prepare() {
+    SkASSERT(fOpArgs.fOp->canPrepareConcurrently());
+    static_cast<GrMeshDrawOp*>(fOpArgs.fOp)->onPrepareDraws(this);
+}
+
+void GrOpFlushState::StagedPrepare::commit() {
+    struct Move {
+        sk_sp<const GrBuffer> fBuffer;
+        int fOffset;
+    };
+    SkTHashMap<const GrBuffer*, Move> moves;
+
+    for (const Allocation& allocation : fVertexAllocations) {
+        if (!allocation.fCount) {
+            continue;
+        }
+        Move move;
+        void* vertices = fState->makeVertexSpace(allocation.fElementSize, allocation.fCount,
+                                                 &move.fBuffer, &move.fOffset);
+        if (!vertices) {
+            SkDebugf("Could not allocate vertices\n");
+            return;
+        }
+        memcpy(vertices, allocation.fBuffer->data(), allocation.fElementSize * allocation.fCount);
+        moves.set(allocation.fBuffer.get(), std::move(move));
+    }
+    for (const Allocation& allocation : fIndexAllocations) {
+        if (!allocation.fCount) {
+            continue;
+        }
+        Move move;
+        uint16_t* indices = fState->makeIndexSpace(allocation.fCount, &move.fBuffer,
+                                                   &move.fOffset);
+        if (!indices) {
+            SkDebugf("Could not allocate indices\n");
+            return;
+        }
+        memcpy(indices, allocation.fBuffer->data(), sizeof(uint16_t) * allocation.fCount);
+        moves.set(allocation.fBuffer.get(), std::move(move));
+    }
+
+    fState->setOpArgs(&fOpArgs);
+    for (StagedDraw& draw : fDraws) {
+        GrMesh* meshes = fArena.makeArray<GrMesh>(draw.fMeshCnt);
+        bool moved = true;
+        for (int i = 0; i < draw.fMeshCnt; ++i) {
+            GrMesh& mesh = meshes[i];
+            mesh = draw.fMeshes[i];
+            if (const Move* move = moves.find(mesh.vertexBuffer())) {
+                mesh.moveVertexData(move->fBuffer, move->fOffset);
+            }
+            if (const Move* move = moves.find(mesh.instanceBuffer())) {
+                mesh.moveInstanceData(move->fBuffer, move->fOffset);
+            }
+            if (const Move* move = moves.find(mesh.indexBuffer())) {
+                moved = moved && mesh.moveIndexData(move->fBuffer, move->fOffset);
+            }
+        }
+        if (!moved) {
+            SkDebugf("Staged index data can't be moved for a patterned or instanced mesh\n");
+            continue;
+        }
+        fState->recordDraw(std::move(draw.fGeometryProcessor), meshes, draw.fMeshCnt,
+                           draw.fFixedDynamicState, draw.fDynamicStateArrays);
+    }
+    fState->setOpArgs(nullptr);
+}
+
+void GrOpFlushState::StagedPrepare::recordDraw(
+        sk_sp<const GrGeometryProcessor> gp, const GrMesh meshes[], int meshCnt,
+        const GrPipeline::FixedDynamicState* fixedDynamicState,
+        const GrPipeline::DynamicStateArrays* dynamicStateArrays) {
+    fDraws.push_back({std::move(gp), meshes, meshCnt, fixedDynamicState, dynamicStateArrays});
+}
+
+void* GrOpFlushState::StagedPrepare::stage(SkTArray<Allocation>* allocations, size_t elementSize,
+                                           int count, sk_sp<const GrBuffer>* buffer, int* start) {
+    if (count <= 0) {
+        return nullptr;
+    }
+    sk_sp<GrCpuBuffer> staging = GrCpuBuffer::Make(elementSize * count);
+    void* data = staging->data();
+    *buffer = staging;
+    *start = 0;
+    allocations->push_back({std::move(staging), elementSize, count});
+    return data;
+}
+
+void* GrOpFlushState::StagedPrepare::makeVertexSpace(size_t vertexSize, int vertexCount,
+                                                     sk_sp<const GrBuffer>* buffer,
+                                                     int* startVertex) {
+    return this->stage(&fVertexAllocations, vertexSize, vertexCount, buffer, startVertex);
+}
+
+uint16_t* GrOpFlushState::StagedPrepare::makeIndexSpace(int indexCount,
+                                                        sk_sp<const GrBuffer>* buffer,
+                                                        int* startIndex) {
+    return static_cast<uint16_t*>(
+            this->stage(&fIndexAllocations, sizeof(uint16_t), indexCount, buffer, startIndex));
+}
+
+void* GrOpFlushState::StagedPrepare::makeVertexSpaceAtLeast(size_t vertexSize, int minVertexCount,
+                                                            int fallbackVertexCount,
+                                                            sk_sp<const GrBuffer>* buffer,
+                                                            int* startVertex,
+                                                            int* actualVertexCount) {
+    // There's no partly used buffer to fill, so allocate as if a new one were needed.
+    *actualVertexCount = SkTMax(minVertexCount, fallbackVertexCount);
+    return this->makeVertexSpace(vertexSize, *actualVertexCount, buffer, startVertex);
+}
+
+uint16_t* GrOpFlushState::StagedPrepare::makeIndexSpaceAtLeast(int minIndexCount,
+                                                               int fallbackIndexCount,
+                                                               sk_sp<const GrBuffer>* buffer,
+                                                               int* startIndex,
+                                                               int* actualIndexCount) {
+    *actualIndexCount = SkTMax(minIndexCount, fallbackIndexCount);
+    return this->makeIndexSpace(*actualIndexCount, buffer, startIndex);
+}
+
+void GrOpFlushState::StagedPrepare::putBackIndices(int indexCount) {
+    SkASSERT(!fIndexAllocations.empty() && fIndexAllocations.back().fCount >= indexCount);
+    fIndexAllocations.back().fCount -= indexCount;
+}
+
+void GrOpFlushState::StagedPrepare::putBackVertices(int vertices, size_t vertexStride) {
+    SkASSERT(!fVertexAllocations.empty() && fVertexAllocations.back().fCount >= vertices);
+    SkASSERT(fVertexAllocations.back().fElementSize == vertexStride);
+    fVertexAllocations.back().fCount -= vertices;
+}
+
+GrAppliedClip GrOpFlushState::StagedPrepare::detachAppliedClip() {
+    return fOpArgs.fAppliedClip ? std::move(*fOpArgs.fAppliedClip) : GrAppliedClip();
+}
+
+GrDeferredUploadTarget* GrOpFlushState::StagedPrepare::deferredUploadTarget() {
+    SkDEBUGFAIL("Ops that upload can't prepare concurrently.");
+    return nullptr;
+}
+
+GrResourceProvider* GrOpFlushState::StagedPrepare::resourceProvider() const {
+    SkDEBUGFAIL("Ops that use the resource provider can't prepare concurrently.");
+    return nullptr;
+}
+
+GrStrikeCache* GrOpFlushState::StagedPrepare::glyphCache() const {
+    SkDEBUGFAIL("Ops that use the glyph cache can't prepare concurrently.");
+    return nullptr;
+}
+
+GrAtlasManager* GrOpFlushState::StagedPrepare::atlasManager() const {
+    SkDEBUGFAIL("Ops that use the atlas manager can't prepare concurrently.");
+    return nullptr;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 
 GrOpFlushState::Draw::~Draw() {
@@ -16,12 +16,15 @@
 #include "GrRenderTargetProxy.h"
 #include "SkArenaAlloc.h"
 #include "SkArenaAllocList.h"
+#include "SkTArray.h"
 #include "ops/GrMeshDrawOp.h"
 
+class GrCpuBuffer;
 class GrGpu;
 class GrGpuCommandBuffer;
 class GrGpuRTCommandBuffer;
 class GrResourceProvider;
+class SkExecutor;
 
 /** Tracks the state across all the GrOps (really just the GrDrawOps) in a GrOpList flush. */
 class GrOpFlushState final : public GrDeferredUploadTarget, public GrMeshDrawOp::Target {
@@ -29,8 +32,11 @@ public:
     // vertexSpace and indexSpace may either be null or an alloation of size
     // GrBufferAllocPool::kDefaultBufferSize. If the latter, then CPU memory is only allocated for
     // vertices/indices when a buffer larger than kDefaultBufferSize is required.
+    // If prepareExecutor is non-null, ops that canPrepareConcurrently() may be prepared on its
+    // threads through StagedPrepares.
     GrOpFlushState(GrGpu*, GrResourceProvider*, GrTokenTracker*,
-                   sk_sp<GrBufferAllocPool::CpuBufferCache> = nullptr);
+                   sk_sp<GrBufferAllocPool::CpuBufferCache> = nullptr,
+                   SkExecutor* prepareExecutor = nullptr);
 
     ~GrOpFlushState() final { this->reset(); }
 
@@ -54,6 +60,10 @@ public:
 
     void reset();
 
+    /** Counts, for GrFlushStats, the op chains executed over the whole flush. */
+    void didExecuteOpChain() { fOpChainsExecuted++; }
+    int numOpChainsExecuted() const { return fOpChainsExecuted; }
+
     /** Additional data required on a per-op basis when executing GrOps. */
     struct OpArgs {
         GrSurfaceOrigin origin() const { return fProxy->origin(); }
@@ -74,6 +84,14 @@ public:
         return *fOpArgs;
     }
 
+    SkExecutor* prepareExecutor() const { return fPrepareExecutor; }
+
+    class StagedPrepare;
+
+    /** Makes a StagedPrepare for the op in 'opArgs', which lives until the flush state is reset.
+        Must be called on the flush thread. */
+    StagedPrepare* makeStagedPrepare(const OpArgs& opArgs);
+
     /** Overrides of GrDeferredUploadTarget. */
 
     const GrTokenTracker* tokenTracker() final { return fTokenTracker; }
@@ -159,7 +177,9 @@ private:
     GrGpu* fGpu;
     GrResourceProvider* fResourceProvider;
     GrTokenTracker* fTokenTracker;
+    SkExecutor* fPrepareExecutor;
     GrGpuCommandBuffer* fCommandBuffer = nullptr;
+    int fOpChainsExecuted = 0;
 
     // Variables that are used to track where we are in lists as ops are executed
     SkArenaAllocList<Draw>::Iter fCurrDraw;
@@ -169,4 +189,79 @@ private:
     GrDeinstantiateProxyTracker fDeinstantiateProxyTracker;
 };
 
+/**
+ * A GrMeshDrawOp::Target that lets an op prepare on a thread other than the flush thread. Vertex
+ * and index space comes from CPU staging buffers and the op's draws are held back. Then commit(),
+ * on the flush thread, copies the data into the flush state's pools and records the draws there,
+ * just as if the op had prepared against the flush state itself.
+ */
+class GrOpFlushState::StagedPrepare final : public GrMeshDrawOp::Target {
+public:
+    StagedPrepare(GrOpFlushState* state, const OpArgs& opArgs)
+            : fState(state), fOpArgs(opArgs) {}
+
+    /** Runs the op's onPrepareDraws() against this target. May be called on any thread. */
+    void prepare();
+
+    /** Must be called on the flush thread, after prepare() has finished, at the point where the op
+        would have prepared. */
+    void commit();
+
+    void recordDraw(
+            sk_sp<const GrGeometryProcessor>, const GrMesh[], int meshCnt,
+            const GrPipeline::FixedDynamicState*, const GrPipeline::DynamicStateArrays*) final;
+    void* makeVertexSpace(size_t vertexSize, int vertexCount, sk_sp<const GrBuffer>*,
+                          int* startVertex) final;
+    uint16_t* makeIndexSpace(int indexCount, sk_sp<const GrBuffer>*, int* startIndex) final;
+    void* makeVertexSpaceAtLeast(size_t vertexSize, int minVertexCount, int fallbackVertexCount,
+                                 sk_sp<const GrBuffer>*, int* startVertex,
+                                 int* actualVertexCount) final;
+    uint16_t* makeIndexSpaceAtLeast(int minIndexCount, int fallbackIndexCount,
+                                    sk_sp<const GrBuffer>*, int* startIndex,
+                                    int* actualIndexCount) final;
+    void putBackIndices(int indexCount) final;
+    void putBackVertices(int vertices, size_t vertexStride) final;
+    GrRenderTargetProxy* proxy() const final { return fOpArgs.fProxy; }
+    const GrAppliedClip* appliedClip() final { return fOpArgs.fAppliedClip; }
+    GrAppliedClip detachAppliedClip() final;
+    const GrXferProcessor::DstProxy& dstProxy() const final { return fOpArgs.fDstProxy; }
+    const GrCaps& caps() const final { return fState->caps(); }
+
+    // Ops that prepare concurrently may not use any of these.
+    GrDeferredUploadTarget* deferredUploadTarget() final;
+    GrResourceProvider* resourceProvider() const final;
+    GrStrikeCache* glyphCache() const final;
+    GrAtlasManager* atlasManager() const final;
+
+private:
+    SkArenaAlloc* allocator() override { return &fArena; }
+
+    struct Allocation {
+        sk_sp<GrCpuBuffer> fBuffer;
+        size_t fElementSize;
+        int fCount;
+    };
+
+    struct StagedDraw {
+        sk_sp<const GrGeometryProcessor> fGeometryProcessor;
+        const GrMesh* fMeshes;
+        int fMeshCnt;
+        const GrPipeline::FixedDynamicState* fFixedDynamicState;
+        const GrPipeline::DynamicStateArrays* fDynamicStateArrays;
+    };
+
+    void* stage(SkTArray<Allocation>*, size_t elementSize, int count, sk_sp<const GrBuffer>*,
+                int* start);
+
+    GrOpFlushState* fState;
+    OpArgs fOpArgs;
+
+    // Meshes, dynamic state, and anything else the op allocates while preparing.
+    SkArenaAlloc fArena{1024};
+
+    SkSTArray<2, Allocation> fVertexAllocations;
+    SkSTArray<2, Allocation> fIndexAllocations;
+    SkSTArray<2, StagedDraw> fDraws;
+};
+
 #endif
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrPaintConversionCache.h"
+
+#include "GrColorSpaceInfo.h"
+#include "GrPaint.h"
+#include "SkPaint.h"
+
+bool GrPaintConversionCache::Key::operator==(const Key& that) const {
+    return fShader == that.fShader &&
+           fColorFilter == that.fColorFilter &&
+           fMaskFilter == that.fMaskFilter &&
+           fViewMatrix == that.fViewMatrix &&
+           fColor == that.fColor &&
+           fConfig == that.fConfig &&
+           fFilterQuality == that.fFilterQuality &&
+           fBlendMode == that.fBlendMode &&
+           fDither == that.fDither &&
+           fHasPrimColorMode == that.fHasPrimColorMode &&
+           (!fHasPrimColorMode || fPrimColorMode == that.fPrimColorMode) &&
+           SkColorSpace::Equals(fColorSpace.get(), that.fColorSpace.get());
+}
+
+bool GrPaintConversionCache::MakeKey(const SkPaint& paint, const GrColorSpaceInfo& colorSpaceInfo,
+                                     const SkMatrix& viewM, const SkBlendMode* primColorMode,
+                                     Key* key) {
+    // Without a shader or mask filter the conversion is little more than a color, unless a color
+    // filter has to become a fragment processor too.
+    bool usesViewMatrix = paint.getShader() || paint.getMaskFilter();
+    if (!usesViewMatrix && !(paint.getColorFilter() && primColorMode)) {
+        return false;
+    }
+
+    key->fShader = paint.refShader();
+    key->fColorFilter = paint.refColorFilter();
+    key->fMaskFilter = paint.refMaskFilter();
+    key->fColorSpace = colorSpaceInfo.refColorSpace();
+    key->fViewMatrix = usesViewMatrix ? viewM : SkMatrix::I();
+    key->fColor = paint.getColor4f();
+    key->fConfig = colorSpaceInfo.config();
+    key->fFilterQuality = paint.getFilterQuality();
+    key->fBlendMode = paint.getBlendMode();
+    key->fDither = paint.isDither();
+    key->fHasPrimColorMode = SkToBool(primColorMode);
+    key->fPrimColorMode = primColorMode ? *primColorMode : SkBlendMode::kDst;
+    return true;
+}
+
+GrPaintConversionCache::Entry* GrPaintConversionCache::findAndPromote(const Key& key) {
+    for (int i = 0; i < fCount; ++i) {
+        if (fEntries[i]->fKey == key) {
+            std::unique_ptr<Entry> entry = std::move(fEntries[i]);
+            for (int j = i; j > 0; --j) {
+                fEntries[j] = std::move(fEntries[j - 1]);
+            }
+            fEntries[0] = std::move(entry);
+            return fEntries[0].get();
+        }
+    }
+    return nullptr;
+}
+
+bool GrPaintConversionCache::find(const Key& key, GrPaint* grPaint) {
+    SkASSERT(grPaint->isTrivial());
+    Entry* entry = this->findAndPromote(key);
+    if (!entry || !entry->fHasPaint) {
+        return false;
+    }
+
+    grPaint->setColor4f(entry->fColor);
+    grPaint->setXPFactory(entry->fXPFactory);
+    for (const auto& fp : entry->fColorFragmentProcessors) {
+        grPaint->addColorFragmentProcessor(fp->clone());
+    }
+    for (const auto& fp : entry->fCoverageFragmentProcessors) {
+        grPaint->addCoverageFragmentProcessor(fp->clone());
+    }
+    return true;
+}
+
+void GrPaintConversionCache::add(const Key& key, const GrPaint& grPaint) {
+    Entry* entry = this->findAndPromote(key);
+    if (!entry) {
+        // First sighting: remember the key, and copy the paint if it's converted again.
+        if (fCount < kMaxEntries) {
+            ++fCount;
+        }
+        for (int i = fCount - 1; i > 0; --i) {
+            fEntries[i] = std::move(fEntries[i - 1]);
+        }
+        fEntries[0].reset(new Entry);
+        fEntries[0]->fKey = key;
+        return;
+    }
+    if (entry->fHasPaint) {
+        return;
+    }
+
+    entry->fColor = grPaint.getColor4f();
+    entry->fXPFactory = grPaint.getXPFactory();
+    for (int i = 0; i < grPaint.numColorFragmentProcessors(); ++i) {
+        entry->fColorFragmentProcessors.push_back(grPaint.getColorFragmentProcessor(i)->clone());
+    }
+    for (int i = 0; i < grPaint.numCoverageFragmentProcessors(); ++i) {
+        entry->fCoverageFragmentProcessors.push_back(
+                grPaint.getCoverageFragmentProcessor(i)->clone());
+    }
+    entry->fHasPaint = true;
+}
+
+void GrPaintConversionCache::reset() {
+    for (int i = 0; i < fCount; ++i) {
+        fEntries[i].reset();
+    }
+    fCount = 0;
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrPaintConversionCache_DEFINED
+#define GrPaintConversionCache_DEFINED
+
+#include "GrFragmentProcessor.h"
+#include "GrTypesPriv.h"
+#include "SkBlendMode.h"
+#include "SkColor.h"
+#include "SkColorFilter.h"
+#include "SkColorSpace.h"
+#include "SkFilterQuality.h"
+#include "SkMaskFilter.h"
+#include "SkMatrix.h"
+#include "SkNoncopyable.h"
+#include "SkShader.h"
+#include "SkTArray.h"
+
+class GrColorSpaceInfo;
+class GrPaint;
+class GrXPFactory;
+class SkPaint;
+
+/**
+ * A small MRU cache of SkPaint to GrPaint conversions (see SkPaintToGrPaint() in SkGr.h), for the
+ * runs of draws that share a paint. A hit clones the cached fragment processors rather than asking
+ * the shader, color filter and mask filter to create them again. Shaders, color filters and mask
+ * filters are immutable, so they're keyed by identity; the cache holds refs to keep those
+ * identities from being reused.
+ *
+ * Paints are only cached the second time they're converted, so one-off paints (e.g. shaders drawn
+ * with an animating matrix) don't pay for the copy.
+ */
+class GrPaintConversionCache : public SkNoncopyable {
+public:
+    /** Everything SkPaintToGrPaint() and SkPaintToGrPaintWithXfermode() convert depends on. */
+    struct Key {
+        sk_sp<SkShader>      fShader;
+        sk_sp<SkColorFilter> fColorFilter;
+        sk_sp<SkMaskFilter>  fMaskFilter;
+        sk_sp<SkColorSpace>  fColorSpace;
+        SkMatrix             fViewMatrix;
+        SkColor4f            fColor;
+        GrPixelConfig        fConfig;
+        SkFilterQuality      fFilterQuality;
+        SkBlendMode          fBlendMode;
+        bool                 fDither;
+        bool                 fHasPrimColorMode;
+        SkBlendMode          fPrimColorMode;
+
+        bool operator==(const Key&) const;
+    };
+
+    /**
+     * Fills out key and returns true if the conversion is worth caching, which is when it creates
+     * fragment processors the shader, color filter or mask filter have to build.
+     */
+    static bool MakeKey(const SkPaint&, const GrColorSpaceInfo&, const SkMatrix& viewM,
+                        const SkBlendMode* primColorMode, Key* key);
+
+    /**
+     * If key's conversion is cached, adds it (with cloned fragment processors) to grPaint, which
+     * must be freshly constructed, and returns true.
+     */
+    bool find(const Key&, GrPaint* grPaint);
+
+    /** Records grPaint as the conversion for key. */
+    void add(const Key&, const GrPaint& grPaint);
+
+    void reset();
+
+private:
+    static constexpr int kMaxEntries = 8;
+
+    struct Entry {
+        Key                                                fKey;
+        bool                                               fHasPaint = false;
+        SkPMColor4f                                        fColor;
+        const GrXPFactory*                                 fXPFactory = nullptr;
+        SkSTArray<4, std::unique_ptr<GrFragmentProcessor>> fColorFragmentProcessors;
+        SkSTArray<2, std::unique_ptr<GrFragmentProcessor>> fCoverageFragmentProcessors;
+    };
+
+    // Moves key's entry, if there is one, to the front and returns it.
+    Entry* findAndPromote(const Key&);
+
+    // Most recently used first.
+    std::unique_ptr<Entry> fEntries[kMaxEntries];
+    int                    fCount = 0;
+};
+
+#endif
@@ -24,6 +24,7 @@
 #include "ops/GrDefaultPathRenderer.h"
 #include "ops/GrStencilAndCoverPathRenderer.h"
 #include "ops/GrTessellatingPathRenderer.h"
+#include "skc/GrSkcPathRenderer.h"
 
 GrPathRendererChain::GrPathRendererChain(GrRecordingContext* context, const Options& options) {
     const GrCaps& caps = *context->priv().caps();
@@ -55,6 +56,15 @@ GrPathRendererChain::GrPathRendererChain(GrRecordingContext* context, const Opti
             fChain.push_back(std::move(ccpr));
         }
     }
+#if SK_ENABLE_SKC
+    if (options.fGpuPathRenderers & GpuPathRenderers::kSkc) {
+        if (auto direct = context->priv().asDirectContext()) {
+            if (auto skc = GrSkcPathRenderer::CreateIfSupported(direct->priv().proxyProvider())) {
+                fChain.push_back(std::move(skc));
+            }
+        }
+    }
+#endif
     if (options.fGpuPathRenderers & GpuPathRenderers::kAAHairline) {
         fChain.push_back(sk_make_sp<GrAAHairLinePathRenderer>());
     }
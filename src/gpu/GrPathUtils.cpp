@@ -13,6 +13,34 @@
 
 static const SkScalar gMinCurveTol = 0.0001f;
 
+// SkPointPriv::DistanceToLineSegmentBetweenSqd() for two points at once, one per lane, with the
+// same arithmetic so the flatness tests below don't change.
+static Sk2s distance_to_segment_sqd(const Sk2s& ptX, const Sk2s& ptY,
+                                    const SkPoint& a, const SkPoint& b) {
+    Sk2s ux = b.fX - a.fX,
+         uy = b.fY - a.fY,
+         vx = ptX - a.fX,
+         vy = ptY - a.fY,
+         wx = b.fX - ptX,
+         wy = b.fY - ptY;
+
+    Sk2s uLengthSqd = ux * ux + uy * uy,
+         uDotV      = ux * vx + uy * vy,
+         vLengthSqd = vx * vx + vy * vy,
+         wLengthSqd = wx * wx + wy * wy;
+
+    Sk2s det  = ux * vy - uy * vx,
+         temp = det / uLengthSqd * det;
+    // A degenerate segment, or a point so far away it looks like one, measures to point A.
+    temp = (temp * 0 == 0).thenElse(temp, vLengthSqd);
+
+    return (uDotV <= 0).thenElse(vLengthSqd, (uDotV > uLengthSqd).thenElse(wLengthSqd, temp));
+}
+
+static inline Sk2s ave(const Sk2s& a, const Sk2s& b) {
+    return (a + b) * SK_ScalarHalf;
+}
+
 SkScalar GrPathUtils::scaleToleranceToSrc(SkScalar devTol,
                                           const SkMatrix& viewM,
                                           const SkRect& pathBounds) {
@@ -89,15 +117,18 @@ uint32_t GrPathUtils::generateQuadraticPoints(const SkPoint& p0,
         return 1;
     }
 
-    SkPoint q[] = {
-        { SkScalarAve(p0.fX, p1.fX), SkScalarAve(p0.fY, p1.fY) },
-        { SkScalarAve(p1.fX, p2.fX), SkScalarAve(p1.fY, p2.fY) },
-    };
-    SkPoint r = { SkScalarAve(q[0].fX, q[1].fX), SkScalarAve(q[0].fY, q[1].fY) };
+    // Split at t = 1/2, with x and y of each point in one register.
+    Sk2s P0 = from_point(p0),
+         P1 = from_point(p1),
+         P2 = from_point(p2);
+    Sk2s q0 = ave(P0, P1),
+         q1 = ave(P1, P2),
+         r  = ave(q0, q1);
+    SkPoint mid = to_point(r);
 
     pointsLeft >>= 1;
-    uint32_t a = generateQuadraticPoints(p0, q[0], r, tolSqd, points, pointsLeft);
-    uint32_t b = generateQuadraticPoints(r, q[1], p2, tolSqd, points, pointsLeft);
+    uint32_t a = generateQuadraticPoints(p0, to_point(q0), mid, tolSqd, points, pointsLeft);
+    uint32_t b = generateQuadraticPoints(mid, to_point(q1), p2, tolSqd, points, pointsLeft);
     return a + b;
 }
 
@@ -139,26 +170,33 @@ uint32_t GrPathUtils::generateCubicPoints(const SkPoint& p0,
                                           SkScalar tolSqd,
                                           SkPoint** points,
                                           uint32_t pointsLeft) {
-    if (pointsLeft < 2 ||
-        (SkPointPriv::DistanceToLineSegmentBetweenSqd(p1, p0, p3) < tolSqd &&
-         SkPointPriv::DistanceToLineSegmentBetweenSqd(p2, p0, p3) < tolSqd)) {
+    // Both control points' distances from the chord, in one pass. Non-finite curves stop here
+    // rather than subdividing all the way down to pointsLeft.
+    Sk2s d = distance_to_segment_sqd({p1.fX, p2.fX}, {p1.fY, p2.fY}, p0, p3);
+    if (pointsLeft < 2 || (d < tolSqd).allTrue() || !(d * 0 == 0).allTrue()) {
         (*points)[0] = p3;
         *points += 1;
         return 1;
     }
-    SkPoint q[] = {
-        { SkScalarAve(p0.fX, p1.fX), SkScalarAve(p0.fY, p1.fY) },
-        { SkScalarAve(p1.fX, p2.fX), SkScalarAve(p1.fY, p2.fY) },
-        { SkScalarAve(p2.fX, p3.fX), SkScalarAve(p2.fY, p3.fY) }
-    };
-    SkPoint r[] = {
-        { SkScalarAve(q[0].fX, q[1].fX), SkScalarAve(q[0].fY, q[1].fY) },
-        { SkScalarAve(q[1].fX, q[2].fX), SkScalarAve(q[1].fY, q[2].fY) }
-    };
-    SkPoint s = { SkScalarAve(r[0].fX, r[1].fX), SkScalarAve(r[0].fY, r[1].fY) };
+
+    // Split at t = 1/2, with x and y of each point in one register.
+    Sk2s P0 = from_point(p0),
+         P1 = from_point(p1),
+         P2 = from_point(p2),
+         P3 = from_point(p3);
+    Sk2s q0 = ave(P0, P1),
+         q1 = ave(P1, P2),
+         q2 = ave(P2, P3),
+         r0 = ave(q0, q1),
+         r1 = ave(q1, q2),
+         s  = ave(r0, r1);
+    SkPoint mid = to_point(s);
+
     pointsLeft >>= 1;
-    uint32_t a = generateCubicPoints(p0, q[0], r[0], s, tolSqd, points, pointsLeft);
-    uint32_t b = generateCubicPoints(s, r[1], q[2], p3, tolSqd, points, pointsLeft);
+    uint32_t a = generateCubicPoints(p0, to_point(q0), to_point(r0), mid, tolSqd, points,
+                                     pointsLeft);
+    uint32_t b = generateCubicPoints(mid, to_point(r1), to_point(q2), p3, tolSqd, points,
+                                     pointsLeft);
     return a + b;
 }
 
@@ -199,6 +199,22 @@ public:
     // Used by Vulkan and Metal to cache their respective pipeline objects
     uint32_t getBlendInfoKey() const;
 
+    /**
+     * The fragment and xfer processors' part of the pipeline's GrProgramDesc key. It doesn't
+     * depend on the primitive processor beyond a few words GrProgramDesc::Build() patches, so
+     * Build() memoizes it here for the draws that share the pipeline.
+     */
+    struct ProcessorKeys {
+        SkTArray<uint8_t, true> fKeys;
+        // Index (in uint32_ts) of each processor's meta key in fKeys: the FPs' in key order, then
+        // the XP's.
+        SkTArray<int, true> fMetaKeyIndices;
+        GrProcessor::CustomFeatures fFeatures = GrProcessor::CustomFeatures::kNone;
+        bool fValid = false;
+    };
+
+    ProcessorKeys* processorKeys() const { return &fProcessorKeys; }
+
 private:
     void markAsBad() { fFlags |= kIsBad_Flag; }
 
@@ -223,6 +239,8 @@ private:
 
     // This value is also the index in fFragmentProcessors where coverage processors begin.
     int fNumColorProcessors;
+
+    mutable ProcessorKeys fProcessorKeys;
 };
 
 #endif
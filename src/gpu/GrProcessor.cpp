@@ -57,8 +57,8 @@ SkTArray<GrXPFactoryTestFactory*, true>* GrXPFactoryTestFactory::GetFactories()
  * we verify the count is as expected.  If a new factory is added, then these numbers must be
  * manually adjusted.
  */
-static const int kFPFactoryCount = 36;
-static const int kGPFactoryCount = 14;
+static const int kFPFactoryCount = 37;
+static const int kGPFactoryCount = 15;
 static const int kXPFactoryCount = 4;
 
 template <>
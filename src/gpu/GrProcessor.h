@@ -102,16 +102,20 @@ public:
         kGrConstColorProcessor_ClassID,
         kGrConvexPolyEffect_ClassID,
         kGrDeviceSpaceTextureDecalFragmentProcessor_ClassID,
+        kGrDifferenceClipEffect_ClassID,
         kGrDiffuseLightingEffect_ClassID,
         kGrDisplacementMapEffect_ClassID,
         kGrDistanceFieldA8TextGeoProc_ClassID,
         kGrDistanceFieldLCDTextGeoProc_ClassID,
         kGrDistanceFieldPathGeoProc_ClassID,
         kGrDitherEffect_ClassID,
+        kGrDrawPatchOp_Processor_ClassID,
         kGrDualIntervalGradientColorizer_ClassID,
         kGrEllipseEffect_ClassID,
+        kGrFillRectOp_InstancedProcessor_ClassID,
         kGrGaussianConvolutionFragmentProcessor_ClassID,
         kGrImprovedPerlinNoiseEffect_ClassID,
+        kGrInstancedRRectShadowGeoProc_ClassID,
         kGrLightingEffect_ClassID,
         kGrLinearGradient_ClassID,
         kGrLinearGradientLayout_ClassID,
@@ -149,6 +153,8 @@ public:
         kGrYUVtoRGBEffect_ClassID,
         kHighContrastFilterEffect_ClassID,
         kInstanceProcessor_ClassID,
+        kInstancedHairlineGP_ClassID,
+        kInstancedLatticeGP_ClassID,
         kLatticeGP_ClassID,
         kLumaColorFilterEffect_ClassID,
         kMSAAQuadProcessor_ClassID,
@@ -163,21 +163,76 @@ static bool gen_meta_key(const GrXferProcessor& xp,
     return true;
 }
 
-static bool gen_frag_proc_and_meta_keys(const GrPrimitiveProcessor& primProc,
-                                        const GrFragmentProcessor& fp,
+// The transform keys depend on the primitive processor, so these keys leave them zero for
+// add_transform_keys() to fill in. Records where each meta key went in metaKeyIndices.
+static bool gen_frag_proc_and_meta_keys(const GrFragmentProcessor& fp,
                                         GrGpu* gpu,
                                         const GrShaderCaps& shaderCaps,
-                                        GrProcessorKeyBuilder* b) {
+                                        GrProcessorKeyBuilder* b,
+                                        SkTArray<int, true>* metaKeyIndices) {
     for (int i = 0; i < fp.numChildProcessors(); ++i) {
-        if (!gen_frag_proc_and_meta_keys(primProc, fp.childProcessor(i), gpu, shaderCaps, b)) {
+        if (!gen_frag_proc_and_meta_keys(fp.childProcessor(i), gpu, shaderCaps, b,
+                                         metaKeyIndices)) {
             return false;
         }
     }
 
     fp.getGLSLProcessorKey(shaderCaps, b);
 
-    return gen_meta_key(fp, gpu, shaderCaps, primProc.getTransformKey(fp.coordTransforms(),
-                                                                      fp.numCoordTransforms()), b);
+    if (!gen_meta_key(fp, gpu, shaderCaps, 0, b)) {
+        return false;
+    }
+    metaKeyIndices->push_back(SkToInt(b->size() / sizeof(uint32_t)) - 2);
+    return true;
+}
+
+static void add_transform_keys(const GrPrimitiveProcessor& primProc,
+                               const GrFragmentProcessor& fp,
+                               uint32_t* k32,
+                               const int** metaKeyIndex) {
+    for (int i = 0; i < fp.numChildProcessors(); ++i) {
+        add_transform_keys(primProc, fp.childProcessor(i), k32, metaKeyIndex);
+    }
+    k32[*(*metaKeyIndex)++ + 1] = primProc.getTransformKey(fp.coordTransforms(),
+                                                           fp.numCoordTransforms());
+}
+
+// Builds the keys of the pipeline's fragment and xfer processors, with meta key sizes relative to
+// the start of the FP keys.
+static bool gen_processor_keys(const GrPipeline& pipeline, GrGpu* gpu,
+                               const GrShaderCaps& shaderCaps,
+                               GrPipeline::ProcessorKeys* keys) {
+    keys->fKeys.reset();
+    keys->fMetaKeyIndices.reset();
+
+    GrProcessorKeyBuilder b(&keys->fKeys);
+    GrProcessor::CustomFeatures processorFeatures = GrProcessor::CustomFeatures::kNone;
+
+    for (int i = 0; i < pipeline.numFragmentProcessors(); ++i) {
+        const GrFragmentProcessor& fp = pipeline.getFragmentProcessor(i);
+        if (!gen_frag_proc_and_meta_keys(fp, gpu, shaderCaps, &b, &keys->fMetaKeyIndices)) {
+            return false;
+        }
+        processorFeatures |= fp.requestedFeatures();
+    }
+
+    const GrXferProcessor& xp = pipeline.getXferProcessor();
+    const GrSurfaceOrigin* originIfDstTexture = nullptr;
+    GrSurfaceOrigin origin;
+    if (pipeline.dstTextureProxy()) {
+        origin = pipeline.dstTextureProxy()->origin();
+        originIfDstTexture = &origin;
+    }
+    xp.getGLSLProcessorKey(shaderCaps, &b, originIfDstTexture);
+    if (!gen_meta_key(xp, shaderCaps, &b)) {
+        return false;
+    }
+    keys->fMetaKeyIndices.push_back(SkToInt(b.size() / sizeof(uint32_t)) - 1);
+    processorFeatures |= xp.requestedFeatures();
+
+    keys->fFeatures = processorFeatures;
+    keys->fValid = true;
+    return true;
 }
 
 bool GrProgramDesc::Build(
@@ -206,28 +261,32 @@ bool GrProgramDesc::Build(
     }
     GrProcessor::CustomFeatures processorFeatures = primProc.requestedFeatures();
 
-    for (int i = 0; i < pipeline.numFragmentProcessors(); ++i) {
-        const GrFragmentProcessor& fp = pipeline.getFragmentProcessor(i);
-        if (!gen_frag_proc_and_meta_keys(primProc, fp, gpu, shaderCaps, &b)) {
+    // The FP and XP keys only change with the pipeline, so they're built once per pipeline. Only
+    // their meta keys' running sizes and the FPs' transform keys depend on the primitive
+    // processor, and those are patched in here.
+    GrPipeline::ProcessorKeys* processorKeys = pipeline.processorKeys();
+    if (!processorKeys->fValid && !gen_processor_keys(pipeline, gpu, shaderCaps, processorKeys)) {
+        desc->key().reset();
+        return false;
+    }
+    const uint32_t primProcKeySize = SkToU32(b.size());
+    const int processorKeyCount = processorKeys->fKeys.count() / sizeof(uint32_t);
+    uint32_t* k32 = b.add32n(processorKeyCount);
+    memcpy(k32, processorKeys->fKeys.begin(), processorKeys->fKeys.count());
+    for (int metaKeyIndex : processorKeys->fMetaKeyIndices) {
+        // Sizes are the low 16 bits of the meta keys.
+        if ((k32[metaKeyIndex] & UINT16_MAX) + primProcKeySize > UINT16_MAX) {
             desc->key().reset();
             return false;
         }
-        processorFeatures |= fp.requestedFeatures();
-    }
-
-    const GrXferProcessor& xp = pipeline.getXferProcessor();
-    const GrSurfaceOrigin* originIfDstTexture = nullptr;
-    GrSurfaceOrigin origin;
-    if (pipeline.dstTextureProxy()) {
-        origin = pipeline.dstTextureProxy()->origin();
-        originIfDstTexture = &origin;
+        k32[metaKeyIndex] += primProcKeySize;
     }
-    xp.getGLSLProcessorKey(shaderCaps, &b, originIfDstTexture);
-    if (!gen_meta_key(xp, shaderCaps, &b)) {
-        desc->key().reset();
-        return false;
+    const int* metaKeyIndex = processorKeys->fMetaKeyIndices.begin();
+    for (int i = 0; i < pipeline.numFragmentProcessors(); ++i) {
+        add_transform_keys(primProc, pipeline.getFragmentProcessor(i), k32, &metaKeyIndex);
     }
-    processorFeatures |= xp.requestedFeatures();
+    SkASSERT(metaKeyIndex == processorKeys->fMetaKeyIndices.end() - 1);
+    processorFeatures |= processorKeys->fFeatures;
 
     if (processorFeatures & GrProcessor::CustomFeatures::kSampleLocations) {
         SkASSERT(pipeline.isHWAntialiasState());
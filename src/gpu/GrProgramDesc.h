@@ -42,6 +42,17 @@ public:
     static bool Build(GrProgramDesc*, const GrRenderTarget*, const GrPrimitiveProcessor&,
                       bool hasPointSize, const GrPipeline&, GrGpu*);
 
+    // Recreates a descriptor from the bytes of an earlier one's asKey(), e.g. as handed to a
+    // PersistentCache.
+    static bool BuildFromData(GrProgramDesc* desc, const void* keyData, size_t keyLength) {
+        if (!SkTFitsIn<int>(keyLength) || !SkIsAlign4(keyLength) || keyLength < kHeaderSize) {
+            return false;
+        }
+        desc->fKey.reset(SkToInt(keyLength));
+        memcpy(desc->fKey.begin(), keyData, keyLength);
+        return true;
+    }
+
     // Returns this as a uint32_t array to be used as a key in the program cache.
     const uint32_t* asKey() const {
         return reinterpret_cast<const uint32_t*>(fKey.begin());
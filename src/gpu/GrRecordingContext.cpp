@@ -11,6 +11,7 @@
 #include "GrContext.h"
 #include "GrDrawingManager.h"
 #include "GrMemoryPool.h"
+#include "GrPaintConversionCache.h"
 #include "GrProxyProvider.h"
 #include "GrRecordingContextPriv.h"
 #include "GrRenderTargetContext.h"
@@ -61,6 +62,8 @@ bool GrRecordingContext::init(sk_sp<const GrCaps> caps, sk_sp<GrSkSLFPFactoryCac
     fTextBlobCache.reset(new GrTextBlobCache(textblobcache_overbudget_CB, this,
                                              this->contextID()));
 
+    fPaintConversionCache.reset(new GrPaintConversionCache);
+
     return true;
 }
 
@@ -111,6 +114,7 @@ void GrRecordingContext::abandonContext() {
 
     fStrikeCache->freeAll();
     fTextBlobCache->freeAll();
+    fPaintConversionCache->reset();
 }
 
 GrDrawingManager* GrRecordingContext::drawingManager() {
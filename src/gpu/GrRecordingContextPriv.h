@@ -53,6 +53,10 @@ public:
     GrStrikeCache* getGrStrikeCache() { return fContext->getGrStrikeCache(); }
     GrTextBlobCache* getTextBlobCache() { return fContext->getTextBlobCache(); }
 
+    GrPaintConversionCache* getPaintConversionCache() {
+        return fContext->getPaintConversionCache();
+    }
+
     /**
      * Registers an object for flush-related callbacks. (See GrOnFlushCallbackObject.)
      *
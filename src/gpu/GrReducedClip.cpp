@@ -617,6 +617,10 @@ GrClipEdgeType GrReducedClip::GetClipEdgeType(Invert invert, GrAA aa) {
 
 GrReducedClip::ClipResult GrReducedClip::addAnalyticFP(const SkRect& deviceSpaceRect,
                                                        Invert invert, GrAA aa) {
+    if (Invert::kYes == invert) {
+        return this->addDifferenceShape(SkRRect::MakeRect(deviceSpaceRect), aa);
+    }
+
     if (this->numAnalyticFPs() >= fMaxAnalyticFPs) {
         return ClipResult::kNotClipped;
     }
@@ -629,6 +633,10 @@ GrReducedClip::ClipResult GrReducedClip::addAnalyticFP(const SkRect& deviceSpace
 
 GrReducedClip::ClipResult GrReducedClip::addAnalyticFP(const SkRRect& deviceSpaceRRect,
                                                        Invert invert, GrAA aa) {
+    if (Invert::kYes == invert && GrDifferenceClipEffect::CanClipOut(deviceSpaceRRect)) {
+        return this->addDifferenceShape(deviceSpaceRRect, aa);
+    }
+
     if (this->numAnalyticFPs() >= fMaxAnalyticFPs) {
         return ClipResult::kNotClipped;
     }
@@ -669,6 +677,19 @@ GrReducedClip::ClipResult GrReducedClip::addAnalyticFP(const SkPath& deviceSpace
     return ClipResult::kNotClipped;
 }
 
+GrReducedClip::ClipResult GrReducedClip::addDifferenceShape(const SkRRect& deviceSpaceRRect,
+                                                            GrAA aa) {
+    // A new FP is only needed once the last one is full.
+    if (0 == fDifferenceRRects.count() % GrDifferenceClipEffect::kMaxShapes &&
+        this->numAnalyticFPs() >= fMaxAnalyticFPs) {
+        return ClipResult::kNotClipped;
+    }
+
+    fDifferenceRRects.push_back(deviceSpaceRRect);
+    fDifferenceAAs.push_back(aa);
+    return ClipResult::kClipped;
+}
+
 void GrReducedClip::makeEmpty() {
     fHasScissor = false;
     fAAClipRectGenID = SK_InvalidGenID;
@@ -961,6 +982,23 @@ bool GrReducedClip::drawStencilClipMask(GrRecordingContext* context,
     return true;
 }
 
+static std::unique_ptr<GrFragmentProcessor> make_difference_fp(int n, const SkRRect rrects[],
+                                                               const GrAA aa[],
+                                                               const GrShaderCaps& shaderCaps) {
+    if (1 == n) {
+        // A lone shape keeps the dedicated effects' shaders.
+        GrClipEdgeType edgeType = (GrAA::kYes == aa[0]) ? GrClipEdgeType::kInverseFillAA
+                                                        : GrClipEdgeType::kInverseFillBW;
+        if (rrects[0].isRect()) {
+            return GrAARectEffect::Make(edgeType, rrects[0].rect());
+        }
+        if (auto fp = GrRRectEffect::Make(edgeType, rrects[0], shaderCaps)) {
+            return fp;
+        }
+    }
+    return GrDifferenceClipEffect::Make(n, rrects, aa);
+}
+
 std::unique_ptr<GrFragmentProcessor> GrReducedClip::finishAndDetachAnalyticFPs(
         GrCoverageCountingPathRenderer* ccpr, uint32_t opListID, int rtWidth, int rtHeight) {
     // Make sure finishAndDetachAnalyticFPs hasn't been called already.
@@ -978,5 +1016,17 @@ std::unique_ptr<GrFragmentProcessor> GrReducedClip::finishAndDetachAnalyticFPs(
         fCCPRClipPaths.reset();
     }
 
+    if (!fDifferenceRRects.empty()) {
+        fAnalyticFPs.reserve(fAnalyticFPs.count() + this->numDifferenceFPs());
+        for (int i = 0; i < fDifferenceRRects.count(); i += GrDifferenceClipEffect::kMaxShapes) {
+            int n = SkTMin<int>(GrDifferenceClipEffect::kMaxShapes, fDifferenceRRects.count() - i);
+            fAnalyticFPs.push_back(make_difference_fp(n, &fDifferenceRRects[i],
+                                                      &fDifferenceAAs[i], *fCaps->shaderCaps()));
+            SkASSERT(fAnalyticFPs.back());
+        }
+        fDifferenceRRects.reset();
+        fDifferenceAAs.reset();
+    }
+
     return GrFragmentProcessor::RunInSeries(fAnalyticFPs.begin(), fAnalyticFPs.count());
 }
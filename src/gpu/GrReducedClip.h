@@ -12,6 +12,7 @@
 #include "GrWindowRectangles.h"
 #include "SkClipStack.h"
 #include "SkTLList.h"
+#include "effects/GrDifferenceClipEffect.h"
 
 class GrCoverageCountingPathRenderer;
 class GrRecordingContext;
@@ -85,7 +86,9 @@ public:
     bool drawAlphaClipMask(GrRenderTargetContext*) const;
     bool drawStencilClipMask(GrRecordingContext*, GrRenderTargetContext*) const;
 
-    int numAnalyticFPs() const { return fAnalyticFPs.count() + fCCPRClipPaths.count(); }
+    int numAnalyticFPs() const {
+        return fAnalyticFPs.count() + fCCPRClipPaths.count() + this->numDifferenceFPs();
+    }
 
     /**
      * Called once the client knows the ID of the opList that the clip FPs will operate in. This
@@ -129,6 +132,14 @@ private:
     ClipResult addAnalyticFP(const SkRRect& deviceSpaceRRect, Invert, GrAA);
     ClipResult addAnalyticFP(const SkPath& deviceSpacePath, Invert, GrAA);
 
+    // Difference rects and circular rrects are batched, kMaxShapes to an FP, so several of them
+    // only use up one analytic FP.
+    ClipResult addDifferenceShape(const SkRRect& deviceSpaceRRect, GrAA);
+    int numDifferenceFPs() const {
+        constexpr int kMaxShapes = GrDifferenceClipEffect::kMaxShapes;
+        return (fDifferenceRRects.count() + kMaxShapes - 1) / kMaxShapes;
+    }
+
     void makeEmpty();
 
     const GrCaps* fCaps;
@@ -147,6 +158,8 @@ private:
     bool fMaskRequiresAA;
     SkSTArray<4, std::unique_ptr<GrFragmentProcessor>> fAnalyticFPs;
     SkSTArray<4, SkPath> fCCPRClipPaths; // Will convert to FPs once we have an opList ID for CCPR.
+    SkSTArray<8, SkRRect> fDifferenceRRects; // Will convert to FPs in finishAndDetachAnalyticFPs.
+    SkSTArray<8, GrAA> fDifferenceAAs;
 };
 
 #endif
@@ -48,6 +48,7 @@
 #include "ops/GrDrawableOp.h"
 #include "ops/GrDrawAtlasOp.h"
 #include "ops/GrDrawOp.h"
+#include "ops/GrDrawPatchOp.h"
 #include "ops/GrDrawVerticesOp.h"
 #include "ops/GrFillRectOp.h"
 #include "ops/GrAAFillRRectOp.h"
@@ -1151,6 +1152,48 @@ void GrRenderTargetContext::drawVertices(const GrClip& clip,
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void GrRenderTargetContext::drawPatch(const GrClip& clip,
+                                      GrPaint&& paint,
+                                      const SkMatrix& viewMatrix,
+                                      const SkPoint cubics[12],
+                                      const SkColor colors[4],
+                                      const SkPoint texCoords[4]) {
+    ASSERT_SINGLE_OWNER
+    RETURN_IF_ABANDONED
+    SkDEBUGCODE(this->validate();)
+    GR_CREATE_TRACE_MARKER_CONTEXT("GrRenderTargetContext", "drawPatch", fContext);
+
+    AutoCheckFlush acf(this->drawingManager());
+
+    SkPMColor4f cornerColors[SkPatchUtils::kNumCorners];
+    if (colors) {
+        for (int i = 0; i < SkPatchUtils::kNumCorners; ++i) {
+            cornerColors[i] = SkColor4fPrepForDst(SkColor4f::FromColor(colors[i]),
+                                                  this->colorSpaceInfo(), *this->caps())
+                              .premul();
+        }
+    }
+    std::unique_ptr<GrDrawOp> op = GrDrawPatchOp::Make(fContext, std::move(paint), viewMatrix,
+                                                       cubics, colors ? cornerColors : nullptr,
+                                                       texCoords);
+    if (op) {
+        this->addDrawOp(clip, std::move(op));
+        return;
+    }
+
+    // Make() leaves the paint alone when it fails.
+    sk_sp<SkVertices> vertices = SkPatchUtils::MakeCachedVertices(
+            cubics, colors, texCoords, viewMatrix, this->colorSpaceInfo().colorSpace());
+    if (vertices) {
+        GrAAType aaType = this->chooseAAType(GrAA::kNo, GrAllowMixedSamples::kNo);
+        this->addDrawOp(clip, GrDrawVerticesOp::Make(
+                fContext, std::move(paint), std::move(vertices), nullptr, 0, viewMatrix, aaType,
+                this->colorSpaceInfo().refColorSpaceXformFromSRGB()));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void GrRenderTargetContext::drawAtlas(const GrClip& clip,
                                       GrPaint&& paint,
                                       const SkMatrix& viewMatrix,
@@ -1166,8 +1209,17 @@ void GrRenderTargetContext::drawAtlas(const GrClip& clip,
     AutoCheckFlush acf(this->drawingManager());
 
     GrAAType aaType = this->chooseAAType(GrAA::kNo, GrAllowMixedSamples::kNo);
+    // Particle systems and tile maps often pass many sprites that are off screen. Dropping them
+    // while the op copies the sprites saves uploading their vertices.
+    SkIRect clipBounds;
+    clip.getConservativeBounds(this->width(), this->height(), &clipBounds);
+    SkRect cullRect = SkRect::Make(clipBounds);
     std::unique_ptr<GrDrawOp> op = GrDrawAtlasOp::Make(fContext, std::move(paint), viewMatrix,
-                                                       aaType, spriteCount, xform, texRect, colors);
+                                                       aaType, spriteCount, xform, texRect, colors,
+                                                       &cullRect);
+    if (op->bounds().isEmpty()) {
+        return;
+    }
     this->addDrawOp(clip, std::move(op));
 }
 
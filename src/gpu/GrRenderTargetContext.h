@@ -307,6 +307,23 @@ public:
                       int boneCount,
                       GrPrimitiveType* overridePrimType = nullptr);
 
+    /**
+     * Draws a Coons patch with a paint, evaluating it on the GPU when possible and otherwise
+     * tessellating it with SkPatchUtils.
+     *
+     * @param   paint            describes how to color pixels.
+     * @param   viewMatrix       transformation matrix
+     * @param   cubics           the patch's 12 control points, required.
+     * @param   colors           optional corner colors, supersede the paint's color.
+     * @param   texCoords        optional corner local coords for the paint's shader.
+     */
+    void drawPatch(const GrClip&,
+                   GrPaint&& paint,
+                   const SkMatrix& viewMatrix,
+                   const SkPoint cubics[12],
+                   const SkColor colors[4],
+                   const SkPoint texCoords[4]);
+
     /**
      * Draws textured sprites from an atlas with a paint. This currently does not support AA for the
      * sprite rectangle edges.
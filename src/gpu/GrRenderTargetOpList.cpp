@@ -17,7 +17,10 @@
 #include "GrRenderTargetContext.h"
 #include "GrResourceAllocator.h"
 #include "SkExchange.h"
+#include "SkMakeUnique.h"
+#include "SkMetrics.h"
 #include "SkRectPriv.h"
+#include "SkTaskGroup.h"
 #include "SkTraceEvent.h"
 #include "ops/GrClearOp.h"
 #include "ops/GrCopySurfaceOp.h"
@@ -25,6 +28,8 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 // Experimentally we have found that most combining occurs within the first 10 comparisons.
+// Past that many chains, recordOp() uses the ChainIndex to skip straight to chains of the op's
+// class, but still gives up after this many of them have failed to take the op.
 static const int kMaxOpMergeDistance = 10;
 static const int kMaxOpChainDistance = 10;
 
@@ -189,6 +194,7 @@ GrRenderTargetOpList::OpChain::List GrRenderTargetOpList::OpChain::DoConcat(
                           a->uniqueID());
             }
             if (merged) {
+                SK_METRIC_COUNT("render_target_op_list.merged_ops", 1);
                 GR_AUDIT_TRAIL_OPS_RESULT_COMBINED(auditTrail, a, chainB.head());
                 if (canBackwardMerge) {
                     pool->release(chainB.popHead());
@@ -272,6 +278,7 @@ bool GrRenderTargetOpList::OpChain::tryConcat(
                 SkASSERT(list->empty());
                 break;
             case GrOp::CombineResult::kMerged: {
+                SK_METRIC_COUNT("render_target_op_list.merged_ops", 1);
                 GrOP_INFO("\t\t: (%s opID: %u) -> Combining with (%s, opID: %u)\n",
                           list->tail()->name(), list->tail()->uniqueID(), list->head()->name(),
                           list->head()->uniqueID());
@@ -348,12 +355,86 @@ inline void GrRenderTargetOpList::OpChain::validate() const {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void GrRenderTargetOpList::ChainIndex::reset() {
+    fCells.reset();
+    fClasses.reset();
+}
+
+void GrRenderTargetOpList::ChainIndex::init(const SkISize& targetSize,
+                                            const OpChainArray& chains) {
+    SkASSERT(!this->isActive());
+    fCells.reset(kGridSize * kGridSize);
+    fCellSize = SkSize::Make(SkTMax(1, targetSize.width())  / (float)kGridSize,
+                             SkTMax(1, targetSize.height()) / (float)kGridSize);
+    for (int i = 0; i < chains.count(); ++i) {
+        this->addChain(i, chains[i].head()->classID(), chains[i].bounds());
+    }
+}
+
+SkIRect GrRenderTargetOpList::ChainIndex::cellsFor(const SkRect& bounds) const {
+    // Ops can reach past the target; they share the cells on its edges.
+    auto cell = [](float v, float size) {
+        return SkTPin(sk_float_floor2int(v / size), 0, kGridSize - 1);
+    };
+    return SkIRect::MakeLTRB(cell(bounds.fLeft,  fCellSize.width()),
+                             cell(bounds.fTop,   fCellSize.height()),
+                             cell(bounds.fRight, fCellSize.width()),
+                             cell(bounds.fBottom, fCellSize.height()));
+}
+
+void GrRenderTargetOpList::ChainIndex::addChain(int index, uint32_t classID,
+                                                const SkRect& bounds) {
+    SkASSERT(this->isActive());
+    SkTDArray<int>* chains = fClasses.find(classID);
+    if (!chains) {
+        chains = fClasses.set(classID, SkTDArray<int>());
+    }
+    chains->push_back(index);
+    this->growChain(index, bounds);
+}
+
+void GrRenderTargetOpList::ChainIndex::growChain(int index, const SkRect& bounds) {
+    SkASSERT(this->isActive());
+    SkIRect cells = this->cellsFor(bounds);
+    for (int y = cells.fTop; y <= cells.fBottom; ++y) {
+        for (int x = cells.fLeft; x <= cells.fRight; ++x) {
+            SkTDArray<int>& cell = fCells[y * kGridSize + x];
+            // A chain keeps growing while it's the most recent, so this catches most repeats.
+            if (cell.isEmpty() || cell.top() != index) {
+                cell.push_back(index);
+            }
+        }
+    }
+}
+
+int GrRenderTargetOpList::ChainIndex::lastOverlap(const SkRect& bounds,
+                                                  const OpChainArray& chains) const {
+    SkASSERT(this->isActive());
+    int last = -1;
+    SkIRect cells = this->cellsFor(bounds);
+    for (int y = cells.fTop; y <= cells.fBottom; ++y) {
+        for (int x = cells.fLeft; x <= cells.fRight; ++x) {
+            // Chains that grew after newer ones were added can be out of order, so look at all.
+            for (int index : fCells[y * kGridSize + x]) {
+                if (index > last && !can_reorder(chains[index].bounds(), bounds)) {
+                    last = index;
+                }
+            }
+        }
+    }
+    return last;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 GrRenderTargetOpList::GrRenderTargetOpList(GrResourceProvider* resourceProvider,
                                            sk_sp<GrOpMemoryPool> opMemoryPool,
                                            GrRenderTargetProxy* proxy,
-                                           GrAuditTrail* auditTrail)
+                                           GrAuditTrail* auditTrail,
+                                           bool sortOpsByState)
         : INHERITED(resourceProvider, std::move(opMemoryPool), proxy, auditTrail)
         , fLastClipStackGenID(SK_InvalidUniqueID)
+        , fSortOpsByState(sortOpsByState)
         SkDEBUGCODE(, fNumClips(0)) {
 }
 
@@ -362,6 +443,7 @@ void GrRenderTargetOpList::deleteOps() {
         chain.deleteOps(fOpMemoryPool.get());
     }
     fOpChains.reset();
+    fChainIndex.reset();
 }
 
 GrRenderTargetOpList::~GrRenderTargetOpList() {
@@ -410,9 +492,51 @@ void GrRenderTargetOpList::onPrepare(GrOpFlushState* flushState) {
     TRACE_EVENT0("skia", TRACE_FUNC);
 #endif
 
+    // Ops that can prepare on other threads start doing so now, into staging buffers. Ops ahead
+    // of the first of them prepare on this thread in the meantime, and then everything goes into
+    // the flush state in op order, so draw tokens and buffer contents come out as if the whole
+    // list had prepared here.
+    SkSTArray<25, GrOpFlushState::StagedPrepare*, true> staged;
+    std::unique_ptr<SkTaskGroup> taskGroup;
+    if (SkExecutor* executor = flushState->prepareExecutor()) {
+        int concurrentCount = 0;
+        for (const auto& chain : fOpChains) {
+            if (chain.head() && chain.head()->canPrepareConcurrently()) {
+                ++concurrentCount;
+            }
+        }
+        // A single op would only swap its thread for a copy.
+        if (concurrentCount > 1) {
+            taskGroup = skstd::make_unique<SkTaskGroup>(*executor);
+            staged.push_back_n(fOpChains.count(), (GrOpFlushState::StagedPrepare*)nullptr);
+            for (int i = 0; i < fOpChains.count(); ++i) {
+                const OpChain& chain = fOpChains[i];
+                if (chain.head() && chain.head()->canPrepareConcurrently()) {
+                    GrOpFlushState::OpArgs opArgs = {
+                        chain.head(),
+                        fTarget.get()->asRenderTargetProxy(),
+                        chain.appliedClip(),
+                        chain.dstProxy()
+                    };
+                    GrOpFlushState::StagedPrepare* stagedPrepare =
+                            flushState->makeStagedPrepare(opArgs);
+                    staged[i] = stagedPrepare;
+                    taskGroup->add([stagedPrepare] { stagedPrepare->prepare(); });
+                }
+            }
+        }
+    }
+
     // Loop over the ops that haven't yet been prepared.
-    for (const auto& chain : fOpChains) {
-        if (chain.head()) {
+    for (int i = 0; i < fOpChains.count(); ++i) {
+        const OpChain& chain = fOpChains[i];
+        if (!staged.empty() && staged[i]) {
+            if (taskGroup) {
+                taskGroup->wait();
+                taskGroup.reset();
+            }
+            staged[i]->commit();
+        } else if (chain.head()) {
 #ifdef SK_BUILD_FOR_ANDROID_FRAMEWORK
             TRACE_EVENT0("skia", chain.head()->name());
 #endif
@@ -435,21 +559,20 @@ static GrGpuRTCommandBuffer* create_command_buffer(GrGpu* gpu,
                                                    const SkRect& bounds,
                                                    GrLoadOp colorLoadOp,
                                                    const SkPMColor4f& loadClearColor,
-                                                   GrLoadOp stencilLoadOp) {
+                                                   GrLoadOp stencilLoadOp,
+                                                   GrStoreOp stencilStoreOp) {
     const GrGpuRTCommandBuffer::LoadAndStoreInfo kColorLoadStoreInfo {
         colorLoadOp,
         GrStoreOp::kStore,
         loadClearColor
     };
 
-    // TODO:
-    // We would like to (at this level) only ever clear & discard. We would need
-    // to stop splitting up higher level opLists for copyOps to achieve that.
-    // Note: we would still need SB loads and stores but they would happen at a
-    // lower level (inside the VK command buffer).
+    // Note: when a command buffer splits its work into several render passes (e.g. for inline
+    // uploads) it still has to load and store the stencil between them. The ops here are for the
+    // start of the first pass and the end of the last.
     const GrGpuRTCommandBuffer::StencilLoadAndStoreInfo stencilLoadAndStoreInfo {
         stencilLoadOp,
-        GrStoreOp::kStore,
+        stencilStoreOp,
     };
 
     return gpu->getCommandBuffer(rt, origin, bounds, kColorLoadStoreInfo, stencilLoadAndStoreInfo);
@@ -473,14 +596,25 @@ bool GrRenderTargetOpList::onExecute(GrOpFlushState* flushState) {
     SkASSERT(fTarget.get()->peekRenderTarget());
     TRACE_EVENT0("skia", TRACE_FUNC);
 
-    // TODO: at the very least, we want the stencil store op to always be discard (at this
-    // level). In Vulkan, sub-command buffers would still need to load & store the stencil buffer.
-
     // Make sure load ops are not kClear if the GPU needs to use draws for clears
     SkASSERT(fColorLoadOp != GrLoadOp::kClear ||
              !flushState->gpu()->caps()->performColorClearsAsDraws());
     SkASSERT(fStencilLoadOp != GrLoadOp::kClear ||
              !flushState->gpu()->caps()->performStencilClearsAsDraws());
+
+    // With native stencil clears, every op list that uses the stencil buffer clears it on load
+    // (see GrRenderTargetContext::addDrawOp), and the stencil clip is only reused within an op
+    // list. So the stencil never has to be read from or written back to memory here, which on
+    // tiling GPUs saves the bandwidth of both. Stencil clears done as draws rely on the stencil
+    // persisting from one op list to the next.
+    GrLoadOp stencilLoadOp = fStencilLoadOp;
+    GrStoreOp stencilStoreOp = GrStoreOp::kStore;
+    if (!flushState->gpu()->caps()->performStencilClearsAsDraws()) {
+        if (GrLoadOp::kClear != stencilLoadOp) {
+            stencilLoadOp = GrLoadOp::kDiscard;
+        }
+        stencilStoreOp = GrStoreOp::kDiscard;
+    }
     GrGpuRTCommandBuffer* commandBuffer = create_command_buffer(
                                                     flushState->gpu(),
                                                     fTarget.get()->peekRenderTarget(),
@@ -488,7 +622,8 @@ bool GrRenderTargetOpList::onExecute(GrOpFlushState* flushState) {
                                                     fTarget.get()->getBoundsRect(),
                                                     fColorLoadOp,
                                                     fLoadClearColor,
-                                                    fStencilLoadOp);
+                                                    stencilLoadOp,
+                                                    stencilStoreOp);
     flushState->setCommandBuffer(commandBuffer);
     commandBuffer->begin();
 
@@ -511,6 +646,7 @@ bool GrRenderTargetOpList::onExecute(GrOpFlushState* flushState) {
         flushState->setOpArgs(&opArgs);
         chain.head()->execute(flushState, chain.bounds());
         flushState->setOpArgs(nullptr);
+        flushState->didExecuteOpChain();
     }
 
     commandBuffer->end();
@@ -652,6 +788,7 @@ void GrRenderTargetOpList::recordOp(
         const DstProxy* dstProxy, const GrCaps& caps) {
     SkDEBUGCODE(op->validate();)
     SkASSERT(processorAnalysis.requiresDstTexture() == (dstProxy && dstProxy->proxy()));
+    SK_METRIC_COUNT("render_target_op_list.recorded_ops", 1);
     SkASSERT(fTarget.get());
 
     // A closed GrOpList should never receive new/more ops
@@ -675,8 +812,12 @@ void GrRenderTargetOpList::recordOp(
                op->bounds().fRight, op->bounds().fBottom);
     GrOP_INFO(SkTabString(op->dumpInfo(), 1).c_str());
     GrOP_INFO("\tOutcome:\n");
-    int maxCandidates = SkTMin(kMaxOpChainDistance, fOpChains.count());
-    if (maxCandidates) {
+    if (fOpChains.count() >= kMaxOpChainDistance) {
+        op = this->recordOpUsingIndex(std::move(op), processorAnalysis, clip, dstProxy, caps);
+        if (!op) {
+            return;
+        }
+    } else if (int maxCandidates = fOpChains.count()) {
         int i = 0;
         while (true) {
             OpChain& candidate = fOpChains.fromBack(i);
@@ -704,6 +845,45 @@ void GrRenderTargetOpList::recordOp(
         SkDEBUGCODE(fNumClips++;)
     }
     fOpChains.emplace_back(std::move(op), processorAnalysis, clip, dstProxy);
+    if (fChainIndex.isActive()) {
+        const OpChain& chain = fOpChains.back();
+        fChainIndex.addChain(fOpChains.count() - 1, chain.head()->classID(), chain.bounds());
+    }
+}
+
+std::unique_ptr<GrOp> GrRenderTargetOpList::recordOpUsingIndex(
+        std::unique_ptr<GrOp> op, GrProcessorSet::Analysis processorAnalysis, GrAppliedClip* clip,
+        const DstProxy* dstProxy, const GrCaps& caps) {
+    if (!fChainIndex.isActive()) {
+        fChainIndex.init(SkISize::Make(fTarget.get()->width(), fTarget.get()->height()),
+                         fOpChains);
+    }
+
+    // We can join any chain from the last one we overlap on, just like the linear search, which
+    // tries the chain it overlaps before it stops.
+    const SkRect opBounds = op->bounds();
+    const int lastOverlap = fChainIndex.lastOverlap(opBounds, fOpChains);
+    const SkTDArray<int>* candidates = fChainIndex.chainsOfClass(op->classID());
+    if (!candidates) {
+        GrOP_INFO("\t\tBackward: No chains of this class\n");
+        return op;
+    }
+    int numChecks = 0;
+    for (int i = candidates->count() - 1; i >= 0 && (*candidates)[i] >= lastOverlap; --i) {
+        int index = (*candidates)[i];
+        op = fOpChains[index].appendOp(std::move(op), processorAnalysis, dstProxy, clip, caps,
+                                       fOpMemoryPool.get(), fAuditTrail);
+        if (!op) {
+            fChainIndex.growChain(index, opBounds);
+            return nullptr;
+        }
+        if (++numChecks == kMaxOpChainDistance) {
+            GrOP_INFO("\t\tBackward: Reached max checks of this class %d\n", numChecks);
+            return op;
+        }
+    }
+    GrOP_INFO("\t\tBackward: Intersects with chain %d or ran out of chains\n", lastOverlap);
+    return op;
 }
 
 void GrRenderTargetOpList::forwardCombine(const GrCaps& caps) {
@@ -737,3 +917,97 @@ void GrRenderTargetOpList::forwardCombine(const GrCaps& caps) {
     }
 }
 
+void GrRenderTargetOpList::sortByState() {
+    SkASSERT(!this->isClosed());
+    // Finding the dependencies compares every pair of chains.
+    static constexpr int kMaxSortedChains = 256;
+    int count = fOpChains.count();
+    if (count < 3 || count > kMaxSortedChains) {
+        return;
+    }
+
+    struct Node {
+        uint32_t fClassID = 0;
+        uint32_t fProxyID = SK_InvalidUniqueID;  // The first proxy the head op reads.
+        int fUnsortedDeps = 0;                   // Earlier overlapping chains not yet placed.
+        SkTDArray<int> fDependents;              // Later chains that overlap this one.
+    };
+    SkAutoTArray<Node> nodes(count);
+    for (int i = 0; i < count; ++i) {
+        const GrOp* head = fOpChains[i].head();
+        if (!head) {
+            // Emptied by forwardCombine(). It draws nothing, so anywhere will do.
+            continue;
+        }
+        nodes[i].fClassID = head->classID();
+        head->visitProxies([&nodes, i](GrSurfaceProxy* proxy) {
+            if (SK_InvalidUniqueID == nodes[i].fProxyID) {
+                nodes[i].fProxyID = proxy->uniqueID().asUInt();
+            }
+        });
+        for (int j = 0; j < i; ++j) {
+            if (fOpChains[j].head() &&
+                !can_reorder(fOpChains[j].bounds(), fOpChains[i].bounds())) {
+                nodes[j].fDependents.push_back(i);
+                ++nodes[i].fUnsortedDeps;
+            }
+        }
+    }
+
+    // Place chains one at a time, each time picking among those whose dependencies have all been
+    // placed. Prefer the same state as the last chain placed, and otherwise the earliest.
+    SkTDArray<int> ready;
+    for (int i = 0; i < count; ++i) {
+        if (!nodes[i].fUnsortedDeps) {
+            ready.push_back(i);
+        }
+    }
+    SkAutoSTMalloc<25, int> order(count);
+    bool reordered = false;
+    for (int placed = 0; placed < count; ++placed) {
+        SkASSERT(!ready.isEmpty());
+        int best = 0;
+        if (placed > 0) {
+            const Node& last = nodes[order[placed - 1]];
+            int bestScore = -1;
+            for (int r = 0; r < ready.count(); ++r) {
+                const Node& node = nodes[ready[r]];
+                int score = node.fClassID != last.fClassID ? 0
+                          : node.fProxyID != last.fProxyID ? 1 : 2;
+                if (score > bestScore || (score == bestScore && ready[r] < ready[best])) {
+                    best = r;
+                    bestScore = score;
+                }
+            }
+        } else {
+            for (int r = 1; r < ready.count(); ++r) {
+                if (ready[r] < ready[best]) {
+                    best = r;
+                }
+            }
+        }
+        int index = ready[best];
+        ready.removeShuffle(best);
+        order[placed] = index;
+        reordered |= (index != placed);
+        for (int dependent : nodes[index].fDependents) {
+            if (!--nodes[dependent].fUnsortedDeps) {
+                ready.push_back(dependent);
+            }
+        }
+    }
+    if (!reordered) {
+        return;
+    }
+    GrOP_INFO("opList: %d SortByState %d chains\n", this->uniqueID(), count);
+
+    // OpChainArray already relies on chains being movable with memcpy.
+    SkAutoTMalloc<char> storage(count * sizeof(OpChain));
+    memcpy(storage.get(), fOpChains.begin(), count * sizeof(OpChain));
+    for (int i = 0; i < count; ++i) {
+        memcpy(static_cast<void*>(&fOpChains[i]), storage.get() + order[i] * sizeof(OpChain),
+               sizeof(OpChain));
+    }
+    // The index describes where the chains used to be. Recording is over anyway.
+    fChainIndex.reset();
+}
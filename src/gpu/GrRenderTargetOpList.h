@@ -20,6 +20,8 @@
 #include "SkStringUtils.h"
 #include "SkStrokeRec.h"
 #include "SkTArray.h"
+#include "SkTDArray.h"
+#include "SkTHash.h"
 #include "SkTLazy.h"
 #include "SkTypes.h"
 
@@ -33,8 +35,10 @@ private:
     using DstProxy = GrXferProcessor::DstProxy;
 
 public:
+    // If 'sortOpsByState' is true, closing the opList reorders its op chains to group those that
+    // are likely to share programs and textures (see sortByState()).
     GrRenderTargetOpList(GrResourceProvider*, sk_sp<GrOpMemoryPool>,
-                         GrRenderTargetProxy*, GrAuditTrail*);
+                         GrRenderTargetProxy*, GrAuditTrail*, bool sortOpsByState = false);
 
     ~GrRenderTargetOpList() override;
 
@@ -44,6 +48,9 @@ public:
         }
 
         this->forwardCombine(caps);
+        if (fSortOpsByState) {
+            this->sortByState();
+        }
 
         INHERITED::makeClosed(caps);
     }
@@ -214,6 +221,42 @@ private:
         SkRect fBounds;
     };
 
+    using OpChainArray = SkSTArray<25, OpChain, true>;
+
+    // Once an opList has more chains than recordOp() searches linearly, this finds the last chain
+    // a new op overlaps, and the chains whose head is the op's class, anywhere in the opList.
+    // The chains are bucketed by a coarse grid over the target; each cell lists the chains
+    // whose bounds reach into it.
+    class ChainIndex {
+    public:
+        bool isActive() const { return !fCells.empty(); }
+        void reset();
+
+        // Indexes every chain so far.
+        void init(const SkISize& targetSize, const OpChainArray&);
+
+        // Notes that chain 'index' has been added, or has grown to cover 'bounds'.
+        void addChain(int index, uint32_t classID, const SkRect& bounds);
+        void growChain(int index, const SkRect& bounds);
+
+        // The index of the last chain that overlaps 'bounds', or -1.
+        int lastOverlap(const SkRect& bounds, const OpChainArray&) const;
+
+        // The chains, oldest first, whose head is of the given class.
+        const SkTDArray<int>* chainsOfClass(uint32_t classID) const {
+            return fClasses.find(classID);
+        }
+
+    private:
+        static constexpr int kGridSize = 16;
+
+        SkIRect cellsFor(const SkRect& bounds) const;
+
+        SkTArray<SkTDArray<int>>             fCells;
+        SkSize                               fCellSize;
+        SkTHashMap<uint32_t, SkTDArray<int>> fClasses;
+    };
+
     void purgeOpsWithUninstantiatedProxies() override;
 
     void gatherProxyIntervals(GrResourceAllocator*) const override;
@@ -221,8 +264,19 @@ private:
     void recordOp(std::unique_ptr<GrOp>, GrProcessorSet::Analysis, GrAppliedClip*, const DstProxy*,
                   const GrCaps& caps);
 
+    // Tries to add the op to an existing chain found through fChainIndex. Returns the op if it
+    // needs a new chain.
+    std::unique_ptr<GrOp> recordOpUsingIndex(std::unique_ptr<GrOp>, GrProcessorSet::Analysis,
+                                             GrAppliedClip*, const DstProxy*, const GrCaps&);
+
     void forwardCombine(const GrCaps&);
 
+    // Reorders the chains so that ones of the same op class that read the same texture run back
+    // to back when painter's order allows it, i.e. a chain never moves past one it overlaps. This
+    // saves program and texture binds when different kinds of draws interleave without overlapping
+    // (e.g. text, icons and rects in a list of UI elements).
+    void sortByState();
+
     uint32_t                       fLastClipStackGenID;
     SkIRect                        fLastDevClipBounds;
     int                            fLastClipNumAnalyticFPs;
@@ -230,8 +284,11 @@ private:
     // We must track if we have a wait op so that we don't delete the op when we have a full clear.
     bool fHasWaitOp = false;;
 
+    bool fSortOpsByState;
+
     // For ops/opList we have mean: 5 stdDev: 28
-    SkSTArray<25, OpChain, true> fOpChains;
+    OpChainArray                   fOpChains;
+    ChainIndex                     fChainIndex;
 
     // MDB TODO: 4096 for the first allocation of the clip space will be huge overkill.
     // Gather statistics to determine the correct size.
@@ -39,6 +39,13 @@ class GrResourceProvider;
  *
  * Note: the op indices (used in the usage intervals) come from the order of the ops in
  * their opLists after the opList DAG has been linearized.
+ *
+ * Surfaces are only shared between intervals whose proxies have the same scratch key. A proxy
+ * can't simply be handed a larger free surface: its worst case dimensions, functional exactness
+ * and gpu memory size may already have been queried (e.g., when an op picked its texture domain)
+ * before it is instantiated. Sharing memory between surfaces with different formats or sizes
+ * would instead need backends that let a GrSurface alias memory it doesn't own, which none of
+ * them currently do (e.g., each GrVkImage has its own GrVkAlloc).
  */
 class GrResourceAllocator {
 public:
@@ -17,10 +17,12 @@
 #include "SkExchange.h"
 #include "SkGr.h"
 #include "SkMessageBus.h"
+#include "SkMetrics.h"
 #include "SkOpts.h"
 #include "SkRandom.h"
 #include "SkScopeExit.h"
 #include "SkTSort.h"
+#include "SkTraceMemoryDump.h"
 #include "SkTo.h"
 
 DECLARE_SKMESSAGEBUS_MESSAGE(GrUniqueKeyInvalidatedMessage);
@@ -123,6 +125,8 @@ GrResourceCache::GrResourceCache(const GrCaps* caps, GrSingleOwner* singleOwner,
         , fBudgetedCount(0)
         , fBudgetedBytes(0)
         , fPurgeableBytes(0)
+        , fRecentlyPurgedKeyRingCount(0)
+        , fRecentlyPurgedKeyRingNext(0)
         , fInvalidUniqueKeyInbox(contextUniqueID)
         , fFreedGpuResourceInbox(contextUniqueID)
         , fContextUniqueID(contextUniqueID)
@@ -324,8 +328,11 @@ GrGpuResource* GrResourceCache::findAndRefScratchResource(const GrScratchKey& sc
     }
     resource = fScratchMap.find(scratchKey, AvailableForScratchUse(false));
     if (resource) {
+        SK_METRIC_COUNT("gpu_resource_cache.scratch_hits", 1);
         this->refAndMakeResourceMRU(resource);
         this->validate();
+    } else {
+        SK_METRIC_COUNT("gpu_resource_cache.scratch_misses", 1);
     }
     return resource;
 }
@@ -392,6 +399,7 @@ void GrResourceCache::changeUniqueKey(GrGpuResource* resource, const GrUniqueKey
 
         resource->cacheAccess().setUniqueKey(newKey);
         fUniqueHash.add(resource);
+        this->checkForRefetch(resource, newKey);
     } else {
         this->removeUniqueKey(resource);
     }
@@ -483,6 +491,11 @@ void GrResourceCache::notifyCntReachedZero(GrGpuResource* resource, uint32_t fla
         }
     }
 
+    if (budgetedType == GrBudgetedType::kBudgeted && hasUniqueKey) {
+        // We only get here with a keyed, budgeted resource when we're over budget.
+        this->recordBudgetPurge(resource);
+    }
+
     SkDEBUGCODE(int beforeCount = this->getResourceCount();)
     resource->cacheAccess().release();
     // We should at least free this resource, perhaps dependent resources as well.
@@ -540,6 +553,11 @@ void GrResourceCache::purgeAsNeeded() {
     while (stillOverbudget && fPurgeableQueue.count()) {
         GrGpuResource* resource = fPurgeableQueue.peek();
         SkASSERT(resource->resourcePriv().isPurgeable());
+        if (GrBudgetedType::kBudgeted == resource->resourcePriv().budgetedType()) {
+            this->recordBudgetPurge(resource);
+        }
+        SK_METRIC_COUNT("gpu_resource_cache.evictions", 1);
+        SK_METRIC_COUNT("gpu_resource_cache.evicted_bytes", resource->gpuMemorySize());
         resource->cacheAccess().release();
         stillOverbudget = this->overBudget();
     }
@@ -547,6 +565,60 @@ void GrResourceCache::purgeAsNeeded() {
     this->validate();
 }
 
+void GrResourceCache::recordBudgetPurge(const GrGpuResource* resource) {
+    PurgeStats* stats = fPurgeStatsByType.find(resource->getResourceType());
+    if (!stats) {
+        stats = fPurgeStatsByType.set(resource->getResourceType(), PurgeStats());
+    }
+    ++stats->fPurgedCount;
+    stats->fPurgedBytes += resource->gpuMemorySize();
+
+    const GrUniqueKey& key = resource->getUniqueKey();
+    if (!key.isValid()) {
+        return;
+    }
+    int slot = fRecentlyPurgedKeyRingNext;
+    if (fRecentlyPurgedKeyRingCount == kRecentlyPurgedKeyCount) {
+        // Forget the oldest key, unless it has been purged again since and moved to a newer slot.
+        uint32_t oldest = fRecentlyPurgedKeyRing[slot];
+        if (int* oldestSlot = fRecentlyPurgedKeys.find(oldest)) {
+            if (*oldestSlot == slot) {
+                fRecentlyPurgedKeys.remove(oldest);
+            }
+        }
+    } else {
+        ++fRecentlyPurgedKeyRingCount;
+    }
+    fRecentlyPurgedKeyRing[slot] = key.hash();
+    fRecentlyPurgedKeys.set(key.hash(), slot);
+    fRecentlyPurgedKeyRingNext = (slot + 1) % kRecentlyPurgedKeyCount;
+}
+
+void GrResourceCache::checkForRefetch(const GrGpuResource* resource, const GrUniqueKey& key) {
+    if (!fRecentlyPurgedKeys.find(key.hash())) {
+        return;
+    }
+    fRecentlyPurgedKeys.remove(key.hash());
+
+    PurgeStats* stats = fPurgeStatsByType.find(resource->getResourceType());
+    if (!stats) {
+        stats = fPurgeStatsByType.set(resource->getResourceType(), PurgeStats());
+    }
+    ++stats->fRefetchedCount;
+    stats->fRefetchedBytes += resource->gpuMemorySize();
+}
+
+GrResourceCache::PurgeStats GrResourceCache::getPurgeStats() const {
+    PurgeStats total;
+    fPurgeStatsByType.foreach([&total](const char*, const PurgeStats& stats) {
+        total.fPurgedCount += stats.fPurgedCount;
+        total.fPurgedBytes += stats.fPurgedBytes;
+        total.fRefetchedCount += stats.fRefetchedCount;
+        total.fRefetchedBytes += stats.fRefetchedBytes;
+    });
+    return total;
+}
+
 void GrResourceCache::purgeUnlockedResources(bool scratchResourcesOnly) {
     if (!scratchResourcesOnly) {
         // We could disable maintaining the heap property here, but it would add a lot of
@@ -756,6 +828,18 @@ void GrResourceCache::dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) c
     for (int i = 0; i < fPurgeableQueue.count(); ++i) {
         fPurgeableQueue.at(i)->dumpMemoryStatistics(traceMemoryDump);
     }
+    fPurgeStatsByType.foreach([traceMemoryDump](const char* type, const PurgeStats& stats) {
+        SkString dumpName("skia/gpu_resource_cache/");
+        dumpName.append(type);
+        traceMemoryDump->dumpNumericValue(dumpName.c_str(), "purged_count", "objects",
+                                          stats.fPurgedCount);
+        traceMemoryDump->dumpNumericValue(dumpName.c_str(), "purged_bytes", "bytes",
+                                          stats.fPurgedBytes);
+        traceMemoryDump->dumpNumericValue(dumpName.c_str(), "refetched_count", "objects",
+                                          stats.fRefetchedCount);
+        traceMemoryDump->dumpNumericValue(dumpName.c_str(), "refetched_bytes", "bytes",
+                                          stats.fRefetchedBytes);
+    });
 }
 
 #if GR_CACHE_STATS
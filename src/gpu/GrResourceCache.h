@@ -13,6 +13,7 @@
 #include "GrGpuResourcePriv.h"
 #include "GrResourceKey.h"
 #include "SkMessageBus.h"
+#include "SkMetrics.h"
 #include "SkRefCnt.h"
 #include "SkTArray.h"
 #include "SkTDPQueue.h"
@@ -150,7 +151,10 @@ public:
     GrGpuResource* findAndRefUniqueResource(const GrUniqueKey& key) {
         GrGpuResource* resource = fUniqueHash.find(key);
         if (resource) {
+            SK_METRIC_COUNT("gpu_resource_cache.unique_hits", 1);
             this->refAndMakeResourceMRU(resource);
+        } else {
+            SK_METRIC_COUNT("gpu_resource_cache.unique_misses", 1);
         }
         return resource;
     }
@@ -249,7 +253,23 @@ public:
     // This function is for unit testing and is only defined in test tools.
     void changeTimestamp(uint32_t newTimestamp);
 
-    // Enumerates all cached resources and dumps their details to traceMemoryDump.
+    /**
+     * Counts the budgeted resources that were purged to get back under budget, and how many of
+     * those were later recreated with the same unique key. A high refetch count means the budget
+     * is too small for the working set and the cache is thrashing.
+     */
+    struct PurgeStats {
+        int    fPurgedCount = 0;
+        size_t fPurgedBytes = 0;
+        int    fRefetchedCount = 0;
+        size_t fRefetchedBytes = 0;
+    };
+
+    // Totals over all resource types.
+    PurgeStats getPurgeStats() const;
+
+    // Enumerates all cached resources and dumps their details to traceMemoryDump. This also dumps
+    // the PurgeStats of each resource type under "skia/gpu_resource_cache/<type>".
     void dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) const;
 
     void setProxyProvider(GrProxyProvider* proxyProvider) { fProxyProvider = proxyProvider; }
@@ -278,6 +298,11 @@ private:
 
     uint32_t getNextTimestamp();
 
+    // Called for budgeted resources that are released to get under budget.
+    void recordBudgetPurge(const GrGpuResource*);
+    // Called when a resource gets a unique key, to see whether it replaces one purged earlier.
+    void checkForRefetch(const GrGpuResource*, const GrUniqueKey&);
+
 #ifdef SK_DEBUG
     bool isInCache(const GrGpuResource* r) const;
     void validate() const;
@@ -371,6 +396,16 @@ private:
     size_t                              fBudgetedBytes;
     size_t                              fPurgeableBytes;
 
+    // Keyed by GrGpuResource::getResourceType(), which returns string literals.
+    SkTHashMap<const char*, PurgeStats> fPurgeStatsByType;
+    // The hashes of the unique keys of the last kRecentlyPurgedKeyCount resources purged to get
+    // under budget, in a ring. fRecentlyPurgedKeys maps each hash to its slot in the ring.
+    static const int kRecentlyPurgedKeyCount = 256;
+    uint32_t                            fRecentlyPurgedKeyRing[kRecentlyPurgedKeyCount];
+    int                                 fRecentlyPurgedKeyRingCount;
+    int                                 fRecentlyPurgedKeyRingNext;
+    SkTHashMap<uint32_t, int>           fRecentlyPurgedKeys;
+
     InvalidUniqueKeyInbox               fInvalidUniqueKeyInbox;
     FreedGpuResourceInbox               fFreedGpuResourceInbox;
     ReourcesAwaitingUnref               fResourcesAwaitingUnref;
@@ -6,11 +6,14 @@
  */
 
 #include "GrSurfaceContext.h"
+#include "GrAsyncReadbackQueue.h"
 #include "GrContextPriv.h"
 #include "GrDrawingManager.h"
+#include "GrGpu.h"
 #include "GrOpList.h"
 #include "GrRecordingContext.h"
 #include "GrRecordingContextPriv.h"
+#include "GrResourceProvider.h"
 #include "SkGr.h"
 #include "../private/GrAuditTrail.h"
 
@@ -74,6 +77,51 @@ bool GrSurfaceContext::readPixels(const SkImageInfo& dstInfo, void* dstBuffer,
                                             dstRowBytes, flags);
 }
 
+bool GrSurfaceContext::asyncReadPixels(const SkIRect& srcRect, GrColorType colorType,
+                                       SkSurface::ReadPixelsCallback callback,
+                                       SkSurface::ReadPixelsContext context) {
+    ASSERT_SINGLE_OWNER
+    RETURN_FALSE_IF_ABANDONED
+    SkDEBUGCODE(this->validate();)
+    GR_AUDIT_TRAIL_AUTO_FRAME(this->auditTrail(), "GrSurfaceContext::asyncReadPixels");
+
+    auto direct = fContext->priv().asDirectContext();
+    if (!direct) {
+        return false;
+    }
+
+    GrSurfaceProxy* proxy = this->asSurfaceProxy();
+    if (!direct->priv().caps()->fenceSyncSupport() ||
+        kTopLeft_GrSurfaceOrigin != proxy->origin() ||
+        GrPixelConfigToColorType(proxy->config()) != colorType ||
+        !SkIRect::MakeWH(proxy->width(), proxy->height()).contains(srcRect)) {
+        return false;
+    }
+
+    // The copy has to see the draws that are still recorded in opLists.
+    direct->priv().flushSurfaceWrites(proxy);
+    GrSurface* surface = proxy->peekSurface();
+    if (!surface) {
+        return false;
+    }
+
+    // Dynamic buffers are scratch resources, so a steady stream of same sized reads cycles through
+    // a few buffers instead of allocating one per read.
+    GrGpu* gpu = direct->priv().getGpu();
+    size_t rowBytes = GrColorTypeBytesPerPixel(colorType) * srcRect.width();
+    sk_sp<GrGpuBuffer> buffer = direct->priv().resourceProvider()->createBuffer(
+            rowBytes * srcRect.height(), GrGpuBufferType::kXferGpuToCpu, kDynamic_GrAccessPattern);
+    if (!buffer || !gpu->transferPixelsFrom(surface, srcRect.fLeft, srcRect.fTop,
+                                            srcRect.width(), srcRect.height(), colorType,
+                                            buffer.get(), 0)) {
+        return false;
+    }
+
+    direct->priv().asyncReadbackQueue()->add(gpu->insertFence(), std::move(buffer), rowBytes,
+                                             callback, context);
+    return true;
+}
+
 bool GrSurfaceContext::writePixels(const SkImageInfo& srcInfo, const void* srcBuffer,
                                    size_t srcRowBytes, int x, int y, uint32_t flags) {
     ASSERT_SINGLE_OWNER
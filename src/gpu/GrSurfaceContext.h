@@ -11,6 +11,7 @@
 #include "../private/GrSurfaceProxy.h"
 #include "GrColorSpaceInfo.h"
 #include "SkRefCnt.h"
+#include "SkSurface.h"
 
 class GrAuditTrail;
 class GrDrawingManager;
@@ -73,6 +74,20 @@ public:
     bool readPixels(const SkImageInfo& dstInfo, void* dstBuffer, size_t dstRowBytes,
                     int x, int y, uint32_t flags = 0);
 
+    /**
+     * Flushes the pending work on the surface, copies a rectangle of it into a transfer buffer and
+     * returns without waiting for the GPU. The callback is called during a later flush or
+     * GrContext::checkAsyncWorkCompletion() with the tightly packed pixels, or with nullptr if the
+     * read failed after it was started.
+     *
+     * @return false, without calling the callback, if the read can't be done asynchronously. This
+     *              requires fences, a top left origin, a colorType that matches the surface's
+     *              config and a backend that can transfer from surfaces.
+     */
+    bool asyncReadPixels(const SkIRect& srcRect, GrColorType colorType,
+                         SkSurface::ReadPixelsCallback callback,
+                         SkSurface::ReadPixelsContext context);
+
     /**
      * Writes a rectangle of pixels [srcInfo, srcBuffer, srcRowbytes] into the
      * renderTargetContext at the specified position.
@@ -711,34 +711,15 @@ void append_quadratic_to_contour(const SkPoint pts[3], SkScalar toleranceSqd, Ve
     }
 }
 
-void generate_cubic_points(const SkPoint& p0,
-                           const SkPoint& p1,
-                           const SkPoint& p2,
-                           const SkPoint& p3,
-                           SkScalar tolSqd,
-                           VertexList* contour,
-                           int pointsLeft,
-                           SkArenaAlloc& alloc) {
-    SkScalar d1 = SkPointPriv::DistanceToLineSegmentBetweenSqd(p1, p0, p3);
-    SkScalar d2 = SkPointPriv::DistanceToLineSegmentBetweenSqd(p2, p0, p3);
-    if (pointsLeft < 2 || (d1 < tolSqd && d2 < tolSqd) ||
-        !SkScalarIsFinite(d1) || !SkScalarIsFinite(d2)) {
-        append_point_to_contour(p3, contour, alloc);
-        return;
+void generate_cubic_points(const SkPoint pts[4], SkScalar tolSqd, VertexList* contour,
+                           int pointsLeft, SkArenaAlloc& alloc) {
+    SkAutoSTMalloc<64, SkPoint> storage(pointsLeft);
+    SkPoint* points = storage.get();
+    int count = GrPathUtils::generateCubicPoints(pts[0], pts[1], pts[2], pts[3], tolSqd, &points,
+                                                 pointsLeft);
+    for (int i = 0; i < count; ++i) {
+        append_point_to_contour(storage[i], contour, alloc);
     }
-    const SkPoint q[] = {
-        { SkScalarAve(p0.fX, p1.fX), SkScalarAve(p0.fY, p1.fY) },
-        { SkScalarAve(p1.fX, p2.fX), SkScalarAve(p1.fY, p2.fY) },
-        { SkScalarAve(p2.fX, p3.fX), SkScalarAve(p2.fY, p3.fY) }
-    };
-    const SkPoint r[] = {
-        { SkScalarAve(q[0].fX, q[1].fX), SkScalarAve(q[0].fY, q[1].fY) },
-        { SkScalarAve(q[1].fX, q[2].fX), SkScalarAve(q[1].fY, q[2].fY) }
-    };
-    const SkPoint s = { SkScalarAve(r[0].fX, r[1].fX), SkScalarAve(r[0].fY, r[1].fY) };
-    pointsLeft >>= 1;
-    generate_cubic_points(p0, q[0], r[0], s, tolSqd, contour, pointsLeft, alloc);
-    generate_cubic_points(s, r[1], q[2], p3, tolSqd, contour, pointsLeft, alloc);
 }
 
 // Stage 1: convert the input path to a set of linear contours (linked list of Vertices).
@@ -790,8 +771,7 @@ void path_to_contours(const SkPath& path, SkScalar tolerance, const SkRect& clip
             }
             case SkPath::kCubic_Verb: {
                 int pointsLeft = GrPathUtils::cubicPointCount(pts, tolerance);
-                generate_cubic_points(pts[0], pts[1], pts[2], pts[3], toleranceSqd, contour,
-                                      pointsLeft, alloc);
+                generate_cubic_points(pts, toleranceSqd, contour, pointsLeft, alloc);
                 *isLinear = false;
                 break;
             }
@@ -121,6 +121,7 @@ bool GrTextureOpList::onExecute(GrOpFlushState* flushState) {
         flushState->setOpArgs(&opArgs);
         fRecordedOps[i]->execute(flushState, fRecordedOps[i].get()->bounds());
         flushState->setOpArgs(nullptr);
+        flushState->didExecuteOpChain();
     }
 
     flushState->gpu()->submit(commandBuffer);
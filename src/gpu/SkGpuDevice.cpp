@@ -1215,6 +1215,11 @@ sk_sp<SkSpecialImage> SkGpuDevice::makeSpecial(const SkImage* image) {
 }
 
 sk_sp<SkSpecialImage> SkGpuDevice::snapSpecial() {
+    const SkImageInfo ii = this->imageInfo();
+    return this->snapSpecialSubset(SkIRect::MakeWH(ii.width(), ii.height()));
+}
+
+sk_sp<SkSpecialImage> SkGpuDevice::snapSpecialSubset(const SkIRect& subset) {
     // If we are wrapping a vulkan secondary command buffer, then we can't snap off a special image
     // since it would require us to make a copy of the underlying VkImage which we don't have access
     // to. Additionaly we can't stop and start the render pass that is used with the secondary
@@ -1223,29 +1228,28 @@ sk_sp<SkSpecialImage> SkGpuDevice::snapSpecial() {
         return nullptr;
     }
 
+    SkIRect srcRect = subset;
     sk_sp<GrTextureProxy> proxy(this->accessRenderTargetContext()->asTextureProxyRef());
     if (!proxy) {
-        // When the device doesn't have a texture, we create a temporary texture.
-        // TODO: we should actually only copy the portion of the source needed to apply the image
-        // filter
+        // When the device doesn't have a texture, we create a temporary texture holding just the
+        // subset.
         proxy = GrSurfaceProxy::Copy(fContext.get(),
                                      this->accessRenderTargetContext()->asSurfaceProxy(),
                                      GrMipMapped::kNo,
+                                     subset,
                                      SkBackingFit::kApprox,
                                      SkBudgeted::kYes);
         if (!proxy) {
             return nullptr;
         }
+        srcRect = SkIRect::MakeWH(subset.width(), subset.height());
     }
 
-    const SkImageInfo ii = this->imageInfo();
-    const SkIRect srcRect = SkIRect::MakeWH(ii.width(), ii.height());
-
     return SkSpecialImage::MakeDeferredFromGpu(fContext.get(),
                                                srcRect,
                                                kNeedNewImageUniqueID_SpecialImage,
                                                std::move(proxy),
-                                               ii.refColorSpace(),
+                                               this->imageInfo().refColorSpace(),
                                                &this->surfaceProps());
 }
 
@@ -1533,6 +1537,27 @@ void SkGpuDevice::drawVertices(const SkVertices* vertices, const SkVertices::Bon
                                        bones, boneCount);
 }
 
+void SkGpuDevice::drawPatch(const SkPoint cubics[12], const SkColor colors[4],
+                            const SkPoint texCoords[4], SkBlendMode mode, const SkPaint& paint) {
+    ASSERT_SINGLE_OWNER
+    GR_CREATE_TRACE_MARKER_CONTEXT("SkGpuDevice", "drawPatch", fContext.get());
+
+    bool hasColors = SkToBool(colors);
+    bool hasTexs = texCoords && paint.getShader();
+    if (!hasTexs && !hasColors) {
+        // Wireframe, which drawVertices() handles.
+        this->INHERITED::drawPatch(cubics, colors, texCoords, mode, paint);
+        return;
+    }
+    GrPaint grPaint;
+    if (!init_vertices_paint(fContext.get(), fRenderTargetContext->colorSpaceInfo(), paint,
+                             this->ctm(), mode, hasTexs, hasColors, &grPaint)) {
+        return;
+    }
+    fRenderTargetContext->drawPatch(this->clip(), std::move(grPaint), this->ctm(), cubics, colors,
+                                    hasTexs ? texCoords : nullptr);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 void SkGpuDevice::drawShadow(const SkPath& path, const SkDrawShadowRec& rec) {
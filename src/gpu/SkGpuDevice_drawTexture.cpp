@@ -11,6 +11,8 @@
 #include "GrBlurUtils.h"
 #include "GrCaps.h"
 #include "GrColorSpaceXform.h"
+#include "GrDrawingManager.h"
+#include "GrImageAtlasManager.h"
 #include "GrImageTextureMaker.h"
 #include "GrRenderTargetContext.h"
 #include "GrShape.h"
@@ -435,6 +437,22 @@ void SkGpuDevice::drawImageQuad(const SkImage* image, const SkRect* srcRect, con
     SK_HISTOGRAM_BOOLEAN("DrawTiled", false);
     LogDrawScaleFactor(ctm, srcToDst, paint.getFilterQuality());
 
+    // Small raster images that are drawn repeatedly can come from a shared atlas page, which lets
+    // the draws of different images batch. The domain keeps filtering inside the image's area.
+    if (attemptDrawTexture && can_use_draw_texture(paint) && !image->isLazyGenerated()) {
+        GrImageAtlasManager* atlas = fContext->priv().drawingManager()->getImageAtlasManager();
+        SkIRect subset;
+        sk_sp<GrTextureProxy> proxy;
+        if (atlas && as_IB(image)->getROPixels(&bm) &&
+            (proxy = atlas->findOrAddImage(image->uniqueID(), bm, &subset))) {
+            draw_texture(fRenderTargetContext.get(), this->clip(), ctm, paint,
+                         src.makeOffset(subset.fLeft, subset.fTop), dst, dstClip, aa, aaFlags,
+                         SkCanvas::kStrict_SrcRectConstraint, std::move(proxy),
+                         image->alphaType(), as_IB(image)->colorSpace());
+            return;
+        }
+    }
+
     // Lazily generated images must get drawn as a texture producer that handles the final
     // texture creation.
     if (image->isLazyGenerated()) {
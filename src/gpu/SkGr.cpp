@@ -13,6 +13,7 @@
 #include "GrContextPriv.h"
 #include "GrGpuResourcePriv.h"
 #include "GrPaint.h"
+#include "GrPaintConversionCache.h"
 #include "GrProxyProvider.h"
 #include "GrRecordingContext.h"
 #include "GrRecordingContextPriv.h"
@@ -523,10 +524,34 @@ static inline bool skpaint_to_grpaint_impl(GrRecordingContext* context,
     return true;
 }
 
+// Converts through the context's GrPaintConversionCache, for conversions that would otherwise
+// have the paint's shader, color filter or mask filter make their fragment processors.
+static bool cached_skpaint_to_grpaint(GrRecordingContext* context,
+                                      const GrColorSpaceInfo& colorSpaceInfo,
+                                      const SkPaint& skPaint,
+                                      const SkMatrix& viewM,
+                                      SkBlendMode* primColorMode,
+                                      GrPaint* grPaint) {
+    GrPaintConversionCache* cache = context->priv().getPaintConversionCache();
+    GrPaintConversionCache::Key key;
+    if (!GrPaintConversionCache::MakeKey(skPaint, colorSpaceInfo, viewM, primColorMode, &key)) {
+        return skpaint_to_grpaint_impl(context, colorSpaceInfo, skPaint, viewM, nullptr,
+                                       primColorMode, grPaint);
+    }
+    if (cache->find(key, grPaint)) {
+        return true;
+    }
+    if (!skpaint_to_grpaint_impl(context, colorSpaceInfo, skPaint, viewM, nullptr, primColorMode,
+                                 grPaint)) {
+        return false;
+    }
+    cache->add(key, *grPaint);
+    return true;
+}
+
 bool SkPaintToGrPaint(GrRecordingContext* context, const GrColorSpaceInfo& colorSpaceInfo,
                       const SkPaint& skPaint, const SkMatrix& viewM, GrPaint* grPaint) {
-    return skpaint_to_grpaint_impl(context, colorSpaceInfo, skPaint, viewM, nullptr, nullptr,
-                                   grPaint);
+    return cached_skpaint_to_grpaint(context, colorSpaceInfo, skPaint, viewM, nullptr, grPaint);
 }
 
 /** Replaces the SkShader (if any) on skPaint with the passed in GrFragmentProcessor. */
@@ -561,8 +586,8 @@ bool SkPaintToGrPaintWithXfermode(GrRecordingContext* context,
                                   const SkMatrix& viewM,
                                   SkBlendMode primColorMode,
                                   GrPaint* grPaint) {
-    return skpaint_to_grpaint_impl(context, colorSpaceInfo, skPaint, viewM, nullptr, &primColorMode,
-                                   grPaint);
+    return cached_skpaint_to_grpaint(context, colorSpaceInfo, skPaint, viewM, &primColorMode,
+                                     grPaint);
 }
 
 bool SkPaintToGrPaintWithTexture(GrRecordingContext* context,
@@ -235,10 +235,12 @@ void GrCCDrawPathsOp::SingleDraw::accountForOwnPath(
     if (fCacheEntry) {
         if (const GrCCCachedAtlas* cachedAtlas = fCacheEntry->cachedAtlas()) {
             SkASSERT(cachedAtlas->getOnFlushProxy());
-            if (CoverageType::kA8_LiteralCoverage == cachedAtlas->coverageType()) {
+            if (CoverageType::kA8_LiteralCoverage == cachedAtlas->coverageType() &&
+                !cachedAtlas->needsCompaction()) {
                 ++specs->fNumCachedPaths;
             } else {
-                // Suggest that this path be copied to a literal coverage atlas, to save memory.
+                // Suggest that this path be copied to a literal coverage atlas, either to save
+                // memory or to move it out of a fragmented one so the old texture can be purged.
                 // (The client may decline this copy via DoCopiesToA8Coverage::kNo.)
                 int idx = (fShape.style().strokeRec().isFillStyle())
                         ? GrCCPerFlushResourceSpecs::kFillIdx
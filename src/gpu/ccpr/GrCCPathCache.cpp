@@ -174,6 +174,8 @@ GrCCPathCache::OnFlushEntryRef GrCCPathCache::find(
     fScratchKey->resetDataCountU32(writeKeyHelper.allocCountU32());
     writeKeyHelper.write(shape, fScratchKey->data());
 
+    ++fStats.fNumFinds;
+
     MaskTransform m(viewMatrix, maskShift);
     GrCCPathCacheEntry* entry = nullptr;
     if (HashNode* node = fHashTable.find(*fScratchKey)) {
@@ -242,6 +244,9 @@ GrCCPathCache::OnFlushEntryRef GrCCPathCache::find(
     }
     entry->fHitRect.join(clippedDrawBounds.makeOffset(-maskShift->x(), -maskShift->y()));
     SkASSERT(!entry->fCachedAtlas || entry->fCachedAtlas->getOnFlushProxy());
+    if (entry->fCachedAtlas) {
+        ++fStats.fNumAtlasHits;
+    }
     return OnFlushEntryRef::OnFlushRef(entry);
 }
 
@@ -381,8 +386,12 @@ GrCCPathCacheEntry::ReleaseAtlasResult GrCCPathCacheEntry::upgradeToLiteralCover
     SkASSERT(!this->hasBeenEvicted());
     SkASSERT(fOnFlushRefCnt > 0);
     SkASSERT(fCachedAtlas);
-    SkASSERT(GrCCAtlas::CoverageType::kFP16_CoverageCount == fCachedAtlas->coverageType());
+    SkASSERT(GrCCAtlas::CoverageType::kFP16_CoverageCount == fCachedAtlas->coverageType() ||
+             fCachedAtlas->needsCompaction());
 
+    if (GrCCAtlas::CoverageType::kA8_LiteralCoverage == fCachedAtlas->coverageType()) {
+        ++pathCache->fStats.fNumCompactedPaths;
+    }
     ReleaseAtlasResult releaseAtlasResult = this->releaseCachedAtlas(pathCache);
 
     fCachedAtlas = atlas->refOrMakeCachedAtlas(onFlushRP);
@@ -412,7 +421,11 @@ GrCCPathCacheEntry::ReleaseAtlasResult GrCCCachedAtlas::invalidatePathPixels(
     // Mark the pixels invalid in the cached atlas texture.
     fNumInvalidatedPathPixels += numPixels;
     SkASSERT(fNumInvalidatedPathPixels <= fNumPathPixels);
-    if (!fIsInvalidatedFromResourceCache && fNumInvalidatedPathPixels >= fNumPathPixels / 2) {
+    if (fIsInvalidatedFromResourceCache) {
+        return ReleaseAtlasResult::kNone;
+    }
+    pathCache->fStats.fWastedAtlasPixels += numPixels;
+    if (fNumInvalidatedPathPixels >= fNumPathPixels / 2) {
         // Too many invalidated pixels: purge the atlas texture from the resource cache.
         if (fOnFlushProxy) {
             // Don't clear (or std::move) fOnFlushProxy. Other path cache entries might still have a
@@ -422,6 +435,7 @@ GrCCPathCacheEntry::ReleaseAtlasResult GrCCCachedAtlas::invalidatePathPixels(
         } else {
             pathCache->fInvalidatedProxyUniqueKeys.push_back(fTextureKey);
         }
+        pathCache->fStats.fWastedAtlasPixels -= fNumInvalidatedPathPixels;
         fIsInvalidatedFromResourceCache = true;
         return ReleaseAtlasResult::kDidInvalidateFromCache;
     }
@@ -120,6 +120,16 @@ public:
     void purgeInvalidatedAtlasTextures(GrOnFlushResourceProvider*);
     void purgeInvalidatedAtlasTextures(GrProxyProvider*);
 
+    // Running totals that describe how well the cache is working.
+    struct Stats {
+        int fNumFinds = 0;              // Calls to find() for shapes that have a cache key.
+        int fNumAtlasHits = 0;          // Finds whose entry still had a mask in a cached atlas.
+        int fNumCompactedPaths = 0;     // Masks copied out of fragmented literal coverage atlases.
+        int64_t fWastedAtlasPixels = 0; // Pixels of cached atlases that no entry uses anymore.
+    };
+
+    const Stats& stats() const { return fStats; }
+
 private:
     // This is a special ref ptr for GrCCPathCacheEntry, used by the hash table. It provides static
     // methods for SkTHash, and can only be moved. This guarantees the hash table holds exactly one
@@ -181,7 +191,10 @@ private:
     SkSTArray<4, sk_sp<GrTextureProxy>> fInvalidatedProxies;
     SkSTArray<4, GrUniqueKey> fInvalidatedProxyUniqueKeys;
 
+    Stats fStats;
+
     friend class GrCCCachedAtlas;  // To append to fInvalidatedProxies, fInvalidatedProxyUniqueKeys.
+    friend class GrCCPathCacheEntry;  // To update fStats.
 
 public:
     const SkTHashTable<HashNode, const Key&>& testingOnly_getHashTable() const;
@@ -233,8 +246,9 @@ public:
                                const SkRect& devBounds, const SkRect& devBounds45,
                                const SkIRect& devIBounds, const SkIVector& maskShift);
 
-    // Called once our path mask has been copied into a permanent, 8-bit atlas. This method points
-    // the entry at the new atlas and updates the GrCCCCachedAtlas data.
+    // Called once our path mask has been copied into a permanent, 8-bit atlas, either out of a
+    // coverage count atlas or out of a fragmented 8-bit atlas that is being compacted. This method
+    // points the entry at the new atlas and updates the GrCCCCachedAtlas data.
     ReleaseAtlasResult upgradeToLiteralCoverageAtlas(GrCCPathCache*, GrOnFlushResourceProvider*,
                                                      GrCCAtlas*, const SkIVector& newAtlasOffset);
 
@@ -282,6 +296,11 @@ public:
  * potentially be reused (i.e., those which still represent an extant path). When the percentage
  * of useful pixels drops below 50%, we purge the entire texture from the resource cache.
  *
+ * Literal coverage atlases that have lost a quarter of their pixels by the start of a flush are
+ * compacted: every path drawn from them during that flush gets copied into a new literal coverage
+ * atlas. The old texture then soon drops below 50% and gets purged, taking with it the paths that
+ * are no longer drawn.
+ *
  * This object also holds a ref on the atlas's actual texture proxy during flush. When
  * fOnFlushRefCnt decrements back down to zero, we release fOnFlushProxy and reset it back to null.
  */
@@ -305,11 +324,18 @@ public:
 
     GrTextureProxy* getOnFlushProxy() const { return fOnFlushProxy.get(); }
 
+    // Called when the atlas is first used during a flush. This also decides whether the atlas gets
+    // compacted during the flush, so the decision doesn't change as entries get invalidated.
     void setOnFlushProxy(sk_sp<GrTextureProxy> proxy) {
         SkASSERT(!fOnFlushProxy);
         fOnFlushProxy = std::move(proxy);
+        fNeedsCompaction = GrCCAtlas::CoverageType::kA8_LiteralCoverage == fCoverageType &&
+                           fNumInvalidatedPathPixels * 4 >= fNumPathPixels;
     }
 
+    // Should paths drawn from this atlas be copied into a new one during the current flush?
+    bool needsCompaction() const { return fNeedsCompaction; }
+
     void addPathPixels(int numPixels) { fNumPathPixels += numPixels; }
     ReleaseAtlasResult invalidatePathPixels(GrCCPathCache*, int numPixels);
 
@@ -328,6 +354,7 @@ private:
     int fNumPathPixels = 0;
     int fNumInvalidatedPathPixels = 0;
     bool fIsInvalidatedFromResourceCache = false;
+    bool fNeedsCompaction = false;
 
     mutable sk_sp<GrTextureProxy> fOnFlushProxy;
     mutable int fOnFlushRefCnt = 0;
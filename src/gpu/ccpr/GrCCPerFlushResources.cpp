@@ -203,11 +203,18 @@ void GrCCPerFlushResources::upgradeEntryToLiteralCoverageAtlas(
     SkASSERT(cachedAtlas);
     SkASSERT(cachedAtlas->getOnFlushProxy());
 
+    bool isCompaction = false;
     if (GrCCAtlas::CoverageType::kA8_LiteralCoverage == cachedAtlas->coverageType()) {
-        // This entry has already been upgraded to literal coverage. The path must have been drawn
-        // multiple times during the flush.
-        SkDEBUGCODE(--fEndCopyInstance);
-        return;
+        if (!cachedAtlas->needsCompaction()) {
+            // This entry has already been upgraded to literal coverage. The path must have been
+            // drawn multiple times during the flush.
+            SkDEBUGCODE(--fEndCopyInstance);
+            return;
+        }
+        // The entry is being moved out of a fragmented literal coverage atlas. Its mask already
+        // holds literal coverage, so there is no fill rule to apply while copying.
+        isCompaction = true;
+        evenOdd = GrCCPathProcessor::DoEvenOddFill::kNo;
     }
 
     SkIVector newAtlasOffset;
@@ -225,11 +232,13 @@ void GrCCPerFlushResources::upgradeEntryToLiteralCoverageAtlas(
             sk_ref_sp(cachedAtlas->getOnFlushProxy()->peekTexture());
     GrCCAtlas* newAtlas = &fCopyAtlasStack.current();
     if (ReleaseAtlasResult::kDidInvalidateFromCache ==
-            entry->upgradeToLiteralCoverageAtlas(pathCache, onFlushRP, newAtlas, newAtlasOffset)) {
+            entry->upgradeToLiteralCoverageAtlas(pathCache, onFlushRP, newAtlas, newAtlasOffset) &&
+        !isCompaction) {
         // This texture just got booted out of the cache. Keep it around, in case we might be able
         // to recycle it for a new atlas. We can recycle it because copying happens before rendering
         // new paths, and every path from the atlas that we're planning to use this flush will be
-        // copied to a new atlas. We'll never copy some and leave others.
+        // copied to a new atlas. We'll never copy some and leave others. (Compacted atlases are
+        // 8-bit, so their textures can't back the coverage count atlases we render.)
         fRecyclableAtlasTextures.push_back(std::move(previousAtlasTexture));
     }
 }
@@ -7,9 +7,11 @@
 
 #include "GrCoverageCountingPathRenderer.h"
 
+#include "GrAppliedClip.h"
 #include "GrCaps.h"
 #include "GrClip.h"
 #include "GrProxyProvider.h"
+#include "GrRenderTargetContext.h"
 #include "SkMakeUnique.h"
 #include "SkPathOps.h"
 #include "ccpr/GrCCClipProcessor.h"
@@ -86,12 +88,8 @@ GrPathRenderer::CanDrawPath GrCoverageCountingPathRenderer::onCanDrawPath(
                 return CanDrawPath::kNo;
             }
 
-            if (numPixels > 256 * 256) {
-                // Large paths can blow up the atlas fast. And they are not ideal for a two-pass
-                // rendering algorithm. Give the simpler direct renderers a chance before we commit
-                // to drawing it.
-                return CanDrawPath::kAsBackup;
-            }
+            // Large fills are drawn in kTileSize tiles (see onDrawPath), so they don't blow up the
+            // atlas.
 
             if (args.fShape->hasUnstyledKey() && path.countVerbs() > 50) {
                 // Complex paths do better cached in an SDF, if the renderer will accept them.
@@ -133,6 +131,40 @@ GrPathRenderer::CanDrawPath GrCoverageCountingPathRenderer::onCanDrawPath(
     return CanDrawPath::kNo;
 }
 
+namespace {
+
+// Restricts a draw to one tile of a large path, in addition to the draw's own clip.
+class TileClip : public GrClip {
+public:
+    TileClip(const GrClip& clip, const SkIRect& tile) : fClip(clip), fTile(tile) {}
+
+    bool quickContains(const SkRect& rect) const override {
+        return SkRect::Make(fTile).contains(rect) && fClip.quickContains(rect);
+    }
+    void getConservativeBounds(int width, int height, SkIRect* devResult,
+                               bool* isIntersectionOfRects) const override {
+        fClip.getConservativeBounds(width, height, devResult, isIntersectionOfRects);
+        if (!devResult->intersect(fTile)) {
+            devResult->setEmpty();
+        }
+    }
+    bool apply(GrRecordingContext* context, GrRenderTargetContext* rtc, bool useHWAA,
+               bool hasUserStencilSettings, GrAppliedClip* out, SkRect* bounds) const override {
+        if (!bounds->intersect(SkRect::Make(fTile))) {
+            return false;
+        }
+        return fClip.apply(context, rtc, useHWAA, hasUserStencilSettings, out, bounds) &&
+               out->hardClip().addScissor(fTile, bounds);
+    }
+    bool isRRect(const SkRect&, SkRRect*, GrAA*) const override { return false; }
+
+private:
+    const GrClip& fClip;
+    const SkIRect fTile;
+};
+
+}  // namespace
+
 bool GrCoverageCountingPathRenderer::onDrawPath(const DrawPathArgs& args) {
     SkASSERT(!fFlushing);
 
@@ -140,20 +172,51 @@ bool GrCoverageCountingPathRenderer::onDrawPath(const DrawPathArgs& args) {
     GrRenderTargetContext* rtc = args.fRenderTargetContext;
     args.fClip->getConservativeBounds(rtc->width(), rtc->height(), &clipIBounds, nullptr);
 
-    auto op = GrCCDrawPathsOp::Make(args.fContext, clipIBounds, *args.fViewMatrix, *args.fShape,
-                                    std::move(args.fPaint));
-    this->recordOp(std::move(op), args);
+    SkIRect maskDevIBounds = SkIRect::MakeEmpty();
+    if (args.fShape->style().isSimpleFill()) {
+        SkRect devBounds;
+        args.fViewMatrix->mapRect(&devBounds, args.fShape->bounds());
+        devBounds.roundOut(&maskDevIBounds);
+        if (!maskDevIBounds.intersect(clipIBounds)) {
+            return true;  // The path is completely clipped away.
+        }
+    }
+
+    if (maskDevIBounds.width() <= kTileSize && maskDevIBounds.height() <= kTileSize) {
+        auto op = GrCCDrawPathsOp::Make(args.fContext, clipIBounds, *args.fViewMatrix,
+                                        *args.fShape, std::move(args.fPaint));
+        this->recordOp(std::move(op), *args.fClip, args);
+        return true;
+    }
+
+    // The fill is too large to render into an atlas in one piece. Render and draw it one tile at a
+    // time instead, each tile only reserving its own part of the mask in an atlas. The tiles share
+    // a cache key, so keep them out of the path cache.
+    SkPath path;
+    args.fShape->asPath(&path);
+    path.setIsVolatile(true);
+    GrShape tileShape(path, args.fShape->style());
+    for (int y = maskDevIBounds.top(); y < maskDevIBounds.bottom(); y += kTileSize) {
+        for (int x = maskDevIBounds.left(); x < maskDevIBounds.right(); x += kTileSize) {
+            SkIRect tile = SkIRect::MakeLTRB(x, y,
+                                             SkTMin(x + kTileSize, maskDevIBounds.right()),
+                                             SkTMin(y + kTileSize, maskDevIBounds.bottom()));
+            auto op = GrCCDrawPathsOp::Make(args.fContext, tile, *args.fViewMatrix, tileShape,
+                                            GrPaint::Clone(args.fPaint));
+            this->recordOp(std::move(op), TileClip(*args.fClip, tile), args);
+        }
+    }
     return true;
 }
 
 void GrCoverageCountingPathRenderer::recordOp(std::unique_ptr<GrCCDrawPathsOp> op,
-                                              const DrawPathArgs& args) {
+                                              const GrClip& clip, const DrawPathArgs& args) {
     if (op) {
         auto addToOwningPerOpListPaths = [this](GrOp* op, uint32_t opListID) {
             op->cast<GrCCDrawPathsOp>()->addToOwningPerOpListPaths(
                     sk_ref_sp(this->lookupPendingPaths(opListID)));
         };
-        args.fRenderTargetContext->addDrawOp(*args.fClip, std::move(op), addToOwningPerOpListPaths);
+        args.fRenderTargetContext->addDrawOp(clip, std::move(op), addToOwningPerOpListPaths);
     }
 }
 
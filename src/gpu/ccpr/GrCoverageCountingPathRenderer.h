@@ -74,6 +74,10 @@ public:
 
     static void CropPath(const SkPath&, const SkIRect& cropbox, SkPath* out);
 
+    // Fills whose clipped device bounds are larger than this in either dimension get split into
+    // kTileSize x kTileSize tiles, each rendered into its own atlas region and drawn separately.
+    static constexpr int kTileSize = 1024;
+
     // Maximum inflation of path bounds due to stroking (from width, miter, caps). Strokes wider
     // than this will be converted to fill paths and drawn by the CCPR filler instead.
     static constexpr float kMaxBoundsInflationFromStroke = 4096;
@@ -92,7 +96,7 @@ private:
     bool onDrawPath(const DrawPathArgs&) override;
 
     GrCCPerOpListPaths* lookupPendingPaths(uint32_t opListID);
-    void recordOp(std::unique_ptr<GrCCDrawPathsOp>, const DrawPathArgs&);
+    void recordOp(std::unique_ptr<GrCCDrawPathsOp>, const GrClip&, const DrawPathArgs&);
 
     // fPendingPaths holds the GrCCPerOpListPaths objects that have already been created, but not
     // flushed, and those that are still being created. All GrCCPerOpListPaths objects will first
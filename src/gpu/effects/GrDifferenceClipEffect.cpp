@@ -0,0 +1,216 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrDifferenceClipEffect.h"
+#include "SkRRect.h"
+#include "glsl/GrGLSLFragmentProcessor.h"
+#include "glsl/GrGLSLFragmentShaderBuilder.h"
+#include "glsl/GrGLSLProgramDataManager.h"
+#include "glsl/GrGLSLUniformHandler.h"
+
+//////////////////////////////////////////////////////////////////////////////
+
+class GrGLDifferenceClipEffect : public GrGLSLFragmentProcessor {
+public:
+    GrGLDifferenceClipEffect() {
+        for (size_t i = 0; i < SK_ARRAY_COUNT(fPrevShapes); ++i) {
+            fPrevShapes[i] = SK_ScalarNaN;
+        }
+        for (size_t i = 0; i < SK_ARRAY_COUNT(fPrevRadii); ++i) {
+            fPrevRadii[i] = SK_ScalarNaN;
+        }
+    }
+
+    void emitCode(EmitArgs&) override;
+
+    static inline void GenKey(const GrProcessor&, const GrShaderCaps&, GrProcessorKeyBuilder*);
+
+protected:
+    void onSetData(const GrGLSLProgramDataManager&, const GrFragmentProcessor&) override;
+
+private:
+    GrGLSLProgramDataManager::UniformHandle fShapesUniform;
+    GrGLSLProgramDataManager::UniformHandle fRadiiUniform;
+    float fPrevShapes[4 * GrDifferenceClipEffect::kMaxShapes];
+    float fPrevRadii[GrDifferenceClipEffect::kMaxShapes];
+    typedef GrGLSLFragmentProcessor INHERITED;
+};
+
+void GrGLDifferenceClipEffect::emitCode(EmitArgs& args) {
+    const GrDifferenceClipEffect& dce = args.fFp.cast<GrDifferenceClipEffect>();
+
+    const char* shapesName;
+    fShapesUniform = args.fUniformHandler->addUniformArray(kFragment_GrShaderFlag,
+                                                           kFloat4_GrSLType,
+                                                           "shapes",
+                                                           dce.shapeCount(),
+                                                           &shapesName);
+    const char* radiiName = nullptr;
+    if (dce.roundMask()) {
+        fRadiiUniform = args.fUniformHandler->addUniformArray(kFragment_GrShaderFlag,
+                                                              kFloat_GrSLType,
+                                                              "radii",
+                                                              dce.shapeCount(),
+                                                              &radiiName);
+    }
+
+    // q is the fragment's offset from each shape's inner rect, which is inset by the corner
+    // radius. Everything is measured from pixel centers, so a pixel centered on an edge is 50%
+    // covered in the AA case and 100% uncovered in the BW case.
+    GrGLSLFPFragmentBuilder* fragBuilder = args.fFragBuilder;
+    fragBuilder->codeAppend("half alpha = 1.0;");
+    fragBuilder->codeAppend("float2 q;");
+    for (int i = 0; i < dce.shapeCount(); ++i) {
+        bool aa = SkToBool(dce.aaMask() & (1 << i));
+        bool round = SkToBool(dce.roundMask() & (1 << i));
+        fragBuilder->codeAppendf("q = abs(sk_FragCoord.xy - %s[%d].xy) - %s[%d].zw;",
+                                 shapesName, i, shapesName, i);
+        if (round && aa) {
+            fragBuilder->codeAppendf("alpha *= 1.0 - half(saturate(%s[%d] + 0.5 - "
+                                                                  "length(max(q, 0.0))));",
+                                     radiiName, i);
+        } else if (round) {
+            fragBuilder->codeAppendf("alpha *= length(max(q, 0.0)) < %s[%d] ? 0.0 : 1.0;",
+                                     radiiName, i);
+        } else if (aa) {
+            fragBuilder->codeAppend("alpha *= 1.0 - half(saturate(0.5 - q.x) * "
+                                                        "saturate(0.5 - q.y));");
+        } else {
+            fragBuilder->codeAppend("alpha *= max(q.x, q.y) < 0.0 ? 0.0 : 1.0;");
+        }
+    }
+    fragBuilder->codeAppendf("%s = %s * alpha;", args.fOutputColor, args.fInputColor);
+}
+
+void GrGLDifferenceClipEffect::onSetData(const GrGLSLProgramDataManager& pdman,
+                                         const GrFragmentProcessor& effect) {
+    const GrDifferenceClipEffect& dce = effect.cast<GrDifferenceClipEffect>();
+    size_t shapesByteSize = 4 * dce.shapeCount() * sizeof(float);
+    if (0 != memcmp(fPrevShapes, dce.shapes(), shapesByteSize)) {
+        pdman.set4fv(fShapesUniform, dce.shapeCount(), dce.shapes());
+        memcpy(fPrevShapes, dce.shapes(), shapesByteSize);
+    }
+    size_t radiiByteSize = dce.shapeCount() * sizeof(float);
+    if (dce.roundMask() && 0 != memcmp(fPrevRadii, dce.radii(), radiiByteSize)) {
+        pdman.set1fv(fRadiiUniform, dce.shapeCount(), dce.radii());
+        memcpy(fPrevRadii, dce.radii(), radiiByteSize);
+    }
+}
+
+void GrGLDifferenceClipEffect::GenKey(const GrProcessor& processor, const GrShaderCaps&,
+                                      GrProcessorKeyBuilder* b) {
+    const GrDifferenceClipEffect& dce = processor.cast<GrDifferenceClipEffect>();
+    GR_STATIC_ASSERT(GrDifferenceClipEffect::kMaxShapes <= 8);
+    b->add32((dce.roundMask() << 12) | (dce.aaMask() << 4) | dce.shapeCount());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool GrDifferenceClipEffect::CanClipOut(const SkRRect& rrect) {
+    if (rrect.isRect()) {
+        return true;
+    }
+    if (!rrect.isSimple()) {
+        return false;
+    }
+    const SkVector& radii = rrect.getSimpleRadii();
+    return radii.fX == radii.fY;
+}
+
+std::unique_ptr<GrFragmentProcessor> GrDifferenceClipEffect::Make(int n, const SkRRect rrects[],
+                                                                  const GrAA aa[]) {
+    if (n <= 0 || n > kMaxShapes) {
+        return nullptr;
+    }
+    for (int i = 0; i < n; ++i) {
+        if (!CanClipOut(rrects[i])) {
+            return nullptr;
+        }
+    }
+    return std::unique_ptr<GrFragmentProcessor>(new GrDifferenceClipEffect(n, rrects, aa));
+}
+
+GrDifferenceClipEffect::GrDifferenceClipEffect(int n, const SkRRect rrects[], const GrAA aa[])
+        : INHERITED(kGrDifferenceClipEffect_ClassID,
+                    kCompatibleWithCoverageAsAlpha_OptimizationFlag)
+        , fShapeCount(n)
+        , fAAMask(0)
+        , fRoundMask(0) {
+    // Factory function should have already ensured this.
+    SkASSERT(n <= kMaxShapes);
+    for (int i = 0; i < n; ++i) {
+        const SkRect& rect = rrects[i].rect();
+        float radius = rrects[i].isRect() ? 0 : rrects[i].getSimpleRadii().fX;
+        fShapes[4 * i + 0] = rect.centerX();
+        fShapes[4 * i + 1] = rect.centerY();
+        fShapes[4 * i + 2] = rect.width() / 2 - radius;
+        fShapes[4 * i + 3] = rect.height() / 2 - radius;
+        fRadii[i] = radius;
+        if (GrAA::kYes == aa[i]) {
+            fAAMask |= 1 << i;
+        }
+        if (radius > 0) {
+            fRoundMask |= 1 << i;
+        }
+    }
+}
+
+GrDifferenceClipEffect::GrDifferenceClipEffect(const GrDifferenceClipEffect& that)
+        : INHERITED(kGrDifferenceClipEffect_ClassID,
+                    kCompatibleWithCoverageAsAlpha_OptimizationFlag)
+        , fShapeCount(that.fShapeCount)
+        , fAAMask(that.fAAMask)
+        , fRoundMask(that.fRoundMask) {
+    memcpy(fShapes, that.fShapes, 4 * that.fShapeCount * sizeof(float));
+    memcpy(fRadii, that.fRadii, that.fShapeCount * sizeof(float));
+}
+
+std::unique_ptr<GrFragmentProcessor> GrDifferenceClipEffect::clone() const {
+    return std::unique_ptr<GrFragmentProcessor>(new GrDifferenceClipEffect(*this));
+}
+
+void GrDifferenceClipEffect::onGetGLSLProcessorKey(const GrShaderCaps& caps,
+                                                   GrProcessorKeyBuilder* b) const {
+    GrGLDifferenceClipEffect::GenKey(*this, caps, b);
+}
+
+GrGLSLFragmentProcessor* GrDifferenceClipEffect::onCreateGLSLInstance() const {
+    return new GrGLDifferenceClipEffect;
+}
+
+bool GrDifferenceClipEffect::onIsEqual(const GrFragmentProcessor& other) const {
+    const GrDifferenceClipEffect& dce = other.cast<GrDifferenceClipEffect>();
+    // ignore the fact that 0 == -0 and just use memcmp.
+    return (dce.fShapeCount == fShapeCount && dce.fAAMask == fAAMask &&
+            dce.fRoundMask == fRoundMask &&
+            0 == memcmp(dce.fShapes, fShapes, 4 * fShapeCount * sizeof(float)) &&
+            0 == memcmp(dce.fRadii, fRadii, fShapeCount * sizeof(float)));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+GR_DEFINE_FRAGMENT_PROCESSOR_TEST(GrDifferenceClipEffect);
+
+#if GR_TEST_UTILS
+std::unique_ptr<GrFragmentProcessor> GrDifferenceClipEffect::TestCreate(GrProcessorTestData* d) {
+    int count = d->fRandom->nextULessThan(kMaxShapes) + 1;
+    SkRRect rrects[kMaxShapes];
+    GrAA aa[kMaxShapes];
+    for (int i = 0; i < count; ++i) {
+        SkRect rect = SkRect::MakeXYWH(d->fRandom->nextRangeScalar(0.f, 1000.f),
+                                       d->fRandom->nextRangeScalar(0.f, 1000.f),
+                                       d->fRandom->nextRangeScalar(1.f, 100.f),
+                                       d->fRandom->nextRangeScalar(1.f, 100.f));
+        // Keep the radius under half the short side so the rrect stays simple, not an oval.
+        SkScalar maxR = 0.4f * SkTMin(rect.width(), rect.height());
+        SkScalar r = d->fRandom->nextBool() ? 0 : d->fRandom->nextRangeScalar(0.1f, maxR);
+        rrects[i].setRectXY(rect, r, r);
+        aa[i] = GrAA(d->fRandom->nextBool());
+    }
+    return GrDifferenceClipEffect::Make(count, rrects, aa);
+}
+#endif
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrDifferenceClipEffect_DEFINED
+#define GrDifferenceClipEffect_DEFINED
+
+#include "GrFragmentProcessor.h"
+#include "GrTypesPriv.h"
+
+class SkRRect;
+
+/**
+ * A coverage effect that clips out the interiors of several device-space rects and circular
+ * rrects in a single stage, so a stack of difference clips doesn't spend one analytic clip FP
+ * apiece (or fall back to a mask once those run out). Each shape may be AA or BW; BW shapes are
+ * sampled at pixel centers.
+ */
+class GrDifferenceClipEffect : public GrFragmentProcessor {
+public:
+    enum {
+        kMaxShapes = 8,
+    };
+
+    /**
+     * Returns true if the effect can clip out rrect, i.e. if it is a rect or a simple rrect with
+     * circular corners.
+     */
+    static bool CanClipOut(const SkRRect& rrect);
+
+    /**
+     * Creates an effect that clips out the n device-space rrects, where n is limited to
+     * kMaxShapes and each rrect must pass CanClipOut(). aa[i] says whether rrects[i] is AA.
+     */
+    static std::unique_ptr<GrFragmentProcessor> Make(int n, const SkRRect rrects[],
+                                                     const GrAA aa[]);
+
+    const char* name() const override { return "DifferenceClip"; }
+
+    std::unique_ptr<GrFragmentProcessor> clone() const override;
+
+    int shapeCount() const { return fShapeCount; }
+
+    // Each shape is (centerX, centerY, halfWidth - radius, halfHeight - radius).
+    const float* shapes() const { return fShapes; }
+
+    const float* radii() const { return fRadii; }
+
+    // Bit i is set if shape i is AA.
+    uint32_t aaMask() const { return fAAMask; }
+
+    // Bit i is set if shape i has round corners.
+    uint32_t roundMask() const { return fRoundMask; }
+
+private:
+    GrDifferenceClipEffect(int n, const SkRRect rrects[], const GrAA aa[]);
+    GrDifferenceClipEffect(const GrDifferenceClipEffect&);
+
+    GrGLSLFragmentProcessor* onCreateGLSLInstance() const override;
+
+    void onGetGLSLProcessorKey(const GrShaderCaps&, GrProcessorKeyBuilder*) const override;
+
+    bool onIsEqual(const GrFragmentProcessor& other) const override;
+
+    int      fShapeCount;
+    float    fShapes[4 * kMaxShapes];
+    float    fRadii[kMaxShapes];
+    uint32_t fAAMask;
+    uint32_t fRoundMask;
+
+    GR_DECLARE_FRAGMENT_PROCESSOR_TEST
+
+    typedef GrFragmentProcessor INHERITED;
+};
+
+#endif
@@ -22,6 +22,19 @@
 // Assuming a radius of a little less than the diagonal of the fragment
 #define SK_DistanceFieldAAFactor     "0.65"
 
+// Declares 'distance' from the distance field sample in 'texColor'. Multi-channel fields store
+// three distances whose median is the distance to the shape.
+static void append_distance(GrGLSLFPFragmentBuilder* fragBuilder, uint32_t flags) {
+    if (flags & kMultiChannel_DistanceFieldEffectFlag) {
+        fragBuilder->codeAppend("half texDistance = max(min(texColor.r, texColor.g), "
+                                "min(max(texColor.r, texColor.g), texColor.b));");
+    } else {
+        fragBuilder->codeAppend("half texDistance = texColor.r;");
+    }
+    fragBuilder->codeAppend("half distance = "
+                  SK_DistanceFieldMultiplier "*(texDistance - " SK_DistanceFieldThreshold ");");
+}
+
 class GrGLDistanceFieldA8TextGeoProc : public GrGLSLGeometryProcessor {
 public:
     GrGLDistanceFieldA8TextGeoProc() = default;
@@ -87,8 +100,7 @@ public:
         append_multitexture_lookup(args, dfTexEffect.numTextureSamplers(),
                                    texIdx, "uv", "texColor");
 
-        fragBuilder->codeAppend("half distance = "
-                      SK_DistanceFieldMultiplier "*(texColor.r - " SK_DistanceFieldThreshold ");");
+        append_distance(fragBuilder, dfTexEffect.getFlags());
 #ifdef SK_GAMMA_APPLY_TO_A8
         // adjust width based on gamma
         fragBuilder->codeAppendf("distance -= %s;", distanceAdjustUniName);
@@ -387,8 +399,7 @@ public:
         append_multitexture_lookup(args, dfPathEffect.numTextureSamplers(), texIdx, "uv",
                                    "texColor");
 
-        fragBuilder->codeAppend("half distance = "
-            SK_DistanceFieldMultiplier "*(texColor.r - " SK_DistanceFieldThreshold ");");
+        append_distance(fragBuilder, dfPathEffect.getFlags());
 
         fragBuilder->codeAppend("half afwidth;");
         bool isUniformScale = (dfPathEffect.getFlags() & kUniformScale_DistanceFieldEffectMask) ==
@@ -25,8 +25,9 @@ enum GrDistanceFieldEffectFlags {
     kPortrait_DistanceFieldEffectFlag     = 0x20, // lcd display is in portrait mode (not used yet)
     kGammaCorrect_DistanceFieldEffectFlag = 0x40, // assume gamma-correct output (linear blending)
     kAliased_DistanceFieldEffectFlag      = 0x80, // monochrome output
+    kMultiChannel_DistanceFieldEffectFlag = 0x100, // median of rgb is the distance (MSDF)
 
-    kInvalid_DistanceFieldEffectFlag      = 0x100,   // invalid state (for initialization)
+    kInvalid_DistanceFieldEffectFlag      = 0x200,   // invalid state (for initialization)
 
     kUniformScale_DistanceFieldEffectMask = kSimilarity_DistanceFieldEffectFlag |
                                             kScaleOnly_DistanceFieldEffectFlag,
@@ -35,7 +36,8 @@ enum GrDistanceFieldEffectFlags {
                                             kScaleOnly_DistanceFieldEffectFlag |
                                             kPerspective_DistanceFieldEffectFlag |
                                             kGammaCorrect_DistanceFieldEffectFlag |
-                                            kAliased_DistanceFieldEffectFlag,
+                                            kAliased_DistanceFieldEffectFlag |
+                                            kMultiChannel_DistanceFieldEffectFlag,
     // The subset of the flags relevant to GrDistanceFieldLCDTextGeoProc
     kLCD_DistanceFieldEffectMask          = kSimilarity_DistanceFieldEffectFlag |
                                             kScaleOnly_DistanceFieldEffectFlag |
@@ -7,12 +7,23 @@
 
 #include "GrShadowGeoProc.h"
 
+#include "SkOnce.h"
 #include "glsl/GrGLSLFragmentShaderBuilder.h"
 #include "glsl/GrGLSLGeometryProcessor.h"
 #include "glsl/GrGLSLUniformHandler.h"
 #include "glsl/GrGLSLVarying.h"
 #include "glsl/GrGLSLVertexGeoBuilder.h"
 
+// Turns the interpolated shadow params into the shadow's falloff.
+static void emit_shadow_coverage(GrGLSLFPFragmentBuilder* fragBuilder, const char* outputCoverage) {
+    fragBuilder->codeAppend("half d = length(shadowParams.xy);");
+    fragBuilder->codeAppend("half distance = shadowParams.z * (1.0 - d);");
+
+    fragBuilder->codeAppend("half factor = 1.0 - clamp(distance, 0.0, 1.0);");
+    fragBuilder->codeAppend("factor = exp(-factor * factor * 4.0) - 0.018;");
+    fragBuilder->codeAppendf("%s = half4(factor);", outputCoverage);
+}
+
 class GrGLSLRRectShadowGeoProc : public GrGLSLGeometryProcessor {
 public:
     GrGLSLRRectShadowGeoProc() {}
@@ -42,13 +53,7 @@ public:
                              rsgp.inPosition().asShaderVar(),
                              args.fFPCoordTransformHandler);
 
-        fragBuilder->codeAppend("half d = length(shadowParams.xy);");
-        fragBuilder->codeAppend("half distance = shadowParams.z * (1.0 - d);");
-
-        fragBuilder->codeAppend("half factor = 1.0 - clamp(distance, 0.0, 1.0);");
-        fragBuilder->codeAppend("factor = exp(-factor * factor * 4.0) - 0.018;");
-        fragBuilder->codeAppendf("%s = half4(factor);",
-                                 args.fOutputCoverage);
+        emit_shadow_coverage(fragBuilder, args.fOutputCoverage);
     }
 
     void setData(const GrGLSLProgramDataManager& pdman, const GrPrimitiveProcessor& proc,
@@ -82,3 +87,169 @@ sk_sp<GrGeometryProcessor> GrRRectShadowGeoProc::TestCreate(GrProcessorTestData*
     return GrRRectShadowGeoProc::Make();
 }
 #endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+class GrGLSLInstancedRRectShadowGeoProc : public GrGLSLGeometryProcessor {
+public:
+    void onEmitCode(EmitArgs& args, GrGPArgs* gpArgs) override {
+        const auto& proc = args.fGP.cast<GrInstancedRRectShadowGeoProc>();
+        GrGLSLVaryingHandler* varyingHandler = args.fVaryingHandler;
+        varyingHandler->emitAttributes(proc);
+        varyingHandler->addPassThroughAttribute(proc.fInColor, args.fOutputColor,
+                                                GrGLSLVaryingHandler::Interpolation::kCanBeFlat);
+
+        // inBounds is the shadow's device rect; inRadii holds its outer radius, umbra inset,
+        // inner radius and blur radius.
+        GrGLSLVertexBuilder* v = args.fVertBuilder;
+        v->codeAppend("float2 position;");
+        v->codeAppend("float2 offset;");
+        v->codeAppend("float distanceCorrection;");
+        if (GrInstancedRRectShadowGeoProc::Shape::kCircles == proc.fShape) {
+            // inCorner.xy is the vertex's direction from the center; z is 0 for the outer
+            // octagon and 1 for the inner one.
+            v->codeAppend("float2 center = (inBounds.xy + inBounds.zw) * .5;");
+            v->codeAppend("float halfWidth = .5 * (inBounds.z - inBounds.x);");
+            v->codeAppend("float ringRadius = 0 == inCorner.z ? halfWidth : inRadii.z;");
+            v->codeAppend("position = center + inCorner.xy * ringRadius;");
+            // The inner radius in the shadow params is in normalized space.
+            v->codeAppend("offset = inCorner.xy * (0 == inCorner.z ? 1 : inRadii.z/inRadii.x);");
+            v->codeAppend("distanceCorrection = inRadii.x / inRadii.w;");
+        } else {
+            // inCorner.x is the corner (TL, TR, BL, BR), yz are the x and y insets of the vertex
+            // (0 for the edge, 1 the outer radius, 2 the umbra, 3 the overstroke rect), and w
+            // selects its offset.
+            v->codeAppend("float2 size = inBounds.zw - inBounds.xy;");
+            v->codeAppend("float umbraInset = min(inRadii.y, .5 * min(size.x, size.y));");
+            v->codeAppend("float4 insets = float4(0, inRadii.x, umbraInset, "
+                                                 "umbraInset + inRadii.z);");
+            v->codeAppend("float4 levels = float4(0, 1, 2, 3);");
+            v->codeAppend("float2 inset = float2("
+                                  "dot(insets, step(abs(levels - inCorner.y), float4(.5))), "
+                                  "dot(insets, step(abs(levels - inCorner.z), float4(.5))));");
+            v->codeAppend("float2 rightBottom = float2(mod(inCorner.x, 2), step(1.5, inCorner.x));");
+            v->codeAppend("position = mix(inBounds.xy + inset, inBounds.zw - inset, rightBottom);");
+
+            // The skewed corner vectors fillInRRectVerts() explains.
+            v->codeAppend("float2 outerVec = float2(inRadii.x - umbraInset, "
+                                                   "-inRadii.x - umbraInset);");
+            v->codeAppend("float outerLength = length(outerVec);");
+            v->codeAppend("outerVec = outerLength > 0 ? outerVec / outerLength : float2(0);");
+            v->codeAppend("if (1 == inCorner.w) {");
+            v->codeAppend(    "offset = float2(0, -1);");
+            v->codeAppend("} else if (2 == inCorner.w) {");
+            v->codeAppend(    "offset = outerVec;");
+            v->codeAppend("} else if (3 == inCorner.w) {");
+            v->codeAppend(    "offset = float2(umbraInset / "
+                                      "(1.41421356 * (inRadii.x - umbraInset) - inRadii.x));");
+            v->codeAppend("} else {");
+            v->codeAppend(    "offset = float2(0);");
+            v->codeAppend("}");
+            v->codeAppend("distanceCorrection = umbraInset / inRadii.w;");
+        }
+        gpArgs->fPositionVar.set(kFloat2_GrSLType, "position");
+
+        this->emitTransforms(v, varyingHandler, args.fUniformHandler,
+                             GrShaderVar("position", kFloat2_GrSLType),
+                             args.fFPCoordTransformHandler);
+
+        GrGLSLVarying shadowParams(kHalf3_GrSLType);
+        varyingHandler->addVarying("shadowParams", &shadowParams);
+        v->codeAppendf("%s = half3(half2(offset), half(distanceCorrection));",
+                       shadowParams.vsOut());
+
+        GrGLSLFPFragmentBuilder* fragBuilder = args.fFragBuilder;
+        fragBuilder->codeAppendf("half3 shadowParams = %s;", shadowParams.fsIn());
+        emit_shadow_coverage(fragBuilder, args.fOutputCoverage);
+    }
+
+    void setData(const GrGLSLProgramDataManager& pdman, const GrPrimitiveProcessor& proc,
+                 FPCoordTransformIter&& transformIter) override {
+        this->setTransformDataHelper(SkMatrix::I(), pdman, &transformIter);
+    }
+
+private:
+    typedef GrGLSLGeometryProcessor INHERITED;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+constexpr GrPrimitiveProcessor::Attribute GrInstancedRRectShadowGeoProc::kInCorner;
+
+GrInstancedRRectShadowGeoProc::GrInstancedRRectShadowGeoProc(Shape shape)
+        : INHERITED(kGrInstancedRRectShadowGeoProc_ClassID)
+        , fShape(shape) {
+    this->setVertexAttributes(&kInCorner, 1);
+    fInBounds = {"inBounds", kFloat4_GrVertexAttribType, kFloat4_GrSLType};
+    fInRadii = {"inRadii", kFloat4_GrVertexAttribType, kFloat4_GrSLType};
+    fInColor = {"inColor", kUByte4_norm_GrVertexAttribType, kHalf4_GrSLType};
+    this->setInstanceAttributes(&fInBounds, 3);
+    SkASSERT(this->vertexStride() == kVertexStride);
+}
+
+const void* GrInstancedRRectShadowGeoProc::VertexData(Shape shape) {
+    static float sCircleData[kCircleVertexCount][4];
+    static float sRRectData[kRRectVertexCount][4];
+    static SkOnce once;
+    once([] {
+        // The octagons' directions, in the order fillInCircleVerts() emits them.
+        const float octOffset = 0.41421356237f;  // sqrt(2) - 1
+        const float c = 0.923579533f;            // cosine and sine of pi/8
+        const float s = 0.382683432f;
+        const float outer[8][2] = {{-octOffset, -1}, {octOffset, -1}, {1, -octOffset},
+                                   {1, octOffset}, {octOffset, 1}, {-octOffset, 1},
+                                   {-1, octOffset}, {-1, -octOffset}};
+        const float inner[8][2] = {{-s, -c}, {s, -c}, {c, -s}, {c, s},
+                                   {s, c}, {-s, c}, {-c, s}, {-c, -s}};
+        for (int i = 0; i < 8; ++i) {
+            for (float* outerVert : {sCircleData[i], sCircleData[kFillCircleBaseVertex + i]}) {
+                outerVert[0] = outer[i][0];
+                outerVert[1] = outer[i][1];
+                outerVert[2] = outerVert[3] = 0;
+            }
+            float* innerVert = sCircleData[8 + i];
+            innerVert[0] = inner[i][0];
+            innerVert[1] = inner[i][1];
+            innerVert[2] = 1;
+            innerVert[3] = 0;
+        }
+        float* centerVert = sCircleData[kFillCircleBaseVertex + 8];
+        centerVert[0] = centerVert[1] = centerVert[2] = centerVert[3] = 0;
+
+        // Each corner's x inset level, y inset level and offset kind, in the order
+        // fillInRRectVerts() emits them.
+        const float corner[6][3] = {{2, 2, 0}, {0, 2, 1}, {0, 1, 2},
+                                    {0, 0, 3}, {1, 0, 2}, {2, 0, 1}};
+        for (int i = 0; i < 4; ++i) {
+            for (int j = 0; j < 6; ++j) {
+                float* vert = sRRectData[6 * i + j];
+                vert[0] = i;
+                vert[1] = corner[j][0];
+                vert[2] = corner[j][1];
+                vert[3] = corner[j][2];
+            }
+            float* overstrokeVert = sRRectData[24 + i];
+            overstrokeVert[0] = i;
+            overstrokeVert[1] = overstrokeVert[2] = 3;
+            overstrokeVert[3] = 0;
+        }
+    });
+    return Shape::kCircles == shape ? static_cast<const void*>(sCircleData)
+                                    : static_cast<const void*>(sRRectData);
+}
+
+GrGLSLPrimitiveProcessor* GrInstancedRRectShadowGeoProc::createGLSLInstance(
+        const GrShaderCaps&) const {
+    return new GrGLSLInstancedRRectShadowGeoProc();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+GR_DEFINE_GEOMETRY_PROCESSOR_TEST(GrInstancedRRectShadowGeoProc);
+
+#if GR_TEST_UTILS
+sk_sp<GrGeometryProcessor> GrInstancedRRectShadowGeoProc::TestCreate(GrProcessorTestData* d) {
+    return GrInstancedRRectShadowGeoProc::Make(d->fRandom->nextBool() ? Shape::kCircles
+                                                                      : Shape::kRRects);
+}
+#endif
@@ -48,5 +48,61 @@ private:
     typedef GrGeometryProcessor INHERITED;
 };
 
+/**
+ * Draws the same shadows as GrRRectShadowGeoProc, but as instances of a static circle or rrect
+ * template. Each instance holds a shadow's device bounds, its outer radius, umbra inset, inner
+ * radius and blur radius, and its color; the vertex shader places the template's vertices and
+ * computes their shadow params.
+ */
+class GrInstancedRRectShadowGeoProc : public GrGeometryProcessor {
+public:
+    enum class Shape {
+        kCircles,
+        kRRects
+    };
+
+    // The circle template is a stroked circle's outer and inner octagons, then a filled circle's
+    // outer octagon and center, starting at kFillCircleBaseVertex. The rrect template is six
+    // vertices per corner, then the corners of the overstroke rect. Both follow the vertex order
+    // of GrShadowRRectOp's index tables.
+    static constexpr int kCircleVertexCount = 25;
+    static constexpr int kFillCircleBaseVertex = 16;
+    static constexpr int kRRectVertexCount = 28;
+
+    static sk_sp<GrGeometryProcessor> Make(Shape shape) {
+        return sk_sp<GrGeometryProcessor>(new GrInstancedRRectShadowGeoProc(shape));
+    }
+
+    /** The template vertices for shape, kVertexStride bytes each. */
+    static const void* VertexData(Shape shape);
+    static const size_t kVertexStride = 4 * sizeof(float);
+
+    const char* name() const override { return "InstancedRRectShadow"; }
+
+    void getGLSLProcessorKey(const GrShaderCaps&, GrProcessorKeyBuilder* b) const override {
+        b->add32(static_cast<uint32_t>(fShape));
+    }
+
+    GrGLSLPrimitiveProcessor* createGLSLInstance(const GrShaderCaps&) const override;
+
+private:
+    friend class GrGLSLInstancedRRectShadowGeoProc;
+
+    GrInstancedRRectShadowGeoProc(Shape);
+
+    Shape fShape;
+
+    Attribute fInBounds;
+    Attribute fInRadii;
+    Attribute fInColor;
+
+    static constexpr Attribute kInCorner = {"inCorner", kFloat4_GrVertexAttribType,
+                                            kFloat4_GrSLType};
+
+    GR_DECLARE_GEOMETRY_PROCESSOR_TEST
+
+    typedef GrGeometryProcessor INHERITED;
+};
+
 
 #endif
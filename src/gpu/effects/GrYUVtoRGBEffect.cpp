@@ -38,7 +38,8 @@ static const float kIdentityConversionMatrix[16] = {
 std::unique_ptr<GrFragmentProcessor> GrYUVtoRGBEffect::Make(const sk_sp<GrTextureProxy> proxies[],
                                                             const SkYUVAIndex yuvaIndices[4],
                                                             SkYUVColorSpace yuvColorSpace,
-                                                            GrSamplerState::Filter filterMode) {
+                                                            GrSamplerState::Filter filterMode,
+                                                            const SkMatrix& localMatrix) {
     int numPlanes;
     SkAssertResult(SkYUVAIndex::AreValidIndices(yuvaIndices, &numPlanes));
 
@@ -73,7 +74,7 @@ std::unique_ptr<GrFragmentProcessor> GrYUVtoRGBEffect::Make(const sk_sp<GrTextur
             break;
     }
     return std::unique_ptr<GrFragmentProcessor>(new GrYUVtoRGBEffect(
-            proxies, scales, filterModes, numPlanes, yuvaIndices, mat));
+            proxies, scales, filterModes, numPlanes, yuvaIndices, mat, localMatrix));
 }
 
 #ifdef SK_DEBUG
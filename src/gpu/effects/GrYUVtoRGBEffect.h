@@ -17,10 +17,12 @@
 
 class GrYUVtoRGBEffect : public GrFragmentProcessor {
 public:
+    // localMatrix maps the local coords to the image's (i.e., the Y plane's) texel coords.
     static std::unique_ptr<GrFragmentProcessor> Make(const sk_sp<GrTextureProxy> proxies[],
                                                      const SkYUVAIndex indices[4],
                                                      SkYUVColorSpace yuvColorSpace,
-                                                     GrSamplerState::Filter filterMode);
+                                                     GrSamplerState::Filter filterMode,
+                                                     const SkMatrix& localMatrix = SkMatrix::I());
 #ifdef SK_DEBUG
     SkString dumpInfo() const override;
 #endif
@@ -35,13 +37,15 @@ public:
 private:
     GrYUVtoRGBEffect(const sk_sp<GrTextureProxy> proxies[], const SkSize scales[],
                      const GrSamplerState::Filter filterModes[], int numPlanes,
-                     const SkYUVAIndex yuvaIndices[4], const SkMatrix44& colorSpaceMatrix)
+                     const SkYUVAIndex yuvaIndices[4], const SkMatrix44& colorSpaceMatrix,
+                     const SkMatrix& localMatrix)
             : INHERITED(kGrYUVtoRGBEffect_ClassID, kNone_OptimizationFlags)
             , fColorSpaceMatrix(colorSpaceMatrix) {
         for (int i = 0; i < numPlanes; ++i) {
             fSamplers[i].reset(std::move(proxies[i]),
                                GrSamplerState(GrSamplerState::WrapMode::kClamp, filterModes[i]));
-            fSamplerTransforms[i] = SkMatrix::MakeScale(scales[i].width(), scales[i].height());
+            fSamplerTransforms[i] = SkMatrix::Concat(
+                    SkMatrix::MakeScale(scales[i].width(), scales[i].height()), localMatrix);
             fSamplerCoordTransforms[i] =
                     GrCoordTransform(fSamplerTransforms[i], fSamplers[i].proxy());
         }
@@ -101,6 +101,9 @@ sk_sp<const GrGLInterface> GrGLMakeAssembledGLInterface(void *ctx, GrGLGetProc g
     GET_PROC(BlendEquation);
     GET_PROC(BlendFunc);
     GET_PROC(BufferData);
+    if (glVer >= GR_GL_VER(4,4) || extensions.has("GL_ARB_buffer_storage")) {
+        GET_PROC(BufferStorage);
+    }
     GET_PROC(BufferSubData);
     GET_PROC(Clear);
     GET_PROC(ClearColor);
@@ -475,6 +478,9 @@ sk_sp<const GrGLInterface> GrGLMakeAssembledGLESInterface(void *ctx, GrGLGetProc
     GET_PROC(BlendEquation);
     GET_PROC(BlendFunc);
     GET_PROC(BufferData);
+    if (extensions.has("GL_EXT_buffer_storage")) {
+        GET_PROC_SUFFIX(BufferStorage, EXT);
+    }
     GET_PROC(BufferSubData);
     GET_PROC(Clear);
     GET_PROC(ClearColor);
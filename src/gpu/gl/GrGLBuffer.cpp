@@ -100,9 +100,40 @@ GrGLBuffer::GrGLBuffer(GrGLGpu* gpu, size_t size, GrGpuBufferType intendedType,
         , fBufferID(0)
         , fUsage(gr_to_gl_access_pattern(intendedType, accessPattern))
         , fGLSizeInBytes(0)
-        , fHasAttachedToTexture(false) {
+        , fHasAttachedToTexture(false)
+        , fPersistentMapPtr(nullptr)
+        , fLastWriteFlushSerial(0) {
     GL_CALL(GenBuffers(1, &fBufferID));
-    if (fBufferID) {
+    bool persistent = gpu->glCaps().persistentBufferMappingSupport() &&
+                      kDynamic_GrAccessPattern == accessPattern &&
+                      (GrGpuBufferType::kVertex == intendedType ||
+                       GrGpuBufferType::kIndex == intendedType);
+    if (fBufferID && persistent) {
+        GrGLenum target = gpu->bindBuffer(fIntendedType, this);
+        static constexpr GrGLbitfield kMapFlags =
+                GR_GL_MAP_WRITE_BIT | GR_GL_MAP_PERSISTENT_BIT | GR_GL_MAP_COHERENT_BIT;
+        CLEAR_ERROR_BEFORE_ALLOC(gpu->glInterface());
+        GL_ALLOC_CALL(gpu->glInterface(), BufferStorage(target, (GrGLsizeiptr) size, data,
+                                                        kMapFlags | GR_GL_DYNAMIC_STORAGE_BIT));
+        if (CHECK_ALLOC_ERROR(gpu->glInterface()) == GR_GL_NO_ERROR) {
+            GL_CALL_RET(fPersistentMapPtr, MapBufferRange(target, 0, (GrGLsizeiptr) size,
+                                                          kMapFlags));
+        }
+        if (fPersistentMapPtr) {
+            fGLSizeInBytes = size;
+        } else {
+            // Immutable storage can't be respecified, so start over with a regular buffer. The GPU
+            // still thinks this buffer is bound to the target, so bind the new ID there directly.
+            GL_CALL(DeleteBuffers(1, &fBufferID));
+            fBufferID = 0;
+            GL_CALL(GenBuffers(1, &fBufferID));
+            if (fBufferID) {
+                GL_CALL(BindBuffer(target, fBufferID));
+            }
+            persistent = false;
+        }
+    }
+    if (fBufferID && !persistent) {
         GrGLenum target = gpu->bindBuffer(fIntendedType, this);
         CLEAR_ERROR_BEFORE_ALLOC(gpu->glInterface());
         // make sure driver can allocate memory for this buffer
@@ -138,11 +169,13 @@ void GrGLBuffer::onRelease() {
         VALIDATE();
         // make sure we've not been abandoned or already released
         if (fBufferID) {
+            // Deleting the buffer also unmaps its persistent mapping.
             GL_CALL(DeleteBuffers(1, &fBufferID));
             fBufferID = 0;
             fGLSizeInBytes = 0;
         }
         fMapPtr = nullptr;
+        fPersistentMapPtr = nullptr;
         VALIDATE();
     }
 
@@ -153,6 +186,7 @@ void GrGLBuffer::onAbandon() {
     fBufferID = 0;
     fGLSizeInBytes = 0;
     fMapPtr = nullptr;
+    fPersistentMapPtr = nullptr;
     VALIDATE();
     INHERITED::onAbandon();
 }
@@ -166,6 +200,16 @@ void GrGLBuffer::onMap() {
     VALIDATE();
     SkASSERT(!this->isMapped());
 
+    if (fPersistentMapPtr) {
+        // Writing the storage while the GPU may still read it would corrupt earlier draws. Leaving
+        // fMapPtr null makes the caller stage the data and upload it with updateData() instead.
+        if (this->glGpu()->isFlushComplete(fLastWriteFlushSerial)) {
+            fMapPtr = fPersistentMapPtr;
+        }
+        VALIDATE();
+        return;
+    }
+
     // TODO: Make this a function parameter.
     bool readOnly = (GrGpuBufferType::kXferGpuToCpu == fIntendedType);
 
@@ -175,8 +219,9 @@ void GrGLBuffer::onMap() {
             break;
         case GrGLCaps::kMapBuffer_MapBufferType: {
             GrGLenum target = this->glGpu()->bindBuffer(fIntendedType, this);
-            // Let driver know it can discard the old data
-            if (this->glCaps().useBufferDataNullHint() || fGLSizeInBytes != this->size()) {
+            // Let driver know it can discard the old data, unless we are mapping it to read it.
+            if (!readOnly &&
+                (this->glCaps().useBufferDataNullHint() || fGLSizeInBytes != this->size())) {
                 GL_CALL(BufferData(target, this->size(), nullptr, fUsage));
             }
             GL_CALL_RET(fMapPtr, MapBuffer(target, readOnly ? GR_GL_READ_ONLY : GR_GL_WRITE_ONLY));
@@ -224,6 +269,12 @@ void GrGLBuffer::onUnmap() {
         fMapPtr = nullptr;
         return;
     }
+    if (fPersistentMapPtr) {
+        // The mapping is coherent, so there is nothing to flush or unmap.
+        this->notePersistentWrite();
+        fMapPtr = nullptr;
+        return;
+    }
     // bind buffer handles the dirty context
     switch (this->glCaps().mapBufferType()) {
         case GrGLCaps::kNone_MapBufferType:
@@ -258,7 +309,12 @@ bool GrGLBuffer::onUpdateData(const void* src, size_t srcSizeInBytes) {
     // bindbuffer handles dirty context
     GrGLenum target = this->glGpu()->bindBuffer(fIntendedType, this);
 
-    if (this->glCaps().useBufferDataNullHint()) {
+    if (fPersistentMapPtr) {
+        // Immutable storage can't be orphaned, so the driver must order this after any earlier
+        // draws that still read the buffer.
+        GL_CALL(BufferSubData(target, 0, (GrGLsizeiptr) srcSizeInBytes, src));
+        this->notePersistentWrite();
+    } else if (this->glCaps().useBufferDataNullHint()) {
         if (this->size() == srcSizeInBytes) {
             GL_CALL(BufferData(target, (GrGLsizeiptr) srcSizeInBytes, src, fUsage));
         } else {
@@ -284,6 +340,11 @@ bool GrGLBuffer::onUpdateData(const void* src, size_t srcSizeInBytes) {
     return true;
 }
 
+void GrGLBuffer::notePersistentWrite() {
+    fLastWriteFlushSerial = this->glGpu()->currentFlushSerial();
+    this->glGpu()->notePersistentBufferWrite();
+}
+
 void GrGLBuffer::setMemoryBacking(SkTraceMemoryDump* traceMemoryDump,
                                        const SkString& dumpName) const {
     SkString buffer_id;
@@ -297,6 +358,7 @@ void GrGLBuffer::setMemoryBacking(SkTraceMemoryDump* traceMemoryDump,
 void GrGLBuffer::validate() const {
     SkASSERT(0 != fBufferID || 0 == fGLSizeInBytes);
     SkASSERT(nullptr == fMapPtr || fGLSizeInBytes <= this->size());
+    SkASSERT(nullptr == fPersistentMapPtr || fGLSizeInBytes == this->size());
 }
 
 #endif
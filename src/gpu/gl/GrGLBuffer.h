@@ -52,6 +52,9 @@ private:
     void onUnmap() override;
     bool onUpdateData(const void* src, size_t srcSizeInBytes) override;
 
+    // Records that the flush being recorded writes the persistently mapped storage.
+    void notePersistentWrite();
+
 #ifdef SK_DEBUG
     void validate() const;
 #endif
@@ -61,6 +64,9 @@ private:
     GrGLenum        fUsage;
     size_t          fGLSizeInBytes;
     bool            fHasAttachedToTexture;
+    // Non-null if the buffer has immutable storage that is mapped for its whole life.
+    void*           fPersistentMapPtr;
+    uint64_t        fLastWriteFlushSerial;
 
     typedef GrGpuBuffer INHERITED;
 };
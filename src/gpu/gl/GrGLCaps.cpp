@@ -52,11 +52,13 @@ GrGLCaps::GrGLCaps(const GrContextOptions& contextOptions,
     fBindFragDataLocationSupport = false;
     fRectangleTextureSupport = false;
     fTextureSwizzleSupport = false;
+    fTimerQuerySupport = false;
     fRGBA8888PixelsOpsAreSlow = false;
     fPartialFBOReadIsSlow = false;
     fMipMapLevelAndLodControlSupport = false;
     fRGBAToBGRAReadbackConversionsAreSlow = false;
     fUseBufferDataNullHint = false;
+    fPersistentBufferMappingSupport = false;
     fDoManualMipmapping = false;
     fClearToBoundaryValuesIsBroken = false;
     fClearTextureSupport = false;
@@ -572,6 +574,17 @@ void GrGLCaps::init(const GrContextOptions& contextOptions,
     // Safely moving textures between contexts requires fences.
     fCrossContextTextureSupport = fFenceSyncSupport;
 
+    // GrGLAssembleInterface only finds the query functions for desktop GL. GLES would also need
+    // GL_EXT_disjoint_timer_query's checks for results spoiled by power changes and the like.
+    if (kGL_GrGLStandard == standard &&
+        (version >= GR_GL_VER(3, 3) || ctxInfo.hasExtension("GL_ARB_timer_query") ||
+         ctxInfo.hasExtension("GL_EXT_timer_query"))) {
+        fTimerQuerySupport = gli->fFunctions.fGenQueries && gli->fFunctions.fDeleteQueries &&
+                             gli->fFunctions.fBeginQuery && gli->fFunctions.fEndQuery &&
+                             gli->fFunctions.fGetQueryObjectuiv &&
+                             gli->fFunctions.fGetQueryObjectui64v;
+    }
+
     // Half float vertex attributes requires GL3 or ES3
     // It can also work with OES_VERTEX_HALF_FLOAT, but that requires a different enum.
     if (kGL_GrGLStandard == standard) {
@@ -610,6 +623,17 @@ void GrGLCaps::init(const GrContextOptions& contextOptions,
         this->applyDriverCorrectnessWorkarounds(ctxInfo, contextOptions, shaderCaps);
     }
 
+    // Dynamic vertex and index buffers can be given immutable storage that stays mapped for their
+    // whole lives. Fences tell us when the GPU is done reading what a flush wrote to them.
+    fPersistentBufferMappingSupport = gli->fFunctions.fBufferStorage &&
+                                      kMapBufferRange_MapBufferType == fMapBufferType &&
+                                      fFenceSyncSupport && !kIsWebGL &&
+                                      kChromium_GrGLDriver != ctxInfo.driver();
+    if (fPersistentBufferMappingSupport && contextOptions.fBufferMapThreshold < 0) {
+        // "Mapping" such a buffer is free, so always write vertex data straight into it.
+        fBufferMapThreshold = 0;
+    }
+
     this->applyOptionsOverrides(contextOptions);
     shaderCaps->applyOptionsOverrides(contextOptions);
 
@@ -1161,9 +1185,11 @@ void GrGLCaps::onDumpJSON(SkJSONWriter* writer) const {
     writer->appendBool("Bind uniform location support", fBindUniformLocationSupport);
     writer->appendBool("Rectangle texture support", fRectangleTextureSupport);
     writer->appendBool("Texture swizzle support", fTextureSwizzleSupport);
+    writer->appendBool("Timer query support", fTimerQuerySupport);
     writer->appendBool("BGRA to RGBA readback conversions are slow",
                        fRGBAToBGRAReadbackConversionsAreSlow);
     writer->appendBool("Use buffer data null hint", fUseBufferDataNullHint);
+    writer->appendBool("Persistent buffer mapping support", fPersistentBufferMappingSupport);
 
     writer->appendBool("Intermediate texture for partial updates of unorm textures ever bound to FBOs",
                        fDisallowTexSubImageForUnormConfigTexturesEverBoundToFBO);
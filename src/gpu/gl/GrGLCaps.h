@@ -333,6 +333,9 @@ public:
     /// GL_ARB_texture_swizzle
     bool textureSwizzleSupport() const { return fTextureSwizzleSupport; }
 
+    /// Can GL_TIME_ELAPSED queries time GPU work?
+    bool timerQuerySupport() const { return fTimerQuerySupport; }
+
     bool mipMapLevelAndLodControlSupport() const { return fMipMapLevelAndLodControlSupport; }
 
     bool doManualMipmapping() const { return fDoManualMipmapping; }
@@ -347,6 +350,12 @@ public:
 
     bool useBufferDataNullHint() const { return fUseBufferDataNullHint; }
 
+    /**
+     * Can dynamic vertex and index buffers be allocated with glBufferStorage and kept persistently
+     * (and coherently) mapped?
+     */
+    bool persistentBufferMappingSupport() const { return fPersistentBufferMappingSupport; }
+
     // Certain Intel GPUs on Mac fail to clear if the glClearColor is made up of only 1s and 0s.
     bool clearToBoundaryValuesIsBroken() const { return fClearToBoundaryValuesIsBroken; }
 
@@ -499,9 +508,11 @@ private:
     bool fBindUniformLocationSupport : 1;
     bool fRectangleTextureSupport : 1;
     bool fTextureSwizzleSupport : 1;
+    bool fTimerQuerySupport : 1;
     bool fMipMapLevelAndLodControlSupport : 1;
     bool fRGBAToBGRAReadbackConversionsAreSlow : 1;
     bool fUseBufferDataNullHint                : 1;
+    bool fPersistentBufferMappingSupport : 1;
     bool fClearTextureSupport : 1;
     bool fProgramBinarySupport : 1;
     bool fSamplerObjectSupport : 1;
@@ -836,6 +836,10 @@
 #define GR_GL_MAP_INVALIDATE_BUFFER_BIT          0x0008
 #define GR_GL_MAP_FLUSH_EXPLICIT_BIT             0x0010
 #define GR_GL_MAP_UNSYNCHRONIZED_BIT             0x0020
+#define GR_GL_MAP_PERSISTENT_BIT                 0x0040
+#define GR_GL_MAP_COHERENT_BIT                   0x0080
+#define GR_GL_DYNAMIC_STORAGE_BIT                0x0100
+#define GR_GL_CLIENT_STORAGE_BIT                 0x0200
 
 /* Read Format */
 #define GR_GL_IMPLEMENTATION_COLOR_READ_TYPE   0x8B9A
@@ -28,6 +28,7 @@
 #include "SkHalf.h"
 #include "SkMakeUnique.h"
 #include "SkMipMap.h"
+#include "SkOpts.h"
 #include "SkPixmap.h"
 #include "SkSLCompiler.h"
 #include "SkStrokeRec.h"
@@ -411,6 +412,21 @@ GrGLGpu::GrGLGpu(std::unique_ptr<GrGLContext> ctx, GrContext* context)
     if (this->glCaps().samplerObjectSupport()) {
         fSamplerObjectCache.reset(new SamplerObjectCache(this));
     }
+
+    // Program binaries are only valid for the driver that made them, and a driver update can also
+    // change the workarounds baked into our GLSL.
+    static const GrGLenum kDriverStrings[] = {
+        GR_GL_VENDOR, GR_GL_RENDERER, GR_GL_VERSION, GR_GL_SHADING_LANGUAGE_VERSION
+    };
+    fDriverHash = 0;
+    for (GrGLenum name : kDriverStrings) {
+        const GrGLubyte* str;
+        GL_CALL_RET(str, GetString(name));
+        if (str) {
+            fDriverHash = SkOpts::hash(str, strlen(reinterpret_cast<const char*>(str)),
+                                       fDriverHash);
+        }
+    }
 }
 
 GrGLGpu::~GrGLGpu() {
@@ -449,6 +465,10 @@ GrGLGpu::~GrGLGpu() {
         }
     }
 
+    for (const FlushFence& fence : fFlushFences) {
+        this->deleteSync(fence.fSync);
+    }
+
     delete fProgramCache;
     fSamplerObjectCache.reset();
 }
@@ -482,6 +502,9 @@ void GrGLGpu::disconnect(DisconnectType type) {
         if (fSamplerObjectCache) {
             fSamplerObjectCache->release();
         }
+        for (const FlushFence& fence : fFlushFences) {
+            this->deleteSync(fence.fSync);
+        }
     } else {
         if (fProgramCache) {
             fProgramCache->abandon();
@@ -495,6 +518,10 @@ void GrGLGpu::disconnect(DisconnectType type) {
     delete fProgramCache;
     fProgramCache = nullptr;
 
+    fFlushFences.reset();
+    fCompletedFlushSerial = fCurrentFlushSerial++;
+    fPersistentBufferWritten = false;
+
     fHWProgramID = 0;
     fTempSrcFBOID = 0;
     fTempDstFBOID = 0;
@@ -1193,6 +1220,14 @@ void GrGLGpu::unbindCpuToGpuXferBuffer() {
     }
 }
 
+void GrGLGpu::unbindGpuToCpuXferBuffer() {
+    auto* xferBufferState = this->hwBufferState(GrGpuBufferType::kXferGpuToCpu);
+    if (!xferBufferState->fBoundBufferUniqueID.isInvalid()) {
+        GL_CALL(BindBuffer(xferBufferState->fGLTarget, 0));
+        xferBufferState->invalidate();
+    }
+}
+
 // TODO: Make this take a GrColorType instead of dataConfig. This requires updating GrGLCaps to
 // convert from GrColorType to externalFormat/externalType GLenum values.
 bool GrGLGpu::uploadTexData(GrPixelConfig texConfig, int texWidth, int texHeight, GrGLenum target,
@@ -2076,6 +2111,7 @@ void GrGLGpu::flushProgram(sk_sp<GrGLProgram> program) {
     auto id = program->programID();
     SkASSERT(id);
     GL_CALL(UseProgram(id));
+    this->countProgramBind();
     fHWProgram = std::move(program);
     fHWProgramID = id;
 }
@@ -2088,6 +2124,7 @@ void GrGLGpu::flushProgram(GrGLuint id) {
     }
     fHWProgram.reset();
     GL_CALL(UseProgram(id));
+    this->countProgramBind();
     fHWProgramID = id;
 }
 
@@ -2344,6 +2381,29 @@ bool GrGLGpu::readPixelsSupported(GrSurface* surfaceForConfig, GrPixelConfig rea
 
 bool GrGLGpu::onReadPixels(GrSurface* surface, int left, int top, int width, int height,
                            GrColorType dstColorType, void* buffer, size_t rowBytes) {
+    this->unbindGpuToCpuXferBuffer();
+    return this->readOrTransferPixelsFrom(surface, left, top, width, height, dstColorType, buffer,
+                                          rowBytes);
+}
+
+bool GrGLGpu::onTransferPixelsFrom(GrSurface* surface, int left, int top, int width, int height,
+                                   GrColorType dstColorType, GrGpuBuffer* transferBuffer,
+                                   size_t offset) {
+    SkASSERT(!transferBuffer->isMapped());
+    SkASSERT(!transferBuffer->isCpuBuffer());
+    const GrGLBuffer* glBuffer = static_cast<const GrGLBuffer*>(transferBuffer);
+    this->bindBuffer(GrGpuBufferType::kXferGpuToCpu, glBuffer);
+
+    // With tight row bytes the read never goes through a scratch allocation, so ReadPixels writes
+    // straight to the offset in the bound buffer.
+    size_t rowBytes = GrColorTypeBytesPerPixel(dstColorType) * width;
+    return this->readOrTransferPixelsFrom(surface, left, top, width, height, dstColorType,
+                                          reinterpret_cast<void*>(offset), rowBytes);
+}
+
+bool GrGLGpu::readOrTransferPixelsFrom(GrSurface* surface, int left, int top, int width,
+                                       int height, GrColorType dstColorType, void* buffer,
+                                       size_t rowBytes) {
     SkASSERT(surface);
 
     GrGLRenderTarget* renderTarget = static_cast<GrGLRenderTarget*>(surface->asRenderTarget());
@@ -4276,6 +4336,21 @@ void GrGLGpu::onFinishFlush(GrSurfaceProxy*, SkSurface::BackendSurfaceAccess acc
     }
     if (flags & kSyncCpu_GrFlushFlag) {
         GL_CALL(Finish());
+        // Everything the GPU was asked to do so far, including this flush, is done.
+        for (const FlushFence& fence : fFlushFences) {
+            this->deleteSync(fence.fSync);
+        }
+        fFlushFences.reset();
+        fCompletedFlushSerial = fCurrentFlushSerial++;
+        fPersistentBufferWritten = false;
+    } else if (fPersistentBufferWritten) {
+        GrGLsync sync;
+        GL_CALL_RET(sync, FenceSync(GR_GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+        if (sync) {
+            fFlushFences.push_back({fCurrentFlushSerial, sync});
+            ++fCurrentFlushSerial;
+            fPersistentBufferWritten = false;
+        }
     }
     // TODO: We should have GL actually wait until the GPU has finished work on the GPU.
     if (finishedProc) {
@@ -4283,6 +4358,32 @@ void GrGLGpu::onFinishFlush(GrSurfaceProxy*, SkSurface::BackendSurfaceAccess acc
     }
 }
 
+bool GrGLGpu::isFlushComplete(uint64_t flushSerial) {
+    if (flushSerial <= fCompletedFlushSerial) {
+        return true;
+    }
+    if (flushSerial >= fCurrentFlushSerial) {
+        // The flush hasn't been submitted yet, so the GPU may still read what it wrote.
+        return false;
+    }
+    // Fences signal in order, so stop at the first one that hasn't.
+    int signaled = 0;
+    while (signaled < fFlushFences.count() &&
+           this->waitFence((GrFence)fFlushFences[signaled].fSync, 0)) {
+        fCompletedFlushSerial = fFlushFences[signaled].fFlushSerial;
+        this->deleteSync(fFlushFences[signaled].fSync);
+        ++signaled;
+    }
+    if (signaled) {
+        int remaining = fFlushFences.count() - signaled;
+        for (int i = 0; i < remaining; ++i) {
+            fFlushFences[i] = fFlushFences[i + signaled];
+        }
+        fFlushFences.pop_back_n(signaled);
+    }
+    return flushSerial <= fCompletedFlushSerial;
+}
+
 void GrGLGpu::submit(GrGpuCommandBuffer* buffer) {
     if (buffer->asRTCommandBuffer()) {
         SkASSERT(fCachedRTCommandBuffer.get() == buffer);
@@ -4304,13 +4405,47 @@ GrFence SK_WARN_UNUSED_RESULT GrGLGpu::insertFence() {
 bool GrGLGpu::waitFence(GrFence fence, uint64_t timeout) {
     GrGLenum result;
     GL_CALL_RET(result, ClientWaitSync((GrGLsync)fence, GR_GL_SYNC_FLUSH_COMMANDS_BIT, timeout));
-    return (GR_GL_CONDITION_SATISFIED == result);
+    // A zero timeout poll of a fence that has already signaled reports ALREADY_SIGNALED.
+    return (GR_GL_CONDITION_SATISFIED == result || GR_GL_ALREADY_SIGNALED == result);
 }
 
 void GrGLGpu::deleteFence(GrFence fence) const {
     this->deleteSync((GrGLsync)fence);
 }
 
+GrTimerQuery GrGLGpu::startTimerQuery() {
+    if (!this->glCaps().timerQuerySupport()) {
+        return 0;
+    }
+    GrGLuint query = 0;
+    GL_CALL(GenQueries(1, &query));
+    if (query) {
+        GL_CALL(BeginQuery(GR_GL_TIME_ELAPSED, query));
+    }
+    return query;
+}
+
+void GrGLGpu::endTimerQuery(GrTimerQuery) {
+    GL_CALL(EndQuery(GR_GL_TIME_ELAPSED));
+}
+
+bool GrGLGpu::checkTimerQuery(GrTimerQuery query, uint64_t* nanos) {
+    GrGLuint available = 0;
+    GL_CALL(GetQueryObjectuiv((GrGLuint)query, GR_GL_QUERY_RESULT_AVAILABLE, &available));
+    if (!available) {
+        return false;
+    }
+    GrGLuint64 elapsed = 0;
+    GL_CALL(GetQueryObjectui64v((GrGLuint)query, GR_GL_QUERY_RESULT, &elapsed));
+    *nanos = elapsed;
+    return true;
+}
+
+void GrGLGpu::deleteTimerQuery(GrTimerQuery query) {
+    GrGLuint id = (GrGLuint)query;
+    GL_CALL(DeleteQueries(1, &id));
+}
+
 sk_sp<GrSemaphore> SK_WARN_UNUSED_RESULT GrGLGpu::makeSemaphore(bool isOwned) {
     SkASSERT(this->caps()->fenceSyncSupport());
     return GrGLSemaphore::Make(this, isOwned);
@@ -160,6 +160,11 @@ public:
     bool waitFence(GrFence, uint64_t timeout) override;
     void deleteFence(GrFence) const override;
 
+    GrTimerQuery startTimerQuery() override;
+    void endTimerQuery(GrTimerQuery) override;
+    bool checkTimerQuery(GrTimerQuery, uint64_t* nanos) override;
+    void deleteTimerQuery(GrTimerQuery) override;
+
     sk_sp<GrSemaphore> SK_WARN_UNUSED_RESULT makeSemaphore(bool isOwned) override;
     sk_sp<GrSemaphore> wrapBackendSemaphore(const GrBackendSemaphore& semaphore,
                                             GrResourceProvider::SemaphoreWrapType wrapType,
@@ -171,6 +176,26 @@ public:
 
     void deleteSync(GrGLsync) const;
 
+    /**
+     * Persistently mapped buffers are written directly while a flush prepares, so a buffer can only
+     * be rewritten once the GPU has finished the draws of the last flush that wrote it. Writes are
+     * tagged with the serial of the flush being recorded, and isFlushComplete() polls the fences
+     * inserted at the end of earlier flushes.
+     */
+    uint64_t currentFlushSerial() const { return fCurrentFlushSerial; }
+    void notePersistentBufferWrite() { fPersistentBufferWritten = true; }
+    bool isFlushComplete(uint64_t flushSerial);
+
+    /**
+     * Identifies the driver (vendor, renderer and version strings). Programs stored in the
+     * PersistentCache are tagged with it, and ignored if it changes between runs.
+     */
+    uint32_t driverHash() const { return fDriverHash; }
+
+    bool precompileShader(const SkData& key, const SkData& data) override {
+        return fProgramCache->precompileShader(key, data);
+    }
+
     void insertEventMarker(const char*);
 
     void bindFramebuffer(GrGLenum fboTarget, GrGLuint fboid);
@@ -234,16 +259,28 @@ private:
     bool onReadPixels(GrSurface*, int left, int top, int width, int height, GrColorType,
                       void* buffer, size_t rowBytes) override;
 
+    // Shared by onReadPixels and onTransferPixelsFrom. When a PIXEL_PACK_BUFFER is bound 'buffer'
+    // is an offset into it.
+    bool readOrTransferPixelsFrom(GrSurface*, int left, int top, int width, int height,
+                                  GrColorType, void* buffer, size_t rowBytes);
+
     bool onWritePixels(GrSurface*, int left, int top, int width, int height, GrColorType,
                        const GrMipLevel texels[], int mipLevelCount) override;
 
     bool onTransferPixels(GrTexture*, int left, int top, int width, int height, GrColorType,
                           GrGpuBuffer* transferBuffer, size_t offset, size_t rowBytes) override;
 
+    bool onTransferPixelsFrom(GrSurface*, int left, int top, int width, int height, GrColorType,
+                              GrGpuBuffer* transferBuffer, size_t offset) override;
+
     // Before calling any variation of TexImage, TexSubImage, etc..., call this to ensure that the
     // PIXEL_UNPACK_BUFFER is unbound.
     void unbindCpuToGpuXferBuffer();
 
+    // Before calling ReadPixels into client memory, call this to ensure that the PIXEL_PACK_BUFFER
+    // is unbound.
+    void unbindGpuToCpuXferBuffer();
+
     void onResolveRenderTarget(GrRenderTarget* target) override;
 
     bool onRegenerateMipMapLevels(GrTexture*) override;
@@ -316,6 +353,7 @@ private:
                                 const GrPrimitiveProcessor&,
                                 const GrTextureProxy* const primProcProxies[],
                                 const GrPipeline&, bool hasPointSize);
+        bool precompileShader(const SkData& key, const SkData& data);
 
     private:
         // We may actually have kMaxEntries+1 shaders in the GL context because we create a new
@@ -336,6 +374,12 @@ private:
 
         SkLRUCache<GrProgramDesc, std::unique_ptr<Entry>, DescHash> fMap;
 
+        // The last program found, and the (origin-independent) desc and the origin it was found
+        // for. Consecutive draws often share a program, and this lets them skip the hash lookup.
+        std::unique_ptr<Entry>*     fLastEntry = nullptr;
+        GrProgramDesc               fLastDesc;
+        GrSurfaceOrigin             fLastOrigin;
+
         GrGLGpu*                    fGpu;
 #ifdef PROGRAM_CACHE_STATS
         int                         fTotalRequests;
@@ -659,6 +703,18 @@ private:
     class SamplerObjectCache;
     std::unique_ptr<SamplerObjectCache> fSamplerObjectCache;
 
+    uint32_t fDriverHash;
+
+    struct FlushFence {
+        uint64_t fFlushSerial;
+        GrGLsync fSync;
+    };
+    // Fences of the flushes that wrote persistently mapped buffers, oldest first.
+    SkTArray<FlushFence> fFlushFences;
+    uint64_t             fCurrentFlushSerial = 1;
+    uint64_t             fCompletedFlushSerial = 0;
+    bool                 fPersistentBufferWritten = false;
+
     std::unique_ptr<GrGLGpuRTCommandBuffer>      fCachedRTCommandBuffer;
     std::unique_ptr<GrGLGpuTextureCommandBuffer> fCachedTexCommandBuffer;
 
@@ -25,7 +25,26 @@ typedef GrGLSLProgramDataManager::UniformHandle UniformHandle;
 struct GrGLGpu::ProgramCache::Entry {
     Entry(sk_sp<GrGLProgram> program) : fProgram(std::move(program)) {}
 
+    Entry(GrGLGpu* gpu, const GrGLPrecompiledProgram& precompiledProgram)
+            : fGpu(gpu), fPrecompiledProgram(precompiledProgram) {}
+
+    ~Entry() {
+        // A precompiled program that was never used still belongs to us.
+        if (fPrecompiledProgram.fProgramID) {
+            GR_GL_CALL(fGpu->glInterface(), DeleteProgram(fPrecompiledProgram.fProgramID));
+        }
+    }
+
+    void abandon() {
+        if (fProgram) {
+            fProgram->abandon();
+        }
+        fPrecompiledProgram.fProgramID = 0;
+    }
+
     sk_sp<GrGLProgram> fProgram;
+    GrGLGpu* fGpu = nullptr;
+    GrGLPrecompiledProgram fPrecompiledProgram;
 };
 
 GrGLGpu::ProgramCache::ProgramCache(GrGLGpu* gpu)
@@ -63,9 +82,10 @@ void GrGLGpu::ProgramCache::abandon() {
 #endif
 
     fMap.foreach([](std::unique_ptr<Entry>* e) {
-        (*e)->fProgram->abandon();
+        (*e)->abandon();
     });
     fMap.reset();
+    fLastEntry = nullptr;
 }
 
 GrGLProgram* GrGLGpu::ProgramCache::refProgram(GrGLGpu* gpu,
@@ -85,6 +105,12 @@ GrGLProgram* GrGLGpu::ProgramCache::refProgram(GrGLGpu* gpu,
         GrCapsDebugf(gpu->caps(), "Failed to gl program descriptor!\n");
         return nullptr;
     }
+    if (fLastEntry && origin == fLastOrigin && desc == fLastDesc) {
+        return SkRef((*fLastEntry)->fProgram.get());
+    }
+    fLastEntry = nullptr;
+    fLastDesc = desc;
+
     std::unique_ptr<Entry>* entry = fMap.find(desc);
     if (!entry) {
         // Didn't find an origin-independent version, check with the specific origin
@@ -103,7 +129,45 @@ GrGLProgram* GrGLGpu::ProgramCache::refProgram(GrGLGpu* gpu,
             return nullptr;
         }
         entry = fMap.insert(desc, std::unique_ptr<Entry>(new Entry(sk_sp<GrGLProgram>(program))));
+    } else if (!(*entry)->fProgram) {
+        // The program was precompiled, and just needs building around its GL program. If that
+        // didn't work out, build it from scratch.
+        GrGLPrecompiledProgram precompiledProgram = (*entry)->fPrecompiledProgram;
+        (*entry)->fPrecompiledProgram.fProgramID = 0;
+        (*entry)->fProgram.reset(GrGLProgramBuilder::CreateProgram(renderTarget, origin, primProc,
+                                                                   primProcProxies, pipeline,
+                                                                   &desc, fGpu,
+                                                                   &precompiledProgram));
+        if (!(*entry)->fProgram) {
+            (*entry)->fProgram.reset(GrGLProgramBuilder::CreateProgram(
+                    renderTarget, origin, primProc, primProcProxies, pipeline, &desc, fGpu));
+        }
+        if (!(*entry)->fProgram) {
+            return nullptr;
+        }
     }
 
+    fLastEntry = entry;
+    fLastOrigin = origin;
     return SkRef((*entry)->fProgram.get());
 }
+
+bool GrGLGpu::ProgramCache::precompileShader(const SkData& key, const SkData& data) {
+    GrProgramDesc desc;
+    if (!GrProgramDesc::BuildFromData(&desc, key.data(), key.size())) {
+        return false;
+    }
+    if (fMap.find(desc)) {
+        // Already have it, one way or another.
+        return true;
+    }
+
+    GrGLPrecompiledProgram precompiledProgram;
+    if (!GrGLProgramBuilder::PrecompileProgram(&precompiledProgram, fGpu, data)) {
+        return false;
+    }
+    fMap.insert(desc, std::unique_ptr<Entry>(new Entry(fGpu, precompiledProgram)));
+    // The insert may have evicted the last program.
+    fLastEntry = nullptr;
+    return true;
+}
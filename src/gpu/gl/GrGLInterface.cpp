@@ -219,6 +219,19 @@ bool GrGLInterface::validate() const {
         }
     }
 
+    // glBufferStorage is part of desktop 4.4. There is also an ARB extension, and an EXT one for ES.
+    if (kGL_GrGLStandard == fStandard) {
+        if (glVer >= GR_GL_VER(4,4) || fExtensions.has("GL_ARB_buffer_storage")) {
+            if (!fFunctions.fBufferStorage) {
+                RETURN_FALSE_INTERFACE;
+            }
+        }
+    } else if (fExtensions.has("GL_EXT_buffer_storage")) {
+        if (!fFunctions.fBufferStorage) {
+            RETURN_FALSE_INTERFACE;
+        }
+    }
+
     // glTextureBarrier is part of desktop 4.5. There are also ARB and NV extensions.
     if (kGL_GrGLStandard == fStandard) {
         if (glVer >= GR_GL_VER(4,5) ||
@@ -29,12 +29,41 @@
 #define GL_CALL(X) GR_GL_CALL(this->gpu()->glInterface(), X)
 #define GL_CALL_RET(R, X) GR_GL_CALL_RET(this->gpu()->glInterface(), R, X)
 
+// Everything we store in the PersistentCache starts with this, so that a program stored by a
+// different driver, or in the other format (binary vs. GLSL), is treated as a cache miss rather
+// than handed to GL.
+struct ProgramCacheHeader {
+    uint32_t fFormat;
+    uint32_t fDriverHash;
+};
+
+static ProgramCacheHeader program_cache_header(const GrGLGpu* gpu) {
+    return { gpu->glCaps().programBinarySupport() ? SkSetFourByteTag('b', 'i', 'n', 'y')
+                                                  : SkSetFourByteTag('g', 'l', 's', 'l'),
+             gpu->driverHash() };
+}
+
+static bool read_program_cache_header(const GrGLGpu* gpu, const uint8_t** bytes, size_t* size) {
+    ProgramCacheHeader expected = program_cache_header(gpu), header;
+    if (*size < sizeof(header)) {
+        return false;
+    }
+    memcpy(&header, *bytes, sizeof(header));
+    if (header.fFormat != expected.fFormat || header.fDriverHash != expected.fDriverHash) {
+        return false;
+    }
+    *bytes += sizeof(header);
+    *size -= sizeof(header);
+    return true;
+}
+
 GrGLProgram* GrGLProgramBuilder::CreateProgram(GrRenderTarget* renderTarget, GrSurfaceOrigin origin,
                                                const GrPrimitiveProcessor& primProc,
                                                const GrTextureProxy* const primProcProxies[],
                                                const GrPipeline& pipeline,
                                                GrProgramDesc* desc,
-                                               GrGLGpu* gpu) {
+                                               GrGLGpu* gpu,
+                                               const GrGLPrecompiledProgram* precompiledProgram) {
     SkASSERT(!pipeline.isBad());
 
     ATRACE_ANDROID_FRAMEWORK("Shader Compile");
@@ -46,17 +75,27 @@ GrGLProgram* GrGLProgramBuilder::CreateProgram(GrRenderTarget* renderTarget, GrS
                                pipeline, primProc, primProcProxies, desc);
 
     auto persistentCache = gpu->getContext()->priv().getPersistentCache();
-    if (persistentCache) {
+    if (persistentCache && !precompiledProgram) {
         sk_sp<SkData> key = SkData::MakeWithoutCopy(desc->asKey(), desc->keyLength());
-        builder.fCached = persistentCache->load(*key);
+        if (sk_sp<SkData> cached = persistentCache->load(*key)) {
+            const uint8_t* bytes = cached->bytes();
+            size_t size = cached->size();
+            if (read_program_cache_header(gpu, &bytes, &size)) {
+                builder.fCached = SkData::MakeWithCopy(bytes, size);
+            }
+        }
         // the eventual end goal is to completely skip emitAndInstallProcs on a cache hit, but it's
         // doing necessary setup in addition to generating the SkSL code. Currently we are only able
         // to skip the SkSL->GLSL step on a cache hit.
     }
     if (!builder.emitAndInstallProcs()) {
+        if (precompiledProgram) {
+            GR_GL_CALL(gpu->glInterface(), DeleteProgram(precompiledProgram->fProgramID));
+        }
         return nullptr;
     }
-    return builder.finalize();
+    return precompiledProgram ? builder.finalizePrecompiled(*precompiledProgram)
+                              : builder.finalize();
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -213,6 +252,21 @@ struct GrGLSLCacheEntry {
     size_t fOffset[kGrShaderTypeCount];
 };
 
+// What PrecompileProgram() needs, besides the GLSL, to link a program the way finalize() does. It
+// follows the shaders in GLSL cache data, as uint32_t kPrecompileTag, uint32_t PrecompileFlags, and
+// uint32_t attribute count, then the attributes' NUL-terminated names in location order. It's
+// left out for programs that need more bound than that (uniforms, NVPR varyings).
+static const uint32_t kPrecompileTag = SkSetFourByteTag('p', 'r', 'e', 'c');
+
+enum PrecompileFlags : uint32_t {
+    kCustomColorOutput_PrecompileFlag = 1 << 0,
+    kSecondaryOutput_PrecompileFlag   = 1 << 1,
+};
+
+static void append_uint32(SkSL::String* str, uint32_t value) {
+    str->append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
 void GrGLProgramBuilder::storeShaderInCache(const SkSL::Program::Inputs& inputs, GrGLuint programID,
                                             const GrGLSLSet& glsl) {
     if (!this->gpu()->getContext()->priv().getPersistentCache()) {
@@ -227,9 +281,12 @@ void GrGLProgramBuilder::storeShaderInCache(const SkSL::Program::Inputs& inputs,
             GrGLenum binaryFormat;
             std::unique_ptr<char[]> binary(new char[length]);
             GL_CALL(GetProgramBinary(programID, length, &length, &binaryFormat, binary.get()));
-            size_t dataLength = sizeof(inputs) + sizeof(binaryFormat) + length;
+            ProgramCacheHeader header = program_cache_header(fGpu);
+            size_t dataLength = sizeof(header) + sizeof(inputs) + sizeof(binaryFormat) + length;
             std::unique_ptr<uint8_t[]> data(new uint8_t[dataLength]);
             size_t offset = 0;
+            memcpy(data.get() + offset, &header, sizeof(header));
+            offset += sizeof(header);
             memcpy(data.get() + offset, &inputs, sizeof(inputs));
             offset += sizeof(inputs);
             memcpy(data.get() + offset, &binaryFormat, sizeof(binaryFormat));
@@ -240,9 +297,35 @@ void GrGLProgramBuilder::storeShaderInCache(const SkSL::Program::Inputs& inputs,
         }
     } else {
         // source cache
-        size_t dataLength = sizeof(GrGLSLCacheEntry) + glsl.getCacheSize();
+        SkSL::String precompileInfo;
+        const GrPrimitiveProcessor& primProc = this->primitiveProcessor();
+        if (!primProc.isPathRendering() && !fGpu->glCaps().bindUniformLocationSupport()) {
+            uint32_t flags = 0;
+            if (fFS.hasCustomColorOutput()) {
+                flags |= kCustomColorOutput_PrecompileFlag;
+            }
+            if (fFS.hasSecondaryOutput()) {
+                flags |= kSecondaryOutput_PrecompileFlag;
+            }
+            append_uint32(&precompileInfo, kPrecompileTag);
+            append_uint32(&precompileInfo, flags);
+            append_uint32(&precompileInfo,
+                          primProc.numVertexAttributes() + primProc.numInstanceAttributes());
+            for (const auto& attr : primProc.vertexAttributes()) {
+                precompileInfo.append(attr.name(), strlen(attr.name()) + 1);
+            }
+            for (const auto& attr : primProc.instanceAttributes()) {
+                precompileInfo.append(attr.name(), strlen(attr.name()) + 1);
+            }
+        }
+
+        // The entry's offsets are from its own start, which follows the header.
+        ProgramCacheHeader header = program_cache_header(fGpu);
+        size_t dataLength = sizeof(header) + sizeof(GrGLSLCacheEntry) + glsl.getCacheSize() +
+                            precompileInfo.size();
         std::unique_ptr<uint8_t[]> data(new uint8_t[dataLength]);
-        size_t offset = 0;
+        memcpy(data.get(), &header, sizeof(header));
+        size_t offset = sizeof(header);
         GrGLSLCacheEntry entry(inputs, glsl);
         memcpy(data.get() + offset, &entry, sizeof(entry));
         offset += sizeof(entry);
@@ -252,6 +335,7 @@ void GrGLProgramBuilder::storeShaderInCache(const SkSL::Program::Inputs& inputs,
                 offset += glsl.fGLSL[i].size() + 1;
             }
         }
+        memcpy(data.get() + offset, precompileInfo.data(), precompileInfo.size());
         this->gpu()->getContext()->priv().getPersistentCache()->store(
                                             *key, *SkData::MakeWithoutCopy(data.get(), dataLength));
     }
@@ -451,6 +535,160 @@ GrGLProgram* GrGLProgramBuilder::finalize() {
     return this->createProgram(programID);
 }
 
+GrGLProgram* GrGLProgramBuilder::finalizePrecompiled(const GrGLPrecompiledProgram& precompiled) {
+    TRACE_EVENT0("skia", TRACE_FUNC);
+
+    // PrecompileProgram() didn't wait for the link, so this is where we find out how it went.
+    GrGLuint programID = precompiled.fProgramID;
+    if (!this->checkLinkStatus(programID)) {
+        GL_CALL(DeleteProgram(programID));
+        return nullptr;
+    }
+    this->addInputVars(precompiled.fInputs);
+    this->computeCountsAndStrides(programID, this->primitiveProcessor(), false);
+    this->resolveProgramResourceLocations(programID);
+    return this->createProgram(programID);
+}
+
+bool GrGLProgramBuilder::PrecompileProgram(GrGLPrecompiledProgram* precompiledProgram,
+                                           GrGLGpu* gpu, const SkData& cachedData) {
+    const GrGLInterface* gli = gpu->glInterface();
+    const GrGLCaps& caps = gpu->glCaps();
+    const uint8_t* bytes = cachedData.bytes();
+    size_t size = cachedData.size();
+    if (!read_program_cache_header(gpu, &bytes, &size)) {
+        return false;
+    }
+
+    if (caps.programBinarySupport()) {
+        // The data is a binary, laid out as finalize() reads it.
+        size_t offset = sizeof(SkSL::Program::Inputs) + sizeof(int);
+        if (size <= offset) {
+            return false;
+        }
+        int binaryFormat;
+        memcpy(&precompiledProgram->fInputs, bytes, sizeof(SkSL::Program::Inputs));
+        memcpy(&binaryFormat, bytes + sizeof(SkSL::Program::Inputs), sizeof(binaryFormat));
+
+        GrGLuint programID;
+        GR_GL_CALL_RET(gli, programID, CreateProgram());
+        if (0 == programID) {
+            return false;
+        }
+        GrGLClearErr(gli);
+        GR_GL_CALL_NOERRCHECK(gli, ProgramBinary(programID, binaryFormat,
+                                                 (void*)(bytes + offset), size - offset));
+        if (GR_GL_GET_ERROR(gli) != GR_GL_NO_ERROR) {
+            GR_GL_CALL(gli, DeleteProgram(programID));
+            return false;
+        }
+        precompiledProgram->fProgramID = programID;
+        return true;
+    }
+
+    if (size < sizeof(GrGLSLCacheEntry) || caps.bindUniformLocationSupport()) {
+        return false;
+    }
+    const GrGLSLCacheEntry* entry = (const GrGLSLCacheEntry*)(bytes);
+
+    // Make sure the shaders are all there, and find the precompile info after them.
+    size_t end = sizeof(GrGLSLCacheEntry);
+    auto read_string = [bytes, size](size_t offset) -> const char* {
+        if (offset >= size || !memchr(bytes + offset, '\0', size - offset)) {
+            return nullptr;
+        }
+        return reinterpret_cast<const char*>(bytes + offset);
+    };
+    for (int i = 0; i < kGrShaderTypeCount; ++i) {
+        if (entry->fOffset[i]) {
+            const char* glsl = read_string(entry->fOffset[i]);
+            if (!glsl) {
+                return false;
+            }
+            end = SkTMax(end, entry->fOffset[i] + strlen(glsl) + 1);
+        }
+    }
+    auto read_uint32 = [bytes, size, &end](uint32_t* value) {
+        if (end + sizeof(uint32_t) > size) {
+            return false;
+        }
+        memcpy(value, bytes + end, sizeof(uint32_t));
+        end += sizeof(uint32_t);
+        return true;
+    };
+    uint32_t tag, flags, attributeCount;
+    if (!read_uint32(&tag) || kPrecompileTag != tag ||
+        !read_uint32(&flags) || !read_uint32(&attributeCount)) {
+        return false;
+    }
+    SkSTArray<8, const char*> attributeNames;
+    for (uint32_t i = 0; i < attributeCount; ++i) {
+        const char* name = read_string(end);
+        if (!name) {
+            return false;
+        }
+        attributeNames.push_back(name);
+        end += strlen(name) + 1;
+    }
+
+    GrGLuint programID;
+    GR_GL_CALL_RET(gli, programID, CreateProgram());
+    if (0 == programID) {
+        return false;
+    }
+
+    // Unlike compileAndAttachShaders(), don't ask whether the shaders compiled: that would wait
+    // for the driver. A failure shows up as a failed link when the program is first used.
+    static const GrGLenum kShaderTypes[kGrShaderTypeCount] = {
+        GR_GL_VERTEX_SHADER, GR_GL_GEOMETRY_SHADER, GR_GL_FRAGMENT_SHADER
+    };
+    SkSTArray<kGrShaderTypeCount, GrGLuint> shaderIDs;
+    for (int i = 0; i < kGrShaderTypeCount; ++i) {
+        if (!entry->fOffset[i]) {
+            continue;
+        }
+        GrGLuint shaderID;
+        GR_GL_CALL_RET(gli, shaderID, CreateShader(kShaderTypes[i]));
+        if (0 == shaderID) {
+            for (GrGLuint id : shaderIDs) {
+                GR_GL_CALL(gli, DeleteShader(id));
+            }
+            GR_GL_CALL(gli, DeleteProgram(programID));
+            return false;
+        }
+        const char* glsl = entry->get(i);
+        GrGLint length = SkToInt(strlen(glsl));
+        GR_GL_CALL(gli, ShaderSource(shaderID, 1, &glsl, &length));
+        gpu->stats()->incShaderCompilations();
+        GR_GL_CALL(gli, CompileShader(shaderID));
+        GR_GL_CALL(gli, AttachShader(programID, shaderID));
+        shaderIDs.push_back(shaderID);
+    }
+
+    // Bind what finalize() would have.
+    for (int i = 0; i < attributeNames.count(); ++i) {
+        GR_GL_CALL(gli, BindAttribLocation(programID, i, attributeNames[i]));
+    }
+    if ((flags & kCustomColorOutput_PrecompileFlag) && caps.bindFragDataLocationSupport()) {
+        GR_GL_CALL(gli, BindFragDataLocation(programID, 0,
+                                    GrGLSLFragmentShaderBuilder::DeclaredColorOutputName()));
+    }
+    if ((flags & kSecondaryOutput_PrecompileFlag) &&
+        caps.shaderCaps()->mustDeclareFragmentShaderOutput()) {
+        GR_GL_CALL(gli, BindFragDataLocationIndexed(programID, 0, 1,
+                                  GrGLSLFragmentShaderBuilder::DeclaredSecondaryColorOutputName()));
+    }
+
+    GR_GL_CALL(gli, LinkProgram(programID));
+    for (GrGLuint id : shaderIDs) {
+        GR_GL_CALL(gli, DeleteShader(id));
+    }
+
+    precompiledProgram->fProgramID = programID;
+    precompiledProgram->fInputs = entry->fInputs;
+    return true;
+}
+
 void GrGLProgramBuilder::bindProgramResourceLocations(GrGLuint programID) {
     fUniformHandler.bindUniformLocations(programID, fGpu->glCaps());
 
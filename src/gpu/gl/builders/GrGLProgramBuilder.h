@@ -24,6 +24,12 @@ struct GrGLSLSet;
 class GrGLSLShaderBuilder;
 class GrShaderCaps;
 
+/** A GL program that GrGLProgramBuilder::PrecompileProgram() compiled and linked ahead of time. */
+struct GrGLPrecompiledProgram {
+    GrGLuint fProgramID = 0;
+    SkSL::Program::Inputs fInputs;
+};
+
 class GrGLProgramBuilder : public GrGLSLProgramBuilder {
 public:
     /** Generates a shader program.
@@ -34,6 +40,8 @@ public:
      * This function may modify the GrProgramDesc by setting the surface origin
      * key to 0 (unspecified) if it turns out the program does not care about
      * the surface origin.
+     * If there's a precompiledProgram, its GL program is used rather than one being compiled,
+     * and ownership of it passes to the returned program (or is released on failure).
      * @return true if generation was successful.
      */
     static GrGLProgram* CreateProgram(GrRenderTarget*, GrSurfaceOrigin,
@@ -41,7 +49,16 @@ public:
                                       const GrTextureProxy* const primProcProxies[],
                                       const GrPipeline&,
                                       GrProgramDesc*,
-                                      GrGLGpu*);
+                                      GrGLGpu*,
+                                      const GrGLPrecompiledProgram* = nullptr);
+
+    /**
+     * Compiles and links a GL program from data that was stored in the PersistentCache. Doesn't
+     * wait to see whether that worked; CreateProgram() checks when the program is first used.
+     * Returns false if the data can't be used this way (e.g. it was stored by an older Skia, or
+     * the program's uniforms need bound locations).
+     */
+    static bool PrecompileProgram(GrGLPrecompiledProgram*, GrGLGpu*, const SkData& cachedData);
 
     const GrCaps* caps() const override;
 
@@ -72,6 +89,7 @@ private:
     void storeShaderInCache(const SkSL::Program::Inputs& inputs, GrGLuint programID,
                             const GrGLSLSet& glsl);
     GrGLProgram* finalize();
+    GrGLProgram* finalizePrecompiled(const GrGLPrecompiledProgram&);
     void bindProgramResourceLocations(GrGLuint programID);
     bool checkLinkStatus(GrGLuint programID);
     void resolveProgramResourceLocations(GrGLuint programID);
@@ -95,10 +113,12 @@ private:
     size_t fVertexStride;
     size_t fInstanceStride;
 
-    // shader pulled from cache. Data is organized as:
+    // shader pulled from cache, minus the header identifying the driver. Data is organized as:
     // SkSL::Program::Inputs inputs
     // int binaryFormat
     // (all remaining bytes) char[] binary
+    // or, when binaries aren't supported, as a GrGLSLCacheEntry, the shaders' GLSL, and
+    // (optionally) what PrecompileProgram() needs to bind before linking.
     sk_sp<SkData> fCached;
 
     typedef GrGLSLProgramBuilder INHERITED;
@@ -21,12 +21,14 @@ struct GrGradientBitmapCache::Entry {
 
     void*       fBuffer;
     size_t      fSize;
-    SkBitmap    fBitmap;
+    int         fAtlas;
+    int         fRow;
 
-    Entry(const void* buffer, size_t size, const SkBitmap& bm)
+    Entry(const void* buffer, size_t size, int atlas, int row)
             : fPrev(nullptr),
               fNext(nullptr),
-              fBitmap(bm) {
+              fAtlas(atlas),
+              fRow(row) {
         fBuffer = sk_malloc_throw(size);
         fSize = size;
         memcpy(fBuffer, buffer, size);
@@ -88,15 +90,15 @@ void GrGradientBitmapCache::attachToHead(Entry* entry) const {
     fHead = entry;
 }
 
-bool GrGradientBitmapCache::find(const void* buffer, size_t size, SkBitmap* bm) const {
+bool GrGradientBitmapCache::find(const void* buffer, size_t size, SkBitmap* bm,
+                                 float* rowY) const {
     AutoValidate av(this);
 
     Entry* entry = fHead;
     while (entry) {
         if (entry->equals(buffer, size)) {
-            if (bm) {
-                *bm = entry->fBitmap;
-            }
+            *bm = fAtlases[entry->fAtlas].fBitmap;
+            *rowY = (entry->fRow + 0.5f) / kRowsPerAtlas;
             // move to the head of our list, so we purge it last
             this->release(entry);
             this->attachToHead(entry);
@@ -107,27 +109,76 @@ bool GrGradientBitmapCache::find(const void* buffer, size_t size, SkBitmap* bm)
     return false;
 }
 
-void GrGradientBitmapCache::add(const void* buffer, size_t len, const SkBitmap& bm) {
+GrGradientBitmapCache::Entry* GrGradientBitmapCache::add(const void* buffer, size_t len,
+                                                         SkColorType colorType,
+                                                         SkAlphaType alphaType) {
     AutoValidate av(this);
 
-    if (fEntryCount == fMaxEntries) {
-        SkASSERT(fTail);
-        delete this->release(fTail);
+    auto matches = [&](int atlas) {
+        return fAtlases[atlas].fBitmap.colorType() == colorType &&
+               fAtlases[atlas].fBitmap.alphaType() == alphaType;
+    };
+
+    // Take the next unused row of an atlas of the right kind...
+    int atlas = -1,
+        row   = -1,
+        atlasesOfThisKind = 0;
+    for (int i = 0; i < fAtlases.count(); i++) {
+        if (matches(i)) {
+            atlasesOfThisKind += 1;
+            if (atlas < 0 && fAtlases[i].fRowsUsed < kRowsPerAtlas) {
+                atlas = i;
+                row   = fAtlases[i].fRowsUsed++;
+            }
+        }
+    }
+
+    // ... or start a new atlas if there's room for more of them...
+    if (atlas < 0 && atlasesOfThisKind * kRowsPerAtlas < fMaxEntries) {
+        Atlas& newAtlas = fAtlases.push_back();
+        newAtlas.fBitmap.allocPixels(SkImageInfo::Make(fResolution, kRowsPerAtlas,
+                                                       colorType, alphaType));
+        newAtlas.fBitmap.eraseColor(SK_ColorTRANSPARENT);
+        newAtlas.fRowsUsed = 1;
+        atlas = fAtlases.count() - 1;
+        row   = 0;
+    }
+
+    // ... or take over the row of the least recently used gradient of the same kind.  Rows are
+    // only ever freed this way, so every used row of a full atlas belongs to some entry.
+    if (atlas < 0) {
+        Entry* victim = fTail;
+        while (!matches(victim->fAtlas)) {
+            victim = victim->fPrev;
+        }
+        atlas = victim->fAtlas;
+        row   = victim->fRow;
+        delete this->release(victim);
         fEntryCount -= 1;
     }
 
-    Entry* entry = new Entry(buffer, len, bm);
+    // Anyone who already has the atlas keeps the pixels they've got.
+    SkBitmap& bitmap = fAtlases[atlas].fBitmap;
+    if (bitmap.isImmutable()) {
+        SkBitmap copy;
+        copy.allocPixels(bitmap.info(), bitmap.rowBytes());
+        memcpy(copy.getPixels(), bitmap.getPixels(), bitmap.computeByteSize());
+        bitmap = copy;
+    }
+
+    Entry* entry = new Entry(buffer, len, atlas, row);
     this->attachToHead(entry);
     fEntryCount += 1;
+    return entry;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
 
 void GrGradientBitmapCache::fillGradient(const SkPMColor4f* colors, const SkScalar* positions,
-                                         int count, SkColorType colorType, SkBitmap* bitmap) {
-    SkHalf* pixelsF16 = reinterpret_cast<SkHalf*>(bitmap->getPixels());
-    uint32_t* pixels32 = reinterpret_cast<uint32_t*>(bitmap->getPixels());
+                                         int count, SkColorType colorType, void* row) {
+    SkHalf* pixelsF16 = reinterpret_cast<SkHalf*>(row);
+    uint32_t* pixels32 = reinterpret_cast<uint32_t*>(row);
 
     typedef std::function<void(const Sk4f&, int)> pixelWriteFn_t;
 
@@ -171,7 +222,7 @@ void GrGradientBitmapCache::fillGradient(const SkPMColor4f* colors, const SkScal
 }
 
 void GrGradientBitmapCache::getGradient(const SkPMColor4f* colors, const SkScalar* positions,
-        int count, SkColorType colorType, SkAlphaType alphaType, SkBitmap* bitmap) {
+        int count, SkColorType colorType, SkAlphaType alphaType, SkBitmap* atlas, float* rowY) {
     // build our key: [numColors + colors[] + positions[] + alphaType + colorType ]
     static_assert(sizeof(SkPMColor4f) % sizeof(int32_t) == 0, "");
     const int colorsAsIntCount = count * sizeof(SkPMColor4f) / sizeof(int32_t);
@@ -200,12 +251,13 @@ void GrGradientBitmapCache::getGradient(const SkPMColor4f* colors, const SkScala
     // acquire lock for checking/adding to cache
     SkAutoExclusive ama(fMutex);
     size_t size = keyCount * sizeof(int32_t);
-    if (!this->find(storage.get(), size, bitmap)) {
-        SkImageInfo info = SkImageInfo::Make(fResolution, 1, colorType, alphaType);
-        bitmap->allocPixels(info);
-        GrGradientBitmapCache::fillGradient(colors, positions, count, colorType, bitmap);
-        bitmap->setImmutable();
-        this->add(storage.get(), size, *bitmap);
+    if (!this->find(storage.get(), size, atlas, rowY)) {
+        Entry* entry = this->add(storage.get(), size, colorType, alphaType);
+        SkBitmap& bitmap = fAtlases[entry->fAtlas].fBitmap;
+        this->fillGradient(colors, positions, count, colorType, bitmap.getAddr(0, entry->fRow));
+        bitmap.setImmutable();
+        *atlas = bitmap;
+        *rowY = (entry->fRow + 0.5f) / kRowsPerAtlas;
     }
 }
 
@@ -214,7 +266,7 @@ void GrGradientBitmapCache::getGradient(const SkPMColor4f* colors, const SkScala
 #ifdef SK_DEBUG
 
 void GrGradientBitmapCache::validate() const {
-    SkASSERT(fEntryCount >= 0 && fEntryCount <= fMaxEntries);
+    SkASSERT(fEntryCount >= 0 && fEntryCount <= fAtlases.count() * kRowsPerAtlas);
 
     if (fEntryCount > 0) {
         SkASSERT(nullptr == fHead->fPrev);
@@ -13,16 +13,29 @@
 #include "SkColorData.h"
 #include "SkMutex.h"
 #include "SkNoncopyable.h"
+#include "SkTArray.h"
 
+/**
+ * Rasterizes gradients into rows of atlases shared by every gradient with the same color type and
+ * alpha type, so that textured gradients can share one texture.  Each atlas is immutable once
+ * handed out, so adding a row to one copies it first: gradients drawn earlier keep sampling the
+ * pixels they saw, and the atlas's new generation ID gets it a new texture.
+ */
 class GrGradientBitmapCache : SkNoncopyable {
 public:
+    // The number of gradients kept, for each color type and alpha type, and the width of each.
     GrGradientBitmapCache(int maxEntries, int resolution);
     ~GrGradientBitmapCache();
 
+    // The number of gradients in each atlas; the cache holds maxEntries/kRowsPerAtlas atlases of
+    // each color type and alpha type at most.
+    static constexpr int kRowsPerAtlas = 32;
+
     // Assumes colors are compatible with the specified alphaType (e.g. if it's premul then colors
-    // are already premultiplied). Thread safe.
+    // are already premultiplied).  Returns the atlas the gradient is in, and the vertical texture
+    // coordinate of the center of its row.  Thread safe.
     void getGradient(const SkPMColor4f* colors, const SkScalar* positions, int count,
-                     SkColorType colorType, SkAlphaType alphaType, SkBitmap* bitmap);
+                     SkColorType colorType, SkAlphaType alphaType, SkBitmap* atlas, float* rowY);
 
 private:
     SkMutex fMutex;
@@ -35,14 +48,22 @@ private:
     mutable Entry*  fHead;
     mutable Entry*  fTail;
 
+    struct Atlas {
+        SkBitmap fBitmap;
+        int      fRowsUsed;
+    };
+    SkTArray<Atlas> fAtlases;
+
     inline Entry* release(Entry*) const;
     inline void attachToHead(Entry*) const;
 
-    bool find(const void* buffer, size_t len, SkBitmap*) const;
-    void add(const void* buffer, size_t len, const SkBitmap&);
+    bool find(const void* buffer, size_t len, SkBitmap*, float* rowY) const;
+    // Returns the entry for a new gradient of colorType and alphaType, evicting the least recently
+    // used of theirs if need be.  Its atlas is ready to have its row written.
+    Entry* add(const void* buffer, size_t len, SkColorType colorType, SkAlphaType alphaType);
 
     void fillGradient(const SkPMColor4f* colors, const SkScalar* positions, int count,
-                      SkColorType colorType, SkBitmap* bitmap);
+                      SkColorType colorType, void* row);
 
 #ifdef SK_DEBUG
     void validate() const;
@@ -27,15 +27,35 @@
 #include "GrRecordingContext.h"
 #include "GrRecordingContextPriv.h"
 #include "SkGr.h"
+#include "SkMathPriv.h"
 
 // Intervals smaller than this (that aren't hard stops) on low-precision-only devices force us to
 // use the textured gradient
 static const SkScalar kLowPrecisionIntervalLimit = 0.01f;
 
-// Each cache entry costs 1K or 2K of RAM. Each bitmap will be 1x256 at either 32bpp or 64bpp.
-static const int kMaxNumCachedGradientBitmaps = 32;
+// Each cache entry costs 1K or 2K of RAM, a 256 pixel row at either 32bpp or 64bpp in an atlas
+// shared with other gradients. Charts can easily draw a few hundred distinct gradients.
+static const int kMaxNumCachedGradientBitmaps = 256;
 static const int kGradientTextureSize = 256;
 
+// Rough per-fragment costs, in ALU ops, of an unrolled binary search step (a compare and two
+// selects) and of the textured colorizer's dependent texture fetch.
+static const int kBinarySearchStepCost = 3;
+static const int kTextureFetchCost = 12;
+
+// Estimates whether sampling the gradient atlas is cheaper than searching the gradient's intervals
+// analytically. The search costs a step for each bit of the interval count. Steps count double on
+// devices without 32-bit floats, biasing them toward the texture they already fall back to for
+// close stops. Textured gradients also all share one program and, usually, one atlas texture,
+// while each interval count is its own analytic program.
+static bool prefer_textured_colorizer(int intervalCount, const GrShaderCaps* caps) {
+    int searchCost = SkNextLog2(intervalCount) * kBinarySearchStepCost;
+    if (!caps->floatIs32Bits()) {
+        searchCost *= 2;
+    }
+    return searchCost > kTextureFetchCost;
+}
+
 // NOTE: signature takes raw pointers to the color/pos arrays and a count to make it easy for
 // MakeColorizer to transparently take care of hard stops at the end points of the gradient.
 static std::unique_ptr<GrFragmentProcessor> make_textured_colorizer(const SkPMColor4f* colors,
@@ -51,19 +71,21 @@ static std::unique_ptr<GrFragmentProcessor> make_textured_colorizer(const SkPMCo
     }
     SkAlphaType alphaType = premul ? kPremul_SkAlphaType : kUnpremul_SkAlphaType;
 
-    SkBitmap bitmap;
-    gCache.getGradient(colors, positions, count, colorType, alphaType, &bitmap);
-    SkASSERT(1 == bitmap.height() && SkIsPow2(bitmap.width()));
-    SkASSERT(bitmap.isImmutable());
+    SkBitmap atlas;
+    float row;
+    gCache.getGradient(colors, positions, count, colorType, alphaType, &atlas, &row);
+    SkASSERT(SkIsPow2(atlas.width()));
+    SkASSERT(atlas.isImmutable());
 
+    // The atlas's texture is cached by its generation ID, so every gradient in it shares one.
     sk_sp<GrTextureProxy> proxy = GrMakeCachedBitmapProxy(
-            args.fContext->priv().proxyProvider(), bitmap);
+            args.fContext->priv().proxyProvider(), atlas);
     if (proxy == nullptr) {
         SkDebugf("Gradient won't draw. Could not create texture.");
         return nullptr;
     }
 
-    return GrTextureGradientColorizer::Make(std::move(proxy));
+    return GrTextureGradientColorizer::Make(std::move(proxy), row);
 }
 
 // Analyze the shader's color stops and positions and chooses an appropriate colorizer to represent
@@ -136,10 +158,20 @@ static std::unique_ptr<GrFragmentProcessor> make_colorizer(const SkPMColor4f* co
         // The single and dual intervals are a specialized case of the unrolled binary search
         // colorizer which can analytically render gradients of up to 8 intervals (up to 9 or 16
         // colors depending on how many hard stops are inserted).
-        std::unique_ptr<GrFragmentProcessor> unrolled = GrUnrolledBinaryGradientColorizer::Make(
-                colors + offset, positions + offset, count);
-        if (unrolled) {
-            return unrolled;
+        // Hard stops don't add intervals to search.
+        int intervalCount = 0;
+        for (int i = offset; i < offset + count - 1; i++) {
+            if (!SkScalarNearlyEqual(positions[i], positions[i + 1])) {
+                intervalCount++;
+            }
+        }
+        if (!prefer_textured_colorizer(intervalCount, caps)) {
+            std::unique_ptr<GrFragmentProcessor> unrolled =
+                    GrUnrolledBinaryGradientColorizer::Make(colors + offset, positions + offset,
+                                                            count);
+            if (unrolled) {
+                return unrolled;
+            }
         }
     }
 
@@ -22,16 +22,31 @@ public:
         GrGLSLFPFragmentBuilder* fragBuilder = args.fFragBuilder;
         const GrTextureGradientColorizer& _outer = args.fFp.cast<GrTextureGradientColorizer>();
         (void)_outer;
+        auto row = _outer.row();
+        (void)row;
+        fRowVar = args.fUniformHandler->addUniform(kFragment_GrShaderFlag, kFloat_GrSLType, "row");
         fragBuilder->codeAppendf(
-                "half2 coord = half2(%s.x, 0.5);\n%s = texture(%s, float2(coord)).%s;\n",
-                args.fInputColor, args.fOutputColor,
+                "float2 coord = float2(float(%s.x), %s);\n%s = texture(%s, coord).%s;\n",
+                args.fInputColor, args.fUniformHandler->getUniformCStr(fRowVar),
+                args.fOutputColor,
                 fragBuilder->getProgramBuilder()->samplerVariable(args.fTexSamplers[0]).c_str(),
                 fragBuilder->getProgramBuilder()->samplerSwizzle(args.fTexSamplers[0]).c_str());
     }
 
 private:
     void onSetData(const GrGLSLProgramDataManager& pdman,
-                   const GrFragmentProcessor& _proc) override {}
+                   const GrFragmentProcessor& _proc) override {
+        const GrTextureGradientColorizer& _outer = _proc.cast<GrTextureGradientColorizer>();
+        {
+            float rowValue = _outer.row();
+            if (fRowPrev != rowValue) {
+                fRowPrev = rowValue;
+                pdman.set1f(fRowVar, rowValue);
+            }
+        }
+    }
+    float fRowPrev = SK_FloatNaN;
+    UniformHandle fRowVar;
 };
 GrGLSLFragmentProcessor* GrTextureGradientColorizer::onCreateGLSLInstance() const {
     return new GrGLSLTextureGradientColorizer();
@@ -42,11 +57,13 @@ bool GrTextureGradientColorizer::onIsEqual(const GrFragmentProcessor& other) con
     const GrTextureGradientColorizer& that = other.cast<GrTextureGradientColorizer>();
     (void)that;
     if (fGradient != that.fGradient) return false;
+    if (fRow != that.fRow) return false;
     return true;
 }
 GrTextureGradientColorizer::GrTextureGradientColorizer(const GrTextureGradientColorizer& src)
         : INHERITED(kGrTextureGradientColorizer_ClassID, src.optimizationFlags())
-        , fGradient(src.fGradient) {
+        , fGradient(src.fGradient)
+        , fRow(src.fRow) {
     this->setTextureSamplerCnt(1);
 }
 std::unique_ptr<GrFragmentProcessor> GrTextureGradientColorizer::clone() const {
@@ -5,14 +5,17 @@
  * found in the LICENSE file.
  */
 
-// Should have height = 1px, horizontal axis represents t = 0 to 1
+// A GrGradientBitmapCache atlas, whose horizontal axis represents t = 0 to 1
 in uniform sampler2D gradient;
 
+// The vertical texture coordinate of the center of the gradient's row
+layout(tracked) in uniform float row;
+
 @samplerParams(gradient) {
     GrSamplerState::ClampBilerp()
 }
 
 void main() {
-    half2 coord = half2(sk_InColor.x, 0.5);
+    float2 coord = float2(sk_InColor.x, row);
     sk_OutColor = texture(gradient, coord);
 }
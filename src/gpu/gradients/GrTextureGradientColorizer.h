@@ -15,17 +15,19 @@
 #include "GrCoordTransform.h"
 class GrTextureGradientColorizer : public GrFragmentProcessor {
 public:
-    static std::unique_ptr<GrFragmentProcessor> Make(sk_sp<GrTextureProxy> gradient) {
-        return std::unique_ptr<GrFragmentProcessor>(new GrTextureGradientColorizer(gradient));
+    float row() const { return fRow; }
+    static std::unique_ptr<GrFragmentProcessor> Make(sk_sp<GrTextureProxy> gradient, float row) {
+        return std::unique_ptr<GrFragmentProcessor>(new GrTextureGradientColorizer(gradient, row));
     }
     GrTextureGradientColorizer(const GrTextureGradientColorizer& src);
     std::unique_ptr<GrFragmentProcessor> clone() const override;
     const char* name() const override { return "TextureGradientColorizer"; }
 
 private:
-    GrTextureGradientColorizer(sk_sp<GrTextureProxy> gradient)
+    GrTextureGradientColorizer(sk_sp<GrTextureProxy> gradient, float row)
             : INHERITED(kGrTextureGradientColorizer_ClassID, kNone_OptimizationFlags)
-            , fGradient(std::move(gradient), GrSamplerState::ClampBilerp()) {
+            , fGradient(std::move(gradient), GrSamplerState::ClampBilerp())
+            , fRow(row) {
         this->setTextureSamplerCnt(1);
     }
     GrGLSLFragmentProcessor* onCreateGLSLInstance() const override;
@@ -34,6 +36,7 @@ private:
     const TextureSampler& onTextureSampler(int) const override;
     GR_DECLARE_FRAGMENT_PROCESSOR_TEST
     TextureSampler fGradient;
+    float fRow;
     typedef GrFragmentProcessor INHERITED;
 };
 #endif
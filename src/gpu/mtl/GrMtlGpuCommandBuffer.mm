@@ -55,14 +55,9 @@ GrMtlGpuRTCommandBuffer::GrMtlGpuRTCommandBuffer(
             fRenderPassDesc.stencilAttachment.loadAction = MTLLoadActionDontCare;
             break;
     }
-    switch (stencilInfo.fStoreOp) {
-        case GrStoreOp::kStore:
-            fRenderPassDesc.stencilAttachment.storeAction = MTLStoreActionStore;
-            break;
-        case GrStoreOp::kDiscard:
-            fRenderPassDesc.stencilAttachment.storeAction = MTLStoreActionDontCare;
-            break;
-    }
+    // Each draw currently gets a render pass (encoder) of its own, and each has to pass the stencil
+    // on to the next. So stencilInfo.fStoreOp can't be honored until the draws share a pass.
+    fRenderPassDesc.stencilAttachment.storeAction = MTLStoreActionStore;
 }
 
 GrMtlGpuRTCommandBuffer::~GrMtlGpuRTCommandBuffer() {
@@ -153,6 +148,7 @@ void GrMtlGpuRTCommandBuffer::onDraw(const GrPrimitiveProcessor& primProc,
     [fActiveRenderCmdEncoder setFrontFacingWinding:MTLWindingCounterClockwise];
 
     [fActiveRenderCmdEncoder setRenderPipelineState:pipelineState->mtlPipelineState()];
+    fGpu->countProgramBind();
     pipelineState->bind(fActiveRenderCmdEncoder);
     pipelineState->setBlendConstants(fActiveRenderCmdEncoder, fRenderTarget->config(),
                                      pipeline.getXferProcessor());
@@ -171,6 +167,7 @@ void GrMtlGpuRTCommandBuffer::onDraw(const GrPrimitiveProcessor& primProc,
             }
 
             [fActiveRenderCmdEncoder setRenderPipelineState:pipelineState->mtlPipelineState()];
+            fGpu->countProgramBind();
             pipelineState->bind(fActiveRenderCmdEncoder);
             pipelineState->setBlendConstants(fActiveRenderCmdEncoder, fRenderTarget->config(),
                                              pipeline.getXferProcessor());
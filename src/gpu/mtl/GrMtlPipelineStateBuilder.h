@@ -86,7 +86,23 @@ private:
     id<MTLLibrary> createMtlShaderLibrary(const GrGLSLShaderBuilder& builder,
                                           SkSL::Program::Kind kind,
                                           const SkSL::Program::Settings& settings,
-                                          GrProgramDesc* desc);
+                                          GrProgramDesc* desc,
+                                          SkSL::String* outMSL,
+                                          SkSL::Program::Inputs* outInputs);
+
+    id<MTLLibrary> installMtlShaderLibrary(const SkSL::String& msl,
+                                           const SkSL::Program::Inputs& inputs);
+
+    // Creates the vertex and fragment libraries from MSL that a previous run stored in the
+    // persistent cache, skipping SkSL entirely.
+    void loadShadersFromCache(const SkData& cached,
+                              id<MTLLibrary>* outVertexLibrary,
+                              id<MTLLibrary>* outFragmentLibrary);
+
+    void storeShadersInCache(const SkSL::String& vert,
+                             const SkSL::Program::Inputs& vertInputs,
+                             const SkSL::String& frag,
+                             const SkSL::Program::Inputs& fragInputs);
 
     GrGLSLUniformHandler* uniformHandler() override { return &fUniformHandler; }
     const GrGLSLUniformHandler* uniformHandler() const override { return &fUniformHandler; }
@@ -18,6 +18,8 @@
 
 #import <simd/simd.h>
 
+typedef size_t shader_size;
+
 GrMtlPipelineState* GrMtlPipelineStateBuilder::CreatePipelineState(
         GrMtlGpu* gpu,
         GrRenderTarget* renderTarget, GrSurfaceOrigin origin,
@@ -63,7 +65,9 @@ id<MTLLibrary> GrMtlPipelineStateBuilder::createMtlShaderLibrary(
         const GrGLSLShaderBuilder& builder,
         SkSL::Program::Kind kind,
         const SkSL::Program::Settings& settings,
-        GrProgramDesc* desc) {
+        GrProgramDesc* desc,
+        SkSL::String* outMSL,
+        SkSL::Program::Inputs* outInputs) {
     SkString shaderString;
     for (int i = 0; i < builder.fCompilerStrings.count(); ++i) {
         if (builder.fCompilerStrings[i]) {
@@ -72,21 +76,104 @@ id<MTLLibrary> GrMtlPipelineStateBuilder::createMtlShaderLibrary(
         }
     }
 
-    SkSL::Program::Inputs inputs;
-    id<MTLLibrary> shaderLibrary = GrCompileMtlShaderLibrary(fGpu, shaderString.c_str(),
-                                                             kind, settings, &inputs);
+    if (!GrSkSLToMSL(fGpu, shaderString.c_str(), kind, settings, outMSL, outInputs)) {
+        return nil;
+    }
+    id<MTLLibrary> shaderLibrary = this->installMtlShaderLibrary(*outMSL, *outInputs);
+    if (shaderLibrary == nil) {
+        return nil;
+    }
+    if (outInputs->fFlipY) {
+        desc->setSurfaceOriginKey(GrGLSLFragmentShaderBuilder::KeyForSurfaceOrigin(this->origin()));
+    }
+    return shaderLibrary;
+}
+
+id<MTLLibrary> GrMtlPipelineStateBuilder::installMtlShaderLibrary(
+        const SkSL::String& msl,
+        const SkSL::Program::Inputs& inputs) {
+    id<MTLLibrary> shaderLibrary = GrCompileMtlShaderLibrary(fGpu, msl);
     if (shaderLibrary == nil) {
         return nil;
     }
     if (inputs.fRTHeight) {
         this->addRTHeightUniform(SKSL_RTHEIGHT_NAME);
     }
-    if (inputs.fFlipY) {
-        desc->setSurfaceOriginKey(GrGLSLFragmentShaderBuilder::KeyForSurfaceOrigin(this->origin()));
-    }
     return shaderLibrary;
 }
 
+void GrMtlPipelineStateBuilder::loadShadersFromCache(const SkData& cached,
+                                                     id<MTLLibrary>* outVertexLibrary,
+                                                     id<MTLLibrary>* outFragmentLibrary) {
+    // format for shader cache entries is:
+    //     shader_size vertSize;
+    //     char[vertSize] vert;
+    //     SkSL::Program::Inputs vertInputs;
+    //     shader_size fragSize;
+    //     char[fragSize] frag;
+    //     SkSL::Program::Inputs fragInputs;
+    size_t offset = 0;
+
+    // vertex shader
+    shader_size vertSize = *((shader_size*) ((char*) cached.data() + offset));
+    offset += sizeof(shader_size);
+    SkSL::String vert((char*) cached.data() + offset, vertSize);
+    offset += vertSize;
+    SkSL::Program::Inputs vertInputs;
+    memcpy(&vertInputs, (char*) cached.data() + offset, sizeof(vertInputs));
+    offset += sizeof(vertInputs);
+
+    // fragment shader
+    shader_size fragSize = *((shader_size*) ((char*) cached.data() + offset));
+    offset += sizeof(shader_size);
+    SkSL::String frag((char*) cached.data() + offset, fragSize);
+    offset += fragSize;
+    SkSL::Program::Inputs fragInputs;
+    memcpy(&fragInputs, (char*) cached.data() + offset, sizeof(fragInputs));
+    offset += sizeof(fragInputs);
+
+    SkASSERT(offset == cached.size());
+
+    *outVertexLibrary = this->installMtlShaderLibrary(vert, vertInputs);
+    *outFragmentLibrary = this->installMtlShaderLibrary(frag, fragInputs);
+}
+
+void GrMtlPipelineStateBuilder::storeShadersInCache(const SkSL::String& vert,
+                                                    const SkSL::Program::Inputs& vertInputs,
+                                                    const SkSL::String& frag,
+                                                    const SkSL::Program::Inputs& fragInputs) {
+    Desc* desc = static_cast<Desc*>(this->desc());
+
+    // see loadShadersFromCache for the layout of cache entries
+    sk_sp<SkData> key = SkData::MakeWithoutCopy(desc->asKey(), desc->shaderKeyLength());
+    size_t dataLength = (sizeof(shader_size) + sizeof(SkSL::Program::Inputs)) * 2 + vert.length() +
+                        frag.length();
+    std::unique_ptr<uint8_t[]> data(new uint8_t[dataLength]);
+    size_t offset = 0;
+
+    // vertex shader
+    *((shader_size*) (data.get() + offset)) = (shader_size) vert.length();
+    offset += sizeof(shader_size);
+    memcpy(data.get() + offset, vert.data(), vert.length());
+    offset += vert.length();
+    memcpy(data.get() + offset, &vertInputs, sizeof(vertInputs));
+    offset += sizeof(vertInputs);
+
+    // fragment shader
+    *((shader_size*) (data.get() + offset)) = (shader_size) frag.length();
+    offset += sizeof(shader_size);
+    memcpy(data.get() + offset, frag.data(), frag.length());
+    offset += frag.length();
+    memcpy(data.get() + offset, &fragInputs, sizeof(fragInputs));
+    offset += sizeof(fragInputs);
+
+    SkASSERT(offset == dataLength);
+
+    fGpu->getContext()->priv().getPersistentCache()->store(
+                                                  *key,
+                                                  *SkData::MakeWithoutCopy(data.get(), dataLength));
+}
+
 static inline MTLVertexFormat attribute_type_to_mtlformat(GrVertexAttribType type) {
     // All half types will actually be float types. We are currently not using half types with
     // metal to avoid an issue with narrow type coercions (float->half) http://skbug.com/8221
@@ -336,17 +423,37 @@ GrMtlPipelineState* GrMtlPipelineStateBuilder::finalize(GrRenderTarget* renderTa
     settings.fSharpenTextures = fGpu->getContext()->priv().options().fSharpenMipmappedTextures;
     SkASSERT(!this->fragColorIsInOut());
 
-    // TODO: Store shaders in cache
     id<MTLLibrary> vertexLibrary = nil;
     id<MTLLibrary> fragmentLibrary = nil;
-    vertexLibrary = this->createMtlShaderLibrary(fVS,
-                                                 SkSL::Program::kVertex_Kind,
-                                                 settings,
-                                                 desc);
-    fragmentLibrary = this->createMtlShaderLibrary(fFS,
-                                                   SkSL::Program::kFragment_Kind,
-                                                   settings,
-                                                   desc);
+    sk_sp<SkData> cached;
+    auto persistentCache = fGpu->getContext()->priv().getPersistentCache();
+    if (persistentCache) {
+        sk_sp<SkData> key = SkData::MakeWithoutCopy(desc->asKey(), desc->shaderKeyLength());
+        cached = persistentCache->load(*key);
+    }
+    if (cached) {
+        this->loadShadersFromCache(*cached, &vertexLibrary, &fragmentLibrary);
+    } else {
+        SkSL::String vert;
+        SkSL::Program::Inputs vertInputs;
+        SkSL::String frag;
+        SkSL::Program::Inputs fragInputs;
+        vertexLibrary = this->createMtlShaderLibrary(fVS,
+                                                     SkSL::Program::kVertex_Kind,
+                                                     settings,
+                                                     desc,
+                                                     &vert,
+                                                     &vertInputs);
+        fragmentLibrary = this->createMtlShaderLibrary(fFS,
+                                                       SkSL::Program::kFragment_Kind,
+                                                       settings,
+                                                       desc,
+                                                       &frag,
+                                                       &fragInputs);
+        if (persistentCache && vertexLibrary && fragmentLibrary) {
+            this->storeShadersInCache(vert, vertInputs, frag, fragInputs);
+        }
+    }
     SkASSERT(!this->primitiveProcessor().willUseGeoShader());
 
     SkASSERT(vertexLibrary);
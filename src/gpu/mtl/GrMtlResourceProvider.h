@@ -66,6 +66,13 @@ private:
 
         SkLRUCache<const GrMtlPipelineStateBuilder::Desc, std::unique_ptr<Entry>, DescHash> fMap;
 
+        // The last pipeline state found, and the (origin-independent) desc and the origin it was
+        // found for. Consecutive draws often share a pipeline state, and this lets them skip the
+        // hash lookup.
+        std::unique_ptr<Entry>*           fLastEntry = nullptr;
+        GrMtlPipelineStateBuilder::Desc   fLastDesc;
+        GrSurfaceOrigin                   fLastOrigin;
+
         GrMtlGpu*                    fGpu;
 
 #ifdef GR_PIPELINE_STATE_CACHE_STATS
@@ -104,6 +104,11 @@ GrMtlPipelineState* GrMtlResourceProvider::PipelineStateCache::refPipelineState(
         GrCapsDebugf(fGpu->caps(), "Failed to build mtl program descriptor!\n");
         return nullptr;
     }
+    if (fLastEntry && origin == fLastOrigin && desc == fLastDesc) {
+        return (*fLastEntry)->fPipelineState.get();
+    }
+    fLastEntry = nullptr;
+    fLastDesc = desc;
 
     std::unique_ptr<Entry>* entry = fMap.find(desc);
     if (!entry) {
@@ -121,7 +126,8 @@ GrMtlPipelineState* GrMtlResourceProvider::PipelineStateCache::refPipelineState(
             return nullptr;
         }
         entry = fMap.insert(desc, std::unique_ptr<Entry>(new Entry(fGpu, pipelineState)));
-        return (*entry)->fPipelineState.get();
     }
+    fLastEntry = entry;
+    fLastOrigin = origin;
     return (*entry)->fPipelineState.get();
 }
@@ -147,11 +147,12 @@ void print_msl(const char* source) {
 }
 #endif
 
-id<MTLLibrary> GrCompileMtlShaderLibrary(const GrMtlGpu* gpu,
-                                         const char* shaderString,
-                                         SkSL::Program::Kind kind,
-                                         const SkSL::Program::Settings& settings,
-                                         SkSL::Program::Inputs* outInputs) {
+bool GrSkSLToMSL(const GrMtlGpu* gpu,
+                 const char* shaderString,
+                 SkSL::Program::Kind kind,
+                 const SkSL::Program::Settings& settings,
+                 SkSL::String* outMSL,
+                 SkSL::Program::Inputs* outInputs) {
     std::unique_ptr<SkSL::Program> program =
             gpu->shaderCompiler()->convertProgram(kind,
                                                   SkSL::String(shaderString),
@@ -160,16 +161,20 @@ id<MTLLibrary> GrCompileMtlShaderLibrary(const GrMtlGpu* gpu,
     if (!program) {
         SkDebugf("SkSL error:\n%s\n", gpu->shaderCompiler()->errorText().c_str());
         SkASSERT(false);
+        return false;
     }
 
     *outInputs = program->fInputs;
-    SkSL::String code;
-    if (!gpu->shaderCompiler()->toMetal(*program, &code)) {
+    if (!gpu->shaderCompiler()->toMetal(*program, outMSL)) {
         SkDebugf("%s\n", gpu->shaderCompiler()->errorText().c_str());
         SkASSERT(false);
-        return nil;
+        return false;
     }
-    NSString* mtlCode = [[NSString alloc] initWithCString: code.c_str()
+    return true;
+}
+
+id<MTLLibrary> GrCompileMtlShaderLibrary(const GrMtlGpu* gpu, const SkSL::String& msl) {
+    NSString* mtlCode = [[NSString alloc] initWithCString: msl.c_str()
                                                  encoding: NSASCIIStringEncoding];
 #if PRINT_MSL
     print_msl([mtlCode cStringUsingEncoding: NSASCIIStringEncoding]);
@@ -188,6 +193,18 @@ id<MTLLibrary> GrCompileMtlShaderLibrary(const GrMtlGpu* gpu,
     return compiledLibrary;
 }
 
+id<MTLLibrary> GrCompileMtlShaderLibrary(const GrMtlGpu* gpu,
+                                         const char* shaderString,
+                                         SkSL::Program::Kind kind,
+                                         const SkSL::Program::Settings& settings,
+                                         SkSL::Program::Inputs* outInputs) {
+    SkSL::String msl;
+    if (!GrSkSLToMSL(gpu, shaderString, kind, settings, &msl, outInputs)) {
+        return nil;
+    }
+    return GrCompileMtlShaderLibrary(gpu, msl);
+}
+
 id<MTLTexture> GrGetMTLTextureFromSurface(GrSurface* surface, bool doResolve) {
     id<MTLTexture> mtlTexture = nil;
 
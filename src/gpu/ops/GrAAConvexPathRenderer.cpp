@@ -690,6 +690,8 @@ public:
 
     const char* name() const override { return "AAConvexPathOp"; }
 
+    bool canPrepareConcurrently() const override { return true; }
+
     void visitProxies(const VisitProxyFunc& func, VisitorType) const override {
         fHelper.visitProxies(func);
     }
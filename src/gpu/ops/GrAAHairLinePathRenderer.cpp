@@ -26,6 +26,11 @@
 #include "SkStroke.h"
 #include "SkTemplates.h"
 #include "effects/GrBezierEffect.h"
+#include "glsl/GrGLSLFragmentShaderBuilder.h"
+#include "glsl/GrGLSLGeometryProcessor.h"
+#include "glsl/GrGLSLUniformHandler.h"
+#include "glsl/GrGLSLVarying.h"
+#include "glsl/GrGLSLVertexGeoBuilder.h"
 #include "ops/GrMeshDrawOp.h"
 
 #define PREALLOC_PTARRAY(N) SkSTArray<(N),SkPoint, true>
@@ -711,6 +716,214 @@ static void add_line(const SkPoint p[2],
 
 ///////////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+// Draws device-space hairline segments as instances, expanding each one in the vertex shader
+// the same way add_line() and bloat_quad()/set_uv_quad() do on the CPU. Lines are instances of
+// their two end points; quads are instances of their three (already subdivided) control points.
+class InstancedHairlineGP : public GrGeometryProcessor {
+public:
+    enum class Type {
+        kLines,
+        kQuads
+    };
+
+    static sk_sp<GrGeometryProcessor> Make(Type type, const SkPMColor4f& color, uint8_t coverage,
+                                           const SkMatrix& localMatrix, bool usesLocalCoords) {
+        return sk_sp<GrGeometryProcessor>(
+                new InstancedHairlineGP(type, color, coverage, localMatrix, usesLocalCoords));
+    }
+
+    // Each line vertex is at an end point (x = 0 or 1), pushed along the line (y) and across it
+    // (z) by half a pixel and a pixel, with coverage w. These match add_line()'s vertices.
+    static constexpr float kLineVertexData[kLineSegNumVertices][4] = {
+            {0, +1,  0, 1},
+            {1, -1,  0, 1},
+            {0, -1, +1, 0},
+            {1, +1, +1, 0},
+            {0, -1, -1, 0},
+            {1, +1, -1, 0}};
+
+    // Each quad vertex is a0, a1, b0, c0 or c1 from bloat_quad(): its first three components
+    // select a, c or the intersection of the outset edges, and the last offsets along the normal.
+    static constexpr float kQuadVertexData[kQuadNumVertices][4] = {
+            {1, 0, 0, +1},
+            {1, 0, 0, -1},
+            {0, 0, 1,  0},
+            {0, 1, 0, +1},
+            {0, 1, 0, -1}};
+
+    const char* name() const override { return "InstancedHairlineGP"; }
+
+    void getGLSLProcessorKey(const GrShaderCaps&, GrProcessorKeyBuilder* b) const override {
+        uint32_t key = static_cast<uint32_t>(fType);
+        key |= fUsesLocalCoords && fLocalMatrix.hasPerspective() ? 0x2 : 0x0;
+        b->add32(key);
+    }
+
+    GrGLSLPrimitiveProcessor* createGLSLInstance(const GrShaderCaps& caps) const override {
+        class GLSLProcessor : public GrGLSLGeometryProcessor {
+        public:
+            void setData(const GrGLSLProgramDataManager& pdman, const GrPrimitiveProcessor& proc,
+                         FPCoordTransformIter&& transformIter) override {
+                const auto& hairlineGP = proc.cast<InstancedHairlineGP>();
+                if (hairlineGP.fColor != fColor) {
+                    pdman.set4fv(fColorUniform, 1, hairlineGP.fColor.vec());
+                    fColor = hairlineGP.fColor;
+                }
+                if (hairlineGP.fCoverage != fCoverage) {
+                    pdman.set1f(fCoverageUniform, GrNormalizeByteToFloat(hairlineGP.fCoverage));
+                    fCoverage = hairlineGP.fCoverage;
+                }
+                this->setTransformDataHelper(hairlineGP.fLocalMatrix, pdman, &transformIter);
+            }
+
+        private:
+            void onEmitCode(EmitArgs& args, GrGPArgs* gpArgs) override {
+                const auto& hairlineGP = args.fGP.cast<InstancedHairlineGP>();
+                GrGLSLVaryingHandler* varyings = args.fVaryingHandler;
+                varyings->emitAttributes(hairlineGP);
+
+                GrGLSLVertexBuilder* v = args.fVertBuilder;
+                GrGLSLVarying coord(kFloat2_GrSLType);
+                varyings->addVarying("hairlineCoord", &coord);
+                if (Type::kLines == hairlineGP.fType) {
+                    v->codeAppend("float2 vec = p1 - p0;");
+                    v->codeAppend("float lengthSqd = dot(vec, vec);");
+                    v->codeAppend("float2 along = lengthSqd > 0 ? vec * (.5 * inversesqrt("
+                                                                "lengthSqd)) : float2(0);");
+                    v->codeAppend("float2 ortho = float2(2 * along.y, -2 * along.x);");
+                    v->codeAppend("float t = corner.x, alongSign = corner.y;");
+                    v->codeAppend("float coverage = corner.w;");
+                    // Lines shorter than a pixel swap their inner vertices and scale coverage by
+                    // their length.
+                    v->codeAppend("if (lengthSqd < 1 && 0 == corner.z) {");
+                    v->codeAppend(    "t = 1 - t;");
+                    v->codeAppend(    "alongSign = -alongSign;");
+                    v->codeAppend(    "coverage *= sqrt(lengthSqd);");
+                    v->codeAppend("}");
+                    v->codeAppend("float2 position = (0 == t ? p0 : p1) + alongSign * along + "
+                                                    "corner.z * ortho;");
+                    v->codeAppendf("%s = float2(coverage, 0);", coord.vsOut());
+                } else {
+                    v->codeAppend("float2 ab = normalize(p1 - p0);");
+                    v->codeAppend("float2 cb = normalize(p1 - p2);");
+                    v->codeAppend("float2 ac = p2 - p0;");
+                    v->codeAppend("float2 abN = float2(ab.y, -ab.x);");
+                    v->codeAppend("if (dot(abN, ac) > 0) { abN = -abN; }");
+                    v->codeAppend("float2 cbN = float2(cb.y, -cb.x);");
+                    v->codeAppend("if (dot(cbN, ac) < 0) { cbN = -cbN; }");
+                    v->codeAppend("float2 position;");
+                    v->codeAppend("if (0 != corner.z) {");
+                                      // Intersect the edges a0->b0 and c0->b0.
+                    v->codeAppend(    "float2 a0 = p0 + abN, c0 = p2 + cbN;");
+                    v->codeAppend(    "float lineAW = -dot(abN, a0), lineBW = -dot(cbN, c0);");
+                    v->codeAppend(    "float w = abN.x * cbN.y - abN.y * cbN.x;");
+                    v->codeAppend(    "if (0 == w) {");
+                                          // The edges are parallel; pick the point in between.
+                    v->codeAppend(        "position = (a0 + c0) * .5 + abN;");
+                    v->codeAppend(    "} else {");
+                    v->codeAppend(        "position = float2(abN.y * lineBW - lineAW * cbN.y, "
+                                                            "lineAW * cbN.x - abN.x * lineBW) / w;");
+                    v->codeAppend(    "}");
+                    v->codeAppend("} else {");
+                    v->codeAppend(    "position = 0 != corner.x ? p0 + corner.w * abN "
+                                                               ": p2 + corner.w * cbN;");
+                    v->codeAppend("}");
+                    // Map the control points to the canonical parabola's (0,0), (.5,0), (1,1).
+                    v->codeAppend("float2x2 pointsToBarycentric = inverse(float2x2(p1 - p0, ac));");
+                    v->codeAppend("float2 st = pointsToBarycentric * (position - p0);");
+                    v->codeAppendf("%s = float2(st.x * .5 + st.y, st.y);", coord.vsOut());
+                }
+                gpArgs->fPositionVar.set(kFloat2_GrSLType, "position");
+
+                this->emitTransforms(v, varyings, args.fUniformHandler,
+                                     GrShaderVar("position", kFloat2_GrSLType),
+                                     hairlineGP.fLocalMatrix, args.fFPCoordTransformHandler);
+
+                GrGLSLFPFragmentBuilder* f = args.fFragBuilder;
+                this->setupUniformColor(f, args.fUniformHandler, args.fOutputColor,
+                                        &fColorUniform);
+                const char* coverageScale;
+                fCoverageUniform = args.fUniformHandler->addUniform(
+                        kFragment_GrShaderFlag, kHalf_GrSLType, "coverage", &coverageScale);
+                if (Type::kLines == hairlineGP.fType) {
+                    f->codeAppendf("half edgeAlpha = half(%s.x);", coord.fsIn());
+                } else {
+                    // The same distance estimate as GrQuadEffect's kHairlineAA.
+                    f->codeAppendf("half2 duvdx = half2(dFdx(%s));", coord.fsIn());
+                    f->codeAppendf("half2 duvdy = half2(dFdy(%s));", coord.fsIn());
+                    f->codeAppendf("half2 gF = half2(2.0 * %s.x * duvdx.x - duvdx.y,"
+                                                    "2.0 * %s.x * duvdy.x - duvdy.y);",
+                                   coord.fsIn(), coord.fsIn());
+                    f->codeAppendf("half edgeAlpha = half(%s.x * %s.x - %s.y);",
+                                   coord.fsIn(), coord.fsIn(), coord.fsIn());
+                    f->codeAppend("edgeAlpha = sqrt(edgeAlpha * edgeAlpha / dot(gF, gF));");
+                    f->codeAppend("edgeAlpha = max(1.0 - edgeAlpha, 0.0);");
+                }
+                f->codeAppendf("%s = half4(%s * edgeAlpha);", args.fOutputCoverage,
+                               coverageScale);
+            }
+
+            SkPMColor4f fColor = SK_PMColor4fILLEGAL;
+            int fCoverage = -1;
+            UniformHandle fColorUniform;
+            UniformHandle fCoverageUniform;
+        };
+        return new GLSLProcessor;
+    }
+
+private:
+    InstancedHairlineGP(Type type, const SkPMColor4f& color, uint8_t coverage,
+                        const SkMatrix& localMatrix, bool usesLocalCoords)
+            : INHERITED(kInstancedHairlineGP_ClassID)
+            , fType(type)
+            , fColor(color)
+            , fCoverage(coverage)
+            , fLocalMatrix(localMatrix)
+            , fUsesLocalCoords(usesLocalCoords) {
+        this->setVertexAttributes(&kCorner, 1);
+        fInPoints[0] = {"p0", kFloat2_GrVertexAttribType, kFloat2_GrSLType};
+        fInPoints[1] = {"p1", kFloat2_GrVertexAttribType, kFloat2_GrSLType};
+        fInPoints[2] = {"p2", kFloat2_GrVertexAttribType, kFloat2_GrSLType};
+        this->setInstanceAttributes(fInPoints, Type::kLines == type ? 2 : 3);
+    }
+
+    static constexpr Attribute kCorner = {"corner", kFloat4_GrVertexAttribType, kFloat4_GrSLType};
+
+    Type fType;
+    Attribute fInPoints[3];
+    SkPMColor4f fColor;
+    uint8_t fCoverage;
+    SkMatrix fLocalMatrix;
+    bool fUsesLocalCoords;
+
+    typedef GrGeometryProcessor INHERITED;
+};
+
+constexpr GrPrimitiveProcessor::Attribute InstancedHairlineGP::kCorner;
+constexpr float InstancedHairlineGP::kLineVertexData[kLineSegNumVertices][4];
+constexpr float InstancedHairlineGP::kQuadVertexData[kQuadNumVertices][4];
+
+GR_DECLARE_STATIC_UNIQUE_KEY(gHairlineLineVertexBufferKey);
+GR_DECLARE_STATIC_UNIQUE_KEY(gHairlineQuadVertexBufferKey);
+
+}  // anonymous namespace
+
+static SkPoint* add_quad_instances(const SkPoint p[3], int subdiv, SkPoint* instance) {
+    SkASSERT(subdiv >= 0);
+    if (subdiv) {
+        SkPoint newP[5];
+        SkChopQuadAtHalf(p, newP);
+        instance = add_quad_instances(newP + 0, subdiv - 1, instance);
+        return add_quad_instances(newP + 2, subdiv - 1, instance);
+    }
+    memcpy(instance, p, 3 * sizeof(SkPoint));
+    return instance + 3;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 GrPathRenderer::CanDrawPath
 GrAAHairLinePathRenderer::onCanDrawPath(const CanDrawPathArgs& args) const {
     if (GrAAType::kCoverage != args.fAAType) {
@@ -852,6 +1065,10 @@ private:
     typedef SkTArray<int, true> IntArray;
     typedef SkTArray<float, true> FloatArray;
 
+    void prepareInstancedLines(Target*, const PtArray& lines, const SkMatrix& localMatrix);
+    void prepareInstancedQuads(Target*, const PtArray& quads, const IntArray& quadSubdivCnts,
+                               int quadCount, const SkMatrix& localMatrix);
+
     CombineResult onCombineIfPossible(GrOp* t, const GrCaps& caps) override {
         AAHairlineOp* that = t->cast<AAHairlineOp>();
 
@@ -956,8 +1173,13 @@ void AAHairlineOp::onPrepareDraws(Target* target) {
         return;
     }
 
+    // Without perspective the segments are in device space, and the GPU can bloat them itself.
+    bool instanced = !hasPerspective && target->caps().instanceAttribSupport();
+
     // do lines first
-    if (lineCount) {
+    if (lineCount && instanced) {
+        this->prepareInstancedLines(target, lines, *geometryProcessorLocalM);
+    } else if (lineCount) {
         sk_sp<GrGeometryProcessor> lineGP;
         {
             using namespace GrDefaultGeoProcFactory;
@@ -997,6 +1219,13 @@ void AAHairlineOp::onPrepareDraws(Target* target) {
         target->recordDraw(std::move(lineGP), mesh);
     }
 
+    if (quadCount && instanced) {
+        this->prepareInstancedQuads(target, quads, qSubdivs, quadCount, *geometryProcessorLocalM);
+        quadAndConicCount = conicCount;
+        quadCount = 0;
+        quads.reset();
+    }
+
     if (quadCount || conicCount) {
         sk_sp<GrGeometryProcessor> quadGP(GrQuadEffect::Make(this->color(),
                                                              *geometryProcessorViewM,
@@ -1063,6 +1292,82 @@ void AAHairlineOp::onPrepareDraws(Target* target) {
     }
 }
 
+void AAHairlineOp::prepareInstancedLines(Target* target, const PtArray& lines,
+                                         const SkMatrix& localMatrix) {
+    GR_DEFINE_STATIC_UNIQUE_KEY(gHairlineLineVertexBufferKey);
+
+    sk_sp<const GrBuffer> cornerBuffer = target->resourceProvider()->findOrMakeStaticBuffer(
+            GrGpuBufferType::kVertex, sizeof(InstancedHairlineGP::kLineVertexData),
+            InstancedHairlineGP::kLineVertexData, gHairlineLineVertexBufferKey);
+    sk_sp<const GrBuffer> linesIndexBuffer = get_lines_index_buffer(target->resourceProvider());
+    if (!cornerBuffer || !linesIndexBuffer) {
+        SkDebugf("Could not allocate vertices\n");
+        return;
+    }
+
+    auto gp = InstancedHairlineGP::Make(InstancedHairlineGP::Type::kLines, this->color(),
+                                        this->coverage(), localMatrix, fHelper.usesLocalCoords());
+    int lineCount = lines.count() / 2;
+    sk_sp<const GrBuffer> instanceBuffer;
+    int baseInstance;
+    void* instances = target->makeVertexSpace(gp->instanceStride(), lineCount, &instanceBuffer,
+                                              &baseInstance);
+    if (!instances) {
+        SkDebugf("Could not allocate vertices\n");
+        return;
+    }
+    SkASSERT(gp->instanceStride() == 2 * sizeof(SkPoint));
+    memcpy(instances, lines.begin(), lineCount * 2 * sizeof(SkPoint));
+
+    GrMesh* mesh = target->allocMesh(GrPrimitiveType::kTriangles);
+    mesh->setIndexedInstanced(std::move(linesIndexBuffer), kIdxsPerLineSeg,
+                              std::move(instanceBuffer), lineCount, baseInstance,
+                              GrPrimitiveRestart::kNo);
+    mesh->setVertexData(std::move(cornerBuffer));
+    target->recordDraw(std::move(gp), mesh);
+}
+
+void AAHairlineOp::prepareInstancedQuads(Target* target, const PtArray& quads,
+                                         const IntArray& quadSubdivCnts, int quadCount,
+                                         const SkMatrix& localMatrix) {
+    GR_DEFINE_STATIC_UNIQUE_KEY(gHairlineQuadVertexBufferKey);
+
+    sk_sp<const GrBuffer> cornerBuffer = target->resourceProvider()->findOrMakeStaticBuffer(
+            GrGpuBufferType::kVertex, sizeof(InstancedHairlineGP::kQuadVertexData),
+            InstancedHairlineGP::kQuadVertexData, gHairlineQuadVertexBufferKey);
+    sk_sp<const GrBuffer> quadsIndexBuffer = get_quads_index_buffer(target->resourceProvider());
+    if (!cornerBuffer || !quadsIndexBuffer) {
+        SkDebugf("Could not allocate vertices\n");
+        return;
+    }
+
+    auto gp = InstancedHairlineGP::Make(InstancedHairlineGP::Type::kQuads, this->color(),
+                                        this->coverage(), localMatrix, fHelper.usesLocalCoords());
+    sk_sp<const GrBuffer> instanceBuffer;
+    int baseInstance;
+    SkPoint* instances = static_cast<SkPoint*>(target->makeVertexSpace(
+            gp->instanceStride(), quadCount, &instanceBuffer, &baseInstance));
+    if (!instances) {
+        SkDebugf("Could not allocate vertices\n");
+        return;
+    }
+    SkASSERT(gp->instanceStride() == 3 * sizeof(SkPoint));
+
+    SkDEBUGCODE(const SkPoint* end = instances + 3 * quadCount;)
+    int unsubdivQuadCnt = quads.count() / 3;
+    for (int i = 0; i < unsubdivQuadCnt; ++i) {
+        instances = add_quad_instances(&quads[3*i], quadSubdivCnts[i], instances);
+    }
+    SkASSERT(instances == end);
+
+    GrMesh* mesh = target->allocMesh(GrPrimitiveType::kTriangles);
+    mesh->setIndexedInstanced(std::move(quadsIndexBuffer), kIdxsPerQuad,
+                              std::move(instanceBuffer), quadCount, baseInstance,
+                              GrPrimitiveRestart::kNo);
+    mesh->setVertexData(std::move(cornerBuffer));
+    target->recordDraw(std::move(gp), mesh);
+}
+
 void AAHairlineOp::onExecute(GrOpFlushState* flushState, const SkRect& chainBounds) {
     fHelper.executeDrawsAndUploads(this, flushState, chainBounds);
 }
@@ -165,6 +165,8 @@ public:
 
     const char* name() const override { return "AAFlatteningConvexPathOp"; }
 
+    bool canPrepareConcurrently() const override { return true; }
+
     void visitProxies(const VisitProxyFunc& func, VisitorType) const override {
         fHelper.visitProxies(func);
     }
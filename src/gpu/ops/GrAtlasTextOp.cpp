@@ -171,20 +171,36 @@ GrProcessorSet::Analysis GrAtlasTextOp::finalize(const GrCaps& caps, const GrApp
     return analysis;
 }
 
-static void clip_quads(const SkIRect& clipRect, char* currVertex, const char* blobVertices,
-                       size_t vertexStride, int glyphCount) {
+// Copies the vertices of glyphCount glyphs, adding translate to their positions on the way.
+static void copy_quads(char* currVertex, const char* blobVertices, size_t vertexStride,
+                       int glyphCount, const SkVector& translate) {
+    if (translate.isZero()) {
+        memcpy(currVertex, blobVertices, glyphCount * 4 * vertexStride);
+        return;
+    }
+    for (int i = 0; i < glyphCount * 4; ++i) {
+        memcpy(currVertex, blobVertices, vertexStride);
+        SkPoint* position = reinterpret_cast<SkPoint*>(currVertex);
+        *position += translate;
+        currVertex += vertexStride;
+        blobVertices += vertexStride;
+    }
+}
+
+static void clip_quads(const SkIRect& clipRect, const SkVector& translate, char* currVertex,
+                       const char* blobVertices, size_t vertexStride, int glyphCount) {
     for (int i = 0; i < glyphCount; ++i) {
-        const SkPoint* blobPositionLT = reinterpret_cast<const SkPoint*>(blobVertices);
-        const SkPoint* blobPositionRB =
-                reinterpret_cast<const SkPoint*>(blobVertices + 3 * vertexStride);
+        SkPoint positionLT = *reinterpret_cast<const SkPoint*>(blobVertices) + translate;
+        SkPoint positionRB =
+                *reinterpret_cast<const SkPoint*>(blobVertices + 3 * vertexStride) + translate;
 
         // positions for bitmap glyphs are pixel boundary aligned
-        SkIRect positionRect = SkIRect::MakeLTRB(SkScalarRoundToInt(blobPositionLT->fX),
-                                                 SkScalarRoundToInt(blobPositionLT->fY),
-                                                 SkScalarRoundToInt(blobPositionRB->fX),
-                                                 SkScalarRoundToInt(blobPositionRB->fY));
+        SkIRect positionRect = SkIRect::MakeLTRB(SkScalarRoundToInt(positionLT.fX),
+                                                 SkScalarRoundToInt(positionLT.fY),
+                                                 SkScalarRoundToInt(positionRB.fX),
+                                                 SkScalarRoundToInt(positionRB.fY));
         if (clipRect.contains(positionRect)) {
-            memcpy(currVertex, blobVertices, 4 * vertexStride);
+            copy_quads(currVertex, blobVertices, vertexStride, 1, translate);
             currVertex += 4 * vertexStride;
         } else {
             // Pull out some more data that we'll need.
@@ -354,28 +370,36 @@ void GrAtlasTextOp::onPrepareDraws(Target* target) {
             }
             done = result.fFinished;
 
-            // Copy regenerated vertices from the blob to our vertex buffer.
+            // Copy regenerated vertices from the blob to our vertex buffer. If the blob only moved
+            // since its vertices were last written, the regenerator leaves them alone and we
+            // translate them here instead. Glyphs that get transformed below fold the translation
+            // into that transformation.
+            SkVector copyTranslate = fNeedsGlyphTransform ? SkVector::Make(0, 0)
+                                                          : result.fTranslate;
             size_t vertexBytes = result.fGlyphsRegenerated * kVerticesPerGlyph * vertexStride;
             if (args.fClipRect.isEmpty()) {
-                memcpy(currVertex, result.fFirstVertex, vertexBytes);
+                copy_quads(currVertex, result.fFirstVertex, vertexStride,
+                           result.fGlyphsRegenerated, copyTranslate);
             } else {
                 SkASSERT(!vmPerspective);
-                clip_quads(args.fClipRect, currVertex, result.fFirstVertex, vertexStride,
-                           result.fGlyphsRegenerated);
+                clip_quads(args.fClipRect, copyTranslate, currVertex, result.fFirstVertex,
+                           vertexStride, result.fGlyphsRegenerated);
             }
-            if (fNeedsGlyphTransform && !args.fViewMatrix.isIdentity()) {
+            if (fNeedsGlyphTransform) {
+                SkMatrix glyphMatrix = args.fViewMatrix;
+                glyphMatrix.preTranslate(result.fTranslate.fX, result.fTranslate.fY);
                 // We always do the distance field view matrix transformation after copying rather
                 // than during blob vertex generation time in the blob as handling successive
                 // arbitrary transformations would be complicated and accumulate error.
-                if (args.fViewMatrix.hasPerspective()) {
+                if (glyphMatrix.hasPerspective()) {
                     auto* pos = reinterpret_cast<SkPoint3*>(currVertex);
                     SkMatrixPriv::MapHomogeneousPointsWithStride(
-                            args.fViewMatrix, pos, vertexStride, pos, vertexStride,
+                            glyphMatrix, pos, vertexStride, pos, vertexStride,
                             result.fGlyphsRegenerated * kVerticesPerGlyph);
-                } else {
+                } else if (!glyphMatrix.isIdentity()) {
                     auto* pos = reinterpret_cast<SkPoint*>(currVertex);
                     SkMatrixPriv::MapPointsWithStride(
-                            args.fViewMatrix, pos, vertexStride,
+                            glyphMatrix, pos, vertexStride,
                             result.fGlyphsRegenerated * kVerticesPerGlyph);
                 }
             }
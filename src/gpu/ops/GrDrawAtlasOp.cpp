@@ -30,7 +30,7 @@ public:
 
     DrawAtlasOp(const Helper::MakeArgs&, const SkPMColor4f& color,
                 const SkMatrix& viewMatrix, GrAAType, int spriteCount, const SkRSXform* xforms,
-                const SkRect* rects, const SkColor* colors);
+                const SkRect* rects, const SkColor* colors, const SkRect* deviceCullRect);
 
     const char* name() const override { return "DrawAtlasOp"; }
 
@@ -89,7 +89,8 @@ static sk_sp<GrGeometryProcessor> make_gp(const GrShaderCaps* shaderCaps,
 
 DrawAtlasOp::DrawAtlasOp(const Helper::MakeArgs& helperArgs, const SkPMColor4f& color,
                          const SkMatrix& viewMatrix, GrAAType aaType, int spriteCount,
-                         const SkRSXform* xforms, const SkRect* rects, const SkColor* colors)
+                         const SkRSXform* xforms, const SkRect* rects, const SkColor* colors,
+                         const SkRect* deviceCullRect)
         : INHERITED(ClassID()), fHelper(helperArgs, aaType), fColor(color) {
     SkASSERT(xforms);
     SkASSERT(rects);
@@ -108,8 +109,14 @@ DrawAtlasOp::DrawAtlasOp(const Helper::MakeArgs& helperArgs, const SkPMColor4f&
         vertexStride += sizeof(GrColor);
     }
 
+    // Sprites entirely outside the cull rect are dropped here, rather than copied and uploaded.
+    // Culling is skipped under perspective, where mapping a sprite's bounds may not bound it.
+    if (viewMatrix.hasPerspective()) {
+        deviceCullRect = nullptr;
+    }
+
     // Compute buffer size and alloc buffer
-    fQuadCount = spriteCount;
+    fQuadCount = 0;
     int allocSize = static_cast<int>(4 * vertexStride * spriteCount);
     installedGeo.fVerts.reset(allocSize);
     uint8_t* currVertex = installedGeo.fVerts.begin();
@@ -122,6 +129,15 @@ DrawAtlasOp::DrawAtlasOp(const Helper::MakeArgs& helperArgs, const SkPMColor4f&
         SkPoint strip[4];
         const SkRect& currRect = rects[spriteIndex];
         xforms[spriteIndex].toTriStrip(currRect.width(), currRect.height(), strip);
+        if (deviceCullRect) {
+            SkRect devBounds;
+            devBounds.set(strip, 4);
+            viewMatrix.mapRect(&devBounds);
+            if (!devBounds.intersects(*deviceCullRect)) {
+                continue;
+            }
+        }
+        ++fQuadCount;
 
         // Copy colors if necessary
         if (colors) {
@@ -165,7 +181,12 @@ DrawAtlasOp::DrawAtlasOp(const Helper::MakeArgs& helperArgs, const SkPMColor4f&
         SkRectPriv::GrowToInclude(&bounds, strip[3]);
         currVertex += vertexStride;
     }
+    installedGeo.fVerts.pop_back_n(static_cast<int>(4 * vertexStride * (spriteCount - fQuadCount)));
 
+    if (!fQuadCount) {
+        this->setBounds(SkRect::MakeEmpty(), HasAABloat::kNo, IsZeroArea::kNo);
+        return;
+    }
     this->setTransformedBounds(bounds, viewMatrix, HasAABloat::kNo, IsZeroArea::kNo);
 }
 
@@ -193,6 +214,9 @@ void DrawAtlasOp::onPrepareDraws(Target* target) {
     size_t vertexStride = gp->vertexStride();
 
     int numQuads = this->quadCount();
+    if (!numQuads) {
+        return;
+    }
     QuadHelper helper(target, vertexStride, numQuads);
     void* verts = helper.vertices();
     if (!verts) {
@@ -270,11 +294,12 @@ std::unique_ptr<GrDrawOp> GrDrawAtlasOp::Make(GrRecordingContext* context,
                                               int spriteCount,
                                               const SkRSXform* xforms,
                                               const SkRect* rects,
-                                              const SkColor* colors) {
+                                              const SkColor* colors,
+                                              const SkRect* deviceCullRect) {
     return GrSimpleMeshDrawOpHelper::FactoryHelper<DrawAtlasOp>(context, std::move(paint),
                                                                 viewMatrix, aaType,
                                                                 spriteCount, xforms,
-                                                                rects, colors);
+                                                                rects, colors, deviceCullRect);
 }
 
 #if GR_TEST_UTILS
@@ -17,6 +17,10 @@ class GrRecordingContext;
 class SkMatrix;
 
 namespace GrDrawAtlasOp {
+    /**
+     * If deviceCullRect is not null, sprites whose device space bounds don't touch it are not
+     * drawn. Returns an op with no sprites (and empty bounds) if none of them do.
+     */
     std::unique_ptr<GrDrawOp> Make(GrRecordingContext*,
                                    GrPaint&&,
                                    const SkMatrix& viewMatrix,
@@ -24,7 +28,8 @@ namespace GrDrawAtlasOp {
                                    int spriteCount,
                                    const SkRSXform* xforms,
                                    const SkRect* rects,
-                                   const SkColor* colors);
+                                   const SkColor* colors,
+                                   const SkRect* deviceCullRect = nullptr);
 };
 
 #endif
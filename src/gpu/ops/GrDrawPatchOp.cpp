@@ -0,0 +1,366 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrDrawPatchOp.h"
+
+#include "GrCaps.h"
+#include "GrGpuCommandBuffer.h"
+#include "GrMemoryPool.h"
+#include "GrOpFlushState.h"
+#include "GrRecordingContext.h"
+#include "GrRecordingContextPriv.h"
+#include "GrResourceProvider.h"
+#include "SkHalf.h"
+#include "glsl/GrGLSLFragmentShaderBuilder.h"
+#include "glsl/GrGLSLGeometryProcessor.h"
+#include "glsl/GrGLSLProgramDataManager.h"
+#include "glsl/GrGLSLUniformHandler.h"
+#include "glsl/GrGLSLUtil.h"
+#include "glsl/GrGLSLVarying.h"
+#include "glsl/GrGLSLVertexGeoBuilder.h"
+
+// The 12 control points are packed two to an attribute.
+static constexpr int kCubicAttribCount = SkPatchUtils::kNumCtrlPts / 2;
+// The (u, v) vertex, the control points, the corner colors and the corner texture coords.
+static constexpr int kMaxAttribCount = 1 + kCubicAttribCount + SkPatchUtils::kNumCorners + 2;
+
+std::unique_ptr<GrDrawOp> GrDrawPatchOp::Make(GrRecordingContext* context,
+                                              GrPaint&& paint,
+                                              const SkMatrix& viewMatrix,
+                                              const SkPoint cubics[SkPatchUtils::kNumCtrlPts],
+                                              const SkPMColor4f colors[SkPatchUtils::kNumCorners],
+                                              const SkPoint texCoords[SkPatchUtils::kNumCorners]) {
+    const GrCaps& caps = *context->priv().caps();
+    int attribCount = texCoords ? kMaxAttribCount : kMaxAttribCount - 2;
+    if (!caps.instanceAttribSupport() || caps.maxVertexAttributes() < attribCount) {
+        return nullptr;
+    }
+
+    SkISize lod = SkPatchUtils::GetBucketedLevelOfDetail(cubics, &viewMatrix);
+    if (lod.isEmpty()) {
+        return nullptr;
+    }
+
+    GrOpMemoryPool* pool = context->priv().opMemoryPool();
+    return pool->allocate<GrDrawPatchOp>(std::move(paint), viewMatrix, lod, cubics, colors,
+                                         texCoords);
+}
+
+GrDrawPatchOp::GrDrawPatchOp(GrPaint&& paint, const SkMatrix& viewMatrix, SkISize lod,
+                             const SkPoint cubics[SkPatchUtils::kNumCtrlPts],
+                             const SkPMColor4f colors[SkPatchUtils::kNumCorners],
+                             const SkPoint texCoords[SkPatchUtils::kNumCorners])
+        : GrDrawOp(ClassID())
+        , fViewMatrix(viewMatrix)
+        , fLOD(lod)
+        , fOriginalColor(paint.getColor4f())
+        , fHasColors(SkToBool(colors))
+        , fHasTexCoords(SkToBool(texCoords))
+        , fProcessors(std::move(paint)) {
+    if (colors) {
+        memcpy(fColors, colors, sizeof(fColors));
+    }
+    if (texCoords) {
+        memcpy(fTexCoords, texCoords, sizeof(fTexCoords));
+    }
+
+    // A patch lies within the convex hull of its control points.
+    SkRect bounds;
+    bounds.set(cubics, SkPatchUtils::kNumCtrlPts);
+    this->setTransformedBounds(bounds, viewMatrix, HasAABloat::kNo, IsZeroArea::kNo);
+
+    // Write the control point attribs. We will write the color and texture coord attribs during
+    // finalize().
+    memcpy(this->appendInstanceData<SkPoint>(SkPatchUtils::kNumCtrlPts), cubics,
+           SkPatchUtils::kNumCtrlPts * sizeof(SkPoint));
+}
+
+GrProcessorSet::Analysis GrDrawPatchOp::finalize(const GrCaps& caps, const GrAppliedClip* clip,
+                                                 GrFSAAType fsaaType, GrClampType clampType) {
+    SkASSERT(1 == fInstanceCount);
+
+    GrProcessorAnalysisColor gpColor(fOriginalColor);
+    if (fHasColors) {
+        bool opaque = true;
+        for (const auto& color : fColors) {
+            opaque = opaque && color.isOpaque();
+        }
+        gpColor = GrProcessorAnalysisColor(opaque ? GrProcessorAnalysisColor::Opaque::kYes
+                                                  : GrProcessorAnalysisColor::Opaque::kNo);
+    }
+
+    SkPMColor4f overrideColor;
+    const GrProcessorSet::Analysis& analysis = fProcessors.finalize(
+            gpColor, GrProcessorAnalysisCoverage::kNone, clip, &GrUserStencilSettings::kUnused,
+            fsaaType, caps, clampType, &overrideColor);
+
+    // Finish writing the instance attribs.
+    SkPMColor4f cornerColors[SkPatchUtils::kNumCorners];
+    bool wideColor = false;
+    for (int i = 0; i < SkPatchUtils::kNumCorners; ++i) {
+        cornerColors[i] = analysis.inputColorIsOverridden() ? overrideColor
+                                                            : fHasColors ? fColors[i]
+                                                                         : fOriginalColor;
+        wideColor = wideColor || !SkPMColor4fFitsInBytes(cornerColors[i]);
+    }
+    for (const auto& color : cornerColors) {
+        if (wideColor) {
+            SkFloatToHalf_finite_ftz(Sk4f::Load(color.vec())).store(
+                    this->appendInstanceData<uint32_t>(2));
+        } else {
+            uint32_t bytes = color.toBytes_RGBA();
+            memcpy(this->appendInstanceData<uint32_t>(1), &bytes, sizeof(uint32_t));
+        }
+    }
+    if (wideColor) {
+        fFlags |= Flags::kWideColor;
+    }
+
+    if (fHasTexCoords && analysis.usesLocalCoords()) {
+        memcpy(this->appendInstanceData<SkPoint>(SkPatchUtils::kNumCorners), fTexCoords,
+               sizeof(fTexCoords));
+        fFlags |= Flags::kHasTexCoords;
+    }
+    fInstanceStride = fInstanceData.count();
+
+    return analysis;
+}
+
+GrDrawOp::CombineResult GrDrawPatchOp::onCombineIfPossible(GrOp* op, const GrCaps&) {
+    const auto& that = *op->cast<GrDrawPatchOp>();
+    if (fFlags != that.fFlags || fLOD != that.fLOD ||
+        !fViewMatrix.cheapEqualTo(that.fViewMatrix) || fProcessors != that.fProcessors ||
+        fInstanceData.count() > std::numeric_limits<int>::max() - that.fInstanceData.count()) {
+        return CombineResult::kCannotCombine;
+    }
+
+    fInstanceData.push_back_n(that.fInstanceData.count(), that.fInstanceData.begin());
+    fInstanceCount += that.fInstanceCount;
+    SkASSERT(fInstanceStride == that.fInstanceStride);
+    return CombineResult::kMerged;
+}
+
+void GrDrawPatchOp::onPrepare(GrOpFlushState* flushState) {
+    if (void* instanceData = flushState->makeVertexSpace(fInstanceStride, fInstanceCount,
+                                                         &fInstanceBuffer, &fBaseInstance)) {
+        SkASSERT(fInstanceStride * fInstanceCount == fInstanceData.count());
+        memcpy(instanceData, fInstanceData.begin(), fInstanceData.count());
+    }
+}
+
+class GrDrawPatchOp::Processor : public GrGeometryProcessor {
+public:
+    Processor(Flags flags, const SkMatrix& viewMatrix)
+            : GrGeometryProcessor(kGrDrawPatchOp_Processor_ClassID)
+            , fFlags(flags)
+            , fViewMatrix(viewMatrix) {
+        this->setVertexAttributes(kVertexAttribs, 1);
+
+        int count = 0;
+        for (const char* name : {"cubics0", "cubics1", "cubics2",
+                                 "cubics3", "cubics4", "cubics5"}) {
+            fInstanceAttribs[count++] = {name, kFloat4_GrVertexAttribType, kFloat4_GrSLType};
+        }
+        for (const char* name : {"color0", "color1", "color2", "color3"}) {
+            fInstanceAttribs[count++] = MakeColorAttribute(name, (flags & Flags::kWideColor));
+        }
+        if (flags & Flags::kHasTexCoords) {
+            for (const char* name : {"texcoords01", "texcoords23"}) {
+                fInstanceAttribs[count++] = {name, kFloat4_GrVertexAttribType, kFloat4_GrSLType};
+            }
+        }
+        SkASSERT(count < kMaxAttribCount);
+        this->setInstanceAttributes(fInstanceAttribs, count);
+    }
+
+    const char* name() const override { return "GrDrawPatchOp::Processor"; }
+
+    void getGLSLProcessorKey(const GrShaderCaps& caps, GrProcessorKeyBuilder* b) const override {
+        uint32_t positionKey = fViewMatrix.isIdentity() ? 0 : fViewMatrix.hasPerspective() ? 2 : 1;
+        b->add32(static_cast<uint32_t>(fFlags) | (positionKey << 8));
+    }
+
+    GrGLSLPrimitiveProcessor* createGLSLInstance(const GrShaderCaps&) const override;
+
+private:
+    static constexpr Attribute kVertexAttribs[] = {
+            {"uv", kFloat2_GrVertexAttribType, kFloat2_GrSLType}};
+
+    Attribute fInstanceAttribs[kMaxAttribCount - 1];
+
+    const Flags fFlags;
+    const SkMatrix fViewMatrix;
+
+    class Impl;
+};
+
+constexpr GrPrimitiveProcessor::Attribute GrDrawPatchOp::Processor::kVertexAttribs[];
+
+class GrDrawPatchOp::Processor::Impl : public GrGLSLGeometryProcessor {
+public:
+    void onEmitCode(EmitArgs& args, GrGPArgs* gpArgs) override {
+        const auto& proc = args.fGP.cast<Processor>();
+
+        GrGLSLVaryingHandler* varyings = args.fVaryingHandler;
+        varyings->emitAttributes(proc);
+
+        // Emit the vertex shader.
+        GrGLSLVertexBuilder* v = args.fVertBuilder;
+
+        // Unpack the control points, which run clockwise from the top left corner.
+        for (int i = 0; i < kCubicAttribCount; ++i) {
+            v->codeAppendf("float2 p%d = cubics%d.xy;", 2 * i, i);
+            v->codeAppendf("float2 p%d = cubics%d.zw;", 2 * i + 1, i);
+        }
+
+        // Evaluate the patch's edge cubics at (u, v) with their Bernstein polynomials.
+        v->codeAppend("float u = uv.x;");
+        v->codeAppend("float v = uv.y;");
+        v->codeAppend("float4 bu = float4((1 - u) * (1 - u) * (1 - u), 3 * u * (1 - u) * (1 - u), "
+                                         "3 * u * u * (1 - u), u * u * u);");
+        v->codeAppend("float4 bv = float4((1 - v) * (1 - v) * (1 - v), 3 * v * (1 - v) * (1 - v), "
+                                         "3 * v * v * (1 - v), v * v * v);");
+        v->codeAppend("float2 top = bu.x * p0 + bu.y * p1 + bu.z * p2 + bu.w * p3;");
+        v->codeAppend("float2 bottom = bu.x * p9 + bu.y * p8 + bu.z * p7 + bu.w * p6;");
+        v->codeAppend("float2 left = bv.x * p0 + bv.y * p11 + bv.z * p10 + bv.w * p9;");
+        v->codeAppend("float2 right = bv.x * p3 + bv.y * p4 + bv.z * p5 + bv.w * p6;");
+
+        // The Coons patch is the sum of the lerps between opposite edges, minus the bilerp of the
+        // corners (see SkPatchUtils::MakeVertices()).
+        v->codeAppend("float2 pos = mix(top, bottom, v) + mix(left, right, u) - "
+                                   "mix(mix(p0, p3, u), mix(p9, p6, u), v);");
+
+        // Bilerp the corner colors, and texture coords if there are any.
+        GrGLSLVarying color(kHalf4_GrSLType);
+        varyings->addVarying("color", &color);
+        v->codeAppendf("%s = mix(mix(color0, color1, half(u)), mix(color3, color2, half(u)), "
+                                "half(v));", color.vsOut());
+
+        GrShaderVar localCoord("pos", kFloat2_GrSLType);
+        if (proc.fFlags & Flags::kHasTexCoords) {
+            v->codeAppend("float2 localcoord = mix(mix(texcoords01.xy, texcoords01.zw, u), "
+                                                  "mix(texcoords23.zw, texcoords23.xy, u), v);");
+            localCoord.set(kFloat2_GrSLType, "localcoord");
+        }
+        this->emitTransforms(v, varyings, args.fUniformHandler, localCoord,
+                             args.fFPCoordTransformHandler);
+
+        // Transform to device space.
+        this->writeOutputPosition(v, args.fUniformHandler, gpArgs, "pos", proc.fViewMatrix,
+                                  &fViewMatrixUniform);
+
+        // Emit the fragment shader.
+        GrGLSLFPFragmentBuilder* f = args.fFragBuilder;
+        f->codeAppendf("%s = %s;", args.fOutputColor, color.fsIn());
+        f->codeAppendf("%s = half4(1);", args.fOutputCoverage);
+    }
+
+    void setData(const GrGLSLProgramDataManager& pdman, const GrPrimitiveProcessor& primProc,
+                 FPCoordTransformIter&& transformIter) override {
+        const auto& proc = primProc.cast<Processor>();
+        if (!proc.fViewMatrix.isIdentity() && !fViewMatrix.cheapEqualTo(proc.fViewMatrix)) {
+            fViewMatrix = proc.fViewMatrix;
+            float viewMatrix[3 * 3];
+            GrGLSLGetMatrix<3>(viewMatrix, fViewMatrix);
+            pdman.setMatrix3f(fViewMatrixUniform, viewMatrix);
+        }
+        this->setTransformDataHelper(SkMatrix::I(), pdman, &transformIter);
+    }
+
+private:
+    SkMatrix fViewMatrix = SkMatrix::InvalidMatrix();
+    UniformHandle fViewMatrixUniform;
+};
+
+GrGLSLPrimitiveProcessor* GrDrawPatchOp::Processor::createGLSLInstance(const GrShaderCaps&) const {
+    return new Impl();
+}
+
+// Finds or makes the grid of (u, v) vertices a patch is evaluated over, lod.width() + 1 columns of
+// lod.height() + 1, and its triangles, which are laid out like SkPatchUtils::MakeVertices() lays
+// them out.
+static bool find_or_make_grid(GrResourceProvider* resourceProvider, SkISize lod,
+                              sk_sp<const GrBuffer>* vertexBuffer,
+                              sk_sp<const GrBuffer>* indexBuffer) {
+    static const GrUniqueKey::Domain kVertexDomain = GrUniqueKey::GenerateDomain();
+    static const GrUniqueKey::Domain kIndexDomain = GrUniqueKey::GenerateDomain();
+
+    int lodX = lod.width(), lodY = lod.height();
+    // SkPatchUtils limits the level of detail to 200 and 10000 vertices.
+    SkASSERT(lodX <= 0xffff && lodY <= 0xffff && (lodX + 1) * (lodY + 1) <= 0xffff);
+
+    GrUniqueKey vertexKey, indexKey;
+    {
+        GrUniqueKey::Builder builder(&vertexKey, kVertexDomain, 1, "Patch Grid Vertices");
+        builder[0] = (lodX << 16) | lodY;
+    }
+    {
+        GrUniqueKey::Builder builder(&indexKey, kIndexDomain, 1, "Patch Grid Indices");
+        builder[0] = (lodX << 16) | lodY;
+    }
+
+    int stride = lodY + 1;
+    if (!(*vertexBuffer = resourceProvider->findByUniqueKey<const GrGpuBuffer>(vertexKey))) {
+        int vertexCount = (lodX + 1) * stride;
+        SkAutoTMalloc<SkPoint> uvs(vertexCount);
+        for (int x = 0; x <= lodX; ++x) {
+            for (int y = 0; y <= lodY; ++y) {
+                uvs[x * stride + y] = {(float)x / lodX, (float)y / lodY};
+            }
+        }
+        *vertexBuffer = resourceProvider->findOrMakeStaticBuffer(
+                GrGpuBufferType::kVertex, vertexCount * sizeof(SkPoint), uvs.get(), vertexKey);
+    }
+    if (!(*indexBuffer = resourceProvider->findByUniqueKey<const GrGpuBuffer>(indexKey))) {
+        int indexCount = 6 * lodX * lodY;
+        SkAutoTMalloc<uint16_t> indices(indexCount);
+        for (int x = 0; x < lodX; ++x) {
+            for (int y = 0; y < lodY; ++y) {
+                uint16_t* quad = indices.get() + 6 * (x * lodY + y);
+                quad[0] = x * stride + y;
+                quad[1] = x * stride + 1 + y;
+                quad[2] = (x + 1) * stride + 1 + y;
+                quad[3] = quad[0];
+                quad[4] = quad[2];
+                quad[5] = (x + 1) * stride + y;
+            }
+        }
+        *indexBuffer = resourceProvider->findOrMakeStaticBuffer(
+                GrGpuBufferType::kIndex, indexCount * sizeof(uint16_t), indices.get(), indexKey);
+    }
+    return *vertexBuffer && *indexBuffer;
+}
+
+void GrDrawPatchOp::onExecute(GrOpFlushState* flushState, const SkRect& chainBounds) {
+    if (!fInstanceBuffer) {
+        return;  // Setup failed.
+    }
+
+    sk_sp<const GrBuffer> vertexBuffer, indexBuffer;
+    if (!find_or_make_grid(flushState->resourceProvider(), fLOD, &vertexBuffer, &indexBuffer)) {
+        return;
+    }
+
+    Processor proc(fFlags, fViewMatrix);
+    SkASSERT(proc.instanceStride() == (size_t)fInstanceStride);
+
+    GrPipeline::InitArgs initArgs;
+    initArgs.fCaps = &flushState->caps();
+    initArgs.fResourceProvider = flushState->resourceProvider();
+    initArgs.fDstProxy = flushState->drawOpArgs().fDstProxy;
+    auto clip = flushState->detachAppliedClip();
+    GrPipeline::FixedDynamicState fixedDynamicState(clip.scissorState().rect());
+    GrPipeline pipeline(initArgs, std::move(fProcessors), std::move(clip));
+
+    GrMesh mesh(GrPrimitiveType::kTriangles);
+    mesh.setIndexedInstanced(std::move(indexBuffer), 6 * fLOD.width() * fLOD.height(),
+                             fInstanceBuffer, fInstanceCount, fBaseInstance,
+                             GrPrimitiveRestart::kNo);
+    mesh.setVertexData(std::move(vertexBuffer));
+    flushState->rtCommandBuffer()->draw(proc, pipeline, &fixedDynamicState, nullptr, &mesh, 1,
+                                        this->bounds());
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrDrawPatchOp_DEFINED
+#define GrDrawPatchOp_DEFINED
+
+#include "GrDrawOp.h"
+#include "GrProcessorSet.h"
+#include "SkMatrix.h"
+#include "SkPatchUtils.h"
+
+class GrRecordingContext;
+
+/**
+ * Draws Coons patches (see SkCanvas::drawPatch()) by evaluating them in the vertex shader. Each
+ * patch is an instance holding its 12 control points, corner colors and corner texture coords,
+ * drawn over a static grid of (u, v) vertices, so patches that move every frame (e.g. a mesh
+ * warp) are never tessellated on the CPU. Patches with the same view matrix and bucketed level of
+ * detail (see SkPatchUtils::GetBucketedLevelOfDetail()) combine into one instanced draw.
+ */
+class GrDrawPatchOp : public GrDrawOp {
+public:
+    DEFINE_OP_CLASS_ID
+
+    /**
+     * Returns null if instanced attributes can't draw the patch, in which case the caller should
+     * tessellate it with SkPatchUtils instead. The corner colors, if any, must be premultiplied and
+     * in the destination's color space; without them the paint's color is used. texCoords, if any,
+     * are the local coords of the corners, otherwise the patch's own coords are.
+     */
+    static std::unique_ptr<GrDrawOp> Make(GrRecordingContext*,
+                                          GrPaint&&,
+                                          const SkMatrix& viewMatrix,
+                                          const SkPoint cubics[SkPatchUtils::kNumCtrlPts],
+                                          const SkPMColor4f colors[SkPatchUtils::kNumCorners],
+                                          const SkPoint texCoords[SkPatchUtils::kNumCorners]);
+
+    const char* name() const override { return "GrDrawPatchOp"; }
+    FixedFunctionFlags fixedFunctionFlags() const override { return FixedFunctionFlags::kNone; }
+    GrProcessorSet::Analysis finalize(
+            const GrCaps&, const GrAppliedClip*, GrFSAAType, GrClampType) override;
+    CombineResult onCombineIfPossible(GrOp*, const GrCaps&) override;
+    void visitProxies(const VisitProxyFunc& fn, VisitorType) const override {
+        fProcessors.visitProxies(fn);
+    }
+    void onPrepare(GrOpFlushState*) override;
+
+    void onExecute(GrOpFlushState*, const SkRect& chainBounds) override;
+
+private:
+    enum class Flags {
+        kNone = 0,
+        kHasTexCoords = 1 << 0,
+        kWideColor = 1 << 1
+    };
+
+    GR_DECL_BITFIELD_CLASS_OPS_FRIENDS(Flags);
+
+    class Processor;
+
+    GrDrawPatchOp(GrPaint&&, const SkMatrix& viewMatrix, SkISize lod,
+                  const SkPoint cubics[SkPatchUtils::kNumCtrlPts],
+                  const SkPMColor4f colors[SkPatchUtils::kNumCorners],
+                  const SkPoint texCoords[SkPatchUtils::kNumCorners]);
+
+    template <typename T> inline void* appendInstanceData(int count) {
+        static_assert(std::is_pod<T>::value, "");
+        static_assert(4 == alignof(T), "");
+        return fInstanceData.push_back_n(sizeof(T) * count);
+    }
+
+    const SkMatrix fViewMatrix;
+    const SkISize fLOD;
+    const SkPMColor4f fOriginalColor;
+    bool fHasColors;
+    SkPMColor4f fColors[SkPatchUtils::kNumCorners];
+    bool fHasTexCoords;
+    SkPoint fTexCoords[SkPatchUtils::kNumCorners];
+    Flags fFlags = Flags::kNone;
+    GrProcessorSet fProcessors;
+
+    SkSTArray<sizeof(float) * 40, char, /*MEM_MOVE=*/ true> fInstanceData;
+    int fInstanceCount = 1;
+    int fInstanceStride = 0;
+
+    sk_sp<const GrBuffer> fInstanceBuffer;
+    int fBaseInstance;
+
+    friend class GrOpMemoryPool;
+};
+
+GR_MAKE_BITFIELD_CLASS_OPS(GrDrawPatchOp::Flags)
+
+#endif
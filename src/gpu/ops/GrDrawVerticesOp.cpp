@@ -9,12 +9,46 @@
 #include "GrCaps.h"
 #include "GrDefaultGeoProcFactory.h"
 #include "GrOpFlushState.h"
+#include "GrRecordingContextPriv.h"
 #include "GrSimpleMeshDrawOpHelper.h"
+#include "SkAutoMalloc.h"
 #include "SkGr.h"
 #include "SkRectPriv.h"
 
 namespace {
 
+// Returns the bounds of the positions SkVertices::applyBones() would produce, without copying
+// the vertices.
+static SkRect skinned_bounds(const SkVertices& vertices, const SkVertices::Bone bones[],
+                             int boneCount) {
+    const SkPoint* positions = vertices.positions();
+    const SkVertices::BoneIndices* boneIndices = vertices.boneIndices();
+    const SkVertices::BoneWeights* boneWeights = vertices.boneWeights();
+    if (!vertices.vertexCount()) {
+        return SkRect::MakeEmpty();
+    }
+    Sk2f min(SK_ScalarInfinity), max(SK_ScalarNegativeInfinity);
+    for (int i = 0; i < vertices.vertexCount(); ++i) {
+        SkPoint world = bones[0].mapPoint(positions[i]);
+        SkPoint result = SkPoint::Make(0.0f, 0.0f);
+        for (int j = 0; j < 4; ++j) {
+            int index = boneIndices[i][j];
+            float weight = boneWeights[i][j];
+            if (index == 0 || weight == 0.0f) {
+                continue;
+            }
+            SkASSERT(index < boneCount);
+            result += bones[index].mapPoint(world) * weight;
+        }
+        Sk2f p = Sk2f::Load(&result);
+        min = Sk2f::Min(min, p);
+        max = Sk2f::Max(max, p);
+    }
+    SkRect bounds;
+    Sk4f(min[0], min[1], max[0], max[1]).store(&bounds);
+    return bounds;
+}
+
 class DrawVerticesOp final : public GrMeshDrawOp {
 private:
     using Helper = GrSimpleMeshDrawOpHelper;
@@ -23,8 +57,9 @@ public:
     DEFINE_OP_CLASS_ID
 
     DrawVerticesOp(const Helper::MakeArgs&, const SkPMColor4f&, sk_sp<SkVertices>,
-                   const SkVertices::Bone bones[], int boneCount, GrPrimitiveType, GrAAType,
-                   sk_sp<GrColorSpaceXform>, const SkMatrix& viewMatrix);
+                   const SkVertices::Bone bones[], int boneCount, bool skinOnGpu,
+                   GrPrimitiveType, GrAAType, sk_sp<GrColorSpaceXform>,
+                   const SkMatrix& viewMatrix);
 
     const char* name() const override { return "DrawVerticesOp"; }
 
@@ -78,11 +113,13 @@ private:
     }
 
     CombineResult onCombineIfPossible(GrOp* t, const GrCaps&) override;
+    CombineResult combineSkinned(DrawVerticesOp* that);
 
     struct Mesh {
         SkPMColor4f fColor;  // Used if this->hasPerVertexColors() is false.
         sk_sp<SkVertices> fVertices;
         SkMatrix fViewMatrix;
+        int fFirstBone;  // This mesh's world transform in fBones, if this->isSkinned().
         bool fIgnoreTexCoords;
         bool fIgnoreColors;
 
@@ -112,6 +149,10 @@ private:
         return SkToBool(kHasMultipleViewMatrices_Flag & fFlags);
     }
 
+    // Skinned ops deform their meshes' positions by fBones in the vertex shader. Every mesh is an
+    // instance of the same non-volatile vertices, whose buffers are cached undeformed.
+    bool isSkinned() const { return !fBones.empty(); }
+
     enum Flags {
         kRequiresPerVertexColors_Flag       = 0x1,
         kAnyMeshHasExplicitLocalCoords_Flag = 0x2,
@@ -120,6 +161,7 @@ private:
 
     Helper fHelper;
     SkSTArray<1, Mesh, true> fMeshes;
+    SkTArray<SkVertices::Bone, true> fBones;
     // GrPrimitiveType is more expressive than fVertices.mode() so it is used instead and we ignore
     // the SkVertices mode (though fPrimitiveType may have been inferred from it).
     GrPrimitiveType fPrimitiveType;
@@ -134,8 +176,8 @@ private:
 
 DrawVerticesOp::DrawVerticesOp(const Helper::MakeArgs& helperArgs, const SkPMColor4f& color,
                                sk_sp<SkVertices> vertices, const SkVertices::Bone bones[],
-                               int boneCount, GrPrimitiveType primitiveType, GrAAType aaType,
-                               sk_sp<GrColorSpaceXform> colorSpaceXform,
+                               int boneCount, bool skinOnGpu, GrPrimitiveType primitiveType,
+                               GrAAType aaType, sk_sp<GrColorSpaceXform> colorSpaceXform,
                                const SkMatrix& viewMatrix)
         : INHERITED(ClassID())
         , fHelper(helperArgs, aaType)
@@ -152,12 +194,22 @@ DrawVerticesOp::DrawVerticesOp(const Helper::MakeArgs& helperArgs, const SkPMCol
     mesh.fColor = color;
     mesh.fViewMatrix = viewMatrix;
     mesh.fVertices = std::move(vertices);
+    mesh.fFirstBone = 0;
     mesh.fIgnoreTexCoords = false;
     mesh.fIgnoreColors = false;
 
-    if (mesh.fVertices->hasBones() && bones) {
-        // Perform the transformations on the CPU instead of the GPU.
-        mesh.fVertices = mesh.fVertices->applyBones(bones, boneCount);
+    SkRect bounds = mesh.fVertices->bounds();
+    if (mesh.fVertices->hasBones() && bones && boneCount > 1) {
+        if (skinOnGpu) {
+            // Keep the undeformed vertices, so their buffers stay cached from frame to frame, and
+            // let the vertex shader apply the bones.
+            fBones.push_back_n(boneCount, bones);
+            bounds = skinned_bounds(*mesh.fVertices, bones, boneCount);
+        } else {
+            // Perform the transformations on the CPU instead of the GPU.
+            mesh.fVertices = mesh.fVertices->applyBones(bones, boneCount);
+            bounds = mesh.fVertices->bounds();
+        }
     } else {
         SkASSERT(!bones || boneCount == 1);
     }
@@ -170,9 +222,9 @@ DrawVerticesOp::DrawVerticesOp(const Helper::MakeArgs& helperArgs, const SkPMCol
         fFlags |= kAnyMeshHasExplicitLocalCoords_Flag;
     }
 
-    // Special case for meshes with a world transform but no bone weights.
+    // Special case for meshes with a world transform but no bone deformations.
     // These will be considered normal vertices draws without bones.
-    if (!mesh.fVertices->hasBones() && boneCount == 1) {
+    if (boneCount == 1) {
         SkMatrix worldTransform;
         worldTransform.setAffine(bones[0].values);
         mesh.fViewMatrix.preConcat(worldTransform);
@@ -185,7 +237,7 @@ DrawVerticesOp::DrawVerticesOp(const Helper::MakeArgs& helperArgs, const SkPMCol
         zeroArea = IsZeroArea::kNo;
     }
 
-    this->setTransformedBounds(mesh.fVertices->bounds(),
+    this->setTransformedBounds(bounds,
                                 mesh.fViewMatrix,
                                 HasAABloat::kNo,
                                 zeroArea);
@@ -263,6 +315,14 @@ sk_sp<GrGeometryProcessor> DrawVerticesOp::makeGP(const GrShaderCaps* shaderCaps
 
     const SkMatrix& vm = this->hasMultipleViewMatrices() ? SkMatrix::I() : fMeshes[0].fViewMatrix;
 
+    if (this->isSkinned()) {
+        return GrDefaultGeoProcFactory::MakeWithBones(shaderCaps,
+                                                      color,
+                                                      Coverage::kSolid_Type,
+                                                      localCoordsType,
+                                                      Bones(fBones.begin(), fBones.count()),
+                                                      vm);
+    }
     return GrDefaultGeoProcFactory::Make(shaderCaps,
                                             color,
                                             Coverage::kSolid_Type,
@@ -271,8 +331,7 @@ sk_sp<GrGeometryProcessor> DrawVerticesOp::makeGP(const GrShaderCaps* shaderCaps
 }
 
 void DrawVerticesOp::onPrepareDraws(Target* target) {
-    bool hasMapBufferSupport = GrCaps::kNone_MapFlags != target->caps().mapBufferFlags();
-    if (fMeshes[0].fVertices->isVolatile() || !hasMapBufferSupport) {
+    if (fMeshes[0].fVertices->isVolatile()) {
         this->drawVolatile(target);
     } else {
         this->drawNonVolatile(target);
@@ -328,17 +387,20 @@ void DrawVerticesOp::drawNonVolatile(Target* target) {
                                                  &hasColorAttribute,
                                                  &hasLocalCoordsAttribute);
 
-    SkASSERT(fMeshes.count() == 1); // Non-volatile meshes should never combine.
+    // Non-volatile meshes should never combine, except as instances of a skinned op's mesh.
+    SkASSERT(fMeshes.count() == 1 || this->isSkinned());
 
     // Get the resource provider.
     GrResourceProvider* rp = target->resourceProvider();
 
-    // Generate keys for the buffers.
+    // Generate keys for the buffers. The same vertices may be drawn by paints that need different
+    // attributes, so the vertex buffer's key includes its layout (which its stride identifies).
+    size_t vertexStride = gp->vertexStride();
     GrUniqueKey vertexKey, indexKey;
     GrUniqueKey::Builder vertexKeyBuilder(&vertexKey, kDomain, 2);
     GrUniqueKey::Builder indexKeyBuilder(&indexKey, kDomain, 2);
     vertexKeyBuilder[0] = indexKeyBuilder[0] = fMeshes[0].fVertices->uniqueID();
-    vertexKeyBuilder[1] = 0;
+    vertexKeyBuilder[1] = SkToU32(vertexStride) << 1;
     indexKeyBuilder[1] = 1;
     vertexKeyBuilder.finish();
     indexKeyBuilder.finish();
@@ -356,38 +418,56 @@ void DrawVerticesOp::drawNonVolatile(Target* target) {
     }
 
     // Allocate vertex buffer.
-    size_t vertexStride = gp->vertexStride();
-    vertexBuffer = rp->createBuffer(
-            fVertexCount * vertexStride, GrGpuBufferType::kVertex, kStatic_GrAccessPattern);
-    void* verts = vertexBuffer ? vertexBuffer->map() : nullptr;
-    if (!verts) {
+    size_t vertexSize = fVertexCount * vertexStride;
+    vertexBuffer = rp->createBuffer(vertexSize, GrGpuBufferType::kVertex, kStatic_GrAccessPattern);
+    if (!vertexBuffer) {
         SkDebugf("Could not allocate vertices\n");
         return;
     }
 
     // Allocate index buffer.
-    uint16_t* indices = nullptr;
+    size_t indexSize = fIndexCount * sizeof(uint16_t);
     if (this->isIndexed()) {
-        indexBuffer = rp->createBuffer(
-                fIndexCount * sizeof(uint16_t), GrGpuBufferType::kIndex, kStatic_GrAccessPattern);
-        indices = indexBuffer ? static_cast<uint16_t*>(indexBuffer->map()) : nullptr;
-        if (!indices) {
+        indexBuffer = rp->createBuffer(indexSize, GrGpuBufferType::kIndex,
+                                       kStatic_GrAccessPattern);
+        if (!indexBuffer) {
             SkDebugf("Could not allocate indices\n");
             return;
         }
     }
 
-    // Fill the buffers.
+    // Fill the buffers, directly if they can be mapped, otherwise through CPU storage.
+    bool hasMapBufferSupport = GrCaps::kNone_MapFlags != target->caps().mapBufferFlags();
+    void* verts = hasMapBufferSupport ? vertexBuffer->map() : nullptr;
+    uint16_t* indices = indexBuffer && hasMapBufferSupport
+            ? static_cast<uint16_t*>(indexBuffer->map()) : nullptr;
+    SkAutoMalloc vertexStorage, indexStorage;
+    if (!verts) {
+        verts = vertexStorage.reset(vertexSize);
+    }
+    if (indexBuffer && !indices) {
+        indices = static_cast<uint16_t*>(indexStorage.reset(indexSize));
+    }
     this->fillBuffers(hasColorAttribute,
                       hasLocalCoordsAttribute,
                       vertexStride,
                       verts,
                       indices);
 
-    // Unmap the buffers.
-    vertexBuffer->unmap();
+    // Unmap or update the buffers.
+    if (vertexBuffer->isMapped()) {
+        vertexBuffer->unmap();
+    } else if (!vertexBuffer->updateData(verts, vertexSize)) {
+        SkDebugf("Could not upload vertices\n");
+        return;
+    }
     if (indexBuffer) {
-        indexBuffer->unmap();
+        if (indexBuffer->isMapped()) {
+            indexBuffer->unmap();
+        } else if (!indexBuffer->updateData(indices, indexSize)) {
+            SkDebugf("Could not upload indices\n");
+            return;
+        }
     }
 
     // Cache the buffers.
@@ -404,13 +484,14 @@ void DrawVerticesOp::fillBuffers(bool hasColorAttribute,
                                  size_t vertexStride,
                                  void* verts,
                                  uint16_t* indices) const {
-    int instanceCount = fMeshes.count();
+    // A skinned op's meshes are all instances of the first one's vertices.
+    int instanceCount = this->isSkinned() ? 1 : fMeshes.count();
 
     // Copy data into the buffers.
     int vertexOffset = 0;
     // We have a fast case below for uploading the vertex data when the matrix is translate
-    // only and there are colors but not local coords.
-    bool fastAttrs = hasColorAttribute && !hasLocalCoordsAttribute;
+    // only and there are colors but not local coords (or bones).
+    bool fastAttrs = hasColorAttribute && !hasLocalCoordsAttribute && !this->isSkinned();
     for (int i = 0; i < instanceCount; i++) {
         // Get each mesh.
         const Mesh& mesh = fMeshes[i];
@@ -460,6 +541,8 @@ void DrawVerticesOp::fillBuffers(bool hasColorAttribute,
             if (hasLocalCoordsAttribute) {
                 offset += sizeof(SkPoint);
             }
+            size_t boneIndexOffset = offset;
+            size_t boneWeightOffset = offset + sizeof(uint32_t);
 
             // TODO4F: Preserve float colors
             GrColor color = mesh.fColor.toBytes_RGBA();
@@ -484,6 +567,18 @@ void DrawVerticesOp::fillBuffers(bool hasColorAttribute,
                         *(SkPoint*)((intptr_t)verts + localCoordOffset) = positions[j];
                     }
                 }
+                if (this->isSkinned()) {
+                    // Unused slots get zero weight, so the shader needn't special case bone 0.
+                    const SkVertices::BoneIndices& boneIndices = mesh.fVertices->boneIndices()[j];
+                    const SkVertices::BoneWeights& boneWeights = mesh.fVertices->boneWeights()[j];
+                    uint8_t* vertexIndices = (uint8_t*)((intptr_t)verts + boneIndexOffset);
+                    float* vertexWeights = (float*)((intptr_t)verts + boneWeightOffset);
+                    for (int k = 0; k < 4; ++k) {
+                        uint32_t index = SkTMin(boneIndices[k], 255u);
+                        vertexIndices[k] = SkToU8(index);
+                        vertexWeights[k] = index ? boneWeights[k] : 0.0f;
+                    }
+                }
                 verts = (void*)((intptr_t)verts + vertexStride);
             }
         }
@@ -498,7 +593,29 @@ void DrawVerticesOp::drawVertices(Target* target,
                                   sk_sp<const GrBuffer> indexBuffer,
                                   int firstIndex) {
     GrMesh* mesh = target->allocMesh(this->primitiveType());
-    if (this->isIndexed()) {
+    if (this->isSkinned()) {
+        // Each instance reads its bones starting at its world transform.
+        SkASSERT(0 == firstVertex && 0 == firstIndex);
+        sk_sp<const GrBuffer> instanceBuffer;
+        int firstInstance = 0;
+        float* firstBones = static_cast<float*>(target->makeVertexSpace(
+                sizeof(float), fMeshes.count(), &instanceBuffer, &firstInstance));
+        if (!firstBones) {
+            SkDebugf("Could not allocate instances\n");
+            return;
+        }
+        for (int i = 0; i < fMeshes.count(); ++i) {
+            firstBones[i] = fMeshes[i].fFirstBone;
+        }
+        if (this->isIndexed()) {
+            mesh->setIndexedInstanced(std::move(indexBuffer), fIndexCount,
+                                      std::move(instanceBuffer), fMeshes.count(), firstInstance,
+                                      GrPrimitiveRestart::kNo);
+        } else {
+            mesh->setInstanced(std::move(instanceBuffer), fMeshes.count(), firstInstance,
+                               fVertexCount);
+        }
+    } else if (this->isIndexed()) {
         mesh->setIndexed(std::move(indexBuffer), fIndexCount, firstIndex, 0, fVertexCount - 1,
                          GrPrimitiveRestart::kNo);
     } else {
@@ -519,6 +636,10 @@ GrOp::CombineResult DrawVerticesOp::onCombineIfPossible(GrOp* t, const GrCaps& c
         return CombineResult::kCannotCombine;
     }
 
+    if (this->isSkinned() || that->isSkinned()) {
+        return this->combineSkinned(that);
+    }
+
     // Non-volatile meshes cannot batch, because if a non-volatile mesh batches with another mesh,
     // then on the next frame, if that non-volatile mesh is drawn, it will draw the other mesh
     // that was saved in its vertex buffer, which is not necessarily there anymore.
@@ -566,6 +687,34 @@ GrOp::CombineResult DrawVerticesOp::onCombineIfPossible(GrOp* t, const GrCaps& c
     return CombineResult::kMerged;
 }
 
+GrOp::CombineResult DrawVerticesOp::combineSkinned(DrawVerticesOp* that) {
+    // Skinned draws of the same vertices become instances of one draw over the cached buffers,
+    // as long as only their bones differ and the bones of them all fit in the GP.
+    if (!this->isSkinned() || !that->isSkinned() ||
+        fMeshes[0].fVertices->uniqueID() != that->fMeshes[0].fVertices->uniqueID() ||
+        fBones.count() + that->fBones.count() > GrDefaultGeoProcFactory::kMaxBones) {
+        return CombineResult::kCannotCombine;
+    }
+
+    if (this->primitiveType() != that->primitiveType() || fFlags != that->fFlags ||
+        fColorArrayType != that->fColorArrayType ||
+        !fMeshes[0].fViewMatrix.cheapEqualTo(that->fMeshes[0].fViewMatrix)) {
+        return CombineResult::kCannotCombine;
+    }
+
+    if (!this->requiresPerVertexColors() && fMeshes[0].fColor != that->fMeshes[0].fColor) {
+        return CombineResult::kCannotCombine;
+    }
+
+    int firstBone = fBones.count();
+    for (const Mesh& mesh : that->fMeshes) {
+        fMeshes.push_back(mesh).fFirstBone += firstBone;
+    }
+    fBones.push_back_n(that->fBones.count(), that->fBones.begin());
+
+    return CombineResult::kMerged;
+}
+
 } // anonymous namespace
 
 std::unique_ptr<GrDrawOp> GrDrawVerticesOp::Make(GrRecordingContext* context,
@@ -580,9 +729,14 @@ std::unique_ptr<GrDrawOp> GrDrawVerticesOp::Make(GrRecordingContext* context,
     SkASSERT(vertices);
     GrPrimitiveType primType = overridePrimType ? *overridePrimType
                                                 : SkVertexModeToGrPrimitiveType(vertices->mode());
+    // Deforming non-volatile vertices on the GPU lets their buffers be cached and shared by
+    // instances with other bones. Volatile vertices are uploaded every draw either way.
+    bool skinOnGpu = vertices->hasBones() && !vertices->isVolatile() &&
+                     boneCount > 1 && boneCount <= GrDefaultGeoProcFactory::kMaxBones &&
+                     context->priv().caps()->instanceAttribSupport();
     return GrSimpleMeshDrawOpHelper::FactoryHelper<DrawVerticesOp>(context, std::move(paint),
                                                                    std::move(vertices),
-                                                                   bones, boneCount,
+                                                                   bones, boneCount, skinOnGpu,
                                                                    primType, aaType,
                                                                    std::move(colorSpaceXform),
                                                                    viewMatrix);
@@ -13,12 +13,16 @@
 #include "GrPaint.h"
 #include "GrQuad.h"
 #include "GrQuadPerEdgeAA.h"
+#include "GrResourceProvider.h"
 #include "GrSimpleMeshDrawOpHelper.h"
+#include "GrVertexWriter.h"
 #include "SkMatrix.h"
 #include "SkRect.h"
 #include "glsl/GrGLSLColorSpaceXformHelper.h"
+#include "glsl/GrGLSLFragmentShaderBuilder.h"
 #include "glsl/GrGLSLGeometryProcessor.h"
 #include "glsl/GrGLSLVarying.h"
+#include "glsl/GrGLSLVertexGeoBuilder.h"
 
 namespace {
 
@@ -52,6 +56,105 @@ static SkString dump_quad_info(int index, const GrPerspQuad& deviceQuad,
 }
 #endif
 
+// Draws each quad as an instance of the unit square, positioned by the parallelogram its corners
+// span in device space (and, optionally, local space). This only works for quads whose opposite
+// sides are parallel and that need no coverage AA, but writes one instance per quad rather than
+// four vertices.
+class InstancedRectProcessor : public GrGeometryProcessor {
+public:
+    InstancedRectProcessor(ColorType colorType, bool hasLocalCoords)
+            : GrGeometryProcessor(kGrFillRectOp_InstancedProcessor_ClassID)
+            , fColorType(colorType)
+            , fHasLocalCoords(hasLocalCoords) {
+        this->setVertexAttributes(&kCorner, 1);
+        fDeviceOrigin = {"deviceOrigin", kFloat2_GrVertexAttribType, kFloat2_GrSLType};
+        fDeviceAxes = {"deviceAxes", kFloat4_GrVertexAttribType, kFloat4_GrSLType};
+        if (colorType != ColorType::kNone) {
+            fColor = MakeColorAttribute("color", colorType == ColorType::kHalf);
+        }
+        if (hasLocalCoords) {
+            fLocalOrigin = {"localOrigin", kFloat2_GrVertexAttribType, kFloat2_GrSLType};
+            fLocalAxes = {"localAxes", kFloat4_GrVertexAttribType, kFloat4_GrSLType};
+        }
+        this->setInstanceAttributes(&fDeviceOrigin, 5);
+    }
+
+    const char* name() const override { return "InstancedRectProcessor"; }
+
+    void getGLSLProcessorKey(const GrShaderCaps&, GrProcessorKeyBuilder* b) const override {
+        b->add32(static_cast<uint32_t>(fColorType) | (fHasLocalCoords ? 0x4 : 0x0));
+    }
+
+    GrGLSLPrimitiveProcessor* createGLSLInstance(const GrShaderCaps&) const override;
+
+    // The unit square's corners, in the same order as GrPerspQuad's, drawn as a triangle strip.
+    static constexpr float kCornerData[] = {0, 0,  0, 1,  1, 0,  1, 1};
+
+private:
+    static constexpr Attribute kCorner = {"corner", kFloat2_GrVertexAttribType, kFloat2_GrSLType};
+
+    // Each origin is a quad's first corner, and each axes attribute holds the vectors from it to
+    // the third corner (xy) and the second corner (zw).
+    Attribute fDeviceOrigin;
+    Attribute fDeviceAxes;
+    Attribute fColor;        // Conditional.
+    Attribute fLocalOrigin;  // Conditional.
+    Attribute fLocalAxes;    // Conditional.
+
+    ColorType fColorType;
+    bool fHasLocalCoords;
+
+    class Impl;
+
+    typedef GrGeometryProcessor INHERITED;
+};
+
+constexpr float InstancedRectProcessor::kCornerData[];
+constexpr GrPrimitiveProcessor::Attribute InstancedRectProcessor::kCorner;
+
+GR_DECLARE_STATIC_UNIQUE_KEY(gCornerBufferKey);
+
+class InstancedRectProcessor::Impl : public GrGLSLGeometryProcessor {
+public:
+    void onEmitCode(EmitArgs& args, GrGPArgs* gpArgs) override {
+        const auto& proc = args.fGP.cast<InstancedRectProcessor>();
+
+        GrGLSLVaryingHandler* varyings = args.fVaryingHandler;
+        varyings->emitAttributes(proc);
+
+        GrGLSLVertexBuilder* v = args.fVertBuilder;
+        v->codeAppend("float2 devicePos = deviceOrigin + corner.x * deviceAxes.xy + "
+                                         "corner.y * deviceAxes.zw;");
+        gpArgs->fPositionVar.set(kFloat2_GrSLType, "devicePos");
+
+        GrShaderVar localCoord("", kFloat2_GrSLType);
+        if (proc.fHasLocalCoords) {
+            v->codeAppend("float2 localPos = localOrigin + corner.x * localAxes.xy + "
+                                            "corner.y * localAxes.zw;");
+            localCoord.set(kFloat2_GrSLType, "localPos");
+        }
+        this->emitTransforms(v, varyings, args.fUniformHandler, localCoord,
+                             args.fFPCoordTransformHandler);
+
+        if (proc.fColor.isInitialized()) {
+            varyings->addPassThroughAttribute(proc.fColor, args.fOutputColor,
+                                              GrGLSLVaryingHandler::Interpolation::kCanBeFlat);
+        } else {
+            args.fFragBuilder->codeAppendf("%s = half4(1);", args.fOutputColor);
+        }
+        args.fFragBuilder->codeAppendf("%s = half4(1);", args.fOutputCoverage);
+    }
+
+    void setData(const GrGLSLProgramDataManager& pdman, const GrPrimitiveProcessor&,
+                 FPCoordTransformIter&& transformIter) override {
+        this->setTransformDataHelper(SkMatrix::I(), pdman, &transformIter);
+    }
+};
+
+GrGLSLPrimitiveProcessor* InstancedRectProcessor::createGLSLInstance(const GrShaderCaps&) const {
+    return new Impl();
+}
+
 class FillRectOp final : public GrMeshDrawOp {
 private:
     using Helper = GrSimpleMeshDrawOpHelperWithStencil;
@@ -192,9 +295,68 @@ private:
             const GrRenderTargetContext::QuadSetEntry quads[], int quadCount,
             const GrUserStencilSettings*);
 
+    // Can every quad be drawn as an instance of the unit square? That requires them to be
+    // parallelograms (in local space too), and to not need the outsets of coverage AA.
+    bool canDrawInstanced(const GrCaps& caps) const {
+        return caps.instancedRectSupport() && fHelper.aaType() != GrAAType::kCoverage &&
+               fDeviceQuads.quadType() <= GrQuadType::kRectilinear &&
+               (!fHelper.usesLocalCoords() || fLocalQuads.quadType() <= GrQuadType::kRectilinear);
+    }
+
+    void prepareInstancedDraws(Target* target) {
+        GR_DEFINE_STATIC_UNIQUE_KEY(gCornerBufferKey);
+
+        sk_sp<const GrBuffer> cornerBuffer = target->resourceProvider()->findOrMakeStaticBuffer(
+                GrGpuBufferType::kVertex, sizeof(InstancedRectProcessor::kCornerData),
+                InstancedRectProcessor::kCornerData, gCornerBufferKey);
+        if (!cornerBuffer) {
+            SkDebugf("Could not allocate vertices\n");
+            return;
+        }
+
+        bool hasLocalCoords = fHelper.usesLocalCoords();
+        sk_sp<GrGeometryProcessor> gp = sk_make_sp<InstancedRectProcessor>(fColorType,
+                                                                           hasLocalCoords);
+        sk_sp<const GrBuffer> instanceBuffer;
+        int baseInstance = 0;
+        GrVertexWriter instances{target->makeVertexSpace(gp->instanceStride(), this->quadCount(),
+                                                         &instanceBuffer, &baseInstance)};
+        if (!instances.fPtr) {
+            SkDebugf("Could not allocate vertices\n");
+            return;
+        }
+
+        for (int i = 0; i < this->quadCount(); ++i) {
+            GrPerspQuad device = fDeviceQuads[i];
+            instances.write(device.x(0), device.y(0),
+                            device.x(2) - device.x(0), device.y(2) - device.y(0),
+                            device.x(1) - device.x(0), device.y(1) - device.y(0));
+            if (fColorType != ColorType::kNone) {
+                instances.write(GrVertexColor(fDeviceQuads.metadata(i).fColor,
+                                              fColorType == ColorType::kHalf));
+            }
+            if (hasLocalCoords) {
+                GrPerspQuad local = fLocalQuads[i];
+                instances.write(local.x(0), local.y(0),
+                                local.x(2) - local.x(0), local.y(2) - local.y(0),
+                                local.x(1) - local.x(0), local.y(1) - local.y(0));
+            }
+        }
+
+        GrMesh* mesh = target->allocMesh(GrPrimitiveType::kTriangleStrip);
+        mesh->setInstanced(std::move(instanceBuffer), this->quadCount(), baseInstance, 4);
+        mesh->setVertexData(std::move(cornerBuffer));
+        target->recordDraw(std::move(gp), mesh);
+    }
+
     void onPrepareDraws(Target* target) override {
         TRACE_EVENT0("skia", TRACE_FUNC);
 
+        if (this->canDrawInstanced(target->caps())) {
+            this->prepareInstancedDraws(target);
+            return;
+        }
+
         using Domain = GrQuadPerEdgeAA::Domain;
         static constexpr SkRect kEmptyDomain = SkRect::MakeEmpty();
 
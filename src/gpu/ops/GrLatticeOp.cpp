@@ -6,11 +6,13 @@
  */
 
 #include "GrLatticeOp.h"
+#include "GrCaps.h"
 #include "GrDefaultGeoProcFactory.h"
 #include "GrDrawOpTest.h"
 #include "GrGpu.h"
 #include "GrMeshDrawOp.h"
 #include "GrOpFlushState.h"
+#include "GrRecordingContextPriv.h"
 #include "GrResourceProvider.h"
 #include "GrResourceProviderPriv.h"
 #include "GrSimpleMeshDrawOpHelper.h"
@@ -18,10 +20,14 @@
 #include "SkBitmap.h"
 #include "SkLatticeIter.h"
 #include "SkMatrixPriv.h"
+#include "SkOnce.h"
 #include "SkRect.h"
 #include "glsl/GrGLSLColorSpaceXformHelper.h"
+#include "glsl/GrGLSLFragmentShaderBuilder.h"
 #include "glsl/GrGLSLGeometryProcessor.h"
+#include "glsl/GrGLSLUniformHandler.h"
 #include "glsl/GrGLSLVarying.h"
+#include "glsl/GrGLSLVertexGeoBuilder.h"
 
 namespace {
 
@@ -123,6 +129,182 @@ private:
     typedef GrGeometryProcessor INHERITED;
 };
 
+// Draws nine-patches as instances of a static 3x3 grid of rects. Each instance holds the four x and
+// four y coordinates of a patch's grid lines in device space and in texels, and the vertex shader
+// picks out the coordinates of each of its vertices and the texture domain of each of its rects.
+class InstancedLatticeGP : public GrGeometryProcessor {
+public:
+    static constexpr int kVertexCount = 9 * 6;
+
+    static sk_sp<GrGeometryProcessor> Make(GrGpu* gpu,
+                                           const GrTextureProxy* proxy,
+                                           sk_sp<GrColorSpaceXform> csxf,
+                                           GrSamplerState::Filter filter,
+                                           bool wideColor) {
+        return sk_sp<GrGeometryProcessor>(
+                new InstancedLatticeGP(gpu, proxy, std::move(csxf), filter, wideColor));
+    }
+
+    // For each vertex of the grid's 9 rects (two triangles each): the column and row of the grid
+    // lines it lies on, then the column and row of its rect.
+    static const float* VertexData() {
+        static float sData[kVertexCount * 4];
+        static SkOnce once;
+        once([] {
+            static const int kCorners[6][2] = {{0, 0}, {0, 1}, {1, 0}, {1, 0}, {0, 1}, {1, 1}};
+            float* v = sData;
+            for (int y = 0; y < 3; ++y) {
+                for (int x = 0; x < 3; ++x) {
+                    for (const auto& corner : kCorners) {
+                        *v++ = x + corner[0];
+                        *v++ = y + corner[1];
+                        *v++ = x;
+                        *v++ = y;
+                    }
+                }
+            }
+        });
+        return sData;
+    }
+
+    const char* name() const override { return "InstancedLatticeGP"; }
+
+    void getGLSLProcessorKey(const GrShaderCaps&, GrProcessorKeyBuilder* b) const override {
+        b->add32(GrColorSpaceXform::XformKey(fColorSpaceXform.get()));
+    }
+
+    GrGLSLPrimitiveProcessor* createGLSLInstance(const GrShaderCaps& caps) const override {
+        class GLSLProcessor : public GrGLSLGeometryProcessor {
+        public:
+            void setData(const GrGLSLProgramDataManager& pdman, const GrPrimitiveProcessor& proc,
+                         FPCoordTransformIter&& transformIter) override {
+                const auto& latticeGP = proc.cast<InstancedLatticeGP>();
+                this->setTransformDataHelper(SkMatrix::I(), pdman, &transformIter);
+                fColorSpaceXformHelper.setData(pdman, latticeGP.fColorSpaceXform.get());
+                pdman.set4fv(fTexCoordXformUni, 1, latticeGP.fTexCoordXform);
+            }
+
+        private:
+            void onEmitCode(EmitArgs& args, GrGPArgs* gpArgs) override {
+                const auto& latticeGP = args.fGP.cast<InstancedLatticeGP>();
+                fColorSpaceXformHelper.emitCode(args.fUniformHandler,
+                                                latticeGP.fColorSpaceXform.get());
+
+                const char* texCoordXform;
+                fTexCoordXformUni = args.fUniformHandler->addUniform(
+                        kVertex_GrShaderFlag, kFloat4_GrSLType, "texCoordXform", &texCoordXform);
+
+                GrGLSLVaryingHandler* varyings = args.fVaryingHandler;
+                varyings->emitAttributes(latticeGP);
+
+                // One-hot vectors select the coordinates of this vertex and of its rect's edges.
+                GrGLSLVertexBuilder* v = args.fVertBuilder;
+                v->codeAppend("float4 lineIndices = float4(0, 1, 2, 3);");
+                v->codeAppend("float4 selX = step(abs(lineIndices - gridCoords.x), float4(0.5));");
+                v->codeAppend("float4 selY = step(abs(lineIndices - gridCoords.y), float4(0.5));");
+                v->codeAppend("float4 selL = step(abs(lineIndices - gridCoords.z), float4(0.5));");
+                v->codeAppend("float4 selT = step(abs(lineIndices - gridCoords.w), float4(0.5));");
+                v->codeAppend("float4 selR = selL.wxyz;");
+                v->codeAppend("float4 selB = selT.wxyz;");
+                v->codeAppend("float2 position = float2(dot(selX, dstX), dot(selY, dstY));");
+                gpArgs->fPositionVar.set(kFloat2_GrSLType, "position");
+
+                // Clamp lookups to half a texel inside the rect's src, as the tessellated path
+                // does, so bilerp doesn't bleed in texels from neighboring rects.
+                v->codeAppendf("float2 texCoords = float2(dot(selX, srcX), dot(selY, srcY)) * "
+                                                  "%s.xy + %s.zw;", texCoordXform, texCoordXform);
+                v->codeAppendf("float2 domainLT = (float2(dot(selL, srcX), dot(selT, srcY)) + "
+                                                  "0.5) * %s.xy + %s.zw;",
+                               texCoordXform, texCoordXform);
+                v->codeAppendf("float2 domainRB = (float2(dot(selR, srcX), dot(selB, srcY)) - "
+                                                  "0.5) * %s.xy + %s.zw;",
+                               texCoordXform, texCoordXform);
+                this->emitTransforms(v, varyings, args.fUniformHandler,
+                                     GrShaderVar("texCoords", kFloat2_GrSLType),
+                                     args.fFPCoordTransformHandler);
+
+                GrGLSLVarying texCoords(kFloat2_GrSLType);
+                varyings->addVarying("textureCoords", &texCoords);
+                v->codeAppendf("%s = texCoords;", texCoords.vsOut());
+                GrGLSLVarying domain(kFloat4_GrSLType);
+                varyings->addVarying("textureDomain", &domain,
+                                     GrGLSLVaryingHandler::Interpolation::kCanBeFlat);
+                v->codeAppendf("%s = float4(min(domainLT, domainRB), max(domainLT, domainRB));",
+                               domain.vsOut());
+                varyings->addPassThroughAttribute(latticeGP.fInColor, args.fOutputColor,
+                                                  GrGLSLVaryingHandler::Interpolation::kCanBeFlat);
+
+                GrGLSLFPFragmentBuilder* f = args.fFragBuilder;
+                f->codeAppendf("%s = ", args.fOutputColor);
+                SkString lookup;
+                lookup.printf("clamp(%s, %s.xy, %s.zw)",
+                              texCoords.fsIn(), domain.fsIn(), domain.fsIn());
+                f->appendTextureLookupAndModulate(args.fOutputColor, args.fTexSamplers[0],
+                                                  lookup.c_str(), kFloat2_GrSLType,
+                                                  &fColorSpaceXformHelper);
+                f->codeAppend(";");
+                f->codeAppendf("%s = half4(1);", args.fOutputCoverage);
+            }
+            GrGLSLColorSpaceXformHelper fColorSpaceXformHelper;
+            UniformHandle fTexCoordXformUni;
+        };
+        return new GLSLProcessor;
+    }
+
+private:
+    InstancedLatticeGP(GrGpu* gpu, const GrTextureProxy* proxy, sk_sp<GrColorSpaceXform> csxf,
+                       GrSamplerState::Filter filter, bool wideColor)
+            : INHERITED(kInstancedLatticeGP_ClassID), fColorSpaceXform(std::move(csxf)) {
+        GrSamplerState samplerState = GrSamplerState(GrSamplerState::WrapMode::kClamp,
+                                                     filter);
+        uint32_t extraSamplerKey = gpu->getExtraSamplerKeyForProgram(samplerState,
+                                                                     proxy->backendFormat());
+
+        fSampler.reset(proxy->textureType(), proxy->config(), samplerState,
+                       extraSamplerKey);
+        this->setTextureSamplerCnt(1);
+
+        // Maps texels to normalized texture coordinates: xy scales, zw translates.
+        fTexCoordXform[0] = 1.f / proxy->width();
+        fTexCoordXform[1] = 1.f / proxy->height();
+        fTexCoordXform[2] = 0;
+        fTexCoordXform[3] = 0;
+        if (proxy->origin() == kBottomLeft_GrSurfaceOrigin) {
+            fTexCoordXform[1] = -fTexCoordXform[1];
+            fTexCoordXform[3] = 1;
+        }
+
+        this->setVertexAttributes(&kGridCoords, 1);
+        fInDstX = {"dstX", kFloat4_GrVertexAttribType, kFloat4_GrSLType};
+        fInDstY = {"dstY", kFloat4_GrVertexAttribType, kFloat4_GrSLType};
+        fInSrcX = {"srcX", kFloat4_GrVertexAttribType, kFloat4_GrSLType};
+        fInSrcY = {"srcY", kFloat4_GrVertexAttribType, kFloat4_GrSLType};
+        fInColor = MakeColorAttribute("color", wideColor);
+        this->setInstanceAttributes(&fInDstX, 5);
+    }
+
+    const TextureSampler& onTextureSampler(int) const override { return fSampler; }
+
+    static constexpr Attribute kGridCoords = {"gridCoords", kFloat4_GrVertexAttribType,
+                                              kFloat4_GrSLType};
+
+    Attribute fInDstX;
+    Attribute fInDstY;
+    Attribute fInSrcX;
+    Attribute fInSrcY;
+    Attribute fInColor;
+
+    sk_sp<GrColorSpaceXform> fColorSpaceXform;
+    TextureSampler fSampler;
+    float fTexCoordXform[4];
+
+    typedef GrGeometryProcessor INHERITED;
+};
+
+constexpr GrPrimitiveProcessor::Attribute InstancedLatticeGP::kGridCoords;
+
+GR_DECLARE_STATIC_UNIQUE_KEY(gLatticeGridKey);
+
 class NonAALatticeOp final : public GrMeshDrawOp {
 private:
     using Helper = GrSimpleMeshDrawOpHelper;
@@ -142,21 +324,28 @@ public:
                                           std::unique_ptr<SkLatticeIter> iter,
                                           const SkRect& dst) {
         SkASSERT(proxy);
+        // Scale-translate nine-patches, the common case for UI, can be drawn as instances.
+        int srcX[4], srcY[4];
+        SkScalar dstX[4], dstY[4];
+        bool instanced = context->priv().caps()->instanceAttribSupport() &&
+                         viewMatrix.isScaleTranslate() &&
+                         iter->getNinePatchGrid(srcX, srcY, dstX, dstY);
         return Helper::FactoryHelper<NonAALatticeOp>(context, std::move(paint), viewMatrix,
                                                      std::move(proxy),
                                                      std::move(colorSpaceXForm), filter,
-                                                     std::move(iter), dst);
+                                                     std::move(iter), dst, instanced);
     }
 
     NonAALatticeOp(Helper::MakeArgs& helperArgs, const SkPMColor4f& color,
                    const SkMatrix& viewMatrix, sk_sp<GrTextureProxy> proxy,
                    sk_sp<GrColorSpaceXform> colorSpaceXform, GrSamplerState::Filter filter,
-                   std::unique_ptr<SkLatticeIter> iter, const SkRect& dst)
+                   std::unique_ptr<SkLatticeIter> iter, const SkRect& dst, bool instanced)
             : INHERITED(ClassID())
             , fHelper(helperArgs, GrAAType::kNone)
             , fProxy(std::move(proxy))
             , fColorSpaceXform(std::move(colorSpaceXform))
-            , fFilter(filter) {
+            , fFilter(filter)
+            , fInstanced(instanced) {
         Patch& patch = fPatches.push_back();
         patch.fViewMatrix = viewMatrix;
         patch.fColor = color;
@@ -207,7 +396,62 @@ public:
     }
 
 private:
+    void prepareInstancedDraws(Target* target) {
+        GR_DEFINE_STATIC_UNIQUE_KEY(gLatticeGridKey);
+
+        sk_sp<const GrBuffer> gridBuffer = target->resourceProvider()->findOrMakeStaticBuffer(
+                GrGpuBufferType::kVertex, InstancedLatticeGP::kVertexCount * 4 * sizeof(float),
+                InstancedLatticeGP::VertexData(), gLatticeGridKey);
+        if (!gridBuffer) {
+            SkDebugf("Could not allocate vertices\n");
+            return;
+        }
+
+        GrGpu* gpu = target->resourceProvider()->priv().gpu();
+        auto gp = InstancedLatticeGP::Make(gpu, fProxy.get(), fColorSpaceXform, fFilter,
+                                           fWideColor);
+        int patchCnt = fPatches.count();
+        sk_sp<const GrBuffer> instanceBuffer;
+        int baseInstance;
+        GrVertexWriter instances{target->makeVertexSpace(gp->instanceStride(), patchCnt,
+                                                         &instanceBuffer, &baseInstance)};
+        if (!instances.fPtr) {
+            SkDebugf("Could not allocate vertices\n");
+            return;
+        }
+
+        for (int i = 0; i < patchCnt; i++) {
+            const Patch& patch = fPatches[i];
+            int srcX[4], srcY[4];
+            SkScalar dstX[4], dstY[4];
+            SkAssertResult(patch.fIter->getNinePatchGrid(srcX, srcY, dstX, dstY));
+
+            const SkMatrix& m = patch.fViewMatrix;
+            float texelX[4], texelY[4];
+            for (int j = 0; j < 4; ++j) {
+                dstX[j] = dstX[j] * m.getScaleX() + m.getTranslateX();
+                dstY[j] = dstY[j] * m.getScaleY() + m.getTranslateY();
+                texelX[j] = SkIntToScalar(srcX[j]);
+                texelY[j] = SkIntToScalar(srcY[j]);
+            }
+            instances.write(dstX, dstY, texelX, texelY, GrVertexColor(patch.fColor, fWideColor));
+        }
+
+        GrMesh* mesh = target->allocMesh(GrPrimitiveType::kTriangles);
+        mesh->setInstanced(std::move(instanceBuffer), patchCnt, baseInstance,
+                           InstancedLatticeGP::kVertexCount);
+        mesh->setVertexData(std::move(gridBuffer));
+        auto fixedDynamicState = target->makeFixedDynamicState(1);
+        fixedDynamicState->fPrimitiveProcessorTextures[0] = fProxy.get();
+        target->recordDraw(std::move(gp), mesh, 1, fixedDynamicState, nullptr);
+    }
+
     void onPrepareDraws(Target* target) override {
+        if (fInstanced) {
+            this->prepareInstancedDraws(target);
+            return;
+        }
+
         GrGpu* gpu = target->resourceProvider()->priv().gpu();
         auto gp = LatticeGP::Make(gpu, fProxy.get(), fColorSpaceXform, fFilter, fWideColor);
         if (!gp) {
@@ -303,7 +547,10 @@ private:
         if (fFilter != that->fFilter) {
             return CombineResult::kCannotCombine;
         }
-        if (GrColorSpaceXform::Equals(fColorSpaceXform.get(), that->fColorSpaceXform.get())) {
+        if (!GrColorSpaceXform::Equals(fColorSpaceXform.get(), that->fColorSpaceXform.get())) {
+            return CombineResult::kCannotCombine;
+        }
+        if (fInstanced != that->fInstanced) {
             return CombineResult::kCannotCombine;
         }
         if (!fHelper.isCompatible(that->fHelper, caps, this->bounds(), that->bounds())) {
@@ -328,6 +575,8 @@ private:
     sk_sp<GrColorSpaceXform> fColorSpaceXform;
     GrSamplerState::Filter fFilter;
     bool fWideColor;
+    // Whether every patch is a scale-translate nine-patch drawn by InstancedLatticeGP.
+    bool fInstanced;
 
     typedef GrMeshDrawOp INHERITED;
 };
@@ -350,7 +599,6 @@ std::unique_ptr<GrDrawOp> MakeNonAA(GrRecordingContext* context,
 
 #if GR_TEST_UTILS
 #include "GrProxyProvider.h"
-#include "GrRecordingContextPriv.h"
 
 /** Randomly divides subset into count divs. */
 static void init_random_divs(int divs[], int count, int subsetStart, int subsetStop,
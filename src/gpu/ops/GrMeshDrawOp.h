@@ -74,6 +74,10 @@ protected:
 private:
     void onPrepare(GrOpFlushState* state) final;
     virtual void onPrepareDraws(Target*) = 0;
+
+    // GrOpFlushState::StagedPrepare calls onPrepareDraws() itself.
+    friend class GrOpFlushState;
+
     typedef GrDrawOp INHERITED;
 };
 
@@ -175,6 +175,13 @@ public:
      */
     void prepare(GrOpFlushState* state) { this->onPrepare(state); }
 
+    /**
+     * Ops that return true are GrMeshDrawOps whose onPrepareDraws() only uses the Target's vertex
+     * and index space, allocator, caps, and op args. The flush may then prepare them on another
+     * thread, against a GrOpFlushState::StagedPrepare rather than the flush state itself.
+     */
+    virtual bool canPrepareConcurrently() const { return false; }
+
     /** Issues the op's commands to GrGpu. */
     void execute(GrOpFlushState* state, const SkRect& chainBounds) {
         TRACE_EVENT0("skia", name());
@@ -622,10 +622,10 @@ static CoverageMode get_mode_for_spec(const GrQuadPerEdgeAA::VertexSpec& spec) {
 }
 
 // Writes four vertices in triangle strip order, including the additional data for local
-// coordinates, domain, color, and coverage as needed to satisfy the vertex spec.
+// coordinates, domain, texture index, color, and coverage as needed to satisfy the vertex spec.
 static void write_quad(GrVertexWriter* vb, const GrQuadPerEdgeAA::VertexSpec& spec,
                        CoverageMode mode, Sk4f coverage, SkPMColor4f color4f, const SkRect& domain,
-                       const Vertices& quad) {
+                       float textureIndex, const Vertices& quad) {
     static constexpr auto If = GrVertexWriter::If<float>;
 
     for (int i = 0; i < 4; ++i) {
@@ -652,6 +652,11 @@ static void write_quad(GrVertexWriter* vb, const GrQuadPerEdgeAA::VertexSpec& sp
         if (spec.hasDomain()) {
             vb->write(domain);
         }
+
+        // save the texture index
+        if (spec.hasTextureIndex()) {
+            vb->write(textureIndex);
+        }
     }
 }
 
@@ -697,8 +702,9 @@ ColorType MinColorType(SkPMColor4f color) {
 
 void* Tessellate(void* vertices, const VertexSpec& spec, const GrPerspQuad& deviceQuad,
                  const SkPMColor4f& color4f, const GrPerspQuad& localQuad, const SkRect& domain,
-                 GrQuadAAFlags aaFlags) {
+                 GrQuadAAFlags aaFlags, int textureIndex) {
     CoverageMode mode = get_mode_for_spec(spec);
+    SkASSERT(spec.hasTextureIndex() || !textureIndex);
 
     // Load position data into Sk4fs (always x, y, and load w to avoid branching down the road)
     Vertices outer;
@@ -740,12 +746,12 @@ void* Tessellate(void* vertices, const VertexSpec& spec, const GrPerspQuad& devi
         // applied a mirror, etc. The current 2D case is already adequately fast.
 
         // Write two quads for inner and outer, inner will use the
-        write_quad(&vb, spec, mode, maxCoverage, color4f, domain, inner);
-        write_quad(&vb, spec, mode, 0.f, color4f, domain, outer);
+        write_quad(&vb, spec, mode, maxCoverage, color4f, domain, textureIndex, inner);
+        write_quad(&vb, spec, mode, 0.f, color4f, domain, textureIndex, outer);
     } else {
         // No outsetting needed, just write a single quad with full coverage
         SkASSERT(mode == CoverageMode::kNone);
-        write_quad(&vb, spec, mode, 1.f, color4f, domain, outer);
+        write_quad(&vb, spec, mode, 1.f, color4f, domain, textureIndex, outer);
     }
 
     return vb.fPtr;
@@ -804,12 +810,12 @@ public:
 
     static sk_sp<GrGeometryProcessor> Make(const VertexSpec& vertexSpec, const GrShaderCaps& caps,
                                            GrTextureType textureType, GrPixelConfig textureConfig,
-                                           const GrSamplerState& samplerState,
+                                           int textureCnt, const GrSamplerState& samplerState,
                                            uint32_t extraSamplerKey,
                                            sk_sp<GrColorSpaceXform> textureColorSpaceXform) {
         return sk_sp<QuadPerEdgeAAGeometryProcessor>(new QuadPerEdgeAAGeometryProcessor(
-                vertexSpec, caps, textureType, textureConfig, samplerState, extraSamplerKey,
-                std::move(textureColorSpaceXform)));
+                vertexSpec, caps, textureType, textureConfig, textureCnt, samplerState,
+                extraSamplerKey, std::move(textureColorSpaceXform)));
     }
 
     const char* name() const override { return "QuadPerEdgeAAGeometryProcessor"; }
@@ -817,7 +823,7 @@ public:
     void getGLSLProcessorKey(const GrShaderCaps&, GrProcessorKeyBuilder* b) const override {
         // domain, texturing, device-dimensions are single bit flags
         uint32_t x = fDomain.isInitialized() ? 0 : 1;
-        x |= fSampler.isInitialized() ? 0 : 2;
+        x |= this->numTextureSamplers() ? 0 : 2;
         x |= fNeedsPerspective ? 0 : 4;
         // local coords require 2 bits (3 choices), 00 for none, 01 for 2d, 10 for 3d
         if (fLocalCoord.isInitialized()) {
@@ -832,6 +838,10 @@ public:
             x |= CoverageMode::kWithPosition == fCoverageMode ? 128 : 256;
         }
 
+        // and the number of textures, which needs 4 bits for 0 through kMaxTextures
+        GR_STATIC_ASSERT(kMaxTextures < 16);
+        x |= this->numTextureSamplers() << 9;
+
         b->add32(GrColorSpaceXform::XformKey(fTextureColorSpaceXform.get()));
         b->add32(x);
     }
@@ -902,7 +912,7 @@ public:
 
                 // If there is a texture, must also handle texture coordinates and reading from
                 // the texture in the fragment shader before continuing to fragment processors.
-                if (gp.fSampler.isInitialized()) {
+                if (gp.numTextureSamplers()) {
                     // Texture coordinates clamped by the domain on the fragment shader; if the GP
                     // has a texture, it's guaranteed to have local coordinates
                     args.fFragBuilder->codeAppend("float2 texCoord;");
@@ -927,12 +937,32 @@ public:
                                 "texCoord = clamp(texCoord, domain.xy, domain.zw);");
                     }
 
-                    // Now modulate the starting output color by the texture lookup
-                    args.fFragBuilder->codeAppendf("%s = ", args.fOutputColor);
-                    args.fFragBuilder->appendTextureLookupAndModulate(
-                        args.fOutputColor, args.fTexSamplers[0], "texCoord", kFloat2_GrSLType,
-                        &fTextureColorSpaceXformHelper);
-                    args.fFragBuilder->codeAppend(";");
+                    // Now modulate the starting output color by the texture lookup. With several
+                    // textures, each quad's index picks one. The index is the same over a quad,
+                    // so the chosen lookup's derivatives are only off in pixels on its edges, and
+                    // those don't matter without mip maps.
+                    int textureCnt = gp.numTextureSamplers();
+                    if (textureCnt > 1) {
+                        args.fFragBuilder->codeAppend("float textureIndex;");
+                        args.fVaryingHandler->addPassThroughAttribute(
+                                gp.fTextureIndex, "textureIndex", Interpolation::kCanBeFlat);
+                    }
+                    for (int i = 0; i < textureCnt; ++i) {
+                        if (i < textureCnt - 1) {
+                            args.fFragBuilder->codeAppendf("%sif (textureIndex < %d.5) {",
+                                                           i ? "else " : "", i);
+                        } else if (i) {
+                            args.fFragBuilder->codeAppend("else {");
+                        }
+                        args.fFragBuilder->codeAppendf("%s = ", args.fOutputColor);
+                        args.fFragBuilder->appendTextureLookupAndModulate(
+                            args.fOutputColor, args.fTexSamplers[i], "texCoord", kFloat2_GrSLType,
+                            &fTextureColorSpaceXformHelper);
+                        args.fFragBuilder->codeAppend(";");
+                        if (textureCnt > 1) {
+                            args.fFragBuilder->codeAppend("}");
+                        }
+                    }
                 }
 
                 // And lastly, output the coverage calculation code
@@ -971,15 +1001,19 @@ private:
 
     QuadPerEdgeAAGeometryProcessor(const VertexSpec& spec, const GrShaderCaps& caps,
                                    GrTextureType textureType, GrPixelConfig textureConfig,
-                                   const GrSamplerState& samplerState,
+                                   int textureCnt, const GrSamplerState& samplerState,
                                    uint32_t extraSamplerKey,
                                    sk_sp<GrColorSpaceXform> textureColorSpaceXform)
             : INHERITED(kQuadPerEdgeAAGeometryProcessor_ClassID)
-            , fTextureColorSpaceXform(std::move(textureColorSpaceXform))
-            , fSampler(textureType, textureConfig, samplerState, extraSamplerKey) {
+            , fTextureColorSpaceXform(std::move(textureColorSpaceXform)) {
         SkASSERT(spec.hasLocalCoords());
+        SkASSERT(textureCnt >= 1 && textureCnt <= kMaxTextures);
+        SkASSERT(textureCnt == 1 || spec.hasTextureIndex());
+        for (int i = 0; i < textureCnt; ++i) {
+            fSamplers[i].reset(textureType, textureConfig, samplerState, extraSamplerKey);
+        }
         this->initializeAttrs(spec);
-        this->setTextureSamplerCnt(1);
+        this->setTextureSamplerCnt(textureCnt);
     }
 
     void initializeAttrs(const VertexSpec& spec) {
@@ -1017,25 +1051,30 @@ private:
             fDomain = {"domain", kFloat4_GrVertexAttribType, kFloat4_GrSLType};
         }
 
-        this->setVertexAttributes(&fPosition, 4);
+        if (spec.hasTextureIndex()) {
+            fTextureIndex = {"textureIndex", kFloat_GrVertexAttribType, kFloat_GrSLType};
+        }
+
+        this->setVertexAttributes(&fPosition, 5);
     }
 
-    const TextureSampler& onTextureSampler(int) const override { return fSampler; }
+    const TextureSampler& onTextureSampler(int i) const override { return fSamplers[i]; }
 
     Attribute fPosition; // May contain coverage as last channel
     Attribute fColor; // May have coverage modulated in if the FPs support it
     Attribute fLocalCoord;
     Attribute fDomain;
+    Attribute fTextureIndex; // Only needed when sampling from more than one texture
 
     // The positions attribute may have coverage built into it, so float3 is an ambiguous type
     // and may mean 2d with coverage, or 3d with no coverage
     bool fNeedsPerspective;
     CoverageMode fCoverageMode;
 
-    // Color space will be null and fSampler.isInitialized() returns false when the GP is configured
-    // to skip texturing.
+    // Color space will be null and there are no texture samplers when the GP is configured to
+    // skip texturing.
     sk_sp<GrColorSpaceXform> fTextureColorSpaceXform;
-    TextureSampler fSampler;
+    TextureSampler fSamplers[kMaxTextures];
 
     typedef GrGeometryProcessor INHERITED;
 };
@@ -1045,11 +1084,11 @@ sk_sp<GrGeometryProcessor> MakeProcessor(const VertexSpec& spec) {
 }
 
 sk_sp<GrGeometryProcessor> MakeTexturedProcessor(const VertexSpec& spec, const GrShaderCaps& caps,
-        GrTextureType textureType, GrPixelConfig textureConfig,
+        GrTextureType textureType, GrPixelConfig textureConfig, int textureCnt,
         const GrSamplerState& samplerState, uint32_t extraSamplerKey,
         sk_sp<GrColorSpaceXform> textureColorSpaceXform) {
     return QuadPerEdgeAAGeometryProcessor::Make(spec, caps, textureType, textureConfig,
-                                                samplerState, extraSamplerKey,
+                                                textureCnt, samplerState, extraSamplerKey,
                                                 std::move(textureColorSpaceXform));
 }
 
@@ -29,21 +29,27 @@ namespace GrQuadPerEdgeAA {
     // Gets the minimum ColorType that can represent a color.
     ColorType MinColorType(SkPMColor4f);
 
+    // The most textures a textured processor can sample from, choosing one for each quad.
+    static constexpr int kMaxTextures = 8;
+
     // Specifies the vertex configuration for an op that renders per-edge AA quads. The vertex
-    // order (when enabled) is device position, color, local position, domain, aa edge equations.
+    // order (when enabled) is device position, color, local position, domain, texture index.
     // This order matches the constructor argument order of VertexSpec and is the order that
     // GPAttributes maintains. If hasLocalCoords is false, then the local quad type can be ignored.
+    // A texture index picks which of a textured processor's textures each quad samples.
     struct VertexSpec {
     public:
         VertexSpec(GrQuadType deviceQuadType, ColorType colorType, GrQuadType localQuadType,
-                   bool hasLocalCoords, Domain domain, GrAAType aa, bool alphaAsCoverage)
+                   bool hasLocalCoords, Domain domain, GrAAType aa, bool alphaAsCoverage,
+                   bool hasTextureIndex = false)
                 : fDeviceQuadType(static_cast<unsigned>(deviceQuadType))
                 , fLocalQuadType(static_cast<unsigned>(localQuadType))
                 , fHasLocalCoords(hasLocalCoords)
                 , fColorType(static_cast<unsigned>(colorType))
                 , fHasDomain(static_cast<unsigned>(domain))
                 , fUsesCoverageAA(aa == GrAAType::kCoverage)
-                , fCompatibleWithAlphaAsCoverage(alphaAsCoverage) { }
+                , fCompatibleWithAlphaAsCoverage(alphaAsCoverage)
+                , fHasTextureIndex(hasTextureIndex) { }
 
         GrQuadType deviceQuadType() const { return static_cast<GrQuadType>(fDeviceQuadType); }
         GrQuadType localQuadType() const { return static_cast<GrQuadType>(fLocalQuadType); }
@@ -53,6 +59,7 @@ namespace GrQuadPerEdgeAA {
         bool hasDomain() const { return fHasDomain; }
         bool usesCoverageAA() const { return fUsesCoverageAA; }
         bool compatibleWithAlphaAsCoverage() const { return fCompatibleWithAlphaAsCoverage; }
+        bool hasTextureIndex() const { return fHasTextureIndex; }
 
         // Will always be 2 or 3
         int deviceDimensionality() const;
@@ -71,24 +78,27 @@ namespace GrQuadPerEdgeAA {
         unsigned fHasDomain: 1;
         unsigned fUsesCoverageAA: 1;
         unsigned fCompatibleWithAlphaAsCoverage: 1;
+        unsigned fHasTextureIndex: 1;
     };
 
     sk_sp<GrGeometryProcessor> MakeProcessor(const VertexSpec& spec);
 
+    // Samples from textureCnt textures, all of the given type, config, and sampler state. If
+    // textureCnt is more than one, the spec must have a texture index.
     sk_sp<GrGeometryProcessor> MakeTexturedProcessor(const VertexSpec& spec,
             const GrShaderCaps& caps, GrTextureType textureType, GrPixelConfig textureConfig,
-            const GrSamplerState& samplerState, uint32_t extraSamplerKey,
+            int textureCnt, const GrSamplerState& samplerState, uint32_t extraSamplerKey,
             sk_sp<GrColorSpaceXform> textureColorSpaceXform);
 
     // Fill vertices with the vertex data needed to represent the given quad. The device position,
-    // local coords, vertex color, domain, and edge coefficients will be written and/or computed
-    // based on the configuration in the vertex spec; if that attribute is disabled in the spec,
-    // then its corresponding function argument is ignored.
+    // local coords, vertex color, domain, texture index, and edge coefficients will be written
+    // and/or computed based on the configuration in the vertex spec; if that attribute is disabled
+    // in the spec, then its corresponding function argument is ignored.
     //
     // Returns the advanced pointer in vertices.
     void* Tessellate(void* vertices, const VertexSpec& spec, const GrPerspQuad& deviceQuad,
                      const SkPMColor4f& color, const GrPerspQuad& localQuad, const SkRect& domain,
-                     GrQuadAAFlags aa);
+                     GrQuadAAFlags aa, int textureIndex = 0);
 
     // The mesh will have its index data configured to meet the expectations of the Tessellate()
     // function, but it the calling code must handle filling a vertex buffer via Tessellate() and
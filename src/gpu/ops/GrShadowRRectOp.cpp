@@ -7,11 +7,14 @@
 
 #include "GrShadowRRectOp.h"
 
+#include "GrCaps.h"
 #include "GrDrawOpTest.h"
 #include "GrMemoryPool.h"
 #include "GrOpFlushState.h"
 #include "GrRecordingContext.h"
 #include "GrRecordingContextPriv.h"
+#include "GrResourceProvider.h"
+#include "GrVertexWriter.h"
 #include "SkRRectPriv.h"
 #include "effects/GrShadowGeoProc.h"
 
@@ -183,6 +186,25 @@ static const uint16_t* rrect_type_to_indices(RRectType type) {
     return nullptr;
 }
 
+// When instancing, each of these draws its shadows with one instanced draw.
+enum InstancedDraw {
+    kFillCircle_InstancedDraw,
+    kStrokeCircle_InstancedDraw,
+    kFillRRect_InstancedDraw,
+    kStrokeRRect_InstancedDraw,
+    kOverstrokeRRect_InstancedDraw,
+
+    kLast_InstancedDraw = kOverstrokeRRect_InstancedDraw
+};
+static const int kInstancedDrawCnt = kLast_InstancedDraw + 1;
+
+GR_DECLARE_STATIC_UNIQUE_KEY(gShadowCircleVertexBufferKey);
+GR_DECLARE_STATIC_UNIQUE_KEY(gShadowRRectVertexBufferKey);
+GR_DECLARE_STATIC_UNIQUE_KEY(gShadowFillCircleIndexBufferKey);
+GR_DECLARE_STATIC_UNIQUE_KEY(gShadowStrokeCircleIndexBufferKey);
+GR_DECLARE_STATIC_UNIQUE_KEY(gShadowRRectIndexBufferKey);
+GR_DECLARE_STATIC_UNIQUE_KEY(gShadowOverstrokeRRectIndexBufferKey);
+
 ///////////////////////////////////////////////////////////////////////////////
 namespace {
 
@@ -537,7 +559,146 @@ private:
 
     }
 
+    static InstancedDraw instanced_draw(const Geometry& args) {
+        if (args.fIsCircle) {
+            return kStroke_RRectType == args.fType ? kStrokeCircle_InstancedDraw
+                                                   : kFillCircle_InstancedDraw;
+        }
+        switch (args.fType) {
+            case kFill_RRectType:
+                return kFillRRect_InstancedDraw;
+            case kStroke_RRectType:
+                return kStrokeRRect_InstancedDraw;
+            case kOverstroke_RRectType:
+                return kOverstrokeRRect_InstancedDraw;
+        }
+        SK_ABORT("Invalid type");
+        return kFillRRect_InstancedDraw;
+    }
+
+    // Writes each shadow's parameters once, rather than its 9 to 28 vertices, and draws each kind
+    // of shadow as instances of its template.
+    void prepareInstancedDraws(Target* target) {
+        using Shape = GrInstancedRRectShadowGeoProc::Shape;
+        GrResourceProvider* resourceProvider = target->resourceProvider();
+
+        GR_DEFINE_STATIC_UNIQUE_KEY(gShadowCircleVertexBufferKey);
+        GR_DEFINE_STATIC_UNIQUE_KEY(gShadowRRectVertexBufferKey);
+        GR_DEFINE_STATIC_UNIQUE_KEY(gShadowFillCircleIndexBufferKey);
+        GR_DEFINE_STATIC_UNIQUE_KEY(gShadowStrokeCircleIndexBufferKey);
+        GR_DEFINE_STATIC_UNIQUE_KEY(gShadowRRectIndexBufferKey);
+        GR_DEFINE_STATIC_UNIQUE_KEY(gShadowOverstrokeRRectIndexBufferKey);
+
+        size_t vertexStride = GrInstancedRRectShadowGeoProc::kVertexStride;
+        sk_sp<const GrBuffer> circleVertexBuffer = resourceProvider->findOrMakeStaticBuffer(
+                GrGpuBufferType::kVertex,
+                GrInstancedRRectShadowGeoProc::kCircleVertexCount * vertexStride,
+                GrInstancedRRectShadowGeoProc::VertexData(Shape::kCircles),
+                gShadowCircleVertexBufferKey);
+        sk_sp<const GrBuffer> rrectVertexBuffer = resourceProvider->findOrMakeStaticBuffer(
+                GrGpuBufferType::kVertex,
+                GrInstancedRRectShadowGeoProc::kRRectVertexCount * vertexStride,
+                GrInstancedRRectShadowGeoProc::VertexData(Shape::kRRects),
+                gShadowRRectVertexBufferKey);
+        // Filled and stroked rrects share the indices after the overstroke quads.
+        sk_sp<const GrBuffer> indexBuffers[kInstancedDrawCnt];
+        indexBuffers[kFillCircle_InstancedDraw] = resourceProvider->findOrMakeStaticBuffer(
+                GrGpuBufferType::kIndex, sizeof(gFillCircleIndices), gFillCircleIndices,
+                gShadowFillCircleIndexBufferKey);
+        indexBuffers[kStrokeCircle_InstancedDraw] = resourceProvider->findOrMakeStaticBuffer(
+                GrGpuBufferType::kIndex, sizeof(gStrokeCircleIndices), gStrokeCircleIndices,
+                gShadowStrokeCircleIndexBufferKey);
+        indexBuffers[kFillRRect_InstancedDraw] = resourceProvider->findOrMakeStaticBuffer(
+                GrGpuBufferType::kIndex, kIndicesPerFillRRect * sizeof(uint16_t),
+                rrect_type_to_indices(kFill_RRectType), gShadowRRectIndexBufferKey);
+        indexBuffers[kStrokeRRect_InstancedDraw] = indexBuffers[kFillRRect_InstancedDraw];
+        indexBuffers[kOverstrokeRRect_InstancedDraw] = resourceProvider->findOrMakeStaticBuffer(
+                GrGpuBufferType::kIndex, kIndicesPerOverstrokeRRect * sizeof(uint16_t),
+                rrect_type_to_indices(kOverstroke_RRectType),
+                gShadowOverstrokeRRectIndexBufferKey);
+        if (!circleVertexBuffer || !rrectVertexBuffer) {
+            SkDebugf("Could not allocate vertices\n");
+            return;
+        }
+        for (const auto& indexBuffer : indexBuffers) {
+            if (!indexBuffer) {
+                SkDebugf("Could not allocate indices\n");
+                return;
+            }
+        }
+
+        sk_sp<GrGeometryProcessor> circleGP = GrInstancedRRectShadowGeoProc::Make(Shape::kCircles);
+        sk_sp<GrGeometryProcessor> rrectGP = GrInstancedRRectShadowGeoProc::Make(Shape::kRRects);
+
+        int instanceCounts[kInstancedDrawCnt] = {};
+        for (const Geometry& args : fGeoData) {
+            ++instanceCounts[instanced_draw(args)];
+        }
+
+        sk_sp<const GrBuffer> instanceBuffer;
+        int baseInstance;
+        GrVertexWriter instances{target->makeVertexSpace(rrectGP->instanceStride(),
+                                                         fGeoData.count(), &instanceBuffer,
+                                                         &baseInstance)};
+        if (!instances.fPtr) {
+            SkDebugf("Could not allocate vertices\n");
+            return;
+        }
+
+        for (int draw = 0; draw < kInstancedDrawCnt; ++draw) {
+            if (!instanceCounts[draw]) {
+                continue;
+            }
+            for (const Geometry& args : fGeoData) {
+                if (draw == instanced_draw(args)) {
+                    instances.write(args.fDevBounds, args.fOuterRadius, args.fUmbraInset,
+                                    args.fInnerRadius, args.fBlurRadius, args.fColor);
+                }
+            }
+
+            bool isCircle = draw <= kStrokeCircle_InstancedDraw;
+            int indexCount;
+            switch (draw) {
+                case kFillCircle_InstancedDraw:
+                    indexCount = kIndicesPerFillCircle;
+                    break;
+                case kStrokeCircle_InstancedDraw:
+                    indexCount = kIndicesPerStrokeCircle;
+                    break;
+                case kFillRRect_InstancedDraw:
+                    indexCount = kIndicesPerFillRRect;
+                    break;
+                case kStrokeRRect_InstancedDraw:
+                    indexCount = kIndicesPerStrokeRRect;
+                    break;
+                default:
+                    indexCount = kIndicesPerOverstrokeRRect;
+                    break;
+            }
+
+            GrMesh* mesh = target->allocMesh(GrPrimitiveType::kTriangles);
+            mesh->setIndexedInstanced(indexBuffers[draw], indexCount, instanceBuffer,
+                                      instanceCounts[draw], baseInstance,
+                                      GrPrimitiveRestart::kNo);
+            if (isCircle) {
+                mesh->setVertexData(circleVertexBuffer,
+                                    kFillCircle_InstancedDraw == draw
+                                            ? GrInstancedRRectShadowGeoProc::kFillCircleBaseVertex
+                                            : 0);
+            } else {
+                mesh->setVertexData(rrectVertexBuffer);
+            }
+            target->recordDraw(isCircle ? circleGP : rrectGP, mesh);
+            baseInstance += instanceCounts[draw];
+        }
+    }
+
     void onPrepareDraws(Target* target) override {
+        if (target->caps().instanceAttribSupport()) {
+            this->prepareInstancedDraws(target);
+            return;
+        }
+
         // Setup geometry processor
         sk_sp<GrGeometryProcessor> gp = GrRRectShadowGeoProc::Make();
 
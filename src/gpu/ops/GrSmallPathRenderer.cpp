@@ -11,6 +11,7 @@
 #include "GrBuffer.h"
 #include "GrCaps.h"
 #include "GrDistanceFieldGenFromVector.h"
+#include "GrDistanceFieldPathCache.h"
 #include "GrDrawOpTest.h"
 #include "GrQuad.h"
 #include "GrRenderTargetContext.h"
@@ -239,14 +240,18 @@ public:
                                           ShapeDataList* shapeList,
                                           bool gammaCorrect,
                                           const GrUserStencilSettings* stencilSettings) {
+        const GrContextOptions& options = context->priv().options();
+        GrContextOptions::PersistentCache* persistentCache =
+                options.fPersistDistanceFieldPaths ? options.fPersistentCache : nullptr;
         return Helper::FactoryHelper<SmallPathOp>(context, std::move(paint), shape, viewMatrix,
                                                   atlas, shapeCache, shapeList, gammaCorrect,
-                                                  stencilSettings);
+                                                  persistentCache, stencilSettings);
     }
 
     SmallPathOp(Helper::MakeArgs helperArgs, const SkPMColor4f& color, const GrShape& shape,
                 const SkMatrix& viewMatrix, GrDrawOpAtlas* atlas, ShapeCache* shapeCache,
                 ShapeDataList* shapeList, bool gammaCorrect,
+                GrContextOptions::PersistentCache* persistentCache,
                 const GrUserStencilSettings* stencilSettings)
             : INHERITED(ClassID()), fHelper(helperArgs, GrAAType::kCoverage, stencilSettings) {
         SkASSERT(shape.hasUnstyledKey());
@@ -268,6 +273,7 @@ public:
         fShapeCache = shapeCache;
         fShapeList = shapeList;
         fGammaCorrect = gammaCorrect;
+        fPersistentCache = persistentCache;
         fWideColor = !SkPMColor4fFitsInBytes(color);
 
     }
@@ -518,6 +524,50 @@ private:
         return GrDrawOpAtlas::ErrorCode::kSucceeded == code;
     }
 
+    bool generateDistanceField(unsigned char* dfStorage, const SkPath& path,
+                               const SkMatrix& drawMatrix, const SkIRect& devPathBounds,
+                               int width, int height) const {
+#ifndef SK_USE_LEGACY_DISTANCE_FIELDS
+        // Generate signed distance field directly from SkPath
+        bool succeed = GrGenerateDistanceFieldFromPath(dfStorage,
+                                        path, drawMatrix,
+                                        width, height, width * sizeof(unsigned char));
+        if (!succeed) {
+#endif
+            // setup bitmap backing
+            SkAutoPixmapStorage dst;
+            if (!dst.tryAlloc(SkImageInfo::MakeA8(devPathBounds.width(),
+                                                  devPathBounds.height()))) {
+                return false;
+            }
+            sk_bzero(dst.writable_addr(), dst.computeByteSize());
+
+            // rasterize path
+            SkPaint paint;
+            paint.setStyle(SkPaint::kFill_Style);
+            paint.setAntiAlias(true);
+
+            SkDraw draw;
+
+            SkRasterClip rasterClip;
+            rasterClip.setRect(devPathBounds);
+            draw.fRC = &rasterClip;
+            draw.fMatrix = &drawMatrix;
+            draw.fDst = dst;
+
+            draw.drawPathCoverage(path, paint);
+
+            // Generate signed distance field
+            SkGenerateDistanceFieldFromA8Image(dfStorage,
+                                               (const unsigned char*)dst.addr(),
+                                               dst.width(), dst.height(), dst.rowBytes());
+#ifndef SK_USE_LEGACY_DISTANCE_FIELDS
+        }
+#endif
+
+        return true;
+    }
+
     bool addDFPathToAtlas(GrMeshDrawOp::Target* target, FlushInfo* flushInfo,
                           GrDrawOpAtlas* atlas, ShapeData* shapeData, const GrShape& shape,
                           uint32_t dimension, SkScalar scale) const {
@@ -562,55 +612,31 @@ private:
         SkIRect dfBounds = devPathBounds.makeOutset(SK_DistanceFieldPad, SK_DistanceFieldPad);
         width = dfBounds.width();
         height = dfBounds.height();
-        // TODO We should really generate this directly into the plot somehow
-        SkAutoSMalloc<1024> dfStorage(width * height * sizeof(unsigned char));
+        size_t fieldSize = width * height * sizeof(unsigned char);
 
+        // The field only depends on the path and the scale, so another context (or an earlier
+        // run, through the persistent cache) may have already generated it.
         SkPath path;
         shape.asPath(&path);
-#ifndef SK_USE_LEGACY_DISTANCE_FIELDS
-        // Generate signed distance field directly from SkPath
-        bool succeed = GrGenerateDistanceFieldFromPath((unsigned char*)dfStorage.get(),
-                                        path, drawMatrix,
-                                        width, height, width * sizeof(unsigned char));
-        if (!succeed) {
-#endif
-            // setup bitmap backing
-            SkAutoPixmapStorage dst;
-            if (!dst.tryAlloc(SkImageInfo::MakeA8(devPathBounds.width(),
-                                                  devPathBounds.height()))) {
+        sk_sp<SkData> fieldKey = GrDistanceFieldPathCache::MakeKey(path, scale);
+        sk_sp<SkData> field = GrDistanceFieldPathCache::Find(*fieldKey, fieldSize,
+                                                             fPersistentCache);
+        if (!field) {
+            // TODO We should really generate this directly into the plot somehow
+            field = SkData::MakeUninitialized(fieldSize);
+            if (!this->generateDistanceField(static_cast<unsigned char*>(field->writable_data()),
+                                             path, drawMatrix, devPathBounds, width, height)) {
                 return false;
             }
-            sk_bzero(dst.writable_addr(), dst.computeByteSize());
-
-            // rasterize path
-            SkPaint paint;
-            paint.setStyle(SkPaint::kFill_Style);
-            paint.setAntiAlias(true);
-
-            SkDraw draw;
-
-            SkRasterClip rasterClip;
-            rasterClip.setRect(devPathBounds);
-            draw.fRC = &rasterClip;
-            draw.fMatrix = &drawMatrix;
-            draw.fDst = dst;
-
-            draw.drawPathCoverage(path, paint);
-
-            // Generate signed distance field
-            SkGenerateDistanceFieldFromA8Image((unsigned char*)dfStorage.get(),
-                                               (const unsigned char*)dst.addr(),
-                                               dst.width(), dst.height(), dst.rowBytes());
-#ifndef SK_USE_LEGACY_DISTANCE_FIELDS
+            GrDistanceFieldPathCache::Add(std::move(fieldKey), field, fPersistentCache);
         }
-#endif
 
         // add to atlas
         SkIPoint16 atlasLocation;
         GrDrawOpAtlas::AtlasID id;
 
         if (!this->addToAtlas(target, flushInfo, atlas,
-                              width, height, dfStorage.get(), &id, &atlasLocation)) {
+                              width, height, field->data(), &id, &atlasLocation)) {
             return false;
         }
 
@@ -861,6 +887,7 @@ private:
     ShapeCache* fShapeCache;
     ShapeDataList* fShapeList;
     bool fGammaCorrect;
+    GrContextOptions::PersistentCache* fPersistentCache;
     bool fWideColor;
 
     typedef GrMeshDrawOp INHERITED;
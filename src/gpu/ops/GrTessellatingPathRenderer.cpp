@@ -40,6 +40,14 @@ struct TessInfo {
     int       fCount;
 };
 
+// Antialiased tessellations are in device space, so they can only be reused by draws with the same
+// scale, skew and subpixel translation.
+struct AATessInfo {
+    SkScalar  fScaleX, fSkewX, fSkewY, fScaleY;
+    SkVector  fSubpixelTranslate;
+    int       fCount;
+};
+
 // When the SkPathRef genID changes, invalidate a corresponding GrResource described by key.
 class PathInvalidator : public SkPathRef::GenIDChangeListener {
 public:
@@ -147,8 +155,8 @@ GrTessellatingPathRenderer::onCanDrawPath(const CanDrawPathArgs& args) const {
     // ones to simpler algorithms. We pass on paths that have styles, though they may come back
     // around after applying the styling information to the geometry to create a filled path. In
     // the non-AA case, We skip paths that don't have a key since the real advantage of this path
-    // renderer comes from caching the tessellated geometry. In the AA case, we do not cache, so we
-    // accept paths without keys.
+    // renderer comes from caching the tessellated geometry. In the AA case, we only cache paths
+    // with keys, so we accept paths without keys.
     if (!args.fShape->style().isSimpleFill() || args.fShape->knownToBeConvex()) {
         return CanDrawPath::kNo;
     }
@@ -166,6 +174,13 @@ GrTessellatingPathRenderer::onCanDrawPath(const CanDrawPathArgs& args) const {
 
 namespace {
 
+// GrTessellator rounds screenspace tessellations to quarter pixels, so moving a path by whole
+// pixels moves its tessellation by the same amount. We tessellate cached antialiased paths with
+// the translation reduced to a quarter-pixel fraction and apply the rest when drawing.
+static SkScalar subpixel_translate(SkScalar t) {
+    return SkScalarRoundToScalar((t - SkScalarFloorToScalar(t)) * 4) * 0.25f;
+}
+
 class TessellatingPathOp final : public GrMeshDrawOp {
 private:
     using Helper = GrSimpleMeshDrawOpHelperWithStencil;
@@ -187,6 +202,10 @@ public:
 
     const char* name() const override { return "TessellatingPathOp"; }
 
+    // Uncached antialiased paths tessellate straight into the target's vertex space. The others
+    // are cached as vertex buffers through the resource provider.
+    bool canPrepareConcurrently() const override { return fAntiAlias && !fCacheAA; }
+
     void visitProxies(const VisitProxyFunc& func, VisitorType) const override {
         fHelper.visitProxies(func);
     }
@@ -215,6 +234,14 @@ public:
             , fViewMatrix(viewMatrix)
             , fDevClipBounds(devClipBounds)
             , fAntiAlias(GrAAType::kCoverage == aaType) {
+        // Inverse fills depend on the clip bounds, which change as the path moves.
+        fCacheAA = fAntiAlias && shape.hasUnstyledKey() && !shape.inverseFilled() &&
+                   !viewMatrix.hasPerspective();
+        fSubpixelTranslate.set(0, 0);
+        if (fCacheAA) {
+            fSubpixelTranslate.set(subpixel_translate(viewMatrix.getTranslateX()),
+                                   subpixel_translate(viewMatrix.getTranslateY()));
+        }
         SkRect devBounds;
         viewMatrix.mapRect(&devBounds, shape.bounds());
         if (shape.inverseFilled()) {
@@ -298,6 +325,74 @@ private:
         this->drawVertices(target, std::move(gp), std::move(vb), 0, count);
     }
 
+    // Returns the translation to draw a cached antialiased tessellation with.
+    SkVector aaCacheTranslate() const {
+        SkASSERT(fCacheAA);
+        return {fViewMatrix.getTranslateX() - fSubpixelTranslate.fX,
+                fViewMatrix.getTranslateY() - fSubpixelTranslate.fY};
+    }
+
+    void drawCachedAA(Target* target, sk_sp<const GrGeometryProcessor> gp, size_t vertexStride) {
+        SkASSERT(fCacheAA);
+        GrResourceProvider* rp = target->resourceProvider();
+        // The key is just the path. A draw with a different matrix replaces the tessellation, so
+        // an animated path only ever has one buffer in the cache.
+        static const GrUniqueKey::Domain kDomain = GrUniqueKey::GenerateDomain();
+        GrUniqueKey key;
+        int shapeKeyDataCnt = fShape.unstyledKeySize();
+        SkASSERT(shapeKeyDataCnt >= 0);
+        GrUniqueKey::Builder builder(&key, kDomain, shapeKeyDataCnt, "Path");
+        fShape.writeUnstyledKey(&builder[0]);
+        builder.finish();
+
+        AATessInfo info;
+        info.fScaleX = fViewMatrix.getScaleX();
+        info.fSkewX = fViewMatrix.getSkewX();
+        info.fSkewY = fViewMatrix.getSkewY();
+        info.fScaleY = fViewMatrix.getScaleY();
+        info.fSubpixelTranslate = fSubpixelTranslate;
+
+        sk_sp<GrGpuBuffer> cachedVertexBuffer(rp->findByUniqueKey<GrGpuBuffer>(key));
+        if (cachedVertexBuffer) {
+            const SkData* data = cachedVertexBuffer->getUniqueKey().getCustomData();
+            SkASSERT(data);
+            const AATessInfo* cachedInfo = static_cast<const AATessInfo*>(data->data());
+            if (cachedInfo->fScaleX == info.fScaleX && cachedInfo->fSkewX == info.fSkewX &&
+                cachedInfo->fSkewY == info.fSkewY && cachedInfo->fScaleY == info.fScaleY &&
+                cachedInfo->fSubpixelTranslate == info.fSubpixelTranslate) {
+                this->drawVertices(target, std::move(gp), std::move(cachedVertexBuffer), 0,
+                                   cachedInfo->fCount);
+                return;
+            }
+        }
+
+        SkPath path = getPath();
+        if (path.isEmpty()) {
+            return;
+        }
+        SkMatrix tessMatrix = fViewMatrix;
+        tessMatrix.setTranslateX(fSubpixelTranslate.fX);
+        tessMatrix.setTranslateY(fSubpixelTranslate.fY);
+        path.transform(tessMatrix);
+        // The clip bounds only matter for inverse fills, which we don't cache.
+        SkRect clipBounds = SkRect::Make(fDevClipBounds);
+        bool isLinear;
+        bool canMapVB = GrCaps::kNone_MapFlags != target->caps().mapBufferFlags();
+        StaticVertexAllocator allocator(vertexStride, rp, canMapVB);
+        int count = GrTessellator::PathToTriangles(path, GrPathUtils::kDefaultTolerance,
+                                                   clipBounds, &allocator, true, &isLinear);
+        if (count == 0) {
+            return;
+        }
+        sk_sp<GrGpuBuffer> vb = allocator.detachVertexBuffer();
+        info.fCount = count;
+        fShape.addGenIDChangeListener(sk_make_sp<PathInvalidator>(key, target->contextUniqueID()));
+        key.setCustomData(SkData::MakeWithCopy(&info, sizeof(info)));
+        rp->assignUniqueKeyToResource(key, vb.get());
+
+        this->drawVertices(target, std::move(gp), std::move(vb), 0, count);
+    }
+
     void drawAA(Target* target, sk_sp<const GrGeometryProcessor> gp, size_t vertexStride) {
         SkASSERT(fAntiAlias);
         SkPath path = getPath();
@@ -337,7 +432,22 @@ private:
             } else {
                 coverageType = Coverage::kSolid_Type;
             }
-            if (fAntiAlias) {
+            if (fCacheAA) {
+                // The cached tessellation is in device space, less aaCacheTranslate().
+                SkVector translate = this->aaCacheTranslate();
+                SkMatrix localMatrix;
+                if (!fViewMatrix.invert(&localMatrix)) {
+                    return;
+                }
+                localMatrix.preTranslate(translate.fX, translate.fY);
+                LocalCoords localCoords = LocalCoords::kUnused_Type == localCoordsType
+                                                  ? LocalCoords(localCoordsType)
+                                                  : LocalCoords(localCoordsType, &localMatrix);
+                gp = GrDefaultGeoProcFactory::Make(target->caps().shaderCaps(),
+                                                   color, coverageType, localCoords,
+                                                   SkMatrix::MakeTrans(translate.fX,
+                                                                       translate.fY));
+            } else if (fAntiAlias) {
                 gp = GrDefaultGeoProcFactory::MakeForDeviceSpace(target->caps().shaderCaps(),
                                                                  color, coverageType,
                                                                  localCoordsType, fViewMatrix);
@@ -351,7 +461,9 @@ private:
             return;
         }
         size_t vertexStride = gp->vertexStride();
-        if (fAntiAlias) {
+        if (fCacheAA) {
+            this->drawCachedAA(target, std::move(gp), vertexStride);
+        } else if (fAntiAlias) {
             this->drawAA(target, std::move(gp), vertexStride);
         } else {
             this->draw(target, std::move(gp), vertexStride);
@@ -377,6 +489,9 @@ private:
     SkMatrix                fViewMatrix;
     SkIRect                 fDevClipBounds;
     bool                    fAntiAlias;
+    bool                    fCacheAA;
+    // The quarter-pixel fraction of the translation that cached AA tessellations are made with.
+    SkVector                fSubpixelTranslate;
 
     typedef GrMeshDrawOp INHERITED;
 };
@@ -376,8 +376,9 @@ private:
         fColorType = static_cast<unsigned>(allOpaque ? ColorType::kNone : ColorType::kByte);
     }
 
-    void tess(void* v, const VertexSpec& spec, const GrTextureProxy* proxy, int start,
-              int cnt) const {
+    // Returns the advanced pointer in v.
+    void* tess(void* v, const VertexSpec& spec, const GrTextureProxy* proxy, int start, int cnt,
+               int textureIndex) const {
         TRACE_EVENT0("skia", TRACE_FUNC);
         auto origin = proxy->origin();
         const auto* texture = proxy->peekTexture();
@@ -401,8 +402,9 @@ private:
             SkRect domain =
                     compute_domain(info.domain(), this->filter(), origin, info.fSrcRect, iw, ih, h);
             v = GrQuadPerEdgeAA::Tessellate(v, spec, device, info.fColor, srcQuad, domain,
-                                            info.aaFlags());
+                                            info.aaFlags(), textureIndex);
         }
+        return v;
     }
 
     void onPrepareDraws(Target* target) override {
@@ -445,8 +447,54 @@ private:
             }
         }
 
+        // Quads with different proxies can still share a mesh, and so a draw, by sampling from up
+        // to maxTextures textures and having each quad pick its own. Without mip maps, that is:
+        // the lookups' derivatives are only wrong in pixels where the pick changes, and there is
+        // only one level for them to choose. So group the proxies, in order, into meshes of at
+        // most maxTextures distinct proxies each.
+        int maxTextures = 1;
+        if (this->filter() != GrSamplerState::Filter::kMipMap) {
+            maxTextures = SkTPin(target->caps().shaderCaps()->maxFragmentSamplers(), 1,
+                                 GrQuadPerEdgeAA::kMaxTextures);
+        }
+        SkAutoSTMalloc<32, int> proxyMeshes(numProxies);
+        SkAutoSTMalloc<32, int> proxyTextureIndices(numProxies);
+        SkAutoSTMalloc<32, int> meshQuadCnts(numProxies);
+        SkAutoSTMalloc<32, int> meshTextureCnts(numProxies);
+        SkAutoSTMalloc<32 * GrQuadPerEdgeAA::kMaxTextures, GrTextureProxy*> meshTextures(
+                numProxies * maxTextures);
+        int numMeshes = 0;
+        int textureCnt = 1;
+        int e = 0;
+        for (const auto& op : ChainRange<TextureOp>(this)) {
+            for (unsigned p = 0; p < op.fProxyCnt; ++p, ++e) {
+                auto* proxy = op.fProxies[p].fProxy;
+                int m = numMeshes - 1;
+                int index = -1;
+                for (int t = 0; m >= 0 && t < meshTextureCnts[m]; ++t) {
+                    if (meshTextures[m * maxTextures + t] == proxy) {
+                        index = t;
+                        break;
+                    }
+                }
+                if (index < 0) {
+                    if (m < 0 || meshTextureCnts[m] == maxTextures) {
+                        m = numMeshes++;
+                        meshQuadCnts[m] = 0;
+                        meshTextureCnts[m] = 0;
+                    }
+                    index = meshTextureCnts[m]++;
+                    meshTextures[m * maxTextures + index] = proxy;
+                    textureCnt = SkTMax(textureCnt, meshTextureCnts[m]);
+                }
+                proxyMeshes[e] = m;
+                proxyTextureIndices[e] = index;
+                meshQuadCnts[m] += op.fProxies[p].fQuadCnt;
+            }
+        }
+
         VertexSpec vertexSpec(quadType, colorType, srcQuadType, /* hasLocal */ true, domain, aaType,
-                              /* alpha as coverage */ true);
+                              /* alpha as coverage */ true, /* texture index */ textureCnt > 1);
 
         GrSamplerState samplerState = GrSamplerState(GrSamplerState::WrapMode::kClamp,
                                                      this->filter());
@@ -456,72 +504,81 @@ private:
 
         sk_sp<GrGeometryProcessor> gp = GrQuadPerEdgeAA::MakeTexturedProcessor(
                 vertexSpec, *target->caps().shaderCaps(),
-                textureType, config, samplerState, extraSamplerKey,
+                textureType, config, textureCnt, samplerState, extraSamplerKey,
                 std::move(fTextureColorSpaceXform));
 
-        // We'll use a dynamic state array for the GP textures when there are multiple ops.
-        // Otherwise, we use fixed dynamic state to specify the single op's proxy.
+        // We'll use a dynamic state array for the GP textures when there are multiple meshes.
+        // Otherwise, we use fixed dynamic state to specify the single mesh's proxies. Meshes
+        // that sample fewer than textureCnt textures repeat their first in the unused slots.
         GrPipeline::DynamicStateArrays* dynamicStateArrays = nullptr;
         GrPipeline::FixedDynamicState* fixedDynamicState;
-        if (numProxies > 1) {
-            dynamicStateArrays = target->allocDynamicStateArrays(numProxies, 1, false);
+        GrTextureProxy** textures;
+        if (numMeshes > 1) {
+            dynamicStateArrays = target->allocDynamicStateArrays(numMeshes, textureCnt, false);
             fixedDynamicState = target->makeFixedDynamicState(0);
+            textures = dynamicStateArrays->fPrimitiveProcessorTextures;
         } else {
-            fixedDynamicState = target->makeFixedDynamicState(1);
-            fixedDynamicState->fPrimitiveProcessorTextures[0] = fProxies[0].fProxy;
+            fixedDynamicState = target->makeFixedDynamicState(textureCnt);
+            textures = fixedDynamicState->fPrimitiveProcessorTextures;
+        }
+        for (int m = 0; m < numMeshes; ++m) {
+            for (int t = 0; t < textureCnt; ++t) {
+                int index = t < meshTextureCnts[m] ? t : 0;
+                textures[m * textureCnt + t] = meshTextures[m * maxTextures + index];
+            }
         }
 
         size_t vertexSize = gp->vertexStride();
 
-        GrMesh* meshes = target->allocMeshes(numProxies);
+        GrMesh* meshes = target->allocMeshes(numMeshes);
         sk_sp<const GrBuffer> vbuffer;
         int vertexOffsetInBuffer = 0;
         int numQuadVerticesLeft = numTotalQuads * vertexSpec.verticesPerQuad();
         int numAllocatedVertices = 0;
         void* vdata = nullptr;
 
-        int m = 0;
+        int m = -1;
+        e = 0;
         for (const auto& op : ChainRange<TextureOp>(this)) {
             int q = 0;
-            for (unsigned p = 0; p < op.fProxyCnt; ++p) {
-                int quadCnt = op.fProxies[p].fQuadCnt;
-                auto* proxy = op.fProxies[p].fProxy;
-                int meshVertexCnt = quadCnt * vertexSpec.verticesPerQuad();
-                if (numAllocatedVertices < meshVertexCnt) {
-                    vdata = target->makeVertexSpaceAtLeast(
-                            vertexSize, meshVertexCnt, numQuadVerticesLeft, &vbuffer,
-                            &vertexOffsetInBuffer, &numAllocatedVertices);
-                    SkASSERT(numAllocatedVertices <= numQuadVerticesLeft);
-                    if (!vdata) {
-                        SkDebugf("Could not allocate vertices\n");
+            for (unsigned p = 0; p < op.fProxyCnt; ++p, ++e) {
+                if (proxyMeshes[e] != m) {
+                    // Starting the next mesh, whose vertices must all be in one buffer.
+                    m = proxyMeshes[e];
+                    int meshVertexCnt = meshQuadCnts[m] * vertexSpec.verticesPerQuad();
+                    if (numAllocatedVertices < meshVertexCnt) {
+                        vdata = target->makeVertexSpaceAtLeast(
+                                vertexSize, meshVertexCnt, numQuadVerticesLeft, &vbuffer,
+                                &vertexOffsetInBuffer, &numAllocatedVertices);
+                        SkASSERT(numAllocatedVertices <= numQuadVerticesLeft);
+                        if (!vdata) {
+                            SkDebugf("Could not allocate vertices\n");
+                            return;
+                        }
+                    }
+                    SkASSERT(numAllocatedVertices >= meshVertexCnt);
+
+                    if (!GrQuadPerEdgeAA::ConfigureMeshIndices(target, &(meshes[m]), vertexSpec,
+                                                               meshQuadCnts[m])) {
+                        SkDebugf("Could not allocate indices");
                         return;
                     }
+                    meshes[m].setVertexData(vbuffer, vertexOffsetInBuffer);
+                    numAllocatedVertices -= meshVertexCnt;
+                    numQuadVerticesLeft -= meshVertexCnt;
+                    vertexOffsetInBuffer += meshVertexCnt;
                 }
-                SkASSERT(numAllocatedVertices >= meshVertexCnt);
 
-                op.tess(vdata, vertexSpec, proxy, q, quadCnt);
-
-                if (!GrQuadPerEdgeAA::ConfigureMeshIndices(target, &(meshes[m]), vertexSpec,
-                                                           quadCnt)) {
-                    SkDebugf("Could not allocate indices");
-                    return;
-                }
-                meshes[m].setVertexData(vbuffer, vertexOffsetInBuffer);
-                if (dynamicStateArrays) {
-                    dynamicStateArrays->fPrimitiveProcessorTextures[m] = proxy;
-                }
-                ++m;
-                numAllocatedVertices -= meshVertexCnt;
-                numQuadVerticesLeft -= meshVertexCnt;
-                vertexOffsetInBuffer += meshVertexCnt;
-                vdata = reinterpret_cast<char*>(vdata) + vertexSize * meshVertexCnt;
+                int quadCnt = op.fProxies[p].fQuadCnt;
+                vdata = op.tess(vdata, vertexSpec, op.fProxies[p].fProxy, q, quadCnt,
+                                proxyTextureIndices[e]);
                 q += quadCnt;
             }
         }
         SkASSERT(!numQuadVerticesLeft);
         SkASSERT(!numAllocatedVertices);
         target->recordDraw(
-                std::move(gp), meshes, numProxies, fixedDynamicState, dynamicStateArrays);
+                std::move(gp), meshes, numMeshes, fixedDynamicState, dynamicStateArrays);
     }
 
     void onExecute(GrOpFlushState* flushState, const SkRect& chainBounds) override {
@@ -0,0 +1,305 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrSkcPathRenderer.h"
+
+#if SK_ENABLE_SKC
+
+#include "GrAuditTrail.h"
+#include "GrCaps.h"
+#include "GrRenderTargetContext.h"
+#include "GrSWMaskHelper.h"
+#include "GrShape.h"
+#include "GrSoftwarePathRenderer.h"
+#include "GrTextureProxy.h"
+#include "SkAutoMalloc.h"
+#include "SkAutoPixmapStorage.h"
+#include "SkGeometry.h"
+#include "SkTraceEvent.h"
+
+// SKC rasterizes in subpixel units.
+static constexpr float kSubpixelScale = 32;
+
+// Paths at least this complex, or covering at least this many pixels, are worth a trip through
+// SKC. Everything else is better served by the other path renderers.
+static constexpr int kMinVerbCount = 256;
+static constexpr int64_t kMinPixelCount = 512 * 512;
+
+// The largest mask SKC renders in one go.
+static constexpr int kMaxMaskSize = 4096;
+
+sk_sp<GrSkcPathRenderer> GrSkcPathRenderer::CreateIfSupported(GrProxyProvider* proxyProvider) {
+    if (!proxyProvider) {
+        return nullptr;
+    }
+    cl_platform_id platform;
+    cl_device_id device;
+    if (CL_SUCCESS != clGetPlatformIDs(1, &platform, nullptr) ||
+        CL_SUCCESS != clGetDeviceIDs(platform, CL_DEVICE_TYPE_GPU, 1, &device, nullptr)) {
+        return nullptr;
+    }
+    cl_int err;
+    cl_context clContext = clCreateContext(nullptr, 1, &device, nullptr, nullptr, &err);
+    if (CL_SUCCESS != err) {
+        return nullptr;
+    }
+    cl_command_queue queue = clCreateCommandQueue(clContext, device, 0, &err);
+    if (CL_SUCCESS != err) {
+        clReleaseContext(clContext);
+        return nullptr;
+    }
+    skc_context_t context;
+    if (SKC_ERR_SUCCESS != skc_context_create_cl(&context, clContext, device)) {
+        clReleaseCommandQueue(queue);
+        clReleaseContext(clContext);
+        return nullptr;
+    }
+    return sk_sp<GrSkcPathRenderer>(new GrSkcPathRenderer(proxyProvider, clContext, queue,
+                                                          context));
+}
+
+GrSkcPathRenderer::GrSkcPathRenderer(GrProxyProvider* proxyProvider, cl_context clContext,
+                                     cl_command_queue queue, skc_context_t context)
+        : fProxyProvider(proxyProvider)
+        , fCLContext(clContext)
+        , fCLQueue(queue)
+        , fContext(context) {
+    // A single layer in a single group is all a coverage mask needs.
+    skc_path_builder_create(fContext, &fPathBuilder);
+    skc_raster_builder_create(fContext, &fRasterBuilder);
+    skc_composition_create(fContext, &fComposition);
+    skc_styling_create(fContext, &fStyling, 1, 1, 64);
+    skc_surface_create(fContext, &fSurface);
+}
+
+GrSkcPathRenderer::~GrSkcPathRenderer() {
+    skc_surface_release(fSurface);
+    skc_styling_release(fStyling);
+    skc_composition_release(fComposition);
+    skc_raster_builder_release(fRasterBuilder);
+    skc_path_builder_release(fPathBuilder);
+    skc_context_release(fContext);
+    if (fImage) {
+        clReleaseMemObject(fImage);
+    }
+    clReleaseCommandQueue(fCLQueue);
+    clReleaseContext(fCLContext);
+}
+
+bool GrSkcPathRenderer::ensureImage(int width, int height) {
+    if (fImage && width <= fImageWidth && height <= fImageHeight) {
+        return true;
+    }
+    if (fImage) {
+        clReleaseMemObject(fImage);
+        fImage = nullptr;
+    }
+    // Grow in powers of two so a run of slightly larger paths doesn't reallocate every time.
+    fImageWidth = SkTMax(SkNextPow2(width), fImageWidth);
+    fImageHeight = SkTMax(SkNextPow2(height), fImageHeight);
+
+    static const cl_image_format kFormat = { CL_RGBA, CL_UNORM_INT8 };
+    cl_int err;
+    fImage = clCreateImage2D(fCLContext, CL_MEM_READ_WRITE, &kFormat, fImageWidth, fImageHeight,
+                             0, nullptr, &err);
+    if (CL_SUCCESS != err) {
+        fImage = nullptr;
+        fImageWidth = fImageHeight = 0;
+        return false;
+    }
+    return true;
+}
+
+GrPathRenderer::CanDrawPath GrSkcPathRenderer::onCanDrawPath(const CanDrawPathArgs& args) const {
+    const GrShape& shape = *args.fShape;
+    if (!shape.style().isSimpleFill() || shape.inverseFilled() ||
+        args.fViewMatrix->hasPerspective() || GrAAType::kCoverage != args.fAAType) {
+        return CanDrawPath::kNo;
+    }
+
+    SkRect devBounds;
+    args.fViewMatrix->mapRect(&devBounds, shape.bounds());
+    SkIRect clippedBounds;
+    if (!clippedBounds.intersect(devBounds.roundOut(), *args.fClipConservativeBounds) ||
+        clippedBounds.width() > kMaxMaskSize || clippedBounds.height() > kMaxMaskSize) {
+        return CanDrawPath::kNo;
+    }
+
+    SkPath path;
+    shape.asPath(&path);
+    if (path.countVerbs() < kMinVerbCount &&
+        sk_64_mul(clippedBounds.width(), clippedBounds.height()) < kMinPixelCount) {
+        return CanDrawPath::kNo;
+    }
+    return CanDrawPath::kYes;
+}
+
+static void render_notify(skc_surface_t, skc_styling_t, skc_composition_t, skc_framebuffer_t,
+                          void* done) {
+    *static_cast<bool*>(done) = true;
+}
+
+static void add_skc_path(skc_path_builder_t pb, const SkPath& path) {
+    SkPath::RawIter iter(path);
+    SkPoint pts[4], start = {0, 0};
+    SkAutoConicToQuads converter;
+    SkPath::Verb verb;
+    while ((verb = iter.next(pts)) != SkPath::kDone_Verb) {
+        switch (verb) {
+            case SkPath::kMove_Verb:
+                start = pts[0];
+                skc_path_move_to(pb, pts[0].fX, pts[0].fY);
+                break;
+            case SkPath::kLine_Verb:
+                skc_path_line_to(pb, pts[1].fX, pts[1].fY);
+                break;
+            case SkPath::kQuad_Verb:
+                skc_path_quad_to(pb, pts[1].fX, pts[1].fY, pts[2].fX, pts[2].fY);
+                break;
+            case SkPath::kConic_Verb: {
+                // SKC has no rational quads.
+                const SkPoint* quads = converter.computeQuads(pts, iter.conicWeight(), 0.25f);
+                for (int i = 0; i < converter.countQuads(); ++i) {
+                    skc_path_quad_to(pb, quads[2 * i + 1].fX, quads[2 * i + 1].fY,
+                                     quads[2 * i + 2].fX, quads[2 * i + 2].fY);
+                }
+                break;
+            }
+            case SkPath::kCubic_Verb:
+                skc_path_cubic_to(pb, pts[1].fX, pts[1].fY, pts[2].fX, pts[2].fY,
+                                  pts[3].fX, pts[3].fY);
+                break;
+            case SkPath::kClose_Verb:
+                skc_path_line_to(pb, start.fX, start.fY);
+                break;
+            case SkPath::kDone_Verb:
+                break;
+        }
+    }
+}
+
+bool GrSkcPathRenderer::onDrawPath(const DrawPathArgs& args) {
+    GR_AUDIT_TRAIL_AUTO_FRAME(args.fRenderTargetContext->auditTrail(),
+                              "GrSkcPathRenderer::onDrawPath");
+    TRACE_EVENT0("skia", TRACE_FUNC);
+
+    SkIRect unclippedDevShapeBounds, clippedDevShapeBounds, devClipBounds;
+    if (!GrSoftwarePathRenderer::GetShapeAndClipBounds(args.fRenderTargetContext, *args.fClip,
+                                                       *args.fShape, *args.fViewMatrix,
+                                                       &unclippedDevShapeBounds,
+                                                       &clippedDevShapeBounds, &devClipBounds)) {
+        return true;
+    }
+    const SkIRect& maskBounds = clippedDevShapeBounds;
+    const int width = maskBounds.width(), height = maskBounds.height();
+    if (!this->ensureImage(width, height)) {
+        return false;
+    }
+
+    SkPath path;
+    args.fShape->asPath(&path);
+    skc_path_t skcPath;
+    skc_path_begin(fPathBuilder);
+    add_skc_path(fPathBuilder, path);
+    skc_path_end(fPathBuilder, &skcPath);
+
+    // Map the path into the mask, in subpixels.
+    SkMatrix m = *args.fViewMatrix;
+    m.postTranslate(-maskBounds.fLeft, -maskBounds.fTop);
+    m.postScale(kSubpixelScale, kSubpixelScale);
+    const float transform[8] = {
+        m.getScaleX(), m.getSkewX(),  m.getTranslateX(),
+        m.getSkewY(),  m.getScaleY(), m.getTranslateY(),
+        0, 0
+    };
+    const float rasterClip[4] = { 0, 0, (float)width, (float)height };
+    skc_transform_weakref_t transformWeakref = SKC_WEAKREF_INVALID;
+    skc_raster_clip_weakref_t clipWeakref = SKC_WEAKREF_INVALID;
+
+    skc_raster_t raster;
+    skc_raster_begin(fRasterBuilder);
+    skc_raster_add_filled(fRasterBuilder, skcPath, &transformWeakref, transform, &clipWeakref,
+                          rasterClip);
+    skc_raster_end(fRasterBuilder, &raster);
+    // The raster keeps what it needs of the path.
+    skc_path_release(fContext, &skcPath, 1);
+
+    // One group, zeroing the accumulator on entry and writing it to the surface on exit, holding
+    // one layer that accumulates white coverage.
+    skc_styling_reset(fStyling);
+    skc_group_id group;
+    skc_styling_group_alloc(fStyling, &group);
+    skc_styling_group_parents(fStyling, group, 0, nullptr);
+    skc_styling_group_range_lo(fStyling, group, 0);
+    skc_styling_group_range_hi(fStyling, group, 0);
+    const skc_styling_cmd_t enter[] = {
+        SKC_STYLING_OPCODE_COLOR_ACC_ZERO | SKC_STYLING_OPCODE_IS_FINAL
+    };
+    skc_styling_group_enter(fStyling, group, SK_ARRAY_COUNT(enter), enter);
+    const skc_styling_cmd_t leave[] = {
+        SKC_STYLING_OPCODE_SURFACE_COMPOSITE | SKC_STYLING_OPCODE_IS_FINAL
+    };
+    skc_styling_group_leave(fStyling, group, SK_ARRAY_COUNT(leave), leave);
+
+    skc_styling_cmd_t cmds[1 + 3 + 1];
+    cmds[0] = SkPath::kEvenOdd_FillType == path.getFillType() ? SKC_STYLING_OPCODE_COVER_EVENODD
+                                                             : SKC_STYLING_OPCODE_COVER_NONZERO;
+    static const float kWhite[4] = { 1, 1, 1, 1 };
+    skc_styling_layer_fill_rgba_encoder(cmds + 1, kWhite);
+    cmds[4] = SKC_STYLING_OPCODE_BLEND_OVER | SKC_STYLING_OPCODE_IS_FINAL;
+    skc_layer_id layer = 0;
+    skc_styling_group_layer(fStyling, group, layer, SK_ARRAY_COUNT(cmds), cmds);
+
+    skc_composition_unseal(fComposition, true);
+    skc_composition_place(fComposition, &raster, &layer, nullptr, nullptr, 1);
+    skc_raster_release(fContext, &raster, 1);
+    skc_composition_seal(fComposition);
+    skc_styling_seal(fStyling);
+
+    skc_framebuffer_cl framebuffer = { SKC_FRAMEBUFFER_CL_IMAGE2D, fImage, nullptr, nullptr };
+    const uint32_t clip[4] = { 0, 0, (uint32_t)width, (uint32_t)height };
+    const int32_t txty[2] = { 0, 0 };
+    bool done = false;
+    skc_surface_render(fSurface, fStyling, fComposition, &framebuffer, clip, txty, render_notify,
+                       &done);
+    while (!done) {
+        skc_context_wait(fContext);
+    }
+
+    SkAutoMalloc rgba(width * height * 4);
+    const size_t origin[3] = { 0, 0, 0 };
+    const size_t region[3] = { (size_t)width, (size_t)height, 1 };
+    if (CL_SUCCESS != clEnqueueReadImage(fCLQueue, fImage, CL_TRUE, origin, region, width * 4, 0,
+                                         rgba.get(), 0, nullptr, nullptr)) {
+        return false;
+    }
+
+    SkAutoPixmapStorage pixels;
+    GrSWMaskHelper helper(&pixels);
+    if (!helper.init(maskBounds)) {
+        return false;
+    }
+    const uint8_t* src = static_cast<const uint8_t*>(rgba.get());
+    for (int y = 0; y < height; ++y) {
+        uint8_t* dst = pixels.writable_addr8(0, y);
+        for (int x = 0; x < width; ++x) {
+            dst[x] = src[4 * x + 3];
+        }
+        src += 4 * width;
+    }
+    sk_sp<GrTextureProxy> proxy = helper.toTextureProxy(args.fContext, SkBackingFit::kApprox);
+    if (!proxy) {
+        return false;
+    }
+    GrSoftwarePathRenderer::DrawToTargetWithShapeMask(
+            std::move(proxy), args.fRenderTargetContext, std::move(args.fPaint),
+            *args.fUserStencilSettings, *args.fClip, *args.fViewMatrix,
+            SkIPoint{maskBounds.fLeft, maskBounds.fTop}, maskBounds);
+    return true;
+}
+
+#endif  // SK_ENABLE_SKC
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrSkcPathRenderer_DEFINED
+#define GrSkcPathRenderer_DEFINED
+
+#include "GrPathRenderer.h"
+
+#if SK_ENABLE_SKC
+
+extern "C" {
+#include "skc_cl.h"
+}
+
+class GrProxyProvider;
+
+/**
+ * Experimental: rasterizes large or complex fills with the SKC compute rasterizer in
+ * src/compute/skc, then composites its coverage like the software path renderer composites its
+ * masks. Requires SK_ENABLE_SKC, the skc and skc/platforms/cl_12 include directories and an
+ * OpenCL 1.2 GPU device.
+ *
+ * FIXME: Each draw runs its own SKC render and reads the coverage back before uploading it.
+ * Sharing SKC's output with the backend (CL/GL interop, or SKC's Vulkan platform once its raster
+ * stages are ported) and rendering a flush's paths as one composition are follow-ups.
+ */
+class GrSkcPathRenderer : public GrPathRenderer {
+public:
+    static sk_sp<GrSkcPathRenderer> CreateIfSupported(GrProxyProvider*);
+
+    ~GrSkcPathRenderer() override;
+
+private:
+    GrSkcPathRenderer(GrProxyProvider*, cl_context, cl_command_queue, skc_context_t);
+
+    bool ensureImage(int width, int height);
+
+    StencilSupport onGetStencilSupport(const GrShape&) const override {
+        return GrPathRenderer::kNoSupport_StencilSupport;
+    }
+
+    CanDrawPath onCanDrawPath(const CanDrawPathArgs&) const override;
+
+    bool onDrawPath(const DrawPathArgs&) override;
+
+    GrProxyProvider*     fProxyProvider;
+
+    cl_context           fCLContext;
+    cl_command_queue     fCLQueue;
+    cl_mem               fImage = nullptr;
+    int                  fImageWidth = 0;
+    int                  fImageHeight = 0;
+
+    skc_context_t        fContext;
+    skc_path_builder_t   fPathBuilder;
+    skc_raster_builder_t fRasterBuilder;
+    skc_composition_t    fComposition;
+    skc_styling_t        fStyling;
+    skc_surface_t        fSurface;
+
+    typedef GrPathRenderer INHERITED;
+};
+
+#endif  // SK_ENABLE_SKC
+
+#endif
@@ -330,9 +330,11 @@ private:
             fY = y;
         }
 
-        // This function assumes the translation will be applied before it is called again
+        // Computes how far the sub run's vertices must move to be drawn at viewMatrix, x and y.
+        // Once the translation has been written into the vertices, init() should be called with
+        // the same arguments.
         void computeTranslation(const SkMatrix& viewMatrix, SkScalar x, SkScalar y,
-                                SkScalar* transX, SkScalar* transY);
+                                SkScalar* transX, SkScalar* transY) const;
 
         // df properties
         void setDrawAsDistanceFields() { fFlags.drawAsSdf = true; }
@@ -346,7 +348,7 @@ private:
         void setNeedsTransform(bool needsTransform) { fFlags.needsTransform = needsTransform; }
         bool needsTransform() const { return fFlags.needsTransform; }
         void setFallback() { fFlags.argbFallback = true; }
-        bool isFallback() { return fFlags.argbFallback; }
+        bool isFallback() const { return fFlags.argbFallback; }
 
         const SkDescriptor* desc() const { return fDesc.getDesc(); }
 
@@ -623,6 +625,13 @@ public:
          * Pointer where the caller finds the first regenerated vertex.
          */
         const char* fFirstVertex;
+
+        /**
+         * When the sub run only moved since its vertices were written, they are returned as they
+         * are and the caller adds this translation to their positions while copying them. This
+         * keeps scrolling a cached blob from rewriting its vertices every frame.
+         */
+        SkVector fTranslate = {0, 0};
     };
 
     bool regenerate(Result*);
@@ -640,6 +649,8 @@ private:
     Run* fRun;
     SubRun* fSubRun;
     GrColor fColor;
+    SkScalar fX;
+    SkScalar fY;
     SkScalar fTransX;
     SkScalar fTransY;
 
@@ -133,7 +133,9 @@ GrTextBlob::VertexRegenerator::VertexRegenerator(GrResourceProvider* resourcePro
         , fLazyCache(lazyCache)
         , fRun(&blob->fRuns[runIdx])
         , fSubRun(&blob->fRuns[runIdx].fSubRunInfo[subRunIdx])
-        , fColor(color) {
+        , fColor(color)
+        , fX(x)
+        , fY(y) {
     // Compute translation if any
     fSubRun->computeTranslation(fViewMatrix, x, y, &fTransX, &fTransY);
 
@@ -239,8 +241,11 @@ bool GrTextBlob::VertexRegenerator::doRegen(GrTextBlob::VertexRegenerator::Resul
         ++fCurrGlyph;
     }
 
-    // We may have changed the color so update it here
+    // We may have changed the color and positions so update them here
     fSubRun->setColor(fColor);
+    if (regenPos) {
+        fSubRun->init(fViewMatrix, fX, fY);
+    }
     if (regenTexCoords) {
         if (regenGlyphs) {
             fSubRun->setStrike(std::move(strike));
@@ -265,7 +270,11 @@ bool GrTextBlob::VertexRegenerator::regenerate(GrTextBlob::VertexRegenerator::Re
         fRegenFlags |= kRegenTex;
     }
 
-    if (fRegenFlags) {
+    // A sub run that only moved keeps its vertices, the caller translates them when it copies them
+    // out. Anything else (new colors, atlas locations or glyphs) is written into the blob, and the
+    // positions are brought up to date along with it. Changes that need the glyphs rasterized
+    // again, like a new scale, are caught by GrTextBlob::mustRegenerate() before we get here.
+    if (fRegenFlags & ~kRegenPos) {
         return this->doRegen(result,
                              fRegenFlags & kRegenPos,
                              fRegenFlags & kRegenCol,
@@ -279,6 +288,9 @@ bool GrTextBlob::VertexRegenerator::regenerate(GrTextBlob::VertexRegenerator::Re
         result->fFirstVertex = fBlob->fVertices + fSubRun->vertexStartIndex() +
                                fCurrGlyph * kVerticesPerGlyph * vertexStride;
         fCurrGlyph = fSubRun->glyphCount();
+        if (fRegenFlags & kRegenPos) {
+            result->fTranslate.set(fTransX, fTransY);
+        }
 
         // set use tokens for all of the glyphs in our subrun.  This is only valid if we
         // have a valid atlas generation
@@ -274,7 +274,7 @@ public:
                            const VkBufferImageCopy* copyRegions);
 
     void copyBufferToImage(const GrVkGpu* gpu,
-                           GrVkTransferBuffer* srcBuffer,
+                           GrVkBuffer* srcBuffer,
                            GrVkImage* dstImage,
                            VkImageLayout dstLayout,
                            uint32_t copyRegionCount,
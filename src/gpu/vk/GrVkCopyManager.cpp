@@ -244,7 +244,7 @@ bool GrVkCopyManager::copySurfaceAsDraw(GrVkGpu* gpu,
     descriptorWrites.dstBinding = GrVkUniformHandler::kGeometryBinding;
     descriptorWrites.dstArrayElement = 0;
     descriptorWrites.descriptorCount = 1;
-    descriptorWrites.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    descriptorWrites.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     descriptorWrites.pImageInfo = nullptr;
     descriptorWrites.pBufferInfo = &uniBufferInfo;
     descriptorWrites.pTexelBufferView = nullptr;
@@ -375,6 +375,8 @@ bool GrVkCopyManager::copySurfaceAsDraw(GrVkGpu* gpu,
     descriptorResources.push_back(srcTex->textureView());
     descriptorResources.push_back(srcTex->resource());
 
+    // The uniform set's buffers are dynamic, but ours starts at the descriptor's own offset.
+    static const uint32_t kUniformOffsets[] = { 0, 0 };
     secondary->bindDescriptorSets(gpu,
                                   descriptorRecycledResources,
                                   descriptorResources,
@@ -382,8 +384,8 @@ bool GrVkCopyManager::copySurfaceAsDraw(GrVkGpu* gpu,
                                   0,
                                   2,
                                   vkDescSets,
-                                  0,
-                                  nullptr);
+                                  SK_ARRAY_COUNT(kUniformOffsets),
+                                  kUniformOffsets);
 
     // Set Dynamic viewport and stencil
     // We always use one viewport the size of the RT
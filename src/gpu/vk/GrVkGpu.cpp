@@ -673,11 +673,20 @@ bool GrVkGpu::uploadTexDataOptimal(GrVkTexture* tex, int left, int top, int widt
         return true;
     }
 
-    // allocate buffer to hold our mip data
-    sk_sp<GrVkTransferBuffer> transferBuffer =
-            GrVkTransferBuffer::Make(this, combinedBufferSize, GrVkBuffer::kCopyRead_Type);
-    if (!transferBuffer) {
-        return false;
+    // Small uploads are suballocated from the staging ring. Larger ones get their own buffer to
+    // hold the mip data.
+    sk_sp<GrVkTransferBuffer> transferBuffer;
+    GrVkStagingRingBuffer::Slice slice;
+    if (combinedBufferSize > GrVkStagingRingBuffer::kMaxUploadSize ||
+        !fResourceProvider.stagingRingBuffer()->allocate(this, combinedBufferSize,
+                                                         alignmentMask + 1, &slice)) {
+        transferBuffer =
+                GrVkTransferBuffer::Make(this, combinedBufferSize, GrVkBuffer::kCopyRead_Type);
+        if (!transferBuffer) {
+            return false;
+        }
+        slice.fBuffer = transferBuffer.get();
+        slice.fOffset = transferBuffer->offset();
     }
 
     int uploadLeft = left;
@@ -719,7 +728,7 @@ bool GrVkGpu::uploadTexDataOptimal(GrVkTexture* tex, int left, int top, int widt
         uploadTop = 0;
     }
 
-    char* buffer = (char*) transferBuffer->map();
+    char* buffer = transferBuffer ? (char*) transferBuffer->map() : slice.fData;
     SkTArray<VkBufferImageCopy> regions(mipLevelCount);
 
     currentWidth = width;
@@ -740,7 +749,7 @@ bool GrVkGpu::uploadTexDataOptimal(GrVkTexture* tex, int left, int top, int widt
 
             VkBufferImageCopy& region = regions.push_back();
             memset(&region, 0, sizeof(VkBufferImageCopy));
-            region.bufferOffset = transferBuffer->offset() + individualMipOffsets[currentMipLevel];
+            region.bufferOffset = slice.fOffset + individualMipOffsets[currentMipLevel];
             region.bufferRowLength = currentWidth;
             region.bufferImageHeight = currentHeight;
             region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, SkToU32(currentMipLevel), 0, 1 };
@@ -752,8 +761,12 @@ bool GrVkGpu::uploadTexDataOptimal(GrVkTexture* tex, int left, int top, int widt
         layerHeight = currentHeight;
     }
 
-    // no need to flush non-coherent memory, unmap will do that for us
-    transferBuffer->unmap();
+    if (transferBuffer) {
+        // no need to flush non-coherent memory, unmap will do that for us
+        transferBuffer->unmap();
+    } else {
+        fResourceProvider.stagingRingBuffer()->flush(this, slice, combinedBufferSize);
+    }
 
     // Change layout of our target so it can be copied to
     uploadTexture->setImageLayout(this,
@@ -764,7 +777,7 @@ bool GrVkGpu::uploadTexDataOptimal(GrVkTexture* tex, int left, int top, int widt
 
     // Copy the buffer to the image
     fCurrentCmdBuffer->copyBufferToImage(this,
-                                         transferBuffer.get(),
+                                         slice.fBuffer,
                                          uploadTexture,
                                          VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
                                          regions.count(),
@@ -1409,7 +1422,7 @@ bool GrVkGpu::createTestingOnlyVkImage(GrPixelConfig config, int w, int h, bool
     GR_VK_CALL_ERRCHECK(this->vkInterface(),
                         CreateImage(this->device(), &imageCreateInfo, nullptr, &image));
 
-    if (!GrVkMemory::AllocAndBindImageMemory(this, image, false, &alloc)) {
+    if (!GrVkMemory::AllocAndBindImageMemory(this, image, false, false, &alloc)) {
         VK_CALL(DestroyImage(this->device(), image, nullptr));
         return false;
     }
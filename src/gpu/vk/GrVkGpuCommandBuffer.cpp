@@ -321,7 +321,7 @@ void GrVkGpuRTCommandBuffer::discard() {
         GrVkRenderPass::LoadStoreOps vkColorOps(VK_ATTACHMENT_LOAD_OP_DONT_CARE,
                                                 VK_ATTACHMENT_STORE_OP_STORE);
         GrVkRenderPass::LoadStoreOps vkStencilOps(VK_ATTACHMENT_LOAD_OP_DONT_CARE,
-                                                  VK_ATTACHMENT_STORE_OP_STORE);
+                                                  fVkStencilStoreOp);
 
         const GrVkRenderPass* oldRP = cbInfo.fRenderPass;
 
@@ -507,19 +507,36 @@ void GrVkGpuRTCommandBuffer::addAdditionalCommandBuffer() {
 
 void GrVkGpuRTCommandBuffer::addAdditionalRenderPass() {
     GrVkRenderTarget* vkRT = static_cast<GrVkRenderTarget*>(fRenderTarget);
+    const GrVkResourceProvider::CompatibleRPHandle& rpHandle =
+            vkRT->compatibleRenderPassHandle();
 
-    fCommandBufferInfos[fCurrentCmdInfo].currentCmdBuf()->end(fGpu);
+    CommandBufferInfo& prevInfo = fCommandBufferInfos[fCurrentCmdInfo];
+    prevInfo.currentCmdBuf()->end(fGpu);
+
+    // Only the last pass may drop the stencil. The one before it now has to store the stencil for
+    // the new pass to load.
+    if (VK_ATTACHMENT_STORE_OP_STORE != fVkStencilStoreOp) {
+        const GrVkRenderPass* oldRP = prevInfo.fRenderPass;
+        GrVkRenderPass::LoadStoreOps vkStencilOps(oldRP->stencilLoadStoreOps().fLoadOp,
+                                                  VK_ATTACHMENT_STORE_OP_STORE);
+        if (rpHandle.isValid()) {
+            prevInfo.fRenderPass = fGpu->resourceProvider().findRenderPass(
+                    rpHandle, oldRP->colorLoadStoreOps(), vkStencilOps);
+        } else {
+            prevInfo.fRenderPass = fGpu->resourceProvider().findRenderPass(
+                    *vkRT, oldRP->colorLoadStoreOps(), vkStencilOps);
+        }
+        SkASSERT(prevInfo.fRenderPass->isCompatible(*oldRP));
+        oldRP->unref(fGpu);
+    }
 
     CommandBufferInfo& cbInfo = fCommandBufferInfos.push_back();
     fCurrentCmdInfo++;
 
     GrVkRenderPass::LoadStoreOps vkColorOps(VK_ATTACHMENT_LOAD_OP_LOAD,
                                             VK_ATTACHMENT_STORE_OP_STORE);
-    GrVkRenderPass::LoadStoreOps vkStencilOps(VK_ATTACHMENT_LOAD_OP_LOAD,
-                                              VK_ATTACHMENT_STORE_OP_STORE);
+    GrVkRenderPass::LoadStoreOps vkStencilOps(VK_ATTACHMENT_LOAD_OP_LOAD, fVkStencilStoreOp);
 
-    const GrVkResourceProvider::CompatibleRPHandle& rpHandle =
-            vkRT->compatibleRenderPassHandle();
     if (rpHandle.isValid()) {
         cbInfo.fRenderPass = fGpu->resourceProvider().findRenderPass(rpHandle,
                                                                      vkColorOps,
@@ -560,13 +577,12 @@ void GrVkGpuRTCommandBuffer::copy(GrSurface* src, GrSurfaceOrigin srcOrigin, con
             LoadStoreState::kStartsWithDiscard == cbInfo.fLoadStoreState);
 
     if (LoadStoreState::kLoadAndStore != cbInfo.fLoadStoreState) {
-        // Change the render pass to do a load and store so we don't lose the results of our copy
+        // Change the render pass to do a load and store so we don't lose the results of our copy.
+        // The copy only affects color, so the stencil keeps its ops.
+        const GrVkRenderPass* oldRP = cbInfo.fRenderPass;
         GrVkRenderPass::LoadStoreOps vkColorOps(VK_ATTACHMENT_LOAD_OP_LOAD,
                                                 VK_ATTACHMENT_STORE_OP_STORE);
-        GrVkRenderPass::LoadStoreOps vkStencilOps(VK_ATTACHMENT_LOAD_OP_LOAD,
-                                                  VK_ATTACHMENT_STORE_OP_STORE);
-
-        const GrVkRenderPass* oldRP = cbInfo.fRenderPass;
+        GrVkRenderPass::LoadStoreOps vkStencilOps = oldRP->stencilLoadStoreOps();
 
         GrVkRenderTarget* vkRT = static_cast<GrVkRenderTarget*>(fRenderTarget);
         const GrVkResourceProvider::CompatibleRPHandle& rpHandle =
@@ -662,6 +678,9 @@ GrVkPipelineState* GrVkGpuRTCommandBuffer::prepareDrawState(
         fGpu->vkCaps().newCBOnPipelineChange()) {
         this->addAdditionalCommandBuffer();
     }
+    if (fLastPipelineState != pipelineState) {
+        fGpu->countProgramBind();
+    }
     fLastPipelineState = pipelineState;
 
     pipelineState->bindPipeline(fGpu, cbInfo.currentCmdBuf());
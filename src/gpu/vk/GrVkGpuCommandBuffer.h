@@ -58,6 +58,18 @@ private:
     typedef GrGpuTextureCommandBuffer INHERITED;
 };
 
+/**
+ * Records an opList's draws into secondary command buffers, one or more per render pass, and
+ * executes them from the GrVkGpu's primary command buffer on submit().
+ *
+ * Recording happens on the context's thread. The secondaries come from the GrVkGpu's current
+ * command pool, which must be externally synchronized, and recording a draw looks up pipeline
+ * states, samplers, descriptor sets and uniform space in the GrVkResourceProvider, none of which
+ * is thread safe. submit() is also called as soon as the opList is done, and it interleaves the
+ * opList's uploads, copies and layout transitions with the executes. Recording on other threads
+ * would need per-thread pools, executing secondaries from other pools, and deferring submit()
+ * until the end of the flush.
+ */
 class GrVkGpuRTCommandBuffer : public GrGpuRTCommandBuffer, private GrMesh::SendToGpuImpl {
 public:
     GrVkGpuRTCommandBuffer(GrVkGpu*);
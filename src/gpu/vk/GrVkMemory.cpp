@@ -89,6 +89,7 @@ const VkDeviceSize kMaxSmallImageSize = 256 * 1024;
 bool GrVkMemory::AllocAndBindImageMemory(const GrVkGpu* gpu,
                                          VkImage image,
                                          bool linearTiling,
+                                         bool lazilyAllocated,
                                          GrVkAlloc* alloc) {
     SkASSERT(!linearTiling);
     GrVkMemoryAllocator* allocator = gpu->memoryAllocator();
@@ -103,6 +104,9 @@ bool GrVkMemory::AllocAndBindImageMemory(const GrVkGpu* gpu,
     } else {
         propFlags = AllocationPropertyFlags::kNone;
     }
+    if (lazilyAllocated) {
+        propFlags |= AllocationPropertyFlags::kLazyAllocation;
+    }
 
     if (!allocator->allocateMemoryForImage(image, propFlags, &memory)) {
         return false;
@@ -170,7 +174,7 @@ void GrVkMemory::GetNonCoherentMappedMemoryRange(const GrVkAlloc& alloc, VkDevic
     offset = offset + alloc.fOffset;
     VkDeviceSize offsetDiff = offset & (alignment -1);
     offset = offset - offsetDiff;
-    size = (size + alignment - 1) & ~(alignment - 1);
+    size = (size + offsetDiff + alignment - 1) & ~(alignment - 1);
 #ifdef SK_DEBUG
     SkASSERT(offset >= alloc.fOffset);
     SkASSERT(offset + size <= alloc.fOffset + alloc.fSize);
@@ -189,8 +193,7 @@ void GrVkMemory::GetNonCoherentMappedMemoryRange(const GrVkAlloc& alloc, VkDevic
 void GrVkMemory::FlushMappedAlloc(const GrVkGpu* gpu, const GrVkAlloc& alloc, VkDeviceSize offset,
                                   VkDeviceSize size) {
     if (alloc.fFlags & GrVkAlloc::kNoncoherent_Flag) {
-        SkASSERT(offset == 0);
-        SkASSERT(size <= alloc.fSize);
+        SkASSERT(offset + size <= alloc.fSize);
         if (alloc.fBackendMemory) {
             GrVkMemoryAllocator* allocator = gpu->memoryAllocator();
             allocator->flushMappedMemory(alloc.fBackendMemory, offset, size);
@@ -208,8 +211,7 @@ void GrVkMemory::FlushMappedAlloc(const GrVkGpu* gpu, const GrVkAlloc& alloc, Vk
 void GrVkMemory::InvalidateMappedAlloc(const GrVkGpu* gpu, const GrVkAlloc& alloc,
                                        VkDeviceSize offset, VkDeviceSize size) {
     if (alloc.fFlags & GrVkAlloc::kNoncoherent_Flag) {
-        SkASSERT(offset == 0);
-        SkASSERT(size <= alloc.fSize);
+        SkASSERT(offset + size <= alloc.fSize);
         if (alloc.fBackendMemory) {
             GrVkMemoryAllocator* allocator = gpu->memoryAllocator();
             allocator->invalidateMappedMemory(alloc.fBackendMemory, offset, size);
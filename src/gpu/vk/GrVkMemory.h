@@ -26,9 +26,12 @@ namespace GrVkMemory {
                                   GrVkAlloc* alloc);
     void FreeBufferMemory(const GrVkGpu* gpu, GrVkBuffer::Type type, const GrVkAlloc& alloc);
 
+    // If lazilyAllocated, the image must be a transient attachment. We then prefer memory the
+    // device only commits if it has to.
     bool AllocAndBindImageMemory(const GrVkGpu* gpu,
                                  VkImage image,
                                  bool linearTiling,
+                                 bool lazilyAllocated,
                                  GrVkAlloc* alloc);
     void FreeImageMemory(const GrVkGpu* gpu, bool linearTiling, const GrVkAlloc& alloc);
 
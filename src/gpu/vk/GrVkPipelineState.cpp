@@ -23,6 +23,7 @@
 #include "GrVkSampler.h"
 #include "GrVkTexture.h"
 #include "GrVkUniformBuffer.h"
+#include "GrVkUniformRingBuffer.h"
 #include "SkMipMap.h"
 #include "glsl/GrGLSLFragmentProcessor.h"
 #include "glsl/GrGLSLGeometryProcessor.h"
@@ -57,8 +58,16 @@ GrVkPipelineState::GrVkPipelineState(
     fDescriptorSets[1] = VK_NULL_HANDLE;
     fDescriptorSets[2] = VK_NULL_HANDLE;
 
-    fGeometryUniformBuffer.reset(GrVkUniformBuffer::Create(gpu, geometryUniformSize));
-    fFragmentUniformBuffer.reset(GrVkUniformBuffer::Create(gpu, fragmentUniformSize));
+    fUsesUniformRingBuffer = geometryUniformSize <= GrVkUniformRingBuffer::kMaxUniformSize &&
+                             fragmentUniformSize <= GrVkUniformRingBuffer::kMaxUniformSize;
+    fUniformRingGeneration = 0;
+    fUniformOffsets[0] = 0;
+    fUniformOffsets[1] = 0;
+    fHasUniforms = geometryUniformSize || fragmentUniformSize;
+    if (!fUsesUniformRingBuffer) {
+        fGeometryUniformBuffer.reset(GrVkUniformBuffer::Create(gpu, geometryUniformSize));
+        fFragmentUniformBuffer.reset(GrVkUniformBuffer::Create(gpu, fragmentUniformSize));
+    }
 
     fNumSamplers = samplers.count();
 
@@ -105,6 +114,17 @@ void GrVkPipelineState::freeGPUResources(GrVkGpu* gpu) {
         fSamplerDescriptorSet->recycle(const_cast<GrVkGpu*>(gpu));
         fSamplerDescriptorSet = nullptr;
     }
+
+    this->releaseBoundSamplerResources(gpu);
+}
+
+void GrVkPipelineState::releaseBoundSamplerResources(GrVkGpu* gpu) {
+    for (int i = 0; i < fBoundSamplers.count(); ++i) {
+        fBoundSamplers[i]->unref(gpu);
+        fBoundImageViews[i]->unref(gpu);
+    }
+    fBoundSamplers.reset();
+    fBoundImageViews.reset();
 }
 
 void GrVkPipelineState::abandonGPUResources() {
@@ -137,6 +157,13 @@ void GrVkPipelineState::abandonGPUResources() {
         fSamplerDescriptorSet->unrefAndAbandon();
         fSamplerDescriptorSet = nullptr;
     }
+
+    for (int i = 0; i < fBoundSamplers.count(); ++i) {
+        fBoundSamplers[i]->unrefAndAbandon();
+        fBoundImageViews[i]->unrefAndAbandon();
+    }
+    fBoundSamplers.reset();
+    fBoundImageViews.reset();
 }
 
 void GrVkPipelineState::setAndBindUniforms(GrVkGpu* gpu,
@@ -167,9 +194,26 @@ void GrVkPipelineState::setAndBindUniforms(GrVkGpu* gpu,
         fXferProcessor->setData(fDataManager, pipeline.getXferProcessor(), dstTexture, offset);
     }
 
-    // Get new descriptor set
-    if (fGeometryUniformBuffer || fFragmentUniformBuffer) {
-        int uniformDSIdx = GrVkUniformHandler::kUniformBufferDescSet;
+    int uniformDSIdx = GrVkUniformHandler::kUniformBufferDescSet;
+    if (fUsesUniformRingBuffer) {
+        if (!fHasUniforms) {
+            return;
+        }
+        // Every draw in the same ring buffer shares its descriptor set; only the offsets change.
+        GrVkUniformRingBuffer* ring = gpu->resourceProvider().uniformRingBuffer();
+        if (!fDataManager.uploadUniformBuffers(gpu, ring, &fUniformRingGeneration,
+                                               fUniformOffsets)) {
+            SkDEBUGFAIL("Failed to allocate uniform data.");
+            return;
+        }
+        fDescriptorSets[uniformDSIdx] = ring->descriptorSet()->descriptorSet();
+        commandBuffer->bindDescriptorSets(gpu, this, fPipelineLayout, uniformDSIdx, 1,
+                                          &fDescriptorSets[uniformDSIdx],
+                                          SK_ARRAY_COUNT(fUniformOffsets), fUniformOffsets);
+        commandBuffer->addResource(ring->descriptorSet());
+        commandBuffer->addResource(ring->resource());
+    } else if (fGeometryUniformBuffer || fFragmentUniformBuffer) {
+        // Get new descriptor set
         if (fDataManager.uploadUniformBuffers(
                     gpu, fGeometryUniformBuffer.get(), fFragmentUniformBuffer.get()) ||
             !fUniformDescriptorSet) {
@@ -180,8 +224,10 @@ void GrVkPipelineState::setAndBindUniforms(GrVkGpu* gpu,
             fDescriptorSets[uniformDSIdx] = fUniformDescriptorSet->descriptorSet();
             this->writeUniformBuffers(gpu);
         }
+        // Our buffers start at the descriptors' own offsets, so the dynamic offsets stay 0.
         commandBuffer->bindDescriptorSets(gpu, this, fPipelineLayout, uniformDSIdx, 1,
-                                          &fDescriptorSets[uniformDSIdx], 0, nullptr);
+                                          &fDescriptorSets[uniformDSIdx],
+                                          SK_ARRAY_COUNT(fUniformOffsets), fUniformOffsets);
         if (fUniformDescriptorSet) {
             commandBuffer->addRecycledResource(fUniformDescriptorSet);
         }
@@ -237,53 +283,72 @@ void GrVkPipelineState::setAndBindTextures(GrVkGpu* gpu,
                 static_cast<GrVkTexture*>(dstTextureProxy->peekTexture())};
     }
 
-    // Get new descriptor set
     SkASSERT(fNumSamplers == currTextureBinding);
     if (fNumSamplers) {
-        if (fSamplerDescriptorSet) {
-            fSamplerDescriptorSet->recycle(gpu);
-        }
-        fSamplerDescriptorSet = gpu->resourceProvider().getSamplerDescriptorSet(fSamplerDSHandle);
-        int samplerDSIdx = GrVkUniformHandler::kSamplerDescSet;
-        fDescriptorSets[samplerDSIdx] = fSamplerDescriptorSet->descriptorSet();
+        SkAutoSTMalloc<8, const GrVkSampler*> samplers(fNumSamplers);
+        bool matchesBoundSet = fSamplerDescriptorSet && fBoundSamplers.count() == fNumSamplers;
         for (int i = 0; i < fNumSamplers; ++i) {
-            const GrSamplerState& state = samplerBindings[i].fState;
-            GrVkTexture* texture = samplerBindings[i].fTexture;
-
-            const GrVkImageView* textureView = texture->textureView();
-            const GrVkSampler* sampler = nullptr;
             if (fImmutableSamplers[i]) {
-                sampler = fImmutableSamplers[i];
+                samplers[i] = fImmutableSamplers[i];
             } else {
-                sampler = gpu->resourceProvider().findOrCreateCompatibleSampler(
-                    state, texture->ycbcrConversionInfo());
+                GrVkTexture* texture = samplerBindings[i].fTexture;
+                samplers[i] = gpu->resourceProvider().findOrCreateCompatibleSampler(
+                        samplerBindings[i].fState, texture->ycbcrConversionInfo());
+            }
+            SkASSERT(samplers[i]);
+            matchesBoundSet = matchesBoundSet && samplers[i] == fBoundSamplers[i] &&
+                              samplerBindings[i].fTexture->textureView() == fBoundImageViews[i];
+        }
+
+        int samplerDSIdx = GrVkUniformHandler::kSamplerDescSet;
+        // The set we last wrote can't be changed while it may be in flight, but if this draw
+        // samples the same textures the same way it can be bound again without any writes.
+        if (!matchesBoundSet) {
+            if (fSamplerDescriptorSet) {
+                fSamplerDescriptorSet->recycle(gpu);
+            }
+            this->releaseBoundSamplerResources(gpu);
+            fSamplerDescriptorSet =
+                    gpu->resourceProvider().getSamplerDescriptorSet(fSamplerDSHandle);
+            fDescriptorSets[samplerDSIdx] = fSamplerDescriptorSet->descriptorSet();
+
+            SkAutoSTMalloc<8, VkDescriptorImageInfo> imageInfos(fNumSamplers);
+            SkAutoSTMalloc<8, VkWriteDescriptorSet> writeInfos(fNumSamplers);
+            for (int i = 0; i < fNumSamplers; ++i) {
+                const GrVkImageView* textureView = samplerBindings[i].fTexture->textureView();
+
+                VkDescriptorImageInfo& imageInfo = imageInfos[i];
+                memset(&imageInfo, 0, sizeof(VkDescriptorImageInfo));
+                imageInfo.sampler = samplers[i]->sampler();
+                imageInfo.imageView = textureView->imageView();
+                imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+                VkWriteDescriptorSet& writeInfo = writeInfos[i];
+                memset(&writeInfo, 0, sizeof(VkWriteDescriptorSet));
+                writeInfo.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                writeInfo.pNext = nullptr;
+                writeInfo.dstSet = fDescriptorSets[samplerDSIdx];
+                writeInfo.dstBinding = i;
+                writeInfo.dstArrayElement = 0;
+                writeInfo.descriptorCount = 1;
+                writeInfo.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+                writeInfo.pImageInfo = &imageInfo;
+                writeInfo.pBufferInfo = nullptr;
+                writeInfo.pTexelBufferView = nullptr;
+
+                samplers[i]->ref();
+                fBoundSamplers.push_back(samplers[i]);
+                textureView->ref();
+                fBoundImageViews.push_back(textureView);
             }
-            SkASSERT(sampler);
-
-            VkDescriptorImageInfo imageInfo;
-            memset(&imageInfo, 0, sizeof(VkDescriptorImageInfo));
-            imageInfo.sampler = sampler->sampler();
-            imageInfo.imageView = textureView->imageView();
-            imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-            VkWriteDescriptorSet writeInfo;
-            memset(&writeInfo, 0, sizeof(VkWriteDescriptorSet));
-            writeInfo.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            writeInfo.pNext = nullptr;
-            writeInfo.dstSet = fDescriptorSets[GrVkUniformHandler::kSamplerDescSet];
-            writeInfo.dstBinding = i;
-            writeInfo.dstArrayElement = 0;
-            writeInfo.descriptorCount = 1;
-            writeInfo.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-            writeInfo.pImageInfo = &imageInfo;
-            writeInfo.pBufferInfo = nullptr;
-            writeInfo.pTexelBufferView = nullptr;
-
-            GR_VK_CALL(gpu->vkInterface(),
-                       UpdateDescriptorSets(gpu->device(), 1, &writeInfo, 0, nullptr));
-            commandBuffer->addResource(sampler);
+            GR_VK_CALL(gpu->vkInterface(), UpdateDescriptorSets(gpu->device(), fNumSamplers,
+                                                                writeInfos.get(), 0, nullptr));
+        }
+
+        for (int i = 0; i < fNumSamplers; ++i) {
+            commandBuffer->addResource(samplers[i]);
             if (!fImmutableSamplers[i]) {
-                sampler->unref(gpu);
+                samplers[i]->unref(gpu);
             }
             commandBuffer->addResource(samplerBindings[i].fTexture->textureView());
             commandBuffer->addResource(samplerBindings[i].fTexture->resource());
@@ -313,7 +378,7 @@ void set_uniform_descriptor_writes(VkWriteDescriptorSet* descriptorWrite,
     descriptorWrite->dstBinding = binding;
     descriptorWrite->dstArrayElement = 0;
     descriptorWrite->descriptorCount = 1;
-    descriptorWrite->descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    descriptorWrite->descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     descriptorWrite->pImageInfo = nullptr;
     descriptorWrite->pBufferInfo = bufferInfo;
     descriptorWrite->pTexelBufferView = nullptr;
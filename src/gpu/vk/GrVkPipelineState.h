@@ -22,6 +22,7 @@ class GrVkDescriptorPool;
 class GrVkDescriptorSet;
 class GrVkGpu;
 class GrVkImageView;
+class GrVkImageView;
 class GrVkPipeline;
 class GrVkPipelineLayout;
 class GrVkSampler;
@@ -76,6 +77,7 @@ public:
 
 private:
     void writeUniformBuffers(const GrVkGpu* gpu);
+    void releaseBoundSamplerResources(GrVkGpu* gpu);
 
     /**
      * We use the RT's size and origin to adjust from Skia device space to vulkan normalized device
@@ -137,6 +139,18 @@ private:
 
     SkSTArray<4, const GrVkSampler*>   fImmutableSamplers;
 
+    // The samplers and image views fSamplerDescriptorSet was written with. We hold refs on them so
+    // that when a draw's match, the set is still valid and can be bound again as is.
+    SkSTArray<4, const GrVkSampler*>   fBoundSamplers;
+    SkSTArray<4, const GrVkImageView*> fBoundImageViews;
+
+    // Unless a uniform block is too big for it, our uniforms go in the GrVkUniformRingBuffer and
+    // are bound with dynamic offsets. Otherwise we have buffers of our own.
+    bool     fUsesUniformRingBuffer;
+    bool     fHasUniforms;
+    uint32_t fUniformRingGeneration;
+    uint32_t fUniformOffsets[2];
+
     std::unique_ptr<GrVkUniformBuffer> fGeometryUniformBuffer;
     std::unique_ptr<GrVkUniformBuffer> fFragmentUniformBuffer;
 
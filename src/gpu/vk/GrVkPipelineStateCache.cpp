@@ -68,10 +68,12 @@ void GrVkResourceProvider::PipelineStateCache::abandon() {
         (*e)->fPipelineState = nullptr;
     });
     fMap.reset();
+    fLastEntry = nullptr;
 }
 
 void GrVkResourceProvider::PipelineStateCache::release() {
     fMap.reset();
+    fLastEntry = nullptr;
 }
 
 GrVkPipelineState* GrVkResourceProvider::PipelineStateCache::refPipelineState(
@@ -100,6 +102,11 @@ GrVkPipelineState* GrVkResourceProvider::PipelineStateCache::refPipelineState(
         GrCapsDebugf(fGpu->caps(), "Failed to build vk program descriptor!\n");
         return nullptr;
     }
+    if (fLastEntry && origin == fLastOrigin && desc == fLastDesc) {
+        return (*fLastEntry)->fPipelineState.get();
+    }
+    fLastEntry = nullptr;
+    fLastDesc = desc;
 
     std::unique_ptr<Entry>* entry = fMap.find(desc);
     if (!entry) {
@@ -118,7 +125,8 @@ GrVkPipelineState* GrVkResourceProvider::PipelineStateCache::refPipelineState(
             return nullptr;
         }
         entry = fMap.insert(desc, std::unique_ptr<Entry>(new Entry(fGpu, pipelineState)));
-        return (*entry)->fPipelineState.get();
     }
+    fLastEntry = entry;
+    fLastOrigin = origin;
     return (*entry)->fPipelineState.get();
 }
@@ -9,6 +9,7 @@
 
 #include "GrVkGpu.h"
 #include "GrVkUniformBuffer.h"
+#include "GrVkUniformRingBuffer.h"
 
 GrVkPipelineStateDataManager::GrVkPipelineStateDataManager(const UniformInfoArray& uniforms,
                                                            uint32_t geometryUniformSize,
@@ -376,3 +377,23 @@ bool GrVkPipelineStateDataManager::uploadUniformBuffers(GrVkGpu* gpu,
 
     return updatedBuffer;
 }
+
+bool GrVkPipelineStateDataManager::uploadUniformBuffers(GrVkGpu* gpu,
+                                                        GrVkUniformRingBuffer* ring,
+                                                        uint32_t* generation,
+                                                        uint32_t offsets[2]) const {
+    if (!ring->reserve(gpu, fGeometryUniformSize + fFragmentUniformSize)) {
+        return false;
+    }
+    bool uploadAll = *generation != ring->generation();
+    if (fGeometryUniformSize && (fGeometryUniformsDirty || uploadAll)) {
+        offsets[0] = ring->upload(gpu, fGeometryUniformData.get(), fGeometryUniformSize);
+        fGeometryUniformsDirty = false;
+    }
+    if (fFragmentUniformSize && (fFragmentUniformsDirty || uploadAll)) {
+        offsets[1] = ring->upload(gpu, fFragmentUniformData.get(), fFragmentUniformSize);
+        fFragmentUniformsDirty = false;
+    }
+    *generation = ring->generation();
+    return true;
+}
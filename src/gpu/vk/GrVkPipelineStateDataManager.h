@@ -16,6 +16,7 @@
 
 class GrVkGpu;
 class GrVkUniformBuffer;
+class GrVkUniformRingBuffer;
 
 class GrVkPipelineStateDataManager : public GrGLSLProgramDataManager {
 public:
@@ -62,6 +63,13 @@ public:
     bool uploadUniformBuffers(GrVkGpu* gpu,
                               GrVkUniformBuffer* geometryBuffer,
                               GrVkUniformBuffer* fragmentBuffer) const;
+
+    // Copies the geometry and fragment uniforms into the ring buffer and writes their dynamic
+    // offsets to offsets[0] and offsets[1]. Uniforms that are clean keep their old offsets, unless
+    // the ring has moved on from *generation, the generation those offsets were handed out in.
+    // Returns false if the ring couldn't make room.
+    bool uploadUniformBuffers(GrVkGpu* gpu, GrVkUniformRingBuffer* ring, uint32_t* generation,
+                              uint32_t offsets[2]) const;
 private:
     struct Uniform {
         uint32_t fBinding;
@@ -114,6 +114,13 @@ public:
     bool equalLoadStoreOps(const LoadStoreOps& colorOps,
                            const LoadStoreOps& stencilOps) const;
 
+    const LoadStoreOps& colorLoadStoreOps() const {
+        return fAttachmentsDescriptor.fColor.fLoadStoreOps;
+    }
+    const LoadStoreOps& stencilLoadStoreOps() const {
+        return fAttachmentsDescriptor.fStencil.fLoadStoreOps;
+    }
+
     VkRenderPass vkRenderPass() const { return fRenderPass; }
 
     const VkExtent2D& granularity() const { return fGranularity; }
@@ -25,7 +25,8 @@ std::atomic<uint32_t> GrVkResource::fKeyCounter{0};
 
 GrVkResourceProvider::GrVkResourceProvider(GrVkGpu* gpu)
     : fGpu(gpu)
-    , fPipelineCache(VK_NULL_HANDLE) {
+    , fPipelineCache(VK_NULL_HANDLE)
+    , fPipelineCacheDirty(false) {
     fPipelineStateCache = new PipelineStateCache(gpu);
 }
 
@@ -52,7 +53,7 @@ VkPipelineCache GrVkResourceProvider::pipelineCache() {
             cached = persistentCache->load(*keyData);
         }
         bool usedCached = false;
-        if (cached) {
+        if (cached && cached->size() >= 16 + VK_UUID_SIZE) {
             uint32_t* cacheHeader = (uint32_t*)cached->data();
             if (cacheHeader[1] == VK_PIPELINE_CACHE_HEADER_VERSION_ONE) {
                 // For version one of the header, the total header size is 16 bytes plus
@@ -101,9 +102,14 @@ GrVkPipeline* GrVkResourceProvider::createPipeline(int numColorSamples,
                                                    GrPrimitiveType primitiveType,
                                                    VkRenderPass compatibleRenderPass,
                                                    VkPipelineLayout layout) {
-    return GrVkPipeline::Create(fGpu, numColorSamples, primProc, pipeline, stencil, shaderStageInfo,
-                                shaderStageCount, primitiveType, compatibleRenderPass, layout,
-                                this->pipelineCache());
+    GrVkPipeline* vkPipeline = GrVkPipeline::Create(fGpu, numColorSamples, primProc, pipeline,
+                                                    stencil, shaderStageInfo, shaderStageCount,
+                                                    primitiveType, compatibleRenderPass, layout,
+                                                    this->pipelineCache());
+    if (vkPipeline) {
+        fPipelineCacheDirty = true;
+    }
+    return vkPipeline;
 }
 
 GrVkCopyPipeline* GrVkResourceProvider::findOrCreateCopyPipeline(
@@ -126,6 +132,7 @@ GrVkCopyPipeline* GrVkResourceProvider::findOrCreateCopyPipeline(
         if (!pipeline) {
             return nullptr;
         }
+        fPipelineCacheDirty = true;
         fCopyPipelines.push_back(pipeline);
     }
     SkASSERT(pipeline);
@@ -428,6 +435,12 @@ void GrVkResourceProvider::destroyResources(bool deviceLost) {
 
     fPipelineStateCache->release();
 
+    // Don't lose the pipelines created since the client last stored the cache data. A lost device
+    // may not hand back anything useful.
+    if (!deviceLost && fGpu->getContext()->priv().getPersistentCache()) {
+        this->storePipelineCacheData();
+    }
+
     GR_VK_CALL(fGpu->vkInterface(), DestroyPipelineCache(fGpu->device(), fPipelineCache, nullptr));
     fPipelineCache = VK_NULL_HANDLE;
 
@@ -443,6 +456,9 @@ void GrVkResourceProvider::destroyResources(bool deviceLost) {
     }
     fAvailableCommandPools.reset();
 
+    fUniformRingBuffer.release(fGpu);
+    fStagingRingBuffer.release(fGpu);
+
     // We must release/destroy all command buffers and pipeline states before releasing the
     // GrVkDescriptorSetManagers
     for (int i = 0; i < fDescriptorSetManagers.count(); ++i) {
@@ -503,6 +519,9 @@ void GrVkResourceProvider::abandonResources() {
 
     fPipelineCache = VK_NULL_HANDLE;
 
+    fUniformRingBuffer.abandon();
+    fStagingRingBuffer.abandon();
+
     // We must abandon all command buffers and pipeline states before abandoning the
     // GrVkDescriptorSetManagers
     for (int i = 0; i < fDescriptorSetManagers.count(); ++i) {
@@ -539,25 +558,37 @@ void GrVkResourceProvider::reset(GrVkCommandPool* pool) {
 }
 
 void GrVkResourceProvider::storePipelineCacheData() {
+    // Nothing new has gone into the cache since it was loaded or last stored.
+    if (!fPipelineCacheDirty || VK_NULL_HANDLE == fPipelineCache) {
+        return;
+    }
+
     size_t dataSize = 0;
     VkResult result = GR_VK_CALL(fGpu->vkInterface(), GetPipelineCacheData(fGpu->device(),
-                                                                           this->pipelineCache(),
+                                                                           fPipelineCache,
                                                                            &dataSize, nullptr));
     SkASSERT(result == VK_SUCCESS);
+    if (VK_SUCCESS != result || !dataSize) {
+        return;
+    }
 
     std::unique_ptr<uint8_t[]> data(new uint8_t[dataSize]);
 
     result = GR_VK_CALL(fGpu->vkInterface(), GetPipelineCacheData(fGpu->device(),
-                                                                  this->pipelineCache(),
+                                                                  fPipelineCache,
                                                                   &dataSize,
                                                                   (void*)data.get()));
     SkASSERT(result == VK_SUCCESS);
+    if (VK_SUCCESS != result) {
+        return;
+    }
 
     uint32_t key = GrVkGpu::kPipelineCache_PersistentCacheKeyType;
     sk_sp<SkData> keyData = SkData::MakeWithoutCopy(&key, sizeof(uint32_t));
 
     fGpu->getContext()->priv().getPersistentCache()->store(
             *keyData, *SkData::MakeWithoutCopy(data.get(), dataSize));
+    fPipelineCacheDirty = false;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -16,6 +16,8 @@
 #include "GrVkResource.h"
 #include "GrVkSampler.h"
 #include "GrVkSamplerYcbcrConversion.h"
+#include "GrVkStagingRingBuffer.h"
+#include "GrVkUniformRingBuffer.h"
 #include "GrVkUtil.h"
 #include "SkLRUCache.h"
 #include "SkTArray.h"
@@ -157,6 +159,12 @@ public:
     void recycleDescriptorSet(const GrVkDescriptorSet* descSet,
                               const GrVkDescriptorSetManager::Handle&);
 
+    // The ring that draws suballocate their uniform data from.
+    GrVkUniformRingBuffer* uniformRingBuffer() { return &fUniformRingBuffer; }
+
+    // The ring that small texture uploads suballocate their staging data from.
+    GrVkStagingRingBuffer* stagingRingBuffer() { return &fStagingRingBuffer; }
+
     // Creates or finds free uniform buffer resources of size GrVkUniformBuffer::kStandardSize.
     // Anything larger will need to be created and released by the client.
     const GrVkResource* findOrCreateStandardUniformBufferResource();
@@ -165,6 +173,9 @@ public:
     // can be reused by the next uniform buffer resource request.
     void recycleStandardUniformBufferResource(const GrVkResource*);
 
+    // Writes the VkPipelineCache's data to the context's PersistentCache, if any pipelines were
+    // created since it was loaded or last stored. This also happens when the resources are
+    // destroyed.
     void storePipelineCacheData();
 
     // Destroy any cached resources. To be called before destroying the VkDevice.
@@ -221,6 +232,13 @@ private:
 
         SkLRUCache<const GrVkPipelineStateBuilder::Desc, std::unique_ptr<Entry>, DescHash> fMap;
 
+        // The last pipeline state found, and the (origin-independent) desc and the origin it was
+        // found for. Consecutive draws often share a pipeline state, and this lets them skip the
+        // hash lookup.
+        std::unique_ptr<Entry>*          fLastEntry = nullptr;
+        GrVkPipelineStateBuilder::Desc   fLastDesc;
+        GrSurfaceOrigin                  fLastOrigin;
+
         GrVkGpu*                    fGpu;
 
 #ifdef GR_PIPELINE_STATE_CACHE_STATS
@@ -263,6 +281,8 @@ private:
 
     // Central cache for creating pipelines
     VkPipelineCache fPipelineCache;
+    // Whether pipelines have been created since fPipelineCache was loaded or last stored.
+    bool fPipelineCacheDirty;
 
     // Cache of previously created copy pipelines
     SkTArray<GrVkCopyPipeline*> fCopyPipelines;
@@ -280,6 +300,10 @@ private:
     // Array of available uniform buffer resources
     SkSTArray<16, const GrVkResource*, true> fAvailableUniformBufferResources;
 
+    GrVkUniformRingBuffer fUniformRingBuffer;
+
+    GrVkStagingRingBuffer fStagingRingBuffer;
+
     // Stores GrVkSampler objects that we've already created so we can reuse them across multiple
     // GrVkPipelineStates
     SkTDynamicHash<GrVkSampler, GrVkSampler::Key> fSamplers;
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrVkStagingRingBuffer.h"
+
+#include "GrVkGpu.h"
+#include "GrVkMemory.h"
+
+class GrVkStagingRingBuffer::Buffer : public GrVkBuffer {
+public:
+    static std::unique_ptr<Buffer> Make(GrVkGpu* gpu) {
+        GrVkBuffer::Desc desc;
+        desc.fDynamic = true;
+        desc.fType = GrVkBuffer::kCopyRead_Type;
+        desc.fSizeInBytes = kBufferSize;
+
+        const GrVkBuffer::Resource* resource = GrVkBuffer::Create(gpu, desc);
+        if (!resource) {
+            return nullptr;
+        }
+        std::unique_ptr<Buffer> buffer(new Buffer(desc, resource));
+        buffer->fMapPtr = static_cast<char*>(buffer->vkMap(gpu));
+        if (!buffer->fMapPtr) {
+            buffer->vkRelease(gpu);
+            return nullptr;
+        }
+        return buffer;
+    }
+
+    char* mapPtr() const { return fMapPtr; }
+
+    void release(GrVkGpu* gpu) {
+        this->vkUnmap(gpu);
+        this->vkRelease(gpu);
+    }
+    void abandon() { this->vkAbandon(); }
+
+private:
+    Buffer(const GrVkBuffer::Desc& desc, const GrVkBuffer::Resource* resource)
+            : INHERITED(desc, resource) {}
+
+    char* fMapPtr = nullptr;
+
+    typedef GrVkBuffer INHERITED;
+};
+
+GrVkStagingRingBuffer::GrVkStagingRingBuffer() = default;
+
+GrVkStagingRingBuffer::~GrVkStagingRingBuffer() {
+    // Must have freed all GPU resources before this is destroyed
+    SkASSERT(fBuffers.empty());
+}
+
+bool GrVkStagingRingBuffer::allocate(GrVkGpu* gpu, size_t size, size_t alignment, Slice* slice) {
+    SkASSERT(size <= kMaxUploadSize);
+    SkASSERT(SkIsPow2(alignment));
+    size_t offset = (fOffset + alignment - 1) & ~(alignment - 1);
+    if (fCurrent < 0 || offset + size > kBufferSize) {
+        // Look for a buffer the GPU is done with, starting with the one we've gone longest without.
+        int next = -1;
+        for (int i = 1; i <= fBuffers.count() && next < 0; ++i) {
+            int index = (fCurrent + i) % fBuffers.count();
+            if (index != fCurrent && fBuffers[index]->resource()->unique()) {
+                next = index;
+            }
+        }
+        if (next < 0) {
+            std::unique_ptr<Buffer> buffer = Buffer::Make(gpu);
+            if (!buffer) {
+                return false;
+            }
+            fBuffers.push_back(std::move(buffer));
+            next = fBuffers.count() - 1;
+        }
+        fCurrent = next;
+        offset = 0;
+    }
+
+    Buffer* buffer = fBuffers[fCurrent].get();
+    slice->fBuffer = buffer;
+    slice->fOffset = buffer->offset() + offset;
+    slice->fData = buffer->mapPtr() + offset;
+    fOffset = offset + size;
+    return true;
+}
+
+void GrVkStagingRingBuffer::flush(GrVkGpu* gpu, const Slice& slice, size_t size) {
+    SkASSERT(fCurrent >= 0 && slice.fBuffer == fBuffers[fCurrent].get());
+    GrVkMemory::FlushMappedAlloc(gpu, slice.fBuffer->alloc(),
+                                 slice.fOffset - slice.fBuffer->offset(), size);
+}
+
+void GrVkStagingRingBuffer::release(GrVkGpu* gpu) {
+    for (const std::unique_ptr<Buffer>& buffer : fBuffers) {
+        buffer->release(gpu);
+    }
+    fBuffers.reset();
+    fCurrent = -1;
+    fOffset = 0;
+}
+
+void GrVkStagingRingBuffer::abandon() {
+    for (const std::unique_ptr<Buffer>& buffer : fBuffers) {
+        buffer->abandon();
+    }
+    fBuffers.reset();
+    fCurrent = -1;
+    fOffset = 0;
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrVkStagingRingBuffer_DEFINED
+#define GrVkStagingRingBuffer_DEFINED
+
+#include "GrVkBuffer.h"
+#include "SkTArray.h"
+#include "vk/GrVkTypes.h"
+
+#include <memory>
+
+class GrVkGpu;
+
+/**
+ * Suballocates the staging data of texture uploads from a set of persistently mapped transfer
+ * buffers, so that the many small uploads of a flush (glyphs, software masks) don't each create,
+ * map and free their own buffer.
+ *
+ * When the current buffer fills up we move to one that no command buffer refers to anymore, or
+ * make a new one.
+ */
+class GrVkStagingRingBuffer {
+public:
+    static const size_t kBufferSize = 256 * 1024;
+    // Larger uploads keep using their own GrVkTransferBuffers, so that one big upload doesn't
+    // waste most of a buffer.
+    static const size_t kMaxUploadSize = kBufferSize / 4;
+
+    struct Slice {
+        GrVkBuffer*  fBuffer = nullptr;
+        // The offset of the slice in fBuffer's VkBuffer.
+        VkDeviceSize fOffset = 0;
+        char*        fData = nullptr;
+    };
+
+    GrVkStagingRingBuffer();
+    ~GrVkStagingRingBuffer();
+
+    /**
+     * Suballocates size bytes, aligned to alignment, which must be a power of two. size must be at
+     * most kMaxUploadSize. Returns false if no buffer could be made.
+     */
+    bool allocate(GrVkGpu*, size_t size, size_t alignment, Slice*);
+
+    // Makes the first size bytes written to the slice visible to the GPU.
+    void flush(GrVkGpu*, const Slice&, size_t size);
+
+    void release(GrVkGpu*);
+    void abandon();
+
+private:
+    class Buffer;
+
+    SkTArray<std::unique_ptr<Buffer>> fBuffers;
+    int                               fCurrent = -1;
+    size_t                            fOffset = 0;
+};
+
+#endif
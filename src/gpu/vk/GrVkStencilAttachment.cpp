@@ -40,9 +40,13 @@ GrVkStencilAttachment* GrVkStencilAttachment::Create(GrVkGpu* gpu,
     imageDesc.fLevels = 1;
     imageDesc.fSamples = sampleCnt;
     imageDesc.fImageTiling = VK_IMAGE_TILING_OPTIMAL;
+    // The stencil is only ever used as an attachment, and normally isn't loaded or stored by render
+    // passes (see GrRenderTargetOpList::onExecute). So tiling GPUs may never need to back it with
+    // memory at all.
     imageDesc.fUsageFlags = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT |
-                            VK_IMAGE_USAGE_TRANSFER_DST_BIT;
-    imageDesc.fMemProps = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+                            VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+    imageDesc.fMemProps = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT |
+                          VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
 
     GrVkImageInfo info;
     if (!GrVkImage::InitImageInfo(gpu, imageDesc, &info)) {
@@ -0,0 +1,145 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrVkUniformRingBuffer.h"
+
+#include "GrVkDescriptorSet.h"
+#include "GrVkGpu.h"
+#include "GrVkMemory.h"
+#include "GrVkUniformBuffer.h"
+#include "GrVkUniformHandler.h"
+#include "SkTo.h"
+
+GrVkUniformRingBuffer::~GrVkUniformRingBuffer() {
+    // Must have freed all GPU resources before this is destroyed
+    SkASSERT(fBuffers.empty());
+}
+
+static size_t uniform_offset_alignment(const GrVkGpu* gpu) {
+    return gpu->physicalDeviceProperties().limits.minUniformBufferOffsetAlignment;
+}
+
+bool GrVkUniformRingBuffer::reserve(GrVkGpu* gpu, size_t size) {
+    SkASSERT(size <= 2 * kMaxUniformSize);
+    size_t alignment = uniform_offset_alignment(gpu);
+    // Both uploads may need padding, and the last one's descriptor range must fit in the buffer.
+    if (fCurrent >= 0 &&
+        GrSizeAlignUp(fOffset, alignment) + size + alignment + kMaxUniformSize <= kBufferSize) {
+        return true;
+    }
+
+    // Look for a buffer the GPU is done with, starting with the one we've gone longest without.
+    int next = -1;
+    for (int i = 1; i <= fBuffers.count() && next < 0; ++i) {
+        int index = (fCurrent + i) % fBuffers.count();
+        if (index != fCurrent && fBuffers[index].fBuffer->resource()->unique() &&
+            fBuffers[index].fDescriptorSet->unique()) {
+            next = index;
+        }
+    }
+    if (next < 0) {
+        Buffer& buffer = fBuffers.push_back();
+        if (!this->makeBuffer(gpu, &buffer)) {
+            fBuffers.pop_back();
+            return false;
+        }
+        next = fBuffers.count() - 1;
+    }
+
+    fCurrent = next;
+    fOffset = 0;
+    ++fGeneration;
+    return true;
+}
+
+bool GrVkUniformRingBuffer::makeBuffer(GrVkGpu* gpu, Buffer* buffer) {
+    buffer->fBuffer.reset(GrVkUniformBuffer::Create(gpu, kBufferSize));
+    if (!buffer->fBuffer) {
+        return false;
+    }
+    buffer->fMapPtr = static_cast<char*>(buffer->fBuffer->map(gpu));
+    if (!buffer->fMapPtr) {
+        buffer->fBuffer->release(gpu);
+        buffer->fBuffer.reset();
+        return false;
+    }
+
+    buffer->fDescriptorSet = gpu->resourceProvider().getUniformDescriptorSet();
+    SkASSERT(buffer->fDescriptorSet);
+
+    VkDescriptorBufferInfo bufferInfo;
+    memset(&bufferInfo, 0, sizeof(VkDescriptorBufferInfo));
+    bufferInfo.buffer = buffer->fBuffer->buffer();
+    bufferInfo.offset = buffer->fBuffer->offset();
+    bufferInfo.range = kMaxUniformSize;
+
+    static const uint32_t kBindings[] = { GrVkUniformHandler::kGeometryBinding,
+                                          GrVkUniformHandler::kFragBinding };
+    VkWriteDescriptorSet descriptorWrites[SK_ARRAY_COUNT(kBindings)];
+    for (size_t i = 0; i < SK_ARRAY_COUNT(kBindings); ++i) {
+        memset(&descriptorWrites[i], 0, sizeof(VkWriteDescriptorSet));
+        descriptorWrites[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptorWrites[i].pNext = nullptr;
+        descriptorWrites[i].dstSet = buffer->fDescriptorSet->descriptorSet();
+        descriptorWrites[i].dstBinding = kBindings[i];
+        descriptorWrites[i].dstArrayElement = 0;
+        descriptorWrites[i].descriptorCount = 1;
+        descriptorWrites[i].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+        descriptorWrites[i].pImageInfo = nullptr;
+        descriptorWrites[i].pBufferInfo = &bufferInfo;
+        descriptorWrites[i].pTexelBufferView = nullptr;
+    }
+    GR_VK_CALL(gpu->vkInterface(), UpdateDescriptorSets(gpu->device(),
+                                                        SK_ARRAY_COUNT(descriptorWrites),
+                                                        descriptorWrites,
+                                                        0, nullptr));
+    return true;
+}
+
+uint32_t GrVkUniformRingBuffer::upload(GrVkGpu* gpu, const void* data, size_t size) {
+    SkASSERT(fCurrent >= 0);
+    SkASSERT(size <= kMaxUniformSize);
+    size_t offset = GrSizeAlignUp(fOffset, uniform_offset_alignment(gpu));
+    SkASSERT(offset + kMaxUniformSize <= kBufferSize);
+
+    const Buffer& buffer = fBuffers[fCurrent];
+    memcpy(buffer.fMapPtr + offset, data, size);
+    GrVkMemory::FlushMappedAlloc(gpu, buffer.fBuffer->alloc(), offset, size);
+    fOffset = offset + size;
+    return SkToU32(offset);
+}
+
+const GrVkDescriptorSet* GrVkUniformRingBuffer::descriptorSet() const {
+    SkASSERT(fCurrent >= 0);
+    return fBuffers[fCurrent].fDescriptorSet;
+}
+
+const GrVkResource* GrVkUniformRingBuffer::resource() const {
+    SkASSERT(fCurrent >= 0);
+    return fBuffers[fCurrent].fBuffer->resource();
+}
+
+void GrVkUniformRingBuffer::release(GrVkGpu* gpu) {
+    for (Buffer& buffer : fBuffers) {
+        buffer.fBuffer->unmap(gpu);
+        buffer.fBuffer->release(gpu);
+        buffer.fDescriptorSet->recycle(gpu);
+    }
+    fBuffers.reset();
+    fCurrent = -1;
+    fOffset = 0;
+}
+
+void GrVkUniformRingBuffer::abandon() {
+    for (Buffer& buffer : fBuffers) {
+        buffer.fBuffer->abandon();
+        buffer.fDescriptorSet->unrefAndAbandon();
+    }
+    fBuffers.reset();
+    fCurrent = -1;
+    fOffset = 0;
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrVkUniformRingBuffer_DEFINED
+#define GrVkUniformRingBuffer_DEFINED
+
+#include "GrVkUniformBuffer.h"
+#include "SkTArray.h"
+#include "vk/GrVkTypes.h"
+
+#include <memory>
+
+class GrVkDescriptorSet;
+class GrVkGpu;
+class GrVkResource;
+
+/**
+ * Suballocates the uniform data of draws from a set of large, persistently mapped uniform buffers.
+ * Each buffer comes with a uniform descriptor set, written once when the buffer is created, whose
+ * geometry and fragment bindings are dynamic uniform buffers covering kMaxUniformSize bytes. Draws
+ * bind that set with dynamic offsets to their own data, so the steady state allocates and writes no
+ * descriptor sets at all.
+ *
+ * When the current buffer fills up we move to one that no command buffer refers to anymore, or
+ * make a new one.
+ */
+class GrVkUniformRingBuffer {
+public:
+    // The range of the dynamic uniform descriptors. Pipeline states with larger uniform blocks keep
+    // using their own GrVkUniformBuffers.
+    static const uint32_t kMaxUniformSize = 4096;
+    static const size_t kBufferSize = 64 * 1024;
+
+    GrVkUniformRingBuffer() = default;
+    ~GrVkUniformRingBuffer();
+
+    /**
+     * Makes sure the current buffer has room for size bytes of uniforms in up to two uploads,
+     * moving on to another buffer if it doesn't. Returns false if no buffer could be made.
+     */
+    bool reserve(GrVkGpu*, size_t size);
+
+    /**
+     * Changes whenever reserve() moves to another buffer. Offsets from an earlier generation are
+     * not valid with the current descriptor set.
+     */
+    uint32_t generation() const { return fGeneration; }
+
+    /**
+     * Copies size bytes into the current buffer and returns the dynamic offset to bind them at.
+     * This must be covered by a preceding reserve() and size must be at most kMaxUniformSize.
+     */
+    uint32_t upload(GrVkGpu*, const void* data, size_t size);
+
+    // The current buffer's descriptor set and buffer resource. Command buffers that bind the set
+    // must also hold refs on both.
+    const GrVkDescriptorSet* descriptorSet() const;
+    const GrVkResource* resource() const;
+
+    void release(GrVkGpu*);
+    void abandon();
+
+private:
+    struct Buffer {
+        std::unique_ptr<GrVkUniformBuffer> fBuffer;
+        const GrVkDescriptorSet*           fDescriptorSet = nullptr;
+        char*                              fMapPtr = nullptr;
+    };
+
+    bool makeBuffer(GrVkGpu*, Buffer*);
+
+    SkTArray<Buffer> fBuffers;
+    int              fCurrent = -1;
+    size_t           fOffset = 0;
+    uint32_t         fGeneration = 0;
+};
+
+#endif
@@ -307,6 +307,14 @@ bool SkImage::isLazyGenerated() const {
     return as_IB(this)->onIsLazyGenerated();
 }
 
+void SkImage::prefetchDecode(SkExecutor& executor, int priority) const {
+    as_IB(this)->onPrefetchDecode(executor, priority);
+}
+
+void SkImage::cancelPrefetchDecode() const {
+    as_IB(this)->onCancelPrefetchDecode();
+}
+
 bool SkImage::isAlphaOnly() const {
     return as_IB(this)->onImageInfo().colorType() == kAlpha_8_SkColorType;
 }
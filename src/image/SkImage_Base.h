@@ -87,6 +87,10 @@ public:
     // True for picture-backed and codec-backed
     virtual bool onIsLazyGenerated() const { return false; }
 
+    // Only lazy-generated images have anything to decode ahead of time.
+    virtual void onPrefetchDecode(SkExecutor&, int /* priority */) const {}
+    virtual void onCancelPrefetchDecode() const {}
+
     // True for images instantiated in GPU memory
     virtual bool onIsTextureBacked() const { return false; }
 
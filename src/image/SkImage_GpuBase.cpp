@@ -17,8 +17,11 @@
 #include "GrTextureAdjuster.h"
 #include "SkBitmapCache.h"
 #include "SkImage_Gpu.h"
+#include "SkMutex.h"
+#include "SkOpts.h"
 #include "SkPromiseImageTexture.h"
 #include "SkReadPixelsRec.h"
+#include "SkTHash.h"
 #include "SkTLList.h"
 #include "effects/GrYUVtoRGBEffect.h"
 
@@ -380,6 +383,50 @@ bool SkImage_GpuBase::RenderYUVAToRGBA(GrContext* ctx, GrRenderTargetContext* re
     return true;
 }
 
+namespace {
+
+// With GrContextOptions::fSharePromiseImageTextures, promise images that have the same key share
+// the GrTexture that the first of them to be instantiated got from the client, for as long as any
+// of them holds onto it. The client keeps the texture context valid until each image is done, and
+// the texture isn't released (it won't go idle) until the last of them lets go.
+struct SharedPromiseTextureKey {
+    SkImage_GpuBase::PromiseImageTextureFulfillProc fFulfillProc;
+    SkImage_GpuBase::PromiseImageTextureReleaseProc fReleaseProc;
+    SkImage_GpuBase::PromiseImageTextureContext fTextureContext;
+    uint32_t fContextID;
+    uint32_t fConfig;
+
+    bool operator==(const SharedPromiseTextureKey& that) const {
+        return fFulfillProc == that.fFulfillProc && fReleaseProc == that.fReleaseProc &&
+               fTextureContext == that.fTextureContext && fContextID == that.fContextID &&
+               fConfig == that.fConfig;
+    }
+};
+
+struct SharedPromiseTextureKeyHash {
+    uint32_t operator()(const SharedPromiseTextureKey& key) const {
+        return SkOpts::hash(&key, sizeof(key));
+    }
+};
+
+struct SharedPromiseTexture {
+    GrTexture* fTexture;
+    int fNumUsers;
+};
+
+using SharedPromiseTextureMap =
+        SkTHashMap<SharedPromiseTextureKey, SharedPromiseTexture, SharedPromiseTextureKeyHash>;
+
+// Lazy callbacks instantiate on their context's thread, but can be destroyed on any thread.
+SK_DECLARE_STATIC_MUTEX(gSharedPromiseTexturesMutex);
+
+SharedPromiseTextureMap* shared_promise_textures() {
+    static SharedPromiseTextureMap* gMap = new SharedPromiseTextureMap;
+    return gMap;
+}
+
+}  // namespace
+
 sk_sp<GrTextureProxy> SkImage_GpuBase::MakePromiseImageLazyProxy(
         GrContext* context, int width, int height, GrSurfaceOrigin origin, GrPixelConfig config,
         GrBackendFormat backendFormat, GrMipMapped mipMapped,
@@ -418,6 +465,10 @@ sk_sp<GrTextureProxy> SkImage_GpuBase::MakePromiseImageLazyProxy(
      *
      * A key invalidation message is installed on the SkPromiseImageTexture so that the GrTexture
      * is deleted once it can no longer be used to instantiate a proxy.
+     *
+     * If the GrContext shares promise image textures, a callback whose key matches a live, already
+     * fulfilled one takes its GrTexture instead of calling Fulfill. It then never calls Release,
+     * and calls Done when it is destroyed.
      */
     class PromiseLazyInstantiateCallback {
     public:
@@ -425,8 +476,11 @@ sk_sp<GrTextureProxy> SkImage_GpuBase::MakePromiseImageLazyProxy(
                                        PromiseImageTextureReleaseProc releaseProc,
                                        PromiseImageTextureDoneProc doneProc,
                                        PromiseImageTextureContext context,
-                                       GrPixelConfig config)
-                : fFulfillProc(fulfillProc), fConfig(config) {
+                                       GrPixelConfig config, uint32_t contextID, bool share)
+                : fFulfillProc(fulfillProc)
+                , fConfig(config)
+                , fSharedKey{fulfillProc, releaseProc, context, contextID, config}
+                , fShare(share) {
             auto doneHelper = sk_make_sp<GrRefCntedCallback>(doneProc, context);
             fIdleCallback = sk_make_sp<GrRefCntedCallback>(releaseProc, context);
             fIdleCallback->addChild(std::move(doneHelper));
@@ -452,6 +506,14 @@ sk_sp<GrTextureProxy> SkImage_GpuBase::MakePromiseImageLazyProxy(
             // Our destructor can run on any thread. We trigger the unref of fTexture by message.
             if (fTexture) {
                 SkASSERT(!fIdleCallback);
+                if (fShare) {
+                    SkAutoMutexAcquire lock(gSharedPromiseTexturesMutex);
+                    SharedPromiseTexture* shared = shared_promise_textures()->find(fSharedKey);
+                    SkASSERT(shared && shared->fTexture == fTexture);
+                    if (0 == --shared->fNumUsers) {
+                        shared_promise_textures()->remove(fSharedKey);
+                    }
+                }
                 SkMessageBus<GrGpuResourceFreedMessage>::Post({fTexture, fTextureContextID});
             }
         }
@@ -463,6 +525,18 @@ sk_sp<GrTextureProxy> SkImage_GpuBase::MakePromiseImageLazyProxy(
                 return sk_ref_sp(fTexture);
             }
             SkASSERT(fIdleCallback);
+            if (fShare) {
+                SkAutoMutexAcquire lock(gSharedPromiseTexturesMutex);
+                if (SharedPromiseTexture* shared = shared_promise_textures()->find(fSharedKey)) {
+                    // Whoever fulfilled this texture still holds it, so it can't get released
+                    // before we're done with it either. Our Done proc is called once we are
+                    // destroyed.
+                    fIdleCallback->abandon();
+                    fDoneCallback = std::move(fIdleCallback);
+                    ++shared->fNumUsers;
+                    return this->holdTexture(sk_ref_sp(shared->fTexture));
+                }
+            }
             PromiseImageTextureContext textureContext = fIdleCallback->context();
             sk_sp<SkPromiseImageTexture> promiseTexture = fFulfillProc(textureContext);
             // From here on out our contract is that the release proc must be called, even if
@@ -506,6 +580,16 @@ sk_sp<GrTextureProxy> SkImage_GpuBase::MakePromiseImageLazyProxy(
             }
             tex->addIdleProc(std::move(fIdleCallback));
             promiseTexture->addKeyToInvalidate(tex->getContext()->priv().contextID(), key);
+            if (fShare) {
+                SkAutoMutexAcquire lock(gSharedPromiseTexturesMutex);
+                SkASSERT(!shared_promise_textures()->find(fSharedKey));
+                shared_promise_textures()->set(fSharedKey, {tex.get(), 1});
+            }
+            return this->holdTexture(std::move(tex));
+        }
+
+    private:
+        sk_sp<GrSurface> holdTexture(sk_sp<GrTexture> tex) {
             fTexture = tex.get();
             // We need to hold on to the GrTexture in case our proxy gets reinstantiated. However,
             // we can't unref in our destructor because we may be on another thread then. So we
@@ -517,13 +601,17 @@ sk_sp<GrTextureProxy> SkImage_GpuBase::MakePromiseImageLazyProxy(
             return std::move(tex);
         }
 
-    private:
         GrTexture* fTexture = nullptr;
         uint32_t fTextureContextID = SK_InvalidUniqueID;
         sk_sp<GrRefCntedCallback> fIdleCallback;
+        // Only set if we took a shared texture instead of calling Fulfill. Calls Done when reset.
+        sk_sp<GrRefCntedCallback> fDoneCallback;
         PromiseImageTextureFulfillProc fFulfillProc;
         GrPixelConfig fConfig;
-    } callback(fulfillProc, releaseProc, doneProc, textureContext, config);
+        SharedPromiseTextureKey fSharedKey;
+        bool fShare;
+    } callback(fulfillProc, releaseProc, doneProc, textureContext, config,
+               context->priv().contextID(), context->priv().options().fSharePromiseImageTextures);
 
     GrProxyProvider* proxyProvider = context->priv().proxyProvider();
 
@@ -11,10 +11,14 @@
 #include "SkBitmapCache.h"
 #include "SkCachedData.h"
 #include "SkData.h"
+#include "SkExecutor.h"
 #include "SkImageGenerator.h"
 #include "SkImagePriv.h"
 #include "SkNextID.h"
 
+#include <algorithm>
+#include <vector>
+
 #if SK_SUPPORT_GPU
 #include "GrCaps.h"
 #include "GrGpuResourcePriv.h"
@@ -192,11 +196,17 @@ bool SkImage_Lazy::getROPixels(SkBitmap* bitmap, SkImage::CachingHint chint) con
     }
 
     if (SkImage::kAllow_CachingHint == chint) {
+        ScopedGenerator generator(fSharedGenerator);
+        // Someone else, e.g. a prefetchDecode(), may have cached the pixels while we waited
+        // for the generator.
+        if (SkBitmapCache::Find(desc, bitmap)) {
+            check_output_bitmap();
+            return true;
+        }
+
         SkPixmap pmap;
         SkBitmapCache::RecPtr cacheRec = SkBitmapCache::Alloc(desc, fInfo, &pmap);
-        if (!cacheRec ||
-            !generate_pixels(ScopedGenerator(fSharedGenerator), pmap,
-                             fOrigin.x(), fOrigin.y())) {
+        if (!cacheRec || !generate_pixels(generator, pmap, fOrigin.x(), fOrigin.y())) {
             return false;
         }
         SkBitmapCache::Add(std::move(cacheRec), bitmap);
@@ -216,6 +226,105 @@ bool SkImage_Lazy::getROPixels(SkBitmap* bitmap, SkImage::CachingHint chint) con
 
 //////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Pending prefetchDecode() requests, shared by every caller and executor. Each request adds
+// one task to its executor, and each task decodes whatever has the highest priority when it
+// runs, so the queue rather than the executors decides the order.
+class DecodeAheadQueue {
+public:
+    static DecodeAheadQueue* Get() {
+        static DecodeAheadQueue* gQueue = new DecodeAheadQueue;
+        return gQueue;
+    }
+
+    void add(sk_sp<const SkImage_Lazy> image, int priority, SkExecutor& executor) {
+        {
+            SkAutoMutexAcquire lock(fMutex);
+            const uint32_t id = image->uniqueID();
+            if (std::find(fDecoding.begin(), fDecoding.end(), id) != fDecoding.end()) {
+                return;
+            }
+            auto queued = this->find(id);
+            if (queued != fRequests.end()) {
+                if (priority > queued->fPriority) {
+                    queued->fPriority = priority;
+                    std::make_heap(fRequests.begin(), fRequests.end());
+                }
+                return;
+            }
+            fRequests.push_back({priority, fNextSequence++, std::move(image)});
+            std::push_heap(fRequests.begin(), fRequests.end());
+        }
+        executor.add([this] { this->decodeNext(); });
+    }
+
+    void cancel(uint32_t id) {
+        SkAutoMutexAcquire lock(fMutex);
+        auto queued = this->find(id);
+        if (queued != fRequests.end()) {
+            fRequests.erase(queued);
+            std::make_heap(fRequests.begin(), fRequests.end());
+        }
+    }
+
+private:
+    struct Request {
+        int                       fPriority;
+        uint64_t                  fSequence;  // breaks ties first come, first served
+        sk_sp<const SkImage_Lazy> fImage;
+
+        bool operator<(const Request& that) const {
+            return fPriority != that.fPriority ? fPriority < that.fPriority
+                                               : fSequence > that.fSequence;
+        }
+    };
+
+    std::vector<Request>::iterator find(uint32_t id) {
+        return std::find_if(fRequests.begin(), fRequests.end(), [id](const Request& request) {
+            return request.fImage->uniqueID() == id;
+        });
+    }
+
+    void decodeNext() {
+        sk_sp<const SkImage_Lazy> image;
+        {
+            SkAutoMutexAcquire lock(fMutex);
+            if (fRequests.empty()) {
+                // Our request was cancelled, or another task took it.
+                return;
+            }
+            std::pop_heap(fRequests.begin(), fRequests.end());
+            image = std::move(fRequests.back().fImage);
+            fRequests.pop_back();
+            fDecoding.push_back(image->uniqueID());
+        }
+
+        SkBitmap bitmap;
+        (void)image->getROPixels(&bitmap, SkImage::kAllow_CachingHint);
+
+        SkAutoMutexAcquire lock(fMutex);
+        fDecoding.erase(std::find(fDecoding.begin(), fDecoding.end(), image->uniqueID()));
+    }
+
+    SkMutex               fMutex;
+    std::vector<Request>  fRequests;   // a max-heap
+    std::vector<uint32_t> fDecoding;
+    uint64_t              fNextSequence = 0;
+};
+
+void SkImage_Lazy::onPrefetchDecode(SkExecutor& executor, int priority) const {
+    SkBitmap bitmap;
+    if (SkBitmapCache::Find(SkBitmapCacheDesc::Make(this), &bitmap)) {
+        return;
+    }
+    DecodeAheadQueue::Get()->add(sk_ref_sp(this), priority, executor);
+}
+
+void SkImage_Lazy::onCancelPrefetchDecode() const {
+    DecodeAheadQueue::Get()->cancel(this->uniqueID());
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
 bool SkImage_Lazy::onReadPixels(const SkImageInfo& dstInfo, void* dstPixels, size_t dstRB,
                                 int srcX, int srcY, CachingHint chint) const {
     SkBitmap bm;
@@ -227,6 +336,10 @@ bool SkImage_Lazy::onReadPixels(const SkImageInfo& dstInfo, void* dstPixels, siz
 
 sk_sp<SkData> SkImage_Lazy::onRefEncoded() const {
     ScopedGenerator generator(fSharedGenerator);
+    // Subsets, and images converted to another color type or space, aren't what was encoded.
+    if (generator->uniqueID() != this->uniqueID()) {
+        return nullptr;
+    }
     return generator->refEncodedData();
 }
 
@@ -56,6 +56,8 @@ public:
     sk_sp<SkImage> onMakeSubset(GrRecordingContext*, const SkIRect&) const override;
     bool getROPixels(SkBitmap*, CachingHint) const override;
     bool onIsLazyGenerated() const override { return true; }
+    void onPrefetchDecode(SkExecutor&, int priority) const override;
+    void onCancelPrefetchDecode() const override;
     sk_sp<SkImage> onMakeColorTypeAndColorSpace(GrRecordingContext*,
                                                 SkColorType, sk_sp<SkColorSpace>) const override;
 
@@ -6,7 +6,10 @@
  */
 
 #include "GrBackendSurface.h"
+#include "SkAutoMalloc.h"
+#include "SkAutoPixmapStorage.h"
 #include "SkCanvas.h"
+#include "SkColorFilter.h"
 #include "SkFontLCDConfig.h"
 #include "SkImagePriv.h"
 #include "SkSurface_Base.h"
@@ -86,12 +89,23 @@ void SkSurface_Base::onDraw(SkCanvas* canvas, SkScalar x, SkScalar y, const SkPa
     }
 }
 
+void SkSurface_Base::onAsyncReadPixels(const SkImageInfo& info, int srcX, int srcY,
+                                       ReadPixelsCallback callback, ReadPixelsContext context) {
+    SkAutoPixmapStorage pm;
+    if (!pm.tryAlloc(info) || !this->readPixels(pm, srcX, srcY)) {
+        callback(context, nullptr, 0);
+        return;
+    }
+    callback(context, pm.addr(), pm.rowBytes());
+}
+
 bool SkSurface_Base::outstandingImageSnapshot() const {
     return fCachedImage && !fCachedImage->unique();
 }
 
-void SkSurface_Base::aboutToDraw(ContentChangeMode mode) {
+void SkSurface_Base::aboutToDraw(ContentChangeMode mode, const SkIRect* damage) {
     this->dirtyGenerationID();
+    this->addDamage(damage);
 
     SkASSERT(!fCachedCanvas || fCachedCanvas->getSurfaceBase() == this);
 
@@ -119,6 +133,14 @@ void SkSurface_Base::aboutToDraw(ContentChangeMode mode) {
     }
 }
 
+void SkSurface_Base::addDamage(const SkIRect* damage) {
+    SkIRect bounds = SkIRect::MakeWH(this->width(), this->height());
+    if (damage && !bounds.intersect(*damage)) {
+        return;
+    }
+    fDamage.join(bounds);
+}
+
 uint32_t SkSurface_Base::newGenerationID() {
     SkASSERT(!fCachedCanvas || fCachedCanvas->getSurfaceBase() == this);
     static std::atomic<uint32_t> nextID{1};
@@ -158,6 +180,14 @@ void SkSurface::notifyContentWillChange(ContentChangeMode mode) {
     asSB(this)->aboutToDraw(mode);
 }
 
+SkIRect SkSurface::damage() const {
+    return static_cast<const SkSurface_Base*>(this)->fDamage;
+}
+
+void SkSurface::resetDamage() {
+    asSB(this)->fDamage.setEmpty();
+}
+
 SkCanvas* SkSurface::getCanvas() {
     return asSB(this)->getCachedCanvas();
 }
@@ -207,6 +237,237 @@ bool SkSurface::readPixels(const SkBitmap& bitmap, int srcX, int srcY) {
     return bitmap.peekPixels(&pm) && this->readPixels(pm, srcX, srcY);
 }
 
+void SkSurface::asyncReadPixels(const SkImageInfo& dstInfo, int srcX, int srcY,
+                                ReadPixelsCallback callback, ReadPixelsContext context) {
+    SkIRect srcRect = SkIRect::MakeXYWH(srcX, srcY, dstInfo.width(), dstInfo.height());
+    if (dstInfo.isEmpty() || !SkIRect::MakeWH(this->width(), this->height()).contains(srcRect)) {
+        callback(context, nullptr, 0);
+        return;
+    }
+    asSB(this)->onAsyncReadPixels(dstInfo, srcX, srcY, callback, context);
+}
+
+void SkSurface::asyncRescaleAndReadPixels(const SkImageInfo& dstInfo, const SkIRect& srcRect,
+                                          RescaleGamma rescaleGamma,
+                                          SkFilterQuality rescaleQuality,
+                                          ReadPixelsCallback callback,
+                                          ReadPixelsContext context) {
+    if (dstInfo.isEmpty() || srcRect.isEmpty() ||
+        !SkIRect::MakeWH(this->width(), this->height()).contains(srcRect)) {
+        callback(context, nullptr, 0);
+        return;
+    }
+    sk_sp<SkImage> image = this->makeImageSnapshot();
+    if (!image) {
+        callback(context, nullptr, 0);
+        return;
+    }
+
+    // Each step draws into a surface made like this one, so on GPU surfaces the filtering and the
+    // color conversion happen on the GPU, and only the last step is transferred.
+    sk_sp<SkColorSpace> stepColorSpace = dstInfo.refColorSpace();
+    SkColorType stepColorType = dstInfo.colorType();
+    if (kLinear == rescaleGamma) {
+        stepColorSpace = stepColorSpace ? stepColorSpace->makeLinearGamma()
+                                        : SkColorSpace::MakeSRGBLinear();
+        stepColorType = kRGBA_F16_SkColorType;
+    }
+    SkAlphaType lastAlphaType = kUnpremul_SkAlphaType == dstInfo.alphaType()
+                                        ? kPremul_SkAlphaType : dstInfo.alphaType();
+    SkRect src = SkRect::Make(srcRect);
+    int width = srcRect.width(),
+        height = srcRect.height();
+    for (;;) {
+        // Bilinear filtering reads 2x2 pixels, so it can only reduce by half without skipping any.
+        int nextWidth = dstInfo.width(),
+            nextHeight = dstInfo.height();
+        if (kNone_SkFilterQuality != rescaleQuality) {
+            if (width > 2 * nextWidth) {
+                nextWidth = (width + 1) / 2;
+            }
+            if (height > 2 * nextHeight) {
+                nextHeight = (height + 1) / 2;
+            }
+        }
+        bool last = nextWidth == dstInfo.width() && nextHeight == dstInfo.height();
+        SkImageInfo stepInfo = last ? dstInfo.makeAlphaType(lastAlphaType)
+                                    : SkImageInfo::Make(nextWidth, nextHeight, stepColorType,
+                                                        kPremul_SkAlphaType, stepColorSpace);
+        sk_sp<SkSurface> step = this->makeSurface(stepInfo);
+        if (!step) {
+            step = SkSurface::MakeRaster(stepInfo);
+        }
+        if (!step) {
+            callback(context, nullptr, 0);
+            return;
+        }
+
+        SkPaint paint;
+        paint.setBlendMode(SkBlendMode::kSrc);
+        SkFilterQuality quality = kNone_SkFilterQuality == rescaleQuality ? kNone_SkFilterQuality
+                                                                           : kLow_SkFilterQuality;
+        if (last && kHigh_SkFilterQuality == rescaleQuality) {
+            quality = kHigh_SkFilterQuality;
+        }
+        paint.setFilterQuality(quality);
+        step->getCanvas()->drawImageRect(image, src, SkRect::MakeIWH(nextWidth, nextHeight),
+                                         &paint, SkCanvas::kStrict_SrcRectConstraint);
+        if (last) {
+            step->asyncReadPixels(dstInfo, 0, 0, callback, context);
+            return;
+        }
+        image = step->makeImageSnapshot();
+        if (!image) {
+            callback(context, nullptr, 0);
+            return;
+        }
+        src = SkRect::MakeIWH(nextWidth, nextHeight);
+        width = nextWidth;
+        height = nextHeight;
+    }
+}
+
+namespace {
+
+// The Y, U and V rows of the RGB to YUV matrices, in SkColorMatrixFilterRowMajor255 form.
+const float kJPEGRows[15] = {
+     0.299000f,  0.587000f,  0.114000f, 0,   0,
+    -0.168736f, -0.331264f,  0.500000f, 0, 128,
+     0.500000f, -0.418688f, -0.081312f, 0, 128,
+};
+const float kRec601Rows[15] = {
+     0.256788f,  0.504129f,  0.097906f, 0,  16,
+    -0.148223f, -0.290993f,  0.439216f, 0, 128,
+     0.439216f, -0.367788f, -0.071427f, 0, 128,
+};
+const float kRec709Rows[15] = {
+     0.182586f,  0.614231f,  0.062007f, 0,  16,
+    -0.100644f, -0.338572f,  0.439216f, 0, 128,
+     0.439216f, -0.398942f, -0.040274f, 0, 128,
+};
+const float kIdentityRows[15] = {
+    1, 0, 0, 0, 0,
+    0, 1, 0, 0, 0,
+    0, 0, 1, 0, 0,
+};
+
+const float* rgb_to_yuv_rows(SkYUVColorSpace yuvColorSpace) {
+    switch (yuvColorSpace) {
+        case kJPEG_SkYUVColorSpace:     return kJPEGRows;
+        case kRec601_SkYUVColorSpace:   return kRec601Rows;
+        case kRec709_SkYUVColorSpace:   return kRec709Rows;
+        case kIdentity_SkYUVColorSpace: return kIdentityRows;
+    }
+    SK_ABORT("Unexpected yuv color space");
+    return kIdentityRows;
+}
+
+// Collects the three plane reads of asyncReadPixelsYUV420(). The planes can land in different
+// flushes, so all but the last one are copied out of their transfer buffers.
+struct YUV420Readback {
+    struct Plane {
+        YUV420Readback* fReadback;
+        int             fHeight;
+        SkAutoMalloc    fPixels;
+        size_t          fRowBytes = 0;
+    };
+
+    static void PlaneDone(SkSurface::ReadPixelsContext context, const void* data,
+                          size_t rowBytes) {
+        Plane* plane = static_cast<Plane*>(context);
+        YUV420Readback* readback = plane->fReadback;
+        bool last = 3 == ++readback->fNumDone;
+        if (!data) {
+            readback->fFailed = true;
+        } else if (!last) {
+            plane->fPixels.reset(rowBytes * plane->fHeight);
+            memcpy(plane->fPixels.get(), data, rowBytes * plane->fHeight);
+        }
+        plane->fRowBytes = rowBytes;
+        if (!last) {
+            return;
+        }
+        if (readback->fFailed) {
+            readback->fCallback(readback->fContext, nullptr, nullptr);
+        } else {
+            const void* planeData[3];
+            size_t planeRowBytes[3];
+            for (int i = 0; i < 3; ++i) {
+                const Plane& p = readback->fPlanes[i];
+                planeData[i] = &p == plane ? data : p.fPixels.get();
+                planeRowBytes[i] = p.fRowBytes;
+            }
+            readback->fCallback(readback->fContext, planeData, planeRowBytes);
+        }
+        delete readback;
+    }
+
+    SkSurface::ReadPixelsYUV420Callback fCallback;
+    SkSurface::ReadPixelsContext        fContext;
+    Plane                               fPlanes[3];
+    int                                 fNumDone = 0;
+    bool                                fFailed = false;
+};
+
+}  // anonymous namespace
+
+void SkSurface::asyncReadPixelsYUV420(SkYUVColorSpace yuvColorSpace, const SkIRect& srcRect,
+                                      ReadPixelsYUV420Callback callback,
+                                      ReadPixelsContext context) {
+    if (srcRect.isEmpty() || !SkIRect::MakeWH(this->width(), this->height()).contains(srcRect)) {
+        callback(context, nullptr, nullptr);
+        return;
+    }
+    sk_sp<SkImage> source = this->makeImageSnapshot();
+    if (!source) {
+        callback(context, nullptr, nullptr);
+        return;
+    }
+
+    // Each plane is drawn into its own A8 surface with a color matrix that puts the plane's row of
+    // the conversion in alpha. On GPU surfaces this keeps the conversion and the chroma filtering
+    // on the GPU and leaves only 1.5 bytes per pixel to transfer.
+    int planeWidths[3] = {srcRect.width(), (srcRect.width() + 1) / 2, (srcRect.width() + 1) / 2};
+    int planeHeights[3] = {srcRect.height(), (srcRect.height() + 1) / 2,
+                           (srcRect.height() + 1) / 2};
+    const float* rows = rgb_to_yuv_rows(yuvColorSpace);
+    sk_sp<SkSurface> planeSurfaces[3];
+    for (int i = 0; i < 3; ++i) {
+        SkImageInfo planeInfo = SkImageInfo::MakeA8(planeWidths[i], planeHeights[i]);
+        planeSurfaces[i] = this->makeSurface(planeInfo);
+        if (!planeSurfaces[i]) {
+            planeSurfaces[i] = SkSurface::MakeRaster(planeInfo);
+        }
+        if (!planeSurfaces[i]) {
+            callback(context, nullptr, nullptr);
+            return;
+        }
+
+        float matrix[20] = {};
+        memcpy(matrix + 15, rows + 5 * i, 5 * sizeof(float));
+        SkPaint paint;
+        paint.setColorFilter(SkColorFilter::MakeMatrixFilterRowMajor255(matrix));
+        paint.setBlendMode(SkBlendMode::kSrc);
+        paint.setFilterQuality(i ? kLow_SkFilterQuality : kNone_SkFilterQuality);
+        planeSurfaces[i]->getCanvas()->drawImageRect(
+                source, SkRect::Make(srcRect),
+                SkRect::MakeIWH(planeWidths[i], planeHeights[i]), &paint,
+                SkCanvas::kStrict_SrcRectConstraint);
+    }
+
+    auto readback = new YUV420Readback;
+    readback->fCallback = callback;
+    readback->fContext = context;
+    for (int i = 0; i < 3; ++i) {
+        readback->fPlanes[i].fReadback = readback;
+        readback->fPlanes[i].fHeight = planeHeights[i];
+    }
+    for (int i = 0; i < 3; ++i) {
+        planeSurfaces[i]->asyncReadPixels(planeSurfaces[i]->getCanvas()->imageInfo(), 0, 0,
+                                          &YUV420Readback::PlaneDone, &readback->fPlanes[i]);
+    }
+}
+
 void SkSurface::writePixels(const SkPixmap& pmap, int x, int y) {
     if (pmap.addr() == nullptr || pmap.width() <= 0 || pmap.height() <= 0) {
         return;
@@ -219,7 +480,7 @@ void SkSurface::writePixels(const SkPixmap& pmap, int x, int y) {
         if (srcR.contains(dstR)) {
             mode = kDiscard_ContentChangeMode;
         }
-        asSB(this)->aboutToDraw(mode);
+        asSB(this)->aboutToDraw(mode, &srcR);
         asSB(this)->onWritePixels(pmap, x, y);
     }
 }
@@ -277,7 +538,11 @@ bool SkSurface::characterize(SkSurfaceCharacterization* characterization) const
 }
 
 bool SkSurface::draw(SkDeferredDisplayList* ddl) {
-    return asSB(this)->onDraw(ddl);
+    if (!asSB(this)->onDraw(ddl)) {
+        return false;
+    }
+    asSB(this)->addDamage(nullptr);
+    return true;
 }
 
 //////////////////////////////////////////////////////////////////////////////////////
@@ -45,6 +45,13 @@ public:
 
     virtual void onWritePixels(const SkPixmap&, int x, int y) = 0;
 
+    /**
+     *  The rectangle of pixels has been checked to be contained by the surface. The default
+     *  reads the pixels synchronously and calls back before returning.
+     */
+    virtual void onAsyncReadPixels(const SkImageInfo&, int srcX, int srcY, ReadPixelsCallback,
+                                   ReadPixelsContext);
+
     /**
      *  Default implementation:
      *
@@ -111,8 +118,11 @@ public:
 private:
     std::unique_ptr<SkCanvas>   fCachedCanvas;
     sk_sp<SkImage>              fCachedImage;
+    SkIRect                     fDamage = SkIRect::MakeEmpty();
 
-    void aboutToDraw(ContentChangeMode mode);
+    // 'damage' bounds the pixels about to change; null means all of them.
+    void aboutToDraw(ContentChangeMode mode, const SkIRect* damage = nullptr);
+    void addDamage(const SkIRect* damage);
 
     // Returns true if there is an outstanding image-snapshot, indicating that a call to aboutToDraw
     // would trigger a copy-on-write.
@@ -133,6 +133,23 @@ void SkSurface_Gpu::onWritePixels(const SkPixmap& src, int x, int y) {
     fDevice->writePixels(src, x, y);
 }
 
+void SkSurface_Gpu::onAsyncReadPixels(const SkImageInfo& info, int srcX, int srcY,
+                                      ReadPixelsCallback callback, ReadPixelsContext context) {
+    // Conversions are left to the synchronous read.
+    const SkImageInfo& surfaceInfo = fDevice->imageInfo();
+    if (info.colorType() == surfaceInfo.colorType() &&
+        info.alphaType() == surfaceInfo.alphaType() &&
+        SkColorSpace::Equals(info.colorSpace(), surfaceInfo.colorSpace())) {
+        GrRenderTargetContext* rtc = fDevice->accessRenderTargetContext();
+        SkIRect srcRect = SkIRect::MakeXYWH(srcX, srcY, info.width(), info.height());
+        if (rtc->asyncReadPixels(srcRect, SkColorTypeToGrColorType(info.colorType()), callback,
+                                 context)) {
+            return;
+        }
+    }
+    INHERITED::onAsyncReadPixels(info, srcX, srcY, callback, context);
+}
+
 // Create a new render target and, if necessary, copy the contents of the old
 // render target into it. Note that this flushes the SkGpuDevice but
 // doesn't force an OpenGL flush.
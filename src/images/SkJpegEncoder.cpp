@@ -10,11 +10,14 @@
 #ifdef SK_HAS_JPEG_LIBRARY
 
 #include "SkColorData.h"
+#include "SkExecutor.h"
 #include "SkImageEncoderFns.h"
 #include "SkImageInfoPriv.h"
 #include "SkJpegEncoder.h"
 #include "SkJPEGWriteUtility.h"
+#include "SkRasterPipeline.h"
 #include "SkStream.h"
+#include "SkTaskGroup.h"
 #include "SkTemplates.h"
 
 #include <stdio.h>
@@ -24,6 +27,13 @@ extern "C" {
     #include "jerror.h"
 }
 
+// Sources that need converting are converted this many rows at a time (a batch per task when
+// there is an executor), enough for libjpeg to compress a whole row of 4:2:0 blocks at once.
+static constexpr int kRowsPerBatch = 2 * DCTSIZE;
+
+// With an executor, this many batches are converted together.
+static constexpr int kBatchesPerExecutorBatch = 8;
+
 class SkJpegEncoderMgr final : SkNoncopyable {
 public:
 
@@ -36,12 +46,22 @@ public:
     }
 
     bool setParams(const SkImageInfo& srcInfo, const SkJpegEncoder::Options& options);
+    void setYUVParams(const SkISize& size, const SkJpegEncoder::Options& options);
 
     jpeg_compress_struct* cinfo() { return &fCInfo; }
 
     skjpeg_error_mgr* errorMgr() { return &fErrMgr; }
 
-    transform_scanline_proc proc() const { return fProc; }
+    // Whether libjpeg can't read the source rows directly, and they must be converted first.
+    bool needsConversion() const { return fNeedsConversion; }
+
+    // How many rows to hand libjpeg at once.
+    int rowsPerBatch() const {
+        return fExecutor ? kBatchesPerExecutorBatch * kRowsPerBatch : kRowsPerBatch;
+    }
+
+    // Converts |count| rows of |src|, starting at |top|, to the RGBA rows libjpeg reads.
+    void convertRows(const SkPixmap& src, int top, int count, uint8_t* dst) const;
 
     ~SkJpegEncoderMgr() {
         jpeg_destroy_compress(&fCInfo);
@@ -51,7 +71,6 @@ private:
 
     SkJpegEncoderMgr(SkWStream* stream)
         : fDstMgr(stream)
-        , fProc(nullptr)
     {
         fCInfo.err = jpeg_std_error(&fErrMgr);
         fErrMgr.error_exit = skjpeg_error_exit;
@@ -59,67 +78,59 @@ private:
         fCInfo.dest = &fDstMgr;
     }
 
+    void setDownsample(SkJpegEncoder::Downsample downsample);
+
     jpeg_compress_struct    fCInfo;
     skjpeg_error_mgr        fErrMgr;
     skjpeg_destination_mgr  fDstMgr;
-    transform_scanline_proc fProc;
+    bool                    fNeedsConversion = false;
+    bool                    fPremul = false;
+    SkExecutor*             fExecutor = nullptr;
 };
 
 bool SkJpegEncoderMgr::setParams(const SkImageInfo& srcInfo, const SkJpegEncoder::Options& options)
 {
-    auto chooseProc8888 = [&]() {
-        if (kUnpremul_SkAlphaType == srcInfo.alphaType() &&
-                options.fAlphaOption == SkJpegEncoder::AlphaOption::kBlendOnBlack) {
-            return transform_scanline_to_premul_legacy;
-        }
-        return (transform_scanline_proc) nullptr;
-    };
+    const bool blendOnBlack = kUnpremul_SkAlphaType == srcInfo.alphaType() &&
+                              SkJpegEncoder::AlphaOption::kBlendOnBlack == options.fAlphaOption;
 
+    // Anything libjpeg can't read is converted to RGBA.
     J_COLOR_SPACE jpegColorType = JCS_EXT_RGBA;
-    int numComponents = 0;
+    int numComponents = 4;
     switch (srcInfo.colorType()) {
         case kRGBA_8888_SkColorType:
-            fProc = chooseProc8888();
-            jpegColorType = JCS_EXT_RGBA;
-            numComponents = 4;
+            fNeedsConversion = blendOnBlack;
             break;
         case kBGRA_8888_SkColorType:
-            fProc = chooseProc8888();
-            jpegColorType = JCS_EXT_BGRA;
-            numComponents = 4;
-            break;
-        case kRGB_565_SkColorType:
-            fProc = transform_scanline_565;
-            jpegColorType = JCS_RGB;
-            numComponents = 3;
+            fNeedsConversion = blendOnBlack;
+            if (!fNeedsConversion) {
+                jpegColorType = JCS_EXT_BGRA;
+            }
             break;
         case kARGB_4444_SkColorType:
             if (SkJpegEncoder::AlphaOption::kBlendOnBlack == options.fAlphaOption) {
                 return false;
             }
-
-            fProc = transform_scanline_444;
-            jpegColorType = JCS_RGB;
-            numComponents = 3;
+            fNeedsConversion = true;
             break;
         case kGray_8_SkColorType:
             SkASSERT(srcInfo.isOpaque());
             jpegColorType = JCS_GRAYSCALE;
             numComponents = 1;
             break;
+        case kRGB_565_SkColorType:
+        case kRGB_888x_SkColorType:
+        case kRGBA_1010102_SkColorType:
+        case kRGB_101010x_SkColorType:
+        case kRGBA_F16Norm_SkColorType:
         case kRGBA_F16_SkColorType:
-            if (kUnpremul_SkAlphaType == srcInfo.alphaType() &&
-                    options.fAlphaOption == SkJpegEncoder::AlphaOption::kBlendOnBlack) {
-                fProc = transform_scanline_F16_to_premul_8888;
-            } else {
-                fProc = transform_scanline_F16_to_8888;
-            }
-            jpegColorType = JCS_EXT_RGBA;
-            numComponents = 4;
+        case kRGBA_F32_SkColorType:
+            fNeedsConversion = true;
             break;
         default:
             return false;
     }
+    fPremul = fNeedsConversion && blendOnBlack;
+    fExecutor = options.fExecutor;
 
     fCInfo.image_width = srcInfo.width();
     fCInfo.image_height = srcInfo.height();
@@ -128,32 +139,7 @@ bool SkJpegEncoderMgr::setParams(const SkImageInfo& srcInfo, const SkJpegEncoder
     jpeg_set_defaults(&fCInfo);
 
     if (kGray_8_SkColorType != srcInfo.colorType()) {
-        switch (options.fDownsample) {
-            case SkJpegEncoder::Downsample::k420:
-                SkASSERT(2 == fCInfo.comp_info[0].h_samp_factor);
-                SkASSERT(2 == fCInfo.comp_info[0].v_samp_factor);
-                SkASSERT(1 == fCInfo.comp_info[1].h_samp_factor);
-                SkASSERT(1 == fCInfo.comp_info[1].v_samp_factor);
-                SkASSERT(1 == fCInfo.comp_info[2].h_samp_factor);
-                SkASSERT(1 == fCInfo.comp_info[2].v_samp_factor);
-                break;
-            case SkJpegEncoder::Downsample::k422:
-                fCInfo.comp_info[0].h_samp_factor = 2;
-                fCInfo.comp_info[0].v_samp_factor = 1;
-                fCInfo.comp_info[1].h_samp_factor = 1;
-                fCInfo.comp_info[1].v_samp_factor = 1;
-                fCInfo.comp_info[2].h_samp_factor = 1;
-                fCInfo.comp_info[2].v_samp_factor = 1;
-                break;
-            case SkJpegEncoder::Downsample::k444:
-                fCInfo.comp_info[0].h_samp_factor = 1;
-                fCInfo.comp_info[0].v_samp_factor = 1;
-                fCInfo.comp_info[1].h_samp_factor = 1;
-                fCInfo.comp_info[1].v_samp_factor = 1;
-                fCInfo.comp_info[2].h_samp_factor = 1;
-                fCInfo.comp_info[2].v_samp_factor = 1;
-                break;
-        }
+        this->setDownsample(options.fDownsample);
     }
 
     // Tells libjpeg-turbo to compute optimal Huffman coding tables
@@ -163,27 +149,91 @@ bool SkJpegEncoderMgr::setParams(const SkImageInfo& srcInfo, const SkJpegEncoder
     return true;
 }
 
-std::unique_ptr<SkEncoder> SkJpegEncoder::Make(SkWStream* dst, const SkPixmap& src,
-                                               const Options& options) {
-    if (!SkPixmapIsValid(src)) {
-        return nullptr;
-    }
+void SkJpegEncoderMgr::setYUVParams(const SkISize& size, const SkJpegEncoder::Options& options) {
+    fCInfo.image_width = size.width();
+    fCInfo.image_height = size.height();
+    fCInfo.in_color_space = JCS_YCbCr;
+    fCInfo.input_components = 3;
+    jpeg_set_defaults(&fCInfo);
+    this->setDownsample(options.fDownsample);
 
-    std::unique_ptr<SkJpegEncoderMgr> encoderMgr = SkJpegEncoderMgr::Make(dst);
+    // We hand libjpeg each component at its downsampled size.
+    fCInfo.raw_data_in = TRUE;
+#if JPEG_LIB_VERSION >= 70
+    fCInfo.do_fancy_downsampling = FALSE;
+#endif
 
-    skjpeg_error_mgr::AutoPushJmpBuf jmp(encoderMgr->errorMgr());
-    if (setjmp(jmp)) {
-        return nullptr;
+    fCInfo.optimize_coding = TRUE;
+}
+
+void SkJpegEncoderMgr::setDownsample(SkJpegEncoder::Downsample downsample) {
+    switch (downsample) {
+        case SkJpegEncoder::Downsample::k420:
+            SkASSERT(2 == fCInfo.comp_info[0].h_samp_factor);
+            SkASSERT(2 == fCInfo.comp_info[0].v_samp_factor);
+            SkASSERT(1 == fCInfo.comp_info[1].h_samp_factor);
+            SkASSERT(1 == fCInfo.comp_info[1].v_samp_factor);
+            SkASSERT(1 == fCInfo.comp_info[2].h_samp_factor);
+            SkASSERT(1 == fCInfo.comp_info[2].v_samp_factor);
+            break;
+        case SkJpegEncoder::Downsample::k422:
+            fCInfo.comp_info[0].h_samp_factor = 2;
+            fCInfo.comp_info[0].v_samp_factor = 1;
+            fCInfo.comp_info[1].h_samp_factor = 1;
+            fCInfo.comp_info[1].v_samp_factor = 1;
+            fCInfo.comp_info[2].h_samp_factor = 1;
+            fCInfo.comp_info[2].v_samp_factor = 1;
+            break;
+        case SkJpegEncoder::Downsample::k444:
+            fCInfo.comp_info[0].h_samp_factor = 1;
+            fCInfo.comp_info[0].v_samp_factor = 1;
+            fCInfo.comp_info[1].h_samp_factor = 1;
+            fCInfo.comp_info[1].v_samp_factor = 1;
+            fCInfo.comp_info[2].h_samp_factor = 1;
+            fCInfo.comp_info[2].v_samp_factor = 1;
+            break;
     }
+}
 
-    if (!encoderMgr->setParams(src.info(), options)) {
-        return nullptr;
+void SkJpegEncoderMgr::convertRows(const SkPixmap& src, int top, int count, uint8_t* dst) const {
+    SkASSERT(fNeedsConversion);
+    auto convert = [&](int bandTop, int bandCount) {
+        SkRasterPipeline_MemoryCtx srcCtx = {
+            const_cast<void*>(src.addr(0, bandTop)), src.rowBytesAsPixels()
+        };
+        SkRasterPipeline_MemoryCtx dstCtx = {
+            dst + (size_t)(bandTop - top) * src.width() * 4, src.width()
+        };
+
+        SkRasterPipeline_<256> p;
+        p.append_load(src.colorType(), &srcCtx);
+        if (fPremul) {
+            p.append(SkRasterPipeline::premul);
+        }
+        p.append_store(kRGBA_8888_SkColorType, &dstCtx);
+        p.run(0, 0, src.width(), bandCount);
+    };
+
+    const int bands = (count + kRowsPerBatch - 1) / kRowsPerBatch;
+    if (fExecutor && bands > 1) {
+        SkTaskGroup tg(*fExecutor);
+        tg.batch(bands, [&](int band) {
+            const int bandTop = top + band * kRowsPerBatch;
+            convert(bandTop, SkTMin(kRowsPerBatch, top + count - bandTop));
+        });
+        tg.wait();
+    } else {
+        convert(top, count);
     }
+}
 
+// Sets the quality, writes the headers and the ICC profile (if any) of |info|'s color space.
+static void start_compress(SkJpegEncoderMgr* encoderMgr, const SkImageInfo& info,
+                           const SkJpegEncoder::Options& options) {
     jpeg_set_quality(encoderMgr->cinfo(), options.fQuality, TRUE);
     jpeg_start_compress(encoderMgr->cinfo(), TRUE);
 
-    sk_sp<SkData> icc = icc_from_color_space(src.info());
+    sk_sp<SkData> icc = icc_from_color_space(info);
     if (icc) {
         // Create a contiguous block of memory with the icc signature followed by the profile.
         sk_sp<SkData> markerData =
@@ -197,36 +247,62 @@ std::unique_ptr<SkEncoder> SkJpegEncoder::Make(SkWStream* dst, const SkPixmap& s
 
         jpeg_write_marker(encoderMgr->cinfo(), kICCMarker, markerData->bytes(), markerData->size());
     }
+}
+
+std::unique_ptr<SkEncoder> SkJpegEncoder::Make(SkWStream* dst, const SkPixmap& src,
+                                               const Options& options) {
+    if (!SkPixmapIsValid(src)) {
+        return nullptr;
+    }
+
+    std::unique_ptr<SkJpegEncoderMgr> encoderMgr = SkJpegEncoderMgr::Make(dst);
+
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(encoderMgr->errorMgr());
+    if (setjmp(jmp)) {
+        return nullptr;
+    }
+
+    if (!encoderMgr->setParams(src.info(), options)) {
+        return nullptr;
+    }
+
+    start_compress(encoderMgr.get(), src.info(), options);
 
     return std::unique_ptr<SkJpegEncoder>(new SkJpegEncoder(std::move(encoderMgr), src));
 }
 
 SkJpegEncoder::SkJpegEncoder(std::unique_ptr<SkJpegEncoderMgr> encoderMgr, const SkPixmap& src)
-    : INHERITED(src, encoderMgr->proc() ? encoderMgr->cinfo()->input_components*src.width() : 0)
+    : INHERITED(src, encoderMgr->needsConversion()
+                         ? (size_t)encoderMgr->rowsPerBatch() * 4 * src.width() : 0)
     , fEncoderMgr(std::move(encoderMgr))
 {}
 
 SkJpegEncoder::~SkJpegEncoder() {}
 
 bool SkJpegEncoder::onEncodeRows(int numRows) {
+    const int rowsPerBatch = fEncoderMgr->rowsPerBatch();
+    SkAutoSTMalloc<kRowsPerBatch, JSAMPROW> rows(rowsPerBatch);
+
     skjpeg_error_mgr::AutoPushJmpBuf jmp(fEncoderMgr->errorMgr());
     if (setjmp(jmp)) {
         return false;
     }
 
-    const void* srcRow = fSrc.addr(0, fCurrRow);
-    for (int i = 0; i < numRows; i++) {
-        JSAMPLE* jpegSrcRow = (JSAMPLE*) srcRow;
-        if (fEncoderMgr->proc()) {
-            fEncoderMgr->proc()((char*)fStorage.get(),
-                                (const char*)srcRow,
-                                fSrc.width(),
-                                fEncoderMgr->cinfo()->input_components);
-            jpegSrcRow = fStorage.get();
+    for (int i = 0; i < numRows; i += rowsPerBatch) {
+        const int top = fCurrRow + i;
+        const int count = SkTMin(rowsPerBatch, numRows - i);
+        if (fEncoderMgr->needsConversion()) {
+            fEncoderMgr->convertRows(fSrc, top, count, fStorage.get());
+            for (int j = 0; j < count; j++) {
+                rows[j] = fStorage.get() + (size_t)j * 4 * fSrc.width();
+            }
+        } else {
+            for (int j = 0; j < count; j++) {
+                rows[j] = (JSAMPROW) fSrc.addr(0, top + j);
+            }
         }
 
-        jpeg_write_scanlines(fEncoderMgr->cinfo(), &jpegSrcRow, 1);
-        srcRow = SkTAddOffset<const void>(srcRow, fSrc.rowBytes());
+        jpeg_write_scanlines(fEncoderMgr->cinfo(), rows.get(), count);
     }
 
     fCurrRow += numRows;
@@ -242,4 +318,77 @@ bool SkJpegEncoder::Encode(SkWStream* dst, const SkPixmap& src, const Options& o
     return encoder.get() && encoder->encodeRows(src.height());
 }
 
+bool SkJpegEncoder::EncodeYUV(SkWStream* dst, const SkPixmap planes[3],
+                              SkYUVColorSpace yuvColorSpace, const Options& options) {
+    if (kJPEG_SkYUVColorSpace != yuvColorSpace) {
+        return false;
+    }
+
+    const int hSamp = Downsample::k444 == options.fDownsample ? 1 : 2;
+    const int vSamp = Downsample::k420 == options.fDownsample ? 2 : 1;
+    const SkISize size = planes[0].info().dimensions();
+    const SkISize uvSize = SkISize::Make((size.width()  + hSamp - 1) / hSamp,
+                                         (size.height() + vSamp - 1) / vSamp);
+    for (int i = 0; i < 3; i++) {
+        if (!SkPixmapIsValid(planes[i]) ||
+            (kGray_8_SkColorType != planes[i].colorType() &&
+             kAlpha_8_SkColorType != planes[i].colorType()) ||
+            planes[i].info().dimensions() != (0 == i ? size : uvSize)) {
+            return false;
+        }
+    }
+
+    // libjpeg reads every plane in whole blocks, a block row's worth of rows at a time.  Rows
+    // that are a whole number of blocks wide are read in place; the rest are copied into
+    // |padded| with their last sample repeated.
+    const int maxRows[3] = { vSamp * DCTSIZE, DCTSIZE, DCTSIZE };
+    size_t paddedWidths[3];
+    SkAutoTMalloc<uint8_t> padded[3];
+    for (int i = 0; i < 3; i++) {
+        paddedWidths[i] = SkAlign8(planes[i].width());
+        if (paddedWidths[i] != (size_t)planes[i].width()) {
+            padded[i].reset(paddedWidths[i] * maxRows[i]);
+        }
+    }
+
+    std::unique_ptr<SkJpegEncoderMgr> encoderMgr = SkJpegEncoderMgr::Make(dst);
+
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(encoderMgr->errorMgr());
+    if (setjmp(jmp)) {
+        return false;
+    }
+
+    encoderMgr->setYUVParams(size, options);
+    start_compress(encoderMgr.get(), planes[0].info(), options);
+
+    jpeg_compress_struct* cinfo = encoderMgr->cinfo();
+    const int linesPerCall = cinfo->max_v_samp_factor * DCTSIZE;
+    JSAMPROW rows[3][2 * DCTSIZE];
+    JSAMPARRAY data[3] = { rows[0], rows[1], rows[2] };
+    while (cinfo->next_scanline < cinfo->image_height) {
+        for (int i = 0; i < 3; i++) {
+            const int v = cinfo->comp_info[i].v_samp_factor;
+            SkASSERT(v * DCTSIZE <= maxRows[i]);
+            const int top = cinfo->next_scanline * v / cinfo->max_v_samp_factor;
+            for (int j = 0; j < v * DCTSIZE; j++) {
+                // Past the bottom, repeat the last row.
+                const int y = SkTMin(top + j, planes[i].height() - 1);
+                const uint8_t* row = planes[i].addr8(0, y);
+                if (padded[i]) {
+                    uint8_t* copy = padded[i].get() + j * paddedWidths[i];
+                    memcpy(copy, row, planes[i].width());
+                    memset(copy + planes[i].width(), row[planes[i].width() - 1],
+                           paddedWidths[i] - planes[i].width());
+                    row = copy;
+                }
+                rows[i][j] = const_cast<JSAMPROW>(row);
+            }
+        }
+        jpeg_write_raw_data(cinfo, data, linesPerCall);
+    }
+
+    jpeg_finish_compress(cinfo);
+    return true;
+}
+
 #endif
@@ -10,15 +10,20 @@
 #ifdef SK_HAS_PNG_LIBRARY
 
 #include "SkColorTable.h"
+#include "SkExecutor.h"
 #include "SkImageEncoderFns.h"
 #include "SkImageInfoPriv.h"
+#include "SkNx.h"
 #include "SkStream.h"
 #include "SkString.h"
 #include "SkPngEncoder.h"
 #include "SkPngPriv.h"
+#include "SkTaskGroup.h"
+#include "SkTo.h"
 #include <vector>
 
 #include "png.h"
+#include "zlib.h"
 
 static_assert(PNG_FILTER_NONE  == (int)SkPngEncoder::FilterFlag::kNone,  "Skia libpng filter err.");
 static_assert(PNG_FILTER_SUB   == (int)SkPngEncoder::FilterFlag::kSub,   "Skia libpng filter err.");
@@ -97,6 +102,24 @@ std::unique_ptr<SkPngEncoderMgr> SkPngEncoderMgr::Make(SkWStream* stream) {
     return std::unique_ptr<SkPngEncoderMgr>(new SkPngEncoderMgr(pngPtr, infoPtr));
 }
 
+static int zlib_strategy(const SkPngEncoder::Options& options) {
+    switch (options.fZLibStrategy) {
+        case SkPngEncoder::ZLibStrategy::kDefault:
+            // libpng's choice.
+            return SkPngEncoder::FilterFlag::kNone == options.fFilterFlags ||
+                   SkPngEncoder::FilterFlag::kZero == options.fFilterFlags
+                           ? Z_DEFAULT_STRATEGY : Z_FILTERED;
+        case SkPngEncoder::ZLibStrategy::kFiltered:
+            return Z_FILTERED;
+        case SkPngEncoder::ZLibStrategy::kHuffmanOnly:
+            return Z_HUFFMAN_ONLY;
+        case SkPngEncoder::ZLibStrategy::kRLE:
+            return Z_RLE;
+    }
+    SkASSERT(false);
+    return Z_DEFAULT_STRATEGY;
+}
+
 bool SkPngEncoderMgr::setHeader(const SkImageInfo& srcInfo, const SkPngEncoder::Options& options) {
     if (setjmp(png_jmpbuf(fPngPtr))) {
         return false;
@@ -201,6 +224,10 @@ bool SkPngEncoderMgr::setHeader(const SkImageInfo& srcInfo, const SkPngEncoder::
     SkASSERT(zlibLevel == options.fZLibLevel);
     png_set_compression_level(fPngPtr, zlibLevel);
 
+    if (SkPngEncoder::ZLibStrategy::kDefault != options.fZLibStrategy) {
+        png_set_compression_strategy(fPngPtr, zlib_strategy(options));
+    }
+
     // Set comments in tEXt chunk
     const sk_sp<SkDataTable>& comments = options.fComments;
     if (comments != nullptr) {
@@ -372,8 +399,8 @@ void SkPngEncoderMgr::chooseProc(const SkImageInfo& srcInfo) {
     fProc = choose_proc(srcInfo);
 }
 
-std::unique_ptr<SkEncoder> SkPngEncoder::Make(SkWStream* dst, const SkPixmap& src,
-                                              const Options& options) {
+static std::unique_ptr<SkPngEncoderMgr> make_encoder_mgr(SkWStream* dst, const SkPixmap& src,
+                                                         const SkPngEncoder::Options& options) {
     if (!SkPixmapIsValid(src)) {
         return nullptr;
     }
@@ -396,6 +423,15 @@ std::unique_ptr<SkEncoder> SkPngEncoder::Make(SkWStream* dst, const SkPixmap& sr
     }
 
     encoderMgr->chooseProc(src.info());
+    return encoderMgr;
+}
+
+std::unique_ptr<SkEncoder> SkPngEncoder::Make(SkWStream* dst, const SkPixmap& src,
+                                              const Options& options) {
+    std::unique_ptr<SkPngEncoderMgr> encoderMgr = make_encoder_mgr(dst, src, options);
+    if (!encoderMgr) {
+        return nullptr;
+    }
 
     return std::unique_ptr<SkPngEncoder>(new SkPngEncoder(std::move(encoderMgr), src));
 }
@@ -432,9 +468,307 @@ bool SkPngEncoder::onEncodeRows(int numRows) {
     return true;
 }
 
+// Encoding in parallel splits the image into bands of rows, pigz style: each band is filtered
+// and compressed on its own into raw deflate data that ends on a byte boundary (with a sync
+// flush), primed with the filtered bytes just before it, so the bands joined together (with a
+// zlib header and combined Adler-32) are one zlib stream.  Each band is written as an IDAT.
+
+// Roughly how many filtered bytes go in each band.
+static constexpr size_t kParallelBandSize = 256 * 1024;
+
+// The largest window deflate uses, and so the most of the previous band that can help.
+static constexpr size_t kDictionarySize = 32 * 1024;
+
+static inline uint8_t paeth_predictor(int a, int b, int c) {
+    int p  = a + b - c,
+        pa = SkTAbs(p - a),
+        pb = SkTAbs(p - b),
+        pc = SkTAbs(p - c);
+    if (pa <= pb && pa <= pc) {
+        return a;
+    }
+    return pb <= pc ? b : c;
+}
+
+// Applies PNG filter type (0 to 4) to cur, given the row before it, prev.
+static void filter_row(int type, const uint8_t* cur, const uint8_t* prev, size_t rowBytes,
+                       int bpp, uint8_t* dst) {
+    size_t i = 0;
+    switch (type) {
+        case PNG_FILTER_VALUE_NONE:
+            memcpy(dst, cur, rowBytes);
+            break;
+        case PNG_FILTER_VALUE_SUB:
+            for (; i < (size_t)bpp; ++i) { dst[i] = cur[i]; }
+            for (; i < rowBytes;    ++i) { dst[i] = cur[i] - cur[i - bpp]; }
+            break;
+        case PNG_FILTER_VALUE_UP:
+            for (; i < rowBytes; ++i) { dst[i] = cur[i] - prev[i]; }
+            break;
+        case PNG_FILTER_VALUE_AVG:
+            for (; i < (size_t)bpp; ++i) { dst[i] = cur[i] - (prev[i] >> 1); }
+            for (; i < rowBytes;    ++i) { dst[i] = cur[i] - ((cur[i - bpp] + prev[i]) >> 1); }
+            break;
+        case PNG_FILTER_VALUE_PAETH:
+            for (; i < (size_t)bpp; ++i) { dst[i] = cur[i] - prev[i]; }
+            for (; i < rowBytes;    ++i) {
+                dst[i] = cur[i] - paeth_predictor(cur[i - bpp], prev[i], prev[i - bpp]);
+            }
+            break;
+        default:
+            SkASSERT(false);
+    }
+}
+
+// libpng's heuristic for choosing among filters: the sum of the filtered bytes' magnitudes,
+// reading them as signed.
+static uint32_t sum_of_magnitudes(const uint8_t* row, size_t rowBytes) {
+    uint32_t sum = 0;
+    size_t i = 0;
+    while (i + 8 <= rowBytes) {
+        // Each lane gains at most 128 a step, so flush them before they can overflow.
+        Sk8h lanes(0);
+        for (int steps = 0; steps < 256 && i + 8 <= rowBytes; ++steps, i += 8) {
+            Sk8h v = SkNx_cast<uint16_t>(Sk8b::Load(row + i));
+            lanes = lanes + Sk8h::Min(v, Sk8h(256) - v);
+        }
+        for (int k = 0; k < 8; ++k) {
+            sum += lanes[k];
+        }
+    }
+    for (; i < rowBytes; ++i) {
+        sum += SkTMin<uint32_t>(row[i], 256 - row[i]);
+    }
+    return sum;
+}
+
+// Transforms and filters the rows of one band.  Rows are filtered as libpng would, with the one
+// filter asked for, or if several are allowed, the one that scores best by the same heuristic.
+class SkPngRowFilterer {
+public:
+    SkPngRowFilterer(const SkPixmap& src, transform_scanline_proc proc, size_t rowBytes, int bpp,
+                     int filterFlags)
+        : fSrc(src)
+        , fProc(proc)
+        , fRowBytes(rowBytes)
+        , fBpp(bpp)
+        , fStorage(4 * rowBytes)
+    {
+        for (int type = PNG_FILTER_VALUE_NONE; type < PNG_FILTER_VALUE_LAST; ++type) {
+            if (filterFlags & (PNG_FILTER_NONE << type)) {
+                fTypes.push_back(type);
+            }
+        }
+        if (fTypes.empty()) {
+            fTypes.push_back(PNG_FILTER_VALUE_NONE);
+        }
+        fPrev  = fStorage.data();
+        fCur   = fPrev + rowBytes;
+        fTrial = fCur  + rowBytes;
+        fBest  = fTrial + rowBytes;
+    }
+
+    // Appends the filter type and filtered bytes of row y to out.
+    void filterRow(int y, std::vector<uint8_t>* out) {
+        if (fLastRow == y - 1) {
+            std::swap(fPrev, fCur);
+        } else if (y > 0) {
+            this->transformRow(y - 1, fPrev);
+        } else {
+            memset(fPrev, 0, fRowBytes);
+        }
+        this->transformRow(y, fCur);
+        fLastRow = y;
+
+        int bestType = fTypes[0];
+        filter_row(bestType, fCur, fPrev, fRowBytes, fBpp, fBest);
+        if (fTypes.size() > 1) {
+            uint32_t bestSum = sum_of_magnitudes(fBest, fRowBytes);
+            for (size_t i = 1; i < fTypes.size(); ++i) {
+                filter_row(fTypes[i], fCur, fPrev, fRowBytes, fBpp, fTrial);
+                uint32_t sum = sum_of_magnitudes(fTrial, fRowBytes);
+                if (sum < bestSum) {
+                    bestSum = sum;
+                    bestType = fTypes[i];
+                    std::swap(fBest, fTrial);
+                }
+            }
+        }
+        out->push_back(SkToU8(bestType));
+        out->insert(out->end(), fBest, fBest + fRowBytes);
+    }
+
+private:
+    void transformRow(int y, uint8_t* dst) {
+        fProc((char*)dst, (const char*)fSrc.addr(0, y), fSrc.width(),
+              SkColorTypeBytesPerPixel(fSrc.colorType()));
+    }
+
+    const SkPixmap&         fSrc;
+    transform_scanline_proc fProc;
+    const size_t            fRowBytes;
+    const int               fBpp;
+    std::vector<int>        fTypes;
+    std::vector<uint8_t>    fStorage;
+    uint8_t*                fPrev;
+    uint8_t*                fCur;
+    uint8_t*                fTrial;
+    uint8_t*                fBest;
+    int                     fLastRow = -1;
+};
+
+struct SkPngBand {
+    int                  fTop;
+    int                  fBottom;
+    std::vector<uint8_t> fOutput;
+    uLong                fAdler  = 0;
+    size_t               fLength = 0;
+    bool                 fOK     = false;
+};
+
+// The two byte zlib header deflateInit2() would have written for this level.
+static void append_zlib_header(int zlibLevel, std::vector<uint8_t>* out) {
+    uint8_t flags = 0x9C;
+    if (zlibLevel < 2) {
+        flags = 0x01;
+    } else if (zlibLevel < 6) {
+        flags = 0x5E;
+    } else if (zlibLevel > 6) {
+        flags = 0xDA;
+    }
+    out->push_back(0x78);
+    out->push_back(flags);
+}
+
+static void encode_band(const SkPixmap& src, transform_scanline_proc proc, size_t rowBytes,
+                        int bpp, const SkPngEncoder::Options& options, int zlibLevel,
+                        bool last, SkPngBand* band) {
+    SkPngRowFilterer filterer(src, proc, rowBytes, bpp, (int)options.fFilterFlags);
+
+    // Filter the end of the band above again to prime deflate with.  Filtering depends only
+    // on a row and the one before it, so these bytes match what that band compressed.
+    std::vector<uint8_t> dictionary;
+    const size_t rowsForDictionary = (kDictionarySize + rowBytes) / (rowBytes + 1);
+    const int dictionaryRows = SkToInt(SkTMin<size_t>(band->fTop, rowsForDictionary));
+    for (int y = band->fTop - dictionaryRows; y < band->fTop; ++y) {
+        filterer.filterRow(y, &dictionary);
+    }
+    if (dictionary.size() > kDictionarySize) {
+        dictionary.erase(dictionary.begin(), dictionary.end() - kDictionarySize);
+    }
+
+    std::vector<uint8_t> input;
+    input.reserve((band->fBottom - band->fTop) * (rowBytes + 1));
+    for (int y = band->fTop; y < band->fBottom; ++y) {
+        filterer.filterRow(y, &input);
+    }
+    band->fLength = input.size();
+    band->fAdler = adler32(adler32(0L, Z_NULL, 0), input.data(), SkToUInt(input.size()));
+
+    z_stream zStream;
+    zStream.zalloc = Z_NULL;
+    zStream.zfree = Z_NULL;
+    zStream.opaque = Z_NULL;
+    if (Z_OK != deflateInit2(&zStream, zlibLevel, Z_DEFLATED, -15 /* raw deflate */, 8,
+                             zlib_strategy(options))) {
+        return;
+    }
+    if (!dictionary.empty()) {
+        deflateSetDictionary(&zStream, dictionary.data(), SkToUInt(dictionary.size()));
+    }
+
+    std::vector<uint8_t>& output = band->fOutput;
+    if (0 == band->fTop) {
+        append_zlib_header(zlibLevel, &output);
+    }
+    size_t used = output.size();
+    // Usually enough for everything, including the empty stored block of a sync flush.
+    output.resize(used + deflateBound(&zStream, (uLong)input.size()) + 16);
+    zStream.next_in = input.data();
+    zStream.avail_in = SkToUInt(input.size());
+    int result;
+    do {
+        if (used == output.size()) {
+            output.resize(2 * output.size());
+        }
+        zStream.next_out = output.data() + used;
+        zStream.avail_out = SkToUInt(output.size() - used);
+        result = deflate(&zStream, last ? Z_FINISH : Z_SYNC_FLUSH);
+        used = output.size() - zStream.avail_out;
+    } while (result != Z_STREAM_ERROR && (zStream.avail_in || zStream.avail_out == 0));
+    output.resize(used);
+    (void)deflateEnd(&zStream);
+    band->fOK = (last ? Z_STREAM_END : Z_OK) == result;
+}
+
+// Returns false if the image can't be, or isn't worth, encoding in parallel; nothing past the
+// header will have been written.  Otherwise sets *success to whether it was encoded.
+static bool encode_in_parallel(SkPngEncoderMgr* encoderMgr, const SkPixmap& src,
+                               const SkPngEncoder::Options& options, bool* success) {
+    const size_t rowBytes = (size_t)encoderMgr->pngBytesPerPixel() * src.width();
+    if (rowBytes != png_get_rowbytes(encoderMgr->pngPtr(), encoderMgr->infoPtr())) {
+        // libpng is transforming rows for us (e.g. dropping the alpha of opaque F16).
+        return false;
+    }
+    const int rowsPerBand = SkToInt(SkTMax<size_t>(1, kParallelBandSize / (rowBytes + 1)));
+    const int bandCount = (src.height() + rowsPerBand - 1) / rowsPerBand;
+    if (bandCount < 2) {
+        return false;
+    }
+
+    const int zlibLevel = SkTMin(SkTMax(0, options.fZLibLevel), 9);
+    std::vector<SkPngBand> bands(bandCount);
+    for (int i = 0; i < bandCount; ++i) {
+        bands[i].fTop = i * rowsPerBand;
+        bands[i].fBottom = SkTMin((i + 1) * rowsPerBand, src.height());
+    }
+    {
+        SkTaskGroup tg(*options.fExecutor);
+        tg.batch(bandCount, [&](int i) {
+            encode_band(src, encoderMgr->proc(), rowBytes, encoderMgr->pngBytesPerPixel(),
+                        options, zlibLevel, i == bandCount - 1, &bands[i]);
+        });
+        tg.wait();
+    }
+
+    *success = false;
+    uLong adler = adler32(0L, Z_NULL, 0);
+    for (const SkPngBand& band : bands) {
+        if (!band.fOK) {
+            return true;
+        }
+        adler = adler32_combine(adler, band.fAdler, (z_off_t)band.fLength);
+    }
+    const uint8_t trailer[4] = {
+        (uint8_t)(adler >> 24), (uint8_t)(adler >> 16), (uint8_t)(adler >> 8), (uint8_t)adler,
+    };
+    bands.back().fOutput.insert(bands.back().fOutput.end(), trailer, trailer + 4);
+
+    png_structp pngPtr = encoderMgr->pngPtr();
+    if (setjmp(png_jmpbuf(pngPtr))) {
+        return true;
+    }
+    for (const SkPngBand& band : bands) {
+        png_write_chunk(pngPtr, (png_const_bytep)"IDAT", band.fOutput.data(), band.fOutput.size());
+    }
+    png_write_chunk(pngPtr, (png_const_bytep)"IEND", nullptr, 0);
+    *success = true;
+    return true;
+}
+
 bool SkPngEncoder::Encode(SkWStream* dst, const SkPixmap& src, const Options& options) {
-    auto encoder = SkPngEncoder::Make(dst, src, options);
-    return encoder.get() && encoder->encodeRows(src.height());
+    std::unique_ptr<SkPngEncoderMgr> encoderMgr = make_encoder_mgr(dst, src, options);
+    if (!encoderMgr) {
+        return false;
+    }
+
+    bool success;
+    if (options.fExecutor && encode_in_parallel(encoderMgr.get(), src, options, &success)) {
+        return success;
+    }
+
+    SkPngEncoder encoder(std::move(encoderMgr), src);
+    return encoder.encodeRows(src.height());
 }
 
 #endif
@@ -34,6 +34,8 @@
 //   http://review.webmproject.org/gitweb?p=libwebp.git
 
 #include <stdio.h>
+#include <vector>
+
 extern "C" {
 // If moving libwebp out of skia source tree, path for webp headers must be
 // updated accordingly. Here, we enforce using local copy in webp sub-directory.
@@ -103,11 +105,9 @@ static int stream_writer(const uint8_t* data, size_t data_size,
   return stream->write(data, data_size) ? 1 : 0;
 }
 
-bool SkWebpEncoder::Encode(SkWStream* stream, const SkPixmap& pixmap, const Options& opts) {
-    if (!SkPixmapIsValid(pixmap)) {
-        return false;
-    }
-
+// Encodes |pixmap| as a still webp, without any color profile.
+static bool encode_picture(SkWStream* stream, const SkPixmap& pixmap,
+                           const SkWebpEncoder::Options& opts) {
     const transform_scanline_proc proc = choose_proc(pixmap.info());
     if (!proc) {
         return false;
@@ -135,12 +135,13 @@ bool SkWebpEncoder::Encode(SkWStream* stream, const SkPixmap& pixmap, const Opti
     pic.width = pixmap.width();
     pic.height = pixmap.height();
     pic.writer = stream_writer;
+    pic.custom_ptr = (void*)stream;
 
     // Set compression, method, and pixel format.
     // libwebp recommends using BGRA for lossless and YUV for lossy.
     // The choices of |webp_config.method| currently just match Chrome's defaults.  We
     // could potentially expose this decision to the client.
-    if (Compression::kLossy == opts.fCompression) {
+    if (SkWebpEncoder::Compression::kLossy == opts.fCompression) {
         webp_config.lossless = 0;
 #ifndef SK_WEBP_ENCODER_USE_DEFAULT_METHOD
         webp_config.method = 3;
@@ -152,13 +153,6 @@ bool SkWebpEncoder::Encode(SkWStream* stream, const SkPixmap& pixmap, const Opti
         pic.use_argb = 1;
     }
 
-    // If there is no need to embed an ICC profile, we write directly to the input stream.
-    // Otherwise, we will first encode to |tmp| and use a mux to add the ICC chunk.  libwebp
-    // forces us to have an encoded image before we can add a profile.
-    sk_sp<SkData> icc = icc_from_color_space(pixmap.info());
-    SkDynamicMemoryWStream tmp;
-    pic.custom_ptr = icc ? (void*)&tmp : (void*)stream;
-
     const uint8_t* src = (uint8_t*)pixmap.addr();
     const int rgbStride = pic.width * bpp;
     const size_t rowBytes = pixmap.rowBytes();
@@ -186,34 +180,179 @@ bool SkWebpEncoder::Encode(SkWStream* stream, const SkPixmap& pixmap, const Opti
         return false;
     }
 
-    if (!WebPEncode(&webp_config, &pic)) {
+    return WebPEncode(&webp_config, &pic);
+}
+
+// Writes what |mux| holds to |stream|.
+static bool assemble(WebPMux* mux, SkWStream* stream) {
+    WebPData assembled;
+    if (WEBP_MUX_OK != WebPMuxAssemble(mux, &assembled)) {
         return false;
     }
 
-    if (icc) {
-        sk_sp<SkData> encodedData = tmp.detachAsData();
-        WebPData encoded = { encodedData->bytes(), encodedData->size() };
-        WebPData iccChunk = { icc->bytes(), icc->size() };
+    bool success = stream->write(assembled.bytes, assembled.size);
+    WebPDataClear(&assembled);
+    return success;
+}
+
+bool SkWebpEncoder::Encode(SkWStream* stream, const SkPixmap& pixmap, const Options& opts) {
+    if (!SkPixmapIsValid(pixmap)) {
+        return false;
+    }
+
+    // If there is no need to embed an ICC profile, we write directly to the input stream.
+    // Otherwise, we will first encode to |tmp| and use a mux to add the ICC chunk.  libwebp
+    // forces us to have an encoded image before we can add a profile.
+    sk_sp<SkData> icc = icc_from_color_space(pixmap.info());
+    if (!icc) {
+        return encode_picture(stream, pixmap, opts);
+    }
+
+    SkDynamicMemoryWStream tmp;
+    if (!encode_picture(&tmp, pixmap, opts)) {
+        return false;
+    }
+
+    sk_sp<SkData> encodedData = tmp.detachAsData();
+    WebPData encoded = { encodedData->bytes(), encodedData->size() };
+    WebPData iccChunk = { icc->bytes(), icc->size() };
+
+    SkAutoTCallVProc<WebPMux, WebPMuxDelete> mux(WebPMuxNew());
+    if (WEBP_MUX_OK != WebPMuxSetImage(mux, &encoded, 0)) {
+        return false;
+    }
+
+    if (WEBP_MUX_OK != WebPMuxSetChunk(mux, "ICCP", &iccChunk, 0)) {
+        return false;
+    }
+
+    return assemble(mux, stream);
+}
+
+// Returns the smallest rectangle outside of which |curr| and |prev| match, or an empty
+// rectangle if they match everywhere.
+static SkIRect find_dirty_rect(const SkPixmap& curr, const SkPixmap& prev) {
+    SkASSERT(curr.info() == prev.info());
+    const int width = curr.width();
+    const int height = curr.height();
+    const size_t bpp = curr.info().bytesPerPixel();
+    const size_t rowBytes = width * bpp;
+    auto rows_match = [&](int y) {
+        return 0 == memcmp(curr.addr(0, y), prev.addr(0, y), rowBytes);
+    };
+    auto pixels_match = [&](int x, int y) {
+        return 0 == memcmp(curr.addr(x, y), prev.addr(x, y), bpp);
+    };
+
+    int top = 0;
+    while (top < height && rows_match(top)) {
+        top++;
+    }
+    if (top == height) {
+        return SkIRect::MakeEmpty();
+    }
+    int bottom = height;
+    while (rows_match(bottom - 1)) {
+        bottom--;
+    }
 
-        SkAutoTCallVProc<WebPMux, WebPMuxDelete> mux(WebPMuxNew());
-        if (WEBP_MUX_OK != WebPMuxSetImage(mux, &encoded, 0)) {
+    // Every row from here on can only narrow the columns that differ.
+    int left = width, right = 0;
+    for (int y = top; y < bottom; ++y) {
+        int x = 0;
+        while (x < left && pixels_match(x, y)) {
+            x++;
+        }
+        left = x;
+        x = width;
+        while (x > right && pixels_match(x - 1, y)) {
+            x--;
+        }
+        right = x;
+    }
+    SkASSERT(left < right);
+    return SkIRect::MakeLTRB(left, top, right, bottom);
+}
+
+bool SkWebpEncoder::EncodeAnimated(SkWStream* stream, const Frame frames[], int frameCount,
+                                   const Options& opts) {
+    if (frameCount < 1) {
+        return false;
+    }
+    const SkImageInfo& info = frames[0].fPixmap.info();
+    for (int i = 0; i < frameCount; ++i) {
+        if (!SkPixmapIsValid(frames[i].fPixmap) || frames[i].fPixmap.info() != info ||
+            frames[i].fDuration < 0) {
             return false;
         }
+    }
 
-        if (WEBP_MUX_OK != WebPMuxSetChunk(mux, "ICCP", &iccChunk, 0)) {
+    struct EncodedFrame {
+        sk_sp<SkData> fData;
+        SkIPoint      fOffset;
+        int           fDuration;
+    };
+    std::vector<EncodedFrame> encodedFrames;
+    for (int i = 0; i < frameCount; ++i) {
+        SkIRect rect = info.bounds();
+        if (i > 0) {
+            rect = find_dirty_rect(frames[i].fPixmap, frames[i - 1].fPixmap);
+            if (rect.isEmpty()) {
+                encodedFrames.back().fDuration += frames[i].fDuration;
+                continue;
+            }
+            // Frames can only be placed at even offsets.
+            rect.fLeft &= ~1;
+            rect.fTop &= ~1;
+        }
+
+        SkPixmap subset;
+        SkAssertResult(frames[i].fPixmap.extractSubset(&subset, rect));
+        SkDynamicMemoryWStream encoded;
+        if (!encode_picture(&encoded, subset, opts)) {
             return false;
         }
+        encodedFrames.push_back({ encoded.detachAsData(), { rect.fLeft, rect.fTop },
+                                  frames[i].fDuration });
+    }
 
-        WebPData assembled;
-        if (WEBP_MUX_OK != WebPMuxAssemble(mux, &assembled)) {
+    SkAutoTCallVProc<WebPMux, WebPMuxDelete> mux(WebPMuxNew());
+    if (!mux) {
+        return false;
+    }
+    for (const EncodedFrame& frame : encodedFrames) {
+        WebPMuxFrameInfo frameInfo;
+        memset(&frameInfo, 0, sizeof(frameInfo));
+        frameInfo.bitstream = { frame.fData->bytes(), frame.fData->size() };
+        frameInfo.x_offset = frame.fOffset.x();
+        frameInfo.y_offset = frame.fOffset.y();
+        frameInfo.duration = frame.fDuration;
+        frameInfo.id = WEBP_CHUNK_ANMF;
+        // Each frame replaces what's under it, and stays until a later frame covers it.
+        frameInfo.dispose_method = WEBP_MUX_DISPOSE_NONE;
+        frameInfo.blend_method = WEBP_MUX_NO_BLEND;
+        if (WEBP_MUX_OK != WebPMuxPushFrame(mux, &frameInfo, 0)) {
             return false;
         }
+    }
 
-        stream->write(assembled.bytes, assembled.size);
-        WebPDataClear(&assembled);
+    WebPMuxAnimParams params;
+    params.bgcolor = 0;
+    params.loop_count = 0;  // Forever.
+    if (WEBP_MUX_OK != WebPMuxSetAnimationParams(mux, &params) ||
+        WEBP_MUX_OK != WebPMuxSetCanvasSize(mux, info.width(), info.height())) {
+        return false;
+    }
+
+    sk_sp<SkData> icc = icc_from_color_space(info);
+    if (icc) {
+        WebPData iccChunk = { icc->bytes(), icc->size() };
+        if (WEBP_MUX_OK != WebPMuxSetChunk(mux, "ICCP", &iccChunk, 0)) {
+            return false;
+        }
     }
 
-    return true;
+    return assemble(mux, stream);
 }
 
 #endif
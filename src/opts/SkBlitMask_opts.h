@@ -10,6 +10,10 @@
 
 #include "Sk4px.h"
 
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    #include <immintrin.h>
+#endif
+
 namespace SK_OPTS_NS {
 
 #if defined(SK_ARM_HAS_NEON)
@@ -155,6 +159,54 @@ namespace SK_OPTS_NS {
     }
 
 #else
+    #if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+        // 8-pixel versions of the Sk4px operations below, with the same math, so each row's
+        // leftover pixels can finish with Sk4px without any visible seam.
+        static inline __m256i approx_mul_div_255_avx2(__m256i x, __m256i y) {
+            const __m256i zero = _mm256_setzero_si256();
+            __m256i xlo = _mm256_unpacklo_epi8(x, zero), xhi = _mm256_unpackhi_epi8(x, zero),
+                    ylo = _mm256_unpacklo_epi8(y, zero), yhi = _mm256_unpackhi_epi8(y, zero);
+            // (x*y + x) >> 8, like Sk4px::approxMulDiv255().
+            __m256i lo = _mm256_srli_epi16(_mm256_add_epi16(xlo, _mm256_mullo_epi16(xlo, ylo)), 8),
+                    hi = _mm256_srli_epi16(_mm256_add_epi16(xhi, _mm256_mullo_epi16(xhi, yhi)), 8);
+            return _mm256_packus_epi16(lo, hi);
+        }
+
+        static inline __m256i inv_avx2(__m256i x) {
+            return _mm256_sub_epi8(_mm256_set1_epi8((char)0xFF), x);
+        }
+
+        static inline __m256i alphas_avx2(__m256i px) {
+            static_assert(SK_A32_SHIFT == 24, "Intel's always little-endian.");
+            const __m256i splat = _mm256_setr_epi8(3,3,3,3, 7,7,7,7, 11,11,11,11, 15,15,15,15,
+                                                   3,3,3,3, 7,7,7,7, 11,11,11,11, 15,15,15,15);
+            return _mm256_shuffle_epi8(px, splat);
+        }
+
+        // Each of 8 alphas splatted across its pixel's 4 bytes.
+        static inline __m256i load8_alphas_avx2(const SkAlpha a[8]) {
+            const __m256i splat = _mm256_setr_epi8(0,0,0,0, 4,4,4,4, 8,8,8,8, 12,12,12,12,
+                                                   0,0,0,0, 4,4,4,4, 8,8,8,8, 12,12,12,12);
+            __m256i as = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)a));
+            return _mm256_shuffle_epi8(as, splat);
+        }
+
+        // Like Sk4px::MapDstAlpha(), but runs fn8 on 8 pixels at a time first.
+        template <typename Fn, typename Fn8>
+        static void map_dst_alpha(int n, SkPMColor* dst, const SkAlpha* a,
+                                  const Fn& fn, const Fn8& fn8) {
+            while (n >= 8) {
+                __m256i d = _mm256_loadu_si256((const __m256i*)dst);
+                _mm256_storeu_si256((__m256i*)dst, fn8(d, load8_alphas_avx2(a)));
+                dst += 8; a += 8; n -= 8;
+            }
+            Sk4px::MapDstAlpha(n, dst, a, fn);
+        }
+        #define SK_MAP_DST_ALPHA(n, dst, a, fn, fn8) map_dst_alpha(n, dst, a, fn, fn8)
+    #else
+        #define SK_MAP_DST_ALPHA(n, dst, a, fn, fn8) Sk4px::MapDstAlpha(n, dst, a, fn)
+    #endif
+
     static void blit_mask_d32_a8_general(SkPMColor* dst, size_t dstRB,
                                          const SkAlpha* mask, size_t maskRB,
                                          SkColor color, int w, int h) {
@@ -166,8 +218,16 @@ namespace SK_OPTS_NS {
                  right = d.approxMulDiv255(left.alphas().inv());
             return left + right;  // This does not overflow (exhaustively checked).
         };
+    #if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+        __m256i s8 = _mm256_set1_epi32(SkPreMultiplyColor(color));
+        auto fn8 = [&](__m256i d, __m256i aa) {
+            __m256i left  = approx_mul_div_255_avx2(s8, aa),
+                    right = approx_mul_div_255_avx2(d, inv_avx2(alphas_avx2(left)));
+            return _mm256_add_epi8(left, right);
+        };
+    #endif
         while (h --> 0) {
-            Sk4px::MapDstAlpha(w, dst, mask, fn);
+            SK_MAP_DST_ALPHA(w, dst, mask, fn, fn8);
             dst  +=  dstRB / sizeof(*dst);
             mask += maskRB / sizeof(*mask);
         }
@@ -186,8 +246,15 @@ namespace SK_OPTS_NS {
             //  = s*aa + d(1-aa)
             return s.approxMulDiv255(aa) + d.approxMulDiv255(aa.inv());
         };
+    #if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+        __m256i s8 = _mm256_set1_epi32(SkPreMultiplyColor(color));
+        auto fn8 = [&](__m256i d, __m256i aa) {
+            return _mm256_add_epi8(approx_mul_div_255_avx2(s8, aa),
+                                   approx_mul_div_255_avx2(d, inv_avx2(aa)));
+        };
+    #endif
         while (h --> 0) {
-            Sk4px::MapDstAlpha(w, dst, mask, fn);
+            SK_MAP_DST_ALPHA(w, dst, mask, fn, fn8);
             dst  +=  dstRB / sizeof(*dst);
             mask += maskRB / sizeof(*mask);
         }
@@ -206,12 +273,20 @@ namespace SK_OPTS_NS {
             return Sk4px(Sk16b(aa) & Sk16b(0,0,0,255, 0,0,0,255, 0,0,0,255, 0,0,0,255))
                  + d.approxMulDiv255(aa.inv());
         };
+    #if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+        auto fn8 = [](__m256i d, __m256i aa) {
+            return _mm256_add_epi8(_mm256_and_si256(aa, _mm256_set1_epi32(0xFF000000)),
+                                   approx_mul_div_255_avx2(d, inv_avx2(aa)));
+        };
+    #endif
         while (h --> 0) {
-            Sk4px::MapDstAlpha(w, dst, mask, fn);
+            SK_MAP_DST_ALPHA(w, dst, mask, fn, fn8);
             dst  +=  dstRB / sizeof(*dst);
             mask += maskRB / sizeof(*mask);
         }
     }
+
+    #undef SK_MAP_DST_ALPHA
 #endif
 
 /*not static*/ inline void blit_mask_d32_a8(SkPMColor* dst, size_t dstRB,
@@ -15,6 +15,9 @@
     #include <immintrin.h>
 #elif defined(SK_ARM_HAS_CRC32)
     #include <arm_acle.h>
+    #if defined(SK_ARM_HAS_NEON)
+        #include <arm_neon.h>
+    #endif
 #endif
 
 namespace SK_OPTS_NS {
@@ -26,9 +29,26 @@ static inline T unaligned_load(const P* p) {
     return v;
 }
 
+#if (SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2 && (defined(__x86_64__) || defined(_M_X64))) || \
+    (defined(SK_ARM_HAS_CRC32) && defined(SK_ARM_HAS_NEON))
+// Long keys can be hashed faster with SIMD multiplies than with crc32 instructions, xxh3-style:
+// 64 bytes at a time into eight 64-bit lanes, each lane adding the product of the two 32-bit
+// halves of (data ^ key) and the data from its neighboring lane, so no input is lost when a
+// product is zero.  Every kWideScrambleBytes the lanes are scrambled so their bits keep mixing.
+// At the end the lanes, the length, and any leftover bytes are hashed the usual way.
+static const size_t kWideMinBytes      = 256,
+                    kWideStripeBytes   = 64,
+                    kWideScrambleBytes = 1024;
+static const uint32_t kWidePrime = 0x9E3779B1;
+static const uint64_t kWideKey[8] = {
+    0xbe4ba423396cfeb8, 0x1cad21f72c81017c, 0xdb979083e96dd4de, 0x1f67b3b7a4a44072,
+    0x78e5c0cc4ee679cb, 0x2172ffcc7dd05a82, 0x8e2443f7744608b8, 0x4c263a81e69035e0,
+};
+#endif
+
 #if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE42 && (defined(__x86_64__) || defined(_M_X64))
     // This is not a CRC32.  It's Just A Hash that uses those instructions because they're fast.
-    /*not static*/ inline uint32_t hash_fn(const void* vdata, size_t bytes, uint32_t seed) {
+    static inline uint32_t crc_hash(const void* vdata, size_t bytes, uint32_t seed) {
         auto data = (const uint8_t*)vdata;
 
         // _mm_crc32_u64() operates on 64-bit registers, so we use uint64_t for a while.
@@ -82,6 +102,64 @@ static inline T unaligned_load(const P* p) {
         return hash32;
     }
 
+  #if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    static inline __m256i wide_accumulate(__m256i acc, const uint8_t* data, __m256i key) {
+        __m256i d  = _mm256_loadu_si256((const __m256i*)data),
+                dk = _mm256_xor_si256(d, key);
+        __m256i product = _mm256_mul_epu32(dk, _mm256_srli_epi64(dk, 32)),
+                swapped = _mm256_shuffle_epi32(d, _MM_SHUFFLE(1,0,3,2));
+        return _mm256_add_epi64(acc, _mm256_add_epi64(product, swapped));
+    }
+
+    static inline __m256i wide_scramble(__m256i acc, __m256i key) {
+        acc = _mm256_xor_si256(acc, _mm256_srli_epi64(acc, 47));
+        acc = _mm256_xor_si256(acc, key);
+        // A 64-bit acc * kWidePrime, from two 32x32->64 bit multiplies.
+        const __m256i prime = _mm256_set1_epi32(kWidePrime);
+        __m256i lo = _mm256_mul_epu32(acc, prime),
+                hi = _mm256_mul_epu32(_mm256_srli_epi64(acc, 32), prime);
+        return _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32));
+    }
+
+    /*not static*/ inline uint32_t hash_fn(const void* vdata, size_t bytes, uint32_t seed) {
+        if (bytes < kWideMinBytes) {
+            return crc_hash(vdata, bytes, seed);
+        }
+        auto data = (const uint8_t*)vdata;
+
+        const __m256i key0 = _mm256_loadu_si256((const __m256i*)(kWideKey + 0)),
+                      key1 = _mm256_loadu_si256((const __m256i*)(kWideKey + 4)),
+                      s    = _mm256_set1_epi64x(seed);
+        __m256i acc0 = _mm256_xor_si256(key0, s),
+                acc1 = _mm256_xor_si256(key1, s);
+
+        for (size_t left = bytes; left >= kWideStripeBytes; ) {
+            size_t stripes = SkTMin(left, kWideScrambleBytes) / kWideStripeBytes;
+            for (size_t i = 0; i < stripes; i++) {
+                acc0 = wide_accumulate(acc0, data +  0, key0);
+                acc1 = wide_accumulate(acc1, data + 32, key1);
+                data += kWideStripeBytes;
+            }
+            left -= stripes * kWideStripeBytes;
+            if (stripes * kWideStripeBytes == kWideScrambleBytes) {
+                acc0 = wide_scramble(acc0, key0);
+                acc1 = wide_scramble(acc1, key1);
+            }
+        }
+
+        uint64_t lanes[8];
+        _mm256_storeu_si256((__m256i*)(lanes + 0), acc0);
+        _mm256_storeu_si256((__m256i*)(lanes + 4), acc1);
+        uint32_t hash = crc_hash(lanes, sizeof(lanes), seed);
+        hash = (uint32_t)_mm_crc32_u64(hash, bytes);
+        return crc_hash(data, bytes % kWideStripeBytes, hash);
+    }
+  #else
+    /*not static*/ inline uint32_t hash_fn(const void* vdata, size_t bytes, uint32_t seed) {
+        return crc_hash(vdata, bytes, seed);
+    }
+  #endif
+
 #elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE42
     // 32-bit version of above, using _mm_crc32_u32() but not _mm_crc32_u64().
     /*not static*/ inline uint32_t hash_fn(const void* vdata, size_t bytes, uint32_t hash) {
@@ -128,7 +206,7 @@ static inline T unaligned_load(const P* p) {
     }
 
 #elif defined(SK_ARM_HAS_CRC32)
-    /*not static*/ inline uint32_t hash_fn(const void* vdata, size_t bytes, uint32_t hash) {
+    static inline uint32_t crc_hash(const void* vdata, size_t bytes, uint32_t hash) {
         auto data = (const uint8_t*)vdata;
         if (bytes >= 24) {
             uint32_t a = hash,
@@ -171,6 +249,66 @@ static inline T unaligned_load(const P* p) {
         return hash;
     }
 
+  #if defined(SK_ARM_HAS_NEON)
+    static inline uint64x2_t wide_accumulate(uint64x2_t acc, const uint8_t* data, uint64x2_t key) {
+        uint64x2_t d  = vreinterpretq_u64_u8(vld1q_u8(data)),
+                   dk = veorq_u64(d, key);
+        uint64x2_t swapped = vextq_u64(d, d, 1);
+        return vaddq_u64(acc, vmlal_u32(swapped, vmovn_u64(dk), vshrn_n_u64(dk, 32)));
+    }
+
+    static inline uint64x2_t wide_scramble(uint64x2_t acc, uint64x2_t key) {
+        acc = veorq_u64(acc, vshrq_n_u64(acc, 47));
+        acc = veorq_u64(acc, key);
+        // A 64-bit acc * kWidePrime, from two 32x32->64 bit multiplies.
+        const uint32x2_t prime = vdup_n_u32(kWidePrime);
+        uint64x2_t lo = vmull_u32(vmovn_u64(acc), prime),
+                   hi = vmull_u32(vshrn_n_u64(acc, 32), prime);
+        return vaddq_u64(lo, vshlq_n_u64(hi, 32));
+    }
+
+    /*not static*/ inline uint32_t hash_fn(const void* vdata, size_t bytes, uint32_t seed) {
+        if (bytes < kWideMinBytes) {
+            return crc_hash(vdata, bytes, seed);
+        }
+        auto data = (const uint8_t*)vdata;
+
+        uint64x2_t key[4], acc[4];
+        for (int j = 0; j < 4; j++) {
+            key[j] = vld1q_u64(kWideKey + 2*j);
+            acc[j] = veorq_u64(key[j], vdupq_n_u64(seed));
+        }
+
+        for (size_t left = bytes; left >= kWideStripeBytes; ) {
+            size_t stripes = SkTMin(left, kWideScrambleBytes) / kWideStripeBytes;
+            for (size_t i = 0; i < stripes; i++) {
+                for (int j = 0; j < 4; j++) {
+                    acc[j] = wide_accumulate(acc[j], data + 16*j, key[j]);
+                }
+                data += kWideStripeBytes;
+            }
+            left -= stripes * kWideStripeBytes;
+            if (stripes * kWideStripeBytes == kWideScrambleBytes) {
+                for (int j = 0; j < 4; j++) {
+                    acc[j] = wide_scramble(acc[j], key[j]);
+                }
+            }
+        }
+
+        uint64_t lanes[8];
+        for (int j = 0; j < 4; j++) {
+            vst1q_u64(lanes + 2*j, acc[j]);
+        }
+        uint32_t hash = crc_hash(lanes, sizeof(lanes), seed);
+        hash = __crc32d(hash, bytes);
+        return crc_hash(data, bytes % kWideStripeBytes, hash);
+    }
+  #else
+    /*not static*/ inline uint32_t hash_fn(const void* vdata, size_t bytes, uint32_t seed) {
+        return crc_hash(vdata, bytes, seed);
+    }
+  #endif
+
 #else
     // This is Murmur3.
     /*not static*/ inline uint32_t hash_fn(const void* vdata, size_t bytes, uint32_t hash) {
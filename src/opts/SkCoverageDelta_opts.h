@@ -0,0 +1,57 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkCoverageDelta_opts_DEFINED
+#define SkCoverageDelta_opts_DEFINED
+
+#include "SkCoverageDelta.h"
+#include "SkNx.h"
+
+namespace SK_OPTS_NS {
+
+    // Returns the running sum of v's lanes, plus carry in every lane.
+    static inline Sk4i prefix_sum(const Sk4i& v, const Sk4i& carry) {
+    #if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+        __m128i sum = _mm_add_epi32(v.fVec, _mm_slli_si128(v.fVec, 4));
+        sum = _mm_add_epi32(sum, _mm_slli_si128(sum, 8));
+        return Sk4i(sum) + carry;
+    #elif defined(SK_ARM_HAS_NEON)
+        int32x4_t zero = vdupq_n_s32(0);
+        int32x4_t sum = vaddq_s32(v.fVec, vextq_s32(zero, v.fVec, 3));
+        sum = vaddq_s32(sum, vextq_s32(zero, sum, 2));
+        return Sk4i(sum) + carry;
+    #else
+        int32_t s1 = v[0] + v[1],
+                s2 = s1 + v[2];
+        return Sk4i(v[0], s1, s2, s2 + v[3]) + carry;
+    #endif
+    }
+
+    // Accumulates one row of SkCoverageDeltaMask deltas into coverages, four at a time, and
+    // converts those into alphas.  width must be a multiple of 4.  Integer sums don't care about
+    // the order they're added in, so the results match a scalar running sum exactly.
+    static void accumulate_coverage_deltas(const SkFixed* deltas, SkAlpha* alphas, int width,
+                                           bool isEvenOdd, bool isInverse, bool isConvex) {
+        SkASSERT(width % 4 == 0);
+        Sk4i carry(0);
+        for (int x = 0; x < width; x += 4) {
+            Sk4i coverage = prefix_sum(Sk4i::Load(deltas + x), carry);
+        #if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+            carry = _mm_shuffle_epi32(coverage.fVec, 0xff);
+        #else
+            carry = Sk4i(coverage[3]);
+        #endif
+
+            Sk4i alpha = isConvex ? ConvexCoverageToAlpha(coverage, isInverse)
+                                  : CoverageToAlpha(coverage, isEvenOdd, isInverse);
+            SkNx_cast<SkAlpha>(alpha).store(alphas + x);
+        }
+    }
+
+}  // namespace SK_OPTS_NS
+
+#endif//SkCoverageDelta_opts_DEFINED
@@ -0,0 +1,95 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkMaskBlurFilter_opts_DEFINED
+#define SkMaskBlurFilter_opts_DEFINED
+
+#include "SkNx.h"
+
+#include <cstring>
+
+namespace SK_OPTS_NS {
+
+    // This is SkMaskBlurFilter's three pass running box sum, run over four A8 rows at once with
+    // one row per lane.  Each ring buffer slot holds all four rows' values side by side, so the
+    // caller's buffer needs 4x the scalar scan's.  The arithmetic is the same 32-bit arithmetic
+    // as the scalar scan, so the results are bit for bit the same.
+    //
+    // Output pixel x of row i goes to dst[x * dstStride + i].  That's where the transposing
+    // passes want it anyway, and it lets us store the four rows' pixels with one write.
+    static void box_blur_a8_x4(const uint8_t* src, size_t srcRB, int srcW,
+                               uint8_t* dst, size_t dstStride, int dstW,
+                               int noChangeCount, const int passSizes[3],
+                               uint32_t weight, uint32_t* buffer) {
+        uint32_t* buffer0    = buffer;
+        uint32_t* buffer0End = buffer0 + 4 * passSizes[0];
+        uint32_t* buffer1    = buffer0End;
+        uint32_t* buffer1End = buffer1 + 4 * passSizes[1];
+        uint32_t* buffer2    = buffer1End;
+        uint32_t* buffer2End = buffer2 + 4 * passSizes[2];
+
+        uint32_t* cursor0 = buffer0;
+        uint32_t* cursor1 = buffer1;
+        uint32_t* cursor2 = buffer2;
+
+        Sk4u sum0, sum1, sum2;
+        const Sk4u w(weight);
+
+        auto step = [&](const Sk4u& leadingEdge, uint8_t* out) {
+            sum0 = sum0 + leadingEdge;
+            sum1 = sum1 + sum0;
+            sum2 = sum2 + sum1;
+
+            // (weight * sum2 + 2^31) >> 32, where the rounding carry is the top bit of the
+            // product's low half.
+            Sk4u scaled = sum2.mulHi(w) + ((sum2 * w) >> 31);
+            SkNx_cast<uint8_t>(scaled).store(out);
+
+            sum2 = sum2 - Sk4u::Load(cursor2);
+            sum1.store(cursor2);
+            cursor2 = (cursor2 + 4) < buffer2End ? cursor2 + 4 : buffer2;
+
+            sum1 = sum1 - Sk4u::Load(cursor1);
+            sum0.store(cursor1);
+            cursor1 = (cursor1 + 4) < buffer1End ? cursor1 + 4 : buffer1;
+
+            sum0 = sum0 - Sk4u::Load(cursor0);
+            leadingEdge.store(cursor0);
+            cursor0 = (cursor0 + 4) < buffer0End ? cursor0 + 4 : buffer0;
+        };
+
+        auto load = [src, srcRB](int x) {
+            return Sk4u{src[x], src[srcRB + x], src[2 * srcRB + x], src[3 * srcRB + x]};
+        };
+
+        const size_t bufferBytes = (buffer2End - buffer0) * sizeof(uint32_t);
+
+        // Consume the source generating pixels, then keep going off its right side.
+        std::memset(buffer, 0, bufferBytes);
+        sum0 = sum1 = sum2 = Sk4u(0);
+        uint8_t* out = dst;
+        for (int x = 0; x < srcW; x++, out += dstStride) {
+            step(load(x), out);
+        }
+        for (int i = 0; i < noChangeCount; i++, out += dstStride) {
+            step(Sk4u(0), out);
+        }
+
+        // Starting from the right, fill in the rest.
+        std::memset(buffer, 0, bufferBytes);
+        sum0 = sum1 = sum2 = Sk4u(0);
+        uint8_t* outCursor = dst + dstW * dstStride;
+        int x = srcW;
+        while (outCursor > out) {
+            outCursor -= dstStride;
+            step(load(--x), outCursor);
+        }
+    }
+
+}
+
+#endif//SkMaskBlurFilter_opts_DEFINED
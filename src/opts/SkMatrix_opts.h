@@ -0,0 +1,86 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkMatrix_opts_DEFINED
+#define SkMatrix_opts_DEFINED
+
+#include "SkMatrix.h"
+#include "SkNx.h"
+#include "SkPoint.h"
+
+namespace SK_OPTS_NS {
+
+#if defined(SK_CPU_SSE_LEVEL) && SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX
+    static const int kMatrixPtsN = 8;
+#else
+    static const int kMatrixPtsN = 4;
+#endif
+
+    // These de-interleave N points into x and y vectors, and do the math in the same order as
+    // SkMatrix's MapXYProcs, so batches and single points map identically.  dst may equal src.
+
+    /*not static*/ inline void matrix_affine_pts(const SkMatrix& m, SkPoint dst[],
+                                                 const SkPoint src[], int count) {
+        using F = SkNx<kMatrixPtsN, float>;
+        const F sx = m.getScaleX(), kx = m.getSkewX(),  tx = m.getTranslateX(),
+                ky = m.getSkewY(),  sy = m.getScaleY(), ty = m.getTranslateY();
+        while (count >= kMatrixPtsN) {
+            F x, y;
+            F::Load2(src, &x, &y);
+            F::Store2(dst, x * sx + y * kx + tx,
+                           x * ky + y * sy + ty);
+            src   += kMatrixPtsN;
+            dst   += kMatrixPtsN;
+            count -= kMatrixPtsN;
+        }
+        while (count --> 0) {
+            SkScalar x = src->fX,
+                     y = src->fY;
+            dst->set(x * m.getScaleX() + y * m.getSkewX()  + m.getTranslateX(),
+                     x * m.getSkewY()  + y * m.getScaleY() + m.getTranslateY());
+            src += 1;
+            dst += 1;
+        }
+    }
+
+    /*not static*/ inline void matrix_persp_pts(const SkMatrix& m, SkPoint dst[],
+                                                const SkPoint src[], int count) {
+        using F = SkNx<kMatrixPtsN, float>;
+        const F sx = m.getScaleX(), kx = m.getSkewX(),  tx = m.getTranslateX(),
+                ky = m.getSkewY(),  sy = m.getScaleY(), ty = m.getTranslateY(),
+                p0 = m.getPerspX(), p1 = m.getPerspY(), p2 = m.get(SkMatrix::kMPersp2);
+        while (count >= kMatrixPtsN) {
+            F x, y;
+            F::Load2(src, &x, &y);
+            F X = x * sx + y * kx + tx,
+              Y = x * ky + y * sy + ty,
+              Z = x * p0 + y * p1 + p2;
+            // A real divide, not invert(): the estimates would drift from Persp_xy.
+            Z = (Z != 0).thenElse(F(1) / Z, F(0));
+            F::Store2(dst, X * Z, Y * Z);
+            src   += kMatrixPtsN;
+            dst   += kMatrixPtsN;
+            count -= kMatrixPtsN;
+        }
+        while (count --> 0) {
+            SkScalar x = src->fX,
+                     y = src->fY;
+            SkScalar X = x * m.getScaleX() + y * m.getSkewX()  + m.getTranslateX(),
+                     Y = x * m.getSkewY()  + y * m.getScaleY() + m.getTranslateY(),
+                     Z = x * m.getPerspX() + y * m.getPerspY() + m.get(SkMatrix::kMPersp2);
+            if (Z) {
+                Z = 1 / Z;
+            }
+            dst->set(X * Z, Y * Z);
+            src += 1;
+            dst += 1;
+        }
+    }
+
+}
+
+#endif//SkMatrix_opts_DEFINED
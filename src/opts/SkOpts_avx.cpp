@@ -8,6 +8,7 @@
 #include "SkOpts.h"
 
 #define SK_OPTS_NS avx
+#include "SkMatrix_opts.h"
 #include "SkRasterPipeline_opts.h"
 #include "SkUtils_opts.h"
 
@@ -17,6 +18,9 @@ namespace SkOpts {
         memset32 = SK_OPTS_NS::memset32;
         memset64 = SK_OPTS_NS::memset64;
 
+        matrix_affine_pts = SK_OPTS_NS::matrix_affine_pts;
+        matrix_persp_pts  = SK_OPTS_NS::matrix_persp_pts;
+
     #define M(st) stages_highp[SkRasterPipeline::st] = (StageFn)SK_OPTS_NS::st;
         SK_RASTER_PIPELINE_STAGES(M)
         just_return_highp = (StageFn)SK_OPTS_NS::just_return;
@@ -8,11 +8,18 @@
 #include "SkOpts.h"
 
 #define SK_OPTS_NS hsw
+#include "SkBlitMask_opts.h"
+#include "SkBlitRow_opts.h"
+#include "SkChecksum_opts.h"
 #include "SkRasterPipeline_opts.h"
 #include "SkUtils_opts.h"
 
 namespace SkOpts {
     void Init_hsw() {
+        blit_mask_d32_a8     = hsw::blit_mask_d32_a8;
+        blit_row_s32a_opaque = hsw::blit_row_s32a_opaque;
+        hash_fn              = hsw::hash_fn;
+
     #define M(st) stages_highp[SkRasterPipeline::st] = (StageFn)SK_OPTS_NS::st;
         SK_RASTER_PIPELINE_STAGES(M)
         just_return_highp = (StageFn)SK_OPTS_NS::just_return;
@@ -10,10 +10,14 @@
 #define SK_OPTS_NS sse41
 #include "SkRasterPipeline_opts.h"
 #include "SkBlitRow_opts.h"
+#include "SkCoverageDelta_opts.h"
+#include "SkMaskBlurFilter_opts.h"
 
 namespace SkOpts {
     void Init_sse41() {
         blit_row_s32a_opaque = sse41::blit_row_s32a_opaque;
+        box_blur_a8_x4       = sse41::box_blur_a8_x4;
+        accumulate_coverage_deltas = sse41::accumulate_coverage_deltas;
 
     #define M(st) stages_highp[SkRasterPipeline::st] = (StageFn)SK_OPTS_NS::st;
         SK_RASTER_PIPELINE_STAGES(M)
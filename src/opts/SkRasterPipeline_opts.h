@@ -83,8 +83,8 @@ struct Ctx {
     #define JUMPER_IS_SCALAR
 #elif defined(SK_ARM_HAS_NEON)
     #define JUMPER_IS_NEON
-#elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX512
-    #define JUMPER_IS_AVX512
+#elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SKX
+    #define JUMPER_IS_SKX
 #elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
     #define JUMPER_IS_HSW
 #elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX
@@ -289,7 +289,175 @@ namespace SK_OPTS_NS {
         }
     }
 
-#elif defined(JUMPER_IS_AVX) || defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#elif defined(JUMPER_IS_SKX)
+    // These are __m512 and __m512i, but friendlier and strongly-typed.
+    template <typename T> using V = T __attribute__((ext_vector_type(16)));
+    using F   = V<float   >;
+    using I32 = V< int32_t>;
+    using U64 = V<uint64_t>;
+    using U32 = V<uint32_t>;
+    using U16 = V<uint16_t>;
+    using U8  = V<uint8_t >;
+
+    SI F   mad(F f, F m, F a)   { return _mm512_fmadd_ps(f,m,a); }
+    SI F   min(F a, F b)        { return _mm512_min_ps(a,b);     }
+    SI F   max(F a, F b)        { return _mm512_max_ps(a,b);     }
+    SI F   abs_  (F v)          { return _mm512_and_ps(v, 0-v);  }
+    SI F   floor_(F v)          { return _mm512_roundscale_ps(v, _MM_FROUND_TO_NEG_INF
+                                                                | _MM_FROUND_NO_EXC); }
+    SI F   rcp   (F v)          { return _mm512_rcp14_ps  (v);   }
+    SI F   rsqrt (F v)          { return _mm512_rsqrt14_ps(v);   }
+    SI F    sqrt_(F v)          { return _mm512_sqrt_ps   (v);   }
+    SI U32 round (F v, F scale) { return _mm512_cvtps_epi32(v*scale); }
+
+    // Clamp negatives to zero first so these saturate just like _mm_packus_epi32/16().
+    SI U16 pack(U32 v) {
+        return _mm512_cvtusepi32_epi16(_mm512_max_epi32(v, _mm512_setzero_si512()));
+    }
+    SI U8 pack(U16 v) {
+        return _mm256_cvtusepi16_epi8(_mm256_max_epi16(v, _mm256_setzero_si256()));
+    }
+
+    SI F if_then_else(I32 c, F t, F e) {
+        return _mm512_mask_blend_ps(_mm512_movepi32_mask(c), e,t);
+    }
+
+    // Tails are handled with mask registers: lanes at or past the tail are neither
+    // read nor written, so we never need to step through them one at a time.
+    SI __mmask16 tail_mask(size_t tail) {
+        return tail ? (__mmask16)((1u << tail) - 1) : (__mmask16)0xffff;
+    }
+
+    SI U8  load_masked(const uint8_t*  p, __mmask16 m) { return    _mm_maskz_loadu_epi8 (m, p); }
+    SI U16 load_masked(const uint16_t* p, __mmask16 m) { return _mm256_maskz_loadu_epi16(m, p); }
+    SI U32 load_masked(const uint32_t* p, __mmask16 m) { return _mm512_maskz_loadu_epi32(m, p); }
+    SI F   load_masked(const float*    p, __mmask16 m) { return _mm512_maskz_loadu_ps   (m, p); }
+
+    SI void store_masked(uint8_t*  p, U8  v, __mmask16 m) {    _mm_mask_storeu_epi8 (p, m, v); }
+    SI void store_masked(uint16_t* p, U16 v, __mmask16 m) { _mm256_mask_storeu_epi16(p, m, v); }
+    SI void store_masked(uint32_t* p, U32 v, __mmask16 m) { _mm512_mask_storeu_epi32(p, m, v); }
+    SI void store_masked(float*    p, F   v, __mmask16 m) { _mm512_mask_storeu_ps   (p, m, v); }
+
+    template <typename T>
+    SI V<T> gather(const T* p, U32 ix) {
+        return { p[ix[ 0]], p[ix[ 1]], p[ix[ 2]], p[ix[ 3]],
+                 p[ix[ 4]], p[ix[ 5]], p[ix[ 6]], p[ix[ 7]],
+                 p[ix[ 8]], p[ix[ 9]], p[ix[10]], p[ix[11]],
+                 p[ix[12]], p[ix[13]], p[ix[14]], p[ix[15]], };
+    }
+    SI F   gather(const float*    p, U32 ix) { return _mm512_i32gather_ps   (ix, p, 4); }
+    SI U32 gather(const uint32_t* p, U32 ix) { return _mm512_i32gather_epi32(ix, p, 4); }
+    SI U64 gather(const uint64_t* p, U32 ix) {
+        __m512i parts[] = {
+            _mm512_i32gather_epi64(_mm512_castsi512_si256 (ix   ), p, 8),
+            _mm512_i32gather_epi64(_mm512_extracti64x4_epi64(ix,1), p, 8),
+        };
+        return bit_cast<U64>(parts);
+    }
+
+    SI __m256i join(__m128i lo, __m128i hi) {
+        return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+    }
+
+    SI void load3(const uint16_t* ptr, size_t tail, U16* r, U16* g, U16* b) {
+        // 16 pixels of 3 channels is 48 uint16_t, one full register of 32 and then 16 more.
+        const size_t n = 3 * (tail ? tail : 16);
+        __mmask32 lo = n >= 32 ? (__mmask32)0xffffffff : (__mmask32)((1u << n) - 1),
+                  hi = n >  32 ? (__mmask32)((1u << (n-32)) - 1) : (__mmask32)0;
+        __m512i _0 = _mm512_maskz_loadu_epi16(lo, ptr +  0),
+                _1 = _mm512_maskz_loadu_epi16(hi, ptr + 32);
+
+        static const uint16_t ix[3][32] = {
+            { 0, 3, 6, 9,12,15,18,21,24,27,30,33,36,39,42,45 },
+            { 1, 4, 7,10,13,16,19,22,25,28,31,34,37,40,43,46 },
+            { 2, 5, 8,11,14,17,20,23,26,29,32,35,38,41,44,47 },
+        };
+        *r = _mm512_castsi512_si256(_mm512_permutex2var_epi16(_0, _mm512_loadu_si512(ix[0]), _1));
+        *g = _mm512_castsi512_si256(_mm512_permutex2var_epi16(_0, _mm512_loadu_si512(ix[1]), _1));
+        *b = _mm512_castsi512_si256(_mm512_permutex2var_epi16(_0, _mm512_loadu_si512(ix[2]), _1));
+    }
+    SI void load4(const uint16_t* ptr, size_t tail, U16* r, U16* g, U16* b, U16* a) {
+        // Each pixel is one 64-bit lane, so 8 pixels per register.
+        __mmask16 m = tail_mask(tail);
+        __m512i _01234567 = _mm512_maskz_loadu_epi64((__mmask8)(m   ), ptr +  0),
+                _89abcdef = _mm512_maskz_loadu_epi64((__mmask8)(m>>8), ptr + 32);
+
+        // _mm512_cvtepi64_epi16() truncates each lane to its bottom 16 bits.
+        *r = join(_mm512_cvtepi64_epi16(                  _01234567     ),
+                  _mm512_cvtepi64_epi16(                  _89abcdef     ));
+        *g = join(_mm512_cvtepi64_epi16(_mm512_srli_epi64(_01234567, 16)),
+                  _mm512_cvtepi64_epi16(_mm512_srli_epi64(_89abcdef, 16)));
+        *b = join(_mm512_cvtepi64_epi16(_mm512_srli_epi64(_01234567, 32)),
+                  _mm512_cvtepi64_epi16(_mm512_srli_epi64(_89abcdef, 32)));
+        *a = join(_mm512_cvtepi64_epi16(_mm512_srli_epi64(_01234567, 48)),
+                  _mm512_cvtepi64_epi16(_mm512_srli_epi64(_89abcdef, 48)));
+    }
+    SI void store4(uint16_t* ptr, size_t tail, U16 r, U16 g, U16 b, U16 a) {
+        auto widen = [](__m128i v, int shift) {
+            return _mm512_sll_epi64(_mm512_cvtepu16_epi64(v), _mm_cvtsi32_si128(shift));
+        };
+        auto lo = [](U16 v) { return _mm256_castsi256_si128   (v   ); };
+        auto hi = [](U16 v) { return _mm256_extracti128_si256(v, 1); };
+
+        __m512i _01234567 = widen(lo(r), 0) | widen(lo(g), 16) | widen(lo(b), 32) | widen(lo(a), 48),
+                _89abcdef = widen(hi(r), 0) | widen(hi(g), 16) | widen(hi(b), 32) | widen(hi(a), 48);
+
+        __mmask16 m = tail_mask(tail);
+        _mm512_mask_storeu_epi64(ptr +  0, (__mmask8)(m   ), _01234567);
+        _mm512_mask_storeu_epi64(ptr + 32, (__mmask8)(m>>8), _89abcdef);
+    }
+
+    // Each register of interleaved floats holds 4 pixels; this masks off those past the tail.
+    SI __mmask16 quad_mask(size_t tail, size_t quad) {
+        size_t n = tail ? tail : 16,
+               k = n > 4*quad ? n - 4*quad : 0;
+        return k >= 4 ? (__mmask16)0xffff : (__mmask16)((1u << 4*k) - 1);
+    }
+
+    SI void load4(const float* ptr, size_t tail, F* r, F* g, F* b, F* a) {
+        F _0123 = _mm512_maskz_loadu_ps(quad_mask(tail,0), ptr+ 0),
+          _4567 = _mm512_maskz_loadu_ps(quad_mask(tail,1), ptr+16),
+          _89ab = _mm512_maskz_loadu_ps(quad_mask(tail,2), ptr+32),
+          _cdef = _mm512_maskz_loadu_ps(quad_mask(tail,3), ptr+48);
+
+        // First split 8 pixels at a time into {r,g} and {b,a} halves...
+        const __m512i rg = _mm512_setr_epi32(0,4, 8,12,16,20,24,28, 1,5, 9,13,17,21,25,29),
+                      ba = _mm512_setr_epi32(2,6,10,14,18,22,26,30, 3,7,11,15,19,23,27,31);
+        F rg01234567 = _mm512_permutex2var_ps(_0123, rg, _4567),  // r0 ... r7 | g0 ... g7
+          ba01234567 = _mm512_permutex2var_ps(_0123, ba, _4567),  // b0 ... b7 | a0 ... a7
+          rg89abcdef = _mm512_permutex2var_ps(_89ab, rg, _cdef),  // r8 ... rf | g8 ... gf
+          ba89abcdef = _mm512_permutex2var_ps(_89ab, ba, _cdef);  // b8 ... bf | a8 ... af
+
+        // ... then join those halves up into whole channels.
+        const __m512i lo = _mm512_setr_epi32(0,1,2,3,4,5,6,7, 16,17,18,19,20,21,22,23),
+                      hi = _mm512_setr_epi32(8,9,10,11,12,13,14,15, 24,25,26,27,28,29,30,31);
+        *r = _mm512_permutex2var_ps(rg01234567, lo, rg89abcdef);
+        *g = _mm512_permutex2var_ps(rg01234567, hi, rg89abcdef);
+        *b = _mm512_permutex2var_ps(ba01234567, lo, ba89abcdef);
+        *a = _mm512_permutex2var_ps(ba01234567, hi, ba89abcdef);
+    }
+    SI void store4(float* ptr, size_t tail, F r, F g, F b, F a) {
+        const __m512i lo = _mm512_setr_epi32(0,1,2,3,4,5,6,7, 16,17,18,19,20,21,22,23),
+                      hi = _mm512_setr_epi32(8,9,10,11,12,13,14,15, 24,25,26,27,28,29,30,31);
+        F rg01234567 = _mm512_permutex2var_ps(r, lo, g),  // r0 ... r7 | g0 ... g7
+          rg89abcdef = _mm512_permutex2var_ps(r, hi, g),  // r8 ... rf | g8 ... gf
+          ba01234567 = _mm512_permutex2var_ps(b, lo, a),  // b0 ... b7 | a0 ... a7
+          ba89abcdef = _mm512_permutex2var_ps(b, hi, a);  // b8 ... bf | a8 ... af
+
+        const __m512i q0 = _mm512_setr_epi32(0, 8,16,24, 1, 9,17,25, 2,10,18,26, 3,11,19,27),
+                      q1 = _mm512_setr_epi32(4,12,20,28, 5,13,21,29, 6,14,22,30, 7,15,23,31);
+        F _0123 = _mm512_permutex2var_ps(rg01234567, q0, ba01234567),  // r0 g0 b0 a0 r1 ...
+          _4567 = _mm512_permutex2var_ps(rg01234567, q1, ba01234567),
+          _89ab = _mm512_permutex2var_ps(rg89abcdef, q0, ba89abcdef),
+          _cdef = _mm512_permutex2var_ps(rg89abcdef, q1, ba89abcdef);
+
+        _mm512_mask_storeu_ps(ptr+ 0, quad_mask(tail,0), _0123);
+        _mm512_mask_storeu_ps(ptr+16, quad_mask(tail,1), _4567);
+        _mm512_mask_storeu_ps(ptr+32, quad_mask(tail,2), _89ab);
+        _mm512_mask_storeu_ps(ptr+48, quad_mask(tail,3), _cdef);
+    }
+
+#elif defined(JUMPER_IS_AVX) || defined(JUMPER_IS_HSW)
     // These are __m256 and __m256i, but friendlier and strongly-typed.
     template <typename T> using V = T __attribute__((ext_vector_type(8)));
     using F   = V<float   >;
@@ -300,7 +468,7 @@ namespace SK_OPTS_NS {
     using U8  = V<uint8_t >;
 
     SI F mad(F f, F m, F a)  {
-    #if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+    #if defined(JUMPER_IS_HSW)
         return _mm256_fmadd_ps(f,m,a);
     #else
         return f*m+a;
@@ -332,7 +500,7 @@ namespace SK_OPTS_NS {
         return { p[ix[0]], p[ix[1]], p[ix[2]], p[ix[3]],
                  p[ix[4]], p[ix[5]], p[ix[6]], p[ix[7]], };
     }
-    #if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+    #if defined(JUMPER_IS_HSW)
         SI F   gather(const float*    p, U32 ix) { return _mm256_i32gather_ps   (p, ix, 4); }
         SI U32 gather(const uint32_t* p, U32 ix) { return _mm256_i32gather_epi32(p, ix, 4); }
         SI U64 gather(const uint64_t* p, U32 ix) {
@@ -732,7 +900,10 @@ SI F from_half(U16 h) {
 #if defined(SK_CPU_ARM64) && !defined(SK_BUILD_FOR_GOOGLE3)  // Temporary workaround for some Google3 builds.
     return vcvt_f32_f16(h);
 
-#elif defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#elif defined(JUMPER_IS_SKX)
+    return _mm512_cvtph_ps(h);
+
+#elif defined(JUMPER_IS_HSW)
     return _mm256_cvtph_ps(h);
 
 #else
@@ -752,7 +923,10 @@ SI U16 to_half(F f) {
 #if defined(SK_CPU_ARM64) && !defined(SK_BUILD_FOR_GOOGLE3)  // Temporary workaround for some Google3 builds.
     return vcvt_f16_f32(f);
 
-#elif defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#elif defined(JUMPER_IS_SKX)
+    return _mm512_cvtps_ph(f, _MM_FROUND_CUR_DIRECTION);
+
+#elif defined(JUMPER_IS_HSW)
     return _mm256_cvtps_ph(f, _MM_FROUND_CUR_DIRECTION);
 
 #else
@@ -887,7 +1061,11 @@ static void start_pipeline(size_t dx, size_t dy, size_t xlimit, size_t ylimit, v
 
 template <typename V, typename T>
 SI V load(const T* src, size_t tail) {
-#if !defined(JUMPER_IS_SCALAR)
+#if defined(JUMPER_IS_SKX)
+    if (__builtin_expect(tail, 0)) {
+        return load_masked(src, tail_mask(tail));
+    }
+#elif !defined(JUMPER_IS_SCALAR)
     __builtin_assume(tail < N);
     if (__builtin_expect(tail, 0)) {
         V v{};  // Any inactive lanes are zeroed.
@@ -908,7 +1086,12 @@ SI V load(const T* src, size_t tail) {
 
 template <typename V, typename T>
 SI void store(T* dst, V v, size_t tail) {
-#if !defined(JUMPER_IS_SCALAR)
+#if defined(JUMPER_IS_SKX)
+    if (__builtin_expect(tail, 0)) {
+        store_masked(dst, v, tail_mask(tail));
+        return;
+    }
+#elif !defined(JUMPER_IS_SCALAR)
     __builtin_assume(tail < N);
     if (__builtin_expect(tail, 0)) {
         switch (tail) {
@@ -994,11 +1177,13 @@ SI I32 cond_to_mask(I32 cond) { return if_then_else(cond, I32(~0), I32(0)); }
 
 // Now finally, normal Stages!
 
+// The centers of the pixels in a run, relative to dx.
+static const float iota[] = {
+    0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f,
+    8.5f, 9.5f,10.5f,11.5f,12.5f,13.5f,14.5f,15.5f,
+};
+
 STAGE(seed_shader, Ctx::None) {
-    static const float iota[] = {
-        0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f,
-        8.5f, 9.5f,10.5f,11.5f,12.5f,13.5f,14.5f,15.5f,
-    };
     // It's important for speed to explicitly cast(dx) and cast(dy),
     // which has the effect of splatting them to vectors before converting to floats.
     // On Intel this breaks a data dependency on previous loop iterations' registers.
@@ -1011,7 +1196,7 @@ STAGE(seed_shader, Ctx::None) {
 
 STAGE(dither, const float* rate) {
     // Get [(dx,dy), (dx+1,dy), (dx+2,dy), ...] loaded up in integer vectors.
-    uint32_t iota[] = {0,1,2,3,4,5,6,7};
+    uint32_t iota[] = {0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15};
     U32 X = dx + unaligned_load<U32>(iota),
         Y = dy;
 
@@ -1573,6 +1758,18 @@ STAGE(gamma, const float* G) {
     b = fn(b);
 }
 
+STAGE(tf_table, const SkRasterPipeline_TFTableCtx* ctx) {
+    // Sampling evenly in sqrt(x) keeps the steep ends of gamma curves accurate.
+    auto fn = [&](F v) {
+        F u = sqrt_(min(max(v, 0), 1)) * (float)(ctx->size - 1);
+        U32 ix = trunc_(u);
+        return lerp(gather(ctx->table, ix), gather(ctx->table, ix + 1), u - cast(ix));
+    };
+    r = fn(r);
+    g = fn(g);
+    b = fn(b);
+}
+
 STAGE(from_srgb, Ctx::None) {
     auto fn = [](F s) {
         U32 sign;
@@ -1590,7 +1787,7 @@ STAGE(to_srgb, Ctx::None) {
         U32 sign;
         l = strip_sign(l, &sign);
         // We tweak c and d for each instruction set to make sure fn(1) is exactly 1.
-    #if defined(JUMPER_IS_AVX512)
+    #if defined(JUMPER_IS_SKX)
         const float c = 1.130026340485f,
                     d = 0.141387879848f;
     #elif defined(JUMPER_IS_SSE2) || defined(JUMPER_IS_SSE41) || \
@@ -1933,7 +2130,18 @@ STAGE(matrix_perspective, const float* m) {
 SI void gradient_lookup(const SkRasterPipeline_GradientCtx* c, U32 idx, F t,
                         F* r, F* g, F* b, F* a) {
     F fr, br, fg, bg, fb, bb, fa, ba;
-#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#if defined(JUMPER_IS_SKX)
+    if (c->stopCount <= 16) {
+        fr = _mm512_permutexvar_ps(idx, _mm512_loadu_ps(c->fs[0]));
+        br = _mm512_permutexvar_ps(idx, _mm512_loadu_ps(c->bs[0]));
+        fg = _mm512_permutexvar_ps(idx, _mm512_loadu_ps(c->fs[1]));
+        bg = _mm512_permutexvar_ps(idx, _mm512_loadu_ps(c->bs[1]));
+        fb = _mm512_permutexvar_ps(idx, _mm512_loadu_ps(c->fs[2]));
+        bb = _mm512_permutexvar_ps(idx, _mm512_loadu_ps(c->bs[2]));
+        fa = _mm512_permutexvar_ps(idx, _mm512_loadu_ps(c->fs[3]));
+        ba = _mm512_permutexvar_ps(idx, _mm512_loadu_ps(c->bs[3]));
+    } else
+#elif defined(JUMPER_IS_HSW)
     if (c->stopCount <=8) {
         fr = _mm256_permutevar8x32_ps(_mm256_loadu_ps(c->fs[0]), idx);
         br = _mm256_permutevar8x32_ps(_mm256_loadu_ps(c->bs[0]), idx);
@@ -1980,6 +2188,19 @@ STAGE(gradient, const SkRasterPipeline_GradientCtx* c) {
     gradient_lookup(c, idx, t, &r, &g, &b, &a);
 }
 
+STAGE(gradient_lut, const SkRasterPipeline_GradientLUTCtx* c) {
+    F u = clamp_01(r) * (float)(c->size - 1);
+    U32 ix = trunc_(u);
+    F t = u - cast(ix);
+    auto lookup = [&](int ch) {
+        return lerp(gather(c->rgba, 4*ix + ch), gather(c->rgba, 4*ix + (4 + ch)), t);
+    };
+    r = lookup(0);
+    g = lookup(1);
+    b = lookup(2);
+    a = lookup(3);
+}
+
 STAGE(evenly_spaced_2_stop_gradient, const void* ctx) {
     // TODO: Rename Ctx SkRasterPipeline_EvenlySpaced2StopGradientCtx.
     struct Ctx { float f[4], b[4]; };
@@ -1992,6 +2213,19 @@ STAGE(evenly_spaced_2_stop_gradient, const void* ctx) {
     a = mad(t, c->f[3], c->b[3]);
 }
 
+STAGE(linear_2_stop_gradient, const SkRasterPipeline_Linear2StopGradientCtx* c) {
+    // Same math, in the same order, as seed_shader, matrix_2x3, clamp_x_1 and
+    // evenly_spaced_2_stop_gradient.
+    F x = cast(dx) + unaligned_load<F>(iota),
+      y = cast(dy) + 0.5f;
+    F t = clamp_01(mad(x,c->tx, mad(y,c->ty, c->t0)));
+    r = mad(t, c->stops.f[0], c->stops.b[0]);
+    g = mad(t, c->stops.f[1], c->stops.b[1]);
+    b = mad(t, c->stops.f[2], c->stops.b[2]);
+    a = mad(t, c->stops.f[3], c->stops.b[3]);
+    dr = dg = db = da = 0;
+}
+
 STAGE(xy_to_unit_angle, Ctx::None) {
     F X = r,
       Y = g;
@@ -2270,7 +2504,7 @@ namespace lowp {
 
 #else  // We are compiling vector code with Clang... let's make some lowp stages!
 
-#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
     using U8  = uint8_t  __attribute__((ext_vector_type(16)));
     using U16 = uint16_t __attribute__((ext_vector_type(16)));
     using I16 =  int16_t __attribute__((ext_vector_type(16)));
@@ -2504,7 +2738,7 @@ SI F mad(F f, F m, F a) { return f*m+a; }
 SI U32 trunc_(F x) { return (U32)cast<I32>(x); }
 
 SI F rcp(F x) {
-#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
     __m256 lo,hi;
     split(x, &lo,&hi);
     return join<F>(_mm256_rcp_ps(lo), _mm256_rcp_ps(hi));
@@ -2525,7 +2759,7 @@ SI F rcp(F x) {
 #endif
 }
 SI F sqrt_(F x) {
-#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
     __m256 lo,hi;
     split(x, &lo,&hi);
     return join<F>(_mm256_sqrt_ps(lo), _mm256_sqrt_ps(hi));
@@ -2560,7 +2794,7 @@ SI F floor_(F x) {
     float32x4_t lo,hi;
     split(x, &lo,&hi);
     return join<F>(vrndmq_f32(lo), vrndmq_f32(hi));
-#elif defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#elif defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
     __m256 lo,hi;
     split(x, &lo,&hi);
     return join<F>(_mm256_floor_ps(lo), _mm256_floor_ps(hi));
@@ -2579,10 +2813,6 @@ SI F abs_(F x) { return bit_cast<F>( bit_cast<I32>(x) & 0x7fffffff ); }
 // ~~~~~~ Basic / misc. stages ~~~~~~ //
 
 STAGE_GG(seed_shader, Ctx::None) {
-    static const float iota[] = {
-        0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f,
-        8.5f, 9.5f,10.5f,11.5f,12.5f,13.5f,14.5f,15.5f,
-    };
     x = cast<F>(I32(dx)) + unaligned_load<F>(iota);
     y = cast<F>(I32(dy)) + 0.5f;
 }
@@ -2654,6 +2884,15 @@ STAGE_PP(premul_dst, Ctx::None) {
     dg = div255(dg * da);
     db = div255(db * da);
 }
+STAGE_PP(unpremul, Ctx::None) {
+    // Within 0.5/255 of the float unpremul of the same 8-bit values.  Alpha 0 unpremuls to 0.
+    F A = cast<F>(a),
+      scale = if_then_else(A == 0, F(0), 255.0f / A);
+    auto unpremul = [&](U16 c) { return cast<U16>(min(cast<F>(c) * scale, 255) + 0.5f); };
+    r = unpremul(r);
+    g = unpremul(g);
+    b = unpremul(b);
+}
 
 STAGE_PP(force_opaque    , Ctx::None) {  a = 255; }
 STAGE_PP(force_opaque_dst, Ctx::None) { da = 255; }
@@ -2763,7 +3002,7 @@ SI V load(const T* ptr, size_t tail) {
     V v = 0;
     switch (tail & (N-1)) {
         case  0: memcpy(&v, ptr, sizeof(v)); break;
-    #if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+    #if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
         case 15: v[14] = ptr[14];
         case 14: v[13] = ptr[13];
         case 13: v[12] = ptr[12];
@@ -2787,7 +3026,7 @@ template <typename V, typename T>
 SI void store(T* ptr, size_t tail, V v) {
     switch (tail & (N-1)) {
         case  0: memcpy(ptr, &v, sizeof(v)); break;
-    #if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+    #if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
         case 15: ptr[14] = v[14];
         case 14: ptr[13] = v[13];
         case 13: ptr[12] = v[12];
@@ -2807,7 +3046,7 @@ SI void store(T* ptr, size_t tail, V v) {
     }
 }
 
-#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
     template <typename V, typename T>
     SI V gather(const T* ptr, U32 ix) {
         return V{ ptr[ix[ 0]], ptr[ix[ 1]], ptr[ix[ 2]], ptr[ix[ 3]],
@@ -2845,7 +3084,7 @@ SI void store(T* ptr, size_t tail, V v) {
 // ~~~~~~ 32-bit memory loads and stores ~~~~~~ //
 
 SI void from_8888(U32 rgba, U16* r, U16* g, U16* b, U16* a) {
-#if 1 && defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#if 1 && defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
     // Swap the middle 128-bit lanes to make _mm256_packus_epi32() in cast_U16() work out nicely.
     __m256i _01,_23;
     split(rgba, &_01, &_23);
@@ -3060,6 +3299,24 @@ STAGE_PP(luminance_to_alpha, Ctx::None) {
     r = g = b = 0;
 }
 
+STAGE_PP(matrix_4x5, const float* m) {
+    // Each channel is computed in float from the 8-bit values, then rounded once, so it's within
+    // 0.5/255 of the float stage's result.  Results are saturated to [0,255]; the float stage
+    // leaves that to clamp_0 and clamp_1, which are no-ops in lowp.
+    F R = cast<F>(r),
+      G = cast<F>(g),
+      B = cast<F>(b),
+      A = cast<F>(a);
+    auto channel = [&](int i) {
+        F v = mad(R,m[i], mad(G,m[4+i], mad(B,m[8+i], mad(A,m[12+i], m[16+i] * 255.0f))));
+        return cast<U16>(min(max(0, v), 255) + 0.5f);
+    };
+    r = channel(0);
+    g = channel(1);
+    b = channel(2);
+    a = channel(3);
+}
+
 // ~~~~~~ Coverage scales / lerps ~~~~~~ //
 
 STAGE_PP(scale_1_float, const float* f) {
@@ -3141,6 +3398,21 @@ STAGE_GG(mirror_x_1, Ctx::None) {
     x = clamp_01(abs_( (x-1.0f) - two(floor_((x-1.0f)*0.5f)) - 1.0f ));
 }
 
+// Tile x or y to [0,limit), using the same float math as the highp stages so that repeat and
+// mirror tiled images sample the same pixels whichever pipeline they land in.
+SI F exclusive_repeat(F v, const SkRasterPipeline_TileCtx* ctx) {
+    return v - floor_(v*ctx->invScale)*ctx->scale;
+}
+SI F exclusive_mirror(F v, const SkRasterPipeline_TileCtx* ctx) {
+    auto limit = ctx->scale;
+    auto invLimit = ctx->invScale;
+    return abs_( (v-limit) - (limit+limit)*floor_((v-limit)*(invLimit*0.5f)) - limit );
+}
+STAGE_GG(repeat_x, const SkRasterPipeline_TileCtx* ctx) { x = exclusive_repeat(x, ctx); }
+STAGE_GG(repeat_y, const SkRasterPipeline_TileCtx* ctx) { y = exclusive_repeat(y, ctx); }
+STAGE_GG(mirror_x, const SkRasterPipeline_TileCtx* ctx) { x = exclusive_mirror(x, ctx); }
+STAGE_GG(mirror_y, const SkRasterPipeline_TileCtx* ctx) { y = exclusive_mirror(y, ctx); }
+
 SI I16 cond_to_mask_16(I32 cond) { return cast<I16>(cond); }
 
 STAGE_GG(decal_x, SkRasterPipeline_DecalTileCtx* ctx) {
@@ -3180,7 +3452,7 @@ SI void gradient_lookup(const SkRasterPipeline_GradientCtx* c, U32 idx, F t,
                         U16* r, U16* g, U16* b, U16* a) {
 
     F fr, fg, fb, fa, br, bg, bb, ba;
-#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
     if (c->stopCount <=8) {
         __m256i lo, hi;
         split(idx, &lo, &hi);
@@ -3239,6 +3511,19 @@ STAGE_GP(evenly_spaced_gradient, const SkRasterPipeline_GradientCtx* c) {
     gradient_lookup(c, idx, t, &r, &g, &b, &a);
 }
 
+STAGE_GP(gradient_lut, const SkRasterPipeline_GradientLUTCtx* c) {
+    F u = clamp_01(x) * (float)(c->size - 1);
+    U32 ix = trunc_(u);
+    F t = u - cast<F>(ix);
+    auto lookup = [&](int ch) {
+        F lo = gather<F>(c->rgba, 4*ix + ch),
+          hi = gather<F>(c->rgba, 4*ix + (4 + ch));
+        return mad(t, hi - lo, lo);
+    };
+    round_F_to_U16(lookup(0), lookup(1), lookup(2), lookup(3), c->interpolatedInPremul,
+                   &r,&g,&b,&a);
+}
+
 STAGE_GP(evenly_spaced_2_stop_gradient, const SkRasterPipeline_EvenlySpaced2StopGradientCtx* c) {
     auto t = x;
     round_F_to_U16(mad(t, c->f[0], c->b[0]),
@@ -3249,6 +3534,18 @@ STAGE_GP(evenly_spaced_2_stop_gradient, const SkRasterPipeline_EvenlySpaced2Stop
                    &r,&g,&b,&a);
 }
 
+STAGE_GP(linear_2_stop_gradient, const SkRasterPipeline_Linear2StopGradientCtx* c) {
+    x = cast<F>(I32(dx)) + unaligned_load<F>(iota);
+    y = cast<F>(I32(dy)) + 0.5f;
+    F t = clamp_01(mad(x,c->tx, mad(y,c->ty, c->t0)));
+    round_F_to_U16(mad(t, c->stops.f[0], c->stops.b[0]),
+                   mad(t, c->stops.f[1], c->stops.b[1]),
+                   mad(t, c->stops.f[2], c->stops.b[2]),
+                   mad(t, c->stops.f[3], c->stops.b[3]),
+                   c->stops.interpolatedInPremul,
+                   &r,&g,&b,&a);
+}
+
 STAGE_GG(xy_to_unit_angle, Ctx::None) {
     F xabs = abs_(x),
       yabs = abs_(y);
@@ -3366,7 +3663,6 @@ STAGE_GP(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
     NOT_IMPLEMENTED(store_dst)
     NOT_IMPLEMENTED(unbounded_set_rgb)
     NOT_IMPLEMENTED(unbounded_uniform_color)
-    NOT_IMPLEMENTED(unpremul)
     NOT_IMPLEMENTED(dither)  // TODO
     NOT_IMPLEMENTED(from_srgb)
     NOT_IMPLEMENTED(to_srgb)
@@ -3393,17 +3689,13 @@ STAGE_GP(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
     NOT_IMPLEMENTED(luminosity)
     NOT_IMPLEMENTED(matrix_3x3)
     NOT_IMPLEMENTED(matrix_3x4)
-    NOT_IMPLEMENTED(matrix_4x5)  // TODO
     NOT_IMPLEMENTED(matrix_4x3)  // TODO
     NOT_IMPLEMENTED(parametric)
     NOT_IMPLEMENTED(gamma)
+    NOT_IMPLEMENTED(tf_table)
     NOT_IMPLEMENTED(rgb_to_hsl)
     NOT_IMPLEMENTED(hsl_to_rgb)
     NOT_IMPLEMENTED(gauss_a_to_rgba)  // TODO
-    NOT_IMPLEMENTED(mirror_x)         // TODO
-    NOT_IMPLEMENTED(repeat_x)         // TODO
-    NOT_IMPLEMENTED(mirror_y)         // TODO
-    NOT_IMPLEMENTED(repeat_y)         // TODO
     NOT_IMPLEMENTED(negate_x)
     NOT_IMPLEMENTED(bilinear_nx)      // TODO
     NOT_IMPLEMENTED(bilinear_ny)      // TODO
@@ -7,7 +7,9 @@
 #include "SkAddIntersections.h"
 #include "SkOpCoincidence.h"
 #include "SkPathOpsBounds.h"
+#include "SkTSort.h"
 
+#include <cfloat>
 #include <utility>
 
 #if DEBUG_ADD_INTERSECTING_TS
@@ -256,323 +258,433 @@ static void debugShowCubicIntersection(int , const SkIntersectionHelper& ,
 }
 #endif
 
-bool AddIntersectTs(SkOpContour* test, SkOpContour* next, SkOpCoincidence* coincidence) {
-    if (test != next) {
-        if (AlmostLessUlps(test->bounds().fBottom, next->bounds().fTop)) {
-            return false;
-        }
-        // OPTIMIZATION: outset contour bounds a smidgen instead?
-        if (!SkPathOpsBounds::Intersects(test->bounds(), next->bounds())) {
-            return true;
-        }
-    }
-    SkIntersectionHelper wt;
-    wt.init(test);
-    do {
-        SkIntersectionHelper wn;
-        wn.init(next);
-        test->debugValidate();
-        next->debugValidate();
-        if (test == next && !wn.startAfter(wt)) {
-            continue;
-        }
-        do {
-            if (!SkPathOpsBounds::Intersects(wt.bounds(), wn.bounds())) {
-                continue;
+// Finds and records the intersections between the segments wt and wn, whose bounds overlap.
+static void intersect_segments(const SkIntersectionHelper& wt, const SkIntersectionHelper& wn,
+                               SkOpContour* test, SkOpCoincidence* coincidence) {
+    int pts = 0;
+    SkIntersections ts { SkDEBUGCODE(test->globalState()) };
+    bool swap = false;
+    SkDQuad quad1, quad2;
+    SkDConic conic1, conic2;
+    SkDCubic cubic1, cubic2;
+    switch (wt.segmentType()) {
+        case SkIntersectionHelper::kHorizontalLine_Segment:
+            swap = true;
+            switch (wn.segmentType()) {
+                case SkIntersectionHelper::kHorizontalLine_Segment:
+                case SkIntersectionHelper::kVerticalLine_Segment:
+                case SkIntersectionHelper::kLine_Segment:
+                    pts = ts.lineHorizontal(wn.pts(), wt.left(),
+                            wt.right(), wt.y(), wt.xFlipped());
+                    debugShowLineIntersection(pts, wn, wt, ts);
+                    break;
+                case SkIntersectionHelper::kQuad_Segment:
+                    pts = ts.quadHorizontal(wn.pts(), wt.left(),
+                            wt.right(), wt.y(), wt.xFlipped());
+                    debugShowQuadLineIntersection(pts, wn, wt, ts);
+                    break;
+                case SkIntersectionHelper::kConic_Segment:
+                    pts = ts.conicHorizontal(wn.pts(), wn.weight(), wt.left(),
+                            wt.right(), wt.y(), wt.xFlipped());
+                    debugShowConicLineIntersection(pts, wn, wt, ts);
+                    break;
+                case SkIntersectionHelper::kCubic_Segment:
+                    pts = ts.cubicHorizontal(wn.pts(), wt.left(),
+                            wt.right(), wt.y(), wt.xFlipped());
+                    debugShowCubicLineIntersection(pts, wn, wt, ts);
+                    break;
+                default:
+                    SkASSERT(0);
             }
-            int pts = 0;
-            SkIntersections ts { SkDEBUGCODE(test->globalState()) };
-            bool swap = false;
-            SkDQuad quad1, quad2;
-            SkDConic conic1, conic2;
-            SkDCubic cubic1, cubic2;
-            switch (wt.segmentType()) {
+            break;
+        case SkIntersectionHelper::kVerticalLine_Segment:
+            swap = true;
+            switch (wn.segmentType()) {
                 case SkIntersectionHelper::kHorizontalLine_Segment:
-                    swap = true;
-                    switch (wn.segmentType()) {
-                        case SkIntersectionHelper::kHorizontalLine_Segment:
-                        case SkIntersectionHelper::kVerticalLine_Segment:
-                        case SkIntersectionHelper::kLine_Segment:
-                            pts = ts.lineHorizontal(wn.pts(), wt.left(),
-                                    wt.right(), wt.y(), wt.xFlipped());
-                            debugShowLineIntersection(pts, wn, wt, ts);
-                            break;
-                        case SkIntersectionHelper::kQuad_Segment:
-                            pts = ts.quadHorizontal(wn.pts(), wt.left(),
-                                    wt.right(), wt.y(), wt.xFlipped());
-                            debugShowQuadLineIntersection(pts, wn, wt, ts);
-                            break;
-                        case SkIntersectionHelper::kConic_Segment:
-                            pts = ts.conicHorizontal(wn.pts(), wn.weight(), wt.left(),
-                                    wt.right(), wt.y(), wt.xFlipped());
-                            debugShowConicLineIntersection(pts, wn, wt, ts);
-                            break;
-                        case SkIntersectionHelper::kCubic_Segment:
-                            pts = ts.cubicHorizontal(wn.pts(), wt.left(),
-                                    wt.right(), wt.y(), wt.xFlipped());
-                            debugShowCubicLineIntersection(pts, wn, wt, ts);
-                            break;
-                        default:
-                            SkASSERT(0);
-                    }
+                case SkIntersectionHelper::kVerticalLine_Segment:
+                case SkIntersectionHelper::kLine_Segment: {
+                    pts = ts.lineVertical(wn.pts(), wt.top(),
+                            wt.bottom(), wt.x(), wt.yFlipped());
+                    debugShowLineIntersection(pts, wn, wt, ts);
+                    break;
+                }
+                case SkIntersectionHelper::kQuad_Segment: {
+                    pts = ts.quadVertical(wn.pts(), wt.top(),
+                            wt.bottom(), wt.x(), wt.yFlipped());
+                    debugShowQuadLineIntersection(pts, wn, wt, ts);
+                    break;
+                }
+                case SkIntersectionHelper::kConic_Segment: {
+                    pts = ts.conicVertical(wn.pts(), wn.weight(), wt.top(),
+                            wt.bottom(), wt.x(), wt.yFlipped());
+                    debugShowConicLineIntersection(pts, wn, wt, ts);
+                    break;
+                }
+                case SkIntersectionHelper::kCubic_Segment: {
+                    pts = ts.cubicVertical(wn.pts(), wt.top(),
+                            wt.bottom(), wt.x(), wt.yFlipped());
+                    debugShowCubicLineIntersection(pts, wn, wt, ts);
+                    break;
+                }
+                default:
+                    SkASSERT(0);
+            }
+            break;
+        case SkIntersectionHelper::kLine_Segment:
+            switch (wn.segmentType()) {
+                case SkIntersectionHelper::kHorizontalLine_Segment:
+                    pts = ts.lineHorizontal(wt.pts(), wn.left(),
+                            wn.right(), wn.y(), wn.xFlipped());
+                    debugShowLineIntersection(pts, wt, wn, ts);
                     break;
                 case SkIntersectionHelper::kVerticalLine_Segment:
-                    swap = true;
-                    switch (wn.segmentType()) {
-                        case SkIntersectionHelper::kHorizontalLine_Segment:
-                        case SkIntersectionHelper::kVerticalLine_Segment:
-                        case SkIntersectionHelper::kLine_Segment: {
-                            pts = ts.lineVertical(wn.pts(), wt.top(),
-                                    wt.bottom(), wt.x(), wt.yFlipped());
-                            debugShowLineIntersection(pts, wn, wt, ts);
-                            break;
-                        }
-                        case SkIntersectionHelper::kQuad_Segment: {
-                            pts = ts.quadVertical(wn.pts(), wt.top(),
-                                    wt.bottom(), wt.x(), wt.yFlipped());
-                            debugShowQuadLineIntersection(pts, wn, wt, ts);
-                            break;
-                        }
-                        case SkIntersectionHelper::kConic_Segment: {
-                            pts = ts.conicVertical(wn.pts(), wn.weight(), wt.top(),
-                                    wt.bottom(), wt.x(), wt.yFlipped());
-                            debugShowConicLineIntersection(pts, wn, wt, ts);
-                            break;
-                        }
-                        case SkIntersectionHelper::kCubic_Segment: {
-                            pts = ts.cubicVertical(wn.pts(), wt.top(),
-                                    wt.bottom(), wt.x(), wt.yFlipped());
-                            debugShowCubicLineIntersection(pts, wn, wt, ts);
-                            break;
-                        }
-                        default:
-                            SkASSERT(0);
-                    }
+                    pts = ts.lineVertical(wt.pts(), wn.top(),
+                            wn.bottom(), wn.x(), wn.yFlipped());
+                    debugShowLineIntersection(pts, wt, wn, ts);
                     break;
                 case SkIntersectionHelper::kLine_Segment:
-                    switch (wn.segmentType()) {
-                        case SkIntersectionHelper::kHorizontalLine_Segment:
-                            pts = ts.lineHorizontal(wt.pts(), wn.left(),
-                                    wn.right(), wn.y(), wn.xFlipped());
-                            debugShowLineIntersection(pts, wt, wn, ts);
-                            break;
-                        case SkIntersectionHelper::kVerticalLine_Segment:
-                            pts = ts.lineVertical(wt.pts(), wn.top(),
-                                    wn.bottom(), wn.x(), wn.yFlipped());
-                            debugShowLineIntersection(pts, wt, wn, ts);
-                            break;
-                        case SkIntersectionHelper::kLine_Segment:
-                            pts = ts.lineLine(wt.pts(), wn.pts());
-                            debugShowLineIntersection(pts, wt, wn, ts);
-                            break;
-                        case SkIntersectionHelper::kQuad_Segment:
-                            swap = true;
-                            pts = ts.quadLine(wn.pts(), wt.pts());
-                            debugShowQuadLineIntersection(pts, wn, wt, ts);
-                            break;
-                        case SkIntersectionHelper::kConic_Segment:
-                            swap = true;
-                            pts = ts.conicLine(wn.pts(), wn.weight(), wt.pts());
-                            debugShowConicLineIntersection(pts, wn, wt, ts);
-                            break;
-                        case SkIntersectionHelper::kCubic_Segment:
-                            swap = true;
-                            pts = ts.cubicLine(wn.pts(), wt.pts());
-                            debugShowCubicLineIntersection(pts, wn, wt, ts);
-                            break;
-                        default:
-                            SkASSERT(0);
-                    }
+                    pts = ts.lineLine(wt.pts(), wn.pts());
+                    debugShowLineIntersection(pts, wt, wn, ts);
                     break;
                 case SkIntersectionHelper::kQuad_Segment:
-                    switch (wn.segmentType()) {
-                        case SkIntersectionHelper::kHorizontalLine_Segment:
-                            pts = ts.quadHorizontal(wt.pts(), wn.left(),
-                                    wn.right(), wn.y(), wn.xFlipped());
-                            debugShowQuadLineIntersection(pts, wt, wn, ts);
-                            break;
-                        case SkIntersectionHelper::kVerticalLine_Segment:
-                            pts = ts.quadVertical(wt.pts(), wn.top(),
-                                    wn.bottom(), wn.x(), wn.yFlipped());
-                            debugShowQuadLineIntersection(pts, wt, wn, ts);
-                            break;
-                        case SkIntersectionHelper::kLine_Segment:
-                            pts = ts.quadLine(wt.pts(), wn.pts());
-                            debugShowQuadLineIntersection(pts, wt, wn, ts);
-                            break;
-                        case SkIntersectionHelper::kQuad_Segment: {
-                            pts = ts.intersect(quad1.set(wt.pts()), quad2.set(wn.pts()));
-                            debugShowQuadIntersection(pts, wt, wn, ts);
-                            break;
-                        }
-                        case SkIntersectionHelper::kConic_Segment: {
-                            swap = true;
-                            pts = ts.intersect(conic2.set(wn.pts(), wn.weight()),
-                                    quad1.set(wt.pts()));
-                            debugShowConicQuadIntersection(pts, wn, wt, ts);
-                            break;
-                        }
-                        case SkIntersectionHelper::kCubic_Segment: {
-                            swap = true;
-                            pts = ts.intersect(cubic2.set(wn.pts()), quad1.set(wt.pts()));
-                            debugShowCubicQuadIntersection(pts, wn, wt, ts);
-                            break;
-                        }
-                        default:
-                            SkASSERT(0);
-                    }
+                    swap = true;
+                    pts = ts.quadLine(wn.pts(), wt.pts());
+                    debugShowQuadLineIntersection(pts, wn, wt, ts);
                     break;
                 case SkIntersectionHelper::kConic_Segment:
-                    switch (wn.segmentType()) {
-                        case SkIntersectionHelper::kHorizontalLine_Segment:
-                            pts = ts.conicHorizontal(wt.pts(), wt.weight(), wn.left(),
-                                    wn.right(), wn.y(), wn.xFlipped());
-                            debugShowConicLineIntersection(pts, wt, wn, ts);
-                            break;
-                        case SkIntersectionHelper::kVerticalLine_Segment:
-                            pts = ts.conicVertical(wt.pts(), wt.weight(), wn.top(),
-                                    wn.bottom(), wn.x(), wn.yFlipped());
-                            debugShowConicLineIntersection(pts, wt, wn, ts);
-                            break;
-                        case SkIntersectionHelper::kLine_Segment:
-                            pts = ts.conicLine(wt.pts(), wt.weight(), wn.pts());
-                            debugShowConicLineIntersection(pts, wt, wn, ts);
-                            break;
-                        case SkIntersectionHelper::kQuad_Segment: {
-                            pts = ts.intersect(conic1.set(wt.pts(), wt.weight()),
-                                    quad2.set(wn.pts()));
-                            debugShowConicQuadIntersection(pts, wt, wn, ts);
-                            break;
-                        }
-                        case SkIntersectionHelper::kConic_Segment: {
-                            pts = ts.intersect(conic1.set(wt.pts(), wt.weight()),
-                                    conic2.set(wn.pts(), wn.weight()));
-                            debugShowConicIntersection(pts, wt, wn, ts);
-                            break;
-                        }
-                        case SkIntersectionHelper::kCubic_Segment: {
-                            swap = true;
-                            pts = ts.intersect(cubic2.set(wn.pts()
-                                    SkDEBUGPARAMS(ts.globalState())),
-                                    conic1.set(wt.pts(), wt.weight()
-                                    SkDEBUGPARAMS(ts.globalState())));
-                            debugShowCubicConicIntersection(pts, wn, wt, ts);
-                            break;
-                        }
-                    }
+                    swap = true;
+                    pts = ts.conicLine(wn.pts(), wn.weight(), wt.pts());
+                    debugShowConicLineIntersection(pts, wn, wt, ts);
                     break;
                 case SkIntersectionHelper::kCubic_Segment:
-                    switch (wn.segmentType()) {
-                        case SkIntersectionHelper::kHorizontalLine_Segment:
-                            pts = ts.cubicHorizontal(wt.pts(), wn.left(),
-                                    wn.right(), wn.y(), wn.xFlipped());
-                            debugShowCubicLineIntersection(pts, wt, wn, ts);
-                            break;
-                        case SkIntersectionHelper::kVerticalLine_Segment:
-                            pts = ts.cubicVertical(wt.pts(), wn.top(),
-                                    wn.bottom(), wn.x(), wn.yFlipped());
-                            debugShowCubicLineIntersection(pts, wt, wn, ts);
-                            break;
-                        case SkIntersectionHelper::kLine_Segment:
-                            pts = ts.cubicLine(wt.pts(), wn.pts());
-                            debugShowCubicLineIntersection(pts, wt, wn, ts);
-                            break;
-                        case SkIntersectionHelper::kQuad_Segment: {
-                            pts = ts.intersect(cubic1.set(wt.pts()), quad2.set(wn.pts()));
-                            debugShowCubicQuadIntersection(pts, wt, wn, ts);
-                            break;
-                        }
-                        case SkIntersectionHelper::kConic_Segment: {
-                            pts = ts.intersect(cubic1.set(wt.pts()
-                                    SkDEBUGPARAMS(ts.globalState())),
-                                    conic2.set(wn.pts(), wn.weight()
-                                    SkDEBUGPARAMS(ts.globalState())));
-                            debugShowCubicConicIntersection(pts, wt, wn, ts);
-                            break;
-                        }
-                        case SkIntersectionHelper::kCubic_Segment: {
-                            pts = ts.intersect(cubic1.set(wt.pts()), cubic2.set(wn.pts()));
-                            debugShowCubicIntersection(pts, wt, wn, ts);
-                            break;
-                        }
-                        default:
-                            SkASSERT(0);
-                    }
+                    swap = true;
+                    pts = ts.cubicLine(wn.pts(), wt.pts());
+                    debugShowCubicLineIntersection(pts, wn, wt, ts);
                     break;
                 default:
                     SkASSERT(0);
             }
-#if DEBUG_T_SECT_LOOP_COUNT
-            test->globalState()->debugAddLoopCount(&ts, wt, wn);
-#endif
-            int coinIndex = -1;
-            SkOpPtT* coinPtT[2];
-            for (int pt = 0; pt < pts; ++pt) {
-                SkASSERT(ts[0][pt] >= 0 && ts[0][pt] <= 1);
-                SkASSERT(ts[1][pt] >= 0 && ts[1][pt] <= 1);
-                wt.segment()->debugValidate();
-                // if t value is used to compute pt in addT, error may creep in and
-                // rect intersections may result in non-rects. if pt value from intersection
-                // is passed in, current tests break. As a workaround, pass in pt
-                // value from intersection only if pt.x and pt.y is integral
-                SkPoint iPt = ts.pt(pt).asSkPoint();
-                bool iPtIsIntegral = iPt.fX == floor(iPt.fX) && iPt.fY == floor(iPt.fY);
-                SkOpPtT* testTAt = iPtIsIntegral ? wt.segment()->addT(ts[swap][pt], iPt)
-                        : wt.segment()->addT(ts[swap][pt]);
-                wn.segment()->debugValidate();
-                SkOpPtT* nextTAt = iPtIsIntegral ? wn.segment()->addT(ts[!swap][pt], iPt)
-                        : wn.segment()->addT(ts[!swap][pt]);
-                if (!testTAt->contains(nextTAt)) {
-                    SkOpPtT* oppPrev = testTAt->oppPrev(nextTAt);  //  Returns nullptr if pair
-                    if (oppPrev) {                                 //  already share a pt-t loop.
-                        testTAt->span()->mergeMatches(nextTAt->span());
-                        testTAt->addOpp(nextTAt, oppPrev);
-                    }
-                    if (testTAt->fPt != nextTAt->fPt) {
-                        testTAt->span()->unaligned();
-                        nextTAt->span()->unaligned();
-                    }
-                    wt.segment()->debugValidate();
-                    wn.segment()->debugValidate();
+            break;
+        case SkIntersectionHelper::kQuad_Segment:
+            switch (wn.segmentType()) {
+                case SkIntersectionHelper::kHorizontalLine_Segment:
+                    pts = ts.quadHorizontal(wt.pts(), wn.left(),
+                            wn.right(), wn.y(), wn.xFlipped());
+                    debugShowQuadLineIntersection(pts, wt, wn, ts);
+                    break;
+                case SkIntersectionHelper::kVerticalLine_Segment:
+                    pts = ts.quadVertical(wt.pts(), wn.top(),
+                            wn.bottom(), wn.x(), wn.yFlipped());
+                    debugShowQuadLineIntersection(pts, wt, wn, ts);
+                    break;
+                case SkIntersectionHelper::kLine_Segment:
+                    pts = ts.quadLine(wt.pts(), wn.pts());
+                    debugShowQuadLineIntersection(pts, wt, wn, ts);
+                    break;
+                case SkIntersectionHelper::kQuad_Segment: {
+                    pts = ts.intersect(quad1.set(wt.pts()), quad2.set(wn.pts()));
+                    debugShowQuadIntersection(pts, wt, wn, ts);
+                    break;
                 }
-                if (!ts.isCoincident(pt)) {
-                    continue;
+                case SkIntersectionHelper::kConic_Segment: {
+                    swap = true;
+                    pts = ts.intersect(conic2.set(wn.pts(), wn.weight()),
+                            quad1.set(wt.pts()));
+                    debugShowConicQuadIntersection(pts, wn, wt, ts);
+                    break;
                 }
-                if (coinIndex < 0) {
-                    coinPtT[0] = testTAt;
-                    coinPtT[1] = nextTAt;
-                    coinIndex = pt;
-                    continue;
+                case SkIntersectionHelper::kCubic_Segment: {
+                    swap = true;
+                    pts = ts.intersect(cubic2.set(wn.pts()), quad1.set(wt.pts()));
+                    debugShowCubicQuadIntersection(pts, wn, wt, ts);
+                    break;
+                }
+                default:
+                    SkASSERT(0);
+            }
+            break;
+        case SkIntersectionHelper::kConic_Segment:
+            switch (wn.segmentType()) {
+                case SkIntersectionHelper::kHorizontalLine_Segment:
+                    pts = ts.conicHorizontal(wt.pts(), wt.weight(), wn.left(),
+                            wn.right(), wn.y(), wn.xFlipped());
+                    debugShowConicLineIntersection(pts, wt, wn, ts);
+                    break;
+                case SkIntersectionHelper::kVerticalLine_Segment:
+                    pts = ts.conicVertical(wt.pts(), wt.weight(), wn.top(),
+                            wn.bottom(), wn.x(), wn.yFlipped());
+                    debugShowConicLineIntersection(pts, wt, wn, ts);
+                    break;
+                case SkIntersectionHelper::kLine_Segment:
+                    pts = ts.conicLine(wt.pts(), wt.weight(), wn.pts());
+                    debugShowConicLineIntersection(pts, wt, wn, ts);
+                    break;
+                case SkIntersectionHelper::kQuad_Segment: {
+                    pts = ts.intersect(conic1.set(wt.pts(), wt.weight()),
+                            quad2.set(wn.pts()));
+                    debugShowConicQuadIntersection(pts, wt, wn, ts);
+                    break;
                 }
-                if (coinPtT[0]->span() == testTAt->span()) {
-                    coinIndex = -1;
-                    continue;
+                case SkIntersectionHelper::kConic_Segment: {
+                    pts = ts.intersect(conic1.set(wt.pts(), wt.weight()),
+                            conic2.set(wn.pts(), wn.weight()));
+                    debugShowConicIntersection(pts, wt, wn, ts);
+                    break;
                 }
-                if (coinPtT[1]->span() == nextTAt->span()) {
-                    coinIndex = -1;  // coincidence span collapsed
-                    continue;
+                case SkIntersectionHelper::kCubic_Segment: {
+                    swap = true;
+                    pts = ts.intersect(cubic2.set(wn.pts()
+                            SkDEBUGPARAMS(ts.globalState())),
+                            conic1.set(wt.pts(), wt.weight()
+                            SkDEBUGPARAMS(ts.globalState())));
+                    debugShowCubicConicIntersection(pts, wn, wt, ts);
+                    break;
                 }
-                if (swap) {
-                    using std::swap;
-                    swap(coinPtT[0], coinPtT[1]);
-                    swap(testTAt, nextTAt);
+            }
+            break;
+        case SkIntersectionHelper::kCubic_Segment:
+            switch (wn.segmentType()) {
+                case SkIntersectionHelper::kHorizontalLine_Segment:
+                    pts = ts.cubicHorizontal(wt.pts(), wn.left(),
+                            wn.right(), wn.y(), wn.xFlipped());
+                    debugShowCubicLineIntersection(pts, wt, wn, ts);
+                    break;
+                case SkIntersectionHelper::kVerticalLine_Segment:
+                    pts = ts.cubicVertical(wt.pts(), wn.top(),
+                            wn.bottom(), wn.x(), wn.yFlipped());
+                    debugShowCubicLineIntersection(pts, wt, wn, ts);
+                    break;
+                case SkIntersectionHelper::kLine_Segment:
+                    pts = ts.cubicLine(wt.pts(), wn.pts());
+                    debugShowCubicLineIntersection(pts, wt, wn, ts);
+                    break;
+                case SkIntersectionHelper::kQuad_Segment: {
+                    pts = ts.intersect(cubic1.set(wt.pts()), quad2.set(wn.pts()));
+                    debugShowCubicQuadIntersection(pts, wt, wn, ts);
+                    break;
                 }
-                SkASSERT(coincidence->globalState()->debugSkipAssert()
-                        || coinPtT[0]->span()->t() < testTAt->span()->t());
-                if (coinPtT[0]->span()->deleted()) {
-                    coinIndex = -1;
-                    continue;
+                case SkIntersectionHelper::kConic_Segment: {
+                    pts = ts.intersect(cubic1.set(wt.pts()
+                            SkDEBUGPARAMS(ts.globalState())),
+                            conic2.set(wn.pts(), wn.weight()
+                            SkDEBUGPARAMS(ts.globalState())));
+                    debugShowCubicConicIntersection(pts, wt, wn, ts);
+                    break;
                 }
-                if (testTAt->span()->deleted()) {
-                    coinIndex = -1;
-                    continue;
+                case SkIntersectionHelper::kCubic_Segment: {
+                    pts = ts.intersect(cubic1.set(wt.pts()), cubic2.set(wn.pts()));
+                    debugShowCubicIntersection(pts, wt, wn, ts);
+                    break;
                 }
-                coincidence->add(coinPtT[0], testTAt, coinPtT[1], nextTAt);
-                wt.segment()->debugValidate();
-                wn.segment()->debugValidate();
-                coinIndex = -1;
+                default:
+                    SkASSERT(0);
+            }
+            break;
+        default:
+            SkASSERT(0);
+    }
+#if DEBUG_T_SECT_LOOP_COUNT
+    test->globalState()->debugAddLoopCount(&ts, wt, wn);
+#endif
+    int coinIndex = -1;
+    SkOpPtT* coinPtT[2];
+    for (int pt = 0; pt < pts; ++pt) {
+        SkASSERT(ts[0][pt] >= 0 && ts[0][pt] <= 1);
+        SkASSERT(ts[1][pt] >= 0 && ts[1][pt] <= 1);
+        wt.segment()->debugValidate();
+        // if t value is used to compute pt in addT, error may creep in and
+        // rect intersections may result in non-rects. if pt value from intersection
+        // is passed in, current tests break. As a workaround, pass in pt
+        // value from intersection only if pt.x and pt.y is integral
+        SkPoint iPt = ts.pt(pt).asSkPoint();
+        bool iPtIsIntegral = iPt.fX == floor(iPt.fX) && iPt.fY == floor(iPt.fY);
+        SkOpPtT* testTAt = iPtIsIntegral ? wt.segment()->addT(ts[swap][pt], iPt)
+                : wt.segment()->addT(ts[swap][pt]);
+        wn.segment()->debugValidate();
+        SkOpPtT* nextTAt = iPtIsIntegral ? wn.segment()->addT(ts[!swap][pt], iPt)
+                : wn.segment()->addT(ts[!swap][pt]);
+        if (!testTAt->contains(nextTAt)) {
+            SkOpPtT* oppPrev = testTAt->oppPrev(nextTAt);  //  Returns nullptr if pair
+            if (oppPrev) {                                 //  already share a pt-t loop.
+                testTAt->span()->mergeMatches(nextTAt->span());
+                testTAt->addOpp(nextTAt, oppPrev);
+            }
+            if (testTAt->fPt != nextTAt->fPt) {
+                testTAt->span()->unaligned();
+                nextTAt->span()->unaligned();
+            }
+            wt.segment()->debugValidate();
+            wn.segment()->debugValidate();
+        }
+        if (!ts.isCoincident(pt)) {
+            continue;
+        }
+        if (coinIndex < 0) {
+            coinPtT[0] = testTAt;
+            coinPtT[1] = nextTAt;
+            coinIndex = pt;
+            continue;
+        }
+        if (coinPtT[0]->span() == testTAt->span()) {
+            coinIndex = -1;
+            continue;
+        }
+        if (coinPtT[1]->span() == nextTAt->span()) {
+            coinIndex = -1;  // coincidence span collapsed
+            continue;
+        }
+        if (swap) {
+            using std::swap;
+            swap(coinPtT[0], coinPtT[1]);
+            swap(testTAt, nextTAt);
+        }
+        SkASSERT(coincidence->globalState()->debugSkipAssert()
+                || coinPtT[0]->span()->t() < testTAt->span()->t());
+        if (coinPtT[0]->span()->deleted()) {
+            coinIndex = -1;
+            continue;
+        }
+        if (testTAt->span()->deleted()) {
+            coinIndex = -1;
+            continue;
+        }
+        coincidence->add(coinPtT[0], testTAt, coinPtT[1], nextTAt);
+        wt.segment()->debugValidate();
+        wn.segment()->debugValidate();
+        coinIndex = -1;
+    }
+    SkOPOBJASSERT(coincidence, coinIndex < 0);  // expect coincidence to be paired
+}
+
+// Contour pairs with at least this many segment pairs find the segments whose bounds overlap with
+// a sweep down y, instead of testing every pair.
+static constexpr int kSweepSegmentPairs = 1024;
+
+namespace {
+
+struct SweepEntry {
+    SkOpSegment* fSegment;
+    float        fTop;     // The segment's bounds, outset to cover the slop that
+    float        fBottom;  // SkPathOpsBounds::Intersects() allows.
+    int          fIndex;   // Position in its contour.
+    bool         fFromNext;
+
+    bool operator<(const SweepEntry& that) const { return fTop < that.fTop; }
+};
+
+struct SegmentPair {
+    int fTest;
+    int fNext;
+
+    bool operator<(const SegmentPair& that) const {
+        return fTest < that.fTest || (fTest == that.fTest && fNext < that.fNext);
+    }
+};
+
+}  // namespace
+
+// AlmostLessOrEqualUlps() accepts values up to 16 ulps, or 16 epsilons near zero, out of order.
+static float sweep_slop(float v) {
+    return SkScalarAbs(v) * (1.f / (1 << 18)) + FLT_EPSILON * 32;
+}
+
+static void add_sweep_entries(SkOpContour* contour, bool fromNext, SkTDArray<SweepEntry>* entries,
+                              SkTDArray<SkOpSegment*>* segments) {
+    int index = 0;
+    for (SkOpSegment* segment = contour->first(); segment; segment = segment->next()) {
+        const SkPathOpsBounds& bounds = segment->bounds();
+        *entries->append() = { segment, bounds.fTop - sweep_slop(bounds.fTop),
+                               bounds.fBottom + sweep_slop(bounds.fBottom), index++, fromNext };
+        *segments->append() = segment;
+    }
+}
+
+// Visits the same segment pairs as the exhaustive loop in AddIntersectTs(), in the same order,
+// so the intersections found and the order they're added in don't change. Only pairs whose
+// slightly outset y ranges overlap are tested for overlapping bounds.
+static void sweep_intersect_ts(SkOpContour* test, SkOpContour* next,
+                               SkOpCoincidence* coincidence) {
+    test->debugValidate();
+    next->debugValidate();
+    bool self = test == next;
+    SkTDArray<SweepEntry> entries;
+    SkTDArray<SkOpSegment*> testSegments, nextSegments;
+    add_sweep_entries(test, false, &entries, &testSegments);
+    if (!self) {
+        add_sweep_entries(next, true, &entries, &nextSegments);
+    }
+    SkTQSort(entries.begin(), entries.end() - 1);
+
+    SkTDArray<SegmentPair> pairs;
+    SkTDArray<const SweepEntry*> active[2];
+    for (const SweepEntry& entry : entries) {
+        // Self intersections pair every segment with those before it, otherwise only test
+        // segments with next segments.
+        SkTDArray<const SweepEntry*>& others = active[self ? 0 : !entry.fFromNext];
+        int kept = 0;
+        for (const SweepEntry* other : others) {
+            if (other->fBottom < entry.fTop) {
+                continue;  // Entries are sorted by top, so it's done overlapping anything else.
+            }
+            others[kept++] = other;
+            if (!SkPathOpsBounds::Intersects(entry.fSegment->bounds(),
+                                             other->fSegment->bounds())) {
+                continue;
+            }
+            int entryIndex = entry.fIndex,
+                otherIndex = other->fIndex;
+            if (self ? entryIndex > otherIndex : entry.fFromNext) {
+                using std::swap;
+                swap(entryIndex, otherIndex);
+            }
+            *pairs.append() = { entryIndex, otherIndex };
+        }
+        others.setCount(kept);
+        *active[self ? 0 : entry.fFromNext].append() = &entry;
+    }
+    if (pairs.isEmpty()) {
+        return;
+    }
+    SkTQSort(pairs.begin(), pairs.end() - 1);
+
+    const SkTDArray<SkOpSegment*>& wnSegments = self ? testSegments : nextSegments;
+    SkIntersectionHelper wt, wn;
+    for (const SegmentPair& pair : pairs) {
+        wt.setSegment(testSegments[pair.fTest]);
+        wn.setSegment(wnSegments[pair.fNext]);
+        intersect_segments(wt, wn, test, coincidence);
+    }
+}
+
+bool AddIntersectTs(SkOpContour* test, SkOpContour* next, SkOpCoincidence* coincidence) {
+    if (test != next) {
+        if (AlmostLessUlps(test->bounds().fBottom, next->bounds().fTop)) {
+            return false;
+        }
+        // OPTIMIZATION: outset contour bounds a smidgen instead?
+        if (!SkPathOpsBounds::Intersects(test->bounds(), next->bounds())) {
+            return true;
+        }
+    }
+    if (test->count() * next->count() >= kSweepSegmentPairs) {
+        sweep_intersect_ts(test, next, coincidence);
+        return true;
+    }
+    SkIntersectionHelper wt;
+    wt.init(test);
+    do {
+        SkIntersectionHelper wn;
+        wn.init(next);
+        test->debugValidate();
+        next->debugValidate();
+        if (test == next && !wn.startAfter(wt)) {
+            continue;
+        }
+        do {
+            if (!SkPathOpsBounds::Intersects(wt.bounds(), wn.bounds())) {
+                continue;
             }
-            SkOPOBJASSERT(coincidence, coinIndex < 0);  // expect coincidence to be paired
+            intersect_segments(wt, wn, test, coincidence);
         } while (wn.advance());
     } while (wt.advance());
     return true;
@@ -6,11 +6,16 @@
  */
 
 #include "SkArenaAlloc.h"
+#include "SkExecutor.h"
 #include "SkMatrix.h"
 #include "SkOpEdgeBuilder.h"
 #include "SkPathPriv.h"
 #include "SkPathOps.h"
 #include "SkPathOpsCommon.h"
+#include "SkTSort.h"
+#include "SkTaskGroup.h"
+
+#include <atomic>
 
 static bool one_contour(const SkPath& path) {
     SkSTArenaAlloc<256> allocator;
@@ -120,10 +125,64 @@ void SkOpBuilder::reset() {
     fOps.reset();
 }
 
+// Sorts the paths into groups whose bounds overlap, directly or through other paths in the same
+// group. Paths in different groups can't overlap, so each group can be unioned on its own.
+// Returns the number of groups, each listing its paths in their original order.
+static int group_overlapping_paths(const SkTArray<SkPath>& paths,
+                                   SkTArray<SkTDArray<int>>* groups) {
+    int count = paths.count();
+    SkTDArray<int> parent, order;
+    parent.setCount(count);
+    order.setCount(count);
+    for (int index = 0; index < count; ++index) {
+        parent[index] = order[index] = index;
+    }
+    auto find = [&parent](int index) {
+        while (parent[index] != index) {
+            index = parent[index] = parent[parent[index]];
+        }
+        return index;
+    };
+
+    // Sweep from left to right, so each path only has to be tested against the paths that
+    // start before it ends.
+    SkTQSort(order.begin(), order.end() - 1, [&paths](int a, int b) {
+        return paths[a].getBounds().fLeft < paths[b].getBounds().fLeft;
+    });
+    for (int index = 0; index < count; ++index) {
+        const SkRect& bounds = paths[order[index]].getBounds();
+        for (int next = index + 1; next < count; ++next) {
+            const SkRect& nextBounds = paths[order[next]].getBounds();
+            if (nextBounds.fLeft >= bounds.fRight) {
+                break;
+            }
+            if (SkRect::Intersects(bounds, nextBounds)) {
+                parent[find(order[next])] = find(order[index]);
+            }
+        }
+    }
+
+    SkTDArray<int> groupOf;
+    groupOf.setCount(count);
+    for (int index = 0; index < count; ++index) {
+        groupOf[index] = -1;
+    }
+    groups->reset();
+    for (int index = 0; index < count; ++index) {
+        int root = find(index);
+        if (groupOf[root] < 0) {
+            groupOf[root] = groups->count();
+            groups->push_back();
+        }
+        (*groups)[groupOf[root]].push_back(index);
+    }
+    return groups->count();
+}
+
 /* OPTIMIZATION: Union doesn't need to be all-or-nothing. A run of three or more convex
    paths with union ops could be locally resolved and still improve over doing the
    ops one at a time. */
-bool SkOpBuilder::resolve(SkPath* result) {
+bool SkOpBuilder::resolve(SkPath* result, SkExecutor* executor) {
     SkPath original = *result;
     int count = fOps.count();
     bool allUnion = true;
@@ -158,6 +217,10 @@ bool SkOpBuilder::resolve(SkPath* result) {
             }
         }
     }
+    if (!allUnion && this->unionGroups(result, executor)) {
+        reset();
+        return true;
+    }
     if (!allUnion) {
         *result = fPathRefs[0];
         for (int index = 1; index < count; ++index) {
@@ -193,3 +256,67 @@ bool SkOpBuilder::resolve(SkPath* result) {
     }
     return success;
 }
+
+// When every op is a union but some paths overlap, unions each group of overlapping paths on its
+// own, the way resolve() unions all of them otherwise, and then simplifies the sum of the groups
+// like the all-union case does. Returns false without touching result if some op isn't a union,
+// if everything overlaps anyway, or if any step fails; resolve() then falls back to applying
+// the ops one at a time.
+bool SkOpBuilder::unionGroups(SkPath* result, SkExecutor* executor) {
+    int count = fOps.count();
+    for (int index = 0; index < count; ++index) {
+        const SkPath& path = fPathRefs[index];
+        if (kUnion_SkPathOp != fOps[index] || path.isInverseFillType() ||
+            !path.getBounds().isFinite()) {
+            return false;
+        }
+    }
+    SkTArray<SkTDArray<int>> groups;
+    int groupCount = group_overlapping_paths(fPathRefs, &groups);
+    if (groupCount < 2) {
+        return false;
+    }
+
+    SkTArray<SkPath> unions(groupCount);
+    unions.push_back_n(groupCount);
+    std::atomic<bool> success{true};
+    auto unionGroup = [this, &groups, &unions, &success](int groupIndex) {
+        const SkTDArray<int>& group = groups[groupIndex];
+        SkPath* groupUnion = &unions[groupIndex];
+        bool groupSuccess = true;
+        if (1 == group.count()) {
+            groupSuccess = Simplify(fPathRefs[group[0]], groupUnion);
+        } else {
+            *groupUnion = fPathRefs[group[0]];
+            for (int index = 1; groupSuccess && index < group.count(); ++index) {
+                groupSuccess = Op(*groupUnion, fPathRefs[group[index]], kUnion_SkPathOp,
+                                  groupUnion);
+            }
+        }
+        // convert the even odd result back to winding form before accumulating it
+        if (!groupSuccess || (!groupUnion->isEmpty() && !FixWinding(groupUnion))) {
+            success = false;
+        }
+    };
+    if (executor) {
+        SkTaskGroup(*executor).batch(groupCount, unionGroup);
+    } else {
+        for (int groupIndex = 0; groupIndex < groupCount; ++groupIndex) {
+            unionGroup(groupIndex);
+        }
+    }
+    if (!success) {
+        return false;
+    }
+
+    SkPath sum;
+    for (const SkPath& groupUnion : unions) {
+        sum.addPath(groupUnion);
+    }
+    SkPath simplified;
+    if (!Simplify(sum, &simplified)) {
+        return false;
+    }
+    *result = simplified;
+    return true;
+}
@@ -8,13 +8,17 @@
 #include "SkDeflate.h"
 
 #include "SkData.h"
+#include "SkExecutor.h"
 #include "SkMakeUnique.h"
 #include "SkMalloc.h"
+#include "SkTaskGroup.h"
 #include "SkTo.h"
 #include "SkTraceEvent.h"
 
 #include "zlib.h"
 
+#include <vector>
+
 namespace {
 
 // Different zlib implementations use different T.
@@ -55,23 +59,124 @@ static void do_deflate(int flush,
                  : returnValue == Z_OK);
 }
 
+// The largest window deflate uses, and so the most of the previous chunk that can help.
+static constexpr size_t kDictionarySize = 32 * 1024;
+
+// One piece of a stream compressed in parallel: a raw deflate stream that ends on a byte
+// boundary (with a sync flush), or with the final block if it's the last one.
+struct DeflateChunk {
+    std::vector<uint8_t> fInput;
+    std::vector<uint8_t> fDictionary;
+    std::vector<uint8_t> fOutput;
+    size_t fLength = 0;
+    uLong fAdler = 0;
+    bool fLast = false;
+
+    void compress(int compressionLevel) {
+        TRACE_EVENT0("skia", TRACE_FUNC);
+        fAdler = adler32(adler32(0L, Z_NULL, 0), fInput.data(), SkToUInt(fInput.size()));
+
+        z_stream zStream;
+        zStream.zalloc = &skia_alloc_func;
+        zStream.zfree = &skia_free_func;
+        zStream.opaque = nullptr;
+        SkDEBUGCODE(int r =) deflateInit2(&zStream, compressionLevel, Z_DEFLATED,
+                                          -15 /* raw deflate */, 8, Z_DEFAULT_STRATEGY);
+        SkASSERT(Z_OK == r);
+        if (!fDictionary.empty()) {
+            deflateSetDictionary(&zStream, fDictionary.data(), SkToUInt(fDictionary.size()));
+        }
+
+        // Usually enough for everything, including the empty stored block of a sync flush.
+        fOutput.resize(deflateBound(&zStream, (uLong)fInput.size()) + 16);
+        zStream.next_in = fInput.data();
+        zStream.avail_in = SkToUInt(fInput.size());
+        size_t used = 0;
+        do {
+            if (used == fOutput.size()) {
+                fOutput.resize(2 * fOutput.size());
+            }
+            zStream.next_out = fOutput.data() + used;
+            zStream.avail_out = SkToUInt(fOutput.size() - used);
+            SkDEBUGCODE(r =) deflate(&zStream, fLast ? Z_FINISH : Z_SYNC_FLUSH);
+            SkASSERT(r == Z_OK || r == Z_STREAM_END || r == Z_BUF_ERROR);
+            used = fOutput.size() - zStream.avail_out;
+        } while (zStream.avail_in || zStream.avail_out == 0);
+        fOutput.resize(used);
+        (void)deflateEnd(&zStream);
+
+        fLength = fInput.size();
+
+        fInput = std::vector<uint8_t>();
+        fDictionary = std::vector<uint8_t>();
+    }
+};
+
+// The two byte zlib header deflateInit2() would have written for this level.
+static void write_zlib_header(int compressionLevel, SkWStream* out) {
+    uint8_t header[2] = { 0x78, 0x9C };
+    if (compressionLevel >= 0 && compressionLevel < 2) {
+        header[1] = 0x01;
+    } else if (compressionLevel >= 2 && compressionLevel < 6) {
+        header[1] = 0x5E;
+    } else if (compressionLevel > 6) {
+        header[1] = 0xDA;
+    }
+    out->write(header, sizeof(header));
+}
+
 // Hide all zlib impl details.
 struct SkDeflateWStream::Impl {
     SkWStream* fOut;
     unsigned char fInBuffer[SKDEFLATEWSTREAM_INPUT_BUFFER_SIZE];
     size_t fInBufferIndex;
     z_stream fZStream;
+
+    // Only used when compressing in parallel, in which case we leave fZStream alone once the
+    // first chunk is handed off.
+    SkExecutor* fExecutor = nullptr;
+    int fCompressionLevel = -1;
+    std::vector<uint8_t> fPending;
+    std::vector<std::unique_ptr<DeflateChunk>> fChunks;
+    std::unique_ptr<SkTaskGroup> fTaskGroup;
+    size_t fTotalIn = 0;
+
+    // The tail of the last chunk we launched, to prime the next one with.
+    std::vector<uint8_t> fLastInput;
+
+    void launchChunk(bool last) {
+        auto chunk = skstd::make_unique<DeflateChunk>();
+        chunk->fDictionary.swap(fLastInput);
+        chunk->fInput.swap(fPending);
+        fLastInput.assign(chunk->fInput.end() - SkTMin(chunk->fInput.size(), kDictionarySize),
+                          chunk->fInput.end());
+        chunk->fLast = last;
+
+        if (!fTaskGroup) {
+            fTaskGroup = skstd::make_unique<SkTaskGroup>(*fExecutor);
+        }
+        DeflateChunk* chunkPtr = chunk.get();
+        int level = fCompressionLevel;
+        fTaskGroup->add([chunkPtr, level]() { chunkPtr->compress(level); });
+        fChunks.push_back(std::move(chunk));
+        fPending.reserve(kParallelChunkSize);
+    }
 };
 
 SkDeflateWStream::SkDeflateWStream(SkWStream* out,
                                    int compressionLevel,
-                                   bool gzip)
+                                   bool gzip,
+                                   SkExecutor* executor)
     : fImpl(skstd::make_unique<SkDeflateWStream::Impl>()) {
     fImpl->fOut = out;
     fImpl->fInBufferIndex = 0;
     if (!fImpl->fOut) {
         return;
     }
+    if (!gzip) {
+        fImpl->fExecutor = executor;
+        fImpl->fCompressionLevel = compressionLevel;
+    }
     fImpl->fZStream.next_in = nullptr;
     fImpl->fZStream.zalloc = &skia_alloc_func;
     fImpl->fZStream.zfree = &skia_free_func;
@@ -90,8 +195,30 @@ void SkDeflateWStream::finalize() {
     if (!fImpl->fOut) {
         return;
     }
-    do_deflate(Z_FINISH, &fImpl->fZStream, fImpl->fOut, fImpl->fInBuffer,
-               fImpl->fInBufferIndex);
+    if (fImpl->fExecutor && !fImpl->fChunks.empty()) {
+        fImpl->launchChunk(true);
+        fImpl->fTaskGroup->wait();
+
+        write_zlib_header(fImpl->fCompressionLevel, fImpl->fOut);
+        uLong adler = adler32(0L, Z_NULL, 0);
+        for (const auto& chunk : fImpl->fChunks) {
+            fImpl->fOut->write(chunk->fOutput.data(), chunk->fOutput.size());
+            adler = adler32_combine(adler, chunk->fAdler, (z_off_t)chunk->fLength);
+        }
+        const uint8_t trailer[4] = {
+            (uint8_t)(adler >> 24), (uint8_t)(adler >> 16), (uint8_t)(adler >> 8), (uint8_t)adler,
+        };
+        fImpl->fOut->write(trailer, sizeof(trailer));
+        fImpl->fChunks.clear();
+    } else {
+        if (fImpl->fExecutor) {
+            // We never filled a chunk; compress what we have the usual way.
+            do_deflate(Z_NO_FLUSH, &fImpl->fZStream, fImpl->fOut, fImpl->fPending.data(),
+                       fImpl->fPending.size());
+        }
+        do_deflate(Z_FINISH, &fImpl->fZStream, fImpl->fOut, fImpl->fInBuffer,
+                   fImpl->fInBufferIndex);
+    }
     (void)deflateEnd(&fImpl->fZStream);
     fImpl->fOut = nullptr;
 }
@@ -102,6 +229,21 @@ bool SkDeflateWStream::write(const void* void_buffer, size_t len) {
         return false;
     }
     const char* buffer = (const char*)void_buffer;
+    if (fImpl->fExecutor) {
+        fImpl->fTotalIn += len;
+        while (len > 0) {
+            // We leave a full chunk pending until we know there's more, since only streams
+            // longer than one chunk are compressed in parallel.
+            if (fImpl->fPending.size() == kParallelChunkSize) {
+                fImpl->launchChunk(false);
+            }
+            size_t tocopy = SkTMin(len, kParallelChunkSize - fImpl->fPending.size());
+            fImpl->fPending.insert(fImpl->fPending.end(), buffer, buffer + tocopy);
+            len -= tocopy;
+            buffer += tocopy;
+        }
+        return true;
+    }
     while (len > 0) {
         size_t tocopy =
                 SkTMin(len, sizeof(fImpl->fInBuffer) - fImpl->fInBufferIndex);
@@ -122,5 +264,8 @@ bool SkDeflateWStream::write(const void* void_buffer, size_t len) {
 }
 
 size_t SkDeflateWStream::bytesWritten() const {
+    if (fImpl->fExecutor) {
+        return fImpl->fTotalIn;
+    }
     return fImpl->fZStream.total_in + fImpl->fInBufferIndex;
 }
@@ -11,6 +11,8 @@
 
 #include "SkStream.h"
 
+class SkExecutor;
+
 /**
   * Wrap a stream in this class to compress the information written to
   * this stream using the Deflate algorithm.
@@ -29,10 +31,19 @@ public:
         a wrapper, documented in RFC 1952, around a deflate stream."
         gzip adds a header with a magic number to the beginning of the
         stream, allowing a client to identify a gzip file.
+
+        @param executor if not null, and more than kParallelChunkSize
+        bytes are written, the input is split into chunks of that size
+        which are compressed in parallel.  Each chunk is primed with the
+        32K of input before it, so this costs little compression.  The
+        output is still a single zlib stream.  Not supported with gzip.
      */
     SkDeflateWStream(SkWStream*,
                      int compressionLevel = -1,
-                     bool gzip = false);
+                     bool gzip = false,
+                     SkExecutor* executor = nullptr);
+
+    static constexpr size_t kParallelChunkSize = 256 * 1024;
 
     /** The destructor calls finalize(). */
     ~SkDeflateWStream() override;
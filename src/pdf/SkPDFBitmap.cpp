@@ -14,9 +14,11 @@
 #include "SkImage.h"
 #include "SkImageInfoPriv.h"
 #include "SkJpegInfo.h"
+#include "SkMD5.h"
 #include "SkPDFDocumentPriv.h"
 #include "SkPDFTypes.h"
 #include "SkPDFUtils.h"
+#include "SkResourceCache.h"
 #include "SkStream.h"
 #include "SkTo.h"
 
@@ -65,14 +67,24 @@ static SkColor get_neighbor_avg_color(const SkPixmap& bm, int xOrig, int yOrig)
                  : SK_ColorTRANSPARENT;
 }
 
-template <typename T>
+namespace {
+// An image's streams, compressed and ready to embed. Nothing here depends on the document, so
+// the same image can be embedded again, in this document or another, without recompressing it.
+struct CompressedImage {
+    sk_sp<SkData> fData;
+    sk_sp<SkData> fAlpha;  // DeviceGray, deflated, the same size; null for opaque images.
+    SkISize fSize = {0, 0};
+    const char* fColorSpace = "DeviceGray";
+    bool fIsJpeg = false;
+};
+}  // namespace
+
 static void emit_image_stream(SkPDFDocument* doc,
                               SkPDFIndirectReference ref,
-                              T writeStream,
+                              sk_sp<SkData> data,
                               SkISize size,
                               const char* colorSpace,
                               SkPDFIndirectReference sMask,
-                              int length,
                               bool isJpeg) {
     SkPDFDict pdfDict("XObject");
     pdfDict.insertName("Subtype", "Image");
@@ -94,13 +106,35 @@ static void emit_image_stream(SkPDFDocument* doc,
     if (isJpeg) {
         pdfDict.insertInt("ColorTransform", 0);
     }
-    pdfDict.insertInt("Length", length);
-    doc->emitStream(pdfDict, std::move(writeStream), ref);
+    pdfDict.insertInt("Length", SkToInt(data->size()));
+    doc->emitStream(pdfDict, [&data](SkWStream* dst) { dst->writeData(data); }, ref);
+}
+
+static void emit_compressed_image(const CompressedImage& image, SkPDFDocument* doc,
+                                  SkPDFIndirectReference ref) {
+    SkPDFIndirectReference sMask;
+    if (image.fAlpha) {
+        sMask = doc->reserveRef();
+    }
+    emit_image_stream(doc, ref, image.fData, image.fSize, image.fColorSpace, sMask,
+                      image.fIsJpeg);
+    if (image.fAlpha) {
+        emit_image_stream(doc, sMask, image.fAlpha, image.fSize, "DeviceGray",
+                          SkPDFIndirectReference(), false);
+    }
 }
 
-static void do_deflated_alpha(const SkPixmap& pm, SkPDFDocument* doc, SkPDFIndirectReference ref) {
+static sk_sp<SkData> finish_deflated(SkDynamicMemoryWStream* buffer) {
+    #ifdef SK_PDF_BASE85_BINARY
+    SkPDFUtils::Base85Encode(buffer->detachAsStream(), buffer);
+    #endif
+    return buffer->detachAsData();
+}
+
+static sk_sp<SkData> do_deflated_alpha(const SkPixmap& pm, int compressionLevel,
+                                       SkExecutor* executor) {
     SkDynamicMemoryWStream buffer;
-    SkDeflateWStream deflateWStream(&buffer);
+    SkDeflateWStream deflateWStream(&buffer, compressionLevel, false, executor);
     if (kAlpha_8_SkColorType == pm.colorType()) {
         SkASSERT(pm.rowBytes() == (size_t)pm.width());
         buffer.write(pm.addr8(), pm.width() * pm.height());
@@ -124,33 +158,22 @@ static void do_deflated_alpha(const SkPixmap& pm, SkPDFDocument* doc, SkPDFIndir
         deflateWStream.write(byteBuffer, dst - byteBuffer);
     }
     deflateWStream.finalize();
-
-    #ifdef SK_PDF_BASE85_BINARY
-    SkPDFUtils::Base85Encode(buffer.detachAsStream(), &buffer);
-    #endif
-    int length = SkToInt(buffer.bytesWritten());
-    emit_image_stream(doc, ref, [&buffer](SkWStream* stream) { buffer.writeToAndReset(stream); },
-                      pm.info().dimensions(), "DeviceGray", SkPDFIndirectReference(),
-                      length, false);
+    return finish_deflated(&buffer);
 }
 
-static void do_deflated_image(const SkPixmap& pm,
-                              SkPDFDocument* doc,
-                              bool isOpaque,
-                              SkPDFIndirectReference ref) {
-    SkPDFIndirectReference sMask;
-    if (!isOpaque) {
-        sMask = doc->reserveRef();
-    }
+static CompressedImage do_deflated_image(const SkPixmap& pm,
+                                         int compressionLevel,
+                                         SkExecutor* executor,
+                                         bool isOpaque) {
     SkDynamicMemoryWStream buffer;
-    SkDeflateWStream deflateWStream(&buffer);
+    SkDeflateWStream deflateWStream(&buffer, compressionLevel, false, executor);
     const char* colorSpace = "DeviceGray";
     switch (pm.colorType()) {
         case kAlpha_8_SkColorType:
             fill_stream(&deflateWStream, '\x00', pm.width() * pm.height());
             break;
         case kGray_8_SkColorType:
-            SkASSERT(sMask.fValue = -1);
+            SkASSERT(isOpaque);
             SkASSERT(pm.rowBytes() == (size_t)pm.width());
             deflateWStream.write(pm.addr8(), pm.width() * pm.height());
             break;
@@ -182,19 +205,17 @@ static void do_deflated_image(const SkPixmap& pm,
             deflateWStream.write(byteBuffer, dst - byteBuffer);
     }
     deflateWStream.finalize();
-    #ifdef SK_PDF_BASE85_BINARY
-    SkPDFUtils::Base85Encode(buffer.detachAsStream(), &buffer);
-    #endif
-    int length = SkToInt(buffer.bytesWritten());
-    emit_image_stream(doc, ref, [&buffer](SkWStream* stream) { buffer.writeToAndReset(stream); },
-                      pm.info().dimensions(), colorSpace, sMask, length, false);
+    CompressedImage image;
+    image.fData = finish_deflated(&buffer);
+    image.fSize = pm.info().dimensions();
+    image.fColorSpace = colorSpace;
     if (!isOpaque) {
-        do_deflated_alpha(pm, doc, sMask);
+        image.fAlpha = do_deflated_alpha(pm, compressionLevel, executor);
     }
+    return image;
 }
 
-static bool do_jpeg(sk_sp<SkData> data, SkPDFDocument* doc, SkISize size,
-                    SkPDFIndirectReference ref) {
+static bool do_jpeg(sk_sp<SkData> data, SkISize size, CompressedImage* image) {
     SkISize jpegSize;
     SkEncodedInfo::Color jpegColorType;
     SkEncodedOrigin exifOrientation;
@@ -215,10 +236,10 @@ static bool do_jpeg(sk_sp<SkData> data, SkPDFDocument* doc, SkISize size,
     data = buffer.detachAsData();
     #endif
 
-    emit_image_stream(doc, ref,
-                      [&data](SkWStream* dst) { dst->write(data->data(), data->size()); },
-                      jpegSize, yuv ? "DeviceRGB" : "DeviceGray",
-                      SkPDFIndirectReference(), SkToInt(data->size()), true);
+    image->fData = std::move(data);
+    image->fSize = jpegSize;
+    image->fColorSpace = yuv ? "DeviceRGB" : "DeviceGray";
+    image->fIsJpeg = true;
     return true;
 }
 
@@ -245,46 +266,132 @@ static SkBitmap to_pixels(const SkImage* image) {
     return bm;
 }
 
-void serialize_image(const SkImage* img,
-                     int encodingQuality,
-                     SkPDFDocument* doc,
-                     SkPDFIndirectReference ref) {
-    SkASSERT(img);
-    SkASSERT(doc);
-    SkASSERT(encodingQuality >= 0);
+static CompressedImage compress_image(const SkImage* img,
+                                      int encodingQuality,
+                                      int compressionLevel,
+                                      SkExecutor* executor) {
     SkISize dimensions = img->dimensions();
+    CompressedImage image;
     sk_sp<SkData> data = img->refEncodedData();
-    if (data && do_jpeg(std::move(data), doc, dimensions, ref)) {
-        return;
+    if (data && do_jpeg(std::move(data), dimensions, &image)) {
+        return image;
     }
     SkBitmap bm = to_pixels(img);
     SkPixmap pm = bm.pixmap();
     bool isOpaque = pm.isOpaque() || pm.computeIsOpaque();
     if (encodingQuality <= 100 && isOpaque) {
         sk_sp<SkData> data = img->encodeToData(SkEncodedImageFormat::kJPEG, encodingQuality);
-        if (data && do_jpeg(std::move(data), doc, dimensions, ref)) {
-            return;
+        if (data && do_jpeg(std::move(data), dimensions, &image)) {
+            return image;
         }
     }
-    do_deflated_image(pm, doc, isOpaque, ref);
+    return do_deflated_image(pm, compressionLevel, executor, isOpaque);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Compressed images are also kept in the resource cache, by content, so that documents made one
+// after another (or at once) in this process share the work of compressing the same images.
+namespace {
+static unsigned gPDFImageKeyNamespaceLabel;
+
+struct PDFImageKey : public SkResourceCache::Key {
+    PDFImageKey(const SkMD5::Digest& digest, int encodingQuality, int compressionLevel)
+        : fDigest(digest), fEncodingQuality(encodingQuality), fCompressionLevel(compressionLevel) {
+        this->init(&gPDFImageKeyNamespaceLabel, 0,
+                   sizeof(fDigest) + sizeof(fEncodingQuality) + sizeof(fCompressionLevel));
+    }
+
+    SkMD5::Digest fDigest;
+    int32_t fEncodingQuality;
+    int32_t fCompressionLevel;
+};
+
+struct PDFImageRec : public SkResourceCache::Rec {
+    PDFImageRec(const PDFImageKey& key, const CompressedImage& image)
+        : fKey(key), fImage(image) {}
+
+    PDFImageKey fKey;
+    CompressedImage fImage;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override {
+        return sizeof(*this) + fImage.fData->size() + (fImage.fAlpha ? fImage.fAlpha->size() : 0);
+    }
+    const char* getCategory() const override { return "pdf-image"; }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* context) {
+        *static_cast<CompressedImage*>(context) = static_cast<const PDFImageRec&>(baseRec).fImage;
+        return true;
+    }
+};
+}  // namespace
+
+static void serialize_image(const SkImage* img,
+                            const SkMD5::Digest* digest,
+                            int encodingQuality,
+                            SkPDFDocument* doc,
+                            SkPDFIndirectReference ref) {
+    SkASSERT(img);
+    SkASSERT(doc);
+    SkASSERT(encodingQuality >= 0);
+    int compressionLevel = (int)doc->metadata().fCompressionLevel;
+    CompressedImage image;
+    if (digest) {
+        PDFImageKey key(*digest, encodingQuality, compressionLevel);
+        if (!SkResourceCache::Find(key, PDFImageRec::Visitor, &image)) {
+            image = compress_image(img, encodingQuality, compressionLevel, doc->executor());
+            SkResourceCache::Add(new PDFImageRec(key, image));
+        }
+    } else {
+        image = compress_image(img, encodingQuality, compressionLevel, doc->executor());
+    }
+    emit_compressed_image(image, doc, ref);
+}
+
+bool SkPDFImageDigest(const SkImage* img, SkMD5::Digest* digest) {
+    SkASSERT(img);
+    SkMD5 md5;
+    if (sk_sp<SkData> encoded = img->refEncodedData()) {
+        md5.write("encoded", 8);
+        md5.write(encoded->data(), encoded->size());
+    } else {
+        SkPixmap pm;
+        if (!img->peekPixels(&pm)) {
+            return false;
+        }
+        // Color spaces aren't embedded, so they don't change the output.
+        int32_t header[] = {pm.width(), pm.height(), pm.colorType(), pm.alphaType()};
+        md5.write("pixels", 7);
+        md5.write(header, sizeof(header));
+        size_t rowBytes = pm.info().minRowBytes();
+        for (int y = 0; y < pm.height(); ++y) {
+            md5.write(pm.addr(0, y), rowBytes);
+        }
+    }
+    md5.finish(*digest);
+    return true;
 }
 
 SkPDFIndirectReference SkPDFSerializeImage(const SkImage* img,
                                            SkPDFDocument* doc,
-                                           int encodingQuality) {
+                                           int encodingQuality,
+                                           const SkMD5::Digest* digest) {
     SkASSERT(img);
     SkASSERT(doc);
     SkPDFIndirectReference ref = doc->reserveRef();
     if (SkExecutor* executor = doc->executor()) {
         SkRef(img);
         doc->incrementJobCount();
-        executor->add([img, encodingQuality, doc, ref]() {
-            serialize_image(img, encodingQuality, doc, ref);
+        bool hasDigest = digest != nullptr;
+        SkMD5::Digest digestCopy = hasDigest ? *digest : SkMD5::Digest();
+        executor->add([img, hasDigest, digestCopy, encodingQuality, doc, ref]() {
+            serialize_image(img, hasDigest ? &digestCopy : nullptr, encodingQuality, doc, ref);
             SkSafeUnref(img);
             doc->signalJobComplete();
         });
         return ref;
     }
-    serialize_image(img, encodingQuality, doc, ref);
+    serialize_image(img, digest, encodingQuality, doc, ref);
     return ref;
 }
@@ -7,6 +7,8 @@
 #ifndef SkPDFBitmap_DEFINED
 #define SkPDFBitmap_DEFINED
 
+#include "SkMD5.h"
+
 class SkImage;
 class SkPDFDocument;
 struct SkPDFIndirectReference;
@@ -14,9 +16,19 @@ struct SkPDFIndirectReference;
 /**
  * Serialize a SkImage as an Image Xobject.
  *  quality > 100 means lossless
+ *  If digest is not null, it's what SkPDFImageDigest() computed for img, and the compressed
+ *  image is shared, through the resource cache, with other images with the same digest.
  */
 SkPDFIndirectReference SkPDFSerializeImage(const SkImage* img,
                                            SkPDFDocument* doc,
-                                           int encodingQuality = 101);
+                                           int encodingQuality = 101,
+                                           const SkMD5::Digest* digest = nullptr);
+
+/**
+ * Digest the image's encoded data, or its pixels if it has them but no encoded data.  Images
+ * with the same digest serialize the same way.  Returns false, without decoding anything, for
+ * other images.
+ */
+bool SkPDFImageDigest(const SkImage* img, SkMD5::Digest* digest);
 
 #endif  // SkPDFBitmap_DEFINED
@@ -2001,8 +2001,21 @@ void SkPDFDevice::internalDrawImageRect(SkKeyedImage imageSubset,
     SkPDFIndirectReference pdfimage = pdfimagePtr ? *pdfimagePtr : SkPDFIndirectReference();
     if (!pdfimagePtr) {
         SkASSERT(imageSubset);
-        pdfimage = SkPDFSerializeImage(imageSubset.image().get(), fDocument,
-                                       fDocument->metadata().fEncodingQuality);
+        // Images that aren't the same SkImage may still be the same image, e.g. the same file
+        // decoded twice, so de-dup those by content too.
+        SkMD5::Digest digest;
+        bool hasDigest = SkPDFImageDigest(imageSubset.image().get(), &digest);
+        if (SkPDFIndirectReference* ptr =
+                    hasDigest ? fDocument->fPDFBitmapDigestMap.find(digest) : nullptr) {
+            pdfimage = *ptr;
+        } else {
+            pdfimage = SkPDFSerializeImage(imageSubset.image().get(), fDocument,
+                                           fDocument->metadata().fEncodingQuality,
+                                           hasDigest ? &digest : nullptr);
+            if (hasDigest) {
+                fDocument->fPDFBitmapDigestMap.set(digest, pdfimage);
+            }
+        }
         SkASSERT((key != SkBitmapKey{{0, 0, 0, 0}, 0}));
         fDocument->fPDFBitmapMap.set(key, pdfimage);
     }
@@ -18,6 +18,7 @@
 #include "SkPDFTag.h"
 #include "SkPDFUtils.h"
 #include "SkStream.h"
+#include "SkTaskGroup.h"
 #include "SkTo.h"
 
 #include <utility>
@@ -113,18 +114,21 @@ static void serialize_footer(const SkPDFOffsetMap& offsetMap,
     wStream->writeText("\n%%EOF");
 }
 
+// PDF wants a tree describing all the pages in the document.  We arbitrary
+// choose 8 (kMaxPageTreeNodeSize) as the number of allowed children.
+static constexpr size_t kMaxPageTreeNodeSize = 8;
+
 static SkPDFIndirectReference generate_page_tree(
         SkPDFDocument* doc,
-        std::vector<std::unique_ptr<SkPDFDict>> pages,
+        const std::vector<SkPDFIndirectReference>& leafRefs,
         const std::vector<SkPDFIndirectReference>& pageRefs) {
-    // PDF wants a tree describing all the pages in the document.  We arbitrary
-    // choose 8 (kNodeSize) as the number of allowed children.  The internal
-    // nodes have type "Pages" with an array of children, a parent pointer, and
-    // the number of leaves below the node as "Count."  The leaves are passed
-    // into the method, have type "Page" and need a parent pointer. This method
-    // builds the tree bottom up, skipping internal nodes that would have only
-    // one child.
-    SkASSERT(pages.size() > 0);
+    // The internal nodes have type "Pages" with an array of children, a
+    // parent pointer, and the number of leaves below the node as "Count."
+    // The pages themselves have type "Page" and were already written, each
+    // pointing at the node reserved for its run of kMaxPageTreeNodeSize pages
+    // (leafRefs).  This method builds the rest of the tree bottom up,
+    // skipping internal nodes that would have only one child.
+    SkASSERT(leafRefs.size() > 0);
     struct PageTreeNode {
         std::unique_ptr<SkPDFDict> fNode;
         SkPDFIndirectReference fReservedRef;
@@ -132,10 +136,9 @@ static SkPDFIndirectReference generate_page_tree(
 
         static std::vector<PageTreeNode> Layer(std::vector<PageTreeNode> vec, SkPDFDocument* doc) {
             std::vector<PageTreeNode> result;
-            static constexpr size_t kMaxNodeSize = 8;
             const size_t n = vec.size();
             SkASSERT(n >= 1);
-            const size_t result_len = (n - 1) / kMaxNodeSize + 1;
+            const size_t result_len = (n - 1) / kMaxPageTreeNodeSize + 1;
             SkASSERT(result_len >= 1);
             SkASSERT(n == 1 || result_len < n);
             result.reserve(result_len);
@@ -148,7 +151,7 @@ static SkPDFIndirectReference generate_page_tree(
                 SkPDFIndirectReference parent = doc->reserveRef();
                 auto kids_list = SkPDFMakeArray();
                 int descendantCount = 0;
-                for (size_t j = 0; j < kMaxNodeSize && index < n; ++j) {
+                for (size_t j = 0; j < kMaxPageTreeNodeSize && index < n; ++j) {
                     PageTreeNode& node = vec[index++];
                     node.fNode->insertRef("Parent", parent);
                     kids_list->appendRef(doc->emit(*node.fNode, node.fReservedRef));
@@ -163,12 +166,20 @@ static SkPDFIndirectReference generate_page_tree(
         }
     };
     std::vector<PageTreeNode> currentLayer;
-    currentLayer.reserve(pages.size());
-    SkASSERT(pages.size() == pageRefs.size());
-    for (size_t i = 0; i < pages.size(); ++i) {
-        currentLayer.push_back(PageTreeNode{std::move(pages[i]), pageRefs[i], 1});
+    currentLayer.reserve(leafRefs.size());
+    SkASSERT((pageRefs.size() - 1) / kMaxPageTreeNodeSize + 1 == leafRefs.size());
+    for (size_t i = 0; i < leafRefs.size(); ++i) {
+        auto kids_list = SkPDFMakeArray();
+        size_t first = i * kMaxPageTreeNodeSize,
+               stop = SkTMin(first + kMaxPageTreeNodeSize, pageRefs.size());
+        for (size_t j = first; j < stop; ++j) {
+            kids_list->appendRef(pageRefs[j]);
+        }
+        auto leaf = SkPDFMakeDict("Pages");
+        leaf->insertInt("Count", SkToInt(stop - first));
+        leaf->insertObject("Kids", std::move(kids_list));
+        currentLayer.push_back(PageTreeNode{std::move(leaf), leafRefs[i], SkToInt(stop - first)});
     }
-    currentLayer = PageTreeNode::Layer(std::move(currentLayer), doc);
     while (currentLayer.size() > 1) {
         currentLayer = PageTreeNode::Layer(std::move(currentLayer), doc);
     }
@@ -227,7 +238,7 @@ static SkSize operator*(SkSize u, SkScalar s) { return SkSize{u.width() * s, u.h
 
 SkCanvas* SkPDFDocument::onBeginPage(SkScalar width, SkScalar height) {
     SkASSERT(fCanvas.imageInfo().dimensions().isZero());
-    if (fPages.empty()) {
+    if (fPageRefs.empty()) {
         // if this is the first page if the document.
         {
             SkAutoMutexAcquire autoMutexAcquire(fMutex);
@@ -259,6 +270,9 @@ SkCanvas* SkPDFDocument::onBeginPage(SkScalar width, SkScalar height) {
     fPageDevice = sk_make_sp<SkPDFDevice>(pageSize, this, initialTransform);
     reset_object(&fCanvas, fPageDevice);
     fCanvas.scale(fRasterScale, fRasterScale);
+    if (fPageRefs.size() % kMaxPageTreeNodeSize == 0) {
+        fPageTreeLeafRefs.push_back(this->reserveRef());
+    }
     fPageRefs.push_back(this->reserveRef());
     return &fCanvas;
 }
@@ -288,7 +302,15 @@ void SkPDFDocument::onEndPage() {
     // The StructParents unique identifier for each page is just its
     // 0-based page index.
     page->insertInt("StructParents", SkToInt(this->currentPageIndex()));
-    fPages.emplace_back(std::move(page));
+    // The page is complete, so write it now rather than holding on to it until close().
+    page->insertRef("Parent", fPageTreeLeafRefs.back());
+    this->emit(*page, fPageRefs.back());
+    fEndedPageCount++;
+
+    int fontPageCount = fMetadata.fFontPageRunLength;
+    if (fontPageCount > 0 && fEndedPageCount % fontPageCount == 0) {
+        this->emitFonts();
+    }
 }
 
 void SkPDFDocument::onAbort() {
@@ -450,9 +472,51 @@ static std::vector<const SkPDFFont*> get_fonts(const SkPDFDocument& canon) {
     return fonts;
 }
 
+void SkPDFDocument::emitFonts() {
+    std::vector<const SkPDFFont*> fonts = get_fonts(*this);
+    if (fExecutor) {
+        // Subsetting, glyph widths and ToUnicode cmaps are the slow parts of emitting a font, and
+        // don't depend on any other font, so make all of those at once. The metrics and unicode
+        // maps are cached in the document, so look them up here first; the maps move as that
+        // cache grows, so only hold on to them once it's complete. The fonts are still emitted
+        // one by one in the same order, so they get the same object numbers as without an
+        // executor.
+        std::vector<const SkAdvancedTypefaceMetrics*> metrics(fonts.size());
+        for (size_t i = 0; i < fonts.size(); ++i) {
+            metrics[i] = SkPDFFont::GetMetrics(fonts[i]->typeface(), this);
+            if (metrics[i]) {
+                SkPDFFont::GetUnicodeMap(fonts[i]->typeface(), this);
+            }
+        }
+        std::vector<const std::vector<SkUnichar>*> unicodeMaps(fonts.size());
+        for (size_t i = 0; i < fonts.size(); ++i) {
+            if (metrics[i]) {
+                unicodeMaps[i] = &SkPDFFont::GetUnicodeMap(fonts[i]->typeface(), this);
+            }
+        }
+        std::vector<SkPDFFont::PreparedData> prepared(fonts.size());
+        SkTaskGroup taskGroup(*fExecutor);
+        taskGroup.batch(SkToInt(fonts.size()), [&](int i) {
+            if (metrics[i]) {
+                fonts[i]->prepare(*metrics[i], *unicodeMaps[i], &prepared[i]);
+            }
+        });
+        taskGroup.wait();
+        for (size_t i = 0; i < fonts.size(); ++i) {
+            fonts[i]->emitSubset(this, &prepared[i]);
+        }
+    } else {
+        for (const SkPDFFont* f : fonts) {
+            f->emitSubset(this);
+        }
+    }
+
+    fFontMap.reset();
+}
+
 void SkPDFDocument::onClose(SkWStream* stream) {
     SkASSERT(fCanvas.imageInfo().dimensions().isZero());
-    if (fPages.empty()) {
+    if (fPageRefs.empty()) {
         this->waitForJobs();
         return;
     }
@@ -465,7 +529,7 @@ void SkPDFDocument::onClose(SkWStream* stream) {
         docCatalog->insertObject("OutputIntents", make_srgb_output_intents(this));
     }
 
-    docCatalog->insertRef("Pages", generate_page_tree(this, std::move(fPages), fPageRefs));
+    docCatalog->insertRef("Pages", generate_page_tree(this, fPageTreeLeafRefs, fPageRefs));
 
     if (fDests.size() > 0) {
         docCatalog->insertRef("Dests", this->emit(fDests));
@@ -483,9 +547,7 @@ void SkPDFDocument::onClose(SkWStream* stream) {
 
     auto docCatalogRef = this->emit(*docCatalog);
 
-    for (const SkPDFFont* f : get_fonts(*this)) {
-        f->emitSubset(this);
-    }
+    this->emitFonts();
 
     this->waitForJobs();
     {
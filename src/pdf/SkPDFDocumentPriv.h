@@ -8,6 +8,7 @@
 #define SkPDFDocumentPriv_DEFINED
 
 #include "SkCanvas.h"
+#include "SkMD5.h"
 #include "SkMutex.h"
 #include "SkPDFDocument.h"
 #include "SkPDFMetadata.h"
@@ -92,14 +93,18 @@ public:
     SkExecutor* executor() const { return fExecutor; }
     void incrementJobCount();
     void signalJobComplete();
-    size_t currentPageIndex() { return fPages.size(); }
+    size_t currentPageIndex() { return fEndedPageCount; }
     size_t pageCount() { return fPageRefs.size(); }
 
     // Canonicalized objects
     SkTHashMap<SkPDFImageShaderKey, SkPDFIndirectReference> fImageShaderMap;
     SkTHashMap<SkPDFGradientShader::Key, SkPDFIndirectReference, SkPDFGradientShader::KeyHash>
         fGradientPatternMap;
+    // Keyed in shader space, so one shading serves each transform of the same gradient.
+    SkTHashMap<SkPDFGradientShader::Key, SkPDFIndirectReference, SkPDFGradientShader::KeyHash>
+        fGradientShadingMap;
     SkTHashMap<SkBitmapKey, SkPDFIndirectReference> fPDFBitmapMap;
+    SkTHashMap<SkMD5::Digest, SkPDFIndirectReference> fPDFBitmapDigestMap;
     SkTHashMap<uint32_t, std::unique_ptr<SkAdvancedTypefaceMetrics>> fTypefaceMetrics;
     SkTHashMap<uint32_t, std::vector<SkString>> fType1GlyphNames;
     SkTHashMap<uint32_t, std::vector<SkUnichar>> fToUnicodeMap;
@@ -114,8 +119,10 @@ public:
 private:
     SkPDFOffsetMap fOffsetMap;
     SkCanvas fCanvas;
-    std::vector<std::unique_ptr<SkPDFDict>> fPages;
     std::vector<SkPDFIndirectReference> fPageRefs;
+    // Each run of (up to) 8 pages has a node in the page tree, reserved when the run begins.
+    std::vector<SkPDFIndirectReference> fPageTreeLeafRefs;
+    size_t fEndedPageCount = 0;
     SkPDFDict fDests;
     sk_sp<SkPDFDevice> fPageDevice;
     std::atomic<int> fNextObjectNumber = {1};
@@ -135,6 +142,8 @@ private:
     SkSemaphore fSemaphore;
 
     void waitForJobs();
+    // Writes every font used since the last call, and forgets them.
+    void emitFonts();
     SkWStream* beginObject(SkPDFIndirectReference);
     void endObject();
 };
@@ -283,7 +283,27 @@ static sk_sp<SkData> stream_to_data(std::unique_ptr<SkStreamAsset> stream) {
     return SkData::MakeFromStream(stream.get(), size);
 }
 
-static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
+static std::unique_ptr<SkStreamAsset> make_to_unicode(const SkPDFFont& font,
+                                                     const std::vector<SkUnichar>& glyphToUnicode) {
+    SkASSERT(SkToSizeT(font.typeface()->countGlyphs()) == glyphToUnicode.size());
+    return SkPDFMakeToUnicodeCmap(glyphToUnicode.data(),
+                                  &font.glyphUsage(),
+                                  font.multiByteGlyphs(),
+                                  font.firstGlyphID(),
+                                  font.lastGlyphID());
+}
+
+static void make_cid_glyph_widths(const SkPDFFont& font, SkPDFFont::PreparedData* out) {
+    int emSize;
+    auto glyphCache = SkPDFFont::MakeVectorCache(font.typeface(), &emSize);
+    out->fEmSize = SkToS16(emSize);
+    out->fGlyphWidths = SkPDFMakeCIDGlyphWidthsArray(
+            glyphCache.get(), &font.glyphUsage(), out->fEmSize, &out->fDefaultWidth);
+    out->fHasGlyphWidths = true;
+}
+
+static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc,
+                              SkPDFFont::PreparedData* prepared) {
     const SkAdvancedTypefaceMetrics* metricsPtr =
         SkPDFFont::GetMetrics(font.typeface(), doc);
     SkASSERT(metricsPtr);
@@ -311,9 +331,11 @@ static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
                 if (!SkToBool(metrics.fFlags &
                               SkAdvancedTypefaceMetrics::kNotSubsettable_FontFlag)) {
                     SkASSERT(font.firstGlyphID() == 1);
-                    sk_sp<SkData> subsetFontData = SkPDFSubsetFont(
-                            stream_to_data(std::move(fontAsset)), font.glyphUsage(),
-                            metrics.fFontName.c_str(), ttcIndex);
+                    sk_sp<SkData> subsetFontData =
+                            prepared ? std::move(prepared->fSubsetFontData)
+                                     : SkPDFSubsetFont(stream_to_data(std::move(fontAsset)),
+                                                       font.glyphUsage(),
+                                                       metrics.fFontName.c_str(), ttcIndex);
                     if (subsetFontData) {
                         std::unique_ptr<SkPDFDict> tmp = SkPDFMakeDict();
                         tmp->insertInt("Length1", SkToInt(subsetFontData->size()));
@@ -325,7 +347,9 @@ static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
                         break;
                     }
                     // If subsetting fails, fall back to original font data.
-                    fontAsset = face->openStream(&ttcIndex);
+                    if (!fontAsset) {
+                        fontAsset = face->openStream(&ttcIndex);
+                    }
                     SkASSERT(fontAsset);
                     SkASSERT(fontAsset->getLength() == fontSize);
                     if (!fontAsset || fontAsset->getLength() == 0) { break; }
@@ -371,18 +395,16 @@ static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
     sysInfo->insertInt("Supplement", 0);
     newCIDFont->insertObject("CIDSystemInfo", std::move(sysInfo));
 
-    int16_t defaultWidth = 0;
-    {
-        int emSize;
-        auto glyphCache = SkPDFFont::MakeVectorCache(face, &emSize);
-        std::unique_ptr<SkPDFArray> widths = SkPDFMakeCIDGlyphWidthsArray(
-                glyphCache.get(), &font.glyphUsage(), SkToS16(emSize), &defaultWidth);
-        if (widths && widths->size() > 0) {
-            newCIDFont->insertObject("W", std::move(widths));
-        }
-        newCIDFont->insertScalar(
-                "DW", scaleFromFontUnits(defaultWidth, SkToS16(emSize)));
+    SkPDFFont::PreparedData widths;
+    SkPDFFont::PreparedData* widthsData = prepared && prepared->fHasGlyphWidths ? prepared : &widths;
+    if (!widthsData->fHasGlyphWidths) {
+        make_cid_glyph_widths(font, widthsData);
     }
+    if (widthsData->fGlyphWidths && widthsData->fGlyphWidths->size() > 0) {
+        newCIDFont->insertObject("W", std::move(widthsData->fGlyphWidths));
+    }
+    newCIDFont->insertScalar(
+            "DW", scaleFromFontUnits(widthsData->fDefaultWidth, widthsData->fEmSize));
 
     ////////////////////////////////////////////////////////////////////////////
 
@@ -394,15 +416,10 @@ static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
     descendantFonts->appendRef(doc->emit(*newCIDFont));
     fontDict.insertObject("DescendantFonts", std::move(descendantFonts));
 
-    const std::vector<SkUnichar>& glyphToUnicode =
-        SkPDFFont::GetUnicodeMap(font.typeface(), doc);
-    SkASSERT(SkToSizeT(font.typeface()->countGlyphs()) == glyphToUnicode.size());
     std::unique_ptr<SkStreamAsset> toUnicode =
-            SkPDFMakeToUnicodeCmap(glyphToUnicode.data(),
-                                   &font.glyphUsage(),
-                                   font.multiByteGlyphs(),
-                                   font.firstGlyphID(),
-                                   font.lastGlyphID());
+            prepared && prepared->fToUnicode
+                    ? std::move(prepared->fToUnicode)
+                    : make_to_unicode(font, SkPDFFont::GetUnicodeMap(font.typeface(), doc));
     fontDict.insertRef("ToUnicode", SkPDFStreamOut(nullptr, std::move(toUnicode), doc));
 
     doc->emit(fontDict, font.indirectReference());
@@ -628,7 +645,8 @@ static SkPDFIndirectReference type3_descriptor(SkPDFDocument* doc,
 }
 
 
-static void emit_subset_type3(const SkPDFFont& pdfFont, SkPDFDocument* doc) {
+static void emit_subset_type3(const SkPDFFont& pdfFont, SkPDFDocument* doc,
+                              SkPDFFont::PreparedData* prepared) {
     SkTypeface* typeface = pdfFont.typeface();
     SkGlyphID firstGlyphID = pdfFont.firstGlyphID();
     SkGlyphID lastGlyphID = pdfFont.lastGlyphID();
@@ -743,13 +761,10 @@ static void emit_subset_type3(const SkPDFFont& pdfFont, SkPDFDocument* doc) {
 
     font.insertName("CIDToGIDMap", "Identity");
 
-    const std::vector<SkUnichar>& glyphToUnicode = SkPDFFont::GetUnicodeMap(typeface, doc);
-    SkASSERT(glyphToUnicode.size() == SkToSizeT(typeface->countGlyphs()));
-    auto toUnicodeCmap = SkPDFMakeToUnicodeCmap(glyphToUnicode.data(),
-                                                &subset,
-                                                false,
-                                                firstGlyphID,
-                                                lastGlyphID);
+    std::unique_ptr<SkStreamAsset> toUnicodeCmap =
+            prepared && prepared->fToUnicode
+                    ? std::move(prepared->fToUnicode)
+                    : make_to_unicode(pdfFont, SkPDFFont::GetUnicodeMap(typeface, doc));
     font.insertRef("ToUnicode", SkPDFStreamOut(nullptr, std::move(toUnicodeCmap), doc));
     font.insertRef("FontDescriptor", type3_descriptor(doc, typeface, cache.get()));
     font.insertObject("Widths", std::move(widthArray));
@@ -760,16 +775,50 @@ static void emit_subset_type3(const SkPDFFont& pdfFont, SkPDFDocument* doc) {
 }
 
 
-void SkPDFFont::emitSubset(SkPDFDocument* doc) const {
+static sk_sp<SkData> make_subset_font_data(const SkPDFFont& font,
+                                           const SkAdvancedTypefaceMetrics& metrics) {
+    if (font.getType() != SkAdvancedTypefaceMetrics::kTrueType_Font || !can_embed(metrics) ||
+        SkToBool(metrics.fFlags & SkAdvancedTypefaceMetrics::kNotSubsettable_FontFlag)) {
+        return nullptr;
+    }
+    int ttcIndex;
+    std::unique_ptr<SkStreamAsset> fontAsset = font.typeface()->openStream(&ttcIndex);
+    if (!fontAsset || fontAsset->getLength() == 0) {
+        return nullptr;
+    }
+    return SkPDFSubsetFont(stream_to_data(std::move(fontAsset)), font.glyphUsage(),
+                           metrics.fFontName.c_str(), ttcIndex);
+}
+
+void SkPDFFont::prepare(const SkAdvancedTypefaceMetrics& metrics,
+                        const std::vector<SkUnichar>& glyphToUnicode,
+                        PreparedData* prepared) const {
+    SkASSERT(fFontType != SkPDFFont().fFontType); // not default value
+    switch (fFontType) {
+        case SkAdvancedTypefaceMetrics::kType1CID_Font:
+        case SkAdvancedTypefaceMetrics::kTrueType_Font:
+            prepared->fSubsetFontData = make_subset_font_data(*this, metrics);
+            make_cid_glyph_widths(*this, prepared);
+            prepared->fToUnicode = make_to_unicode(*this, glyphToUnicode);
+            return;
+        case SkAdvancedTypefaceMetrics::kType1_Font:
+            return;
+        default:
+            prepared->fToUnicode = make_to_unicode(*this, glyphToUnicode);
+            return;
+    }
+}
+
+void SkPDFFont::emitSubset(SkPDFDocument* doc, PreparedData* prepared) const {
     SkASSERT(fFontType != SkPDFFont().fFontType); // not default value
     switch (fFontType) {
         case SkAdvancedTypefaceMetrics::kType1CID_Font:
         case SkAdvancedTypefaceMetrics::kTrueType_Font:
-            return emit_subset_type0(*this, doc);
+            return emit_subset_type0(*this, doc, prepared);
         case SkAdvancedTypefaceMetrics::kType1_Font:
             return emit_subset_type1(*this, doc);
         default:
-            return emit_subset_type3(*this, doc);
+            return emit_subset_type3(*this, doc, prepared);
     }
 }
 
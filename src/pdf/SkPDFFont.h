@@ -98,7 +98,28 @@ public:
     static const std::vector<SkUnichar>& GetUnicodeMap(const SkTypeface* typeface,
                                                        SkPDFDocument* canon);
 
-    void emitSubset(SkPDFDocument*) const;
+    /** The slow parts of emitting a font: the subset TrueType data, the CID glyph widths and the
+     *  ToUnicode cmap. None of them touch the document, so many fonts can be prepared at once.
+     */
+    struct PreparedData {
+        sk_sp<SkData> fSubsetFontData;
+        std::unique_ptr<SkPDFArray> fGlyphWidths;
+        int16_t fDefaultWidth = 0;
+        int16_t fEmSize = 0;
+        bool fHasGlyphWidths = false;
+        std::unique_ptr<SkStreamAsset> fToUnicode;
+    };
+
+    /** Fill in whichever parts of PreparedData apply to this font's type.  The metrics and
+     *  glyphToUnicode are what GetMetrics() and GetUnicodeMap() return for this typeface.
+     */
+    void prepare(const SkAdvancedTypefaceMetrics&, const std::vector<SkUnichar>& glyphToUnicode,
+                 PreparedData*) const;
+
+    /** If prepared is not null, it holds what prepare() made for this font, and we use (and
+     *  consume) that rather than making it again.
+     */
+    void emitSubset(SkPDFDocument*, PreparedData* prepared = nullptr) const;
 
     /**
      *  Return false iff the typeface has its NotEmbeddable flag set.
@@ -585,6 +585,89 @@ static SkPDFIndirectReference make_ps_function(std::unique_ptr<SkStreamAsset> ps
     return SkPDFStreamOut(std::move(dict), std::move(psCode), doc);
 }
 
+// warning: does not set fHash on new key.  (All callers need to change fields.)
+static SkPDFGradientShader::Key clone_key(const SkPDFGradientShader::Key& k) {
+    SkPDFGradientShader::Key clone = {
+        k.fType,
+        k.fInfo,  // change pointers later.
+        std::unique_ptr<SkColor[]>(new SkColor[k.fInfo.fColorCount]),
+        std::unique_ptr<SkScalar[]>(new SkScalar[k.fInfo.fColorCount]),
+        k.fCanvasTransform,
+        k.fShaderTransform,
+        k.fBBox, 0};
+    clone.fInfo.fColors = clone.fColors.get();
+    clone.fInfo.fColorOffsets = clone.fStops.get();
+    for (int i = 0; i < clone.fInfo.fColorCount; i++) {
+        clone.fInfo.fColorOffsets[i] = k.fInfo.fColorOffsets[i];
+        clone.fInfo.fColors[i] = k.fInfo.fColors[i];
+    }
+    return clone;
+}
+
+// An axial or radial shading, which only depends on the gradient's own geometry and colors.  Its
+// coordinates are in shader space, so every pattern with the same gradient can share it, however
+// it's transformed.
+static SkPDFIndirectReference find_stitched_shading(SkPDFDocument* doc,
+                                                    const SkPDFGradientShader::Key& state) {
+    SkPDFGradientShader::Key shadingKey = clone_key(state);
+    shadingKey.fCanvasTransform = SkMatrix::I();
+    shadingKey.fShaderTransform = SkMatrix::I();
+    shadingKey.fBBox = SkIRect::MakeEmpty();
+    shadingKey.fHash = hash(shadingKey);
+    if (SkPDFIndirectReference* ptr = doc->fGradientShadingMap.find(shadingKey)) {
+        return *ptr;
+    }
+
+    const SkShader::GradientInfo& info = state.fInfo;
+    SkPDFDict pdfShader;
+    pdfShader.insertObject("Function", gradientStitchCode(info));
+    int32_t shadingType = (state.fType == SkShader::kLinear_GradientType) ? 2 : 3;
+
+    auto extend = SkPDFMakeArray();
+    extend->reserve(2);
+    extend->appendBool(true);
+    extend->appendBool(true);
+    pdfShader.insertObject("Extend", std::move(extend));
+
+    std::unique_ptr<SkPDFArray> coords;
+    if (state.fType == SkShader::kConical_GradientType) {
+        SkScalar r1 = info.fRadius[0];
+        SkScalar r2 = info.fRadius[1];
+        SkPoint pt1 = info.fPoint[0];
+        SkPoint pt2 = info.fPoint[1];
+        FixUpRadius(pt1, r1, pt2, r2);
+
+        coords = SkPDFMakeArray(pt1.x(),
+                                pt1.y(),
+                                r1,
+                                pt2.x(),
+                                pt2.y(),
+                                r2);
+    } else if (state.fType == SkShader::kRadial_GradientType) {
+        const SkPoint& pt1 = info.fPoint[0];
+        coords = SkPDFMakeArray(pt1.x(),
+                                pt1.y(),
+                                0,
+                                pt1.x(),
+                                pt1.y(),
+                                info.fRadius[0]);
+    } else {
+        const SkPoint& pt1 = info.fPoint[0];
+        const SkPoint& pt2 = info.fPoint[1];
+        coords = SkPDFMakeArray(pt1.x(),
+                                pt1.y(),
+                                pt2.x(),
+                                pt2.y());
+    }
+
+    pdfShader.insertObject("Coords", std::move(coords));
+    pdfShader.insertInt("ShadingType", shadingType);
+    pdfShader.insertName("ColorSpace", "DeviceRGB");
+    SkPDFIndirectReference ref = doc->emit(pdfShader);
+    doc->fGradientShadingMap.set(std::move(shadingKey), ref);
+    return ref;
+}
+
 static SkPDFIndirectReference make_function_shader(SkPDFDocument* doc,
                                                    const SkPDFGradientShader::Key& state) {
     SkPoint transformPoints[2];
@@ -598,146 +681,107 @@ static SkPDFIndirectReference make_function_shader(SkPDFDocument* doc,
                              info.fTileMode == SkShader::kClamp_TileMode &&
                              !finalMatrix.hasPerspective();
 
-    int32_t shadingType = 1;
-    auto pdfShader = SkPDFMakeDict();
-    // The two point radial gradient further references
-    // state.fInfo
-    // in translating from x, y coordinates to the t parameter. So, we have
-    // to transform the points and radii according to the calculated matrix.
+    // Only the pattern, which places the shading on the page, depends on the transform.
     if (doStitchFunctions) {
-        pdfShader->insertObject("Function", gradientStitchCode(info));
-        shadingType = (state.fType == SkShader::kLinear_GradientType) ? 2 : 3;
-
-        auto extend = SkPDFMakeArray();
-        extend->reserve(2);
-        extend->appendBool(true);
-        extend->appendBool(true);
-        pdfShader->insertObject("Extend", std::move(extend));
-
-        std::unique_ptr<SkPDFArray> coords;
-        if (state.fType == SkShader::kConical_GradientType) {
-            SkScalar r1 = info.fRadius[0];
-            SkScalar r2 = info.fRadius[1];
-            SkPoint pt1 = info.fPoint[0];
-            SkPoint pt2 = info.fPoint[1];
-            FixUpRadius(pt1, r1, pt2, r2);
-
-            coords = SkPDFMakeArray(pt1.x(),
-                                    pt1.y(),
-                                    r1,
-                                    pt2.x(),
-                                    pt2.y(),
-                                    r2);
-        } else if (state.fType == SkShader::kRadial_GradientType) {
-            const SkPoint& pt1 = info.fPoint[0];
-            coords = SkPDFMakeArray(pt1.x(),
-                                    pt1.y(),
-                                    0,
-                                    pt1.x(),
-                                    pt1.y(),
-                                    info.fRadius[0]);
-        } else {
-            const SkPoint& pt1 = info.fPoint[0];
-            const SkPoint& pt2 = info.fPoint[1];
-            coords = SkPDFMakeArray(pt1.x(),
-                                    pt1.y(),
-                                    pt2.x(),
-                                    pt2.y());
-        }
-
-        pdfShader->insertObject("Coords", std::move(coords));
-    } else {
-        // Depending on the type of the gradient, we want to transform the
-        // coordinate space in different ways.
-        transformPoints[0] = info.fPoint[0];
-        transformPoints[1] = info.fPoint[1];
-        switch (state.fType) {
-            case SkShader::kLinear_GradientType:
-                break;
-            case SkShader::kRadial_GradientType:
-                transformPoints[1] = transformPoints[0];
-                transformPoints[1].fX += info.fRadius[0];
-                break;
-            case SkShader::kConical_GradientType: {
-                transformPoints[1] = transformPoints[0];
-                transformPoints[1].fX += SK_Scalar1;
-                break;
-            }
-            case SkShader::kSweep_GradientType:
-                transformPoints[1] = transformPoints[0];
-                transformPoints[1].fX += SK_Scalar1;
-                break;
-            case SkShader::kColor_GradientType:
-            case SkShader::kNone_GradientType:
-            default:
-                return SkPDFIndirectReference();
-        }
+        SkPDFDict pdfFunctionShader("Pattern");
+        pdfFunctionShader.insertInt("PatternType", 2);
+        pdfFunctionShader.insertObject("Matrix", SkPDFUtils::MatrixToArray(finalMatrix));
+        pdfFunctionShader.insertRef("Shading", find_stitched_shading(doc, state));
+        return doc->emit(pdfFunctionShader);
+    }
 
-        // Move any scaling (assuming a unit gradient) or translation
-        // (and rotation for linear gradient), of the final gradient from
-        // info.fPoints to the matrix (updating bbox appropriately).  Now
-        // the gradient can be drawn on on the unit segment.
-        SkMatrix mapperMatrix;
-        unit_to_points_matrix(transformPoints, &mapperMatrix);
-
-        finalMatrix.preConcat(mapperMatrix);
-
-        // Preserves as much as possible in the final matrix, and only removes
-        // the perspective. The inverse of the perspective is stored in
-        // perspectiveInverseOnly matrix and has 3 useful numbers
-        // (p0, p1, p2), while everything else is either 0 or 1.
-        // In this way the shader will handle it eficiently, with minimal code.
-        SkMatrix perspectiveInverseOnly = SkMatrix::I();
-        if (finalMatrix.hasPerspective()) {
-            if (!split_perspective(finalMatrix,
-                                   &finalMatrix, &perspectiveInverseOnly)) {
-                return SkPDFIndirectReference();
-            }
+    int32_t shadingType = 1;
+    auto pdfShader = SkPDFMakeDict();
+    // Depending on the type of the gradient, we want to transform the
+    // coordinate space in different ways.
+    transformPoints[0] = info.fPoint[0];
+    transformPoints[1] = info.fPoint[1];
+    switch (state.fType) {
+        case SkShader::kLinear_GradientType:
+            break;
+        case SkShader::kRadial_GradientType:
+            transformPoints[1] = transformPoints[0];
+            transformPoints[1].fX += info.fRadius[0];
+            break;
+        case SkShader::kConical_GradientType: {
+            transformPoints[1] = transformPoints[0];
+            transformPoints[1].fX += SK_Scalar1;
+            break;
         }
+        case SkShader::kSweep_GradientType:
+            transformPoints[1] = transformPoints[0];
+            transformPoints[1].fX += SK_Scalar1;
+            break;
+        case SkShader::kColor_GradientType:
+        case SkShader::kNone_GradientType:
+        default:
+            return SkPDFIndirectReference();
+    }
 
-        SkRect bbox;
-        bbox.set(state.fBBox);
-        if (!SkPDFUtils::InverseTransformBBox(finalMatrix, &bbox)) {
+    // Move any scaling (assuming a unit gradient) or translation
+    // (and rotation for linear gradient), of the final gradient from
+    // info.fPoints to the matrix (updating bbox appropriately).  Now
+    // the gradient can be drawn on on the unit segment.
+    SkMatrix mapperMatrix;
+    unit_to_points_matrix(transformPoints, &mapperMatrix);
+
+    finalMatrix.preConcat(mapperMatrix);
+
+    // Preserves as much as possible in the final matrix, and only removes
+    // the perspective. The inverse of the perspective is stored in
+    // perspectiveInverseOnly matrix and has 3 useful numbers
+    // (p0, p1, p2), while everything else is either 0 or 1.
+    // In this way the shader will handle it eficiently, with minimal code.
+    SkMatrix perspectiveInverseOnly = SkMatrix::I();
+    if (finalMatrix.hasPerspective()) {
+        if (!split_perspective(finalMatrix,
+                               &finalMatrix, &perspectiveInverseOnly)) {
             return SkPDFIndirectReference();
         }
-        SkDynamicMemoryWStream functionCode;
+    }
 
-        SkShader::GradientInfo infoCopy = info;
+    SkRect bbox;
+    bbox.set(state.fBBox);
+    if (!SkPDFUtils::InverseTransformBBox(finalMatrix, &bbox)) {
+        return SkPDFIndirectReference();
+    }
+    SkDynamicMemoryWStream functionCode;
 
-        if (state.fType == SkShader::kConical_GradientType) {
-            SkMatrix inverseMapperMatrix;
-            if (!mapperMatrix.invert(&inverseMapperMatrix)) {
-                return SkPDFIndirectReference();
-            }
-            inverseMapperMatrix.mapPoints(infoCopy.fPoint, 2);
-            infoCopy.fRadius[0] = inverseMapperMatrix.mapRadius(info.fRadius[0]);
-            infoCopy.fRadius[1] = inverseMapperMatrix.mapRadius(info.fRadius[1]);
-        }
-        switch (state.fType) {
-            case SkShader::kLinear_GradientType:
-                linearCode(infoCopy, perspectiveInverseOnly, &functionCode);
-                break;
-            case SkShader::kRadial_GradientType:
-                radialCode(infoCopy, perspectiveInverseOnly, &functionCode);
-                break;
-            case SkShader::kConical_GradientType:
-                twoPointConicalCode(infoCopy, perspectiveInverseOnly, &functionCode);
-                break;
-            case SkShader::kSweep_GradientType:
-                sweepCode(infoCopy, perspectiveInverseOnly, &functionCode);
-                break;
-            default:
-                SkASSERT(false);
-        }
-        pdfShader->insertObject(
-                "Domain", SkPDFMakeArray(bbox.left(), bbox.right(), bbox.top(), bbox.bottom()));
+    SkShader::GradientInfo infoCopy = info;
 
-        auto domain = SkPDFMakeArray(bbox.left(), bbox.right(), bbox.top(), bbox.bottom());
-        std::unique_ptr<SkPDFArray> rangeObject = SkPDFMakeArray(0, 1, 0, 1, 0, 1);
-        pdfShader->insertRef("Function",
-                             make_ps_function(functionCode.detachAsStream(), std::move(domain),
-                                              std::move(rangeObject), doc));
+    if (state.fType == SkShader::kConical_GradientType) {
+        SkMatrix inverseMapperMatrix;
+        if (!mapperMatrix.invert(&inverseMapperMatrix)) {
+            return SkPDFIndirectReference();
+        }
+        inverseMapperMatrix.mapPoints(infoCopy.fPoint, 2);
+        infoCopy.fRadius[0] = inverseMapperMatrix.mapRadius(info.fRadius[0]);
+        infoCopy.fRadius[1] = inverseMapperMatrix.mapRadius(info.fRadius[1]);
     }
+    switch (state.fType) {
+        case SkShader::kLinear_GradientType:
+            linearCode(infoCopy, perspectiveInverseOnly, &functionCode);
+            break;
+        case SkShader::kRadial_GradientType:
+            radialCode(infoCopy, perspectiveInverseOnly, &functionCode);
+            break;
+        case SkShader::kConical_GradientType:
+            twoPointConicalCode(infoCopy, perspectiveInverseOnly, &functionCode);
+            break;
+        case SkShader::kSweep_GradientType:
+            sweepCode(infoCopy, perspectiveInverseOnly, &functionCode);
+            break;
+        default:
+            SkASSERT(false);
+    }
+    pdfShader->insertObject(
+            "Domain", SkPDFMakeArray(bbox.left(), bbox.right(), bbox.top(), bbox.bottom()));
+
+    auto domain = SkPDFMakeArray(bbox.left(), bbox.right(), bbox.top(), bbox.bottom());
+    std::unique_ptr<SkPDFArray> rangeObject = SkPDFMakeArray(0, 1, 0, 1, 0, 1);
+    pdfShader->insertRef("Function",
+                         make_ps_function(functionCode.detachAsStream(), std::move(domain),
+                                          std::move(rangeObject), doc));
 
     pdfShader->insertInt("ShadingType", shadingType);
     pdfShader->insertName("ColorSpace", "DeviceRGB");
@@ -795,24 +839,6 @@ static bool gradient_has_alpha(const SkPDFGradientShader::Key& key) {
     return false;
 }
 
-// warning: does not set fHash on new key.  (Both callers need to change fields.)
-static SkPDFGradientShader::Key clone_key(const SkPDFGradientShader::Key& k) {
-    SkPDFGradientShader::Key clone = {
-        k.fType,
-        k.fInfo,  // change pointers later.
-        std::unique_ptr<SkColor[]>(new SkColor[k.fInfo.fColorCount]),
-        std::unique_ptr<SkScalar[]>(new SkScalar[k.fInfo.fColorCount]),
-        k.fCanvasTransform,
-        k.fShaderTransform,
-        k.fBBox, 0};
-    clone.fInfo.fColors = clone.fColors.get();
-    clone.fInfo.fColorOffsets = clone.fStops.get();
-    for (int i = 0; i < clone.fInfo.fColorCount; i++) {
-        clone.fInfo.fColorOffsets[i] = k.fInfo.fColorOffsets[i];
-        clone.fInfo.fColors[i] = k.fInfo.fColors[i];
-    }
-    return clone;
-}
 
 static SkPDFIndirectReference create_smask_graphic_state(SkPDFDocument* doc,
                                                      const SkPDFGradientShader::Key& state) {
@@ -73,8 +73,11 @@ struct SkPDFTagNode {
     struct MarkedContentInfo {
         unsigned fPageIndex;
         int fMarkId;
+        MarkedContentInfo* fNext;
     };
-    SkTArray<MarkedContentInfo> fMarkedContent;
+    // A list, in the tree's arena, of this tag's marked content.
+    MarkedContentInfo* fMarkedContent = nullptr;
+    MarkedContentInfo* fLastMarkedContent = nullptr;
     int fNodeId;
     SkPDF::DocumentStructureType fType;
     SkPDFIndirectReference fRef;
@@ -115,7 +118,8 @@ void SkPDFTagTree::init(const SkPDF::StructureElementNode* node) {
 void SkPDFTagTree::reset() {
     fArena.reset();
     fNodeMap.reset();
-    fMarksPerPage.reset();
+    fMarks.reset();
+    fPageMarkStarts.reset();
     fRoot = nullptr;
 }
 
@@ -129,13 +133,20 @@ int SkPDFTagTree::getMarkIdForNodeId(int nodeId, unsigned pageIndex) {
     }
     SkPDFTagNode* tag = *tagPtr;
     SkASSERT(tag);
-    while (fMarksPerPage.size() < pageIndex + 1) {
-        fMarksPerPage.push_back();
+    SkASSERT(fPageMarkStarts.count() <= SkToInt(pageIndex + 1));
+    while (fPageMarkStarts.count() < SkToInt(pageIndex + 1)) {
+        fPageMarkStarts.push_back(fMarks.count());
     }
-    SkTArray<SkPDFTagNode*>& pageMarks = fMarksPerPage[pageIndex];
-    int markId = pageMarks.count();
-    tag->fMarkedContent.push_back({pageIndex, markId});
-    pageMarks.push_back(tag);
+    int markId = fMarks.count() - fPageMarkStarts[pageIndex];
+    auto info = fArena.make<SkPDFTagNode::MarkedContentInfo>(
+            SkPDFTagNode::MarkedContentInfo{pageIndex, markId, nullptr});
+    if (tag->fLastMarkedContent) {
+        tag->fLastMarkedContent->fNext = info;
+    } else {
+        tag->fMarkedContent = info;
+    }
+    tag->fLastMarkedContent = info;
+    fMarks.push_back(tag);
     return markId;
 }
 
@@ -146,7 +157,7 @@ static bool can_discard(SkPDFTagNode* node) {
     if (node->fCanDiscard == SkPDFTagNode::kNo) {
         return false;
     }
-    if (!node->fMarkedContent.empty()) {
+    if (node->fMarkedContent) {
         node->fCanDiscard = SkPDFTagNode::kNo;
         return false;
     }
@@ -174,10 +185,10 @@ SkPDFIndirectReference prepare_tag_tree_to_emit(SkPDFIndirectReference parent,
             kids->appendRef(prepare_tag_tree_to_emit(ref, child, doc));
         }
     }
-    for (const SkPDFTagNode::MarkedContentInfo& info : node->fMarkedContent) {
+    for (auto info = node->fMarkedContent; info; info = info->fNext) {
         std::unique_ptr<SkPDFDict> mcr = SkPDFMakeDict("MCR");
-        mcr->insertRef("Pg", doc->getPage(info.fPageIndex));
-        mcr->insertInt("MCID", info.fMarkId);
+        mcr->insertRef("Pg", doc->getPage(info->fPageIndex));
+        mcr->insertInt("MCID", info->fMarkId);
         kids->appendObject(std::move(mcr));
     }
     node->fRef = ref;
@@ -209,13 +220,15 @@ SkPDFIndirectReference SkPDFTagTree::makeStructTreeRoot(SkPDFDocument* doc) {
     SkPDFDict parentTree("ParentTree");
     auto parentTreeNums = SkPDFMakeArray();
 
-    SkASSERT(fMarksPerPage.size() <= pageCount);
-    for (size_t j = 0; j < fMarksPerPage.size(); ++j) {
-        const SkTArray<SkPDFTagNode*>& pageMarks = fMarksPerPage[j];
+    SkASSERT(SkToUInt(fPageMarkStarts.count()) <= pageCount);
+    for (int j = 0; j < fPageMarkStarts.count(); ++j) {
+        int start = fPageMarkStarts[j],
+            stop  = j + 1 < fPageMarkStarts.count() ? fPageMarkStarts[j + 1] : fMarks.count();
         SkPDFArray markToTagArray;
-        for (SkPDFTagNode* mark : pageMarks) {
-            SkASSERT(mark->fRef);
-            markToTagArray.appendRef(mark->fRef);
+        markToTagArray.reserve(stop - start);
+        for (int i = start; i < stop; ++i) {
+            SkASSERT(fMarks[i]->fRef);
+            markToTagArray.appendRef(fMarks[i]->fRef);
         }
         parentTreeNums->appendInt(j);
         parentTreeNums->appendRef(doc->emit(markToTagArray));
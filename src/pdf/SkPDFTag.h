@@ -9,8 +9,8 @@
 #define SkPDFTag_DEFINED
 
 #include "SkPDFDocument.h"
-#include "SkTArray.h"
 #include "SkArenaAlloc.h"
+#include "SkTDArray.h"
 #include "SkTHash.h"
 
 class SkPDFDocument;
@@ -29,7 +29,10 @@ private:
     SkArenaAlloc fArena;
     SkTHashMap<int, SkPDFTagNode*> fNodeMap;
     SkPDFTagNode* fRoot = nullptr;
-    SkTArray<SkTArray<SkPDFTagNode*>> fMarksPerPage;
+    // The tag of every marked content sequence, in order.  Pages are drawn one after another, so
+    // each page's marks are a run of this, starting at fPageMarkStarts[pageIndex].
+    SkTDArray<SkPDFTagNode*> fMarks;
+    SkTDArray<int> fPageMarkStarts;
 
     SkPDFTagTree(const SkPDFTagTree&) = delete;
     SkPDFTagTree& operator=(const SkPDFTagTree&) = delete;
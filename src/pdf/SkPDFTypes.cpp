@@ -432,7 +432,9 @@ static void serialize_stream(SkPDFDict* origDict,
     static const size_t kMinimumSavings = strlen("/Filter_/FlateDecode_");
     if (deflate && stream->getLength() > kMinimumSavings) {
         SkDynamicMemoryWStream compressedData;
-        SkDeflateWStream deflateWStream(&compressedData);
+        SkDeflateWStream deflateWStream(&compressedData,
+                                        (int)doc->metadata().fCompressionLevel,
+                                        false, doc->executor());
         SkStreamCopy(&deflateWStream, stream);
         deflateWStream.finalize();
         #ifdef SK_PDF_BASE85_BINARY
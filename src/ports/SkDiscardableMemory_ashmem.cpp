@@ -0,0 +1,108 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkDiscardableMemory.h"
+#include "SkDiscardableMemoryPool.h"
+#include "SkTypes.h"
+
+#include <fcntl.h>
+#include <linux/ashmem.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if __ANDROID_API__ >= 26
+#include <android/sharedmem.h>
+#endif
+
+namespace {
+
+// Unlocking unpins the ashmem region, so the kernel may drop its pages whenever memory is tight;
+// lock() pins it again and reports whether they survived.
+class SkAshmemDiscardableMemory : public SkDiscardableMemory {
+public:
+    static SkAshmemDiscardableMemory* Make(size_t bytes) {
+        if (0 == bytes) {
+            return nullptr;
+        }
+        int fd = create_region(bytes);
+        if (fd < 0) {
+            return nullptr;
+        }
+        void* addr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (MAP_FAILED == addr) {
+            close(fd);
+            return nullptr;
+        }
+        // New regions start out pinned, i.e. locked.
+        return new SkAshmemDiscardableMemory(fd, addr, bytes);
+    }
+
+    ~SkAshmemDiscardableMemory() override {
+        SkASSERT(!fLocked);
+        munmap(fAddr, fSize);
+        close(fFd);
+    }
+
+    bool lock() override {
+        SkASSERT(!fLocked);
+        struct ashmem_pin pin = { 0, 0 };  // The whole region.
+        int result = ioctl(fFd, ASHMEM_PIN, &pin);
+        if (ASHMEM_NOT_PURGED != result) {
+            if (ASHMEM_WAS_PURGED == result) {
+                ioctl(fFd, ASHMEM_UNPIN, &pin);
+            }
+            return false;
+        }
+        fLocked = true;
+        return true;
+    }
+
+    void* data() override {
+        SkASSERT(fLocked);
+        return fAddr;
+    }
+
+    void unlock() override {
+        SkASSERT(fLocked);
+        struct ashmem_pin pin = { 0, 0 };
+        ioctl(fFd, ASHMEM_UNPIN, &pin);
+        fLocked = false;
+    }
+
+private:
+    SkAshmemDiscardableMemory(int fd, void* addr, size_t size)
+        : fFd(fd), fAddr(addr), fSize(size), fLocked(true) {}
+
+    static int create_region(size_t bytes) {
+#if __ANDROID_API__ >= 26
+        return ASharedMemory_create("skia-discardable", bytes);
+#else
+        int fd = open("/dev/ashmem", O_RDWR | O_CLOEXEC);
+        if (fd >= 0 && ioctl(fd, ASHMEM_SET_SIZE, bytes) < 0) {
+            close(fd);
+            fd = -1;
+        }
+        return fd;
+#endif
+    }
+
+    int    fFd;
+    void*  fAddr;
+    size_t fSize;
+    bool   fLocked;
+};
+
+}  // namespace
+
+SkDiscardableMemory* SkDiscardableMemory::Create(size_t bytes) {
+    if (SkDiscardableMemory* dm = SkAshmemDiscardableMemory::Make(bytes)) {
+        return dm;
+    }
+    // Out of file descriptors or address space; fall back to process-managed memory.
+    return SkGetGlobalDiscardableMemoryPool()->create(bytes);
+}
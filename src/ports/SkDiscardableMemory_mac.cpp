@@ -0,0 +1,84 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkDiscardableMemory.h"
+#include "SkDiscardableMemoryPool.h"
+#include "SkTypes.h"
+
+#include <mach/mach.h>
+#include <mach/vm_param.h>
+
+namespace {
+
+// Unlocking marks the purgeable region volatile, so the kernel may empty it whenever memory is
+// tight; lock() makes it nonvolatile again and reports whether it was emptied meanwhile.
+class SkPurgeableDiscardableMemory : public SkDiscardableMemory {
+public:
+    static SkPurgeableDiscardableMemory* Make(size_t bytes) {
+        if (0 == bytes) {
+            return nullptr;
+        }
+        vm_address_t addr = 0;
+        vm_size_t size = round_page(bytes);
+        if (KERN_SUCCESS != vm_allocate(mach_task_self(), &addr, size,
+                                        VM_FLAGS_ANYWHERE | VM_FLAGS_PURGABLE)) {
+            return nullptr;
+        }
+        // New regions start out nonvolatile, i.e. locked.
+        return new SkPurgeableDiscardableMemory(addr, size);
+    }
+
+    ~SkPurgeableDiscardableMemory() override {
+        SkASSERT(!fLocked);
+        vm_deallocate(mach_task_self(), fAddr, fSize);
+    }
+
+    bool lock() override {
+        SkASSERT(!fLocked);
+        int state = VM_PURGABLE_NONVOLATILE;
+        if (KERN_SUCCESS != vm_purgable_control(mach_task_self(), fAddr, VM_PURGABLE_SET_STATE,
+                                                &state)) {
+            return false;
+        }
+        // state now holds the region's previous state.
+        if (VM_PURGABLE_EMPTY == (state & VM_PURGABLE_STATE_MASK)) {
+            return false;
+        }
+        fLocked = true;
+        return true;
+    }
+
+    void* data() override {
+        SkASSERT(fLocked);
+        return reinterpret_cast<void*>(fAddr);
+    }
+
+    void unlock() override {
+        SkASSERT(fLocked);
+        int state = VM_PURGABLE_VOLATILE | VM_VOLATILE_GROUP_DEFAULT;
+        vm_purgable_control(mach_task_self(), fAddr, VM_PURGABLE_SET_STATE, &state);
+        fLocked = false;
+    }
+
+private:
+    SkPurgeableDiscardableMemory(vm_address_t addr, vm_size_t size)
+        : fAddr(addr), fSize(size), fLocked(true) {}
+
+    vm_address_t fAddr;
+    vm_size_t    fSize;
+    bool         fLocked;
+};
+
+}  // namespace
+
+SkDiscardableMemory* SkDiscardableMemory::Create(size_t bytes) {
+    if (SkDiscardableMemory* dm = SkPurgeableDiscardableMemory::Make(bytes)) {
+        return dm;
+    }
+    // Out of address space; fall back to process-managed memory.
+    return SkGetGlobalDiscardableMemoryPool()->create(bytes);
+}
@@ -235,13 +235,23 @@ private:
 
 struct SkFaceRec;
 
+// gFTMutex guards the library's lifetime and the idle face list, and serializes creating and
+// destroying faces, which FreeType requires be done one at a time per FT_Library.  Each face is
+// only ever used by one owner at a time, so loading, rendering and measuring glyphs on it needs
+// no lock at all.
 SK_DECLARE_STATIC_MUTEX(gFTMutex);
 static FreeTypeLibrary* gFTLibrary;
+
+// Faces no longer in use, most recently released first, kept for the next user of the same font.
 static SkFaceRec* gFaceRecHead;
+static int gIdleFaceCount;
+static constexpr int kMaxIdleFaces = 8;
 
 // Private to ref_ft_library and unref_ft_library
 static int gFTCount;
 
+static void purge_idle_ft_faces(int keep);
+
 // Caller must lock gFTMutex before calling this function.
 static bool ref_ft_library() {
     gFTMutex.assertHeld();
@@ -262,6 +272,7 @@ static void unref_ft_library() {
 
     --gFTCount;
     if (0 == gFTCount) {
+        purge_idle_ft_faces(0);
         SkASSERT(nullptr == gFaceRecHead);
         SkASSERT(nullptr != gFTLibrary);
         delete gFTLibrary;
@@ -272,11 +283,10 @@ static void unref_ft_library() {
 ///////////////////////////////////////////////////////////////////////////
 
 struct SkFaceRec {
-    SkFaceRec* fNext;
+    SkFaceRec* fNext;  // Next idle face, while this one is idle.
     std::unique_ptr<FT_FaceRec, SkFunctionWrapper<FT_Error, FT_FaceRec, FT_Done_Face>> fFace;
     FT_StreamRec fFTStream;
     std::unique_ptr<SkStreamAsset> fSkStream;
-    uint32_t fRefCnt;
     uint32_t fFontID;
 
     // FreeType prior to 2.7.1 does not implement retreiving variation design metrics.
@@ -313,7 +323,7 @@ extern "C" {
 }
 
 SkFaceRec::SkFaceRec(std::unique_ptr<SkStreamAsset> stream, uint32_t fontID)
-        : fNext(nullptr), fSkStream(std::move(stream)), fRefCnt(1), fFontID(fontID)
+        : fNext(nullptr), fSkStream(std::move(stream)), fFontID(fontID)
         , fAxesCount(0), fNamedVariationSpecified(false)
 {
     sk_bzero(&fFTStream, sizeof(fFTStream));
@@ -367,20 +377,22 @@ static void ft_face_setup_axes(SkFaceRec* rec, const SkFontData& data) {
     }
 }
 
-// Will return nullptr on failure
+// Returns a face for typeface that the caller has to itself until it calls release_ft_face(),
+// reusing an idle one if there is one.  Will return nullptr on failure.
 // Caller must lock gFTMutex before calling this function.
-static SkFaceRec* ref_ft_face(const SkTypeface* typeface) {
+static SkFaceRec* acquire_ft_face(const SkTypeface* typeface) {
     gFTMutex.assertHeld();
 
     const SkFontID fontID = typeface->uniqueID();
-    SkFaceRec* cachedRec = gFaceRecHead;
-    while (cachedRec) {
-        if (cachedRec->fFontID == fontID) {
-            SkASSERT(cachedRec->fFace);
-            cachedRec->fRefCnt += 1;
-            return cachedRec;
+    for (SkFaceRec** rec = &gFaceRecHead; *rec; rec = &(*rec)->fNext) {
+        if ((*rec)->fFontID == fontID) {
+            SkFaceRec* idle = *rec;
+            SkASSERT(idle->fFace);
+            *rec = idle->fNext;
+            idle->fNext = nullptr;
+            gIdleFaceCount--;
+            return idle;
         }
-        cachedRec = cachedRec->fNext;
     }
 
     std::unique_ptr<SkFontData> data = typeface->makeFontData();
@@ -425,51 +437,55 @@ static SkFaceRec* ref_ft_face(const SkTypeface* typeface) {
         FT_Select_Charmap(rec->fFace.get(), FT_ENCODING_MS_SYMBOL);
     }
 
-    rec->fNext = gFaceRecHead;
-    gFaceRecHead = rec.get();
     return rec.release();
 }
 
+// Deletes the least recently released idle faces until at most keep remain.
 // Caller must lock gFTMutex before calling this function.
-// Marked extern because vc++ does not support internal linkage template parameters.
-extern /*static*/ void unref_ft_face(SkFaceRec* faceRec) {
+static void purge_idle_ft_faces(int keep) {
     gFTMutex.assertHeld();
 
-    SkFaceRec*  rec = gFaceRecHead;
-    SkFaceRec*  prev = nullptr;
-    while (rec) {
-        SkFaceRec* next = rec->fNext;
-        if (rec->fFace == faceRec->fFace) {
-            if (--rec->fRefCnt == 0) {
-                if (prev) {
-                    prev->fNext = next;
-                } else {
-                    gFaceRecHead = next;
-                }
-                delete rec;
-            }
-            return;
-        }
-        prev = rec;
-        rec = next;
+    SkFaceRec** rec = &gFaceRecHead;
+    for (int i = 0; i < keep && *rec; ++i) {
+        rec = &(*rec)->fNext;
+    }
+    while (*rec) {
+        SkFaceRec* next = (*rec)->fNext;
+        delete *rec;
+        gIdleFaceCount--;
+        *rec = next;
     }
-    SkDEBUGFAIL("shouldn't get here, face not in list");
+    SkASSERT(gIdleFaceCount <= keep);
+}
+
+// Gives a face from acquire_ft_face() back, to be reused or deleted.
+// Caller must lock gFTMutex before calling this function.
+// Marked extern because vc++ does not support internal linkage template parameters.
+extern /*static*/ void release_ft_face(SkFaceRec* faceRec) {
+    gFTMutex.assertHeld();
+    SkASSERT(nullptr == faceRec->fNext);
+
+    faceRec->fNext = gFaceRecHead;
+    gFaceRecHead = faceRec;
+    gIdleFaceCount++;
+    purge_idle_ft_faces(kMaxIdleFaces);
 }
 
+// Gives its owner a face of its own for the typeface, to use without holding gFTMutex.
 class AutoFTAccess {
 public:
     AutoFTAccess(const SkTypeface* tf) : fFaceRec(nullptr) {
-        gFTMutex.acquire();
+        SkAutoMutexAcquire ac(gFTMutex);
         SkASSERT_RELEASE(ref_ft_library());
-        fFaceRec = ref_ft_face(tf);
+        fFaceRec = acquire_ft_face(tf);
     }
 
     ~AutoFTAccess() {
+        SkAutoMutexAcquire ac(gFTMutex);
         if (fFaceRec) {
-            unref_ft_face(fFaceRec);
+            release_ft_face(fFaceRec);
         }
         unref_ft_library();
-        gFTMutex.release();
     }
 
     FT_Face face() { return fFaceRec ? fFaceRec->fFace.get() : nullptr; }
@@ -502,14 +518,18 @@ protected:
     bool generateAdvance(SkGlyph* glyph) override;
     void generateMetrics(SkGlyph* glyph) override;
     void generateImage(const SkGlyph& glyph) override;
+    void generateImages(SkSpan<const SkGlyph* const> glyphs) override;
     bool generatePath(SkGlyphID glyphID, SkPath* path) override;
     void generateFontMetrics(SkFontMetrics*) override;
+    // Unhinted outlines are only scaled by the char size and transformed by fMatrix22.
+    bool outlinesScaleLinearly() const override { return true; }
 
 private:
-    using UnrefFTFace = SkFunctionWrapper<void, SkFaceRec, unref_ft_face>;
-    std::unique_ptr<SkFaceRec, UnrefFTFace> fFaceRec;
+    // Released with gFTMutex locked.
+    using ReleaseFTFace = SkFunctionWrapper<void, SkFaceRec, release_ft_face>;
+    std::unique_ptr<SkFaceRec, ReleaseFTFace> fFaceRec;
 
-    FT_Face   fFace;  // Borrowed face from gFaceRecHead.
+    FT_Face   fFace;  // Borrowed from fFaceRec, which this scaler context has to itself.
     FT_Size   fFTSize;  // The size on the fFace for this scaler.
     FT_Int    fStrikeIndex;
 
@@ -531,9 +551,9 @@ private:
     void getBBoxForCurrentGlyph(const SkGlyph* glyph, FT_BBox* bbox,
                                 bool snapToPixelBoundary = false);
     bool getCBoxForLetter(char letter, FT_BBox* bbox);
-    // Caller must lock gFTMutex before calling this function.
+    // Like generateImage, but with the size already set up.
+    void generateImageWithSize(const SkGlyph& glyph);
     void updateGlyphIfLCD(SkGlyph* glyph);
-    // Caller must lock gFTMutex before calling this function.
     // update FreeType2 glyph slot with glyph emboldened
     void emboldenIfNeeded(FT_Face face, FT_GlyphSlot glyph, SkGlyphID gid);
     bool shouldSubpixelBitmap(const SkGlyph&, const SkMatrix&);
@@ -826,10 +846,11 @@ SkScalerContext_FreeType::SkScalerContext_FreeType(sk_sp<SkTypeface> typeface,
     , fFTSize(nullptr)
     , fStrikeIndex(-1)
 {
-    SkAutoMutexAcquire  ac(gFTMutex);
-    SkASSERT_RELEASE(ref_ft_library());
-
-    fFaceRec.reset(ref_ft_face(this->getTypeface()));
+    {
+        SkAutoMutexAcquire  ac(gFTMutex);
+        SkASSERT_RELEASE(ref_ft_library());
+        fFaceRec.reset(acquire_ft_face(this->getTypeface()));
+    }
 
     // load the font file
     if (nullptr == fFaceRec) {
@@ -1001,22 +1022,19 @@ SkScalerContext_FreeType::SkScalerContext_FreeType(sk_sp<SkTypeface> typeface,
 }
 
 SkScalerContext_FreeType::~SkScalerContext_FreeType() {
-    SkAutoMutexAcquire  ac(gFTMutex);
-
     if (fFTSize != nullptr) {
         FT_Done_Size(fFTSize);
     }
 
+    SkAutoMutexAcquire  ac(gFTMutex);
     fFaceRec = nullptr;
-
     unref_ft_library();
 }
 
-/*  We call this before each use of the fFace, since we may be sharing
-    this face with other context (at different sizes).
+/*  We call this before each use of the fFace, since the face may have been used
+    at another size by a previous owner.
 */
 FT_Error SkScalerContext_FreeType::setupSize() {
-    gFTMutex.assertHeld();
     FT_Error err = FT_Activate_Size(fFTSize);
     if (err != 0) {
         return err;
@@ -1030,7 +1048,6 @@ unsigned SkScalerContext_FreeType::generateGlyphCount() {
 }
 
 uint16_t SkScalerContext_FreeType::generateCharToGlyph(SkUnichar uni) {
-    SkAutoMutexAcquire  ac(gFTMutex);
     return SkToU16(FT_Get_Char_Index( fFace, uni ));
 }
 
@@ -1042,8 +1059,6 @@ bool SkScalerContext_FreeType::generateAdvance(SkGlyph* glyph) {
         return false;
     }
 
-    SkAutoMutexAcquire  ac(gFTMutex);
-
     if (this->setupSize()) {
         glyph->zeroMetrics();
         return true;
@@ -1147,8 +1162,6 @@ bool SkScalerContext_FreeType::shouldSubpixelBitmap(const SkGlyph& glyph, const
 }
 
 void SkScalerContext_FreeType::generateMetrics(SkGlyph* glyph) {
-    SkAutoMutexAcquire  ac(gFTMutex);
-
     glyph->fMaskFormat = fRec.fMaskFormat;
 
     if (this->setupSize()) {
@@ -1303,13 +1316,27 @@ static void clear_glyph_image(const SkGlyph& glyph) {
 }
 
 void SkScalerContext_FreeType::generateImage(const SkGlyph& glyph) {
-    SkAutoMutexAcquire  ac(gFTMutex);
-
     if (this->setupSize()) {
         clear_glyph_image(glyph);
         return;
     }
+    this->generateImageWithSize(glyph);
+}
+
+void SkScalerContext_FreeType::generateImages(SkSpan<const SkGlyph* const> glyphs) {
+    // The size and transform stay set on the face for the whole batch.
+    if (this->setupSize()) {
+        for (const SkGlyph* glyph : glyphs) {
+            clear_glyph_image(*glyph);
+        }
+        return;
+    }
+    for (const SkGlyph* glyph : glyphs) {
+        this->generateImageWithSize(*glyph);
+    }
+}
 
+void SkScalerContext_FreeType::generateImageWithSize(const SkGlyph& glyph) {
     FT_Error err = FT_Load_Glyph(fFace, glyph.getGlyphID(), fLoadGlyphFlags);
     if (err != 0) {
         SK_TRACEFTR(err, "SkScalerContext_FreeType::generateImage: FT_Load_Glyph(glyph:%d "
@@ -1336,8 +1363,6 @@ void SkScalerContext_FreeType::generateImage(const SkGlyph& glyph) {
 bool SkScalerContext_FreeType::generatePath(SkGlyphID glyphID, SkPath* path) {
     SkASSERT(path);
 
-    SkAutoMutexAcquire  ac(gFTMutex);
-
     // FT_IS_SCALABLE is documented to mean the face contains outline glyphs.
     if (!FT_IS_SCALABLE(fFace) || this->setupSize()) {
         path->reset();
@@ -1377,8 +1402,6 @@ void SkScalerContext_FreeType::generateFontMetrics(SkFontMetrics* metrics) {
         return;
     }
 
-    SkAutoMutexAcquire ac(gFTMutex);
-
     if (this->setupSize()) {
         sk_bzero(metrics, sizeof(*metrics));
         return;
@@ -1837,7 +1860,8 @@ bool SkTypeface_FreeType::Scanner::recognizedFont(SkStreamAsset* stream, int* nu
 #include "SkTSearch.h"
 bool SkTypeface_FreeType::Scanner::scanFont(
     SkStreamAsset* stream, int ttcIndex,
-    SkString* name, SkFontStyle* style, bool* isFixedPitch, AxisDefinitions* axes) const
+    SkString* name, SkFontStyle* style, bool* isFixedPitch, AxisDefinitions* axes,
+    SkTDArray<SkUnichar>* coverage) const
 {
     SkAutoMutexAcquire libraryLock(fLibraryMutex);
 
@@ -1918,6 +1942,27 @@ bool SkTypeface_FreeType::Scanner::scanFont(
         *isFixedPitch = FT_IS_FIXED_WIDTH(face);
     }
 
+    if (coverage) {
+        // Select the charmap the same way faces for a typeface do, then record each run of
+        // consecutive characters it maps as a [first, last] pair.
+        if (!face->charmap) {
+            FT_Select_Charmap(face, FT_ENCODING_MS_SYMBOL);
+        }
+        coverage->rewind();
+        FT_UInt glyphIndex;
+        FT_ULong charCode = FT_Get_First_Char(face, &glyphIndex);
+        while (glyphIndex) {
+            SkUnichar uni = SkToS32(charCode);
+            if (!coverage->isEmpty() && coverage->top() + 1 == uni) {
+                coverage->top() = uni;
+            } else {
+                coverage->push_back(uni);
+                coverage->push_back(uni);
+            }
+            charCode = FT_Get_Next_Char(face, charCode, &glyphIndex);
+        }
+    }
+
     bool success = GetAxes(face, axes);
     FT_Done_Face(face);
     return success;
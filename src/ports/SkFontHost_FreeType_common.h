@@ -12,6 +12,7 @@
 #include "SkGlyph.h"
 #include "SkMutex.h"
 #include "SkScalerContext.h"
+#include "SkTDArray.h"
 #include "SkTypeface.h"
 #include "SkTypes.h"
 
@@ -69,9 +70,11 @@ public:
         };
         using AxisDefinitions = SkSTArray<4, AxisDefinition, true>;
         bool recognizedFont(SkStreamAsset* stream, int* numFonts) const;
+        // If coverage isn't null, it's set to the sorted, inclusive [first, last] ranges of the
+        // characters the font maps to glyphs, as consecutive pairs.
         bool scanFont(SkStreamAsset* stream, int ttcIndex,
                       SkString* name, SkFontStyle* style, bool* isFixedPitch,
-                      AxisDefinitions* axes) const;
+                      AxisDefinitions* axes, SkTDArray<SkUnichar>* coverage = nullptr) const;
         static void computeAxisValues(
             AxisDefinitions axisDefinitions,
             const SkFontArguments::VariationPosition position,
@@ -13,9 +13,11 @@
 #include "SkFontHost_FreeType_common.h"
 #include "SkFontMgr.h"
 #include "SkFontMgr_android.h"
+#include "SkFontMgr_android_index.h"
 #include "SkFontMgr_android_parser.h"
 #include "SkFontStyle.h"
 #include "SkMakeUnique.h"
+#include "SkMutex.h"
 #include "SkOSFile.h"
 #include "SkPaint.h"
 #include "SkRefCnt.h"
@@ -62,19 +64,31 @@ public:
                              bool isFixedPitch,
                              const SkString& familyName,
                              const SkTArray<SkLanguage, true>& lang,
-                             FontVariant variantStyle)
+                             FontVariant variantStyle,
+                             sk_sp<SkData> coverage)
         : INHERITED(style, isFixedPitch, familyName)
         , fPathName(pathName)
         , fIndex(index)
         , fAxes(axes, axesCount)
         , fLang(lang)
         , fVariantStyle(variantStyle)
+        , fCoverage(std::move(coverage))
         , fFile(cacheFontFiles ? sk_fopen(fPathName.c_str(), kRead_SkFILE_Flag) : nullptr) {
         if (cacheFontFiles) {
             SkASSERT(fFile);
         }
     }
 
+    /** Returns true if the font has a glyph for character, without opening it if its coverage
+     *  is known.
+     */
+    bool hasCharacter(SkUnichar character) const {
+        if (fCoverage) {
+            return SkFontInfo_Android::Covers(*fCoverage, character);
+        }
+        return this->unicharToGlyph(character) != 0;
+    }
+
     std::unique_ptr<SkStreamAsset> makeStream() const {
         if (fFile) {
             sk_sp<SkData> data(SkData::MakeFromFILE(fFile));
@@ -112,7 +126,8 @@ public:
                                                     this->isFixedPitch(),
                                                     fFamilyName,
                                                     fLang,
-                                                    fVariantStyle);
+                                                    fVariantStyle,
+                                                    fCoverage);
     }
 
     const SkString fPathName;
@@ -120,6 +135,7 @@ public:
     const SkSTArray<4, SkFixed, true> fAxes;
     const SkSTArray<4, SkLanguage, true> fLang;
     const FontVariant fVariantStyle;
+    const sk_sp<SkData> fCoverage;  // May be null.
     SkAutoTCallVProc<FILE, sk_fclose> fFile;
 
     typedef SkTypeface_Android INHERITED;
@@ -173,39 +189,36 @@ class SkFontStyleSet_Android : public SkFontStyleSet {
 
 public:
     explicit SkFontStyleSet_Android(const FontFamily& family, const Scanner& scanner,
-                                    const bool cacheFontFiles) {
+                                    SkFontIndex_Android* index, const bool cacheFontFiles)
+        : fLanguages(family.fLanguages)
+        , fCacheFontFiles(cacheFontFiles)
+    {
         const SkString* cannonicalFamilyName = nullptr;
         if (family.fNames.count() > 0) {
             cannonicalFamilyName = &family.fNames[0];
         }
         fFallbackFor = family.fFallbackFor;
 
-        // TODO? make this lazy
+        fVariant = family.fVariant;
+        if (kDefault_FontVariant == fVariant) {
+            fVariant = kCompact_FontVariant | kElegant_FontVariant;
+        }
+
+        // Only fallback fonts are ever asked which characters they have.
+        const bool wantCoverage = family.fIsFallbackFont;
+
         for (int i = 0; i < family.fFonts.count(); ++i) {
             const FontFileInfo& fontFile = family.fFonts[i];
 
             SkString pathName(family.fBasePath);
             pathName.append(fontFile.fFileName);
 
-            std::unique_ptr<SkStreamAsset> stream = SkStream::MakeFromFile(pathName.c_str());
-            if (!stream) {
-                SkDEBUGF("Requested font file %s does not exist or cannot be opened.\n",
-                         pathName.c_str());
-                continue;
-            }
-
             const int ttcIndex = fontFile.fIndex;
-            SkString familyName;
-            SkFontStyle style;
-            bool isFixedWidth;
-            Scanner::AxisDefinitions axisDefinitions;
-            if (!scanner.scanFont(stream.get(), ttcIndex,
-                                  &familyName, &style, &isFixedWidth, &axisDefinitions))
-            {
-                SkDEBUGF("Requested font file %s exists, but is not a valid font.\n",
-                         pathName.c_str());
+            SkFontInfo_Android info;
+            if (!index->find(pathName, ttcIndex, wantCoverage, scanner, &info)) {
                 continue;
             }
+            SkFontStyle style = info.fStyle;
 
             int weight = fontFile.fWeight != 0 ? fontFile.fWeight : style.weight();
             SkFontStyle::Slant slant = style.slant();
@@ -217,29 +230,34 @@ public:
             }
             style = SkFontStyle(weight, style.width(), slant);
 
-            uint32_t variant = family.fVariant;
-            if (kDefault_FontVariant == variant) {
-                variant = kCompact_FontVariant | kElegant_FontVariant;
-            }
-
             // The first specified family name overrides the family name found in the font.
             // TODO: SkTypeface_AndroidSystem::onCreateFamilyNameIterator should return
             // all of the specified family names in addition to the names found in the font.
+            SkString familyName = info.fFamilyName;
             if (cannonicalFamilyName != nullptr) {
                 familyName = *cannonicalFamilyName;
             }
 
-            SkAutoSTMalloc<4, SkFixed> axisValues(axisDefinitions.count());
+            Style& entry = fStyles.push_back();
+            entry.fPathName = pathName;
+            entry.fIndex = ttcIndex;
+            entry.fStyle = style;
+            entry.fIsFixedPitch = info.fIsFixedPitch;
+            entry.fFamilyName = familyName;
+            entry.fCoverage = std::move(info.fCoverage);
+
+            entry.fAxisValues.reset(info.fAxes.count());
             SkFontArguments::VariationPosition position = {
                 fontFile.fVariationDesignPosition.begin(),
                 fontFile.fVariationDesignPosition.count()
             };
-            Scanner::computeAxisValues(axisDefinitions, position,
-                                       axisValues, familyName);
+            Scanner::computeAxisValues(info.fAxes, position,
+                                       entry.fAxisValues.begin(), familyName);
 
-            fStyles.push_back().reset(new SkTypeface_AndroidSystem(
-                    pathName, cacheFontFiles, ttcIndex, axisValues.get(), axisDefinitions.count(),
-                    style, isFixedWidth, familyName, family.fLanguages, variant));
+            // Isolated font managers must open their files now, rather than when first used.
+            if (fCacheFontFiles) {
+                this->typeface(fStyles.count() - 1);
+            }
         }
     }
 
@@ -251,7 +269,7 @@ public:
             return;
         }
         if (style) {
-            *style = fStyles[index]->fontStyle();
+            *style = fStyles[index].fStyle;
         }
         if (name) {
             name->reset();
@@ -261,15 +279,54 @@ public:
         if (index < 0 || fStyles.count() <= index) {
             return nullptr;
         }
-        return SkRef(fStyles[index].get());
+        return SkRef(this->typeface(index));
     }
 
     SkTypeface_AndroidSystem* matchStyle(const SkFontStyle& pattern) override {
         return static_cast<SkTypeface_AndroidSystem*>(this->matchStyleCSS3(pattern));
     }
 
+    /** Returns true if typeface is one of this set's. */
+    bool contains(const SkTypeface* typeface) {
+        SkAutoMutexAcquire lock(fTypefaceMutex);
+        for (const Style& style : fStyles) {
+            if (style.fTypeface.get() == typeface) {
+                return true;
+            }
+        }
+        return false;
+    }
+
 private:
-    SkTArray<sk_sp<SkTypeface_AndroidSystem>> fStyles;
+    // What's needed to make a typeface, which is only done when it's first asked for.
+    struct Style {
+        SkString fPathName;
+        int fIndex;
+        SkSTArray<4, SkFixed, true> fAxisValues;
+        SkFontStyle fStyle;
+        bool fIsFixedPitch;
+        SkString fFamilyName;
+        sk_sp<SkData> fCoverage;
+        sk_sp<SkTypeface_AndroidSystem> fTypeface;  // Guarded by fTypefaceMutex.
+    };
+
+    SkTypeface_AndroidSystem* typeface(int index) {
+        SkAutoMutexAcquire lock(fTypefaceMutex);
+        Style& style = fStyles[index];
+        if (!style.fTypeface) {
+            style.fTypeface = sk_make_sp<SkTypeface_AndroidSystem>(
+                    style.fPathName, fCacheFontFiles, style.fIndex, style.fAxisValues.begin(),
+                    style.fAxisValues.count(), style.fStyle, style.fIsFixedPitch,
+                    style.fFamilyName, fLanguages, (FontVariant)fVariant, style.fCoverage);
+        }
+        return style.fTypeface.get();
+    }
+
+    SkTArray<Style> fStyles;
+    SkMutex fTypefaceMutex;
+    const SkSTArray<4, SkLanguage, true> fLanguages;
+    uint32_t fVariant;
+    const bool fCacheFontFiles;
     SkString fFallbackFor;
 
     friend struct NameToFamily;
@@ -307,7 +364,9 @@ public:
             SkFontMgr_Android_Parser::GetCustomFontFamilies(
                 families, base, custom->fFontsXml, custom->fFallbackFontsXml);
         }
-        this->buildNameToFamilyMap(families, custom ? custom->fIsolated : false);
+        SkFontIndex_Android index(custom ? custom->fFontIndex : nullptr);
+        this->buildNameToFamilyMap(families, &index, custom ? custom->fIsolated : false);
+        index.save();
         this->findDefaultStyleSet();
         families.deleteAll();
     }
@@ -363,10 +422,8 @@ protected:
     virtual SkTypeface* onMatchFaceStyle(const SkTypeface* typeface,
                                          const SkFontStyle& style) const override {
         for (int i = 0; i < fStyleSets.count(); ++i) {
-            for (int j = 0; j < fStyleSets[i]->fStyles.count(); ++j) {
-                if (fStyleSets[i]->fStyles[j].get() == typeface) {
-                    return fStyleSets[i]->matchStyle(style);
-                }
+            if (fStyleSets[i]->contains(typeface)) {
+                return fStyleSets[i]->matchStyle(style);
             }
         }
         return nullptr;
@@ -397,7 +454,7 @@ protected:
                 continue;
             }
 
-            if (face->unicharToGlyph(character) != 0) {
+            if (face->hasCharacter(character)) {
                 return face;
             }
         }
@@ -525,7 +582,8 @@ private:
     SkTArray<NameToFamily, true> fNameToFamilyMap;
     SkTArray<NameToFamily, true> fFallbackNameToFamilyMap;
 
-    void addFamily(FontFamily& family, const bool isolated, int familyIndex) {
+    void addFamily(FontFamily& family, SkFontIndex_Android* index, const bool isolated,
+                   int familyIndex) {
         SkTArray<NameToFamily, true>* nameToFamily = &fNameToFamilyMap;
         if (family.fIsFallbackFont) {
             nameToFamily = &fFallbackNameToFamilyMap;
@@ -537,7 +595,7 @@ private:
         }
 
         sk_sp<SkFontStyleSet_Android> newSet =
-            sk_make_sp<SkFontStyleSet_Android>(family, fScanner, isolated);
+            sk_make_sp<SkFontStyleSet_Android>(family, fScanner, index, isolated);
         if (0 == newSet->count()) {
             return;
         }
@@ -547,13 +605,14 @@ private:
         }
         fStyleSets.emplace_back(std::move(newSet));
     }
-    void buildNameToFamilyMap(SkTDArray<FontFamily*> families, const bool isolated) {
+    void buildNameToFamilyMap(SkTDArray<FontFamily*> families, SkFontIndex_Android* index,
+                              const bool isolated) {
         int familyIndex = 0;
         for (FontFamily* family : families) {
-            addFamily(*family, isolated, familyIndex++);
-            family->fallbackFamilies.foreach([this, isolated, &familyIndex]
+            addFamily(*family, index, isolated, familyIndex++);
+            family->fallbackFamilies.foreach([this, index, isolated, &familyIndex]
                 (SkString, std::unique_ptr<FontFamily>* fallbackFamily) {
-                    addFamily(*(*fallbackFamily).get(), isolated, familyIndex++);
+                    addFamily(*(*fallbackFamily).get(), index, isolated, familyIndex++);
                 }
             );
         }
@@ -0,0 +1,267 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkFontMgr_android_index.h"
+
+#include "SkStream.h"
+#include "SkTDArray.h"
+
+#include <stdio.h>
+#include <sys/stat.h>
+
+// The index is a header followed by its entries, all in native byte order, with every field
+// four byte aligned so coverage can be used straight from the mapping:
+//
+//   u32 magic, u32 version, u32 entry count
+//   per entry:
+//     string path, s32 collection index, u64 file size, s64 modification time,
+//     string family name, s32 weight, s32 width, s32 slant, u32 fixed pitch,
+//     u32 axis count, then per axis u32 tag, s32 minimum, s32 default, s32 maximum,
+//     s32 coverage count (-1 if not recorded), then that many SkUnichars
+//
+// where a string is a u32 length followed by its bytes, padded with zeros to four bytes.
+
+static constexpr uint32_t kIndexMagic   = SkSetFourByteTag('s', 'k', 'f', 'i');
+static constexpr uint32_t kIndexVersion = 1;
+
+static SkString make_key(const SkString& path, int ttcIndex) {
+    SkString key(path);
+    key.appendf("#%d", ttcIndex);
+    return key;
+}
+
+static bool write_string(SkWStream* stream, const SkString& str) {
+    static const char kZeros[4] = {0, 0, 0, 0};
+    return stream->write32(SkToU32(str.size())) &&
+           stream->write(str.c_str(), str.size()) &&
+           stream->write(kZeros, SkAlign4(str.size()) - str.size());
+}
+
+static bool write64(SkWStream* stream, uint64_t v) {
+    return stream->write32((uint32_t)v) && stream->write32((uint32_t)(v >> 32));
+}
+
+static bool read_string(SkMemoryStream* stream, SkString* str) {
+    uint32_t size;
+    if (!stream->readU32(&size) || size > stream->getLength() - stream->getPosition()) {
+        return false;
+    }
+    str->set(static_cast<const char*>(stream->getAtPos()), size);
+    size_t padded = SkAlign4(size);
+    return stream->skip(padded) == padded;
+}
+
+static bool read64(SkMemoryStream* stream, uint64_t* v) {
+    uint32_t lo, hi;
+    if (!stream->readU32(&lo) || !stream->readU32(&hi)) {
+        return false;
+    }
+    *v = (uint64_t)hi << 32 | lo;
+    return true;
+}
+
+bool SkFontInfo_Android::Covers(const SkData& coverage, SkUnichar character) {
+    const SkUnichar* ranges = static_cast<const SkUnichar*>(coverage.data());
+    int lo = 0,
+        hi = SkToInt(coverage.size() / (2 * sizeof(SkUnichar)));
+    // Find the first range that ends at or after character.
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (ranges[2 * mid + 1] < character) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo < SkToInt(coverage.size() / (2 * sizeof(SkUnichar))) && ranges[2 * lo] <= character;
+}
+
+SkFontIndex_Android::SkFontIndex_Android(const char* path) : fDirty(false) {
+    if (!path) {
+        return;
+    }
+    fPath.set(path);
+    fData = SkData::MakeFromFileName(path);
+    if (fData && !this->parse()) {
+        SkDEBUGF("Font index %s is malformed; rebuilding it.\n", path);
+        fMapped.reset();
+        fMappedIndex.reset();
+        fData = nullptr;
+    }
+}
+
+bool SkFontIndex_Android::parse() {
+    SkMemoryStream stream(fData);
+    uint32_t magic, version, count;
+    if (!stream.readU32(&magic) || magic != kIndexMagic ||
+        !stream.readU32(&version) || version != kIndexVersion ||
+        !stream.readU32(&count))
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        Entry& entry = fMapped.push_back();
+        uint64_t modifiedTime;
+        int32_t weight, width, slant;
+        uint32_t fixedPitch, axisCount;
+        if (!read_string(&stream, &entry.fPath) ||
+            !stream.readS32(&entry.fTTCIndex) ||
+            !read64(&stream, &entry.fFileSize) ||
+            !read64(&stream, &modifiedTime) ||
+            !read_string(&stream, &entry.fInfo.fFamilyName) ||
+            !stream.readS32(&weight) || !stream.readS32(&width) || !stream.readS32(&slant) ||
+            slant < SkFontStyle::kUpright_Slant || slant > SkFontStyle::kOblique_Slant ||
+            !stream.readU32(&fixedPitch) ||
+            !stream.readU32(&axisCount) ||
+            axisCount > (stream.getLength() - stream.getPosition()) / (4 * sizeof(uint32_t)))
+        {
+            return false;
+        }
+        entry.fModifiedTime = (int64_t)modifiedTime;
+        entry.fInfo.fStyle = SkFontStyle(weight, width, (SkFontStyle::Slant)slant);
+        entry.fInfo.fIsFixedPitch = SkToBool(fixedPitch);
+
+        entry.fInfo.fAxes.reset(axisCount);
+        for (Scanner::AxisDefinition& axis : entry.fInfo.fAxes) {
+            if (!stream.readU32(&axis.fTag) ||
+                !stream.readS32(&axis.fMinimum) ||
+                !stream.readS32(&axis.fDefault) ||
+                !stream.readS32(&axis.fMaximum))
+            {
+                return false;
+            }
+        }
+
+        int32_t coverageCount;
+        if (!stream.readS32(&coverageCount)) {
+            return false;
+        }
+        if (coverageCount >= 0) {
+            size_t bytes = coverageCount * sizeof(SkUnichar);
+            if ((coverageCount & 1) || bytes > stream.getLength() - stream.getPosition()) {
+                return false;
+            }
+            entry.fInfo.fCoverage = SkData::MakeSubset(fData.get(), stream.getPosition(), bytes);
+            stream.skip(bytes);
+        }
+
+        fMappedIndex.set(make_key(entry.fPath, entry.fTTCIndex), fMapped.count() - 1);
+    }
+    return stream.isAtEnd();
+}
+
+bool SkFontIndex_Android::find(const SkString& path, int ttcIndex, bool wantCoverage,
+                               const Scanner& scanner, SkFontInfo_Android* info) {
+    struct stat status;
+    if (0 != stat(path.c_str(), &status)) {
+        SkDEBUGF("Requested font file %s does not exist or cannot be opened.\n", path.c_str());
+        return false;
+    }
+    const uint64_t fileSize = status.st_size;
+    const int64_t modifiedTime = status.st_mtime;
+    auto is_current = [&](const Entry& entry) {
+        return entry.fFileSize == fileSize && entry.fModifiedTime == modifiedTime &&
+               (!wantCoverage || entry.fInfo.fCoverage);
+    };
+
+    // Families often name the same font more than once, e.g. at several variation positions.
+    const SkString key = make_key(path, ttcIndex);
+    int* found = fFoundIndex.find(key);
+    if (found && is_current(fFound[*found])) {
+        *info = fFound[*found].fInfo;
+        return true;
+    }
+    auto add = [&](const Entry& entry) {
+        if (found) {
+            fFound[*found] = entry;
+        } else {
+            fFoundIndex.set(key, fFound.count());
+            fFound.push_back(entry);
+        }
+    };
+    int* mapped = fMappedIndex.find(key);
+    if (mapped && is_current(fMapped[*mapped])) {
+        add(fMapped[*mapped]);
+        *info = fMapped[*mapped].fInfo;
+        return true;
+    }
+
+    std::unique_ptr<SkStreamAsset> stream = SkStream::MakeFromFile(path.c_str());
+    if (!stream) {
+        SkDEBUGF("Requested font file %s does not exist or cannot be opened.\n", path.c_str());
+        return false;
+    }
+    SkTDArray<SkUnichar> coverage;
+    if (!scanner.scanFont(stream.get(), ttcIndex, &info->fFamilyName, &info->fStyle,
+                          &info->fIsFixedPitch, &info->fAxes, wantCoverage ? &coverage : nullptr))
+    {
+        SkDEBUGF("Requested font file %s exists, but is not a valid font.\n", path.c_str());
+        return false;
+    }
+    info->fCoverage = wantCoverage ? SkData::MakeWithCopy(coverage.begin(), coverage.bytes())
+                                   : nullptr;
+
+    add(Entry{path, ttcIndex, fileSize, modifiedTime, *info});
+    fDirty = true;
+    return true;
+}
+
+void SkFontIndex_Android::save() {
+    if (fPath.isEmpty() || (!fDirty && fFound.count() == fMapped.count())) {
+        return;
+    }
+
+    // Write a new file and move it into place, so readers only ever map a complete index.
+    SkString tmpPath(fPath);
+    tmpPath.append(".tmp");
+    bool ok;
+    {
+        SkFILEWStream stream(tmpPath.c_str());
+        if (!stream.isValid()) {
+            SkDEBUGF("Could not write font index %s.\n", tmpPath.c_str());
+            return;
+        }
+        ok = stream.write32(kIndexMagic) &&
+                  stream.write32(kIndexVersion) &&
+                  stream.write32(fFound.count());
+        for (int i = 0; ok && i < fFound.count(); ++i) {
+            const Entry& entry = fFound[i];
+            const SkFontInfo_Android& info = entry.fInfo;
+            ok = write_string(&stream, entry.fPath) &&
+                 stream.write32(entry.fTTCIndex) &&
+                 write64(&stream, entry.fFileSize) &&
+                 write64(&stream, (uint64_t)entry.fModifiedTime) &&
+                 write_string(&stream, info.fFamilyName) &&
+                 stream.write32(info.fStyle.weight()) &&
+                 stream.write32(info.fStyle.width()) &&
+                 stream.write32(info.fStyle.slant()) &&
+                 stream.write32(info.fIsFixedPitch) &&
+                 stream.write32(info.fAxes.count());
+            for (int j = 0; ok && j < info.fAxes.count(); ++j) {
+                const Scanner::AxisDefinition& axis = info.fAxes[j];
+                ok = stream.write32(axis.fTag) &&
+                     stream.write32(axis.fMinimum) &&
+                     stream.write32(axis.fDefault) &&
+                     stream.write32(axis.fMaximum);
+            }
+            if (ok && info.fCoverage) {
+                ok = stream.write32(SkToU32(info.fCoverage->size() / sizeof(SkUnichar))) &&
+                     stream.write(info.fCoverage->data(), info.fCoverage->size());
+            } else if (ok) {
+                ok = stream.write32((uint32_t)-1);
+            }
+        }
+    }
+    if (!ok) {
+        SkDEBUGF("Could not write font index %s.\n", tmpPath.c_str());
+        remove(tmpPath.c_str());
+    } else if (0 != rename(tmpPath.c_str(), fPath.c_str())) {
+        SkDEBUGF("Could not replace font index %s.\n", fPath.c_str());
+        remove(tmpPath.c_str());
+    }
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkFontMgr_android_index_DEFINED
+#define SkFontMgr_android_index_DEFINED
+
+#include "SkData.h"
+#include "SkFontHost_FreeType_common.h"
+#include "SkFontStyle.h"
+#include "SkNoncopyable.h"
+#include "SkRefCnt.h"
+#include "SkString.h"
+#include "SkTArray.h"
+#include "SkTHash.h"
+#include "SkTypes.h"
+
+/** What scanning one font in a font file found. */
+struct SkFontInfo_Android {
+    SkString fFamilyName;
+    SkFontStyle fStyle;
+    bool fIsFixedPitch = false;
+    SkTypeface_FreeType::Scanner::AxisDefinitions fAxes;
+
+    /** The sorted, inclusive [first, last] ranges of characters the font maps to glyphs, as
+     *  pairs of SkUnichars, or null if they weren't asked for.
+     */
+    sk_sp<SkData> fCoverage;
+
+    /** Returns true if coverage says the font maps character. */
+    static bool Covers(const SkData& coverage, SkUnichar character);
+};
+
+/**
+ *  A cache of what scanning the fonts named by fonts.xml found, so that font managers can be
+ *  built without opening every font file.
+ *
+ *  The index is a flat file that is mapped into memory. Each entry is keyed by a font file's path
+ *  and collection index, and is used only while the file's size and modification time still
+ *  match those recorded with it. Character coverage is read in place from the mapping.
+ */
+class SkFontIndex_Android : SkNoncopyable {
+public:
+    using Scanner = SkTypeface_FreeType::Scanner;
+
+    /** Maps the index at path, if there is one and it's well formed. If path is null, nothing is
+     *  cached and every font is scanned.
+     */
+    explicit SkFontIndex_Android(const char* path);
+
+    /** Fills out info for the font at ttcIndex in the file at path, from the index if it has a
+     *  current entry (with coverage, if wantCoverage), otherwise by scanning the font.
+     *  Returns false if the file can't be opened or isn't a font.
+     */
+    bool find(const SkString& path, int ttcIndex, bool wantCoverage, const Scanner& scanner,
+              SkFontInfo_Android* info);
+
+    /** If anything had to be scanned, rewrites the index to hold just the fonts found since it
+     *  was mapped.
+     */
+    void save();
+
+private:
+    struct Entry {
+        SkString fPath;
+        int32_t fTTCIndex;
+        uint64_t fFileSize;
+        int64_t fModifiedTime;
+        SkFontInfo_Android fInfo;
+    };
+
+    bool parse();
+
+    SkString fPath;
+    sk_sp<SkData> fData;
+    SkTArray<Entry> fMapped;
+    SkTHashMap<SkString, int> fMappedIndex;  // "path#ttcIndex" to index in fMapped.
+    SkTArray<Entry> fFound;
+    SkTHashMap<SkString, int> fFoundIndex;   // "path#ttcIndex" to index in fFound.
+    bool fDirty;
+};
+
+#endif
@@ -17,9 +17,11 @@
 #include "SkMutex.h"
 #include "SkOSFile.h"
 #include "SkRefCnt.h"
+#include "SkSharedMutex.h"
 #include "SkStream.h"
 #include "SkString.h"
 #include "SkTDArray.h"
+#include "SkTHash.h"
 #include "SkTemplates.h"
 #include "SkTypeface.h"
 #include "SkTypefaceCache.h"
@@ -699,6 +701,108 @@ class SkFontMgr_fontconfig : public SkFontMgr {
         return face;
     }
 
+    /** The fonts fontconfig would fall back to for one family, style and set of languages, and
+     *  which of them each character looked up so far was matched to.
+     *
+     *  Matching a character to its fallback ranks coverage of the character above everything else
+     *  in the request, so the matched font is always the best of the sorted fonts which contain
+     *  the character. The sort only needs to happen once per request, after which each new
+     *  character is a walk down the list testing each font's FcCharSet.
+     */
+    struct FallbackList {
+        SkAutoFcPattern fPattern;  // The substituted request, without a character set.
+        SkAutoFcFontSet fFonts;    // Every font, best first for fPattern.
+        SkTHashMap<int, sk_sp<SkTypeface>> fTypefaces;  // By index in fFonts, null if unusable.
+        SkTHashMap<SkUnichar, int> fFontForCharacter;   // Index in fFonts, -1 if none has it.
+    };
+
+    // Requests past this many are matched by fontconfig each time instead of being remembered.
+    static constexpr int kMaxFallbackLists = 64;
+
+    /** Guards fFallbacks and the lists in it. Always acquired before FCLocker. */
+    mutable SkSharedMutex fFallbackMutex;
+    mutable SkTHashMap<SkString, std::unique_ptr<FallbackList>> fFallbacks;
+
+    static SkString FallbackKey(const char familyName[], const SkFontStyle& style,
+                                const char* bcp47[], int bcp47Count) {
+        SkString key;
+        key.printf("%c%s:%d:%d:%d", familyName ? 'f' : '-', familyName ? familyName : "",
+                   style.weight(), style.width(), style.slant());
+        for (int i = 0; i < bcp47Count; ++i) {
+            key.appendf(":%s", bcp47[i]);
+        }
+        return key;
+    }
+
+    /** Adds the family, style and languages of a character match to pattern. */
+    static void AddCharacterRequest(FcPattern* pattern, const char familyName[],
+                                    const SkFontStyle& style,
+                                    const char* bcp47[], int bcp47Count) {
+        if (familyName) {
+            FcValue familyNameValue;
+            familyNameValue.type = FcTypeString;
+            familyNameValue.u.s = reinterpret_cast<const FcChar8*>(familyName);
+            FcPatternAddWeak(pattern, FC_FAMILY, familyNameValue, FcFalse);
+        }
+        fcpattern_from_skfontstyle(style, pattern);
+
+        if (bcp47Count > 0) {
+            SkASSERT(bcp47);
+            SkAutoFcLangSet langSet;
+            for (int i = bcp47Count; i --> 0;) {
+                FcLangSetAdd(langSet, (const FcChar8*)bcp47[i]);
+            }
+            FcPatternAddLangSet(pattern, FC_LANG, langSet);
+        }
+    }
+
+    std::unique_ptr<FallbackList> makeFallbackList(const char familyName[],
+                                                   const SkFontStyle& style,
+                                                   const char* bcp47[], int bcp47Count) const {
+        FCLocker::AssertHeld();
+        auto list = skstd::make_unique<FallbackList>();
+        AddCharacterRequest(list->fPattern, familyName, style, bcp47, bcp47Count);
+        FcConfigSubstitute(fFC, list->fPattern, FcMatchPattern);
+        FcDefaultSubstitute(list->fPattern);
+
+        FcResult result;
+        list->fFonts.reset(FcFontSort(fFC, list->fPattern, FcFalse, nullptr, &result));
+        if (!list->fFonts.get()) {
+            list->fFonts.reset(FcFontSetCreate());
+        }
+        return list;
+    }
+
+    /** Finds the fallback for a character the list hasn't seen yet. */
+    sk_sp<SkTypeface> matchFallback(FallbackList* list, SkUnichar character) const {
+        FCLocker::AssertHeld();
+        int index = -1;
+        for (int i = 0; i < list->fFonts->nfont; ++i) {
+            if (FontContainsCharacter(list->fFonts->fonts[i], character)) {
+                index = i;
+                break;
+            }
+        }
+        list->fFontForCharacter.set(character, index);
+        if (index < 0) {
+            return nullptr;
+        }
+        if (sk_sp<SkTypeface>* face = list->fTypefaces.find(index)) {
+            return *face;
+        }
+
+        sk_sp<SkTypeface> face;
+        FcPattern* font = list->fFonts->fonts[index];
+        if (FontAccessible(font)) {
+            SkAutoFcPattern prepared(FcFontRenderPrepare(fFC, list->fPattern, font));
+            if (prepared.get()) {
+                face = this->createTypefaceFromFcPattern(prepared);
+            }
+        }
+        list->fTypefaces.set(index, face);
+        return face;
+    }
+
 public:
     /** Takes control of the reference to 'config'. */
     explicit SkFontMgr_fontconfig(FcConfig* config)
@@ -706,8 +810,14 @@ public:
         , fFamilyNames(GetFamilyNames(fFC)) { }
 
     ~SkFontMgr_fontconfig() override {
-        // Hold the lock while unrefing the config.
+        // Typefaces lock when destroyed, so release the fallback typefaces before locking.
+        fFallbacks.foreach([](const SkString&, std::unique_ptr<FallbackList>* list) {
+            (*list)->fTypefaces.reset();
+        });
+
+        // Hold the lock while unrefing the fallback patterns and the config.
         FCLocker lock;
+        fFallbacks.reset();
         fFC.reset();
     }
 
@@ -877,30 +987,43 @@ protected:
                                             int bcp47Count,
                                             SkUnichar character) const override
     {
+        const SkString key = FallbackKey(familyName, style, bcp47, bcp47Count);
+        {
+            SkAutoSharedMutexShared shared(fFallbackMutex);
+            if (std::unique_ptr<FallbackList>* list = fFallbacks.find(key)) {
+                if (int* index = (*list)->fFontForCharacter.find(character)) {
+                    return *index < 0 ? nullptr
+                                      : SkSafeRef((*list)->fTypefaces.find(*index)->get());
+                }
+            }
+        }
+        {
+            SkAutoExclusive exclusive(fFallbackMutex);
+            FCLocker lock;
+            std::unique_ptr<FallbackList>* list = fFallbacks.find(key);
+            if (!list && fFallbacks.count() < kMaxFallbackLists) {
+                list = fFallbacks.set(key, this->makeFallbackList(familyName, style,
+                                                                  bcp47, bcp47Count));
+            }
+            if (list) {
+                if (int* index = (*list)->fFontForCharacter.find(character)) {
+                    return *index < 0 ? nullptr
+                                      : SkSafeRef((*list)->fTypefaces.find(*index)->get());
+                }
+                return this->matchFallback(list->get(), character).release();
+            }
+        }
+
+        // Too many different requests to remember; ask fontconfig for this one.
         FCLocker lock;
 
         SkAutoFcPattern pattern;
-        if (familyName) {
-            FcValue familyNameValue;
-            familyNameValue.type = FcTypeString;
-            familyNameValue.u.s = reinterpret_cast<const FcChar8*>(familyName);
-            FcPatternAddWeak(pattern, FC_FAMILY, familyNameValue, FcFalse);
-        }
-        fcpattern_from_skfontstyle(style, pattern);
+        AddCharacterRequest(pattern, familyName, style, bcp47, bcp47Count);
 
         SkAutoFcCharSet charSet;
         FcCharSetAddChar(charSet, character);
         FcPatternAddCharSet(pattern, FC_CHARSET, charSet);
 
-        if (bcp47Count > 0) {
-            SkASSERT(bcp47);
-            SkAutoFcLangSet langSet;
-            for (int i = bcp47Count; i --> 0;) {
-                FcLangSetAdd(langSet, (const FcChar8*)bcp47[i]);
-            }
-            FcPatternAddLangSet(pattern, FC_LANG, langSet);
-        }
-
         FcConfigSubstitute(fFC, pattern, FcMatchPattern);
         FcDefaultSubstitute(pattern);
 
@@ -6,6 +6,7 @@
  */
 
 #include "SkMalloc.h"
+#include "SkMallocStats.h"
 
 #include <cstdlib>
 
@@ -54,11 +55,21 @@ void sk_out_of_memory(void) {
 }
 
 void* sk_realloc_throw(void* addr, size_t size) {
+#if SK_METRICS_ENABLED
+    SkMallocStats::RecordFree(addr);
+    void* p = throw_on_failure(size, realloc(addr, size));
+    SkMallocStats::RecordAlloc(p);
+    return p;
+#else
     return throw_on_failure(size, realloc(addr, size));
+#endif
 }
 
 void sk_free(void* p) {
     if (p) {
+#if SK_METRICS_ENABLED
+        SkMallocStats::RecordFree(p);
+#endif
         free(p);
     }
 }
@@ -70,6 +81,9 @@ void* sk_malloc_flags(size_t size, unsigned flags) {
     } else {
         p = malloc(size);
     }
+#if SK_METRICS_ENABLED
+    SkMallocStats::RecordAlloc(p);
+#endif
     if (flags & SK_MALLOC_THROW) {
         return throw_on_failure(size, p);
     } else {
@@ -94,6 +94,20 @@ struct BitmapShaderRec : public SkResourceCache::Rec {
     }
 };
 
+// Snaps a tile scale up to the next of kScaleStepsPerOctave steps per power of two, so a smoothly
+// changing scale (an animated zoom, say) keeps reusing the same few tiles.  Tiles are drawn at
+// most about 19% larger than needed; scales that are already on a step are kept as they are.
+static constexpr SkScalar kScaleStepsPerOctave = 4;
+
+SkScalar bucket_scale(SkScalar scale) {
+    if (!(scale > 0) || !SkScalarIsFinite(scale)) {
+        return scale;
+    }
+    // Allow a little slop, so float noise in an exact step (e.g. 1.0000001) doesn't bump it up.
+    SkScalar level = sk_float_ceil(sk_float_log2(scale) * kScaleStepsPerOctave - 1e-3f);
+    return sk_float_pow(2, level / kScaleStepsPerOctave);
+}
+
 uint32_t next_id() {
     static std::atomic<uint32_t> nextID{1};
 
@@ -181,8 +195,8 @@ sk_sp<SkShader> SkPictureShader::refBitmapShader(const SkMatrix& viewMatrix,
         scale.set(SkScalarSqrt(m.getScaleX() * m.getScaleX() + m.getSkewX() * m.getSkewX()),
                   SkScalarSqrt(m.getScaleY() * m.getScaleY() + m.getSkewY() * m.getSkewY()));
     }
-    SkSize scaledSize = SkSize::Make(SkScalarAbs(scale.x() * fTile.width()),
-                                     SkScalarAbs(scale.y() * fTile.height()));
+    SkSize scaledSize = SkSize::Make(bucket_scale(SkScalarAbs(scale.x())) * fTile.width(),
+                                     bucket_scale(SkScalarAbs(scale.y())) * fTile.height());
 
     // Clamp the tile size to about 4M pixels
     static const SkScalar kMaxTileArea = 2048 * 2048;
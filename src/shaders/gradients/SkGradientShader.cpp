@@ -15,8 +15,10 @@
 #include "SkHalf.h"
 #include "SkLinearGradient.h"
 #include "SkMallocPixelRef.h"
+#include "SkOpts.h"
 #include "SkRadialGradient.h"
 #include "SkReadBuffer.h"
+#include "SkResourceCache.h"
 #include "SkSweepGradient.h"
 #include "SkTwoPointConicalGradient.h"
 #include "SkWriteBuffer.h"
@@ -271,6 +273,111 @@ static void init_stop_pos(
     add_stop_color(ctx, stop, Fs, Bs);
 }
 
+namespace {
+
+// Gradients with at least this many stops look up their colors in a table rather than searching
+// for the stop around each pixel's t.  Fewer stops are about as fast to search.
+static constexpr size_t kGradientLUTMinStops = 16;
+static constexpr int    kGradientLUTSize     = 1024;
+
+static unsigned gGradientLUTKeyNamespaceLabel;
+
+struct GradientLUTKey : public SkResourceCache::Key {
+public:
+    GradientLUTKey(uint32_t hash, uint32_t count) : fHash(hash), fCount(count) {
+        this->init(&gGradientLUTKeyNamespaceLabel, 0, sizeof(fHash) + sizeof(fCount));
+    }
+
+    uint32_t fHash;
+    uint32_t fCount;
+};
+
+// A table is identified by everything that went into its gradient's SkRasterPipeline_GradientCtx.
+// That's too much for a key, so the key is its hash and each Rec keeps the whole thing to compare.
+struct GradientLUTRec : public SkResourceCache::Rec {
+    GradientLUTRec(const GradientLUTKey& key, SkTDArray<float> recipe, sk_sp<SkData> lut)
+        : fKey(key), fRecipe(std::move(recipe)), fLUT(std::move(lut)) {}
+
+    GradientLUTKey   fKey;
+    SkTDArray<float> fRecipe;
+    sk_sp<SkData>    fLUT;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override {
+        return sizeof(*this) + fRecipe.bytes() + fLUT->size();
+    }
+    const char* getCategory() const override { return "gradient-lut"; }
+
+    struct Context {
+        const SkTDArray<float>* recipe;
+        sk_sp<SkData>*          lut;
+    };
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* context) {
+        const GradientLUTRec& rec = static_cast<const GradientLUTRec&>(baseRec);
+        auto ctx = static_cast<Context*>(context);
+        if (rec.fRecipe.count() != ctx->recipe->count() ||
+            0 != memcmp(rec.fRecipe.begin(), ctx->recipe->begin(), rec.fRecipe.bytes())) {
+            return false;  // A hash collision; this Rec will make way for the new one.
+        }
+        *ctx->lut = rec.fLUT;
+        return true;
+    }
+};
+
+}  // namespace
+
+// Returns an SkRasterPipeline_GradientLUTCtx followed by the colors it points to, sampled from
+// the gradient ctx describes.
+static sk_sp<SkData> find_or_make_gradient_lut(const SkRasterPipeline_GradientCtx* ctx) {
+    const int n = SkToInt(ctx->stopCount);
+
+    SkTDArray<float> recipe;
+    recipe.setReserve(9*n);
+    *recipe.append() = ctx->interpolatedInPremul ? 1.0f : 0.0f;
+    for (int i = 0; i < 4; i++) {
+        recipe.append(n, ctx->fs[i]);
+        recipe.append(n, ctx->bs[i]);
+    }
+    if (ctx->ts) {
+        recipe.append(n - 1, ctx->ts + 1);  // ts[0] is never read.
+    }
+
+    GradientLUTKey key(SkOpts::hash(recipe.begin(), recipe.bytes()), recipe.count());
+    sk_sp<SkData> data;
+    GradientLUTRec::Context context = { &recipe, &data };
+    if (SkResourceCache::Find(key, GradientLUTRec::Visitor, &context)) {
+        return data;
+    }
+
+    data = SkData::MakeUninitialized(sizeof(SkRasterPipeline_GradientLUTCtx) +
+                                     (kGradientLUTSize + 1) * 4 * sizeof(float));
+    auto lut  = static_cast<SkRasterPipeline_GradientLUTCtx*>(data->writable_data());
+    auto rgba = reinterpret_cast<float*>(lut + 1);
+    for (int i = 0; i < kGradientLUTSize; i++) {
+        // The same math as the gradient and evenly_spaced_gradient stages, one t at a time.
+        float t = i * (1.0f / (kGradientLUTSize - 1));
+        int idx = 0;
+        if (ctx->ts) {
+            for (int stop = 1; stop < n; stop++) {
+                idx += t >= ctx->ts[stop] ? 1 : 0;
+            }
+        } else {
+            idx = (int)(t * (n - 1));
+        }
+        for (int ch = 0; ch < 4; ch++) {
+            rgba[4*i + ch] = t * ctx->fs[ch][idx] + ctx->bs[ch][idx];
+        }
+    }
+    memcpy(rgba + 4*kGradientLUTSize, rgba + 4*(kGradientLUTSize - 1), 4 * sizeof(float));
+    lut->rgba                 = rgba;
+    lut->size                 = kGradientLUTSize;
+    lut->interpolatedInPremul = ctx->interpolatedInPremul;
+
+    SkResourceCache::Add(new GradientLUTRec(key, std::move(recipe), data));
+    return data;
+}
+
 bool SkGradientShaderBase::onAppendStages(const StageRec& rec) const {
     SkRasterPipeline* p = rec.fPipeline;
     SkArenaAlloc* alloc = rec.fAlloc;
@@ -282,6 +389,39 @@ bool SkGradientShaderBase::onAppendStages(const StageRec& rec) const {
     }
     matrix.postConcat(fPtsToUnit);
 
+    const bool premulGrad = fGradFlags & SkGradientShader::kInterpolateColorsInPremul_Flag;
+
+    // Transform all of the colors to destination color space
+    SkColor4fXformer xformedColors(fOrigColors4f, fColorCount, fColorSpace.get(), rec.fDstCS);
+
+    auto prepareColor = [premulGrad, &xformedColors](int i) {
+        SkColor4f c = xformedColors.fColors[i];
+        return premulGrad ? c.premul()
+                          : SkPMColor4f{ c.fR, c.fG, c.fB, c.fA };
+    };
+
+    // Clamped linear gradients with two evenly spaced stops are common enough to fold
+    // seed_shader, the matrix, clamp_x_1 and evenly_spaced_2_stop_gradient into one stage.
+    if (fColorCount == 2 && fOrigPos == nullptr && fTileMode == kClamp_TileMode &&
+        !matrix.hasPerspective() && kLinear_GradientType == this->asAGradient(nullptr)) {
+        const SkPMColor4f c_l = prepareColor(0),
+                          c_r = prepareColor(1);
+
+        auto ctx = alloc->make<SkRasterPipeline_Linear2StopGradientCtx>();
+        ctx->tx = matrix.getScaleX();
+        ctx->ty = matrix.getSkewX();
+        ctx->t0 = matrix.getTranslateX();
+        (Sk4f::Load(c_r.vec()) - Sk4f::Load(c_l.vec())).store(ctx->stops.f);
+        (                        Sk4f::Load(c_l.vec())).store(ctx->stops.b);
+        ctx->stops.interpolatedInPremul = premulGrad;
+
+        p->append(SkRasterPipeline::linear_2_stop_gradient, ctx);
+        if (!premulGrad && !this->colorsAreOpaque()) {
+            p->append(SkRasterPipeline::premul);
+        }
+        return true;
+    }
+
     SkRasterPipeline_<256> postPipeline;
 
     p->append(SkRasterPipeline::seed_shader);
@@ -308,17 +448,6 @@ bool SkGradientShaderBase::onAppendStages(const StageRec& rec) const {
             break;
     }
 
-    const bool premulGrad = fGradFlags & SkGradientShader::kInterpolateColorsInPremul_Flag;
-
-    // Transform all of the colors to destination color space
-    SkColor4fXformer xformedColors(fOrigColors4f, fColorCount, fColorSpace.get(), rec.fDstCS);
-
-    auto prepareColor = [premulGrad, &xformedColors](int i) {
-        SkColor4f c = xformedColors.fColors[i];
-        return premulGrad ? c.premul()
-                          : SkPMColor4f{ c.fR, c.fG, c.fB, c.fA };
-    };
-
     // The two-stop case with stops at 0 and 1.
     if (fColorCount == 2 && fOrigPos == nullptr) {
         const SkPMColor4f c_l = prepareColor(0),
@@ -334,13 +463,14 @@ bool SkGradientShaderBase::onAppendStages(const StageRec& rec) const {
     } else {
         auto* ctx = alloc->make<SkRasterPipeline_GradientCtx>();
         ctx->interpolatedInPremul = premulGrad;
+        SkRasterPipeline::StockStage stage;
 
         // Note: In order to handle clamps in search, the search assumes a stop conceptully placed
         // at -inf. Therefore, the max number of stops is fColorCount+1.
         for (int i = 0; i < 4; i++) {
-            // Allocate at least at for the AVX2 gather from a YMM register.
-            ctx->fs[i] = alloc->makeArray<float>(std::max(fColorCount+1, 8));
-            ctx->bs[i] = alloc->makeArray<float>(std::max(fColorCount+1, 8));
+            // Allocate at least enough for the AVX-512 permute from a ZMM register.
+            ctx->fs[i] = alloc->makeArray<float>(std::max(fColorCount+1, 16));
+            ctx->bs[i] = alloc->makeArray<float>(std::max(fColorCount+1, 16));
         }
 
         if (fOrigPos == nullptr) {
@@ -358,7 +488,7 @@ bool SkGradientShaderBase::onAppendStages(const StageRec& rec) const {
             add_const_color(ctx, stopCount - 1, c_l);
 
             ctx->stopCount = stopCount;
-            p->append(SkRasterPipeline::evenly_spaced_gradient, ctx);
+            stage = SkRasterPipeline::evenly_spaced_gradient;
         } else {
             // Handle arbitrary stops.
 
@@ -398,7 +528,15 @@ bool SkGradientShaderBase::onAppendStages(const StageRec& rec) const {
             add_const_color(ctx, stopCount++, c_l);
 
             ctx->stopCount = stopCount;
-            p->append(SkRasterPipeline::gradient, ctx);
+            stage = SkRasterPipeline::gradient;
+        }
+
+        if (ctx->stopCount >= kGradientLUTMinStops) {
+            // The arena holds a ref to the table for as long as the pipeline might run.
+            sk_sp<SkData>* lut = alloc->make<sk_sp<SkData>>(find_or_make_gradient_lut(ctx));
+            p->append(SkRasterPipeline::gradient_lut, (*lut)->data());
+        } else {
+            p->append(stage, ctx);
         }
     }
 
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SKSL_BYTECODE
+#define SKSL_BYTECODE
+
+#include "SkSLInterpreter.h"
+
+#include <vector>
+
+namespace SkSL {
+
+/**
+ * A function compiled by ByteCodeGenerator, run by Interpreter::Run. Every instruction reads its
+ * operands from and writes its result to slots of a flat register file, so running it involves no
+ * tree traversal, variable lookups or stack traffic.
+ *
+ * The register file starts with the function's parameters, followed by its local variables and
+ * expression temporaries, and ends with fConstants, which callers copy in once at fConstantBase
+ * before running the function any number of times.
+ */
+struct ByteCode {
+    enum class Op : uint8_t {
+        // fDst = fA
+        kCopy,
+
+        // fDst = fA op fB
+        kAddF, kAddI,
+        kSubF, kSubI,
+        kMulF, kMulI,
+        kDivF, kDivI,
+        kAndI, kOrI, kXorI,
+        kLtF, kLtI,
+        kGtF, kGtI,
+        kLteqF, kLteqI,
+        kGteqF, kGteqI,
+        kEqF, kEqI,
+        kNeqF, kNeqI,
+
+        // fDst = op fA
+        kNegF, kNegI,
+        kNotB,
+
+        // Continues at instruction fDst
+        kJump,
+        // Continues at instruction fDst if fA is false
+        kBranchIfFalse,
+
+        kReturn,
+    };
+
+    struct Instruction {
+        Op       fOp;
+        uint16_t fDst;
+        uint16_t fA;
+        uint16_t fB;
+    };
+
+    std::vector<Instruction>        fCode;
+    std::vector<Interpreter::Value> fConstants;
+    int                             fParameterCount = 0;
+    int                             fConstantBase = 0;
+    int                             fSlotCount = 0;
+};
+
+} // namespace
+
+#endif
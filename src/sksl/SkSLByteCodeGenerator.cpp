@@ -0,0 +1,436 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SKSL_STANDALONE
+
+#include "SkSLByteCodeGenerator.h"
+#include "ir/SkSLBinaryExpression.h"
+#include "ir/SkSLBlock.h"
+#include "ir/SkSLBoolLiteral.h"
+#include "ir/SkSLDoStatement.h"
+#include "ir/SkSLExpressionStatement.h"
+#include "ir/SkSLFloatLiteral.h"
+#include "ir/SkSLForStatement.h"
+#include "ir/SkSLIfStatement.h"
+#include "ir/SkSLIntLiteral.h"
+#include "ir/SkSLPostfixExpression.h"
+#include "ir/SkSLPrefixExpression.h"
+#include "ir/SkSLReturnStatement.h"
+#include "ir/SkSLTernaryExpression.h"
+#include "ir/SkSLVarDeclarations.h"
+#include "ir/SkSLVarDeclarationsStatement.h"
+#include "ir/SkSLVariableReference.h"
+#include "ir/SkSLWhileStatement.h"
+
+namespace SkSL {
+
+static Interpreter::TypeKind type_kind(const Type& type) {
+    if (type.fName == "int") {
+        return Interpreter::kInt_TypeKind;
+    } else if (type.fName == "float") {
+        return Interpreter::kFloat_TypeKind;
+    } else if (type.fName == "bool") {
+        return Interpreter::kBool_TypeKind;
+    }
+    ABORT("unsupported type: %s\n", type.description().c_str());
+}
+
+// Picks the float or int flavor of an operator based on its operand type.
+static ByteCode::Op typed_op(const Type& type, ByteCode::Op floatOp, ByteCode::Op intOp) {
+    switch (type_kind(type)) {
+        case Interpreter::kFloat_TypeKind:
+            return floatOp;
+        case Interpreter::kInt_TypeKind:
+            return intOp;
+        default:
+            ABORT("unsupported type: %s\n", type.description().c_str());
+    }
+}
+
+static ByteCode::Op int_op(const Type& type, ByteCode::Op op) {
+    if (Interpreter::kInt_TypeKind != type_kind(type)) {
+        ABORT("unsupported type: %s\n", type.description().c_str());
+    }
+    return op;
+}
+
+std::unique_ptr<ByteCode> ByteCodeGenerator::generate(const FunctionDefinition& f) {
+    fByteCode.reset(new ByteCode());
+    fVariables.clear();
+    fLoops.clear();
+    fReturns.clear();
+    fLocalCount = 0;
+    fTempCount = 0;
+    fMaxSlotCount = 0;
+
+    for (const Variable* p : f.fDeclaration.fParameters) {
+        type_kind(p->fType);
+        fVariables[p] = this->allocLocal();
+    }
+    fByteCode->fParameterCount = fLocalCount;
+    this->writeStatement(*f.fBody);
+    this->patch(fReturns, fByteCode->fCode.size());
+    this->emit(ByteCode::Op::kReturn);
+    this->resolveConstants();
+    return std::move(fByteCode);
+}
+
+uint16_t ByteCodeGenerator::allocLocal() {
+    SkASSERT(!fTempCount);
+    uint16_t result = fLocalCount++;
+    fMaxSlotCount = SkTMax(fMaxSlotCount, fLocalCount);
+    return result;
+}
+
+uint16_t ByteCodeGenerator::allocTemp() {
+    uint16_t result = fLocalCount + fTempCount++;
+    fMaxSlotCount = SkTMax(fMaxSlotCount, fLocalCount + fTempCount);
+    if (fMaxSlotCount >= kConstant_Flag) {
+        ABORT("too many slots\n");
+    }
+    return result;
+}
+
+uint16_t ByteCodeGenerator::constant(Interpreter::Value value) {
+    std::vector<Interpreter::Value>& constants = fByteCode->fConstants;
+    for (size_t i = 0; i < constants.size(); ++i) {
+        if (constants[i].fInt == value.fInt) {
+            return kConstant_Flag | i;
+        }
+    }
+    if (constants.size() >= kConstant_Flag) {
+        ABORT("too many constants\n");
+    }
+    constants.push_back(value);
+    return kConstant_Flag | (constants.size() - 1);
+}
+
+size_t ByteCodeGenerator::emit(ByteCode::Op op, uint16_t dst, uint16_t a, uint16_t b) {
+    fByteCode->fCode.push_back({ op, dst, a, b });
+    return fByteCode->fCode.size() - 1;
+}
+
+void ByteCodeGenerator::patch(size_t index) {
+    this->patch({ index }, fByteCode->fCode.size());
+}
+
+void ByteCodeGenerator::patch(const std::vector<size_t>& indices, size_t target) {
+    if (target >= kConstant_Flag) {
+        ABORT("function too large\n");
+    }
+    for (size_t index : indices) {
+        ByteCode::Instruction& inst = fByteCode->fCode[index];
+        SkASSERT(ByteCode::Op::kJump == inst.fOp || ByteCode::Op::kBranchIfFalse == inst.fOp);
+        inst.fDst = target;
+    }
+}
+
+uint16_t ByteCodeGenerator::getLValue(const Expression& expr) {
+    if (Expression::kVariableReference_Kind == expr.fKind) {
+        const Variable* var = &((const VariableReference&) expr).fVariable;
+        SkASSERT(fVariables.find(var) != fVariables.end());
+        return fVariables[var];
+    }
+    ABORT("unsupported lvalue: %s\n", expr.description().c_str());
+}
+
+uint16_t ByteCodeGenerator::writeBinaryExpression(const Expression& expr) {
+    using Op = ByteCode::Op;
+    const BinaryExpression& b = (const BinaryExpression&) expr;
+    const Type& type = b.fLeft->fType;
+    // Compound assignments use the same instructions as their plain operators.
+    Token::Kind op = b.fOperator;
+    bool compound = true;
+    switch (op) {
+        case Token::PLUSEQ:       op = Token::PLUS;       break;
+        case Token::MINUSEQ:      op = Token::MINUS;      break;
+        case Token::STAREQ:       op = Token::STAR;       break;
+        case Token::SLASHEQ:      op = Token::SLASH;      break;
+        case Token::BITWISEANDEQ: op = Token::BITWISEAND; break;
+        case Token::BITWISEOREQ:  op = Token::BITWISEOR;  break;
+        case Token::BITWISEXOREQ: op = Token::BITWISEXOR; break;
+        default:                  compound = false;       break;
+    }
+    Op inst;
+    switch (op) {
+        case Token::LOGICALAND:
+        case Token::LOGICALOR: {
+            uint16_t result = this->allocTemp();
+            this->emit(Op::kCopy, result, this->writeExpression(*b.fLeft));
+            size_t skip;
+            if (Token::LOGICALAND == op) {
+                skip = this->emit(Op::kBranchIfFalse, 0, result);
+            } else {
+                size_t evaluateRight = this->emit(Op::kBranchIfFalse, 0, result);
+                skip = this->emit(Op::kJump);
+                this->patch(evaluateRight);
+            }
+            this->emit(Op::kCopy, result, this->writeExpression(*b.fRight));
+            this->patch(skip);
+            return result;
+        }
+        case Token::EQ: {
+            uint16_t left = this->getLValue(*b.fLeft);
+            this->emit(Op::kCopy, left, this->writeExpression(*b.fRight));
+            return left;
+        }
+        case Token::PLUS:       inst = typed_op(type, Op::kAddF,  Op::kAddI);  break;
+        case Token::MINUS:      inst = typed_op(type, Op::kSubF,  Op::kSubI);  break;
+        case Token::STAR:       inst = typed_op(type, Op::kMulF,  Op::kMulI);  break;
+        case Token::SLASH:      inst = typed_op(type, Op::kDivF,  Op::kDivI);  break;
+        case Token::LT:         inst = typed_op(type, Op::kLtF,   Op::kLtI);   break;
+        case Token::GT:         inst = typed_op(type, Op::kGtF,   Op::kGtI);   break;
+        case Token::LTEQ:       inst = typed_op(type, Op::kLteqF, Op::kLteqI); break;
+        case Token::GTEQ:       inst = typed_op(type, Op::kGteqF, Op::kGteqI); break;
+        case Token::EQEQ:       inst = typed_op(type, Op::kEqF,   Op::kEqI);   break;
+        case Token::NEQ:        inst = typed_op(type, Op::kNeqF,  Op::kNeqI);  break;
+        case Token::BITWISEAND: inst = int_op(type, Op::kAndI);                break;
+        case Token::BITWISEOR:  inst = int_op(type, Op::kOrI);                 break;
+        case Token::BITWISEXOR: inst = int_op(type, Op::kXorI);                break;
+        default:
+            ABORT("unsupported operator: %s\n", expr.description().c_str());
+    }
+    if (compound) {
+        uint16_t left = this->getLValue(*b.fLeft);
+        this->emit(inst, left, left, this->writeExpression(*b.fRight));
+        return left;
+    }
+    uint16_t left = this->writeExpression(*b.fLeft);
+    if (b.fRight->hasSideEffects() && left < fLocalCount) {
+        // The right side may change the variable we read the left side from.
+        uint16_t copy = this->allocTemp();
+        this->emit(Op::kCopy, copy, left);
+        left = copy;
+    }
+    uint16_t right = this->writeExpression(*b.fRight);
+    uint16_t result = this->allocTemp();
+    this->emit(inst, result, left, right);
+    return result;
+}
+
+uint16_t ByteCodeGenerator::writeExpression(const Expression& expr) {
+    using Op = ByteCode::Op;
+    switch (expr.fKind) {
+        case Expression::kBinary_Kind:
+            return this->writeBinaryExpression(expr);
+        case Expression::kBoolLiteral_Kind: {
+            Interpreter::Value value(0);
+            value.fBool = ((const BoolLiteral&) expr).fValue;
+            return this->constant(value);
+        }
+        case Expression::kFloatLiteral_Kind:
+            return this->constant(Interpreter::Value((float) ((const FloatLiteral&) expr).fValue));
+        case Expression::kIntLiteral_Kind:
+            return this->constant(Interpreter::Value((int) ((const IntLiteral&) expr).fValue));
+        case Expression::kPrefix_Kind: {
+            const PrefixExpression& p = (const PrefixExpression&) expr;
+            switch (p.fOperator) {
+                case Token::PLUS:
+                    return this->writeExpression(*p.fOperand);
+                case Token::MINUS: {
+                    uint16_t operand = this->writeExpression(*p.fOperand);
+                    uint16_t result = this->allocTemp();
+                    this->emit(typed_op(p.fType, Op::kNegF, Op::kNegI), result, operand);
+                    return result;
+                }
+                case Token::LOGICALNOT: {
+                    uint16_t operand = this->writeExpression(*p.fOperand);
+                    uint16_t result = this->allocTemp();
+                    this->emit(Op::kNotB, result, operand);
+                    return result;
+                }
+                case Token::PLUSPLUS:
+                case Token::MINUSMINUS: {
+                    uint16_t lvalue = this->getLValue(*p.fOperand);
+                    bool isFloat = Interpreter::kFloat_TypeKind == type_kind(p.fType);
+                    uint16_t one = isFloat ? this->constant(Interpreter::Value(1.0f))
+                                           : this->constant(Interpreter::Value(1));
+                    this->emit(Token::PLUSPLUS == p.fOperator
+                                       ? typed_op(p.fType, Op::kAddF, Op::kAddI)
+                                       : typed_op(p.fType, Op::kSubF, Op::kSubI),
+                               lvalue, lvalue, one);
+                    return lvalue;
+                }
+                default:
+                    break;
+            }
+            break;
+        }
+        case Expression::kPostfix_Kind: {
+            const PostfixExpression& p = (const PostfixExpression&) expr;
+            uint16_t lvalue = this->getLValue(*p.fOperand);
+            bool isFloat = Interpreter::kFloat_TypeKind == type_kind(p.fType);
+            uint16_t one = isFloat ? this->constant(Interpreter::Value(1.0f))
+                                   : this->constant(Interpreter::Value(1));
+            uint16_t result = this->allocTemp();
+            this->emit(Op::kCopy, result, lvalue);
+            if (Token::PLUSPLUS == p.fOperator) {
+                this->emit(typed_op(p.fType, Op::kAddF, Op::kAddI), lvalue, lvalue, one);
+            } else {
+                SkASSERT(Token::MINUSMINUS == p.fOperator);
+                this->emit(typed_op(p.fType, Op::kSubF, Op::kSubI), lvalue, lvalue, one);
+            }
+            return result;
+        }
+        case Expression::kTernary_Kind: {
+            const TernaryExpression& t = (const TernaryExpression&) expr;
+            uint16_t result = this->allocTemp();
+            size_t ifFalse = this->emit(Op::kBranchIfFalse, 0, this->writeExpression(*t.fTest));
+            this->emit(Op::kCopy, result, this->writeExpression(*t.fIfTrue));
+            size_t end = this->emit(Op::kJump);
+            this->patch(ifFalse);
+            this->emit(Op::kCopy, result, this->writeExpression(*t.fIfFalse));
+            this->patch(end);
+            return result;
+        }
+        case Expression::kVariableReference_Kind:
+            return this->getLValue(expr);
+        default:
+            break;
+    }
+    ABORT("unsupported expression: %s\n", expr.description().c_str());
+}
+
+void ByteCodeGenerator::writeStatement(const Statement& stmt) {
+    using Op = ByteCode::Op;
+    // Temporaries never outlive the statement that computes them.
+    int tempCount = fTempCount;
+    switch (stmt.fKind) {
+        case Statement::kBlock_Kind:
+            for (const auto& s : ((const Block&) stmt).fStatements) {
+                this->writeStatement(*s);
+            }
+            break;
+        case Statement::kBreak_Kind:
+            SkASSERT(fLoops.size());
+            fLoops.back().fBreaks.push_back(this->emit(Op::kJump));
+            break;
+        case Statement::kContinue_Kind:
+            SkASSERT(fLoops.size());
+            fLoops.back().fContinues.push_back(this->emit(Op::kJump));
+            break;
+        case Statement::kDo_Kind: {
+            const DoStatement& d = (const DoStatement&) stmt;
+            fLoops.emplace_back();
+            size_t start = fByteCode->fCode.size();
+            this->writeStatement(*d.fStatement);
+            this->patch(fLoops.back().fContinues, fByteCode->fCode.size());
+            size_t exit = this->emit(Op::kBranchIfFalse, 0, this->writeExpression(*d.fTest));
+            this->patch({ this->emit(Op::kJump) }, start);
+            this->patch(exit);
+            this->patch(fLoops.back().fBreaks, fByteCode->fCode.size());
+            fLoops.pop_back();
+            break;
+        }
+        case Statement::kExpression_Kind:
+            this->writeExpression(*((const ExpressionStatement&) stmt).fExpression);
+            break;
+        case Statement::kFor_Kind: {
+            const ForStatement& f = (const ForStatement&) stmt;
+            if (f.fInitializer) {
+                this->writeStatement(*f.fInitializer);
+            }
+            fLoops.emplace_back();
+            size_t start = fByteCode->fCode.size();
+            std::vector<size_t> exits;
+            if (f.fTest) {
+                exits.push_back(this->emit(Op::kBranchIfFalse, 0,
+                                           this->writeExpression(*f.fTest)));
+                fTempCount = tempCount;
+            }
+            this->writeStatement(*f.fStatement);
+            this->patch(fLoops.back().fContinues, fByteCode->fCode.size());
+            if (f.fNext) {
+                this->writeExpression(*f.fNext);
+                fTempCount = tempCount;
+            }
+            this->patch({ this->emit(Op::kJump) }, start);
+            this->patch(exits, fByteCode->fCode.size());
+            this->patch(fLoops.back().fBreaks, fByteCode->fCode.size());
+            fLoops.pop_back();
+            break;
+        }
+        case Statement::kIf_Kind: {
+            const IfStatement& i = (const IfStatement&) stmt;
+            size_t ifFalse = this->emit(Op::kBranchIfFalse, 0, this->writeExpression(*i.fTest));
+            fTempCount = tempCount;
+            this->writeStatement(*i.fIfTrue);
+            if (i.fIfFalse) {
+                size_t end = this->emit(Op::kJump);
+                this->patch(ifFalse);
+                this->writeStatement(*i.fIfFalse);
+                this->patch(end);
+            } else {
+                this->patch(ifFalse);
+            }
+            break;
+        }
+        case Statement::kNop_Kind:
+            break;
+        case Statement::kReturn_Kind:
+            if (((const ReturnStatement&) stmt).fExpression) {
+                ABORT("unsupported statement: %s\n", stmt.description().c_str());
+            }
+            fReturns.push_back(this->emit(Op::kJump));
+            break;
+        case Statement::kVarDeclarations_Kind:
+            for (const auto& decl : ((const VarDeclarationsStatement&) stmt).fDeclaration->fVars) {
+                const VarDeclaration& v = (const VarDeclaration&) *decl;
+                if (v.fSizes.size()) {
+                    ABORT("unsupported statement: %s\n", stmt.description().c_str());
+                }
+                type_kind(v.fVar->fType);
+                uint16_t slot = this->allocLocal();
+                fVariables[v.fVar] = slot;
+                if (v.fValue) {
+                    this->emit(Op::kCopy, slot, this->writeExpression(*v.fValue));
+                    fTempCount = tempCount;
+                }
+            }
+            break;
+        case Statement::kWhile_Kind: {
+            const WhileStatement& w = (const WhileStatement&) stmt;
+            fLoops.emplace_back();
+            size_t start = fByteCode->fCode.size();
+            size_t exit = this->emit(Op::kBranchIfFalse, 0, this->writeExpression(*w.fTest));
+            fTempCount = tempCount;
+            this->writeStatement(*w.fStatement);
+            this->patch({ this->emit(Op::kJump) }, start);
+            this->patch(exit);
+            this->patch(fLoops.back().fContinues, start);
+            this->patch(fLoops.back().fBreaks, fByteCode->fCode.size());
+            fLoops.pop_back();
+            break;
+        }
+        default:
+            ABORT("unsupported statement: %s\n", stmt.description().c_str());
+    }
+    fTempCount = tempCount;
+}
+
+void ByteCodeGenerator::resolveConstants() {
+    fByteCode->fConstantBase = fMaxSlotCount;
+    fByteCode->fSlotCount = fMaxSlotCount + (int) fByteCode->fConstants.size();
+    if (fByteCode->fSlotCount >= kConstant_Flag) {
+        ABORT("too many slots\n");
+    }
+    auto resolve = [this](uint16_t* slot) {
+        if (*slot & kConstant_Flag) {
+            *slot = fByteCode->fConstantBase + (*slot & ~kConstant_Flag);
+        }
+    };
+    for (ByteCode::Instruction& inst : fByteCode->fCode) {
+        // Jump targets live in fDst, and no instruction writes to a constant.
+        SkASSERT(!(inst.fDst & kConstant_Flag));
+        resolve(&inst.fA);
+        resolve(&inst.fB);
+    }
+}
+
+} // namespace
+
+#endif
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SKSL_BYTECODEGENERATOR
+#define SKSL_BYTECODEGENERATOR
+
+#include "SkSLByteCode.h"
+#include "ir/SkSLExpression.h"
+#include "ir/SkSLFunctionDefinition.h"
+#include "ir/SkSLStatement.h"
+
+#include <unordered_map>
+
+namespace SkSL {
+
+/**
+ * Compiles a function to ByteCode. This supports the same subset of SkSL as the tree walking
+ * Interpreter (scalar int, float and bool variables and arithmetic), plus while and do loops,
+ * break, continue and returning from void functions. Anything else aborts.
+ */
+class ByteCodeGenerator {
+public:
+    std::unique_ptr<ByteCode> generate(const FunctionDefinition& f);
+
+private:
+    // Slot indices with this bit set refer to fConstants until resolveConstants() offsets them.
+    static const uint16_t kConstant_Flag = 0x8000;
+
+    struct Loop {
+        std::vector<size_t> fBreaks;
+        std::vector<size_t> fContinues;
+    };
+
+    uint16_t allocLocal();
+
+    uint16_t allocTemp();
+
+    uint16_t constant(Interpreter::Value value);
+
+    size_t emit(ByteCode::Op op, uint16_t dst = 0, uint16_t a = 0, uint16_t b = 0);
+
+    // Points the jump or branch at index to the next instruction emitted.
+    void patch(size_t index);
+
+    void patch(const std::vector<size_t>& indices, size_t target);
+
+    uint16_t getLValue(const Expression& expr);
+
+    uint16_t writeExpression(const Expression& expr);
+
+    uint16_t writeBinaryExpression(const Expression& expr);
+
+    void writeStatement(const Statement& stmt);
+
+    void resolveConstants();
+
+    std::unique_ptr<ByteCode> fByteCode;
+    std::unordered_map<const Variable*, uint16_t> fVariables;
+    std::vector<Loop> fLoops;
+    std::vector<size_t> fReturns;
+    int fLocalCount = 0;
+    int fTempCount = 0;
+    int fMaxSlotCount = 0;
+};
+
+} // namespace
+
+#endif
@@ -1231,6 +1231,26 @@ void Compiler::scanCFG(FunctionDefinition& f) {
     }
 }
 
+void Compiler::loadInclude(Program::Kind kind, const char* text,
+                           std::vector<std::unique_ptr<ProgramElement>>* include,
+                           std::shared_ptr<SymbolTable>* symbols) {
+    if (*symbols) {
+        return;
+    }
+    // Like the includes loaded by the constructor, these go on top of the previous one.
+    Program::Settings settings;
+    fIRGenerator->fSymbolTable = fGeometrySymbolTable;
+    fIRGenerator->start(&settings, nullptr);
+    fIRGenerator->convertProgram(kind, text, strlen(text), *fTypes, include);
+    fIRGenerator->fSymbolTable->markAllFunctionsBuiltin();
+    for (auto& element : *include) {
+        if (element->fKind == ProgramElement::kEnum_Kind) {
+            ((Enum&) *element).fBuiltin = true;
+        }
+    }
+    *symbols = fIRGenerator->fSymbolTable;
+}
+
 std::unique_ptr<Program> Compiler::convertProgram(Program::Kind kind, String text,
                                                   const Program::Settings& settings) {
     fErrorText = "";
@@ -1254,25 +1274,19 @@ std::unique_ptr<Program> Compiler::convertProgram(Program::Kind kind, String tex
             fIRGenerator->start(&settings, inherited);
             break;
         case Program::kFragmentProcessor_Kind:
-            inherited = nullptr;
-            fIRGenerator->start(&settings, nullptr);
-            fIRGenerator->convertProgram(kind, SKSL_FP_INCLUDE, strlen(SKSL_FP_INCLUDE), *fTypes,
-                                         &elements);
-            fIRGenerator->fSymbolTable->markAllFunctionsBuiltin();
+            this->loadInclude(kind, SKSL_FP_INCLUDE, &fFPInclude, &fFPSymbolTable);
+            inherited = &fFPInclude;
+            fIRGenerator->fSymbolTable = fFPSymbolTable;
+            fIRGenerator->start(&settings, inherited);
             break;
         case Program::kPipelineStage_Kind:
-            inherited = nullptr;
-            fIRGenerator->start(&settings, nullptr);
-            fIRGenerator->convertProgram(kind, SKSL_PIPELINE_STAGE_INCLUDE,
-                                         strlen(SKSL_PIPELINE_STAGE_INCLUDE), *fTypes, &elements);
-            fIRGenerator->fSymbolTable->markAllFunctionsBuiltin();
+            this->loadInclude(kind, SKSL_PIPELINE_STAGE_INCLUDE, &fPipelineInclude,
+                              &fPipelineSymbolTable);
+            inherited = &fPipelineInclude;
+            fIRGenerator->fSymbolTable = fPipelineSymbolTable;
+            fIRGenerator->start(&settings, inherited);
             break;
     }
-    for (auto& element : elements) {
-        if (element->fKind == ProgramElement::kEnum_Kind) {
-            ((Enum&) *element).fBuiltin = true;
-        }
-    }
     std::unique_ptr<String> textPtr(new String(std::move(text)));
     fSource = textPtr.get();
     fIRGenerator->convertProgram(kind, textPtr->c_str(), textPtr->size(), *fTypes, &elements);
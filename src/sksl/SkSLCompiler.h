@@ -166,6 +166,14 @@ private:
 
     void scanCFG(FunctionDefinition& f);
 
+    /**
+     * Parses an include the first time a program of its kind is converted, so that later programs
+     * inherit its elements instead of parsing it again.
+     */
+    void loadInclude(Program::Kind kind, const char* text,
+                     std::vector<std::unique_ptr<ProgramElement>>* include,
+                     std::shared_ptr<SymbolTable>* symbols);
+
     Position position(int offset);
 
     std::vector<std::unique_ptr<ProgramElement>> fVertexInclude;
@@ -174,6 +182,10 @@ private:
     std::shared_ptr<SymbolTable> fFragmentSymbolTable;
     std::vector<std::unique_ptr<ProgramElement>> fGeometryInclude;
     std::shared_ptr<SymbolTable> fGeometrySymbolTable;
+    std::vector<std::unique_ptr<ProgramElement>> fFPInclude;
+    std::shared_ptr<SymbolTable> fFPSymbolTable;
+    std::vector<std::unique_ptr<ProgramElement>> fPipelineInclude;
+    std::shared_ptr<SymbolTable> fPipelineSymbolTable;
 
     std::shared_ptr<SymbolTable> fTypes;
     IRGenerator* fIRGenerator;
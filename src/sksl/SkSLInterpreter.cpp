@@ -8,6 +8,8 @@
 #ifndef SKSL_STANDALONE
 
 #include "SkSLInterpreter.h"
+#include "SkSLByteCode.h"
+#include "SkSLByteCodeGenerator.h"
 #include "ir/SkSLBinaryExpression.h"
 #include "ir/SkSLExpressionStatement.h"
 #include "ir/SkSLForStatement.h"
@@ -213,23 +215,78 @@ Interpreter::StackIndex Interpreter::getLValue(const Expression& expr) {
 }
 
 struct CallbackCtx : public SkRasterPipeline_CallbackCtx {
-    Interpreter* fInterpreter;
-    const FunctionDefinition* fFunction;
+    std::unique_ptr<ByteCode> fByteCode;
+    std::vector<Interpreter::Value> fSlots;
 };
 
 static void do_callback(SkRasterPipeline_CallbackCtx* raw, int activePixels) {
     CallbackCtx& ctx = (CallbackCtx&) *raw;
+    Interpreter::Value* slots = ctx.fSlots.data();
     for (int i = 0; i < activePixels; ++i) {
-        ctx.fInterpreter->push(Interpreter::Value(ctx.rgba[i * 4 + 0]));
-        ctx.fInterpreter->push(Interpreter::Value(ctx.rgba[i * 4 + 1]));
-        ctx.fInterpreter->push(Interpreter::Value(ctx.rgba[i * 4 + 2]));
-        ctx.fInterpreter->run(*ctx.fFunction);
-        ctx.read_from[i * 4 + 2] = ctx.fInterpreter->pop().fFloat;
-        ctx.read_from[i * 4 + 1] = ctx.fInterpreter->pop().fFloat;
-        ctx.read_from[i * 4 + 0] = ctx.fInterpreter->pop().fFloat;
+        slots[0] = Interpreter::Value(ctx.rgba[i * 4 + 0]);
+        slots[1] = Interpreter::Value(ctx.rgba[i * 4 + 1]);
+        slots[2] = Interpreter::Value(ctx.rgba[i * 4 + 2]);
+        Interpreter::Run(*ctx.fByteCode, slots);
+        ctx.read_from[i * 4 + 0] = slots[0].fFloat;
+        ctx.read_from[i * 4 + 1] = slots[1].fFloat;
+        ctx.read_from[i * 4 + 2] = slots[2].fFloat;
     }
 }
 
+void Interpreter::Run(const ByteCode& byteCode, Value* slots) {
+    const ByteCode::Instruction* code = byteCode.fCode.data();
+    const ByteCode::Instruction* ip = code;
+    // Jumps keep their target in fDst, so operands are only looked up by the cases that use them.
+    #define DST slots[inst.fDst]
+    #define A   slots[inst.fA]
+    #define B   slots[inst.fB]
+    for (;;) {
+        const ByteCode::Instruction& inst = *ip++;
+        switch (inst.fOp) {
+            case ByteCode::Op::kCopy:  DST = A; break;
+            case ByteCode::Op::kAddF:  DST = Value(A.fFloat + B.fFloat); break;
+            case ByteCode::Op::kAddI:  DST = Value(A.fInt + B.fInt); break;
+            case ByteCode::Op::kSubF:  DST = Value(A.fFloat - B.fFloat); break;
+            case ByteCode::Op::kSubI:  DST = Value(A.fInt - B.fInt); break;
+            case ByteCode::Op::kMulF:  DST = Value(A.fFloat * B.fFloat); break;
+            case ByteCode::Op::kMulI:  DST = Value(A.fInt * B.fInt); break;
+            case ByteCode::Op::kDivF:  DST = Value(A.fFloat / B.fFloat); break;
+            case ByteCode::Op::kDivI:  DST = Value(A.fInt / B.fInt); break;
+            case ByteCode::Op::kAndI:  DST = Value(A.fInt & B.fInt); break;
+            case ByteCode::Op::kOrI:   DST = Value(A.fInt | B.fInt); break;
+            case ByteCode::Op::kXorI:  DST = Value(A.fInt ^ B.fInt); break;
+            case ByteCode::Op::kLtF:   DST = Value(A.fFloat <  B.fFloat); break;
+            case ByteCode::Op::kLtI:   DST = Value(A.fInt   <  B.fInt);   break;
+            case ByteCode::Op::kGtF:   DST = Value(A.fFloat >  B.fFloat); break;
+            case ByteCode::Op::kGtI:   DST = Value(A.fInt   >  B.fInt);   break;
+            case ByteCode::Op::kLteqF: DST = Value(A.fFloat <= B.fFloat); break;
+            case ByteCode::Op::kLteqI: DST = Value(A.fInt   <= B.fInt);   break;
+            case ByteCode::Op::kGteqF: DST = Value(A.fFloat >= B.fFloat); break;
+            case ByteCode::Op::kGteqI: DST = Value(A.fInt   >= B.fInt);   break;
+            case ByteCode::Op::kEqF:   DST = Value(A.fFloat == B.fFloat); break;
+            case ByteCode::Op::kEqI:   DST = Value(A.fInt   == B.fInt);   break;
+            case ByteCode::Op::kNeqF:  DST = Value(A.fFloat != B.fFloat); break;
+            case ByteCode::Op::kNeqI:  DST = Value(A.fInt   != B.fInt);   break;
+            case ByteCode::Op::kNegF:  DST = Value(-A.fFloat); break;
+            case ByteCode::Op::kNegI:  DST = Value(-A.fInt); break;
+            case ByteCode::Op::kNotB:  DST = Value(!A.fBool); break;
+            case ByteCode::Op::kJump:
+                ip = code + inst.fDst;
+                break;
+            case ByteCode::Op::kBranchIfFalse:
+                if (!A.fBool) {
+                    ip = code + inst.fDst;
+                }
+                break;
+            case ByteCode::Op::kReturn:
+                return;
+        }
+    }
+    #undef DST
+    #undef A
+    #undef B
+}
+
 void Interpreter::appendStage(const AppendStage& a) {
     switch (a.fStage) {
         case SkRasterPipeline::matrix_4x5: {
@@ -241,17 +298,21 @@ void Interpreter::appendStage(const AppendStage& a) {
         case SkRasterPipeline::callback: {
             SkASSERT(a.fArguments.size() == 1);
             CallbackCtx* ctx = new CallbackCtx();
-            ctx->fInterpreter = this;
             ctx->fn = do_callback;
             for (const auto& e : *fProgram) {
                 if (ProgramElement::kFunction_Kind == e.fKind) {
                     const FunctionDefinition& f = (const FunctionDefinition&) e;
                     if (&f.fDeclaration ==
                                       ((const FunctionReference&) *a.fArguments[0]).fFunctions[0]) {
-                        ctx->fFunction = &f;
+                        // Compile once here rather than walking the tree for every pixel.
+                        ctx->fByteCode = ByteCodeGenerator().generate(f);
                     }
                 }
             }
+            SkASSERT(ctx->fByteCode && 3 == ctx->fByteCode->fParameterCount);
+            ctx->fSlots.resize(ctx->fByteCode->fSlotCount, Value(0));
+            std::copy(ctx->fByteCode->fConstants.begin(), ctx->fByteCode->fConstants.end(),
+                      ctx->fSlots.begin() + ctx->fByteCode->fConstantBase);
             fPipeline.append(SkRasterPipeline::callback, ctx);
             break;
         }
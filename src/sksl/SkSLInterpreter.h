@@ -21,6 +21,8 @@ class SkRasterPipeline;
 
 namespace SkSL {
 
+struct ByteCode;
+
 class Interpreter {
     typedef int StackIndex;
 
@@ -60,6 +62,13 @@ public:
 
     void run(const FunctionDefinition& f);
 
+    /**
+     * Runs a function compiled by ByteCodeGenerator. slots must hold byteCode.fSlotCount values,
+     * starting with the function's parameters and ending with its constants. Parameters are
+     * updated in place.
+     */
+    static void Run(const ByteCode& byteCode, Value* slots);
+
     void push(Value value);
 
     Value pop();
@@ -70,6 +70,11 @@ struct AppendStage;
  *   void* func = module->getJumperStage("swap");
  *   p->append(func, nullptr);
  * #endif
+ *
+ * A JIT stage is just one more raw function in the pipeline. Like the stock stages, it receives
+ * the pixels' registers as arguments and tail calls the next stage, so nothing is spilled in
+ * between. The JIT only sees SkSL, though. It can't fuse the stock stages around it, because their
+ * bodies only exist as C++ in SkRasterPipeline_opts.h.
  */
 class JIT {
     typedef int StackIndex;
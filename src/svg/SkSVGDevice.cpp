@@ -8,7 +8,6 @@
 #include "SkSVGDevice.h"
 
 #include "SkAnnotationKeys.h"
-#include "SkBase64.h"
 #include "SkBitmap.h"
 #include "SkBlendMode.h"
 #include "SkChecksum.h"
@@ -131,10 +130,20 @@ bool RequiresViewportReset(const SkPaint& paint) {
 
 }  // namespace
 
-// For now all this does is serve unique serial IDs, but it will eventually evolve to track
-// and deduplicate resources.
+// Serves unique serial IDs, and remembers which resources have already been written to <defs>,
+// so that later draws using identical ones can refer to them by id.
 class SkSVGDevice::ResourceBucket : ::SkNoncopyable {
 public:
+    // A bitmap's pixel ref and subset, or an image shader's image and tile modes.
+    struct ImageKey {
+        uint32_t fID;
+        int32_t  fParams[4];
+
+        bool operator==(const ImageKey& other) const {
+            return 0 == memcmp(this, &other, sizeof(ImageKey));
+        }
+    };
+
     ResourceBucket()
             : fGradientCount(0)
             , fClipCount(0)
@@ -165,6 +174,45 @@ public:
       return SkStringPrintf("pattern_%d", fPatternCount++);
     }
 
+    // The find methods return the id of a resource already written for the key, if any. The
+    // add methods serve a new id, which the caller must then write the resource under.
+    const SkString* findLinearGradient(const SkString& desc) const {
+        return fGradients.find(desc);
+    }
+    SkString addLinearGradient(const SkString& desc) {
+        return *fGradients.set(desc, this->addLinearGradient());
+    }
+
+    const SkString* findClip(uint32_t clipGenID) const { return fClips.find(clipGenID); }
+    SkString addClip(uint32_t clipGenID) { return *fClips.set(clipGenID, this->addClip()); }
+
+    const SkString* findImage(const ImageKey& key) const { return fImages.find(key); }
+    SkString addImage(const ImageKey& key) { return *fImages.set(key, this->addImage()); }
+
+    const SkString* findPattern(const ImageKey& key) const { return fPatterns.find(key); }
+    SkString addPattern(const ImageKey& key) { return *fPatterns.set(key, this->addPattern()); }
+
+    const SkString* findColorFilter(SkColor color) const { return fColorFilters.find(color); }
+    SkString addColorFilter(SkColor color) {
+        return *fColorFilters.set(color, this->addColorFilter());
+    }
+
+    // Most paths are only drawn once, so they stay inline at first. The second draw of a path's
+    // geometry serves an id and sets *isNew; before that this returns an empty string.
+    SkString findOrAddPath(uint32_t pathGenID, bool* isNew) {
+        *isNew = false;
+        SkString* id = fPaths.find(pathGenID);
+        if (!id) {
+            fPaths.set(pathGenID, SkString());
+            return SkString();
+        }
+        if (id->isEmpty()) {
+            *id = this->addPath();
+            *isNew = true;
+        }
+        return *id;
+    }
+
 private:
     uint32_t fGradientCount;
     uint32_t fClipCount;
@@ -172,6 +220,13 @@ private:
     uint32_t fImageCount;
     uint32_t fPatternCount;
     uint32_t fColorFilterCount;
+
+    SkTHashMap<SkString, SkString> fGradients;      // keyed by the gradient's parameters
+    SkTHashMap<uint32_t, SkString> fClips;          // keyed by the clip stack's gen ID
+    SkTHashMap<ImageKey, SkString> fImages;         // keyed by pixel ref gen ID and subset
+    SkTHashMap<ImageKey, SkString> fPatterns;       // keyed by image unique ID and tile modes
+    SkTHashMap<SkColor,  SkString> fColorFilters;   // keyed by the SrcIn filter color
+    SkTHashMap<uint32_t, SkString> fPaths;          // keyed by the path's gen ID
 };
 
 struct SkSVGDevice::MxCp {
@@ -225,7 +280,7 @@ public:
     }
 
     void addAttribute(const char name[], const SkString& val) {
-        fWriter->addAttribute(name, val.c_str());
+        fWriter->addAttributeLen(name, val.c_str(), val.size());
     }
 
     void addAttribute(const char name[], int32_t val) {
@@ -236,6 +291,10 @@ public:
         fWriter->addScalarAttribute(name, val);
     }
 
+    void addBase64Attribute(const char name[], const char prefix[], const SkData& data) {
+        fWriter->addBase64Attribute(name, prefix, data.data(), data.size());
+    }
+
     void addText(const SkString& text) {
         fWriter->addText(text.c_str(), text.size());
     }
@@ -259,7 +318,8 @@ private:
     void addPaint(const SkPaint& paint, const Resources& resources);
 
 
-    SkString addLinearGradientDef(const SkShader::GradientInfo& info, const SkShader* shader);
+    void addLinearGradientDef(const SkString& id, const SkShader::GradientInfo& info,
+                              const SkShader* shader);
 
     SkXMLWriter*               fWriter;
     ResourceBucket*            fResourceBucket;
@@ -318,20 +378,14 @@ void SkSVGDevice::AutoElement::addPaint(const SkPaint& paint, const Resources& r
 Resources SkSVGDevice::AutoElement::addResources(const MxCp& mc, const SkPaint& paint) {
     Resources resources(paint);
 
-    // FIXME: this is a weak heuristic and we end up with LOTS of redundant clips.
-    bool hasClip   = !mc.fClipStack->isWideOpen();
-    bool hasShader = SkToBool(paint.getShader());
-
-    if (hasClip || hasShader) {
-        AutoElement defs("defs", fWriter);
-
-        if (hasClip) {
-            this->addClipResources(mc, &resources);
-        }
+    // Resources already written for earlier draws are only referenced; the rest are written to
+    // <defs> here, to be shared with later draws.
+    if (!mc.fClipStack->isWideOpen()) {
+        this->addClipResources(mc, &resources);
+    }
 
-        if (hasShader) {
-            this->addShaderResources(paint, &resources);
-        }
+    if (paint.getShader()) {
+        this->addShaderResources(paint, &resources);
     }
 
     if (const SkColorFilter* cf = paint.getColorFilter()) {
@@ -364,12 +418,42 @@ void SkSVGDevice::AutoElement::addGradientShaderResources(const SkShader* shader
     SkASSERT(grInfo.fColorCount <= grColors.count());
     SkASSERT(grInfo.fColorCount <= grOffsets.count());
 
-    resources->fPaintServer.printf("url(#%s)", addLinearGradientDef(grInfo, shader).c_str());
+    // Everything the <linearGradient> is made of, as raw bytes.
+    SkString desc;
+    desc.append(reinterpret_cast<const char*>(grInfo.fPoint), sizeof(grInfo.fPoint));
+    desc.append(reinterpret_cast<const char*>(grColors.get()),
+                grInfo.fColorCount * sizeof(SkColor));
+    desc.append(reinterpret_cast<const char*>(grOffsets.get()),
+                grInfo.fColorCount * sizeof(SkScalar));
+    SkScalar localMatrix[9];
+    shader->getLocalMatrix().get9(localMatrix);
+    desc.append(reinterpret_cast<const char*>(localMatrix), sizeof(localMatrix));
+
+    SkString id;
+    if (const SkString* existing = fResourceBucket->findLinearGradient(desc)) {
+        id = *existing;
+    } else {
+        id = fResourceBucket->addLinearGradient(desc);
+        AutoElement defs("defs", fWriter);
+        this->addLinearGradientDef(id, grInfo, shader);
+    }
+    resources->fPaintServer.printf("url(#%s)", id.c_str());
 }
 
 void SkSVGDevice::AutoElement::addColorFilterResources(const SkColorFilter& cf,
                                                        Resources* resources) {
-    SkString colorfilterID = fResourceBucket->addColorFilter();
+    SkColor filterColor;
+    SkBlendMode mode;
+    bool asColorMode = cf.asColorMode(&filterColor, &mode);
+    SkAssertResult(asColorMode);
+    SkASSERT(mode == SkBlendMode::kSrcIn);
+
+    if (const SkString* existing = fResourceBucket->findColorFilter(filterColor)) {
+        resources->fColorFilter.printf("url(#%s)", existing->c_str());
+        return;
+    }
+
+    SkString colorfilterID = fResourceBucket->addColorFilter(filterColor);
     {
         AutoElement filterElement("filter", fWriter);
         filterElement.addAttribute("id", colorfilterID);
@@ -378,12 +462,6 @@ void SkSVGDevice::AutoElement::addColorFilterResources(const SkColorFilter& cf,
         filterElement.addAttribute("width", "100%");
         filterElement.addAttribute("height", "100%");
 
-        SkColor filterColor;
-        SkBlendMode mode;
-        bool asColorMode = cf.asColorMode(&filterColor, &mode);
-        SkAssertResult(asColorMode);
-        SkASSERT(mode == SkBlendMode::kSrcIn);
-
         {
             // first flood with filter color
             AutoElement floodElement("feFlood", fWriter);
@@ -402,40 +480,24 @@ void SkSVGDevice::AutoElement::addColorFilterResources(const SkColorFilter& cf,
     resources->fColorFilter.printf("url(#%s)", colorfilterID.c_str());
 }
 
-// Returns data uri from bytes.
-// it will use any cached data if available, otherwise will
-// encode as png.
-sk_sp<SkData> AsDataUri(SkImage* image) {
+// Returns the image's encoded bytes, and the data URI prefix for them.
+// It will use any cached data if available, otherwise will encode as png.
+static sk_sp<SkData> encode_image(SkImage* image, const char** dataUriPrefix) {
     sk_sp<SkData> imageData = image->encodeToData();
     if (!imageData) {
         return nullptr;
     }
 
-    const char* src = (char*)imageData->data();
-    const char* selectedPrefix = nullptr;
-    size_t selectedPrefixLength = 0;
-
-    const static char pngDataPrefix[] = "data:image/png;base64,";
-    const static char jpgDataPrefix[] = "data:image/jpeg;base64,";
-
+    const char* src = (const char*)imageData->data();
     if (SkJpegCodec::IsJpeg(src, imageData->size())) {
-        selectedPrefix = jpgDataPrefix;
-        selectedPrefixLength = sizeof(jpgDataPrefix);
+        *dataUriPrefix = "data:image/jpeg;base64,";
     } else {
       if (!SkPngCodec::IsPng(src, imageData->size())) {
         imageData = image->encodeToData(SkEncodedImageFormat::kPNG, 100);
       }
-      selectedPrefix = pngDataPrefix;
-      selectedPrefixLength = sizeof(pngDataPrefix);
+      *dataUriPrefix = "data:image/png;base64,";
     }
-
-    size_t b64Size = SkBase64::Encode(imageData->data(), imageData->size(), nullptr);
-    sk_sp<SkData> dataUri = SkData::MakeUninitialized(selectedPrefixLength + b64Size);
-    char* dest = (char*)dataUri->writable_data();
-    memcpy(dest, selectedPrefix, selectedPrefixLength);
-    SkBase64::Encode(imageData->data(), imageData->size(), dest + selectedPrefixLength - 1);
-    dest[dataUri->size() - 1] = 0;
-    return dataUri;
+    return imageData;
 }
 
 void SkSVGDevice::AutoElement::addImageShaderResources(const SkShader* shader, const SkPaint& paint,
@@ -446,10 +508,18 @@ void SkSVGDevice::AutoElement::addImageShaderResources(const SkShader* shader, c
     SkImage* image = shader->isAImage(&outMatrix, xy);
     SkASSERT(image);
 
+    // The pattern only depends on the image and how it tiles.
+    const ResourceBucket::ImageKey key = { image->uniqueID(), { (int32_t)xy[0], (int32_t)xy[1] } };
+    if (const SkString* existing = fResourceBucket->findPattern(key)) {
+        resources->fPaintServer.printf("url(#%s)", existing->c_str());
+        return;
+    }
+
     SkString patternDims[2];  // width, height
 
-    sk_sp<SkData> dataUri = AsDataUri(image);
-    if (!dataUri) {
+    const char* dataUriPrefix;
+    sk_sp<SkData> imageData = encode_image(image, &dataUriPrefix);
+    if (!imageData) {
         return;
     }
     SkIRect imageSize = image->bounds();
@@ -465,8 +535,9 @@ void SkSVGDevice::AutoElement::addImageShaderResources(const SkShader* shader, c
         }
     }
 
-    SkString patternID = fResourceBucket->addPattern();
+    SkString patternID = fResourceBucket->addPattern(key);
     {
+        AutoElement defs("defs", fWriter);
         AutoElement pattern("pattern", fWriter);
         pattern.addAttribute("id", patternID);
         pattern.addAttribute("patternUnits", "userSpaceOnUse");
@@ -484,7 +555,7 @@ void SkSVGDevice::AutoElement::addImageShaderResources(const SkShader* shader, c
             imageTag.addAttribute("y", 0);
             imageTag.addAttribute("width", image->width());
             imageTag.addAttribute("height", image->height());
-            imageTag.addAttribute("xlink:href", static_cast<const char*>(dataUri->data()));
+            imageTag.addBase64Attribute("xlink:href", dataUriPrefix, *imageData);
         }
     }
     resources->fPaintServer.printf("url(#%s)", patternID.c_str());
@@ -505,15 +576,23 @@ void SkSVGDevice::AutoElement::addShaderResources(const SkPaint& paint, Resource
 void SkSVGDevice::AutoElement::addClipResources(const MxCp& mc, Resources* resources) {
     SkASSERT(!mc.fClipStack->isWideOpen());
 
+    // Every state of a device's clip stack has its own gen ID.
+    const uint32_t clipGenID = mc.fClipStack->getTopmostGenID();
+    if (const SkString* existing = fResourceBucket->findClip(clipGenID)) {
+        resources->fClip.printf("url(#%s)", existing->c_str());
+        return;
+    }
+
     SkPath clipPath;
     (void) mc.fClipStack->asPath(&clipPath);
 
-    SkString clipID = fResourceBucket->addClip();
+    SkString clipID = fResourceBucket->addClip(clipGenID);
     const char* clipRule = clipPath.getFillType() == SkPath::kEvenOdd_FillType ?
                            "evenodd" : "nonzero";
     {
         // clipPath is in device space, but since we're only pushing transform attributes
         // to the leaf nodes, so are all our elements => SVG userSpaceOnUse == device space.
+        AutoElement defs("defs", fWriter);
         AutoElement clipPathElement("clipPath", fWriter);
         clipPathElement.addAttribute("id", clipID);
 
@@ -532,11 +611,9 @@ void SkSVGDevice::AutoElement::addClipResources(const MxCp& mc, Resources* resou
     resources->fClip.printf("url(#%s)", clipID.c_str());
 }
 
-SkString SkSVGDevice::AutoElement::addLinearGradientDef(const SkShader::GradientInfo& info,
-                                                        const SkShader* shader) {
-    SkASSERT(fResourceBucket);
-    SkString id = fResourceBucket->addLinearGradient();
-
+void SkSVGDevice::AutoElement::addLinearGradientDef(const SkString& id,
+                                                    const SkShader::GradientInfo& info,
+                                                    const SkShader* shader) {
     {
         AutoElement gradient("linearGradient", fWriter);
 
@@ -567,8 +644,6 @@ SkString SkSVGDevice::AutoElement::addLinearGradientDef(const SkShader::Gradient
             }
         }
     }
-
-    return id;
 }
 
 void SkSVGDevice::AutoElement::addRectAttributes(const SkRect& rect) {
@@ -761,8 +836,24 @@ void SkSVGDevice::drawRRect(const SkRRect& rr, const SkPaint& paint) {
 }
 
 void SkSVGDevice::drawPath(const SkPath& path, const SkPaint& paint, bool pathIsMutable) {
-    AutoElement elem("path", fWriter, fResourceBucket.get(), MxCp(this), paint);
-    elem.addPathAttributes(path);
+    // Geometry drawn more than once (markers, repeated glyph-like shapes) goes into <defs>, and
+    // each draw becomes a <use> carrying the paint and transform.
+    bool isNew;
+    SkString pathID = fResourceBucket->findOrAddPath(path.getGenerationID(), &isNew);
+    if (isNew) {
+        AutoElement defs("defs", fWriter);
+        AutoElement def("path", fWriter);
+        def.addAttribute("id", pathID);
+        def.addPathAttributes(path);
+    }
+
+    AutoElement elem(pathID.isEmpty() ? "path" : "use",
+                     fWriter, fResourceBucket.get(), MxCp(this), paint);
+    if (pathID.isEmpty()) {
+        elem.addPathAttributes(path);
+    } else {
+        elem.addAttribute("xlink:href", SkStringPrintf("#%s", pathID.c_str()));
+    }
 
     // TODO: inverse fill types?
     if (path.getFillType() == SkPath::kEvenOdd_FillType) {
@@ -776,27 +867,28 @@ static sk_sp<SkData> encode(const SkBitmap& src) {
 }
 
 void SkSVGDevice::drawBitmapCommon(const MxCp& mc, const SkBitmap& bm, const SkPaint& paint) {
-    sk_sp<SkData> pngData = encode(bm);
-    if (!pngData) {
-        return;
-    }
-
-    size_t b64Size = SkBase64::Encode(pngData->data(), pngData->size(), nullptr);
-    SkAutoTMalloc<char> b64Data(b64Size);
-    SkBase64::Encode(pngData->data(), pngData->size(), b64Data.get());
-
-    SkString svgImageData("data:image/png;base64,");
-    svgImageData.append(b64Data.get(), b64Size);
+    // Each distinct bitmap is encoded once; later draws of it only add a <use>.
+    const SkIPoint origin = bm.pixelRefOrigin();
+    const ResourceBucket::ImageKey key = {
+        bm.getGenerationID(), { origin.x(), origin.y(), bm.width(), bm.height() }
+    };
+    SkString imageID;
+    if (const SkString* existing = fResourceBucket->findImage(key)) {
+        imageID = *existing;
+    } else {
+        sk_sp<SkData> pngData = encode(bm);
+        if (!pngData) {
+            return;
+        }
 
-    SkString imageID = fResourceBucket->addImage();
-    {
+        imageID = fResourceBucket->addImage(key);
         AutoElement defs("defs", fWriter);
         {
             AutoElement image("image", fWriter);
             image.addAttribute("id", imageID);
             image.addAttribute("width", bm.width());
             image.addAttribute("height", bm.height());
-            image.addAttribute("xlink:href", svgImageData);
+            image.addBase64Attribute("xlink:href", "data:image/png;base64,", *pngData);
         }
     }
 
@@ -10,12 +10,21 @@
 #include "SkCodecImageGenerator.h"
 #include "SkData.h"
 #include "SkImage.h"
+#include "SkMakeUnique.h"
+#include "SkTArray.h"
+#include "SkTaskGroup.h"
 #include <algorithm>
 
-SkAnimCodecPlayer::SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec) : fCodec(std::move(codec)) {
+SkAnimCodecPlayer::SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec)
+    : SkAnimCodecPlayer(std::move(codec), Options()) {}
+
+SkAnimCodecPlayer::SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec, const Options& options)
+    : fCodec(std::move(codec))
+    , fOptions(options) {
     fImageInfo = fCodec->getInfo();
     fFrameInfos = fCodec->getFrameInfo();
     fImages.resize(fFrameInfos.size());
+    fLastUsed.resize(fFrameInfos.size());
 
     // change the interpretation of fDuration to a end-time for that frame
     size_t dur = 0;
@@ -25,28 +34,72 @@ SkAnimCodecPlayer::SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec) : fCodec(st
     }
     fTotalDuration = dur;
 
+    const size_t frameBytes = fImageInfo.computeMinByteSize();
+    fMaxCachedCount = SkToInt(fFrameInfos.size());
+    if (frameBytes > 0 && fOptions.fCacheBudget / frameBytes < fFrameInfos.size()) {
+        fMaxCachedCount = SkTMax(1, SkToInt(fOptions.fCacheBudget / frameBytes));
+    }
+
     if (!fTotalDuration) {
         // Static image -- may or may not have returned a single frame info.
         fFrameInfos.clear();
         fImages.clear();
         fImages.push_back(SkImage::MakeFromGenerator(
                               SkCodecImageGenerator::MakeFromCodec(std::move(fCodec))));
+    } else if (fOptions.fExecutor) {
+        fTaskGroup = skstd::make_unique<SkTaskGroup>(*fOptions.fExecutor);
     }
 }
 
-SkAnimCodecPlayer::~SkAnimCodecPlayer() {}
+SkAnimCodecPlayer::~SkAnimCodecPlayer() {
+    if (fTaskGroup) {
+        {
+            SkAutoMutexAcquire lock(fMutex);
+            fShuttingDown = true;
+        }
+        fTaskGroup->wait();
+    }
+}
 
 SkISize SkAnimCodecPlayer::dimensions() {
     return { fImageInfo.width(), fImageInfo.height() };
 }
 
-sk_sp<SkImage> SkAnimCodecPlayer::getFrameAt(int index) {
-    SkASSERT((unsigned)index < fFrameInfos.size());
+int SkAnimCodecPlayer::findCachedPriorFrame(int index) const {
+    // Any frame from the required frame on can be drawn over, unless it is to be restored.
+    const int requiredFrame = fFrameInfos[index].fRequiredFrame;
+    if (requiredFrame == SkCodec::kNoFrame) {
+        return SkCodec::kNoFrame;
+    }
+    for (int i = index - 1; i >= requiredFrame; --i) {
+        if (fImages[i] &&
+            fFrameInfos[i].fDisposalMethod != SkCodecAnimation::DisposalMethod::kRestorePrevious) {
+            return i;
+        }
+    }
+    return SkCodec::kNoFrame;
+}
 
-    if (fImages[index]) {
-        return fImages[index];
+void SkAnimCodecPlayer::cacheFrame(int index, sk_sp<SkImage> image) {
+    SkASSERT(!fImages[index]);
+    if (fCachedCount >= fMaxCachedCount) {
+        int oldest = -1;
+        for (int i = 0; i < SkToInt(fImages.size()); ++i) {
+            if (fImages[i] && i != fCurrIndex && (oldest < 0 || fLastUsed[i] < fLastUsed[oldest])) {
+                oldest = i;
+            }
+        }
+        if (oldest >= 0) {
+            fImages[oldest] = nullptr;
+            fCachedCount--;
+        }
     }
+    fImages[index] = std::move(image);
+    fLastUsed[index] = ++fUseCount;
+    fCachedCount++;
+}
 
+bool SkAnimCodecPlayer::decodeFrame(int index) {
     size_t rb = fImageInfo.minRowBytes();
     size_t size = fImageInfo.computeByteSize(rb);
     auto data = SkData::MakeUninitialized(size);
@@ -54,27 +107,86 @@ sk_sp<SkImage> SkAnimCodecPlayer::getFrameAt(int index) {
     SkCodec::Options opts;
     opts.fFrameIndex = index;
 
-    const int requiredFrame = fFrameInfos[index].fRequiredFrame;
-    if (requiredFrame != SkCodec::kNoFrame) {
-        auto requiredImage = fImages[requiredFrame];
-        SkPixmap requiredPM;
-        if (requiredImage && requiredImage->peekPixels(&requiredPM)) {
-            sk_careful_memcpy(data->writable_data(), requiredPM.addr(), size);
-            opts.fPriorFrame = requiredFrame;
+    // Without a prior frame, the codec decodes the frames this one depends on itself.
+    const int priorFrame = this->findCachedPriorFrame(index);
+    if (priorFrame != SkCodec::kNoFrame) {
+        SkPixmap priorPM;
+        if (fImages[priorFrame]->peekPixels(&priorPM)) {
+            sk_careful_memcpy(data->writable_data(), priorPM.addr(), size);
+            opts.fPriorFrame = priorFrame;
         }
     }
-    if (SkCodec::kSuccess == fCodec->getPixels(fImageInfo, data->writable_data(), rb, &opts)) {
-        return fImages[index] = SkImage::MakeRasterData(fImageInfo, std::move(data), rb);
+    if (SkCodec::kSuccess != fCodec->getPixels(fImageInfo, data->writable_data(), rb, &opts)) {
+        return false;
     }
-    return nullptr;
+    this->cacheFrame(index, SkImage::MakeRasterData(fImageInfo, std::move(data), rb));
+    return true;
+}
+
+sk_sp<SkImage> SkAnimCodecPlayer::getFrameAt(int index) {
+    SkASSERT((unsigned)index < fFrameInfos.size());
+
+    if (fImages[index]) {
+        fLastUsed[index] = ++fUseCount;
+        return fImages[index];
+    }
+
+    // Walk back through the frames this one depends on to one we can start from (a cached
+    // frame, or one that depends on nothing), then decode forward, caching each frame.
+    SkSTArray<16, int> toDecode;
+    for (int i = index; i != SkCodec::kNoFrame && !fImages[i];
+         i = fFrameInfos[i].fRequiredFrame) {
+        toDecode.push_back(i);
+        if (this->findCachedPriorFrame(i) != SkCodec::kNoFrame) {
+            break;
+        }
+    }
+    for (int i = toDecode.count() - 1; i >= 0; --i) {
+        if (!fImages[toDecode[i]] && !this->decodeFrame(toDecode[i])) {
+            return nullptr;
+        }
+    }
+    return fImages[index];
+}
+
+void SkAnimCodecPlayer::prefetch() {
+    if (!fTaskGroup || fPrefetching) {
+        return;
+    }
+
+    fPrefetching = true;
+    fTaskGroup->add([this] {
+        for (;;) {
+            SkAutoMutexAcquire lock(fMutex);
+            const int frameCount = SkToInt(fFrameInfos.size());
+            const int ahead = SkTMin(fOptions.fPrefetchCount, fMaxCachedCount - 1);
+            int next = -1;
+            for (int n = 0; n <= ahead && n < frameCount; ++n) {
+                int i = (fCurrIndex + n) % frameCount;
+                if (!fImages[i]) {
+                    next = i;
+                    break;
+                }
+            }
+            if (fShuttingDown || next < 0 || !this->getFrameAt(next)) {
+                fPrefetching = false;
+                return;
+            }
+        }
+    });
 }
 
 sk_sp<SkImage> SkAnimCodecPlayer::getFrame() {
     SkASSERT(fTotalDuration > 0 || fImages.size() == 1);
 
-    return fTotalDuration > 0
-        ? this->getFrameAt(fCurrIndex)
-        : fImages.front();
+    if (!fTotalDuration) {
+        return fImages.front();
+    }
+
+    SkAutoMutexAcquire lock(fMutex);
+    sk_sp<SkImage> frame = this->getFrameAt(fCurrIndex);
+    this->prefetch();
+    return frame;
 }
 
 bool SkAnimCodecPlayer::seek(uint32_t msec) {
@@ -88,9 +200,9 @@ bool SkAnimCodecPlayer::seek(uint32_t msec) {
                                   [](const SkCodec::FrameInfo& info, uint32_t msec) {
                                       return (uint32_t)info.fDuration < msec;
                                   });
+    SkAutoMutexAcquire lock(fMutex);
     int prevIndex = fCurrIndex;
     fCurrIndex = lower - fFrameInfos.begin();
+    this->prefetch();
     return fCurrIndex != prevIndex;
 }
-
-
@@ -20,6 +20,8 @@ public:
 
     bool isAtEnd() const override;
 
+    void setWaitForData(bool wait) override { fStream->setWaitForData(wait); }
+
     bool rewind() override;
 
     bool hasLength() const override { return fHasLength; }
@@ -901,10 +901,186 @@ SkString Value::toString() const {
     return SkString(static_cast<const char*>(data->data()), data->size());
 }
 
+// Binary DOMs (see DOM::writeBinary()) are images of the value tree, which load without any
+// lexing or number parsing:
+//
+//   [magic: '\0' 'S' 'K' 'J'] [u32 version] [slabs ...] [u32 image size] [u32 0] [root record]
+//
+// Records are 8 bytes, laid out like Values. Inline values (null, bool, numbers and short
+// strings) are stored verbatim. Strings, arrays and objects store the file offset of their slab
+// in the low 32 bits instead of a pointer, with their tag in the top byte as usual. Slabs are
+// 8-byte aligned:
+//
+//   [u32 n] [u32 0] [n records (arrays) | n key/value record pairs (objects) | n chars, \0]
+//
+// Each slab is written after the slabs it refers to, so a record only ever points back from
+// the slab holding it. Loading relies on that to reject images that would loop.
+namespace {
+
+static constexpr char     kBinaryMagic[4] = { '\0', 'S', 'K', 'J' };
+static constexpr uint32_t kBinaryVersion  = 1;
+static constexpr size_t   kBinaryHeaderSize = 8;
+static constexpr size_t   kBinaryTrailerSize = 16;
+static constexpr size_t   kBinaryRecordSize = 8;
+static constexpr int      kBinaryMaxDepth = 1024;
+// The tag byte is the last one, i.e. the top byte of a little-endian record.
+static constexpr int      kRecordTagShift = 56;
+
+class BinaryRecord final : public Value {
+public:
+    static bool IsBinary(const char* data, size_t size) {
+        return size >= kBinaryHeaderSize + kBinaryTrailerSize &&
+               0 == memcmp(data, kBinaryMagic, sizeof(kBinaryMagic));
+    }
+
+    // Writes v's slab (after its children's), if it needs one, and returns v's record.
+    static uint64_t Write(const Value& v, SkDynamicMemoryWStream* stream) {
+        switch (static_cast<const BinaryRecord&>(v).getTag()) {
+        case Tag::kString: {
+            const auto& str = v.as<StringValue>();
+            return WriteSlab(Tag::kString, str.size(), str.begin(), str.size() + 1, stream);
+        }
+        case Tag::kArray: {
+            const auto& array = v.as<ArrayValue>();
+            std::vector<uint64_t> records;
+            records.reserve(array.size());
+            for (const auto& item : array) {
+                records.push_back(Write(item, stream));
+            }
+            return WriteSlab(Tag::kArray, array.size(), records.data(),
+                             records.size() * kBinaryRecordSize, stream);
+        }
+        case Tag::kObject: {
+            const auto& object = v.as<ObjectValue>();
+            std::vector<uint64_t> records;
+            records.reserve(object.size() * 2);
+            for (const auto& member : object) {
+                records.push_back(Write(member.fKey, stream));
+                records.push_back(Write(member.fValue, stream));
+            }
+            return WriteSlab(Tag::kObject, object.size(), records.data(),
+                             records.size() * kBinaryRecordSize, stream);
+        }
+        default: {
+            uint64_t record;
+            memcpy(&record, &v, sizeof(record));
+            return record;
+        }
+        }
+    }
+
+    // Returns the image's root value, or null if the image is malformed.
+    static Value Load(const char* data, size_t size, SkArenaAlloc& alloc) {
+        uint32_t version, imageSize;
+        memcpy(&version, data + sizeof(kBinaryMagic), sizeof(version));
+        memcpy(&imageSize, data + size - kBinaryTrailerSize, sizeof(imageSize));
+        if (version != kBinaryVersion || imageSize != size || !SkIsAlign8(size)) {
+            return NullValue();
+        }
+
+        const size_t slabsEnd = size - kBinaryTrailerSize;
+        uint64_t root;
+        memcpy(&root, data + size - kBinaryRecordSize, sizeof(root));
+        Value value;
+        return Load(data, root, slabsEnd, 0, alloc, &value) ? value : NullValue();
+    }
+
+private:
+    static uint64_t WriteSlab(Tag tag, size_t n, const void* payload, size_t payloadSize,
+                              SkDynamicMemoryWStream* stream) {
+        static constexpr char kZeros[8] = {};
+        const size_t offset = stream->bytesWritten();
+        SkASSERT(SkIsAlign8(offset));
+        const uint32_t header[2] = { SkToU32(n), 0 };
+        stream->write(header, sizeof(header));
+        stream->write(payload, payloadSize);
+        stream->write(kZeros, SkAlign8(payloadSize) - payloadSize);
+
+        return static_cast<uint32_t>(offset) | static_cast<uint64_t>(tag) << kRecordTagShift;
+    }
+
+    // Decodes the record into *value. Any slab it refers to must end by limit.
+    static bool Load(const char* data, uint64_t record, size_t limit, int depth,
+                     SkArenaAlloc& alloc, Value* value) {
+        memcpy(value, &record, sizeof(record));
+        const Tag tag = static_cast<BinaryRecord*>(value)->getTag();
+        if (tag == Tag::kShortString) {
+            // Keep the terminator, whatever the image says.
+            record &= ~(static_cast<uint64_t>(0xff) << kRecordTagShift);
+            memcpy(value, &record, sizeof(record));
+        }
+        if (tag != Tag::kString && tag != Tag::kArray && tag != Tag::kObject) {
+            return true;
+        }
+
+        const size_t offset = static_cast<uint32_t>(record);
+        if (depth >= kBinaryMaxDepth || !SkIsAlign8(offset) || offset < kBinaryHeaderSize ||
+            offset + 8 > limit) {
+            return false;
+        }
+        uint32_t n;
+        memcpy(&n, data + offset, sizeof(n));
+        const char* payload = data + offset + 8;
+        const size_t available = limit - offset - 8;
+
+        switch (tag) {
+        case Tag::kString:
+            if (n >= available || payload[n] != '\0') {
+                return false;
+            }
+            *value = StringValue(payload, n, alloc);
+            return true;
+        case Tag::kArray: {
+            if (n > available / kBinaryRecordSize) {
+                return false;
+            }
+            std::vector<Value> items(n);
+            for (uint32_t i = 0; i < n; ++i) {
+                uint64_t item;
+                memcpy(&item, payload + i * kBinaryRecordSize, sizeof(item));
+                if (!Load(data, item, offset, depth + 1, alloc, &items[i])) {
+                    return false;
+                }
+            }
+            *value = ArrayValue(items.data(), n, alloc);
+            return true;
+        }
+        default: {
+            if (n > available / (2 * kBinaryRecordSize)) {
+                return false;
+            }
+            std::vector<Member> members;
+            members.reserve(n);
+            for (uint32_t i = 0; i < n; ++i) {
+                uint64_t key, val;
+                memcpy(&key, payload + 2 * i * kBinaryRecordSize, sizeof(key));
+                memcpy(&val, payload + (2 * i + 1) * kBinaryRecordSize, sizeof(val));
+                Value keyValue, valValue;
+                if (!Load(data, key, offset, depth + 1, alloc, &keyValue) ||
+                    !keyValue.is<StringValue>() ||
+                    !Load(data, val, offset, depth + 1, alloc, &valValue)) {
+                    return false;
+                }
+                members.push_back({ keyValue.as<StringValue>(), valValue });
+            }
+            *value = ObjectValue(members.data(), n, alloc);
+            return true;
+        }
+        }
+    }
+};
+
+} // namespace
+
 static constexpr size_t kMinChunkSize = 4096;
 
 DOM::DOM(const char* data, size_t size)
     : fAlloc(kMinChunkSize) {
+    if (BinaryRecord::IsBinary(data, size)) {
+        fRoot = BinaryRecord::Load(data, size, fAlloc);
+        return;
+    }
+
     DOMParser parser(fAlloc);
 
     fRoot = parser.parse(data, size);
@@ -914,4 +1090,20 @@ void DOM::write(SkWStream* stream) const {
     Write(fRoot, stream);
 }
 
+bool DOM::writeBinary(SkWStream* stream) const {
+    SkDynamicMemoryWStream image;
+    image.write(kBinaryMagic, sizeof(kBinaryMagic));
+    image.write32(kBinaryVersion);
+    const uint64_t root = BinaryRecord::Write(fRoot, &image);
+    // Offsets (and the image size) are 32 bits.
+    const size_t imageSize = image.bytesWritten() + kBinaryTrailerSize;
+    if (imageSize > UINT32_MAX) {
+        return false;
+    }
+    image.write32(SkToU32(imageSize));
+    image.write32(0);
+    image.write(&root, sizeof(root));
+    return image.writeToAndReset(stream);
+}
+
 } // namespace skjson
@@ -328,12 +328,24 @@ private:
 
 class DOM final : public SkNoncopyable {
 public:
+    /**
+     *  Parses the JSON text, or loads the binary image writeBinary() wrote. A malformed input
+     *  results in a null root.
+     */
     DOM(const char*, size_t);
 
     const Value& root() const { return fRoot; }
 
     void write(SkWStream*) const;
 
+    /**
+     *  Writes a binary image of the DOM, which the constructor loads much faster than it parses
+     *  the equivalent text: there's nothing to lex and no numbers or escapes to decode. Images
+     *  are little-endian and independent of pointer size. Returns false if the image would
+     *  exceed 4GB.
+     */
+    bool writeBinary(SkWStream*) const;
+
 private:
     SkArenaAlloc fAlloc;
     Value        fRoot;
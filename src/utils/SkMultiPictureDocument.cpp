@@ -7,6 +7,7 @@
 
 #include "SkMultiPictureDocument.h"
 
+#include "SkData.h"
 #include "SkMultiPictureDocumentPriv.h"
 #include "SkNWayCanvas.h"
 #include "SkPicture.h"
@@ -17,10 +18,32 @@
 #include "SkTo.h"
 
 #include <limits.h>
+#include <stdint.h>
 
 /*
   File format:
       BEGINNING_OF_FILE:
+        kMagic
+        uint32_t version_number (==3)
+        {
+          uint32_t kPageTag
+          float sizeX
+          float sizeY
+          uint32_t byte_count
+          skp file (byte_count bytes, then zeros to a multiple of 4)
+        } * page_count
+        uint32_t kIndexTag
+        uint32_t page_count
+        uint64_t page_offset * page_count     (of each kPageTag, from BEGINNING_OF_FILE)
+        uint64_t index_offset                 (of kIndexTag, from BEGINNING_OF_FILE)
+        uint32_t kIndexTag
+      END_OF_FILE
+
+  Pages are written as they end, so only one is held in memory at a time.  Readers that know the
+  stream's length find any page through the index at the end; others can still hop from page to
+  page using their byte counts.  Neither needs to deserialize the pages they don't read.
+
+  Version 2 files, which hold every page in a single skp file, can still be read:
         kMagic
         uint32_t version_number (==2)
         uint32_t page_count
@@ -34,67 +57,150 @@
 namespace {
 // The unique file signature for this file type.
 static constexpr char kMagic[] = "Skia Multi-Picture Doc\n\n";
+static constexpr size_t kMagicSize = sizeof(kMagic) - 1;
 
 static constexpr char kEndPage[] = "SkMultiPictureEndPage";
 
-const uint32_t kVersion = 2;
+const uint32_t kVersion = 3;
+const uint32_t kLegacyVersion = 2;
 
-static SkSize join(const SkTArray<SkSize>& sizes) {
-    SkSize joined = {0, 0};
-    for (SkSize s : sizes) {
-        joined = SkSize{SkTMax(joined.width(), s.width()), SkTMax(joined.height(), s.height())};
-    }
-    return joined;
-}
+const uint32_t kPageTag = SkSetFourByteTag('p', 'a', 'g', 'e');
+const uint32_t kIndexTag = SkSetFourByteTag('i', 'n', 'd', 'x');
+
+// Everything before a page's skp file.
+static constexpr size_t kPageHeaderSize = 4 * sizeof(uint32_t);
+static constexpr size_t kFooterSize = sizeof(uint64_t) + sizeof(uint32_t);
 
 struct MultiPictureDocument final : public SkDocument {
     const SkSerialProcs fProcs;
     SkPictureRecorder fPictureRecorder;
     SkSize fCurrentPageSize;
-    SkTArray<sk_sp<SkPicture>> fPages;
-    SkTArray<SkSize> fSizes;
+    SkTArray<uint64_t, true> fPageOffsets;
+    size_t fStart = 0;
+    bool fWroteHeader = false;
     MultiPictureDocument(SkWStream* s, const SkSerialProcs* procs)
         : SkDocument(s)
         , fProcs(procs ? *procs : SkSerialProcs())
     {}
     ~MultiPictureDocument() override { this->close(); }
 
+    uint64_t offset(SkWStream* wStream) const { return wStream->bytesWritten() - fStart; }
+
+    void writeHeader(SkWStream* wStream) {
+        if (!fWroteHeader) {
+            fStart = wStream->bytesWritten();
+            wStream->writeText(kMagic);
+            wStream->write32(kVersion);
+            fWroteHeader = true;
+        }
+    }
+
     SkCanvas* onBeginPage(SkScalar w, SkScalar h) override {
         fCurrentPageSize.set(w, h);
         return fPictureRecorder.beginRecording(w, h);
     }
     void onEndPage() override {
-        fSizes.push_back(fCurrentPageSize);
-        fPages.push_back(fPictureRecorder.finishRecordingAsPicture());
+        SkWStream* wStream = this->getStream();
+        this->writeHeader(wStream);
+        sk_sp<SkData> skp = fPictureRecorder.finishRecordingAsPicture()->serialize(&fProcs);
+
+        fPageOffsets.push_back(this->offset(wStream));
+        wStream->write32(kPageTag);
+        wStream->write(&fCurrentPageSize, sizeof(fCurrentPageSize));
+        wStream->write32(SkToU32(skp->size()));
+        wStream->write(skp->data(), skp->size());
+        static const uint32_t kZero = 0;
+        wStream->write(&kZero, SkAlign4(skp->size()) - skp->size());
     }
     void onClose(SkWStream* wStream) override {
         SkASSERT(wStream);
-        SkASSERT(wStream->bytesWritten() == 0);
-        wStream->writeText(kMagic);
-        wStream->write32(kVersion);
-        wStream->write32(SkToU32(fPages.count()));
-        for (SkSize s : fSizes) {
-            wStream->write(&s, sizeof(s));
-        }
-        SkSize bigsize = join(fSizes);
-        SkCanvas* c = fPictureRecorder.beginRecording(SkRect::MakeSize(bigsize));
-        for (const sk_sp<SkPicture>& page : fPages) {
-            c->drawPicture(page);
-            c->drawAnnotation(SkRect::MakeEmpty(), kEndPage, nullptr);
-        }
-        sk_sp<SkPicture> p = fPictureRecorder.finishRecordingAsPicture();
-        p->serialize(wStream, &fProcs);
-        fPages.reset();
-        fSizes.reset();
-        return;
+        this->writeHeader(wStream);
+        const uint64_t indexOffset = this->offset(wStream);
+        wStream->write32(kIndexTag);
+        wStream->write32(SkToU32(fPageOffsets.count()));
+        wStream->write(fPageOffsets.begin(), fPageOffsets.count() * sizeof(uint64_t));
+        wStream->write(&indexOffset, sizeof(indexOffset));
+        wStream->write32(kIndexTag);
+        fPageOffsets.reset();
     }
     void onAbort() override {
-        fPages.reset();
-        fSizes.reset();
+        fPageOffsets.reset();
     }
 };
+
+// Checks the magic and returns the version, or 0 if this isn't a multi-picture document.
+static uint32_t read_version(SkStreamSeekable* stream) {
+    char buffer[kMagicSize];
+    uint32_t version;
+    if (!stream || !stream->seek(0) || kMagicSize != stream->read(buffer, kMagicSize) ||
+        0 != memcmp(kMagic, buffer, kMagicSize) || !stream->readU32(&version)) {
+        return 0;
+    }
+    return version;
 }
 
+static bool read_u64(SkStream* stream, uint64_t* v) {
+    return sizeof(*v) == stream->read(v, sizeof(*v));
+}
+
+// Finds the offset of every page in a version 3 document.
+static bool read_page_offsets(SkStreamSeekable* stream, SkTArray<uint64_t, true>* offsets) {
+    offsets->reset();
+    uint32_t tag, count;
+
+    // With the stream's length, jump straight to the index through the footer.
+    const size_t kHeaderSize = kMagicSize + sizeof(uint32_t);
+    if (stream->hasLength() && stream->getLength() >= kHeaderSize + kFooterSize) {
+        uint64_t indexOffset;
+        if (!stream->seek(stream->getLength() - kFooterSize) ||
+            !read_u64(stream, &indexOffset) || !stream->readU32(&tag) || kIndexTag != tag ||
+            indexOffset > SIZE_MAX || !stream->seek((size_t)indexOffset) ||
+            !stream->readU32(&tag) || kIndexTag != tag || !stream->readU32(&count) ||
+            count > INT_MAX || count > stream->getLength() / sizeof(uint64_t)) {
+            return false;
+        }
+        offsets->reset(SkTo<int>(count));
+        size_t bytes = count * sizeof(uint64_t);
+        return bytes == stream->read(offsets->begin(), bytes);
+    }
+
+    // Otherwise hop from page to page until we reach the index.
+    size_t position = kHeaderSize;
+    while (stream->seek(position) && stream->readU32(&tag)) {
+        if (kIndexTag == tag) {
+            return true;
+        }
+        uint32_t byteCount;
+        if (kPageTag != tag || !stream->move(sizeof(SkSize)) || !stream->readU32(&byteCount) ||
+            offsets->count() == INT_MAX) {
+            return false;
+        }
+        offsets->push_back(position);
+        position += kPageHeaderSize + SkAlign4(byteCount);
+    }
+    return false;
+}
+
+// Reads the size, and if readPicture is true the picture, of a version 3 document's page.
+static bool read_page(SkStreamSeekable* stream, uint64_t offset, SkDocumentPage* page,
+                      bool readPicture, const SkDeserialProcs* procs) {
+    uint32_t tag, byteCount;
+    if (offset > SIZE_MAX || !stream->seek((size_t)offset) || !stream->readU32(&tag) ||
+        kPageTag != tag || sizeof(SkSize) != stream->read(&page->fSize, sizeof(SkSize))) {
+        return false;
+    }
+    if (!readPicture) {
+        return true;
+    }
+    if (!stream->readU32(&byteCount)) {
+        return false;
+    }
+    sk_sp<SkData> skp = SkData::MakeFromStream(stream, byteCount);
+    page->fPicture = skp ? SkPicture::MakeFromData(skp.get(), procs) : nullptr;
+    return page->fPicture != nullptr;
+}
+}  // namespace
+
 sk_sp<SkDocument> SkMakeMultiPictureDocument(SkWStream* wStream, const SkSerialProcs* procs) {
     return sk_make_sp<MultiPictureDocument>(wStream, procs);
 }
@@ -102,26 +208,22 @@ sk_sp<SkDocument> SkMakeMultiPictureDocument(SkWStream* wStream, const SkSerialP
 ////////////////////////////////////////////////////////////////////////////////
 
 int SkMultiPictureDocumentReadPageCount(SkStreamSeekable* stream) {
-    if (!stream) {
-        return 0;
-    }
-    stream->seek(0);
-    const size_t size = sizeof(kMagic) - 1;
-    char buffer[size];
-    if (size != stream->read(buffer, size) || 0 != memcmp(kMagic, buffer, size)) {
-        stream = nullptr;
-        return 0;
-    }
-    uint32_t versionNumber;
-    if (!stream->readU32(&versionNumber) || versionNumber != kVersion) {
-        return 0;
-    }
-    uint32_t pageCount;
-    if (!stream->readU32(&pageCount) || pageCount > INT_MAX) {
-        return 0;
+    switch (read_version(stream)) {
+        case kVersion: {
+            SkTArray<uint64_t, true> offsets;
+            return read_page_offsets(stream, &offsets) ? offsets.count() : 0;
+        }
+        case kLegacyVersion: {
+            uint32_t pageCount;
+            if (!stream->readU32(&pageCount) || pageCount > INT_MAX) {
+                return 0;
+            }
+            // leave stream position right here.
+            return SkTo<int>(pageCount);
+        }
+        default:
+            return 0;
     }
-    // leave stream position right here.
-    return SkTo<int>(pageCount);
 }
 
 bool SkMultiPictureDocumentReadPageSizes(SkStreamSeekable* stream,
@@ -130,6 +232,19 @@ bool SkMultiPictureDocumentReadPageSizes(SkStreamSeekable* stream,
     if (!dstArray || dstArrayCount < 1) {
         return false;
     }
+    if (kVersion == read_version(stream)) {
+        SkTArray<uint64_t, true> offsets;
+        if (!read_page_offsets(stream, &offsets) || offsets.count() != dstArrayCount) {
+            return false;
+        }
+        for (int i = 0; i < dstArrayCount; ++i) {
+            if (!read_page(stream, offsets[i], &dstArray[i], false, nullptr)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     int pageCount = SkMultiPictureDocumentReadPageCount(stream);
     if (pageCount < 1 || pageCount != dstArrayCount) {
         return false;
@@ -175,10 +290,54 @@ struct PagerCanvas : public SkNWayCanvas {
 };
 }  // namespace
 
+bool SkMultiPictureDocumentReadPage(SkStreamSeekable* stream,
+                                    int pageIndex,
+                                    SkDocumentPage* dst,
+                                    const SkDeserialProcs* procs) {
+    if (!dst || pageIndex < 0) {
+        return false;
+    }
+    switch (read_version(stream)) {
+        case kVersion: {
+            SkTArray<uint64_t, true> offsets;
+            return read_page_offsets(stream, &offsets) && pageIndex < offsets.count() &&
+                   read_page(stream, offsets[pageIndex], dst, true, procs);
+        }
+        case kLegacyVersion: {
+            // All the pages are in one picture, so there's nothing to skip.
+            int pageCount = SkMultiPictureDocumentReadPageCount(stream);
+            if (pageIndex >= pageCount) {
+                return false;
+            }
+            SkAutoTArray<SkDocumentPage> pages(pageCount);
+            if (!SkMultiPictureDocumentRead(stream, pages.get(), pageCount, procs)) {
+                return false;
+            }
+            *dst = pages[pageIndex];
+            return dst->fPicture != nullptr;
+        }
+        default:
+            return false;
+    }
+}
+
 bool SkMultiPictureDocumentRead(SkStreamSeekable* stream,
                                 SkDocumentPage* dstArray,
                                 int dstArrayCount,
                                 const SkDeserialProcs* procs) {
+    if (dstArray && dstArrayCount > 0 && kVersion == read_version(stream)) {
+        SkTArray<uint64_t, true> offsets;
+        if (!read_page_offsets(stream, &offsets) || offsets.count() != dstArrayCount) {
+            return false;
+        }
+        for (int i = 0; i < dstArrayCount; ++i) {
+            if (!read_page(stream, offsets[i], &dstArray[i], true, procs)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     if (!SkMultiPictureDocumentReadPageSizes(stream, dstArray, dstArrayCount)) {
         return false;
     }
@@ -17,7 +17,8 @@ struct SkSerialProcs;
 class SkStreamSeekable;
 
 /**
- *  Writes into a file format that is similar to SkPicture::serialize()
+ *  Writes into a file format that is similar to SkPicture::serialize(). Each page is written to
+ *  dst as soon as it ends.
  */
 SK_API sk_sp<SkDocument> SkMakeMultiPictureDocument(SkWStream* dst, const SkSerialProcs* = nullptr);
 
@@ -31,6 +32,15 @@ struct SkDocumentPage {
  */
 SK_API int SkMultiPictureDocumentReadPageCount(SkStreamSeekable* src);
 
+/**
+ *  Read one page of the SkMultiPictureDocument into dst, without reading the pages before it.
+ *  Return false on error, or if pageIndex is out of range.
+ */
+SK_API bool SkMultiPictureDocumentReadPage(SkStreamSeekable* src,
+                                           int pageIndex,
+                                           SkDocumentPage* dst,
+                                           const SkDeserialProcs* = nullptr);
+
 /**
  *  Read the SkMultiPictureDocument into the provided array of pages.
  *  dstArrayCount must equal SkMultiPictureDocumentReadPageCount().
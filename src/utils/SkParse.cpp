@@ -8,6 +8,7 @@
 
 #include "SkParse.h"
 
+#include <math.h>
 #include <stdlib.h>
 
 static inline bool is_between(int c, int min, int max)
@@ -199,17 +200,96 @@ const char* SkParse::FindMSec(const char str[], SkMSec* value)
     return str;
 }
 
+// Scans a decimal number ([+-]digits[.digits][(e|E)[+-]digits]) without going through the C
+// library, whose strtod() is slow and depends on the locale's decimal point. Returns the end of the
+// number, or nullptr if there are no digits.
+static const char* scan_decimal(const char str[], double* value) {
+    // Powers of ten that are exact as doubles.
+    static const double kPow10[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+    };
+    static constexpr int kMaxDigits = 19;  // fits in a uint64_t
+
+    const bool negative = *str == '-';
+    if (*str == '-' || *str == '+') {
+        str++;
+    }
+
+    uint64_t mantissa = 0;
+    int digits = 0,     // significant digits in mantissa
+        exponent = 0;   // decimal exponent to apply to mantissa
+    bool any = false;
+    for (; is_digit(*str); str++, any = true) {
+        if (digits < kMaxDigits) {
+            mantissa = mantissa * 10 + (*str - '0');
+            digits += mantissa != 0;
+        } else {
+            exponent++;
+        }
+    }
+    if (*str == '.') {
+        str++;
+        for (; is_digit(*str); str++, any = true) {
+            if (digits < kMaxDigits) {
+                mantissa = mantissa * 10 + (*str - '0');
+                digits += mantissa != 0;
+                exponent--;
+            }
+        }
+    }
+    if (!any) {
+        return nullptr;
+    }
+
+    // Only consume the exponent if it's well formed, so "1e" parses as 1 followed by 'e'.
+    if ((*str | 0x20) == 'e') {
+        const char* e = str + 1;
+        const bool negativeExp = *e == '-';
+        if (*e == '-' || *e == '+') {
+            e++;
+        }
+        if (is_digit(*e)) {
+            int exp = 0;
+            for (; is_digit(*e); e++) {
+                exp = SkTMin(exp * 10 + (*e - '0'), 100000);
+            }
+            exponent += negativeExp ? -exp : exp;
+            str = e;
+        }
+    }
+
+    double v = (double)mantissa;
+    if (mantissa == 0) {
+        // Leave v alone, so even huge exponents give zero.
+    } else if (mantissa <= (1ull << 53) && exponent >= -22 && exponent <= 22) {
+        // Both operands are exact, so this is correctly rounded, matching strtod().
+        v = exponent < 0 ? v / kPow10[-exponent] : v * kPow10[exponent];
+    } else {
+        // Out of range of the exact path; this is still far more precise than a float needs.
+        v *= pow(10.0, exponent);
+    }
+    *value = negative ? -v : v;
+    return str;
+}
+
 const char* SkParse::FindScalar(const char str[], SkScalar* value) {
     SkASSERT(str);
     str = skip_ws(str);
 
-    char* stop;
-    float v = (float)strtod(str, &stop);
-    if (str == stop) {
-        return nullptr;
+    double v;
+    const char* stop = scan_decimal(str, &v);
+    if (!stop) {
+        // Not a decimal number, but it might be something else strtod() knows, like "inf".
+        char* end;
+        v = strtod(str, &end);
+        if (str == end) {
+            return nullptr;
+        }
+        stop = end;
     }
     if (value) {
-        *value = v;
+        *value = (float)v;
     }
     return stop;
 }
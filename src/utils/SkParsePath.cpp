@@ -72,8 +72,28 @@ static const char* find_scalar(const char str[], SkScalar* value,
     return str;
 }
 
+// Estimates how many points a path string makes by counting the numbers in it, so the path can
+// be allocated up front rather than grown as it's parsed.
+static int estimate_point_count(const char str[]) {
+    int numbers = 0;
+    bool inNumber = false;
+    for (; *str; str++) {
+        const bool numeric = is_digit(*str) || *str == '.';
+        numbers += numeric && !inNumber;
+        // Exponents continue a number (the 'e' and its sign are never commands or separators).
+        inNumber = numeric || (inNumber && (*str == 'e' || *str == 'E' ||
+                                            ((str[-1] == 'e' || str[-1] == 'E') &&
+                                             (*str == '-' || *str == '+'))));
+    }
+    // Most commands take two numbers per point. Arcs (7 numbers, up to 8 points) may still grow.
+    return numbers / 2 + 1;
+}
+
 bool SkParsePath::FromSVGString(const char data[], SkPath* result) {
     SkPath path;
+    if (data) {
+        path.incReserve(estimate_point_count(data));
+    }
     SkPoint first = {0, 0};
     SkPoint c = {0, 0};
     SkPoint lastc = {0, 0};
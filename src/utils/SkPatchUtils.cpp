@@ -12,6 +12,8 @@
 #include "SkColorSpacePriv.h"
 #include "SkConvertPixels.h"
 #include "SkGeometry.h"
+#include "SkMathPriv.h"
+#include "SkResourceCache.h"
 #include "SkTo.h"
 
 namespace {
@@ -188,6 +190,44 @@ SkISize SkPatchUtils::GetLevelOfDetail(const SkPoint cubics[12], const SkMatrix*
     return SkISize::Make(SkMax32(8, lodX), SkMax32(8, lodY));
 }
 
+// It is recommended to generate draw calls of no more than 65536 indices, so we never generate
+// more than 60000 indices. To accomplish that we resize the LOD when it needs too many vertices.
+static SkISize limit_level_of_detail(int lodX, int lodY) {
+    const int64_t vertexCount = (int64_t)(lodX + 1) * (lodY + 1);
+    if (vertexCount > 10000 || lodX > 200 || lodY > 200) {
+        float weightX = static_cast<float>(lodX) / (lodX + lodY);
+        float weightY = static_cast<float>(lodY) / (lodX + lodY);
+
+        // 200 comes from the 100 * 2 which is the max value of vertices because of the limit of
+        // 60000 indices ( sqrt(60000 / 6) that comes from data->fIndexCount = lodX * lodY * 6)
+        // Need a min of 1 since we later divide by lod
+        lodX = std::max(1, sk_float_floor2int_no_saturate(weightX * 200));
+        lodY = std::max(1, sk_float_floor2int_no_saturate(weightY * 200));
+    }
+    return {lodX, lodY};
+}
+
+// Rounds lod up to a multiple of a quarter of the largest power of two at or below it, i.e. to one
+// of 8, 10, 12, 14, 16, 20, 24, 28, 32, 40, ...
+static int bucket_level_of_detail(int lod) {
+    // Anything this fine gets limited anyway.
+    lod = SkTMin(lod, 1 << 16);
+    if (lod <= 8) {
+        return lod;
+    }
+    int step = SkPrevPow2(lod) / 4;
+    return (lod + step - 1) / step * step;
+}
+
+SkISize SkPatchUtils::GetBucketedLevelOfDetail(const SkPoint cubics[12], const SkMatrix* matrix) {
+    SkISize lod = GetLevelOfDetail(cubics, matrix);
+    if (lod.isEmpty()) {
+        return {0, 0};
+    }
+    return limit_level_of_detail(bucket_level_of_detail(lod.width()),
+                                 bucket_level_of_detail(lod.height()));
+}
+
 void SkPatchUtils::GetTopCubic(const SkPoint cubics[12], SkPoint points[4]) {
     points[0] = cubics[kTopP0_CubicCtrlPts];
     points[1] = cubics[kTopP1_CubicCtrlPts];
@@ -252,20 +292,10 @@ sk_sp<SkVertices> SkPatchUtils::MakeVertices(const SkPoint cubics[12], const SkC
         colorSpace = sk_srgb_singleton();
     }
 
-    int vertexCount = SkToS32(mult64);
-    // it is recommended to generate draw calls of no more than 65536 indices, so we never generate
-    // more than 60000 indices. To accomplish that we resize the LOD and vertex count
-    if (vertexCount > 10000 || lodX > 200 || lodY > 200) {
-        float weightX = static_cast<float>(lodX) / (lodX + lodY);
-        float weightY = static_cast<float>(lodY) / (lodX + lodY);
-
-        // 200 comes from the 100 * 2 which is the max value of vertices because of the limit of
-        // 60000 indices ( sqrt(60000 / 6) that comes from data->fIndexCount = lodX * lodY * 6)
-        // Need a min of 1 since we later divide by lod
-        lodX = std::max(1, sk_float_floor2int_no_saturate(weightX * 200));
-        lodY = std::max(1, sk_float_floor2int_no_saturate(weightY * 200));
-        vertexCount = (lodX + 1) * (lodY + 1);
-    }
+    SkISize lod = limit_level_of_detail(lodX, lodY);
+    lodX = lod.width();
+    lodY = lod.height();
+    const int vertexCount = (lodX + 1) * (lodY + 1);
     const int indexCount = lodX * lodY * 6;
     uint32_t flags = 0;
     if (srcTexCoords) {
@@ -367,3 +397,85 @@ sk_sp<SkVertices> SkPatchUtils::MakeVertices(const SkPoint cubics[12], const SkC
     }
     return builder.detach();
 }
+
+namespace {
+static unsigned gPatchVerticesKeyNamespaceLabel;
+
+// Everything MakeVertices() depends on.
+struct PatchVerticesKey : public SkResourceCache::Key {
+public:
+    PatchVerticesKey(const SkPoint cubics[12], const SkColor colors[4], const SkPoint texCoords[4],
+                     SkISize lod, SkColorSpace* colorSpace) {
+        // The key is compared as bytes, so absent colors and texture coords are zeroed.
+        memset(fColors, 0, sizeof(fColors));
+        memset(fTexCoords, 0, sizeof(fTexCoords));
+        memcpy(fCubics, cubics, sizeof(fCubics));
+        if (colors) {
+            memcpy(fColors, colors, sizeof(fColors));
+        }
+        if (texCoords) {
+            memcpy(fTexCoords, texCoords, sizeof(fTexCoords));
+        }
+        fFlags = (colors ? 1 : 0) | (texCoords ? 2 : 0);
+        fLODX = lod.width();
+        fLODY = lod.height();
+        const SkColorSpace* cs = colorSpace ? colorSpace : sk_srgb_singleton();
+        fColorSpaceHash[0] = cs->toXYZD50Hash();
+        fColorSpaceHash[1] = cs->transferFnHash();
+
+        this->init(&gPatchVerticesKeyNamespaceLabel, 0,
+                   sizeof(fCubics) + sizeof(fColors) + sizeof(fTexCoords) + sizeof(fFlags) +
+                   sizeof(fLODX) + sizeof(fLODY) + sizeof(fColorSpaceHash));
+    }
+
+    SkPoint  fCubics[SkPatchUtils::kNumCtrlPts];
+    SkColor  fColors[SkPatchUtils::kNumCorners];
+    SkPoint  fTexCoords[SkPatchUtils::kNumCorners];
+    uint32_t fFlags;
+    int32_t  fLODX;
+    int32_t  fLODY;
+    uint32_t fColorSpaceHash[2];
+};
+
+struct PatchVerticesRec : public SkResourceCache::Rec {
+    PatchVerticesRec(const PatchVerticesKey& key, sk_sp<SkVertices> vertices)
+        : fKey(key)
+        , fVertices(std::move(vertices)) {}
+
+    PatchVerticesKey  fKey;
+    sk_sp<SkVertices> fVertices;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(*this) + fVertices->approximateSize(); }
+    const char* getCategory() const override { return "patch-vertices"; }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const PatchVerticesRec& rec = static_cast<const PatchVerticesRec&>(baseRec);
+        *static_cast<sk_sp<SkVertices>*>(contextData) = rec.fVertices;
+        return true;
+    }
+};
+} // namespace
+
+sk_sp<SkVertices> SkPatchUtils::MakeCachedVertices(const SkPoint cubics[12],
+                                                   const SkColor colors[4],
+                                                   const SkPoint texCoords[4],
+                                                   const SkMatrix& matrix,
+                                                   SkColorSpace* colorSpace) {
+    SkISize lod = GetBucketedLevelOfDetail(cubics, &matrix);
+    if (lod.isEmpty()) {
+        return nullptr;
+    }
+
+    PatchVerticesKey key(cubics, colors, texCoords, lod, colorSpace);
+    sk_sp<SkVertices> vertices;
+    if (SkResourceCache::Find(key, PatchVerticesRec::Visitor, &vertices)) {
+        return vertices;
+    }
+
+    vertices = MakeVertices(cubics, colors, texCoords, lod.width(), lod.height(), colorSpace);
+    if (vertices) {
+        SkResourceCache::Add(new PatchVerticesRec(key, vertices));
+    }
+    return vertices;
+}
@@ -49,9 +49,24 @@ public:
      */
     static SkISize GetLevelOfDetail(const SkPoint cubics[12], const SkMatrix* matrix);
 
+    /**
+     * Like GetLevelOfDetail(), but rounded up to a coarser set of levels (at most 25% finer) and
+     * limited like MakeVertices() limits it, so patches drawn at similar scales tessellate alike.
+     */
+    static SkISize GetBucketedLevelOfDetail(const SkPoint cubics[12], const SkMatrix* matrix);
+
     static sk_sp<SkVertices> MakeVertices(const SkPoint cubics[12], const SkColor colors[4],
                                           const SkPoint texCoords[4], int lodX, int lodY,
                                           SkColorSpace* colorSpace = nullptr);
+
+    /**
+     * MakeVertices() at the bucketed level of detail for matrix. The vertices are cached in
+     * SkResourceCache and returned again for the same patch, level of detail and color space,
+     * which also lets the GPU backend reuse their buffers.
+     */
+    static sk_sp<SkVertices> MakeCachedVertices(const SkPoint cubics[12], const SkColor colors[4],
+                                                const SkPoint texCoords[4], const SkMatrix& matrix,
+                                                SkColorSpace* colorSpace = nullptr);
 };
 
 #endif
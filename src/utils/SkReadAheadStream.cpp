@@ -0,0 +1,242 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkReadAheadStream.h"
+
+#include "SkExecutor.h"
+#include "SkMakeUnique.h"
+#include "SkMutex.h"
+#include "SkSemaphore.h"
+#include "SkTemplates.h"
+
+constexpr size_t SkReadAheadStream::kDefaultWindowBytes;
+
+namespace {
+
+// The window is a ring buffer: the reader consumes bytes from fHead while fill() appends the
+// source's bytes after the fSize already there.  Each only touches its own part of the ring, so
+// neither holds fMutex while copying, and fill() never holds it while reading the source.
+class ReadAheadStream final : public SkReadAheadStream {
+public:
+    ReadAheadStream(std::unique_ptr<SkStream> source, SkExecutor* executor, size_t windowBytes,
+                    std::function<void()> onData)
+        : fSource(std::move(source))
+        , fExecutor(executor)
+        , fOnData(std::move(onData))
+        , fWindowBytes(windowBytes)
+        , fWindow(windowBytes) {
+        this->startFill();
+    }
+
+    ~ReadAheadStream() override {
+        this->stopFill();
+    }
+
+    size_t read(void* buffer, size_t size) override {
+        size_t total = 0;
+        auto dst = static_cast<char*>(buffer);
+        while (total < size) {
+            size_t wanted = size - total;
+            if (!this->waitFor(SkTMin(wanted, fWindowBytes), fWaitForData)) {
+                break;
+            }
+
+            size_t n;
+            {
+                SkAutoMutexAcquire lock(fMutex);
+                n = SkTMin(wanted, fSize);
+            }
+            if (n == 0) {
+                break;  // The source has ended.
+            }
+            if (dst) {
+                this->copyOut(dst + total, n);
+            }
+            {
+                SkAutoMutexAcquire lock(fMutex);
+                fHead = (fHead + n) % fWindowBytes;
+                fSize -= n;
+            }
+            total += n;
+            this->startFill();
+        }
+        return total;
+    }
+
+    size_t peek(void* buffer, size_t size) const override {
+        size = SkTMin(size, fWindowBytes);
+        if (!this->waitFor(size, fWaitForData)) {
+            return 0;
+        }
+        {
+            SkAutoMutexAcquire lock(fMutex);
+            size = SkTMin(size, fSize);
+        }
+        this->copyOut(buffer, size);
+        return size;
+    }
+
+    bool isAtEnd() const override {
+        SkAutoMutexAcquire lock(fMutex);
+        return fEnded && fSize == 0;
+    }
+
+    bool rewind() override {
+        this->stopFill();
+        const bool rewound = fSource->rewind();
+        {
+            SkAutoMutexAcquire lock(fMutex);
+            fHead = fSize = 0;
+            // If the source can't rewind, what's been read of it is gone, so it's at its end.
+            fEnded = !rewound;
+            fStopping = false;
+        }
+        this->startFill();
+        return rewound;
+    }
+
+    void setWaitForData(bool wait) override { fWaitForData = wait; }
+
+    size_t bytesAvailable() const override {
+        SkAutoMutexAcquire lock(fMutex);
+        return fSize;
+    }
+
+    bool hasAllData() const override {
+        SkAutoMutexAcquire lock(fMutex);
+        return fEnded;
+    }
+
+private:
+    // Copies size bytes, which must have arrived, from the front of the window.
+    void copyOut(void* dst, size_t size) const {
+        size_t first = SkTMin(size, fWindowBytes - fHead);
+        memcpy(dst, fWindow.get() + fHead, first);
+        memcpy(static_cast<char*>(dst) + first, fWindow.get(), size - first);
+    }
+
+    // Returns true if size bytes, or the rest of the source, can be read, waiting for them if
+    // wait is true.
+    bool waitFor(size_t size, bool wait) const {
+        for (;;) {
+            {
+                SkAutoMutexAcquire lock(fMutex);
+                if (fSize >= size || fEnded) {
+                    return true;
+                }
+                if (!wait) {
+                    return false;
+                }
+                fWaiting = true;
+            }
+            fDataArrived.wait();
+        }
+    }
+
+    // Reads the source ahead on fExecutor, unless that's already happening or there's no need.
+    void startFill() {
+        {
+            SkAutoMutexAcquire lock(fMutex);
+            if (fFilling || fEnded || fStopping || fSize == fWindowBytes) {
+                return;
+            }
+            fFilling = true;
+        }
+        // Outside the lock, as the executor may run fill() right away on this thread.
+        fExecutor->add([this] { this->fill(); });
+    }
+
+    void fill() {
+        for (;;) {
+            char* dst = nullptr;
+            size_t n = 0;
+            bool stopping = false;
+            {
+                SkAutoMutexAcquire lock(fMutex);
+                if (fEnded || fStopping || fSize == fWindowBytes) {
+                    fFilling = false;
+                    stopping = fStopping;
+                } else {
+                    size_t tail = (fHead + fSize) % fWindowBytes;
+                    n   = SkTMin(fWindowBytes - fSize, fWindowBytes - tail);
+                    dst = fWindow.get() + tail;
+                }
+            }
+            if (!dst) {
+                // Once signaled, stopFill()'s caller may delete us, so it must come last.
+                if (stopping) {
+                    fFillStopped.signal();
+                }
+                return;
+            }
+
+            size_t bytesRead = fSource->read(dst, n);
+            const bool ended = bytesRead == 0 || fSource->isAtEnd();
+
+            bool waiting;
+            {
+                SkAutoMutexAcquire lock(fMutex);
+                fSize += bytesRead;
+                fEnded = ended;
+                waiting = fWaiting;
+                fWaiting = false;
+            }
+            if (waiting) {
+                fDataArrived.signal();
+            }
+            if (fOnData) {
+                fOnData();
+            }
+        }
+    }
+
+    // Waits for fill(), if it's running, to stop.
+    void stopFill() {
+        bool filling;
+        {
+            SkAutoMutexAcquire lock(fMutex);
+            fStopping = true;
+            filling = fFilling;
+        }
+        if (filling) {
+            fFillStopped.wait();
+        }
+    }
+
+    std::unique_ptr<SkStream> fSource;
+    SkExecutor* const         fExecutor;
+    std::function<void()>     fOnData;
+    const size_t              fWindowBytes;
+    SkAutoTMalloc<char>       fWindow;
+    bool                      fWaitForData = true;  // Only used by the reader.
+
+    mutable SkMutex           fMutex;  // Guards everything below.
+    size_t                    fHead     = 0;
+    size_t                    fSize     = 0;
+    bool                      fEnded    = false;
+    bool                      fFilling  = false;
+    bool                      fStopping = false;
+    mutable bool              fWaiting  = false;
+
+    mutable SkSemaphore       fDataArrived;
+    SkSemaphore               fFillStopped;
+};
+
+}  // namespace
+
+std::unique_ptr<SkReadAheadStream> SkReadAheadStream::Make(std::unique_ptr<SkStream> source,
+                                                           SkExecutor* executor,
+                                                           size_t windowBytes,
+                                                           std::function<void()> onData) {
+    if (!source) {
+        return nullptr;
+    }
+    return skstd::make_unique<ReadAheadStream>(std::move(source),
+                                               executor ? executor : &SkExecutor::GetDefault(),
+                                               SkTMax<size_t>(windowBytes, 1),
+                                               std::move(onData));
+}
@@ -6,6 +6,7 @@
 */
 
 #include "SkShadowUtils.h"
+#include "SkBitmap.h"
 #include "SkBlurMask.h"
 #include "SkCanvas.h"
 #include "SkColorFilter.h"
@@ -13,15 +14,19 @@
 #include "SkDevice.h"
 #include "SkDrawShadowInfo.h"
 #include "SkMaskFilter.h"
+#include "SkNx.h"
+#include "SkOnce.h"
 #include "SkPath.h"
 #include "SkPathPriv.h"
-#include "SkRandom.h"
+#include "SkPointPriv.h"
+#include "SkRRectPriv.h"
 #include "SkRasterPipeline.h"
 #include "SkResourceCache.h"
 #include "SkShadowTessellator.h"
 #include "SkString.h"
 #include "SkTLazy.h"
 #include "SkVertices.h"
+#include <atomic>
 #include <new>
 #if SK_SUPPORT_GPU
 #include "GrShape.h"
@@ -205,14 +210,19 @@ public:
     }
 
 private:
+    // Each shape keeps at most MAX_ENTRIES tessellations per kind of shadow, and no more than
+    // kMaxBytesPerSet of them, evicting the least recently used first.
+    static constexpr size_t kMaxBytesPerSet = 256 * 1024;
+
     template <typename FACTORY, int MAX_ENTRIES>
     class Set {
     public:
         size_t size() const { return fSize; }
 
+        // Only called with SkResourceCache's lock held, so bumping the use counts is safe.
         sk_sp<SkVertices> find(const FACTORY& factory, const SkMatrix& matrix,
                                SkVector* translate) const {
-            for (int i = 0; i < MAX_ENTRIES; ++i) {
+            for (int i = 0; i < fCount; ++i) {
                 if (fEntries[i].fFactory.isCompatible(factory, translate)) {
                     const SkMatrix& m = fEntries[i].fMatrix;
                     if (matrix.hasPerspective() || m.hasPerspective()) {
@@ -225,6 +235,7 @@ private:
                                matrix.getSkewY() != m.getSkewY()) {
                         continue;
                     }
+                    fEntries[i].fLastUse = ++fUseCount;
                     return fEntries[i].fVertices;
                 }
             }
@@ -237,30 +248,44 @@ private:
             if (!vertices) {
                 return nullptr;
             }
-            int i;
-            if (fCount < MAX_ENTRIES) {
-                i = fCount++;
-            } else {
-                i = fRandom.nextULessThan(MAX_ENTRIES);
-                fSize -= fEntries[i].fVertices->approximateSize();
+            size_t bytes = vertices->approximateSize();
+            while (fCount > 0 && (fCount == MAX_ENTRIES || fSize + bytes > kMaxBytesPerSet)) {
+                this->evictLeastRecentlyUsed();
             }
-            fEntries[i].fFactory = factory;
-            fEntries[i].fVertices = vertices;
-            fEntries[i].fMatrix = matrix;
-            fSize += vertices->approximateSize();
+            Entry& entry = fEntries[fCount++];
+            entry.fFactory = factory;
+            entry.fVertices = vertices;
+            entry.fMatrix = matrix;
+            entry.fLastUse = ++fUseCount;
+            fSize += bytes;
             return vertices;
         }
 
     private:
+        void evictLeastRecentlyUsed() {
+            int lru = 0;
+            for (int i = 1; i < fCount; ++i) {
+                if (fEntries[i].fLastUse < fEntries[lru].fLastUse) {
+                    lru = i;
+                }
+            }
+            fSize -= fEntries[lru].fVertices->approximateSize();
+            if (lru != fCount - 1) {
+                fEntries[lru] = std::move(fEntries[fCount - 1]);
+            }
+            fEntries[--fCount] = Entry();
+        }
+
         struct Entry {
             FACTORY fFactory;
             sk_sp<SkVertices> fVertices;
             SkMatrix fMatrix;
+            mutable uint32_t fLastUse = 0;
         };
         Entry fEntries[MAX_ENTRIES];
         int fCount = 0;
         size_t fSize = 0;
-        SkRandom fRandom;
+        mutable uint32_t fUseCount = 0;
     };
 
     Set<AmbientVerticesFactory, 4> fAmbientSet;
@@ -364,12 +389,31 @@ public:
     }
     bool isRRect(SkRRect* rrect) { return fShapeForKey.asRRect(rrect, nullptr, nullptr, nullptr); }
 #else
-    int keyBytes() const { return -1; }
-    void writeKey(void* key) const { SK_ABORT("Should never be called"); }
+    // Without GrShape we can still key rrects and ovals by their geometry.
+    int keyBytes() const {
+        SkRRect rrect;
+        return this->asRRect(&rrect) ? SkToInt(SkRRect::kSizeInMemory) : -1;
+    }
+    void writeKey(void* key) const {
+        SkRRect rrect;
+        SkAssertResult(this->asRRect(&rrect));
+        rrect.writeToMemory(key);
+    }
     bool isRRect(SkRRect* rrect) { return false; }
 #endif
 
 private:
+#if !SK_SUPPORT_GPU
+    bool asRRect(SkRRect* rrect) const {
+        SkRect oval;
+        if (fPath->isOval(&oval)) {
+            rrect->setOval(oval);
+            return true;
+        }
+        return fPath->isRRect(rrect);
+    }
+#endif
+
     const SkPath* fPath;
     const SkMatrix* fViewMatrix;
 #if SK_SUPPORT_GPU
@@ -380,6 +424,9 @@ private:
 // This creates a domain of keys in SkResourceCache used by this file.
 static void* kNamespace;
 
+static std::atomic<int> gCacheHits{0};
+static std::atomic<int> gCacheMisses{0};
+
 // When the SkPathRef genID changes, invalidate a corresponding GrResource described by key.
 class ShadowInvalidator : public SkPathRef::GenIDChangeListener {
 public:
@@ -429,8 +476,10 @@ bool draw_shadow(const FACTORY& factory,
     sk_sp<SkVertices> vertices;
     bool foundInCache = SkToBool(context.fVertices);
     if (foundInCache) {
+        gCacheHits++;
         vertices = std::move(context.fVertices);
     } else {
+        gCacheMisses++;
         // TODO: handle transforming the path as part of the tessellator
         if (key) {
             // Update or initialize a tessellation set and add it to the cache.
@@ -482,6 +531,15 @@ static SkPoint3 map(const SkMatrix& m, const SkPoint3& pt) {
     return result;
 }
 
+SkShadowUtils::CacheStats SkShadowUtils::GetCacheStats() {
+    return { gCacheHits.load(), gCacheMisses.load() };
+}
+
+void SkShadowUtils::ResetCacheStats() {
+    gCacheHits = 0;
+    gCacheMisses = 0;
+}
+
 void SkShadowUtils::ComputeTonalColors(SkColor inAmbientColor, SkColor inSpotColor,
                                        SkColor* outAmbientColor, SkColor* outSpotColor) {
     // For tonal color we only compute color values for the spot shadow.
@@ -559,6 +617,212 @@ void SkShadowUtils::DrawShadow(SkCanvas* canvas, const SkPath& path, const SkPoi
     canvas->private_draw_shadow_rec(path, rec);
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// exp(-4(1-u)^2) - 0.018 for u in [0, 1], which is the falloff GrShadowGeoProc uses.
+static const uint8_t* shadow_falloff_lut() {
+    static uint8_t lut[256];
+    static SkOnce once;
+    once([] {
+        for (int i = 0; i < 256; ++i) {
+            float factor = 1.0f - i / 255.0f;
+            float falloff = expf(-factor * factor * 4.0f) - 0.018f;
+            lut[i] = SkToU8(SkTPin(sk_float_round2int(falloff * 255), 0, 255));
+        }
+    });
+    return lut;
+}
+
+// Draws one shadow rrect the way GrShadowRRectOp does. Coverage follows the falloff over
+// blurWidth inward from the rrect's edge, and, unless insetWidth reaches the middle, stops
+// insetWidth in, where an opaque occluder would cover it. The A8 mask is handed to drawMask,
+// along with its device position and color.
+template <typename DrawMask>
+static void draw_shadow_rrect(const SkImageInfo& deviceInfo, const DrawMask& drawMask,
+                              SkColor color, const SkMatrix& viewMatrix, const SkRRect& rrect,
+                              SkScalar blurWidth, SkScalar insetWidth) {
+    SkRect devRect = viewMatrix.mapRect(rrect.getBounds());
+    SkScalar matrixFactor = viewMatrix[SkMatrix::kMScaleX] + viewMatrix[SkMatrix::kMSkewX];
+    SkScalar halfMin = 0.5f * SkTMin(devRect.width(), devRect.height());
+    SkScalar devRadius = SkTMin(SkScalarAbs(SkRRectPriv::GetSimpleRadii(rrect).fX * matrixFactor),
+                                halfMin);
+    SkScalar devInset = SkScalarAbs(insetWidth * matrixFactor);
+    if (devInset > halfMin) {
+        devInset = SK_ScalarInfinity;
+    }
+
+    SkIRect bounds = devRect.roundOut();
+    if (!bounds.intersect(SkIRect::MakeSize(deviceInfo.dimensions()))) {
+        return;
+    }
+    SkBitmap mask;
+    if (!mask.tryAllocPixels(SkImageInfo::MakeA8(bounds.width(), bounds.height()))) {
+        return;
+    }
+
+    // Distance in from the edge of the rrect, four pixels at a time, looked up in the falloff.
+    const uint8_t* lut = shadow_falloff_lut();
+    const Sk4f invBlur(blurWidth > 0 ? 1.0f / blurWidth : 1e6f);
+    const Sk4f halfX(0.5f * devRect.width() - devRadius);
+    const float halfY = 0.5f * devRect.height() - devRadius;
+    const Sk4f centerX(devRect.centerX());
+    const Sk4f lanes(0.5f, 1.5f, 2.5f, 3.5f);
+    for (int y = 0; y < bounds.height(); ++y) {
+        const Sk4f qy(SkScalarAbs(bounds.fTop + y + 0.5f - devRect.centerY()) - halfY);
+        const Sk4f oy = Sk4f::Max(qy, 0.0f);
+        uint8_t* row = mask.getAddr8(0, y);
+        for (int x = 0; x < bounds.width(); x += 4) {
+            Sk4f qx = (Sk4f(bounds.fLeft + x) + lanes - centerX).abs() - halfX;
+            Sk4f ox = Sk4f::Max(qx, 0.0f);
+            Sk4f d = devRadius - (ox * ox + oy * oy).sqrt() - Sk4f::Min(Sk4f::Max(qx, qy), 0.0f);
+            Sk4f u = Sk4f::Min(Sk4f::Max(d * invBlur, 0.0f), 1.0f);
+            u = (d > devInset).thenElse(0.0f, u);
+            Sk4i index = SkNx_cast<int>(u * 255.0f + 0.5f);
+            for (int k = 0; k < SkTMin(4, bounds.width() - x); ++k) {
+                row[x + k] = lut[index[k]];
+            }
+        }
+    }
+
+    drawMask(mask, bounds.fLeft, bounds.fTop, color);
+}
+
+// The raster version of GrRenderTargetContext::drawFastShadow(). Rects, circles and rrects with
+// circular corners under a similarity matrix get their shadows drawn straight from their
+// geometry, with the same shapes and falloff as the GPU, instead of being tessellated.
+// Returns false if the shadow needs to be tessellated after all.
+template <typename DrawMask>
+static bool draw_analytic_shadow(const SkImageInfo& deviceInfo, const DrawMask& drawMask,
+                                 const SkPath& path,
+                                 const SkMatrix& viewMatrix, const SkDrawShadowRec& rec) {
+    bool skipAnalytic = SkToBool(rec.fFlags & SkShadowFlags::kGeometricOnly_ShadowFlag);
+    if (tilted(rec.fZPlaneParams) || skipAnalytic ||
+        !viewMatrix.rectStaysRect() || !viewMatrix.isSimilarity()) {
+        return false;
+    }
+
+    SkRRect rrect;
+    SkRect rect;
+    bool isRRect = path.isRRect(&rrect) && SkRRectPriv::IsSimpleCircular(rrect) &&
+        rrect.radii(SkRRect::kUpperLeft_Corner).fX > SK_ScalarNearlyZero;
+    if (!isRRect &&
+        path.isOval(&rect) && SkScalarNearlyEqual(rect.width(), rect.height()) &&
+        rect.width() > SK_ScalarNearlyZero) {
+        rrect.setOval(rect);
+        isRRect = true;
+    }
+    if (!isRRect && path.isRect(&rect)) {
+        rrect.setRect(rect);
+        isRRect = true;
+    }
+    if (!isRRect) {
+        return false;
+    }
+    if (rrect.isEmpty()) {
+        return true;
+    }
+
+    SkPoint3 devLightPos = map(viewMatrix, rec.fLightPos);
+    SkScalar devToSrcScale = viewMatrix.isScaleTranslate() ?
+        SkScalarInvert(viewMatrix[SkMatrix::kMScaleX]) :
+        sk_float_rsqrt(viewMatrix[SkMatrix::kMScaleX] * viewMatrix[SkMatrix::kMScaleX] +
+                       viewMatrix[SkMatrix::kMSkewX] * viewMatrix[SkMatrix::kMSkewX]);
+    SkScalar occluderHeight = rec.fZPlaneParams.fZ;
+    bool transparent = SkToBool(rec.fFlags & SkShadowFlags::kTransparentOccluder_ShadowFlag);
+
+    if (SkColorGetA(rec.fAmbientColor) > 0) {
+        SkScalar devSpaceInsetWidth = SkDrawShadowMetrics::AmbientBlurRadius(occluderHeight);
+        const SkScalar umbraRecipAlpha = SkDrawShadowMetrics::AmbientRecipAlpha(occluderHeight);
+        const SkScalar devSpaceAmbientBlur = devSpaceInsetWidth * umbraRecipAlpha;
+
+        // Outset the shadow rrect to the border of the penumbra.
+        SkScalar ambientPathOutset = devSpaceInsetWidth * devToSrcScale;
+        SkRRect ambientRRect;
+        SkRect outsetRect = rrect.rect().makeOutset(ambientPathOutset, ambientPathOutset);
+        if (rrect.isOval()) {
+            ambientRRect = SkRRect::MakeOval(outsetRect);
+        } else {
+            SkScalar outsetRad = SkRRectPriv::GetSimpleRadii(rrect).fX + ambientPathOutset;
+            ambientRRect = SkRRect::MakeRectXY(outsetRect, outsetRad, outsetRad);
+        }
+        if (transparent) {
+            // set a large inset to force a fill
+            devSpaceInsetWidth = ambientRRect.width();
+        }
+        draw_shadow_rrect(deviceInfo, drawMask, rec.fAmbientColor, viewMatrix, ambientRRect,
+                          devSpaceAmbientBlur, devSpaceInsetWidth);
+    }
+
+    if (SkColorGetA(rec.fSpotColor) > 0) {
+        SkScalar devSpaceSpotBlur;
+        SkScalar spotScale;
+        SkVector spotOffset;
+        SkDrawShadowMetrics::GetSpotParams(occluderHeight, devLightPos.fX, devLightPos.fY,
+                                           devLightPos.fZ, rec.fLightRadius,
+                                           &devSpaceSpotBlur, &spotScale, &spotOffset);
+        const SkScalar srcSpaceSpotBlur = devSpaceSpotBlur * devToSrcScale;
+
+        // Adjust translate for the effect of the scale, and bring it into source space.
+        spotOffset.fX += spotScale*viewMatrix[SkMatrix::kMTransX];
+        spotOffset.fY += spotScale*viewMatrix[SkMatrix::kMTransY];
+        SkMatrix ctmInverse;
+        if (!viewMatrix.invert(&ctmInverse)) {
+            return true;
+        }
+        ctmInverse.mapPoints(&spotOffset, 1);
+
+        SkRRect spotShadowRRect;
+        SkMatrix shadowTransform;
+        shadowTransform.setScaleTranslate(spotScale, spotScale, spotOffset.fX, spotOffset.fY);
+        rrect.transform(shadowTransform, &spotShadowRRect);
+        SkScalar spotRadius = SkRRectPriv::GetSimpleRadii(spotShadowRRect).fX;
+
+        // See GrRenderTargetContext::drawFastShadow() for how the inset meets the occluder.
+        SkScalar blurOutset = srcSpaceSpotBlur;
+        SkScalar insetWidth = blurOutset;
+        if (transparent) {
+            insetWidth += spotShadowRRect.width();
+        } else {
+            SkScalar maxOffset;
+            if (rrect.isRect()) {
+                maxOffset = SkTMax(SkTMax(SkTAbs(spotShadowRRect.rect().fLeft -
+                                                 rrect.rect().fLeft),
+                                          SkTAbs(spotShadowRRect.rect().fTop -
+                                                 rrect.rect().fTop)),
+                                   SkTMax(SkTAbs(spotShadowRRect.rect().fRight -
+                                                 rrect.rect().fRight),
+                                          SkTAbs(spotShadowRRect.rect().fBottom -
+                                                 rrect.rect().fBottom)));
+            } else {
+                SkScalar dr = spotRadius - SkRRectPriv::GetSimpleRadii(rrect).fX;
+                SkPoint upperLeftOffset = SkPoint::Make(spotShadowRRect.rect().fLeft -
+                                                        rrect.rect().fLeft + dr,
+                                                        spotShadowRRect.rect().fTop -
+                                                        rrect.rect().fTop + dr);
+                SkPoint lowerRightOffset = SkPoint::Make(spotShadowRRect.rect().fRight -
+                                                         rrect.rect().fRight - dr,
+                                                         spotShadowRRect.rect().fBottom -
+                                                         rrect.rect().fBottom - dr);
+                maxOffset = SkScalarSqrt(SkTMax(SkPointPriv::LengthSqd(upperLeftOffset),
+                                                SkPointPriv::LengthSqd(lowerRightOffset))) + dr;
+            }
+            insetWidth += SkTMax(blurOutset, maxOffset);
+        }
+
+        // Outset the shadow rrect to the border of the penumbra.
+        SkRect outsetRect = spotShadowRRect.rect().makeOutset(blurOutset, blurOutset);
+        if (spotShadowRRect.isOval()) {
+            spotShadowRRect = SkRRect::MakeOval(outsetRect);
+        } else {
+            SkScalar outsetRad = spotRadius + blurOutset;
+            spotShadowRRect = SkRRect::MakeRectXY(outsetRect, outsetRad, outsetRad);
+        }
+        draw_shadow_rrect(deviceInfo, drawMask, rec.fSpotColor, viewMatrix, spotShadowRRect,
+                          2.0f * devSpaceSpotBlur, insetWidth);
+    }
+    return true;
+}
+
 static bool validate_rec(const SkDrawShadowRec& rec) {
     return rec.fLightPos.isFinite() && rec.fZPlaneParams.isFinite() &&
            SkScalarIsFinite(rec.fLightRadius);
@@ -586,6 +850,17 @@ void SkBaseDevice::drawShadow(const SkPath& path, const SkDrawShadowRec& rec) {
     SkMatrix viewMatrix = this->ctm();
     SkAutoDeviceCTMRestore adr(this, SkMatrix::I());
 
+    // Devices without pixels (PDF, SVG, ...) would rather have the geometry.
+    auto drawMask = [this](const SkBitmap& mask, int x, int y, SkColor color) {
+        SkPaint paint;
+        paint.setColor(color);
+        this->drawSprite(mask, x, y, paint);
+    };
+    if (kUnknown_SkColorType != this->imageInfo().colorType() &&
+        draw_analytic_shadow(this->imageInfo(), drawMask, path, viewMatrix, rec)) {
+        return;
+    }
+
     ShadowedPath shadowedPath(&path, &viewMatrix);
 
     bool tiltZPlane = tilted(rec.fZPlaneParams);
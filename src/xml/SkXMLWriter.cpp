@@ -7,6 +7,7 @@
 
 #include "SkXMLWriter.h"
 
+#include "SkBase64.h"
 #include "SkStream.h"
 #include "SkTo.h"
 
@@ -28,9 +29,9 @@ void SkXMLWriter::addAttribute(const char name[], const char value[]) {
 }
 
 void SkXMLWriter::addS32Attribute(const char name[], int32_t value) {
-    SkString    tmp;
-    tmp.appendS32(value);
-    this->addAttribute(name, tmp.c_str());
+    char    tmp[SkStrAppendS32_MaxSize];
+    char*   stop = SkStrAppendS32(tmp, value);
+    this->addAttributeLen(name, tmp, stop - tmp);
 }
 
 void SkXMLWriter::addHexAttribute(const char name[], uint32_t value, int minDigits) {
@@ -40,9 +41,14 @@ void SkXMLWriter::addHexAttribute(const char name[], uint32_t value, int minDigi
 }
 
 void SkXMLWriter::addScalarAttribute(const char name[], SkScalar value) {
-    SkString    tmp;
-    tmp.appendScalar(value);
-    this->addAttribute(name, tmp.c_str());
+    char    tmp[SkStrAppendScalar_MaxSize];
+    char*   stop = SkStrAppendScalar(tmp, value);
+    this->addAttributeLen(name, tmp, stop - tmp);
+}
+
+void SkXMLWriter::addBase64Attribute(const char name[], const char prefix[],
+                                     const void* data, size_t length) {
+    this->onAddBase64Attribute(name, prefix, data, length);
 }
 
 void SkXMLWriter::addText(const char text[], size_t length) {
@@ -129,20 +135,36 @@ static size_t escape_markup(char dst[], const char src[], size_t length) {
 }
 
 void SkXMLWriter::addAttributeLen(const char name[], const char value[], size_t length) {
+    if (fDoEscapeMarkup) {
+        this->onAddEscapedAttributeLen(name, value, length);
+    } else {
+        this->onAddAttributeLen(name, value, length);
+    }
+}
+
+void SkXMLWriter::onAddEscapedAttributeLen(const char name[], const char value[], size_t length) {
     SkString valueStr;
 
-    if (fDoEscapeMarkup) {
-        size_t   extra = escape_markup(nullptr, value, length);
-        if (extra) {
-            valueStr.resize(length + extra);
-            (void)escape_markup(valueStr.writable_str(), value, length);
-            value = valueStr.c_str();
-            length += extra;
-        }
+    size_t   extra = escape_markup(nullptr, value, length);
+    if (extra) {
+        valueStr.resize(length + extra);
+        (void)escape_markup(valueStr.writable_str(), value, length);
+        value = valueStr.c_str();
+        length += extra;
     }
     this->onAddAttributeLen(name, value, length);
 }
 
+void SkXMLWriter::onAddBase64Attribute(const char name[], const char prefix[],
+                                       const void* data, size_t length) {
+    size_t   prefixLength = strlen(prefix);
+    SkString valueStr(prefixLength + SkBase64::Encode(data, length, nullptr));
+
+    memcpy(valueStr.writable_str(), prefix, prefixLength);
+    SkBase64::Encode(data, length, valueStr.writable_str() + prefixLength);
+    this->onAddAttributeLen(name, valueStr.c_str(), valueStr.size());
+}
+
 void SkXMLWriter::startElementLen(const char elem[], size_t length) {
     this->onStartElementLen(elem, length);
 }
@@ -203,15 +225,58 @@ SkXMLStreamWriter::~SkXMLStreamWriter() {
     this->flush();
 }
 
-void SkXMLStreamWriter::onAddAttributeLen(const char name[], const char value[], size_t length) {
+void SkXMLStreamWriter::startAttribute(const char name[]) {
     SkASSERT(!fElems.top()->fHasChildren && !fElems.top()->fHasText);
     fStream.writeText(" ");
     fStream.writeText(name);
     fStream.writeText("=\"");
+}
+
+void SkXMLStreamWriter::onAddAttributeLen(const char name[], const char value[], size_t length) {
+    this->startAttribute(name);
     fStream.write(value, length);
     fStream.writeText("\"");
 }
 
+// Writes the runs between markup characters straight to the stream, rather than escaping into a
+// copy of the value first.
+void SkXMLStreamWriter::onAddEscapedAttributeLen(const char name[], const char value[],
+                                                 size_t length) {
+    this->startAttribute(name);
+
+    const char* run  = value;
+    const char* stop = value + length;
+    for (const char* src = value; src < stop; ++src) {
+        char        orig[2];
+        const char* seq = escape_char(*src, orig);
+        if (seq != orig) {
+            fStream.write(run, src - run);
+            fStream.writeText(seq);
+            run = src + 1;
+        }
+    }
+    fStream.write(run, stop - run);
+    fStream.writeText("\"");
+}
+
+// Encodes a few KB at a time through a stack buffer; base64 doesn't need escaping.
+void SkXMLStreamWriter::onAddBase64Attribute(const char name[], const char prefix[],
+                                             const void* data, size_t length) {
+    this->startAttribute(name);
+    fStream.writeText(prefix);
+
+    static constexpr size_t kChunkSize = 3 * 1024;  // a multiple of 3, so no padding until the end
+    char        encoded[kChunkSize / 3 * 4];
+    const char* src = static_cast<const char*>(data);
+    while (length > 0) {
+        size_t chunk = SkTMin(length, kChunkSize);
+        fStream.write(encoded, SkBase64::Encode(src, chunk, encoded));
+        src    += chunk;
+        length -= chunk;
+    }
+    fStream.writeText("\"");
+}
+
 void SkXMLStreamWriter::onAddText(const char text[], size_t length) {
     Elem* elem = fElems.top();
 
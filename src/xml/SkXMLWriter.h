@@ -23,6 +23,9 @@ public:
     void    addS32Attribute(const char name[], int32_t value);
     void    addAttribute(const char name[], const char value[]);
     void    addAttributeLen(const char name[], const char value[], size_t length);
+    // Writes prefix followed by the base64 encoding of data, e.g. for a data: URI.
+    void    addBase64Attribute(const char name[], const char prefix[],
+                               const void* data, size_t length);
     void    addHexAttribute(const char name[], uint32_t value, int minDigits = 0);
     void    addScalarAttribute(const char name[], SkScalar value);
     void    addText(const char text[], size_t length);
@@ -36,6 +39,10 @@ public:
 protected:
     virtual void onStartElementLen(const char elem[], size_t length) = 0;
     virtual void onAddAttributeLen(const char name[], const char value[], size_t length) = 0;
+    // These default to building the escaped or encoded value, then calling onAddAttributeLen().
+    virtual void onAddEscapedAttributeLen(const char name[], const char value[], size_t length);
+    virtual void onAddBase64Attribute(const char name[], const char prefix[],
+                                      const void* data, size_t length);
     virtual void onAddText(const char text[], size_t length) = 0;
     virtual void onEndElement() = 0;
 
@@ -71,9 +78,14 @@ protected:
     void onStartElementLen(const char elem[], size_t length) override;
     void onEndElement() override;
     void onAddAttributeLen(const char name[], const char value[], size_t length) override;
+    void onAddEscapedAttributeLen(const char name[], const char value[], size_t length) override;
+    void onAddBase64Attribute(const char name[], const char prefix[],
+                              const void* data, size_t length) override;
     void onAddText(const char text[], size_t length) override;
 
 private:
+    void startAttribute(const char name[]);
+
     SkWStream&      fStream;
 };
 
@@ -26,6 +26,7 @@
 #include "SkData.h"
 #include "SkDraw.h"
 #include "SkEndian.h"
+#include "SkExecutor.h"
 #include "SkFindAndPlaceGlyph.h"
 #include "SkGeometry.h"
 #include "SkHRESULT.h"
@@ -40,6 +41,7 @@
 #include "SkPoint.h"
 #include "SkRasterClip.h"
 #include "SkSFNTHeader.h"
+#include "SkSemaphore.h"
 #include "SkShader.h"
 #include "SkSize.h"
 #include "SkStream.h"
@@ -115,7 +117,8 @@ HRESULT SkXPSDevice::createId(wchar_t* buffer, size_t bufferSize, wchar_t sep) {
 SkXPSDevice::SkXPSDevice(SkISize s)
     : INHERITED(SkImageInfo::MakeUnknown(s.width(), s.height()),
                 SkSurfaceProps(0, kUnknown_SkPixelGeometry))
-    , fCurrentPage(0) {}
+    , fCurrentPage(0)
+    , fExecutor(nullptr) {}
 
 SkXPSDevice::~SkXPSDevice() {}
 
@@ -131,9 +134,11 @@ SkXPSDevice::TypefaceUse::~TypefaceUse() {
     delete this->glyphsUsed;
 }
 
-bool SkXPSDevice::beginPortfolio(SkWStream* outputStream, IXpsOMObjectFactory* factory) {
+bool SkXPSDevice::beginPortfolio(SkWStream* outputStream, IXpsOMObjectFactory* factory,
+                                 SkExecutor* executor) {
     SkASSERT(factory);
     fXpsFactory.reset(SkRefComPtr(factory));
+    fExecutor = executor;
     HRB(SkWIStream::CreateFromSkWStream(outputStream, &this->fOutputStream));
     return true;
 }
@@ -435,6 +440,7 @@ bool SkXPSDevice::endPortfolio() {
     }
 
     HRBM(this->fPackageWriter->Close(), "Could not close writer.");
+    fImageResources.reset();
 
     return true;
 }
@@ -623,18 +629,71 @@ static XPS_TILE_MODE SkToXpsTileMode[SkShader::kTileModeCount+1]
     /*None  */ {XTM_N,  XTM_N,   XTM_Y,   XTM_N},
 };
 
-HRESULT SkXPSDevice::createXpsImageBrush(
-        const SkBitmap& bitmap,
-        const SkMatrix& localMatrix,
-        const SkShader::TileMode (&xy)[2],
-        const SkAlpha alpha,
-        IXpsOMTileBrush** xpsBrush) {
-    SkDynamicMemoryWStream write;
-    if (!SkEncodeImage(&write, bitmap, SkEncodedImageFormat::kPNG, 100)) {
-        HRM(E_FAIL, "Unable to encode bitmap as png.");
+namespace {
+// PNG data being encoded by an SkExecutor task. The package writer only reads an image resource's
+// stream when it writes the first page using it, so encoding overlaps the rest of the drawing.
+struct PendingPng : public SkNVRefCnt<PendingPng> {
+    SkSemaphore   fDone;
+    sk_sp<SkData> fData;  // Empty if the encode failed.
+};
+
+// Waits for the PendingPng before its first read.
+class PendingPngStream final : public SkStream {
+public:
+    explicit PendingPngStream(sk_sp<PendingPng> pending) : fPending(std::move(pending)) {}
+
+    size_t read(void* buffer, size_t size) override { return this->stream()->read(buffer, size); }
+    bool isAtEnd() const override { return this->stream()->isAtEnd(); }
+    bool rewind() override { return this->stream()->rewind(); }
+    bool hasLength() const override { return true; }
+    size_t getLength() const override { return this->stream()->getLength(); }
+
+private:
+    SkMemoryStream* stream() const {
+        if (fPending) {
+            fPending->fDone.wait();
+            if (fPending->fData) {
+                fStream.setData(std::move(fPending->fData));
+            }
+            fPending.reset();
+        }
+        return &fStream;
+    }
+
+    mutable sk_sp<PendingPng> fPending;
+    mutable SkMemoryStream    fStream;
+};
+}  // namespace
+
+HRESULT SkXPSDevice::createXpsImageResource(const SkBitmap& bitmap,
+                                            IXpsOMImageResource** image) {
+    SkStream* read;
+    if (fExecutor) {
+        // Encode from an immutable copy, since the caller may change or free the pixels.
+        sk_sp<SkImage> pixels = SkMakeImageFromRasterBitmap(bitmap, kIfMutable_SkCopyPixelsMode);
+        if (!pixels) {
+            HRM(E_FAIL, "Unable to snapshot bitmap for encoding.");
+        }
+        sk_sp<PendingPng> pending = sk_make_sp<PendingPng>();
+        fExecutor->add([pixels, pending]() {
+            SkPixmap pixmap;
+            SkDynamicMemoryWStream write;
+            if (pixels->peekPixels(&pixmap) &&
+                SkEncodeImage(&write, pixmap, SkEncodedImageFormat::kPNG, 100)) {
+                pending->fData = write.detachAsData();
+            }
+            pending->fDone.signal();
+        });
+        read = new PendingPngStream(std::move(pending));
+    } else {
+        SkDynamicMemoryWStream write;
+        if (!SkEncodeImage(&write, bitmap, SkEncodedImageFormat::kPNG, 100)) {
+            HRM(E_FAIL, "Unable to encode bitmap as png.");
+        }
+        SkMemoryStream* memory = new SkMemoryStream;
+        memory->setData(write.detachAsData());
+        read = memory;
     }
-    SkMemoryStream* read = new SkMemoryStream;
-    read->setData(write.detachAsData());
     SkTScopedComPtr<IStream> readWrapper;
     HRM(SkIStream::CreateFromSkStream(read, true, &readWrapper),
         "Could not create stream from png data.");
@@ -650,14 +709,36 @@ HRESULT SkXPSDevice::createXpsImageBrush(
     HRM(this->fXpsFactory->CreatePartUri(buffer, &imagePartUri),
         "Could not create image part uri.");
 
-    SkTScopedComPtr<IXpsOMImageResource> imageResource;
     HRM(this->fXpsFactory->CreateImageResource(
             readWrapper.get(),
             XPS_IMAGE_TYPE_PNG,
             imagePartUri.get(),
-            &imageResource),
+            image),
         "Could not create image resource.");
 
+    return S_OK;
+}
+
+HRESULT SkXPSDevice::createXpsImageBrush(
+        const SkBitmap& bitmap,
+        uint32_t imageUniqueID,
+        const SkMatrix& localMatrix,
+        const SkShader::TileMode (&xy)[2],
+        const SkAlpha alpha,
+        IXpsOMTileBrush** xpsBrush) {
+    SkTScopedComPtr<IXpsOMImageResource> imageResource;
+    SkTScopedComPtr<IXpsOMImageResource>* shared =
+            imageUniqueID ? fImageResources.find(imageUniqueID) : nullptr;
+    if (shared) {
+        imageResource.reset(SkRefComPtr(shared->get()));
+    } else {
+        HR(this->createXpsImageResource(bitmap, &imageResource));
+        if (imageUniqueID) {
+            fImageResources.set(imageUniqueID, SkTScopedComPtr<IXpsOMImageResource>(
+                                                       SkRefComPtr(imageResource.get())));
+        }
+    }
+
     XPS_RECT bitmapRect = {
         0.0, 0.0,
         static_cast<FLOAT>(bitmap.width()), static_cast<FLOAT>(bitmap.height())
@@ -1060,6 +1141,7 @@ HRESULT SkXPSDevice::createXpsBrush(const SkPaint& skPaint,
 
         SkTScopedComPtr<IXpsOMTileBrush> tileBrush;
         HR(this->createXpsImageBrush(outTexture,
+                                     image->uniqueID(),
                                      localMatrix,
                                      xy,
                                      skPaint.getAlpha(),
@@ -1429,7 +1511,7 @@ HRESULT SkXPSDevice::applyMask(const SkMask& mask,
     bm.installMaskPixels(mask);
 
     SkTScopedComPtr<IXpsOMTileBrush> maskBrush;
-    HR(this->createXpsImageBrush(bm, m, xy, 0xFF, &maskBrush));
+    HR(this->createXpsImageBrush(bm, 0, m, xy, 0xFF, &maskBrush));
     HRM(shadedPath->SetOpacityMaskBrushLocal(maskBrush.get()),
         "Could not set mask.");
 
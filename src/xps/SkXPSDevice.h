@@ -27,9 +27,11 @@
 #include "SkShader.h"
 #include "SkSize.h"
 #include "SkTArray.h"
+#include "SkTHash.h"
 #include "SkTScopedComPtr.h"
 #include "SkTypeface.h"
 
+class SkExecutor;
 class SkGlyphRunList;
 
 //#define SK_XPS_USE_DETERMINISTIC_IDS
@@ -43,7 +45,12 @@ public:
     SK_API SkXPSDevice(SkISize);
     SK_API ~SkXPSDevice() override;
 
-    bool beginPortfolio(SkWStream* outputStream, IXpsOMObjectFactory*);
+    /**
+      @param executor if not null, images are PNG encoded on its threads while drawing continues.
+                      The encoded data is waited for when the page using it is written.
+     */
+    bool beginPortfolio(SkWStream* outputStream, IXpsOMObjectFactory*,
+                        SkExecutor* executor = nullptr);
     /**
       @param unitsPerMeter converts geometry units into physical units.
       @param pixelsPerMeter resolution to use when geometry must be rasterized.
@@ -130,6 +137,10 @@ private:
 
     SkTArray<TypefaceUse, true> fTypefaces;
 
+    SkExecutor* fExecutor;
+    // Image resources are shared by every draw of the same SkImage, on any page.
+    SkTHashMap<uint32_t, SkTScopedComPtr<IXpsOMImageResource>> fImageResources;
+
     /** Creates a GUID based id and places it into buffer.
         buffer should have space for at least GUID_ID_LEN wide characters.
         The string will always be wchar null terminated.
@@ -166,8 +177,14 @@ private:
         const SkColor skColor, const SkAlpha alpha,
         IXpsOMBrush** xpsBrush);
 
+    HRESULT createXpsImageResource(
+        const SkBitmap& bitmap,
+        IXpsOMImageResource** image);
+
+    /** imageUniqueID identifies the bitmap's SkImage, or is 0 if it has none. */
     HRESULT createXpsImageBrush(
         const SkBitmap& bitmap,
+        uint32_t imageUniqueID,
         const SkMatrix& localMatrix,
         const SkShader::TileMode (&xy)[2],
         const SkAlpha alpha,
@@ -25,7 +25,7 @@ struct SkXPSDocument final : public SkDocument {
     SkVector fUnitsPerMeter;
     SkVector fPixelsPerMeter;
 
-    SkXPSDocument(SkWStream*, SkScalar dpi, SkTScopedComPtr<IXpsOMObjectFactory>);
+    SkXPSDocument(SkWStream*, SkScalar dpi, SkTScopedComPtr<IXpsOMObjectFactory>, SkExecutor*);
     ~SkXPSDocument() override;
     SkCanvas* onBeginPage(SkScalar w, SkScalar h) override;
     void onEndPage() override;
@@ -36,7 +36,8 @@ struct SkXPSDocument final : public SkDocument {
 
 SkXPSDocument::SkXPSDocument(SkWStream* stream,
                    SkScalar dpi,
-                   SkTScopedComPtr<IXpsOMObjectFactory> xpsFactory)
+                   SkTScopedComPtr<IXpsOMObjectFactory> xpsFactory,
+                   SkExecutor* executor)
         : SkDocument(stream)
         , fXpsFactory(std::move(xpsFactory))
         , fDevice(SkISize{10000, 10000})
@@ -46,7 +47,7 @@ SkXPSDocument::SkXPSDocument(SkWStream* stream,
     SkScalar pixelsPerMeterScale = SkDoubleToScalar(dpi * 5000.0 / 127.0);
     fPixelsPerMeter.set(pixelsPerMeterScale, pixelsPerMeterScale);
     SkASSERT(fXpsFactory);
-    fDevice.beginPortfolio(stream, fXpsFactory.get());
+    fDevice.beginPortfolio(stream, fXpsFactory.get(), executor);
 }
 
 SkXPSDocument::~SkXPSDocument() {
@@ -77,10 +78,11 @@ void SkXPSDocument::onAbort() {}
 
 sk_sp<SkDocument> SkXPS::MakeDocument(SkWStream* stream,
                                       IXpsOMObjectFactory* factoryPtr,
-                                      SkScalar dpi) {
+                                      SkScalar dpi,
+                                      SkExecutor* executor) {
     SkTScopedComPtr<IXpsOMObjectFactory> factory(SkSafeRefComPtr(factoryPtr));
     return stream && factory
-           ? sk_make_sp<SkXPSDocument>(stream, dpi, std::move(factory))
+           ? sk_make_sp<SkXPSDocument>(stream, dpi, std::move(factory), executor)
            : nullptr;
 }
 #endif  // defined(SK_BUILD_FOR_WIN)
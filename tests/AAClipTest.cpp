@@ -20,6 +20,7 @@
 #include "SkRect.h"
 #include "SkRegion.h"
 #include "SkScalar.h"
+#include "SkTemplates.h"
 #include "SkTypes.h"
 #include "Test.h"
 
@@ -297,6 +298,116 @@ static void test_irect(skiatest::Reporter* reporter) {
     }
 }
 
+// Intersecting with a rect crops the clip's rows directly, which must match the general op.
+static void test_intersect_rect(skiatest::Reporter* reporter) {
+    SkPath path;
+    path.addCircle(50, 50, 50);
+    path.addCircle(50, 50, 40);
+    path.setFillType(SkPath::kEvenOdd_FillType);
+
+    SkAAClip ring;
+    ring.setPath(path);
+
+    SkRandom rand;
+    for (int i = 0; i < 1000; ++i) {
+        SkIRect r;
+        rand_irect(&r, 60, rand);
+
+        SkAAClip cropped(ring), rectClip, expected;
+        cropped.op(r, SkRegion::kIntersect_Op);
+        rectClip.setRect(r);
+        expected.op(ring, rectClip, SkRegion::kIntersect_Op);
+        REPORTER_ASSERT(reporter, cropped.getBounds() == expected.getBounds());
+
+        SkMask maskCropped, maskExpected;
+        cropped.copyToMask(&maskCropped);
+        expected.copyToMask(&maskExpected);
+        SkAutoMaskFreeImage freeCropped(maskCropped.fImage);
+        SkAutoMaskFreeImage freeExpected(maskExpected.fImage);
+        REPORTER_ASSERT(reporter, maskCropped == maskExpected);
+    }
+}
+
+// Records the coverage blitted to each pixel, and whether any pixel was blitted twice.
+class CoverageBlitter : public SkBlitter {
+public:
+    CoverageBlitter(int width, int height) : fWidth(width), fHeight(height), fOverlap(false) {
+        fCoverage.reset(width * height);
+        sk_bzero(fCoverage.get(), width * height);
+    }
+
+    void blitH(int x, int y, int width) override {
+        for (int i = 0; i < width; ++i) {
+            this->set(x + i, y, 0xFF);
+        }
+    }
+    void blitAntiH(int x, int y, const SkAlpha aa[], const int16_t runs[]) override {
+        for (int n = runs[0]; n > 0; x += n, aa += n, runs += n, n = runs[0]) {
+            for (int i = 0; i < n; ++i) {
+                this->set(x + i, y, aa[0]);
+            }
+        }
+    }
+    void blitV(int x, int y, int height, SkAlpha alpha) override {
+        for (int i = 0; i < height; ++i) {
+            this->set(x, y + i, alpha);
+        }
+    }
+    void blitRect(int x, int y, int width, int height) override {
+        for (int i = 0; i < height; ++i) {
+            this->blitH(x, y + i, width);
+        }
+    }
+
+    bool operator==(const CoverageBlitter& other) const {
+        return !fOverlap && !other.fOverlap &&
+               !memcmp(fCoverage.get(), other.fCoverage.get(), fWidth * fHeight);
+    }
+
+private:
+    void set(int x, int y, SkAlpha alpha) {
+        SkASSERT(x >= 0 && x < fWidth && y >= 0 && y < fHeight);
+        uint8_t* dst = &fCoverage[y * fWidth + x];
+        fOverlap |= *dst != 0;
+        *dst = alpha;
+    }
+
+    int fWidth, fHeight;
+    SkAutoTMalloc<uint8_t> fCoverage;
+    bool fOverlap;
+};
+
+// Clipped rects are blitted a group of rows sharing their runs at a time, which must cover the
+// same pixels, by the same amounts, as blitting them one row at a time.
+static void test_blit_rect(skiatest::Reporter* reporter) {
+    SkPath path;
+    path.addRRect(SkRRect::MakeRectXY(SkRect::MakeLTRB(2.5f, 3.25f, 97.5f, 96.75f), 12, 9));
+    path.addCircle(50, 50, 20, SkPath::kCCW_Direction);
+
+    SkAAClip clip;
+    clip.setPath(path);
+    const SkIRect& bounds = clip.getBounds();
+
+    SkRandom rand;
+    for (int i = 0; i < 200; ++i) {
+        SkIRect r;
+        rand_irect(&r, 100, rand);
+        if (!r.intersect(bounds)) {
+            continue;
+        }
+
+        CoverageBlitter byRect(100, 100), byRow(100, 100);
+        SkAAClipBlitter blitter;
+        blitter.init(&byRect, &clip);
+        blitter.blitRect(r.fLeft, r.fTop, r.width(), r.height());
+        blitter.init(&byRow, &clip);
+        for (int y = r.fTop; y < r.fBottom; ++y) {
+            blitter.blitH(r.fLeft, y, r.width());
+        }
+        REPORTER_ASSERT(reporter, byRect == byRow);
+    }
+}
+
 static void test_path_with_hole(skiatest::Reporter* reporter) {
     static const uint8_t gExpectedImage[] = {
         0xFF, 0xFF, 0xFF, 0xFF,
@@ -433,6 +544,8 @@ DEF_TEST(AAClip, reporter) {
     test_empty(reporter);
     test_path_bounds(reporter);
     test_irect(reporter);
+    test_intersect_rect(reporter);
+    test_blit_rect(reporter);
     test_rgn(reporter);
     test_path_with_hole(reporter);
     test_regressions();
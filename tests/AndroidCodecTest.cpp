@@ -295,3 +295,70 @@ DEF_TEST(AndroidCodec_sampledOrientation, r) {
         ERRORF(r, "got result \"%s\"\n", SkCodec::ResultToString(result));
     }
 }
+
+DEF_TEST(AndroidCodec_resize, r) {
+    if (GetResourcePath().isEmpty()) {
+        return;
+    }
+
+    for (const char* path : { "images/mandrill_512_q075.jpg", "images/color_wheel.png" }) {
+        auto data = GetResourceAsData(path);
+        if (!data) {
+            ERRORF(r, "Failed to get resource %s", path);
+            continue;
+        }
+        auto androidCodec = SkAndroidCodec::MakeFromCodec(SkCodec::MakeFromData(data));
+
+        // Decode at full size and let a draw do the resampling, for reference.
+        SkBitmap full;
+        full.allocPixels(androidCodec->getInfo().makeColorType(kN32_SkColorType)
+                                                .makeAlphaType(kPremul_SkAlphaType));
+        REPORTER_ASSERT(r, SkCodec::kSuccess == androidCodec->getAndroidPixels(
+                full.info(), full.getPixels(), full.rowBytes()));
+
+        // Not a size sampling or libjpeg can hit.
+        const SkISize size = { full.width() * 3 / 7, full.height() * 2 / 7 };
+        SkBitmap expected;
+        expected.allocPixels(full.info().makeWH(size.width(), size.height()));
+        full.pixmap().scalePixels(expected.pixmap(), kHigh_SkFilterQuality);
+
+        for (auto filter : { SkAndroidCodec::ResizeFilter::kBox,
+                             SkAndroidCodec::ResizeFilter::kLanczos3 }) {
+            SkAndroidCodec::AndroidOptions options;
+            options.fResizeFilter = filter;
+            SkBitmap bm;
+            bm.allocPixels(expected.info());
+            auto result = androidCodec->getAndroidPixels(bm.info(), bm.getPixels(),
+                                                         bm.rowBytes(), &options);
+            if (result != SkCodec::kSuccess) {
+                ERRORF(r, "%s: got result \"%s\"\n", path, SkCodec::ResultToString(result));
+                continue;
+            }
+
+            // Different filters won't agree exactly, but they should be close on average.
+            int64_t totalDiff = 0;
+            for (int y = 0; y < size.height(); y++) {
+                for (int x = 0; x < size.width(); x++) {
+                    SkColor a = bm.getColor(x, y),
+                            b = expected.getColor(x, y);
+                    totalDiff += std::abs((int) SkColorGetR(a) - (int) SkColorGetR(b)) +
+                                 std::abs((int) SkColorGetG(a) - (int) SkColorGetG(b)) +
+                                 std::abs((int) SkColorGetB(a) - (int) SkColorGetB(b)) +
+                                 std::abs((int) SkColorGetA(a) - (int) SkColorGetA(b));
+                }
+            }
+            const double meanDiff = (double) totalDiff / (4.0 * size.width() * size.height());
+            if (meanDiff > 8) {
+                ERRORF(r, "%s: resized decode is off by %g on average", path, meanDiff);
+            }
+        }
+
+        // Sizes larger than the image are rejected.
+        SkAndroidCodec::AndroidOptions options;
+        options.fResizeFilter = SkAndroidCodec::ResizeFilter::kBox;
+        SkBitmap bm;
+        bm.allocPixels(full.info().makeWH(full.width() + 1, full.height()));
+        REPORTER_ASSERT(r, SkCodec::kInvalidScale == androidCodec->getAndroidPixels(
+                bm.info(), bm.getPixels(), bm.rowBytes(), &options));
+    }
+}
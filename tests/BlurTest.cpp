@@ -20,6 +20,7 @@
 #include "SkImageInfo.h"
 #include "SkLayerDrawLooper.h"
 #include "SkMask.h"
+#include "SkMaskBlurFilter.h"
 #include "SkMaskFilter.h"
 #include "SkMaskFilterBase.h"
 #include "SkMath.h"
@@ -742,3 +743,42 @@ DEF_TEST(zero_blur, reporter) {
     bitmap.extractAlpha(&alpha, &paint, nullptr, &offset);
 }
 
+
+// A8 masks take the four-rows-at-a-time path through the horizontal pass, while ARGB32 masks
+// take the one-row-at-a-time path, so the two should blur the same alpha to the same bytes.
+DEF_TEST(BlurMaskFilter_A8MatchesARGB32, reporter) {
+    const int kWidth = 37, kHeight = 29;  // not multiples of four, so both paths run
+
+    SkMask a8, argb;
+    a8.fBounds = argb.fBounds = SkIRect::MakeWH(kWidth, kHeight);
+    a8.fFormat = SkMask::kA8_Format;
+    a8.fRowBytes = kWidth;
+    argb.fFormat = SkMask::kARGB32_Format;
+    argb.fRowBytes = kWidth * 4;
+    SkAutoMaskFreeImage a8Storage(a8.fImage = SkMask::AllocImage(a8.computeImageSize()));
+    SkAutoMaskFreeImage argbStorage(argb.fImage = SkMask::AllocImage(argb.computeImageSize()));
+
+    uint32_t* argbPixels = reinterpret_cast<uint32_t*>(argb.fImage);
+    for (int y = 0; y < kHeight; y++) {
+        for (int x = 0; x < kWidth; x++) {
+            uint8_t alpha = (uint8_t)((x * 7 + y * 13) * (x ^ y));
+            a8.fImage[y * kWidth + x] = alpha;
+            argbPixels[y * kWidth + x] = SkPackARGB32(alpha, 0, 0, 0);
+        }
+    }
+
+    for (double sigma : {2.5, 17.0, 55.0}) {
+        SkMaskBlurFilter filter(sigma, sigma);
+        SkMask a8Dst, argbDst;
+        SkIPoint a8Border = filter.blur(a8, &a8Dst);
+        SkIPoint argbBorder = filter.blur(argb, &argbDst);
+        SkAutoMaskFreeImage a8DstStorage(a8Dst.fImage);
+        SkAutoMaskFreeImage argbDstStorage(argbDst.fImage);
+
+        REPORTER_ASSERT(reporter, a8Border == argbBorder);
+        REPORTER_ASSERT(reporter, a8Dst.fBounds == argbDst.fBounds);
+        REPORTER_ASSERT(reporter, a8Dst.fFormat == argbDst.fFormat);
+        REPORTER_ASSERT(reporter, 0 == memcmp(a8Dst.fImage, argbDst.fImage,
+                                              a8Dst.computeImageSize()));
+    }
+}
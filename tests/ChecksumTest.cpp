@@ -71,3 +71,71 @@ DEF_TEST(ChecksumCollisions, r) {
         REPORTER_ASSERT(r, SkOpts::hash(a, sizeof(a)) != SkOpts::hash(b, sizeof(b)));
     }
 }
+
+DEF_TEST(ChecksumLongKeys, r) {
+    // Long enough to hash 64 bytes at a time on some CPUs, with some left over, and long enough to
+    // be scrambled a few times along the way.
+    const size_t kBytes = 4096 + 37;
+    SkRandom rand;
+    uint8_t data[kBytes];
+    for (size_t i = 0; i < kBytes; ++i) {
+        data[i] = (uint8_t)rand.nextU();
+    }
+
+    const uint32_t hash = SkOpts::hash(data, kBytes);
+    REPORTER_ASSERT(r, hash == SkOpts::hash(data, kBytes));
+    REPORTER_ASSERT(r, hash != SkOpts::hash(data, kBytes, 1));
+    REPORTER_ASSERT(r, hash != SkOpts::hash(data, kBytes - 1));
+
+    // Changing any single byte should change the hash.
+    for (size_t i = 0; i < kBytes; i += 7) {
+        const uint8_t saved = data[i];
+        data[i] ^= 1 + (rand.nextU() % 255);
+        REPORTER_ASSERT(r, hash != SkOpts::hash(data, kBytes));
+        data[i] = saved;
+    }
+    REPORTER_ASSERT(r, hash == SkOpts::hash(data, kBytes));
+}
+
+DEF_TEST(ChecksumHasher, r) {
+    const size_t kBytes = 3 * SkHasher::kBlockBytes + 5;
+    SkRandom rand;
+    uint8_t data[kBytes];
+    for (size_t i = 0; i < kBytes; ++i) {
+        data[i] = (uint8_t)rand.nextU();
+    }
+
+    // Nothing written hashes like a zero length key.
+    REPORTER_ASSERT(r, SkHasher().finish() == SkOpts::hash(nullptr, 0));
+    REPORTER_ASSERT(r, SkHasher(7).finish() == SkOpts::hash(nullptr, 0, 7));
+
+    // Up to a block, keys hash the same written in pieces as hashed all at once.
+    for (size_t bytes : { (size_t)1, (size_t)13, (size_t)300, SkHasher::kBlockBytes }) {
+        SkHasher hasher(42);
+        size_t written = 0;
+        while (written < bytes) {
+            size_t n = SkTMin(bytes - written, (size_t)(1 + rand.nextU() % 64));
+            hasher.write(data + written, n);
+            written += n;
+        }
+        REPORTER_ASSERT(r, hasher.finish() == SkOpts::hash(data, bytes, 42));
+    }
+
+    // However they're split up, longer keys all hash the same.
+    SkHasher whole;
+    whole.write(data, kBytes);
+    const uint32_t hash = whole.finish();
+    for (size_t piece : { (size_t)1, (size_t)3, (size_t)64, SkHasher::kBlockBytes - 1,
+                          SkHasher::kBlockBytes, SkHasher::kBlockBytes + 1, 2 * kBytes }) {
+        SkHasher hasher;
+        for (size_t written = 0; written < kBytes; written += piece) {
+            hasher.write(data + written, SkTMin(piece, kBytes - written));
+        }
+        REPORTER_ASSERT(r, hasher.finish() == hash);
+    }
+
+    data[kBytes - 1] ^= 1;
+    SkHasher tweaked;
+    tweaked.write(data, kBytes);
+    REPORTER_ASSERT(r, tweaked.finish() != hash);
+}
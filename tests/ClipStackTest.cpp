@@ -1235,6 +1235,32 @@ static void test_reduced_clip_stack_no_aa_crash(skiatest::Reporter* reporter) {
     REPORTER_ASSERT(reporter, reduced.maskElements().isEmpty());
 }
 
+static void test_reduced_clip_stack_difference_rrects(skiatest::Reporter* reporter) {
+    // Ten rounded cutouts, AA and BW, in one layer.
+    SkClipStack stack;
+    for (int i = 0; i < 10; ++i) {
+        SkRect rect = SkRect::MakeXYWH(20 + 90 * i, 20 + 40 * i, 60, 30);
+        stack.clipRRect(SkRRect::MakeRectXY(rect, 8, 8), SkMatrix::I(), kDifference_SkClipOp,
+                        i & 1);
+    }
+    SkRect bounds = SkRect::MakeWH(1000, 1000);
+
+    auto context = GrContext::MakeMock(nullptr);
+    const GrCaps* caps = context->priv().caps();
+
+    // The cutouts are batched, GrDifferenceClipEffect::kMaxShapes to an analytic FP.
+    GrReducedClip reduced(stack, bounds, caps, 0, 4);
+    REPORTER_ASSERT(reporter, reduced.maskElements().isEmpty());
+    REPORTER_ASSERT(reporter, 2 == reduced.numAnalyticFPs());
+    REPORTER_ASSERT(reporter, reduced.finishAndDetachAnalyticFPs(nullptr, 0, 1000, 1000));
+
+    // The ones that don't fit in the budget are left for the mask.
+    const GrReducedClip oneFP(stack, bounds, caps, 0, 1);
+    REPORTER_ASSERT(reporter, 1 == oneFP.numAnalyticFPs());
+    REPORTER_ASSERT(reporter, 10 - GrDifferenceClipEffect::kMaxShapes ==
+                              oneFP.maskElements().count());
+}
+
 enum class ClipMethod {
     kSkipDraw,
     kIgnoreClip,
@@ -1510,6 +1536,7 @@ DEF_TEST(ClipStack, reporter) {
     test_reduced_clip_stack(reporter);
     test_reduced_clip_stack_genid(reporter);
     test_reduced_clip_stack_no_aa_crash(reporter);
+    test_reduced_clip_stack_difference_rrects(reporter);
     test_reduced_clip_stack_aa(reporter);
     test_tiny_query_bounds_assertion_bug(reporter);
     test_is_rrect_deep_rect_stack(reporter);
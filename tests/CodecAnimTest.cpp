@@ -13,6 +13,8 @@
 #include "SkCodec.h"
 #include "SkCodecAnimation.h"
 #include "SkData.h"
+#include "SkExecutor.h"
+#include "SkImage.h"
 #include "SkImageInfo.h"
 #include "SkMakeUnique.h"
 #include "SkRefCnt.h"
@@ -452,6 +454,67 @@ DEF_TEST(AndroidCodec_animated, r) {
     }
 }
 
+// With an executor, SkWebpCodec decodes each next frame ahead of time. Playing through
+// the animation that way has to produce the same frames as the serial decode, including
+// when the dst format means the prefetched pixels still need a color transform or a blend.
+DEF_TEST(Codec_webpExecutor, r) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    for (const char* file : { "images/blendBG.webp", "images/required.webp",
+                              "images/webp-animated.webp" }) {
+        sk_sp<SkData> data(GetResourceAsData(file));
+        if (!data) {
+            continue;
+        }
+        std::unique_ptr<SkCodec> serial(SkCodec::MakeFromData(data));
+        std::unique_ptr<SkCodec> threaded(SkCodec::MakeFromData(data));
+        if (!serial || !threaded) {
+            ERRORF(r, "Failed to create codec for %s", file);
+            continue;
+        }
+
+        for (SkColorType colorType : { kN32_SkColorType, kRGB_565_SkColorType }) {
+            const int frameCount = serial->getFrameCount();
+            SkImageInfo info = serial->getInfo().makeColorType(colorType);
+            SkBitmap expected, actual;
+            expected.allocPixels(info);
+            actual.allocPixels(info);
+
+            for (int i = 0; i < frameCount; i++) {
+                SkCodec::FrameInfo frameInfo;
+                REPORTER_ASSERT(r, serial->getFrameInfo(i, &frameInfo));
+                SkAlphaType alphaType = kRGB_565_SkColorType == colorType
+                        ? kOpaque_SkAlphaType : frameInfo.fAlphaType;
+                if (kUnpremul_SkAlphaType == alphaType) {
+                    alphaType = kPremul_SkAlphaType;
+                }
+                info = info.makeAlphaType(alphaType);
+
+                SkCodec::Options options;
+                options.fFrameIndex = i;
+                options.fPriorFrame = i - 1;
+                auto result = serial->getPixels(info, expected.getPixels(),
+                                                expected.rowBytes(), &options);
+                if (SkCodec::kSuccess != result) {
+                    // 565 can't represent every frame; that's not what we're testing.
+                    break;
+                }
+                options.fExecutor = executor.get();
+                result = threaded->getPixels(info, actual.getPixels(), actual.rowBytes(),
+                                             &options);
+                REPORTER_ASSERT(r, SkCodec::kSuccess == result);
+
+                for (int y = 0; y < info.height(); y++) {
+                    if (memcmp(expected.getAddr(0, y), actual.getAddr(0, y),
+                               info.minRowBytes())) {
+                        ERRORF(r, "%s: frame %i differs at row %i", file, i, y);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
+
 DEF_TEST(AnimCodecPlayer, r) {
     static constexpr struct {
         const char* fFile;
@@ -484,3 +547,74 @@ DEF_TEST(AnimCodecPlayer, r) {
         REPORTER_ASSERT(r, f1->bounds().size() == test.fSize);
     }
 }
+
+// Frames decoded out of order, from a small cache and ahead of time, should match frames decoded
+// in order with everything cached.
+DEF_TEST(AnimCodecPlayer_cache, r) {
+    static constexpr const char* gFiles[] = {
+        "images/alphabetAnim.gif",
+        "images/required.gif",
+        "images/randPixelsAnim.gif",
+        "images/required.webp",
+        "images/blendBG.webp",
+    };
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    for (const char* file : gFiles) {
+        sk_sp<SkData> data = GetResourceAsData(file);
+        if (!data) {
+            continue;
+        }
+        auto codec = SkCodec::MakeFromData(data);
+        REPORTER_ASSERT(r, codec);
+        if (!codec) {
+            continue;
+        }
+
+        // Seeking to just after a frame starts shows that frame.
+        std::vector<uint32_t> times;
+        uint32_t time = 0;
+        for (const auto& info : codec->getFrameInfo()) {
+            if (info.fDuration > 0) {
+                times.push_back(time + 1);
+            }
+            time += info.fDuration;
+        }
+        const int frameCount = SkToInt(times.size());
+
+        SkAnimCodecPlayer expectedPlayer(std::move(codec));
+        std::vector<sk_sp<SkImage>> expected;
+        for (int i = 0; i < frameCount; ++i) {
+            expectedPlayer.seek(times[i]);
+            expected.push_back(expectedPlayer.getFrame());
+            REPORTER_ASSERT(r, expected.back());
+        }
+
+        for (SkExecutor* exec : { (SkExecutor*)nullptr, executor.get() }) {
+            SkAnimCodecPlayer::Options options;
+            const SkISize size = expectedPlayer.dimensions();
+            options.fCacheBudget = 2 * size.width() * size.height() * sizeof(SkPMColor);
+            options.fExecutor = exec;
+            options.fPrefetchCount = 1;
+            SkAnimCodecPlayer player(SkCodec::MakeFromData(data), options);
+
+            // Backwards, then alternating between the ends.
+            std::vector<int> order;
+            for (int i = frameCount - 1; i >= 0; --i) {
+                order.push_back(i);
+            }
+            for (int i = 0; i < frameCount; ++i) {
+                order.push_back(i % 2 ? frameCount - 1 - i / 2 : i / 2);
+            }
+            for (int i : order) {
+                player.seek(times[i]);
+                sk_sp<SkImage> frame = player.getFrame();
+                REPORTER_ASSERT(r, frame);
+                if (frame && expected[i] &&
+                    !sk_tool_utils::equal_pixels(frame.get(), expected[i].get())) {
+                    ERRORF(r, "%s: frame %i differs%s", file, i, exec ? " (prefetched)" : "");
+                }
+            }
+        }
+    }
+}
@@ -11,8 +11,10 @@
 #include "SkBitmap.h"
 #include "SkCodec.h"
 #include "SkData.h"
+#include "SkImageEncoder.h"
 #include "SkImageInfo.h"
 #include "SkMakeUnique.h"
+#include "SkRandom.h"
 #include "SkRefCnt.h"
 #include "SkStream.h"
 #include "SkTypes.h"
@@ -369,6 +371,98 @@ DEF_TEST(Codec_rewind, r) {
     test_interleaved(r, "images/box.gif");
 }
 
+namespace {
+// Counts rewinds, to tell an incremental decode that picked up where the last one stopped
+// from one that started over.
+class RewindCountingStream : public SkMemoryStream {
+public:
+    RewindCountingStream(sk_sp<SkData> data, int* rewinds)
+        : SkMemoryStream(std::move(data)), fRewinds(rewinds) {}
+
+    bool rewind() override {
+        (*fRewinds)++;
+        return SkMemoryStream::rewind();
+    }
+
+private:
+    int* fRewinds;
+};
+}  // namespace
+
+// Decode the image a strip at a time, top to bottom, as incremental decodes of subsets.
+// Non-interlaced PNGs should carry on from the previous strip instead of rewinding.
+static void test_strips(skiatest::Reporter* r, const char* name, sk_sp<SkData> file,
+                        bool expectResume) {
+    SkBitmap truth;
+    if (!create_truth(file, &truth)) {
+        ERRORF(r, "Failed to decode %s", name);
+        return;
+    }
+    const SkImageInfo& info = truth.info();
+
+    for (int stripHeight : { 1, 7, 64 }) {
+        int rewinds = 0;
+        std::unique_ptr<SkCodec> codec(SkCodec::MakeFromStream(
+                skstd::make_unique<RewindCountingStream>(file, &rewinds)));
+        if (!codec) {
+            ERRORF(r, "Failed to create codec for %s", name);
+            return;
+        }
+
+        SkBitmap strips;
+        strips.allocPixels(info);
+        for (int top = 0; top < info.height(); top += stripHeight) {
+            const SkIRect subset = SkIRect::MakeLTRB(0, top, info.width(),
+                                                     SkTMin(top + stripHeight, info.height()));
+            SkCodec::Options options;
+            options.fSubset = &subset;
+            REPORTER_ASSERT(r, SkCodec::kSuccess == codec->startIncrementalDecode(info,
+                    strips.getAddr(0, top), strips.rowBytes(), &options));
+            REPORTER_ASSERT(r, SkCodec::kSuccess == codec->incrementalDecode());
+        }
+        compare_bitmaps(r, truth, strips);
+        if (expectResume) {
+            REPORTER_ASSERT(r, 0 == rewinds);
+        }
+
+        // Going back up means starting over, and still gets the right rows.
+        const int height = SkTMin(stripHeight, info.height());
+        const SkIRect subset = SkIRect::MakeWH(info.width(), height);
+        SkCodec::Options options;
+        options.fSubset = &subset;
+        strips.eraseColor(SK_ColorTRANSPARENT);
+        REPORTER_ASSERT(r, SkCodec::kSuccess == codec->startIncrementalDecode(info,
+                strips.getPixels(), strips.rowBytes(), &options));
+        REPORTER_ASSERT(r, SkCodec::kSuccess == codec->incrementalDecode());
+        for (int y = 0; y < height; y++) {
+            REPORTER_ASSERT(r, !memcmp(truth.getAddr(0, y), strips.getAddr(0, y),
+                                       info.minRowBytes()));
+        }
+    }
+}
+
+DEF_TEST(Codec_pngStrips, r) {
+    // Noise compresses badly, so this spans many of the buffers processData() feeds libpng.
+    SkBitmap noise;
+    noise.allocN32Pixels(123, 300);
+    SkRandom random;
+    for (int y = 0; y < noise.height(); y++) {
+        for (int x = 0; x < noise.width(); x++) {
+            *noise.getAddr32(x, y) = random.nextU() | 0xFF000000;
+        }
+    }
+    SkDynamicMemoryWStream stream;
+    if (SkEncodeImage(&stream, noise, SkEncodedImageFormat::kPNG, 100)) {
+        test_strips(r, "noise", stream.detachAsData(), true);
+    }
+
+    for (const char* name : { "images/plane.png", "images/plane_interlaced.png" }) {
+        if (sk_sp<SkData> file = GetResourceAsData(name)) {
+            test_strips(r, name, std::move(file), !strstr(name, "interlaced"));
+        }
+    }
+}
+
 // Modified version of the giflib logo, from
 // http://giflib.sourceforge.net/whatsinagif/bits_and_bytes.html
 // The global color map has been replaced with a local color map.
@@ -18,6 +18,7 @@
 #include "SkColorSpacePriv.h"
 #include "SkData.h"
 #include "SkEncodedImageFormat.h"
+#include "SkExecutor.h"
 #include "SkFrontBufferedStream.h"
 #include "SkImage.h"
 #include "SkImageGenerator.h"
@@ -1809,3 +1810,73 @@ DEF_TEST(Codec_crbug807324, r) {
         }
     }
 }
+
+// icc-v2-gbr.jpg has a restart marker every 10 MCUs, so it can be decoded in bands.
+DEF_TEST(Codec_jpegRestartBands, r) {
+    const char* file = "images/icc-v2-gbr.jpg";
+    sk_sp<SkData> data = GetResourceAsData(file);
+    if (!data) {
+        ERRORF(r, "Missing %s", file);
+        return;
+    }
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    auto decode = [&](const SkImageInfo& info, SkExecutor* exec, SkBitmap* bm) {
+        std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data);
+        bm->allocPixels(info);
+        SkCodec::Options options;
+        options.fExecutor = exec;
+        REPORTER_ASSERT(r, SkCodec::kSuccess ==
+                           codec->getPixels(info, bm->getPixels(), bm->rowBytes(), &options));
+    };
+
+    std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data);
+    if (!codec) {
+        ERRORF(r, "Could not create codec for %s", file);
+        return;
+    }
+    const SkImageInfo fullInfo = codec->getInfo();
+    const SkImageInfo infos[] = {
+        fullInfo,
+        fullInfo.makeWH(codec->getScaledDimensions(0.5f).width(),
+                        codec->getScaledDimensions(0.5f).height()),
+        fullInfo.makeColorSpace(SkColorSpace::MakeSRGB()),
+        fullInfo.makeColorType(kRGB_565_SkColorType).makeColorSpace(nullptr),
+    };
+    for (const SkImageInfo& info : infos) {
+        SkBitmap serial, banded;
+        decode(info, nullptr, &serial);
+        decode(info, executor.get(), &banded);
+        for (int y = 0; y < info.height(); y++) {
+            if (memcmp(serial.getAddr(0, y), banded.getAddr(0, y), info.minRowBytes())) {
+                ERRORF(r, "Row %d of the banded decode differs.", y);
+                break;
+            }
+        }
+    }
+
+    SkYUVASizeInfo sizeInfo;
+    if (!codec->queryYUV8(&sizeInfo, nullptr)) {
+        return;
+    }
+    SkAutoMalloc serial(sizeInfo.computeTotalBytes()),
+                 banded(sizeInfo.computeTotalBytes());
+    void* serialPlanes[SkYUVASizeInfo::kMaxCount];
+    void* bandedPlanes[SkYUVASizeInfo::kMaxCount];
+    sizeInfo.computePlanes(serial.get(), serialPlanes);
+    sizeInfo.computePlanes(banded.get(), bandedPlanes);
+    REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getYUV8Planes(sizeInfo, serialPlanes));
+    REPORTER_ASSERT(r, SkCodec::kSuccess ==
+                       codec->getYUV8Planes(sizeInfo, bandedPlanes, executor.get()));
+    for (int i = 0; i < 3; i++) {
+        for (int y = 0; y < sizeInfo.fSizes[i].height(); y++) {
+            size_t offset = y * sizeInfo.fWidthBytes[i];
+            if (memcmp(SkTAddOffset<void>(serialPlanes[i], offset),
+                       SkTAddOffset<void>(bandedPlanes[i], offset),
+                       sizeInfo.fSizes[i].width())) {
+                ERRORF(r, "Row %d of plane %d of the banded YUV decode differs.", y, i);
+                break;
+            }
+        }
+    }
+}
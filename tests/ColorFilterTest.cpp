@@ -6,12 +6,16 @@
  */
 
 #include "SkAutoMalloc.h"
+#include "SkBitmap.h"
 #include "SkBlendMode.h"
+#include "SkCanvas.h"
 #include "SkColor.h"
 #include "SkColorFilter.h"
+#include "SkColorMatrixFilter.h"
 #include "SkRandom.h"
 #include "SkReadBuffer.h"
 #include "SkRefCnt.h"
+#include "SkTableColorFilter.h"
 #include "SkWriteBuffer.h"
 #include "SkTypes.h"
 #include "Test.h"
@@ -112,3 +116,64 @@ DEF_TEST(ColorFilter, reporter) {
 
     test_composecolorfilter_limit(reporter);
 }
+
+// filterPixmap() should match drawing the pixels through a paint with the filter, including on
+// pixmaps large enough to be split into bands.
+DEF_TEST(ColorFilter_filterPixmap, reporter) {
+    const SkScalar matrix[20] = { 0.5f, 0.2f, 0,    0, 10,
+                                  0,    0.9f, 0.1f, 0, 0,
+                                  0.3f, 0,    0.6f, 0, 20,
+                                  0,    0,    0,    1, 0 };
+    uint8_t table[256];
+    for (int i = 0; i < 256; ++i) {
+        table[i] = (uint8_t)(255 - i);
+    }
+    sk_sp<SkColorFilter> filters[] = {
+        SkColorFilter::MakeMatrixFilterRowMajor255(matrix),
+        SkTableColorFilter::MakeARGB(nullptr, table, nullptr, table),
+    };
+
+    for (const SkISize& size : { SkISize::Make(17, 5), SkISize::Make(512, 384) }) {
+        SkBitmap src;
+        src.allocN32Pixels(size.width(), size.height());
+        SkRandom rand;
+        for (int y = 0; y < size.height(); ++y) {
+            for (int x = 0; x < size.width(); ++x) {
+                *src.getAddr32(x, y) = SkPreMultiplyColor(rand.nextU());
+            }
+        }
+
+        for (const sk_sp<SkColorFilter>& filter : filters) {
+            SkBitmap expected;
+            expected.allocN32Pixels(size.width(), size.height());
+            SkCanvas canvas(expected);
+            SkPaint paint;
+            paint.setBlendMode(SkBlendMode::kSrc);
+            paint.setColorFilter(filter);
+            canvas.drawBitmap(src, 0, 0, &paint);
+
+            SkBitmap actual;
+            actual.allocN32Pixels(size.width(), size.height());
+            REPORTER_ASSERT(reporter, src.readPixels(actual.pixmap()));
+            REPORTER_ASSERT(reporter, filter->filterPixmap(actual.pixmap()));
+
+            int mismatches = 0;
+            for (int y = 0; y < size.height(); ++y) {
+                for (int x = 0; x < size.width(); ++x) {
+                    SkPMColor a = *actual.getAddr32(x, y),
+                              e = *expected.getAddr32(x, y);
+                    for (int shift = 0; shift < 32; shift += 8) {
+                        if (SkTAbs((int)((a >> shift) & 0xFF) - (int)((e >> shift) & 0xFF)) > 1) {
+                            mismatches++;
+                            break;
+                        }
+                    }
+                }
+            }
+            REPORTER_ASSERT(reporter, 0 == mismatches);
+        }
+    }
+
+    SkPixmap empty;
+    REPORTER_ASSERT(reporter, !filters[0]->filterPixmap(empty));
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkTypes.h"
+
+#include "GrContextFactory.h"
+#include "SkCanvas.h"
+#include "SkExecutor.h"
+#include "SkPath.h"
+#include "SkSurface.h"
+#include "Test.h"
+
+#include <vector>
+
+using namespace sk_gpu_test;
+
+static void draw_paths(SkCanvas* canvas) {
+    canvas->clear(SK_ColorWHITE);
+
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    for (int i = 0; i < 40; ++i) {
+        SkScalar x = SkIntToScalar(20 + (i % 8) * 30),
+                 y = SkIntToScalar(20 + (i / 8) * 45);
+        paint.setColor(0xFF000000 | (i * 0x1F3A67));
+
+        // Convex: one of the AA convex renderers, filled or stroked.
+        SkPath convex;
+        convex.moveTo(x - 9, y - 2);
+        convex.quadTo(x, y - 14, x + 9, y - 2);
+        convex.lineTo(x + 5, y + 8);
+        convex.lineTo(x - 5, y + 8);
+        convex.close();
+        paint.setStyle(i % 3 ? SkPaint::kFill_Style : SkPaint::kStroke_Style);
+        paint.setStrokeWidth(2);
+        canvas->drawPath(convex, paint);
+
+        // Concave: the tessellator.
+        SkPath star;
+        for (int j = 0; j < 5; ++j) {
+            SkScalar angle = SK_ScalarPI * 4 * j / 5;
+            SkPoint pt = {x + 11 * SkScalarSin(angle), y + 22 + 11 * SkScalarCos(angle)};
+            j ? star.lineTo(pt) : star.moveTo(pt);
+        }
+        star.setFillType(SkPath::kEvenOdd_FillType);
+        paint.setStyle(SkPaint::kFill_Style);
+        canvas->drawPath(star, paint);
+    }
+}
+
+static bool render(GrContext* context, std::vector<uint32_t>* pixels) {
+    SkImageInfo info = SkImageInfo::MakeN32Premul(256, 256);
+    sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, info);
+    if (!surface) {
+        return false;
+    }
+    draw_paths(surface->getCanvas());
+    pixels->resize(info.width() * info.height());
+    return surface->readPixels(info, pixels->data(), info.minRowBytes(), 0, 0);
+}
+
+DEF_GPUTEST(GrOpFlushState_ConcurrentPrepare, reporter, options) {
+    std::unique_ptr<SkExecutor> threadPool = SkExecutor::MakeFIFOThreadPool(2);
+
+    GrContextOptions serialOptions = options;
+    serialOptions.fGpuPathRenderers = GpuPathRenderers::kAAConvex |
+                                      GpuPathRenderers::kAALinearizing |
+                                      GpuPathRenderers::kTessellating;
+    serialOptions.fExecutor = nullptr;
+    GrContextOptions concurrentOptions = serialOptions;
+    concurrentOptions.fExecutor = threadPool.get();
+    concurrentOptions.fPrepareOpsConcurrently = true;
+
+    for (int i = 0; i < GrContextFactory::kContextTypeCnt; ++i) {
+        GrContextFactory::ContextType ctxType = static_cast<GrContextFactory::ContextType>(i);
+        if (!GrContextFactory::IsRenderingContext(ctxType)) {
+            continue;
+        }
+        GrContextFactory serialFactory(serialOptions);
+        GrContextFactory concurrentFactory(concurrentOptions);
+        GrContext* serialContext = serialFactory.get(ctxType);
+        GrContext* concurrentContext = concurrentFactory.get(ctxType);
+        if (!serialContext || !concurrentContext) {
+            continue;
+        }
+
+        // The staged vertex data lands in the same buffers, in the same order, so the results
+        // should match exactly.
+        std::vector<uint32_t> serial, concurrent;
+        if (!render(serialContext, &serial) || !render(concurrentContext, &concurrent)) {
+            continue;
+        }
+        REPORTER_ASSERT(reporter, serial == concurrent, "%s",
+                        GrContextFactory::ContextTypeName(ctxType));
+    }
+}
@@ -305,6 +305,8 @@ DEF_TEST(RWBuffer_threaded, reporter) {
             REPORTER_ASSERT(reporter, stream->getLength() == reader->size());
             check_alphabet_buffer(reporter, reader.get());
             check_alphabet_stream(reporter, stream);
+            sk_sp<SkData> data = reader->asData();
+            check_abcs(reporter, (const char*)data->data(), data->size());
             REPORTER_ASSERT(reporter, stream->rewind());
             delete stream;
         });
@@ -352,3 +354,40 @@ DEF_TEST(RWBuffer_noAppend, r) {
         REPORTER_ASSERT(r, stream->skip(10) == 0);
     }
 }
+
+DEF_TEST(RWBuffer_asData, r) {
+    SkRWBuffer buffer;
+    REPORTER_ASSERT(r, buffer.makeROBufferSnapshot()->asData()->size() == 0);
+
+    // While everything is in the first block, asData() shares it.
+    buffer.append(gABC, 26);
+    sk_sp<SkROBuffer> small = buffer.makeROBufferSnapshot();
+    sk_sp<SkData> smallData = small->asData();
+    REPORTER_ASSERT(r, smallData->size() == 26);
+    REPORTER_ASSERT(r, smallData->data() == SkROBuffer::Iter(small).data());
+
+    // Past the first block, snapshots are coalesced, and each larger one reuses the bytes
+    // copied for the last, so the copies share one allocation until it has to grow.
+    const void* lastBase = nullptr;
+    int moves = 0;
+    for (int i = 1; i < 1000; ++i) {
+        buffer.append(gABC, 26);
+        sk_sp<SkROBuffer> snapshot = buffer.makeROBufferSnapshot();
+        sk_sp<SkData> data = snapshot->asData();
+        REPORTER_ASSERT(r, data->size() == (i + 1) * 26U);
+        check_abcs(r, (const char*)data->data(), data->size());
+        if (data->data() != lastBase) {
+            moves++;
+            lastBase = data->data();
+        }
+
+        std::unique_ptr<SkStreamAsset> stream = buffer.makeStreamSnapshot();
+        REPORTER_ASSERT(r, stream->getMemoryBase());
+        REPORTER_ASSERT(r, !memcmp(stream->getMemoryBase(), data->data(), data->size()));
+    }
+    REPORTER_ASSERT(r, moves < 20);
+
+    // Views of earlier snapshots are unchanged by the appends since.
+    REPORTER_ASSERT(r, smallData->size() == 26);
+    check_abcs(r, (const char*)smallData->data(), smallData->size());
+}
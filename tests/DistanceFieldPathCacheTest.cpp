@@ -0,0 +1,45 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrDistanceFieldPathCache.h"
+#include "MemoryCache.h"
+#include "SkPath.h"
+#include "SkResourceCache.h"
+#include "Test.h"
+
+DEF_TEST(DistanceFieldPathCache, reporter) {
+    SkPath path;
+    path.addCircle(10, 10, 8);
+    SkPath copy = path;
+    copy.setIsVolatile(true);  // Keys ignore everything but the path's contents.
+
+    sk_sp<SkData> key = GrDistanceFieldPathCache::MakeKey(path, 2);
+    REPORTER_ASSERT(reporter, key->equals(GrDistanceFieldPathCache::MakeKey(copy, 2).get()));
+    REPORTER_ASSERT(reporter, !key->equals(GrDistanceFieldPathCache::MakeKey(path, 4).get()));
+
+    const size_t kFieldSize = 64;
+    sk_sp<SkData> field = SkData::MakeUninitialized(kFieldSize);
+    memset(field->writable_data(), 0x5a, kFieldSize);
+
+    sk_gpu_test::MemoryCache persistentCache;
+    SkResourceCache::PurgeAll();
+    REPORTER_ASSERT(reporter, !GrDistanceFieldPathCache::Find(*key, kFieldSize, nullptr));
+    GrDistanceFieldPathCache::Add(key, field, &persistentCache);
+
+    // Found in the process-wide cache, whichever context asks.
+    sk_sp<SkData> found = GrDistanceFieldPathCache::Find(*key, kFieldSize, nullptr);
+    REPORTER_ASSERT(reporter, found && found->equals(field.get()));
+    REPORTER_ASSERT(reporter, !GrDistanceFieldPathCache::Find(*key, kFieldSize + 1, nullptr));
+
+    // Reloaded from the persistent cache once the process-wide one has forgotten it.
+    SkResourceCache::PurgeAll();
+    REPORTER_ASSERT(reporter, !GrDistanceFieldPathCache::Find(*key, kFieldSize, nullptr));
+    found = GrDistanceFieldPathCache::Find(*key, kFieldSize, &persistentCache);
+    REPORTER_ASSERT(reporter, found && found->equals(field.get()));
+    found = GrDistanceFieldPathCache::Find(*key, kFieldSize, nullptr);
+    REPORTER_ASSERT(reporter, found && found->equals(field.get()));
+}
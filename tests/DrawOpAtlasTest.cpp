@@ -271,11 +271,16 @@ DEF_GPUTEST(GrDrawOpAtlasConfig_Basic, reporter, options) {
                       { 2048, 1024 }, { 256, 256 });
     test_atlas_config(reporter, 65536, 8 * 1024 * 1024, kA8_GrMaskFormat,
                       { 2048, 2048 }, { 512, 512 });
-    // 16 MB (should be same as 8 MB)
+    // 16 MB
     test_atlas_config(reporter, 65536, 16 * 1024 * 1024, kARGB_GrMaskFormat,
-                      { 2048, 1024 }, { 256, 256 });
+                      { 2048, 2048 }, { 256, 256 });
     test_atlas_config(reporter, 65536, 16 * 1024 * 1024, kA8_GrMaskFormat,
                       { 2048, 2048 }, { 512, 512 });
+    // 32 MB (should be same as 16 MB)
+    test_atlas_config(reporter, 65536, 32 * 1024 * 1024, kARGB_GrMaskFormat,
+                      { 2048, 2048 }, { 256, 256 });
+    test_atlas_config(reporter, 65536, 32 * 1024 * 1024, kA8_GrMaskFormat,
+                      { 2048, 2048 }, { 512, 512 });
 
     // 4MB, restricted texture size
     test_atlas_config(reporter, 1024, 8 * 1024 * 1024, kARGB_GrMaskFormat,
@@ -8,9 +8,13 @@
 #include "Resources.h"
 #include "Test.h"
 
+#include "SkAutoMalloc.h"
 #include "SkBitmap.h"
+#include "SkCodec.h"
+#include "SkColorData.h"
 #include "SkColorPriv.h"
 #include "SkEncodedImageFormat.h"
+#include "SkExecutor.h"
 #include "SkImage.h"
 #include "SkJpegEncoder.h"
 #include "SkPngEncoder.h"
@@ -177,6 +181,112 @@ DEF_TEST(Encode_JpegDownsample, r) {
     REPORTER_ASSERT(r, almost_equals(bm1, bm2, 60));
 }
 
+// Decodes the Y, U and V planes of a jpeg.
+static bool decode_yuv(sk_sp<SkData> data, SkAutoMalloc* storage, SkPixmap planes[3]) {
+    std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(std::move(data));
+    SkYUVASizeInfo sizeInfo;
+    SkYUVColorSpace colorSpace;
+    if (!codec || !codec->queryYUV8(&sizeInfo, &colorSpace)) {
+        return false;
+    }
+    storage->reset(sizeInfo.computeTotalBytes());
+    void* pixels[SkYUVASizeInfo::kMaxCount];
+    sizeInfo.computePlanes(storage->get(), pixels);
+    if (SkCodec::kSuccess != codec->getYUV8Planes(sizeInfo, pixels)) {
+        return false;
+    }
+    for (int i = 0; i < 3; ++i) {
+        planes[i].reset(SkImageInfo::MakeA8(sizeInfo.fSizes[i].width(),
+                                            sizeInfo.fSizes[i].height()),
+                        pixels[i], sizeInfo.fWidthBytes[i]);
+    }
+    return true;
+}
+
+DEF_TEST(Encode_JpegYUV, r) {
+    const struct {
+        const char*                 fPath;
+        SkJpegEncoder::Downsample   fDownsample;
+    } kRecs[] = {
+        { "images/mandrill_512_q075.jpg", SkJpegEncoder::Downsample::k420 },
+        { "images/mandrill_h2v1.jpg",     SkJpegEncoder::Downsample::k422 },
+        { "images/mandrill_h1v1.jpg",     SkJpegEncoder::Downsample::k444 },
+    };
+    for (const auto& rec : kRecs) {
+        sk_sp<SkData> data = GetResourceAsData(rec.fPath);
+        if (!data) {
+            continue;
+        }
+        SkAutoMalloc srcStorage;
+        SkPixmap srcPlanes[3];
+        REPORTER_ASSERT(r, decode_yuv(data, &srcStorage, srcPlanes));
+
+        SkJpegEncoder::Options options;
+        options.fDownsample = rec.fDownsample;
+        SkDynamicMemoryWStream dst;
+        REPORTER_ASSERT(r, SkJpegEncoder::EncodeYUV(&dst, srcPlanes, kJPEG_SkYUVColorSpace,
+                                                    options));
+        REPORTER_ASSERT(r, !SkJpegEncoder::EncodeYUV(&dst, srcPlanes, kRec601_SkYUVColorSpace,
+                                                     options));
+
+        // At full quality the planes should come back as they went in, give or take the DCT.
+        SkAutoMalloc dstStorage;
+        SkPixmap dstPlanes[3];
+        REPORTER_ASSERT(r, decode_yuv(dst.detachAsData(), &dstStorage, dstPlanes));
+        for (int i = 0; i < 3; ++i) {
+            REPORTER_ASSERT(r, srcPlanes[i].info() == dstPlanes[i].info());
+            if (srcPlanes[i].info() != dstPlanes[i].info()) {
+                continue;
+            }
+            int maxDiff = 0;
+            for (int y = 0; y < srcPlanes[i].height(); ++y) {
+                for (int x = 0; x < srcPlanes[i].width(); ++x) {
+                    maxDiff = SkTMax(maxDiff, SkTAbs(*srcPlanes[i].addr8(x, y) -
+                                                     *dstPlanes[i].addr8(x, y)));
+                }
+            }
+            REPORTER_ASSERT(r, maxDiff <= 2, "%s plane %d differs by %d", rec.fPath, i, maxDiff);
+        }
+
+        // The chroma planes must match the downsampling asked for.
+        options.fDownsample = SkJpegEncoder::Downsample::k444 == rec.fDownsample
+                                      ? SkJpegEncoder::Downsample::k420
+                                      : SkJpegEncoder::Downsample::k444;
+        REPORTER_ASSERT(r, !SkJpegEncoder::EncodeYUV(&dst, srcPlanes, kJPEG_SkYUVColorSpace,
+                                                     options));
+    }
+}
+
+// Converting rows across an executor should not change what's encoded.
+DEF_TEST(Encode_JpegExecutor, r) {
+    SkBitmap bitmap;
+    if (!GetResourceAsBitmap("images/mandrill_512.png", &bitmap)) {
+        return;
+    }
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    const SkImageInfo infos[] = {
+        bitmap.info().makeColorType(kRGBA_F16_SkColorType),
+        bitmap.info().makeColorType(kRGB_565_SkColorType).makeAlphaType(kOpaque_SkAlphaType),
+        bitmap.info().makeColorType(kN32_SkColorType).makeAlphaType(kUnpremul_SkAlphaType),
+    };
+    for (const SkImageInfo& info : infos) {
+        SkBitmap converted;
+        converted.allocPixels(info);
+        REPORTER_ASSERT(r, bitmap.readPixels(converted.pixmap()));
+
+        SkJpegEncoder::Options options;
+        options.fAlphaOption = SkJpegEncoder::AlphaOption::kBlendOnBlack;
+        SkDynamicMemoryWStream serial, threaded;
+        REPORTER_ASSERT(r, SkJpegEncoder::Encode(&serial, converted.pixmap(), options));
+        options.fExecutor = executor.get();
+        REPORTER_ASSERT(r, SkJpegEncoder::Encode(&threaded, converted.pixmap(), options));
+
+        sk_sp<SkData> serialData = serial.detachAsData();
+        REPORTER_ASSERT(r, serialData->equals(threaded.detachAsData().get()));
+    }
+}
+
 static inline void pushComment(
         std::vector<std::string>& comments, const char* keyword, const char* text) {
     comments.push_back(keyword);
@@ -291,6 +401,83 @@ DEF_TEST(Encode_PngOptions, r) {
     REPORTER_ASSERT(r, almost_equals(bm0, bm2, 0));
 }
 
+static int count_chunks(const SkData& png, const char* type) {
+    int count = 0;
+    const uint8_t* bytes = png.bytes();
+    for (size_t i = 4; i + 4 <= png.size(); ++i) {
+        if (0 == memcmp(bytes + i, type, 4)) {
+            count++;
+        }
+    }
+    return count;
+}
+
+DEF_TEST(Encode_PngParallel, r) {
+    SkBitmap bitmap;
+    if (!GetResourceAsBitmap("images/mandrill_512.png", &bitmap)) {
+        return;
+    }
+    SkPixmap src;
+    REPORTER_ASSERT(r, bitmap.peekPixels(&src));
+
+    // Also try an image with alpha.
+    SkBitmap unpremul;
+    unpremul.allocPixels(bitmap.info().makeColorType(kRGBA_8888_SkColorType)
+                                     .makeAlphaType(kUnpremul_SkAlphaType));
+    for (int y = 0; y < unpremul.height(); ++y) {
+        for (int x = 0; x < unpremul.width(); ++x) {
+            SkColor c = bitmap.getColor(x, y);
+            *unpremul.getAddr32(x, y) = SkPackARGB_as_RGBA((x ^ y) & 0xFF, SkColorGetR(c),
+                                                           SkColorGetG(c), SkColorGetB(c));
+        }
+    }
+    SkPixmap unpremulSrc;
+    REPORTER_ASSERT(r, unpremul.peekPixels(&unpremulSrc));
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    const SkPngEncoder::FilterFlag filters[] = {
+        SkPngEncoder::FilterFlag::kAll,
+        SkPngEncoder::FilterFlag::kNone,
+        SkPngEncoder::FilterFlag::kPaeth,
+        SkPngEncoder::FilterFlag::kSub | SkPngEncoder::FilterFlag::kUp,
+    };
+    const SkPngEncoder::ZLibStrategy strategies[] = {
+        SkPngEncoder::ZLibStrategy::kDefault,
+        SkPngEncoder::ZLibStrategy::kFiltered,
+        SkPngEncoder::ZLibStrategy::kHuffmanOnly,
+        SkPngEncoder::ZLibStrategy::kRLE,
+    };
+    for (const SkPixmap& pixmap : { src, unpremulSrc }) {
+        for (SkPngEncoder::FilterFlag filter : filters) {
+            for (SkPngEncoder::ZLibStrategy strategy : strategies) {
+                SkPngEncoder::Options options;
+                options.fFilterFlags = filter;
+                options.fZLibStrategy = strategy;
+                SkDynamicMemoryWStream serialStream, parallelStream;
+                REPORTER_ASSERT(r, SkPngEncoder::Encode(&serialStream, pixmap, options));
+                options.fExecutor = executor.get();
+                REPORTER_ASSERT(r, SkPngEncoder::Encode(&parallelStream, pixmap, options));
+
+                sk_sp<SkData> serial = serialStream.detachAsData();
+                sk_sp<SkData> parallel = parallelStream.detachAsData();
+                REPORTER_ASSERT(r, count_chunks(*parallel, "IDAT") > 1);
+                REPORTER_ASSERT(r, count_chunks(*parallel, "IEND") == 1);
+
+                SkBitmap serialBitmap, parallelBitmap;
+                sk_sp<SkImage> serialImage = SkImage::MakeFromEncoded(serial);
+                sk_sp<SkImage> parallelImage = SkImage::MakeFromEncoded(parallel);
+                REPORTER_ASSERT(r, serialImage && parallelImage);
+                if (!serialImage || !parallelImage) {
+                    continue;
+                }
+                serialImage->asLegacyBitmap(&serialBitmap);
+                parallelImage->asLegacyBitmap(&parallelBitmap);
+                REPORTER_ASSERT(r, almost_equals(serialBitmap, parallelBitmap, 0));
+            }
+        }
+    }
+}
+
 #ifndef SK_BUILD_FOR_GOOGLE3
 DEF_TEST(Encode_WebpQuality, r) {
     SkBitmap bm;
@@ -391,3 +578,59 @@ DEF_TEST(Encode_WebpOptions, r) {
     REPORTER_ASSERT(r, almost_equals(bm0, bm2, 90));
     REPORTER_ASSERT(r, almost_equals(bm2, bm3, 50));
 }
+
+DEF_TEST(Encode_WebpAnimated, r) {
+    SkBitmap bitmap;
+    if (!GetResourceAsBitmap("images/mandrill_128.png", &bitmap)) {
+        return;
+    }
+
+    // The second frame changes a rectangle, the third is the same as the second, and the last
+    // changes a single pixel.
+    SkBitmap bitmaps[4];
+    for (SkBitmap& frame : bitmaps) {
+        frame.allocPixels(bitmap.info());
+        REPORTER_ASSERT(r, bitmap.readPixels(frame.pixmap()));
+    }
+    for (int i = 1; i < 4; ++i) {
+        bitmaps[i].erase(SK_ColorRED, SkIRect::MakeLTRB(33, 21, 50, 40));
+    }
+    bitmaps[3].erase(SK_ColorBLUE, SkIRect::MakeXYWH(127, 127, 1, 1));
+
+    SkWebpEncoder::Frame frames[4];
+    for (int i = 0; i < 4; ++i) {
+        frames[i].fPixmap = bitmaps[i].pixmap();
+        frames[i].fDuration = 100;
+    }
+
+    SkWebpEncoder::Options options;
+    options.fCompression = SkWebpEncoder::Compression::kLossless;
+    SkDynamicMemoryWStream dst;
+    REPORTER_ASSERT(r, SkWebpEncoder::EncodeAnimated(&dst, frames, 4, options));
+    REPORTER_ASSERT(r, !SkWebpEncoder::EncodeAnimated(&dst, frames, 0, options));
+
+    std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(dst.detachAsData());
+    REPORTER_ASSERT(r, codec);
+    if (!codec) {
+        return;
+    }
+    std::vector<SkCodec::FrameInfo> frameInfos = codec->getFrameInfo();
+    REPORTER_ASSERT(r, 3u == frameInfos.size());
+    if (3u != frameInfos.size()) {
+        return;
+    }
+    REPORTER_ASSERT(r, 100 == frameInfos[0].fDuration);
+    REPORTER_ASSERT(r, 200 == frameInfos[1].fDuration);
+    REPORTER_ASSERT(r, 100 == frameInfos[2].fDuration);
+
+    const int sourceFrames[] = { 0, 1, 3 };
+    for (int i = 0; i < 3; ++i) {
+        SkBitmap decoded;
+        decoded.allocPixels(bitmap.info());
+        SkCodec::Options decodeOptions;
+        decodeOptions.fFrameIndex = i;
+        REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getPixels(decoded.pixmap(),
+                                                                 &decodeOptions));
+        REPORTER_ASSERT(r, almost_equals(decoded, bitmaps[sourceFrames[i]], 0));
+    }
+}
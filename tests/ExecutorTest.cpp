@@ -0,0 +1,89 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkExecutor.h"
+#include "SkString.h"
+#include "SkTaskGroup.h"
+#include "Test.h"
+
+#include <atomic>
+
+static void fan_out(SkExecutor* pool, int depth, std::atomic<int>* count) {
+    count->fetch_add(1);
+    if (depth > 0) {
+        SkTaskGroup group(*pool);
+        for (int i = 0; i < 3; i++) {
+            group.add([=] { fan_out(pool, depth - 1, count); });
+        }
+        group.wait();
+    }
+}
+
+DEF_TEST(SkExecutor_WorkStealing, r) {
+    for (int threads : { 1, 2, 5 }) {
+        std::atomic<int> flat(0), nested(0), background(0);
+        {
+            std::unique_ptr<SkExecutor> pool = SkExecutor::MakeWorkStealingThreadPool(threads);
+
+            SkTaskGroup(*pool).batch(1000, [&](int) { flat.fetch_add(1); });
+            REPORTER_ASSERT(r, 1000 == flat.load());
+
+            // Tasks waiting on the tasks they add must not deadlock, even with one thread.
+            fan_out(pool.get(), 5, &nested);
+            REPORTER_ASSERT(r, 364 == nested.load());  // 3^0 + 3^1 + ... + 3^5
+
+            // Destroying the pool runs the background work still waiting.
+            for (int i = 0; i < 100; i++) {
+                pool->addBackground([&] { background.fetch_add(1); });
+            }
+        }
+        REPORTER_ASSERT(r, 100 == background.load());
+    }
+}
+
+DEF_TEST(SkTaskGroup_parallelFor, r) {
+    std::unique_ptr<SkExecutor> pool = SkExecutor::MakeWorkStealingThreadPool(3);
+    for (int N : { 0, 1, 7, 1000 }) {
+        for (int grain : { 0, 1, 3, 2000 }) {
+            std::unique_ptr<std::atomic<int>[]> visits(new std::atomic<int>[N + 1]);
+            for (int i = 0; i <= N; i++) {
+                visits[i] = 0;
+            }
+            SkTaskGroup(*pool).parallelFor(N, grain, [&](int start, int end) {
+                REPORTER_ASSERT(r, 0 <= start && start < end && end <= N);
+                // Nested loops help run their own chunks rather than wait on the busy pool.
+                SkTaskGroup(*pool).parallelFor(end - start, 0, [&](int s, int e) {
+                    for (int i = start + s; i < start + e; i++) {
+                        visits[i].fetch_add(1);
+                    }
+                });
+            });
+            for (int i = 0; i < N; i++) {
+                REPORTER_ASSERT(r, 1 == visits[i].load());
+            }
+
+            // A non-commutative reduction still sees the chunks in order.
+            SkString digits = SkTaskGroup(*pool).parallelReduce(N, grain, SkString(),
+                    [](int start, int end) {
+                        SkString str;
+                        for (int i = start; i < end; i++) {
+                            str.appendf("%d,", i);
+                        }
+                        return str;
+                    },
+                    [](SkString a, const SkString& b) {
+                        a.append(b);
+                        return a;
+                    });
+            SkString expected;
+            for (int i = 0; i < N; i++) {
+                expected.appendf("%d,", i);
+            }
+            REPORTER_ASSERT(r, digits == expected);
+        }
+    }
+}
@@ -6,16 +6,27 @@
  */
 
 #include "Resources.h"
+#include "SkArenaAlloc.h"
 #include "SkAutoMalloc.h"
+#include "SkCanvas.h"
+#include "SkDescriptor.h"
 #include "SkEndian.h"
+#include "SkExecutor.h"
 #include "SkFont.h"
 #include "SkFontStream.h"
+#include "SkGraphics.h"
 #include "SkOSFile.h"
 #include "SkPaint.h"
+#include "SkScalerContext.h"
 #include "SkStream.h"
+#include "SkSurface.h"
+#include "SkTDArray.h"
+#include "SkTaskGroup.h"
 #include "SkTypeface.h"
 #include "Test.h"
 
+#include <atomic>
+
 //#define DUMP_TABLES
 //#define DUMP_TTC_TABLES
 
@@ -313,4 +324,102 @@ DEF_TEST(FontHost, reporter) {
     test_symbolfont(reporter);
 }
 
+// Glyphs generated on many threads at once, at many sizes of the same typeface, should look just
+// like the ones generated one at a time.
+DEF_TEST(FontHost_threadedGlyphs, reporter) {
+    sk_sp<SkTypeface> typeface = SkTypeface::MakeDefault();
+    static const char kText[] = "Sphinx of black quartz, judge my vow.";
+    static const int kSizes = 12;
+
+    auto draw = [&](int i) {
+        SkFont font(typeface, 10 + 3 * i);
+        font.setEdging(SkFont::Edging::kAntiAlias);
+        auto surface = SkSurface::MakeRasterN32Premul(400, 60);
+        surface->getCanvas()->clear(SK_ColorWHITE);
+        surface->getCanvas()->drawSimpleText(kText, strlen(kText), kUTF8_SkTextEncoding,
+                                             5, 50, font, SkPaint());
+        return surface->makeImageSnapshot();
+    };
+
+    sk_sp<SkImage> expected[kSizes];
+    for (int i = 0; i < kSizes; ++i) {
+        expected[i] = draw(i);
+    }
+
+    // Make every thread regenerate its glyphs.
+    SkGraphics::PurgeFontCache();
+
+    std::atomic<int> mismatches{0};
+    SkTaskGroup().batch(kSizes, [&](int i) {
+        SkPixmap actual, want;
+        sk_sp<SkImage> image = draw(i);
+        if (!image->peekPixels(&actual) || !expected[i]->peekPixels(&want) ||
+            0 != memcmp(actual.addr(), want.addr(), actual.computeByteSize())) {
+            mismatches++;
+        }
+    });
+    REPORTER_ASSERT(reporter, mismatches == 0);
+}
+
+// Glyph images generated as a batch, whether by the backend or by scan converting paths across an
+// executor, should match those generated one at a time.
+DEF_TEST(FontHost_batchedGlyphImages, reporter) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    SkFont font(SkTypeface::MakeDefault(), 24);
+    font.setEdging(SkFont::Edging::kAntiAlias);
+    static const char kText[] = "Sphinx of black quartz, judge my vow.";
+    SkGlyphID glyphIDs[SK_ARRAY_COUNT(kText)];
+    const int count = font.textToGlyphs(kText, strlen(kText), kUTF8_SkTextEncoding,
+                                        glyphIDs, SK_ARRAY_COUNT(glyphIDs));
+
+    for (bool framed : {false, true}) {
+        SkPaint paint;
+        if (framed) {
+            // Frames are drawn from the glyphs' paths.
+            paint.setStyle(SkPaint::kStroke_Style);
+            paint.setStrokeWidth(1);
+        }
+        SkAutoDescriptor ad;
+        SkScalerContextEffects effects;
+        SkScalerContext::CreateDescriptorAndEffectsUsingPaint(
+                font, paint, SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+                SkScalerContextFlags::kNone, SkMatrix::I(), &ad, &effects);
+
+        SkArenaAlloc alloc(4096);
+        auto make_glyphs = [&](SkScalerContext* context) {
+            SkTDArray<const SkGlyph*> glyphs;
+            for (int i = 0; i < count; ++i) {
+                SkGlyph* glyph = alloc.make<SkGlyph>(SkPackedGlyphID(glyphIDs[i]));
+                context->getMetrics(glyph);
+                if (!glyph->isEmpty()) {
+                    glyph->allocImage(&alloc);
+                    glyphs.push_back(glyph);
+                }
+            }
+            return glyphs;
+        };
+
+        auto single = font.getTypefaceOrDefault()->createScalerContext(effects, ad.getDesc());
+        SkTDArray<const SkGlyph*> expected = make_glyphs(single.get());
+        for (const SkGlyph* glyph : expected) {
+            single->getImage(*glyph);
+        }
+
+        for (SkExecutor* batchExecutor : {(SkExecutor*)nullptr, executor.get()}) {
+            auto batched = font.getTypefaceOrDefault()->createScalerContext(effects, ad.getDesc());
+            SkTDArray<const SkGlyph*> actual = make_glyphs(batched.get());
+            batched->getImages(SkSpan<const SkGlyph* const>{actual.begin(), actual.size()},
+                               batchExecutor);
+
+            REPORTER_ASSERT(reporter, actual.count() == expected.count());
+            for (int i = 0; i < SkTMin(actual.count(), expected.count()); ++i) {
+                const size_t size = expected[i]->computeImageSize();
+                REPORTER_ASSERT(reporter, actual[i]->computeImageSize() == size);
+                REPORTER_ASSERT(reporter,
+                                0 == memcmp(actual[i]->fImage, expected[i]->fImage, size));
+            }
+        }
+    }
+}
+
 // need tests for SkStrSearch
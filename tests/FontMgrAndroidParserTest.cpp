@@ -15,6 +15,8 @@
 #include "SkFontMgr_android.h"
 #include "SkFontMgr_android_parser.h"
 #include "SkOSFile.h"
+#include "SkOSPath.h"
+#include "SkStream.h"
 #include "SkTypeface.h"
 
 #include <cmath>
@@ -375,3 +377,73 @@ DEF_TEST(FontMgrAndroidSystemFallbackFor, reporter) {
 
     REPORTER_ASSERT(reporter, typeface->fontStyle() == SkFontStyle::Bold());
 }
+
+DEF_TEST(FontMgrAndroidFontIndex, reporter) {
+    constexpr char fontsXmlFilename[] = "fonts/fonts.xml";
+    SkString basePath = GetResourcePath("fonts/");
+    SkString fontsXml = GetResourcePath(fontsXmlFilename);
+
+    if (!sk_exists(fontsXml.c_str())) {
+        ERRORF(reporter, "file missing: %s\n", fontsXmlFilename);
+        return;
+    }
+    SkString tmpDir = skiatest::GetTmpDir();
+    if (tmpDir.isEmpty()) {
+        return;
+    }
+    SkString indexPath = SkOSPath::Join(tmpDir.c_str(), "android_font_index");
+    remove(indexPath.c_str());
+
+    SkFontMgr_Android_CustomFonts custom;
+    custom.fSystemFontUse = SkFontMgr_Android_CustomFonts::kOnlyCustom;
+    custom.fBasePath = basePath.c_str();
+    custom.fFontsXml = fontsXml.c_str();
+    custom.fFallbackFontsXml = nullptr;
+    custom.fIsolated = false;
+    sk_sp<SkFontMgr> expected(SkFontMgr_New_Android(&custom));
+
+    auto check = [&](const sk_sp<SkFontMgr>& actual) {
+        REPORTER_ASSERT(reporter, actual->countFamilies() == expected->countFamilies());
+        for (int i = 0; i < SkTMin(actual->countFamilies(), expected->countFamilies()); ++i) {
+            sk_sp<SkFontStyleSet> actualSet(actual->createStyleSet(i));
+            sk_sp<SkFontStyleSet> expectedSet(expected->createStyleSet(i));
+            REPORTER_ASSERT(reporter, actualSet->count() == expectedSet->count());
+            for (int j = 0; j < SkTMin(actualSet->count(), expectedSet->count()); ++j) {
+                SkFontStyle actualStyle, expectedStyle;
+                actualSet->getStyle(j, &actualStyle, nullptr);
+                expectedSet->getStyle(j, &expectedStyle, nullptr);
+                REPORTER_ASSERT(reporter, actualStyle == expectedStyle);
+            }
+        }
+        const SkUnichar kCharacters[] = { '!', 'A', 's', 0x2603, 0x1F577 };
+        for (SkUnichar c : kCharacters) {
+            sk_sp<SkTypeface> actualFace(actual->matchFamilyStyleCharacter(
+                    "sans-serif", SkFontStyle(), nullptr, 0, c));
+            sk_sp<SkTypeface> expectedFace(expected->matchFamilyStyleCharacter(
+                    "sans-serif", SkFontStyle(), nullptr, 0, c));
+            REPORTER_ASSERT(reporter, !actualFace == !expectedFace, "U+%04X", c);
+            if (actualFace && expectedFace) {
+                SkString actualName, expectedName;
+                actualFace->getFamilyName(&actualName);
+                expectedFace->getFamilyName(&expectedName);
+                REPORTER_ASSERT(reporter, actualName == expectedName, "U+%04X", c);
+                REPORTER_ASSERT(reporter, actualFace->fontStyle() == expectedFace->fontStyle());
+            }
+        }
+    };
+
+    // The first font manager scans the fonts and writes the index; the second reads it.
+    custom.fFontIndex = indexPath.c_str();
+    check(SkFontMgr_New_Android(&custom));
+    REPORTER_ASSERT(reporter, sk_exists(indexPath.c_str()));
+    check(SkFontMgr_New_Android(&custom));
+
+    // A damaged index is ignored and rebuilt.
+    {
+        SkFILEWStream stream(indexPath.c_str());
+        stream.writeText("not a font index");
+    }
+    check(SkFontMgr_New_Android(&custom));
+    check(SkFontMgr_New_Android(&custom));
+    remove(indexPath.c_str());
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkFont.h"
+#include "SkGlyphOutlineCache.h"
+#include "SkPath.h"
+#include "SkTypeface.h"
+#include "Test.h"
+
+DEF_TEST(GlyphOutlineCache, reporter) {
+    sk_sp<SkTypeface> typeface = SkTypeface::MakeDefault();
+    SkFont font(typeface, 64);
+    font.setHinting(kNo_SkFontHinting);
+
+    SkGlyphOutlineCache cache(4);
+    SkGlyphOutlineCache::Outline outline;
+    if (!cache.findOutline(*typeface, font.unicharToGlyph('A'), &outline)) {
+        // Without units per em there's nothing to cache.
+        REPORTER_ASSERT(reporter, cache.getCountUsed() == 0);
+        return;
+    }
+    REPORTER_ASSERT(reporter, outline.fUnitsPerEm == typeface->getUnitsPerEm());
+    REPORTER_ASSERT(reporter, cache.getCountUsed() == 1);
+
+    SkGlyphOutlineCache::Outline again;
+    REPORTER_ASSERT(reporter, cache.findOutline(*typeface, font.unicharToGlyph('A'), &again));
+    REPORTER_ASSERT(reporter, again.fHasPath == outline.fHasPath);
+    REPORTER_ASSERT(reporter, again.fPath == outline.fPath);
+    REPORTER_ASSERT(reporter, cache.getCountUsed() == 1);
+
+    // An unhinted glyph at any size is its outline scaled down from units per em.
+    SkPath path;
+    if (outline.fHasPath && font.getPath(font.unicharToGlyph('A'), &path)) {
+        SkRect expected = outline.fPath.getBounds();
+        const SkScalar scale = font.getSize() / outline.fUnitsPerEm;
+        expected.setLTRB(expected.fLeft * scale, expected.fTop * scale,
+                         expected.fRight * scale, expected.fBottom * scale);
+        const SkRect& bounds = path.getBounds();
+        const SkScalar kTolerance = 0.125f;
+        REPORTER_ASSERT(reporter, SkScalarNearlyEqual(bounds.fLeft, expected.fLeft, kTolerance));
+        REPORTER_ASSERT(reporter, SkScalarNearlyEqual(bounds.fTop, expected.fTop, kTolerance));
+        REPORTER_ASSERT(reporter, SkScalarNearlyEqual(bounds.fRight, expected.fRight, kTolerance));
+        REPORTER_ASSERT(reporter,
+                        SkScalarNearlyEqual(bounds.fBottom, expected.fBottom, kTolerance));
+    }
+
+    // Past its limit the cache drops the least recently used outlines.
+    for (SkUnichar c : {'B', 'C', 'D', 'E', 'F'}) {
+        REPORTER_ASSERT(reporter, cache.findOutline(*typeface, font.unicharToGlyph(c), &outline));
+    }
+    REPORTER_ASSERT(reporter, cache.getCountUsed() == 4);
+
+    cache.purgeAll();
+    REPORTER_ASSERT(reporter, cache.getCountUsed() == 0);
+}
@@ -7,8 +7,11 @@
 
 #include "SkGlyphRun.h"
 
+#include "SkCanvas.h"
+#include "SkSurface.h"
 #include "SkTextBlob.h"
 #include "Test.h"
+#include "sk_tool_utils.h"
 
 #include <algorithm>
 #include <memory>
@@ -92,3 +95,34 @@ DEF_TEST(GlyphRunBlob, reporter) {
     }
 }
 #endif
+
+// Redrawing a blob reuses its glyph runs; check that still draws what a fresh canvas does, whatever
+// the origin, and after other text has been drawn in between.
+DEF_TEST(GlyphRunBlobRedraw, reporter) {
+    SkFont font(sk_tool_utils::create_portable_typeface(), 16);
+    auto blob0 = SkTextBlob::MakeFromString("Redrawn blob", font);
+    auto blob1 = SkTextBlob::MakeFromString("Another blob", font);
+
+    auto info = SkImageInfo::MakeN32Premul(128, 64);
+    auto draw = [&](SkCanvas* canvas, const SkTextBlob* blob, SkScalar x, SkScalar y) {
+        canvas->clear(SK_ColorWHITE);
+        canvas->drawTextBlob(blob, x, y, SkPaint());
+    };
+
+    auto surface = SkSurface::MakeRaster(info);
+    SkCanvas* canvas = surface->getCanvas();
+    draw(canvas, blob0.get(), 10, 20);
+    draw(canvas, blob0.get(), 20, 40);
+    auto redrawn = surface->makeImageSnapshot();
+    draw(canvas, blob1.get(), 10, 20);
+    canvas->drawString("plain text", 0, 60, font, SkPaint());
+    draw(canvas, blob0.get(), 20, 40);
+    auto redrawnAgain = surface->makeImageSnapshot();
+
+    auto expectedSurface = SkSurface::MakeRaster(info);
+    draw(expectedSurface->getCanvas(), blob0.get(), 20, 40);
+    auto expected = expectedSurface->makeImageSnapshot();
+
+    REPORTER_ASSERT(reporter, sk_tool_utils::equal_pixels(expected.get(), redrawn.get()));
+    REPORTER_ASSERT(reporter, sk_tool_utils::equal_pixels(expected.get(), redrawnAgain.get()));
+}
@@ -16,7 +16,9 @@
 #include "GrContextFactory.h"
 #include "GrContextPriv.h"
 #include "GrGpu.h"
+#include "SkAndroidCodec.h"
 #include "SkImage.h"
+#include "SkImageEncoder.h"
 #include "SkSurface.h"
 #include "Test.h"
 
@@ -275,4 +277,73 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(GrAHardwareBuffer_ImportAsSurface,
     surface_draw_test_helper(reporter, context_info, kBottomLeft_GrSurfaceOrigin);
 }
 
+// Test to make sure SkAndroidCodec can decode straight into an AHardwareBuffer that we then draw
+// as an SkImage.
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(GrAHardwareBuffer_DecodeIntoBuffer,
+                                   reporter, context_info) {
+    GrContext* context = context_info.grContext();
+    if (!context->priv().caps()->supportsAHardwareBufferImages()) {
+        return;
+    }
+
+    const SkBitmap srcBitmap = make_src_bitmap();
+    std::unique_ptr<SkAndroidCodec> codec = SkAndroidCodec::MakeFromData(
+            SkEncodeBitmap(srcBitmap, SkEncodedImageFormat::kPNG, 100));
+    if (!codec) {
+        ERRORF(reporter, "Failed to make SkAndroidCodec.");
+        return;
+    }
+
+    AHardwareBuffer* buffer = nullptr;
+
+    AHardwareBuffer_Desc hwbDesc;
+    hwbDesc.width = DEV_W;
+    hwbDesc.height = DEV_H;
+    hwbDesc.layers = 1;
+    hwbDesc.usage = AHARDWAREBUFFER_USAGE_CPU_READ_NEVER |
+                    AHARDWAREBUFFER_USAGE_CPU_WRITE_OFTEN |
+                    AHARDWAREBUFFER_USAGE_GPU_SAMPLED_IMAGE;
+    hwbDesc.format = AHARDWAREBUFFER_FORMAT_R8G8B8A8_UNORM;
+    // The following three are not used in the allocate
+    hwbDesc.stride = 0;
+    hwbDesc.rfu0= 0;
+    hwbDesc.rfu1= 0;
+
+    if (int error = AHardwareBuffer_allocate(&hwbDesc, &buffer)) {
+        ERRORF(reporter, "Failed to allocated hardware buffer, error: %d", error);
+        cleanup_resources(buffer);
+        return;
+    }
+
+    SkImageInfo decodeInfo = codec->getInfo().makeColorType(kRGBA_8888_SkColorType);
+    SkCodec::Result result = codec->getAndroidPixels(decodeInfo, buffer, nullptr);
+    REPORTER_ASSERT(reporter, SkCodec::kSuccess == result);
+
+    // A size mismatch must be rejected without touching the buffer.
+    result = codec->getAndroidPixels(decodeInfo.makeWH(DEV_W / 2, DEV_H / 2), buffer, nullptr);
+    REPORTER_ASSERT(reporter, SkCodec::kInvalidParameters == result);
+
+    sk_sp<SkImage> image = SkImage::MakeFromAHardwareBuffer(buffer, kPremul_SkAlphaType,
+                                                            nullptr, kTopLeft_GrSurfaceOrigin);
+    REPORTER_ASSERT(reporter, image);
+
+    SkImageInfo imageInfo = SkImageInfo::Make(DEV_W, DEV_H, kRGBA_8888_SkColorType,
+                                              kPremul_SkAlphaType);
+    sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo,
+                                                           imageInfo);
+    REPORTER_ASSERT(reporter, surface);
+
+    surface->getCanvas()->drawImage(image, 0, 0);
+
+    SkBitmap readbackBitmap;
+    readbackBitmap.allocN32Pixels(DEV_W, DEV_H);
+
+    REPORTER_ASSERT(reporter, surface->readPixels(readbackBitmap, 0, 0));
+    REPORTER_ASSERT(reporter, check_read(reporter, srcBitmap, readbackBitmap));
+
+    image.reset();
+
+    cleanup_resources(buffer);
+}
+
 #endif
@@ -836,6 +836,50 @@ class CCPR_cache_partialInvalidate : public CCPRCacheTest {
 };
 DEF_CCPR_TEST(CCPR_cache_partialInvalidate)
 
+// Ensures ccpr moves the surviving paths out of a literal coverage atlas once enough of it has been
+// invalidated, so the fragmented texture can be purged.
+class CCPR_cache_compaction : public CCPRCacheTest {
+    static constexpr int kPathSize = 20;
+
+    void onRun(skiatest::Reporter* reporter, CCPRPathDrawer& ccpr,
+               const RecordLastMockAtlasIDs& atlasIDRecorder) override {
+        SkMatrix matrices[3] = {
+            SkMatrix::MakeTrans(5, 5),
+            SkMatrix::MakeTrans(kCanvasSize/2 - kPathSize/2, kCanvasSize/2 - kPathSize/2),
+            SkMatrix::MakeTrans(kCanvasSize - kPathSize - 5, kCanvasSize - kPathSize - 5)
+        };
+        for (SkMatrix& matrix : matrices) {
+            matrix.preScale(kPathSize, kPathSize);
+        }
+
+        const GrCCPathCache::Stats& stats = ccpr.ccpr()->testingOnly_getPathCache()->stats();
+
+        // Hit 3: the masks get copied into an A8 atlas.
+        for (int i = 0; i < 3; ++i) {
+            this->drawPathsAndFlush(ccpr, matrices, 3);
+        }
+        REPORTER_ASSERT(reporter, 0 != atlasIDRecorder.lastCopyAtlasID());
+        REPORTER_ASSERT(reporter, 0 == stats.fWastedAtlasPixels);
+
+        // Invalidate a third of the masks. The atlas was fine when this flush started, so nothing
+        // gets compacted yet.
+        matrices[0].preTranslate(1.6f, 1.4f);
+        this->drawPathsAndFlush(ccpr, matrices, 3);
+        REPORTER_ASSERT(reporter, 0 == atlasIDRecorder.lastCopyAtlasID());
+        REPORTER_ASSERT(reporter, 0 == stats.fNumCompactedPaths);
+        int64_t wastedPixels = stats.fWastedAtlasPixels;
+        REPORTER_ASSERT(reporter, wastedPixels > 0);
+
+        // Now the remaining masks get copied out of the fragmented atlas, which then gets purged.
+        this->drawPathsAndFlush(ccpr, matrices, 3);
+        REPORTER_ASSERT(reporter, 0 != atlasIDRecorder.lastCopyAtlasID());
+        REPORTER_ASSERT(reporter, stats.fNumCompactedPaths > 0);
+        REPORTER_ASSERT(reporter, stats.fWastedAtlasPixels < wastedPixels);
+        REPORTER_ASSERT(reporter, stats.fNumAtlasHits <= stats.fNumFinds);
+    }
+};
+DEF_CCPR_TEST(CCPR_cache_compaction)
+
 class CCPR_unrefPerOpListPathsBeforeOps : public CCPRTest {
     void onRun(skiatest::Reporter* reporter, CCPRPathDrawer& ccpr) override {
         REPORTER_ASSERT(reporter, SkPathPriv::TestingOnly_unique(fPath));
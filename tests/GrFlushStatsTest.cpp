@@ -0,0 +1,102 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Test.h"
+
+#include "GrContext.h"
+#include "GrContextPriv.h"
+#include "SkCanvas.h"
+#include "SkSurface.h"
+#include "SkTArray.h"
+#include "gl/GrGLCaps.h"
+
+static void record_flush_stats(GrFlushStatsContext context, const GrFlushStats& stats) {
+    static_cast<SkTArray<GrFlushStats>*>(context)->push_back(stats);
+}
+
+DEF_GPUTEST_FOR_ALL_CONTEXTS(GrFlushStats, reporter, ctxInfo) {
+    GrContext* context = ctxInfo.grContext();
+
+    SkImageInfo info = SkImageInfo::Make(16, 16, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+    sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, info);
+    if (!surface) {
+        return;
+    }
+    surface->getCanvas()->clear(SK_ColorWHITE);
+    context->flush();
+
+    SkTArray<GrFlushStats> stats;
+    context->setFlushStatsProc(record_flush_stats, &stats);
+
+    SkPaint paint;
+    paint.setColor(SK_ColorRED);
+    surface->getCanvas()->drawRect(SkRect::MakeWH(8, 8), paint);
+    paint.setColor(SK_ColorBLUE);
+    surface->getCanvas()->drawCircle(8, 8, 4, paint);
+    context->flush();
+
+    REPORTER_ASSERT(reporter, stats.count() == 1);
+    const GrFlushStats& drew = stats[0];
+    REPORTER_ASSERT(reporter, drew.fFlushID > 0);
+    REPORTER_ASSERT(reporter, drew.fOpLists >= 1);
+    REPORTER_ASSERT(reporter, drew.fOpChains >= 1);
+    REPORTER_ASSERT(reporter, drew.fDraws >= 1 && drew.fMeshes >= drew.fDraws);
+    REPORTER_ASSERT(reporter, drew.fTotalNanos >= drew.fAllocateNanos + drew.fPrepareNanos +
+                                                  drew.fUploadNanos + drew.fExecuteNanos +
+                                                  drew.fSubmitNanos);
+    REPORTER_ASSERT(reporter, !drew.fGpuTimedFlushID && !drew.fGpuNanos);
+
+    // Uploads are counted by the next flush, even if they happen outside of one.
+    SkBitmap bitmap;
+    bitmap.allocPixels(info);
+    bitmap.eraseColor(SK_ColorGREEN);
+    surface->writePixels(bitmap, 0, 0);
+    context->flush();
+    REPORTER_ASSERT(reporter, stats.count() == 2);
+    REPORTER_ASSERT(reporter, stats[1].fFlushID == stats[0].fFlushID + 1);
+    REPORTER_ASSERT(reporter, stats[1].fBytesUploaded >= bitmap.computeByteSize());
+
+    // Nothing to do.
+    context->flush();
+    REPORTER_ASSERT(reporter, stats.count() == 3);
+    REPORTER_ASSERT(reporter, !stats[2].fOpLists && !stats[2].fDraws && !stats[2].fBytesUploaded);
+    REPORTER_ASSERT(reporter, !stats[2].fProgramBinds);
+
+    context->setFlushStatsProc(nullptr, nullptr);
+    context->flush();
+    REPORTER_ASSERT(reporter, stats.count() == 3);
+
+    // With GPU timing, a flush that waits for the GPU is timed by the next one.
+    stats.reset();
+    context->setFlushStatsProc(record_flush_stats, &stats, true);
+    surface->getCanvas()->drawRect(SkRect::MakeWH(8, 8), paint);
+    context->flush(kSyncCpu_GrFlushFlag, 0, nullptr);
+    context->flush();
+    REPORTER_ASSERT(reporter, stats.count() == 2);
+    bool timed = context->backend() == GrBackendApi::kOpenGL &&
+                 static_cast<const GrGLCaps*>(context->priv().caps())->timerQuerySupport();
+    if (timed) {
+        REPORTER_ASSERT(reporter, stats[1].fGpuTimedFlushID == stats[0].fFlushID);
+    } else {
+        REPORTER_ASSERT(reporter, !stats[1].fGpuTimedFlushID);
+    }
+
+    // Many flushes without waiting never leave more than a few queries pending, and results only
+    // ever come from earlier flushes, oldest first.
+    for (int i = 0; i < 50; i++) {
+        context->flush();
+    }
+    uint64_t lastTimed = 0;
+    for (const GrFlushStats& s : stats) {
+        if (s.fGpuTimedFlushID) {
+            REPORTER_ASSERT(reporter, s.fGpuTimedFlushID < s.fFlushID);
+            REPORTER_ASSERT(reporter, s.fGpuTimedFlushID > lastTimed);
+            lastTimed = s.fGpuTimedFlushID;
+        }
+    }
+    context->setFlushStatsProc(nullptr, nullptr);
+}
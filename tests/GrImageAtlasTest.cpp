@@ -0,0 +1,103 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkTypes.h"
+
+#include "GrContextFactory.h"
+#include "GrContextPriv.h"
+#include "GrDrawingManager.h"
+#include "GrImageAtlasManager.h"
+#include "GrTextureProxy.h"
+#include "SkCanvas.h"
+#include "SkImage.h"
+#include "SkSurface.h"
+#include "Test.h"
+
+using namespace sk_gpu_test;
+
+static SkBitmap make_bitmap(int width, int height, SkColor color) {
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(width, height);
+    bitmap.eraseColor(color);
+    bitmap.setImmutable();
+    return bitmap;
+}
+
+DEF_GPUTEST(GrImageAtlas, reporter, options) {
+    GrContextOptions atlasOptions = options;
+    atlasOptions.fImageAtlasMaxImageSize = 32;
+    for (int i = 0; i < GrContextFactory::kContextTypeCnt; ++i) {
+        auto ctxType = static_cast<GrContextFactory::ContextType>(i);
+        if (!GrContextFactory::IsRenderingContext(ctxType)) {
+            continue;
+        }
+        GrContextFactory factory(atlasOptions);
+        GrContext* context = factory.get(ctxType);
+        if (!context) {
+            continue;
+        }
+        GrImageAtlasManager* atlas = context->priv().drawingManager()->getImageAtlasManager();
+        REPORTER_ASSERT(reporter, atlas);
+        if (!atlas) {
+            continue;
+        }
+
+        // Images are only atlased once they've been drawn before, and only if they're small.
+        SkBitmap red = make_bitmap(10, 12, SK_ColorRED);
+        SkBitmap blue = make_bitmap(7, 5, SK_ColorBLUE);
+        SkBitmap big = make_bitmap(33, 4, SK_ColorGREEN);
+        uint32_t redID = red.getGenerationID();
+        uint32_t blueID = blue.getGenerationID();
+        uint32_t bigID = big.getGenerationID();
+        SkIRect redSubset, blueSubset, bigSubset;
+        REPORTER_ASSERT(reporter, !atlas->findOrAddImage(redID, red, &redSubset));
+        sk_sp<GrTextureProxy> redProxy = atlas->findOrAddImage(redID, red, &redSubset);
+        REPORTER_ASSERT(reporter, redProxy && redSubset.size() == red.dimensions());
+        REPORTER_ASSERT(reporter, !atlas->findOrAddImage(blueID, blue, &blueSubset));
+        sk_sp<GrTextureProxy> blueProxy = atlas->findOrAddImage(blueID, blue, &blueSubset);
+        REPORTER_ASSERT(reporter, blueProxy == redProxy);
+        REPORTER_ASSERT(reporter, !SkIRect::Intersects(blueSubset, redSubset));
+        REPORTER_ASSERT(reporter, atlas->findOrAddImage(redID, red, &redSubset) == redProxy);
+        REPORTER_ASSERT(reporter, !atlas->findOrAddImage(bigID, big, &bigSubset));
+        REPORTER_ASSERT(reporter, !atlas->findOrAddImage(bigID, big, &bigSubset));
+        context->flush();
+
+        // Images drawn from the atlas look like they would otherwise, with bilerp and AA too.
+        SkImageInfo info = SkImageInfo::MakeN32Premul(64, 64);
+        sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, info);
+        if (!surface) {
+            continue;
+        }
+        sk_sp<SkImage> images[] = {
+                SkImage::MakeFromBitmap(make_bitmap(8, 8, SK_ColorRED)),
+                SkImage::MakeFromBitmap(make_bitmap(8, 8, SK_ColorBLUE)),
+        };
+        SkPaint paint;
+        paint.setFilterQuality(kLow_SkFilterQuality);
+        paint.setAntiAlias(true);
+        for (int frame = 0; frame < 3; ++frame) {
+            surface->getCanvas()->clear(SK_ColorWHITE);
+            surface->getCanvas()->drawImageRect(images[0], SkRect::MakeXYWH(0, 0, 32, 64),
+                                                &paint);
+            surface->getCanvas()->drawImageRect(images[1], SkRect::MakeXYWH(32, 0, 32, 64),
+                                                &paint);
+            surface->getCanvas()->flush();
+
+            SkBitmap result;
+            result.allocPixels(info);
+            if (!surface->readPixels(result, 0, 0)) {
+                continue;
+            }
+            for (int y = 0; y < 64; y += 7) {
+                REPORTER_ASSERT(reporter, result.getColor(1, y) == SK_ColorRED);
+                REPORTER_ASSERT(reporter, result.getColor(30, y) == SK_ColorRED);
+                REPORTER_ASSERT(reporter, result.getColor(33, y) == SK_ColorBLUE);
+                REPORTER_ASSERT(reporter, result.getColor(62, y) == SK_ColorBLUE);
+            }
+        }
+    }
+}
@@ -12,6 +12,8 @@
 #include "SkTDArray.h"
 #include "SkTemplates.h"
 
+#include <thread>
+
 // A is the top of an inheritance tree of classes that overload op new and
 // and delete to use a GrMemoryPool. The objects have values of different types
 // that can be set and checked.
@@ -318,3 +320,32 @@ DEF_TEST(GrMemoryPoolAPI, reporter) {
         REPORTER_ASSERT(reporter, pool.size() == hugeBlockSize + kMinAllocSize);
     }
 }
+
+DEF_TEST(GrOpMemoryPoolRemoteRelease, reporter) {
+    constexpr int kCount = 1000;
+    GrOpMemoryPool pool(GrMemoryPool::kSmallestMinAllocSize, GrMemoryPool::kSmallestMinAllocSize);
+
+    SkTArray<void*> first;
+    for (int i = 0; i < kCount; i++) {
+        first.push_back(pool.allocate(i % 64));
+    }
+
+    // Release the first batch on another thread while this one keeps allocating.
+    SkTArray<void*> second;
+    std::thread releaser([&] {
+        for (void* mem : first) {
+            pool.release(mem);
+        }
+    });
+    for (int i = 0; i < kCount; i++) {
+        second.push_back(pool.allocate(i % 64));
+    }
+    releaser.join();
+    for (void* mem : second) {
+        pool.release(mem);
+    }
+
+    // Whatever the other thread released after our last allocation is still waiting for us.
+    pool.release(pool.allocate(0));
+    REPORTER_ASSERT(reporter, pool.isEmpty());
+}
@@ -9,6 +9,7 @@
 #include "SkColorPriv.h"
 #include "SkColorShader.h"
 #include "SkGradientShader.h"
+#include "SkRandom.h"
 #include "SkShader.h"
 #include "SkSurface.h"
 #include "SkTemplates.h"
@@ -538,6 +539,45 @@ static void test_sweep_fuzzer(skiatest::Reporter*) {
     }
 }
 
+// Gradients with many stops sample a table of their colors; that should be close to exact.
+static void test_many_stops(skiatest::Reporter* reporter) {
+    constexpr int kStops = 17,
+                  kWidth = 512;
+    SkColor  colors[kStops];
+    SkScalar pos   [kStops];
+    SkRandom rand;
+    for (int i = 0; i < kStops; i++) {
+        colors[i] = rand.nextU() | 0xff000000;
+        pos   [i] = i / (kStops - 1.0f);
+    }
+    const SkPoint pts[] = {{ 0, 0 }, { kWidth, 0 }};
+
+    for (const SkScalar* p : { (const SkScalar*)nullptr, (const SkScalar*)pos }) {
+        SkPaint paint;
+        paint.setShader(SkGradientShader::MakeLinear(pts, colors, p, kStops,
+                                                     SkShader::kClamp_TileMode));
+        SkBitmap bm;
+        bm.allocN32Pixels(kWidth, 1);
+        SkCanvas canvas(bm);
+        canvas.drawPaint(paint);
+
+        for (int x = 0; x < kWidth; x++) {
+            float t = (x + 0.5f) / kWidth * (kStops - 1);
+            int   i = std::min((int)t, kStops - 2);
+            t -= i;
+            const SkColor got = bm.getColor(x, 0);
+            auto check = [&](unsigned (*channel)(SkColor)) {
+                float want = channel(colors[i]) + t * ((float)channel(colors[i+1]) -
+                                                       (float)channel(colors[i]));
+                return fabsf(want - channel(got)) <= 3;
+            };
+            REPORTER_ASSERT(reporter, check([](SkColor c) { return SkColorGetR(c); }) &&
+                                      check([](SkColor c) { return SkColorGetG(c); }) &&
+                                      check([](SkColor c) { return SkColorGetB(c); }), "x=%d", x);
+        }
+    }
+}
+
 DEF_TEST(Gradient, reporter) {
     TestGradientShaders(reporter);
     TestGradientOptimization(reporter);
@@ -551,4 +591,5 @@ DEF_TEST(Gradient, reporter) {
     test_degenerate_linear(reporter);
     test_linear_fuzzer(reporter);
     test_sweep_fuzzer(reporter);
+    test_many_stops(reporter);
 }
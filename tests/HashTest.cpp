@@ -9,6 +9,7 @@
 #include "SkRefCnt.h"
 #include "SkString.h"
 #include "SkTHash.h"
+#include "SkTSwissTable.h"
 #include "Test.h"
 
 // Tests use of const foreach().  map.count() is of course the better way to do this.
@@ -199,3 +200,64 @@ DEF_TEST(HashFindOrNull, r) {
 
     REPORTER_ASSERT(r, &seven == table.findOrNull(7));
 }
+
+DEF_TEST(SwissTable, r) {
+    struct Entry {
+        int key;
+        sk_sp<SkRefCnt> ref;  // Not trivially copyable, to check entries are destroyed.
+    };
+
+    struct HashTraits {
+        static int GetKey(const Entry& e) { return e.key; }
+        static uint32_t Hash(int key) { return key; }
+    };
+
+    sk_sp<SkRefCnt> ref(new SkRefCnt);
+    {
+        SkTSwissTable<Entry, int, HashTraits> table;
+        REPORTER_ASSERT(r, !table.find(7));
+
+        // Enough entries to fill many groups, then remove most of them so that later sets have
+        // to reuse deleted slots.
+        constexpr int kCount = 1000;
+        for (int i = 0; i < kCount; i++) {
+            table.set({i, ref});
+        }
+        REPORTER_ASSERT(r, kCount == table.count());
+        for (int i = 0; i < kCount; i++) {
+            if (i % 4 != 0) {
+                table.remove(i);
+            }
+        }
+        REPORTER_ASSERT(r, kCount / 4 == table.count());
+        for (int round = 0; round < 3; round++) {
+            for (int i = kCount; i < 2 * kCount; i++) {
+                table.set({i, ref});
+            }
+            for (int i = kCount; i < 2 * kCount; i++) {
+                table.remove(i);
+            }
+        }
+
+        for (int i = 0; i < 2 * kCount; i++) {
+            Entry* e = table.find(i);
+            REPORTER_ASSERT(r, SkToBool(e) == (i < kCount && i % 4 == 0));
+            REPORTER_ASSERT(r, !e || e->key == i);
+        }
+        int n = 0;
+        const auto& constTable = table;
+        constTable.foreach([&n](const Entry&) { n++; });
+        REPORTER_ASSERT(r, kCount / 4 == n);
+
+        // Setting an existing key overwrites it.
+        table.set({0, nullptr});
+        REPORTER_ASSERT(r, kCount / 4 == table.count());
+        REPORTER_ASSERT(r, !table.find(0)->ref);
+
+        SkTSwissTable<Entry, int, HashTraits> moved(std::move(table));
+        REPORTER_ASSERT(r, 0 == table.count());
+        REPORTER_ASSERT(r, kCount / 4 == moved.count());
+        REPORTER_ASSERT(r, !ref->unique());
+    }
+    REPORTER_ASSERT(r, ref->unique());
+}
@@ -150,3 +150,26 @@ DEF_TEST(ImageCache_doubleAdd, r) {
     REPORTER_ASSERT(r, cache.find(key, TestingRec::Visitor, &value));
     REPORTER_ASSERT(r, 2 == value || 3 == value);
 }
+
+DEF_TEST(ImageCache_global, r) {
+    // Use a sharedID no other test will, so we can purge just our recs at the end.
+    static const uint64_t kSharedID = 0x5eed5eed5eedULL;
+    static const int kCount = 64;  // Enough to land in every shard of the global cache.
+
+    for (int i = 0; i < kCount; ++i) {
+        SkResourceCache::Add(new TestingRec(TestingKey(i, kSharedID), i));
+    }
+    for (int i = 0; i < kCount; ++i) {
+        intptr_t value = -1;
+        REPORTER_ASSERT(r, SkResourceCache::Find(TestingKey(i, kSharedID),
+                                                 TestingRec::Visitor, &value));
+        REPORTER_ASSERT(r, i == value);
+    }
+
+    SkResourceCache::PostPurgeSharedID(kSharedID);
+    for (int i = 0; i < kCount; ++i) {
+        intptr_t value = -1;
+        REPORTER_ASSERT(r, !SkResourceCache::Find(TestingKey(i, kSharedID),
+                                                  TestingRec::Visitor, &value));
+    }
+}
@@ -14,6 +14,7 @@
 #include "SkImageFilter.h"
 #include "SkImageFilterCache.h"
 #include "SkMatrix.h"
+#include "SkPaintImageFilter.h"
 #include "SkSpecialImage.h"
 
 static const int kSmallerSize = 10;
@@ -147,6 +148,41 @@ static void test_explicit_purging(skiatest::Reporter* reporter,
     REPORTER_ASSERT(reporter, !cache->get(key2, &foundOffset));
 }
 
+// The cache's byte count should follow what was added and removed exactly
+static void test_byte_accounting(skiatest::Reporter* reporter,
+                                 const sk_sp<SkSpecialImage>& image,
+                                 const sk_sp<SkSpecialImage>& subset) {
+    static const size_t kCacheSize = 1000000;
+    sk_sp<SkImageFilterCache> cache(SkImageFilterCache::Create(kCacheSize));
+    REPORTER_ASSERT(reporter, kCacheSize == cache->getByteLimit());
+    REPORTER_ASSERT(reporter, 0 == cache->getTotalBytesUsed());
+
+    SkIRect clip = SkIRect::MakeWH(100, 100);
+    SkImageFilterCacheKey key1(0, SkMatrix::I(), clip, image->uniqueID(), image->subset());
+    SkImageFilterCacheKey key2(1, SkMatrix::I(), clip, subset->uniqueID(), subset->subset());
+
+    SkIPoint offset = SkIPoint::Make(3, 4);
+    auto filter1 = make_filter();
+    auto filter2 = make_filter();
+    cache->set(key1, image.get(), offset, filter1.get());
+    cache->set(key2, subset.get(), offset, filter2.get());
+    const size_t bothSizes = image->getSize() + subset->getSize();
+    REPORTER_ASSERT(reporter, bothSizes == cache->getTotalBytesUsed());
+
+    // Replacing an entry shouldn't count it twice.
+    cache->set(key1, image.get(), offset, filter1.get());
+    REPORTER_ASSERT(reporter, bothSizes == cache->getTotalBytesUsed());
+
+    cache->purgeByImageFilter(filter2.get());
+    REPORTER_ASSERT(reporter, image->getSize() == cache->getTotalBytesUsed());
+
+    // Shrinking the budget evicts right away.
+    cache->setByteLimit(image->getSize() - 1);
+    REPORTER_ASSERT(reporter, 0 == cache->getTotalBytesUsed());
+    SkIPoint foundOffset;
+    REPORTER_ASSERT(reporter, !cache->get(key1, &foundOffset));
+}
+
 DEF_TEST(ImageFilterCache_RasterBacked, reporter) {
     SkBitmap srcBM = create_bm();
 
@@ -162,9 +198,54 @@ DEF_TEST(ImageFilterCache_RasterBacked, reporter) {
     test_dont_find_if_diff_key(reporter, fullImg, subsetImg);
     test_internal_purge(reporter, fullImg);
     test_explicit_purging(reporter, fullImg, subsetImg);
+    test_byte_accounting(reporter, fullImg, subsetImg);
 }
 
 
+// A filter that ignores its source should be found again after a whole-pixel translation,
+// with its offset moved to match.
+DEF_TEST(ImageFilterCache_TranslationInvariant, reporter) {
+    static const size_t kCacheSize = 1000000;
+    sk_sp<SkImageFilterCache> cache(SkImageFilterCache::Create(kCacheSize));
+
+    SkBitmap srcBM = create_bm();
+    sk_sp<SkSpecialImage> src(SkSpecialImage::MakeFromRaster(SkIRect::MakeWH(kFullSize, kFullSize),
+                                                             srcBM));
+
+    SkPaint paint;
+    paint.setColor(SK_ColorRED);
+    SkImageFilter::CropRect cropRect(SkRect::MakeXYWH(2, 3, 20, 20));
+    sk_sp<SkImageFilter> sourceFree(SkPaintImageFilter::Make(paint, &cropRect));
+    sk_sp<SkImageFilter> usesSource(make_filter());
+
+    SkImageFilter::OutputProperties noColorSpace(kN32_SkColorType, nullptr);
+    const SkIRect clip = SkIRect::MakeWH(100, 100);
+    SkImageFilter::Context ctx1(SkMatrix::MakeTrans(10.5f, 4.25f), clip, cache.get(),
+                                noColorSpace);
+    SkImageFilter::Context ctx2(SkMatrix::MakeTrans(13.5f, 9.25f), clip.makeOffset(3, 5),
+                                cache.get(), noColorSpace);
+
+    SkIPoint offset1, offset2;
+    sk_sp<SkSpecialImage> result1(sourceFree->filterImage(src.get(), ctx1, &offset1));
+    sk_sp<SkSpecialImage> result2(sourceFree->filterImage(src.get(), ctx2, &offset2));
+    REPORTER_ASSERT(reporter, result1 && result1 == result2);
+    REPORTER_ASSERT(reporter, offset2 == offset1 + SkIVector::Make(3, 5));
+    SkDEBUGCODE(REPORTER_ASSERT(reporter, 1 == cache->count());)
+
+    // A fractional move changes what gets drawn, so it needs its own entry.
+    SkImageFilter::Context ctx3(SkMatrix::MakeTrans(13.75f, 9.25f), clip.makeOffset(3, 5),
+                                cache.get(), noColorSpace);
+    SkIPoint offset3;
+    sk_sp<SkSpecialImage> result3(sourceFree->filterImage(src.get(), ctx3, &offset3));
+    REPORTER_ASSERT(reporter, result3 && result3 != result1);
+    SkDEBUGCODE(REPORTER_ASSERT(reporter, 2 == cache->count());)
+
+    // Filters that read the source stay keyed on the exact CTM.
+    usesSource->filterImage(src.get(), ctx1, &offset1);
+    usesSource->filterImage(src.get(), ctx2, &offset2);
+    SkDEBUGCODE(REPORTER_ASSERT(reporter, 4 == cache->count());)
+}
+
 // Shared test code for both the raster and gpu-backed image cases
 static void test_image_backed(skiatest::Reporter* reporter,
                               GrContext* context,
@@ -181,6 +262,7 @@ static void test_image_backed(skiatest::Reporter* reporter,
     test_dont_find_if_diff_key(reporter, fullImg, subsetImg);
     test_internal_purge(reporter, fullImg);
     test_explicit_purging(reporter, fullImg, subsetImg);
+    test_byte_accounting(reporter, fullImg, subsetImg);
 }
 
 DEF_TEST(ImageFilterCache_ImageBackedRaster, reporter) {
@@ -273,4 +355,5 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(ImageFilterCache_GPUBacked, reporter, ctxInfo
     test_dont_find_if_diff_key(reporter, fullImg, subsetImg);
     test_internal_purge(reporter, fullImg);
     test_explicit_purging(reporter, fullImg, subsetImg);
+    test_byte_accounting(reporter, fullImg, subsetImg);
 }
@@ -46,6 +46,8 @@
 #include "GrContext.h"
 #include "GrContextPriv.h"
 
+#include <atomic>
+
 static const int kBitmapSize = 4;
 
 namespace {
@@ -1860,6 +1862,19 @@ DEF_TEST(ImageFilterColorSpaceDAG, reporter) {
     auto xformedFilter = xformer->apply(complexFilter.get());
 
     REPORTER_ASSERT(reporter, filter->cloneCount() == 1u);
+
+    // Transforming the same DAG again (e.g. drawing it again) reuses the transformed filters.
+    auto xformedAgain = xformer->apply(complexFilter.get());
+    REPORTER_ASSERT(reporter, xformedAgain == xformedFilter);
+    REPORTER_ASSERT(reporter, xformer->apply(filter.get()).get() == filter.get());
+    REPORTER_ASSERT(reporter, filter->cloneCount() == 1u);
+
+    SkPaint paint;
+    paint.setImageFilter(complexFilter);
+    SkPaint xformedPaint = xformer->apply(paint);
+    REPORTER_ASSERT(reporter, xformedPaint.getImageFilter() == xformedFilter.get());
+    REPORTER_ASSERT(reporter, xformer->apply(paint) == xformedPaint);
+    REPORTER_ASSERT(reporter, filter->cloneCount() == 1u);
 }
 
 // Test SkXfermodeImageFilter::filterBounds with different blending modes.
@@ -2038,3 +2053,138 @@ DEF_TEST(ImageSourceBounds, reporter) {
                                                              &input));
 }
 
+
+// Raster devices evaluate filters over big areas a tile at a time; the tiles should be seamless.
+DEF_TEST(ImageFilterTiledEvaluation, reporter) {
+    const int kWidth = 4200, kHeight = 1024;
+    SkBitmap srcBitmap;
+    srcBitmap.allocN32Pixels(kWidth, kHeight);
+    {
+        SkCanvas canvas(srcBitmap);
+        canvas.clear(SK_ColorTRANSPARENT);
+        SkPaint paint;
+        for (int y = 0; y < kHeight; y += 37) {
+            for (int x = 0; x < kWidth; x += 41) {
+                paint.setColor(0xff000000 | ((x * 0x010203) ^ (y * 0x030201)));
+                canvas.drawRect(SkRect::MakeXYWH(x, y, 20, 20), paint);
+            }
+        }
+    }
+    sk_sp<SkImage> image = SkImage::MakeFromBitmap(srcBitmap);
+
+    sk_sp<SkImageFilter> blur(SkBlurImageFilter::Make(3, 3, nullptr));
+    sk_sp<SkImageFilter> filter(SkMergeImageFilter::Make(
+            blur, SkOffsetImageFilter::Make(7, -5, blur)));
+
+    SkBitmap tiled;
+    tiled.allocN32Pixels(kWidth, kHeight);
+    {
+        SkCanvas canvas(tiled);
+        canvas.clear(SK_ColorTRANSPARENT);
+        SkPaint paint;
+        paint.setImageFilter(filter);
+        canvas.drawImage(image, 0, 0, &paint);
+    }
+
+    SkBitmap untiled;
+    untiled.allocN32Pixels(kWidth, kHeight);
+    untiled.eraseColor(SK_ColorTRANSPARENT);
+    {
+        const SkIRect bounds = SkIRect::MakeWH(kWidth, kHeight);
+        SkIRect outSubset;
+        SkIPoint offset;
+        sk_sp<SkImage> filtered = image->makeWithFilter(filter.get(), bounds, bounds,
+                                                        &outSubset, &offset);
+        REPORTER_ASSERT(reporter, filtered);
+        SkCanvas canvas(untiled);
+        canvas.drawImageRect(filtered, outSubset,
+                             SkRect::Make(outSubset.makeOffset(offset.fX - outSubset.fLeft,
+                                                               offset.fY - outSubset.fTop)),
+                             nullptr);
+    }
+
+    int mismatches = 0;
+    for (int y = 0; y < kHeight; ++y) {
+        for (int x = 0; x < kWidth; ++x) {
+            mismatches += *tiled.getAddr32(x, y) != *untiled.getAddr32(x, y) ? 1 : 0;
+        }
+    }
+    REPORTER_ASSERT(reporter, 0 == mismatches, "%d pixels differ", mismatches);
+}
+
+// The bands handed out by SkImageFilterForEachBand() cover every line exactly once.
+DEF_TEST(ImageFilterForEachBand, reporter) {
+    for (int lines : { 0, 1, 7, 100, 1000, 4096 }) {
+        for (int pixelsPerLine : { 1, 256, 4096 }) {
+            std::unique_ptr<std::atomic<int>[]> visits(new std::atomic<int>[lines + 1]);
+            for (int i = 0; i <= lines; ++i) {
+                visits[i] = 0;
+            }
+            SkImageFilterForEachBand(lines, pixelsPerLine, [&](int start, int end) {
+                REPORTER_ASSERT(reporter, 0 <= start && start < end && end <= lines);
+                for (int i = start; i < end; ++i) {
+                    visits[i]++;
+                }
+            });
+            for (int i = 0; i < lines; ++i) {
+                REPORTER_ASSERT(reporter, 1 == visits[i]);
+            }
+        }
+    }
+}
+
+// A backdrop filter under a thin clip only snaps the part of the device it reads, and must draw
+// what filtering the whole device would have.
+DEF_TEST(ImageFilterBackdropSubset, reporter) {
+    const int kSize = 256;
+    const SkIRect kStrip = SkIRect::MakeLTRB(0, 100, kSize, 116);
+    auto draw_content = [](SkCanvas* canvas) {
+        canvas->clear(SK_ColorWHITE);
+        SkPaint paint;
+        for (int i = 0; i < kSize; i += 16) {
+            paint.setColor(0xff000000 | (i * 0x010101) | (i << 16));
+            canvas->drawRect(SkRect::MakeXYWH(i, (i * 7) % kSize, 12, 40), paint);
+        }
+    };
+
+    sk_sp<SkImageFilter> blur(SkBlurImageFilter::Make(4, 4, nullptr));
+    sk_sp<SkImageFilter> filter(SkMergeImageFilter::Make(
+            blur, SkOffsetImageFilter::Make(9, -6, blur)));
+
+    SkBitmap result;
+    result.allocN32Pixels(kSize, kSize);
+    {
+        SkCanvas canvas(result);
+        draw_content(&canvas);
+        canvas.clipRect(SkRect::Make(kStrip));
+        canvas.saveLayer(SkCanvas::SaveLayerRec(nullptr, nullptr, filter.get(), 0));
+        canvas.restore();
+    }
+
+    SkBitmap expected;
+    expected.allocN32Pixels(kSize, kSize);
+    {
+        SkCanvas canvas(expected);
+        draw_content(&canvas);
+        sk_sp<SkImage> content = SkImage::MakeFromBitmap(expected);
+        const SkIRect bounds = SkIRect::MakeWH(kSize, kSize);
+        SkIRect outSubset;
+        SkIPoint offset;
+        sk_sp<SkImage> filtered = content->makeWithFilter(filter.get(), bounds, bounds,
+                                                          &outSubset, &offset);
+        REPORTER_ASSERT(reporter, filtered);
+        canvas.clipRect(SkRect::Make(kStrip));
+        canvas.drawImageRect(filtered, outSubset,
+                             SkRect::Make(outSubset.makeOffset(offset.fX - outSubset.fLeft,
+                                                               offset.fY - outSubset.fTop)),
+                             nullptr);
+    }
+
+    int mismatches = 0;
+    for (int y = 0; y < kSize; ++y) {
+        for (int x = 0; x < kSize; ++x) {
+            mismatches += *result.getAddr32(x, y) != *expected.getAddr32(x, y) ? 1 : 0;
+        }
+    }
+    REPORTER_ASSERT(reporter, 0 == mismatches, "%d pixels differ", mismatches);
+}
@@ -14,6 +14,7 @@
 #include "SkCanvas.h"
 #include "SkColorSpacePriv.h"
 #include "SkData.h"
+#include "SkExecutor.h"
 #include "SkImageEncoder.h"
 #include "SkImageGenerator.h"
 #include "SkImage_Base.h"
@@ -323,6 +324,99 @@ DEF_TEST(image_newfrombitmap, reporter) {
     }
 }
 
+namespace {
+// Holds tasks until the test runs them, one at a time.
+class DeferredExecutor final : public SkExecutor {
+public:
+    void add(std::function<void(void)> work) override { fWork.push_back(std::move(work)); }
+
+    bool runOne() {
+        if (fWork.empty()) {
+            return false;
+        }
+        auto work = std::move(fWork.front());
+        fWork.erase(fWork.begin());
+        work();
+        return true;
+    }
+
+private:
+    std::vector<std::function<void(void)>> fWork;
+};
+
+// Records the order images are decoded in.
+class OrderRecordingGenerator final : public SkImageGenerator {
+public:
+    OrderRecordingGenerator(int id, std::vector<int>* order)
+        : INHERITED(SkImageInfo::MakeN32Premul(8, 8)), fID(id), fOrder(order) {}
+
+protected:
+    bool onGetPixels(const SkImageInfo& info, void* pixels, size_t rowBytes,
+                     const Options&) override {
+        fOrder->push_back(fID);
+        for (int y = 0; y < info.height(); y++) {
+            sk_memset32(SkTAddOffset<uint32_t>(pixels, y * rowBytes), SK_ColorBLUE,
+                        info.width());
+        }
+        return true;
+    }
+
+private:
+    const int         fID;
+    std::vector<int>* fOrder;
+
+    typedef SkImageGenerator INHERITED;
+};
+}  // namespace
+
+DEF_TEST(Image_prefetchDecode, reporter) {
+    std::vector<int> order;
+    sk_sp<SkImage> images[4];
+    for (int i = 0; i < 4; i++) {
+        images[i] = SkImage::MakeFromGenerator(
+                skstd::make_unique<OrderRecordingGenerator>(i, &order));
+    }
+
+    DeferredExecutor executor;
+    images[0]->prefetchDecode(executor, 0);
+    images[1]->prefetchDecode(executor, 1);
+    images[2]->prefetchDecode(executor, 2);
+    images[3]->prefetchDecode(executor, 3);
+    // Asking again just raises the priority; it doesn't decode twice.
+    images[0]->prefetchDecode(executor, 4);
+    images[1]->prefetchDecode(executor, 0);
+    images[2]->cancelPrefetchDecode();
+
+    // The prefetches hold their own references.
+    for (auto& image : images) {
+        image.reset();
+    }
+    while (executor.runOne()) {}
+    REPORTER_ASSERT(reporter, (order == std::vector<int>{ 0, 3, 1 }));
+
+    // A prefetched image draws from the cache, without decoding again.
+    order.clear();
+    sk_sp<SkImage> image = SkImage::MakeFromGenerator(
+            skstd::make_unique<OrderRecordingGenerator>(7, &order));
+    image->prefetchDecode(executor);
+    while (executor.runOne()) {}
+    REPORTER_ASSERT(reporter, (order == std::vector<int>{ 7 }));
+
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(8, 8);
+    REPORTER_ASSERT(reporter, image->readPixels(bitmap.pixmap(), 0, 0));
+    REPORTER_ASSERT(reporter, SK_ColorBLUE == bitmap.getColor(4, 4));
+    if (order.size() != 1) {
+        // Not really a bug, since the cache is global and this test may be run with other
+        // threads competing for its budget.
+        SkDebugf("Image_prefetchDecode : prefetched pixels were already purged\n");
+    }
+
+    // Nothing to do for an image that is already cached.
+    image->prefetchDecode(executor);
+    REPORTER_ASSERT(reporter, order.size() != 1 || !executor.runOne());
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "SkBitmapCache.h"
@@ -415,6 +415,45 @@ DEF_TEST(JSON_DOM_build, reporter) {
                                             "}");
 }
 
+DEF_TEST(JSON_DOM_binary, reporter) {
+    static constexpr char json[] = "{ \"k1\": null, \"k2\": [ true, false, 42, -1.5 ], "
+                                   "\"k3\": \"foo\", \"a rather longer key\": "
+                                   "{ \"k4\": \"a rather longer string\", \"k5\": [[], {}] } }";
+
+    const DOM dom(json, strlen(json));
+    const auto expected = dom.root().toString();
+    REPORTER_ASSERT(reporter, dom.root().is<ObjectValue>());
+
+    SkDynamicMemoryWStream stream;
+    REPORTER_ASSERT(reporter, dom.writeBinary(&stream));
+    const auto image = stream.detachAsData();
+    const auto* data = static_cast<const char*>(image->data());
+
+    const DOM loaded(data, image->size());
+    REPORTER_ASSERT(reporter, loaded.root().toString().equals(expected));
+
+    // The loaded DOM doesn't refer back to the image.
+    std::vector<char> copy(data, data + image->size());
+    const DOM loadedCopy(copy.data(), copy.size());
+    std::fill(copy.begin(), copy.end(), '\xff');
+    REPORTER_ASSERT(reporter, loadedCopy.root().toString().equals(expected));
+
+    // Truncated images load as null.
+    for (size_t size = 0; size < image->size(); size += 8) {
+        const DOM truncated(data, size);
+        REPORTER_ASSERT(reporter, truncated.root().is<NullValue>());
+    }
+
+    // So do images pointing past or ahead of their slabs.
+    std::vector<char> corrupt(data, data + image->size());
+    const size_t root = corrupt.size() - 8;
+    for (uint32_t offset : { 0u, 4u, SkToU32(root), SkToU32(root - 16), 0xfffffff8u }) {
+        memcpy(corrupt.data() + root, &offset, sizeof(offset));
+        const DOM bad(corrupt.data(), corrupt.size());
+        REPORTER_ASSERT(reporter, bad.root().is<NullValue>());
+    }
+}
+
 DEF_TEST(JSON_ParseNumber, reporter) {
     static constexpr struct {
         const char* string;
@@ -0,0 +1,31 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkMalloc.h"
+#include "SkMallocStats.h"
+#include "Test.h"
+
+// Other tests allocate on other threads meanwhile, so this can only check lower bounds.
+DEF_TEST(MallocStats, r) {
+    if (!SkMallocStats::Enabled()) {
+        return;
+    }
+    SkMallocStats::Totals before = SkMallocStats::Get();
+    void* p = sk_malloc_throw(1000);
+    SkMallocStats::Totals allocated = SkMallocStats::Get();
+    p = sk_realloc_throw(p, 2000);
+    sk_free(p);
+    SkMallocStats::Totals after = SkMallocStats::Get();
+
+    REPORTER_ASSERT(r, after.fAllocs - before.fAllocs >= 2);
+    REPORTER_ASSERT(r, after.fFrees - before.fFrees >= 2);
+    REPORTER_ASSERT(r, allocated.fPeakLiveBytes >= allocated.fLiveBytes);
+    if (after.fAllocBytes) {
+        // The allocator's usable size is known on this platform.
+        REPORTER_ASSERT(r, after.fAllocBytes - before.fAllocBytes >= 3000);
+    }
+}
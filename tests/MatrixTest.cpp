@@ -1066,3 +1066,36 @@ DEF_TEST(Matrix_maprects, r) {
         }
     }
 }
+
+// mapPoints() runs several points at a time; it should agree exactly with mapXY() for every
+// point, whatever the batch size and whether or not it's mapping in place.
+DEF_TEST(Matrix_mappoints_batches, r) {
+    SkMatrix affine;
+    affine.setRotate(30);
+    affine.postScale(2, 0.5f);
+    affine.postTranslate(3, -4);
+    SkMatrix persp = affine;
+    persp.setPerspX(1.0f / 16);
+    persp.setPerspY(-1.0f / 32);
+
+    SkRandom rand;
+    SkPoint src[37], dst[37];
+    for (SkPoint& pt : src) {
+        pt.set(rand.nextRangeF(-100, 100), rand.nextRangeF(-100, 100));
+    }
+    src[5].set(-8, 16);  // maps to w == 0 with persp
+
+    for (const SkMatrix& m : { affine, persp }) {
+        for (int count : { 1, 3, 4, 7, 8, 9, 37 }) {
+            m.mapPoints(dst, src, count);
+            for (int i = 0; i < count; ++i) {
+                REPORTER_ASSERT(r, dst[i] == m.mapXY(src[i].fX, src[i].fY), "%d of %d", i, count);
+            }
+            memcpy(dst, src, sizeof(src));
+            m.mapPoints(dst, count);
+            for (int i = 0; i < count; ++i) {
+                REPORTER_ASSERT(r, dst[i] == m.mapXY(src[i].fX, src[i].fY), "%d of %d", i, count);
+            }
+        }
+    }
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkMetrics.h"
+#include "SkString.h"
+#include "SkTHash.h"
+#include "SkTaskGroup.h"
+#include "SkTraceMemoryDump.h"
+#include "Test.h"
+
+namespace {
+
+class MetricsDump : public SkTraceMemoryDump {
+public:
+    void dumpNumericValue(const char* dumpName, const char* valueName, const char*,
+                          uint64_t value) override {
+        fValues.set(SkStringPrintf("%s:%s", dumpName, valueName), value);
+    }
+    void setMemoryBacking(const char*, const char*, const char*) override {}
+    void setDiscardableMemoryBacking(const char*, const SkDiscardableMemory&) override {}
+    LevelOfDetail getRequestedDetails() const override {
+        return SkTraceMemoryDump::kObjectsBreakdowns_LevelOfDetail;
+    }
+
+    uint64_t find(const char* name) const {
+        const uint64_t* value = fValues.find(SkString(name));
+        return value ? *value : ~0ull;
+    }
+
+private:
+    SkTHashMap<SkString, uint64_t> fValues;
+};
+
+}  // namespace
+
+static SkMetrics::Counter* test_counter() {
+    static SkMetrics::Counter counter("test.metrics.counter");
+    return &counter;
+}
+
+static SkMetrics::Histogram* test_histogram() {
+    static SkMetrics::Histogram histogram("test.metrics.histogram");
+    return &histogram;
+}
+
+DEF_TEST(Metrics_counter, r) {
+    SkMetrics::Counter* counter = test_counter();
+    SkMetrics::ResetAll();
+    REPORTER_ASSERT(r, counter->value() == 0);
+
+    // Adds from many threads land in different shards, but all count.
+    SkTaskGroup().batch(1000, [counter](int i) { counter->add(i); });
+    REPORTER_ASSERT(r, counter->value() == 999 * 1000 / 2);
+    counter->add(-500);
+    REPORTER_ASSERT(r, counter->value() == 999 * 1000 / 2 - 500);
+
+    int found = 0;
+    SkMetrics::ForEachCounter([&](const SkMetrics::Counter& c) {
+        if (&c == counter) {
+            found++;
+            REPORTER_ASSERT(r, !strcmp(c.name(), "test.metrics.counter"));
+        }
+    });
+    REPORTER_ASSERT(r, found == 1);
+
+    SkMetrics::ResetAll();
+    REPORTER_ASSERT(r, counter->value() == 0);
+}
+
+DEF_TEST(Metrics_histogram, r) {
+    SkMetrics::Histogram* histogram = test_histogram();
+    SkMetrics::ResetAll();
+
+    SkTaskGroup().batch(100, [histogram](int) {
+        histogram->record(0);
+        histogram->record(1);
+        histogram->record(5);     // [4, 8)
+        histogram->record(1000);  // [512, 1024)
+    });
+    histogram->record(~0ull);
+
+    SkMetrics::Histogram::Totals totals = histogram->totals();
+    REPORTER_ASSERT(r, totals.fCount == 401);
+    REPORTER_ASSERT(r, totals.fBuckets[0]  == 100);
+    REPORTER_ASSERT(r, totals.fBuckets[1]  == 100);
+    REPORTER_ASSERT(r, totals.fBuckets[3]  == 100);
+    REPORTER_ASSERT(r, totals.fBuckets[10] == 100);
+    REPORTER_ASSERT(r, totals.fBuckets[64] == 1);
+    REPORTER_ASSERT(r, totals.fSum == 100 * (1 + 5 + 1000) + ~0ull);
+
+    MetricsDump dump;
+    test_counter()->add(7);
+    SkMetrics::DumpMemoryStatistics(&dump);
+    REPORTER_ASSERT(r, dump.find("skia/metrics/test.metrics.counter:count") == 7);
+    REPORTER_ASSERT(r, dump.find("skia/metrics/test.metrics.histogram:count") == 401);
+    REPORTER_ASSERT(r, dump.find("skia/metrics/test.metrics.histogram:bucket_3") == 100);
+    REPORTER_ASSERT(r, dump.find("skia/metrics/test.metrics.histogram:bucket_2") == ~0ull);
+}
+
+DEF_TEST(Metrics_macros, r) {
+    SkMetrics::ResetAll();
+    int evaluated = 0;
+    for (int i = 0; i < 3; i++) {
+        SK_METRIC_COUNT("test.metrics.macro", ++evaluated);
+    }
+
+    int64_t value = -1;
+    SkMetrics::ForEachCounter([&](const SkMetrics::Counter& c) {
+        if (!strcmp(c.name(), "test.metrics.macro")) {
+            value = c.value();
+        }
+    });
+#if SK_METRICS_ENABLED
+    REPORTER_ASSERT(r, evaluated == 3 && value == 1 + 2 + 3);
+#else
+    // Disabled, the macros don't even evaluate their arguments.
+    REPORTER_ASSERT(r, evaluated == 0 && value == -1);
+#endif
+}
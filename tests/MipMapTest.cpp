@@ -6,6 +6,7 @@
  */
 
 #include "SkBitmap.h"
+#include "SkExecutor.h"
 #include "SkMipMap.h"
 #include "SkRandom.h"
 #include "Test.h"
@@ -209,3 +210,41 @@ DEF_TEST(MipMap_F16, reporter) {
     bmp.eraseColor(0);
     sk_sp<SkMipMap> mipmap(SkMipMap::Build(bmp, nullptr));
 }
+
+// Building the biggest levels in parallel, a level at a time, has to agree with the serial
+// build, which interleaves the levels a few rows at a time.
+DEF_TEST(MipMap_Executor, reporter) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    SkRandom rand;
+
+    const SkISize sizes[] = { {1023, 1025}, {1024, 1024}, {700, 3}, {2, 999} };
+    for (SkISize size : sizes) {
+        SkBitmap bm;
+        bm.allocN32Pixels(size.width(), size.height());
+        for (int y = 0; y < size.height(); y++) {
+            for (int x = 0; x < size.width(); x++) {
+                *bm.getAddr32(x, y) = SkPreMultiplyColor(rand.nextU());
+            }
+        }
+
+        sk_sp<SkMipMap> serial(SkMipMap::Build(bm, nullptr));
+        sk_sp<SkMipMap> parallel(SkMipMap::Build(bm, nullptr, executor.get()));
+        REPORTER_ASSERT(reporter, serial && parallel);
+        if (!serial || !parallel) {
+            continue;
+        }
+        REPORTER_ASSERT(reporter, serial->countLevels() == parallel->countLevels());
+        for (int i = 0; i < serial->countLevels(); i++) {
+            SkMipMap::Level a, b;
+            REPORTER_ASSERT(reporter, serial->getLevel(i, &a) && parallel->getLevel(i, &b));
+            for (int y = 0; y < a.fPixmap.height(); y++) {
+                if (memcmp(a.fPixmap.addr(0, y), b.fPixmap.addr(0, y),
+                           a.fPixmap.info().minRowBytes())) {
+                    ERRORF(reporter, "%dx%d: level %d differs at row %d",
+                           size.width(), size.height(), i, y);
+                    break;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrDistanceFieldGenFromVector.h"
+#include "SkDistanceFieldGen.h"
+#include "SkMatrix.h"
+#include "SkPath.h"
+#include "SkTemplates.h"
+#include "Test.h"
+
+static unsigned char median(const unsigned char* texel) {
+    return SkTMax(SkTMin(texel[0], texel[1]), SkTMin(SkTMax(texel[0], texel[1]), texel[2]));
+}
+
+DEF_TEST(MultiChannelDistanceField, reporter) {
+    static const int kSize = 20;
+    static const int kDFSize = kSize + 2 * SK_DistanceFieldPad;
+    static const size_t kRowBytes = 4 * kDFSize;
+
+    SkPath path;
+    path.addRect(SkRect::MakeWH(kSize, kSize));
+
+    SkAutoTMalloc<unsigned char> df(kDFSize * kRowBytes);
+    REPORTER_ASSERT(reporter, GrGenerateMultiChannelDistanceFieldFromPath(
+            df.get(), path, SkMatrix::I(), kDFSize, kDFSize, kRowBytes));
+
+    // Inside is above 128, everywhere the median agrees with the single channel field in alpha.
+    for (int y = 0; y < kDFSize; ++y) {
+        for (int x = 0; x < kDFSize; ++x) {
+            const unsigned char* texel = df.get() + y * kRowBytes + 4 * x;
+            bool inside = x >= SK_DistanceFieldPad && x < SK_DistanceFieldPad + kSize &&
+                          y >= SK_DistanceFieldPad && y < SK_DistanceFieldPad + kSize;
+            REPORTER_ASSERT(reporter, (median(texel) > 128) == inside, "%d %d", x, y);
+            REPORTER_ASSERT(reporter, (texel[3] > 128) == inside, "%d %d", x, y);
+        }
+    }
+
+    // Diagonally outside a corner the single channel distance is to the corner point, rounding it
+    // off when magnified. The median is the distance to the corner's edges instead.
+    int corner = SK_DistanceFieldPad + kSize + 1;
+    const unsigned char* texel = df.get() + corner * kRowBytes + 4 * corner;
+    REPORTER_ASSERT(reporter, median(texel) > texel[3]);
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkBitmap.h"
+#include "SkCanvas.h"
+#include "SkData.h"
+#include "SkDocument.h"
+#include "SkMultiPictureDocument.h"
+#include "SkMultiPictureDocumentPriv.h"
+#include "SkStream.h"
+#include "Test.h"
+
+static const SkColor kColors[] = { SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE };
+static const int kPageCount = SK_ARRAY_COUNT(kColors);
+
+static sk_sp<SkData> make_document() {
+    SkDynamicMemoryWStream stream;
+    sk_sp<SkDocument> doc = SkMakeMultiPictureDocument(&stream);
+    for (int i = 0; i < kPageCount; ++i) {
+        doc->beginPage(10 + i, 20)->drawColor(kColors[i]);
+        doc->endPage();
+    }
+    doc->close();
+    return stream.detachAsData();
+}
+
+static void check_page(skiatest::Reporter* r, const SkDocumentPage& page, int i) {
+    REPORTER_ASSERT(r, page.fSize == SkSize::Make(10 + i, 20));
+    if (!page.fPicture) {
+        ERRORF(r, "page %d has no picture", i);
+        return;
+    }
+    SkBitmap bm;
+    bm.allocN32Pixels(1, 1);
+    SkCanvas canvas(bm);
+    canvas.drawPicture(page.fPicture);
+    REPORTER_ASSERT(r, kColors[i] == bm.getColor(0, 0));
+}
+
+// A stream that doesn't know its length, so readers can't use the index at the end of the file.
+class NoLengthStream : public SkStreamSeekable {
+public:
+    explicit NoLengthStream(sk_sp<SkData> data) : fStream(std::move(data)) {}
+
+    size_t read(void* buffer, size_t size) override { return fStream.read(buffer, size); }
+    bool isAtEnd() const override { return fStream.isAtEnd(); }
+    bool rewind() override { return fStream.rewind(); }
+    size_t getPosition() const override { return fStream.getPosition(); }
+    bool seek(size_t position) override { return fStream.seek(position); }
+    bool move(long offset) override { return fStream.move(offset); }
+
+private:
+    SkStreamSeekable* onDuplicate() const override { return nullptr; }
+    SkStreamSeekable* onFork() const override { return nullptr; }
+
+    SkMemoryStream fStream;
+};
+
+DEF_TEST(MultiPictureDocument, r) {
+    sk_sp<SkData> data = make_document();
+
+    SkMemoryStream indexed(data);
+    NoLengthStream unindexed(data);
+    for (SkStreamSeekable* stream : { (SkStreamSeekable*)&indexed,
+                                      (SkStreamSeekable*)&unindexed }) {
+        REPORTER_ASSERT(r, kPageCount == SkMultiPictureDocumentReadPageCount(stream));
+
+        SkDocumentPage pages[kPageCount];
+        REPORTER_ASSERT(r, SkMultiPictureDocumentReadPageSizes(stream, pages, kPageCount));
+        for (int i = 0; i < kPageCount; ++i) {
+            REPORTER_ASSERT(r, pages[i].fSize == SkSize::Make(10 + i, 20));
+            REPORTER_ASSERT(r, !pages[i].fPicture);
+        }
+
+        // Pages can be read one at a time, in any order.
+        for (int i = kPageCount - 1; i >= 0; --i) {
+            SkDocumentPage page;
+            REPORTER_ASSERT(r, SkMultiPictureDocumentReadPage(stream, i, &page));
+            check_page(r, page, i);
+        }
+        SkDocumentPage page;
+        REPORTER_ASSERT(r, !SkMultiPictureDocumentReadPage(stream, kPageCount, &page));
+
+        REPORTER_ASSERT(r, SkMultiPictureDocumentRead(stream, pages, kPageCount));
+        for (int i = 0; i < kPageCount; ++i) {
+            check_page(r, pages[i], i);
+        }
+    }
+
+    // A truncated file has no index, and its last page is incomplete.
+    SkMemoryStream truncated(SkData::MakeSubset(data.get(), 0, data->size() - 1));
+    REPORTER_ASSERT(r, 0 == SkMultiPictureDocumentReadPageCount(&truncated));
+}
@@ -152,6 +152,48 @@ private:
 
     typedef GrOp INHERITED;
 };
+
+/**
+ * An op that covers one pixel and counts how many ops are left to execute once they've been
+ * recorded. Ops of the same kind always merge when they're allowed to; ops of different kinds
+ * never combine.
+ */
+template <int kKind>
+class CountingOp : public GrOp {
+public:
+    DEFINE_OP_CLASS_ID
+
+    static std::unique_ptr<CountingOp> Make(GrContext* context, int x, int* executedOps) {
+        GrOpMemoryPool* pool = context->priv().opMemoryPool();
+        return pool->allocate<CountingOp>(x, executedOps);
+    }
+
+    const char* name() const override { return "CountingOp"; }
+
+private:
+    friend class ::GrOpMemoryPool;  // for ctor
+
+    CountingOp(int x, int* executedOps) : INHERITED(ClassID()), fExecutedOps(executedOps) {
+        this->setBounds(SkRect::MakeXYWH(x, 0, 1, 1), HasAABloat::kNo, IsZeroArea::kNo);
+    }
+
+    void onPrepare(GrOpFlushState*) override {}
+
+    void onExecute(GrOpFlushState*, const SkRect&) override {
+        for (const auto& op : ChainRange<CountingOp>(this)) {
+            (void)op;
+            ++*fExecutedOps;
+        }
+    }
+
+    CombineResult onCombineIfPossible(GrOp*, const GrCaps&) override {
+        return kKind == 0 ? CombineResult::kMerged : CombineResult::kCannotCombine;
+    }
+
+    int* fExecutedOps;
+
+    typedef GrOp INHERITED;
+};
 }  // namespace
 
 /**
@@ -238,3 +280,56 @@ DEF_GPUTEST(OpChainTest, reporter, /*ctxInfo*/) {
         }
     }
 }
+
+/**
+ * Ops should merge across any number of chains that don't overlap them, but never across one
+ * that does.
+ */
+DEF_GPUTEST(OpChainTest_DistantMerge, reporter, /*ctxInfo*/) {
+    auto context = GrContext::MakeMock(nullptr);
+    SkASSERT(context);
+    static constexpr int kNumBlockers = 50;
+    GrSurfaceDesc desc;
+    desc.fConfig = kRGBA_8888_GrPixelConfig;
+    desc.fWidth = kNumBlockers + 2;
+    desc.fHeight = 1;
+    desc.fFlags = kRenderTarget_GrSurfaceFlag;
+
+    const GrBackendFormat format =
+            context->priv().caps()->getBackendFormatFromColorType(kRGBA_8888_SkColorType);
+
+    auto proxy = context->priv().proxyProvider()->createProxy(
+            format, desc, kTopLeft_GrSurfaceOrigin, GrMipMapped::kNo, SkBackingFit::kExact,
+            SkBudgeted::kNo, GrInternalSurfaceFlags::kNone);
+    SkASSERT(proxy);
+    proxy->instantiate(context->priv().resourceProvider());
+
+    for (bool overlap : {false, true}) {
+        int executedOps = 0;
+        GrTokenTracker tracker;
+        GrOpFlushState flushState(context->priv().getGpu(), context->priv().resourceProvider(),
+                                  &tracker);
+        GrRenderTargetOpList opList(context->priv().resourceProvider(),
+                                    sk_ref_sp(context->priv().opMemoryPool()),
+                                    proxy->asRenderTargetProxy(), context->priv().auditTrail());
+        const GrCaps& caps = *context->priv().caps();
+
+        // Two mergeable ops with a run of ops that can't combine with anything between them.
+        // When 'overlap' is set, the last of those lands where the second one will.
+        opList.addOp(CountingOp<0>::Make(context.get(), 0, &executedOps), caps);
+        for (int i = 0; i < kNumBlockers; ++i) {
+            int x = (overlap && i == kNumBlockers - 1) ? kNumBlockers + 1 : i + 1;
+            opList.addOp(CountingOp<1>::Make(context.get(), x, &executedOps), caps);
+        }
+        opList.addOp(CountingOp<0>::Make(context.get(), kNumBlockers + 1, &executedOps), caps);
+
+        opList.makeClosed(caps);
+        opList.prepare(&flushState);
+        opList.execute(&flushState);
+        opList.endFlush();
+
+        int expected = kNumBlockers + (overlap ? 2 : 1);
+        REPORTER_ASSERT(reporter, executedOps == expected, "overlap: %d, executed %d ops",
+                        overlap, executedOps);
+    }
+}
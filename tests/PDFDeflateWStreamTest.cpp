@@ -10,6 +10,7 @@
 #ifdef SK_SUPPORT_PDF
 
 #include "SkDeflate.h"
+#include "SkExecutor.h"
 #include "SkRandom.h"
 #include "SkTo.h"
 
@@ -167,4 +168,38 @@ DEF_TEST(SkPDF_DeflateWStream, r) {
     REPORTER_ASSERT(r, !emptyDeflateWStream.writeText("FOO"));
 }
 
+DEF_TEST(SkPDF_DeflateWStream_parallel, r) {
+    // Enough for a handful of chunks, with a ragged last one.
+    const size_t size = 3 * SkDeflateWStream::kParallelChunkSize + 12345;
+    SkRandom random(654321);
+    SkAutoTMalloc<uint8_t> buffer(size);
+    for (size_t j = 0; j < size; ++j) {
+        // Compressible, so matches reach back across chunk boundaries.
+        buffer[j] = (j % 7 == 0) ? (random.nextU() & 0xff) : (uint8_t)('a' + j % 13);
+    }
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (int level : {-1, 0, 1, 9}) {
+        SkDynamicMemoryWStream dynamicMemoryWStream;
+        {
+            SkDeflateWStream deflateWStream(&dynamicMemoryWStream, level, false, executor.get());
+            size_t j = 0;
+            while (j < size) {
+                size_t writeSize = SkTMin(size - j, (size_t)random.nextRangeU(1, 100000));
+                REPORTER_ASSERT(r, deflateWStream.write(&buffer[j], writeSize));
+                j += writeSize;
+            }
+            REPORTER_ASSERT(r, deflateWStream.bytesWritten() == size);
+        }
+        std::unique_ptr<SkStreamAsset> compressed(dynamicMemoryWStream.detachAsStream());
+        std::unique_ptr<SkStreamAsset> decompressed(stream_inflate(r, compressed.get()));
+        if (!decompressed || decompressed->getLength() != size) {
+            ERRORF(r, "Parallel deflate at level %d did not round trip.", level);
+            continue;
+        }
+        sk_sp<SkData> data = SkData::MakeFromStream(decompressed.get(), size);
+        REPORTER_ASSERT(r, data && 0 == memcmp(data->data(), buffer.get(), size));
+    }
+}
+
 #endif
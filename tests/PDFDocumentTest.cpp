@@ -9,6 +9,7 @@
 #include "Resources.h"
 #include "SkCanvas.h"
 #include "SkExecutor.h"
+#include "SkGradientShader.h"
 #include "SkOSFile.h"
 #include "SkOSPath.h"
 #include "SkPDFDocument.h"
@@ -256,3 +257,100 @@ DEF_TEST(SkPDF_abort_jobs, rep) {
     doc->abort();
 }
 
+
+// Fonts are subset in parallel given an executor, but we should write out exactly the same
+// objects. (Jobs finishing in a different order can reorder them, but not change their size.)
+DEF_TEST(SkPDF_parallel_font_subsetting, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_parallel_font_subsetting, r);
+    sk_sp<SkTypeface> typefaces[] = {
+        MakeResourceAsTypeface("fonts/Roboto-Regular.ttf"),
+        MakeResourceAsTypeface("fonts/Em.ttf"),
+        MakeResourceAsTypeface("fonts/SpiderSymbol.ttf"),
+    };
+
+    auto makePDF = [&typefaces](SkExecutor* executor) {
+        SkPDF::Metadata metadata;
+        metadata.fExecutor = executor;
+        SkDynamicMemoryWStream stream;
+        auto doc = SkPDF::MakeDocument(&stream, metadata);
+        for (int page = 0; page < 3; ++page) {
+            SkCanvas* canvas = doc->beginPage(612, 792);
+            SkFont font;
+            font.setSize(24);
+            for (size_t i = 0; i < SK_ARRAY_COUNT(typefaces); ++i) {
+                font.setTypeface(typefaces[i]);
+                canvas->drawString("Hello, World! 0123456789", 36, 72 + 36 * i, font, SkPaint());
+            }
+            doc->endPage();
+        }
+        doc->close();
+        return stream.bytesWritten();
+    };
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool();
+    size_t serialSize = makePDF(nullptr);
+    REPORTER_ASSERT(r, serialSize > 0);
+    REPORTER_ASSERT(r, makePDF(executor.get()) == serialSize);
+}
+
+static int count(const SkData* data, const char* needle) {
+    size_t length = strlen(needle);
+    int n = 0;
+    for (size_t i = 0; i + length <= data->size(); ++i) {
+        n += 0 == memcmp(data->bytes() + i, needle, length);
+    }
+    return n;
+}
+
+// The same gradient drawn at different places needs a pattern for each place, but they should
+// all share one shading.
+DEF_TEST(SkPDF_shared_gradient_shading, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_shared_gradient_shading, r);
+    SkDynamicMemoryWStream stream;
+    auto doc = SkPDF::MakeDocument(&stream);
+    SkPoint pts[] = {{0, 0}, {100, 0}};
+    SkColor colors[] = {SK_ColorRED, SK_ColorBLUE};
+    SkPaint paint;
+    paint.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, 2,
+                                                 SkShader::kClamp_TileMode));
+    for (int page = 0; page < 2; ++page) {
+        SkCanvas* canvas = doc->beginPage(612, 792);
+        for (int i = 0; i < 3; ++i) {
+            canvas->drawRect(SkRect::MakeWH(100, 20), paint);
+            canvas->translate(0, 40);
+        }
+        doc->endPage();
+    }
+    doc->close();
+    sk_sp<SkData> pdf = stream.detachAsData();
+    REPORTER_ASSERT(r, count(pdf.get(), "/PatternType 2") == 3);
+    REPORTER_ASSERT(r, count(pdf.get(), "/ShadingType 2") == 1);
+}
+
+// Pages are written as they end, and fonts too if asked to, at the end of each run of pages.
+DEF_TEST(SkPDF_font_page_runs, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_font_page_runs, r);
+    sk_sp<SkTypeface> typeface = MakeResourceAsTypeface("fonts/Roboto-Regular.ttf");
+    if (!typeface) {
+        return;
+    }
+    auto makePDF = [&typeface](int fontPageRunLength) {
+        SkPDF::Metadata metadata;
+        metadata.fFontPageRunLength = fontPageRunLength;
+        SkDynamicMemoryWStream stream;
+        auto doc = SkPDF::MakeDocument(&stream, metadata);
+        SkFont font(typeface, 24);
+        for (int page = 0; page < 20; ++page) {
+            doc->beginPage(612, 792)->drawString("Hello, World!", 36, 72, font, SkPaint());
+            doc->endPage();
+        }
+        doc->close();
+        return stream.detachAsData();
+    };
+    sk_sp<SkData> pdf = makePDF(0);
+    REPORTER_ASSERT(r, count(pdf.get(), "/FontFile2") == 1);
+    REPORTER_ASSERT(r, count(pdf.get(), "/Type /Page\n") == 20);
+
+    pdf = makePDF(8);
+    REPORTER_ASSERT(r, count(pdf.get(), "/FontFile2") == 3);
+}
@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "SkBitmap.h"
 #include "SkCanvas.h"
 #include "SkData.h"
 #include "SkImageGenerator.h"
@@ -79,6 +80,48 @@ DEF_TEST(SkPDF_JpegEmbedTest, r) {
     REPORTER_ASSERT(r, !is_subset_of(cmykData.get(), pdfData.get()));
 }
 
+static int count_images(const SkData* pdf) {
+    static const char kImage[] = "/Subtype /Image";
+    const size_t length = sizeof(kImage) - 1;
+    int count = 0;
+    for (size_t i = 0; i + length <= pdf->size(); ++i) {
+        count += 0 == memcmp(pdf->bytes() + i, kImage, length);
+    }
+    return count;
+}
+
+/**
+ *  Test that separately made images with the same contents (the same file decoded twice, or
+ *  equal pixels) are embedded once.
+ */
+DEF_TEST(SkPDF_ImageContentDedup, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_ImageContentDedup, r);
+    sk_sp<SkData> mandrillData(load_resource(r, "SkPDF_ImageContentDedup",
+                                             "images/mandrill_512_q075.jpg"));
+    if (!mandrillData) {
+        return;
+    }
+    SkBitmap bm1, bm2;
+    bm1.allocN32Pixels(16, 16);
+    bm1.eraseColor(SK_ColorRED);
+    bm2.allocN32Pixels(16, 16);
+    bm2.eraseColor(SK_ColorRED);
+
+    SkDynamicMemoryWStream pdf;
+    auto document = SkPDF::MakeDocument(&pdf);
+    SkCanvas* canvas = document->beginPage(1100, 600);
+    canvas->drawImage(SkImage::MakeFromEncoded(mandrillData), 0, 0);
+    canvas->drawImage(SkImage::MakeFromEncoded(SkData::MakeWithCopy(mandrillData->data(),
+                                                                    mandrillData->size())),
+                      550, 0);
+    canvas->drawImage(SkImage::MakeFromBitmap(bm1), 0, 550);
+    canvas->drawImage(SkImage::MakeFromBitmap(bm2), 550, 550);
+    document->endPage();
+    document->close();
+    sk_sp<SkData> pdfData = pdf.detachAsData();
+    REPORTER_ASSERT(r, count_images(pdfData.get()) == 2, "%d", count_images(pdfData.get()));
+}
+
 #ifdef SK_SUPPORT_PDF
 
 #include "SkJpegInfo.h"
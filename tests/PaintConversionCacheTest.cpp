@@ -0,0 +1,82 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Test.h"
+
+#include "GrColorSpaceInfo.h"
+#include "GrContext.h"
+#include "GrPaint.h"
+#include "SkGr.h"
+#include "SkGradientShader.h"
+#include "SkPaint.h"
+
+static bool same_processors(const GrPaint& a, const GrPaint& b) {
+    if (a.numColorFragmentProcessors() != b.numColorFragmentProcessors() ||
+        a.numCoverageFragmentProcessors() != b.numCoverageFragmentProcessors() ||
+        a.getXPFactory() != b.getXPFactory() || a.getColor4f() != b.getColor4f()) {
+        return false;
+    }
+    for (int i = 0; i < a.numColorFragmentProcessors(); ++i) {
+        if (!a.getColorFragmentProcessor(i)->isEqual(*b.getColorFragmentProcessor(i))) {
+            return false;
+        }
+    }
+    for (int i = 0; i < a.numCoverageFragmentProcessors(); ++i) {
+        if (!a.getCoverageFragmentProcessor(i)->isEqual(*b.getCoverageFragmentProcessor(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(PaintConversionCache, reporter, ctxInfo) {
+    GrContext* context = ctxInfo.grContext();
+    const GrColorSpaceInfo colorSpaceInfo(nullptr, kRGBA_8888_GrPixelConfig);
+
+    static constexpr SkPoint kPts[] = { { 0, 0 }, { 100, 100 } };
+    static constexpr SkColor kColors[] = { SK_ColorRED, SK_ColorBLUE };
+    SkPaint paint;
+    paint.setAlpha(0x80);
+    paint.setBlendMode(SkBlendMode::kMultiply);
+    paint.setShader(SkGradientShader::MakeLinear(kPts, kColors, nullptr, 2,
+                                                 SkShader::kClamp_TileMode));
+    const SkMatrix viewM = SkMatrix::MakeScale(2);
+
+    // The first conversion is only keyed, the second cached and the rest copied from the cache.
+    // They should all come out the same.
+    GrPaint first;
+    REPORTER_ASSERT(reporter, SkPaintToGrPaint(context, colorSpaceInfo, paint, viewM, &first));
+    REPORTER_ASSERT(reporter, first.numColorFragmentProcessors() > 0);
+    for (int i = 0; i < 3; ++i) {
+        GrPaint grPaint;
+        REPORTER_ASSERT(reporter, SkPaintToGrPaint(context, colorSpaceInfo, paint, viewM,
+                                                   &grPaint));
+        REPORTER_ASSERT(reporter, same_processors(first, grPaint));
+    }
+
+    // Changing anything the conversion depends on has to miss.
+    SkPaint opaquePaint(paint);
+    opaquePaint.setAlpha(0xFF);
+    GrPaint expected, actual;
+    REPORTER_ASSERT(reporter, SkPaintToGrPaint(context, colorSpaceInfo, opaquePaint, viewM,
+                                               &expected));
+    REPORTER_ASSERT(reporter, SkPaintToGrPaint(context, colorSpaceInfo, opaquePaint, viewM,
+                                               &actual));
+    REPORTER_ASSERT(reporter, same_processors(expected, actual));
+    REPORTER_ASSERT(reporter, !same_processors(first, actual));
+
+    GrPaint withXfermode;
+    REPORTER_ASSERT(reporter, SkPaintToGrPaintWithXfermode(context, colorSpaceInfo, paint, viewM,
+                                                           SkBlendMode::kModulate,
+                                                           &withXfermode));
+    REPORTER_ASSERT(reporter, !same_processors(first, withXfermode));
+
+    context->freeGpuResources();
+    GrPaint afterFree;
+    REPORTER_ASSERT(reporter, SkPaintToGrPaint(context, colorSpaceInfo, paint, viewM, &afterFree));
+    REPORTER_ASSERT(reporter, same_processors(first, afterFree));
+}
@@ -73,8 +73,49 @@ DEF_TEST(ParsePath_invalid, r) {
 }
 
 #include "random_parse_path.h"
+#include "SkFloatBits.h"
+#include "SkParse.h"
 #include "SkRandom.h"
 
+#include <stdlib.h>
+
+DEF_TEST(ParseScalar, r) {
+    static const struct {
+        const char* fStr;
+        int         fLength;  // -1 if it shouldn't parse
+    } gTests[] = {
+        { "1", 1 }, { " -1.5,", 5 }, { "+.5", 3 }, { "5.", 2 }, { "00012", 5 },
+        { "1e5", 3 }, { "7E-2", 4 }, { "1e", 1 }, { "1e+", 1 }, { "1.2.3", 3 },
+        { "3.4028235e38", 12 }, { "1e39", 4 }, { "1e-46", 5 }, { "9.37088e-26", 11 },
+        { "0.0000000000000000000000000001234", 33 },
+        { "123456789012345678901234567890", 30 },
+        { ".", -1 }, { "-", -1 }, { "e5", -1 }, { "", -1 },
+    };
+    for (const auto& test : gTests) {
+        SkScalar value;
+        const char* stop = SkParse::FindScalar(test.fStr, &value);
+        if (test.fLength < 0) {
+            REPORTER_ASSERT(r, !stop, "%s", test.fStr);
+            continue;
+        }
+        REPORTER_ASSERT(r, stop && stop - test.fStr == test.fLength, "%s", test.fStr);
+        REPORTER_ASSERT(r, value == (float)strtod(test.fStr, nullptr), "%s", test.fStr);
+    }
+
+    // Whatever ToSVGString() writes reads back exactly.
+    SkRandom rand;
+    for (int i = 0; i < 1000; ++i) {
+        SkScalar x = SkBits2Float(rand.nextU());
+        if (!SkScalarIsFinite(x)) {
+            continue;
+        }
+        SkString str;
+        str.printf("%.9g", x);
+        SkScalar y;
+        REPORTER_ASSERT(r, SkParse::FindScalar(str.c_str(), &y) && x == y, "%s", str.c_str());
+    }
+}
+
 DEF_TEST(ParsePathRandom, r) {
     SkRandom rand;
     for (int index = 0; index < 1000; ++index) {
@@ -0,0 +1,133 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Test.h"
+
+#include "GrContext.h"
+#include "SkBitmap.h"
+#include "SkCanvas.h"
+#include "SkPatchUtils.h"
+#include "SkSurface.h"
+
+static constexpr SkPoint kCubics[SkPatchUtils::kNumCtrlPts] = {
+    // top
+    {8, 8}, {20, 2}, {40, 14}, {56, 8},
+    // right
+    {62, 20}, {50, 40},
+    // bottom
+    {56, 56}, {40, 50}, {20, 62}, {8, 56},
+    // left
+    {14, 40}, {2, 20},
+};
+
+static constexpr SkColor kColors[SkPatchUtils::kNumCorners] = {
+    SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE, SK_ColorYELLOW
+};
+
+DEF_TEST(PatchUtils_BucketedLevelOfDetail, reporter) {
+    SkISize prev = {0, 0};
+    for (SkScalar scale = 0.25f; scale < 40; scale *= 1.1f) {
+        SkMatrix m = SkMatrix::MakeScale(scale);
+        SkISize lod = SkPatchUtils::GetLevelOfDetail(kCubics, &m);
+        SkISize bucketed = SkPatchUtils::GetBucketedLevelOfDetail(kCubics, &m);
+
+        // Never coarser than asked for, and at most a quarter finer, until the limits kick in.
+        if (lod.width() <= 64 && lod.height() <= 64) {
+            REPORTER_ASSERT(reporter, bucketed.width() >= lod.width());
+            REPORTER_ASSERT(reporter, bucketed.height() >= lod.height());
+            REPORTER_ASSERT(reporter, bucketed.width() * 4 <= lod.width() * 5);
+            REPORTER_ASSERT(reporter, bucketed.height() * 4 <= lod.height() * 5);
+        }
+        REPORTER_ASSERT(reporter, bucketed.width() * bucketed.height() * 6 <= 60000);
+
+        // Growing the scale never makes the patch coarser.
+        REPORTER_ASSERT(reporter, bucketed.width() >= prev.width() ||
+                                  bucketed.height() >= prev.height());
+        prev = bucketed;
+    }
+
+    SkMatrix nan = SkMatrix::MakeScale(SK_ScalarNaN);
+    REPORTER_ASSERT(reporter, SkPatchUtils::GetBucketedLevelOfDetail(kCubics, &nan).isEmpty());
+}
+
+DEF_TEST(PatchUtils_CachedVertices, reporter) {
+    const SkMatrix m = SkMatrix::MakeScale(3);
+    SkISize lod = SkPatchUtils::GetBucketedLevelOfDetail(kCubics, &m);
+    sk_sp<SkVertices> expected = SkPatchUtils::MakeVertices(kCubics, kColors, nullptr,
+                                                            lod.width(), lod.height());
+
+    // Cached or not, the vertices should be the ones MakeVertices() makes.
+    for (int i = 0; i < 2; ++i) {
+        auto vertices = SkPatchUtils::MakeCachedVertices(kCubics, kColors, nullptr, m);
+        REPORTER_ASSERT(reporter, vertices);
+        if (!vertices) {
+            return;
+        }
+        REPORTER_ASSERT(reporter, vertices->vertexCount() == expected->vertexCount());
+        REPORTER_ASSERT(reporter, vertices->indexCount() == expected->indexCount());
+        REPORTER_ASSERT(reporter, !vertices->hasTexCoords());
+        REPORTER_ASSERT(reporter, 0 == memcmp(vertices->positions(), expected->positions(),
+                                              expected->vertexCount() * sizeof(SkPoint)));
+        REPORTER_ASSERT(reporter, 0 == memcmp(vertices->colors(), expected->colors(),
+                                              expected->vertexCount() * sizeof(SkColor)));
+    }
+
+    // Different corner colors must not hit the same entry.
+    const SkColor otherColors[SkPatchUtils::kNumCorners] = {
+        SK_ColorBLACK, SK_ColorBLACK, SK_ColorBLACK, SK_ColorBLACK
+    };
+    auto other = SkPatchUtils::MakeCachedVertices(kCubics, otherColors, nullptr, m);
+    REPORTER_ASSERT(reporter, other && other->colors()[0] == SK_ColorBLACK);
+}
+
+// The GPU evaluates patches in the vertex shader; compare that with drawing the CPU tessellation.
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(PatchOp, reporter, ctxInfo) {
+    GrContext* context = ctxInfo.grContext();
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(64, 64);
+    auto patchSurface = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, info);
+    auto verticesSurface = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, info);
+    if (!patchSurface || !verticesSurface) {
+        return;
+    }
+
+    SkISize lod = SkPatchUtils::GetBucketedLevelOfDetail(kCubics, &SkMatrix::I());
+    sk_sp<SkVertices> vertices = SkPatchUtils::MakeVertices(kCubics, kColors, nullptr,
+                                                            lod.width(), lod.height());
+    SkPaint paint;
+    patchSurface->getCanvas()->clear(SK_ColorWHITE);
+    patchSurface->getCanvas()->drawPatch(kCubics, kColors, nullptr, SkBlendMode::kModulate,
+                                         paint);
+    verticesSurface->getCanvas()->clear(SK_ColorWHITE);
+    verticesSurface->getCanvas()->drawVertices(vertices, SkBlendMode::kModulate, paint);
+
+    SkBitmap patchBitmap, verticesBitmap;
+    patchBitmap.allocPixels(info);
+    verticesBitmap.allocPixels(info);
+    if (!patchSurface->readPixels(patchBitmap, 0, 0) ||
+        !verticesSurface->readPixels(verticesBitmap, 0, 0)) {
+        ERRORF(reporter, "Could not read back patches.");
+        return;
+    }
+
+    // Allow for rounding differences in the colors, and for the odd pixel along the edges falling
+    // on the other side of a slightly different triangle.
+    int mismatches = 0;
+    for (int y = 0; y < info.height(); ++y) {
+        for (int x = 0; x < info.width(); ++x) {
+            SkColor a = patchBitmap.getColor(x, y), b = verticesBitmap.getColor(x, y);
+            int diff = SkTMax(SkTMax(SkAbs32(SkColorGetR(a) - SkColorGetR(b)),
+                                     SkAbs32(SkColorGetG(a) - SkColorGetG(b))),
+                              SkTMax(SkAbs32(SkColorGetB(a) - SkColorGetB(b)),
+                                     SkAbs32(SkColorGetA(a) - SkColorGetA(b))));
+            if (diff > 3) {
+                ++mismatches;
+            }
+        }
+    }
+    REPORTER_ASSERT(reporter, mismatches <= info.width() * info.height() / 100,
+                    "%d mismatched pixels", mismatches);
+}
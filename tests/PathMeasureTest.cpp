@@ -306,3 +306,49 @@ DEF_TEST(contour_measure, reporter) {
     test_empty_contours(reporter);
     test_MLM_contours(reporter);
 }
+
+#include "SkContourMeasureCache.h"
+
+// Walking all of a non-volatile path's contours caches them, and later iterators over the same
+// path replay the same measures until the path changes.
+DEF_TEST(contour_measure_cache, reporter) {
+    SkPath path;
+    path.addCircle(0, 0, 100);
+    path.moveTo(0, 0).cubicTo(10, 40, 60, -20, 100, 30);
+
+    SkContourMeasureCache::Measures cached;
+    REPORTER_ASSERT(reporter, !SkContourMeasureCache::Find(path, false, 2, &cached));
+
+    SkTArray<sk_sp<SkContourMeasure>> built;
+    SkContourMeasureIter iter(path, false, 2);
+    while (auto cm = iter.next()) {
+        built.push_back(std::move(cm));
+    }
+    REPORTER_ASSERT(reporter, built.count() == 2);
+    REPORTER_ASSERT(reporter, SkContourMeasureCache::Find(path, false, 2, &cached));
+    REPORTER_ASSERT(reporter, cached.count() == 2);
+    REPORTER_ASSERT(reporter, !SkContourMeasureCache::Find(path, true, 2, &cached));
+    REPORTER_ASSERT(reporter, !SkContourMeasureCache::Find(path, false, 1, &cached));
+
+    SkContourMeasureIter replay(path, false, 2);
+    for (int i = 0; i < built.count(); ++i) {
+        auto cm = replay.next();
+        REPORTER_ASSERT(reporter, cm.get() == built[i].get());
+    }
+    REPORTER_ASSERT(reporter, !replay.next());
+
+    path.lineTo(200, 30);
+    REPORTER_ASSERT(reporter, !SkContourMeasureCache::Find(path, false, 2, &cached));
+    SkContourMeasureIter changed(path, false, 2);
+    changed.next();
+    auto cm = changed.next();
+    REPORTER_ASSERT(reporter, cm && cm.get() != built[1].get());
+    REPORTER_ASSERT(reporter, cm && cm->length() > built[1]->length() + 99);
+
+    path.setIsVolatile(true);
+    SkContourMeasureIter volatileIter(path, false, 2);
+    while (volatileIter.next()) {}
+    SkPath nonVolatile(path);
+    nonVolatile.setIsVolatile(false);
+    REPORTER_ASSERT(reporter, !SkContourMeasureCache::Find(nonVolatile, false, 2, &cached));
+}
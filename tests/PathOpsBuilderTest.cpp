@@ -8,6 +8,7 @@
 #include "PathOpsExtendedTest.h"
 #include "PathOpsTestCommon.h"
 #include "SkBitmap.h"
+#include "SkExecutor.h"
 #include "Test.h"
 
 DEF_TEST(PathOpsBuilder, reporter) {
@@ -361,3 +362,34 @@ SkOpBuilder builder;
     builder.add(path1, SkPathOp::kUnion_SkPathOp);
     builder.resolve(&path);
 }
+
+DEF_TEST(SkOpBuilderIslands, reporter) {
+    // Three clusters of overlapping shapes, each of which has to be unioned on its own.
+    SkPath paths[9];
+    for (int island = 0; island < 3; ++island) {
+        SkScalar x = 40 * island, y = 30 * island;
+        paths[3 * island + 0].addCircle(x + 10, y + 10, 8);
+        paths[3 * island + 1].addRect(x + 12, y + 4, x + 26, y + 14);
+        paths[3 * island + 2].moveTo(x + 4, y + 6);
+        paths[3 * island + 2].lineTo(x + 30, y + 20);
+        paths[3 * island + 2].lineTo(x + 8, y + 24);
+        paths[3 * island + 2].close();
+    }
+
+    SkPath opCompare;
+    for (const SkPath& path : paths) {
+        REPORTER_ASSERT(reporter, Op(opCompare, path, kUnion_SkPathOp, &opCompare));
+    }
+
+    auto executor = SkExecutor::MakeFIFOThreadPool(2);
+    for (SkExecutor* exec : {(SkExecutor*)nullptr, executor.get()}) {
+        SkOpBuilder builder;
+        for (const SkPath& path : paths) {
+            builder.add(path, kUnion_SkPathOp);
+        }
+        SkPath result;
+        REPORTER_ASSERT(reporter, builder.resolve(&result, exec));
+        int pixelDiff = comparePaths(reporter, __FUNCTION__, opCompare, result);
+        REPORTER_ASSERT(reporter, pixelDiff == 0);
+    }
+}
@@ -5449,3 +5449,42 @@ DEF_TEST(path_last_move_to_index, r) {
 
     copyPath.rConicTo(1, 1, 3, 3, 0.707107f);
 }
+
+DEF_TEST(Path_GenIDChangeListener, r) {
+    class Listener final : public SkPathRef::GenIDChangeListener {
+    public:
+        explicit Listener(int* changes) : fChanges(changes) {}
+        void onChange() override { ++*fChanges; }
+
+    private:
+        int* fChanges;
+    };
+
+    int changes = 0;
+    {
+        SkPath path;
+        path.moveTo(0, 0).lineTo(10, 10);
+
+        // Editing the path notifies its listeners once.
+        SkPathPriv::AddGenIDChangeListener(path, sk_make_sp<Listener>(&changes));
+        path.lineTo(20, 0);
+        REPORTER_ASSERT(r, changes == 1);
+        path.lineTo(30, 10);
+        REPORTER_ASSERT(r, changes == 1);
+
+        // Unregistered listeners aren't notified.
+        auto listener = sk_make_sp<Listener>(&changes);
+        SkPathPriv::AddGenIDChangeListener(path, listener);
+        listener->markShouldUnregisterFromPath();
+        path.lineTo(40, 0);
+        REPORTER_ASSERT(r, changes == 1);
+
+        // Neither are listeners of the shared empty path.
+        SkPath empty;
+        SkPathPriv::AddGenIDChangeListener(empty, sk_make_sp<Listener>(&changes));
+
+        SkPathPriv::AddGenIDChangeListener(path, sk_make_sp<Listener>(&changes));
+    }
+    // Deleting the path notifies its listeners.
+    REPORTER_ASSERT(r, changes == 2);
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Resources.h"
+#include "SkFont.h"
+#include "SkGlyph.h"
+#include "SkOSPath.h"
+#include "SkPersistentStrikeStore.h"
+#include "SkScalerContext.h"
+#include "SkStream.h"
+#include "SkStrikeCache.h"
+#include "SkTypeface.h"
+#include "Test.h"
+
+#include <vector>
+
+DEF_TEST(PersistentStrikeStore_roundTrip, reporter) {
+    SkString tmpDir = skiatest::GetTmpDir();
+    if (tmpDir.isEmpty()) {
+        return;
+    }
+    SkString path = SkOSPath::Join(tmpDir.c_str(), "persistent_strikes");
+
+    auto typeface = MakeResourceAsTypeface("fonts/Em.ttf");
+    if (!typeface) {
+        return;
+    }
+    SkFont font;
+    font.setTypeface(typeface);
+    font.setSize(36);
+    font.setEdging(SkFont::Edging::kAntiAlias);
+
+    SkAutoDescriptor ad;
+    SkScalerContextEffects effects;
+    const SkDescriptor* desc = SkScalerContext::CreateDescriptorAndEffectsUsingPaint(
+            font, SkPaint(), SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+            SkScalerContextFlags::kNone, SkMatrix::I(), &ad, &effects);
+
+    const SkGlyphID glyphIDs[] = { font.unicharToGlyph('E'), font.unicharToGlyph('m') };
+    std::vector<uint8_t> images[SK_ARRAY_COUNT(glyphIDs)];
+
+    {
+        SkStrikeCache cache;
+        {
+            auto strike = cache.findOrCreateStrikeExclusive(*desc, effects, *typeface);
+            for (size_t i = 0; i < SK_ARRAY_COUNT(glyphIDs); i++) {
+                const SkGlyph& glyph = strike->getGlyphIDMetrics(glyphIDs[i]);
+                auto image = static_cast<const uint8_t*>(strike->findImage(glyph));
+                if (image) {
+                    images[i].assign(image, image + glyph.computeImageSize());
+                }
+                (void)strike->findPath(glyph);
+            }
+        }
+        REPORTER_ASSERT(reporter, cache.savePersistentStore(path.c_str()));
+    }
+
+    sk_sp<SkPersistentStrikeStore> store = SkPersistentStrikeStore::Make(path.c_str());
+    REPORTER_ASSERT(reporter, store);
+    if (!store) {
+        return;
+    }
+    REPORTER_ASSERT(reporter, store->strikeCount() == 1);
+
+    SkStrikeCache cache;
+    cache.setPersistentStore(store);
+    auto strike = cache.findOrCreateStrikeExclusive(*desc, effects, *typeface);
+
+    // The glyphs should already be there, before anyone asks the scaler for them.
+    REPORTER_ASSERT(reporter, strike->countCachedGlyphs() == (int)SK_ARRAY_COUNT(glyphIDs));
+    for (size_t i = 0; i < SK_ARRAY_COUNT(glyphIDs); i++) {
+        const SkGlyph& glyph = strike->getGlyphIDMetrics(glyphIDs[i]);
+        REPORTER_ASSERT(reporter, glyph.computeImageSize() == images[i].size());
+        if (!images[i].empty()) {
+            REPORTER_ASSERT(reporter, glyph.fImage != nullptr);
+            REPORTER_ASSERT(reporter,
+                            0 == memcmp(glyph.fImage, images[i].data(), images[i].size()));
+        }
+        REPORTER_ASSERT(reporter, glyph.fPathData != nullptr);
+    }
+
+    // A file that isn't a store is rejected rather than half-read.
+    SkString junkPath = SkOSPath::Join(tmpDir.c_str(), "persistent_strikes_junk");
+    {
+        SkFILEWStream junk(junkPath.c_str());
+        junk.write("not a strike store", 18);
+    }
+    REPORTER_ASSERT(reporter, !SkPersistentStrikeStore::Make(junkPath.c_str()));
+}
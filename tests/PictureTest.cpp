@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "SkAutoMalloc.h"
 #include "SkBBHFactory.h"
 #include "SkBBoxHierarchy.h"
 #include "SkBigPicture.h"
@@ -14,15 +15,21 @@
 #include "SkClipOpPriv.h"
 #include "SkColor.h"
 #include "SkData.h"
+#include "SkDrawable.h"
+#include "SkExecutor.h"
+#include "SkFont.h"
 #include "SkFontStyle.h"
+#include "SkImage.h"
 #include "SkImageInfo.h"
 #include "SkMatrix.h"
 #include "SkMiniRecorder.h"
+#include "SkNoDrawCanvas.h"
 #include "SkPaint.h"
 #include "SkPath.h"
 #include "SkPicturePriv.h"
 #include "SkPictureRecorder.h"
 #include "SkPixelRef.h"
+#include "SkRRect.h"
 #include "SkRandom.h"
 #include "SkRect.h"
 #include "SkRectPriv.h"
@@ -31,6 +38,7 @@
 #include "SkShader.h"
 #include "SkStream.h"
 #include "SkTypeface.h"
+#include "SkThreadedPicturePlayback.h"
 #include "SkTypes.h"
 #include "Test.h"
 
@@ -768,6 +776,38 @@ DEF_TEST(MiniRecorderLeftHanging, r) {
     // Don't call rec.detachPicture().  Test succeeds by not asserting or leaking the shader.
 }
 
+DEF_TEST(MiniRecorder_SingleOps, r) {
+    SkBitmap bm;
+    bm.allocN32Pixels(10, 20);
+    bm.eraseColor(SK_ColorBLUE);
+    sk_sp<SkImage> image = SkImage::MakeFromBitmap(bm);
+
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    const SkRect oval = SkRect::MakeLTRB(5, 5, 25, 15);
+    const SkRRect rrect = SkRRect::MakeRectXY(SkRect::MakeLTRB(0, 0, 30, 30), 4, 4);
+
+    SkPictureRecorder recorder;
+    auto check = [&](const SkRect& cull) {
+        sk_sp<SkPicture> pic = recorder.finishRecordingAsPicture();
+        REPORTER_ASSERT(r, !SkPicturePriv::AsSkBigPicture(pic));
+        REPORTER_ASSERT(r, 1 == pic->approximateOpCount());
+        REPORTER_ASSERT(r, pic->cullRect() == cull);
+    };
+
+    SkRTreeFactory factory;
+    recorder.beginRecording(SkRectPriv::MakeLargest(), &factory)->drawOval(oval, paint);
+    check(oval);
+    recorder.beginRecording(SkRectPriv::MakeLargest(), &factory)->drawRRect(rrect, paint);
+    check(rrect.rect());
+    recorder.beginRecording(SkRectPriv::MakeLargest(), &factory)->drawImage(image, 3, 4);
+    check(SkRect::MakeXYWH(3, 4, 10, 20));
+
+    // Image draws with a paint still record into an SkBigPicture.
+    recorder.beginRecording(100, 100)->drawImage(image, 3, 4, &paint);
+    REPORTER_ASSERT(r, SkPicturePriv::AsSkBigPicture(recorder.finishRecordingAsPicture()));
+}
+
 DEF_TEST(Picture_preserveCullRect, r) {
     SkPictureRecorder recorder;
 
@@ -879,3 +919,228 @@ DEF_TEST(Picture_empty_serial, reporter) {
     REPORTER_ASSERT(reporter, pic2);
 }
 
+static sk_sp<SkPicture> make_shared_data_picture() {
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(16, 16);
+    bitmap.eraseColor(SK_ColorBLUE);
+    bitmap.eraseArea(SkIRect::MakeWH(8, 8), SK_ColorRED);
+    sk_sp<SkImage> image = SkImage::MakeFromEncoded(SkImage::MakeFromBitmap(bitmap)->encodeToData());
+
+    SkPictureRecorder nestedRecorder;
+    SkCanvas* nestedCanvas = nestedRecorder.beginRecording(50, 50);
+    nestedCanvas->drawCircle(25, 25, 20, SkPaint());
+    nestedCanvas->drawLine(0, 0, 50, 50, SkPaint());
+    sk_sp<SkPicture> nested = nestedRecorder.finishRecordingAsPicture();
+
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(100, 100);
+    SkPaint paint;
+    paint.setColor(SK_ColorGREEN);
+    paint.setAntiAlias(true);
+    canvas->drawRect(SkRect::MakeXYWH(10, 10, 30, 20), paint);
+    canvas->drawImage(image, 50, 10);
+    canvas->save();
+    canvas->translate(40, 40);
+    canvas->drawPicture(nested);
+    canvas->restore();
+    canvas->drawString("Q", 10, 90, SkFont(), paint);
+    return recorder.finishRecordingAsPicture();
+}
+
+static void draw_to_bitmap(const SkPicture* picture, SkBitmap* bitmap) {
+    bitmap->allocN32Pixels(100, 100);
+    bitmap->eraseColor(SK_ColorWHITE);
+    SkCanvas canvas(*bitmap);
+    canvas.drawPicture(picture);
+}
+
+static bool bitmaps_equal(const SkBitmap& a, const SkBitmap& b) {
+    for (int y = 0; y < a.height(); ++y) {
+        if (0 != memcmp(a.getAddr32(0, y), b.getAddr32(0, y), a.width() * 4)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+DEF_TEST(Picture_sharedData, r) {
+    sk_sp<SkData> data = make_shared_data_picture()->serialize();
+    SkBitmap expected;
+    draw_to_bitmap(SkPicture::MakeFromData(data.get()).get(), &expected);
+
+    // Also read the data from an unaligned address, which has to copy rather than share it.
+    SkAutoMalloc storage(data->size() + 1);
+    memcpy(SkTAddOffset<void>(storage.get(), 1), data->data(), data->size());
+    sk_sp<SkData> unaligned = SkData::MakeWithoutCopy(SkTAddOffset<void>(storage.get(), 1),
+                                                      data->size());
+
+    for (const sk_sp<SkData>& source : { data, unaligned }) {
+        sk_sp<SkPicture> picture = SkPicture::MakeFromSharedData(source);
+        REPORTER_ASSERT(r, picture);
+        if (!picture) {
+            continue;
+        }
+        REPORTER_ASSERT(r, picture->cullRect() == SkRect::MakeWH(100, 100));
+        REPORTER_ASSERT(r, picture->approximateOpCount() > 0);
+
+        SkBitmap actual;
+        draw_to_bitmap(picture.get(), &actual);
+        REPORTER_ASSERT(r, bitmaps_equal(expected, actual));
+
+        // It survives serializing again, too.
+        draw_to_bitmap(SkPicture::MakeFromData(picture->serialize().get()).get(), &actual);
+        REPORTER_ASSERT(r, bitmaps_equal(expected, actual));
+    }
+    REPORTER_ASSERT(r, !SkPicture::MakeFromSharedData(nullptr));
+}
+
+DEF_TEST(Picture_sharedDataPartialPlayback, r) {
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(400, 400);
+    SkPaint paint;
+    for (int y = 0; y < 10; ++y) {
+        for (int x = 0; x < 10; ++x) {
+            canvas->save();
+            canvas->translate(x * 40, y * 40);
+            canvas->clipRect(SkRect::MakeWH(35, 35));
+            paint.setColor(SkColorSetRGB(x * 25, y * 25, 128));
+            canvas->drawRect(SkRect::MakeLTRB(5, 5, 30, 30), paint);
+            canvas->restore();
+        }
+    }
+    sk_sp<SkData> data = recorder.finishRecordingAsPicture()->serialize();
+    sk_sp<SkPicture> shared = SkPicture::MakeFromSharedData(data);
+    sk_sp<SkPicture> full = SkPicture::MakeFromData(data.get());
+    REPORTER_ASSERT(r, shared && full);
+
+    // Tiles draw just like they do from the fully deserialized picture...
+    const SkIPoint tiles[] = { {0, 0}, {150, 70}, {370, 370}, {500, 0} };
+    for (SkIPoint tile : tiles) {
+        SkBitmap expected, actual;
+        for (SkBitmap* bitmap : { &expected, &actual }) {
+            bitmap->allocN32Pixels(64, 64);
+            bitmap->eraseColor(SK_ColorWHITE);
+            SkCanvas tileCanvas(*bitmap);
+            tileCanvas.translate(-tile.x(), -tile.y());
+            tileCanvas.drawPicture(bitmap == &expected ? full : shared);
+            REPORTER_ASSERT(r, 1 == tileCanvas.getSaveCount());
+        }
+        REPORTER_ASSERT(r, bitmaps_equal(expected, actual));
+    }
+
+    // ...but only play back the ops that draw into them.
+    class RectCounter : public SkNoDrawCanvas {
+    public:
+        RectCounter() : SkNoDrawCanvas(400, 400) {}
+        int fRects = 0;
+
+    protected:
+        void onDrawRect(const SkRect&, const SkPaint&) override { fRects++; }
+    } counter;
+    counter.clipRect(SkRect::MakeXYWH(50, 50, 20, 20));
+    shared->playback(&counter);
+    REPORTER_ASSERT(r, 1 == counter.fRects);
+    REPORTER_ASSERT(r, 1 == counter.getSaveCount());
+}
+
+
+DEF_TEST(Picture_threadedPlayback, r) {
+    SkRTreeFactory factory;
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(300, 300, &factory);
+        SkRandom rand;
+        for (int i = 0; i < 200; i++) {
+            SkPaint paint;
+            paint.setColor(rand.nextU());
+            paint.setAntiAlias(rand.nextBool());
+            SkRect rect = SkRect::MakeXYWH(rand.nextRangeScalar(0, 300),
+                                           rand.nextRangeScalar(0, 300),
+                                           rand.nextRangeScalar(0,  60),
+                                           rand.nextRangeScalar(0,  60));
+            if (i % 2) {
+                canvas->drawOval(rect, paint);
+            } else {
+                canvas->drawRect(rect, paint);
+            }
+        }
+    sk_sp<SkPicture> pic = recorder.finishRecordingAsPicture();
+
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(300, 300);
+    SkBitmap serial, threaded;
+    serial.allocPixels(info);
+    threaded.allocPixels(info);
+    serial.eraseColor(SK_ColorWHITE);
+    threaded.eraseColor(SK_ColorWHITE);
+
+    // Use a tile size that doesn't divide the canvas evenly.
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    {
+        SkCanvas serialCanvas(serial), threadedCanvas(threaded);
+        serialCanvas.translate(7, 3);
+        threadedCanvas.translate(7, 3);
+        pic->playback(&serialCanvas);
+        SkThreadedPicturePlayback(pic.get(), &threadedCanvas, executor.get(), 64, 48);
+    }
+
+    for (int y = 0; y < info.height(); y++) {
+        if (0 != memcmp(serial.getAddr32(0, y), threaded.getAddr32(0, y), info.minRowBytes())) {
+            ERRORF(r, "row %d differs between serial and threaded playback", y);
+            break;
+        }
+    }
+}
+
+namespace {
+class CountingDrawable : public SkDrawable {
+public:
+    explicit CountingDrawable(bool cachesSnapshots) { this->setCachesSnapshots(cachesSnapshots); }
+
+    void setColor(SkColor color) {
+        fColor = color;
+        this->notifyDrawingChanged();
+    }
+
+    int fDraws = 0;
+
+protected:
+    SkRect onGetBounds() override { return SkRect::MakeWH(10, 10); }
+    void onDraw(SkCanvas* canvas) override {
+        fDraws++;
+        SkPaint paint;
+        paint.setColor(fColor);
+        canvas->drawRect(SkRect::MakeWH(10, 10), paint);
+    }
+
+private:
+    SkColor fColor = SK_ColorRED;
+};
+}  // namespace
+
+DEF_TEST(Drawable_cachedSnapshots, r) {
+    SkBitmap bm;
+    bm.allocN32Pixels(10, 10);
+    SkCanvas canvas(bm);
+
+    sk_sp<CountingDrawable> cached = sk_make_sp<CountingDrawable>(true);
+    sk_sp<SkPicture> first(cached->newPictureSnapshot());
+    sk_sp<SkPicture> second(cached->newPictureSnapshot());
+    REPORTER_ASSERT(r, first == second);
+    cached->draw(&canvas);
+    REPORTER_ASSERT(r, 1 == cached->fDraws);
+    REPORTER_ASSERT(r, SK_ColorRED == bm.getColor(5, 5));
+
+    // Changes are seen once the drawable notifies.
+    cached->setColor(SK_ColorBLUE);
+    cached->draw(&canvas);
+    REPORTER_ASSERT(r, 2 == cached->fDraws);
+    REPORTER_ASSERT(r, SK_ColorBLUE == bm.getColor(5, 5));
+    sk_sp<SkPicture> third(cached->newPictureSnapshot());
+    REPORTER_ASSERT(r, third != first);
+
+    // By default every snapshot and draw calls onDraw().
+    sk_sp<CountingDrawable> uncached = sk_make_sp<CountingDrawable>(false);
+    sk_sp<SkPicture> a(uncached->newPictureSnapshot()),
+                     b(uncached->newPictureSnapshot());
+    uncached->draw(&canvas);
+    REPORTER_ASSERT(r, 3 == uncached->fDraws);
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkTypes.h"
+
+#include "GrContextFactory.h"
+#include "GrContextPriv.h"
+#include "GrShaderCaps.h"
+#include "gl/GrGLCaps.h"
+#include "MemoryCache.h"
+#include "SkCanvas.h"
+#include "SkPath.h"
+#include "SkRRect.h"
+#include "SkSurface.h"
+#include "Test.h"
+
+#include <vector>
+
+using namespace sk_gpu_test;
+
+static bool render(GrContext* context, std::vector<uint32_t>* pixels) {
+    SkImageInfo info = SkImageInfo::MakeN32Premul(64, 64);
+    sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, info);
+    if (!surface) {
+        return false;
+    }
+    SkCanvas* canvas = surface->getCanvas();
+    canvas->clear(SK_ColorWHITE);
+
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setColor(SK_ColorRED);
+    canvas->drawRect(SkRect::MakeXYWH(4, 4, 20, 10), paint);
+    paint.setColor(SK_ColorBLUE);
+    canvas->drawCircle(40, 12, 8, paint);
+    paint.setColor(SK_ColorGREEN);
+    canvas->drawRRect(SkRRect::MakeRectXY(SkRect::MakeXYWH(4, 30, 24, 24), 6, 6), paint);
+    SkPath path;
+    path.moveTo(36, 30);
+    path.lineTo(60, 40);
+    path.lineTo(40, 60);
+    path.lineTo(46, 42);
+    path.close();
+    paint.setColor(SK_ColorBLACK);
+    canvas->drawPath(path, paint);
+
+    pixels->resize(info.width() * info.height());
+    return surface->readPixels(info, pixels->data(), info.minRowBytes(), 0, 0);
+}
+
+DEF_GPUTEST(GrContext_precompileShader, reporter, options) {
+    for (int i = 0; i < GrContextFactory::kContextTypeCnt; ++i) {
+        GrContextFactory::ContextType ctxType = static_cast<GrContextFactory::ContextType>(i);
+        if (!GrContextFactory::IsRenderingContext(ctxType) ||
+            GrBackendApi::kOpenGL != GrContextFactory::ContextTypeBackend(ctxType)) {
+            continue;
+        }
+
+        MemoryCache cache;
+        GrContextOptions cacheOptions = options;
+        cacheOptions.fPersistentCache = &cache;
+
+        // Fill the cache as a previous run would have.
+        std::vector<uint32_t> expected;
+        {
+            GrContextFactory factory(cacheOptions);
+            GrContext* context = factory.get(ctxType);
+            if (!context || !render(context, &expected)) {
+                continue;
+            }
+        }
+
+        GrContextFactory factory(cacheOptions);
+        GrContext* context = factory.get(ctxType);
+        if (!context) {
+            continue;
+        }
+        int entries = 0, precompiled = 0;
+        cache.foreach([&](const SkData& key, const SkData& data) {
+            ++entries;
+            // Programs stored by another driver are ignored. The driver hash follows the format.
+            if (data.size() >= 2 * sizeof(uint32_t)) {
+                sk_sp<SkData> otherDriver = SkData::MakeWithCopy(data.data(), data.size());
+                static_cast<uint8_t*>(otherDriver->writable_data())[sizeof(uint32_t)] ^= 0xff;
+                REPORTER_ASSERT(reporter, !context->precompileShader(key, *otherDriver));
+            }
+            if (context->precompileShader(key, data)) {
+                ++precompiled;
+                // Asking again is harmless.
+                REPORTER_ASSERT(reporter, context->precompileShader(key, data));
+            }
+        });
+        // Garbage isn't mistaken for a cached program.
+        sk_sp<SkData> junk = SkData::MakeWithCString("not a program");
+        REPORTER_ASSERT(reporter, !context->precompileShader(*junk, *junk));
+
+        // The precompiled programs must draw just like ones built on demand.
+        std::vector<uint32_t> actual;
+        if (render(context, &actual)) {
+            REPORTER_ASSERT(reporter, expected == actual, "%s",
+                            GrContextFactory::ContextTypeName(ctxType));
+        }
+        // Only NVPR programs and ones with bound uniform locations can't be precompiled.
+        const GrGLCaps* caps = static_cast<const GrGLCaps*>(context->priv().caps());
+        if (!caps->shaderCaps()->pathRenderingSupport() && !caps->bindUniformLocationSupport()) {
+            REPORTER_ASSERT(reporter, entries == precompiled);
+        }
+    }
+}
@@ -475,3 +475,67 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(PromiseImageTextureFullCache, reporter, ctxIn
 
     gpu->deleteTestingOnlyBackendTexture(backendTex);
 }
+
+DEF_GPUTEST(PromiseImageTextureSharing, reporter, ctxInfo) {
+    const int kWidth = 10;
+    const int kHeight = 10;
+
+    GrContextOptions options;
+    options.fSharePromiseImageTextures = true;
+
+    for (int type = 0; type < sk_gpu_test::GrContextFactory::kContextTypeCnt; ++type) {
+        auto contextType = static_cast<sk_gpu_test::GrContextFactory::ContextType>(type);
+        if (!sk_gpu_test::GrContextFactory::IsRenderingContext(contextType)) {
+            continue;
+        }
+        sk_gpu_test::GrContextFactory factory(options);
+        auto ctx = factory.get(contextType);
+        if (!ctx) {
+            continue;
+        }
+        GrGpu* gpu = ctx->priv().getGpu();
+
+        GrBackendTexture backendTex = gpu->createTestingOnlyBackendTexture(
+                nullptr, kWidth, kHeight, GrColorType::kRGBA_8888, false, GrMipMapped::kNo);
+        REPORTER_ASSERT(reporter, backendTex.isValid());
+
+        SkImageInfo info = SkImageInfo::MakeN32Premul(kWidth, kHeight);
+        sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(ctx, SkBudgeted::kNo, info);
+        SkCanvas* canvas = surface->getCanvas();
+
+        // Two promise images for the same texture context, as if made by two DDLs.
+        PromiseTextureChecker promiseChecker(backendTex, reporter, false);
+        sk_sp<SkImage> images[2];
+        for (sk_sp<SkImage>& image : images) {
+            image = SkImage_Gpu::MakePromiseTexture(
+                    ctx, backendTex.getBackendFormat(), kWidth, kHeight, GrMipMapped::kNo,
+                    kTopLeft_GrSurfaceOrigin, kRGBA_8888_SkColorType, kPremul_SkAlphaType,
+                    nullptr, PromiseTextureChecker::Fulfill, PromiseTextureChecker::Release,
+                    PromiseTextureChecker::Done, &promiseChecker);
+            REPORTER_ASSERT(reporter, image);
+        }
+
+        canvas->drawImage(images[0], 0, 0);
+        canvas->drawImage(images[1], 1, 1);
+        surface->flush();
+        gpu->testingOnly_flushGpuAndSync();
+
+        // The second image used the texture the first one was fulfilled with.
+        REPORTER_ASSERT(reporter, check_fulfill_and_release_cnts(promiseChecker,
+                                                                 ReleaseBalanceExpecation::kAny,
+                                                                 1, 0, true, 0, reporter));
+
+        images[0].reset();
+        images[1].reset();
+        ctx->flush();
+        gpu->testingOnly_flushGpuAndSync();
+
+        // The shared texture is released once, after both images are done with it.
+        REPORTER_ASSERT(reporter,
+                        check_fulfill_and_release_cnts(promiseChecker,
+                                                       ReleaseBalanceExpecation::kBalanced,
+                                                       1, 1, true, 2, reporter));
+
+        gpu->deleteTestingOnlyBackendTexture(backendTex);
+    }
+}
@@ -89,3 +89,36 @@ DEF_TEST(RTree, reporter) {
                                   expectedDepthMax >= rtree.getDepth());
     }
 }
+
+DEF_TEST(RTree_incremental, reporter) {
+    SkRandom rand;
+    SkAutoTMalloc<SkRect> rects(NUM_RECTS);
+    for (int j = 0; j < NUM_RECTS; j++) {
+        rects[j] = random_rect(rand);
+    }
+    rects[7].setEmpty();  // Empty rects are skipped but still take up an index.
+
+    SkRTree whole;
+    whole.insert(rects.get(), NUM_RECTS);
+
+    // Inserting in batches numbers each batch after the last, and finds the same rects.
+    SkRTree batched;
+    const int batches[] = { 1, 9, 0, 90, NUM_RECTS - 100 };
+    int inserted = 0;
+    for (int count : batches) {
+        batched.insert(rects.get() + inserted, count);
+        inserted += count;
+    }
+    REPORTER_ASSERT(reporter, NUM_RECTS == inserted);
+    REPORTER_ASSERT(reporter, whole.getCount() == batched.getCount());
+    REPORTER_ASSERT(reporter, whole.getDepth() == batched.getDepth());
+    REPORTER_ASSERT(reporter, whole.getRootBound() == batched.getRootBound());
+
+    for (size_t i = 0; i < NUM_QUERIES; ++i) {
+        SkRect query = random_rect(rand);
+        SkTDArray<int> expected, found;
+        whole.search(query, &expected);
+        batched.search(query, &found);
+        REPORTER_ASSERT(reporter, expected == found);
+    }
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkClipOpPriv.h"
+#include "SkMatrix.h"
+#include "SkPath.h"
+#include "SkRRect.h"
+#include "SkRasterClip.h"
+#include "SkRasterClipCache.h"
+#include "SkRasterClipStack.h"
+#include "SkResourceCache.h"
+#include "Test.h"
+
+DEF_TEST(RasterClipCache, reporter) {
+    SkResourceCache cache(1024 * 1024);
+    const SkIRect devBounds = SkIRect::MakeWH(100, 100);
+    const SkRasterClip root(devBounds);
+
+    SkPath path;
+    path.addCircle(50, 50, 30);
+
+    SkRasterClipCache::Desc desc(root, 0, SkMatrix::I(), devBounds, SkClipOp::kIntersect, true);
+    desc.setPath(path);
+    REPORTER_ASSERT(reporter, desc.isValid());
+
+    SkRasterClip found(devBounds);
+    uint32_t id = 0;
+    REPORTER_ASSERT(reporter, !SkRasterClipCache::Find(desc, &found, &id, &cache));
+
+    SkRasterClip circle(root);
+    circle.op(path, SkMatrix::I(), devBounds, SkRegion::kIntersect_Op, true);
+    uint32_t circleID = SkRasterClipCache::Add(desc, circle, &cache);
+    REPORTER_ASSERT(reporter, circleID != 0);
+    REPORTER_ASSERT(reporter, SkRasterClipCache::Find(desc, &found, &id, &cache));
+    REPORTER_ASSERT(reporter, id == circleID);
+    REPORTER_ASSERT(reporter, found == circle);
+
+    // A different matrix is a different clip.
+    SkRasterClipCache::Desc moved(root, 0, SkMatrix::MakeTrans(1, 0), devBounds,
+                                  SkClipOp::kIntersect, true);
+    moved.setPath(path);
+    REPORTER_ASSERT(reporter, !SkRasterClipCache::Find(moved, &found, &id, &cache));
+
+    // Results are identified by their ID when they're the parent of later clips.
+    SkRasterClipCache::Desc child(circle, circleID, SkMatrix::I(), devBounds,
+                                  SkClipOp::kDifference, true);
+    child.setRRect(SkRRect::MakeOval(SkRect::MakeLTRB(40, 40, 60, 60)));
+    REPORTER_ASSERT(reporter, child.isValid());
+    SkRasterClip ring(circle);
+    ring.op(SkRRect::MakeOval(SkRect::MakeLTRB(40, 40, 60, 60)), SkMatrix::I(), devBounds,
+            SkRegion::kDifference_Op, true);
+    uint32_t ringID = SkRasterClipCache::Add(child, ring, &cache);
+    REPORTER_ASSERT(reporter, ringID != circleID);
+    REPORTER_ASSERT(reporter, SkRasterClipCache::Find(child, &found, &id, &cache));
+    REPORTER_ASSERT(reporter, found == ring && id == ringID);
+
+    // Complex parents without an ID, volatile paths and expanding ops can't be keyed.
+    REPORTER_ASSERT(reporter, !SkRasterClipCache::Desc(circle, 0, SkMatrix::I(), devBounds,
+                                                       SkClipOp::kIntersect, true).isValid());
+    SkRasterClipCache::Desc expanding(root, 0, SkMatrix::I(), devBounds, kUnion_SkClipOp, true);
+    REPORTER_ASSERT(reporter, !expanding.isValid());
+    {
+        SkPath volatilePath(path);
+        volatilePath.setIsVolatile(true);
+        SkRasterClipCache::Desc volatileDesc(root, 0, SkMatrix::I(), devBounds,
+                                             SkClipOp::kIntersect, true);
+        volatileDesc.setPath(volatilePath);
+        REPORTER_ASSERT(reporter, !volatileDesc.isValid());
+    }
+
+    // Editing the path purges its entries.
+    path.lineTo(0, 0);
+    REPORTER_ASSERT(reporter, !SkRasterClipCache::Find(desc, &found, &id, &cache));
+}
+
+// Repeating a save/clip/restore sequence must produce the same clips it did the first time.
+DEF_TEST(RasterClipStack_Cache, reporter) {
+    SkRasterClipStack stack(100, 100);
+    SkPath path;
+    path.addCircle(50, 50, 30);
+    SkRRect oval = SkRRect::MakeOval(SkRect::MakeLTRB(30, 30, 70, 70));
+    SkMatrix rotate;
+    rotate.setRotate(30, 50, 50);
+
+    SkRasterClip first[3];
+    for (int frame = 0; frame < 2; ++frame) {
+        stack.save();
+        stack.clipPath(SkMatrix::I(), path, SkClipOp::kIntersect, true);
+        SkRasterClip circle(stack.rc());
+        stack.clipRect(rotate, SkRect::MakeLTRB(20, 20, 80, 80), SkClipOp::kIntersect, true);
+        SkRasterClip square(stack.rc());
+        stack.clipRRect(SkMatrix::I(), oval, SkClipOp::kDifference, true);
+        SkRasterClip ring(stack.rc());
+        stack.restore();
+
+        if (0 == frame) {
+            first[0].setClip(circle);
+            first[1].setClip(square);
+            first[2].setClip(ring);
+        } else {
+            REPORTER_ASSERT(reporter, circle == first[0]);
+            REPORTER_ASSERT(reporter, square == first[1]);
+            REPORTER_ASSERT(reporter, ring == first[2]);
+        }
+        REPORTER_ASSERT(reporter, stack.rc().isRect());
+    }
+}
@@ -0,0 +1,215 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Resources.h"
+#include "SkBitmap.h"
+#include "SkCodec.h"
+#include "SkData.h"
+#include "SkExecutor.h"
+#include "SkMakeUnique.h"
+#include "SkMutex.h"
+#include "SkReadAheadStream.h"
+#include "SkSemaphore.h"
+#include "SkStream.h"
+#include "Test.h"
+
+// Like a socket: read() waits until release() lets some of the data through.
+class GatedStream : public SkStream {
+public:
+    explicit GatedStream(sk_sp<SkData> data) : fData(std::move(data)) {}
+
+    void release(size_t bytes) {
+        bool waiting;
+        {
+            SkAutoMutexAcquire lock(fMutex);
+            fReleased = SkTMin(fReleased + bytes, fData->size());
+            waiting = fWaiting;
+            fWaiting = false;
+        }
+        if (waiting) {
+            fReleasedMore.signal();
+        }
+    }
+
+    size_t read(void* buffer, size_t size) override {
+        for (;;) {
+            {
+                SkAutoMutexAcquire lock(fMutex);
+                if (fReleased > fPosition || fPosition == fData->size()) {
+                    size = SkTMin(size, fReleased - fPosition);
+                    memcpy(buffer, fData->bytes() + fPosition, size);
+                    fPosition += size;
+                    return size;
+                }
+                fWaiting = true;
+            }
+            fReleasedMore.wait();
+        }
+    }
+
+    bool isAtEnd() const override {
+        SkAutoMutexAcquire lock(fMutex);
+        return fPosition == fData->size();
+    }
+
+private:
+    sk_sp<SkData>  fData;
+    mutable SkMutex fMutex;
+    size_t         fReleased = 0;
+    size_t         fPosition = 0;
+    bool           fWaiting  = false;
+    SkSemaphore    fReleasedMore;
+};
+
+static sk_sp<SkData> make_data(size_t size) {
+    sk_sp<SkData> data = SkData::MakeUninitialized(size);
+    auto bytes = static_cast<uint8_t*>(data->writable_data());
+    for (size_t i = 0; i < size; i++) {
+        bytes[i] = (uint8_t)(i * 7 + (i >> 8));
+    }
+    return data;
+}
+
+DEF_TEST(ReadAheadStream_blocking, r) {
+    sk_sp<SkData> data = make_data(10000);
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(1);
+
+    // Small windows make the reader and the read ahead wrap around the ring many times.
+    for (size_t window : { (size_t)1, (size_t)7, (size_t)256, (size_t)20000 }) {
+        auto stream = SkReadAheadStream::Make(skstd::make_unique<SkMemoryStream>(data),
+                                              executor.get(), window);
+        REPORTER_ASSERT(r, stream);
+
+        for (int pass = 0; pass < 2; pass++) {
+            uint8_t peeked[64];
+            REPORTER_ASSERT(r, stream->peek(peeked, 3) == SkTMin<size_t>(3, window));
+            REPORTER_ASSERT(r, !memcmp(peeked, data->data(), SkTMin<size_t>(3, window)));
+
+            SkAutoTMalloc<uint8_t> storage(data->size());
+            size_t offset = 0;
+            for (size_t piece = 1; offset < data->size(); piece = piece * 3 % 1001 + 1) {
+                offset += stream->read(storage.get() + offset,
+                                       SkTMin(piece, data->size() - offset));
+            }
+            REPORTER_ASSERT(r, !memcmp(storage.get(), data->data(), data->size()));
+            REPORTER_ASSERT(r, stream->read(storage.get(), 1) == 0);
+            REPORTER_ASSERT(r, stream->isAtEnd());
+            REPORTER_ASSERT(r, stream->hasAllData());
+
+            REPORTER_ASSERT(r, stream->rewind());
+        }
+
+        // Skipping goes through read() with a null buffer.
+        REPORTER_ASSERT(r, stream->skip(5000) == 5000);
+        uint8_t byte;
+        REPORTER_ASSERT(r, stream->read(&byte, 1) == 1 && byte == data->bytes()[5000]);
+    }
+
+    // Without an executor, the read ahead happens on the reading thread.
+    auto stream = SkReadAheadStream::Make(skstd::make_unique<SkMemoryStream>(data), nullptr, 100);
+    SkAutoTMalloc<uint8_t> storage(data->size());
+    REPORTER_ASSERT(r, stream->read(storage.get(), data->size()) == data->size());
+    REPORTER_ASSERT(r, !memcmp(storage.get(), data->data(), data->size()));
+
+    REPORTER_ASSERT(r, !SkReadAheadStream::Make(nullptr, executor.get()));
+}
+
+// Waits for bytes, no more than the window, to arrive, or for the source to end.
+static void wait_for(SkReadAheadStream* stream, SkSemaphore* onData, size_t bytes) {
+    while (stream->bytesAvailable() < bytes && !stream->hasAllData()) {
+        onData->wait();
+    }
+}
+
+DEF_TEST(ReadAheadStream_noWait, r) {
+    sk_sp<SkData> data = make_data(1000);
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(1);
+
+    auto source = skstd::make_unique<GatedStream>(data);
+    GatedStream* gate = source.get();
+    SkSemaphore onData;
+    auto stream = SkReadAheadStream::Make(std::move(source), executor.get(), 256,
+                                          [&onData] { onData.signal(); });
+    stream->setWaitForData(false);
+
+    uint8_t buffer[300];
+    REPORTER_ASSERT(r, stream->read(buffer, 10) == 0);
+    REPORTER_ASSERT(r, stream->peek(buffer, 10) == 0);
+    REPORTER_ASSERT(r, !stream->isAtEnd());
+
+    // A read can't be partly satisfied, or the reader would lose track of what it's read.
+    gate->release(6);
+    wait_for(stream.get(), &onData, 6);
+    REPORTER_ASSERT(r, stream->read(buffer, 10) == 0);
+    REPORTER_ASSERT(r, stream->read(buffer, 4) == 4);
+    REPORTER_ASSERT(r, !memcmp(buffer, data->data(), 4));
+
+    // Reads larger than the window only need to wait for a window's worth.
+    SkAutoTMalloc<uint8_t> storage(data->size());
+    memcpy(storage.get(), buffer, 4);
+    size_t offset = 4;
+    gate->release(600);
+    wait_for(stream.get(), &onData, 256);
+    offset += stream->read(storage.get() + offset, 300);
+    REPORTER_ASSERT(r, offset >= 4 + 256);
+
+    gate->release(data->size());
+    while (!stream->isAtEnd()) {
+        wait_for(stream.get(), &onData, SkTMin<size_t>(data->size() - offset, 256));
+        offset += stream->read(storage.get() + offset, data->size() - offset);
+    }
+    REPORTER_ASSERT(r, offset == data->size());
+    REPORTER_ASSERT(r, !memcmp(storage.get(), data->data(), data->size()));
+    REPORTER_ASSERT(r, stream->read(buffer, 1) == 0);
+}
+
+DEF_TEST(ReadAheadStream_incrementalDecode, r) {
+    sk_sp<SkData> data = GetResourceAsData("images/mandrill_128.png");
+    if (!data) {
+        return;
+    }
+    SkBitmap expected;
+    {
+        std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data);
+        REPORTER_ASSERT(r, codec);
+        expected.allocPixels(codec->getInfo());
+        REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getPixels(expected.pixmap()));
+    }
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(1);
+    auto source = skstd::make_unique<GatedStream>(data);
+    GatedStream* gate = source.get();
+    SkSemaphore onData;
+    auto stream = SkReadAheadStream::Make(std::move(source), executor.get(), 4096,
+                                          [&onData] { onData.signal(); });
+    SkReadAheadStream* readAhead = stream.get();
+
+    // Reading the header waits for it, as codecs are made.
+    gate->release(data->size() / 2);
+    std::unique_ptr<SkCodec> codec = SkCodec::MakeFromStream(std::move(stream));
+    REPORTER_ASSERT(r, codec);
+    if (!codec) {
+        return;
+    }
+
+    SkBitmap bm;
+    bm.allocPixels(codec->getInfo());
+    REPORTER_ASSERT(r, SkCodec::kSuccess == codec->startIncrementalDecode(bm.info(),
+                                                                         bm.getPixels(),
+                                                                         bm.rowBytes()));
+    REPORTER_ASSERT(r, SkCodec::kIncompleteInput == codec->incrementalDecode());
+
+    // As more arrives, each call decodes more, until all of it has.
+    gate->release(data->size());
+    SkCodec::Result result;
+    while ((result = codec->incrementalDecode()) == SkCodec::kIncompleteInput &&
+           !readAhead->isAtEnd()) {
+        wait_for(readAhead, &onData, SkTMin<size_t>(readAhead->bytesAvailable() + 1, 4096));
+    }
+    REPORTER_ASSERT(r, SkCodec::kSuccess == result);
+    REPORTER_ASSERT(r, !memcmp(bm.getPixels(), expected.getPixels(), expected.computeByteSize()));
+}
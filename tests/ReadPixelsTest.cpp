@@ -8,9 +8,12 @@
 #include <initializer_list>
 #include "SkCanvas.h"
 #include "SkColorData.h"
+#include "SkConvertPixels.h"
+#include "SkExecutor.h"
 #include "SkHalf.h"
 #include "SkImageInfoPriv.h"
 #include "SkMathPriv.h"
+#include "SkRandom.h"
 #include "SkSurface.h"
 #include "Test.h"
 
@@ -688,3 +691,209 @@ DEF_TEST(ReadPixels_ValidConversion, reporter) {
         }
     }
 }
+
+// Conversions split into bands on an executor, and large ones that stream their stores, should
+// produce exactly what a single-threaded conversion does.
+DEF_TEST(ReadPixels_ThreadedConversion, reporter) {
+    std::unique_ptr<SkExecutor> pool = SkExecutor::MakeFIFOThreadPool(4);
+
+    const struct {
+        SkColorType fSrc, fDst;
+    } kConversions[] = {
+        { kRGBA_8888_SkColorType, kRGBA_8888_SkColorType },  // Large enough to stream.
+        { kRGBA_8888_SkColorType, kBGRA_8888_SkColorType },
+        { kRGBA_8888_SkColorType, kRGBA_F16_SkColorType },
+        { kRGBA_F16_SkColorType,  kRGBA_1010102_SkColorType },
+        { kBGRA_8888_SkColorType, kGray_8_SkColorType },
+        { kRGBA_8888_SkColorType, kAlpha_8_SkColorType },
+    };
+
+    const int kW = 1536, kH = 1537;
+    for (auto conversion : kConversions) {
+        SkImageInfo srcInfo = SkImageInfo::Make(kW, kH, conversion.fSrc, kPremul_SkAlphaType);
+        SkImageInfo dstInfo = SkImageInfo::Make(kW, kH, conversion.fDst, kPremul_SkAlphaType,
+                                                SkColorSpace::MakeSRGB());
+
+        SkBitmap src;
+        src.allocPixels(srcInfo);
+        SkRandom rand;
+        const SkColor4f color = { rand.nextF(), rand.nextF(), rand.nextF(), 1 };
+        src.erase(color.toSkColor(), SkIRect::MakeWH(kW, kH));
+        src.erase(SK_ColorTRANSPARENT, SkIRect::MakeXYWH(7, 300, 900, 600));
+
+        SkBitmap expected, actual;
+        expected.allocPixels(dstInfo);
+        actual.allocPixels(dstInfo);
+        SkConvertPixels(dstInfo, expected.getPixels(), expected.rowBytes(),
+                        srcInfo, src.getPixels(), src.rowBytes());
+        SkConvertPixels(dstInfo, actual.getPixels(), actual.rowBytes(),
+                        srcInfo, src.getPixels(), src.rowBytes(), pool.get());
+        REPORTER_ASSERT(reporter, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                              expected.computeByteSize()),
+                        "%d -> %d", conversion.fSrc, conversion.fDst);
+    }
+}
+
+struct AsyncReadResult {
+    bool fCalled = false;
+    SkBitmap fPixels;
+};
+
+static void async_read_callback(SkSurface::ReadPixelsContext context, const void* data,
+                                size_t rowBytes) {
+    auto result = static_cast<AsyncReadResult*>(context);
+    SkASSERT(!result->fCalled);
+    result->fCalled = true;
+    if (data) {
+        SkPixmap pm(result->fPixels.info(), data, rowBytes);
+        result->fPixels.writePixels(pm, 0, 0);
+    } else {
+        result->fPixels.reset();
+    }
+}
+
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(AsyncReadPixels, reporter, ctxInfo) {
+    GrContext* context = ctxInfo.grContext();
+    for (auto origin : {kTopLeft_GrSurfaceOrigin, kBottomLeft_GrSurfaceOrigin}) {
+        SkImageInfo info = SkImageInfo::MakeN32Premul(DEV_W, DEV_H);
+        sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, info, 0,
+                                                               origin, nullptr);
+        if (!surface) {
+            continue;
+        }
+        fill_src_canvas(surface->getCanvas());
+
+        const SkIRect kRect = SkIRect::MakeXYWH(3, 5, 50, 40);
+        SkImageInfo dstInfo = info.makeWH(kRect.width(), kRect.height());
+        AsyncReadResult result;
+        result.fPixels.allocPixels(dstInfo);
+        surface->asyncReadPixels(dstInfo, kRect.fLeft, kRect.fTop, async_read_callback, &result);
+        // Draws after the read must not show up in it.
+        surface->getCanvas()->clear(SK_ColorBLACK);
+        for (int i = 0; i < 100 && !result.fCalled; ++i) {
+            context->flush(kSyncCpu_GrFlushFlag, 0, nullptr);
+            context->checkAsyncWorkCompletion();
+        }
+        REPORTER_ASSERT(reporter, result.fCalled);
+        if (!result.fPixels.isNull()) {
+            check_read(reporter, result.fPixels, kRect.fLeft, kRect.fTop, true, false, info);
+        }
+
+        // Reads outside the surface fail right away.
+        AsyncReadResult outside;
+        outside.fPixels.allocPixels(dstInfo);
+        surface->asyncReadPixels(dstInfo, DEV_W - 1, 0, async_read_callback, &outside);
+        REPORTER_ASSERT(reporter, outside.fCalled && outside.fPixels.isNull());
+    }
+}
+
+struct AsyncYUVReadResult {
+    bool fCalled = false;
+    bool fSucceeded = false;
+    int fValues[3] = {};
+    bool fUniform = true;
+    int fPlaneWidths[3];
+    int fPlaneHeights[3];
+};
+
+static void async_yuv_read_callback(SkSurface::ReadPixelsContext context, const void* data[3],
+                                    const size_t rowBytes[3]) {
+    auto result = static_cast<AsyncYUVReadResult*>(context);
+    SkASSERT(!result->fCalled);
+    result->fCalled = true;
+    if (!data) {
+        return;
+    }
+    result->fSucceeded = true;
+    for (int i = 0; i < 3; ++i) {
+        auto plane = static_cast<const uint8_t*>(data[i]);
+        result->fValues[i] = plane[0];
+        for (int y = 0; y < result->fPlaneHeights[i]; ++y) {
+            for (int x = 0; x < result->fPlaneWidths[i]; ++x) {
+                if (plane[y * rowBytes[i] + x] != plane[0]) {
+                    result->fUniform = false;
+                }
+            }
+        }
+    }
+}
+
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(AsyncReadPixelsYUV420, reporter, ctxInfo) {
+    GrContext* context = ctxInfo.grContext();
+    SkImageInfo info = SkImageInfo::MakeN32Premul(DEV_W, DEV_H);
+    sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, info);
+    if (!surface) {
+        return;
+    }
+    surface->getCanvas()->clear(SK_ColorRED);
+
+    // Red is Y 76, U 85 and V 255 in full range. The odd width rounds the chroma planes up.
+    const SkIRect kRect = SkIRect::MakeXYWH(1, 2, 31, 20);
+    AsyncYUVReadResult result;
+    result.fPlaneWidths[0] = 31;
+    result.fPlaneHeights[0] = 20;
+    for (int i = 1; i < 3; ++i) {
+        result.fPlaneWidths[i] = 16;
+        result.fPlaneHeights[i] = 10;
+    }
+    surface->asyncReadPixelsYUV420(kJPEG_SkYUVColorSpace, kRect, async_yuv_read_callback,
+                                   &result);
+    for (int i = 0; i < 100 && !result.fCalled; ++i) {
+        context->flush(kSyncCpu_GrFlushFlag, 0, nullptr);
+        context->checkAsyncWorkCompletion();
+    }
+    REPORTER_ASSERT(reporter, result.fCalled);
+    if (!result.fSucceeded) {
+        return;
+    }
+    REPORTER_ASSERT(reporter, result.fUniform);
+    static const int kExpected[3] = {76, 85, 255};
+    for (int i = 0; i < 3; ++i) {
+        REPORTER_ASSERT(reporter, SkTAbs(result.fValues[i] - kExpected[i]) <= 1,
+                        "plane %d: %d expected %d", i, result.fValues[i], kExpected[i]);
+    }
+}
+
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(AsyncRescaleAndReadPixels, reporter, ctxInfo) {
+    GrContext* context = ctxInfo.grContext();
+    SkImageInfo info = SkImageInfo::MakeN32Premul(DEV_W, DEV_H);
+    sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, info);
+    if (!surface) {
+        return;
+    }
+    // Left half red, right half blue, so every step of the rescale has to keep them apart.
+    SkCanvas* canvas = surface->getCanvas();
+    canvas->clear(SK_ColorBLUE);
+    SkPaint red;
+    red.setColor(SK_ColorRED);
+    canvas->drawRect(SkRect::MakeWH(DEV_W / 2, DEV_H), red);
+
+    SkImageInfo dstInfo = SkImageInfo::Make(8, 4, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+    for (auto gamma : {SkSurface::kSrc, SkSurface::kLinear}) {
+        for (auto quality : {kNone_SkFilterQuality, kLow_SkFilterQuality, kHigh_SkFilterQuality}) {
+            AsyncReadResult result;
+            result.fPixels.allocPixels(dstInfo);
+            surface->asyncRescaleAndReadPixels(dstInfo, SkIRect::MakeWH(DEV_W, DEV_H), gamma,
+                                               quality, async_read_callback, &result);
+            for (int i = 0; i < 100 && !result.fCalled; ++i) {
+                context->flush(kSyncCpu_GrFlushFlag, 0, nullptr);
+                context->checkAsyncWorkCompletion();
+            }
+            REPORTER_ASSERT(reporter, result.fCalled);
+            if (result.fPixels.isNull()) {
+                continue;
+            }
+            REPORTER_ASSERT(reporter, result.fPixels.getColor(1, 2) == SK_ColorRED,
+                            "%d %d: 0x%08x", gamma, quality, result.fPixels.getColor(1, 2));
+            REPORTER_ASSERT(reporter, result.fPixels.getColor(6, 2) == SK_ColorBLUE,
+                            "%d %d: 0x%08x", gamma, quality, result.fPixels.getColor(6, 2));
+        }
+    }
+
+    AsyncReadResult outside;
+    outside.fPixels.allocPixels(dstInfo);
+    surface->asyncRescaleAndReadPixels(dstInfo, SkIRect::MakeXYWH(1, 0, DEV_W, DEV_H),
+                                       SkSurface::kSrc, kLow_SkFilterQuality,
+                                       async_read_callback, &outside);
+    REPORTER_ASSERT(reporter, outside.fCalled && outside.fPixels.isNull());
+}
@@ -11,6 +11,7 @@
 #include "SkDebugCanvas.h"
 #include "SkDropShadowImageFilter.h"
 #include "SkImagePriv.h"
+#include "SkLayerInfo.h"
 #include "SkRecord.h"
 #include "SkRecordDraw.h"
 #include "SkRecordOpts.h"
@@ -210,6 +211,43 @@ DEF_TEST(RecordDraw_SaveLayerAffectsClipBounds, r) {
     REPORTER_ASSERT(r, sloppy_rect_eq(bounds[3], SkRect::MakeLTRB(0, 0, 50, 50)));
 }
 
+DEF_TEST(RecordDraw_ComputeLayers, r) {
+    SkRecord record;
+    SkRecorder recorder(&record, 50, 50);
+
+    SkPaint alpha;
+    alpha.setAlpha(0x80);
+    recorder.translate(5, 5);
+    recorder.saveLayer(nullptr, &alpha);                         // 1
+        SkRect hint = SkRect::MakeWH(20, 20);
+        recorder.saveLayer(&hint, nullptr);                      // 2
+            recorder.drawRect(SkRect::MakeWH(10, 10), SkPaint());
+        recorder.restore();                                      // 4
+    recorder.restore();                                          // 5
+
+    // A blend mode other than srcover can't just composite a cached layer.
+    SkPaint src;
+    src.setBlendMode(SkBlendMode::kSrc);
+    recorder.saveLayer(nullptr, &src);                           // 6
+        recorder.drawRect(SkRect::MakeWH(10, 10), SkPaint());
+    recorder.restore();
+
+    SkAutoTMalloc<SkRect> bounds(record.count());
+    SkLayerInfo info;
+    SkRecordComputeLayers(SkRect::MakeWH(50, 50), record, bounds, nullptr, &info);
+    REPORTER_ASSERT(r, 2 == info.numBlocks());
+
+    const SkLayerInfo::BlockInfo& outer = info.block(0);
+    REPORTER_ASSERT(r, 1 == outer.fSaveLayerOpID && 5 == outer.fRestoreOpID);
+    REPORTER_ASSERT(r, outer.fLocalMat == SkMatrix::MakeTrans(5, 5));
+    REPORTER_ASSERT(r, sloppy_rect_eq(outer.fBounds, SkRect::MakeLTRB(5, 5, 15, 15)));
+    REPORTER_ASSERT(r, !outer.fHint && outer.fPaint && 0x80 == outer.fPaint->getAlpha());
+
+    const SkLayerInfo::BlockInfo& inner = info.block(1);
+    REPORTER_ASSERT(r, 2 == inner.fSaveLayerOpID && 4 == inner.fRestoreOpID);
+    REPORTER_ASSERT(r, inner.fHint && *inner.fHint == hint && !inner.fPaint);
+}
+
 // TODO This would be nice, but we can't get it right today.
 #if 0
 // When a saveLayer provides an explicit bound and has a complex paint (e.g., one that
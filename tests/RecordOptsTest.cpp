@@ -72,6 +72,65 @@ DEF_TEST(RecordOpts_NoopSaveRestores, r) {
     }
 }
 
+DEF_TEST(RecordOpts_NoopDeadMatrices, r) {
+    SkRecord record;
+    SkRecorder recorder(&record, W, H);
+
+    recorder.save();
+        recorder.translate(10, 10);
+        recorder.drawRect(SkRect::MakeWH(200, 200), SkPaint());
+        recorder.scale(2, 2);
+        recorder.translate(5, 5);
+    recorder.restore();
+
+    SkRecordNoopDeadMatrices(&record);
+    assert_type<SkRecords::Save>     (r, record, 0);
+    assert_type<SkRecords::Translate>(r, record, 1);
+    assert_type<SkRecords::DrawRect> (r, record, 2);
+    assert_type<SkRecords::NoOp>     (r, record, 3);
+    assert_type<SkRecords::NoOp>     (r, record, 4);
+    assert_type<SkRecords::Restore>  (r, record, 5);
+}
+
+DEF_TEST(RecordOpts_NoopOverdrawnDraws, r) {
+    SkRecord record;
+    SkRecorder recorder(&record, W, H);
+
+    SkPaint opaque, translucent;
+    translucent.setAlpha(0x80);
+
+    recorder.drawRect(SkRect::MakeWH(200, 200), SkPaint());      // 0: outside the later clip
+    recorder.clipRect(SkRect::MakeWH(100, 100));                 // 1
+    recorder.drawRect(SkRect::MakeWH(300, 300), SkPaint());      // 2: covered
+    recorder.save();                                             // 3
+        recorder.clipRect(SkRect::MakeWH(50, 50));               // 4
+        recorder.drawRect(SkRect::MakeWH(300, 300), SkPaint());  // 5: covered
+    recorder.restore();                                          // 6
+    recorder.drawPaint(translucent);                             // 7: covered
+    recorder.drawPaint(opaque);                                  // 8
+    recorder.save();                                             // 9
+        recorder.translate(10, 10);                              // 10
+        recorder.drawRect(SkRect::MakeWH(300, 300), SkPaint());  // 11: inside the block
+        recorder.drawPaint(opaque);                              // 12: only hides 11
+    recorder.restore();                                          // 13
+
+    SkRecordNoopOverdrawnDraws(&record);
+    assert_type<SkRecords::DrawRect> (r, record, 0);
+    assert_type<SkRecords::ClipRect> (r, record, 1);
+    assert_type<SkRecords::NoOp>     (r, record, 2);
+    assert_type<SkRecords::Save>     (r, record, 3);
+    assert_type<SkRecords::ClipRect> (r, record, 4);
+    assert_type<SkRecords::NoOp>     (r, record, 5);
+    assert_type<SkRecords::Restore>  (r, record, 6);
+    assert_type<SkRecords::NoOp>     (r, record, 7);
+    assert_type<SkRecords::DrawPaint>(r, record, 8);
+    assert_type<SkRecords::Save>     (r, record, 9);
+    assert_type<SkRecords::Translate>(r, record, 10);
+    assert_type<SkRecords::NoOp>     (r, record, 11);
+    assert_type<SkRecords::DrawPaint>(r, record, 12);
+    assert_type<SkRecords::Restore>  (r, record, 13);
+}
+
 DEF_TEST(RecordOpts_SaveSaveLayerRestoreRestore, r) {
     SkRecord record;
     SkRecorder recorder(&record, W, H);
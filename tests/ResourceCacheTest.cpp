@@ -1588,6 +1588,48 @@ static void test_free_resource_messages(skiatest::Reporter* reporter) {
     REPORTER_ASSERT(reporter, 0 == TestResource::NumAlive());
 }
 
+static void test_purge_stats(skiatest::Reporter* reporter) {
+    Mock mock(2, 30000);
+    GrContext* context = mock.context();
+    GrResourceCache* cache = mock.cache();
+    GrGpu* gpu = context->priv().getGpu();
+
+    auto make_keyed = [gpu](int data) {
+        GrUniqueKey key;
+        make_unique_key<0>(&key, data);
+        sk_sp<TestResource> resource(new TestResource(gpu));
+        resource->resourcePriv().setUniqueKey(key);
+    };
+
+    make_keyed(1);
+    make_keyed(2);
+    GrResourceCache::PurgeStats stats = cache->getPurgeStats();
+    REPORTER_ASSERT(reporter, 0 == stats.fPurgedCount && 0 == stats.fRefetchedCount);
+
+    // Adding a third resource purges the first to get under budget.
+    make_keyed(3);
+    stats = cache->getPurgeStats();
+    REPORTER_ASSERT(reporter, 1 == stats.fPurgedCount);
+    REPORTER_ASSERT(reporter, TestResource::kDefaultSize == stats.fPurgedBytes);
+    REPORTER_ASSERT(reporter, 0 == stats.fRefetchedCount);
+
+    // Recreating the first one is a refetch, and purges the second.
+    make_keyed(1);
+    stats = cache->getPurgeStats();
+    REPORTER_ASSERT(reporter, 2 == stats.fPurgedCount);
+    REPORTER_ASSERT(reporter, 1 == stats.fRefetchedCount);
+    REPORTER_ASSERT(reporter, TestResource::kDefaultSize == stats.fRefetchedBytes);
+
+    // A key that was never purged isn't.
+    make_keyed(4);
+    stats = cache->getPurgeStats();
+    REPORTER_ASSERT(reporter, 3 == stats.fPurgedCount);
+    REPORTER_ASSERT(reporter, 1 == stats.fRefetchedCount);
+
+    // Explicit purges aren't counted.
+    cache->purgeAllUnlocked();
+    REPORTER_ASSERT(reporter, 3 == cache->getPurgeStats().fPurgedCount);
+}
 
 DEF_GPUTEST(ResourceCacheMisc, reporter, /* options */) {
     // The below tests create their own mock contexts.
@@ -1610,6 +1652,7 @@ DEF_GPUTEST(ResourceCacheMisc, reporter, /* options */) {
     test_abandoned(reporter);
     test_tags(reporter);
     test_free_resource_messages(reporter);
+    test_purge_stats(reporter);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
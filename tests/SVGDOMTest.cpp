@@ -0,0 +1,94 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkTypes.h"
+
+#if defined(SK_XML)
+
+#include "SkBitmap.h"
+#include "SkCanvas.h"
+#include "SkSVGAttribute.h"
+#include "SkSVGDOM.h"
+#include "SkSVGNode.h"
+#include "SkSVGValue.h"
+#include "SkStream.h"
+#include "Test.h"
+
+static const char kSVG[] =
+    "<svg xmlns='http://www.w3.org/2000/svg' width='40' height='20'>"
+      "<defs>"
+        "<linearGradient id='grad'>"
+          "<stop id='stop' offset='0' stop-color='blue'/>"
+        "</linearGradient>"
+      "</defs>"
+      "<g>"
+        "<rect id='left' x='0' y='0' width='20' height='20' fill='red'/>"
+      "</g>"
+      "<g>"
+        "<rect x='20' y='0' width='20' height='20' fill='url(#grad)'/>"
+      "</g>"
+    "</svg>";
+
+static sk_sp<SkSVGDOM> make_dom() {
+    SkMemoryStream stream(kSVG, sizeof(kSVG) - 1);
+    return SkSVGDOM::MakeFromStream(stream);
+}
+
+static SkBitmap render(const SkSVGDOM& dom) {
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(40, 20);
+    bitmap.eraseColor(SK_ColorWHITE);
+    SkCanvas canvas(bitmap);
+    dom.render(&canvas);
+    return bitmap;
+}
+
+DEF_TEST(SVGDOM_RenderCache, reporter) {
+    sk_sp<SkSVGDOM> dom = make_dom();
+    REPORTER_ASSERT(reporter, dom);
+    if (!dom) {
+        return;
+    }
+
+    // The second render records the unchanged subtrees, and later ones replay them.
+    for (int i = 0; i < 3; ++i) {
+        SkBitmap bitmap = render(*dom);
+        REPORTER_ASSERT(reporter, bitmap.getColor(10, 10) == SK_ColorRED, "render %d", i);
+        REPORTER_ASSERT(reporter, bitmap.getColor(30, 10) == SK_ColorBLUE, "render %d", i);
+    }
+
+    SkSVGNode* left = dom->findNodeById("left");
+    REPORTER_ASSERT(reporter, left && !dom->findNodeById("missing"));
+    if (!left) {
+        return;
+    }
+    const uint32_t leftID = left->generationID();
+    left->setAttribute(SkSVGAttribute::kFill,
+                       SkSVGPaintValue(SkSVGPaint(SkSVGColorType(SK_ColorGREEN))));
+    REPORTER_ASSERT(reporter, left->generationID() != leftID);
+
+    // Updates to nodes, and to nodes they reference elsewhere in the tree, show up right away.
+    for (int i = 0; i < 3; ++i) {
+        SkBitmap bitmap = render(*dom);
+        REPORTER_ASSERT(reporter, bitmap.getColor(10, 10) == SK_ColorGREEN, "render %d", i);
+        REPORTER_ASSERT(reporter, bitmap.getColor(30, 10) == SK_ColorBLUE, "render %d", i);
+    }
+    SkSVGNode* stop = dom->findNodeById("stop");
+    REPORTER_ASSERT(reporter, stop);
+    if (!stop) {
+        return;
+    }
+    stop->setAttribute(SkSVGAttribute::kStopColor,
+                       SkSVGColorValue(SkSVGColorType(SK_ColorBLACK)));
+    for (int i = 0; i < 3; ++i) {
+        SkBitmap bitmap = render(*dom);
+        REPORTER_ASSERT(reporter, bitmap.getColor(10, 10) == SK_ColorGREEN, "render %d", i);
+        REPORTER_ASSERT(reporter, bitmap.getColor(30, 10) == SK_ColorBLACK, "render %d", i);
+    }
+}
+
+#endif  // defined(SK_XML)
@@ -13,10 +13,12 @@
         }                                                          \
     } while (0)
 
+#include "SkAnnotation.h"
 #include "SkBitmap.h"
 #include "SkCanvas.h"
 #include "SkColorFilter.h"
 #include "SkData.h"
+#include "SkGradientShader.h"
 #include "SkImage.h"
 #include "SkImageShader.h"
 #include "SkMakeUnique.h"
@@ -32,6 +34,7 @@
 
 #include "SkDOM.h"
 #include "../src/svg/SkSVGDevice.h"
+#include "SkSVGCanvas.h"
 #include "SkXMLWriter.h"
 
 static std::unique_ptr<SkCanvas> MakeDOMCanvas(SkDOM* dom) {
@@ -192,12 +195,12 @@ void SetImageShader(SkPaint* paint, int imageWidth, int imageHeight, SkShader::T
 
 // Attempt to find the three nodes on which we have expectations:
 // the pattern node, the image within that pattern, and the rect which
-// uses the pattern as a fill.
+// uses the pattern as a fill. The pattern's defs are looked for in defsRoot.
 // returns false if not all nodes are found.
 bool FindImageShaderNodes(skiatest::Reporter* reporter, const SkDOM* dom, const SkDOM::Node* root,
-                          const SkDOM::Node** patternOut, const SkDOM::Node** imageOut,
-                          const SkDOM::Node** rectOut) {
-    if (root == nullptr || dom == nullptr) {
+                          const SkDOM::Node* defsRoot, const SkDOM::Node** patternOut,
+                          const SkDOM::Node** imageOut, const SkDOM::Node** rectOut) {
+    if (root == nullptr || defsRoot == nullptr || dom == nullptr) {
         ERRORF(reporter, "root element not found");
         return false;
     }
@@ -210,7 +213,7 @@ bool FindImageShaderNodes(skiatest::Reporter* reporter, const SkDOM* dom, const
     }
     *rectOut = rect;
 
-    const SkDOM::Node* defs = dom->getFirstChild(root, "defs");
+    const SkDOM::Node* defs = dom->getFirstChild(defsRoot, "defs");
     if (defs == nullptr) {
         ERRORF(reporter, "defs not found");
         return false;
@@ -256,7 +259,7 @@ DEF_TEST(SVGDevice_image_shader_norepeat, reporter) {
 
     const SkDOM::Node *patternNode, *imageNode, *rectNode;
     bool structureAppropriate =
-            FindImageShaderNodes(reporter, &dom, root, &patternNode, &imageNode, &rectNode);
+            FindImageShaderNodes(reporter, &dom, root, root, &patternNode, &imageNode, &rectNode);
     REPORTER_ASSERT(reporter, structureAppropriate);
 
     // the image should always maintain its size.
@@ -285,8 +288,9 @@ DEF_TEST(SVGDevice_image_shader_tilex, reporter) {
     }
 
     const SkDOM::Node *patternNode, *imageNode, *rectNode;
-    bool structureAppropriate =
-            FindImageShaderNodes(reporter, &dom, innerSvg, &patternNode, &imageNode, &rectNode);
+    // The wrapping <svg> writes the pattern, and the rect inside it reuses that.
+    bool structureAppropriate = FindImageShaderNodes(reporter, &dom, innerSvg, root,
+                                                     &patternNode, &imageNode, &rectNode);
     REPORTER_ASSERT(reporter, structureAppropriate);
 
     // the imageNode should always maintain its size.
@@ -315,8 +319,9 @@ DEF_TEST(SVGDevice_image_shader_tiley, reporter) {
     }
 
     const SkDOM::Node *patternNode, *imageNode, *rectNode;
-    bool structureAppropriate =
-            FindImageShaderNodes(reporter, &dom, innerSvg, &patternNode, &imageNode, &rectNode);
+    // The wrapping <svg> writes the pattern, and the rect inside it reuses that.
+    bool structureAppropriate = FindImageShaderNodes(reporter, &dom, innerSvg, root,
+                                                     &patternNode, &imageNode, &rectNode);
     REPORTER_ASSERT(reporter, structureAppropriate);
 
     // the imageNode should always maintain its size.
@@ -345,8 +350,9 @@ DEF_TEST(SVGDevice_image_shader_tileboth, reporter) {
         ERRORF(reporter, "inner svg element not found");
         return;
     }
-    bool structureAppropriate =
-            FindImageShaderNodes(reporter, &dom, innerSvg, &patternNode, &imageNode, &rectNode);
+    // The wrapping <svg> writes the pattern, and the rect inside it reuses that.
+    bool structureAppropriate = FindImageShaderNodes(reporter, &dom, innerSvg, root,
+                                                     &patternNode, &imageNode, &rectNode);
     REPORTER_ASSERT(reporter, structureAppropriate);
 
     // the imageNode should always maintain its size.
@@ -389,4 +395,84 @@ DEF_TEST(SVGDevice_ColorFilters, reporter) {
     REPORTER_ASSERT(reporter, strcmp(dom.findAttr(compositeElement, "operator"), "in") == 0);
 }
 
+static int count_occurrences(const SkData& data, const char needle[]) {
+    const char* text = static_cast<const char*>(data.data());
+    const size_t needleLen = strlen(needle);
+    int count = 0;
+    for (size_t i = 0; i + needleLen <= data.size(); ++i) {
+        count += 0 == memcmp(text + i, needle, needleLen);
+    }
+    return count;
+}
+
+DEF_TEST(SVGDevice_SharedResources, reporter) {
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(4, 4);
+    bitmap.eraseColor(SK_ColorBLUE);
+
+    SkPath triangle;
+    triangle.moveTo(0, 0);
+    triangle.lineTo(8, 0);
+    triangle.lineTo(4, 8);
+    triangle.close();
+
+    SkDynamicMemoryWStream stream;
+    {
+        std::unique_ptr<SkCanvas> canvas = SkSVGCanvas::Make(SkRect::MakeWH(100, 100), &stream);
+        canvas->clipRect(SkRect::MakeWH(90, 90));
+        for (int i = 0; i < 3; ++i) {
+            const SkScalar x = 10.f * i;
+            canvas->drawBitmapRect(bitmap, SkRect::MakeXYWH(x, 0, 4, 4), nullptr);
+
+            // A new, but identical, gradient each time.
+            const SkPoint pts[] = { { 0, 0 }, { 100, 0 } };
+            const SkColor colors[] = { SK_ColorRED, SK_ColorGREEN };
+            SkPaint gradient;
+            gradient.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, 2,
+                                                            SkShader::kClamp_TileMode));
+            canvas->drawRect(SkRect::MakeXYWH(x, 10, 8, 8), gradient);
+
+            canvas->save();
+            canvas->translate(x, 20);
+            canvas->drawPath(triangle, SkPaint());
+            canvas->restore();
+        }
+        sk_sp<SkData> data(SkData::MakeWithCString("http://example.com/?a=1&b=2"));
+        SkAnnotateRectWithURL(canvas.get(), SkRect::MakeXYWH(0, 40, 10, 10), data.get());
+    }
+    sk_sp<SkData> svg = stream.detachAsData();
+
+    // Each resource is written once, and referenced by every draw that uses it.
+    REPORTER_ASSERT(reporter, count_occurrences(*svg, "<image ") == 1);
+    REPORTER_ASSERT(reporter, count_occurrences(*svg, "xlink:href=\"#img_0\"") == 3);
+    REPORTER_ASSERT(reporter, count_occurrences(*svg, "<linearGradient ") == 1);
+    REPORTER_ASSERT(reporter, count_occurrences(*svg, "url(#gradient_0)") == 3);
+    REPORTER_ASSERT(reporter, count_occurrences(*svg, "<clipPath ") == 1);
+
+    // The triangle is drawn inline once, then lands in <defs> for the later draws to <use>.
+    REPORTER_ASSERT(reporter, count_occurrences(*svg, "d=\"M0 0L8 0L4 8L0 0Z\"") == 2);
+    REPORTER_ASSERT(reporter, count_occurrences(*svg, "xlink:href=\"#path_0\"") == 2);
+
+    REPORTER_ASSERT(reporter, count_occurrences(*svg, "data:image/png;base64,") == 1);
+    REPORTER_ASSERT(reporter,
+                    count_occurrences(*svg, "xlink:href=\"http://example.com/?a=1&amp;b=2\"") == 1);
+
+    // Streaming the base64 data gives the same URI as encoding it up front.
+    SkDOM dom;
+    {
+        auto svgCanvas = MakeDOMCanvas(&dom);
+        svgCanvas->drawBitmapRect(bitmap, SkRect::MakeWH(4, 4), nullptr);
+    }
+    const SkDOM::Node* root = dom.finishParsing();
+    ABORT_TEST(reporter, !root, "root element not found");
+    const SkDOM::Node* defs = dom.getFirstChild(root, "defs");
+    ABORT_TEST(reporter, !defs, "defs element not found");
+    const SkDOM::Node* image = dom.getFirstChild(defs, "image");
+    ABORT_TEST(reporter, !image, "image element not found");
+    SkString href;
+    href.printf("xlink:href=\"%s\"", dom.findAttr(image, "xlink:href"));
+    REPORTER_ASSERT(reporter, count_occurrences(*svg, href.c_str()) == 1);
+}
+
 #endif
+
@@ -785,3 +785,41 @@ DEF_TEST(WriteBuffer_external_memory_flattenable, reporter) {
     storage.realloc(storage_size);
     REPORTER_ASSERT(reporter, path_effect->serialize(storage.get(), storage_size) != 0u);
 }
+
+DEF_TEST(Serialization_adopts_encoded_images, r) {
+    sk_sp<SkData> encoded = GetResourceAsData("images/mandrill_128.png");
+    if (!encoded) {
+        return;
+    }
+    SkPictureRecorder recorder;
+    recorder.beginRecording(128, 128)->drawImage(SkImage::MakeFromEncoded(encoded), 0, 0);
+    sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+
+    // The encoded image should reach a SkDataListWStream by reference, never copied.
+    SkDataListWStream stream;
+    picture->serialize(&stream);
+    SkAutoTArray<SkDataListWStream::Segment> segments(stream.segmentCount());
+    stream.getSegments(segments.get());
+    bool adopted = false;
+    for (int i = 0; i < stream.segmentCount(); ++i) {
+        adopted |= segments[i].fData == encoded->data();
+    }
+    REPORTER_ASSERT(r, adopted);
+
+    // It's still the same serialized picture.
+    sk_sp<SkData> data = stream.detachAsData();
+    SkDynamicMemoryWStream flat;
+    picture->serialize(&flat);
+    REPORTER_ASSERT(r, data->equals(flat.detachAsData().get()));
+    REPORTER_ASSERT(r, SkPicture::MakeFromData(data.get()));
+
+    // Flattenables record their sizes, which must count the image data held by reference.
+    sk_sp<SkShader> shader = SkImage::MakeFromEncoded(encoded)->makeShader()
+                                    ->makeWithLocalMatrix(SkMatrix::MakeScale(2));
+    sk_sp<SkData> flattened = shader->serialize();
+    sk_sp<SkShaderBase> readBack = SkShaderBase::Deserialize(flattened->data(), flattened->size());
+    REPORTER_ASSERT(r, readBack);
+    if (readBack) {
+        REPORTER_ASSERT(r, readBack->serialize()->equals(flattened.get()));
+    }
+}
@@ -5,9 +5,11 @@
  * found in the LICENSE file.
  */
 
+#include "SkBitmap.h"
 #include "SkCanvas.h"
 #include "SkDrawShadowInfo.h"
 #include "SkPath.h"
+#include "SkRRect.h"
 #include "SkShadowTessellator.h"
 #include "SkShadowUtils.h"
 #include "SkVertices.h"
@@ -175,3 +177,53 @@ DEF_TEST(ShadowBounds, reporter) {
     path.cubicTo(100, 50, 20, 100, 0, 0);
     check_bounds(reporter, path);
 }
+
+static int count_nonzero_alpha(const SkBitmap& bm) {
+    int count = 0;
+    for (int y = 0; y < bm.height(); ++y) {
+        for (int x = 0; x < bm.width(); ++x) {
+            count += SkColorGetA(bm.getColor(x, y)) > 0;
+        }
+    }
+    return count;
+}
+
+DEF_TEST(ShadowUtils_Raster, reporter) {
+    SkBitmap bm;
+    bm.allocN32Pixels(200, 200);
+    SkCanvas canvas(bm);
+
+    SkPath rrect;
+    rrect.addRRect(SkRRect::MakeRectXY(SkRect::MakeXYWH(50, 50, 100, 100), 10, 10));
+    const SkPoint3 zPlane = SkPoint3::Make(0, 0, 8);
+    const SkPoint3 lightPos = SkPoint3::Make(100, 0, 600);
+    // Opaque occluders' spot shadows only reuse tessellations at the same offset.
+    const uint32_t kTransparent = SkShadowFlags::kTransparentOccluder_ShadowFlag;
+
+    // Rrects under a similarity are drawn analytically, and shadow outside the occluder.
+    canvas.clear(SK_ColorTRANSPARENT);
+    SkShadowUtils::DrawShadow(&canvas, rrect, zPlane, lightPos, 80,
+                              SK_ColorBLACK, SK_ColorBLACK, kTransparent);
+    REPORTER_ASSERT(reporter, SkColorGetA(bm.getColor(100, 155)) > 0);
+    REPORTER_ASSERT(reporter, SkColorGetA(bm.getColor(100, 199)) == 0);
+    int analytic = count_nonzero_alpha(bm);
+
+    // The tessellated shadow should cover roughly the same pixels.
+    canvas.clear(SK_ColorTRANSPARENT);
+    SkShadowUtils::ResetCacheStats();
+    SkShadowUtils::DrawShadow(&canvas, rrect, zPlane, lightPos, 80,
+                              SK_ColorBLACK, SK_ColorBLACK,
+                              kTransparent | SkShadowFlags::kGeometricOnly_ShadowFlag);
+    int geometric = count_nonzero_alpha(bm);
+    REPORTER_ASSERT(reporter, SkTAbs(analytic - geometric) < geometric / 10);
+
+    // Drawing it again, even translated, finds the tessellations in the cache.
+    SkShadowUtils::CacheStats stats = SkShadowUtils::GetCacheStats();
+    canvas.translate(3, 5);
+    SkShadowUtils::DrawShadow(&canvas, rrect, zPlane, lightPos, 80,
+                              SK_ColorBLACK, SK_ColorBLACK,
+                              kTransparent | SkShadowFlags::kGeometricOnly_ShadowFlag);
+    SkShadowUtils::CacheStats after = SkShadowUtils::GetCacheStats();
+    REPORTER_ASSERT(reporter, after.fMisses == stats.fMisses);
+    REPORTER_ASSERT(reporter, after.fHits > stats.fHits);
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkFont.h"
+#include "SkGlyph.h"
+#include "SkStrikeCache.h"
+#include "SkTaskGroup.h"
+#include "SkTypeface.h"
+#include "Test.h"
+#include "sk_tool_utils.h"
+
+#include <atomic>
+
+DEF_TEST(SharedStrike_threads, reporter) {
+    SkFont font;
+    font.setEdging(SkFont::Edging::kAntiAlias);
+    font.setSize(24);
+    font.setTypeface(sk_tool_utils::create_portable_typeface("serif", SkFontStyle()));
+
+    SkGlyphID glyphs['z'];
+    for (int c = ' '; c < 'z'; c++) {
+        glyphs[c] = font.unicharToGlyph(c);
+    }
+
+    // Keep a reference for the whole test, so every thread is handed this same strike.
+    auto mainStrike = SkStrikeCache::FindOrCreateSharedStrike(
+            font, SkPaint(), SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+            SkScalerContextFlags::kNone, SkMatrix::I());
+    REPORTER_ASSERT(reporter, mainStrike);
+
+    const SkGlyph* seen['z'] = {};
+    const void*    images['z'] = {};
+    for (int c = ' '; c < 'z'; c++) {
+        seen[c]   = &mainStrike.getGlyphMetrics(glyphs[c], {0, 0});
+        images[c] = mainStrike.findImage(*seen[c]);
+    }
+
+    std::atomic<int> mismatches{0};
+    SkTaskGroup().batch(16, [&](int) {
+        auto strike = SkStrikeCache::FindOrCreateSharedStrike(
+                font, SkPaint(), SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+                SkScalerContextFlags::kNone, SkMatrix::I());
+        for (int c = ' '; c < 'z'; c++) {
+            const SkGlyph& glyph = strike.getGlyphMetrics(glyphs[c], {0, 0});
+            if (&glyph != seen[c] || strike.findImage(glyph) != images[c]) {
+                mismatches++;
+            }
+            // Paths are found lazily; just make sure concurrent misses are safe.
+            (void)strike.findPath(glyph);
+        }
+    });
+    REPORTER_ASSERT(reporter, mismatches == 0);
+}
@@ -7,6 +7,7 @@
 
 #include "SkColorSpacePriv.h"
 #include "SkColorSpaceXformSteps.h"
+#include "SkRasterPipeline.h"
 #include "Test.h"
 
 DEF_TEST(SkColorSpaceXformSteps, r) {
@@ -169,3 +170,45 @@ DEF_TEST(SkColorSpaceXformSteps, r) {
                 (t&16) ? " true" : "false");
     }
 }
+
+DEF_TEST(SkColorSpaceXformSteps_tables, r) {
+    // Going from a narrower gamut to a wider one keeps normalized colors in [0,1].
+    auto srgb22 = SkColorSpace::MakeRGB(SkNamedTransferFn::k2Dot2, SkNamedGamut::kSRGB),
+         adobe  = SkColorSpace::MakeRGB(SkNamedTransferFn::k2Dot2, SkNamedGamut::kAdobeRGB);
+
+    SkColorSpaceXformSteps math  {srgb22.get(), kUnpremul_SkAlphaType,
+                                  adobe .get(), kUnpremul_SkAlphaType},
+                           tables{srgb22.get(), kUnpremul_SkAlphaType,
+                                  adobe .get(), kUnpremul_SkAlphaType};
+    tables.useTables();
+    REPORTER_ASSERT(r, !math.srcTFTable && !math.dstTFInvTable);
+    REPORTER_ASSERT(r, tables.srcTFTable && tables.dstTFInvTable);
+
+    // The tables are shared by every transform with the same transfer functions.
+    SkColorSpaceXformSteps again{srgb22.get(), kUnpremul_SkAlphaType,
+                                 adobe .get(), kUnpremul_SkAlphaType};
+    again.useTables();
+    REPORTER_ASSERT(r, again.srcTFTable == tables.srcTFTable);
+
+    float want[16*16*4],
+          got [16*16*4];
+    for (int i = 0; i < 16*16; i++) {
+        want[4*i+0] = got[4*i+0] = (i % 16) * (1/15.0f);
+        want[4*i+1] = got[4*i+1] = (i / 16) * (1/15.0f);
+        want[4*i+2] = got[4*i+2] = ((i * 7) % 16) * (1/15.0f);
+        want[4*i+3] = got[4*i+3] = 1.0f;
+    }
+
+    for (auto pair : { std::make_pair(&math, want), std::make_pair(&tables, got) }) {
+        SkRasterPipeline_MemoryCtx ptr = { pair.second, 0 };
+        SkRasterPipeline_<256> p;
+        p.append(SkRasterPipeline::load_f32, &ptr);
+        pair.first->apply(&p, true);
+        p.append(SkRasterPipeline::store_f32, &ptr);
+        p.run(0,0,16*16,1);
+    }
+
+    for (int i = 0; i < 16*16*4; i++) {
+        REPORTER_ASSERT(r, fabsf(want[i] - got[i]) < 0.5f/255, "%g vs %g", want[i], got[i]);
+    }
+}
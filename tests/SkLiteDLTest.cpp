@@ -63,3 +63,37 @@ DEF_TEST(SkLiteRecorder_RecordsFlush, r) {
     canvas.flush();
     REPORTER_ASSERT(r, !dl.empty());
 }
+
+DEF_TEST(SkLiteDL_reuseAndCompact, r) {
+    SkLiteDL dl;
+    for (int i = 0; i < 1000; i++) {
+        dl.drawRect(SkRect{0,0,9,9}, SkPaint{});
+    }
+    const size_t reserved = dl.bytesReserved();
+    REPORTER_ASSERT(r, reserved > 0);
+
+    // The next frame records into the same storage.
+    dl.reset();
+    REPORTER_ASSERT(r, dl.empty());
+    for (int i = 0; i < 10; i++) {
+        dl.drawRect(SkRect{0,0,9,9}, SkPaint{});
+    }
+    REPORTER_ASSERT(r, dl.bytesReserved() == reserved);
+
+    dl.compact();
+    REPORTER_ASSERT(r, dl.bytesReserved() < reserved);
+    REPORTER_ASSERT(r, !dl.empty());
+
+    // Compacted lists still play back and grow.
+    SkLiteDL copy;
+    SkLiteRecorder rec;
+    rec.reset(&copy, {0,0,10,10});
+    dl.draw(&rec);
+    dl.drawRect(SkRect{0,0,9,9}, SkPaint{});
+    REPORTER_ASSERT(r, dl.bytesReserved() > 0);
+    REPORTER_ASSERT(r, !copy.empty());
+
+    dl.reset();
+    dl.compact();
+    REPORTER_ASSERT(r, 0 == dl.bytesReserved());
+}
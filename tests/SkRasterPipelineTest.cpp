@@ -202,3 +202,140 @@ DEF_TEST(SkRasterPipeline_lowp_clamp01, r) {
     p.append(SkRasterPipeline::store_8888, &ptr);
     p.run(0,0,1,1);
 }
+
+DEF_TEST(SkRasterPipeline_lowp_color_matrix, r) {
+    uint32_t rgba[64];
+    for (int i = 0; i < 64; i++) {
+        int a = 4*i + 3;
+        rgba[i] = (a * 1 / 4) << 0
+                | (a * 2 / 4) << 8
+                | (a * 3 / 4) << 16
+                | (a        ) << 24;
+    }
+    // Swap red and blue, halve green, and raise alpha by 0.25, as SkColorMatrixFilter would.
+    const float m[20] = { 0,0,1,0,  0,0.5f,0,0,  1,0,0,0,  0,0,0,1,  0,0,0,0.25f };
+
+    SkRasterPipeline_MemoryCtx ptr = { rgba, 0 };
+    SkRasterPipeline_<256> p;
+    p.append(SkRasterPipeline::load_8888,  &ptr);
+    p.append(SkRasterPipeline::unpremul);
+    p.append(SkRasterPipeline::matrix_4x5, m);
+    p.append(SkRasterPipeline::clamp_1);
+    p.append(SkRasterPipeline::premul);
+    p.append(SkRasterPipeline::store_8888, &ptr);
+    p.run(0,0,64,1);
+
+    for (int i = 0; i < 64; i++) {
+        int a = 4*i + 3;
+        float R = (a * 1 / 4) / (float)a,
+              G = (a * 2 / 4) / (float)a,
+              B = (a * 3 / 4) / (float)a,
+              A = SkTMin(a / 255.0f + 0.25f, 1.0f);
+        int want[4] = { (int)(B * A * 255 + 0.5f), (int)(0.5f * G * A * 255 + 0.5f),
+                        (int)(R * A * 255 + 0.5f), (int)(A * 255 + 0.5f) };
+        for (int c = 0; c < 4; c++) {
+            int got = (rgba[i] >> (8*c)) & 0xff;
+            // Lowp rounds after each of unpremul, the matrix and premul.
+            if (SkTAbs(got - want[c]) > 2) {
+                ERRORF(r, "pixel %d channel %d: got %d, want %d\n", i, c, got, want[c]);
+            }
+        }
+    }
+}
+
+DEF_TEST(SkRasterPipeline_highp_fallback_count, r) {
+    float rgba[4] = { 0.5f, 0.5f, 0.5f, 1 };
+    SkRasterPipeline_MemoryCtx ptr = { rgba, 0 };
+
+    // Other threads may be counting too, but the count can only go up.
+    const int before = SkRasterPipeline::HighpFallbackCount(SkRasterPipeline::load_f32);
+    SkRasterPipeline_<256> p;
+    p.append(SkRasterPipeline::load_f32,  &ptr);
+    p.append(SkRasterPipeline::store_f32, &ptr);
+    p.run(0,0,1,1);
+    REPORTER_ASSERT(r, before < SkRasterPipeline::HighpFallbackCount(SkRasterPipeline::load_f32));
+}
+
+DEF_TEST(SkRasterPipeline_lowp_tiling, r) {
+    // A 3x3 image, repeated and mirrored across 16x6 pixels by pipelines that can run in lowp.
+    uint32_t src[9];
+    for (int i = 0; i < 9; i++) {
+        src[i] = 0xff000000 | i;
+    }
+    SkRasterPipeline_GatherCtx gather;
+    gather.pixels = src;
+    gather.stride = 3;
+    gather.width  = 3;
+    gather.height = 3;
+
+    SkRasterPipeline_TileCtx limit = { 3.0f, 1.0f / 3 };
+
+    auto repeat = [](int v) { return v % 3; };
+    auto mirror = [](int v) { v %= 6; return v < 3 ? v : 5 - v; };
+
+    for (bool mirrored : { false, true }) {
+        uint32_t dst[16*6];
+        SkRasterPipeline_MemoryCtx store = { dst, 16 };
+
+        SkRasterPipeline_<256> p;
+        p.append(SkRasterPipeline::seed_shader);
+        p.append(mirrored ? SkRasterPipeline::mirror_x : SkRasterPipeline::repeat_x, &limit);
+        p.append(mirrored ? SkRasterPipeline::mirror_y : SkRasterPipeline::repeat_y, &limit);
+        p.append(SkRasterPipeline::gather_8888, &gather);
+        p.append(SkRasterPipeline::store_8888, &store);
+        p.run(0,0,16,6);
+
+        for (int y = 0; y < 6; y++) {
+            for (int x = 0; x < 16; x++) {
+                uint32_t want = mirrored ? src[mirror(y)*3 + mirror(x)]
+                                         : src[repeat(y)*3 + repeat(x)];
+                if (dst[y*16 + x] != want) {
+                    ERRORF(r, "%s (%d,%d): got %08x, want %08x\n",
+                           mirrored ? "mirror" : "repeat", x, y, dst[y*16 + x], want);
+                }
+            }
+        }
+    }
+}
+
+DEF_TEST(SkRasterPipeline_linear_2_stop_gradient, r) {
+    // The fused stage should match seed_shader -> matrix_2x3 -> clamp_x_1 ->
+    // evenly_spaced_2_stop_gradient exactly, in both lowp (store_8888) and highp (store_f32).
+    const float m[6] = { 0.05f, 0.01f, 0.02f, 0.03f, -0.2f, 0.1f };
+
+    SkRasterPipeline_Linear2StopGradientCtx fused;
+    fused.tx = m[0];
+    fused.ty = m[2];
+    fused.t0 = m[4];
+    const float f[4] = { 1.0f, -0.5f, 0.25f, 0.0f },
+                b[4] = { 0.0f,  0.75f, 0.5f, 1.0f };
+    for (int i = 0; i < 4; i++) {
+        fused.stops.f[i] = f[i];
+        fused.stops.b[i] = b[i];
+    }
+    fused.stops.interpolatedInPremul = true;
+
+    for (bool highp : { false, true }) {
+        const SkRasterPipeline::StockStage store = highp ? SkRasterPipeline::store_f32
+                                                         : SkRasterPipeline::store_8888;
+        float want[19*3*4], got[19*3*4];
+
+        SkRasterPipeline_MemoryCtx wantCtx = { want, 19 };
+        SkRasterPipeline_<256> unfused;
+        unfused.append(SkRasterPipeline::seed_shader);
+        unfused.append(SkRasterPipeline::matrix_2x3, m);
+        unfused.append(SkRasterPipeline::clamp_x_1);
+        unfused.append(SkRasterPipeline::evenly_spaced_2_stop_gradient, &fused.stops);
+        unfused.append(store, &wantCtx);
+        unfused.run(0,0,19,3);
+
+        SkRasterPipeline_MemoryCtx gotCtx = { got, 19 };
+        SkRasterPipeline_<256> p;
+        p.append(SkRasterPipeline::linear_2_stop_gradient, &fused);
+        p.append(store, &gotCtx);
+        p.run(0,0,19,3);
+
+        size_t bytes = highp ? sizeof(want) : sizeof(uint32_t) * 19*3;
+        REPORTER_ASSERT(r, 0 == memcmp(want, got, bytes), "highp %d", highp);
+    }
+}
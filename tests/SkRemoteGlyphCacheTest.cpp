@@ -192,6 +192,56 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(SkRemoteGlyphCache_StrikeSerialization, repor
     discardableManager->unlockAndDeleteAll();
 }
 
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(SkRemoteGlyphCache_SharedGlyphMemory, reporter, ctxInfo) {
+    sk_sp<DiscardableManager> discardableManager = sk_make_sp<DiscardableManager>();
+    std::vector<uint8_t> sharedMemory(64 * 1024);
+    SkStrikeServer server(discardableManager.get());
+    server.setSharedGlyphMemory(sharedMemory.data(), sharedMemory.size());
+    SkStrikeClient client(discardableManager, false);
+    client.setSharedGlyphMemory(sharedMemory.data(), sharedMemory.size());
+    const SkPaint paint;
+
+    // Server.
+    auto serverTf = SkTypeface::MakeFromName("monospace", SkFontStyle());
+    auto serverTfData = server.serializeTypeface(serverTf.get());
+
+    int glyphCount = 10;
+    auto serverBlob = buildTextBlob(serverTf, glyphCount);
+    auto props = FindSurfaceProps(ctxInfo.grContext());
+    SkTextBlobCacheDiffCanvas cache_diff_canvas(10, 10, props, &server,
+                                                MakeSettings(ctxInfo.grContext()));
+    cache_diff_canvas.drawTextBlob(serverBlob.get(), 0, 0, paint);
+
+    std::vector<uint8_t> serverStrikeData;
+    server.writeStrikeData(&serverStrikeData);
+    size_t sharedBytesUsed = server.sharedGlyphMemoryUsedForTesting();
+
+    // Client.
+    auto clientTf = client.deserializeTypeface(serverTfData->data(), serverTfData->size());
+    REPORTER_ASSERT(reporter,
+                    client.readStrikeData(serverStrikeData.data(), serverStrikeData.size()));
+    auto clientBlob = buildTextBlob(clientTf, glyphCount);
+
+    SkBitmap expected = RasterBlob(serverBlob, 10, 10, paint, ctxInfo.grContext());
+    SkBitmap actual = RasterBlob(clientBlob, 10, 10, paint, ctxInfo.grContext());
+    compare_blobs(expected, actual, reporter);
+    REPORTER_ASSERT(reporter, !discardableManager->hasCacheMiss());
+    SkStrikeCache::ValidateGlyphCacheDataSize();
+
+    // Once the client deletes the strike, the server reuses its images' memory rather than
+    // taking more.
+    discardableManager->unlockAndDeleteAll();
+    SkGraphics::PurgeFontCache();
+    cache_diff_canvas.drawTextBlob(serverBlob.get(), 0, 0, paint);
+    serverStrikeData.clear();
+    server.writeStrikeData(&serverStrikeData);
+    REPORTER_ASSERT(reporter, server.sharedGlyphMemoryUsedForTesting() == sharedBytesUsed);
+
+    // Must unlock everything on termination, otherwise valgrind complains about memory leaks.
+    discardableManager->unlockAndDeleteAll();
+    SkGraphics::PurgeFontCache();
+}
+
 DEF_GPUTEST_FOR_RENDERING_CONTEXTS(SkRemoteGlyphCache_ReleaseTypeFace, reporter, ctxInfo) {
     sk_sp<DiscardableManager> discardableManager = sk_make_sp<DiscardableManager>();
     SkStrikeServer server(discardableManager.get());
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkSLByteCode.h"
+#include "SkSLByteCodeGenerator.h"
+#include "SkSLCompiler.h"
+
+#include "Test.h"
+
+// Compiles test(), runs it with the given arguments and checks the final value of its first
+// parameter.
+template<typename type>
+void test(skiatest::Reporter* r, const char* src, type x, type y, type result) {
+    SkSL::Compiler compiler;
+    SkSL::Program::Settings settings;
+    std::unique_ptr<SkSL::Program> program = compiler.convertProgram(
+                                                                 SkSL::Program::kPipelineStage_Kind,
+                                                                 SkSL::String(src), settings);
+    REPORTER_ASSERT(r, program);
+    if (!program) {
+        printf("%s", compiler.errorText().c_str());
+        return;
+    }
+    for (const auto& e : *program) {
+        if (SkSL::ProgramElement::kFunction_Kind == e.fKind) {
+            const SkSL::FunctionDefinition& f = (const SkSL::FunctionDefinition&) e;
+            if ("test" != f.fDeclaration.fName) {
+                continue;
+            }
+            std::unique_ptr<SkSL::ByteCode> byteCode = SkSL::ByteCodeGenerator().generate(f);
+            REPORTER_ASSERT(r, 2 == byteCode->fParameterCount);
+            std::vector<SkSL::Interpreter::Value> slots(byteCode->fSlotCount,
+                                                        SkSL::Interpreter::Value(0));
+            std::copy(byteCode->fConstants.begin(), byteCode->fConstants.end(),
+                      slots.begin() + byteCode->fConstantBase);
+            slots[0] = SkSL::Interpreter::Value(x);
+            slots[1] = SkSL::Interpreter::Value(y);
+            SkSL::Interpreter::Run(*byteCode, slots.data());
+            REPORTER_ASSERT(r, 0 == memcmp(&slots[0], &result, sizeof(type)));
+            return;
+        }
+    }
+    REPORTER_ASSERT(r, false);
+}
+
+DEF_TEST(SkSLInterpreterArithmetic, r) {
+    test<int>(r, "void test(inout int x, int y) { x = x + y * 2; }", 12, 5, 22);
+    test<float>(r, "void test(inout float x, float y) { x = (x - y) / 2; }", -1, 7, -4);
+    test<int>(r, "void test(inout int x, int y) { x -= y; x *= -y; }", 12, 5, -35);
+    test<int>(r, "void test(inout int x, int y) { x = (x | y) ^ (x & y); }", 45, 15, 34);
+    test<int>(r, "void test(inout int x, int y) { int z = x++; x = z + x + ++y; }", 3, 1, 9);
+}
+
+DEF_TEST(SkSLInterpreterIf, r) {
+    test<int>(r, "void test(inout int x, int y) { if (x > y) { x = 1; } else { x = 2; } }",
+              5, 3, 1);
+    test<int>(r, "void test(inout int x, int y) { if (x > y) { x = 1; } else { x = 2; } }",
+              3, 5, 2);
+    test<float>(r, "void test(inout float x, float y) { x = x <= y ? y : x; }", 4, 6, 6);
+    test<int>(r, "void test(inout int x, int y) { x = x > 0 && y > 0 ? 1 : 0; }", 1, -1, 0);
+    test<int>(r, "void test(inout int x, int y) { x = x > 0 || y > 0 ? 1 : 0; }", -1, 1, 1);
+    test<int>(r, "void test(inout int x, int y) { if (x == y) { return; } x = 7; }", 2, 2, 2);
+}
+
+DEF_TEST(SkSLInterpreterLoops, r) {
+    test<int>(r, "void test(inout int x, int y) { for (int i = 0; i < y; ++i) { x += i; } }",
+              0, 5, 10);
+    test<int>(r, "void test(inout int x, int y) { while (x < y) { x *= 2; } }", 1, 100, 128);
+    test<int>(r, "void test(inout int x, int y) { do { x++; } while (x < y); }", 10, 0, 11);
+    test<int>(r, "void test(inout int x, int y) {"
+                 "    for (int i = 0; i < 10; ++i) {"
+                 "        if (i == y) { break; }"
+                 "        if (i == 1) { continue; }"
+                 "        x += i;"
+                 "    }"
+                 "}", 0, 4, 5);
+}
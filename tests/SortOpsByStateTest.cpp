@@ -0,0 +1,88 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkTypes.h"
+
+#include "GrContextFactory.h"
+#include "SkCanvas.h"
+#include "SkSurface.h"
+#include "Test.h"
+
+#include <vector>
+
+using namespace sk_gpu_test;
+
+static void record_flush_stats(GrFlushStatsContext context, const GrFlushStats& stats) {
+    *static_cast<GrFlushStats*>(context) = stats;
+}
+
+// Interleaves rects and circles that don't overlap, then covers some of them with an overlapping
+// rect whose place in painter's order matters.
+static bool draw(GrContext* context, std::vector<uint32_t>* pixels, GrFlushStats* stats) {
+    SkImageInfo info = SkImageInfo::Make(64, 64, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+    sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, info);
+    if (!surface) {
+        return false;
+    }
+    SkCanvas* canvas = surface->getCanvas();
+    canvas->clear(SK_ColorWHITE);
+    context->flush();
+
+    context->setFlushStatsProc(record_flush_stats, stats);
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    for (int i = 0; i < 8; ++i) {
+        SkScalar y = 8.f * i;
+        paint.setColor(SK_ColorRED);
+        paint.setBlendMode(i & 1 ? SkBlendMode::kSrcOver : SkBlendMode::kMultiply);
+        canvas->drawRect(SkRect::MakeXYWH(2, y + 1, 20, 6), paint);
+        paint.setColor(SK_ColorBLUE);
+        paint.setBlendMode(SkBlendMode::kSrcOver);
+        canvas->drawCircle(40, y + 4, 3, paint);
+    }
+    paint.setColor(SK_ColorGREEN);
+    canvas->drawRect(SkRect::MakeXYWH(30, 20, 20, 20), paint);
+    context->flush();
+    context->setFlushStatsProc(nullptr, nullptr);
+
+    pixels->resize(info.width() * info.height());
+    return surface->readPixels(info, pixels->data(), info.minRowBytes(), 0, 0);
+}
+
+DEF_GPUTEST(SortOpsByState, reporter, options) {
+    for (int i = 0; i < GrContextFactory::kContextTypeCnt; ++i) {
+        auto ctxType = static_cast<GrContextFactory::ContextType>(i);
+        if (!GrContextFactory::IsRenderingContext(ctxType)) {
+            continue;
+        }
+
+        std::vector<uint32_t> expected;
+        GrFlushStats unsortedStats = {};
+        {
+            GrContextFactory factory(options);
+            GrContext* context = factory.get(ctxType);
+            if (!context || !draw(context, &expected, &unsortedStats)) {
+                continue;
+            }
+        }
+
+        GrContextOptions sortOptions = options;
+        sortOptions.fSortOpsByState = true;
+        GrContextFactory factory(sortOptions);
+        GrContext* context = factory.get(ctxType);
+        std::vector<uint32_t> actual;
+        GrFlushStats sortedStats = {};
+        if (!context || !draw(context, &actual, &sortedStats)) {
+            continue;
+        }
+        REPORTER_ASSERT(reporter, expected == actual, "%s",
+                        GrContextFactory::ContextTypeName(ctxType));
+        REPORTER_ASSERT(reporter, sortedStats.fProgramBinds <= unsortedStats.fProgramBinds,
+                        "%s: %d > %d", GrContextFactory::ContextTypeName(ctxType),
+                        sortedStats.fProgramBinds, unsortedStats.fProgramBinds);
+    }
+}
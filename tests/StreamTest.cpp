@@ -456,6 +456,70 @@ DEF_TEST(DynamicMemoryWStream_detachAsData, r) {
     }
 }
 
+static sk_sp<SkData> concat_segments(const SkDataListWStream& stream) {
+    SkAutoTArray<SkDataListWStream::Segment> segments(stream.segmentCount());
+    stream.getSegments(segments.get());
+    SkDynamicMemoryWStream concat;
+    for (int i = 0; i < stream.segmentCount(); ++i) {
+        concat.write(segments[i].fData, segments[i].fSize);
+    }
+    return concat.detachAsData();
+}
+
+DEF_TEST(DataListWStream, r) {
+    SkRandom rand;
+    sk_sp<SkData> big = SkData::MakeUninitialized(SkDataListWStream::kMinAdoptBytes + 3);
+    for (size_t i = 0; i < big->size(); ++i) {
+        static_cast<uint8_t*>(big->writable_data())[i] = (uint8_t)rand.nextU();
+    }
+    sk_sp<SkData> small = SkData::MakeWithCString("small");
+
+    // Write the same things to a SkDynamicMemoryWStream to compare against.
+    SkDataListWStream stream;
+    SkDynamicMemoryWStream expected;
+    const char az[] = "abcdefghijklmnopqrstuvwxyz";
+    for (SkWStream* s : std::initializer_list<SkWStream*>{&stream, &expected}) {
+        for (int i = 0; i < 500; ++i) {
+            s->writeText(az);
+        }
+        s->writeData(big);
+        s->writeData(small);
+        s->writeText(az);
+    }
+    REPORTER_ASSERT(r, stream.bytesWritten() == expected.bytesWritten());
+    sk_sp<SkData> expectedData = expected.detachAsData();
+
+    // The big data should be one of the segments, not a copy of it.
+    SkAutoTArray<SkDataListWStream::Segment> segments(stream.segmentCount());
+    stream.getSegments(segments.get());
+    bool adopted = false;
+    for (int i = 0; i < stream.segmentCount(); ++i) {
+        adopted |= segments[i].fData == big->data() && segments[i].fSize == big->size();
+    }
+    REPORTER_ASSERT(r, adopted);
+    REPORTER_ASSERT(r, concat_segments(stream)->equals(expectedData.get()));
+
+    SkAutoMalloc storage(stream.bytesWritten());
+    stream.copyTo(storage.get());
+    REPORTER_ASSERT(r, 0 == memcmp(storage.get(), expectedData->data(), expectedData->size()));
+
+    SkDynamicMemoryWStream copy;
+    REPORTER_ASSERT(r, stream.writeToStream(&copy));
+    REPORTER_ASSERT(r, copy.detachAsData()->equals(expectedData.get()));
+
+    // Writing on after the segments were read keeps them intact.
+    stream.writeText(az);
+    sk_sp<SkData> detached = stream.detachAsData();
+    REPORTER_ASSERT(r, detached->size() == expectedData->size() + strlen(az));
+    REPORTER_ASSERT(r, 0 == memcmp(detached->data(), expectedData->data(), expectedData->size()));
+    REPORTER_ASSERT(r, stream.bytesWritten() == 0 && stream.segmentCount() == 0);
+
+    // Contents held in one segment are detached without a copy.
+    stream.writeData(big);
+    REPORTER_ASSERT(r, stream.detachAsData()->data() == big->data());
+    REPORTER_ASSERT(r, stream.detachAsData()->size() == 0);
+}
+
 DEF_TEST(StreamCopy, reporter) {
     SkRandom random(123456);
     static const int N = 10000;
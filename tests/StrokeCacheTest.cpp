@@ -0,0 +1,138 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkBitmap.h"
+#include "SkCanvas.h"
+#include "SkDashPathEffect.h"
+#include "SkPaint.h"
+#include "SkPath.h"
+#include "SkResourceCache.h"
+#include "SkStrokeCache.h"
+#include "SkStrokeRec.h"
+#include "Test.h"
+
+DEF_TEST(StrokeCache, reporter) {
+    SkResourceCache cache(1024 * 1024);
+
+    SkPath path;
+    path.moveTo(0, 0);
+    path.lineTo(10, 10);
+    path.lineTo(20, 0);
+
+    SkPaint paint;
+    paint.setStyle(SkPaint::kStroke_Style);
+    paint.setStrokeWidth(4);
+    SkStrokeRec rec(paint, 1);
+
+    SkPath stroked, found;
+    REPORTER_ASSERT(reporter, !SkStrokeCache::Find(path, rec, &found, &cache));
+    REPORTER_ASSERT(reporter, rec.applyToPath(&stroked, path));
+    SkStrokeCache::Add(path, rec, stroked, &cache);
+    REPORTER_ASSERT(reporter, SkStrokeCache::Find(path, rec, &found, &cache));
+    REPORTER_ASSERT(reporter, found == stroked);
+
+    SkStrokeRec wider(rec);
+    wider.setStrokeStyle(8);
+    REPORTER_ASSERT(reporter, !SkStrokeCache::Find(path, wider, &found, &cache));
+
+    // Editing the path purges its entries.
+    path.lineTo(30, 10);
+    REPORTER_ASSERT(reporter, !SkStrokeCache::Find(path, rec, &found, &cache));
+    REPORTER_ASSERT(reporter, 0 == cache.getTotalBytesUsed());
+
+    REPORTER_ASSERT(reporter, 1 == SkStrokeCache::BucketResScale(1));
+    REPORTER_ASSERT(reporter, 2 == SkStrokeCache::BucketResScale(1.5f));
+    REPORTER_ASSERT(reporter, 4 == SkStrokeCache::BucketResScale(4));
+    REPORTER_ASSERT(reporter, 0.5f == SkStrokeCache::BucketResScale(0.3f));
+}
+
+// Thin strokes are drawn without building their outlines, which should look about the same as
+// filling the outline. Where the two measure dashes differently, only the total coverage is close.
+static void check_thin_stroke(skiatest::Reporter* reporter, const SkPath& path,
+                              const SkPaint& paint, bool comparePixels) {
+    SkPaint fill(paint);
+    fill.setStyle(SkPaint::kFill_Style);
+    fill.setPathEffect(nullptr);
+    SkPath outline;
+    paint.getFillPath(path, &outline);
+
+    SkBitmap stroked, filled;
+    stroked.allocPixels(SkImageInfo::MakeA8(100, 100));
+    filled.allocPixels(SkImageInfo::MakeA8(100, 100));
+    stroked.eraseColor(SK_ColorTRANSPARENT);
+    filled.eraseColor(SK_ColorTRANSPARENT);
+    SkCanvas(stroked).drawPath(path, paint);
+    SkCanvas(filled).drawPath(outline, fill);
+
+    int strokedSum = 0, filledSum = 0;
+    for (int y = 0; y < 100; ++y) {
+        for (int x = 0; x < 100; ++x) {
+            int a = *stroked.getAddr8(x, y),
+                b = *filled.getAddr8(x, y);
+            REPORTER_ASSERT(reporter, !comparePixels || SkTAbs(a - b) <= 64,
+                            "cap %d width %g at %d %d: %d vs %d",
+                            paint.getStrokeCap(), paint.getStrokeWidth(), x, y, a, b);
+            strokedSum += a;
+            filledSum += b;
+        }
+    }
+    REPORTER_ASSERT(reporter, SkTAbs(strokedSum - filledSum) <= filledSum / 20,
+                    "cap %d width %g: %d vs %d",
+                    paint.getStrokeCap(), paint.getStrokeWidth(), strokedSum, filledSum);
+}
+
+static SkPaint thin_stroke_paint(SkPaint::Cap cap, SkScalar width) {
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setBlendMode(SkBlendMode::kSrc);
+    paint.setStyle(SkPaint::kStroke_Style);
+    paint.setStrokeCap(cap);
+    paint.setStrokeWidth(width);
+    return paint;
+}
+
+DEF_TEST(ThinStroke, reporter) {
+    SkPath path;
+    path.moveTo(10, 10.5f);
+    path.lineTo(40, 20);
+    path.lineTo(70, 15);
+    path.lineTo(90, 40);
+    path.lineTo(90, 80);
+
+    for (SkPaint::Cap cap : { SkPaint::kButt_Cap, SkPaint::kRound_Cap, SkPaint::kSquare_Cap }) {
+        for (SkScalar width : { 0.75f, 1.5f, 2.0f }) {
+            check_thin_stroke(reporter, path, thin_stroke_paint(cap, width), true);
+        }
+    }
+}
+
+DEF_TEST(ThinDash, reporter) {
+    SkPath polyline;
+    polyline.moveTo(10, 10.5f);
+    polyline.lineTo(40, 20);
+    polyline.lineTo(70, 15);
+    polyline.lineTo(90, 40);
+    SkPath rect;
+    rect.addRect(SkRect::MakeLTRB(10.5f, 50.5f, 90.5f, 90.5f));
+    SkPath oval;
+    oval.addOval(SkRect::MakeLTRB(10, 10, 90, 90));
+
+    const SkScalar dashes[] = { 6, 4 };
+    const SkScalar dots[] = { 0, 4 };
+    for (SkScalar width : { 1.0f, 2.0f }) {
+        SkPaint paint = thin_stroke_paint(SkPaint::kButt_Cap, width);
+        paint.setPathEffect(SkDashPathEffect::Make(dashes, 2, 3));
+        check_thin_stroke(reporter, polyline, paint, true);
+        check_thin_stroke(reporter, rect, paint, true);
+        check_thin_stroke(reporter, oval, paint, false);
+
+        paint.setStrokeCap(SkPaint::kRound_Cap);
+        paint.setPathEffect(SkDashPathEffect::Make(dots, 2, 0));
+        check_thin_stroke(reporter, polyline, paint, true);
+        check_thin_stroke(reporter, rect, paint, true);
+    }
+}
@@ -604,6 +604,47 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(SurfaceNoCanvas_Gpu, reporter, ctxInfo) {
     }
 }
 
+static void test_damage(skiatest::Reporter* reporter, SkSurface* surface) {
+    REPORTER_ASSERT(reporter, surface->damage().isEmpty());
+
+    // Damage is conservative: it must contain what was drawn, and shouldn't stray much further.
+    auto check = [&](const SkIRect& drawn, const SkIRect& limit) {
+        SkIRect damage = surface->damage();
+        REPORTER_ASSERT(reporter, damage.contains(drawn) && limit.contains(damage),
+                        "damage {%d %d %d %d}", damage.fLeft, damage.fTop,
+                        damage.fRight, damage.fBottom);
+        surface->resetDamage();
+        REPORTER_ASSERT(reporter, surface->damage().isEmpty());
+    };
+
+    SkCanvas* canvas = surface->getCanvas();
+    canvas->drawRect(SkRect::MakeLTRB(2, 2, 4, 4), SkPaint());
+    check(SkIRect::MakeLTRB(2, 2, 4, 4), SkIRect::MakeLTRB(1, 1, 5, 5));
+
+    canvas->save();
+    canvas->clipRect(SkRect::MakeWH(3, 3));
+    canvas->drawPaint(SkPaint());
+    canvas->restore();
+    check(SkIRect::MakeWH(3, 3), SkIRect::MakeWH(4, 4));
+
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(1, 1);
+    bitmap.eraseColor(SK_ColorRED);
+    surface->writePixels(bitmap, 8, 8);
+    check(SkIRect::MakeXYWH(8, 8, 1, 1), SkIRect::MakeXYWH(8, 8, 1, 1));
+
+    surface->notifyContentWillChange(SkSurface::kRetain_ContentChangeMode);
+    const SkIRect bounds = SkIRect::MakeWH(surface->width(), surface->height());
+    check(bounds, bounds);
+}
+DEF_TEST(SurfaceDamage, reporter) {
+    test_damage(reporter, create_surface().get());
+}
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(SurfaceDamage_Gpu, reporter, ctxInfo) {
+    auto surface(create_gpu_surface(ctxInfo.grContext()));
+    test_damage(reporter, surface.get());
+}
+
 static void check_rowbytes_remain_consistent(SkSurface* surface, skiatest::Reporter* reporter) {
     SkPixmap surfacePM;
     REPORTER_ASSERT(reporter, surface->peekPixels(&surfacePM));
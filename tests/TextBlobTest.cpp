@@ -446,3 +446,39 @@ DEF_TEST(TextBlob_MakeAsDrawText, reporter) {
     REPORTER_ASSERT(reporter, runs == 1);
 
 }
+
+DEF_TEST(TextBlob_reserveRuns, reporter) {
+    SkTextBlobBuilder builder;
+    SkFont font;
+
+    // Reserving and making nothing leaves the builder reusable.
+    builder.reserveRuns(4, 100);
+    REPORTER_ASSERT(reporter, !builder.make());
+
+    // Runs fit in a reservation whatever their positioning, and overflowing it still works.
+    for (int reserved : { 1, 3, 10 }) {
+        builder.reserveRuns(reserved, reserved * 10);
+        for (int i = 0; i < 3; ++i) {
+            // Alternate positioning to keep the runs from merging.
+            const auto& run = (i & 1) ? builder.allocRunPos(font, 10)
+                                      : builder.allocRunPosH(font, 10, SkIntToScalar(i));
+            for (int g = 0; g < 10; ++g) {
+                run.glyphs[g] = SkToU16(i * 10 + g);
+            }
+            int scalars = (i & 1) ? 20 : 10;
+            for (int s = 0; s < scalars; ++s) {
+                run.pos[s] = SkIntToScalar(s);
+            }
+        }
+        auto blob = builder.make();
+        REPORTER_ASSERT(reporter, blob);
+
+        int runs = 0;
+        for (SkTextBlobRunIterator it(blob.get()); !it.done(); it.next()) {
+            REPORTER_ASSERT(reporter, it.glyphCount() == 10);
+            REPORTER_ASSERT(reporter, it.glyphs()[9] == runs * 10 + 9);
+            runs += 1;
+        }
+        REPORTER_ASSERT(reporter, runs == 3);
+    }
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkCanvas.h"
+#include "SkExecutor.h"
+#include "SkGradientShader.h"
+#include "SkMaskFilter.h"
+#include "SkPath.h"
+#include "SkRRect.h"
+#include "SkThreadedBMPDevice.h"
+#include "Test.h"
+
+static void draw_scene(SkCanvas* canvas) {
+    SkPaint paint;
+    paint.setAntiAlias(true);
+
+    paint.setColor(SK_ColorBLUE);
+    canvas->drawRect(SkRect::MakeXYWH(10, 10, 200, 150), paint);
+
+    canvas->save();
+    canvas->clipRRect(SkRRect::MakeOval(SkRect::MakeXYWH(40, 30, 220, 200)), true);
+    const SkPoint pts[] = {{0, 0}, {256, 256}};
+    const SkColor colors[] = {SK_ColorRED, SK_ColorGREEN};
+    paint.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, 2,
+                                                 SkShader::kClamp_TileMode));
+    canvas->drawPaint(paint);
+    paint.setShader(nullptr);
+    canvas->restore();
+
+    SkPath path;
+    path.moveTo(20, 240);
+    path.cubicTo(80, 20, 180, 300, 250, 30);
+    paint.setStyle(SkPaint::kStroke_Style);
+    paint.setStrokeWidth(7);
+    paint.setColor(0x80FF00FF);
+    canvas->drawPath(path, paint);
+
+    // Blurred paths have their masks rendered ahead of time, and then blitted by each tile.
+    SkPath star;
+    star.moveTo(128, 20);
+    star.lineTo(190, 230);
+    star.lineTo(20, 100);
+    star.lineTo(236, 100);
+    star.lineTo(66, 230);
+    star.close();
+    paint.setStyle(SkPaint::kFill_Style);
+    paint.setColor(0xA0008000);
+    paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, 6));
+    canvas->drawPath(star, paint);
+    canvas->save();
+    canvas->clipRect(SkRect::MakeXYWH(0, 120, 256, 70));
+    canvas->translate(-40, 10);
+    canvas->drawPath(star, paint);
+    canvas->restore();
+    paint.setMaskFilter(nullptr);
+
+    // With --deltaAA, complex fills like this one have their coverage deltas computed once,
+    // ahead of time, for every tile to blit.
+    SkPath zigzag;
+    zigzag.moveTo(10, 250);
+    for (int i = 0; i < 12; ++i) {
+        zigzag.lineTo(20 + 20 * i, i & 1 ? 250 : 20 + 10 * i);
+    }
+    zigzag.close();
+    paint.setColor(0x9000A0FF);
+    canvas->drawPath(zigzag, paint);
+
+    canvas->rotate(15);
+    paint.setColor(0xC000FFFF);
+    canvas->drawRRect(SkRRect::MakeRectXY(SkRect::MakeXYWH(90, 60, 120, 90), 20, 20), paint);
+
+    const SkPoint points[] = {{30, 30}, {60, 90}, {120, 40}, {200, 200}};
+    paint.setStrokeWidth(5);
+    canvas->drawPoints(SkCanvas::kPolygon_PointMode, SK_ARRAY_COUNT(points), points, paint);
+}
+
+DEF_TEST(ThreadedBMPDevice_MatchesSerial, reporter) {
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(256, 256);
+
+    SkBitmap expected;
+    expected.allocPixels(info);
+    expected.eraseColor(SK_ColorTRANSPARENT);
+    {
+        SkCanvas canvas(expected);
+        draw_scene(&canvas);
+    }
+
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (int tiles : {1, 3, 7, 256}) {
+        SkBitmap actual;
+        actual.allocPixels(info);
+        actual.eraseColor(SK_ColorTRANSPARENT);
+        {
+            SkCanvas canvas(sk_make_sp<SkThreadedBMPDevice>(actual, tiles, 0, executor.get()));
+            draw_scene(&canvas);
+            canvas.flush();
+        }
+
+        for (int y = 0; y < info.height(); ++y) {
+            if (0 != memcmp(expected.getAddr32(0, y), actual.getAddr32(0, y),
+                            info.minRowBytes())) {
+                ERRORF(reporter, "row %d differs with %d tiles", y, tiles);
+                break;
+            }
+        }
+    }
+}
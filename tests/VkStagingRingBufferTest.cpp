@@ -0,0 +1,60 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+// This is a GPU-backend specific test. It relies on static intializers to work
+
+#include "SkTypes.h"
+
+#if defined(SK_VULKAN)
+
+#include "vk/GrVkVulkan.h"
+
+#include "GrContextFactory.h"
+#include "GrContextPriv.h"
+#include "Test.h"
+#include "vk/GrVkGpu.h"
+#include "vk/GrVkStagingRingBuffer.h"
+
+DEF_GPUTEST_FOR_VULKAN_CONTEXT(VkStagingRingBufferTest, reporter, ctxInfo) {
+    GrContext* context = ctxInfo.grContext();
+    GrVkGpu* gpu = static_cast<GrVkGpu*>(context->priv().getGpu());
+
+    GrVkStagingRingBuffer ring;
+    GrVkStagingRingBuffer::Slice first, second;
+    REPORTER_ASSERT(reporter, ring.allocate(gpu, 3, 4, &first));
+    REPORTER_ASSERT(reporter, ring.allocate(gpu, 64, 16, &second));
+    REPORTER_ASSERT(reporter, first.fBuffer == second.fBuffer);
+    REPORTER_ASSERT(reporter, 0 == second.fOffset % 16);
+    REPORTER_ASSERT(reporter, second.fOffset >= first.fOffset + 3);
+    REPORTER_ASSERT(reporter, second.fData - first.fData ==
+                              (ptrdiff_t)(second.fOffset - first.fOffset));
+    memset(second.fData, 0xAB, 64);
+    ring.flush(gpu, second, 64);
+
+    // Keep going until the first buffer is full.
+    const GrVkBuffer* firstBuffer = first.fBuffer;
+    GrVkStagingRingBuffer::Slice slice;
+    do {
+        REPORTER_ASSERT(reporter, ring.allocate(gpu, GrVkStagingRingBuffer::kMaxUploadSize, 4,
+                                                &slice));
+        REPORTER_ASSERT(reporter, slice.fOffset + GrVkStagingRingBuffer::kMaxUploadSize <=
+                                  GrVkStagingRingBuffer::kBufferSize);
+    } while (slice.fBuffer == firstBuffer);
+    REPORTER_ASSERT(reporter, 0 == slice.fOffset);
+
+    // No command buffer refers to the first buffer, so after filling the second we go back to it.
+    const GrVkBuffer* secondBuffer = slice.fBuffer;
+    do {
+        REPORTER_ASSERT(reporter, ring.allocate(gpu, GrVkStagingRingBuffer::kMaxUploadSize, 4,
+                                                &slice));
+    } while (slice.fBuffer == secondBuffer);
+    REPORTER_ASSERT(reporter, slice.fBuffer == firstBuffer);
+
+    ring.release(gpu);
+}
+
+#endif
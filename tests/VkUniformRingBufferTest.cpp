@@ -0,0 +1,66 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+// This is a GPU-backend specific test. It relies on static intializers to work
+
+#include "SkTypes.h"
+
+#if defined(SK_VULKAN)
+
+#include "vk/GrVkVulkan.h"
+
+#include "GrContextFactory.h"
+#include "GrContextPriv.h"
+#include "Test.h"
+#include "vk/GrVkGpu.h"
+#include "vk/GrVkUniformRingBuffer.h"
+
+DEF_GPUTEST_FOR_VULKAN_CONTEXT(VkUniformRingBufferTest, reporter, ctxInfo) {
+    GrContext* context = ctxInfo.grContext();
+    GrVkGpu* gpu = static_cast<GrVkGpu*>(context->priv().getGpu());
+    const VkDeviceSize alignment =
+            gpu->physicalDeviceProperties().limits.minUniformBufferOffsetAlignment;
+
+    GrVkUniformRingBuffer ring;
+    const uint8_t data[48] = {};
+
+    REPORTER_ASSERT(reporter, ring.reserve(gpu, 2 * sizeof(data)));
+    uint32_t generation = ring.generation();
+    const GrVkResource* firstBuffer = ring.resource();
+    uint32_t geometryOffset = ring.upload(gpu, data, sizeof(data));
+    uint32_t fragmentOffset = ring.upload(gpu, data, sizeof(data));
+    REPORTER_ASSERT(reporter, 0 == geometryOffset);
+    REPORTER_ASSERT(reporter, 0 == fragmentOffset % alignment);
+    REPORTER_ASSERT(reporter, fragmentOffset >= sizeof(data));
+
+    // Keep going until the first buffer is full. Every upload is aligned and leaves room for the
+    // descriptor's range.
+    while (true) {
+        REPORTER_ASSERT(reporter, ring.reserve(gpu, sizeof(data)));
+        if (ring.generation() != generation) {
+            break;
+        }
+        uint32_t offset = ring.upload(gpu, data, sizeof(data));
+        REPORTER_ASSERT(reporter, 0 == offset % alignment);
+        REPORTER_ASSERT(reporter, offset + GrVkUniformRingBuffer::kMaxUniformSize <=
+                                  GrVkUniformRingBuffer::kBufferSize);
+    }
+    REPORTER_ASSERT(reporter, ring.resource() != firstBuffer);
+    REPORTER_ASSERT(reporter, 0 == ring.upload(gpu, data, sizeof(data)));
+
+    // No command buffer refers to the first buffer, so after filling the second we go back to it.
+    generation = ring.generation();
+    while (ring.generation() == generation) {
+        REPORTER_ASSERT(reporter, ring.reserve(gpu, sizeof(data)));
+        ring.upload(gpu, data, sizeof(data));
+    }
+    REPORTER_ASSERT(reporter, ring.resource() == firstBuffer);
+
+    ring.release(gpu);
+}
+
+#endif
@@ -16,6 +16,9 @@
 #include "SkSurface.h"
 #include "SkSurfaceCharacterization.h"
 #include "SkTaskGroup.h"
+#include "SkTime.h"
+
+#include <algorithm>
 
 DDLTileHelper::TileData::TileData(sk_sp<SkSurface> s, const SkIRect& clip)
         : fSurface(std::move(s))
@@ -45,6 +48,8 @@ void DDLTileHelper::TileData::createTileSpecificSKP(SkData* compressedPictureDat
 void DDLTileHelper::TileData::createDDL() {
     SkASSERT(!fDisplayList);
 
+    double start = SkTime::GetMSecs();
+
     SkDeferredDisplayListRecorder recorder(fCharacterization);
 
     // DDL TODO: the DDLRecorder's GrContext isn't initialized until getCanvas is called.
@@ -73,6 +78,9 @@ void DDLTileHelper::TileData::createDDL() {
     }
 
     fDisplayList = recorder.detach();
+
+    fRecordMs = SkTime::GetMSecs() - start;
+    fRecordThread = std::this_thread::get_id();
 }
 
 void DDLTileHelper::TileData::draw() {
@@ -127,6 +135,11 @@ DDLTileHelper::DDLTileHelper(SkCanvas* canvas, const SkIRect& viewport, int numD
             fTiles.push_back(TileData(std::move(tileSurface), clip));
         }
     }
+
+    fRecordOrder.reserve(fTiles.count());
+    for (int i = 0; i < fTiles.count(); ++i) {
+        fRecordOrder.push_back(i);
+    }
 }
 
 void DDLTileHelper::createSKPPerTile(SkData* compressedPictureData,
@@ -137,25 +150,61 @@ void DDLTileHelper::createSKPPerTile(SkData* compressedPictureData,
 }
 
 void DDLTileHelper::createDDLsInParallel() {
+    // A stable sort keeps the grid order until we have timings, and between equally costly tiles.
+    std::stable_sort(fRecordOrder.begin(), fRecordOrder.end(), [this](int a, int b) {
+        return fTiles[a].recordMs() > fTiles[b].recordMs();
+    });
+
 #if 1
-    SkTaskGroup().batch(fTiles.count(), [&](int i) { fTiles[i].createDDL(); });
-    SkTaskGroup().wait();
+    SkTaskGroup taskGroup;
+    taskGroup.batch(fTiles.count(), [&](int i) { fTiles[fRecordOrder[i]].createDDL(); });
+    taskGroup.wait();
 #else
     // Use this code path to debug w/o threads
     for (int i = 0; i < fTiles.count(); ++i) {
-        fTiles[i].createDDL();
+        fTiles[fRecordOrder[i]].createDDL();
     }
 #endif
 
+    for (const TileData& tile : fTiles) {
+        ThreadTiming* timing = nullptr;
+        for (ThreadTiming& t : fThreadTimings) {
+            if (t.fThread == tile.recordThread()) {
+                timing = &t;
+                break;
+            }
+        }
+        if (!timing) {
+            timing = &fThreadTimings.push_back();
+            timing->fThread = tile.recordThread();
+        }
+        ++timing->fNumTiles;
+        timing->fRecordMs += tile.recordMs();
+    }
+    ++fNumRecordings;
 }
 
 void DDLTileHelper::drawAllTilesAndFlush(GrContext* context, bool flush) {
+    double start = SkTime::GetMSecs();
+
+    // The tiles draw into separate surfaces, so they can replay in any order. Keep the grid order
+    // so the GPU work comes out the same whatever order the tiles were recorded in.
     for (int i = 0; i < fTiles.count(); ++i) {
         fTiles[i].draw();
     }
     if (flush) {
         context->flush();
     }
+
+    fReplayMs += SkTime::GetMSecs() - start;
+    ++fNumReplays;
+}
+
+void DDLTileHelper::resetTimings() {
+    fThreadTimings.reset();
+    fReplayMs = 0;
+    fNumRecordings = 0;
+    fNumReplays = 0;
 }
 
 void DDLTileHelper::composeAllTiles(SkCanvas* dstCanvas) {
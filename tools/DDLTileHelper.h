@@ -11,6 +11,9 @@
 #include "SkRect.h"
 #include "SkRefCnt.h"
 #include "SkSurfaceCharacterization.h"
+#include "SkTArray.h"
+
+#include <thread>
 
 class DDLPromiseImageHelper;
 class SkCanvas;
@@ -38,6 +41,11 @@ public:
         // Create the per-tile DDL from the per-tile SKP
         void createDDL();
 
+        // How long the last createDDL() took, and on which thread. The scheduler uses the former
+        // as the tile's cost.
+        double recordMs() const { return fRecordMs; }
+        std::thread::id recordThread() const { return fRecordThread; }
+
         // This method operates serially and replays the recorded DDL into the tile surface.
         void draw();
 
@@ -55,23 +63,47 @@ public:
         SkTArray<sk_sp<SkImage>>               fPromiseImages; // All the promise images in the
                                                                // reconstituted picture
         std::unique_ptr<SkDeferredDisplayList> fDisplayList;
+        double                                 fRecordMs = 0;
+        std::thread::id                        fRecordThread;
+    };
+
+    // Recording time spent on one thread, accumulated across calls to createDDLsInParallel().
+    struct ThreadTiming {
+        std::thread::id fThread;
+        int             fNumTiles = 0;
+        double          fRecordMs = 0;
     };
 
     DDLTileHelper(SkCanvas* canvas, const SkIRect& viewport, int numDivisions);
 
     void createSKPPerTile(SkData* compressedPictureData, const DDLPromiseImageHelper& helper);
 
+    // Tiles are handed out to the SkTaskGroup's threads one at a time, whichever thread is free
+    // next taking the next tile. They go out most expensive first, going by how long they took to
+    // record the previous time, so no thread is left with a big tile once the others run dry.
     void createDDLsInParallel();
 
     void drawAllTilesAndFlush(GrContext*, bool flush);
 
+    // Recording times per thread and total replay time, since construction or resetTimings().
+    const SkTArray<ThreadTiming>& threadTimings() const { return fThreadTimings; }
+    double replayMs() const { return fReplayMs; }
+    int numRecordings() const { return fNumRecordings; }
+    int numReplays() const { return fNumReplays; }
+    void resetTimings();
+
     void composeAllTiles(SkCanvas* dstCanvas);
 
     void resetAllTiles();
 
 private:
-    int                fNumDivisions; // number of tiles along a side
-    SkTArray<TileData> fTiles;
+    int                    fNumDivisions; // number of tiles along a side
+    SkTArray<TileData>     fTiles;
+    SkTArray<int>          fRecordOrder;  // indices into fTiles, most expensive first
+    SkTArray<ThreadTiming> fThreadTimings;
+    double                 fReplayMs = 0;
+    int                    fNumRecordings = 0;
+    int                    fNumReplays = 0;
 };
 
 #endif
@@ -12,7 +12,9 @@
 #include "SkPaintFilterCanvas.h"
 #include "SkPicture.h"
 #include "SkRectPriv.h"
+#include "SkTHash.h"
 #include "SkTextBlob.h"
+#include "SkTime.h"
 #include "SkClipOpPriv.h"
 
 #include "GrAuditTrail.h"
@@ -24,6 +26,13 @@
 #define SKDEBUGCANVAS_ATTRIBUTE_VERSION           "version"
 #define SKDEBUGCANVAS_ATTRIBUTE_COMMANDS          "commands"
 #define SKDEBUGCANVAS_ATTRIBUTE_AUDITTRAIL        "auditTrail"
+#define SKDEBUGCANVAS_ATTRIBUTE_COMMAND           "command"
+#define SKDEBUGCANVAS_ATTRIBUTE_VISIBLE           "visible"
+#define SKDEBUGCANVAS_ATTRIBUTE_GPUTIMED          "gpuTimed"
+#define SKDEBUGCANVAS_ATTRIBUTE_CPUNANOS          "cpuNanos"
+#define SKDEBUGCANVAS_ATTRIBUTE_FLUSHNANOS        "flushNanos"
+#define SKDEBUGCANVAS_ATTRIBUTE_GPUNANOS          "gpuNanos"
+#define SKDEBUGCANVAS_ATTRIBUTE_DRAWS             "draws"
 
 class DebugPaintFilterCanvas : public SkPaintFilterCanvas {
 public:
@@ -288,6 +297,102 @@ void SkDebugCanvas::toJSONOpList(SkJSONWriter& writer, int n, SkCanvas* canvas)
     this->cleanupAuditTrail(canvas);
 }
 
+namespace {
+struct ProfileState {
+    SkTArray<SkDebugCanvas::CommandProfile>* fProfiles;
+    SkTHashMap<uint64_t, int> fFlushCommands; // Flush ID to the command that was flushed.
+    int fCommand;                             // The command being flushed, or -1.
+    bool fGpuTimed;
+};
+
+void record_flush_stats(GrFlushStatsContext context, const GrFlushStats& stats) {
+    ProfileState* state = static_cast<ProfileState*>(context);
+    if (state->fCommand >= 0) {
+        SkDebugCanvas::CommandProfile& profile = (*state->fProfiles)[state->fCommand];
+        // Submitting includes waiting for the GPU to finish, which profile() forces.
+        profile.fFlushNanos += stats.fTotalNanos - stats.fSubmitNanos;
+        profile.fDraws += stats.fDraws;
+        state->fFlushCommands.set(stats.fFlushID, state->fCommand);
+    }
+    // GPU times arrive with later flushes.
+    if (stats.fGpuTimedFlushID) {
+        if (int* command = state->fFlushCommands.find(stats.fGpuTimedFlushID)) {
+            (*state->fProfiles)[*command].fGpuNanos += stats.fGpuNanos;
+            state->fGpuTimed = true;
+        }
+    }
+}
+} // namespace
+
+bool SkDebugCanvas::profile(SkCanvas* canvas, SkTArray<CommandProfile>* profiles) {
+    ProfileState state = { profiles, {}, -1, false };
+    profiles->reset();
+    profiles->push_back_n(fCommandVector.count(), CommandProfile());
+
+    // Start from the state drawTo() does.
+    int saveCount = canvas->save();
+    SkRect windowRect = SkRect::MakeWH(SkIntToScalar(canvas->getBaseLayerSize().width()),
+                                       SkIntToScalar(canvas->getBaseLayerSize().height()));
+    canvas->clear(SK_ColorWHITE);
+    canvas->resetMatrix();
+    if (!windowRect.isEmpty()) {
+        canvas->clipRect(windowRect, kReplace_SkClipOp);
+    }
+
+    // Finish anything already pending, so it isn't charged to the first command.
+    GrContext* context = canvas->getGrContext();
+    if (context) {
+        context->flush(kSyncCpu_GrFlushFlag, 0, nullptr);
+        context->setFlushStatsProc(record_flush_stats, &state, true);
+    }
+
+    for (int i = 0; i < fCommandVector.count(); i++) {
+        if (!fCommandVector[i]->isVisible()) {
+            continue;
+        }
+        double start = SkTime::GetNSecs();
+        fCommandVector[i]->execute(canvas);
+        (*profiles)[i].fCpuNanos = (uint64_t)(SkTime::GetNSecs() - start);
+
+        if (context) {
+            state.fCommand = i;
+            context->flush(kSyncCpu_GrFlushFlag, 0, nullptr);
+            state.fCommand = -1;
+        }
+    }
+    canvas->restoreToCount(saveCount);
+
+    if (context) {
+        // The last command's GPU time is reported by the flush after its own.
+        context->flush();
+        context->setFlushStatsProc(nullptr, nullptr);
+    }
+    return state.fGpuTimed;
+}
+
+void SkDebugCanvas::toJSONProfile(SkJSONWriter& writer, SkCanvas* canvas) {
+    SkTArray<CommandProfile> profiles;
+    bool gpuTimed = this->profile(canvas, &profiles);
+
+    writer.appendS32(SKDEBUGCANVAS_ATTRIBUTE_VERSION, SKDEBUGCANVAS_VERSION);
+    writer.appendBool(SKDEBUGCANVAS_ATTRIBUTE_GPUTIMED, gpuTimed);
+    writer.beginArray(SKDEBUGCANVAS_ATTRIBUTE_COMMANDS);
+    for (int i = 0; i < profiles.count(); i++) {
+        writer.beginObject();
+        writer.appendString(SKDEBUGCANVAS_ATTRIBUTE_COMMAND,
+                            SkDrawCommand::GetCommandString(fCommandVector[i]->getOpType()));
+        writer.appendBool(SKDEBUGCANVAS_ATTRIBUTE_VISIBLE, fCommandVector[i]->isVisible());
+        writer.appendU64(SKDEBUGCANVAS_ATTRIBUTE_CPUNANOS, profiles[i].fCpuNanos);
+        writer.appendU64(SKDEBUGCANVAS_ATTRIBUTE_FLUSHNANOS, profiles[i].fFlushNanos);
+        if (gpuTimed) {
+            writer.appendU64(SKDEBUGCANVAS_ATTRIBUTE_GPUNANOS, profiles[i].fGpuNanos);
+        }
+        writer.appendS32(SKDEBUGCANVAS_ATTRIBUTE_DRAWS, profiles[i].fDraws);
+        writer.endObject();
+    }
+    writer.endArray(); // commands
+}
+
 void SkDebugCanvas::setOverdrawViz(bool overdrawViz) {
     fOverdrawViz = overdrawViz;
 }
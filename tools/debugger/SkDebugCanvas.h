@@ -107,6 +107,31 @@ public:
 
     void toJSONOpList(SkJSONWriter& writer, int n, SkCanvas*);
 
+    /**
+        The cost of one command, as measured by profile().
+     */
+    struct CommandProfile {
+        uint64_t fCpuNanos;   // Executing the command on the canvas.
+        uint64_t fFlushNanos; // Flushing the GPU work the command recorded, before submitting it.
+        uint64_t fGpuNanos;   // The GPU running that work, when the backend can time it.
+        int      fDraws;      // Draws the command issued to the GPU backend.
+    };
+
+    /**
+        Executes every visible command on the canvas, one at a time, and returns what each cost
+        in profiles, indexed like the commands. On a GPU canvas each command's work is flushed
+        and finished before the next command runs, so its flush and GPU time are its own. This
+        replaces the GrContext's flush stats proc while it runs and clears it afterwards.
+        Returns true if the GPU times were measured.
+     */
+    bool profile(SkCanvas*, SkTArray<CommandProfile>* profiles);
+
+    /**
+        Profiles the commands on the canvas and writes the result into the current JSON object,
+        with each command's name, visibility and costs in a "commands" array.
+     */
+    void toJSONProfile(SkJSONWriter& writer, SkCanvas*);
+
     void detachCommands(SkTDArray<SkDrawCommand*>* dst) {
         fCommandVector.swap(*dst);
     }
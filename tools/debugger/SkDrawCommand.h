@@ -84,6 +84,8 @@ public:
         fVisible = toggle;
     }
 
+    OpType getOpType() const { return fOpType; }
+
     virtual void execute(SkCanvas*) const = 0;
 
     virtual bool render(SkCanvas* canvas) const { return false; }
@@ -161,13 +161,18 @@ DEFINE_bool(cachePathMasks, true, "Allows path mask textures to be cached in GPU
 
 DEFINE_bool(noGS, false, "Disables support for geometry shaders.");
 
+DEFINE_bool(noInstancedRects, false, "Always tessellate filled rects instead of instancing them.");
+
 DEFINE_string(pr, "all",
               "Set of enabled gpu path renderers. Defined as a list of: "
               "[~]none [~]dashline [~]nvpr [~]ccpr [~]aahairline [~]aaconvex [~]aalinearizing "
-              "[~]small [~]tess] [~]all");
+              "[~]small [~]tess] [~]skc [~]all");
 
 DEFINE_bool(disableExplicitAlloc, false, "Disable explicit allocation of GPU resources");
 DEFINE_bool(reduceOpListSplitting, false, "Improve opList sorting");
+DEFINE_bool(prepareOpsConcurrently, false, "Generate vertex data for ops that support it on the "
+                                           "--gpuThreads threads while flushing");
+DEFINE_bool(reducedQualityBlurs, false, "Compute large GPU blurs at a lower resolution.");
 
 void SetCtxOptionsFromCommonFlags(GrContextOptions* ctxOptions) {
     static std::unique_ptr<SkExecutor> gGpuExecutor = (0 != FLAGS_gpuThreads)
@@ -175,6 +180,7 @@ void SetCtxOptionsFromCommonFlags(GrContextOptions* ctxOptions) {
     ctxOptions->fExecutor = gGpuExecutor.get();
     ctxOptions->fAllowPathMaskCaching = FLAGS_cachePathMasks;
     ctxOptions->fSuppressGeometryShaders = FLAGS_noGS;
+    ctxOptions->fSuppressInstancedRects = FLAGS_noInstancedRects;
     ctxOptions->fGpuPathRenderers = CollectGpuPathRenderersFromFlags();
     ctxOptions->fDisableDriverCorrectnessWorkarounds = FLAGS_disableDriverCorrectnessWorkarounds;
 
@@ -187,4 +193,6 @@ void SetCtxOptionsFromCommonFlags(GrContextOptions* ctxOptions) {
     if (FLAGS_reduceOpListSplitting) {
         ctxOptions->fReduceOpListSplitting = GrContextOptions::Enable::kYes;
     }
+    ctxOptions->fPrepareOpsConcurrently = FLAGS_prepareOpsConcurrently;
+    ctxOptions->fReducedQualityBlurs = FLAGS_reducedQualityBlurs;
 }
@@ -15,9 +15,12 @@
 DECLARE_int32(gpuThreads);
 DECLARE_bool(cachePathMasks);
 DECLARE_bool(noGS);
+DECLARE_bool(noInstancedRects);
 DECLARE_string(pr);
 DECLARE_bool(disableExplicitAlloc);
 DECLARE_bool(reduceOpListSplitting);
+DECLARE_bool(prepareOpsConcurrently);
+DECLARE_bool(reducedQualityBlurs);
 
 inline GpuPathRenderers get_named_pathrenderers_flags(const char* name) {
     if (!strcmp(name, "none")) {
@@ -38,6 +41,8 @@ inline GpuPathRenderers get_named_pathrenderers_flags(const char* name) {
         return GpuPathRenderers::kSmall;
     } else if (!strcmp(name, "tess")) {
         return GpuPathRenderers::kTessellating;
+    } else if (!strcmp(name, "skc")) {
+        return GpuPathRenderers::kSkc;
     } else if (!strcmp(name, "all")) {
         return GpuPathRenderers::kAll;
     }
@@ -33,6 +33,14 @@ public:
     int numCacheMisses() const { return fCacheMissCnt; }
     void resetNumCacheMisses() { fCacheMissCnt = 0; }
 
+    /** Calls fn(const SkData& key, const SkData& data) for each stored entry. */
+    template <typename Fn>
+    void foreach(Fn&& fn) const {
+        for (const auto& entry : fMap) {
+            fn(*entry.first.fKey, *entry.second);
+        }
+    }
+
 private:
     struct Key {
         Key() = default;
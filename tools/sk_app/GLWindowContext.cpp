@@ -81,7 +81,12 @@ sk_sp<SkSurface> GLWindowContext::getBackbufferSurface() {
 }
 
 void GLWindowContext::swapBuffers() {
-    this->onSwapBuffers();
+    SkIRect damage = SkIRect::MakeWH(fWidth, fHeight);
+    if (fSurface) {
+        damage = fSurface->damage();
+        fSurface->resetDamage();
+    }
+    this->onSwapBuffersWithDamage(damage);
 }
 
 void GLWindowContext::resize(int  w, int h) {
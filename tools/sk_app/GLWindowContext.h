@@ -45,6 +45,9 @@ protected:
     virtual void onDestroyContext() = 0;
 
     virtual void onSwapBuffers() = 0;
+    // Like onSwapBuffers(), but given the bounds (top-left origin) of the pixels drawn this frame.
+    // Platforms with a swap-with-damage extension override this to pass them along.
+    virtual void onSwapBuffersWithDamage(const SkIRect& damage) { this->onSwapBuffers(); }
 
     sk_sp<const GrGLInterface> fBackendContext;
     sk_sp<SkSurface>           fSurface;
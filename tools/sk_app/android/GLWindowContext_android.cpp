@@ -7,7 +7,9 @@
  */
 
 #include <EGL/egl.h>
+#include <EGL/eglext.h>
 #include <GLES/gl.h>
+#include <string.h>
 #include "../GLWindowContext.h"
 #include "WindowContextFactory_android.h"
 #include "gl/GrGLInterface.h"
@@ -24,6 +26,7 @@ public:
     ~GLWindowContext_android() override;
 
     void onSwapBuffers() override;
+    void onSwapBuffersWithDamage(const SkIRect& damage) override;
 
     sk_sp<const GrGLInterface> onInitializeContext() override;
     void onDestroyContext() override;
@@ -33,6 +36,8 @@ private:
     EGLDisplay fDisplay;
     EGLContext fEGLContext;
     EGLSurface fSurfaceAndroid;
+    // From EGL_KHR_swap_buffers_with_damage, if the display supports it.
+    PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC fSwapBuffersWithDamage = nullptr;
 
     // For setDisplayParams and resize which call onInitializeContext with null platformData
     ANativeWindow* fNativeWindow = nullptr;
@@ -105,6 +110,12 @@ sk_sp<const GrGLInterface> GLWindowContext_android::onInitializeContext() {
     SkASSERT(EGL_NO_SURFACE != fSurfaceAndroid);
 
     SkAssertResult(eglMakeCurrent(fDisplay, fSurfaceAndroid, fSurfaceAndroid, fEGLContext));
+
+    const char* extensions = eglQueryString(fDisplay, EGL_EXTENSIONS);
+    if (extensions && strstr(extensions, "EGL_KHR_swap_buffers_with_damage")) {
+        fSwapBuffersWithDamage = (PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC)
+                eglGetProcAddress("eglSwapBuffersWithDamageKHR");
+    }
     // GLWindowContext::initializeContext will call GrGLMakeNativeInterface so we
     // won't call it here.
 
@@ -129,6 +140,7 @@ void GLWindowContext_android::onDestroyContext() {
     SkAssertResult(eglDestroyContext(fDisplay, fEGLContext));
     fEGLContext = EGL_NO_CONTEXT;
     fSurfaceAndroid = EGL_NO_SURFACE;
+    fSwapBuffersWithDamage = nullptr;
 }
 
 void GLWindowContext_android::onSwapBuffers() {
@@ -137,6 +149,17 @@ void GLWindowContext_android::onSwapBuffers() {
     }
 }
 
+void GLWindowContext_android::onSwapBuffersWithDamage(const SkIRect& damage) {
+    if (!fSwapBuffersWithDamage || !fDisplay || !fEGLContext || !fSurfaceAndroid) {
+        this->onSwapBuffers();
+        return;
+    }
+    // EGL's rects are x, y, width and height, with y measured from the bottom of the window.
+    // (Passing no rects would mean the whole window, so an empty damage is still passed as one.)
+    EGLint rect[4] = { damage.fLeft, fHeight - damage.fBottom, damage.width(), damage.height() };
+    fSwapBuffersWithDamage(fDisplay, fSurfaceAndroid, rect, 1);
+}
+
 }  // anonymous namespace
 
 namespace sk_app {
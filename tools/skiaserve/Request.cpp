@@ -241,6 +241,20 @@ sk_sp<SkData> Request::getJsonOpList(int n) {
     return stream.detachAsData();
 }
 
+sk_sp<SkData> Request::getJsonProfile() {
+    SkCanvas* canvas = this->getCanvas();
+    SkDynamicMemoryWStream stream;
+    SkJSONWriter writer(&stream, SkJSONWriter::Mode::kFast);
+    writer.beginObject(); // root
+
+    writer.appendString("mode", fGPUEnabled ? "gpu" : "cpu");
+    fDebugCanvas->toJSONProfile(writer, canvas);
+
+    writer.endObject(); // root
+    writer.flush();
+    return stream.detachAsData();
+}
+
 sk_sp<SkData> Request::getJsonInfo(int n) {
     // drawTo
     sk_sp<SkSurface> surface(this->createCPUSurface());
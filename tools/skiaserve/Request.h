@@ -53,6 +53,9 @@ struct Request {
     // Returns a json list of ops as an SkData
     sk_sp<SkData> getJsonOpList(int n);
 
+    // Returns json with each command's CPU and GPU cost
+    sk_sp<SkData> getJsonProfile();
+
     // Returns json with the viewMatrix and clipRect
     sk_sp<SkData> getJsonInfo(int n);
 
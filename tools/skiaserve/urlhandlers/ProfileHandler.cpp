@@ -0,0 +1,35 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "UrlHandler.h"
+
+#include "microhttpd.h"
+#include "../Request.h"
+#include "../Response.h"
+
+using namespace Response;
+
+bool ProfileHandler::canHandle(const char* method, const char* url) {
+    const char* kBasePath = "/profile";
+    return 0 == strcmp(method, MHD_HTTP_METHOD_GET) &&
+           0 == strncmp(url, kBasePath, strlen(kBasePath));
+}
+
+int ProfileHandler::handle(Request* request, MHD_Connection* connection,
+                           const char* url, const char* method,
+                           const char* upload_data, size_t* upload_data_size) {
+    SkTArray<SkString> commands;
+    SkStrSplit(url, "/", &commands);
+
+    if (!request->hasPicture() || commands.count() > 1) {
+        return MHD_NO;
+    }
+
+    // /profile
+    sk_sp<SkData> data(request->getJsonProfile());
+    return SendData(connection, data.get(), "application/json");
+}
@@ -135,6 +135,17 @@ public:
                const char* upload_data, size_t* upload_data_size) override;
 };
 
+/*
+ * Returns a json profile of what each command costs to draw, for a heat map of the commands
+ */
+class ProfileHandler : public UrlHandler {
+public:
+    bool canHandle(const char* method, const char* url) override;
+    int handle(Request* request, MHD_Connection* connection,
+               const char* url, const char* method,
+               const char* upload_data, size_t* upload_data_size) override;
+};
+
 class RootHandler : public UrlHandler {
 public:
     bool canHandle(const char* method, const char* url) override;
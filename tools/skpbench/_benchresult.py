@@ -70,3 +70,86 @@ class BenchResult:
       values.append(bench_pad[min(len(config_suffix), len(bench_pad) - 1):])
       values.append(self.get_string('bench'))
       return ''.join(values)
+
+class FrameResult:
+  """Parses the result of an skpbench run with --frameMs."""
+  FLOAT_REGEX = '[-+]?((\d+(\.\d*)?|\.\d+)([eE][-+]?\d+)?|nan)'
+  NAMES = ['p50', 'p90', 'p99', 'p999', 'max', 'frames', 'missed', 'frame_ms',
+           'gpu_p50', 'gpu_p99', 'config', 'bench']
+  PATTERN = re.compile('^(?P<p50_pad> *)'
+                       '(?P<p50>' + FLOAT_REGEX + ')'
+                       '(?P<p90_pad> +)'
+                       '(?P<p90>' + FLOAT_REGEX + ')'
+                       '(?P<p99_pad> +)'
+                       '(?P<p99>' + FLOAT_REGEX + ')'
+                       '(?P<p999_pad> +)'
+                       '(?P<p999>' + FLOAT_REGEX + ')'
+                       '(?P<max_pad> +)'
+                       '(?P<max>' + FLOAT_REGEX + ')'
+                       '(?P<frames_pad> +)'
+                       '(?P<frames>\d+)'
+                       '(?P<missed_pad> +)'
+                       '(?P<missed>\d+)'
+                       '(?P<frame_ms_pad> +)'
+                       '(?P<frame_ms>' + FLOAT_REGEX + ')'
+                       '(?P<gpu_p50_pad> +)'
+                       '(?P<gpu_p50>' + FLOAT_REGEX + ')'
+                       '(?P<gpu_p99_pad> +)'
+                       '(?P<gpu_p99>' + FLOAT_REGEX + ')'
+                       '(?P<config_pad> +)'
+                       '(?P<config>[^\s]+)'
+                       '(?P<bench_pad> +)'
+                       '(?P<bench>[^\s]+)$')
+
+  @classmethod
+  def match(cls, text):
+    match = cls.PATTERN.search(text)
+    return cls(match) if match else None
+
+  def __init__(self, match):
+    self.p50 = float(match.group('p50'))
+    self.p90 = float(match.group('p90'))
+    self.p99 = float(match.group('p99'))
+    self.p999 = float(match.group('p999'))
+    self.max = float(match.group('max'))
+    self.frames = int(match.group('frames'))
+    self.missed = int(match.group('missed'))
+    self.frame_ms = float(match.group('frame_ms'))
+    self.gpu_p50 = float(match.group('gpu_p50'))
+    self.gpu_p99 = float(match.group('gpu_p99'))
+    self.config = match.group('config')
+    self.bench = match.group('bench')
+    self._match = match
+
+  def get_string(self, name):
+    return self._match.group(name)
+
+  def format(self, config_suffix=None):
+    if not config_suffix or config_suffix == '':
+      return self._match.group(0)
+    else:
+      values = list()
+      for name in self.NAMES[:-1]:
+        values.append(self.get_string(name + '_pad'))
+        values.append(self.get_string(name))
+      values.append(config_suffix)
+      bench_pad = self.get_string('bench_pad')
+      values.append(bench_pad[min(len(config_suffix), len(bench_pad) - 1):])
+      values.append(self.get_string('bench'))
+      return ''.join(values)
+
+class FrameTime:
+  """Parses one frame's times from an skpbench run with --printFrameTimes."""
+  PATTERN = re.compile('^frame +(?P<index>\d+)'
+                       ' +(?P<ms>' + FrameResult.FLOAT_REGEX + ')'
+                       ' +(?P<gpu_ms>' + FrameResult.FLOAT_REGEX + ')$')
+
+  @classmethod
+  def match(cls, text):
+    match = cls.PATTERN.search(text)
+    return cls(match) if match else None
+
+  def __init__(self, match):
+    self.index = int(match.group('index'))
+    self.ms = float(match.group('ms'))
+    self.gpu_ms = float(match.group('gpu_ms'))
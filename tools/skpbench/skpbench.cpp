@@ -17,6 +17,7 @@
 #include "SkDeferredDisplayList.h"
 #include "SkGraphics.h"
 #include "SkGr.h"
+#include "SkMultiPictureDocument.h"
 #include "SkOSFile.h"
 #include "SkOSPath.h"
 #include "SkPerlinNoiseShader.h"
@@ -40,6 +41,7 @@
 #include <array>
 #include <chrono>
 #include <cmath>
+#include <thread>
 #include <vector>
 
 /**
@@ -51,6 +53,11 @@
  * No tiling, looping, or other fanciness is used; it just draws the skp whole into a size-matched
  * render target and syncs the GPU after each draw.
  *
+ * With --frameMs, the input is instead played as an animation: each .skp given to --src, or each
+ * page of an .mskp, is one frame, drawn at a vsync-like interval. This reports what an app's frame
+ * loop would see (percentiles of the time from each vsync to its frame finishing on the GPU, and
+ * how many frames missed their deadline) rather than throughput.
+ *
  * Currently, only GPU configs are supported.
  */
 
@@ -58,15 +65,20 @@ DEFINE_bool(ddl, false, "record the skp into DDLs before rendering");
 DEFINE_int32(ddlNumAdditionalThreads, 0, "number of DDL recording threads in addition to main one");
 DEFINE_int32(ddlTilingWidthHeight, 0, "number of tiles along one edge when in DDL mode");
 DEFINE_bool(ddlRecordTime, false, "report just the cpu time spent recording DDLs");
+DEFINE_bool(ddlThreadTimes, false, "print per-thread DDL recording times and replay time to stderr");
 
 DEFINE_int32(duration, 5000, "number of milliseconds to run the benchmark");
 DEFINE_int32(sampleMs, 50, "minimum duration of a sample");
 DEFINE_bool(gpuClock, false, "time on the gpu clock (gpu work only)");
 DEFINE_bool(fps, false, "use fps instead of ms");
-DEFINE_string(src, "", "path to a single .skp or .svg file, or 'warmup' for a builtin warmup run");
+DEFINE_string(src, "", "path to a single .skp or .svg file, or 'warmup' for a builtin warmup run "
+                      "(with --frameMs, any number of .skp files or a single .mskp animation)");
 DEFINE_string(png, "", "if set, save a .png proof to disk at this file location");
 DEFINE_int32(verbosity, 4, "level of verbosity (0=none to 5=debug)");
 DEFINE_bool(suppressHeader, false, "don't print a header row before the results");
+DEFINE_double(frameMs, 0, "if positive, play the src frames in a loop paced to this vsync interval "
+                          "and report the distribution of frame times");
+DEFINE_bool(printFrameTimes, false, "with --frameMs, print each frame's times before the results");
 
 static const char* header =
 "   accum    median       max       min   stddev  samples  sample_ms  clock  metric  config    bench";
@@ -74,6 +86,15 @@ static const char* header =
 static const char* resultFormat =
 "%8.4g  %8.4g  %8.4g  %8.4g  %6.3g%%  %7li  %9i  %-5s  %-6s  %-9s %s";
 
+static const char* frameHeader =
+"     p50       p90       p99     p99.9       max   frames  missed  frame_ms   gpu_p50   gpu_p99"
+"  config    bench";
+
+static const char* frameResultFormat =
+"%8.4g  %8.4g  %8.4g  %8.4g  %8.4g  %7zu  %6i  %8.4g  %8.4g  %8.4g  %-9s %s";
+
+static const char* frameTimeFormat = "frame  %7zu  %8.4g  %8.4g";
+
 static constexpr int kNumFlushesToPrimeCache = 3;
 
 struct Sample {
@@ -89,6 +110,11 @@ struct Sample {
     duration   fDuration;
 };
 
+struct FrameTime {
+    double   fMs;     // From the frame's vsync until its GPU work completed.
+    double   fGpuMs;  // NaN if the GPU timer was unavailable or disjoint.
+};
+
 class GpuSync {
 public:
     GpuSync(const sk_gpu_test::FenceSync* fenceSync);
@@ -113,8 +139,10 @@ enum class ExitErr {
 };
 
 static void draw_skp_and_flush(SkSurface*, const SkPicture*);
+static void draw_frame_and_flush(SkSurface*, const SkPicture*);
 static sk_sp<SkPicture> create_warmup_skp();
 static sk_sp<SkPicture> create_skp_from_svg(SkStream*, const char* filename);
+static void read_src(const char* srcfile, std::vector<sk_sp<SkPicture>>* frames);
 static bool mkdir_p(const SkString& name);
 static SkString join(const SkCommandLineFlags::StringArray&);
 static void exitf(ExitErr, const char* format, ...);
@@ -174,6 +202,9 @@ static void run_ddl_benchmark(const sk_gpu_test::FenceSync* fenceSync,
     GpuSync gpuSync(fenceSync);
     ddl_sample(context, &tiles, &gpuSync, nullptr, &startStopTime);
 
+    // Don't count the warmup frames.
+    tiles.resetTimings();
+
     clock::duration cumulativeDuration = std::chrono::milliseconds(0);
 
     do {
@@ -187,6 +218,19 @@ static void run_ddl_benchmark(const sk_gpu_test::FenceSync* fenceSync,
         cumulativeDuration += sample.fDuration;
     } while (cumulativeDuration < benchDuration || 0 == samples->size() % 2);
 
+    if (FLAGS_ddlThreadTimes) {
+        const SkTArray<DDLTileHelper::ThreadTiming>& timings = tiles.threadTimings();
+        for (int i = 0; i < timings.count(); ++i) {
+            fprintf(stderr, "DDL thread %i: %.3f ms recording per frame (%.1f tiles)\n", i,
+                    timings[i].fRecordMs / tiles.numRecordings(),
+                    (double) timings[i].fNumTiles / tiles.numRecordings());
+        }
+        if (tiles.numReplays()) {
+            fprintf(stderr, "DDL replay: %.3f ms per frame\n",
+                    tiles.replayMs() / tiles.numReplays());
+        }
+    }
+
     if (!FLAGS_png.isEmpty()) {
         // The user wants to see the final result
         tiles.composeAllTiles(finalCanvas);
@@ -290,6 +334,88 @@ static void run_gpu_time_benchmark(sk_gpu_test::GpuTimer* gpuTimer,
     gpuTimer->deleteQuery(previousTime);
 }
 
+static void wait_for_gpu(const sk_gpu_test::FenceSync* fenceSync) {
+    sk_gpu_test::PlatformFence fence = fenceSync->insertFence();
+    if (sk_gpu_test::kInvalidFence == fence) {
+        exitf(ExitErr::kUnavailable, "failed to insert fence");
+    }
+    if (!fenceSync->waitFence(fence)) {
+        exitf(ExitErr::kUnavailable, "failed to wait for fence");
+    }
+    fenceSync->deleteFence(fence);
+}
+
+/**
+ * Each frame starts at a vsync and is waited on until the GPU has finished it. A frame that isn't
+ * done by the following vsync has missed its deadline, and, as with a swap chain, the next frame
+ * then waits for the first vsync after it finishes.
+ */
+static void run_frame_benchmark(sk_gpu_test::GpuTimer* gpuTimer,
+                                const sk_gpu_test::FenceSync* fenceSync, SkSurface* surface,
+                                const std::vector<sk_sp<SkPicture>>& frames,
+                                std::vector<FrameTime>* frameTimes, int* missedDeadlines) {
+    using sk_gpu_test::PlatformTimerQuery;
+    using clock = std::chrono::steady_clock;
+    const clock::duration interval = std::chrono::duration_cast<clock::duration>(
+            std::chrono::duration<double, std::milli>(FLAGS_frameMs));
+    const clock::duration benchDuration = std::chrono::milliseconds(FLAGS_duration);
+
+    for (int i = 0; i < kNumFlushesToPrimeCache; ++i) {
+        for (const sk_sp<SkPicture>& frame : frames) {
+            draw_frame_and_flush(surface, frame.get());
+        }
+        wait_for_gpu(fenceSync);
+    }
+
+    clock::time_point vsync = clock::now();
+    const clock::time_point endTime = vsync + benchDuration;
+    *missedDeadlines = 0;
+
+    do {
+        std::this_thread::sleep_until(vsync);
+
+        PlatformTimerQuery query = 0;
+        if (gpuTimer) {
+            gpuTimer->queueStart();
+        }
+        draw_frame_and_flush(surface, frames[frameTimes->size() % frames.size()].get());
+        if (gpuTimer) {
+            query = gpuTimer->queueStop();
+        }
+        wait_for_gpu(fenceSync);
+        const clock::time_point done = clock::now();
+
+        FrameTime frameTime;
+        frameTime.fMs = std::chrono::duration<double, std::milli>(done - vsync).count();
+        frameTime.fGpuMs = NAN;
+        if (gpuTimer) {
+            switch (gpuTimer->checkQueryStatus(query)) {
+                using QueryStatus = sk_gpu_test::GpuTimer::QueryStatus;
+                case QueryStatus::kInvalid:
+                    exitf(ExitErr::kUnavailable, "GPU timer failed");
+                case QueryStatus::kPending:
+                    exitf(ExitErr::kUnavailable, "timer query still not ready after fence sync");
+                case QueryStatus::kDisjoint:
+                    break;
+                case QueryStatus::kAccurate:
+                    frameTime.fGpuMs = std::chrono::duration<double, std::milli>(
+                            gpuTimer->getTimeElapsed(query)).count();
+                    break;
+            }
+            gpuTimer->deleteQuery(query);
+        }
+        frameTimes->push_back(frameTime);
+
+        vsync += interval;
+        if (done > vsync) {
+            ++*missedDeadlines;
+            do {
+                vsync += interval;
+            } while (done > vsync);
+        }
+    } while (vsync < endTime || frameTimes->size() < frames.size());
+}
+
 void print_result(const std::vector<Sample>& samples, const char* config, const char* bench)  {
     if (0 == (samples.size() % 2)) {
         exitf(ExitErr::kSoftware, "attempted to gather stats on even number of samples");
@@ -322,13 +448,47 @@ void print_result(const std::vector<Sample>& samples, const char* config, const
     fflush(stdout);
 }
 
+// Nearest-rank percentile of sorted values.
+static double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) {
+        return NAN;
+    }
+    size_t rank = static_cast<size_t>(std::ceil(p / 100 * sorted.size()));
+    return sorted[SkTMax<size_t>(rank, 1) - 1];
+}
+
+void print_frame_result(const std::vector<FrameTime>& frameTimes, int missedDeadlines,
+                        const char* config, const char* bench) {
+    std::vector<double> ms, gpuMs;
+    ms.reserve(frameTimes.size());
+    for (size_t i = 0; i < frameTimes.size(); ++i) {
+        if (FLAGS_printFrameTimes) {
+            printf(frameTimeFormat, i, frameTimes[i].fMs, frameTimes[i].fGpuMs);
+            printf("\n");
+        }
+        ms.push_back(frameTimes[i].fMs);
+        if (!std::isnan(frameTimes[i].fGpuMs)) {
+            gpuMs.push_back(frameTimes[i].fGpuMs);
+        }
+    }
+    std::sort(ms.begin(), ms.end());
+    std::sort(gpuMs.begin(), gpuMs.end());
+
+    printf(frameResultFormat, percentile(ms, 50), percentile(ms, 90), percentile(ms, 99),
+           percentile(ms, 99.9), ms.back(), ms.size(), missedDeadlines, FLAGS_frameMs,
+           percentile(gpuMs, 50), percentile(gpuMs, 99), config, bench);
+    printf("\n");
+    fflush(stdout);
+}
+
 int main(int argc, char** argv) {
     SkCommandLineFlags::SetUsage("Use skpbench.py instead. "
                                  "You usually don't want to use this program directly.");
     SkCommandLineFlags::Parse(argc, argv);
 
+    const bool frameMode = FLAGS_frameMs > 0;
     if (!FLAGS_suppressHeader) {
-        printf("%s\n", header);
+        printf("%s\n", frameMode ? frameHeader : header);
     }
     if (FLAGS_duration <= 0) {
         exit(0); // This can be used to print the header and quit.
@@ -344,7 +504,7 @@ int main(int argc, char** argv) {
     }
 
     // Parse the skp.
-    if (FLAGS_src.count() != 1) {
+    if (FLAGS_src.count() != 1 && (!frameMode || FLAGS_src.isEmpty())) {
         exitf(ExitErr::kUsage,
               "invalid input '%s': must specify a single .skp or .svg file, or 'warmup'",
               join(FLAGS_src).c_str());
@@ -352,34 +512,35 @@ int main(int argc, char** argv) {
 
     SkGraphics::Init();
 
-    sk_sp<SkPicture> skp;
+    std::vector<sk_sp<SkPicture>> frames;
     SkString srcname;
     if (0 == strcmp(FLAGS_src[0], "warmup")) {
-        skp = create_warmup_skp();
+        frames.push_back(create_warmup_skp());
         srcname = "warmup";
     } else {
-        SkString srcfile(FLAGS_src[0]);
-        std::unique_ptr<SkStream> srcstream(SkStream::MakeFromFile(srcfile.c_str()));
-        if (!srcstream) {
-            exitf(ExitErr::kIO, "failed to open file %s", srcfile.c_str());
+        for (int i = 0; i < FLAGS_src.count(); ++i) {
+            read_src(FLAGS_src[i], &frames);
         }
-        if (srcfile.endsWith(".svg")) {
-            skp = create_skp_from_svg(srcstream.get(), srcfile.c_str());
-        } else {
-            skp = SkPicture::MakeFromStream(srcstream.get());
-        }
-        if (!skp) {
-            exitf(ExitErr::kData, "failed to parse file %s", srcfile.c_str());
+        srcname = SkOSPath::Basename(FLAGS_src[0]);
+        if (FLAGS_src.count() > 1) {
+            srcname.appendf("+%i", FLAGS_src.count() - 1);
         }
-        srcname = SkOSPath::Basename(srcfile.c_str());
     }
-    int width = SkTMin(SkScalarCeilToInt(skp->cullRect().width()), 2048),
-        height = SkTMin(SkScalarCeilToInt(skp->cullRect().height()), 2048);
-    if (FLAGS_verbosity >= 3 &&
-        (width != skp->cullRect().width() || height != skp->cullRect().height())) {
+    if (frames.size() != 1 && !frameMode) {
+        exitf(ExitErr::kUsage, "%s has %zu frames; animations require --frameMs",
+                               srcname.c_str(), frames.size());
+    }
+    const sk_sp<SkPicture>& skp = frames.front();
+    SkRect cullSize = SkRect::MakeEmpty();
+    for (const sk_sp<SkPicture>& frame : frames) {
+        cullSize.join(SkRect::MakeWH(frame->cullRect().width(), frame->cullRect().height()));
+    }
+    int width = SkTMin(SkScalarCeilToInt(cullSize.width()), 2048),
+        height = SkTMin(SkScalarCeilToInt(cullSize.height()), 2048);
+    if (FLAGS_verbosity >= 3 && (width != cullSize.width() || height != cullSize.height())) {
         fprintf(stderr, "%s is too large (%ix%i), cropping to %ix%i.\n",
-                        srcname.c_str(), SkScalarCeilToInt(skp->cullRect().width()),
-                        SkScalarCeilToInt(skp->cullRect().height()), width, height);
+                        srcname.c_str(), SkScalarCeilToInt(cullSize.width()),
+                        SkScalarCeilToInt(cullSize.height()), width, height);
     }
 
     if (config->getSurfType() != SkCommandLineConfigGpu::SurfType::kDefault) {
@@ -390,6 +551,8 @@ int main(int argc, char** argv) {
     // Create a context.
     GrContextOptions ctxOptions;
     SetCtxOptionsFromCommonFlags(&ctxOptions);
+    // DDLPromiseImageHelper fulfills each of its promise texture contexts with the same texture.
+    ctxOptions.fSharePromiseImageTextures = FLAGS_ddl;
     sk_gpu_test::GrContextFactory factory(ctxOptions);
     sk_gpu_test::ContextInfo ctxInfo =
         factory.getContextInfo(config->getContextType(), config->getContextOverrides());
@@ -434,33 +597,47 @@ int main(int argc, char** argv) {
                                      width, height, config->getTag().c_str());
     }
 
-    // Run the benchmark.
-    std::vector<Sample> samples;
-    if (FLAGS_sampleMs > 0) {
-        // +1 because we might take one more sample in order to have an odd number.
-        samples.reserve(1 + (FLAGS_duration + FLAGS_sampleMs - 1) / FLAGS_sampleMs);
-    } else {
-        samples.reserve(2 * FLAGS_duration);
-    }
-    SkCanvas* canvas = surface->getCanvas();
-    canvas->translate(-skp->cullRect().x(), -skp->cullRect().y());
-    if (!FLAGS_gpuClock) {
+    if (frameMode) {
         if (FLAGS_ddl) {
-            run_ddl_benchmark(testCtx->fenceSync(), ctx, canvas, skp.get(), &samples);
-        } else {
-            run_benchmark(testCtx->fenceSync(), surface.get(), skp.get(), &samples);
+            exitf(ExitErr::kUnavailable, "DDL: frame pacing not supported");
         }
+        sk_gpu_test::GpuTimer* gpuTimer = testCtx->gpuTimingSupport() ? testCtx->gpuTimer()
+                                                                       : nullptr;
+        std::vector<FrameTime> frameTimes;
+        int missedDeadlines;
+        run_frame_benchmark(gpuTimer, testCtx->fenceSync(), surface.get(), frames, &frameTimes,
+                            &missedDeadlines);
+        print_frame_result(frameTimes, missedDeadlines, config->getTag().c_str(),
+                           srcname.c_str());
     } else {
-        if (FLAGS_ddl) {
-            exitf(ExitErr::kUnavailable, "DDL: GPU-only timing not supported");
+        // Run the benchmark.
+        std::vector<Sample> samples;
+        if (FLAGS_sampleMs > 0) {
+            // +1 because we might take one more sample in order to have an odd number.
+            samples.reserve(1 + (FLAGS_duration + FLAGS_sampleMs - 1) / FLAGS_sampleMs);
+        } else {
+            samples.reserve(2 * FLAGS_duration);
         }
-        if (!testCtx->gpuTimingSupport()) {
-            exitf(ExitErr::kUnavailable, "GPU does not support timing");
+        SkCanvas* canvas = surface->getCanvas();
+        canvas->translate(-skp->cullRect().x(), -skp->cullRect().y());
+        if (!FLAGS_gpuClock) {
+            if (FLAGS_ddl) {
+                run_ddl_benchmark(testCtx->fenceSync(), ctx, canvas, skp.get(), &samples);
+            } else {
+                run_benchmark(testCtx->fenceSync(), surface.get(), skp.get(), &samples);
+            }
+        } else {
+            if (FLAGS_ddl) {
+                exitf(ExitErr::kUnavailable, "DDL: GPU-only timing not supported");
+            }
+            if (!testCtx->gpuTimingSupport()) {
+                exitf(ExitErr::kUnavailable, "GPU does not support timing");
+            }
+            run_gpu_time_benchmark(testCtx->gpuTimer(), testCtx->fenceSync(), surface.get(),
+                                   skp.get(), &samples);
         }
-        run_gpu_time_benchmark(testCtx->gpuTimer(), testCtx->fenceSync(), surface.get(), skp.get(),
-                               &samples);
+        print_result(samples, config->getTag().c_str(), srcname.c_str());
     }
-    print_result(samples, config->getTag().c_str(), srcname.c_str());
 
     // Save a proof (if one was requested).
     if (!FLAGS_png.isEmpty()) {
@@ -486,6 +663,45 @@ static void draw_skp_and_flush(SkSurface* surface, const SkPicture* skp) {
     surface->flush();
 }
 
+static void draw_frame_and_flush(SkSurface* surface, const SkPicture* frame) {
+    auto canvas = surface->getCanvas();
+    canvas->save();
+    canvas->translate(-frame->cullRect().x(), -frame->cullRect().y());
+    canvas->drawPicture(frame);
+    canvas->restore();
+    surface->flush();
+}
+
+static void read_src(const char* srcfile, std::vector<sk_sp<SkPicture>>* frames) {
+    std::unique_ptr<SkStreamAsset> srcstream(SkStream::MakeFromFile(srcfile));
+    if (!srcstream) {
+        exitf(ExitErr::kIO, "failed to open file %s", srcfile);
+    }
+    SkString filename(srcfile);
+    if (filename.endsWith(".mskp")) {
+        int pageCount = SkMultiPictureDocumentReadPageCount(srcstream.get());
+        std::vector<SkDocumentPage> pages(SkTMax(pageCount, 0));
+        if (pageCount <= 0 || !srcstream->rewind() ||
+            !SkMultiPictureDocumentRead(srcstream.get(), pages.data(), pageCount)) {
+            exitf(ExitErr::kData, "failed to parse file %s", srcfile);
+        }
+        for (SkDocumentPage& page : pages) {
+            frames->push_back(std::move(page.fPicture));
+        }
+        return;
+    }
+    sk_sp<SkPicture> skp;
+    if (filename.endsWith(".svg")) {
+        skp = create_skp_from_svg(srcstream.get(), srcfile);
+    } else {
+        skp = SkPicture::MakeFromStream(srcstream.get());
+    }
+    if (!skp) {
+        exitf(ExitErr::kData, "failed to parse file %s", srcfile);
+    }
+    frames->push_back(std::move(skp));
+}
+
 static sk_sp<SkPicture> create_warmup_skp() {
     static constexpr SkRect bounds{0, 0, 500, 500};
     SkPictureRecorder recorder;
@@ -7,7 +7,7 @@
 
 from __future__ import print_function
 from _adb import Adb
-from _benchresult import BenchResult
+from _benchresult import BenchResult, FrameResult, FrameTime
 from _hardware import HardwareException, Hardware
 from argparse import ArgumentParser
 from multiprocessing import Queue
@@ -79,11 +79,24 @@ __argparse.add_argument('--gpuThreads',
   type=int, default=-1,
   help="Create this many extra threads to assist with GPU work, including"
        " software path rendering. Defaults to two.")
+__argparse.add_argument('--frame-ms',
+  type=float,
+  help="play each src as an animation paced to this vsync interval, and report "
+       "frame-time percentiles and missed deadlines instead of throughput")
+__argparse.add_argument('--frame-sequence',
+  action='store_true',
+  help="with --frame-ms, play all the srcs in order as the frames of one "
+       "animation (otherwise each .skp or .mskp is its own animation)")
+__argparse.add_argument('--graph',
+  help="with --frame-ms, path of a .png to graph each animation's frame times "
+       "into (requires matplotlib)")
 __argparse.add_argument('srcs',
   nargs='+',
   help=".skp files or directories to expand for .skp files, and/or .svg files")
 
 FLAGS = __argparse.parse_args()
+if (FLAGS.frame_sequence or FLAGS.graph) and not FLAGS.frame_ms:
+  __argparse.error('--frame-sequence and --graph require --frame-ms')
 if FLAGS.adb:
   import _adb_path as _path
   _path.init(FLAGS.device_serial, FLAGS.adb_binary)
@@ -153,9 +166,16 @@ class SKPBench:
     else:
       ARGV[:0] = [FLAGS.adb_binary, '-s', FLAGS.device_serial, 'shell']
 
+  # Frame pacing parameters (not used for the warmup run).
+  FRAME_ARGV = list()
+  if FLAGS.frame_ms:
+    FRAME_ARGV.extend(['--frameMs', str(FLAGS.frame_ms)])
+  if FLAGS.graph:
+    FRAME_ARGV.extend(['--printFrameTimes', 'true'])
+
   @classmethod
   def get_header(cls, outfile=sys.stdout):
-    commandline = cls.ARGV + ['--duration', '0']
+    commandline = cls.ARGV + cls.FRAME_ARGV + ['--duration', '0']
     dump_commandline_if_verbose(commandline)
     out = subprocess.check_output(commandline, stderr=subprocess.STDOUT)
     return out.rstrip()
@@ -183,6 +203,7 @@ class SKPBench:
     self.config = config
     self.max_stddev = max_stddev
     self.best_result = best_result
+    self.frame_times = list()
     self._queue = Queue()
     self._proc = None
     self._monitor = None
@@ -201,12 +222,14 @@ class SKPBench:
     hardware.sanity_check()
     self._schedule_hardware_poll()
 
-    commandline = self.ARGV + ['--config', self.config,
-                               '--src', self.src,
-                               '--suppressHeader', 'true']
+    # With --frame-sequence, src is the list of all the animation's frames.
+    srcs = self.src if isinstance(self.src, list) else [self.src]
+    commandline = self.ARGV + self.FRAME_ARGV + ['--config', self.config,
+                                                 '--src'] + srcs + \
+                  ['--suppressHeader', 'true']
     if FLAGS.write_path:
       pngfile = _path.join(FLAGS.write_path, self.config,
-                           _path.basename(self.src) + '.png')
+                           _path.basename(srcs[0]) + '.png')
       commandline.extend(['--png', pngfile])
     dump_commandline_if_verbose(commandline)
     self._proc = subprocess.Popen(commandline, stdout=subprocess.PIPE,
@@ -217,7 +240,14 @@ class SKPBench:
     while True:
       message = self._queue.get()
       if message.message == Message.READLINE:
-        result = BenchResult.match(message.value)
+        if FLAGS.frame_ms:
+          frame = FrameTime.match(message.value)
+          if frame:
+            self.frame_times.append(frame)
+            continue
+          result = FrameResult.match(message.value)
+        else:
+          result = BenchResult.match(message.value)
         if result:
           hardware.sanity_check()
           self._process_result(result)
@@ -245,6 +275,10 @@ class SKPBench:
     self._hw_poll_timer.start()
 
   def _process_result(self, result):
+    if FLAGS.frame_ms:
+      # Tail latency is the point, so there is no stddev to filter on.
+      self.best_result = result
+      return
     if not self.best_result or result.stddev <= self.best_result.stddev:
       self.best_result = result
     elif FLAGS.verbosity >= 2:
@@ -269,7 +303,38 @@ def emit_result(line, resultsfile=None):
     print(line, file=resultsfile)
     resultsfile.flush()
 
-def run_benchmarks(configs, srcs, hardware, resultsfile=None):
+def graph_frame_times(frame_times, filename):
+  import matplotlib
+  matplotlib.use('Agg')
+  import matplotlib.pyplot as plt
+
+  figure, (timeline, tail) = plt.subplots(2, 1, figsize=(12, 9))
+  for label, frames in frame_times.items():
+    lines = timeline.plot([frame.ms for frame in frames], linewidth=0.75,
+                          label=label)
+    gpu_ms = [frame.gpu_ms for frame in frames]
+    if not all(math.isnan(ms) for ms in gpu_ms):
+      timeline.plot(gpu_ms, linewidth=0.75, linestyle=':',
+                    color=lines[0].get_color(), label=label + ' (gpu)')
+    sorted_ms = sorted(frame.ms for frame in frames)
+    tail.plot([100.0 * (i + 1) / len(sorted_ms) for i in range(len(sorted_ms))],
+              sorted_ms, label=label)
+  for axes in [timeline, tail]:
+    axes.axhline(FLAGS.frame_ms, color='red', linestyle='--', linewidth=0.75,
+                 label='deadline')
+    axes.set_ylabel('ms')
+  timeline.set_xlabel('frame')
+  timeline.set_title('frame times (vsync to gpu done)')
+  timeline.legend(fontsize='small')
+  tail.set_xlabel('percentile')
+  tail.set_xlim(50, 100)
+  tail.set_title('frame time distribution')
+  figure.tight_layout()
+  figure.savefig(filename)
+  print('wrote frame time graph to %s' % filename, file=sys.stderr)
+
+def run_benchmarks(configs, srcs, hardware, resultsfile=None,
+                   frame_times=None):
   hasheader = False
   benches = collections.deque([(src, config, FLAGS.max_stddev)
                                for src in srcs
@@ -289,6 +354,11 @@ def run_benchmarks(configs, srcs, hardware, resultsfile=None):
               if skpbench.best_result:
                 emit_result(skpbench.best_result.format(FLAGS.suffix),
                             resultsfile)
+                if frame_times is not None:
+                  label = '%s%s %s' % (skpbench.best_result.config,
+                                       FLAGS.suffix or '',
+                                       skpbench.best_result.bench)
+                  frame_times[label] = skpbench.frame_times
               else:
                 print("WARNING: no result for %s with config %s" %
                       (skpbench.src, skpbench.config), file=sys.stderr)
@@ -323,6 +393,8 @@ def main():
   DELIMITER = r'[, ](?!(?:[^(]*\([^)]*\))*[^()]*\))'
   configs = re.split(DELIMITER, FLAGS.config)
   srcs = _path.find_skps(FLAGS.srcs)
+  if FLAGS.frame_sequence:
+    srcs = [srcs]
 
   if FLAGS.adb:
     adb = Adb(FLAGS.device_serial, FLAGS.adb_binary,
@@ -348,11 +420,16 @@ def main():
   else:
     hardware = Hardware()
 
+  frame_times = collections.OrderedDict() if FLAGS.graph else None
   if FLAGS.resultsfile:
     with open(FLAGS.resultsfile, mode='a+') as resultsfile:
-      run_benchmarks(configs, srcs, hardware, resultsfile=resultsfile)
+      run_benchmarks(configs, srcs, hardware, resultsfile=resultsfile,
+                     frame_times=frame_times)
   else:
-    run_benchmarks(configs, srcs, hardware)
+    run_benchmarks(configs, srcs, hardware, frame_times=frame_times)
+
+  if FLAGS.graph:
+    graph_frame_times(frame_times, FLAGS.graph)
 
 
 if __name__ == '__main__':
@@ -74,6 +74,9 @@ int main(int argc, char** argv) {
         // reading the file.
         return kSuccess;
     }
+    // Newer SKPs pad the picture data so it stays aligned.
+    const bool aligned = info.getVersion() >= SkReadBuffer::kAlignedPictureData_Version;
+    if (aligned && !stream.move(3)) { return kTruncatedFile; }
 
     for (;;) {
         uint32_t tag;
@@ -105,6 +108,19 @@ int main(int argc, char** argv) {
                 SkDebugf("SK_PICT_READER_TAG %d\n", chunkSize);
             }
             break;
+        case SK_PICT_OP_GROUPS_TAG:
+            if (FLAGS_tags && !FLAGS_quiet) {
+                SkDebugf("SK_PICT_OP_GROUPS_TAG %d\n", chunkSize);
+            }
+            // The group count is followed by one more offset than that, and each group's bounds.
+            chunkSize = (chunkSize + 1) * sizeof(uint32_t) + chunkSize * sizeof(SkRect);
+            if (curPos + chunkSize > totStreamSize) {
+                if (!FLAGS_quiet) {
+                    SkDebugf("truncated file\n");
+                }
+                return kTruncatedFile;
+            }
+            break;
         case SK_PICT_FACTORY_TAG:
             if (FLAGS_tags && !FLAGS_quiet) {
                 SkDebugf("SK_PICT_FACTORY_TAG %d\n", chunkSize);
@@ -115,6 +131,18 @@ int main(int argc, char** argv) {
                 SkDebugf("SK_PICT_TYPEFACE_TAG %d\n", chunkSize);
             }
 
+            if (aligned) {
+                // The typefaces' size in bytes follows their count.
+                if (!stream.readU32(&chunkSize)) { return kTruncatedFile; }
+                if (stream.getPosition() + chunkSize > totStreamSize) {
+                    if (!FLAGS_quiet) {
+                        SkDebugf("truncated file\n");
+                    }
+                    return kTruncatedFile;
+                }
+                break;
+            }
+
             const int count = SkToInt(chunkSize);
             for (int i = 0; i < count; i++) {
                 SkFontDescriptor desc;